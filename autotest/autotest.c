@@ -32,6 +32,8 @@
 #include <string.h>
 #include <getopt.h>
 #include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
 #include "autotest/autotest.h"
 
 void usage()
@@ -42,6 +44,7 @@ void usage()
     printf("  -h            display this help and exit\n");
     printf("  -t <id>       run specific test\n");
     printf("  -p <id>       run specific package\n");
+    printf("  -j <num>      run tests across parallel worker processes\n");
     printf("  -r            run all tests, random order\n");
     printf("  -R <seed>     specify random seed value\n");
     printf("  -L            lists all scripts\n");
@@ -68,6 +71,8 @@ typedef struct {
     float percent_passed;           // percent of checks that passed
     int executed;                   // was the test executed?
     int pass;                       // did the test pass? (i.e. no failures)
+    double time_wall;               // wall-clock execution time [s]
+    double time_cpu;                // cpu execution time [s]
 } autotest_t;
 
 // define package_t
@@ -96,6 +101,9 @@ typedef struct {
 // execute a specific test
 void execute_autotest(autotest_t * _test, int _verbose);
 
+// execute all tests across forked worker processes
+int execute_all_parallel(unsigned int _num_workers);
+
 // execute a specific package
 void execute_package(package_t * _p, int _verbose);
 
@@ -111,6 +119,9 @@ void print_package_results(package_t * _p);
 // print all unstable tests (those which failed or gave warnings)
 void print_unstable_tests(void);
 
+// print report of slowest tests by wall-clock time
+void print_timing_report(void);
+
 // print list of tests
 void print_test_list(void);
 
@@ -131,6 +142,7 @@ int main(int argc, char *argv[])
     // set defaults
     unsigned int autotest_id        = 0;
     unsigned int package_id         = 0;
+    unsigned int num_workers        = 1;
     int          verbose            = 1;
     int          stop_on_fail       = 0;
     unsigned int rseed              = time(NULL);
@@ -141,7 +153,7 @@ int main(int argc, char *argv[])
 
     // get input options
     int d;
-    while((d = getopt(argc,argv,"ht:p:rR:Llxs:vqo:")) != EOF){
+    while((d = getopt(argc,argv,"ht:p:j:rR:Llxs:vqo:")) != EOF){
         switch (d) {
         case 'h':
             usage();
@@ -154,6 +166,13 @@ int main(int argc, char *argv[])
             package_id = atoi(optarg);
             mode = RUN_SINGLE_PACKAGE;
             break;
+        case 'j':
+            num_workers = atoi(optarg);
+            if (num_workers == 0) {
+                fprintf(stderr,"error: number of workers must be greater than zero\n");
+                return 1;
+            }
+            break;
         case 'r':
             mode = RUN_ALL_RANDOM;
             break;
@@ -208,6 +227,19 @@ int main(int argc, char *argv[])
     unsigned int n=0;
     switch (mode) {
     case RUN_ALL:
+        if (num_workers > 1) {
+            // run all tests across forked worker processes; note that
+            // stop-on-fail cannot interrupt workers already running
+            if (execute_all_parallel(num_workers) != 0)
+                return -1;
+            for (i=0; i<NUM_PACKAGES; i++) {
+                packages[i].executed = 1;
+                if (verbose)
+                    print_package_results( &packages[i] );
+            }
+            break;
+        }
+
         for (i=0; i<NUM_PACKAGES; i++) {
             execute_package( &packages[i], verbose );
 
@@ -274,6 +306,10 @@ int main(int argc, char *argv[])
     if (liquid_autotest_verbose)
         print_unstable_tests();
 
+    // print timing report for full runs
+    if (verbose && (mode == RUN_ALL || mode == RUN_ALL_RANDOM || mode == RUN_SEARCH))
+        print_timing_report();
+
     printf("autotest seed: %u\n", rseed);
     autotest_print_results();
 
@@ -314,11 +350,13 @@ int main(int argc, char *argv[])
     fprintf(fid,"  \"stop-on-fail\" : %s,\n", stop_on_fail ? "true" : "false");
     fprintf(fid,"  \"tests\" : [\n");
     for (i=0; i<NUM_AUTOSCRIPTS; i++) {
-        fprintf(fid,"    {\"id\":%3u, \"pass\":%s, \"num_checks\":%4lu, \"num_passed\":%4lu, \"name\":\"%s\"}%s\n",
+        fprintf(fid,"    {\"id\":%3u, \"pass\":%s, \"num_checks\":%4lu, \"num_passed\":%4lu, \"time_wall_ms\":%.3f, \"time_cpu_ms\":%.3f, \"name\":\"%s\"}%s\n",
                 scripts[i].id,
                 scripts[i].num_failed == 0 ? "true" : "false",
                 scripts[i].num_checks,
                 scripts[i].num_passed,
+                scripts[i].time_wall * 1e3,
+                scripts[i].time_cpu  * 1e3,
                 scripts[i].name,
                 i==NUM_AUTOSCRIPTS-1 ? "" : ",");
     }
@@ -332,6 +370,14 @@ int main(int argc, char *argv[])
     return rc;
 }
 
+// get current wall-clock time [s]
+static double autotest_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
+}
+
 // execute a specific autotest
 //  _test       :   pointer to autotest object
 //  _verbose    :   verbose output flag
@@ -342,8 +388,12 @@ void execute_autotest(autotest_t * _test,
     unsigned long int autotest_num_failed_init = liquid_autotest_num_failed;
     unsigned long int autotest_num_warnings_init = liquid_autotest_num_warnings;
 
-    // execute test
+    // execute test, measuring wall-clock and cpu time
+    double  t0_wall = autotest_get_time();
+    clock_t t0_cpu  = clock();
     _test->api();
+    _test->time_wall = autotest_get_time() - t0_wall;
+    _test->time_cpu  = (double)(clock() - t0_cpu) / (double)CLOCKS_PER_SEC;
 
     _test->num_passed = liquid_autotest_num_passed - autotest_num_passed_init;
     _test->num_failed = liquid_autotest_num_failed - autotest_num_failed_init;
@@ -361,6 +411,104 @@ void execute_autotest(autotest_t * _test,
     //    print_autotest_results(_test);
 }
 
+// per-test result record passed from worker process to parent
+typedef struct {
+    unsigned int      id;           // test identification
+    unsigned long int num_passed;   // number of checks that passed
+    unsigned long int num_failed;   // number of checks that failed
+    unsigned long int num_warnings; // number of warnings
+    double            time_wall;    // wall-clock execution time [s]
+    double            time_cpu;     // cpu execution time [s]
+} autotest_record_t;
+
+// execute all tests across forked worker processes; worker k runs every
+// k-th test and streams fixed-size result records back through a pipe,
+// which the parent merges into the script table and global counters so
+// reporting is identical to a serial run
+//  _num_workers    :   number of worker processes
+int execute_all_parallel(unsigned int _num_workers)
+{
+    if (_num_workers > NUM_AUTOSCRIPTS)
+        _num_workers = NUM_AUTOSCRIPTS;
+
+    int   fd [_num_workers][2]; // result pipes (worker to parent)
+    pid_t pid[_num_workers];    // worker process identifiers
+
+    unsigned int w;
+    unsigned int i;
+    for (w=0; w<_num_workers; w++) {
+        if (pipe(fd[w]) != 0) {
+            fprintf(stderr,"error: %s, could not create result pipe\n", __FILE__);
+            return -1;
+        }
+
+        pid[w] = fork();
+        if (pid[w] < 0) {
+            fprintf(stderr,"error: %s, could not fork worker process\n", __FILE__);
+            return -1;
+        } else if (pid[w] == 0) {
+            // worker: run tests round-robin and stream result records;
+            // individual check failures still print directly
+            close(fd[w][0]);
+            for (i=w; i<NUM_AUTOSCRIPTS; i+=_num_workers) {
+                execute_autotest(&scripts[i], 0);
+
+                autotest_record_t r = {
+                    .id           = scripts[i].id,
+                    .num_passed   = scripts[i].num_passed,
+                    .num_failed   = scripts[i].num_failed,
+                    .num_warnings = scripts[i].num_warnings,
+                    .time_wall    = scripts[i].time_wall,
+                    .time_cpu     = scripts[i].time_cpu,
+                };
+                if (write(fd[w][1], &r, sizeof(r)) != (ssize_t)sizeof(r))
+                    exit(2);
+            }
+            close(fd[w][1]);
+            exit(liquid_autotest_num_failed > 0 ? 1 : 0);
+        }
+
+        close(fd[w][1]);
+    }
+
+    // parent: merge result records into script table and global counters
+    for (w=0; w<_num_workers; w++) {
+        autotest_record_t r;
+        while (read(fd[w][0], &r, sizeof(r)) == (ssize_t)sizeof(r)) {
+            autotest_t * t  = &scripts[r.id];
+            t->num_passed   = r.num_passed;
+            t->num_failed   = r.num_failed;
+            t->num_warnings = r.num_warnings;
+            t->num_checks   = r.num_passed + r.num_failed;
+            t->pass         = (r.num_failed==0) ? 1 : 0;
+            t->percent_passed = t->num_checks > 0 ?
+                100.0f * (float)(t->num_passed) / (float)(t->num_checks) : 0.0f;
+            t->executed     = 1;
+            t->time_wall    = r.time_wall;
+            t->time_cpu     = r.time_cpu;
+
+            liquid_autotest_num_checks   += t->num_checks;
+            liquid_autotest_num_passed   += t->num_passed;
+            liquid_autotest_num_failed   += t->num_failed;
+            liquid_autotest_num_warnings += t->num_warnings;
+        }
+        close(fd[w][0]);
+    }
+
+    // reap workers; a worker that died without finishing its tests (e.g.
+    // a crashing test) is counted as a failure but does not discard the
+    // results already collected
+    for (w=0; w<_num_workers; w++) {
+        int status;
+        waitpid(pid[w], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) == 2) {
+            fprintf(stderr,"error: %s, worker %u terminated abnormally\n", __FILE__, w);
+            liquid_autotest_num_failed++;
+        }
+    }
+    return 0;
+}
+
 // execute a specific package
 //  _p          :   pointer to package object
 //  _verbose    :   verbose output flag
@@ -459,6 +607,50 @@ void print_unstable_tests(void)
     }
 }
 
+// compare tests by wall-clock time (descending) for timing report
+static int compare_test_time(const void * _a, const void * _b)
+{
+    double ta = (*(autotest_t * const *)_a)->time_wall;
+    double tb = (*(autotest_t * const *)_b)->time_wall;
+    return ta < tb ? 1 : (ta > tb ? -1 : 0);
+}
+
+// print report of slowest tests by wall-clock time
+void print_timing_report(void)
+{
+    // collect executed tests and total times
+    autotest_t * executed[NUM_AUTOSCRIPTS];
+    unsigned int num_executed = 0;
+    double total_wall = 0.0;
+    double total_cpu  = 0.0;
+    unsigned int t;
+    for (t=0; t<NUM_AUTOSCRIPTS; t++) {
+        if (!scripts[t].executed)
+            continue;
+        executed[num_executed++] = &scripts[t];
+        total_wall += scripts[t].time_wall;
+        total_cpu  += scripts[t].time_cpu;
+    }
+    if (num_executed == 0)
+        return;
+
+    // sort by wall-clock time, slowest first
+    qsort(executed, num_executed, sizeof(autotest_t*), compare_test_time);
+
+    unsigned int num_report = num_executed < 10 ? num_executed : 10;
+    printf("==================================\n");
+    printf(" SLOWEST TESTS:      wall      cpu\n");
+    for (t=0; t<num_report; t++) {
+        printf("    %3u : %8.1f ms %7.1f ms : %s\n",
+                executed[t]->id,
+                executed[t]->time_wall * 1e3,
+                executed[t]->time_cpu  * 1e3,
+                executed[t]->name);
+    }
+    printf("  total : %8.1f ms %7.1f ms (%u tests)\n",
+            total_wall * 1e3, total_cpu * 1e3, num_executed);
+}
+
 void print_test_list(void)
 {
     unsigned int i;
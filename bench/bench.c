@@ -34,8 +34,15 @@
 #include <getopt.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
+#include <time.h>
 #include <sys/resource.h>
 
+#include "liquid_benchmark.h"
+
+// roofline workload annotation, filled in by individual benchmarks
+struct liquid_benchmark_workload_s liquid_benchmark_workload = {0.0f, 0.0f};
+
 // define benchmark function pointer
 typedef void(benchmark_function_t) (
     struct rusage *_start,
@@ -52,6 +59,8 @@ typedef struct {
     float extime;
     float rate;
     float cycles_per_trial;
+    float gbytes_per_second;    // achieved memory bandwidth (0 if unannotated)
+    float gflops;               // achieved compute rate     (0 if unannotated)
 } benchmark_t;
 
 // define package_t
@@ -76,6 +85,8 @@ typedef struct {
 void estimate_cpu_clock(void);
 void set_num_trials_from_cpu_speed(void);
 void execute_benchmark(benchmark_t* _benchmark, int _verbose);
+void execute_benchmark_scaling(benchmark_t* _benchmark, unsigned int _num_threads);
+void run_benchmark(benchmark_t* _benchmark, int _verbose);
 void execute_package(package_t* _package, int _verbose);
 
 char convert_units(float * _s);
@@ -86,9 +97,17 @@ double calculate_execution_time(struct rusage, struct rusage);
 unsigned long int num_base_trials = 1<<12;
 float cpu_clock = 1.0f; // cpu clock speed (Hz)
 float runtime=0.100f;   // minimum run time (s)
+int output_json = 0;    // print results as JSON lines to stdout
+unsigned int num_threads = 1;   // concurrent instances for scaling mode
+
+// relative rate change considered significant when comparing runs;
+// smaller differences are within run-to-run measurement noise
+#define BENCH_COMPARE_THRESHOLD (0.10f)
 
 FILE * fid; // output file id
 void output_benchmark_to_file(FILE * _fid, benchmark_t * _benchmark);
+void print_benchmark_json(benchmark_t * _benchmark);
+int  compare_results(const char * _filename);
 
 void usage()
 {
@@ -109,6 +128,10 @@ void usage()
     printf("  -L           : list all available scripts\n");
     printf("  -s <search>  : run all packages/benchmarks matching search string\n");
     printf("  -o <file>    : output file (json)\n");
+    printf("  -j           : print results as JSON lines to stdout\n");
+    printf("  -d <file>    : compare results against baseline (json), flag regressions\n");
+    printf("  -T <threads> : run each benchmark concurrently on <threads> threads and\n");
+    printf("                 report per-thread throughput degradation versus one thread\n");
 }
 
 // main function
@@ -129,11 +152,15 @@ int main(int argc, char *argv[])
     int autoscale = 1;
     int cpu_clock_detect = 1;
     char filename[256];
+    char baseline_filename[256];
     char search_string[128];
+    filename[0]          = '\0';
+    baseline_filename[0] = '\0';
+    search_string[0]     = '\0';
 
     // get input options
     int d;
-    while((d = getopt(argc,argv,"hvqfec:n:b:p:t:lLs:o:")) != EOF){
+    while((d = getopt(argc,argv,"hvqfec:n:b:p:t:lLs:o:jd:T:")) != EOF){
         switch (d) {
         case 'h':   usage();        return 0;
         case 'v':   verbose = 1;    break;
@@ -203,6 +230,21 @@ int main(int argc, char *argv[])
             strncpy(filename,optarg,255);
             filename[255] = '\0';
             break;
+        case 'j':
+            output_json = 1;
+            verbose     = 0;
+            break;
+        case 'd':
+            strncpy(baseline_filename,optarg,255);
+            baseline_filename[255] = '\0';
+            break;
+        case 'T':
+            num_threads = atoi(optarg);
+            if (num_threads < 1) {
+                printf("error: number of threads must be at least 1\n");
+                return -1;
+            }
+            break;
         default:
             usage();
             return 0;
@@ -231,7 +273,7 @@ int main(int argc, char *argv[])
         //    print_package_results( &packages[i] );
         break;
     case RUN_SINGLE_BENCH:
-        execute_benchmark( &scripts[benchmark_id], verbose );
+        run_benchmark( &scripts[benchmark_id], verbose );
         //print_benchmark_results( &scripts[benchmark_id] );
         break;
     case RUN_SINGLE_PACKAGE:
@@ -252,7 +294,7 @@ int main(int argc, char *argv[])
             // see if search string matches benchmark name
             if (strstr(scripts[i].name, search_string) != NULL && scripts[i].num_trials == 0) {
                 // run the benchmark
-                execute_benchmark( &scripts[i], verbose );
+                run_benchmark( &scripts[i], verbose );
             }
         }
         break;
@@ -261,8 +303,14 @@ int main(int argc, char *argv[])
         exit(1);
     }
 
+    // compare results against baseline file, returning non-zero exit
+    // status on any significant regression so upgrades can be gated
+    int num_regressions = 0;
+    if (strcmp(baseline_filename,"") != 0)
+        num_regressions = compare_results(baseline_filename);
+
     if (strcmp(filename,"")==0)
-        return 0;
+        return num_regressions > 0 ? 1 : 0;
 
     // export results to output .json file; try to open file for writing
     FILE * fid = fopen(filename,"w");
@@ -286,12 +334,14 @@ int main(int argc, char *argv[])
     fprintf(fid,"  \"num_trials\"          : %lu,\n", num_base_trials);
     fprintf(fid,"  \"benchmarks\"          : [\n");
     for (i=0; i<NUM_AUTOSCRIPTS; i++) {
-        fprintf(fid,"    {\"id\":%5u, \"trials\":%12u, \"extime\":%12.4e, \"rate\":%12.4e, \"cycles_per_trial\":%12.4e, \"name\":\"%s\"}%s\n",
+        fprintf(fid,"    {\"id\":%5u, \"trials\":%12u, \"extime\":%12.4e, \"rate\":%12.4e, \"cycles_per_trial\":%12.4e, \"gbytes_per_second\":%12.4e, \"gflops\":%12.4e, \"name\":\"%s\"}%s\n",
                 scripts[i].id,
                 scripts[i].num_trials,
                 scripts[i].extime,
                 scripts[i].rate,
                 scripts[i].cycles_per_trial,
+                scripts[i].gbytes_per_second,
+                scripts[i].gflops,
                 scripts[i].name,
                 i==NUM_AUTOSCRIPTS-1 ? "" : ",");
     }
@@ -301,7 +351,7 @@ int main(int argc, char *argv[])
     if (verbose)
         printf("output JSON results written to %s\n", filename);
 
-    return 0;
+    return num_regressions > 0 ? 1 : 0;
 }
 
 // run basic benchmark to estimate CPU clock frequency
@@ -364,6 +414,11 @@ void execute_benchmark(benchmark_t* _benchmark, int _verbose)
     unsigned long int n = num_base_trials;
     struct rusage start, finish;
 
+    // reset workload annotation; benchmarks which describe their memory
+    // traffic and floating-point work overwrite these fields
+    liquid_benchmark_workload.bytes_per_trial = 0.0f;
+    liquid_benchmark_workload.flops_per_trial = 0.0f;
+
     unsigned int num_attempts = 0;
     unsigned long int num_trials;
     do {
@@ -391,8 +446,15 @@ void execute_benchmark(benchmark_t* _benchmark, int _verbose)
     _benchmark->rate = (float)(_benchmark->num_trials) / _benchmark->extime;
     _benchmark->cycles_per_trial = cpu_clock / (_benchmark->rate);
 
+    // derive achieved memory bandwidth and compute rate from the
+    // benchmark's workload annotation (zero when unannotated)
+    _benchmark->gbytes_per_second = 1e-9f * liquid_benchmark_workload.bytes_per_trial * _benchmark->rate;
+    _benchmark->gflops            = 1e-9f * liquid_benchmark_workload.flops_per_trial * _benchmark->rate;
+
     if (_verbose)
         print_benchmark_results(_benchmark);
+    if (output_json)
+        print_benchmark_json(_benchmark);
 }
 
 void execute_package(package_t* _package, int _verbose)
@@ -402,8 +464,88 @@ void execute_package(package_t* _package, int _verbose)
     
     unsigned int i;
     for (i=0; i<_package->num_scripts; i++) {
-        execute_benchmark( &scripts[ i + _package->index ], _verbose );
+        run_benchmark( &scripts[ i + _package->index ], _verbose );
+    }
+}
+
+// dispatch to threaded scaling mode when requested with -T
+void run_benchmark(benchmark_t* _benchmark, int _verbose)
+{
+    if (num_threads > 1)
+        execute_benchmark_scaling(_benchmark, num_threads);
+    else
+        execute_benchmark(_benchmark, _verbose);
+}
+
+// per-thread state for scaling mode
+typedef struct {
+    benchmark_t *     benchmark;    // benchmark to execute
+    unsigned long int num_trials;   // requested number of trials
+    unsigned long int num_done;     // trials actually executed
+    double            extime;       // wall-clock execution time (s)
+} bench_thread_t;
+
+// run one benchmark instance, timing it against the wall clock; rusage
+// cannot be used here as it aggregates cpu time across all threads
+void * benchmark_thread(void * _arg)
+{
+    bench_thread_t * t = (bench_thread_t*) _arg;
+    struct rusage start, finish;    // captured but unused (process-wide)
+    struct timespec t0, t1;
+    unsigned long int n = t->num_trials;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    t->benchmark->api(&start, &finish, &n);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    t->num_done = n;
+    t->extime   = (t1.tv_sec - t0.tv_sec) + 1e-9*(t1.tv_nsec - t0.tv_nsec);
+    return NULL;
+}
+
+// run benchmark once on a single thread and then on _num_threads
+// concurrent threads, reporting the per-thread throughput degradation
+// caused by cross-core interference (shared tables, caches, memory
+// bandwidth)
+void execute_benchmark_scaling(benchmark_t* _benchmark, unsigned int _num_threads)
+{
+    unsigned int i;
+
+    // establish trial count with the regular auto-scaled run, then
+    // measure the single-thread wall-clock baseline with that count
+    execute_benchmark(_benchmark, 0);
+    bench_thread_t baseline;
+    baseline.benchmark  = _benchmark;
+    baseline.num_trials = _benchmark->num_trials;
+    benchmark_thread(&baseline);
+    double rate_0 = (double)baseline.num_done / baseline.extime;
+
+    // run concurrent instances
+    pthread_t      threads[_num_threads];
+    bench_thread_t args[_num_threads];
+    for (i=0; i<_num_threads; i++) {
+        args[i].benchmark  = _benchmark;
+        args[i].num_trials = _benchmark->num_trials;
+        if (pthread_create(&threads[i], NULL, benchmark_thread, &args[i]) != 0) {
+            fprintf(stderr,"error: could not create benchmark thread\n");
+            exit(1);
+        }
+    }
+    for (i=0; i<_num_threads; i++)
+        pthread_join(threads[i], NULL);
+
+    // report per-thread rates relative to the single-thread baseline
+    printf("  %-3u: %-30s: scaling over %u threads (baseline %10.4e t/s)\n",
+            _benchmark->id, _benchmark->name, _num_threads, rate_0);
+    double rate_total = 0.0;
+    for (i=0; i<_num_threads; i++) {
+        double rate = (double)args[i].num_done / args[i].extime;
+        rate_total += rate;
+        printf("      thread %2u : %10.4e t/s (%6.1f%% of single-thread)\n",
+                i, rate, 100.0*rate/rate_0);
     }
+    printf("      aggregate : %10.4e t/s, scaling efficiency %5.1f%%\n",
+            rate_total, 100.0*rate_total/((double)_num_threads*rate_0));
 }
 
 // convert raw value into metric units,
@@ -442,12 +584,17 @@ void print_benchmark_results(benchmark_t* _b)
     float cycles_format = _b->cycles_per_trial;
     char cycles_units = convert_units(&cycles_format);
 
-    printf("  %-3u: %-30s: %6.2f %c trials / %6.2f %cs (%6.2f %c t/s, %6.2f %c c/t)\n",
+    printf("  %-3u: %-30s: %6.2f %c trials / %6.2f %cs (%6.2f %c t/s, %6.2f %c c/t)",
         _b->id, _b->name,
         trials_format, trials_units,
         extime_format, extime_units,
         rate_format, rate_units,
         cycles_format, cycles_units);
+
+    // append roofline annotation when the benchmark provided one
+    if (_b->gbytes_per_second > 0.0f || _b->gflops > 0.0f)
+        printf(" [%6.2f GB/s, %6.2f GFLOPS]", _b->gbytes_per_second, _b->gflops);
+    printf("\n");
 }
 
 void print_package_results(package_t* _package)
@@ -460,6 +607,88 @@ void print_package_results(package_t* _package)
     printf("\n");
 }
 
+// print single benchmark result to stdout as one JSON object per line
+// for machine parsing (e.g. diffing runs between releases)
+void print_benchmark_json(benchmark_t * _b)
+{
+    printf("{\"name\":\"%s\", \"trials\":%u, \"extime\":%.4e, \"rate\":%.4e, \"cycles_per_trial\":%.4e, \"gbytes_per_second\":%.4e, \"gflops\":%.4e}\n",
+            _b->name,
+            _b->num_trials,
+            _b->extime,
+            _b->rate,
+            _b->cycles_per_trial,
+            _b->gbytes_per_second,
+            _b->gflops);
+}
+
+// look up rate for named benchmark in baseline file written with -o
+// (one benchmark object per line); returns 0 on success
+int baseline_lookup_rate(const char * _filename,
+                         const char * _name,
+                         float *      _rate)
+{
+    FILE * fid = fopen(_filename,"r");
+    if (!fid) {
+        fprintf(stderr,"error: %s, could not open '%s' for reading\n", __FILE__, _filename);
+        exit(1);
+    }
+
+    // scan for line whose "name" field matches exactly
+    char line[1024];
+    char pattern[256];
+    snprintf(pattern, sizeof(pattern), "\"name\":\"%s\"", _name);
+    int found = 0;
+    while (fgets(line, sizeof(line), fid) != NULL) {
+        if (strstr(line, pattern) == NULL)
+            continue;
+        char * r = strstr(line, "\"rate\":");
+        if (r != NULL && sscanf(r+7, "%f", _rate) == 1) {
+            found = 1;
+            break;
+        }
+    }
+    fclose(fid);
+    return found ? 0 : -1;
+}
+
+// compare executed benchmarks against baseline results, printing the
+// relative rate change for each and flagging significant differences;
+// returns the number of regressions found
+int compare_results(const char * _filename)
+{
+    unsigned int i;
+    int num_regressions = 0;
+    printf("comparing results against baseline '%s'...\n", _filename);
+    for (i=0; i<NUM_AUTOSCRIPTS; i++) {
+        // skip benchmarks which were not executed in this run
+        if (scripts[i].num_trials == 0)
+            continue;
+
+        float rate_0;
+        if (baseline_lookup_rate(_filename, scripts[i].name, &rate_0) != 0) {
+            printf("  %-30s %34s\n", scripts[i].name, "[not in baseline]");
+            continue;
+        } else if (rate_0 <= 0.0f) {
+            continue;
+        }
+
+        // relative rate change; flag differences beyond measurement noise
+        float delta = (scripts[i].rate - rate_0) / rate_0;
+        const char * flag = "";
+        if (delta < -BENCH_COMPARE_THRESHOLD) {
+            flag = "[REGRESSION]";
+            num_regressions++;
+        } else if (delta > BENCH_COMPARE_THRESHOLD) {
+            flag = "[improved]";
+        }
+        printf("  %-30s %10.4e -> %10.4e (%+6.1f%%) %s\n",
+                scripts[i].name, rate_0, scripts[i].rate, delta*100.0f, flag);
+    }
+    printf("%d regression(s) found (threshold: %.0f%%)\n",
+            num_regressions, BENCH_COMPARE_THRESHOLD*100.0f);
+    return num_regressions;
+}
+
 double calculate_execution_time(struct rusage _start, struct rusage _finish)
 {
     return _finish.ru_utime.tv_sec - _start.ru_utime.tv_sec
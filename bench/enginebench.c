@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// bench/enginebench.c : engine-variant comparison harness
+//
+// Runs every registered engine variant of a kernel (e.g. the portable,
+// unrolled, structured/SIMD, and split-complex dot products) across a
+// size sweep on the executing machine. For each size the harness
+// asserts that all variants agree with the reference engine within
+// tolerance, measures per-variant throughput, reports the crossover
+// points where the fastest engine changes, and emits a machine-specific
+// dispatch table suitable for tuning the run-time kernel selection
+// thresholds.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <sys/resource.h>
+
+#include "liquid.h"
+
+void usage()
+{
+    // help
+    printf("Usage: enginebench [OPTION]\n");
+    printf("Compare registered engine variants of liquid-dsp kernels.\n");
+    printf("  -h            display this help and exit\n");
+    printf("  -v/q          verbose/quiet\n");
+    printf("  -t <seconds>  set minimum execution time per measurement\n");
+    printf("  -n <size>     minimum kernel size in sweep\n");
+    printf("  -N <size>     maximum kernel size in sweep\n");
+    printf("  -o <filename> export dispatch table\n");
+}
+
+// maximum number of engine variants per kernel
+#define ENGINEBENCH_MAX_ENGINES (8)
+
+// maximum number of sizes in sweep
+#define ENGINEBENCH_MAX_SIZES   (64)
+
+// problem state shared by all engine variants of all kernels
+typedef struct {
+    unsigned int    n;      // kernel size
+
+    // input/coefficient arrays
+    float *         hf;     // real coefficients
+    float *         xf;     // real input
+    float complex * hc;     // complex coefficients
+    float complex * xc;     // complex input
+
+    // split-complex (planar) copies of complex arrays
+    float *         hi;     // coefficient in-phase plane
+    float *         hq;     // coefficient quadrature plane
+    float *         xi;     // input in-phase plane
+    float *         xq;     // input quadrature plane
+
+    // structured dot product objects (created once per size)
+    dotprod_rrrf    q_rrrf;
+    dotprod_crcf    q_crcf;
+    dotprod_cccf    q_cccf;
+
+    float complex   y;      // kernel output (real kernels use real part)
+} engine_state_t;
+
+// an engine variant: computes the kernel output once on prepared state
+typedef struct {
+    const char * name;                      // engine variant name
+    void (*execute)(engine_state_t * _s);   // kernel invocation
+} engine_t;
+
+// a kernel family with its registered engine variants; engines[0] is
+// the reference for equivalence checking
+typedef struct {
+    const char * name;                          // kernel family name
+    unsigned int num_engines;                   // number of variants
+    engine_t engines[ENGINEBENCH_MAX_ENGINES];  // engine variants
+} kernel_t;
+
+//
+// engine variants: real dot product
+//
+
+void engine_rrrf_portable(engine_state_t * _s)
+{
+    float y;
+    dotprod_rrrf_run(_s->hf, _s->xf, _s->n, &y);
+    _s->y = y;
+}
+
+void engine_rrrf_unrolled(engine_state_t * _s)
+{
+    float y;
+    dotprod_rrrf_run4(_s->hf, _s->xf, _s->n, &y);
+    _s->y = y;
+}
+
+void engine_rrrf_structured(engine_state_t * _s)
+{
+    float y;
+    dotprod_rrrf_execute(_s->q_rrrf, _s->xf, &y);
+    _s->y = y;
+}
+
+//
+// engine variants: complex/real dot product
+//
+
+void engine_crcf_portable(engine_state_t * _s)
+{
+    dotprod_crcf_run(_s->hf, _s->xc, _s->n, &_s->y);
+}
+
+void engine_crcf_unrolled(engine_state_t * _s)
+{
+    dotprod_crcf_run4(_s->hf, _s->xc, _s->n, &_s->y);
+}
+
+void engine_crcf_structured(engine_state_t * _s)
+{
+    dotprod_crcf_execute(_s->q_crcf, _s->xc, &_s->y);
+}
+
+//
+// engine variants: complex dot product
+//
+
+void engine_cccf_portable(engine_state_t * _s)
+{
+    dotprod_cccf_run(_s->hc, _s->xc, _s->n, &_s->y);
+}
+
+void engine_cccf_unrolled(engine_state_t * _s)
+{
+    dotprod_cccf_run4(_s->hc, _s->xc, _s->n, &_s->y);
+}
+
+void engine_cccf_structured(engine_state_t * _s)
+{
+    dotprod_cccf_execute(_s->q_cccf, _s->xc, &_s->y);
+}
+
+void engine_cccf_planar(engine_state_t * _s)
+{
+    dotprod_cccf_soa_run(_s->hi, _s->hq, _s->xi, _s->xq, _s->n, &_s->y);
+}
+
+// kernel registry
+static kernel_t kernels[] = {
+    {"dotprod_rrrf", 3, {
+        {"portable",   engine_rrrf_portable},
+        {"unrolled",   engine_rrrf_unrolled},
+        {"structured", engine_rrrf_structured}, }},
+    {"dotprod_crcf", 3, {
+        {"portable",   engine_crcf_portable},
+        {"unrolled",   engine_crcf_unrolled},
+        {"structured", engine_crcf_structured}, }},
+    {"dotprod_cccf", 4, {
+        {"portable",   engine_cccf_portable},
+        {"unrolled",   engine_cccf_unrolled},
+        {"structured", engine_cccf_structured},
+        {"planar",     engine_cccf_planar}, }},
+};
+#define NUM_KERNELS (sizeof(kernels)/sizeof(kernels[0]))
+
+// create problem state for a given size with deterministic random data
+engine_state_t * engine_state_create(unsigned int _n)
+{
+    engine_state_t * s = (engine_state_t*) malloc(sizeof(engine_state_t));
+    s->n  = _n;
+    s->hf = (float*)         malloc(_n*sizeof(float));
+    s->xf = (float*)         malloc(_n*sizeof(float));
+    s->hc = (float complex*) malloc(_n*sizeof(float complex));
+    s->xc = (float complex*) malloc(_n*sizeof(float complex));
+    s->hi = (float*)         malloc(_n*sizeof(float));
+    s->hq = (float*)         malloc(_n*sizeof(float));
+    s->xi = (float*)         malloc(_n*sizeof(float));
+    s->xq = (float*)         malloc(_n*sizeof(float));
+
+    // deterministic data so runs are repeatable across engines
+    srand(12345 + _n);
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        s->hf[i] = randnf();
+        s->xf[i] = randnf();
+        s->hc[i] = randnf() + _Complex_I*randnf();
+        s->xc[i] = randnf() + _Complex_I*randnf();
+    }
+
+    // split complex arrays into i/q planes for the planar engine
+    liquid_complexf_deinterleave(s->hc, _n, s->hi, s->hq);
+    liquid_complexf_deinterleave(s->xc, _n, s->xi, s->xq);
+
+    // create structured objects
+    s->q_rrrf = dotprod_rrrf_create(s->hf, _n);
+    s->q_crcf = dotprod_crcf_create(s->hf, _n);
+    s->q_cccf = dotprod_cccf_create(s->hc, _n);
+
+    s->y = 0;
+    return s;
+}
+
+// destroy problem state
+void engine_state_destroy(engine_state_t * _s)
+{
+    dotprod_rrrf_destroy(_s->q_rrrf);
+    dotprod_crcf_destroy(_s->q_crcf);
+    dotprod_cccf_destroy(_s->q_cccf);
+    free(_s->hf); free(_s->xf);
+    free(_s->hc); free(_s->xc);
+    free(_s->hi); free(_s->hq);
+    free(_s->xi); free(_s->xq);
+    free(_s);
+}
+
+// compute elapsed user time between rusage measurements
+double calculate_execution_time(struct rusage _start,
+                                struct rusage _finish)
+{
+    return _finish.ru_utime.tv_sec - _start.ru_utime.tv_sec
+        + 1e-6*(_finish.ru_utime.tv_usec - _start.ru_utime.tv_usec)
+        + _finish.ru_stime.tv_sec - _start.ru_stime.tv_sec
+        + 1e-6*(_finish.ru_stime.tv_usec - _start.ru_stime.tv_usec);
+}
+
+// measure throughput of one engine on prepared state [samples/second];
+// the number of trials is scaled until the minimum runtime is reached
+double engine_measure_throughput(engine_t *       _engine,
+                                 engine_state_t * _s,
+                                 float            _runtime)
+{
+    unsigned long int num_trials = 256;
+    struct rusage start, finish;
+    double extime;
+
+    while (1) {
+        getrusage(RUSAGE_SELF, &start);
+        unsigned long int t;
+        for (t=0; t<num_trials; t++)
+            _engine->execute(_s);
+        getrusage(RUSAGE_SELF, &finish);
+        extime = calculate_execution_time(start, finish);
+
+        if (extime >= _runtime)
+            break;
+
+        // scale number of trials for next attempt
+        num_trials *= (extime <= 0.0) ? 16 : 4;
+    }
+
+    return (double)num_trials * (double)_s->n / extime;
+}
+
+int main(int argc, char *argv[])
+{
+    // options
+    float        runtime  = 0.050f; // minimum execution time per measurement
+    unsigned int size_min = 4;      // minimum size in sweep
+    unsigned int size_max = 1024;   // maximum size in sweep
+    int          verbose  = 1;
+    char         filename[256] = "";
+
+    int d;
+    while ((d = getopt(argc,argv,"hvqt:n:N:o:")) != EOF) {
+        switch (d) {
+        case 'h': usage();                  return 0;
+        case 'v': verbose = 1;              break;
+        case 'q': verbose = 0;              break;
+        case 't': runtime  = atof(optarg);  break;
+        case 'n': size_min = atoi(optarg);  break;
+        case 'N': size_max = atoi(optarg);  break;
+        case 'o':
+            strncpy(filename,optarg,255);
+            filename[255] = '\0';
+            break;
+        default:
+            return 1;
+        }
+    }
+
+    if (size_min == 0 || size_max < size_min) {
+        fprintf(stderr,"error: %s, invalid size sweep [%u,%u]\n",
+                __FILE__, size_min, size_max);
+        return 1;
+    }
+
+    // generate size sweep: dense at small sizes, logarithmic above
+    unsigned int sizes[ENGINEBENCH_MAX_SIZES];
+    unsigned int num_sizes = 0;
+    unsigned int n = size_min;
+    while (n <= size_max && num_sizes < ENGINEBENCH_MAX_SIZES) {
+        sizes[num_sizes++] = n;
+        n += (n < 32) ? 4 : n/2;
+    }
+
+    // fastest engine index per kernel per size (for dispatch table)
+    unsigned int fastest[NUM_KERNELS][ENGINEBENCH_MAX_SIZES];
+
+    unsigned long int num_failed = 0;
+    unsigned int k;
+    unsigned int s;
+    unsigned int e;
+    for (k=0; k<NUM_KERNELS; k++) {
+        kernel_t * kernel = &kernels[k];
+        printf("%s:\n", kernel->name);
+        printf("    %8s :", "size");
+        for (e=0; e<kernel->num_engines; e++)
+            printf(" %14s", kernel->engines[e].name);
+        printf("   [samples/s]\n");
+
+        for (s=0; s<num_sizes; s++) {
+            engine_state_t * state = engine_state_create(sizes[s]);
+
+            // reference output from engine 0
+            kernel->engines[0].execute(state);
+            float complex y_ref = state->y;
+
+            // error tolerance scales with the number of accumulated
+            // products (different engines sum in different orders)
+            float tol = 1e-4f * sqrtf((float)sizes[s]);
+
+            // verify equivalence and measure throughput of each engine
+            double throughput[ENGINEBENCH_MAX_ENGINES];
+            printf("    %8u :", sizes[s]);
+            for (e=0; e<kernel->num_engines; e++) {
+                kernel->engines[e].execute(state);
+                float err = cabsf(state->y - y_ref) / (1.0f + cabsf(y_ref));
+                if (err > tol) {
+                    printf("\nerror: %s/%s, size %u: output deviates from reference (%12.4e > %12.4e)\n",
+                            kernel->name, kernel->engines[e].name,
+                            sizes[s], err, tol);
+                    num_failed++;
+                }
+
+                throughput[e] = engine_measure_throughput(
+                        &kernel->engines[e], state, runtime);
+
+                float rate = (float)throughput[e];
+                printf(" %13.4e%c", rate,
+                        e+1==kernel->num_engines ? '\n' : ' ');
+            }
+
+            // record fastest engine for this size
+            fastest[k][s] = 0;
+            for (e=1; e<kernel->num_engines; e++) {
+                if (throughput[e] > throughput[fastest[k][s]])
+                    fastest[k][s] = e;
+            }
+
+            engine_state_destroy(state);
+        }
+        printf("\n");
+    }
+
+    // report throughput crossover points
+    printf("engine crossover points:\n");
+    for (k=0; k<NUM_KERNELS; k++) {
+        printf("  %s: %s", kernels[k].name,
+                kernels[k].engines[fastest[k][0]].name);
+        for (s=1; s<num_sizes; s++) {
+            if (fastest[k][s] != fastest[k][s-1]) {
+                printf(" -> %s (n >= %u)",
+                        kernels[k].engines[fastest[k][s]].name, sizes[s]);
+            }
+        }
+        printf("\n");
+    }
+
+    if (num_failed > 0) {
+        fprintf(stderr,"error: %s, %lu engine variant(s) deviated from reference\n",
+                __FILE__, num_failed);
+        return 1;
+    }
+
+    if (strcmp(filename,"")==0)
+        return 0;
+
+    // export machine-specific dispatch table; each entry gives the
+    // smallest size at which the named engine becomes the fastest
+    FILE * fid = fopen(filename,"w");
+    if (!fid) {
+        fprintf(stderr,"error: %s, could not open '%s' for writing\n",
+                __FILE__, filename);
+        return 1;
+    }
+    fprintf(fid,"// engine dispatch table, machine-generated by enginebench\n");
+    fprintf(fid,"// fields: kernel, minimum size, fastest engine\n");
+    for (k=0; k<NUM_KERNELS; k++) {
+        fprintf(fid,"{\"%s\", %6u, \"%s\"},\n", kernels[k].name, sizes[0],
+                kernels[k].engines[fastest[k][0]].name);
+        for (s=1; s<num_sizes; s++) {
+            if (fastest[k][s] != fastest[k][s-1]) {
+                fprintf(fid,"{\"%s\", %6u, \"%s\"},\n", kernels[k].name,
+                        sizes[s], kernels[k].engines[fastest[k][s]].name);
+            }
+        }
+    }
+    fclose(fid);
+    if (verbose)
+        printf("dispatch table written to %s\n", filename);
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// shared declarations between the benchmark harness (bench/bench.c) and
+// individual benchmark scripts (src/*/bench)
+//
+
+#ifndef __LIQUID_BENCHMARK_H__
+#define __LIQUID_BENCHMARK_H__
+
+// roofline-style workload annotation: a benchmark may fill this in
+// (typically just before returning) to describe the memory traffic and
+// floating-point work of a single trial; the harness then reports the
+// achieved GB/s and GFLOPS alongside the trial rate, making it easy to
+// tell whether a kernel is memory- or compute-bound on a given machine.
+// Both fields are reset to zero before each benchmark runs.
+struct liquid_benchmark_workload_s {
+    float bytes_per_trial;  // memory traffic per trial [bytes]
+    float flops_per_trial;  // floating-point operations per trial
+};
+
+extern struct liquid_benchmark_workload_s liquid_benchmark_workload;
+
+#endif // __LIQUID_BENCHMARK_H__
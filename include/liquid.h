@@ -211,6 +211,28 @@ float AGC(_get_gain)(AGC() _q);                                             \
 void  AGC(_set_gain)(AGC() _q,                                              \
                      float _gain);                                          \
                                                                             \
+/* Get size of serialized gain-control state in bytes                   */  \
+unsigned int AGC(_get_state_size)(AGC() _q);                                \
+                                                                            \
+/* Save adaptive gain-control state (gain and signal level estimate)    */  \
+/* into buffer for later warm start; configuration (bandwidth, scale,   */  \
+/* squelch) is not included                                             */  \
+/*  _q       : automatic gain control object                            */  \
+/*  _buf     : output buffer, [size: _buf_len x 1]                      */  \
+/*  _buf_len : buffer length, must match AGC(_get_state_size)           */  \
+void AGC(_save_state)(AGC()           _q,                                   \
+                      unsigned char * _buf,                                 \
+                      unsigned int    _buf_len);                            \
+                                                                            \
+/* Restore adaptive gain-control state previously saved with            */  \
+/* AGC(_save_state), skipping cold-start convergence                    */  \
+/*  _q       : automatic gain control object                            */  \
+/*  _buf     : input buffer, [size: _buf_len x 1]                       */  \
+/*  _buf_len : buffer length, must match AGC(_get_state_size)           */  \
+void AGC(_restore_state)(AGC()           _q,                                \
+                         unsigned char * _buf,                              \
+                         unsigned int    _buf_len);                         \
+                                                                            \
 /* Get the ouput scaling applied to each sample (linear).               */  \
 float AGC(_get_scale)(AGC() _q);                                            \
                                                                             \
@@ -259,12 +281,130 @@ unsigned int AGC(_squelch_get_timeout)(AGC() _q);                           \
                                                                             \
 /* Get squelch status (e.g. LIQUID_AGC_SQUELCH_TIMEOUT)                 */  \
 int AGC(_squelch_get_status)(AGC() _q);                                     \
+                                                                            \
+/* Update the internal energy estimate and gain from a block of raw q15 */  \
+/* (sc16) samples without converting them to floating point. No output  */  \
+/* is produced; the tracked gain may be queried with _get_gain() and    */  \
+/* applied downstream once samples are converted to floating point.     */  \
+/*  _q      :   automatic gain control object                           */  \
+/*  _x      :   input data array, interleaved i/q for complex types     */  \
+/*  _n      :   number of input samples                                 */  \
+void AGC(_update_energy_q15)(AGC()        _q,                               \
+                             int16_t *    _x,                               \
+                             unsigned int _n);                              \
 
 // Define agc APIs
 LIQUID_AGC_DEFINE_API(LIQUID_AGC_MANGLE_CRCF, float, liquid_float_complex)
 LIQUID_AGC_DEFINE_API(LIQUID_AGC_MANGLE_RRRF, float, float)
 
 
+// automatic gain control bank
+#define LIQUID_AGCBANK_MANGLE_CRCF(name) LIQUID_CONCAT(agcbank_crcf, name)
+#define LIQUID_AGCBANK_MANGLE_RRRF(name) LIQUID_CONCAT(agcbank_rrrf, name)
+
+// large macro
+//   AGCBANK : name-mangling macro
+//   T       : primitive data type
+//   TC      : input/output data type
+#define LIQUID_AGCBANK_DEFINE_API(AGCBANK,T,TC)                             \
+                                                                            \
+/* Automatic gain control bank, running many parallel channels with     */  \
+/* shared loop parameters. The per-channel gains and energy estimates   */  \
+/* are stored in contiguous arrays so that processing a block of        */  \
+/* channel-interleaved samples sweeps all channels in one vectorizable  */  \
+/* pass per sample, rather than running hundreds of tiny scalar loops.  */  \
+/* Each channel follows the same loop recursion as the corresponding    */  \
+/* scalar agc object's block-mode processing; squelch is not supported. */  \
+typedef struct AGCBANK(_s) * AGCBANK();                                     \
+                                                                            \
+/* Create automatic gain control bank object                            */  \
+/*  _num_channels : number of parallel channels, _num_channels > 0      */  \
+AGCBANK() AGCBANK(_create)(unsigned int _num_channels);                     \
+                                                                            \
+/* Destroy object, freeing all internally-allocated memory.             */  \
+void AGCBANK(_destroy)(AGCBANK() _q);                                       \
+                                                                            \
+/* Print object properties to stdout, including per-channel state       */  \
+void AGCBANK(_print)(AGCBANK() _q);                                         \
+                                                                            \
+/* Reset internal state of all channels and unlock them                 */  \
+void AGCBANK(_reset)(AGCBANK() _q);                                         \
+                                                                            \
+/* Get number of parallel channels                                      */  \
+unsigned int AGCBANK(_get_num_channels)(AGCBANK() _q);                      \
+                                                                            \
+/* Get loop bandwidth (shared across all channels)                      */  \
+float AGCBANK(_get_bandwidth)(AGCBANK() _q);                                \
+                                                                            \
+/* Set loop bandwidth (shared across all channels)                      */  \
+/*  _q  : automatic gain control bank object                            */  \
+/*  _bt : bandwidth, _bt > 0                                            */  \
+void AGCBANK(_set_bandwidth)(AGCBANK() _q,                                  \
+                             float     _bt);                                \
+                                                                            \
+/* Set output scale applied to all unlocked channels                    */  \
+void AGCBANK(_set_scale)(AGCBANK() _q,                                      \
+                         T         _scale);                                 \
+                                                                            \
+/* Get output scale                                                     */  \
+T AGCBANK(_get_scale)(AGCBANK() _q);                                        \
+                                                                            \
+/* Lock gain control for a single channel; the gain is applied but no   */  \
+/* longer updated for that channel                                      */  \
+void AGCBANK(_lock)(AGCBANK()    _q,                                        \
+                    unsigned int _channel);                                 \
+                                                                            \
+/* Unlock gain control for a single channel                             */  \
+void AGCBANK(_unlock)(AGCBANK()    _q,                                      \
+                      unsigned int _channel);                               \
+                                                                            \
+/* Is gain control locked for a particular channel?                     */  \
+int AGCBANK(_is_locked)(AGCBANK()    _q,                                    \
+                        unsigned int _channel);                             \
+                                                                            \
+/* Lock gain control for all channels                                   */  \
+void AGCBANK(_lock_all)(AGCBANK() _q);                                      \
+                                                                            \
+/* Unlock gain control for all channels                                 */  \
+void AGCBANK(_unlock_all)(AGCBANK() _q);                                    \
+                                                                            \
+/* Get estimated signal level for a channel (dB)                        */  \
+float AGCBANK(_get_rssi)(AGCBANK()    _q,                                   \
+                         unsigned int _channel);                            \
+                                                                            \
+/* Get internal gain for a channel                                      */  \
+float AGCBANK(_get_gain)(AGCBANK()    _q,                                   \
+                         unsigned int _channel);                            \
+                                                                            \
+/* Set internal gain for a channel                                      */  \
+void AGCBANK(_set_gain)(AGCBANK()    _q,                                    \
+                        unsigned int _channel,                              \
+                        float        _gain);                                \
+                                                                            \
+/* Execute gain control on one channel-interleaved sample row           */  \
+/*  _q  : automatic gain control bank object                            */  \
+/*  _x  : input sample array,  [size: num_channels x 1]                 */  \
+/*  _y  : output sample array, [size: num_channels x 1]                 */  \
+void AGCBANK(_execute)(AGCBANK() _q,                                        \
+                       TC *      _x,                                        \
+                       TC *      _y);                                       \
+                                                                            \
+/* Execute gain control on a block of channel-interleaved samples,      */  \
+/* x[i*num_channels + ch] holding sample i of channel ch                */  \
+/*  _q  : automatic gain control bank object                            */  \
+/*  _x  : input data array,  [size: _n*num_channels x 1]                */  \
+/*  _n  : number of input, output sample rows                           */  \
+/*  _y  : output data array, [size: _n*num_channels x 1]                */  \
+void AGCBANK(_execute_block)(AGCBANK()    _q,                               \
+                             TC *         _x,                               \
+                             unsigned int _n,                               \
+                             TC *         _y);                              \
+
+// Define agcbank APIs
+LIQUID_AGCBANK_DEFINE_API(LIQUID_AGCBANK_MANGLE_CRCF, float, liquid_float_complex)
+LIQUID_AGCBANK_DEFINE_API(LIQUID_AGCBANK_MANGLE_RRRF, float, float)
+
+
 
 //
 // MODULE : audio
@@ -296,11 +436,128 @@ float           cvsd_decode(cvsd _q, unsigned char _bit);
 void cvsd_encode8(cvsd _q, float * _audio, unsigned char * _data);
 void cvsd_decode8(cvsd _q, unsigned char _data, float * _audio);
 
+// encode/decode block of samples, eight samples per byte
+//  _audio  :   audio sample array [size: 8*_n x 1]
+//  _n      :   number of data bytes
+//  _data   :   data array [size: _n x 1]
+void cvsd_encode_block(cvsd _q, float * _audio, unsigned int _n, unsigned char * _data);
+void cvsd_decode_block(cvsd _q, unsigned char * _data, unsigned int _n, float * _audio);
+
+
+// CVSD codec bank: many independent streams processed in parallel
+typedef struct cvsdbank_s * cvsdbank;
+
+// create cvsd codec bank object
+//  _num_bits       :   number of adjacent bits to observe (4 recommended)
+//  _zeta           :   slope adjustment multiplier (1.5 recommended)
+//  _alpha          :   pre-/post-emphasis filter coefficient (0.9 recommended)
+//  _num_channels   :   number of streams processed in parallel
+cvsdbank cvsdbank_create(unsigned int _num_bits,
+                         float        _zeta,
+                         float        _alpha,
+                         unsigned int _num_channels);
+
+// destroy cvsd codec bank object
+void cvsdbank_destroy(cvsdbank _q);
+
+// print cvsd codec bank object parameters
+void cvsdbank_print(cvsdbank _q);
+
+// reset all channel states
+void cvsdbank_reset(cvsdbank _q);
+
+// get number of channels
+unsigned int cvsdbank_get_num_channels(cvsdbank _q);
+
+// encode/decode eight channel-interleaved sample rows, one byte per channel
+//  _audio  :   audio samples [size: 8 x num_channels], channel-interleaved
+//  _data   :   data array [size: num_channels x 1]
+void cvsdbank_encode(cvsdbank _q, float * _audio, unsigned char * _data);
+void cvsdbank_decode(cvsdbank _q, unsigned char * _data, float * _audio);
+
 
 //
 // MODULE : buffer
 //
 
+// burst buffer
+#define LIQUID_BBUFFER_MANGLE_FLOAT(name)  LIQUID_CONCAT(bbufferf,  name)
+#define LIQUID_BBUFFER_MANGLE_CFLOAT(name) LIQUID_CONCAT(bbuffercf, name)
+
+// large macro
+//   BBUFFER : name-mangling macro
+//   T       : data type
+#define LIQUID_BBUFFER_DEFINE_API(BBUFFER,T)                                \
+                                                                            \
+/* Burst buffer object: a large circular sample arena where detectors   */  \
+/* acquire zero-copy, reference-counted [start,length] slice handles    */  \
+/* which downstream workers process in place and release; samples       */  \
+/* covered by a live slice are protected from being overwritten         */  \
+typedef struct BBUFFER(_s) * BBUFFER();                                     \
+                                                                            \
+/* Create burst buffer object                                           */  \
+/*  _max_size      : arena capacity [samples], _max_size > 0            */  \
+/*  _max_slice_len : maximum slice length,                              */  \
+/*                   0 < _max_slice_len <= _max_size                    */  \
+BBUFFER() BBUFFER(_create)(unsigned int _max_size,                          \
+                           unsigned int _max_slice_len);                    \
+                                                                            \
+/* Destroy burst buffer object, freeing all internal memory             */  \
+void BBUFFER(_destroy)(BBUFFER() _q);                                       \
+                                                                            \
+/* Print burst buffer object properties to stdout                       */  \
+void BBUFFER(_print)(BBUFFER() _q);                                         \
+                                                                            \
+/* Reset burst buffer, discarding all samples and slices                */  \
+void BBUFFER(_reset)(BBUFFER() _q);                                         \
+                                                                            \
+/* Get total number of samples written to the buffer; slice positions   */  \
+/* are expressed as absolute sample indices against this counter        */  \
+unsigned long int BBUFFER(_get_num_written)(BBUFFER() _q);                  \
+                                                                            \
+/* Get number of live (unreleased) slices                               */  \
+unsigned int BBUFFER(_get_num_slices)(BBUFFER() _q);                        \
+                                                                            \
+/* Append block of samples to the arena. The write aborts if it would   */  \
+/* overrun samples still covered by an unreleased slice.                */  \
+/*  _q      : burst buffer object                                       */  \
+/*  _v      : sample array [size: _n x 1]                               */  \
+/*  _n      : number of samples                                         */  \
+void BBUFFER(_write)(BBUFFER()    _q,                                       \
+                     T *          _v,                                       \
+                     unsigned int _n);                                      \
+                                                                            \
+/* Acquire slice handle on a range of buffered samples; the samples     */  \
+/* are protected from being overwritten until every reference to the    */  \
+/* slice has been released                                              */  \
+/*  _q      : burst buffer object                                       */  \
+/*  _start  : absolute index of first sample                            */  \
+/*  _len    : slice length, 0 < _len <= max_slice_len                   */  \
+unsigned int BBUFFER(_slice_acquire)(BBUFFER()         _q,                  \
+                                     unsigned long int _start,              \
+                                     unsigned int      _len);               \
+                                                                            \
+/* Get pointer to a slice's samples (zero-copy, within the arena);      */  \
+/* valid until the last reference to the slice is released              */  \
+T * BBUFFER(_slice_data)(BBUFFER()    _q,                                   \
+                         unsigned int _id);                                 \
+                                                                            \
+/* Get slice length                                                     */  \
+unsigned int BBUFFER(_slice_len)(BBUFFER()    _q,                           \
+                                 unsigned int _id);                         \
+                                                                            \
+/* Add reference to slice (e.g. handing it to another worker)           */  \
+void BBUFFER(_slice_retain)(BBUFFER()    _q,                                \
+                            unsigned int _id);                              \
+                                                                            \
+/* Release reference to slice; once the last reference is dropped the   */  \
+/* samples may be overwritten by subsequent writes                      */  \
+void BBUFFER(_slice_release)(BBUFFER()    _q,                               \
+                             unsigned int _id);                             \
+
+LIQUID_BBUFFER_DEFINE_API(LIQUID_BBUFFER_MANGLE_FLOAT,  float)
+LIQUID_BBUFFER_DEFINE_API(LIQUID_BBUFFER_MANGLE_CFLOAT, liquid_float_complex)
+
 // circular buffer
 #define LIQUID_CBUFFER_MANGLE_FLOAT(name)  LIQUID_CONCAT(cbufferf,  name)
 #define LIQUID_CBUFFER_MANGLE_CFLOAT(name) LIQUID_CONCAT(cbuffercf, name)
@@ -326,6 +583,13 @@ CBUFFER() CBUFFER(_create)(unsigned int _max_size);                         \
 CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,                      \
                                unsigned int _max_read);                     \
                                                                             \
+/* Create circular buffer object in lock-free single-producer,          */  \
+/* single-consumer mode; one thread may write (push, write) while       */  \
+/* another concurrently reads (pop, read, release) without locks.       */  \
+/* The requested size is rounded up to the next power of two.           */  \
+/*  _max_size  : minimum buffer size, _max_size > 0                     */  \
+CBUFFER() CBUFFER(_create_spsc)(unsigned int _max_size);                    \
+                                                                            \
 /* Destroy cbuffer object, freeing all internal memory                  */  \
 void CBUFFER(_destroy)(CBUFFER() _q);                                       \
                                                                             \
@@ -367,6 +631,29 @@ void CBUFFER(_write)(CBUFFER()    _q,                                       \
                      T *          _v,                                       \
                      unsigned int _n);                                      \
                                                                             \
+/* Reserve a contiguous writable region inside the buffer, returning a  */  \
+/* pointer the caller may fill directly (e.g. as a DMA target) without  */  \
+/* an intermediate copy; no samples become visible to the reader until  */  \
+/* they are committed. The region may be smaller than requested if the  */  \
+/* buffer is nearly full or the internal write position is close to     */  \
+/* wrapping; call again after committing to obtain the next region      */  \
+/*  _q              : circular buffer object                            */  \
+/*  _num_requested  : number of elements requested                      */  \
+/*  _v              : output pointer to writable region                 */  \
+/*  _num_reserved   : number of elements writable through _v            */  \
+void CBUFFER(_reserve)(CBUFFER()      _q,                                   \
+                       unsigned int   _num_requested,                       \
+                       T **           _v,                                   \
+                       unsigned int * _num_reserved);                       \
+                                                                            \
+/* Commit _n samples previously filled through the pointer returned by  */  \
+/* reserve(), making them available to the reader; _n may be smaller    */  \
+/* than the reserved region size but cannot exceed it                   */  \
+/*  _q : circular buffer object                                         */  \
+/*  _n : number of elements to commit                                   */  \
+void CBUFFER(_commit)(CBUFFER()    _q,                                      \
+                      unsigned int _n);                                     \
+                                                                            \
 /* Remove and return a single element from the buffer by setting the    */  \
 /* value of the output sample pointed to by _v                          */  \
 /*  _q  : circular buffer object                                        */  \
@@ -760,6 +1047,34 @@ void DOTPROD(_print)(DOTPROD() _q);                                         \
 void DOTPROD(_execute)(DOTPROD() _q,                                        \
                        TI *      _x,                                        \
                        TO *      _y);                                       \
+                                                                            \
+/* Execute batch of dot products, applying several coefficient sets to  */  \
+/* the same input array. The input window is loaded once and re-used    */  \
+/* across coefficient sets which reduces memory traffic considerably    */  \
+/* when many filters share one input (e.g. polyphase filter banks).     */  \
+/*  _q      : array of dotprod objects [size: _batch x 1]               */  \
+/*  _batch  : number of dotprod objects                                 */  \
+/*  _x      : input array, at least as long as longest dotprod object   */  \
+/*  _y      : output sample array [size: _batch x 1]                    */  \
+void DOTPROD(_execute_batch)(DOTPROD() *  _q,                               \
+                             unsigned int _batch,                           \
+                             TI *         _x,                               \
+                             TO *         _y);                              \
+                                                                            \
+/* Execute two dot products against the same input array in a single    */  \
+/* fused pass: the input window is loaded once and applied to both      */  \
+/* coefficient sets (e.g. matched and derivative matched filters in     */  \
+/* timing recovery).                                                    */  \
+/*  _q0     : first dotprod object                                      */  \
+/*  _q1     : second dotprod object                                     */  \
+/*  _x      : input array, at least as long as both objects             */  \
+/*  _y0     : first output sample pointer                               */  \
+/*  _y1     : second output sample pointer                              */  \
+void DOTPROD(_execute_pair)(DOTPROD() _q0,                                  \
+                            DOTPROD() _q1,                                  \
+                            TI *      _x,                                   \
+                            TO *      _y0,                                  \
+                            TO *      _y1);                                 \
 
 LIQUID_DOTPROD_DEFINE_API(LIQUID_DOTPROD_MANGLE_RRRF,
                           float,
@@ -776,6 +1091,71 @@ LIQUID_DOTPROD_DEFINE_API(LIQUID_DOTPROD_MANGLE_CRCF,
                           float,
                           liquid_float_complex)
 
+// fixed-point dot products for embedded targets: samples and
+// coefficients in Q.15 (q16) or Q.31 (q32) format with a wide internal
+// accumulator; results are rounded back to the sample format
+#define LIQUID_DOTPROD_MANGLE_RRRQ16(name) LIQUID_CONCAT(dotprod_rrrq16,name)
+#define LIQUID_DOTPROD_MANGLE_RRRQ32(name) LIQUID_CONCAT(dotprod_rrrq32,name)
+
+LIQUID_DOTPROD_DEFINE_API(LIQUID_DOTPROD_MANGLE_RRRQ16,
+                          int16_t,
+                          int16_t,
+                          int16_t)
+
+LIQUID_DOTPROD_DEFINE_API(LIQUID_DOTPROD_MANGLE_RRRQ32,
+                          int32_t,
+                          int32_t,
+                          int32_t)
+
+// complex fixed-point dot product: interleaved i/q samples in Q.15
+// against real Q.15 coefficients, matching the sc16 sample format of
+// most radio front ends; _n counts complex samples, so the input array
+// spans 2*_n words and the output occupies two words (i then q)
+#define LIQUID_DOTPROD_MANGLE_CRCQ16(name) LIQUID_CONCAT(dotprod_crcq16,name)
+
+LIQUID_DOTPROD_DEFINE_API(LIQUID_DOTPROD_MANGLE_CRCQ16,
+                          int16_t,
+                          int16_t,
+                          int16_t)
+
+// split-complex (planar) storage: separate in-phase/quadrature planes
+// keep SIMD lanes homogeneous in the complex dot-product kernel and let
+// planar pipelines avoid repeated (de)interleaving
+
+// split interleaved complex array into i/q planes
+//  _x  : input interleaved array [size: _n x 1]
+//  _n  : array length
+//  _xi : output in-phase plane [size: _n x 1]
+//  _xq : output quadrature plane [size: _n x 1]
+void liquid_complexf_deinterleave(liquid_float_complex * _x,
+                                  unsigned int           _n,
+                                  float *                _xi,
+                                  float *                _xq);
+
+// combine i/q planes into interleaved complex array
+//  _xi : input in-phase plane [size: _n x 1]
+//  _xq : input quadrature plane [size: _n x 1]
+//  _n  : array length
+//  _y  : output interleaved array [size: _n x 1]
+void liquid_complexf_interleave(float *                _xi,
+                                float *                _xq,
+                                unsigned int           _n,
+                                liquid_float_complex * _y);
+
+// compute complex dot product on split-complex (planar) operands
+//  _hi : coefficient in-phase plane [size: _n x 1]
+//  _hq : coefficient quadrature plane [size: _n x 1]
+//  _xi : sample in-phase plane [size: _n x 1]
+//  _xq : sample quadrature plane [size: _n x 1]
+//  _n  : dot product length
+//  _y  : output result pointer
+void dotprod_cccf_soa_run(float *                _hi,
+                          float *                _hq,
+                          float *                _xi,
+                          float *                _xq,
+                          unsigned int           _n,
+                          liquid_float_complex * _y);
+
 //
 // sum squared methods
 //
@@ -786,6 +1166,73 @@ float liquid_sumsqf(float *      _v,
 float liquid_sumsqcf(liquid_float_complex * _v,
                      unsigned int           _n);
 
+// sum of squares of Q.15 values, accumulated in 64 bits and normalized
+// back to unit full scale; for interleaved complex (sc16) input pass
+// twice the number of complex samples
+float liquid_sumsqq16(int16_t *    _v,
+                      unsigned int _n);
+
+//
+// external compute backend (e.g. GPU offload)
+//
+
+// Interface for an out-of-tree compute backend supplying the library's
+// most regular batched kernels. Once registered, calls whose total
+// problem size reaches the corresponding threshold are routed through
+// the backend; a callback may return non-zero to decline a particular
+// call, in which case the built-in implementation runs instead. With
+// no backend registered the library behaves exactly as before.
+typedef struct {
+    // opaque pointer passed to each callback
+    void * context;
+
+    // batched one-dimensional complex transform
+    //  _context    : opaque backend context
+    //  _direction  : LIQUID_FFT_FORWARD or LIQUID_FFT_BACKWARD
+    //  _nfft       : transform size
+    //  _batch      : number of transforms
+    //  _x          : input array [size: _batch x _x_stride]
+    //  _x_stride   : input stride between transforms
+    //  _y          : output array [size: _batch x _y_stride]
+    //  _y_stride   : output stride between transforms
+    // return 0 on success, non-zero to fall back
+    int (*fft_execute_batch)(void *                 _context,
+                             int                    _direction,
+                             unsigned int           _nfft,
+                             unsigned int           _batch,
+                             liquid_float_complex * _x,
+                             unsigned int           _x_stride,
+                             liquid_float_complex * _y,
+                             unsigned int           _y_stride);
+
+    // minimum total problem size (_nfft * _batch) routed to the
+    // fft_execute_batch callback
+    unsigned int fft_threshold;
+
+    // batch of structured complex dot products against a common input
+    // array (the channelizer kernel); the backend may key device-side
+    // coefficient state off the object pointers
+    //  _context    : opaque backend context
+    //  _q          : array of dot product objects [size: _batch x 1]
+    //  _batch      : number of dot product objects
+    //  _x          : input array, at least as long as longest object
+    //  _y          : output array [size: _batch x 1]
+    // return 0 on success, non-zero to fall back
+    int (*dotprod_cccf_execute_batch)(void *                 _context,
+                                      dotprod_cccf *         _q,
+                                      unsigned int           _batch,
+                                      liquid_float_complex * _x,
+                                      liquid_float_complex * _y);
+
+    // minimum total problem size (object length times _batch) routed
+    // to the dotprod_cccf_execute_batch callback
+    unsigned int dotprod_threshold;
+} liquid_backend;
+
+// register external compute backend, copying the interface structure;
+// pass NULL to restore built-in implementations
+void liquid_backend_register(liquid_backend * _backend);
+
 
 //
 // MODULE : equalization
@@ -906,12 +1353,49 @@ void EQLMS(_step)(EQLMS() _q,                                               \
 void EQLMS(_step_blind)(EQLMS() _q,                                         \
                         T       _d_hat);                                    \
                                                                             \
+/* Step through a block of training cycles (block LMS). The filter      */  \
+/* output is computed for each input sample, but the tap gradient is    */  \
+/* accumulated across the block and applied as a single update with     */  \
+/* the normalization (signal energy estimate) computed once per block.  */  \
+/* With _n = 1 this is equivalent to push(), execute(), step().         */  \
+/*  _q      :   equalizer object                                        */  \
+/*  _x      :   received sample array, [size: _n x 1]                   */  \
+/*  _d      :   desired output array, [size: _n x 1]                    */  \
+/*  _n      :   input array length                                      */  \
+/*  _d_hat  :   output sample array, [size: _n x 1]                     */  \
+void EQLMS(_step_block)(EQLMS()      _q,                                    \
+                        T *          _x,                                    \
+                        T *          _d,                                    \
+                        unsigned int _n,                                    \
+                        T *          _d_hat);                               \
+                                                                            \
 /* Get equalizer's internal coefficients                                */  \
 /*  _q      :   equalizer object                                        */  \
 /*  _w      :   weights, [size: _p x 1]                                 */  \
 void EQLMS(_get_weights)(EQLMS() _q,                                        \
                          T *     _w);                                       \
                                                                             \
+/* Get size of serialized equalizer state in bytes                      */  \
+unsigned int EQLMS(_get_state_size)(EQLMS() _q);                            \
+                                                                            \
+/* Save converged equalizer weights into buffer for later warm start    */  \
+/*  _q       : equalizer object                                         */  \
+/*  _buf     : output buffer, [size: _buf_len x 1]                      */  \
+/*  _buf_len : buffer length, must match EQLMS(_get_state_size)         */  \
+void EQLMS(_save_state)(EQLMS()         _q,                                 \
+                        unsigned char * _buf,                               \
+                        unsigned int    _buf_len);                          \
+                                                                            \
+/* Restore equalizer weights previously saved with EQLMS(_save_state),  */  \
+/* skipping cold-start convergence; the object must have the same       */  \
+/* filter length as the one the state was saved from                    */  \
+/*  _q       : equalizer object                                         */  \
+/*  _buf     : input buffer, [size: _buf_len x 1]                       */  \
+/*  _buf_len : buffer length, must match EQLMS(_get_state_size)         */  \
+void EQLMS(_restore_state)(EQLMS()         _q,                              \
+                           unsigned char * _buf,                            \
+                           unsigned int    _buf_len);                       \
+                                                                            \
 /* Train equalizer object on group of samples                           */  \
 /*  _q      :   equalizer object                                        */  \
 /*  _w      :   input/output weights,  [size: _p x 1]                   */  \
@@ -946,6 +1430,14 @@ typedef struct EQRLS(_s) * EQRLS();                                         \
 EQRLS() EQRLS(_create)(T *          _h,                                     \
                        unsigned int _n);                                    \
                                                                             \
+/* Create RLS EQ using the dichotomous coordinate descent (DCD) engine, */  \
+/* replacing the O(_n^2) inverse-correlation recursion with             */  \
+/* power-of-two coordinate updates at near-LMS per-symbol cost          */  \
+/*  _h : filter coefficients; set to NULL for {1,0,0...},[size: _n x 1] */  \
+/*  _n : filter length                                                  */  \
+EQRLS() EQRLS(_create_dcd)(T *          _h,                                 \
+                           unsigned int _n);                                \
+                                                                            \
 /* Re-create EQ initialized with external coefficients                  */  \
 /*  _q :   equalizer object                                             */  \
 /*  _h :   filter coefficients (NULL for {1,0,0...}), [size: _n x 1]    */  \
@@ -1009,6 +1501,157 @@ void EQRLS(_train)(EQRLS()      _q,                                         \
 LIQUID_EQRLS_DEFINE_API(LIQUID_EQRLS_MANGLE_RRRF, float)
 LIQUID_EQRLS_DEFINE_API(LIQUID_EQRLS_MANGLE_CCCF, liquid_float_complex)
 
+//
+// frequency-domain block LMS equalizer (overlap-save); filtering and
+// adaptation operate on blocks of _h_len samples using transforms of
+// size 2*_h_len with per-bin complex gain adaptation, replacing the
+// O(_h_len) per-sample cost of eqlms with O(log _h_len) for long
+// equalizers
+//
+typedef struct eqfde_cccf_s * eqfde_cccf;
+
+// create frequency-domain equalizer object
+//  _h_len  : equalizer length (number of time-domain taps), _h_len > 0
+eqfde_cccf eqfde_cccf_create(unsigned int _h_len);
+
+// destroy equalizer object, freeing all internal memory
+void eqfde_cccf_destroy(eqfde_cccf _q);
+
+// reset equalizer object: pass-through response, cleared input history
+void eqfde_cccf_reset(eqfde_cccf _q);
+
+// print equalizer object internals
+void eqfde_cccf_print(eqfde_cccf _q);
+
+// get block length (samples consumed/produced per block)
+unsigned int eqfde_cccf_get_block_len(eqfde_cccf _q);
+
+// get learning rate of equalizer
+float eqfde_cccf_get_bw(eqfde_cccf _q);
+
+// set learning rate of equalizer
+//  _q      : equalizer object
+//  _mu     : LMS learning rate (should be near 0), _mu > 0
+void eqfde_cccf_set_bw(eqfde_cccf _q,
+                       float      _mu);
+
+// retrieve internal time-domain filter coefficients
+//  _q      : equalizer object
+//  _w      : output weights [size: _h_len x 1]
+void eqfde_cccf_get_weights(eqfde_cccf            _q,
+                            liquid_float_complex * _w);
+
+// filter a single block of _h_len samples without adaptation
+//  _q      : equalizer object
+//  _x      : input sample block [size: _h_len x 1]
+//  _y      : output sample block [size: _h_len x 1]
+void eqfde_cccf_execute(eqfde_cccf             _q,
+                        liquid_float_complex * _x,
+                        liquid_float_complex * _y);
+
+// filter a group of blocks without adaptation
+//  _q      : equalizer object
+//  _x      : input sample array [size: _n x 1]
+//  _n      : input array length (multiple of block length)
+//  _y      : output sample array [size: _n x 1]
+void eqfde_cccf_execute_block(eqfde_cccf             _q,
+                              liquid_float_complex * _x,
+                              unsigned int           _n,
+                              liquid_float_complex * _y);
+
+// step through one block of equalizer training: filter the block, then
+// update the per-bin gains from the error using normalized
+// frequency-domain gradient descent
+//  _q      : equalizer object
+//  _x      : received sample block [size: _h_len x 1]
+//  _d      : desired output block [size: _h_len x 1]
+//  _d_hat  : output sample block [size: _h_len x 1]
+void eqfde_cccf_step(eqfde_cccf             _q,
+                     liquid_float_complex * _x,
+                     liquid_float_complex * _d,
+                     liquid_float_complex * _d_hat);
+
+// step through a group of blocks of equalizer training
+//  _q      : equalizer object
+//  _x      : received sample array [size: _n x 1]
+//  _d      : desired output array [size: _n x 1]
+//  _n      : input array length (multiple of block length)
+//  _d_hat  : output sample array [size: _n x 1]
+void eqfde_cccf_step_block(eqfde_cccf             _q,
+                           liquid_float_complex * _x,
+                           liquid_float_complex * _d,
+                           unsigned int           _n,
+                           liquid_float_complex * _d_hat);
+
+//
+// decision-feedback equalizer (DFE) with LMS adaptation; the
+// feedforward section filters received samples and the feedback
+// section filters past decisions, with both sections adapted jointly
+// in a single pass from the common error. The push/execute/step flow
+// matches eqlms_cccf, with the decision entering the feedback buffer
+// inside step().
+//
+typedef struct eqdfe_cccf_s * eqdfe_cccf;
+
+// create decision-feedback equalizer object
+//  _nff    : feedforward filter length (received samples), _nff > 0
+//  _nfb    : feedback filter length (past decisions)
+eqdfe_cccf eqdfe_cccf_create(unsigned int _nff,
+                             unsigned int _nfb);
+
+// destroy equalizer object, freeing all internal memory
+void eqdfe_cccf_destroy(eqdfe_cccf _q);
+
+// reset equalizer object: feedforward delta response, cleared feedback
+void eqdfe_cccf_reset(eqdfe_cccf _q);
+
+// print equalizer object internals
+void eqdfe_cccf_print(eqdfe_cccf _q);
+
+// get learning rate of equalizer
+float eqdfe_cccf_get_bw(eqdfe_cccf _q);
+
+// set learning rate of equalizer
+//  _q      : equalizer object
+//  _mu     : LMS learning rate (should be near 0), _mu > 0
+void eqdfe_cccf_set_bw(eqdfe_cccf _q,
+                       float      _mu);
+
+// push received sample into equalizer internal buffer
+//  _q      : equalizer object
+//  _x      : received sample
+void eqdfe_cccf_push(eqdfe_cccf           _q,
+                     liquid_float_complex _x);
+
+// execute internal dot products over both sections and return result
+//  _q      : equalizer object
+//  _y      : output sample
+void eqdfe_cccf_execute(eqdfe_cccf             _q,
+                        liquid_float_complex * _y);
+
+// step through one cycle of equalizer training: adapt both sections
+// jointly from the common error, then feed the decision back
+//  _q      : equalizer object
+//  _d      : desired output (decision)
+//  _d_hat  : actual output
+void eqdfe_cccf_step(eqdfe_cccf           _q,
+                     liquid_float_complex _d,
+                     liquid_float_complex _d_hat);
+
+// step through one cycle of equalizer training (blind)
+//  _q      : equalizer object
+//  _d_hat  : actual output
+void eqdfe_cccf_step_blind(eqdfe_cccf           _q,
+                           liquid_float_complex _d_hat);
+
+// get equalizer's internal coefficients
+//  _q      : equalizer object
+//  _wf     : feedforward weights, [size: _nff x 1]
+//  _wb     : feedback weights, [size: _nfb x 1]
+void eqdfe_cccf_get_weights(eqdfe_cccf             _q,
+                            liquid_float_complex * _wf,
+                            liquid_float_complex * _wb);
+
 
 
 
@@ -1302,6 +1945,12 @@ typedef struct interleaver_s * interleaver;
 //   _n     : number of bytes
 interleaver interleaver_create(unsigned int _n);
 
+// re-create interleaver for a new length, re-planning the internal
+// permutation tables in place (growing them only as necessary)
+//   _q     : old interleaver object
+//   _n     : number of bytes
+interleaver interleaver_recreate(interleaver _q, unsigned int _n);
+
 // destroy interleaver object
 void interleaver_destroy(interleaver _q);
 
@@ -1360,6 +2009,10 @@ typedef enum {
     LIQUID_FFT_FORWARD  =  +1,  // complex one-dimensional FFT
     LIQUID_FFT_BACKWARD =  -1,  // complex one-dimensional inverse FFT
 
+    // real-input one-dimensional transforms (conjugate symmetric)
+    LIQUID_FFT_REAL_FORWARD  = 2,   // real-to-complex FFT
+    LIQUID_FFT_REAL_BACKWARD = 3,   // complex-to-real inverse FFT
+
     // discrete cosine transforms
     LIQUID_FFT_REDFT00  =  10,  // real one-dimensional DCT-I
     LIQUID_FFT_REDFT10  =  11,  // real one-dimensional DCT-II
@@ -1377,6 +2030,12 @@ typedef enum {
     LIQUID_FFT_IMDCT    =  31,  // IMDCT
 } liquid_fft_type;
 
+// transform flags: attach to the _flags argument of fft_create_plan();
+// threaded execution is opt-in, applies to large mixed-radix plans, and
+// is silently ignored when the library is built without pthread support
+#define LIQUID_FFT_FLAG_THREADED       (1<<8)           // split execution across worker threads
+#define LIQUID_FFT_FLAG_NUM_THREADS(N) (((N)&0xf)<<12)  // optional worker count (default: 4)
+
 #define LIQUID_FFT_MANGLE_FLOAT(name) LIQUID_CONCAT(fft,name)
 
 // Macro    :   FFT
@@ -1400,6 +2059,54 @@ FFT(plan) FFT(_create_plan)(unsigned int _n,                                \
                             int          _dir,                              \
                             int          _flags);                           \
                                                                             \
+/* Create complex one-dimensional transform pruned to a fixed set of   */  \
+/* nonzero input indices. The transform is computed only from the      */  \
+/* declared inputs (any value outside the set is ignored), with cost   */  \
+/* scaling with the number of occupied inputs instead of the transform */  \
+/* size; useful for sparse spectra such as narrowband-in-wideband OFDM */  \
+/* symbol generation. The output is full length and matches a regular  */  \
+/* transform of the same input with the remaining entries set to zero. */  \
+/*  _n              :   transform size                                 */  \
+/*  _x              :   pointer to input array  [size: _n x 1]         */  \
+/*  _y              :   pointer to output array [size: _n x 1]         */  \
+/*  _dir            :   direction (e.g. LIQUID_FFT_FORWARD)            */  \
+/*  _index          :   nonzero input indices [size: _num_nonzero x 1] */  \
+/*  _num_nonzero    :   number of nonzero inputs, in [1, _n]           */  \
+/*  _flags          :   options, optimization                          */  \
+FFT(plan) FFT(_create_plan_pruned)(unsigned int   _n,                       \
+                                   TC *           _x,                       \
+                                   TC *           _y,                       \
+                                   int            _dir,                     \
+                                   unsigned int * _index,                   \
+                                   unsigned int   _num_nonzero,             \
+                                   int            _flags);                  \
+                                                                            \
+/* Create real-to-complex one-dimensional transform, exploiting the     */  \
+/* conjugate symmetry of real input for roughly twice the throughput    */  \
+/* and half the internal memory of a regular complex transform. The     */  \
+/* full _n-point (conjugate-symmetric) spectrum is written to the       */  \
+/* output array.                                                        */  \
+/*  _n      :   transform size                                          */  \
+/*  _x      :   pointer to input array  [size: _n x 1]                  */  \
+/*  _y      :   pointer to output array [size: _n x 1]                  */  \
+/*  _flags  :   options, optimization                                   */  \
+FFT(plan) FFT(_create_plan_r2c)(unsigned int _n,                            \
+                                T *          _x,                            \
+                                TC *         _y,                            \
+                                int          _flags);                       \
+                                                                            \
+/* Create complex-to-real one-dimensional inverse transform; the input  */  \
+/* spectrum is assumed conjugate symmetric. As with the regular complex */  \
+/* inverse transform the output is not normalized by the size.          */  \
+/*  _n      :   transform size                                          */  \
+/*  _x      :   pointer to input array  [size: _n x 1]                  */  \
+/*  _y      :   pointer to output array [size: _n x 1]                  */  \
+/*  _flags  :   options, optimization                                   */  \
+FFT(plan) FFT(_create_plan_c2r)(unsigned int _n,                            \
+                                TC *         _x,                            \
+                                T *          _y,                            \
+                                int          _flags);                       \
+                                                                            \
 /* Create real-to-real one-dimensional transform                        */  \
 /*  _n      :   transform size                                          */  \
 /*  _x      :   pointer to input array  [size: _n x 1]                  */  \
@@ -1423,6 +2130,22 @@ void FFT(_print_plan)(FFT(plan) _p);                                        \
 /* Run the transform                                                    */  \
 void FFT(_execute)(FFT(plan) _p);                                           \
                                                                             \
+/* Run a batch of contiguous same-size transforms with a single plan,   */  \
+/* amortizing twiddle and index table loads across transforms. Only     */  \
+/* regular complex one-dimensional plans are supported.                 */  \
+/*  _p          : fft plan                                              */  \
+/*  _batch      : number of transforms                                  */  \
+/*  _x          : input array [size: _batch x _x_stride]                */  \
+/*  _x_stride   : input stride between transforms, _x_stride >= nfft    */  \
+/*  _y          : output array [size: _batch x _y_stride]               */  \
+/*  _y_stride   : output stride between transforms, _y_stride >= nfft   */  \
+void FFT(_execute_batch)(FFT(plan)    _p,                                   \
+                         unsigned int _batch,                               \
+                         TC *         _x,                                   \
+                         unsigned int _x_stride,                            \
+                         TC *         _y,                                   \
+                         unsigned int _y_stride);                           \
+                                                                            \
 /* Perform n-point FFT allocating plan internally                       */  \
 /*  _nfft   : fft size                                                  */  \
 /*  _x      : input array [size: _nfft x 1]                             */  \
@@ -1568,6 +2291,12 @@ unsigned long long int SPGRAM(_get_num_transforms)(SPGRAM() _q);            \
 /* Get number of transforms processed since object was created          */  \
 unsigned long long int SPGRAM(_get_num_transforms_total)(SPGRAM() _q);      \
                                                                             \
+/* Get accumulation epoch; the epoch increments whenever the            */  \
+/* accumulated spectrum changes (transform or reset), so pollers can    */  \
+/* compare against a saved value and skip output conversion entirely    */  \
+/* when the spectrum is unchanged                                       */  \
+unsigned long long int SPGRAM(_get_epoch)(SPGRAM() _q);                     \
+                                                                            \
 /* Push a single sample into the object, executing internal transform   */  \
 /* as necessary.                                                        */  \
 /*  _q  : spgram object                                                 */  \
@@ -1591,6 +2320,46 @@ void SPGRAM(_write)(SPGRAM()     _q,                                        \
 void SPGRAM(_get_psd)(SPGRAM() _q,                                          \
                       T *      _X);                                         \
                                                                             \
+/* Compute spectral periodogram output only if the accumulated          */  \
+/* spectrum has changed since the caller's saved epoch, avoiding the    */  \
+/* per-bin dB conversion for unchanged spectra. Returns 1 if the        */  \
+/* output was updated, 0 if the spectrum was unchanged.                 */  \
+/*  _q      : spgram object                                             */  \
+/*  _epoch  : caller's saved epoch, updated on conversion (set to 0     */  \
+/*            before the first call)                                    */  \
+/*  _X      : output spectrum (dB), [size: _nfft x 1]                   */  \
+int SPGRAM(_get_psd_delta)(SPGRAM()                 _q,                     \
+                           unsigned long long int * _epoch,                 \
+                           T *                      _X);                    \
+                                                                            \
+/* Get size of exported accumulation state [bytes]                      */  \
+unsigned int SPGRAM(_get_accum_size)(SPGRAM() _q);                          \
+                                                                            \
+/* Export raw linear accumulation state (power accumulation buffer and  */  \
+/* sample/transform counts) into a compact binary buffer, e.g. for      */  \
+/* shipping partial periodograms from distributed monitoring nodes.     */  \
+/* The object must be in accumulation mode (alpha of -1). Returns 0 on  */  \
+/* success, anything other than 0 for failure.                          */  \
+/*  _q       : spgram object                                            */  \
+/*  _buf     : output buffer, [size: _buf_len x 1]                      */  \
+/*  _buf_len : buffer length, at least SPGRAM(_get_accum_size)          */  \
+int SPGRAM(_export_accum)(SPGRAM()        _q,                               \
+                          unsigned char * _buf,                             \
+                          unsigned int    _buf_len);                        \
+                                                                            \
+/* Merge previously exported accumulation state into this object by     */  \
+/* summing the linear power accumulation buffers and sample/transform   */  \
+/* counts, producing exactly the average that a single object           */  \
+/* processing all partial streams would report. Both objects must use   */  \
+/* the same transform size, window, and accumulation mode. Returns 0    */  \
+/* on success, anything other than 0 for failure.                       */  \
+/*  _q       : spgram object                                            */  \
+/*  _buf     : input buffer, [size: _buf_len x 1]                       */  \
+/*  _buf_len : buffer length, must match SPGRAM(_get_accum_size)        */  \
+int SPGRAM(_import_merge)(SPGRAM()        _q,                               \
+                          unsigned char * _buf,                             \
+                          unsigned int    _buf_len);                        \
+                                                                            \
 /* Export stand-alone gnuplot file for plotting output spectrum,        */  \
 /* returning 0 on sucess, anything other than 0 for failure             */  \
 /*  _q        : spgram object                                           */  \
@@ -1619,6 +2388,33 @@ LIQUID_SPGRAM_DEFINE_API(LIQUID_SPGRAM_MANGLE_FLOAT,
                          liquid_float_complex,
                          float)
 
+// write block of half-precision samples to spectral periodogram,
+// widening internally; see liquid_fp16tof()
+//  _q : spgram object
+//  _x : input buffer, interleaved half-precision i/q [size: 2 _n x 1]
+//  _n : input buffer length [complex samples]
+void spgramcf_write_fp16(spgramcf     _q,
+                         uint16_t *   _x,
+                         unsigned int _n);
+
+// create spgramcf object for monitoring a decimated sub-band, fusing
+// frequency translation, anti-alias filtering, and decimation into the
+// transform stage; equivalent to mixing the input down by _fc,
+// decimating by _decim, and running a standard spgramcf, with mid-band
+// levels lining up with a full-band estimate of the same input
+//  _nfft       : FFT size (resolution within the sub-band)
+//  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
+//  _window_len : window length [decimated samples], _window_len <= _nfft
+//  _delay      : delay between transforms [input samples], _delay > 0
+//  _fc         : sub-band center frequency, -0.5 <= _fc <= 0.5
+//  _decim      : decimation factor, _decim > 0
+spgramcf spgramcf_create_decim(unsigned int _nfft,
+                               int          _wtype,
+                               unsigned int _window_len,
+                               unsigned int _delay,
+                               float        _fc,
+                               unsigned int _decim);
+
 //
 // asgram : ascii spectral periodogram
 //
@@ -1691,6 +2487,24 @@ void ASGRAM(_execute)(ASGRAM() _q,                                          \
                       float * _peakval,                                     \
                       float * _peakfreq);                                   \
                                                                             \
+/* Compute spectral periodogram output from current buffer contents,    */  \
+/* reporting only the cells which changed since the last render so the  */  \
+/* caller can redraw incrementally. On the first render (and after      */  \
+/* reset) every cell is reported as changed.                            */  \
+/*  _q           : asgram object                                        */  \
+/*  _ascii       : output ASCII string [size: _nfft x 1]                */  \
+/*  _changed     : output indices of changed cells [size: _nfft x 1]    */  \
+/*  _num_changed : number of changed cells                              */  \
+/*  _peakval     : peak power spectral density value [dB]               */  \
+/*  _peakfreq    : peak power spectral density frequency                */  \
+/* returns dirty flag: 1 if any cell changed, 0 otherwise               */  \
+int ASGRAM(_execute_diff)(ASGRAM()       _q,                                \
+                          char *         _ascii,                            \
+                          unsigned int * _changed,                          \
+                          unsigned int * _num_changed,                      \
+                          float *        _peakval,                          \
+                          float *        _peakfreq);                        \
+                                                                            \
 /* Compute spectral periodogram output from current buffer contents and */  \
 /* print standard format to stdout                                      */  \
 void ASGRAM(_print)(ASGRAM() _q);                                           \
@@ -1766,6 +2580,38 @@ unsigned int SPWATERFALL(_get_num_time)(SPWATERFALL() _q);                  \
 /* Get power spectral density (PSD), size: nfft x time                  */  \
 const T * SPWATERFALL(_get_psd)(SPWATERFALL() _q);                          \
                                                                             \
+/* Enable incremental multi-resolution pyramid mode. Each level keeps   */  \
+/* the most recent 'time' spectral estimates at a power-of-two time     */  \
+/* decimation; new estimates cascade to coarser levels by pairwise      */  \
+/* log-average with constant amortized cost and bounded memory, making  */  \
+/* long monitoring runs queryable at any zoom level. While enabled the  */  \
+/* legacy consolidation buffer is bypassed.                             */  \
+/*  _q          : spwaterfall object                                    */  \
+/*  _num_levels : number of time-decimation levels, _num_levels > 0     */  \
+int SPWATERFALL(_pyramid_enable)(SPWATERFALL() _q,                          \
+                                 unsigned int  _num_levels);                \
+                                                                            \
+/* Disable pyramid mode; accumulated level buffers are retained for     */  \
+/* querying until the object is cleared or destroyed                    */  \
+int SPWATERFALL(_pyramid_disable)(SPWATERFALL() _q);                        \
+                                                                            \
+/* Get number of pyramid time-decimation levels                         */  \
+unsigned int SPWATERFALL(_pyramid_get_num_levels)(SPWATERFALL() _q);        \
+                                                                            \
+/* Get number of valid rows at a particular pyramid level; each row at  */  \
+/* level 'l' spans 2^l spectral estimates in time                       */  \
+unsigned int SPWATERFALL(_pyramid_get_num_time)(SPWATERFALL() _q,           \
+                                                unsigned int  _level);      \
+                                                                            \
+/* Get power spectral density at a particular pyramid level, copying    */  \
+/* valid rows in chronological order (oldest first)                     */  \
+/*  _q     : spwaterfall object                                         */  \
+/*  _level : pyramid level, _level < num_levels                         */  \
+/*  _psd   : output buffer, [size: num_time x nfft]                     */  \
+int SPWATERFALL(_pyramid_get_psd)(SPWATERFALL() _q,                         \
+                                  unsigned int  _level,                     \
+                                  T *           _psd);                      \
+                                                                            \
 /* Set the center frequency of the received signal.                     */  \
 /* This is for display purposes only when generating the output image.  */  \
 /*  _q      : spectral periodogram waterfall object                     */  \
@@ -1816,6 +2662,40 @@ void SPWATERFALL(_write)(SPWATERFALL() _q,                                  \
 /*  _base : base filename (will export .gnu, .bin, and .png files)      */  \
 int SPWATERFALL(_export)(SPWATERFALL() _q,                                  \
                          const char *  _base);                              \
+                                                                            \
+/* Open binary archive for appending, writing the fixed header if the   */  \
+/* file is new. The archive is append-only and seekable: a fixed header */  \
+/* followed by fixed-size tiles, one per spectral estimate (quantized   */  \
+/* to 8 bits with per-tile range and sample index), so review tools can */  \
+/* map the file and seek to any time slice without parsing. Each        */  \
+/* estimate is appended as one tile until the archive is stopped.       */  \
+/*  _q        : spwaterfall object                                      */  \
+/*  _filename : archive filename                                        */  \
+int SPWATERFALL(_archive_start)(SPWATERFALL() _q,                           \
+                                const char *  _filename);                   \
+                                                                            \
+/* Stop archiving spectral estimates and close the archive file         */  \
+int SPWATERFALL(_archive_stop)(SPWATERFALL() _q);                           \
+                                                                            \
+/* Get transform size of an existing archive (or -1 on error)           */  \
+/*  _filename : archive filename                                        */  \
+int SPWATERFALL(_archive_get_nfft)(const char * _filename);                 \
+                                                                            \
+/* Get number of tiles (spectral estimates) in an existing archive      */  \
+/* (or -1 on error)                                                     */  \
+/*  _filename : archive filename                                        */  \
+int SPWATERFALL(_archive_get_num_tiles)(const char * _filename);            \
+                                                                            \
+/* Read a single tile from an existing archive, de-quantizing the       */  \
+/* spectral estimate into the output buffer                             */  \
+/*  _filename     : archive filename                                    */  \
+/*  _index        : tile index, _index < num_tiles                      */  \
+/*  _psd          : output spectral estimate, [size: nfft x 1]          */  \
+/*  _sample_index : output sample index of estimate (ignored if NULL)   */  \
+int SPWATERFALL(_archive_read)(const char * _filename,                      \
+                               unsigned int _index,                         \
+                               T *          _psd,                           \
+                               uint64_t *   _sample_index);                 \
 
 
 LIQUID_SPWATERFALL_DEFINE_API(LIQUID_SPWATERFALL_MANGLE_CFLOAT,
@@ -1875,6 +2755,26 @@ void liquid_firdes_prototype(liquid_firfilt_type _type,
                              float               _dt,
                              float *             _h);
 
+// Design (root-)Nyquist filter from prototype, returning a shared
+// immutable coefficient array (length: 2*_k*_m+1) from an in-process
+// cache; the design is only computed the first time a given parameter
+// tuple is requested. The returned array remains valid until
+// liquid_firdes_cache_clear() and must not be modified or freed.
+//  _type   : filter type (e.g. LIQUID_FIRFILT_RRC)
+//  _k      : samples/symbol,          _k > 1
+//  _m      : symbol delay,            _m > 0
+//  _beta   : excess bandwidth factor, _beta in [0,1)
+//  _dt     : fractional sample delay, _dt in [-1,1]
+const float * liquid_firdes_prototype_cached(liquid_firfilt_type _type,
+                                             unsigned int        _k,
+                                             unsigned int        _m,
+                                             float               _beta,
+                                             float               _dt);
+
+// Clear the internal prototype design cache, freeing all memory and
+// invalidating previously-returned coefficient arrays
+void liquid_firdes_cache_clear(void);
+
 // returns filter type based on input string
 int liquid_getopt_str2firfilt(const char * _str);
 
@@ -2001,6 +2901,13 @@ void firdespm_print(firdespm _q);
 // execute filter design, storing result in _h
 void firdespm_execute(firdespm _q, float * _h);
 
+// execute filter design in reusable mode, storing result in _h; the
+// dense grid is refreshed (allowing a user-defined callback to supply
+// an updated response) and the exchange is warm-started from the
+// previous design's extremal frequencies, reducing design latency for
+// iterative re-designs
+void firdespm_execute_reuse(firdespm _q, float * _h);
+
 
 // Design FIR using kaiser window
 //  _n      : filter length, _n > 0
@@ -2201,6 +3108,67 @@ void liquid_iirdes(liquid_iirdes_filtertype _ftype,
                    float * _B,
                    float * _A);
 
+// IIR filter design object caching the analog prototype. The expensive
+// analog root finding depends only on the filter type, order, and
+// ripple specifications; re-applying the frequency transformation for
+// new band edges (e.g. re-tuning a bank of notch filters) is cheap.
+typedef struct iirdes_s * iirdes;
+
+// create design object, computing and caching the analog prototype
+//  _ftype      :   filter type (e.g. LIQUID_IIRDES_BUTTER)
+//  _btype      :   band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _format     :   coefficients format (e.g. LIQUID_IIRDES_SOS)
+//  _n          :   filter order
+//  _Ap         :   pass-band ripple in dB
+//  _As         :   stop-band ripple in dB
+iirdes iirdes_create(liquid_iirdes_filtertype _ftype,
+                     liquid_iirdes_bandtype   _btype,
+                     liquid_iirdes_format     _format,
+                     unsigned int             _n,
+                     float                    _Ap,
+                     float                    _As);
+
+// destroy design object, freeing all internal memory
+void iirdes_destroy(iirdes _q);
+
+// print design object internals to stdout
+void iirdes_print(iirdes _q);
+
+// get number of output coefficients in each of B and A for a single
+// design (also the stride between designs in iirdes_execute_batch)
+unsigned int iirdes_get_num_coefficients(iirdes _q);
+
+// re-apply the frequency transformation to the cached analog prototype,
+// producing filter coefficients for new band edges without repeating
+// the analog root finding; equivalent to liquid_iirdes() with the same
+// parameters
+//  _q      :   filter design object
+//  _fc     :   low-pass prototype cut-off frequency
+//  _f0     :   center frequency (band-pass, band-stop)
+//  _B      :   numerator,   [size: iirdes_get_num_coefficients(_q) x 1]
+//  _A      :   denominator, [size: iirdes_get_num_coefficients(_q) x 1]
+void iirdes_execute(iirdes  _q,
+                    float   _fc,
+                    float   _f0,
+                    float * _B,
+                    float * _A);
+
+// generate coefficient sets for an array of band edges from a single
+// cached analog prototype, e.g. a bank of filters with different
+// center frequencies
+//  _q      :   filter design object
+//  _fc     :   low-pass prototype cut-off frequencies, [size: _num x 1]
+//  _f0     :   center frequencies (band-pass, -stop),  [size: _num x 1]
+//  _num    :   number of designs to generate
+//  _B      :   numerators,   [size: _num*iirdes_get_num_coefficients(_q) x 1]
+//  _A      :   denominators, [size: _num*iirdes_get_num_coefficients(_q) x 1]
+void iirdes_execute_batch(iirdes       _q,
+                          float *      _fc,
+                          float *      _f0,
+                          unsigned int _num,
+                          float *      _B,
+                          float *      _A);
+
 // compute analog zeros, poles, gain for specific filter types
 void butter_azpkf(unsigned int _n,
                   liquid_float_complex * _za,
@@ -2402,6 +3370,14 @@ typedef struct AUTOCORR(_s) * AUTOCORR();                                   \
 AUTOCORR() AUTOCORR(_create)(unsigned int _window_size,                     \
                              unsigned int _delay);                          \
                                                                             \
+/* Create multi-lag auto-correlator object computing all lags in        */  \
+/* [0,_num_lags); above a lag-count threshold the outputs are computed  */  \
+/* together with transforms rather than one dot product per lag         */  \
+/*  _window_size    : size of the correlator window                     */  \
+/*  _num_lags       : number of lags to compute, _num_lags > 0          */  \
+AUTOCORR() AUTOCORR(_create_multi)(unsigned int _window_size,               \
+                                   unsigned int _num_lags);                 \
+                                                                            \
 /* Destroy auto-correlator object, freeing internal memory              */  \
 void AUTOCORR(_destroy)(AUTOCORR() _q);                                     \
                                                                             \
@@ -2431,6 +3407,12 @@ void AUTOCORR(_write)(AUTOCORR()   _q,                                      \
 void AUTOCORR(_execute)(AUTOCORR() _q,                                      \
                         TO *       _rxx);                                   \
                                                                             \
+/* Compute auto-correlation output at all lags of a multi-lag object    */  \
+/*  _q      : multi-lag auto-correlator object                          */  \
+/*  _rxx    : output array, [size: num_lags x 1]                        */  \
+void AUTOCORR(_execute_multi)(AUTOCORR() _q,                                \
+                              TO *       _rxx);                             \
+                                                                            \
 /* Compute auto-correlation on block of samples; the input and output   */  \
 /* arrays may have the same pointer                                     */  \
 /*  _q      :   auto-correlation object                                 */  \
@@ -2481,6 +3463,15 @@ typedef struct FIRFILT(_s) * FIRFILT();                                     \
 FIRFILT() FIRFILT(_create)(TC *         _h,                                 \
                            unsigned int _n);                                \
                                                                             \
+/* Create filter object with an automatically-selected internal         */  \
+/* implementation: long filters attach an FFT-based (overlap-add)       */  \
+/* engine which is used transparently by the block execute method,      */  \
+/* while retaining the sample-at-a-time interface                       */  \
+/*  _h      : filter coefficients [size: _n x 1]                        */  \
+/*  _n      : number of filter coefficients, _n > 0                     */  \
+FIRFILT() FIRFILT(_create_auto)(TC *         _h,                            \
+                                unsigned int _n);                           \
+                                                                            \
 /* Create object using Kaiser-Bessel windowed sinc method               */  \
 /*  _n      : filter length, _n > 0                                     */  \
 /*  _fc     : filter normalized cut-off frequency, 0 < _fc < 0.5        */  \
@@ -2491,6 +3482,19 @@ FIRFILT() FIRFILT(_create_kaiser)(unsigned int _n,                          \
                                   float        _As,                         \
                                   float        _mu);                        \
                                                                             \
+/* Create object using Kaiser-Bessel windowed sinc method with the      */  \
+/* design itself deferred to the first execute or an explicit prepare   */  \
+/* call; constructing a large bank of filters returns immediately and   */  \
+/* the designs may then run in parallel                                 */  \
+/*  _n      : filter length, _n > 0                                     */  \
+/*  _fc     : filter normalized cut-off frequency, 0 < _fc < 0.5        */  \
+/*  _As     : filter stop-band attenuation [dB], _As > 0                */  \
+/*  _mu     : fractional sample offset, -0.5 < _mu < 0.5                */  \
+FIRFILT() FIRFILT(_create_lazy_kaiser)(unsigned int _n,                     \
+                                       float        _fc,                    \
+                                       float        _As,                    \
+                                       float        _mu);                   \
+                                                                            \
 /* Create object from square-root Nyquist prototype.                    */  \
 /* The filter length will be \(2 k m + 1 \) samples long with a delay   */  \
 /* of \( k m + 1 \) samples.                                            */  \
@@ -2505,6 +3509,23 @@ FIRFILT() FIRFILT(_create_rnyquist)(int          _type,                     \
                                     float        _beta,                     \
                                     float        _mu);                      \
                                                                             \
+/* Create object from square-root Nyquist prototype with the design     */  \
+/* deferred to the first execute or an explicit prepare call            */  \
+/*  _type   : filter type (e.g. LIQUID_FIRFILT_RRC)                     */  \
+/*  _k      : nominal samples per symbol, _k > 1                        */  \
+/*  _m      : filter delay [symbols], _m > 0                            */  \
+/*  _beta   : rolloff factor, 0 < beta <= 1                             */  \
+/*  _mu     : fractional sample offset [samples], -0.5 < _mu < 0.5      */  \
+FIRFILT() FIRFILT(_create_lazy_rnyquist)(int          _type,                \
+                                         unsigned int _k,                   \
+                                         unsigned int _m,                   \
+                                         float        _beta,                \
+                                         float        _mu);                 \
+                                                                            \
+/* Run any deferred filter design (see the create_lazy methods); a      */  \
+/* no-op when the coefficients are already available                    */  \
+void FIRFILT(_prepare)(FIRFILT() _q);                                       \
+                                                                            \
 /* Create object from Parks-McClellan algorithm prototype               */  \
 /*  _h_len  : filter length, _h_len > 0                                 */  \
 /*  _fc     : cutoff frequency, 0 < _fc < 0.5                           */  \
@@ -2542,6 +3563,13 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT()    _q,                               \
                              TC *         _h,                               \
                              unsigned int _n);                              \
                                                                             \
+/* Create a clone of the filter object which shares the original's      */  \
+/* coefficients but runs on an independent sample stream. The           */  \
+/* coefficient set is reference counted and freed with the last object; */  \
+/* destroy the clone with the regular destroy method.                   */  \
+/*  _q      : original filter object                                    */  \
+FIRFILT() FIRFILT(_clone_shared)(FIRFILT() _q);                             \
+                                                                            \
 /* Destroy filter object and free all internal memory                   */  \
 void FIRFILT(_destroy)(FIRFILT() _q);                                       \
                                                                             \
@@ -2611,6 +3639,28 @@ void FIRFILT(_freqresponse)(FIRFILT()              _q,                      \
 /*  _fc     : frequency to evaluate                                     */  \
 float FIRFILT(_groupdelay)(FIRFILT() _q,                                    \
                            float     _fc);                                  \
+                                                                            \
+/* Compute complex frequency response at _nfft uniformly-spaced         */  \
+/* frequencies with a single transform rather than one evaluation per   */  \
+/* point; _H[i] corresponds to frequency i/_nfft (upper half wrapping   */  \
+/* to negative frequencies as with an FFT)                              */  \
+/*  _q      : filter object                                             */  \
+/*  _nfft   : number of frequency points, _nfft > 0                     */  \
+/*  _H      : output frequency response, [size: _nfft x 1]              */  \
+void FIRFILT(_freqresponse_block)(FIRFILT()              _q,                \
+                                  unsigned int           _nfft,             \
+                                  liquid_float_complex * _H);               \
+                                                                            \
+/* Compute group delay at _nfft uniformly-spaced frequencies with two   */  \
+/* transforms rather than one evaluation per point; _d[i] corresponds   */  \
+/* to frequency i/_nfft (upper half wrapping to negative frequencies    */  \
+/* as with an FFT)                                                      */  \
+/*  _q      : filter object                                             */  \
+/*  _nfft   : number of frequency points, _nfft > 0                     */  \
+/*  _d      : output group delay [samples], [size: _nfft x 1]           */  \
+void FIRFILT(_groupdelay_block)(FIRFILT()    _q,                            \
+                                unsigned int _nfft,                         \
+                                float *      _d);                           \
 
 LIQUID_FIRFILT_DEFINE_API(LIQUID_FIRFILT_MANGLE_RRRF,
                           float,
@@ -2627,6 +3677,265 @@ LIQUID_FIRFILT_DEFINE_API(LIQUID_FIRFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+// execute filter on block of half-precision input samples, widening
+// internally; see liquid_fp16tof()
+//  _q : filter object
+//  _x : input buffer, interleaved half-precision i/q [size: 2 _n x 1]
+//  _y : output buffer [size: _n x 1]
+//  _n : number of complex samples
+void firfilt_crcf_execute_block_fp16(firfilt_crcf           _q,
+                                     uint16_t *             _x,
+                                     unsigned int           _n,
+                                     liquid_float_complex * _y);
+
+//
+// fixed-point filter: interleaved q15 (sc16) complex samples against
+// real Q.15 coefficients, processed entirely in integer arithmetic so
+// the front half of a receive chain can run on native radio samples
+// before converting to floating point for demodulation
+//
+typedef struct firfilt_crcq16_s * firfilt_crcq16;
+
+// create fixed-point filter object
+//  _h      : filter coefficients in Q.15 [size: _n x 1]
+//  _n      : number of filter coefficients, _n > 0
+firfilt_crcq16 firfilt_crcq16_create(int16_t *    _h,
+                                     unsigned int _n);
+
+// destroy filter object, freeing all internal memory
+void firfilt_crcq16_destroy(firfilt_crcq16 _q);
+
+// reset filter object's internal buffer
+void firfilt_crcq16_reset(firfilt_crcq16 _q);
+
+// print filter object internals to standard output
+void firfilt_crcq16_print(firfilt_crcq16 _q);
+
+// push one complex sample (interleaved i/q pair) into filter buffer
+//  _q      : filter object
+//  _x      : input sample, interleaved i/q [size: 2 x 1]
+void firfilt_crcq16_push(firfilt_crcq16 _q,
+                         int16_t *      _x);
+
+// compute output sample from internal buffer
+//  _q      : filter object
+//  _y      : output sample, interleaved i/q [size: 2 x 1]
+void firfilt_crcq16_execute(firfilt_crcq16 _q,
+                            int16_t *      _y);
+
+// execute filter on block of interleaved complex samples
+//  _q      : filter object
+//  _x      : input buffer, interleaved i/q [size: 2 _n x 1]
+//  _n      : number of complex samples
+//  _y      : output buffer, interleaved i/q [size: 2 _n x 1]
+void firfilt_crcq16_execute_block(firfilt_crcq16 _q,
+                                  int16_t *      _x,
+                                  unsigned int   _n,
+                                  int16_t *      _y);
+
+// get length of filter object (number of coefficients)
+unsigned int firfilt_crcq16_get_length(firfilt_crcq16 _q);
+
+//
+// Sparse finite impulse response (FIR) filter
+//
+
+#define LIQUID_SFIRFILT_MANGLE_RRRF(name) LIQUID_CONCAT(sfirfilt_rrrf,name)
+#define LIQUID_SFIRFILT_MANGLE_CRCF(name) LIQUID_CONCAT(sfirfilt_crcf,name)
+#define LIQUID_SFIRFILT_MANGLE_CCCF(name) LIQUID_CONCAT(sfirfilt_cccf,name)
+
+// Macro:
+//   SFIRFILT   : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_SFIRFILT_DEFINE_API(SFIRFILT,TO,TC,TI)                       \
+                                                                            \
+/* Sparse finite impulse response (FIR) filter with only a few          */  \
+/* non-zero taps across a long span (e.g. comb and echo-profile         */  \
+/* filters), specified as explicit delay/coefficient pairs              */  \
+typedef struct SFIRFILT(_s) * SFIRFILT();                                   \
+                                                                            \
+/* Create a sparse FIR filter from a list of delay/coefficient pairs    */  \
+/*  _h          : filter coefficients, [size: _num_taps x 1]            */  \
+/*  _delays     : tap delays (in samples), [size: _num_taps x 1]        */  \
+/*  _num_taps   : number of non-zero taps, _num_taps > 0                */  \
+SFIRFILT() SFIRFILT(_create)(TC *           _h,                             \
+                             unsigned int * _delays,                        \
+                             unsigned int   _num_taps);                     \
+                                                                            \
+/* Destroy filter object and free all internal memory                   */  \
+void SFIRFILT(_destroy)(SFIRFILT() _q);                                     \
+                                                                            \
+/* Reset filter object's internal buffer                                */  \
+void SFIRFILT(_reset)(SFIRFILT() _q);                                       \
+                                                                            \
+/* Print filter object information to stdout                            */  \
+void SFIRFILT(_print)(SFIRFILT() _q);                                       \
+                                                                            \
+/* Set output scaling for filter                                        */  \
+/*  _q      : filter object                                             */  \
+/*  _scale  : scaling factor to apply to each output sample             */  \
+void SFIRFILT(_set_scale)(SFIRFILT() _q,                                    \
+                          TC         _scale);                               \
+                                                                            \
+/* Get output scaling for filter                                        */  \
+/*  _q      : filter object                                             */  \
+/*  _scale  : scaling factor applied to each output sample              */  \
+void SFIRFILT(_get_scale)(SFIRFILT() _q,                                    \
+                          TC *       _scale);                               \
+                                                                            \
+/* Push sample into filter object's internal buffer                     */  \
+/*  _q      : filter object                                             */  \
+/*  _x      : single input sample                                       */  \
+void SFIRFILT(_push)(SFIRFILT() _q,                                         \
+                     TI         _x);                                        \
+                                                                            \
+/* Write block of samples into filter object's internal buffer          */  \
+/*  _q      : filter object                                             */  \
+/*  _x      : buffer of input samples, [size: _n x 1]                   */  \
+/*  _n      : number of input samples                                   */  \
+void SFIRFILT(_write)(SFIRFILT()   _q,                                      \
+                      TI *         _x,                                      \
+                      unsigned int _n);                                     \
+                                                                            \
+/* Execute vector dot product on the filter's internal buffer and       */  \
+/* coefficients, gathering only the non-zero taps                       */  \
+/*  _q      : filter object                                             */  \
+/*  _y      : pointer to single output sample                           */  \
+void SFIRFILT(_execute)(SFIRFILT() _q,                                      \
+                        TO *       _y);                                     \
+                                                                            \
+/* Execute the filter on a block of input samples; in-place operation   */  \
+/* is permitted (_x and _y may point to the same array)                 */  \
+/*  _q      : filter object                                             */  \
+/*  _x      : pointer to input array, [size: _n x 1]                    */  \
+/*  _n      : number of input, output samples                           */  \
+/*  _y      : pointer to output array, [size: _n x 1]                   */  \
+void SFIRFILT(_execute_block)(SFIRFILT()   _q,                              \
+                              TI *         _x,                              \
+                              unsigned int _n,                              \
+                              TO *         _y);                             \
+                                                                            \
+/* Get length of filter object's impulse response span (maximum tap     */  \
+/* delay plus one)                                                      */  \
+unsigned int SFIRFILT(_get_length)(SFIRFILT() _q);                          \
+                                                                            \
+/* Get number of non-zero taps in filter object                         */  \
+unsigned int SFIRFILT(_get_num_taps)(SFIRFILT() _q);                        \
+
+LIQUID_SFIRFILT_DEFINE_API(LIQUID_SFIRFILT_MANGLE_RRRF,
+                           float,
+                           float,
+                           float)
+
+LIQUID_SFIRFILT_DEFINE_API(LIQUID_SFIRFILT_MANGLE_CRCF,
+                           liquid_float_complex,
+                           float,
+                           liquid_float_complex)
+
+LIQUID_SFIRFILT_DEFINE_API(LIQUID_SFIRFILT_MANGLE_CCCF,
+                           liquid_float_complex,
+                           liquid_float_complex,
+                           liquid_float_complex)
+
+//
+// Quantized-coefficient finite impulse response (FIR) filter
+//
+
+#define LIQUID_QFIRFILT_MANGLE_RRRF(name) LIQUID_CONCAT(qfirfilt_rrrf,name)
+#define LIQUID_QFIRFILT_MANGLE_CRCF(name) LIQUID_CONCAT(qfirfilt_crcf,name)
+
+// Macro:
+//   QFIRFILT   : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_QFIRFILT_DEFINE_API(QFIRFILT,TO,TC,TI)                       \
+                                                                            \
+/* Finite impulse response (FIR) filter with coefficients quantized     */  \
+/* to 8- or 16-bit integers and a single per-filter scale factor,       */  \
+/* cutting coefficient memory by a factor of four (or two) for large    */  \
+/* banks of filters sharing a cache                                     */  \
+typedef struct QFIRFILT(_s) * QFIRFILT();                                   \
+                                                                            \
+/* Create a quantized-coefficient FIR filter from external              */  \
+/* coefficients; the scale factor is derived from the largest           */  \
+/* coefficient magnitude and the quantization error is computed for     */  \
+/* reporting                                                            */  \
+/*  _h      : filter coefficients, [size: _h_len x 1]                   */  \
+/*  _h_len  : filter length, _h_len > 0                                 */  \
+/*  _nbits  : coefficient word size (8 or 16 bits)                      */  \
+QFIRFILT() QFIRFILT(_create)(TC *         _h,                               \
+                             unsigned int _h_len,                           \
+                             unsigned int _nbits);                          \
+                                                                            \
+/* Destroy filter object and free all internal memory                   */  \
+void QFIRFILT(_destroy)(QFIRFILT() _q);                                     \
+                                                                            \
+/* Reset filter object's internal buffer                                */  \
+void QFIRFILT(_reset)(QFIRFILT() _q);                                       \
+                                                                            \
+/* Print filter object information to stdout                            */  \
+void QFIRFILT(_print)(QFIRFILT() _q);                                       \
+                                                                            \
+/* Push sample into filter object's internal buffer                     */  \
+/*  _q      : filter object                                             */  \
+/*  _x      : single input sample                                       */  \
+void QFIRFILT(_push)(QFIRFILT() _q,                                         \
+                     TI         _x);                                        \
+                                                                            \
+/* Write block of samples into filter object's internal buffer          */  \
+/*  _q      : filter object                                             */  \
+/*  _x      : buffer of input samples, [size: _n x 1]                   */  \
+/*  _n      : number of input samples                                   */  \
+void QFIRFILT(_write)(QFIRFILT()   _q,                                      \
+                      TI *         _x,                                      \
+                      unsigned int _n);                                     \
+                                                                            \
+/* Execute vector dot product on the filter's internal buffer and       */  \
+/* quantized coefficients, applying the scale factor once to the        */  \
+/* accumulated result                                                   */  \
+/*  _q      : filter object                                             */  \
+/*  _y      : pointer to single output sample                           */  \
+void QFIRFILT(_execute)(QFIRFILT() _q,                                      \
+                        TO *       _y);                                     \
+                                                                            \
+/* Execute the filter on a block of input samples; in-place operation   */  \
+/* is permitted (_x and _y may point to the same array)                 */  \
+/*  _q      : filter object                                             */  \
+/*  _x      : pointer to input array, [size: _n x 1]                    */  \
+/*  _n      : number of input, output samples                           */  \
+/*  _y      : pointer to output array, [size: _n x 1]                   */  \
+void QFIRFILT(_execute_block)(QFIRFILT()   _q,                              \
+                              TI *         _x,                              \
+                              unsigned int _n,                              \
+                              TO *         _y);                             \
+                                                                            \
+/* Get length of filter object's impulse response                       */  \
+unsigned int QFIRFILT(_get_length)(QFIRFILT() _q);                          \
+                                                                            \
+/* Get coefficient word size (8 or 16 bits)                             */  \
+unsigned int QFIRFILT(_get_nbits)(QFIRFILT() _q);                           \
+                                                                            \
+/* Get scale factor applied to the quantized coefficient values         */  \
+TC QFIRFILT(_get_scale)(QFIRFILT() _q);                                     \
+                                                                            \
+/* Get relative r.m.s. coefficient quantization error computed at       */  \
+/* create time, bounding the stopband degradation introduced by         */  \
+/* quantization                                                         */  \
+float QFIRFILT(_get_quantization_error)(QFIRFILT() _q);                     \
+
+LIQUID_QFIRFILT_DEFINE_API(LIQUID_QFIRFILT_MANGLE_RRRF,
+                           float,
+                           float,
+                           float)
+
+LIQUID_QFIRFILT_DEFINE_API(LIQUID_QFIRFILT_MANGLE_CRCF,
+                           liquid_float_complex,
+                           float,
+                           liquid_float_complex)
+
 //
 // FIR Hilbert transform
 //  2:1 real-to-complex decimator
@@ -2664,6 +3973,15 @@ void FIRHILB(_print)(FIRHILB() _q);                                         \
 /* Reset firhilb object internal state                                  */  \
 void FIRHILB(_reset)(FIRHILB() _q);                                         \
                                                                             \
+/* Set residual frequency offset of fused mixer. The offset is applied  */  \
+/* as a mix-down on the decimator output, shifting a signal centered    */  \
+/* slightly off the quarter-sample-rate IF to baseband without a        */  \
+/* separate oscillator pass.                                            */  \
+/*  _q      :   Hilbert transform object                                */  \
+/*  _dphi   :   frequency offset [radians/output sample]                */  \
+void FIRHILB(_set_freq)(FIRHILB() _q,                                       \
+                        float     _dphi);                                   \
+                                                                            \
 /* Execute Hilbert transform (real to complex)                          */  \
 /*  _q      :   Hilbert transform object                                */  \
 /*  _x      :   real-valued input sample                                */  \
@@ -2877,6 +4195,21 @@ void FFTFILT(_execute)(FFTFILT() _q,                                        \
                        TI *      _x,                                        \
                        TO *      _y);                                       \
                                                                             \
+/* Execute the filter on several contiguous blocks of input samples in  */  \
+/* a single call, handling the overlap between blocks internally. All   */  \
+/* blocks are transformed with a batched FFT against the persistent     */  \
+/* filter spectrum before the overlap-add pass, amortizing per-call     */  \
+/* overhead across blocks; the output is identical to calling           */  \
+/* _execute() once per block. In-place operation is permitted.          */  \
+/*  _q          : filter object                                         */  \
+/*  _x          : pointer to input data array,  [size: _n _num_blocks x 1] */\
+/*  _num_blocks : number of blocks of _n samples to process             */  \
+/*  _y          : pointer to output data array, [size: _n _num_blocks x 1] */\
+void FFTFILT(_execute_block)(FFTFILT()    _q,                               \
+                             TI *         _x,                               \
+                             unsigned int _num_blocks,                      \
+                             TO *         _y);                              \
+                                                                            \
 /* Get length of filter object's internal coefficients                  */  \
 unsigned int FFTFILT(_get_length)(FFTFILT() _q);                            \
 
@@ -2931,6 +4264,18 @@ IIRFILT() IIRFILT(_create)(TC *         _b,                                 \
                            TC *         _a,                                 \
                            unsigned int _na);                               \
                                                                             \
+/* Create IIR filter using transposed direct-form II structure with     */  \
+/* double-precision internal state; numerically stable for long-running */  \
+/* filters at the cost of slightly more work per sample                 */  \
+/*  _b      : feed-forward coefficients (numerator), [size: _nb x 1]    */  \
+/*  _nb     : number of feed-forward coefficients, _nb > 0              */  \
+/*  _a      : feed-back coefficients (denominator), [size: _na x 1]     */  \
+/*  _na     : number of feed-back coefficients, _na > 0                 */  \
+IIRFILT() IIRFILT(_create_trans)(TC *         _b,                           \
+                                 unsigned int _nb,                          \
+                                 TC *         _a,                           \
+                                 unsigned int _na);                         \
+                                                                            \
 /* Create IIR filter using 2nd-order secitons from external             */  \
 /* coefficients.                                                        */  \
 /*  _B      : feed-forward coefficients [size: _nsos x 3]               */  \
@@ -3031,6 +4376,28 @@ void IIRFILT(_freqresponse)(IIRFILT()              _q,                      \
 /*  _q      : filter object                                             */  \
 /*  _fc     : frequency to evaluate                                     */  \
 float IIRFILT(_groupdelay)(IIRFILT() _q, float _fc);                        \
+                                                                            \
+/* Compute complex frequency response at _nfft uniformly-spaced         */  \
+/* frequencies in one pass rather than one evaluation per point;        */  \
+/* _H[i] corresponds to frequency i/_nfft (upper half wrapping to       */  \
+/* negative frequencies as with an FFT)                                 */  \
+/*  _q      : filter object                                             */  \
+/*  _nfft   : number of frequency points, _nfft > 0                     */  \
+/*  _H      : output frequency response, [size: _nfft x 1]              */  \
+void IIRFILT(_freqresponse_block)(IIRFILT()              _q,                \
+                                  unsigned int           _nfft,             \
+                                  liquid_float_complex * _H);               \
+                                                                            \
+/* Compute group delay at _nfft uniformly-spaced frequencies in one     */  \
+/* pass rather than one evaluation per point; _d[i] corresponds to      */  \
+/* frequency i/_nfft (upper half wrapping to negative frequencies as    */  \
+/* with an FFT)                                                         */  \
+/*  _q      : filter object                                             */  \
+/*  _nfft   : number of frequency points, _nfft > 0                     */  \
+/*  _d      : output group delay [samples], [size: _nfft x 1]           */  \
+void IIRFILT(_groupdelay_block)(IIRFILT()    _q,                            \
+                                unsigned int _nfft,                         \
+                                float *      _d);                           \
 
 LIQUID_IIRFILT_DEFINE_API(LIQUID_IIRFILT_MANGLE_RRRF,
                           float,
@@ -3121,6 +4488,24 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,                                 \
                            TC *         _h,                                 \
                            unsigned int _h_len);                            \
                                                                             \
+/* Create a clone of the firpfb object which shares the original's      */  \
+/* filter bank but runs on an independent sample stream. The bank is    */  \
+/* reference counted and freed with the last object; destroy the clone  */  \
+/* with the regular destroy method.                                     */  \
+/*  _q      : original firpfb object                                    */  \
+FIRPFB() FIRPFB(_clone_shared)(FIRPFB() _q);                                \
+                                                                            \
+/* Create firpfb object with its own coefficients but sharing another   */  \
+/* bank's window buffer: samples pushed into either object are seen by  */  \
+/* both, so a pair of banks filters one stream in a single combined     */  \
+/* polyphase pass. Destroy the sharing object before its base.          */  \
+/*  _base   : firpfb object owning the window buffer                    */  \
+/*  _h      : coefficients [size: _h_len x 1]                           */  \
+/*  _h_len  : filter length, must match that of _base                   */  \
+FIRPFB() FIRPFB(_create_shared_window)(FIRPFB()     _base,                  \
+                                       TC *         _h,                     \
+                                       unsigned int _h_len);                \
+                                                                            \
 /* Destroy firpfb object, freeing all internal memory and destroying    */  \
 /* all internal objects                                                 */  \
 void FIRPFB(_destroy)(FIRPFB() _q);                                         \
@@ -3158,6 +4543,39 @@ void FIRPFB(_execute)(FIRPFB()     _q,                                      \
                       unsigned int _i,                                      \
                       TO *         _y);                                     \
                                                                             \
+/* Execute vector dot products for all sub-filters on the filter's      */  \
+/* internal buffer, writing one output sample per sub-filter. The       */  \
+/* internal buffer is read once and shared across all coefficient sets  */  \
+/* which is considerably faster than executing each index in turn.      */  \
+/*  _q      : firpfb object                                             */  \
+/*  _y      : pointer to output array [size: _M x 1]                    */  \
+void FIRPFB(_execute_all)(FIRPFB() _q,                                      \
+                          TO *     _y);                                     \
+                                                                            \
+/* Execute vector dot products on two filter banks (e.g. matched and    */  \
+/* derivative matched filters) at the same index in one fused pass over */  \
+/* the first object's internal buffer. Both banks must have the same    */  \
+/* dimensions; only the first object's buffer is read, so pushing       */  \
+/* samples into the second is unnecessary.                              */  \
+/*  _q0     : first firpfb object (provides the input buffer)           */  \
+/*  _q1     : second firpfb object                                      */  \
+/*  _i      : index of filter to use                                    */  \
+/*  _y0     : pointer to first output sample                            */  \
+/*  _y1     : pointer to second output sample                           */  \
+void FIRPFB(_execute_pair)(FIRPFB()     _q0,                                \
+                           FIRPFB()     _q1,                                \
+                           unsigned int _i,                                 \
+                           TO *         _y0,                                \
+                           TO *         _y1);                               \
+                                                                            \
+/* Execute all filters in the bank on the internal buffer, reading the  */  \
+/* buffer state only once; useful when every output of the bank is      */  \
+/* needed for the same input state (e.g. interpolation)                 */  \
+/*  _q      : firpfb object                                             */  \
+/*  _y      : output sample array, [size: num_filters x 1]              */  \
+void FIRPFB(_execute_all)(FIRPFB() _q,                                      \
+                          TO *     _y);                                     \
+                                                                            \
 /* Execute the filter on a block of input samples, all using index _i.  */  \
 /* In-place operation is permitted (_x and _y may point to the same     */  \
 /* place in memory)                                                     */  \
@@ -3503,6 +4921,48 @@ LIQUID_FIRDECIM_DEFINE_API(LIQUID_FIRDECIM_MANGLE_CCCF,
                            liquid_float_complex,
                            liquid_float_complex)
 
+//
+// fixed-point decimator: interleaved q15 (sc16) complex samples against
+// real Q.15 coefficients, processed entirely in integer arithmetic;
+// companion to firfilt_crcq16 for integer receive front ends
+//
+typedef struct firdecim_crcq16_s * firdecim_crcq16;
+
+// create fixed-point decimator object
+//  _M      : decimation factor, _M > 0
+//  _h      : filter coefficients in Q.15 [size: _h_len x 1]
+//  _h_len  : number of filter coefficients, _h_len > 0
+firdecim_crcq16 firdecim_crcq16_create(unsigned int _M,
+                                       int16_t *    _h,
+                                       unsigned int _h_len);
+
+// destroy decimator object, freeing all internal memory
+void firdecim_crcq16_destroy(firdecim_crcq16 _q);
+
+// reset decimator object's internal buffer
+void firdecim_crcq16_reset(firdecim_crcq16 _q);
+
+// print decimator object internals to standard output
+void firdecim_crcq16_print(firdecim_crcq16 _q);
+
+// execute decimator on one block of _M complex input samples
+//  _q      : decimator object
+//  _x      : input buffer, interleaved i/q [size: 2 _M x 1]
+//  _y      : output sample, interleaved i/q [size: 2 x 1]
+void firdecim_crcq16_execute(firdecim_crcq16 _q,
+                             int16_t *       _x,
+                             int16_t *       _y);
+
+// execute decimator on block of _n*_M complex input samples
+//  _q      : decimator object
+//  _x      : input buffer, interleaved i/q [size: 2 _n _M x 1]
+//  _n      : number of output samples
+//  _y      : output buffer, interleaved i/q [size: 2 _n x 1]
+void firdecim_crcq16_execute_block(firdecim_crcq16 _q,
+                                   int16_t *       _x,
+                                   unsigned int    _n,
+                                   int16_t *       _y);
+
 
 // iirdecim : infinite impulse response decimator
 #define LIQUID_IIRDECIM_MANGLE_RRRF(name) LIQUID_CONCAT(iirdecim_rrrf,name)
@@ -3853,6 +5313,18 @@ float RRESAMP(_get_rate)(RRESAMP() _q);                                     \
 void RRESAMP(_execute)(RRESAMP()       _q,                                  \
                         TI *           _x,                                  \
                         TO *           _y);                                 \
+                                                                            \
+/* Execute on a block of input samples, equivalent to _n successive     */  \
+/* calls to "execute" but using a schedule of filter-bank indices       */  \
+/* pre-computed at create time                                          */  \
+/*  _q  : resamp object                                                 */  \
+/*  _n  : block size (number of "execute" input blocks)                 */  \
+/*  _x  : input sample array, [size: _n*Q x 1]                          */  \
+/*  _y  : output sample array [size: _n*P x 1]                          */  \
+void RRESAMP(_execute_block)(RRESAMP()       _q,                            \
+                             TI *            _x,                            \
+                             unsigned int    _n,                            \
+                             TO *            _y);                           \
 
 LIQUID_RRESAMP_DEFINE_API(LIQUID_RRESAMP_MANGLE_RRRF,
                           float,
@@ -3870,6 +5342,144 @@ LIQUID_RRESAMP_DEFINE_API(LIQUID_RRESAMP_MANGLE_CCCF,
                           liquid_float_complex)
 
 
+//
+// Rational resampler bank
+//
+#define LIQUID_RRESAMPBANK_MANGLE_RRRF(name) LIQUID_CONCAT(rresampbank_rrrf,name)
+#define LIQUID_RRESAMPBANK_MANGLE_CRCF(name) LIQUID_CONCAT(rresampbank_crcf,name)
+#define LIQUID_RRESAMPBANK_MANGLE_CCCF(name) LIQUID_CONCAT(rresampbank_cccf,name)
+
+#define LIQUID_RRESAMPBANK_DEFINE_API(RRESAMPBANK,TO,TC,TI)                 \
+                                                                            \
+/* Rational rate resampler bank, running many parallel channels through */  \
+/* a single shared filter. The per-channel delay lines are interleaved  */  \
+/* in memory so that each filter tap is applied to all channels in one  */  \
+/* contiguous pass, which is far more cache- and SIMD-friendly than     */  \
+/* running an array of independent rresamp objects with identical       */  \
+/* coefficients. Input and output blocks are channel-interleaved        */  \
+/* (sample-major): x[i*num_channels + ch] is sample i of channel ch.    */  \
+typedef struct RRESAMPBANK(_s) * RRESAMPBANK();                             \
+                                                                            \
+/* Create rational-rate resampler bank from external coefficients to    */  \
+/* resample all channels at an exact rate P/Q.                          */  \
+/* Note that to preserve the input filter coefficients, the greatest    */  \
+/* common divisor (gcd) is not removed internally from _P and _Q when   */  \
+/* this method is called.                                               */  \
+/*  _P              : interpolation factor,             P > 0           */  \
+/*  _Q              : decimation factor,                Q > 0           */  \
+/*  _m              : filter semi-length (delay),       0 < _m          */  \
+/*  _h              : filter coefficients, [size: 2*_P*_m x 1]          */  \
+/*  _num_channels   : number of parallel channels,      _num_channels>0 */  \
+RRESAMPBANK() RRESAMPBANK(_create)(unsigned int _P,                         \
+                                   unsigned int _Q,                         \
+                                   unsigned int _m,                         \
+                                   TC *         _h,                         \
+                                   unsigned int _num_channels);             \
+                                                                            \
+/* Create rational-rate resampler bank from filter prototype to         */  \
+/* resample all channels at an exact rate P/Q.                          */  \
+/* Note that because the filter coefficients are computed internally    */  \
+/* here, the greatest common divisor (gcd) from _P and _Q is internally */  \
+/* removed to improve speed.                                            */  \
+/*  _P              : interpolation factor,             P > 0           */  \
+/*  _Q              : decimation factor,                Q > 0           */  \
+/*  _m              : filter semi-length (delay),       0 < _m          */  \
+/*  _bw             : filter bandwidth, 0 < _bw <= 0.5                  */  \
+/*  _As             : filter stop-band attenuation [dB],0 < _As         */  \
+/*  _num_channels   : number of parallel channels,      _num_channels>0 */  \
+RRESAMPBANK() RRESAMPBANK(_create_kaiser)(unsigned int _P,                  \
+                                          unsigned int _Q,                  \
+                                          unsigned int _m,                  \
+                                          float        _bw,                 \
+                                          float        _As,                 \
+                                          unsigned int _num_channels);      \
+                                                                            \
+/* Create rational resampler bank with a specified resampling rate of   */  \
+/* exactly P/Q with default parameters.                                 */  \
+/* The default parameters are                                           */  \
+/*  m    = 12    (filter semi-length),                                  */  \
+/*  bw   = 0.5   (filter bandwidth), and                                */  \
+/*  As   = 60 dB (filter stop-band attenuation)                         */  \
+/*  _P              : interpolation factor, P > 0                       */  \
+/*  _Q              : decimation factor,    Q > 0                       */  \
+/*  _num_channels   : number of parallel channels, _num_channels > 0    */  \
+RRESAMPBANK() RRESAMPBANK(_create_default)(unsigned int _P,                 \
+                                           unsigned int _Q,                 \
+                                           unsigned int _num_channels);     \
+                                                                            \
+/* Destroy resampler bank object, freeing all internal memory           */  \
+void RRESAMPBANK(_destroy)(RRESAMPBANK() _q);                               \
+                                                                            \
+/* Print resampler bank object internals to stdout                      */  \
+void RRESAMPBANK(_print)(RRESAMPBANK() _q);                                 \
+                                                                            \
+/* Reset resampler bank object internals, clearing all channel state    */  \
+void RRESAMPBANK(_reset)(RRESAMPBANK() _q);                                 \
+                                                                            \
+/* Set output scaling for filter, applied to every channel              */  \
+/*  _q      : resampler bank object                                     */  \
+/*  _scale  : scaling factor to apply to each output sample             */  \
+void RRESAMPBANK(_set_scale)(RRESAMPBANK() _q,                              \
+                             TC            _scale);                         \
+                                                                            \
+/* Get output scaling for filter                                        */  \
+/*  _q      : resampler bank object                                     */  \
+/*  _scale  : scaling factor to apply to each output sample             */  \
+void RRESAMPBANK(_get_scale)(RRESAMPBANK() _q,                              \
+                             TC *          _scale);                         \
+                                                                            \
+/* Get resampler delay (filter semi-length \(m\))                       */  \
+unsigned int RRESAMPBANK(_get_delay)(RRESAMPBANK() _q);                     \
+                                                                            \
+/* Get block length (e.g. greatest common divisor) between original P   */  \
+/* and Q values                                                         */  \
+unsigned int RRESAMPBANK(_get_block_len)(RRESAMPBANK() _q);                 \
+                                                                            \
+/* Get rate of resampler, \(r = P/Q\)                                   */  \
+float RRESAMPBANK(_get_rate)(RRESAMPBANK() _q);                             \
+                                                                            \
+/* Get number of parallel channels                                      */  \
+unsigned int RRESAMPBANK(_get_num_channels)(RRESAMPBANK() _q);              \
+                                                                            \
+/* Execute resampler bank on one interleaved block of input samples,    */  \
+/* consuming Q samples and producing P samples for every channel. The   */  \
+/* same block-length convention applies as with rresamp: if the object  */  \
+/* was created with P and Q sharing a common divisor, execute() still   */  \
+/* expects buffers sized by the original P and Q.                       */  \
+/*  _q  : resampler bank object                                         */  \
+/*  _x  : input sample array, [size: Q*num_channels x 1]                */  \
+/*  _y  : output sample array [size: P*num_channels x 1]                */  \
+void RRESAMPBANK(_execute)(RRESAMPBANK() _q,                                \
+                           TI *          _x,                                \
+                           TO *          _y);                               \
+                                                                            \
+/* Execute on a block of interleaved input samples, equivalent to _n    */  \
+/* successive calls to "execute"                                        */  \
+/*  _q  : resampler bank object                                         */  \
+/*  _x  : input sample array, [size: _n*Q*num_channels x 1]             */  \
+/*  _n  : block size (number of "execute" input blocks)                 */  \
+/*  _y  : output sample array [size: _n*P*num_channels x 1]             */  \
+void RRESAMPBANK(_execute_block)(RRESAMPBANK() _q,                          \
+                                 TI *          _x,                          \
+                                 unsigned int  _n,                          \
+                                 TO *          _y);                         \
+
+LIQUID_RRESAMPBANK_DEFINE_API(LIQUID_RRESAMPBANK_MANGLE_RRRF,
+                              float,
+                              float,
+                              float)
+
+LIQUID_RRESAMPBANK_DEFINE_API(LIQUID_RRESAMPBANK_MANGLE_CRCF,
+                              liquid_float_complex,
+                              float,
+                              liquid_float_complex)
+
+LIQUID_RRESAMPBANK_DEFINE_API(LIQUID_RRESAMPBANK_MANGLE_CCCF,
+                              liquid_float_complex,
+                              liquid_float_complex,
+                              liquid_float_complex)
+
+
 //
 // Arbitrary resampler
 //
@@ -3906,6 +5516,22 @@ RESAMP() RESAMP(_create)(float        _rate,                                \
 /*  _rate   : arbitrary resampling rate,         0 < _rate              */  \
 RESAMP() RESAMP(_create_default)(float _rate);                              \
                                                                             \
+/* Create arbitrary resampler object with a square-root Nyquist         */  \
+/* prototype convolved into the polyphase bank, producing               */  \
+/* matched-filter shaped samples at arbitrary output rate in a single   */  \
+/* pass (e.g. for variable-rate transmit chains, replacing a            */  \
+/* resamp/firinterp cascade)                                            */  \
+/*  _type   : filter type (e.g. LIQUID_FIRFILT_RRC)                     */  \
+/*  _rate   : resampling rate (output samples per input symbol)         */  \
+/*  _m      : prototype filter semi-length (symbols)                    */  \
+/*  _beta   : prototype filter excess bandwidth, 0 < _beta <= 1         */  \
+/*  _npfb   : number of filters in polyphase filterbank                 */  \
+RESAMP() RESAMP(_create_prototype)(int          _type,                      \
+                                   float        _rate,                      \
+                                   unsigned int _m,                         \
+                                   float        _beta,                      \
+                                   unsigned int _npfb);                     \
+                                                                            \
 /* Destroy arbitrary resampler object, freeing all internal memory      */  \
 void RESAMP(_destroy)(RESAMP() _q);                                         \
                                                                             \
@@ -3918,6 +5544,22 @@ void RESAMP(_reset)(RESAMP() _q);                                           \
 /* Get resampler delay (filter semi-length \(m\))                       */  \
 unsigned int RESAMP(_get_delay)(RESAMP() _q);                               \
                                                                             \
+/* Get number of input samples consumed since reset                     */  \
+unsigned long long RESAMP(_get_num_input)(RESAMP() _q);                     \
+                                                                            \
+/* Get number of output samples produced since reset                    */  \
+unsigned long long RESAMP(_get_num_output)(RESAMP() _q);                    \
+                                                                            \
+/* Get exact resampling rate realized by the quantized internal phase   */  \
+/* step; differs slightly from the requested rate and is the value to   */  \
+/* use when mapping output sample indices back to input sample times    */  \
+double RESAMP(_get_rate_actual)(RESAMP() _q);                               \
+                                                                            \
+/* Get input-clock time of the next output sample to be produced,       */  \
+/* measured in (fractional) input samples since reset and compensated   */  \
+/* for the filter group delay; exact under rate adjustments             */  \
+double RESAMP(_get_next_output_time)(RESAMP() _q);                          \
+                                                                            \
 /* Set rate of arbitrary resampler                                      */  \
 /*  _q      : resampling object                                         */  \
 /*  _rate   : new sampling rate, _rate > 0                              */  \
@@ -3945,6 +5587,21 @@ void RESAMP(_set_timing_phase)(RESAMP() _q,                                 \
 void RESAMP(_adjust_timing_phase)(RESAMP() _q,                              \
                                   float    _delta);                         \
                                                                             \
+/* Enable Farrow-structure execution engine: the polyphase branch       */  \
+/* response is fit to a short polynomial in the timing phase and each   */  \
+/* output is evaluated from a fixed set of sub-filters with no          */  \
+/* per-sample branch selection, trading a small filter approximation    */  \
+/* error for a branch-free kernel. Enabling (or re-enabling) the        */  \
+/* engine resets the object state.                                      */  \
+/*  _q      : resampling object                                         */  \
+/*  _order  : polynomial order (e.g. 3), 1 <= _order <= 8               */  \
+void RESAMP(_enable_farrow)(RESAMP()     _q,                                \
+                            unsigned int _order);                           \
+                                                                            \
+/* Disable Farrow-structure execution engine, reverting to polyphase    */  \
+/* branch selection; the object state is reset                          */  \
+void RESAMP(_disable_farrow)(RESAMP() _q);                                  \
+                                                                            \
 /* Execute arbitrary resampler on a single input sample and store the   */  \
 /* resulting samples in the output array. The number of output samples  */  \
 /* is depenent upon the resampling rate but will be at most             */  \
@@ -4043,6 +5700,11 @@ int MSRESAMP2(_get_type)(MSRESAMP2() _q);                                   \
 /* Get group delay (number of output samples)                           */  \
 float MSRESAMP2(_get_delay)(MSRESAMP2() _q);                                \
                                                                             \
+/* Get strict latency bound (number of output samples): integer upper   */  \
+/* bound on the group delay including the input accumulation of the     */  \
+/* streaming interface when running as a decimator                      */  \
+unsigned int MSRESAMP2(_get_latency)(MSRESAMP2() _q);                       \
+                                                                            \
 /* Execute multi-stage resampler, M = 2^num_stages                      */  \
 /*  LIQUID_RESAMP_INTERP:   input: 1,   output: M                       */  \
 /*  LIQUID_RESAMP_DECIM:    input: M,   output: 1                       */  \
@@ -4052,6 +5714,21 @@ float MSRESAMP2(_get_delay)(MSRESAMP2() _q);                                \
 void MSRESAMP2(_execute)(MSRESAMP2() _q,                                    \
                          TI *        _x,                                    \
                          TO *        _y);                                   \
+                                                                            \
+/* Execute multi-stage resampler on a block of samples with arbitrary   */  \
+/* call granularity. As a decimator, input samples are accumulated      */  \
+/* internally and an output sample is produced whenever a full block of */  \
+/* M samples is available, so calls need not align to the decimation    */  \
+/* factor. Returns the number of output samples written.                */  \
+/*  _q      : msresamp object                                           */  \
+/*  _x      : input sample array, [size: _nx x 1]                       */  \
+/*  _nx     : input sample array size                                   */  \
+/*  _y      : output sample array, [size: _nx*M x 1] (interpolator) or  */  \
+/*            at most [size: (_nx+M-1)/M x 1] (decimator)               */  \
+unsigned int MSRESAMP2(_execute_stream)(MSRESAMP2()  _q,                    \
+                                        TI *         _x,                    \
+                                        unsigned int _nx,                   \
+                                        TO *         _y);                   \
 
 LIQUID_MSRESAMP2_DEFINE_API(LIQUID_MSRESAMP2_MANGLE_RRRF,
                             float,
@@ -4104,6 +5781,40 @@ float MSRESAMP(_get_delay)(MSRESAMP() _q);                                  \
 /* get overall resampling rate                                          */  \
 float MSRESAMP(_get_rate)(MSRESAMP() _q);                                   \
                                                                             \
+/* Get exact composite resampling rate realized by the stage cascade;   */  \
+/* the half-band and integer stages are exact powers so only the        */  \
+/* arbitrary stage's quantized phase step contributes                   */  \
+double MSRESAMP(_get_rate_actual)(MSRESAMP() _q);                           \
+                                                                            \
+/* Get number of input samples consumed since reset                     */  \
+unsigned long long MSRESAMP(_get_num_input)(MSRESAMP() _q);                 \
+                                                                            \
+/* Get number of output samples produced since reset                    */  \
+unsigned long long MSRESAMP(_get_num_output)(MSRESAMP() _q);                \
+                                                                            \
+/* Get input-clock time of a given output sample, measured in           */  \
+/* (fractional) input samples since reset and compensated for the       */  \
+/* composite filter group delay, so output streams can carry            */  \
+/* drift-free timestamps                                                */  \
+/*  _q      : multi-stage resampler object                              */  \
+/*  _k      : output sample index (counted from reset)                  */  \
+double MSRESAMP(_get_output_time)(MSRESAMP()         _q,                    \
+                                  unsigned long long _k);                   \
+                                                                            \
+/* Get stage plan selected by the internal cost model: the number of    */  \
+/* half-band stages, the integer decimation factor (1 if no integer     */  \
+/* stage was created), and the rate of the final arbitrary resampling   */  \
+/* stage (exactly 1 if the composite rate is realized without it).      */  \
+/* Pointers may be NULL to ignore a particular value.                   */  \
+/*  _q              : multi-stage resampler object                      */  \
+/*  _num_halfband   : number of half-band stages                        */  \
+/*  _decim_factor   : integer decimation factor                         */  \
+/*  _rate_arbitrary : rate of arbitrary resampling stage                */  \
+void MSRESAMP(_get_plan)(MSRESAMP()     _q,                                 \
+                         unsigned int * _num_halfband,                      \
+                         unsigned int * _decim_factor,                      \
+                         float *        _rate_arbitrary);                   \
+                                                                            \
 /* Execute multi-stage resampler on one or more input samples.          */  \
 /* The number of output samples is dependent upon the resampling rate   */  \
 /* and the number of input samples. In general it is good practice to   */  \
@@ -4142,6 +5853,17 @@ LIQUID_MSRESAMP_DEFINE_API(LIQUID_MSRESAMP_MANGLE_CCCF,
 #define LIQUID_SYMSYNC_MANGLE_RRRF(name) LIQUID_CONCAT(symsync_rrrf,name)
 #define LIQUID_SYMSYNC_MANGLE_CRCF(name) LIQUID_CONCAT(symsync_crcf,name)
 
+// symbol-timing tracking statistics snapshot; filled atomically by
+// symsync_xxx_get_stats() and safe to request from a monitoring thread
+// while another thread runs the synchronizer
+typedef struct {
+    float             timing_error_mean;    // smoothed timing error
+    float             timing_error_var;     // smoothed timing error variance
+    float             rate;                 // instantaneous resampling rate
+    float             tau;                  // current timing phase estimate
+    unsigned long int num_symbols;          // symbols through timing loop
+} liquid_symsync_stats;
+
 #define LIQUID_SYMSYNC_DEFINE_API(SYMSYNC,TO,TC,TI)                         \
                                                                             \
 /* Multi-rate symbol synchronizer for symbol timing recovery.           */  \
@@ -4210,6 +5932,38 @@ void SYMSYNC(_set_lf_bw)(SYMSYNC() _q,                                      \
 /* Return instantaneous fractional timing offset estimate               */  \
 float SYMSYNC(_get_tau)(SYMSYNC() _q);                                      \
                                                                             \
+/* Get consistent snapshot of timing-tracking statistics. The           */  \
+/* statistics are accumulated in the per-symbol timing update at        */  \
+/* negligible cost and published through a sequence counter, so this    */  \
+/* method may be called from a monitoring thread without a mutex on     */  \
+/* the synchronizer's hot path.                                         */  \
+/*  _q      : synchronizer object                                       */  \
+/*  _stats  : output statistics snapshot                                */  \
+void SYMSYNC(_get_stats)(SYMSYNC()              _q,                         \
+                         liquid_symsync_stats * _stats);                    \
+                                                                            \
+/* Get size of serialized timing state in bytes                         */  \
+unsigned int SYMSYNC(_get_state_size)(SYMSYNC() _q);                        \
+                                                                            \
+/* Save converged timing state (resampling rate, timing phase and       */  \
+/* filtered error) into buffer for later warm start                     */  \
+/*  _q       : synchronizer object                                      */  \
+/*  _buf     : output buffer, [size: _buf_len x 1]                      */  \
+/*  _buf_len : buffer length, must match SYMSYNC(_get_state_size)       */  \
+void SYMSYNC(_save_state)(SYMSYNC()       _q,                               \
+                          unsigned char * _buf,                             \
+                          unsigned int    _buf_len);                        \
+                                                                            \
+/* Restore timing state previously saved with SYMSYNC(_save_state);     */  \
+/* the object must have the same configuration as the one the state     */  \
+/* was saved from                                                       */  \
+/*  _q       : synchronizer object                                      */  \
+/*  _buf     : input buffer, [size: _buf_len x 1]                       */  \
+/*  _buf_len : buffer length, must match SYMSYNC(_get_state_size)       */  \
+void SYMSYNC(_restore_state)(SYMSYNC()       _q,                            \
+                             unsigned char * _buf,                          \
+                             unsigned int    _buf_len);                     \
+                                                                            \
 /* Execute synchronizer on input data array                             */  \
 /*  _q      : synchronizer object                                       */  \
 /*  _x      : input data array, [size: _nx x 1]                         */  \
@@ -4221,6 +5975,29 @@ void SYMSYNC(_execute)(SYMSYNC()      _q,                                   \
                        unsigned int   _nx,                                  \
                        TO *           _y,                                   \
                        unsigned int * _ny);                                 \
+                                                                            \
+/* Execute synchronizer on a large block of input samples, equivalent   */  \
+/* to execute() but optimized for streaming operation: when the         */  \
+/* synchronizer is locked the timing-error update is hoisted out of the */  \
+/* inner loop entirely                                                  */  \
+/*  _q      : synchronizer object                                       */  \
+/*  _x      : input data array, [size: _nx x 1]                         */  \
+/*  _nx     : number of input samples                                   */  \
+/*  _y      : output data array                                         */  \
+/*  _ny     : number of samples written to output buffer                */  \
+void SYMSYNC(_execute_stream)(SYMSYNC()      _q,                            \
+                              TI *           _x,                            \
+                              unsigned int   _nx,                           \
+                              TO *           _y,                            \
+                              unsigned int * _ny);                          \
+                                                                            \
+/* Get upper bound on the number of output samples written by a single  */  \
+/* call to execute() or execute_stream() with _nx input samples,        */  \
+/* suitable for allocating the output buffer once up front              */  \
+/*  _q      : synchronizer object                                       */  \
+/*  _nx     : number of input samples                                   */  \
+unsigned int SYMSYNC(_get_output_max)(SYMSYNC()    _q,                      \
+                                      unsigned int _nx);                    \
 
 LIQUID_SYMSYNC_DEFINE_API(LIQUID_SYMSYNC_MANGLE_RRRF,
                           float,
@@ -4408,6 +6185,133 @@ LIQUID_ORDFILT_DEFINE_API(LIQUID_ORDFILT_MANGLE_RRRF,
                           float)
 
 
+//
+// MODULE : framework
+//
+
+// flowgraphcf : stream-graph execution engine connecting block-based
+// processing nodes (wrapping existing liquid objects) with batched
+// hand-off: each cache-sized chunk of samples is carried through the
+// entire chain before the next chunk is read
+
+// node processing function: consume _n input samples from _x, write
+// output samples to _y, and return the number of output samples
+//  _context    : node object (as registered with flowgraphcf_add_node)
+//  _x          : input sample array [size: _n x 1]
+//  _n          : number of input samples
+//  _y          : output sample array
+typedef unsigned int (*flowgraphcf_node_proc)(void *                 _context,
+                                              liquid_float_complex * _x,
+                                              unsigned int           _n,
+                                              liquid_float_complex * _y);
+
+typedef struct flowgraphcf_s * flowgraphcf;
+
+// create flowgraph object
+//  _block_len  : scheduling chunk size [samples], _block_len > 0
+flowgraphcf flowgraphcf_create(unsigned int _block_len);
+
+// destroy flowgraph object; registered node objects are user-owned
+// and are not destroyed
+void flowgraphcf_destroy(flowgraphcf _q);
+
+// print flowgraph object internals
+void flowgraphcf_print(flowgraphcf _q);
+
+// reset flowgraph scheduling state; node objects are not reset
+void flowgraphcf_reset(flowgraphcf _q);
+
+// append processing node to the end of the chain
+//  _q          : flowgraph object
+//  _proc       : node processing function
+//  _context    : node object passed to the processing function
+//  _rate       : maximum output/input sample ratio, _rate > 0
+void flowgraphcf_add_node(flowgraphcf           _q,
+                          flowgraphcf_node_proc _proc,
+                          void *                _context,
+                          float                 _rate);
+
+// get number of nodes in the chain
+unsigned int flowgraphcf_get_num_nodes(flowgraphcf _q);
+
+// get upper bound on the number of output samples generated by
+// executing the graph on _n input samples
+unsigned int flowgraphcf_get_output_max(flowgraphcf  _q,
+                                        unsigned int _n);
+
+// execute the graph on a block of input samples
+//  _q      : flowgraph object
+//  _x      : input sample array [size: _nx x 1]
+//  _nx     : number of input samples
+//  _y      : output array [size: flowgraphcf_get_output_max(_q,_nx) x 1]
+//  _ny     : number of output samples written
+void flowgraphcf_execute(flowgraphcf            _q,
+                         liquid_float_complex * _x,
+                         unsigned int           _nx,
+                         liquid_float_complex * _y,
+                         unsigned int *         _ny);
+
+
+// chanbankcf : work-stealing channel-bank executor, scheduling
+// independent per-channel processing chains (e.g. demodulators behind
+// a firpfbch2 channelizer) across worker threads with automatic load
+// balancing; any one channel always runs in order on a single thread
+
+// channel processing function, invoked with a channel's entire
+// pending sample batch
+//  _context    : common context (as registered with chanbankcf_create)
+//  _channel    : channel index
+//  _x          : pending sample array [size: _n x 1]
+//  _n          : number of pending samples
+typedef void (*chanbankcf_channel_proc)(void *                 _context,
+                                        unsigned int           _channel,
+                                        liquid_float_complex * _x,
+                                        unsigned int           _n);
+
+typedef struct chanbankcf_s * chanbankcf;
+
+// create channel-bank executor
+//  _num_channels   : number of channels in the bank, _num_channels > 0
+//  _num_threads    : number of worker threads, 0 < _num_threads <= 16
+//  _proc           : channel processing function
+//  _context        : common context passed to the processing function
+chanbankcf chanbankcf_create(unsigned int            _num_channels,
+                             unsigned int            _num_threads,
+                             chanbankcf_channel_proc _proc,
+                             void *                  _context);
+
+// destroy channel-bank executor; channel objects referenced by the
+// processing context are user-owned and are not destroyed
+void chanbankcf_destroy(chanbankcf _q);
+
+// print channel-bank executor internals
+void chanbankcf_print(chanbankcf _q);
+
+// reset executor, discarding all pending samples
+void chanbankcf_reset(chanbankcf _q);
+
+// get number of channels in the bank
+unsigned int chanbankcf_get_num_channels(chanbankcf _q);
+
+// get number of samples pending on a channel
+unsigned int chanbankcf_get_num_pending(chanbankcf   _q,
+                                        unsigned int _channel);
+
+// append sample batch to a channel's pending queue
+//  _q          : channel-bank executor
+//  _channel    : channel index
+//  _x          : sample array [size: _n x 1]
+//  _n          : number of samples
+void chanbankcf_submit(chanbankcf             _q,
+                       unsigned int           _channel,
+                       liquid_float_complex * _x,
+                       unsigned int           _n);
+
+// drain all pending channel batches across the worker threads;
+// blocks until every channel has been processed
+void chanbankcf_execute(chanbankcf _q);
+
+
 //
 // MODULE : framing
 //
@@ -4456,6 +6360,58 @@ void framedatastats_reset(framedatastats_s * _stats);
 // print framedatastats object
 void framedatastats_print(framedatastats_s * _stats);
 
+// framedatastats_acc : lock-free multi-threaded frame statistics
+//   accumulator; each thread updates its own slot of atomic counters
+//   (no mutex on the frame path) and queries merge all slots on demand.
+//   Frame latencies (e.g. frame detect to callback return) are gathered
+//   into a fixed-bucket log-scale histogram with bucket i spanning
+//   [2^i, 2^(i+1)) microseconds
+#define LIQUID_FRAMEDATASTATS_HIST (32)
+typedef struct framedatastats_acc_s * framedatastats_acc;
+
+// create accumulator with a counter slot for each of _num_threads threads
+framedatastats_acc framedatastats_acc_create(unsigned int _num_threads);
+
+// destroy accumulator object
+void framedatastats_acc_destroy(framedatastats_acc _q);
+
+// reset all per-thread counters and the latency histogram
+void framedatastats_acc_reset(framedatastats_acc _q);
+
+// print merged statistics and latency percentiles
+void framedatastats_acc_print(framedatastats_acc _q);
+
+// record a received frame from a particular thread (lock-free)
+//  _q             : accumulator object
+//  _thread        : updating thread's slot index
+//  _header_valid  : was header valid?
+//  _payload_valid : was payload valid?
+//  _num_bytes     : number of payload bytes received
+//  _latency       : frame-detect to callback latency [seconds], or -1 to skip
+void framedatastats_acc_update(framedatastats_acc _q,
+                               unsigned int       _thread,
+                               int                _header_valid,
+                               int                _payload_valid,
+                               unsigned int       _num_bytes,
+                               float              _latency);
+
+// merge counters across all threads into an aggregate view
+framedatastats_s framedatastats_acc_get(framedatastats_acc _q);
+
+// merge latency histogram counts across all threads
+//  _counts : output bucket counts [size: LIQUID_FRAMEDATASTATS_HIST x 1]
+void framedatastats_acc_get_histogram(framedatastats_acc  _q,
+                                      unsigned long int * _counts);
+
+// lower edge of latency histogram bucket [seconds]
+float framedatastats_acc_histogram_edge(unsigned int _bucket);
+
+// estimate latency percentile from histogram, _percentile in [0,1];
+// returns upper edge of the bucket containing the requested quantile,
+// or zero if no latencies have been recorded
+float framedatastats_acc_get_latency(framedatastats_acc _q,
+                                     float              _percentile);
+
 
 // Generic frame synchronizer callback function type
 //  _header         :   header data [size: 8 bytes]
@@ -4477,6 +6433,88 @@ typedef int (*framesync_callback)(unsigned char *  _header,
 //  _userdata       :   user-defined data pointer
 typedef void (*framesync_csma_callback)(void * _userdata);
 
+// framesync buffer-exchange callback: invoked after the frame callback
+// returns, transferring ownership of the filled payload buffer to the
+// application; must return a fresh buffer (allocated with malloc(), at
+// least _payload_len bytes) for the synchronizer to fill next
+//  _payload        :   filled payload buffer (application takes ownership)
+//  _payload_len    :   length of payload (bytes)
+//  _userdata       :   user-defined data pointer
+typedef unsigned char * (*framesync_buffer_exchange_callback)(
+    unsigned char * _payload,
+    unsigned int    _payload_len,
+    void *          _userdata);
+
+// framequeue : asynchronous frame callback queue decoupling frame
+//   synchronization from application processing; installing
+//   framequeue_callback() as a synchronizer's callback deposits
+//   (header, payload, stats) records into a bounded lock-free queue
+//   the application drains from another thread.  Multiple producers
+//   (synchronizers) may feed one queue; records are drained by a
+//   single consumer
+typedef struct framequeue_s * framequeue;
+
+// backpressure policy applied when the queue is full
+typedef enum {
+    LIQUID_FRAMEQUEUE_DROP=0,   // drop new frame, counting the overflow
+    LIQUID_FRAMEQUEUE_BLOCK,    // wait for the consumer to free a slot
+} liquid_framequeue_policy;
+
+// create frame callback queue
+//  _capacity   : maximum number of queued frames, _capacity > 0
+//  _header_len : header length of the feeding synchronizer(s) (bytes)
+//  _policy     : backpressure policy (e.g. LIQUID_FRAMEQUEUE_DROP)
+framequeue framequeue_create(unsigned int _capacity,
+                             unsigned int _header_len,
+                             int          _policy);
+
+// destroy frame callback queue, freeing any records still pending
+void framequeue_destroy(framequeue _q);
+
+// discard all pending records without invoking a callback
+void framequeue_reset(framequeue _q);
+
+// print frame callback queue internals
+void framequeue_print(framequeue _q);
+
+// producer-side callback: install as a frame synchronizer's callback
+// with the framequeue object as the userdata pointer; copies the
+// frame record into the queue and returns immediately
+int framequeue_callback(unsigned char *  _header,
+                        int              _header_valid,
+                        unsigned char *  _payload,
+                        unsigned int     _payload_len,
+                        int              _payload_valid,
+                        framesyncstats_s _stats,
+                        void *           _userdata);
+
+// pop a single pending record, invoking the application callback;
+// returns 1 if a record was consumed, 0 if the queue was empty
+//  _q        : frame callback queue
+//  _callback : application frame callback
+//  _userdata : application userdata pointer
+int framequeue_pop(framequeue         _q,
+                   framesync_callback _callback,
+                   void *             _userdata);
+
+// drain all pending records, invoking the application callback on
+// each; returns the number of records consumed
+//  _q        : frame callback queue
+//  _callback : application frame callback
+//  _userdata : application userdata pointer
+unsigned int framequeue_drain(framequeue         _q,
+                              framesync_callback _callback,
+                              void *             _userdata);
+
+// get number of records currently pending
+unsigned int framequeue_get_size(framequeue _q);
+
+// get maximum number of queued records
+unsigned int framequeue_get_capacity(framequeue _q);
+
+// get number of frames dropped on overflow (drop policy only)
+unsigned long int framequeue_get_num_dropped(framequeue _q);
+
 //
 // packet encoder/decoder
 //
@@ -4567,6 +6605,55 @@ int qpacketmodem_decode_soft_sym(qpacketmodem  _q,
 int qpacketmodem_decode_soft_payload(qpacketmodem    _q,
                                      unsigned char * _payload);
 
+// decode symbol from modulated frame samples (hard decision),
+// returning flag if all symbols received
+//  _q          :   qpacketmodem object
+//  _symbol     :   encoded/modulated symbol
+int qpacketmodem_decode_sym(qpacketmodem         _q,
+                            liquid_float_complex _symbol);
+
+// decode payload from symbols previously pushed through
+// qpacketmodem_decode_sym(), returning flag if CRC passed
+//  _q          :   qpacketmodem object
+//  _payload    :   recovered decoded payload bytes
+int qpacketmodem_decode_payload(qpacketmodem    _q,
+                                unsigned char * _payload);
+
+//
+// packet encoder/decoder pool
+//
+
+typedef struct qpmpool_s * qpmpool;
+
+// create packet encoder/decoder pool
+qpmpool qpmpool_create ();
+
+// destroy pool and all pooled objects, including any still checked out
+void    qpmpool_destroy(qpmpool _q);
+void    qpmpool_print  (qpmpool _q);
+
+// acquire configured packet encoder/decoder from pool, re-using an idle
+// object with a matching configuration when one is available and creating
+// one otherwise; returns NULL on invalid configuration
+//  _q           :   pool object
+//  _payload_len :   length of payload message [bytes]
+//  _check       :   data validity check
+//  _fec0        :   inner forward error-correction scheme
+//  _fec1        :   outer forward error-correction scheme
+//  _ms          :   modulation scheme
+qpacketmodem qpmpool_acquire(qpmpool      _q,
+                             unsigned int _payload_len,
+                             crc_scheme   _check,
+                             fec_scheme   _fec0,
+                             fec_scheme   _fec1,
+                             int          _ms);
+
+// return packet encoder/decoder to pool for re-use
+int qpmpool_release(qpmpool _q, qpacketmodem _p);
+
+// get total number of objects held by pool (idle and checked out)
+unsigned int qpmpool_get_num_objects(qpmpool _q);
+
 //
 // pilot generator/synchronizer for packet burst recovery
 //
@@ -4751,6 +6838,12 @@ void flexframegen_set_header_len(flexframegen _q, unsigned int _len);
 int flexframegen_set_header_props(flexframegen          _q,
                                   flexframegenprops_s * _props);
 
+// pre-allocate internal buffers for payloads up to _len_max bytes so
+// that subsequent calls to assemble() with payloads no longer than the
+// maximum are allocation-free
+void flexframegen_set_payload_len_max(flexframegen _q,
+                                      unsigned int _len_max);
+
 // get length of assembled frame (samples)
 unsigned int flexframegen_getframelen(flexframegen _q);
 
@@ -4812,6 +6905,40 @@ void flexframesync_decode_payload_soft(flexframesync _q,
 int flexframesync_set_header_props(flexframesync          _q,
                                    flexframegenprops_s * _props);
 
+// set number of internal payload decoding threads (0: serial operation);
+// frame detection remains on the calling thread while payload decoding
+// of each detected frame is handed to a worker pool, with callbacks
+// invoked in detection order; any outstanding frames are delivered
+// before the worker count changes
+void flexframesync_set_threads(flexframesync _q,
+                               unsigned int  _num_threads);
+
+// set optional buffer-exchange callback for zero-copy payload delivery;
+// after the frame callback returns, ownership of the filled payload
+// buffer transfers to the application, which must return a fresh buffer
+// for the synchronizer to fill next (see framesync_buffer_exchange_callback)
+void flexframesync_set_buffer_exchange(flexframesync                      _q,
+                                       framesync_buffer_exchange_callback _exchange,
+                                       void *                             _userdata);
+
+// set carrier frequency offset search range of the internal detector
+// so a single synchronizer can acquire frames over a wide offset range
+//  _q          :   frame synchronizer object
+//  _dphi_max   :   maximum carrier offset [radians/sample], in [0,pi)
+void flexframesync_set_cfo_range(flexframesync _q,
+                                 float         _dphi_max);
+
+// enable energy-gate squelch: skip frame detection (correlation) while
+// the input signal level is below the given threshold; a pre-trigger
+// history buffer ensures no preamble samples are lost when the gate
+// opens
+//  _threshold  :   signal level threshold [dB]
+void flexframesync_squelch_enable(flexframesync _q,
+                                  float         _threshold);
+
+// disable energy-gate squelch
+void flexframesync_squelch_disable(flexframesync _q);
+
 // push samples through frame synchronizer
 //  _q      :   frame synchronizer object
 //  _x      :   input samples [size: _n x 1]
@@ -4965,6 +7092,11 @@ void fskframesync_execute_block(fskframesync           _q,
                                 liquid_float_complex * _x,
                                 unsigned int           _n);
 
+// enable/disable energy-gate squelch: skip frame detection entirely
+// while the input signal level is below the given threshold [dB]
+void fskframesync_squelch_enable (fskframesync _q, float _threshold);
+void fskframesync_squelch_disable(fskframesync _q);
+
 // debugging
 void fskframesync_debug_enable (fskframesync _q);
 void fskframesync_debug_disable(fskframesync _q);
@@ -5016,6 +7148,17 @@ void gmskframesync_execute(gmskframesync _q,
                            liquid_float_complex * _x,
                            unsigned int _n);
 
+// enable energy-gate squelch: skip frame detection (correlation) while
+// the input signal level is below the given threshold; a pre-trigger
+// history buffer ensures no preamble samples are lost when the gate
+// opens
+//  _threshold  :   signal level threshold [dB]
+void gmskframesync_squelch_enable(gmskframesync _q,
+                                  float         _threshold);
+
+// disable energy-gate squelch
+void gmskframesync_squelch_disable(gmskframesync _q);
+
 // debugging
 void gmskframesync_debug_enable(gmskframesync _q);
 void gmskframesync_debug_disable(gmskframesync _q);
@@ -5144,6 +7287,12 @@ void ofdmflexframegen_set_header_len(ofdmflexframegen _q,
 void ofdmflexframegen_set_header_props(ofdmflexframegen _q,
                                        ofdmflexframegenprops_s * _props);
 
+// pre-allocate internal buffers for payloads up to _len_max bytes so
+// that subsequent calls to assemble() with payloads no longer than the
+// maximum are allocation-free
+void ofdmflexframegen_set_payload_len_max(ofdmflexframegen _q,
+                                          unsigned int     _len_max);
+
 // get length of frame (symbols)
 //  _q              :   OFDM frame generator object
 unsigned int ofdmflexframegen_getframelen(ofdmflexframegen _q);
@@ -5166,6 +7315,18 @@ int ofdmflexframegen_write(ofdmflexframegen       _q,
                           liquid_float_complex * _buf,
                           unsigned int           _buf_len);
 
+// enable pipelined frame assembly: ofdmflexframegen_assemble() stages the
+// frame and returns immediately while encoding runs on a background thread;
+// write() emits zeros until the encoded frame is ready and loads each new
+// frame at a symbol boundary. assemble() blocks if an earlier staged frame
+// has not yet been loaded for transmission. Frame and header properties
+// must not be changed while the pipeline is enabled.
+void ofdmflexframegen_pipeline_enable(ofdmflexframegen _q);
+
+// disable pipelined frame assembly, blocking until any staged frame has
+// been encoded; an encoded frame not yet transmitted remains queued
+void ofdmflexframegen_pipeline_disable(ofdmflexframegen _q);
+
 //
 // OFDM flex frame synchronizer
 //
@@ -5217,6 +7378,14 @@ float ofdmflexframesync_get_cfo(ofdmflexframesync _q);
 void             ofdmflexframesync_reset_framedatastats(ofdmflexframesync _q);
 framedatastats_s ofdmflexframesync_get_framedatastats  (ofdmflexframesync _q);
 
+// set number of internal payload decoding threads (0: serial operation);
+// subcarrier demodulation remains on the calling thread while the FEC
+// decode of each completed frame is handed to a worker pool, with
+// callbacks invoked in detection order; any outstanding frames are
+// delivered before the worker count changes
+void ofdmflexframesync_set_threads(ofdmflexframesync _q,
+                                   unsigned int      _num_threads);
+
 // set the received carrier offset estimate
 void ofdmflexframesync_set_cfo(ofdmflexframesync _q, float _cfo);
 
@@ -5350,6 +7519,20 @@ LIQUID_PRESYNC_DEFINE_API(LIQUID_BPRESYNC_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+// enable two-stage (hierarchical) acquisition: a short correlator over
+// the last _prefix_len sequence symbols runs first and the full-length,
+// all-Doppler correlation is computed only at offsets where its output
+// magnitude meets _threshold
+//  _q          : binary pre-demod synchronizer object
+//  _prefix_len : prefix correlator length, 0 < _prefix_len <= n
+//  _threshold  : pre-screening detection threshold (e.g. 0.5)
+void bpresync_cccf_enable_prefix(bpresync_cccf _q,
+                                 unsigned int  _prefix_len,
+                                 float         _threshold);
+
+// disable two-stage acquisition, reverting to full correlation
+void bpresync_cccf_disable_prefix(bpresync_cccf _q);
+
 //
 // Frame detector
 //
@@ -5406,10 +7589,34 @@ qdetector_cccf qdetector_cccf_create_cpfsk(unsigned char * _sequence,
                                            float           _beta,
                                            int             _type);
 
+// copy detector object, re-using the pre-computed template spectrum of
+// the original
+qdetector_cccf qdetector_cccf_copy(qdetector_cccf _q);
+
 void qdetector_cccf_destroy(qdetector_cccf _q);
 void qdetector_cccf_print  (qdetector_cccf _q);
 void qdetector_cccf_reset  (qdetector_cccf _q);
 
+// set new template and reset detector state, re-using internal buffers
+// and transform plans when the transform size is unchanged
+//  _s      :   new sample sequence
+//  _s_len  :   length of sample sequence
+void qdetector_cccf_reset_template(qdetector_cccf         _q,
+                                   liquid_float_complex * _s,
+                                   unsigned int           _s_len);
+
+// add detection template, searching all templates simultaneously with a
+// single forward transform of the input per block; the new template must
+// yield the same transform size as the existing one(s)
+//  _s      :   additional sample sequence
+//  _s_len  :   length of sample sequence
+void qdetector_cccf_add_template(qdetector_cccf         _q,
+                                 liquid_float_complex * _s,
+                                 unsigned int           _s_len);
+
+// index of template which generated the most recent detection
+unsigned int qdetector_cccf_get_template_index(qdetector_cccf _q);
+
 // run detector, looking for sequence; return pointer to aligned, buffered samples
 void * qdetector_cccf_execute(qdetector_cccf       _q,
                               liquid_float_complex _x);
@@ -5457,6 +7664,21 @@ void detector_cccf_print(detector_cccf _q);
 // reset pre-demod detector internal state
 void detector_cccf_reset(detector_cccf _q);
 
+// enable dual-rate pre-search: a coarse correlation runs on the input
+// decimated by _M and the full-rate correlator bank executes only
+// around candidate peaks passing _threshold (set comfortably below the
+// main detection threshold, e.g. 0.8 of it); intended for heavily
+// over-sampled sequences where decimation preserves the peak
+//  _q          :   pre-demod detector
+//  _M          :   decimation factor (e.g. 4), sequence length must be divisible by _M
+//  _threshold  :   coarse detection threshold
+void detector_cccf_enable_presearch(detector_cccf _q,
+                                    unsigned int  _M,
+                                    float         _threshold);
+
+// disable dual-rate pre-search, reverting to full-rate correlation
+void detector_cccf_disable_presearch(detector_cccf _q);
+
 // Run sample through pre-demod detector's correlator.
 // Returns '1' if signal was detected, '0' otherwise
 //  _q          :   pre-demod detector
@@ -5523,6 +7745,20 @@ void SYMSTREAM(_set_gain)(SYMSTREAM() _q,                                   \
 /* Get internal linear gain (before interpolation)                      */  \
 float SYMSTREAM(_get_gain)(SYMSTREAM() _q);                                 \
                                                                             \
+/* Set repeating symbol pattern, pre-rendering one period of the        */  \
+/* interpolated waveform; subsequent calls to write_samples() serve     */  \
+/* the cached waveform by copy instead of running the full              */  \
+/* modulation/filter chain                                              */  \
+/*  _q       : symstream object                                         */  \
+/*  _syms    : symbol indices defining one period [size:_num_syms x 1]  */  \
+/*  _num_syms: pattern length [symbols]                                 */  \
+void SYMSTREAM(_set_pattern)(SYMSTREAM()    _q,                             \
+                             unsigned int * _syms,                          \
+                             unsigned int   _num_syms);                     \
+                                                                            \
+/* Clear repeating symbol pattern, reverting to random generation       */  \
+void SYMSTREAM(_clear_pattern)(SYMSTREAM() _q);                             \
+                                                                            \
 /* Write block of samples to output buffer                              */  \
 /*  _q      : synchronizer object                                       */  \
 /*  _buf    : output buffer [size: _buf_len x 1]                        */  \
@@ -5567,6 +7803,15 @@ void MSOURCE(_print)(MSOURCE() _q);                                         \
 /* Reset msource object                                                 */  \
 void MSOURCE(_reset)(MSOURCE() _q);                                         \
                                                                             \
+/* Set number of worker threads rendering sources in parallel; each     */  \
+/* worker accumulates its sources into a private buffer and the         */  \
+/* buffers are reduced in a fixed order, so output is deterministic     */  \
+/* for a given thread count                                             */  \
+/*  _q          : msource object                                        */  \
+/*  _num_threads: number of workers, 0 to disable threaded generation   */  \
+void MSOURCE(_set_num_threads)(MSOURCE()    _q,                             \
+                               unsigned int _num_threads);                  \
+                                                                            \
 /* user-defined callback for generating samples                         */  \
 typedef int (*MSOURCE(_callback))(void *       _userdata,                   \
                                   TO *         _v,                          \
@@ -5810,6 +8055,118 @@ LIQUID_SYMTRACK_DEFINE_API(LIQUID_SYMTRACK_MANGLE_CCCF,
 
 
 
+//
+// MODULE : io (streaming sample file input/output)
+//
+
+// on-disk sample formats
+#define LIQUID_IQFILE_CF32 (0) // 32-bit float complex (native)
+#define LIQUID_IQFILE_SC16 (1) // 16-bit signed integer complex, interleaved
+
+//
+// streaming sample reader; samples are delivered as 32-bit float
+// complex regardless of the on-disk format, converting (and scaling)
+// on load. Files are memory-mapped where supported; otherwise reads
+// are double-buffered with asynchronous prefetch.
+//
+typedef struct iqreadercf_s * iqreadercf;
+
+// create sample stream reader
+//  _filename   : input file name
+//  _format     : on-disk sample format (e.g. LIQUID_IQFILE_SC16)
+iqreadercf iqreadercf_create(const char * _filename,
+                             int          _format);
+
+// destroy reader object, closing file and freeing internal memory
+void iqreadercf_destroy(iqreadercf _q);
+
+// print reader object internals
+void iqreadercf_print(iqreadercf _q);
+
+// rewind reader to the beginning of the file
+void iqreadercf_reset(iqreadercf _q);
+
+// get total number of samples in file
+unsigned long int iqreadercf_get_num_samples(iqreadercf _q);
+
+// read block of samples, converting to 32-bit float complex;
+// returns the number of samples written to the output
+//  _q              : reader object
+//  _buf            : output array [size: _num_samples x 1]
+//  _num_samples    : maximum number of samples to read
+unsigned long int iqreadercf_read(iqreadercf             _q,
+                                  liquid_float_complex * _buf,
+                                  unsigned long int      _num_samples);
+
+//
+// streaming sample writer; samples are accepted as 32-bit float
+// complex and converted to the on-disk format, with double-buffered
+// asynchronous flushing to disk
+//
+typedef struct iqwritercf_s * iqwritercf;
+
+// create sample stream writer
+//  _filename   : output file name
+//  _format     : on-disk sample format (e.g. LIQUID_IQFILE_SC16)
+iqwritercf iqwritercf_create(const char * _filename,
+                             int          _format);
+
+// destroy writer object, flushing pending samples and closing the file
+void iqwritercf_destroy(iqwritercf _q);
+
+// print writer object internals
+void iqwritercf_print(iqwritercf _q);
+
+// get total number of samples written
+unsigned long int iqwritercf_get_num_samples(iqwritercf _q);
+
+// write block of samples, converting to the on-disk format
+//  _q              : writer object
+//  _buf            : input array [size: _num_samples x 1]
+//  _num_samples    : number of samples to write
+void iqwritercf_write(iqwritercf             _q,
+                      liquid_float_complex * _buf,
+                      unsigned long int      _num_samples);
+
+//
+// compliance recorder; samples are converted straight from the
+// caller's buffer (no intermediate copy) and a SigMF-style JSON
+// metadata sidecar ('<filename>.meta') is emitted on destroy
+//
+typedef struct iqrecordercf_s * iqrecordercf;
+
+// create compliance recorder
+//  _filename   : output file name
+//  _format     : on-disk sample format (e.g. LIQUID_IQFILE_SC16)
+iqrecordercf iqrecordercf_create(const char * _filename,
+                                 int          _format);
+
+// destroy recorder object, closing the file and emitting metadata
+void iqrecordercf_destroy(iqrecordercf _q);
+
+// print recorder object internals
+void iqrecordercf_print(iqrecordercf _q);
+
+// set recording sample rate for metadata [Hz]
+void iqrecordercf_set_sample_rate(iqrecordercf _q,
+                                  float        _sample_rate);
+
+// set recording center frequency for metadata [Hz]
+void iqrecordercf_set_center_frequency(iqrecordercf _q,
+                                       float        _center_frequency);
+
+// get total number of samples recorded
+unsigned long int iqrecordercf_get_num_samples(iqrecordercf _q);
+
+// record block of samples straight from the caller's buffer
+//  _q              : recorder object
+//  _buf            : input array [size: _num_samples x 1]
+//  _num_samples    : number of samples to record
+void iqrecordercf_write(iqrecordercf           _q,
+                        liquid_float_complex * _buf,
+                        unsigned long int      _num_samples);
+
+
 //
 // MODULE : math
 //
@@ -5923,6 +8280,15 @@ float liquid_kaiser(unsigned int _i,
                     unsigned int _wlen,
                     float        _beta);
 
+// Kaiser window computed over the full block; much faster than calling
+// liquid_kaiser() once per tap for long windows
+//  _wlen   :   full window length
+//  _beta   :   Kaiser-Bessel window shape parameter
+//  _w      :   output window buffer, [size: _wlen x 1]
+void liquid_kaiser_window(unsigned int _wlen,
+                          float        _beta,
+                          float *      _w);
+
 // Hamming window
 //  _i      :   window index, _i in [0,_wlen-1]
 //  _wlen   :   full window length
@@ -6009,6 +8375,19 @@ T POLY(_val)(T *          _p,                                               \
              unsigned int _k,                                               \
              T            _x);                                              \
                                                                             \
+/* Evaluate polynomial _p at block of values, equivalent to calling     */  \
+/* POLY(_val) at each point but with a vectorizable inner loop          */  \
+/*  _p      : polynomial coefficients [size _k x 1]                     */  \
+/*  _k      : polynomial coefficients length, order is _k - 1           */  \
+/*  _x      : input values to evaluate polynomial [size: _n x 1]        */  \
+/*  _n      : number of values in _x and _y                             */  \
+/*  _y      : output values [size: _n x 1]                              */  \
+void POLY(_vals)(T *          _p,                                           \
+                 unsigned int _k,                                           \
+                 T *          _x,                                           \
+                 unsigned int _n,                                           \
+                 T *          _y);                                          \
+                                                                            \
 /* Perform least-squares polynomial fit on data set                     */  \
 /*  _x      : x-value sample set [size: _n x 1]                         */  \
 /*  _y      : y-value sample set [size: _n x 1]                         */  \
@@ -6129,6 +8508,19 @@ void POLY(_findroots_durandkerner)(T *          _p,                         \
                                    unsigned int _k,                         \
                                    TC *         _roots);                    \
                                                                             \
+/* Refine complex roots of the polynomial with Durand-Kerner sweeps     */  \
+/* seeded from previous estimates, skipping roots that have settled.    */  \
+/* Intended for incremental redesigns where the coefficients change     */  \
+/* slightly between calls; falls back to a fresh search when the seeds  */  \
+/* fail to converge.                                                    */  \
+/*  _p      : polynomial coefficients [size: _n x 1]                    */  \
+/*  _k      : polynomial length                                         */  \
+/*  _roots  : input previous root estimates, output refined roots       */  \
+/*            [size: _k-1 x 1]                                          */  \
+void POLY(_findroots_warmstart)(T *          _p,                            \
+                                unsigned int _k,                            \
+                                TC *         _roots);                       \
+                                                                            \
 /* Find the complex roots of the polynomial using Bairstow's method.    */  \
 /*  _p      : polynomial coefficients [size: _n x 1]                    */  \
 /*  _k      : polynomial length                                         */  \
@@ -6687,6 +9079,11 @@ void SMATRIX(_mul)(SMATRIX() _x,                                            \
                    SMATRIX() _y,                                            \
                    SMATRIX() _z);                                           \
                                                                             \
+/* Compile contiguous (CSR) representation of non-zero entries,         */  \
+/* accelerating subsequent calls to SMATRIX(_vmul); the compiled        */  \
+/* arrays are invalidated internally when the matrix is modified        */  \
+void SMATRIX(_compile)(SMATRIX() _q);                                       \
+                                                                            \
 /* Multiply sparse matrix by vector                                     */  \
 /*  _q  : sparse matrix                                                 */  \
 /*  _x  : input vector, [size: _n x 1]                                  */  \
@@ -6723,6 +9120,88 @@ void smatrixb_vmulf(smatrixb _q,
                     float *  _x,
                     float *  _y);
 
+//
+// packed binary matrix over GF(2)
+//
+// Rows are stored 64 bits per word so row operations (XOR, Gauss-Jordan
+// elimination, matrix-vector products) run word-wide rather than
+// bit-per-byte, e.g. for generator/parity-check matrix manipulation of
+// custom block codes
+//
+typedef struct bmatrix_s * bmatrix;
+
+// create _M x _N packed binary matrix, initialized with zeros
+bmatrix bmatrix_create(unsigned int _M,
+                       unsigned int _N);
+
+// create _m x _n packed binary matrix, initialized on expanded
+// (bit-per-byte) array
+//  _x  : input matrix, [size: _m x _n]
+//  _m  : number of rows in input matrix
+//  _n  : number of columns in input matrix
+bmatrix bmatrix_create_array(unsigned char * _x,
+                             unsigned int    _m,
+                             unsigned int    _n);
+
+// create packed binary matrix from sparse binary matrix
+bmatrix bmatrix_create_smatrixb(smatrixb _A);
+
+// destroy packed binary matrix, freeing all internal memory
+void bmatrix_destroy(bmatrix _q);
+
+// print packed binary matrix to stdout
+void bmatrix_print(bmatrix _q);
+
+// zero all elements, retaining allocated memory
+void bmatrix_clear(bmatrix _q);
+
+// get size of packed binary matrix (number of rows and columns)
+void bmatrix_size(bmatrix        _q,
+                  unsigned int * _m,
+                  unsigned int * _n);
+
+// set the value in matrix at specified row and column (0 or 1)
+void bmatrix_set(bmatrix      _q,
+                 unsigned int _m,
+                 unsigned int _n,
+                 int          _v);
+
+// get the value from matrix at specified row and column
+int bmatrix_get(bmatrix      _q,
+                unsigned int _m,
+                unsigned int _n);
+
+// initialize to identity matrix
+void bmatrix_eye(bmatrix _q);
+
+// add (XOR) row _src into row _dst, one word at a time
+void bmatrix_row_xor(bmatrix      _q,
+                     unsigned int _dst,
+                     unsigned int _src);
+
+// swap two rows
+void bmatrix_row_swap(bmatrix      _q,
+                      unsigned int _r0,
+                      unsigned int _r1);
+
+// Gauss-Jordan elimination over GF(2) with word-wide row operations,
+// reducing the matrix to reduced row-echelon form in place; returns
+// the rank of the matrix
+unsigned int bmatrix_gjelim(bmatrix _q);
+
+// multiply packed binary matrix by expanded binary vector over GF(2)
+//  _q  : packed binary matrix object
+//  _x  : input vector, [size: _N x 1]
+//  _y  : output vector, [size: _M x 1]
+void bmatrix_vmul(bmatrix         _q,
+                  unsigned char * _x,
+                  unsigned char * _y);
+
+// copy packed binary matrix into sparse binary matrix of the same
+// dimensions, clearing the destination first
+void bmatrix_to_smatrixb(bmatrix  _q,
+                         smatrixb _A);
+
 
 //
 // MODULE : modem (modulator/demodulator)
@@ -6906,6 +9385,18 @@ void MODEM(_modulate)(MODEM()      _q,                                      \
                       unsigned int _s,                                      \
                       TC *         _y);                                     \
                                                                             \
+/* Modulate a block of input symbols and generate output samples. For   */  \
+/* table-driven schemes this reduces to a single look-up loop over the  */  \
+/* precomputed constellation map without per-symbol dispatch.           */  \
+/*  _q  : modem object                                                  */  \
+/*  _s  : input symbol array, 0 <= _s[i] <= M-1, [size: _n x 1]         */  \
+/*  _n  : number of input symbols                                       */  \
+/*  _y  : output sample array, [size: _n x 1]                           */  \
+void MODEM(_modulate_block)(MODEM()        _q,                              \
+                            unsigned int * _s,                              \
+                            unsigned int   _n,                              \
+                            TC *           _y);                             \
+                                                                            \
 /* Demodulate input sample and provide maximum-likelihood estimate of   */  \
 /* symbol that would have generated it.                                 */  \
 /* The output is a hard decision value on the input sample.             */  \
@@ -6938,6 +9429,23 @@ void MODEM(_demodulate_soft)(MODEM()         _q,                            \
                              unsigned int  * _s,                            \
                              unsigned char * _soft_bits);                   \
                                                                             \
+/* Demodulate a block of samples, providing for each the hard symbol    */  \
+/* estimate and the log-likelihood ratio (LLR, soft bits) of each bit.  */  \
+/* Soft bits are computed from the exact minimum distance over each     */  \
+/* per-bit constellation subset using internal tables generated when    */  \
+/* the method is first invoked, making this considerably faster than    */  \
+/* demodulating one symbol at a time for large blocks.                  */  \
+/*  _q          : modem object                                          */  \
+/*  _x          : input sample array, [size: _n x 1]                    */  \
+/*  _n          : number of input samples                               */  \
+/*  _s          : output hard symbols, [size: _n x 1]                   */  \
+/*  _soft_bits  : output soft bits, [size: _n*log2(M) x 1]              */  \
+void MODEM(_demodulate_soft_block)(MODEM()         _q,                      \
+                                   TC *            _x,                      \
+                                   unsigned int    _n,                      \
+                                   unsigned int *  _s,                      \
+                                   unsigned char * _soft_bits);             \
+                                                                            \
 /* Get demodulator's estimated transmit sample                          */  \
 void MODEM(_get_demodulator_sample)(MODEM() _q,                             \
                                     TC *    _x_hat);                        \
@@ -6947,6 +9455,21 @@ float MODEM(_get_demodulator_phase_error)(MODEM() _q);                      \
                                                                             \
 /* Get demodulator error vector magnitude                               */  \
 float MODEM(_get_demodulator_evm)(MODEM() _q);                              \
+                                                                            \
+/* Estimate error vector magnitude and signal-to-noise ratio over a     */  \
+/* block of received samples in a single pass, hard-demodulating each   */  \
+/* sample internally. This provides per-frame link quality metrics      */  \
+/* without demodulating one symbol at a time just for the metric.       */  \
+/*  _q      : modem object                                              */  \
+/*  _x      : received sample array, [size: _n x 1]                     */  \
+/*  _n      : number of samples, _n > 0                                 */  \
+/*  _evm    : output rms error vector magnitude (linear); may be NULL   */  \
+/*  _snr    : output estimated signal-to-noise ratio [dB]; may be NULL  */  \
+void MODEM(_estimate_evm_snr)(MODEM()      _q,                              \
+                              TC *         _x,                              \
+                              unsigned int _n,                              \
+                              T *          _evm,                            \
+                              T *          _snr);                           \
 
 // define modem APIs
 LIQUID_MODEM_DEFINE_API(LIQUID_MODEM_MANGLE_FLOAT,float,liquid_float_complex)
@@ -7143,6 +9666,26 @@ fskdem fskdem_create(unsigned int _m,
                      unsigned int _k,
                      float        _bandwidth);
 
+// create fskdem object using a bank of Goertzel resonators rather
+// than a full FFT; only the candidate tone bins are evaluated so the
+// per-symbol cost is O(M*k) independent of the transform size
+//  _m          :   bits per symbol, _bps > 0
+//  _k          :   samples/symbol, _k >= 2^_m
+//  _bandwidth  :   total signal bandwidth, (0,0.5)
+fskdem fskdem_create_goertzel(unsigned int _m,
+                              unsigned int _k,
+                              float        _bandwidth);
+
+// create fskdem object with the demodulation engine selected from the
+// process-wide tuning table (see liquid_tune); without a recorded
+// measurement the FFT engine is used
+//  _m          :   bits per symbol, _m > 0
+//  _k          :   samples/symbol, _k >= 2^_m
+//  _bandwidth  :   total signal bandwidth, (0,0.5)
+fskdem fskdem_create_auto(unsigned int _m,
+                          unsigned int _k,
+                          float        _bandwidth);
+
 // destroy fskdem object
 void fskdem_destroy(fskdem _q);
 
@@ -7158,6 +9701,22 @@ void fskdem_reset(fskdem _q);
 unsigned int fskdem_demodulate(fskdem                 _q,
                                liquid_float_complex * _y);
 
+// demodulate block of symbols, assuming perfect symbol timing; the
+// internal transform is executed once per symbol with the peak tone
+// search operating on raw (squared magnitude) bin energies, avoiding
+// the per-symbol normalization pass. If _e is not NULL the energy of
+// each candidate tone is stored for soft processing.
+//  _q      :   fskdem object
+//  _y      :   input sample array [size: _n*_k x 1]
+//  _n      :   number of symbols
+//  _s      :   output symbol array [size: _n x 1]
+//  _e      :   output tone energies (ignored if NULL) [size: _n*2^_m x 1]
+void fskdem_demodulate_block(fskdem                 _q,
+                             liquid_float_complex * _y,
+                             unsigned int           _n,
+                             unsigned int *         _s,
+                             float *                _e);
+
 // get demodulator frequency error
 float fskdem_get_frequency_error(fskdem _q);
 
@@ -7242,6 +9801,24 @@ void FREQDEM(_print)(FREQDEM() _q);                             \
 /* reset state                                              */  \
 void FREQDEM(_reset)(FREQDEM() _q);                             \
                                                                 \
+/* enable/disable arcsin-free small-angle discriminator,    */  \
+/* approximating the per-sample phase increment as          */  \
+/* sin(dphi) ~ dphi; roughly twice as fast as the exact     */  \
+/* discriminator and appropriate for high-SNR links with    */  \
+/* modest modulation indices                                */  \
+/*  _q      :   frequency demodulator object                */  \
+/*  _enable :   enable approximation?                       */  \
+void FREQDEM(_set_small_angle)(FREQDEM() _q,                    \
+                               int       _enable);              \
+                                                                \
+/* set de-emphasis time constant, folding a single-pole     */  \
+/* low-pass de-emphasis filter into the demodulator output  */  \
+/* path (e.g. 50 us broadcast de-emphasis: tau = 50e-6*fs)  */  \
+/*  _q      :   frequency demodulator object                */  \
+/*  _tau    :   time constant [samples], 0: disable         */  \
+void FREQDEM(_set_deemphasis)(FREQDEM() _q,                     \
+                              float     _tau);                  \
+                                                                \
 /* demodulate sample                                        */  \
 /*  _q      :   frequency modulator object                  */  \
 /*  _r      :   received signal r(t)                        */  \
@@ -7458,6 +10035,23 @@ void FIRPFBCH2(_reset)(FIRPFBCH2() _q);                         \
 /* print firpfbch2 object internals                         */  \
 void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
                                                                 \
+/* get number of channels                                   */  \
+unsigned int FIRPFBCH2(_get_M)(FIRPFBCH2() _q);                 \
+                                                                \
+/* get channelizer type (e.g. LIQUID_ANALYZER)              */  \
+int FIRPFBCH2(_get_type)(FIRPFBCH2() _q);                       \
+                                                                \
+/* get number of M/2-sample frames processed since reset    */  \
+unsigned long long FIRPFBCH2(_get_num_frames)(FIRPFBCH2() _q);  \
+                                                                \
+/* get high-rate-side sample time of a given frame,         */  \
+/* measured in samples since reset and compensated for the  */  \
+/* prototype filter group delay                             */  \
+/*  _q      :   channelizer object                          */  \
+/*  _frame  :   frame index (counted from reset)            */  \
+double FIRPFBCH2(_get_frame_time)(FIRPFBCH2()        _q,        \
+                                  unsigned long long _frame);   \
+                                                                \
 /* execute filterbank channelizer                           */  \
 /* LIQUID_ANALYZER:     input: M/2, output: M               */  \
 /* LIQUID_SYNTHESIZER:  input: M,   output: M/2             */  \
@@ -7466,6 +10060,29 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
 void FIRPFBCH2(_execute)(FIRPFBCH2() _q,                        \
                          TI *        _x,                        \
                          TO *        _y);                       \
+                                                                \
+/* execute analysis filterbank channelizer over multiple    */  \
+/* steps, writing each channel's output into its own        */  \
+/* contiguous stream (LIQUID_ANALYZER type only)            */  \
+/*  _x      :   channelizer input, [size: _n*M/2 x 1]       */  \
+/*  _y      :   array of M channel buffers, each [_n x 1]   */  \
+/*  _n      :   number of M/2-sample input steps            */  \
+void FIRPFBCH2(_execute_planar)(FIRPFBCH2()  _q,                \
+                                TI *         _x,                \
+                                TO **        _y,                \
+                                unsigned int _n);               \
+                                                                \
+/* execute filterbank channelizer over a block of steps in  */  \
+/* a single call, batching the inverse transforms           */  \
+/* LIQUID_ANALYZER:     input: _n*M/2, output: _n*M         */  \
+/* LIQUID_SYNTHESIZER:  input: _n*M,   output: _n*M/2       */  \
+/*  _x      :   channelizer input                           */  \
+/*  _n      :   number of steps                             */  \
+/*  _y      :   channelizer output                          */  \
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
 
 
 LIQUID_FIRPFBCH2_DEFINE_API(LIQUID_FIRPFBCH2_MANGLE_CRCF,
@@ -7473,6 +10090,16 @@ LIQUID_FIRPFBCH2_DEFINE_API(LIQUID_FIRPFBCH2_MANGLE_CRCF,
                             float,
                             liquid_float_complex)
 
+// execute channelizer on half-precision input, widening internally;
+// see liquid_fp16tof()
+//  _q : channelizer object
+//  _x : input buffer, interleaved half-precision i/q
+//       [size: M x 1 (analyzer) or 2M x 1 (synthesizer) values]
+//  _y : channelizer output
+void firpfbch2_crcf_execute_fp16(firpfbch2_crcf         _q,
+                                 uint16_t *             _x,
+                                 liquid_float_complex * _y);
+
 //
 // Finite impulse response polyphase filterbank channelizer
 // with output rate Fs * P / M
@@ -7663,22 +10290,114 @@ float ofdmframesync_get_cfo(ofdmframesync _q);  // carrier offset estimate
 // set methods
 void ofdmframesync_set_cfo(ofdmframesync _q, float _cfo);  // set carrier offset estimate
 
+// prime acquisition with externally-supplied burst timing (e.g. from a
+// TDMA schedule), skipping the plateau search and starting directly in
+// fine synchronization on the S1 sequence; falls back to full
+// acquisition if the S1 sequence is not found near the hinted position
+//  _q           : synchronizer object
+//  _timing_hint : number of samples before the start of the frame,
+//                 accurate to within a few samples
+//  _cfo_hint    : carrier frequency offset estimate (f/Fs)
+void ofdmframesync_prime(ofdmframesync _q,
+                         unsigned int  _timing_hint,
+                         float         _cfo_hint);
+
 // debugging
 void ofdmframesync_debug_enable(ofdmframesync _q);
 void ofdmframesync_debug_disable(ofdmframesync _q);
 void ofdmframesync_debug_print(ofdmframesync _q, const char * _filename);
 
 
+//
+// combinercf : coherent multi-channel combiner, computing the weighted
+// sum of aligned input streams with complex per-channel weights
+// (beamforming/diversity combining); weights may be set directly or
+// adapted with a normalized LMS update against a known reference
+//
+
+typedef struct combinercf_s * combinercf;
+
+// create combiner object
+//  _num_channels   :   number of input channels
+combinercf combinercf_create(unsigned int _num_channels);
+
+// destroy combiner object
+void combinercf_destroy(combinercf _q);
+
+// print combiner object internals
+void combinercf_print(combinercf _q);
+
+// reset combiner object, setting all weights to unity
+void combinercf_reset(combinercf _q);
+
+// get number of input channels
+unsigned int combinercf_get_num_channels(combinercf _q);
+
+// set all channel weights
+//  _q  :   combiner object
+//  _w  :   weight vector [size: num_channels x 1]
+void combinercf_set_weights(combinercf             _q,
+                            liquid_float_complex * _w);
+
+// set single channel weight
+void combinercf_set_weight(combinercf           _q,
+                           unsigned int         _channel,
+                           liquid_float_complex _w);
+
+// get single channel weight
+liquid_float_complex combinercf_get_weight(combinercf   _q,
+                                           unsigned int _channel);
+
+// set LMS learning rate
+void combinercf_set_bw(combinercf _q,
+                       float      _mu);
+
+// get LMS learning rate
+float combinercf_get_bw(combinercf _q);
+
+// combine aligned channel blocks into weighted sum
+//  _q  :   combiner object
+//  _x  :   array of channel input pointers [size: num_channels x 1], each [size: _n x 1]
+//  _n  :   block size
+//  _y  :   combined output [size: _n x 1]
+void combinercf_execute(combinercf              _q,
+                        liquid_float_complex ** _x,
+                        unsigned int            _n,
+                        liquid_float_complex *  _y);
+
+// combine a single snapshot (one sample per channel)
+//  _q  :   combiner object
+//  _x  :   channel input samples [size: num_channels x 1]
+//  _y  :   combined output sample
+void combinercf_execute_snapshot(combinercf             _q,
+                                 liquid_float_complex * _x,
+                                 liquid_float_complex * _y);
+
+// adjust weights with one normalized LMS step toward a known reference
+// (training symbol or decision), computing the combined output first
+//  _q      :   combiner object
+//  _x      :   channel input samples [size: num_channels x 1]
+//  _d      :   desired (reference) output sample
+//  _d_hat  :   combined output sample (a priori)
+void combinercf_step(combinercf             _q,
+                     liquid_float_complex * _x,
+                     liquid_float_complex   _d,
+                     liquid_float_complex * _d_hat);
+
+
 //
 // MODULE : nco (numerically-controlled oscillator)
 //
 
 // oscillator type
-//  LIQUID_NCO  :   numerically-controlled oscillator (fast)
-//  LIQUID_VCO  :   "voltage"-controlled oscillator (precise)
+//  LIQUID_NCO          :   numerically-controlled oscillator (fast)
+//  LIQUID_VCO          :   "voltage"-controlled oscillator (precise)
+//  LIQUID_NCO_INTERP   :   shared quarter-wave table with linear
+//                          interpolation (compact, low spurs)
 typedef enum {
     LIQUID_NCO=0,
-    LIQUID_VCO
+    LIQUID_VCO,
+    LIQUID_NCO_INTERP
 } liquid_ncotype;
 
 #define LIQUID_NCO_MANGLE_FLOAT(name) LIQUID_CONCAT(nco_crcf, name)
@@ -7693,7 +10412,8 @@ typedef enum {
 typedef struct NCO(_s) * NCO();                                             \
                                                                             \
 /* Create nco object with either fixed-point or floating-point phase    */  \
-/*  _type   : oscillator type, _type in {LIQUID_NCO, LIQUID_VCO}        */  \
+/*  _type   : oscillator type, e.g. LIQUID_NCO, LIQUID_VCO,             */  \
+/*            LIQUID_NCO_INTERP                                         */  \
 NCO() NCO(_create)(liquid_ncotype _type);                                   \
                                                                             \
 /* Destroy nco object, freeing all internally allocated memory          */  \
@@ -7709,6 +10429,26 @@ void NCO(_reset)(NCO() _q);                                                 \
 /* Get frequency of nco object in radians per sample                    */  \
 T NCO(_get_frequency)(NCO() _q);                                            \
                                                                             \
+/* Get size of serialized oscillator state in bytes                     */  \
+unsigned int NCO(_get_state_size)(NCO() _q);                                \
+                                                                            \
+/* Save oscillator state (fixed-point phase and frequency) into buffer  */  \
+/* for later warm start, preserving full 32-bit precision               */  \
+/*  _q       : nco object                                               */  \
+/*  _buf     : output buffer, [size: _buf_len x 1]                      */  \
+/*  _buf_len : buffer length, must match NCO(_get_state_size)           */  \
+void NCO(_save_state)(NCO()           _q,                                   \
+                      unsigned char * _buf,                                 \
+                      unsigned int    _buf_len);                            \
+                                                                            \
+/* Restore oscillator state previously saved with NCO(_save_state)      */  \
+/*  _q       : nco object                                               */  \
+/*  _buf     : input buffer, [size: _buf_len x 1]                       */  \
+/*  _buf_len : buffer length, must match NCO(_get_state_size)           */  \
+void NCO(_restore_state)(NCO()           _q,                                \
+                         unsigned char * _buf,                              \
+                         unsigned int    _buf_len);                         \
+                                                                            \
 /* Set frequency of nco object in radians per sample                    */  \
 /*  _q      : nco object                                                */  \
 /*  _dtheta : input frequency [radians/sample]                          */  \
@@ -7814,6 +10554,71 @@ void NCO(_mix_block_down)(NCO()        _q,                                  \
                           TC *         _x,                                  \
                           TC *         _y,                                  \
                           unsigned int _n);                                 \
+                                                                            \
+/* Rotate vector of interleaved q15 (sc16) samples up by NCO angle      */  \
+/* (stepping), mixing entirely in integer arithmetic with a q15 complex */  \
+/* rotator; the internal phase is advanced as with NCO(_mix_block_up)   */  \
+/*  _q      : nco object                                                */  \
+/*  _x      : input array, interleaved I/Q, [size: 2 _n x 1]            */  \
+/*  _y      : output array, interleaved I/Q, [size: 2 _n x 1]           */  \
+/*  _n      : number of input (and output) samples                      */  \
+void NCO(_mix_block_up_q15)(NCO()        _q,                                \
+                            int16_t *    _x,                                \
+                            int16_t *    _y,                                \
+                            unsigned int _n);                               \
+                                                                            \
+/* Rotate vector of interleaved q15 (sc16) samples down by NCO angle    */  \
+/* (stepping), mixing entirely in integer arithmetic with a q15 complex */  \
+/* rotator; the internal phase is advanced as with NCO(_mix_block_down) */  \
+/*  _q      : nco object                                                */  \
+/*  _x      : input array, interleaved I/Q, [size: 2 _n x 1]            */  \
+/*  _y      : output array, interleaved I/Q, [size: 2 _n x 1]           */  \
+/*  _n      : number of input (and output) samples                      */  \
+void NCO(_mix_block_down_q15)(NCO()        _q,                              \
+                              int16_t *    _x,                              \
+                              int16_t *    _y,                              \
+                              unsigned int _n);                             \
+                                                                            \
+/* Generate a block of a phase-continuous linear-FM chirp, sweeping the */  \
+/* frequency by _df radians/sample each sample. The internal phase and  */  \
+/* frequency are advanced so subsequent calls or mixing operations      */  \
+/* continue the sweep without discontinuity.                            */  \
+/*  _q      : nco object                                                */  \
+/*  _df     : frequency increment per sample [radians/sample^2]         */  \
+/*  _n      : number of output samples                                  */  \
+/*  _y      : array of output samples, [size: _n x 1]                   */  \
+void NCO(_generate_chirp)(NCO()        _q,                                  \
+                          T            _df,                                 \
+                          unsigned int _n,                                  \
+                          TC *         _y);                                 \
+                                                                            \
+/* Generate a linear frequency sweep from the current frequency to a    */  \
+/* target frequency over a block of samples, landing exactly on the     */  \
+/* target. A zero-length block steps to the target immediately, and a   */  \
+/* target equal to the current frequency renders a constant tone.       */  \
+/*  _q      : nco object                                                */  \
+/*  _f1     : target frequency [radians/sample]                         */  \
+/*  _n      : number of output samples                                  */  \
+/*  _y      : array of output samples, [size: _n x 1]                   */  \
+void NCO(_generate_sweep)(NCO()        _q,                                  \
+                          T            _f1,                                 \
+                          unsigned int _n,                                  \
+                          TC *         _y);                                 \
+                                                                            \
+/* Generate a piecewise-linear frequency trajectory: for each segment,  */  \
+/* sweep linearly from the current frequency to the segment's target    */  \
+/* frequency over the segment's duration, concatenating the rendered    */  \
+/* samples                                                              */  \
+/*  _q            : nco object                                          */  \
+/*  _f            : segment target frequencies, [size: _num_segments]   */  \
+/*  _n            : segment durations, [size: _num_segments x 1]        */  \
+/*  _num_segments : number of trajectory segments                       */  \
+/*  _y            : output array, [size: sum(_n) x 1]                   */  \
+void NCO(_generate_trajectory)(NCO()          _q,                           \
+                               T *            _f,                           \
+                               unsigned int * _n,                           \
+                               unsigned int   _num_segments,                \
+                               TC *           _y);                          \
 
 // Define nco APIs
 LIQUID_NCO_DEFINE_API(LIQUID_NCO_MANGLE_FLOAT, float, liquid_float_complex)
@@ -7896,6 +10701,55 @@ void SYNTH(_despread_triple)(SYNTH() _q,                        \
 LIQUID_SYNTH_DEFINE_API(SYNTH_MANGLE_FLOAT, float, liquid_float_complex)
 
 
+#define MSYNTH_MANGLE_FLOAT(name) LIQUID_CONCAT(msynth_crcf, name)
+
+// large macro
+//   MSYNTH : name-mangling macro
+//   T      : primitive data type
+//   TC     : input/output data type
+#define LIQUID_MSYNTH_DEFINE_API(MSYNTH,T,TC)                   \
+                                                                \
+/* Multi-tone synthesizer: bank of phase accumulators       */  \
+/* emitting the summed waveform in a single pass per block  */  \
+typedef struct MSYNTH(_s) * MSYNTH();                           \
+                                                                \
+/* Create multi-tone synthesizer object                     */  \
+/*  _num_tones  : number of tones                           */  \
+MSYNTH() MSYNTH(_create)(unsigned int _num_tones);              \
+void MSYNTH(_destroy)(MSYNTH() _q);                             \
+void MSYNTH(_print)(MSYNTH() _q);                               \
+                                                                \
+/* Reset all tone phases, retaining amplitudes/frequencies  */  \
+void MSYNTH(_reset)(MSYNTH() _q);                               \
+                                                                \
+unsigned int MSYNTH(_get_num_tones)(MSYNTH() _q);               \
+                                                                \
+/* get/set per-tone amplitude, frequency, phase             */  \
+T    MSYNTH(_get_amplitude)(MSYNTH() _q, unsigned int _index);  \
+void MSYNTH(_set_amplitude)(MSYNTH() _q,                        \
+                            unsigned int _index,                \
+                            T _amp);                            \
+T    MSYNTH(_get_frequency)(MSYNTH() _q, unsigned int _index);  \
+void MSYNTH(_set_frequency)(MSYNTH() _q,                        \
+                            unsigned int _index,                \
+                            T _dtheta);                         \
+T    MSYNTH(_get_phase)(MSYNTH() _q, unsigned int _index);      \
+void MSYNTH(_set_phase)(MSYNTH() _q,                            \
+                        unsigned int _index,                    \
+                        T _phi);                                \
+                                                                \
+/* Write block of samples (sum of all tones)                */  \
+/*  _q           : msynth object                            */  \
+/*  _buf         : output buffer [size: _num_samples x 1]   */  \
+/*  _num_samples : number of samples to write               */  \
+void MSYNTH(_write_samples)(MSYNTH() _q,                        \
+                            TC * _buf,                          \
+                            unsigned int _num_samples);         \
+
+// Define msynth APIs
+LIQUID_MSYNTH_DEFINE_API(MSYNTH_MANGLE_FLOAT, float, liquid_float_complex)
+
+
 
 //
 // MODULE : optimization
@@ -7966,6 +10820,12 @@ void gradsearch_destroy(gradsearch _q);
 // Prints current status of search
 void gradsearch_print(gradsearch _q);
 
+// Set number of threads for parallel gradient probes; the caller
+// asserts that the utility callback is thread-safe. A value of 0 or 1
+// evaluates the probes serially (default).
+void gradsearch_set_num_threads(gradsearch   _q,
+                                unsigned int _num_threads);
+
 // Iterate once
 float gradsearch_step(gradsearch _q);
 
@@ -7999,6 +10859,12 @@ void qnsearch_print(qnsearch _g);
 // Resets internal state
 void qnsearch_reset(qnsearch _g);
 
+// Select the memory-bounded L-BFGS engine, retaining a history of _m
+// correction pairs in place of the dense Hessian estimate so each step
+// runs in O(m*n) operations; set _m=0 to restore the default engine.
+// The search is reset when the engine changes.
+void qnsearch_set_lbfgs(qnsearch _g, unsigned int _m);
+
 // Iterate once
 void qnsearch_step(qnsearch _g);
 
@@ -8120,6 +10986,12 @@ void gasearch_set_population_size(gasearch _q,
                                   unsigned int _population_size,
                                   unsigned int _selection_size);
 
+// Set number of threads for parallel fitness evaluation; the caller
+// asserts that the utility callback is thread-safe. A value of 0 or 1
+// evaluates the population serially (default).
+void gasearch_set_num_threads(gasearch     _q,
+                              unsigned int _num_threads);
+
 // Execute the search
 //  _q              :   ga search object
 //  _max_iterations :   maximum number of iterations to run before bailing
@@ -8156,6 +11028,28 @@ void expand_cf_mulaw(liquid_float_complex _y, float _mu, liquid_float_complex *
 unsigned int quantize_adc(float _x, unsigned int _num_bits);
 float quantize_dac(unsigned int _s, unsigned int _num_bits);
 
+// quantize block of samples, hoisting validation and scaling out of
+// the loop; the branch-free body auto-vectorizes
+//  _x          : input array [size: _num_samples x 1]
+//  _num_samples: number of samples
+//  _num_bits   : number of bits per sample
+//  _s          : output sample array [size: _num_samples x 1]
+void quantize_adc_block(float *        _x,
+                        unsigned int   _num_samples,
+                        unsigned int   _num_bits,
+                        unsigned int * _s);
+
+// de-quantize block of samples, hoisting validation and scaling out
+// of the loop
+//  _s          : input sample array [size: _num_samples x 1]
+//  _num_samples: number of samples
+//  _num_bits   : number of bits per sample
+//  _x          : output array [size: _num_samples x 1]
+void quantize_dac_block(unsigned int * _s,
+                        unsigned int   _num_samples,
+                        unsigned int   _num_bits,
+                        float *        _x);
+
 // structured quantizer
 
 typedef enum {
@@ -8209,6 +11103,29 @@ void QUANTIZER(_execute_adc)(QUANTIZER()    _q,                             \
 void QUANTIZER(_execute_dac)(QUANTIZER()  _q,                               \
                              unsigned int _s,                               \
                              T *          _x);                              \
+                                                                            \
+/* Execute quantizer as analog-to-digital converter on a block of       */  \
+/* samples                                                              */  \
+/*  _q          : quantizer object                                      */  \
+/*  _x          : input array [size: _num_samples x 1]                  */  \
+/*  _num_samples: number of samples                                     */  \
+/*  _s          : output sample array [size: _num_samples x 1]          */  \
+void QUANTIZER(_execute_adc_block)(QUANTIZER()    _q,                       \
+                                   T *            _x,                       \
+                                   unsigned int   _num_samples,             \
+                                   unsigned int * _s);                      \
+                                                                            \
+/* Execute quantizer as digital-to-analog converter on a block of       */  \
+/* samples; expansion is a table look-up per axis for all compander     */  \
+/* types                                                                */  \
+/*  _q          : quantizer object                                      */  \
+/*  _s          : input sample array [size: _num_samples x 1]           */  \
+/*  _num_samples: number of samples                                     */  \
+/*  _x          : output array [size: _num_samples x 1]                 */  \
+void QUANTIZER(_execute_dac_block)(QUANTIZER()    _q,                       \
+                                   unsigned int * _s,                       \
+                                   unsigned int   _num_samples,             \
+                                   T *            _x);                      \
 
 LIQUID_QUANTIZER_DEFINE_API(LIQUID_QUANTIZER_MANGLE_FLOAT,  float)
 LIQUID_QUANTIZER_DEFINE_API(LIQUID_QUANTIZER_MANGLE_CFLOAT, liquid_float_complex)
@@ -8219,13 +11136,32 @@ LIQUID_QUANTIZER_DEFINE_API(LIQUID_QUANTIZER_MANGLE_CFLOAT, liquid_float_complex
 //
 
 
+// Random number generator object with per-instance state, enabling
+// independent, reproducible streams (e.g. one per worker thread)
+// without contending on the libc rand() global state
+typedef struct liquid_rng_s * liquid_rng;
+
+// create generator object, seeding internal state
+liquid_rng liquid_rng_create(unsigned long _seed);
+
+// destroy generator object
+void liquid_rng_destroy(liquid_rng _q);
+
+// re-seed generator, resetting internal state
+void liquid_rng_seed(liquid_rng _q, unsigned long _seed);
+
+// advance generator, returning 32 uniform random bits
+unsigned int liquid_rng_uint32(liquid_rng _q);
+
 // Uniform random number generator, [0,1)
 float randf();
+float randf_rng(liquid_rng _rng);
 float randf_pdf(float _x);
 float randf_cdf(float _x);
 
 // Uniform random number generator with arbitrary bounds, [a,b)
 float randuf(float _a, float _b);
+float randuf_rng(liquid_rng _rng, float _a, float _b);
 float randuf_pdf(float _x, float _a, float _b);
 float randuf_cdf(float _x, float _a, float _b);
 
@@ -8237,9 +11173,17 @@ float randuf_cdf(float _x, float _a, float _b);
 //     sigma = standard deviation
 //
 float randnf();
+float randnf_rng(liquid_rng _rng);
 void awgn(float *_x, float _nstd);
 void crandnf(liquid_float_complex *_y);
+void crandnf_rng(liquid_rng _rng, liquid_float_complex *_y);
 void cawgn(liquid_float_complex *_x, float _nstd);
+
+// Gauss random number block generators using a counter-based uniform
+// generator, reproducible from a seed independently of rand()
+void randnf_block_seed(unsigned long _seed);
+void randnf_block(float * _y, unsigned int _n);
+void crandnf_block(liquid_float_complex * _y, unsigned int _n);
 float randnf_pdf(float _x, float _eta, float _sig);
 float randnf_cdf(float _x, float _eta, float _sig);
 
@@ -8249,6 +11193,7 @@ float randnf_cdf(float _x, float _eta, float _sig);
 //  lambda = spread parameter, lambda > 0
 //  x >= 0
 float randexpf(float _lambda);
+float randexpf_rng(liquid_rng _rng, float _lambda);
 float randexpf_pdf(float _x, float _lambda);
 float randexpf_cdf(float _x, float _lambda);
 
@@ -8298,6 +11243,7 @@ float randnakmf_cdf(float _x, float _m, float _omega);
 //  I0    = modified Bessel function of the first kind
 //  x >= 0
 float randricekf(float _K, float _omega);
+float randricekf_rng(liquid_rng _rng, float _K, float _omega);
 float randricekf_cdf(float _x, float _K, float _omega);
 float randricekf_pdf(float _x, float _K, float _omega);
 
@@ -8341,6 +11287,20 @@ void bsequence_circshift(bsequence _bs);
 // Correlate two binary sequences together
 int bsequence_correlate(bsequence _bs1, bsequence _bs2);
 
+// Sliding cross-correlation: push each input bit into the receive
+// window and record the correlation against the reference after each
+// push
+//  _bs1    :   fixed reference sequence
+//  _bs2    :   sliding receive window (same length as _bs1)
+//  _v      :   input bit array [size: _n x 1]
+//  _n      :   number of input bits
+//  _rxy    :   output correlation array [size: _n x 1]
+void bsequence_correlate_sliding(bsequence       _bs1,
+                                 bsequence       _bs2,
+                                 unsigned char * _v,
+                                 unsigned int    _n,
+                                 signed int *    _rxy);
+
 // compute the binary addition of two bit sequences
 void bsequence_add(bsequence _bs1, bsequence _bs2, bsequence _bs3);
 
@@ -8417,6 +11377,22 @@ unsigned int msequence_advance(msequence _ms);
 unsigned int msequence_generate_symbol(msequence _ms,
                                        unsigned int _bps);
 
+// generate block of bits, advancing the shift register a word at a
+// time through its state-transition matrix
+//  _ms     :   m-sequence object
+//  _v      :   output bit array [size: _n x 1]
+//  _n      :   number of bits to generate
+void msequence_generate_block(msequence       _ms,
+                              unsigned char * _v,
+                              unsigned int    _n);
+
+// advance the internal state _n steps without generating output,
+// e.g. to split one code sequence across parallel generators
+//  _ms     :   m-sequence object
+//  _n      :   number of steps to advance
+void msequence_leap(msequence    _ms,
+                    unsigned int _n);
+
 // reset msequence shift register to original state, typically '1'
 void msequence_reset(msequence _ms);
 
@@ -8441,6 +11417,108 @@ void msequence_set_state(msequence    _ms,
 // MODULE : utility
 //
 
+// arena (region) allocator: allocations are served by bumping a pointer
+// within large contiguous blocks, giving cache-friendly layout for
+// groups of related objects and O(1) release of everything at once
+typedef struct liquid_arena_s * liquid_arena;
+
+// set backing allocator used for all subsequent arena block requests;
+// pass NULL for either argument to restore the default malloc/free
+void liquid_set_allocator(void * (*_malloc)(unsigned long int),
+                          void   (*_free)  (void *));
+
+// create arena allocator object
+//  _capacity : size of initial region [bytes]
+liquid_arena liquid_arena_create(unsigned long int _capacity);
+
+// destroy arena object, freeing all internal memory
+void liquid_arena_destroy(liquid_arena _q);
+
+// print arena object internals
+void liquid_arena_print(liquid_arena _q);
+
+// allocate memory from arena; storage is valid until the arena is
+// cleared or destroyed and must not be passed to free()
+//  _q    : arena object
+//  _size : allocation size [bytes]
+void * liquid_arena_alloc(liquid_arena      _q,
+                          unsigned long int _size);
+
+// release all allocations in O(1), retaining the largest region for reuse
+void liquid_arena_clear(liquid_arena _q);
+
+// get total number of bytes currently allocated from arena
+unsigned long int liquid_arena_get_size(liquid_arena _q);
+
+// half-precision (IEEE 754 binary16) sample storage for memory-bound
+// pipelines; values are carried as uint16_t and widened to float at the
+// processing boundary
+
+// convert half-precision value to single precision
+float liquid_fp16tof(uint16_t _h);
+
+// convert single-precision value to half precision (round to nearest
+// even, saturating to infinity)
+uint16_t liquid_ftofp16(float _f);
+
+// convert block of half-precision values to single precision
+//  _h : input array [size: _n x 1]
+//  _n : array length
+//  _f : output array [size: _n x 1]
+void liquid_fp16tof_block(uint16_t *   _h,
+                          unsigned int _n,
+                          float *      _f);
+
+// convert block of single-precision values to half precision
+//  _f : input array [size: _n x 1]
+//  _n : array length
+//  _h : output array [size: _n x 1]
+void liquid_ftofp16_block(float *      _f,
+                          unsigned int _n,
+                          uint16_t *   _h);
+
+// print accumulated cycle-count instrumentation to stdout; counters are
+// populated only when the library is built with --enable-profile
+void liquid_profile_report(void);
+
+// reset all cycle-count instrumentation counters
+void liquid_profile_reset(void);
+
+// operations with a run-time engine choice recorded in the process-wide
+// tuning table (see liquid_tune)
+typedef enum {
+    LIQUID_TUNE_FIRFILT=0,  // firfilt block execute: 0:time-domain, 1:frequency-domain
+    LIQUID_TUNE_FSKDEM,     // fskdem engine, size (m<<16)|k: 0:FFT, 1:Goertzel
+    LIQUID_TUNE_NUM_OPS
+} liquid_tune_op;
+
+// time candidate kernels on the running machine and record the winners
+// in a process-wide table consulted by create functions with an engine
+// choice (e.g. firfilt_crcf_create_auto, fskdem_create_auto); the table
+// is not protected by a lock, so tune before spawning worker threads
+int liquid_tune(void);
+
+// look up recorded engine choice for an operation, matching the entry
+// measured at the nearest size; returns -1 when nothing was recorded
+// so callers fall back to a static default
+int liquid_tune_get(int _op, unsigned int _size);
+
+// record engine choice for an operation at a particular size
+int liquid_tune_set(int _op, unsigned int _size, int _choice);
+
+// discard all recorded engine choices
+void liquid_tune_clear(void);
+
+// print tuning table to stdout
+void liquid_tune_print(void);
+
+// export tuning table to file so production boots can import it and
+// skip the tuning pass
+int liquid_tune_export(const char * _filename);
+
+// import tuning table from file, merging entries
+int liquid_tune_import(const char * _filename);
+
 // pack binary array with symbol(s)
 //  _src        :   source array [size: _n x 1]
 //  _n          :   input source array length
@@ -8465,6 +11543,38 @@ void liquid_unpack_array(unsigned char * _src,
                          unsigned int _b,
                          unsigned char * _sym_out);
 
+// cache-oblivious blocked out-of-place matrix transpose (corner turn),
+// e.g. between a channelizer's per-step channel vectors and per-channel
+// sample runs: _y[c][r] = _x[r][c]
+//  _x  :   input matrix, [size: _r x _c]
+//  _r  :   input rows
+//  _c  :   input columns
+//  _y  :   output matrix, [size: _c x _r]
+void liquid_transpose_f (const float *          _x,
+                         unsigned int           _r,
+                         unsigned int           _c,
+                         float *                _y);
+void liquid_transpose_cf(const liquid_float_complex * _x,
+                         unsigned int           _r,
+                         unsigned int           _c,
+                         liquid_float_complex * _y);
+
+// strided variants for matrices embedded in larger buffers; rows of the
+// input start every _xs elements (_xs >= _c) and rows of the output
+// start every _ys elements (_ys >= _r)
+void liquid_transpose_f_strided (const float *          _x,
+                                 unsigned int           _r,
+                                 unsigned int           _c,
+                                 unsigned int           _xs,
+                                 float *                _y,
+                                 unsigned int           _ys);
+void liquid_transpose_cf_strided(const liquid_float_complex * _x,
+                                 unsigned int           _r,
+                                 unsigned int           _c,
+                                 unsigned int           _xs,
+                                 liquid_float_complex * _y,
+                                 unsigned int           _ys);
+
 // pack one-bit symbols into bytes (8-bit symbols)
 //  _sym_in             :   input symbols array [size: _sym_in_len x 1]
 //  _sym_in_len         :   number of input symbols
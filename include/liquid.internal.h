@@ -54,6 +54,14 @@
 #define PRINTVAL_FLOAT(X,F)     printf(#F,crealf(X));
 #define PRINTVAL_CFLOAT(X,F)    printf(#F "+j*" #F, crealf(X), cimagf(X));
 
+//
+// external compute backend
+//
+
+// registered backend interface (all callbacks NULL when no backend is
+// registered); see liquid_backend_register()
+extern liquid_backend liquid_internal_backend;
+
 //
 // MODULE : agc
 //
@@ -73,6 +81,18 @@
 // MODULE : dotprod
 //
 
+// run-time CPU feature detection (x86); probed once on first call and
+// cached thereafter.  Used by the run-time dispatch kernel set to select
+// the widest instruction set available on the executing machine.
+#define LIQUID_CPU_X86_SSE2     (1<<0)
+#define LIQUID_CPU_X86_SSE3     (1<<1)
+#define LIQUID_CPU_X86_SSE41    (1<<2)
+#define LIQUID_CPU_X86_AVX      (1<<3)
+#define LIQUID_CPU_X86_FMA      (1<<4)
+#define LIQUID_CPU_X86_AVX2     (1<<5)
+#define LIQUID_CPU_X86_AVX512F  (1<<6)
+int liquid_cpu_features(void);
+
 
 //
 // MODULE : fec (forward error-correction)
@@ -86,6 +106,8 @@
 #define CRC32_POLY 0x04C11DB7
 
 unsigned int checksum_generate_key(unsigned char * _msg, unsigned int _msg_len);
+void crc16_init_gentab(void);   // generate slice-by-8 look-up tables
+void crc32_init_gentab(void);   // generate slice-by-8 look-up tables
 unsigned int crc8_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc16_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc24_generate_key(unsigned char * _msg, unsigned int _msg_len);
@@ -165,6 +187,7 @@ struct fec_s {
 
 // simple type testing
 int fec_scheme_is_convolutional(fec_scheme _scheme);
+int fec_scheme_is_conv_v27(fec_scheme _scheme);
 int fec_scheme_is_punctured(fec_scheme _scheme);
 int fec_scheme_is_reedsolomon(fec_scheme _scheme);
 int fec_scheme_is_hamming(fec_scheme _scheme);
@@ -521,6 +544,20 @@ void fec_conv_init_v29(fec _q);
 void fec_conv_init_v39(fec _q);
 void fec_conv_init_v615(fec _q);
 
+// internal K=7, rate-1/2 Viterbi engine (butterfly add-compare-select
+// with batched metric renormalization); signatures match the libfec
+// function pointers in struct fec_s
+void * fec_conv27_viterbi_create(int _num_dec_bits);
+int    fec_conv27_viterbi_init(void * _vp, int _starting_state);
+int    fec_conv27_viterbi_update_blk(void * _vp,
+                                     unsigned char * _syms,
+                                     int _num_bits);
+int    fec_conv27_viterbi_chainback(void * _vp,
+                                    unsigned char * _data,
+                                    unsigned int _num_bits,
+                                    unsigned int _end_state);
+void   fec_conv27_viterbi_delete(void * _vp);
+
 // punctured convolutional codes
 fec fec_conv_punctured_create(fec_scheme _fs);
 void fec_conv_punctured_destroy(fec _q);
@@ -571,6 +608,21 @@ unsigned int fec_rs_get_enc_msg_len(unsigned int _dec_msg_len,
 
 fec fec_rs_create(fec_scheme _fs);
 void fec_rs_destroy(fec _q);
+
+// internal Reed-Solomon codec over GF(2^8): table-driven syndrome and
+// Chien search kernels with early termination on clean blocks;
+// pointer signatures are compatible with libfec
+void * fec_rs_gf256_create(int _symsize, int _gfpoly, int _fcs,
+                           int _prim, int _nroots, int _pad);
+void fec_rs_gf256_destroy(void * _rs);
+void fec_rs_gf256_encode(void * _rs,
+                         unsigned char * _data,
+                         unsigned char * _parity);
+int fec_rs_gf256_decode(void * _rs,
+                        unsigned char * _data,
+                        int * _eras_pos,
+                        int _no_eras);
+
 void fec_rs_init_p8(fec _q);
 void fec_rs_setlength(fec _q,
                       unsigned int _dec_msg_len);
@@ -623,6 +675,22 @@ int fec_sumproduct_step(unsigned int    _m,
                         float *         _LQ,
                         unsigned char * _parity);
 
+// run layered normalized min-sum decoder (fast fixed-point
+// alternative to fec_sumproduct with early termination):
+// returns 1 if parity checks, 0 otherwise
+//  _m          :   rows
+//  _n          :   cols
+//  _H          :   sparse binary parity check matrix [size: _m x _n]
+//  _LLR        :   received signal (soft bits, LLR) [size: _n x 1]
+//  _c_hat      :   estimated transmitted signal [size: _n x 1]
+//  _max_steps  :   maximum number of iterations before bailing
+int fec_minsum(unsigned int    _m,
+               unsigned int    _n,
+               smatrixb        _H,
+               float *         _LLR,
+               unsigned char * _c_hat,
+               unsigned int    _max_steps);
+
 //
 // packetizer
 //
@@ -672,6 +740,7 @@ typedef enum {
     LIQUID_FFT_METHOD_RADER,        // Rader's method for FFTs of prime length
     LIQUID_FFT_METHOD_RADER2,       // Rader's method for FFTs of prime length (alternate)
     LIQUID_FFT_METHOD_DFT,          // regular discrete Fourier transform
+    LIQUID_FFT_METHOD_PRUNED,       // input-pruned transform for sparse spectra
 } liquid_fft_method;
 
 // Macro    :   FFT (internal)
@@ -706,6 +775,7 @@ FFT(_destroy_t) FFT(_destroy_plan_radix2);                      \
 FFT(_destroy_t) FFT(_destroy_plan_mixed_radix);                 \
 FFT(_destroy_t) FFT(_destroy_plan_rader);                       \
 FFT(_destroy_t) FFT(_destroy_plan_rader2);                      \
+FFT(_destroy_t) FFT(_destroy_plan_pruned);                      \
                                                                 \
 /* FFT execute methods */                                       \
 FFT(_execute_t) FFT(_execute_dft);                              \
@@ -713,6 +783,7 @@ FFT(_execute_t) FFT(_execute_radix2);                           \
 FFT(_execute_t) FFT(_execute_mixed_radix);                      \
 FFT(_execute_t) FFT(_execute_rader);                            \
 FFT(_execute_t) FFT(_execute_rader2);                           \
+FFT(_execute_t) FFT(_execute_pruned);                           \
                                                                 \
 /* specific codelets for small DFTs */                          \
 FFT(_execute_t) FFT(_execute_dft_2);                            \
@@ -744,6 +815,16 @@ void FFT(_destroy_plan_r2r_1d)(FFT(plan) _q);                   \
                                                                 \
 /* print real-to-real one-dimensional plan */                   \
 void FFT(_print_plan_r2r_1d)(FFT(plan) _q);                     \
+                                                                \
+/* real-input (r2c/c2r) transform methods */                    \
+FFT(_destroy_t) FFT(_destroy_plan_real);                        \
+FFT(_execute_t) FFT(_execute_r2c);                              \
+FFT(_execute_t) FFT(_execute_c2r);                              \
+FFT(_execute_t) FFT(_execute_r2c_odd);                          \
+FFT(_execute_t) FFT(_execute_c2r_odd);                          \
+                                                                \
+/* print real-input (r2c/c2r) plan */                           \
+void FFT(_print_plan_real)(FFT(plan) _q);                       \
 
 // determine best FFT method based on size
 liquid_fft_method liquid_fft_estimate_method(unsigned int _nfft);
@@ -763,19 +844,37 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   include <fftw3.h>
 #   define FFT_PLAN             fftwf_plan
 #   define FFT_CREATE_PLAN      fftwf_plan_dft_1d
+#   define FFT_CREATE_PLAN_R2C  fftwf_plan_dft_r2c_1d
 #   define FFT_DESTROY_PLAN     fftwf_destroy_plan
 #   define FFT_EXECUTE          fftwf_execute
+#   define FFT_EXECUTE_BATCH(p,batch,x,xs,y,ys)                         \
+        do {                                                            \
+            unsigned int _fft_i;                                        \
+            for (_fft_i=0; _fft_i<(batch); _fft_i++)                    \
+                fftwf_execute_dft((p),                                  \
+                    (fftwf_complex*)(x) + _fft_i*(xs),                  \
+                    (fftwf_complex*)(y) + _fft_i*(ys));                 \
+        } while (0)
 #   define FFT_DIR_FORWARD      FFTW_FORWARD
 #   define FFT_DIR_BACKWARD     FFTW_BACKWARD
 #   define FFT_METHOD           FFTW_ESTIMATE
+    // input-pruned plans are only available with the internal library
+#   define FFT_HAVE_PLAN_PRUNED 0
 #else
 #   define FFT_PLAN             fftplan
 #   define FFT_CREATE_PLAN      fft_create_plan
+#   define FFT_CREATE_PLAN_R2C  fft_create_plan_r2c
 #   define FFT_DESTROY_PLAN     fft_destroy_plan
 #   define FFT_EXECUTE          fft_execute
+#   define FFT_EXECUTE_BATCH(p,batch,x,xs,y,ys)                         \
+        fft_execute_batch((p),(batch),                                  \
+            (liquid_float_complex*)(x),(xs),                            \
+            (liquid_float_complex*)(y),(ys))
 #   define FFT_DIR_FORWARD      LIQUID_FFT_FORWARD
 #   define FFT_DIR_BACKWARD     LIQUID_FFT_BACKWARD
 #   define FFT_METHOD           0
+#   define FFT_HAVE_PLAN_PRUNED 1
+#   define FFT_CREATE_PLAN_PRUNED fft_create_plan_pruned
 #endif
 
 
@@ -872,6 +971,18 @@ void IIRFILTSOS(_execute_df2)(IIRFILTSOS() _q,                  \
                               TI           _x,                  \
                               TO *         _y);                 \
                                                                 \
+/* copy the two most recent direct-form II state values     */  \
+/*  _q      : iirfiltsos object                             */  \
+/*  _v      : state output array [size: 2 x 1]              */  \
+void IIRFILTSOS(_get_state)(IIRFILTSOS() _q,                    \
+                            TO *         _v);                   \
+                                                                \
+/* restore direct-form II state values                      */  \
+/*  _q      : iirfiltsos object                             */  \
+/*  _v      : state input array [size: 2 x 1]               */  \
+void IIRFILTSOS(_set_state)(IIRFILTSOS() _q,                    \
+                            TO *         _v);                   \
+                                                                \
 /* compute and return group delay of filter object          */  \
 /*  _q      : filter object                                 */  \
 /*  _fc     : frequency to evaluate                         */  \
@@ -1234,6 +1345,34 @@ void QSOURCE(_generate_into)(QSOURCE() _q,                                  \
     
 LIQUID_QSOURCE_DEFINE_API(LIQUID_QSOURCE_MANGLE_CFLOAT, liquid_float_complex)
 
+//
+// MODULE : io
+//
+
+// bytes per raw sample for a given on-disk format
+unsigned int liquid_iqfile_sample_size(int _format);
+
+// convert a block of raw samples to 32-bit float complex
+//  _format : on-disk sample format
+//  _raw    : raw input array [size: _n samples]
+//  _n      : number of samples
+//  _buf    : output array [size: _n x 1]
+void liquid_iqfile_convert_to_cf32(int                    _format,
+                                   unsigned char *        _raw,
+                                   unsigned long int      _n,
+                                   liquid_float_complex * _buf);
+
+// convert a block of 32-bit float complex samples to the raw
+// on-disk format
+//  _format : on-disk sample format
+//  _buf    : input array [size: _n x 1]
+//  _n      : number of samples
+//  _raw    : raw output array [size: _n samples]
+void liquid_iqfile_convert_from_cf32(int                    _format,
+                                     liquid_float_complex * _buf,
+                                     unsigned long int      _n,
+                                     unsigned char *        _raw);
+
 //
 // MODULE : math
 //
@@ -1247,8 +1386,11 @@ float liquid_tanf(float _x);
 void  liquid_sincosf(float _x,
                      float * _sinf,
                      float * _cosf);
+// fast polynomial approximations to libm transcendentals for
+// per-sample processing loops (math.fastmath.c)
 float liquid_expf(float _x);
 float liquid_logf(float _x);
+float liquid_powf(float _b, float _x);
 
 // 
 // complex math operations
@@ -1286,7 +1428,17 @@ float liquid_cargf_approx(float complex _z);
 #define LIQUID_MATRIX_DEFINE_INTERNAL_API(MATRIX,T)             \
 T    MATRIX(_det2x2)(T * _x,                                    \
                      unsigned int _rx,                          \
-                     unsigned int _cx);
+                     unsigned int _cx);                         \
+                                                                \
+/* closed-form small-dimension inverse kernels (in place)    */ \
+void MATRIX(_inv2x2)(T * _X);                                   \
+void MATRIX(_inv4x4)(T * _X);                                   \
+                                                                \
+/* unrolled small-dimension Cholesky kernels, A = L * L^H    */ \
+void MATRIX(_chol2x2)(T * _A,                                   \
+                      T * _L);                                  \
+void MATRIX(_chol4x4)(T * _A,                                   \
+                      T * _L);
 
 
 LIQUID_MATRIX_DEFINE_INTERNAL_API(LIQUID_MATRIX_MANGLE_FLOAT,   float)
@@ -1367,6 +1519,9 @@ void MODEM(_init)(MODEM() _q, unsigned int _bits_per_symbol);   \
 /* initialize symbol map for fast modulation */                 \
 void MODEM(_init_map)(MODEM() _q);                              \
                                                                 \
+/* reference shared symbol map for fixed modulation scheme */   \
+void MODEM(_init_map_shared)(MODEM() _q);                       \
+                                                                \
 /* generic modem create routines */                             \
 MODEM() MODEM(_create_ask)( unsigned int _bits_per_symbol);     \
 MODEM() MODEM(_create_qam)( unsigned int _bits_per_symbol);     \
@@ -1459,6 +1614,21 @@ void MODEM(_demodulate_soft_table)(MODEM()         _q,          \
                                    unsigned int *  _sym_out,    \
                                    unsigned char * _soft_bits); \
                                                                 \
+/* generate planar constellation table and per-bit symbol    */ \
+/* subsets for batch soft demodulation                       */ \
+void MODEM(_demodulate_soft_block_init)(MODEM() _q);            \
+                                                                \
+/* generate quantized per-axis LLR look-up table for square  */ \
+/* QAM soft demodulation                                     */ \
+void MODEM(_demodsoft_qam_gentab)(MODEM() _q);                  \
+                                                                \
+/* soft demodulation of square QAM using quantized per-axis  */ \
+/* LLR look-up table                                         */ \
+void MODEM(_demodulate_soft_qam_table)(MODEM()         _q,      \
+                                       TC              _x,      \
+                                       unsigned int *  _sym_out,\
+                                       unsigned char * _soft_bits); \
+                                                                \
 /* Demodulate a linear symbol constellation using dynamic   */  \
 /* threshold calculation                                    */  \
 /*  _v      :   input value             */                      \
@@ -1678,6 +1848,17 @@ void gradsearch_gradient(utility_function _utility,
                          float            _delta,
                          float *          _gradient);
 
+// compute the gradient at a particular point, evaluating the dimension
+// probes concurrently across _num_threads worker threads; the utility
+// callback must be thread-safe
+void gradsearch_gradient_mt(utility_function _utility,
+                            void  *          _userdata,
+                            float *          _x,
+                            unsigned int     _n,
+                            float            _delta,
+                            float *          _gradient,
+                            unsigned int     _num_threads);
+
 // execute line search; loosely solve:
 //
 //    min|max phi(alpha) := f(_x - alpha*_p)
@@ -1719,6 +1900,17 @@ struct qnsearch_s {
     float * B;          // approximate Hessian matrix inverse [n x n]
     float * H;          // Hessian matrix
 
+    // memory-bounded L-BFGS engine (enabled when lbfgs_m > 0)
+    unsigned int lbfgs_m;       // history length (0: dense Hessian engine)
+    unsigned int lbfgs_k;       // number of stored correction pairs
+    unsigned int lbfgs_head;    // circular buffer write index
+    int lbfgs_valid;            // previous point/gradient available?
+    float * lbfgs_s;            // parameter step history [m x n]
+    float * lbfgs_y;            // gradient change history [m x n]
+    float * lbfgs_rho;          // 1 / (y^T s) for each stored pair [m]
+    float * lbfgs_alpha;        // two-loop recursion scratch [m]
+    float * v0;                 // parameter vector at previous step
+
     float* p;           // search direction
     float* gradient;    // gradient approximation
     float* gradient0;   // gradient approximation (previous step)
@@ -1743,6 +1935,15 @@ void qnsearch_compute_Hessian(qnsearch _q);
 // Goldfarb & Shanno method (BFGS)
 void qnsearch_update_hessian_bfgs(qnsearch _q);
 
+// append latest correction pair {s,y} to the L-BFGS history
+void qnsearch_update_history_lbfgs(qnsearch _q);
+
+// compute search direction from the L-BFGS history (two-loop recursion)
+void qnsearch_compute_direction_lbfgs(qnsearch _q);
+
+// backtracking line search along the current L-BFGS direction
+float qnsearch_linesearch_lbfgs(qnsearch _q);
+
 
 // Chromosome structure used in genetic algorithm searches
 struct chromosome_s {
@@ -1782,6 +1983,7 @@ struct gasearch_s {
     gasearch_utility get_utility;       // utility function pointer
     void * userdata;                    // object to optimize
     int minimize;                       // minimize/maximize utility (search direction)
+    unsigned int num_threads;           // number of threads for fitness evaluation
 };
 
 //
@@ -1841,6 +2043,9 @@ struct msequence_s {
     unsigned int n;     // length of sequence, n = (2^m)-1
     unsigned int v;     // shift register
     unsigned int b;     // return bit
+
+    unsigned int am_len;    // m-step leap table length (0 until computed)
+    unsigned int am[15];    // m-step leap table (state-transition matrix A^m)
 };
 
 // Default msequence generator objects
@@ -1851,6 +2056,40 @@ extern struct msequence_s msequence_default[16];
 // MODULE : utility
 //
 
+// cycle-count instrumentation for hot execute paths; compiled in with
+// ./configure --enable-profile, otherwise the hooks expand to nothing
+
+// timer identifiers
+enum {
+    LIQUID_PROFILE_TIMER_FFT_EXECUTE=0,
+    LIQUID_PROFILE_TIMER_FIRPFBCH2_ANALYZER,
+    LIQUID_PROFILE_TIMER_FIRPFBCH2_SYNTHESIZER,
+    LIQUID_PROFILE_TIMER_MSRESAMP_ARBITRARY,
+    LIQUID_PROFILE_TIMER_MSRESAMP_HALFBAND,
+    LIQUID_PROFILE_TIMER_FLEXFRAMESYNC_SEEKPN,
+    LIQUID_PROFILE_TIMER_FLEXFRAMESYNC_RXPREAMBLE,
+    LIQUID_PROFILE_TIMER_FLEXFRAMESYNC_RXHEADER,
+    LIQUID_PROFILE_TIMER_FLEXFRAMESYNC_RXPAYLOAD,
+    LIQUID_PROFILE_NUM_TIMERS
+};
+
+// read time-stamp counter
+unsigned long long int liquid_profile_tic(void);
+
+// accumulate elapsed cycles into timer
+//  _timer : timer identifier (e.g. LIQUID_PROFILE_TIMER_FFT_EXECUTE)
+//  _tic   : counter value captured at region entry
+void liquid_profile_toc(int                    _timer,
+                        unsigned long long int _tic);
+
+#if defined LIQUID_PROFILE
+#  define LIQUID_PROFILE_BEGIN(ID) unsigned long long int _liquid_tic_##ID = liquid_profile_tic()
+#  define LIQUID_PROFILE_END(ID)   liquid_profile_toc(LIQUID_PROFILE_TIMER_##ID, _liquid_tic_##ID)
+#else
+#  define LIQUID_PROFILE_BEGIN(ID) do {} while (0)
+#  define LIQUID_PROFILE_END(ID)   do {} while (0)
+#endif
+
 // number of ones in a byte
 //  0   0000 0000   :   0
 //  1   0000 0001   :   1
@@ -1884,6 +2123,15 @@ extern const unsigned char liquid_c_ones[256];
     liquid_c_ones[ ((x)>>16) & 0xff ] +         \
     liquid_c_ones[ ((x)>>24) & 0xff ])
 
+// word population count; the compiler builtin maps to a hardware
+// instruction where the target supports one (POPCNT, NEON VCNT) and
+// falls back to the byte table otherwise
+#if defined(__GNUC__)
+#  define liquid_popcount_uint32(x) __builtin_popcount(x)
+#else
+#  define liquid_popcount_uint32(x) liquid_count_ones_uint32(x)
+#endif
+
 
 // number of ones in a byte, modulo 2
 //  0   0000 0000   :   0
@@ -124,6 +124,37 @@ AC_DEFUN([AX_EXT],
     fi
   ])
 
+ AC_CACHE_CHECK([whether fma is supported], [ax_cv_have_fma_ext],
+  [
+    ax_cv_have_fma_ext=no
+    if test "$((0x$ecx>>12&0x01))" = 1; then
+      ax_cv_have_fma_ext=yes
+    fi
+  ])
+
+  AX_GCC_X86_CPUID_COUNT(0x00000007, 0x00)
+  ebx7=0
+  if test "$ax_cv_gcc_x86_cpuid_0x00000007" != "unknown";
+  then
+     ebx7=`echo $ax_cv_gcc_x86_cpuid_0x00000007 | cut -d ":" -f 2`
+  fi
+
+ AC_CACHE_CHECK([whether avx2 is supported], [ax_cv_have_avx2_ext],
+  [
+    ax_cv_have_avx2_ext=no
+    if test "$((0x$ebx7>>5&0x01))" = 1; then
+      ax_cv_have_avx2_ext=yes
+    fi
+  ])
+
+ AC_CACHE_CHECK([whether avx512f is supported], [ax_cv_have_avx512f_ext],
+  [
+    ax_cv_have_avx512f_ext=no
+    if test "$((0x$ebx7>>16&0x01))" = 1; then
+      ax_cv_have_avx512f_ext=yes
+    fi
+  ])
+
   if [ test "$ax_cv_have_mmx_ext" = yes && test "$ac_cv_header_mmintrin_h" = yes ]; then
     AC_DEFINE(HAVE_MMX,1, [Support MMX instructions])
     AX_CHECK_COMPILE_FLAG(-mmmx, SIMD_FLAGS="$SIMD_FLAGS -mmmx", [])
@@ -164,5 +195,20 @@ AC_DEFUN([AX_EXT],
     AX_CHECK_COMPILE_FLAG(-mavx, SIMD_FLAGS="$SIMD_FLAGS -mavx", [])
   fi
 
+  if [ test "$ax_cv_have_fma_ext" = yes && test "$ac_cv_header_immintrin_h" = yes ]; then
+    AC_DEFINE(HAVE_FMA,1,[Support FMA (Fused Multiply-Add) instructions])
+    AX_CHECK_COMPILE_FLAG(-mfma, SIMD_FLAGS="$SIMD_FLAGS -mfma", [])
+  fi
+
+  if [ test "$ax_cv_have_avx2_ext" = yes && test "$ac_cv_header_immintrin_h" = yes ]; then
+    AC_DEFINE(HAVE_AVX2,1,[Support AVX2 (Advanced Vector Extensions 2) instructions])
+    AX_CHECK_COMPILE_FLAG(-mavx2, SIMD_FLAGS="$SIMD_FLAGS -mavx2", [])
+  fi
+
+  if [ test "$ax_cv_have_avx512f_ext" = yes && test "$ac_cv_header_immintrin_h" = yes ]; then
+    AC_DEFINE(HAVE_AVX512F,1,[Support AVX-512 Foundation instructions])
+    AX_CHECK_COMPILE_FLAG(-mavx512f, SIMD_FLAGS="$SIMD_FLAGS -mavx512f", [])
+  fi
+
   AC_SUBST(SIMD_FLAGS)
 ])
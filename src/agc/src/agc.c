@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -33,6 +34,19 @@
 // default AGC loop bandwidth
 #define AGC_DEFAULT_BW   (1e-2f)
 
+// sub-block length for block-mode processing: the gain control loop is
+// updated once per sub-block rather than once per sample
+#define AGC_SUBBLOCK_LEN (16)
+
+// type-specific vector helper methods
+#if TC_COMPLEX
+#  define AGC_SUMSQ(X,N)                liquid_sumsqcf(X,N)
+#  define AGC_VECTOR_MULSCALAR(X,N,V,Y) liquid_vectorcf_mulscalar(X,N,V,Y)
+#else
+#  define AGC_SUMSQ(X,N)                liquid_sumsqf(X,N)
+#  define AGC_VECTOR_MULSCALAR(X,N,V,Y) liquid_vectorf_mulscalar(X,N,V,Y)
+#endif
+
 // internal method definition
 void AGC(_squelch_update_mode)(AGC() _q);
 
@@ -145,7 +159,7 @@ void AGC(_execute)(AGC() _q,
 
     // update gain according to output energy
     if (_q->y2_prime > 1e-6f)
-        _q->g *= expf( -0.5f*_q->alpha*logf(_q->y2_prime) );
+        _q->g *= liquid_expf( -0.5f*_q->alpha*liquid_logf(_q->y2_prime) );
 
     // clamp to 120 dB gain
     if (_q->g > 1e6f)
@@ -158,7 +172,10 @@ void AGC(_execute)(AGC() _q,
     *_y *= _q->scale;
 }
 
-// execute automatic gain control on block of samples
+// execute automatic gain control on block of samples; the loop is
+// updated once per sub-block from the average sub-block energy and the
+// gain is applied with a vectorized scalar multiply, deferring the
+// transcendental gain computation from every sample to every sub-block
 //  _q      : automatic gain control object
 //  _x      : input data array, [size: _n x 1]
 //  _n      : number of input, output samples
@@ -169,8 +186,88 @@ void AGC(_execute_block)(AGC()        _q,
                          TC *         _y)
 {
     unsigned int i;
-    for (i=0; i<_n; i++)
-        AGC(_execute)(_q, _x[i], &_y[i]);
+
+    // fall back to sample-by-sample processing when squelch is
+    // active; the squelch timer counts individual samples
+    if (_q->squelch_mode != LIQUID_AGC_SQUELCH_DISABLED) {
+        for (i=0; i<_n; i++)
+            AGC(_execute)(_q, _x[i], &_y[i]);
+        return;
+    }
+
+    for (i=0; i<_n; i+=AGC_SUBBLOCK_LEN) {
+        // sub-block length
+        unsigned int m = _n - i;
+        if (m > AGC_SUBBLOCK_LEN)
+            m = AGC_SUBBLOCK_LEN;
+
+        // apply gain to sub-block (output scale applied only when
+        // loop is running, as with sample-by-sample processing)
+        T g = _q->is_locked ? _q->g : _q->g * _q->scale;
+        AGC_VECTOR_MULSCALAR(_x+i, m, g, _y+i);
+
+        // compute average output signal energy over sub-block
+        T y2 = (_q->g)*(_q->g)*AGC_SUMSQ(_x+i, m) / (T)m;
+
+        // smooth energy estimate, applying the single-pole low-pass
+        // filter recursion m times with the average held constant
+        T b = powf(1.0f-_q->alpha, (float)m);
+        _q->y2_prime = b*_q->y2_prime + (1.0f-b)*y2;
+
+        // continue if locked
+        if (_q->is_locked)
+            continue;
+
+        // update gain according to output energy, accumulating the
+        // per-sample adjustment over the sub-block
+        if (_q->y2_prime > 1e-6f)
+            _q->g *= liquid_expf( -0.5f*_q->alpha*(float)m*liquid_logf(_q->y2_prime) );
+
+        // clamp to 120 dB gain
+        if (_q->g > 1e6f)
+            _q->g = 1e6f;
+    }
+}
+
+// update the internal energy estimate and gain from a block of raw q15
+// (sc16) samples without converting them to floating point; this lets
+// the front half of a receive chain run at integer precision while the
+// gain loop tracks, with the gain applied downstream after conversion
+//  _q      : automatic gain control object
+//  _x      : input data array, interleaved i/q for complex types
+//  _n      : number of input samples
+void AGC(_update_energy_q15)(AGC()        _q,
+                             int16_t *    _x,
+                             unsigned int _n)
+{
+    // compute average input signal energy over block; complex types
+    // span two q15 words per sample
+#if TC_COMPLEX
+    T x2 = liquid_sumsqq16(_x, 2*_n) / (T)_n;
+#else
+    T x2 = liquid_sumsqq16(_x,   _n) / (T)_n;
+#endif
+
+    // energy the output would have if the tracked gain were applied
+    T y2 = (_q->g)*(_q->g)*x2;
+
+    // smooth energy estimate, applying the single-pole low-pass
+    // filter recursion _n times with the average held constant
+    T b = powf(1.0f-_q->alpha, (float)_n);
+    _q->y2_prime = b*_q->y2_prime + (1.0f-b)*y2;
+
+    // return if locked
+    if (_q->is_locked)
+        return;
+
+    // update gain according to output energy, accumulating the
+    // per-sample adjustment over the block
+    if (_q->y2_prime > 1e-6f)
+        _q->g *= liquid_expf( -0.5f*_q->alpha*(float)_n*liquid_logf(_q->y2_prime) );
+
+    // clamp to 120 dB gain
+    if (_q->g > 1e6f)
+        _q->g = 1e6f;
 }
 
 // lock agc
@@ -277,6 +374,53 @@ void AGC(_set_gain)(AGC() _q,
     _q->g = _gain;
 }
 
+// get size of serialized gain-control state [bytes]
+unsigned int AGC(_get_state_size)(AGC() _q)
+{
+    return 2*sizeof(T);
+}
+
+// save adaptive gain-control state (gain and signal level estimate)
+// into buffer for later warm start; configuration (bandwidth, scale,
+// squelch) is not included and is restored by re-creating the object
+//  _q       : agc object
+//  _buf     : output buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match AGC(_get_state_size)
+void AGC(_save_state)(AGC()           _q,
+                      unsigned char * _buf,
+                      unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != AGC(_get_state_size)(_q)) {
+        fprintf(stderr,"error: agc_%s_save_state(), invalid buffer length %u (expected %u)\n",
+                EXTENSION_FULL, _buf_len, AGC(_get_state_size)(_q));
+        exit(1);
+    }
+
+    memmove(_buf,             &_q->g,        sizeof(T));
+    memmove(_buf + sizeof(T), &_q->y2_prime, sizeof(T));
+}
+
+// restore adaptive gain-control state previously saved with
+// AGC(_save_state), skipping cold-start convergence
+//  _q       : agc object
+//  _buf     : input buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match AGC(_get_state_size)
+void AGC(_restore_state)(AGC()           _q,
+                         unsigned char * _buf,
+                         unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != AGC(_get_state_size)(_q)) {
+        fprintf(stderr,"error: agc_%s_restore_state(), invalid buffer length %u (expected %u)\n",
+                EXTENSION_FULL, _buf_len, AGC(_get_state_size)(_q));
+        exit(1);
+    }
+
+    memmove(&_q->g,        _buf,             sizeof(T));
+    memmove(&_q->y2_prime, _buf + sizeof(T), sizeof(T));
+}
+
 // get scale
 float AGC(_get_scale)(AGC() _q)
 {
@@ -32,6 +32,7 @@
 
 // macros
 #define AGC(name)           LIQUID_CONCAT(agc_crcf,name)
+#define AGCBANK(name)       LIQUID_CONCAT(agcbank_crcf,name)
 
 #define T                   float           // general
 #define TC                  float complex   // input/output
@@ -40,3 +41,4 @@
 
 // source files
 #include "agc.c"
+#include "agcbank.c"
@@ -32,6 +32,7 @@
 
 // macros
 #define AGC(name)           LIQUID_CONCAT(agc_rrrf,name)
+#define AGCBANK(name)       LIQUID_CONCAT(agcbank_rrrf,name)
 
 #define T                   float           // general
 #define TC                  float           // input/output
@@ -40,3 +41,4 @@
 
 // source files
 #include "agc.c"
+#include "agcbank.c"
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Automatic gain control bank: many parallel channels, shared parameters
+//
+// Running N independent agc objects over N streams scatters N tiny
+// states across memory and runs N scalar loops per sample. This object
+// keeps the per-channel gains and energy estimates in contiguous arrays
+// (structure-of-arrays) and processes channel-interleaved blocks, so the
+// gain application and energy accumulation sweep all channels in one
+// contiguous, vectorizable pass per sample row. The control loop is
+// updated once per sub-block per channel, matching agc_xxx_execute_block().
+// Per-channel lock state is held in a bitmask. Squelch is not supported;
+// use individual agc objects where squelch is required.
+//
+
+// agcbank structure object
+struct AGCBANK(_s) {
+    unsigned int num_channels;  // number of parallel channels
+
+    // gain control loop filter parameters (shared across channels)
+    float bandwidth;// bandwidth-time constant
+    T alpha;        // feed-back gain
+    T scale;        // output scale value
+
+    // per-channel state, contiguous arrays
+    T * g;          // current gain values,            [size: num_channels x 1]
+    T * y2_prime;   // filtered output energy estimates[size: num_channels x 1]
+
+    // per-channel locked flags, packed bitmask
+    unsigned char * locked;     // [size: (num_channels+7)/8 x 1]
+
+    // scratch buffers for block processing
+    T * e;          // accumulated sub-block energy,   [size: num_channels x 1]
+    T * geff;       // effective (scaled) gains,       [size: num_channels x 1]
+};
+
+// create agcbank object
+//  _num_channels   : number of parallel channels, _num_channels > 0
+AGCBANK() AGCBANK(_create)(unsigned int _num_channels)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: agcbank_%s_create(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create object and initialize to default parameters
+    AGCBANK() q = (AGCBANK()) malloc(sizeof(struct AGCBANK(_s)));
+    q->num_channels = _num_channels;
+
+    // allocate per-channel state
+    q->g        = (T*) malloc(q->num_channels*sizeof(T));
+    q->y2_prime = (T*) malloc(q->num_channels*sizeof(T));
+    q->e        = (T*) malloc(q->num_channels*sizeof(T));
+    q->geff     = (T*) malloc(q->num_channels*sizeof(T));
+    q->locked   = (unsigned char*) malloc((q->num_channels+7)/8);
+
+    // initialize bandwidth
+    AGCBANK(_set_bandwidth)(q, AGC_DEFAULT_BW);
+
+    // set default output gain
+    q->scale = 1;
+
+    // reset object and return
+    AGCBANK(_reset)(q);
+    return q;
+}
+
+// destroy agcbank object, freeing all internally-allocated memory
+void AGCBANK(_destroy)(AGCBANK() _q)
+{
+    // free per-channel state
+    free(_q->g);
+    free(_q->y2_prime);
+    free(_q->e);
+    free(_q->geff);
+    free(_q->locked);
+
+    // free main object memory
+    free(_q);
+}
+
+// print agcbank object internals
+void AGCBANK(_print)(AGCBANK() _q)
+{
+    printf("agcbank [channels: %u, bw: %12.4e]:\n", _q->num_channels, _q->bandwidth);
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        printf("  %4u : rssi: %12.4f dB, locked: %s\n", i,
+                AGCBANK(_get_rssi)(_q, i),
+                AGCBANK(_is_locked)(_q, i) ? "yes" : "no");
+    }
+}
+
+// reset agcbank object's internal state
+void AGCBANK(_reset)(AGCBANK() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        // reset gain and signal level estimates
+        _q->g[i]        = 1.0f;
+        _q->y2_prime[i] = 1.0f;
+    }
+
+    // unlock all channels
+    memset(_q->locked, 0x00, (_q->num_channels+7)/8);
+}
+
+// get number of parallel channels
+unsigned int AGCBANK(_get_num_channels)(AGCBANK() _q)
+{
+    return _q->num_channels;
+}
+
+// get loop bandwidth (shared across all channels)
+float AGCBANK(_get_bandwidth)(AGCBANK() _q)
+{
+    return _q->bandwidth;
+}
+
+// set loop bandwidth (shared across all channels)
+//  _q      :   agcbank object
+//  _bt     :   bandwidth
+void AGCBANK(_set_bandwidth)(AGCBANK() _q,
+                             float     _bt)
+{
+    // check to ensure bandwidth is reasonable
+    if ( _bt < 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_bandwidth(), bandwidth must be positive\n", EXTENSION_FULL);
+        exit(-1);
+    } else if ( _bt > 1.0f ) {
+        fprintf(stderr,"error: agcbank_%s_set_bandwidth(), bandwidth must less than 1.0\n", EXTENSION_FULL);
+        exit(-1);
+    }
+
+    // set internal bandwidth
+    _q->bandwidth = _bt;
+
+    // compute filter coefficient based on bandwidth
+    _q->alpha = _q->bandwidth;
+}
+
+// set output scale (shared across all channels)
+void AGCBANK(_set_scale)(AGCBANK() _q,
+                         T         _scale)
+{
+    if (_scale <= 0) {
+        fprintf(stderr,"error: agcbank_%s_set_scale(), scale must be greater than zero\n", EXTENSION_FULL);
+        exit(-1);
+    }
+    _q->scale = _scale;
+}
+
+// get output scale
+T AGCBANK(_get_scale)(AGCBANK() _q)
+{
+    return _q->scale;
+}
+
+// internal: validate channel index
+void AGCBANK(_validate_channel)(AGCBANK()    _q,
+                                unsigned int _channel,
+                                const char * _method)
+{
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: agcbank_%s_%s(), channel index (%u) exceeds bank size (%u)\n",
+                EXTENSION_FULL, _method, _channel, _q->num_channels);
+        exit(1);
+    }
+}
+
+// lock gain control for a single channel
+void AGCBANK(_lock)(AGCBANK()    _q,
+                    unsigned int _channel)
+{
+    AGCBANK(_validate_channel)(_q, _channel, "lock");
+    _q->locked[_channel >> 3] |= (1 << (_channel & 7));
+}
+
+// unlock gain control for a single channel
+void AGCBANK(_unlock)(AGCBANK()    _q,
+                      unsigned int _channel)
+{
+    AGCBANK(_validate_channel)(_q, _channel, "unlock");
+    _q->locked[_channel >> 3] &= ~(1 << (_channel & 7));
+}
+
+// is gain control locked for a particular channel?
+int AGCBANK(_is_locked)(AGCBANK()    _q,
+                        unsigned int _channel)
+{
+    AGCBANK(_validate_channel)(_q, _channel, "is_locked");
+    return (_q->locked[_channel >> 3] >> (_channel & 7)) & 1;
+}
+
+// lock gain control for all channels
+void AGCBANK(_lock_all)(AGCBANK() _q)
+{
+    memset(_q->locked, 0xff, (_q->num_channels+7)/8);
+}
+
+// unlock gain control for all channels
+void AGCBANK(_unlock_all)(AGCBANK() _q)
+{
+    memset(_q->locked, 0x00, (_q->num_channels+7)/8);
+}
+
+// get estimated signal level for a channel (dB)
+float AGCBANK(_get_rssi)(AGCBANK()    _q,
+                         unsigned int _channel)
+{
+    AGCBANK(_validate_channel)(_q, _channel, "get_rssi");
+    return -20*log10(_q->g[_channel]);
+}
+
+// get internal gain for a channel
+float AGCBANK(_get_gain)(AGCBANK()    _q,
+                         unsigned int _channel)
+{
+    AGCBANK(_validate_channel)(_q, _channel, "get_gain");
+    return _q->g[_channel];
+}
+
+// set internal gain for a channel
+void AGCBANK(_set_gain)(AGCBANK()    _q,
+                        unsigned int _channel,
+                        float        _gain)
+{
+    AGCBANK(_validate_channel)(_q, _channel, "set_gain");
+    if ( _gain <= 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_gain(), gain must be greater than zero\n", EXTENSION_FULL);
+        exit(-1);
+    }
+    _q->g[_channel] = _gain;
+}
+
+// execute gain control on a block of channel-interleaved samples; each
+// channel runs the same loop recursion as agc_xxx_execute_block(), with
+// the gain application and energy accumulation vectorized across
+// channels and the loop updated once per sub-block
+//  _q      : agcbank object
+//  _x      : input data array, [size: _n*num_channels x 1]
+//  _n      : number of input, output sample rows
+//  _y      : output data array, [size: _n*num_channels x 1]
+void AGCBANK(_execute_block)(AGCBANK()    _q,
+                             TC *         _x,
+                             unsigned int _n,
+                             TC *         _y)
+{
+    unsigned int nc = _q->num_channels;
+    unsigned int i, j, ch;
+
+    for (i=0; i<_n; i+=AGC_SUBBLOCK_LEN) {
+        // sub-block length (number of sample rows)
+        unsigned int m = _n - i;
+        if (m > AGC_SUBBLOCK_LEN)
+            m = AGC_SUBBLOCK_LEN;
+
+        // compute effective gains (output scale applied only when the
+        // loop is running, as with the scalar object)
+        for (ch=0; ch<nc; ch++) {
+            int locked = (_q->locked[ch >> 3] >> (ch & 7)) & 1;
+            _q->geff[ch] = locked ? _q->g[ch] : _q->g[ch] * _q->scale;
+            _q->e[ch]    = 0;
+        }
+
+        // apply gains and accumulate input energy, sweeping all
+        // channels contiguously for each sample row
+        for (j=0; j<m; j++) {
+            const TC * xp = _x + (i+j)*nc;
+            TC *       yp = _y + (i+j)*nc;
+            for (ch=0; ch<nc; ch++) {
+                yp[ch] = xp[ch] * _q->geff[ch];
+                _q->e[ch] += crealf( xp[ch]*conjf(xp[ch]) );
+            }
+        }
+
+        // update loop state per channel once per sub-block
+        for (ch=0; ch<nc; ch++) {
+            // average output signal energy over sub-block
+            T y2 = (_q->g[ch])*(_q->g[ch])*_q->e[ch] / (T)m;
+
+            // smooth energy estimate, applying the single-pole low-pass
+            // filter recursion m times with the average held constant
+            T b = powf(1.0f-_q->alpha, (float)m);
+            _q->y2_prime[ch] = b*_q->y2_prime[ch] + (1.0f-b)*y2;
+
+            // continue if locked
+            if ((_q->locked[ch >> 3] >> (ch & 7)) & 1)
+                continue;
+
+            // update gain according to output energy
+            if (_q->y2_prime[ch] > 1e-6f)
+                _q->g[ch] *= liquid_expf( -0.5f*_q->alpha*(float)m*liquid_logf(_q->y2_prime[ch]) );
+
+            // clamp to 120 dB gain
+            if (_q->g[ch] > 1e6f)
+                _q->g[ch] = 1e6f;
+        }
+    }
+}
+
+// execute gain control on one channel-interleaved sample row
+//  _q      : agcbank object
+//  _x      : input sample array,  [size: num_channels x 1]
+//  _y      : output sample array, [size: num_channels x 1]
+void AGCBANK(_execute)(AGCBANK() _q,
+                       TC *      _x,
+                       TC *      _y)
+{
+    AGCBANK(_execute_block)(_q, _x, 1, _y);
+}
@@ -52,7 +52,51 @@ void autotest_agc_crcf_dc_gain_control()
     agc_crcf_destroy(q);
 }
 
-// 
+//
+// Test saving and restoring converged gain-control state
+//
+void autotest_agc_crcf_state()
+{
+    // set paramaters
+    float gamma = 0.1f;     // nominal signal level
+    float bt    = 0.1f;     // bandwidth-time product
+    float tol   = 1e-6f;    // error tolerance
+
+    // create AGC object and let gain converge
+    agc_crcf q0 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q0, bt);
+
+    unsigned int i;
+    float complex x = gamma;    // input sample
+    float complex y0, y1;
+    for (i=0; i<256; i++)
+        agc_crcf_execute(q0, x, &y0);
+
+    // save converged state
+    unsigned int n = agc_crcf_get_state_size(q0);
+    unsigned char state[n];
+    agc_crcf_save_state(q0, state, n);
+
+    // restore into a fresh (cold) object with the same configuration
+    agc_crcf q1 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q1, bt);
+    agc_crcf_restore_state(q1, state, n);
+    CONTEND_DELTA( agc_crcf_get_gain(q1), agc_crcf_get_gain(q0), tol );
+
+    // both objects track identically from here
+    for (i=0; i<64; i++) {
+        agc_crcf_execute(q0, x, &y0);
+        agc_crcf_execute(q1, x, &y1);
+        CONTEND_DELTA( crealf(y0), crealf(y1), tol );
+        CONTEND_DELTA( cimagf(y0), cimagf(y1), tol );
+    }
+
+    // destroy AGC objects
+    agc_crcf_destroy(q0);
+    agc_crcf_destroy(q1);
+}
+
+//
 // Test AC gain control
 //
 void autotest_agc_crcf_ac_gain_control()
@@ -87,7 +131,44 @@ void autotest_agc_crcf_ac_gain_control()
 
 
 
-// 
+//
+// Test gain control on block of samples
+//
+void autotest_agc_crcf_block_gain_control()
+{
+    // set paramaters
+    float gamma = 0.1f;             // nominal signal level
+    float bt    = 0.1f;             // bandwidth-time product
+    float tol   = 0.01f;            // error tolerance
+    float dphi  = 0.1f;             // NCO frequency
+    unsigned int num_samples = 256; // number of samples to run
+
+    // create AGC object and initialize
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q, bt);
+
+    // generate signal (complex sinusoid)
+    unsigned int i;
+    float complex x[num_samples];
+    float complex y[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = gamma * cexpf(_Complex_I*i*dphi);
+
+    // run signal through gain control object as a single block
+    agc_crcf_execute_block(q, x, num_samples, y);
+
+    if (liquid_autotest_verbose)
+        printf("gamma : %12.8f, rssi : %12.8f\n", gamma, agc_crcf_get_signal_level(q));
+
+    // Check results
+    CONTEND_DELTA( agc_crcf_get_gain(q), 1.0f/gamma, tol);
+    CONTEND_DELTA( cabsf(y[num_samples-1]), 1.0f, tol );
+
+    // destroy AGC object
+    agc_crcf_destroy(q);
+}
+
+//
 // Test RSSI on sinusoidal input
 //
 void autotest_agc_crcf_rssi_sinusoid()
@@ -225,3 +306,40 @@ void autotest_agc_crcf_squelch()
 
 
 
+
+//
+// Test gain tracking from raw q15 (sc16) sample blocks
+//
+void autotest_agc_crcf_update_energy_q15()
+{
+    // set paramaters
+    float gamma = 0.1f;     // nominal signal level
+    float bt    = 0.1f;     // bandwidth-time product
+    float tol   = 0.001f;   // error tolerance
+
+    // create AGC object and initialize
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q, bt);
+
+    // generate block of interleaved q15 samples at constant level
+    unsigned int block_len = 16;
+    int16_t      x[2*block_len];
+    unsigned int i;
+    for (i=0; i<block_len; i++) {
+        x[2*i  ] = (int16_t)roundf(gamma * 32768.0f);
+        x[2*i+1] = 0;
+    }
+
+    // quantized signal level seen by the gain loop
+    float gamma_q15 = (float)x[0] / 32768.0f;
+
+    // update energy tracking from raw integer blocks (no conversion)
+    for (i=0; i<64; i++)
+        agc_crcf_update_energy_q15(q, x, block_len);
+
+    // tracked gain brings the quantized signal level to unity
+    CONTEND_DELTA( agc_crcf_get_gain(q) * gamma_q15, 1.0f, tol );
+
+    // destroy AGC object
+    agc_crcf_destroy(q);
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : gain control bank matches independent agc objects
+//
+// Run channel-interleaved input through the bank and the de-interleaved
+// streams through independent agc_rrrf objects (block mode); outputs and
+// converged gains must agree to within rounding
+void autotest_agcbank_rrrf()
+{
+    unsigned int num_channels = 7;
+    unsigned int num_samples  = 2048;
+    float        bt           = 0.01f;
+    float        tol          = 1e-3f;
+
+    // create bank and reference objects
+    agcbank_rrrf bank = agcbank_rrrf_create(num_channels);
+    agcbank_rrrf_set_bandwidth(bank, bt);
+    agc_rrrf ref[num_channels];
+    unsigned int ch;
+    for (ch=0; ch<num_channels; ch++) {
+        ref[ch] = agc_rrrf_create();
+        agc_rrrf_set_bandwidth(ref[ch], bt);
+    }
+
+    CONTEND_EQUALITY( agcbank_rrrf_get_num_channels(bank), num_channels );
+    CONTEND_DELTA   ( agcbank_rrrf_get_bandwidth   (bank), bt, 1e-6f    );
+
+    // generate channel-interleaved input: distinct amplitude and
+    // frequency per channel
+    float x [num_samples*num_channels];
+    float y [num_samples*num_channels];
+    float xc[num_samples];
+    float yc[num_samples];
+    unsigned int i;
+    for (ch=0; ch<num_channels; ch++) {
+        float gamma = 0.01f * powf(10.0f, 0.3f*ch);     // channel amplitude
+        float fc    = 0.01f + 0.05f*ch;                 // channel frequency
+        for (i=0; i<num_samples; i++)
+            x[i*num_channels + ch] = gamma*cosf(2*M_PI*fc*i + 0.2f*ch);
+    }
+
+    // run bank on interleaved block
+    agcbank_rrrf_execute_block(bank, x, num_samples, y);
+
+    // run each reference object on its de-interleaved stream
+    for (ch=0; ch<num_channels; ch++) {
+        for (i=0; i<num_samples; i++)
+            xc[i] = x[i*num_channels + ch];
+        agc_rrrf_execute_block(ref[ch], xc, num_samples, yc);
+
+        // compare output samples and converged gains
+        for (i=0; i<num_samples; i++) {
+            CONTEND_DELTA( y[i*num_channels + ch], yc[i], tol );
+        }
+        CONTEND_DELTA( agcbank_rrrf_get_gain(bank, ch),
+                       agc_rrrf_get_gain(ref[ch]), tol*agc_rrrf_get_gain(ref[ch]) );
+        CONTEND_DELTA( agcbank_rrrf_get_rssi(bank, ch),
+                       agc_rrrf_get_rssi(ref[ch]), 0.1f );
+    }
+
+    // destroy objects
+    agcbank_rrrf_destroy(bank);
+    for (ch=0; ch<num_channels; ch++)
+        agc_rrrf_destroy(ref[ch]);
+}
+
+//
+// AUTOTEST : per-channel lock holds gain on locked channels only
+//
+void autotest_agcbank_rrrf_lock()
+{
+    unsigned int num_channels = 5;
+    unsigned int num_samples  = 1024;
+
+    agcbank_rrrf bank = agcbank_rrrf_create(num_channels);
+    agcbank_rrrf_set_bandwidth(bank, 0.05f);
+
+    float x[num_samples*num_channels];
+    float y[num_samples*num_channels];
+    unsigned int i, ch;
+    for (ch=0; ch<num_channels; ch++) {
+        for (i=0; i<num_samples; i++)
+            x[i*num_channels + ch] = 0.1f*cosf(2*M_PI*(0.02f + 0.03f*ch)*i);
+    }
+
+    // converge on the signal, then lock odd-indexed channels
+    agcbank_rrrf_execute_block(bank, x, num_samples, y);
+    for (ch=1; ch<num_channels; ch+=2)
+        agcbank_rrrf_lock(bank, ch);
+    for (ch=0; ch<num_channels; ch++) {
+        CONTEND_EQUALITY( agcbank_rrrf_is_locked(bank, ch), ch & 1 );
+    }
+
+    // drop the input level by 20 dB and run again: locked channels must
+    // hold their gain, unlocked channels must re-converge
+    float g0[num_channels];
+    for (ch=0; ch<num_channels; ch++)
+        g0[ch] = agcbank_rrrf_get_gain(bank, ch);
+    for (i=0; i<num_samples*num_channels; i++)
+        x[i] *= 0.1f;
+    agcbank_rrrf_execute_block(bank, x, num_samples, y);
+
+    for (ch=0; ch<num_channels; ch++) {
+        if (ch & 1) {
+            CONTEND_DELTA( agcbank_rrrf_get_gain(bank, ch), g0[ch], 1e-6f );
+        } else {
+            CONTEND_GREATER_THAN( agcbank_rrrf_get_gain(bank, ch), 2.0f*g0[ch] );
+        }
+    }
+
+    // unlocking all channels resumes adaptation everywhere
+    agcbank_rrrf_unlock_all(bank);
+    for (ch=0; ch<num_channels; ch++) {
+        CONTEND_EQUALITY( agcbank_rrrf_is_locked(bank, ch), 0 );
+    }
+
+    agcbank_rrrf_destroy(bank);
+}
+
+//
+// AUTOTEST : complex gain control bank matches independent agc objects
+//
+void autotest_agcbank_crcf()
+{
+    unsigned int num_channels = 4;
+    unsigned int num_samples  = 2048;
+    float        bt           = 0.02f;
+    float        tol          = 1e-3f;
+
+    agcbank_crcf bank = agcbank_crcf_create(num_channels);
+    agcbank_crcf_set_bandwidth(bank, bt);
+    agc_crcf ref[num_channels];
+    unsigned int ch;
+    for (ch=0; ch<num_channels; ch++) {
+        ref[ch] = agc_crcf_create();
+        agc_crcf_set_bandwidth(ref[ch], bt);
+    }
+
+    float complex x [num_samples*num_channels];
+    float complex y [num_samples*num_channels];
+    float complex xc[num_samples];
+    float complex yc[num_samples];
+    unsigned int i;
+    for (ch=0; ch<num_channels; ch++) {
+        float gamma = 0.05f * powf(10.0f, 0.4f*ch);
+        float fc    = -0.2f + 0.1f*ch;
+        for (i=0; i<num_samples; i++)
+            x[i*num_channels + ch] = gamma*cexpf(_Complex_I*2*M_PI*fc*i);
+    }
+
+    agcbank_crcf_execute_block(bank, x, num_samples, y);
+
+    for (ch=0; ch<num_channels; ch++) {
+        for (i=0; i<num_samples; i++)
+            xc[i] = x[i*num_channels + ch];
+        agc_crcf_execute_block(ref[ch], xc, num_samples, yc);
+
+        for (i=0; i<num_samples; i++) {
+            CONTEND_DELTA( crealf(y[i*num_channels + ch]), crealf(yc[i]), tol );
+            CONTEND_DELTA( cimagf(y[i*num_channels + ch]), cimagf(yc[i]), tol );
+        }
+        CONTEND_DELTA( agcbank_crcf_get_rssi(bank, ch),
+                       agc_crcf_get_rssi(ref[ch]), 0.1f );
+    }
+
+    agcbank_crcf_destroy(bank);
+    for (ch=0; ch<num_channels; ch++)
+        agc_crcf_destroy(ref[ch]);
+}
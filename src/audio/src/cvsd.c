@@ -26,6 +26,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 #include "liquid.internal.h"
 
@@ -229,3 +231,354 @@ void cvsd_decode8(cvsd _q,
     }
 }
 
+// encode block of samples, eight samples per output byte
+//  _q      :   cvsd object
+//  _audio  :   input audio array [size: 8*_n x 1]
+//  _n      :   number of output bytes
+//  _data   :   output data array [size: _n x 1]
+void cvsd_encode_block(cvsd _q,
+                       float * _audio,
+                       unsigned int _n,
+                       unsigned char * _data)
+{
+    // keep codec state in local variables across the inner loop
+    unsigned char bitref = _q->bitref;
+    float         ref    = _q->ref;
+    float         delta  = _q->delta;
+
+    unsigned int i, j;
+    float yb[8];
+    for (i=0; i<_n; i++) {
+        // push audio samples through pre-filter
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+        iirfilt_rrrf_execute_block(_q->prefilt, &_audio[8*i], 8, yb);
+#else
+        memmove(yb, &_audio[8*i], 8*sizeof(float));
+#endif
+
+        unsigned char data = 0x00;
+        for (j=0; j<8; j++) {
+            // determine output bit
+            unsigned char bit = (ref > yb[j]) ? 0 : 1;
+            data = (data << 1) | bit;
+
+            // shift last value into reference buffer
+            bitref = ((bitref << 1) | bit) & _q->bitmask;
+
+            // update delta, limiting with branchless select/clamp
+            int run = (bitref == 0) || (bitref == _q->bitmask);
+            delta = run ? (delta * _q->zeta) : (delta / _q->zeta);
+            delta = fminf(delta, _q->delta_max);
+            delta = fmaxf(delta, _q->delta_min);
+
+            // update and limit reference
+            ref += bit ? delta : -delta;
+            ref  = fminf(ref,  1.0f);
+            ref  = fmaxf(ref, -1.0f);
+        }
+        _data[i] = data;
+    }
+
+    // store updated state
+    _q->bitref = bitref;
+    _q->ref    = ref;
+    _q->delta  = delta;
+}
+
+// decode block of samples, eight samples per input byte
+//  _q      :   cvsd object
+//  _data   :   input data array [size: _n x 1]
+//  _n      :   number of input bytes
+//  _audio  :   output audio array [size: 8*_n x 1]
+void cvsd_decode_block(cvsd _q,
+                       unsigned char * _data,
+                       unsigned int _n,
+                       float * _audio)
+{
+    // keep codec state in local variables across the inner loop
+    unsigned char bitref = _q->bitref;
+    float         ref    = _q->ref;
+    float         delta  = _q->delta;
+
+    unsigned int i, j;
+    for (i=0; i<_n; i++) {
+        unsigned char data = _data[i];
+        float * yb = &_audio[8*i];
+        for (j=0; j<8; j++) {
+            // extract bit and shift into reference buffer
+            unsigned char bit = (data >> (8-j-1)) & 0x01;
+            bitref = ((bitref << 1) | bit) & _q->bitmask;
+
+            // update delta, limiting with branchless select/clamp
+            int run = (bitref == 0) || (bitref == _q->bitmask);
+            delta = run ? (delta * _q->zeta) : (delta / _q->zeta);
+            delta = fminf(delta, _q->delta_max);
+            delta = fmaxf(delta, _q->delta_min);
+
+            // update and limit reference
+            ref += bit ? delta : -delta;
+            ref  = fminf(ref,  1.0f);
+            ref  = fmaxf(ref, -1.0f);
+
+            yb[j] = ref;
+        }
+
+        // push reference values through post-filter (in place)
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+        iirfilt_rrrf_execute_block(_q->postfilt, yb, 8, yb);
+#endif
+    }
+
+    // store updated state
+    _q->bitref = bitref;
+    _q->ref    = ref;
+    _q->delta  = delta;
+}
+
+//
+// CVSD codec bank: many independent streams processed in parallel with
+// per-channel state held in structure-of-arrays form
+//
+
+struct cvsdbank_s {
+    unsigned int num_channels;  // number of streams
+    unsigned int num_bits;      // number of adjacent bits to observe
+    unsigned char bitmask;      // historical bit reference mask
+    float zeta;                 // delta step factor
+    float delta_min;            // minimum delta
+    float delta_max;            // maximum delta
+
+    // per-channel codec state (structure-of-arrays)
+    unsigned char * bitref;     // historical bit references [num_channels]
+    float * ref;                // internal references [num_channels]
+    float * delta;              // current step sizes [num_channels]
+    float * yb;                 // conditioned sample buffer [8 x num_channels]
+
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+    float alpha;                // pre-/de-emphasis filter coefficient
+    float beta;                 // DC-blocking coefficient (decoder)
+    iirfilt_rrrf * prefilt;     // pre-emphasis filters [num_channels]
+    iirfilt_rrrf * postfilt;    // de-emphasis filters [num_channels]
+#endif
+};
+
+// create cvsd codec bank object
+//  _num_bits       :   number of adjacent bits to observe
+//  _zeta           :   slope adjustment multiplier
+//  _alpha          :   pre-/post-emphasis filter coefficient (0.9 recommended)
+//  _num_channels   :   number of streams processed in parallel
+cvsdbank cvsdbank_create(unsigned int _num_bits,
+                         float _zeta,
+                         float _alpha,
+                         unsigned int _num_channels)
+{
+    if (_num_bits == 0) {
+        fprintf(stderr, "error: cvsdbank_create(), _num_bits must be positive\n");
+        exit(1);
+    } else if (_zeta <= 1.0f) {
+        fprintf(stderr, "error: cvsdbank_create(), zeta must be greater than 1\n");
+        exit(1);
+    } else if (_alpha < 0.0f || _alpha > 1.0f) {
+        fprintf(stderr, "error: cvsdbank_create(), alpha must be in [0,1]\n");
+        exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr, "error: cvsdbank_create(), number of channels must be greater than zero\n");
+        exit(1);
+    }
+
+    cvsdbank q = (cvsdbank) malloc(sizeof(struct cvsdbank_s));
+    q->num_channels = _num_channels;
+    q->num_bits = _num_bits;
+    q->bitmask = (1<<(q->num_bits)) - 1;
+
+    q->zeta = _zeta;
+    q->delta_min = 0.01f;
+    q->delta_max = 1.0f;
+
+    // allocate and initialize per-channel state
+    q->bitref = (unsigned char*) malloc(q->num_channels*sizeof(unsigned char));
+    q->ref    = (float*) malloc(q->num_channels*sizeof(float));
+    q->delta  = (float*) malloc(q->num_channels*sizeof(float));
+    q->yb     = (float*) malloc(8*q->num_channels*sizeof(float));
+
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+    // design pre-emphasis filter prototype
+    q->alpha = _alpha;
+    float b_pre[2] = {1.0f, -q->alpha};
+    float a_pre[2] = {1.0f, 0.0f};
+
+    // design post-emphasis filter prototype
+    q->beta = 0.99f;    // DC-blocking parameter
+    float b_post[3] = {1.0f, -1.0f, 0.0f};
+    float a_post[3] = {1.0f, -(q->alpha + q->beta), q->alpha*q->beta};
+
+    q->prefilt  = (iirfilt_rrrf*) malloc(q->num_channels*sizeof(iirfilt_rrrf));
+    q->postfilt = (iirfilt_rrrf*) malloc(q->num_channels*sizeof(iirfilt_rrrf));
+    unsigned int ch;
+    for (ch=0; ch<q->num_channels; ch++) {
+        q->prefilt[ch]  = iirfilt_rrrf_create(b_pre,2,a_pre,2);
+        q->postfilt[ch] = iirfilt_rrrf_create(b_post,3,a_post,3);
+    }
+#endif
+
+    cvsdbank_reset(q);
+
+    return q;
+}
+
+// destroy cvsd codec bank object
+void cvsdbank_destroy(cvsdbank _q)
+{
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+    // destroy filters
+    unsigned int ch;
+    for (ch=0; ch<_q->num_channels; ch++) {
+        iirfilt_rrrf_destroy(_q->prefilt[ch]);
+        iirfilt_rrrf_destroy(_q->postfilt[ch]);
+    }
+    free(_q->prefilt);
+    free(_q->postfilt);
+#endif
+
+    // free internal arrays
+    free(_q->bitref);
+    free(_q->ref);
+    free(_q->delta);
+    free(_q->yb);
+
+    // free main object memory
+    free(_q);
+}
+
+// print cvsd codec bank object parameters
+void cvsdbank_print(cvsdbank _q)
+{
+    printf("cvsd codec bank:\n");
+    printf("    channels: %u\n", _q->num_channels);
+    printf("    num bits: %u\n", _q->num_bits);
+    printf("    zeta    : %8.4f\n", _q->zeta);
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+    printf("    alpha   : %8.4f\n", _q->alpha);
+#endif
+}
+
+// reset all channel states
+void cvsdbank_reset(cvsdbank _q)
+{
+    unsigned int ch;
+    for (ch=0; ch<_q->num_channels; ch++) {
+        _q->bitref[ch] = 0;
+        _q->ref[ch]    = 0.0f;
+        _q->delta[ch]  = 0.01f;
+
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+        iirfilt_rrrf_reset(_q->prefilt[ch]);
+        iirfilt_rrrf_reset(_q->postfilt[ch]);
+#endif
+    }
+}
+
+// get number of channels
+unsigned int cvsdbank_get_num_channels(cvsdbank _q)
+{
+    return _q->num_channels;
+}
+
+// encode eight channel-interleaved sample rows, one output byte per channel
+//  _q      :   cvsd codec bank object
+//  _audio  :   input audio [size: 8 x num_channels], channel-interleaved
+//  _data   :   output data array [size: num_channels x 1]
+void cvsdbank_encode(cvsdbank _q,
+                     float * _audio,
+                     unsigned char * _data)
+{
+    unsigned int j, ch;
+    unsigned int nc = _q->num_channels;
+
+    // push audio samples through pre-filters
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+    for (j=0; j<8; j++) {
+        for (ch=0; ch<nc; ch++)
+            iirfilt_rrrf_execute(_q->prefilt[ch], _audio[j*nc+ch], &_q->yb[j*nc+ch]);
+    }
+#else
+    memmove(_q->yb, _audio, 8*nc*sizeof(float));
+#endif
+
+    // clear output bytes
+    for (ch=0; ch<nc; ch++)
+        _data[ch] = 0x00;
+
+    for (j=0; j<8; j++) {
+        float * yp = &_q->yb[j*nc];
+        for (ch=0; ch<nc; ch++) {
+            // determine output bit
+            unsigned char bit = (_q->ref[ch] > yp[ch]) ? 0 : 1;
+            _data[ch] = (_data[ch] << 1) | bit;
+
+            // shift last value into reference buffer
+            unsigned char bitref = ((_q->bitref[ch] << 1) | bit) & _q->bitmask;
+            _q->bitref[ch] = bitref;
+
+            // update delta, limiting with branchless select/clamp
+            int run = (bitref == 0) || (bitref == _q->bitmask);
+            float delta = run ? (_q->delta[ch] * _q->zeta) : (_q->delta[ch] / _q->zeta);
+            delta = fminf(delta, _q->delta_max);
+            delta = fmaxf(delta, _q->delta_min);
+            _q->delta[ch] = delta;
+
+            // update and limit reference
+            float ref = _q->ref[ch] + (bit ? delta : -delta);
+            ref = fminf(ref,  1.0f);
+            ref = fmaxf(ref, -1.0f);
+            _q->ref[ch] = ref;
+        }
+    }
+}
+
+// decode one byte per channel into eight channel-interleaved sample rows
+//  _q      :   cvsd codec bank object
+//  _data   :   input data array [size: num_channels x 1]
+//  _audio  :   output audio [size: 8 x num_channels], channel-interleaved
+void cvsdbank_decode(cvsdbank _q,
+                     unsigned char * _data,
+                     float * _audio)
+{
+    unsigned int j, ch;
+    unsigned int nc = _q->num_channels;
+
+    for (j=0; j<8; j++) {
+        float * yp = &_q->yb[j*nc];
+        for (ch=0; ch<nc; ch++) {
+            // extract bit and shift into reference buffer
+            unsigned char bit = (_data[ch] >> (8-j-1)) & 0x01;
+            unsigned char bitref = ((_q->bitref[ch] << 1) | bit) & _q->bitmask;
+            _q->bitref[ch] = bitref;
+
+            // update delta, limiting with branchless select/clamp
+            int run = (bitref == 0) || (bitref == _q->bitmask);
+            float delta = run ? (_q->delta[ch] * _q->zeta) : (_q->delta[ch] / _q->zeta);
+            delta = fminf(delta, _q->delta_max);
+            delta = fmaxf(delta, _q->delta_min);
+            _q->delta[ch] = delta;
+
+            // update and limit reference
+            float ref = _q->ref[ch] + (bit ? delta : -delta);
+            ref = fminf(ref,  1.0f);
+            ref = fmaxf(ref, -1.0f);
+            _q->ref[ch] = ref;
+
+            yp[ch] = ref;
+        }
+    }
+
+    // push reference values through post-filters
+#if CVSD_ENABLE_SIGNAL_CONDITIONING
+    for (j=0; j<8; j++) {
+        for (ch=0; ch<nc; ch++)
+            iirfilt_rrrf_execute(_q->postfilt[ch], _q->yb[j*nc+ch], &_audio[j*nc+ch]);
+    }
+#else
+    memmove(_audio, _q->yb, 8*nc*sizeof(float));
+#endif
+}
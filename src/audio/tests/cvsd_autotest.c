@@ -61,3 +61,54 @@ void autotest_cvsd_rmse_sine() {
     cvsd_destroy(cvsd_decoder);
 }
 
+
+//
+// AUTOTEST: block-based encode/decode matches the sample-based interface
+//
+void autotest_cvsd_block() {
+    unsigned int num_bytes=40;
+    unsigned int nbits=3;
+    float zeta=1.5f;
+    float alpha=0.90f;
+    float tol=1e-6f;
+
+    // create sample-based and block-based codecs
+    cvsd enc0 = cvsd_create(nbits,zeta,alpha);
+    cvsd enc1 = cvsd_create(nbits,zeta,alpha);
+    cvsd dec0 = cvsd_create(nbits,zeta,alpha);
+    cvsd dec1 = cvsd_create(nbits,zeta,alpha);
+
+    // generate input audio
+    unsigned int n = 8*num_bytes;
+    float x[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = 0.5f*sinf(0.1f*i) + 0.3f*cosf(0.017f*i);
+
+    // encode with both interfaces
+    unsigned char b0[num_bytes];
+    unsigned char b1[num_bytes];
+    for (i=0; i<num_bytes; i++)
+        cvsd_encode8(enc0, &x[8*i], &b0[i]);
+    cvsd_encode_block(enc1, x, num_bytes, b1);
+
+    // encoded bytes must match exactly
+    CONTEND_SAME_DATA(b0, b1, num_bytes*sizeof(unsigned char));
+
+    // decode with both interfaces
+    float y0[n];
+    float y1[n];
+    for (i=0; i<num_bytes; i++)
+        cvsd_decode8(dec0, b0[i], &y0[8*i]);
+    cvsd_decode_block(dec1, b1, num_bytes, y1);
+
+    // decoded audio must match
+    for (i=0; i<n; i++)
+        CONTEND_DELTA(y0[i], y1[i], tol);
+
+    // destroy codecs
+    cvsd_destroy(enc0);
+    cvsd_destroy(enc1);
+    cvsd_destroy(dec0);
+    cvsd_destroy(dec1);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+//
+// AUTOTEST: codec bank matches a set of independent scalar codecs
+//
+void autotest_cvsdbank() {
+    unsigned int num_channels=7;
+    unsigned int num_bytes=30;
+    unsigned int nbits=3;
+    float zeta=1.5f;
+    float alpha=0.90f;
+    float tol=1e-6f;
+
+    // create codec bank (encoder and decoder)
+    cvsdbank enc = cvsdbank_create(nbits,zeta,alpha,num_channels);
+    cvsdbank dec = cvsdbank_create(nbits,zeta,alpha,num_channels);
+    CONTEND_EQUALITY( cvsdbank_get_num_channels(enc), num_channels );
+
+    // create independent scalar codecs for reference
+    cvsd enc_ref[num_channels];
+    cvsd dec_ref[num_channels];
+    unsigned int ch;
+    for (ch=0; ch<num_channels; ch++) {
+        enc_ref[ch] = cvsd_create(nbits,zeta,alpha);
+        dec_ref[ch] = cvsd_create(nbits,zeta,alpha);
+    }
+
+    unsigned int i, j;
+    float x[8*num_channels];            // channel-interleaved input
+    float y[8*num_channels];            // channel-interleaved output
+    unsigned char data[num_channels];   // encoded data, one byte per channel
+    float x_ref[8];
+    float y_ref[8];
+    unsigned char data_ref;
+
+    for (i=0; i<num_bytes; i++) {
+        // generate channel-interleaved input (distinct per channel)
+        for (j=0; j<8; j++) {
+            for (ch=0; ch<num_channels; ch++)
+                x[j*num_channels+ch] = 0.5f*sinf(0.1f*(8*i+j) + 0.4f*ch);
+        }
+
+        // run bank encoder/decoder
+        cvsdbank_encode(enc, x, data);
+        cvsdbank_decode(dec, data, y);
+
+        // compare each channel against scalar reference
+        for (ch=0; ch<num_channels; ch++) {
+            for (j=0; j<8; j++)
+                x_ref[j] = x[j*num_channels+ch];
+            cvsd_encode8(enc_ref[ch], x_ref, &data_ref);
+            CONTEND_EQUALITY( data[ch], data_ref );
+
+            cvsd_decode8(dec_ref[ch], data_ref, y_ref);
+            for (j=0; j<8; j++)
+                CONTEND_DELTA( y[j*num_channels+ch], y_ref[j], tol );
+        }
+    }
+
+    // destroy objects
+    cvsdbank_destroy(enc);
+    cvsdbank_destroy(dec);
+    for (ch=0; ch<num_channels; ch++) {
+        cvsd_destroy(enc_ref[ch]);
+        cvsd_destroy(dec_ref[ch]);
+    }
+}
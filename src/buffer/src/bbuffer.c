@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Burst buffer with zero-copy, reference-counted slices
+//
+// A large circular sample arena for burst receivers: the capture path
+// appends samples, detectors acquire [start,length] slice handles by
+// absolute sample index, and demodulation workers process the slice
+// data in place and release the handle.  Samples covered by a live
+// slice are protected from being overwritten, so no per-burst copy is
+// ever made.  The leading max_slice_len samples of the arena are
+// mirrored past its end (as with the regular circular buffer), so
+// every slice is contiguous in memory even when it spans the
+// wrap-around point.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// internal slice descriptor
+struct BBUFFER(_slice_s) {
+    unsigned long int start;    // absolute index of first sample
+    unsigned int      len;      // slice length
+    unsigned int      refcount; // references held (0 : slot is free)
+};
+
+struct BBUFFER(_s) {
+    T * v;                          // sample arena [size: max_size + max_slice_len]
+    unsigned int max_size;          // arena capacity
+    unsigned int max_slice_len;     // maximum slice length
+    unsigned long int num_written;  // total number of samples written
+
+    struct BBUFFER(_slice_s) * slices;  // slice descriptor table
+    unsigned int num_slots;             // descriptor table size
+};
+
+// create burst buffer object
+//  _max_size       :   arena capacity [samples], _max_size > 0
+//  _max_slice_len  :   maximum slice length, 0 < _max_slice_len <= _max_size
+BBUFFER() BBUFFER(_create)(unsigned int _max_size,
+                           unsigned int _max_slice_len)
+{
+    // validate input
+    if (_max_size == 0) {
+        fprintf(stderr,"error: bbuffer%s_create(), buffer size must be greater than zero\n", EXTENSION);
+        exit(1);
+    } else if (_max_slice_len == 0 || _max_slice_len > _max_size) {
+        fprintf(stderr,"error: bbuffer%s_create(), maximum slice length must be in [1,max_size]\n", EXTENSION);
+        exit(1);
+    }
+
+    // create object and initialize
+    BBUFFER() q = (BBUFFER()) malloc(sizeof(struct BBUFFER(_s)));
+    q->max_size      = _max_size;
+    q->max_slice_len = _max_slice_len;
+
+    // allocate arena with mirrored head region for contiguous slices
+    q->v = (T*) malloc((q->max_size + q->max_slice_len)*sizeof(T));
+
+    // slice descriptor table (grown on demand)
+    q->slices    = NULL;
+    q->num_slots = 0;
+
+    // reset and return
+    BBUFFER(_reset)(q);
+    return q;
+}
+
+// destroy burst buffer object, freeing all internal memory
+void BBUFFER(_destroy)(BBUFFER() _q)
+{
+    free(_q->slices);
+    free(_q->v);
+    free(_q);
+}
+
+// print burst buffer object properties
+void BBUFFER(_print)(BBUFFER() _q)
+{
+    printf("bbuffer%s: [max size: %u, max slice: %u, written: %lu, live slices: %u]\n",
+            EXTENSION, _q->max_size, _q->max_slice_len,
+            _q->num_written, BBUFFER(_get_num_slices)(_q));
+}
+
+// reset burst buffer, discarding all samples and releasing all slices
+void BBUFFER(_reset)(BBUFFER() _q)
+{
+    _q->num_written = 0;
+    unsigned int i;
+    for (i=0; i<_q->num_slots; i++)
+        _q->slices[i].refcount = 0;
+}
+
+// get total number of samples written to the buffer
+unsigned long int BBUFFER(_get_num_written)(BBUFFER() _q)
+{
+    return _q->num_written;
+}
+
+// get number of live (unreleased) slices
+unsigned int BBUFFER(_get_num_slices)(BBUFFER() _q)
+{
+    unsigned int i;
+    unsigned int n = 0;
+    for (i=0; i<_q->num_slots; i++) {
+        if (_q->slices[i].refcount > 0)
+            n++;
+    }
+    return n;
+}
+
+// compute absolute index of the oldest sample protected by a live
+// slice; internal method used for overwrite protection
+unsigned long int BBUFFER(_get_retention_index)(BBUFFER() _q)
+{
+    unsigned long int index = _q->num_written;
+    unsigned int i;
+    for (i=0; i<_q->num_slots; i++) {
+        if (_q->slices[i].refcount > 0 && _q->slices[i].start < index)
+            index = _q->slices[i].start;
+    }
+    return index;
+}
+
+// append block of samples to the arena
+//  _q      :   burst buffer object
+//  _v      :   sample array [size: _n x 1]
+//  _n      :   number of samples
+void BBUFFER(_write)(BBUFFER()    _q,
+                     T *          _v,
+                     unsigned int _n)
+{
+    // ensure the write does not overrun samples held by a live slice
+    if (_q->num_written + _n > BBUFFER(_get_retention_index)(_q) + _q->max_size) {
+        fprintf(stderr,"error: bbuffer%s_write(), write would overrun unreleased slice\n", EXTENSION);
+        exit(1);
+    }
+
+    while (_n > 0) {
+        // copy contiguous run up to the arena wrap-around point
+        unsigned int index = (unsigned int)(_q->num_written % _q->max_size);
+        unsigned int r = _q->max_size - index;
+        if (r > _n) r = _n;
+        memmove(_q->v + index, _v, r*sizeof(T));
+
+        // mirror the leading region past the end of the arena so
+        // slices spanning the wrap-around point remain contiguous
+        if (index < _q->max_slice_len) {
+            unsigned int m = _q->max_slice_len - index;
+            if (m > r) m = r;
+            memmove(_q->v + _q->max_size + index, _v, m*sizeof(T));
+        }
+
+        _q->num_written += r;
+        _v += r;
+        _n -= r;
+    }
+}
+
+// acquire slice handle on a range of buffered samples; the samples are
+// protected from being overwritten until every reference is released
+//  _q      :   burst buffer object
+//  _start  :   absolute index of first sample (see get_num_written)
+//  _len    :   slice length, 0 < _len <= max_slice_len
+unsigned int BBUFFER(_slice_acquire)(BBUFFER()         _q,
+                                     unsigned long int _start,
+                                     unsigned int      _len)
+{
+    // validate input
+    if (_len == 0 || _len > _q->max_slice_len) {
+        fprintf(stderr,"error: bbuffer%s_slice_acquire(), slice length (%u) must be in [1,%u]\n",
+                EXTENSION, _len, _q->max_slice_len);
+        exit(1);
+    } else if (_start + _len > _q->num_written) {
+        fprintf(stderr,"error: bbuffer%s_slice_acquire(), slice extends past last written sample\n", EXTENSION);
+        exit(1);
+    } else if (_start + _q->max_size < _q->num_written) {
+        fprintf(stderr,"error: bbuffer%s_slice_acquire(), slice samples have already been overwritten\n", EXTENSION);
+        exit(1);
+    }
+
+    // find a free descriptor slot, extending the table as needed
+    unsigned int id;
+    for (id=0; id<_q->num_slots; id++) {
+        if (_q->slices[id].refcount == 0)
+            break;
+    }
+    if (id == _q->num_slots) {
+        _q->num_slots++;
+        _q->slices = (struct BBUFFER(_slice_s)*) realloc(_q->slices,
+                _q->num_slots*sizeof(struct BBUFFER(_slice_s)));
+    }
+
+    // initialize descriptor
+    _q->slices[id].start    = _start;
+    _q->slices[id].len      = _len;
+    _q->slices[id].refcount = 1;
+
+    return id;
+}
+
+// validate slice handle; internal method
+void BBUFFER(_slice_validate)(BBUFFER()    _q,
+                              unsigned int _id,
+                              const char * _method)
+{
+    if (_id >= _q->num_slots || _q->slices[_id].refcount == 0) {
+        fprintf(stderr,"error: bbuffer%s_slice_%s(), invalid slice handle (%u)\n",
+                EXTENSION, _method, _id);
+        exit(1);
+    }
+}
+
+// get pointer to a slice's samples (zero-copy, in the arena); valid
+// until the last reference to the slice is released
+T * BBUFFER(_slice_data)(BBUFFER()    _q,
+                         unsigned int _id)
+{
+    BBUFFER(_slice_validate)(_q, _id, "data");
+    return _q->v + (unsigned int)(_q->slices[_id].start % _q->max_size);
+}
+
+// get slice length
+unsigned int BBUFFER(_slice_len)(BBUFFER()    _q,
+                                 unsigned int _id)
+{
+    BBUFFER(_slice_validate)(_q, _id, "len");
+    return _q->slices[_id].len;
+}
+
+// add reference to slice (e.g. handing it to an additional worker)
+void BBUFFER(_slice_retain)(BBUFFER()    _q,
+                            unsigned int _id)
+{
+    BBUFFER(_slice_validate)(_q, _id, "retain");
+    _q->slices[_id].refcount++;
+}
+
+// release reference to slice; when the last reference is dropped the
+// samples may be overwritten by subsequent writes
+void BBUFFER(_slice_release)(BBUFFER()    _q,
+                             unsigned int _id)
+{
+    BBUFFER(_slice_validate)(_q, _id, "release");
+    _q->slices[_id].refcount--;
+}
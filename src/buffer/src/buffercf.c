@@ -31,6 +31,7 @@
 
 #define BUFFER_TYPE_CFLOAT
 
+#define BBUFFER(name)   LIQUID_CONCAT(bbuffercf, name)
 #define CBUFFER(name)   LIQUID_CONCAT(cbuffercf, name)
 //#define SBUFFER(name)   LIQUID_CONCAT(sbuffercf, name)
 #define WDELAY(name)    LIQUID_CONCAT(wdelaycf,  name)
@@ -42,6 +43,7 @@
 #define BUFFER_PRINT_VALUE(V) \
     printf("  : %12.4e + %12.4e", crealf(V), cimagf(V));
 
+#include "bbuffer.c"
 #include "cbuffer.c"
 //#include "sbuffer.c"
 #include "window.c"
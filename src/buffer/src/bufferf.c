@@ -31,6 +31,7 @@
 
 #define BUFFER_TYPE_FLOAT
 
+#define BBUFFER(name)   LIQUID_CONCAT(bbufferf, name)
 #define CBUFFER(name)   LIQUID_CONCAT(cbufferf, name)
 //#define SBUFFER(name)   LIQUID_CONCAT(sbufferf, name)
 #define WDELAY(name)    LIQUID_CONCAT(wdelayf,  name)
@@ -42,6 +43,7 @@
 #define BUFFER_PRINT_VALUE(V) \
     printf("  : %12.4e", V);
 
+#include "bbuffer.c"
 #include "cbuffer.c"
 //#include "sbuffer.c"
 #include "wdelay.c"
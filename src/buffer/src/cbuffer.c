@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 
 #include "liquid.internal.h"
 
@@ -46,15 +47,25 @@ struct CBUFFER(_s) {
 
     // number of elements allocated in memory
     unsigned int num_allocated;
-    
+
     // number of elements currently in buffer
     unsigned int num_elements;
-    
+
     // index to read
     unsigned int read_index;
-    
+
     // index to write
     unsigned int write_index;
+
+    // lock-free single-producer/single-consumer mode enabled?
+    int spsc;
+
+    // free-running element counters for SPSC mode; the producer only
+    // stores to num_written and the consumer only stores to num_read,
+    // so the element count may be derived from either thread without
+    // locks as (num_written - num_read)
+    atomic_ulong num_written;
+    atomic_ulong num_read;
 };
 
 // create circular buffer object of a particular size
@@ -86,6 +97,9 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
     // allocate internal memory array
     q->v = (T*) malloc((q->num_allocated)*sizeof(T));
 
+    // default to single-threaded operation
+    q->spsc = 0;
+
     // reset object
     CBUFFER(_reset)(q);
 
@@ -93,6 +107,26 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
     return q;
 }
 
+// create circular buffer object in lock-free single-producer/
+// single-consumer mode; the requested size is rounded up to the
+// next power of two so indices wrap cleanly
+CBUFFER() CBUFFER(_create_spsc)(unsigned int _max_size)
+{
+    // round capacity up to the next power of two
+    unsigned int n = 1;
+    while (n < _max_size)
+        n <<= 1;
+
+    // create main object
+    CBUFFER() q = CBUFFER(_create_max)(n, n);
+
+    // enable lock-free single-producer/single-consumer mode
+    q->spsc = 1;
+
+    // return main object
+    return q;
+}
+
 // destroy cbuffer object, freeing all internal memory
 void CBUFFER(_destroy)(CBUFFER() _q)
 {
@@ -106,14 +140,15 @@ void CBUFFER(_destroy)(CBUFFER() _q)
 // print cbuffer object properties
 void CBUFFER(_print)(CBUFFER() _q)
 {
+    unsigned int num_elements = CBUFFER(_size)(_q);
     printf("cbuffer%s [max size: %u, max read: %u, elements: %u]\n",
             EXTENSION,
             _q->max_size,
             _q->max_read,
-            _q->num_elements);
+            num_elements);
 
     unsigned int i;
-    for (i=0; i<_q->num_elements; i++) {
+    for (i=0; i<num_elements; i++) {
         printf("%u", i);
         BUFFER_PRINT_LINE(_q,(_q->read_index+i)%(_q->max_size))
         printf("\n");
@@ -127,7 +162,7 @@ void CBUFFER(_debug_print)(CBUFFER() _q)
             EXTENSION,
             _q->max_size,
             _q->max_read,
-            _q->num_elements);
+            CBUFFER(_size)(_q));
 
     unsigned int i;
     for (i=0; i<_q->max_size; i++) {
@@ -157,17 +192,26 @@ void CBUFFER(_debug_print)(CBUFFER() _q)
     }
 }
 
-// clear internal buffer
+// clear internal buffer; not safe to call while another thread is
+// accessing the buffer in single-producer/single-consumer mode
 void CBUFFER(_reset)(CBUFFER() _q)
 {
     _q->read_index   = 0;
     _q->write_index  = 0;
     _q->num_elements = 0;
+    atomic_store(&_q->num_written, 0);
+    atomic_store(&_q->num_read,    0);
 }
 
 // get the number of elements currently in the buffer
 unsigned int CBUFFER(_size)(CBUFFER() _q)
 {
+    if (_q->spsc) {
+        // derive count from free-running producer/consumer counters
+        unsigned long int w = atomic_load_explicit(&_q->num_written, memory_order_acquire);
+        unsigned long int r = atomic_load_explicit(&_q->num_read,    memory_order_acquire);
+        return (unsigned int)(w - r);
+    }
     return _q->num_elements;
 }
 
@@ -187,13 +231,13 @@ unsigned int CBUFFER(_max_read)(CBUFFER() _q)
 // return number of elements available for writing
 unsigned int CBUFFER(_space_available)(CBUFFER() _q)
 {
-    return _q->max_size - _q->num_elements;
+    return _q->max_size - CBUFFER(_size)(_q);
 }
 
 // is buffer full?
 int CBUFFER(_is_full)(CBUFFER() _q)
 {
-    return (_q->num_elements == _q->max_size ? 1 : 0);
+    return (CBUFFER(_size)(_q) == _q->max_size ? 1 : 0);
 }
 
 // write a single sample into the buffer
@@ -203,7 +247,7 @@ void CBUFFER(_push)(CBUFFER() _q,
                     T         _v)
 {
     // ensure buffer isn't already full
-    if (_q->num_elements == _q->max_size) {
+    if (CBUFFER(_size)(_q) == _q->max_size) {
         fprintf(stderr,"warning: cbuffer%s_push(), no space available\n",
                 EXTENSION);
         return;
@@ -215,8 +259,13 @@ void CBUFFER(_push)(CBUFFER() _q,
     // update write index
     _q->write_index = (_q->write_index+1) % _q->max_size;
 
-    // increment number of elements
-    _q->num_elements++;
+    // increment number of elements; in SPSC mode the release store
+    // publishes the sample written above to the consumer thread
+    if (_q->spsc) {
+        unsigned long int w = atomic_load_explicit(&_q->num_written, memory_order_relaxed);
+        atomic_store_explicit(&_q->num_written, w+1, memory_order_release);
+    } else
+        _q->num_elements++;
 }
 
 // write samples to the buffer
@@ -228,12 +277,11 @@ void CBUFFER(_write)(CBUFFER()    _q,
                      unsigned int _n)
 {
     // ensure number of samples to write doesn't exceed space available
-    if (_n > (_q->max_size - _q->num_elements)) {
+    if (_n > CBUFFER(_space_available)(_q)) {
         printf("warning: cbuffer%s_write(), cannot write more elements than are available\n", EXTENSION);
         return;
     }
 
-    _q->num_elements += _n;
     // space available at end of buffer
     unsigned int k = _q->max_size - _q->write_index;
     //printf("n : %u, k : %u\n", _n, k);
@@ -247,6 +295,68 @@ void CBUFFER(_write)(CBUFFER()    _q,
         memmove(_q->v + _q->write_index, _v, _n*sizeof(T));
         _q->write_index += _n;
     }
+
+    // increment number of elements; in SPSC mode the release store
+    // publishes the samples copied above to the consumer thread
+    if (_q->spsc) {
+        unsigned long int w = atomic_load_explicit(&_q->num_written, memory_order_relaxed);
+        atomic_store_explicit(&_q->num_written, w+_n, memory_order_release);
+    } else
+        _q->num_elements += _n;
+}
+
+// reserve a contiguous writable region inside the buffer for the
+// caller to fill directly (e.g. as a DMA target), avoiding the copy
+// through an intermediate array; samples only become visible to the
+// reader once committed
+//  _q              : circular buffer object
+//  _num_requested  : number of elements requested
+//  _v              : output pointer to writable region
+//  _num_reserved   : number of elements writable through _v
+void CBUFFER(_reserve)(CBUFFER()      _q,
+                       unsigned int   _num_requested,
+                       T **           _v,
+                       unsigned int * _num_reserved)
+{
+    // adjust number requested depending upon space available
+    unsigned int space_available = CBUFFER(_space_available)(_q);
+    if (_num_requested > space_available)
+        _num_requested = space_available;
+
+    // restrict region to run before the write index wraps around
+    unsigned int k = _q->max_size - _q->write_index;
+    if (_num_requested > k)
+        _num_requested = k;
+
+    // set output pointer appropriately
+    *_v            = _q->v + _q->write_index;
+    *_num_reserved = _num_requested;
+}
+
+// commit _n samples previously filled through the pointer returned
+// by reserve(), making them available to the reader
+//  _q : circular buffer object
+//  _n : number of elements to commit
+void CBUFFER(_commit)(CBUFFER()    _q,
+                      unsigned int _n)
+{
+    // ensure commit doesn't exceed the maximum reservable region
+    unsigned int k = _q->max_size - _q->write_index;
+    if (_n > CBUFFER(_space_available)(_q) || _n > k) {
+        printf("error: cbuffer%s_commit(), cannot commit more elements than were reserved\n", EXTENSION);
+        return;
+    }
+
+    // advance write index
+    _q->write_index = (_q->write_index + _n) % _q->max_size;
+
+    // increment number of elements; in SPSC mode the release store
+    // publishes the samples filled by the caller to the consumer thread
+    if (_q->spsc) {
+        unsigned long int w = atomic_load_explicit(&_q->num_written, memory_order_relaxed);
+        atomic_store_explicit(&_q->num_written, w+_n, memory_order_release);
+    } else
+        _q->num_elements += _n;
 }
 
 // remove and return a single element from the buffer
@@ -256,7 +366,7 @@ void CBUFFER(_pop)(CBUFFER()    _q,
                    T *          _v)
 {
     // ensure there is at least one element
-    if (_q->num_elements == 0) {
+    if (CBUFFER(_size)(_q) == 0) {
         fprintf(stderr,"warning: cbuffer%s_pop(), no elements available\n",
                 EXTENSION);
         return;
@@ -269,8 +379,13 @@ void CBUFFER(_pop)(CBUFFER()    _q,
     // increment read index
     _q->read_index = (_q->read_index + 1) % _q->max_size;
 
-    // decrement number of elements in the buffer
-    _q->num_elements--;
+    // decrement number of elements in the buffer; in SPSC mode the
+    // release store returns the slot to the producer thread
+    if (_q->spsc) {
+        unsigned long int r = atomic_load_explicit(&_q->num_read, memory_order_relaxed);
+        atomic_store_explicit(&_q->num_read, r+1, memory_order_release);
+    } else
+        _q->num_elements--;
 }
 
 // read buffer contents
@@ -284,9 +399,10 @@ void CBUFFER(_read)(CBUFFER()      _q,
                     unsigned int * _num_read)
 {
     // adjust number requested depending upon availability
-    if (_num_requested > _q->num_elements)
-        _num_requested = _q->num_elements;
-    
+    unsigned int num_elements = CBUFFER(_size)(_q);
+    if (_num_requested > num_elements)
+        _num_requested = num_elements;
+
     // restrict maximum number of elements to originally specified value
     if (_num_requested > _q->max_read)
         _num_requested = _q->max_read;
@@ -305,13 +421,19 @@ void CBUFFER(_release)(CBUFFER()    _q,
                        unsigned int _n)
 {
     // advance read_index by _n making sure not to step on write_index
-    if (_n > _q->num_elements) {
+    if (_n > CBUFFER(_size)(_q)) {
         printf("error: cbuffer%s_release(), cannot release more elements in buffer than exist\n", EXTENSION);
         return;
     }
 
     _q->read_index = (_q->read_index + _n) % _q->max_size;
-    _q->num_elements -= _n;
+
+    // in SPSC mode the release store returns the slots to the producer
+    if (_q->spsc) {
+        unsigned long int r = atomic_load_explicit(&_q->num_read, memory_order_relaxed);
+        atomic_store_explicit(&_q->num_read, r+_n, memory_order_release);
+    } else
+        _q->num_elements -= _n;
 }
 
 
@@ -30,15 +30,16 @@
 #include <string.h>
 #include <stdlib.h>
 
+// window object structure; the internal buffer is mirrored such that
+// each sample is written to two locations exactly _len_ elements apart.
+// this guarantees a contiguous read pointer is always available without
+// ever copying buffer contents on wrap-around
 struct WINDOW(_s) {
     T * v;                      // allocated array pointer
     unsigned int len;           // length of window
-    unsigned int m;             // floor(log2(len)) + 1
-    unsigned int n;             // 2^m
-    unsigned int mask;          // n-1
     unsigned int num_allocated; // number of elements allocated
-                                // in memory
-    unsigned int read_index;
+                                // in memory (2*len)
+    unsigned int write_index;   // mirrored write position in [0,len)
 };
 
 // create window buffer object of length _n
@@ -55,17 +56,14 @@ WINDOW() WINDOW(_create)(unsigned int _n)
     WINDOW() q = (WINDOW()) malloc(sizeof(struct WINDOW(_s)));
 
     // set internal parameters
-    q->len  = _n;                   // nominal window size
-    q->m    = liquid_msb_index(_n); // effectively floor(log2(len))+1
-    q->n    = 1<<(q->m);            // 2^m
-    q->mask = q->n - 1;             // bit mask
+    q->len = _n;    // nominal window size
 
-    // number of elements to allocate to memory
-    q->num_allocated = q->n + q->len - 1;
+    // number of elements to allocate to memory (mirrored buffer)
+    q->num_allocated = 2*q->len;
 
     // allocte memory
     q->v = (T*) malloc((q->num_allocated)*sizeof(T));
-    q->read_index = 0;
+    q->write_index = q->len - 1;
 
     // reset window
     WINDOW(_reset)(q);
@@ -140,9 +138,9 @@ void WINDOW(_debug_print)(WINDOW() _q)
     printf("window [%u elements] :\n", _q->len);
     unsigned int i;
     for (i=0; i<_q->len; i++) {
-        // print read index pointer
-        if (i==_q->read_index)
-            printf("<r>");
+        // print write index pointer
+        if (i==_q->write_index)
+            printf("<w>");
 
         // print window value
         BUFFER_PRINT_LINE(_q,i)
@@ -150,7 +148,7 @@ void WINDOW(_debug_print)(WINDOW() _q)
     }
     printf("----------------------------------\n");
 
-    // print excess window memory
+    // print mirrored window memory
     for (i=_q->len; i<_q->num_allocated; i++) {
         BUFFER_PRINT_LINE(_q,i)
         printf("\n");
@@ -160,8 +158,8 @@ void WINDOW(_debug_print)(WINDOW() _q)
 // reset window object (initialize to zeros)
 void WINDOW(_reset)(WINDOW() _q)
 {
-    // reset read index
-    _q->read_index = 0;
+    // reset write index
+    _q->write_index = _q->len - 1;
 
     // clear all allocated memory
     memset(_q->v, 0, (_q->num_allocated)*sizeof(T));
@@ -173,7 +171,7 @@ void WINDOW(_reset)(WINDOW() _q)
 void WINDOW(_read)(WINDOW() _q, T ** _v)
 {
     // return pointer to buffer
-    *_v = _q->v + _q->read_index;
+    *_v = _q->v + _q->write_index + 1;
 }
 
 // index single element in buffer at a particular index
@@ -191,7 +189,7 @@ void WINDOW(_index)(WINDOW()     _q,
     }
 
     // return value at index
-    *_v = _q->v[_q->read_index + _i];
+    *_v = _q->v[_q->write_index + 1 + _i];
 }
 
 // push single element onto window buffer
@@ -199,18 +197,14 @@ void WINDOW(_index)(WINDOW()     _q,
 //  _v      : single input element
 void WINDOW(_push)(WINDOW() _q, T _v)
 {
-    // increment index
-    _q->read_index++;
-
-    // wrap around pointer
-    _q->read_index &= _q->mask;
-
-    // if pointer wraps around, copy excess memory
-    if (_q->read_index == 0)
-        memmove(_q->v, _q->v + _q->n, (_q->len-1)*sizeof(T));
-
-    // append value to end of buffer
-    _q->v[_q->read_index + _q->len - 1] = _v;
+    // increment index, wrapping around buffer
+    _q->write_index++;
+    if (_q->write_index == _q->len)
+        _q->write_index = 0;
+
+    // write value to both mirrored locations
+    _q->v[_q->write_index         ] = _v;
+    _q->v[_q->write_index + _q->len] = _v;
 }
 
 // write array of elements onto window buffer
@@ -221,9 +215,26 @@ void WINDOW(_write)(WINDOW()     _q,
                     T *          _v,
                     unsigned int _n)
 {
-    // TODO make this more efficient
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        WINDOW(_push)(_q, _v[i]);
+    unsigned int n = 0;
+    while (n < _n) {
+        // compute run length before the write index wraps around
+        unsigned int k = _q->len - 1 - _q->write_index;
+
+        if (k == 0) {
+            // push single element, wrapping the write index
+            WINDOW(_push)(_q, _v[n++]);
+            continue;
+        }
+
+        // limit run length to number of input values remaining
+        if (k > _n - n)
+            k = _n - n;
+
+        // write run of values to both mirrored locations in bulk
+        memmove(_q->v + _q->write_index + 1,           _v + n, k*sizeof(T));
+        memmove(_q->v + _q->write_index + 1 + _q->len, _v + n, k*sizeof(T));
+        _q->write_index += k;
+        n += k;
+    }
 }
 
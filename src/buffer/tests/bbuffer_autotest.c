@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// write a long random stream in uneven chunks and verify slices
+// (including one spanning the arena wrap-around point) return the
+// correct samples without copying
+void autotest_bbuffercf_slice()
+{
+    unsigned int max_size      = 256;   // arena capacity
+    unsigned int max_slice_len =  64;   // maximum slice length
+    unsigned int num_samples   = 600;   // total samples written
+
+    unsigned int i;
+
+    // create burst buffer
+    bbuffercf q = bbuffercf_create(max_size, max_slice_len);
+    CONTEND_EQUALITY( bbuffercf_get_num_written(q), 0 );
+    CONTEND_EQUALITY( bbuffercf_get_num_slices(q),  0 );
+
+    // generate reference stream and write it in uneven chunks
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    unsigned int n = 0;
+    while (n < num_samples) {
+        unsigned int r = 1 + (rand() % 37);
+        if (r > num_samples - n)
+            r = num_samples - n;
+        bbuffercf_write(q, x+n, r);
+        n += r;
+    }
+    CONTEND_EQUALITY( bbuffercf_get_num_written(q), num_samples );
+
+    // acquire slice on the most recent samples
+    unsigned int s0 = bbuffercf_slice_acquire(q, num_samples-50, 50);
+    CONTEND_EQUALITY( bbuffercf_get_num_slices(q), 1 );
+    CONTEND_EQUALITY( bbuffercf_slice_len(q, s0), 50 );
+    CONTEND_SAME_DATA( bbuffercf_slice_data(q, s0),
+                       x + num_samples - 50,
+                       50*sizeof(float complex) );
+
+    // acquire slice spanning the arena wrap-around point
+    // (600 mod 256 = 88, so indices [490,550) cross the boundary)
+    unsigned int s1 = bbuffercf_slice_acquire(q, 490, 60);
+    CONTEND_EQUALITY( bbuffercf_get_num_slices(q), 2 );
+    CONTEND_SAME_DATA( bbuffercf_slice_data(q, s1),
+                       x + 490,
+                       60*sizeof(float complex) );
+
+    // retain and release: slice stays live until the last reference
+    bbuffercf_slice_retain(q, s0);
+    bbuffercf_slice_release(q, s0);
+    CONTEND_EQUALITY( bbuffercf_get_num_slices(q), 2 );
+    bbuffercf_slice_release(q, s0);
+    CONTEND_EQUALITY( bbuffercf_get_num_slices(q), 1 );
+
+    // slice data remains valid while further samples stream in, as
+    // long as the write does not reach the protected region
+    float complex y[100];
+    for (i=0; i<100; i++)
+        y[i] = randnf() + randnf()*_Complex_I;
+    bbuffercf_write(q, y, 100);
+    CONTEND_SAME_DATA( bbuffercf_slice_data(q, s1),
+                       x + 490,
+                       60*sizeof(float complex) );
+    bbuffercf_slice_release(q, s1);
+    CONTEND_EQUALITY( bbuffercf_get_num_slices(q), 0 );
+
+    // destroy object
+    bbuffercf_destroy(q);
+}
+
+// basic operation on the real-valued type, exercising handle re-use
+// after release and reset
+void autotest_bbufferf_slice()
+{
+    unsigned int i;
+    float v[40];
+    for (i=0; i<40; i++)
+        v[i] = randnf();
+
+    bbufferf q = bbufferf_create(32, 8);
+    bbufferf_write(q, v, 20);
+
+    unsigned int s0 = bbufferf_slice_acquire(q, 12, 8);
+    CONTEND_SAME_DATA( bbufferf_slice_data(q, s0), v+12, 8*sizeof(float) );
+
+    // release and acquire again: descriptor slot is re-used
+    bbufferf_slice_release(q, s0);
+    unsigned int s1 = bbufferf_slice_acquire(q, 4, 6);
+    CONTEND_EQUALITY( s0, s1 );
+    CONTEND_SAME_DATA( bbufferf_slice_data(q, s1), v+4, 6*sizeof(float) );
+    bbufferf_slice_release(q, s1);
+
+    // reset clears sample counter and all slices
+    bbufferf_reset(q);
+    CONTEND_EQUALITY( bbufferf_get_num_written(q), 0 );
+    CONTEND_EQUALITY( bbufferf_get_num_slices(q),  0 );
+
+    bbufferf_destroy(q);
+}
@@ -292,3 +292,166 @@ void autotest_cbufferf_flow()
 }
 
 
+
+// test lock-free single-producer/single-consumer mode; the SPSC buffer
+// must behave identically to the regular circular buffer when driven
+// from a single thread
+void autotest_cbufferf_spsc()
+{
+    // options
+    unsigned int max_size     =   48; // minimum number of elements in buffer
+    unsigned int num_elements = 1200; // total number of elements for run
+
+    // flag to indicate if test was successful
+    int success = 1;
+
+    // create new circular buffer in SPSC mode
+    cbufferf q = cbufferf_create_spsc(max_size);
+
+    // requested size is rounded up to the next power of two
+    CONTEND_EQUALITY( cbufferf_max_size(q), 64 );
+    CONTEND_EQUALITY( cbufferf_size(q),      0 );
+
+    // temporary buffer to write samples before sending to cbuffer
+    float write_buffer[cbufferf_max_size(q)];
+
+    //
+    unsigned i;
+    unsigned write_id = 0;  // running total number of values written
+    unsigned read_id  = 0;  // running total number of values read
+
+    // continue running until
+    while (1) {
+        // write some values
+        unsigned int num_available_to_write = cbufferf_space_available(q);
+
+        // write samples if space is available
+        if (num_available_to_write > 0) {
+            // number of elements to write
+            unsigned int num_to_write = (rand() % num_available_to_write) + 1;
+
+            // generate samples to write
+            for (i=0; i<num_to_write; i++) {
+                write_buffer[i] = (float)(write_id);
+                write_id++;
+            }
+
+            // write samples
+            cbufferf_write(q, write_buffer, num_to_write);
+        }
+
+        // read some values
+        unsigned int num_available_to_read = cbufferf_size(q);
+
+        // read samples if available
+        if (num_available_to_read > 0) {
+            // number of elements to read
+            unsigned int num_to_read = rand() % num_available_to_read;
+
+            // read samples
+            float *r;               // output read pointer
+            unsigned int num_read;  // number of samples read
+            cbufferf_read(q, num_to_read, &r, &num_read);
+
+            // compare results
+            for (i=0; i<num_read; i++) {
+                if (liquid_autotest_verbose)
+                    printf(" %s read %12.0f, expected %12u\n", r[i] == (float)read_id ? " " : "*", r[i], read_id);
+
+                if (r[i] != (float)read_id)
+                    success = 0;
+                read_id++;
+            }
+
+            // release all the samples that were read
+            cbufferf_release(q, num_read);
+        }
+
+        // stop on fail or upon completion
+        if (!success || read_id >= num_elements)
+            break;
+    }
+
+    // ensure test was successful
+    CONTEND_EXPRESSION(success == 1);
+
+    // destroy object
+    cbufferf_destroy(q);
+}
+
+// test zero-copy reserve/commit producer interface against the
+// copying write() path
+void autotest_cbufferf_reserve()
+{
+    // options
+    unsigned int max_size     =   48; // maximum number of elements in buffer
+    unsigned int num_elements = 1200; // total number of elements for run
+
+    // flag to indicate if test was successful
+    int success = 1;
+
+    // create new circular buffer
+    cbufferf q = cbufferf_create(max_size);
+
+    //
+    unsigned i;
+    unsigned write_id = 0;  // running total number of values written
+    unsigned read_id  = 0;  // running total number of values read
+
+    // continue running until
+    while (1) {
+        // reserve a writable region and fill it in place
+        float *w;                   // writable region pointer
+        unsigned int num_reserved;  // size of writable region
+        unsigned int num_requested = (rand() % max_size) + 1;
+        cbufferf_reserve(q, num_requested, &w, &num_reserved);
+
+        // region cannot exceed request
+        if (num_reserved > num_requested)
+            success = 0;
+
+        // fill region directly and commit
+        for (i=0; i<num_reserved; i++) {
+            w[i] = (float)(write_id);
+            write_id++;
+        }
+        cbufferf_commit(q, num_reserved);
+
+        // read some values
+        unsigned int num_available_to_read = cbufferf_size(q);
+
+        // read samples if available
+        if (num_available_to_read > 0) {
+            // number of elements to read
+            unsigned int num_to_read = rand() % num_available_to_read;
+
+            // read samples
+            float *r;               // output read pointer
+            unsigned int num_read;  // number of samples read
+            cbufferf_read(q, num_to_read, &r, &num_read);
+
+            // compare results
+            for (i=0; i<num_read; i++) {
+                if (liquid_autotest_verbose)
+                    printf(" %s read %12.0f, expected %12u\n", r[i] == (float)read_id ? " " : "*", r[i], read_id);
+
+                if (r[i] != (float)read_id)
+                    success = 0;
+                read_id++;
+            }
+
+            // release all the samples that were read
+            cbufferf_release(q, num_read);
+        }
+
+        // stop on fail or upon completion
+        if (!success || read_id >= num_elements)
+            break;
+    }
+
+    // ensure test was successful
+    CONTEND_EXPRESSION(success == 1);
+
+    // destroy object
+    cbufferf_destroy(q);
+}
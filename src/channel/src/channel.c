@@ -271,7 +271,11 @@ void CHANNEL(_execute)(CHANNEL() _q,
     *_y = r;
 }
 
-// apply channel impairments on single input sample
+// internal chunk size for fused block processing; small enough for the
+// working set to stay cache-resident
+#define CHANNEL_BLOCK_LEN (64)
+
+// apply channel impairments on block of input samples
 //  _q      : channel object
 //  _x      : input array [size: _n x 1]
 //  _n      : input array length
@@ -281,10 +285,47 @@ void CHANNEL(_execute_block)(CHANNEL()    _q,
                              unsigned int _n,
                              TO *         _y)
 {
-    // apply channel effects on each input sample
-    // TODO: apply in blocks
+    // apply each enabled impairment across a cache-resident chunk
+    // before moving to the next, so the buffer is walked once per
+    // stage rather than once per sample
+    TO noise[CHANNEL_BLOCK_LEN];
     unsigned int i;
-    for (i=0; i<_n; i++)
-        CHANNEL(_execute)(_q, _x[i], &_y[i]);
+    unsigned int n = 0;
+    while (n < _n) {
+        unsigned int m = (_n - n) < CHANNEL_BLOCK_LEN ? (_n - n) : CHANNEL_BLOCK_LEN;
+
+        // apply multi-path filter
+        if (_q->enabled_multipath)
+            FIRFILT(_execute_block)(_q->channel_filter, _x+n, m, _y+n);
+        else
+            memmove(_y+n, _x+n, m*sizeof(TO));
+
+        // apply shadowing if enabled; the gain recursion carries state
+        // sample to sample so it cannot be re-ordered within the chunk
+        if (_q->enabled_shadowing) {
+            for (i=0; i<m; i++) {
+                float g = 0;
+                IIRFILT(_execute)(_q->shadowing_filter, randnf()*_q->shadowing_std, &g);
+                g /= _q->shadowing_fd * 6.9f;
+                g = powf(10.0f, g/20.0f);
+                _y[n+i] *= g;
+            }
+        }
+
+        // apply carrier if enabled, mixing the chunk with the
+        // vectorized block rotator
+        if (_q->enabled_carrier)
+            NCO(_mix_block_up)(_q->nco, _y+n, _y+n, m);
+
+        // apply AWGN if enabled, drawing the noise for the whole chunk
+        // from the batch Gauss generator
+        if (_q->enabled_awgn) {
+            crandnf_block(noise, m);
+            for (i=0; i<m; i++)
+                _y[n+i] = _q->gamma*_y[n+i] + _q->nstd*noise[i]*M_SQRT1_2;
+        }
+
+        n += m;
+    }
 }
 
@@ -144,6 +144,10 @@ void TVMPCH(_execute)(TVMPCH() _q,
     DOTPROD(_run4)(r, _q->h, _q->h_len, _y);
 }
 
+// internal chunk size for block processing; bounds the stack space
+// needed for the tap trajectory buffers
+#define TVMPCH_BLOCK_LEN (64)
+
 // execute the filter on a block of input samples; the
 // input and output buffers may be the same
 //  _q      : filter object
@@ -155,13 +159,56 @@ void TVMPCH(_execute_block)(TVMPCH()     _q,
                             unsigned int _n,
                             TO *         _y)
 {
+    unsigned int p = _q->h_len - 1; // number of time-varying taps
+
+    // single-tap channel never varies; run scalar path directly
+    if (p == 0) {
+        unsigned int i;
+        for (i=0; i<_n; i++) {
+            TVMPCH(_push)(_q, _x[i]);
+            TVMPCH(_execute)(_q, &_y[i]);
+        }
+        return;
+    }
+
+    // process in chunks: draw all Gauss innovations for the chunk in
+    // one batch, synthesize the tap trajectories one tap at a time
+    // (the recursion is serial in time but independent across taps),
+    // then run the convolution against the precomputed trajectories
     unsigned int i;
-    for (i=0; i<_n; i++) {
-        // push sample into filter
-        TVMPCH(_push)(_q, _x[i]);
+    unsigned int k;
+    unsigned int n = 0;
+    while (n < _n) {
+        unsigned int m = (_n - n) < TVMPCH_BLOCK_LEN ? (_n - n) : TVMPCH_BLOCK_LEN;
+
+        // batch-generate innovations, one per tap per sample
+        TC v[m*p];
+        crandnf_block(v, m*p);
+
+        // synthesize tap trajectories, storing sample-major for the
+        // convolution below; the direct-path tap is static
+        TC htraj[m*_q->h_len];
+        float g = _q->beta * _q->std * M_SQRT1_2;
+        for (k=0; k<p; k++) {
+            TC hk = _q->h[k];
+            for (i=0; i<m; i++) {
+                hk = _q->alpha*hk + g*v[k*m+i];
+                htraj[i*_q->h_len + k] = hk;
+            }
+            _q->h[k] = hk;
+        }
+        for (i=0; i<m; i++)
+            htraj[i*_q->h_len + p] = _q->h[p];
+
+        // run convolution against the trajectory for each sample
+        for (i=0; i<m; i++) {
+            WINDOW(_push)(_q->w, _x[n+i]);
+            TI * r;
+            WINDOW(_read)(_q->w, &r);
+            DOTPROD(_run4)(r, &htraj[i*_q->h_len], _q->h_len, &_y[n+i]);
+        }
 
-        // compute output sample
-        TVMPCH(_execute)(_q, &_y[i]);
+        n += m;
     }
 }
 
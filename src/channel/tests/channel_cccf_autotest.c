@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: block execution matches per-sample execution for the
+// deterministic impairments (carrier offset and multi-path)
+//
+void autotest_channel_cccf_block()
+{
+    float        tol = 1e-2f;   // error tolerance (phase rotator drift)
+    unsigned int n   = 200;     // number of samples
+
+    // multi-path coefficients
+    float complex h[4] = {1.0f, 0.1f-0.2f*_Complex_I, -0.1f+0.05f*_Complex_I, 0.04f};
+
+    // create two channel objects with identical configurations
+    channel_cccf q0 = channel_cccf_create();
+    channel_cccf q1 = channel_cccf_create();
+    channel_cccf_add_carrier_offset(q0, 0.1f, 1.2f);
+    channel_cccf_add_carrier_offset(q1, 0.1f, 1.2f);
+    channel_cccf_add_multipath(q0, h, 4);
+    channel_cccf_add_multipath(q1, h, 4);
+
+    // generate input signal
+    unsigned int i;
+    float complex x [n];
+    float complex y0[n];
+    float complex y1[n];
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*(0.03f*i + 0.6f*i*i/(float)n));
+
+    // run one object sample by sample...
+    for (i=0; i<n; i++)
+        channel_cccf_execute(q0, x[i], &y0[i]);
+
+    // ...and the other in uneven blocks
+    channel_cccf_execute_block(q1, x,     17,  y1    );
+    channel_cccf_execute_block(q1, x+17,  100, y1+17 );
+    channel_cccf_execute_block(q1, x+117, n-117, y1+117);
+
+    // outputs match
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects
+    channel_cccf_destroy(q0);
+    channel_cccf_destroy(q1);
+}
+
+//
+// AUTOTEST: block AWGN impairment statistics
+//
+void autotest_channel_cccf_block_awgn()
+{
+    unsigned int n              = 100000;   // number of samples
+    float        noise_floor_dB = -20.0f;   // noise floor
+    float        SNRdB          = 10.0f;    // signal-to-noise ratio
+
+    // create channel object with AWGN only
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_awgn(q, noise_floor_dB, SNRdB);
+
+    // seed block generator for reproducible statistics
+    randnf_block_seed(1234);
+
+    // run zeros through the channel; the output is pure noise
+    unsigned int i;
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = 0.0f;
+    channel_cccf_execute_block(q, x, n, y);
+
+    // estimate noise power
+    float p = 0.0f;
+    for (i=0; i<n; i++)
+        p += crealf( y[i]*conjf(y[i]) );
+    float noise_dB = 10.0f*log10f(p/(float)n);
+
+    if (liquid_autotest_verbose)
+        printf("channel_cccf_block_awgn: noise floor = %12.8f dB (expected %12.8f dB)\n",
+                noise_dB, noise_floor_dB);
+
+    CONTEND_DELTA( noise_dB, noise_floor_dB, 0.1f );
+
+    // destroy object
+    channel_cccf_destroy(q);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: with zero tap deviation the channel is an identity and the
+// block path matches the scalar path exactly
+//
+void autotest_tvmpch_cccf_static()
+{
+    float        tol = 1e-6f;   // error tolerance
+    unsigned int n   = 100;     // number of samples
+
+    tvmpch_cccf q = tvmpch_cccf_create(8, 0.0f, 0.2f);
+
+    // generate input signal
+    unsigned int i;
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*(0.211f*i + 0.017f*i*i));
+
+    // run block execution; only the static direct path contributes
+    tvmpch_cccf_execute_block(q, x, n, y);
+
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y[i]), crealf(x[i]), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(x[i]), tol );
+    }
+
+    tvmpch_cccf_destroy(q);
+}
+
+//
+// AUTOTEST: block execution output energy matches theory
+//
+void autotest_tvmpch_cccf_block_energy()
+{
+    unsigned int h_len = 8;         // channel length
+    float        std   = 0.1f;      // tap standard deviation
+    float        tau   = 0.2f;      // coherence time
+    unsigned int n     = 50000;     // number of samples
+
+    tvmpch_cccf q = tvmpch_cccf_create(h_len, std, tau);
+
+    // seed block generator for reproducible statistics
+    randnf_block_seed(1234);
+
+    // run constant-modulus input through the channel
+    unsigned int i;
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*(1.117f*i + 0.023f*i*i));
+    tvmpch_cccf_execute_block(q, x, n, y);
+
+    // measure output energy and compare to theory: the unit direct
+    // path plus (h_len-1) independent taps, each with stationary
+    // variance 4 std^2 / (2-tau)
+    float p = 0.0f;
+    for (i=0; i<n; i++)
+        p += crealf( y[i]*conjf(y[i]) );
+    p /= (float) n;
+    float p_expected = 1.0f + (float)(h_len-1)*4.0f*std*std/(2.0f-tau);
+
+    if (liquid_autotest_verbose)
+        printf("tvmpch_cccf_block_energy: energy = %12.8f (expected %12.8f)\n", p, p_expected);
+
+    CONTEND_DELTA( p, p_expected, 0.05f*p_expected );
+
+    tvmpch_cccf_destroy(q);
+}
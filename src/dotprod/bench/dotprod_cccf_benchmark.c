@@ -22,6 +22,7 @@
 
 #include <sys/resource.h>
 #include "liquid.h"
+#include "bench/liquid_benchmark.h"
 
 // Helper function to keep code base small
 void dotprod_cccf_bench(struct rusage *_start,
@@ -61,6 +62,11 @@ void dotprod_cccf_bench(struct rusage *_start,
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 8;
 
+    // roofline workload annotation (per execute): read complex x and h,
+    // write y; four real multiplies and four adds per coefficient
+    liquid_benchmark_workload.bytes_per_trial = 2*_n*sizeof(float complex) + sizeof(float complex);
+    liquid_benchmark_workload.flops_per_trial = 8.0f * _n;
+
     // clean up objects
     dotprod_cccf_destroy(dp);
 }
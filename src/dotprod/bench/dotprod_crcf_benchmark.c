@@ -22,6 +22,7 @@
 
 #include <sys/resource.h>
 #include "liquid.h"
+#include "bench/liquid_benchmark.h"
 
 // Helper function to keep code base small
 void dotprod_crcf_bench(struct rusage *_start,
@@ -61,6 +62,11 @@ void dotprod_crcf_bench(struct rusage *_start,
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 8;
 
+    // roofline workload annotation (per execute): read complex x and
+    // real h, write y; two real multiply-adds per coefficient
+    liquid_benchmark_workload.bytes_per_trial = _n*sizeof(float complex) + _n*sizeof(float) + sizeof(float complex);
+    liquid_benchmark_workload.flops_per_trial = 4.0f * _n;
+
     // clean up objects
     dotprod_crcf_destroy(dp);
 }
@@ -22,6 +22,7 @@
 
 #include <sys/resource.h>
 #include "liquid.h"
+#include "bench/liquid_benchmark.h"
 
 // Helper function to keep code base small
 void dotprod_rrrf_bench(struct rusage *_start,
@@ -55,6 +56,11 @@ void dotprod_rrrf_bench(struct rusage *_start,
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
 
+    // roofline workload annotation (per execute): read x and h, write y;
+    // one multiply and one add per coefficient
+    liquid_benchmark_workload.bytes_per_trial = (2*_n + 1)*sizeof(float);
+    liquid_benchmark_workload.flops_per_trial = 2.0f * _n;
+
     // clean up objects
     dotprod_rrrf_destroy(dp);
 }
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// cpufeatures.c : run-time CPU feature detection (x86)
+//
+// The feature set is probed once (on the first dotprod create call) and
+// cached, so the cost of the cpuid instructions is not paid on the fast
+// path.  The probe checks both the cpuid feature flags and, for the AVX
+// family, that the operating system has enabled saving the extended
+// register state (xgetbv).
+//
+
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#if defined(__i386__) || defined(__x86_64__)
+
+// raw cpuid instruction wrapper
+static void liquid_cpuid(unsigned int   _leaf,
+                         unsigned int   _subleaf,
+                         unsigned int * _eax,
+                         unsigned int * _ebx,
+                         unsigned int * _ecx,
+                         unsigned int * _edx)
+{
+    __asm__ __volatile__("cpuid"
+        : "=a" (*_eax), "=b" (*_ebx), "=c" (*_ecx), "=d" (*_edx)
+        : "a" (_leaf), "c" (_subleaf));
+}
+
+// read extended control register (OS support for AVX state saving)
+static unsigned long long liquid_xgetbv(void)
+{
+    unsigned int eax, edx;
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" // xgetbv
+        : "=a" (eax), "=d" (edx)
+        : "c" (0));
+    return ((unsigned long long)edx << 32) | eax;
+}
+
+// probe cpuid feature flags
+static int liquid_cpu_features_probe(void)
+{
+    int features = 0;
+    unsigned int eax, ebx, ecx, edx;
+
+    // standard feature flags (leaf 1)
+    liquid_cpuid(1, 0, &eax, &ebx, &ecx, &edx);
+    if ( edx & (1u<<26) ) features |= LIQUID_CPU_X86_SSE2;
+    if ( ecx & (1u<< 0) ) features |= LIQUID_CPU_X86_SSE3;
+    if ( ecx & (1u<<19) ) features |= LIQUID_CPU_X86_SSE41;
+
+    // AVX family additionally requires OS support for saving the
+    // extended register state (xsave/xgetbv)
+    int os_avx = 0;
+    if ( (ecx & (1u<<27)) && (ecx & (1u<<28)) )
+        os_avx = (liquid_xgetbv() & 0x06) == 0x06;              // xmm|ymm
+    if (os_avx) {
+        features |= LIQUID_CPU_X86_AVX;
+        if ( ecx & (1u<<12) ) features |= LIQUID_CPU_X86_FMA;
+
+        // extended feature flags (leaf 7)
+        liquid_cpuid(7, 0, &eax, &ebx, &ecx, &edx);
+        if ( ebx & (1u<< 5) ) features |= LIQUID_CPU_X86_AVX2;
+        if ( (ebx & (1u<<16)) && (liquid_xgetbv() & 0xe0) == 0xe0 )
+            features |= LIQUID_CPU_X86_AVX512F;                 // + opmask|zmm
+    }
+
+    return features;
+}
+
+#else
+
+// non-x86 platform: no features to report
+static int liquid_cpu_features_probe(void)
+{
+    return 0;
+}
+
+#endif
+
+// return cached CPU feature set, probing on first invocation
+int liquid_cpu_features(void)
+{
+    static int features = -1;
+    if (features < 0)
+        features = liquid_cpu_features_probe();
+    return features;
+}
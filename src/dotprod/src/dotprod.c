@@ -166,3 +166,51 @@ void DOTPROD(_execute)(DOTPROD() _q,
     DOTPROD(_run4)(_q->h, _x, _q->n, _y);
 }
 
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void DOTPROD(_execute_batch)(DOTPROD() *  _q,
+                             unsigned int _batch,
+                             TI *         _x,
+                             TO *         _y)
+{
+#if DOTPROD_BACKEND_CCCF
+    // route large batches through the registered external backend
+    // (if any); the backend may decline by returning non-zero
+    if (liquid_internal_backend.dotprod_cccf_execute_batch != NULL &&
+        _batch > 0 &&
+        _q[0]->n * _batch >= liquid_internal_backend.dotprod_threshold)
+    {
+        if (liquid_internal_backend.dotprod_cccf_execute_batch(
+                liquid_internal_backend.context, _q, _batch, _x, _y) == 0)
+            return;
+    }
+#endif
+
+    // run each dot product in turn; the input array stays resident in
+    // cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        DOTPROD(_execute)(_q[i], _x, &_y[i]);
+}
+
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void DOTPROD(_execute_pair)(DOTPROD() _q0,
+                            DOTPROD() _q1,
+                            TI *      _x,
+                            TO *      _y0,
+                            TO *      _y1)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across calls
+    DOTPROD(_execute)(_q0, _x, _y0);
+    DOTPROD(_execute)(_q1, _x, _y1);
+}
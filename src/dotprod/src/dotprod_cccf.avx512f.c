@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Floating-point dot product (AVX-512)
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#include <immintrin.h>  // AVX-512
+
+#define DEBUG_DOTPROD_CCCF_AVX512F  0
+
+// internal methods
+void dotprod_cccf_execute_avx512f(dotprod_cccf    _q,
+                                  float complex * _x,
+                                  float complex * _y);
+void dotprod_cccf_execute_avx512f4(dotprod_cccf    _q,
+                                   float complex * _x,
+                                   float complex * _y);
+
+// basic dot product (ordinal calculation)
+void dotprod_cccf_run(float complex * _h,
+                      float complex * _x,
+                      unsigned int    _n,
+                      float complex * _y)
+{
+    float complex r = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += _h[i] * _x[i];
+    *_y = r;
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_cccf_run4(float complex * _h,
+                       float complex * _x,
+                       unsigned int    _n,
+                       float complex * _y)
+{
+    float complex r = 0;
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        r += _h[i]   * _x[i];
+        r += _h[i+1] * _x[i+1];
+        r += _h[i+2] * _x[i+2];
+        r += _h[i+3] * _x[i+3];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        r += _h[i] * _x[i];
+
+    *_y = r;
+}
+
+
+//
+// structured AVX-512 dot product
+//
+
+struct dotprod_cccf_s {
+    unsigned int n;     // length
+    float * hi;         // in-phase
+    float * hq;         // quadrature
+};
+
+dotprod_cccf dotprod_cccf_create(float complex * _h,
+                                 unsigned int    _n)
+{
+    dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
+    q->n = _n;
+
+    // allocate memory for coefficients, 64-byte aligned
+    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
+    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
+
+    // set coefficients, repeated
+    //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
+    //  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
+    unsigned int i;
+    for (i=0; i<q->n; i++) {
+        q->hi[2*i+0] = crealf(_h[i]);
+        q->hi[2*i+1] = crealf(_h[i]);
+
+        q->hq[2*i+0] = cimagf(_h[i]);
+        q->hq[2*i+1] = cimagf(_h[i]);
+    }
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_cccf dotprod_cccf_recreate(dotprod_cccf    _q,
+                                   float complex * _h,
+                                   unsigned int    _n)
+{
+    // completely destroy and re-create dotprod object
+    dotprod_cccf_destroy(_q);
+    return dotprod_cccf_create(_h,_n);
+}
+
+
+void dotprod_cccf_destroy(dotprod_cccf _q)
+{
+    _mm_free(_q->hi);
+    _mm_free(_q->hq);
+    free(_q);
+}
+
+void dotprod_cccf_print(dotprod_cccf _q)
+{
+    printf("dotprod_cccf [avx512f, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("  %3u : %12.9f +j%12.9f\n", i, _q->hi[i], _q->hq[i]);
+}
+
+// execute structured dot product
+//  _q      :   dotprod object
+//  _x      :   input array
+//  _y      :   output sample
+void dotprod_cccf_execute(dotprod_cccf    _q,
+                          float complex * _x,
+                          float complex * _y)
+{
+    // switch based on size
+    if (_q->n < 128) {
+        dotprod_cccf_execute_avx512f(_q, _x, _y);
+    } else {
+        dotprod_cccf_execute_avx512f4(_q, _x, _y);
+    }
+}
+
+// use AVX-512 extensions with masked tail handling
+//
+// (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
+//
+// mm_x  = { x[0].real, x[0].imag, x[1].real, x[1].imag, ... }
+// mm_hi = { h[0].real, h[0].real, h[1].real, h[1].real, ... }
+// mm_hq = { h[0].imag, h[0].imag, h[1].imag, h[1].imag, ... }
+//
+// sumi += mm_x * mm_hi
+// sumq += swap(mm_x) * mm_hq
+//
+// even lanes: sumi - sumq, odd lanes: sumi + sumq
+//
+void dotprod_cccf_execute_avx512f(dotprod_cccf    _q,
+                                  float complex * _x,
+                                  float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    // temporary buffers
+    __m512 v;   // input vector
+    __m512 hi;  // coefficients vector (real)
+    __m512 hq;  // coefficients vector (imag)
+
+    // load zeros into sum registers
+    __m512 sumi = _mm512_setzero_ps();
+    __m512 sumq = _mm512_setzero_ps();
+
+    // t = 16*(floor(_n/16))
+    unsigned int t = (n >> 4) << 4;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        // load inputs into register (unaligned)
+        v = _mm512_loadu_ps(&x[i]);
+
+        // load coefficients into registers (aligned)
+        hi = _mm512_load_ps(&_q->hi[i]);
+        hq = _mm512_load_ps(&_q->hq[i]);
+
+        // multiply and accumulate in-phase terms
+        sumi = _mm512_fmadd_ps(v, hi, sumi);
+
+        // swap real/imaginary pairs and accumulate quadrature terms
+        v = _mm512_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm512_fmadd_ps(v, hq, sumq);
+    }
+
+    // handle remaining samples with a masked load rather than a
+    // scalar cleanup loop (n is always even so real/imaginary pairs
+    // remain intact)
+    if (i < n) {
+        __mmask16 mask = (__mmask16)((1U << (n - i)) - 1);
+        v  = _mm512_maskz_loadu_ps(mask, &x[i]);
+        hi = _mm512_maskz_load_ps (mask, &_q->hi[i]);
+        hq = _mm512_maskz_load_ps (mask, &_q->hq[i]);
+        sumi = _mm512_fmadd_ps(v, hi, sumi);
+        v = _mm512_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm512_fmadd_ps(v, hq, sumq);
+    }
+
+    // negate quadrature terms in even lanes and accumulate:
+    // even lanes: sumi - sumq, odd lanes: sumi + sumq
+    __m512 mneg = _mm512_set_ps( 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f,
+                                 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f);
+    __m512 sum = _mm512_fmadd_ps(sumq, mneg, sumi);
+
+    // aligned output array
+    float w[16] __attribute__((aligned(64)));
+
+    // unload packed array
+    _mm512_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    float complex total =
+        (w[0] + w[2] + w[ 4] + w[ 6] + w[ 8] + w[10] + w[12] + w[14]) +
+        (w[1] + w[3] + w[ 5] + w[ 7] + w[ 9] + w[11] + w[13] + w[15]) * _Complex_I;
+
+    // set return value
+    *_y = total;
+}
+
+// use AVX-512 extensions, unrolled loop
+void dotprod_cccf_execute_avx512f4(dotprod_cccf    _q,
+                                   float complex * _x,
+                                   float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    // temporary buffers
+    __m512 v0,  v1;     // input vectors
+    __m512 hi0, hi1;    // coefficients vectors (real)
+    __m512 hq0, hq1;    // coefficients vectors (imag)
+
+    // load zeros into sum registers
+    __m512 sumi0 = _mm512_setzero_ps();
+    __m512 sumi1 = _mm512_setzero_ps();
+    __m512 sumq0 = _mm512_setzero_ps();
+    __m512 sumq1 = _mm512_setzero_ps();
+
+    // t = 32*(floor(_n/32))
+    unsigned int t = (n >> 5) << 5;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=32) {
+        // load inputs into registers (unaligned)
+        v0 = _mm512_loadu_ps(&x[i   ]);
+        v1 = _mm512_loadu_ps(&x[i+16]);
+
+        // load coefficients into registers (aligned)
+        hi0 = _mm512_load_ps(&_q->hi[i   ]);
+        hi1 = _mm512_load_ps(&_q->hi[i+16]);
+        hq0 = _mm512_load_ps(&_q->hq[i   ]);
+        hq1 = _mm512_load_ps(&_q->hq[i+16]);
+
+        // multiply and accumulate in-phase terms
+        sumi0 = _mm512_fmadd_ps(v0, hi0, sumi0);
+        sumi1 = _mm512_fmadd_ps(v1, hi1, sumi1);
+
+        // swap real/imaginary pairs and accumulate quadrature terms
+        v0 = _mm512_permute_ps(v0, _MM_SHUFFLE(2,3,0,1));
+        v1 = _mm512_permute_ps(v1, _MM_SHUFFLE(2,3,0,1));
+        sumq0 = _mm512_fmadd_ps(v0, hq0, sumq0);
+        sumq1 = _mm512_fmadd_ps(v1, hq1, sumq1);
+    }
+
+    // continue in single-register strides
+    for (; i+16 <= n; i+=16) {
+        v0  = _mm512_loadu_ps(&x[i]);
+        hi0 = _mm512_load_ps(&_q->hi[i]);
+        hq0 = _mm512_load_ps(&_q->hq[i]);
+        sumi0 = _mm512_fmadd_ps(v0, hi0, sumi0);
+        v0 = _mm512_permute_ps(v0, _MM_SHUFFLE(2,3,0,1));
+        sumq0 = _mm512_fmadd_ps(v0, hq0, sumq0);
+    }
+
+    // handle remaining samples with a masked load
+    if (i < n) {
+        __mmask16 mask = (__mmask16)((1U << (n - i)) - 1);
+        v0  = _mm512_maskz_loadu_ps(mask, &x[i]);
+        hi0 = _mm512_maskz_load_ps (mask, &_q->hi[i]);
+        hq0 = _mm512_maskz_load_ps (mask, &_q->hq[i]);
+        sumi0 = _mm512_fmadd_ps(v0, hi0, sumi0);
+        v0 = _mm512_permute_ps(v0, _MM_SHUFFLE(2,3,0,1));
+        sumq0 = _mm512_fmadd_ps(v0, hq0, sumq0);
+    }
+
+    // fold down into single registers
+    sumi0 = _mm512_add_ps( sumi0, sumi1 );
+    sumq0 = _mm512_add_ps( sumq0, sumq1 );
+
+    // negate quadrature terms in even lanes and accumulate:
+    // even lanes: sumi - sumq, odd lanes: sumi + sumq
+    __m512 mneg = _mm512_set_ps( 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f,
+                                 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f);
+    __m512 sum = _mm512_fmadd_ps(sumq0, mneg, sumi0);
+
+    // aligned output array
+    float w[16] __attribute__((aligned(64)));
+
+    // unload packed array
+    _mm512_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    float complex total =
+        (w[0] + w[2] + w[ 4] + w[ 6] + w[ 8] + w[10] + w[12] + w[14]) +
+        (w[1] + w[3] + w[ 5] + w[ 7] + w[ 9] + w[11] + w[13] + w[15]) * _Complex_I;
+
+    // set return value
+    *_y = total;
+}
+
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void dotprod_cccf_execute_batch(dotprod_cccf *  _q,
+                                unsigned int    _batch,
+                                float complex * _x,
+                                float complex * _y)
+{
+    // route large batches through the registered external backend
+    // (if any); the backend may decline by returning non-zero
+    if (liquid_internal_backend.dotprod_cccf_execute_batch != NULL &&
+        _batch > 0 &&
+        _q[0]->n * _batch >= liquid_internal_backend.dotprod_threshold)
+    {
+        if (liquid_internal_backend.dotprod_cccf_execute_batch(
+                liquid_internal_backend.context, _q, _batch, _x, _y) == 0)
+            return;
+    }
+
+    // run each dot product in turn; the input array stays resident in
+    // cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_cccf_execute(_q[i], _x, &_y[i]);
+}
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void dotprod_cccf_execute_pair(dotprod_cccf    _q0,
+                                dotprod_cccf    _q1,
+                                float complex * _x,
+                                float complex * _y0,
+                                float complex * _y1)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across calls
+    dotprod_cccf_execute(_q0, _x, _y0);
+    dotprod_cccf_execute(_q1, _x, _y1);
+}
@@ -32,4 +32,7 @@
 #define TC              float complex
 #define TI              float complex
 
+// enable external backend routing for batched execution
+#define DOTPROD_BACKEND_CCCF 1
+
 #include "dotprod.c"
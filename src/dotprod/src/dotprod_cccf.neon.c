@@ -340,3 +340,49 @@ void dotprod_cccf_execute_neon4(dotprod_cccf    _q,
     *_y = total;
 }
 
+
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void dotprod_cccf_execute_batch(dotprod_cccf *  _q,
+                                unsigned int    _batch,
+                                float complex * _x,
+                                float complex * _y)
+{
+    // route large batches through the registered external backend
+    // (if any); the backend may decline by returning non-zero
+    if (liquid_internal_backend.dotprod_cccf_execute_batch != NULL &&
+        _batch > 0 &&
+        _q[0]->n * _batch >= liquid_internal_backend.dotprod_threshold)
+    {
+        if (liquid_internal_backend.dotprod_cccf_execute_batch(
+                liquid_internal_backend.context, _q, _batch, _x, _y) == 0)
+            return;
+    }
+
+    // run each dot product in turn; the input array stays resident in
+    // cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_cccf_execute(_q[i], _x, &_y[i]);
+}
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void dotprod_cccf_execute_pair(dotprod_cccf    _q0,
+                                dotprod_cccf    _q1,
+                                float complex * _x,
+                                float complex * _y0,
+                                float complex * _y1)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across calls
+    dotprod_cccf_execute(_q0, _x, _y0);
+    dotprod_cccf_execute(_q1, _x, _y1);
+}
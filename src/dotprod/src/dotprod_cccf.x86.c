@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Floating-point dot product (x86, run-time dispatch)
+//
+// This translation unit is compiled without architecture-specific flags;
+// each kernel carries a gcc target attribute and the appropriate variant
+// is selected at create time from the executing CPU's feature set, so a
+// single binary runs optimally from SSE2 through AVX-512.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+#define DEBUG_DOTPROD_CCCF_X86   0
+
+// forward declaration of internal kernels
+static void dotprod_cccf_execute_sse2   (dotprod_cccf _q, float complex * _x, float complex * _y);
+static void dotprod_cccf_execute_avx2   (dotprod_cccf _q, float complex * _x, float complex * _y);
+static void dotprod_cccf_execute_avx512f(dotprod_cccf _q, float complex * _x, float complex * _y);
+
+// basic dot product (ordinal calculation)
+void dotprod_cccf_run(float complex * _h,
+                      float complex * _x,
+                      unsigned int    _n,
+                      float complex * _y)
+{
+    float complex r = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += _h[i] * _x[i];
+    *_y = r;
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_cccf_run4(float complex * _h,
+                       float complex * _x,
+                       unsigned int    _n,
+                       float complex * _y)
+{
+    float complex r = 0;
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        r += _h[i]   * _x[i];
+        r += _h[i+1] * _x[i+1];
+        r += _h[i+2] * _x[i+2];
+        r += _h[i+3] * _x[i+3];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        r += _h[i] * _x[i];
+
+    *_y = r;
+}
+
+
+//
+// structured dot product with run-time kernel dispatch
+//
+
+struct dotprod_cccf_s {
+    unsigned int n;     // length
+    float * hi;         // in-phase (repeated)
+    float * hq;         // quadrature (repeated)
+
+    // kernel installed at create time based on CPU features
+    void (*execute)(dotprod_cccf _q, float complex * _x, float complex * _y);
+};
+
+dotprod_cccf dotprod_cccf_create(float complex * _h,
+                                 unsigned int    _n)
+{
+    dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
+    q->n = _n;
+
+    // allocate memory for coefficients: 64-byte aligned and zero-padded
+    // to the widest vector length so kernels never need a ragged tail
+    // on the coefficients arrays
+    unsigned int n_padded = ((2*q->n + 15) >> 4) << 4;
+    q->hi = (float*) _mm_malloc( n_padded*sizeof(float), 64 );
+    q->hq = (float*) _mm_malloc( n_padded*sizeof(float), 64 );
+    memset(q->hi, 0x00, n_padded*sizeof(float));
+    memset(q->hq, 0x00, n_padded*sizeof(float));
+
+    // set coefficients, repeated
+    //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
+    //  hq = { cimagf(_h[0]), cimagf(_h[0]), ... cimagf(_h[n-1]), cimagf(_h[n-1])}
+    unsigned int i;
+    for (i=0; i<q->n; i++) {
+        q->hi[2*i+0] = crealf(_h[i]);
+        q->hi[2*i+1] = crealf(_h[i]);
+
+        q->hq[2*i+0] = cimagf(_h[i]);
+        q->hq[2*i+1] = cimagf(_h[i]);
+    }
+
+    // install best kernel available on this machine
+    int features = liquid_cpu_features();
+    if (features & LIQUID_CPU_X86_AVX512F)
+        q->execute = dotprod_cccf_execute_avx512f;
+    else if ((features & LIQUID_CPU_X86_AVX2) && (features & LIQUID_CPU_X86_FMA))
+        q->execute = dotprod_cccf_execute_avx2;
+    else
+        q->execute = dotprod_cccf_execute_sse2;
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_cccf dotprod_cccf_recreate(dotprod_cccf    _q,
+                                   float complex * _h,
+                                   unsigned int    _n)
+{
+    // completely destroy and re-create dotprod object
+    dotprod_cccf_destroy(_q);
+    return dotprod_cccf_create(_h,_n);
+}
+
+
+void dotprod_cccf_destroy(dotprod_cccf _q)
+{
+    _mm_free(_q->hi);
+    _mm_free(_q->hq);
+    free(_q);
+}
+
+void dotprod_cccf_print(dotprod_cccf _q)
+{
+    printf("dotprod_cccf [x86, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("  %3u : %12.9f +j%12.9f\n", i, _q->hi[i], _q->hq[i]);
+}
+
+// execute structured dot product
+//  _q      :   dotprod object
+//  _x      :   input array
+//  _y      :   output sample
+void dotprod_cccf_execute(dotprod_cccf    _q,
+                          float complex * _x,
+                          float complex * _y)
+{
+    _q->execute(_q, _x, _y);
+}
+
+// sliding mask table for _mm256_maskload_ps; index [8-r] exposes the
+// first r lanes
+static const int32_t dotprod_maskf_avx[16] __attribute__((aligned(32))) = {
+    -1,-1,-1,-1,-1,-1,-1,-1,  0, 0, 0, 0, 0, 0, 0, 0};
+
+// SSE2 kernel (x86-64 baseline)
+//
+// (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
+//
+// mm_x  = { x[0].real, x[0].imag, x[1].real, x[1].imag }
+// mm_hi = { h[0].real, h[0].real, h[1].real, h[1].real }
+// mm_hq = { h[0].imag, h[0].imag, h[1].imag, h[1].imag }
+//
+// sumi += mm_x * mm_hi
+// sumq += swap(mm_x) * mm_hq
+//
+// even lanes: sumi - sumq, odd lanes: sumi + sumq
+//
+__attribute__((target("sse2")))
+static void dotprod_cccf_execute_sse2(dotprod_cccf    _q,
+                                      float complex * _x,
+                                      float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    // temporary buffers
+    __m128 v;   // input vector
+    __m128 hi;  // coefficients vector (real)
+    __m128 hq;  // coefficients vector (imag)
+
+    // load zeros into sum registers
+    __m128 sumi = _mm_setzero_ps();
+    __m128 sumq = _mm_setzero_ps();
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (n >> 2) << 2;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // load inputs into register (unaligned)
+        v = _mm_loadu_ps(&x[i]);
+
+        // load coefficients into registers (aligned)
+        hi = _mm_load_ps(&_q->hi[i]);
+        hq = _mm_load_ps(&_q->hq[i]);
+
+        // accumulate in-phase terms
+        sumi = _mm_add_ps(sumi, _mm_mul_ps(v, hi));
+
+        // swap real/imaginary pairs and accumulate quadrature terms
+        v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm_add_ps(sumq, _mm_mul_ps(v, hq));
+    }
+
+    // negate quadrature terms in even lanes and accumulate:
+    // even lanes: sumi - sumq, odd lanes: sumi + sumq
+    __m128 mneg = _mm_set_ps( 1.0f,-1.0f, 1.0f,-1.0f);
+    __m128 sum = _mm_add_ps(sumi, _mm_mul_ps(sumq, mneg));
+
+    // aligned output array
+    float w[4] __attribute__((aligned(16)));
+
+    // unload packed array
+    _mm_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    float complex total = (w[0] + w[2]) + (w[1] + w[3]) * _Complex_I;
+
+    // cleanup
+    for (i=t/2; i<_q->n; i++)
+        total += _x[i] * ( _q->hi[2*i] + _q->hq[2*i]*_Complex_I );
+
+    // set return value
+    *_y = total;
+}
+
+// AVX2/FMA kernel
+__attribute__((target("avx2,fma")))
+static void dotprod_cccf_execute_avx2(dotprod_cccf    _q,
+                                      float complex * _x,
+                                      float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    // temporary buffers
+    __m256 v;   // input vector
+    __m256 hi;  // coefficients vector (real)
+    __m256 hq;  // coefficients vector (imag)
+
+    // load zeros into sum registers
+    __m256 sumi = _mm256_setzero_ps();
+    __m256 sumq = _mm256_setzero_ps();
+
+    // t = 8*(floor(_n/8))
+    unsigned int t = (n >> 3) << 3;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load inputs into register (unaligned)
+        v = _mm256_loadu_ps(&x[i]);
+
+        // load coefficients into registers (aligned)
+        hi = _mm256_load_ps(&_q->hi[i]);
+        hq = _mm256_load_ps(&_q->hq[i]);
+
+        // multiply and accumulate in-phase terms
+        sumi = _mm256_fmadd_ps(v, hi, sumi);
+
+        // swap real/imaginary pairs and accumulate quadrature terms
+        v = _mm256_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm256_fmadd_ps(v, hq, sumq);
+    }
+
+    // masked tail: load remaining inputs under a mask (n is always even
+    // so real/imaginary pairs remain intact); coefficients are
+    // zero-padded so full aligned loads are safe
+    if (i < n) {
+        __m256i mask = _mm256_loadu_si256(
+            (const __m256i*)&dotprod_maskf_avx[8 - (n - i)]);
+        v  = _mm256_maskload_ps(&x[i], mask);
+        hi = _mm256_load_ps(&_q->hi[i]);
+        hq = _mm256_load_ps(&_q->hq[i]);
+        sumi = _mm256_fmadd_ps(v, hi, sumi);
+        v = _mm256_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm256_fmadd_ps(v, hq, sumq);
+    }
+
+    // combine using addsub: even lanes subtract, odd lanes add
+    __m256 sum = _mm256_addsub_ps( sumi, sumq );
+
+    // aligned output array
+    float w[8] __attribute__((aligned(32)));
+
+    // unload packed array
+    _mm256_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    *_y = (w[0] + w[2] + w[4] + w[6]) +
+          (w[1] + w[3] + w[5] + w[7]) * _Complex_I;
+}
+
+// AVX-512 kernel with masked tail handling
+__attribute__((target("avx512f")))
+static void dotprod_cccf_execute_avx512f(dotprod_cccf    _q,
+                                         float complex * _x,
+                                         float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    // temporary buffers
+    __m512 v;   // input vector
+    __m512 hi;  // coefficients vector (real)
+    __m512 hq;  // coefficients vector (imag)
+
+    // load zeros into sum registers
+    __m512 sumi = _mm512_setzero_ps();
+    __m512 sumq = _mm512_setzero_ps();
+
+    // t = 16*(floor(_n/16))
+    unsigned int t = (n >> 4) << 4;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        // load inputs into register (unaligned)
+        v = _mm512_loadu_ps(&x[i]);
+
+        // load coefficients into registers (aligned)
+        hi = _mm512_load_ps(&_q->hi[i]);
+        hq = _mm512_load_ps(&_q->hq[i]);
+
+        // multiply and accumulate in-phase terms
+        sumi = _mm512_fmadd_ps(v, hi, sumi);
+
+        // swap real/imaginary pairs and accumulate quadrature terms
+        v = _mm512_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm512_fmadd_ps(v, hq, sumq);
+    }
+
+    // handle remaining samples with a masked load (n is always even
+    // so real/imaginary pairs remain intact)
+    if (i < n) {
+        __mmask16 mask = (__mmask16)((1U << (n - i)) - 1);
+        v  = _mm512_maskz_loadu_ps(mask, &x[i]);
+        hi = _mm512_load_ps(&_q->hi[i]);    // zero-padded; full loads
+        hq = _mm512_load_ps(&_q->hq[i]);    // are safe
+        sumi = _mm512_fmadd_ps(v, hi, sumi);
+        v = _mm512_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+        sumq = _mm512_fmadd_ps(v, hq, sumq);
+    }
+
+    // negate quadrature terms in even lanes and accumulate:
+    // even lanes: sumi - sumq, odd lanes: sumi + sumq
+    __m512 mneg = _mm512_set_ps( 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f,
+                                 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f, 1.0f,-1.0f);
+    __m512 sum = _mm512_fmadd_ps(sumq, mneg, sumi);
+
+    // aligned output array
+    float w[16] __attribute__((aligned(64)));
+
+    // unload packed array
+    _mm512_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    float complex total =
+        (w[0] + w[2] + w[ 4] + w[ 6] + w[ 8] + w[10] + w[12] + w[14]) +
+        (w[1] + w[3] + w[ 5] + w[ 7] + w[ 9] + w[11] + w[13] + w[15]) * _Complex_I;
+
+    // set return value
+    *_y = total;
+}
+
+// AVX2/FMA batch kernel: apply four coefficient banks to one input
+// array, sharing each input load across all banks
+__attribute__((target("avx2,fma")))
+static void dotprod_cccf_execute_batch4_avx2(dotprod_cccf *  _q,
+                                             float complex * _x,
+                                             float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // all four banks share a common length
+    unsigned int n = 2*_q[0]->n;
+
+    // temporary buffers
+    __m256 v, vs;
+
+    // load zeros into sum registers (in-phase/quadrature per bank)
+    __m256 sumi0 = _mm256_setzero_ps(), sumq0 = _mm256_setzero_ps();
+    __m256 sumi1 = _mm256_setzero_ps(), sumq1 = _mm256_setzero_ps();
+    __m256 sumi2 = _mm256_setzero_ps(), sumq2 = _mm256_setzero_ps();
+    __m256 sumi3 = _mm256_setzero_ps(), sumq3 = _mm256_setzero_ps();
+
+    // t = 8*(floor(_n/8))
+    unsigned int t = (n >> 3) << 3;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load input once (unaligned) and re-use for all four banks
+        v  = _mm256_loadu_ps(&x[i]);
+        vs = _mm256_permute_ps(v, _MM_SHUFFLE(2,3,0,1));
+
+        // multiply and accumulate each bank's terms
+        sumi0 = _mm256_fmadd_ps(v,  _mm256_load_ps(&_q[0]->hi[i]), sumi0);
+        sumq0 = _mm256_fmadd_ps(vs, _mm256_load_ps(&_q[0]->hq[i]), sumq0);
+        sumi1 = _mm256_fmadd_ps(v,  _mm256_load_ps(&_q[1]->hi[i]), sumi1);
+        sumq1 = _mm256_fmadd_ps(vs, _mm256_load_ps(&_q[1]->hq[i]), sumq1);
+        sumi2 = _mm256_fmadd_ps(v,  _mm256_load_ps(&_q[2]->hi[i]), sumi2);
+        sumq2 = _mm256_fmadd_ps(vs, _mm256_load_ps(&_q[2]->hq[i]), sumq2);
+        sumi3 = _mm256_fmadd_ps(v,  _mm256_load_ps(&_q[3]->hi[i]), sumi3);
+        sumq3 = _mm256_fmadd_ps(vs, _mm256_load_ps(&_q[3]->hq[i]), sumq3);
+    }
+
+    // combine and unload each bank
+    float w[8] __attribute__((aligned(32)));
+    unsigned int k;
+    for (k=0; k<4; k++) {
+        __m256 sumi = k==0 ? sumi0 : k==1 ? sumi1 : k==2 ? sumi2 : sumi3;
+        __m256 sumq = k==0 ? sumq0 : k==1 ? sumq1 : k==2 ? sumq2 : sumq3;
+
+        // combine using addsub: even lanes subtract, odd lanes add
+        _mm256_store_ps(w, _mm256_addsub_ps(sumi, sumq));
+
+        // add in-phase and quadrature components
+        float complex total = (w[0] + w[2] + w[4] + w[6]) +
+                              (w[1] + w[3] + w[5] + w[7]) * _Complex_I;
+
+        // cleanup
+        unsigned int j;
+        for (j=t/2; j<_q[k]->n; j++)
+            total += _x[j] * ( _q[k]->hi[2*j] + _q[k]->hq[2*j]*_Complex_I );
+
+        _y[k] = total;
+    }
+}
+
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void dotprod_cccf_execute_batch(dotprod_cccf *  _q,
+                                unsigned int    _batch,
+                                float complex * _x,
+                                float complex * _y)
+{
+    unsigned int i=0;
+
+    // route large batches through the registered external backend
+    // (if any); the backend may decline by returning non-zero
+    if (liquid_internal_backend.dotprod_cccf_execute_batch != NULL &&
+        _batch > 0 &&
+        _q[0]->n * _batch >= liquid_internal_backend.dotprod_threshold)
+    {
+        if (liquid_internal_backend.dotprod_cccf_execute_batch(
+                liquid_internal_backend.context, _q, _batch, _x, _y) == 0)
+            return;
+    }
+
+    // tile four coefficient banks at a time when the banks share a
+    // common length (the typical polyphase filter-bank case), sharing
+    // each input load across the tile
+    if (liquid_cpu_features() & LIQUID_CPU_X86_AVX2) {
+        for (; i+4 <= _batch; i+=4) {
+            if (_q[i]->n != _q[i+1]->n || _q[i]->n != _q[i+2]->n || _q[i]->n != _q[i+3]->n)
+                break;
+            dotprod_cccf_execute_batch4_avx2(&_q[i], _x, &_y[i]);
+        }
+    }
+
+    // remaining (or non-uniform) banks one at a time; the input array
+    // stays resident in cache across iterations
+    for (; i<_batch; i++)
+        dotprod_cccf_execute(_q[i], _x, &_y[i]);
+}
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void dotprod_cccf_execute_pair(dotprod_cccf    _q0,
+                               dotprod_cccf    _q1,
+                               float complex * _x,
+                               float complex * _y0,
+                               float complex * _y1)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across calls
+    dotprod_cccf_execute(_q0, _x, _y0);
+    dotprod_cccf_execute(_q1, _x, _y1);
+}
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Floating-point dot product (x86, run-time dispatch)
+//
+// This translation unit is compiled without architecture-specific flags;
+// each kernel carries a gcc target attribute and the appropriate variant
+// is selected at create time from the executing CPU's feature set, so a
+// single binary runs optimally from SSE2 through AVX-512.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+#define DEBUG_DOTPROD_CRCF_X86   0
+
+// forward declaration of internal kernels
+static void dotprod_crcf_execute_sse2   (dotprod_crcf _q, float complex * _x, float complex * _y);
+static void dotprod_crcf_execute_avx2   (dotprod_crcf _q, float complex * _x, float complex * _y);
+static void dotprod_crcf_execute_avx512f(dotprod_crcf _q, float complex * _x, float complex * _y);
+
+// basic dot product (ordinal calculation)
+void dotprod_crcf_run(float *         _h,
+                      float complex * _x,
+                      unsigned int    _n,
+                      float complex * _y)
+{
+    float complex r = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += _h[i] * _x[i];
+    *_y = r;
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_crcf_run4(float *         _h,
+                       float complex * _x,
+                       unsigned int    _n,
+                       float complex * _y)
+{
+    float complex r = 0;
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        r += _h[i]   * _x[i];
+        r += _h[i+1] * _x[i+1];
+        r += _h[i+2] * _x[i+2];
+        r += _h[i+3] * _x[i+3];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        r += _h[i] * _x[i];
+
+    *_y = r;
+}
+
+
+//
+// structured dot product with run-time kernel dispatch
+//
+
+struct dotprod_crcf_s {
+    unsigned int n;     // length
+    float * h;          // coefficients array (repeated)
+
+    // kernel installed at create time based on CPU features
+    void (*execute)(dotprod_crcf _q, float complex * _x, float complex * _y);
+};
+
+dotprod_crcf dotprod_crcf_create(float *      _h,
+                                 unsigned int _n)
+{
+    dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    q->n = _n;
+
+    // allocate memory for coefficients: 64-byte aligned and zero-padded
+    // to the widest vector length so kernels never need a ragged tail
+    // on the coefficients array
+    unsigned int n_padded = ((2*q->n + 15) >> 4) << 4;
+    q->h = (float*) _mm_malloc( n_padded*sizeof(float), 64 );
+    memset(q->h, 0x00, n_padded*sizeof(float));
+
+    // set coefficients, repeated
+    //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
+    unsigned int i;
+    for (i=0; i<q->n; i++) {
+        q->h[2*i+0] = _h[i];
+        q->h[2*i+1] = _h[i];
+    }
+
+    // install best kernel available on this machine
+    int features = liquid_cpu_features();
+    if (features & LIQUID_CPU_X86_AVX512F)
+        q->execute = dotprod_crcf_execute_avx512f;
+    else if ((features & LIQUID_CPU_X86_AVX2) && (features & LIQUID_CPU_X86_FMA))
+        q->execute = dotprod_crcf_execute_avx2;
+    else
+        q->execute = dotprod_crcf_execute_sse2;
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_crcf dotprod_crcf_recreate(dotprod_crcf _q,
+                                   float *      _h,
+                                   unsigned int _n)
+{
+    // completely destroy and re-create dotprod object
+    dotprod_crcf_destroy(_q);
+    return dotprod_crcf_create(_h,_n);
+}
+
+
+void dotprod_crcf_destroy(dotprod_crcf _q)
+{
+    _mm_free(_q->h);
+    free(_q);
+}
+
+void dotprod_crcf_print(dotprod_crcf _q)
+{
+    // print coefficients to screen, skipping odd entries (due
+    // to repeated coefficients)
+    printf("dotprod_crcf [x86, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("  %3u : %12.9f\n", i, _q->h[2*i]);
+}
+
+//
+void dotprod_crcf_execute(dotprod_crcf    _q,
+                          float complex * _x,
+                          float complex * _y)
+{
+    _q->execute(_q, _x, _y);
+}
+
+// sliding mask table for _mm256_maskload_ps; index [8-r] exposes the
+// first r lanes
+static const int32_t dotprod_maskf_avx[16] __attribute__((aligned(32))) = {
+    -1,-1,-1,-1,-1,-1,-1,-1,  0, 0, 0, 0, 0, 0, 0, 0};
+
+// SSE2 kernel (x86-64 baseline)
+__attribute__((target("sse2")))
+static void dotprod_crcf_execute_sse2(dotprod_crcf    _q,
+                                      float complex * _x,
+                                      float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    __m128 v;   // input vector
+    __m128 h;   // coefficients vector
+    __m128 s;   // dot product
+    __m128 sum = _mm_setzero_ps();  // load zeros into sum register
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (n >> 2) << 2;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // load inputs into register (unaligned)
+        v = _mm_loadu_ps(&x[i]);
+
+        // load coefficients into register (aligned)
+        h = _mm_load_ps(&_q->h[i]);
+
+        // compute multiplication
+        s = _mm_mul_ps(v, h);
+
+        // accumulate
+        sum = _mm_add_ps(sum, s);
+    }
+
+    // aligned output array
+    float w[4] __attribute__((aligned(16)));
+
+    // unload packed array
+    _mm_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    float complex total = (w[0] + w[2]) + (w[1] + w[3]) * _Complex_I;
+
+    // cleanup
+    for (i=t/2; i<_q->n; i++)
+        total += _x[i] * _q->h[2*i];
+
+    // set return value
+    *_y = total;
+}
+
+// AVX2/FMA kernel
+__attribute__((target("avx2,fma")))
+static void dotprod_crcf_execute_avx2(dotprod_crcf    _q,
+                                      float complex * _x,
+                                      float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    __m256 v0, v1;
+    __m256 h0, h1;
+
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+
+    // t = 16*(floor(_n/16))
+    unsigned int t = (n >> 4) << 4;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        // load inputs into registers (unaligned)
+        v0 = _mm256_loadu_ps(&x[i  ]);
+        v1 = _mm256_loadu_ps(&x[i+8]);
+
+        // load coefficients into registers (aligned)
+        h0 = _mm256_load_ps(&_q->h[i  ]);
+        h1 = _mm256_load_ps(&_q->h[i+8]);
+
+        // multiply and accumulate
+        sum0 = _mm256_fmadd_ps(v0, h0, sum0);
+        sum1 = _mm256_fmadd_ps(v1, h1, sum1);
+    }
+
+    // continue in single-register strides
+    for (; i+8 <= n; i+=8) {
+        v0 = _mm256_loadu_ps(&x[i]);
+        h0 = _mm256_load_ps(&_q->h[i]);
+        sum0 = _mm256_fmadd_ps(v0, h0, sum0);
+    }
+
+    // masked tail: load remaining inputs under a mask (n is always even
+    // so real/imaginary pairs remain intact); coefficients are
+    // zero-padded so a full aligned load is safe
+    if (i < n) {
+        __m256i mask = _mm256_loadu_si256(
+            (const __m256i*)&dotprod_maskf_avx[8 - (n - i)]);
+        v0 = _mm256_maskload_ps(&x[i], mask);
+        h0 = _mm256_load_ps(&_q->h[i]);
+        sum0 = _mm256_fmadd_ps(v0, h0, sum0);
+    }
+
+    // fold down into single register
+    sum0 = _mm256_add_ps( sum0, sum1 );
+
+    // aligned output array
+    float w[8] __attribute__((aligned(32)));
+
+    // unload packed array
+    _mm256_store_ps(w, sum0);
+
+    // add in-phase and quadrature components
+    *_y = (w[0] + w[2] + w[4] + w[6]) +
+          (w[1] + w[3] + w[5] + w[7]) * _Complex_I;
+}
+
+// AVX-512 kernel with masked tail handling
+__attribute__((target("avx512f")))
+static void dotprod_crcf_execute_avx512f(dotprod_crcf    _q,
+                                         float complex * _x,
+                                         float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q->n;
+
+    __m512 v;   // input vector
+    __m512 h;   // coefficients vector
+    __m512 sum = _mm512_setzero_ps();  // load zeros into sum register
+
+    // t = 16*(floor(_n/16))
+    unsigned int t = (n >> 4) << 4;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        // load inputs into register (unaligned)
+        v = _mm512_loadu_ps(&x[i]);
+
+        // load coefficients into register (aligned)
+        h = _mm512_load_ps(&_q->h[i]);
+
+        // multiply and accumulate
+        sum = _mm512_fmadd_ps(v, h, sum);
+    }
+
+    // handle remaining samples with a masked load (n is always even
+    // so real/imaginary pairs remain intact)
+    if (i < n) {
+        __mmask16 mask = (__mmask16)((1U << (n - i)) - 1);
+        v = _mm512_maskz_loadu_ps(mask, &x[i]);
+        h = _mm512_load_ps(&_q->h[i]);  // zero-padded; full load is safe
+        sum = _mm512_fmadd_ps(v, h, sum);
+    }
+
+    // aligned output array
+    float w[16] __attribute__((aligned(64)));
+
+    // unload packed array
+    _mm512_store_ps(w, sum);
+
+    // add in-phase and quadrature components
+    float complex total =
+        (w[0] + w[2] + w[ 4] + w[ 6] + w[ 8] + w[10] + w[12] + w[14]) +
+        (w[1] + w[3] + w[ 5] + w[ 7] + w[ 9] + w[11] + w[13] + w[15]) * _Complex_I;
+
+    // set return value
+    *_y = total;
+}
+
+// fused AVX2/FMA kernel for a pair of dot products of equal length; the
+// input window is loaded once and applied to both coefficient sets
+__attribute__((target("avx2,fma")))
+static void dotprod_crcf_execute_pair_avx2(dotprod_crcf    _q0,
+                                           dotprod_crcf    _q1,
+                                           float complex * _x,
+                                           float complex * _y0,
+                                           float complex * _y1)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_q0->n;
+
+    __m256 v;       // shared input vector
+    __m256 ha, hb;  // coefficients vectors
+
+    // load zeros into sum registers
+    __m256 suma = _mm256_setzero_ps();
+    __m256 sumb = _mm256_setzero_ps();
+
+    // t = 8*(floor(n/8))
+    unsigned int t = (n >> 3) << 3;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load input into register once (unaligned)
+        v = _mm256_loadu_ps(&x[i]);
+
+        // load both coefficient sets (aligned)
+        ha = _mm256_load_ps(&_q0->h[i]);
+        hb = _mm256_load_ps(&_q1->h[i]);
+
+        // multiply and accumulate
+        suma = _mm256_fmadd_ps(v, ha, suma);
+        sumb = _mm256_fmadd_ps(v, hb, sumb);
+    }
+
+    // masked tail: load remaining inputs under a mask (n is always even
+    // so real/imaginary pairs remain intact); coefficients are
+    // zero-padded so full aligned loads are safe
+    if (i < n) {
+        __m256i mask = _mm256_loadu_si256(
+            (const __m256i*)&dotprod_maskf_avx[8 - (n - i)]);
+        v  = _mm256_maskload_ps(&x[i], mask);
+        ha = _mm256_load_ps(&_q0->h[i]);
+        hb = _mm256_load_ps(&_q1->h[i]);
+        suma = _mm256_fmadd_ps(v, ha, suma);
+        sumb = _mm256_fmadd_ps(v, hb, sumb);
+    }
+
+    // aligned output arrays
+    float wa[8] __attribute__((aligned(32)));
+    float wb[8] __attribute__((aligned(32)));
+
+    // unload packed arrays
+    _mm256_store_ps(wa, suma);
+    _mm256_store_ps(wb, sumb);
+
+    // add in-phase and quadrature components
+    *_y0 = (wa[0] + wa[2] + wa[4] + wa[6]) +
+           (wa[1] + wa[3] + wa[5] + wa[7]) * _Complex_I;
+    *_y1 = (wb[0] + wb[2] + wb[4] + wb[6]) +
+           (wb[1] + wb[3] + wb[5] + wb[7]) * _Complex_I;
+}
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void dotprod_crcf_execute_pair(dotprod_crcf    _q0,
+                               dotprod_crcf    _q1,
+                               float complex * _x,
+                               float complex * _y0,
+                               float complex * _y1)
+{
+    // use fused kernel when lengths match and AVX2/FMA is available
+    int features = liquid_cpu_features();
+    if (_q0->n == _q1->n &&
+        (features & LIQUID_CPU_X86_AVX2) && (features & LIQUID_CPU_X86_FMA)) {
+        dotprod_crcf_execute_pair_avx2(_q0, _q1, _x, _y0, _y1);
+        return;
+    }
+
+    // otherwise run each dot product in turn; the input array stays
+    // resident in cache across calls
+    dotprod_crcf_execute(_q0, _x, _y0);
+    dotprod_crcf_execute(_q1, _x, _y1);
+}
+
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void dotprod_crcf_execute_batch(dotprod_crcf *  _q,
+                                unsigned int    _batch,
+                                float complex * _x,
+                                float complex * _y)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_crcf_execute(_q[i], _x, &_y[i]);
+}
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Fixed-point dot products (Q.15 and Q.31)
+//
+// Samples and coefficients are signed fixed-point values; products are
+// accumulated in a register twice the sample width and rounded back to
+// the sample format on output.  Intended for embedded receivers where a
+// floating-point unit is unavailable or power-constrained.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// Q.15 fractional bits
+#define DOTPROD_Q16_BITS    (15)
+
+// Q.31 fractional bits
+#define DOTPROD_Q32_BITS    (31)
+
+//
+// q16 : samples and coefficients in Q.15
+//
+
+// basic dot product (ordinal calculation)
+void dotprod_rrrq16_run(int16_t *    _h,
+                        int16_t *    _x,
+                        unsigned int _n,
+                        int16_t *    _y)
+{
+    // accumulate in 32 bits; rounding constant for shift back to Q.15
+    int32_t r = 1 << (DOTPROD_Q16_BITS-1);
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += (int32_t)_h[i] * (int32_t)_x[i];
+
+    *_y = (int16_t)(r >> DOTPROD_Q16_BITS);
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_rrrq16_run4(int16_t *    _h,
+                         int16_t *    _x,
+                         unsigned int _n,
+                         int16_t *    _y)
+{
+    int32_t r = 1 << (DOTPROD_Q16_BITS-1);
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        r += (int32_t)_h[i]   * (int32_t)_x[i];
+        r += (int32_t)_h[i+1] * (int32_t)_x[i+1];
+        r += (int32_t)_h[i+2] * (int32_t)_x[i+2];
+        r += (int32_t)_h[i+3] * (int32_t)_x[i+3];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        r += (int32_t)_h[i] * (int32_t)_x[i];
+
+    *_y = (int16_t)(r >> DOTPROD_Q16_BITS);
+}
+
+// structured dot product object
+struct dotprod_rrrq16_s {
+    int16_t * h;        // coefficients array
+    unsigned int n;     // length
+};
+
+dotprod_rrrq16 dotprod_rrrq16_create(int16_t *    _h,
+                                     unsigned int _n)
+{
+    dotprod_rrrq16 q = (dotprod_rrrq16) malloc(sizeof(struct dotprod_rrrq16_s));
+    q->n = _n;
+
+    // allocate memory for coefficients
+    q->h = (int16_t*) malloc((q->n)*sizeof(int16_t));
+
+    // set coefficients
+    memmove(q->h, _h, (q->n)*sizeof(int16_t));
+
+    // return object
+    return q;
+}
+
+// re-create dot product object
+dotprod_rrrq16 dotprod_rrrq16_recreate(dotprod_rrrq16 _q,
+                                       int16_t *      _h,
+                                       unsigned int   _n)
+{
+    // check to see if length has changed
+    if (_q->n != _n) {
+        // set new length
+        _q->n = _n;
+
+        // re-allocate memory
+        _q->h = (int16_t*) realloc(_q->h, (_q->n)*sizeof(int16_t));
+    }
+
+    // copy coefficients
+    memmove(_q->h, _h, (_q->n)*sizeof(int16_t));
+    return _q;
+}
+
+void dotprod_rrrq16_destroy(dotprod_rrrq16 _q)
+{
+    free(_q->h);    // free coefficients memory
+    free(_q);       // free main object memory
+}
+
+void dotprod_rrrq16_print(dotprod_rrrq16 _q)
+{
+    printf("dotprod_rrrq16 [portable, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("  %4u : %12.8f (0x%.4x)\n", i,
+                (float)_q->h[i] / (float)(1<<DOTPROD_Q16_BITS),
+                (uint16_t)_q->h[i]);
+}
+
+// execute structured dot product
+void dotprod_rrrq16_execute(dotprod_rrrq16 _q,
+                            int16_t *      _x,
+                            int16_t *      _y)
+{
+    dotprod_rrrq16_run4(_q->h, _x, _q->n, _y);
+}
+
+// execute batch of structured dot products against a common input array
+void dotprod_rrrq16_execute_batch(dotprod_rrrq16 * _q,
+                                  unsigned int     _batch,
+                                  int16_t *        _x,
+                                  int16_t *        _y)
+{
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_rrrq16_execute(_q[i], _x, &_y[i]);
+}
+
+void dotprod_rrrq16_execute_pair(dotprod_rrrq16 _q0,
+                                 dotprod_rrrq16 _q1,
+                                 int16_t *      _x,
+                                 int16_t *      _y0,
+                                 int16_t *      _y1)
+{
+    dotprod_rrrq16_execute(_q0, _x, _y0);
+    dotprod_rrrq16_execute(_q1, _x, _y1);
+}
+
+
+//
+// q32 : samples and coefficients in Q.31
+//
+
+// basic dot product (ordinal calculation)
+void dotprod_rrrq32_run(int32_t *    _h,
+                        int32_t *    _x,
+                        unsigned int _n,
+                        int32_t *    _y)
+{
+    // accumulate in 64 bits; rounding constant for shift back to Q.31
+    int64_t r = (int64_t)1 << (DOTPROD_Q32_BITS-1);
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += (int64_t)_h[i] * (int64_t)_x[i];
+
+    *_y = (int32_t)(r >> DOTPROD_Q32_BITS);
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_rrrq32_run4(int32_t *    _h,
+                         int32_t *    _x,
+                         unsigned int _n,
+                         int32_t *    _y)
+{
+    int64_t r = (int64_t)1 << (DOTPROD_Q32_BITS-1);
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        r += (int64_t)_h[i]   * (int64_t)_x[i];
+        r += (int64_t)_h[i+1] * (int64_t)_x[i+1];
+        r += (int64_t)_h[i+2] * (int64_t)_x[i+2];
+        r += (int64_t)_h[i+3] * (int64_t)_x[i+3];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        r += (int64_t)_h[i] * (int64_t)_x[i];
+
+    *_y = (int32_t)(r >> DOTPROD_Q32_BITS);
+}
+
+// structured dot product object
+struct dotprod_rrrq32_s {
+    int32_t * h;        // coefficients array
+    unsigned int n;     // length
+};
+
+dotprod_rrrq32 dotprod_rrrq32_create(int32_t *    _h,
+                                     unsigned int _n)
+{
+    dotprod_rrrq32 q = (dotprod_rrrq32) malloc(sizeof(struct dotprod_rrrq32_s));
+    q->n = _n;
+
+    // allocate memory for coefficients
+    q->h = (int32_t*) malloc((q->n)*sizeof(int32_t));
+
+    // set coefficients
+    memmove(q->h, _h, (q->n)*sizeof(int32_t));
+
+    // return object
+    return q;
+}
+
+// re-create dot product object
+dotprod_rrrq32 dotprod_rrrq32_recreate(dotprod_rrrq32 _q,
+                                       int32_t *      _h,
+                                       unsigned int   _n)
+{
+    // check to see if length has changed
+    if (_q->n != _n) {
+        // set new length
+        _q->n = _n;
+
+        // re-allocate memory
+        _q->h = (int32_t*) realloc(_q->h, (_q->n)*sizeof(int32_t));
+    }
+
+    // copy coefficients
+    memmove(_q->h, _h, (_q->n)*sizeof(int32_t));
+    return _q;
+}
+
+void dotprod_rrrq32_destroy(dotprod_rrrq32 _q)
+{
+    free(_q->h);    // free coefficients memory
+    free(_q);       // free main object memory
+}
+
+void dotprod_rrrq32_print(dotprod_rrrq32 _q)
+{
+    printf("dotprod_rrrq32 [portable, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("  %4u : %12.8f (0x%.8x)\n", i,
+                (float)_q->h[i] / (float)(1u<<DOTPROD_Q32_BITS),
+                (uint32_t)_q->h[i]);
+}
+
+// execute structured dot product
+void dotprod_rrrq32_execute(dotprod_rrrq32 _q,
+                            int32_t *      _x,
+                            int32_t *      _y)
+{
+    dotprod_rrrq32_run4(_q->h, _x, _q->n, _y);
+}
+
+// execute batch of structured dot products against a common input array
+void dotprod_rrrq32_execute_batch(dotprod_rrrq32 * _q,
+                                  unsigned int     _batch,
+                                  int32_t *        _x,
+                                  int32_t *        _y)
+{
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_rrrq32_execute(_q[i], _x, &_y[i]);
+}
+
+void dotprod_rrrq32_execute_pair(dotprod_rrrq32 _q0,
+                                 dotprod_rrrq32 _q1,
+                                 int32_t *      _x,
+                                 int32_t *      _y0,
+                                 int32_t *      _y1)
+{
+    dotprod_rrrq32_execute(_q0, _x, _y0);
+    dotprod_rrrq32_execute(_q1, _x, _y1);
+}
+
+
+//
+// crcq16 : interleaved complex samples in Q.15, real coefficients in Q.15
+//
+// The in-phase and quadrature accumulations share each coefficient so the
+// kernel reads the i/q words in pairs, exactly as they arrive from an sc16
+// radio front end; _n counts complex samples (the input spans 2*_n words)
+//
+
+// basic dot product (ordinal calculation)
+void dotprod_crcq16_run(int16_t *    _h,
+                        int16_t *    _x,
+                        unsigned int _n,
+                        int16_t *    _y)
+{
+    // separate i/q accumulators with rounding constants
+    int32_t ri = 1 << (DOTPROD_Q16_BITS-1);
+    int32_t rq = 1 << (DOTPROD_Q16_BITS-1);
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        ri += (int32_t)_h[i] * (int32_t)_x[2*i  ];
+        rq += (int32_t)_h[i] * (int32_t)_x[2*i+1];
+    }
+
+    _y[0] = (int16_t)(ri >> DOTPROD_Q16_BITS);
+    _y[1] = (int16_t)(rq >> DOTPROD_Q16_BITS);
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_crcq16_run4(int16_t *    _h,
+                         int16_t *    _x,
+                         unsigned int _n,
+                         int16_t *    _y)
+{
+    int32_t ri = 1 << (DOTPROD_Q16_BITS-1);
+    int32_t rq = 1 << (DOTPROD_Q16_BITS-1);
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        ri += (int32_t)_h[i]   * (int32_t)_x[2*i  ];
+        rq += (int32_t)_h[i]   * (int32_t)_x[2*i+1];
+        ri += (int32_t)_h[i+1] * (int32_t)_x[2*i+2];
+        rq += (int32_t)_h[i+1] * (int32_t)_x[2*i+3];
+        ri += (int32_t)_h[i+2] * (int32_t)_x[2*i+4];
+        rq += (int32_t)_h[i+2] * (int32_t)_x[2*i+5];
+        ri += (int32_t)_h[i+3] * (int32_t)_x[2*i+6];
+        rq += (int32_t)_h[i+3] * (int32_t)_x[2*i+7];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++) {
+        ri += (int32_t)_h[i] * (int32_t)_x[2*i  ];
+        rq += (int32_t)_h[i] * (int32_t)_x[2*i+1];
+    }
+
+    _y[0] = (int16_t)(ri >> DOTPROD_Q16_BITS);
+    _y[1] = (int16_t)(rq >> DOTPROD_Q16_BITS);
+}
+
+// structured dot product object
+struct dotprod_crcq16_s {
+    int16_t * h;        // coefficients array
+    unsigned int n;     // length
+};
+
+dotprod_crcq16 dotprod_crcq16_create(int16_t *    _h,
+                                     unsigned int _n)
+{
+    dotprod_crcq16 q = (dotprod_crcq16) malloc(sizeof(struct dotprod_crcq16_s));
+    q->n = _n;
+
+    // allocate memory for coefficients
+    q->h = (int16_t*) malloc((q->n)*sizeof(int16_t));
+
+    // set coefficients
+    memmove(q->h, _h, (q->n)*sizeof(int16_t));
+
+    // return object
+    return q;
+}
+
+// re-create dot product object
+dotprod_crcq16 dotprod_crcq16_recreate(dotprod_crcq16 _q,
+                                       int16_t *      _h,
+                                       unsigned int   _n)
+{
+    // check to see if length has changed
+    if (_q->n != _n) {
+        // set new length
+        _q->n = _n;
+
+        // re-allocate memory
+        _q->h = (int16_t*) realloc(_q->h, (_q->n)*sizeof(int16_t));
+    }
+
+    // copy coefficients
+    memmove(_q->h, _h, (_q->n)*sizeof(int16_t));
+    return _q;
+}
+
+void dotprod_crcq16_destroy(dotprod_crcq16 _q)
+{
+    free(_q->h);    // free coefficients memory
+    free(_q);       // free main object memory
+}
+
+void dotprod_crcq16_print(dotprod_crcq16 _q)
+{
+    printf("dotprod_crcq16 [portable, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("  %4u : %12.8f (0x%.4x)\n", i,
+                (float)_q->h[i] / (float)(1<<DOTPROD_Q16_BITS),
+                (uint16_t)_q->h[i]);
+}
+
+// execute structured dot product
+void dotprod_crcq16_execute(dotprod_crcq16 _q,
+                            int16_t *      _x,
+                            int16_t *      _y)
+{
+    dotprod_crcq16_run4(_q->h, _x, _q->n, _y);
+}
+
+// execute batch of structured dot products against a common input array
+void dotprod_crcq16_execute_batch(dotprod_crcq16 * _q,
+                                  unsigned int     _batch,
+                                  int16_t *        _x,
+                                  int16_t *        _y)
+{
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_crcq16_execute(_q[i], _x, &_y[2*i]);
+}
+
+void dotprod_crcq16_execute_pair(dotprod_crcq16 _q0,
+                                 dotprod_crcq16 _q1,
+                                 int16_t *      _x,
+                                 int16_t *      _y0,
+                                 int16_t *      _y1)
+{
+    dotprod_crcq16_execute(_q0, _x, _y0);
+    dotprod_crcq16_execute(_q1, _x, _y1);
+}
+
+
+// sum of squares of Q.15 values, accumulated in 64 bits and normalized
+// back to unit full scale; for interleaved complex (sc16) input pass
+// twice the number of complex samples
+float liquid_sumsqq16(int16_t *    _v,
+                      unsigned int _n)
+{
+    int64_t r = 0;
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += (int32_t)_v[i] * (int32_t)_v[i];
+
+    // each product carries 2*DOTPROD_Q16_BITS fractional bits
+    return (float)r / (float)(1 << (2*DOTPROD_Q16_BITS));
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Floating-point dot product (AVX2 + FMA)
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#include <immintrin.h>  // AVX2/FMA
+
+#define DEBUG_DOTPROD_RRRF_AVX2  0
+
+// internal methods
+void dotprod_rrrf_execute_avx2(dotprod_rrrf _q,
+                               float *      _x,
+                               float *      _y);
+void dotprod_rrrf_execute_avx24(dotprod_rrrf _q,
+                                float *      _x,
+                                float *      _y);
+
+// basic dot product (ordinal calculation)
+void dotprod_rrrf_run(float *      _h,
+                      float *      _x,
+                      unsigned int _n,
+                      float *      _y)
+{
+    float r=0;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        r += _h[i] * _x[i];
+    *_y = r;
+}
+
+// basic dot product (ordinal calculation) with loop unrolled
+void dotprod_rrrf_run4(float *      _h,
+                       float *      _x,
+                       unsigned int _n,
+                       float *      _y)
+{
+    float r=0;
+
+    // t = 4*(floor(_n/4))
+    unsigned int t=(_n>>2)<<2;
+
+    // compute dotprod in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        r += _h[i]   * _x[i];
+        r += _h[i+1] * _x[i+1];
+        r += _h[i+2] * _x[i+2];
+        r += _h[i+3] * _x[i+3];
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        r += _h[i] * _x[i];
+
+    *_y = r;
+}
+
+
+//
+// structured AVX2 dot product
+//
+
+struct dotprod_rrrf_s {
+    unsigned int n;     // length
+    float * h;          // coefficients array
+};
+
+dotprod_rrrf dotprod_rrrf_create(float *      _h,
+                                 unsigned int _n)
+{
+    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    q->n = _n;
+
+    // allocate memory for coefficients, 32-byte aligned
+    q->h = (float*) _mm_malloc( q->n*sizeof(float), 32);
+
+    // set coefficients
+    memmove(q->h, _h, _n*sizeof(float));
+
+    // return object
+    return q;
+}
+
+// re-create the structured dotprod object
+dotprod_rrrf dotprod_rrrf_recreate(dotprod_rrrf _q,
+                                   float * _h,
+                                   unsigned int _n)
+{
+    // completely destroy and re-create dotprod object
+    dotprod_rrrf_destroy(_q);
+    return dotprod_rrrf_create(_h,_n);
+}
+
+
+void dotprod_rrrf_destroy(dotprod_rrrf _q)
+{
+    _mm_free(_q->h);
+    free(_q);
+}
+
+void dotprod_rrrf_print(dotprod_rrrf _q)
+{
+    printf("dotprod_rrrf [avx2, %u coefficients]\n", _q->n);
+    unsigned int i;
+    for (i=0; i<_q->n; i++)
+        printf("%3u : %12.9f\n", i, _q->h[i]);
+}
+
+//
+void dotprod_rrrf_execute(dotprod_rrrf _q,
+                          float *      _x,
+                          float *      _y)
+{
+    // switch based on size
+    if (_q->n < 32) {
+        dotprod_rrrf_execute_avx2(_q, _x, _y);
+    } else {
+        dotprod_rrrf_execute_avx24(_q, _x, _y);
+    }
+}
+
+// use AVX2/FMA extensions
+void dotprod_rrrf_execute_avx2(dotprod_rrrf _q,
+                               float *      _x,
+                               float *      _y)
+{
+    __m256 v;   // input vector
+    __m256 h;   // coefficients vector
+    __m256 sum = _mm256_setzero_ps(); // load zeros into sum register
+
+    // t = 8*(floor(_n/8))
+    unsigned int t = (_q->n >> 3) << 3;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        // load inputs into register (unaligned)
+        v = _mm256_loadu_ps(&_x[i]);
+
+        // load coefficients into register (aligned)
+        h = _mm256_load_ps(&_q->h[i]);
+
+        // multiply and accumulate
+        sum = _mm256_fmadd_ps(v, h, sum);
+    }
+
+    // aligned output array
+    float w[8] __attribute__((aligned(32)));
+
+    // fold down into single value
+    __m256 z = _mm256_setzero_ps();
+    sum = _mm256_hadd_ps(sum, z);
+    sum = _mm256_hadd_ps(sum, z);
+
+    // unload packed array; lanes do not cross with hadd so sum
+    // across the two 128-bit halves
+    _mm256_store_ps(w, sum);
+    float total = w[0] + w[4];
+
+    // cleanup
+    for (; i<_q->n; i++)
+        total += _x[i] * _q->h[i];
+
+    // set return value
+    *_y = total;
+}
+
+// use AVX2/FMA extensions, unrolled loop
+void dotprod_rrrf_execute_avx24(dotprod_rrrf _q,
+                                float *      _x,
+                                float *      _y)
+{
+    __m256 v0, v1, v2, v3;
+    __m256 h0, h1, h2, h3;
+
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 8*floor(n/32)
+    unsigned int r = (_q->n >> 5) << 3;
+
+    //
+    unsigned int i;
+    for (i=0; i<r; i+=8) {
+        // load inputs into registers (unaligned)
+        v0 = _mm256_loadu_ps(&_x[4*i+ 0]);
+        v1 = _mm256_loadu_ps(&_x[4*i+ 8]);
+        v2 = _mm256_loadu_ps(&_x[4*i+16]);
+        v3 = _mm256_loadu_ps(&_x[4*i+24]);
+
+        // load coefficients into registers (aligned)
+        h0 = _mm256_load_ps(&_q->h[4*i+ 0]);
+        h1 = _mm256_load_ps(&_q->h[4*i+ 8]);
+        h2 = _mm256_load_ps(&_q->h[4*i+16]);
+        h3 = _mm256_load_ps(&_q->h[4*i+24]);
+
+        // multiply and accumulate
+        sum0 = _mm256_fmadd_ps(v0, h0, sum0);
+        sum1 = _mm256_fmadd_ps(v1, h1, sum1);
+        sum2 = _mm256_fmadd_ps(v2, h2, sum2);
+        sum3 = _mm256_fmadd_ps(v3, h3, sum3);
+    }
+
+    // fold down into single register
+    sum0 = _mm256_add_ps( sum0, sum1 );
+    sum2 = _mm256_add_ps( sum2, sum3 );
+    sum0 = _mm256_add_ps( sum0, sum2 );
+
+    // aligned output array
+    float w[8] __attribute__((aligned(32)));
+
+    // unload packed array and perform manual sum
+    _mm256_store_ps(w, sum0);
+    float total = w[0] + w[1] + w[2] + w[3] +
+                  w[4] + w[5] + w[6] + w[7];
+
+    // cleanup (note: n _may_ be less than 32 at this point)
+    for (i=4*r; i<_q->n; i++)
+        total += _x[i] * _q->h[i];
+
+    // set return value
+    *_y = total;
+}
+
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void dotprod_rrrf_execute_batch(dotprod_rrrf * _q,
+                                unsigned int   _batch,
+                                float *        _x,
+                                float *        _y)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_rrrf_execute(_q[i], _x, &_y[i]);
+}
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void dotprod_rrrf_execute_pair(dotprod_rrrf    _q0,
+                                dotprod_rrrf    _q1,
+                                float *         _x,
+                                float *         _y0,
+                                float *         _y1)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across calls
+    dotprod_rrrf_execute(_q0, _x, _y0);
+    dotprod_rrrf_execute(_q1, _x, _y1);
+}
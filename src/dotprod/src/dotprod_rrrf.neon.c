@@ -220,3 +220,38 @@ void dotprod_rrrf_execute(dotprod_rrrf _q,
     }
 }
 
+
+// execute batch of structured dot products against a common input array
+//  _q      :   array of dot product objects [size: _batch x 1]
+//  _batch  :   number of dot product objects
+//  _x      :   input array, at least as long as longest object
+//  _y      :   output array [size: _batch x 1]
+void dotprod_rrrf_execute_batch(dotprod_rrrf * _q,
+                                unsigned int   _batch,
+                                float *        _x,
+                                float *        _y)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++)
+        dotprod_rrrf_execute(_q[i], _x, &_y[i]);
+}
+
+// execute two structured dot products against a common input array
+//  _q0     :   first dot product object
+//  _q1     :   second dot product object
+//  _x      :   input array, at least as long as both objects
+//  _y0     :   first output sample pointer
+//  _y1     :   second output sample pointer
+void dotprod_rrrf_execute_pair(dotprod_rrrf    _q0,
+                                dotprod_rrrf    _q1,
+                                float *         _x,
+                                float *         _y0,
+                                float *         _y1)
+{
+    // run each dot product in turn; the input array stays resident in
+    // cache across calls
+    dotprod_rrrf_execute(_q0, _x, _y0);
+    dotprod_rrrf_execute(_q1, _x, _y1);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// split-complex (planar, structure-of-arrays) storage helpers and dot
+// product.  Keeping the in-phase and quadrature components in separate
+// planes makes every SIMD lane homogeneous, so the four real
+// accumulations below vectorize directly without the shuffle/swizzle
+// steps the interleaved kernels need.
+//
+
+#include "liquid.internal.h"
+
+// split interleaved complex array into i/q planes
+//  _x  : input interleaved array [size: _n x 1]
+//  _n  : array length
+//  _xi : output in-phase plane [size: _n x 1]
+//  _xq : output quadrature plane [size: _n x 1]
+void liquid_complexf_deinterleave(liquid_float_complex * _x,
+                                  unsigned int           _n,
+                                  float *                _xi,
+                                  float *                _xq)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _xi[i] = crealf(_x[i]);
+        _xq[i] = cimagf(_x[i]);
+    }
+}
+
+// combine i/q planes into interleaved complex array
+//  _xi : input in-phase plane [size: _n x 1]
+//  _xq : input quadrature plane [size: _n x 1]
+//  _n  : array length
+//  _y  : output interleaved array [size: _n x 1]
+void liquid_complexf_interleave(float *                _xi,
+                                float *                _xq,
+                                unsigned int           _n,
+                                liquid_float_complex * _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _xi[i] + _Complex_I*_xq[i];
+}
+
+// compute complex dot product on split-complex (planar) operands;
+// expanding (hi + j hq)(xi + j xq) gives four independent real dot
+// products accumulated in parallel
+//  _hi : coefficient in-phase plane [size: _n x 1]
+//  _hq : coefficient quadrature plane [size: _n x 1]
+//  _xi : sample in-phase plane [size: _n x 1]
+//  _xq : sample quadrature plane [size: _n x 1]
+//  _n  : dot product length
+//  _y  : output result pointer
+void dotprod_cccf_soa_run(float *                _hi,
+                          float *                _hq,
+                          float *                _xi,
+                          float *                _xq,
+                          unsigned int           _n,
+                          liquid_float_complex * _y)
+{
+    float rii = 0.0f;   // sum hi*xi
+    float rqq = 0.0f;   // sum hq*xq
+    float riq = 0.0f;   // sum hi*xq
+    float rqi = 0.0f;   // sum hq*xi
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        rii += _hi[i] * _xi[i];
+        rqq += _hq[i] * _xq[i];
+        riq += _hi[i] * _xq[i];
+        rqi += _hq[i] * _xi[i];
+    }
+    *_y = (rii - rqq) + _Complex_I*(riq + rqi);
+}
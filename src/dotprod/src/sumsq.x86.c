@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// sumsq.x86.c : floating-point sum of squares (x86, run-time dispatch)
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+// SSE2 kernel (x86-64 baseline)
+__attribute__((target("sse2")))
+static float liquid_sumsqf_sse2(float *      _v,
+                                unsigned int _n)
+{
+    __m128 v;   // input vector
+    __m128 s;   // squared terms
+    __m128 sum = _mm_setzero_ps(); // load zeros into sum register
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // load inputs into register (unaligned)
+        v = _mm_loadu_ps(&_v[i]);
+
+        // compute multiplication
+        s = _mm_mul_ps(v, v);
+
+        // parallel addition
+        sum = _mm_add_ps( sum, s );
+    }
+
+    // aligned output array
+    float w[4] __attribute__((aligned(16)));
+
+    // unload packed array
+    _mm_store_ps(w, sum);
+    float total = w[0] + w[1] + w[2] + w[3];
+
+    // cleanup
+    for (; i<_n; i++)
+        total += _v[i] * _v[i];
+
+    // set return value
+    return total;
+}
+
+// AVX-512 kernel with masked tail handling
+__attribute__((target("avx512f")))
+static float liquid_sumsqf_avx512f(float *      _v,
+                                   unsigned int _n)
+{
+    __m512 v;   // input vector
+    __m512 sum = _mm512_setzero_ps(); // load zeros into sum register
+
+    // t = 16*(floor(_n/16))
+    unsigned int t = (_n >> 4) << 4;
+
+    //
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        // load inputs into register (unaligned)
+        v = _mm512_loadu_ps(&_v[i]);
+
+        // square and accumulate
+        sum = _mm512_fmadd_ps(v, v, sum);
+    }
+
+    // handle remaining samples with a masked load
+    if (i < _n) {
+        __mmask16 mask = (__mmask16)((1U << (_n - i)) - 1);
+        v = _mm512_maskz_loadu_ps(mask, &_v[i]);
+        sum = _mm512_fmadd_ps(v, v, sum);
+    }
+
+    // fold down into single value and return
+    return _mm512_reduce_add_ps(sum);
+}
+
+// sum squares, run-time dispatch
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqf(float *      _v,
+                    unsigned int _n)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_AVX512F)
+        return liquid_sumsqf_avx512f(_v, _n);
+    return liquid_sumsqf_sse2(_v, _n);
+}
+
+// sum squares, basic loop
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqcf(float complex * _v,
+                     unsigned int    _n)
+{
+    // simple method: type cast input as real pointer, run double
+    // length sumsqf method
+    float * v = (float*) _v;
+    return liquid_sumsqf(v, 2*_n);
+}
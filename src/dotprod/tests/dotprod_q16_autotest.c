@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: fixed-point (Q.15) dot product against floating-point reference
+//
+void autotest_dotprod_rrrq16_vs_float()
+{
+    unsigned int n = 32;
+    float tol = 2.0f / 32768.0f;    // two quantization steps
+
+    // generate random values on (-0.5, 0.5) to avoid accumulator overflow
+    float        hf[n];
+    float        xf[n];
+    int16_t      h[n];
+    int16_t      x[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        hf[i] = 0.1f * randnf();
+        xf[i] = 0.1f * randnf();
+        h[i]  = (int16_t)roundf(hf[i] * 32768.0f);
+        x[i]  = (int16_t)roundf(xf[i] * 32768.0f);
+
+        // use the quantized values as reference
+        hf[i] = (float)h[i] / 32768.0f;
+        xf[i] = (float)x[i] / 32768.0f;
+    }
+
+    // compute floating-point reference
+    float yf;
+    dotprod_rrrf_run(hf, xf, n, &yf);
+
+    // ordinal methods
+    int16_t y;
+    dotprod_rrrq16_run(h, x, n, &y);
+    CONTEND_DELTA((float)y / 32768.0f, yf, tol);
+
+    dotprod_rrrq16_run4(h, x, n, &y);
+    CONTEND_DELTA((float)y / 32768.0f, yf, tol);
+
+    // structured object
+    dotprod_rrrq16 q = dotprod_rrrq16_create(h, n);
+    dotprod_rrrq16_execute(q, x, &y);
+    CONTEND_DELTA((float)y / 32768.0f, yf, tol);
+    dotprod_rrrq16_destroy(q);
+}
+
+//
+// AUTOTEST: fixed-point (Q.31) dot product against floating-point reference
+//
+void autotest_dotprod_rrrq32_vs_float()
+{
+    unsigned int n = 32;
+    float tol = 1e-6f;
+
+    // generate random values on (-0.5, 0.5) to avoid accumulator overflow
+    float        hf[n];
+    float        xf[n];
+    int32_t      h[n];
+    int32_t      x[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        hf[i] = 0.1f * randnf();
+        xf[i] = 0.1f * randnf();
+        h[i]  = (int32_t)roundf(hf[i] * 2147483648.0f);
+        x[i]  = (int32_t)roundf(xf[i] * 2147483648.0f);
+
+        // use the quantized values as reference
+        hf[i] = (float)h[i] / 2147483648.0f;
+        xf[i] = (float)x[i] / 2147483648.0f;
+    }
+
+    // compute floating-point reference
+    float yf;
+    dotprod_rrrf_run(hf, xf, n, &yf);
+
+    // ordinal methods
+    int32_t y;
+    dotprod_rrrq32_run(h, x, n, &y);
+    CONTEND_DELTA((float)y / 2147483648.0f, yf, tol);
+
+    dotprod_rrrq32_run4(h, x, n, &y);
+    CONTEND_DELTA((float)y / 2147483648.0f, yf, tol);
+
+    // structured object
+    dotprod_rrrq32 q = dotprod_rrrq32_create(h, n);
+    dotprod_rrrq32_execute(q, x, &y);
+    CONTEND_DELTA((float)y / 2147483648.0f, yf, tol);
+    dotprod_rrrq32_destroy(q);
+}
+
+//
+// AUTOTEST: interleaved complex Q.15 dot product against floating-point
+//           reference
+//
+void autotest_dotprod_crcq16_vs_float()
+{
+    unsigned int n = 32;
+    float tol = 2.0f / 32768.0f;    // two quantization steps
+
+    // generate random values on (-0.5, 0.5) to avoid accumulator overflow
+    float         hf[n];
+    float complex xf[n];
+    int16_t       h[n];
+    int16_t       x[2*n];   // interleaved i/q
+    unsigned int  i;
+    for (i=0; i<n; i++) {
+        hf[i] = 0.1f * randnf();
+        xf[i] = 0.1f * randnf() + 0.1f * randnf() * _Complex_I;
+        h[i]     = (int16_t)roundf(hf[i]        * 32768.0f);
+        x[2*i  ] = (int16_t)roundf(crealf(xf[i])* 32768.0f);
+        x[2*i+1] = (int16_t)roundf(cimagf(xf[i])* 32768.0f);
+
+        // use the quantized values as reference
+        hf[i] = (float)h[i] / 32768.0f;
+        xf[i] = ((float)x[2*i] + (float)x[2*i+1]*_Complex_I) / 32768.0f;
+    }
+
+    // compute floating-point reference
+    float complex yf;
+    dotprod_crcf_run(hf, xf, n, &yf);
+
+    // ordinal methods
+    int16_t y[2];
+    dotprod_crcq16_run(h, x, n, y);
+    CONTEND_DELTA((float)y[0] / 32768.0f, crealf(yf), tol);
+    CONTEND_DELTA((float)y[1] / 32768.0f, cimagf(yf), tol);
+
+    dotprod_crcq16_run4(h, x, n, y);
+    CONTEND_DELTA((float)y[0] / 32768.0f, crealf(yf), tol);
+    CONTEND_DELTA((float)y[1] / 32768.0f, cimagf(yf), tol);
+
+    // structured object
+    dotprod_crcq16 q = dotprod_crcq16_create(h, n);
+    dotprod_crcq16_execute(q, x, y);
+    CONTEND_DELTA((float)y[0] / 32768.0f, crealf(yf), tol);
+    CONTEND_DELTA((float)y[1] / 32768.0f, cimagf(yf), tol);
+    dotprod_crcq16_destroy(q);
+}
+
+//
+// AUTOTEST: Q.15 sum of squares against floating-point reference
+//
+void autotest_sumsqq16()
+{
+    unsigned int n = 64;
+    float tol = 1e-3f;
+
+    float        vf[n];
+    int16_t      v[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        vf[i] = 0.2f * randnf();
+        v[i]  = (int16_t)roundf(vf[i] * 32768.0f);
+        vf[i] = (float)v[i] / 32768.0f;
+    }
+
+    CONTEND_DELTA(liquid_sumsqq16(v, n), liquid_sumsqf(vf, n), tol);
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Decision-feedback equalizer (DFE) with LMS adaptation
+//
+// The feedforward section filters received samples and the feedback
+// section filters past decisions; both sections are adapted jointly
+// in a single pass from the common a priori error, normalized by the
+// combined energy of both filter inputs. The push/execute/step flow
+// matches eqlms_cccf, with the decision entering the feedback buffer
+// inside step().
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+struct eqdfe_cccf_s {
+    unsigned int    nff;        // feedforward filter length
+    unsigned int    nfb;        // feedback filter length
+    float           mu;         // LMS step size
+
+    float complex * wf;         // feedforward weights [nff x 1]
+    float complex * wb;         // feedback weights [nfb x 1]
+
+    windowcf        buf_ff;     // received sample buffer
+    windowcf        buf_fb;     // past decision buffer (NULL if nfb==0)
+
+    unsigned int    count;      // input sample count
+    int             buf_full;   // input buffer full flag
+    wdelayf         x2;         // buffer of |x|^2 values
+    float           x2_sum;     // sum{ |x|^2 } over feedforward window
+    wdelayf         d2;         // buffer of |d|^2 values (NULL if nfb==0)
+    float           d2_sum;     // sum{ |d|^2 } over feedback window
+};
+
+// create decision-feedback equalizer object
+//  _nff    :   feedforward filter length (received samples), _nff > 0
+//  _nfb    :   feedback filter length (past decisions)
+eqdfe_cccf eqdfe_cccf_create(unsigned int _nff,
+                             unsigned int _nfb)
+{
+    // validate input
+    if (_nff == 0) {
+        fprintf(stderr,"error: eqdfe_cccf_create(), feedforward filter length must be greater than 0\n");
+        exit(1);
+    }
+
+    eqdfe_cccf q = (eqdfe_cccf) malloc(sizeof(struct eqdfe_cccf_s));
+
+    // set filter lengths, other params
+    q->nff = _nff;
+    q->nfb = _nfb;
+    q->mu  = 0.5f;
+
+    // allocate weights and buffers; with no feedback taps the object
+    // degenerates to a linear LMS equalizer
+    q->wf     = (float complex*) malloc((q->nff)*sizeof(float complex));
+    q->wb     = q->nfb > 0 ? (float complex*) malloc((q->nfb)*sizeof(float complex)) : NULL;
+    q->buf_ff = windowcf_create(q->nff);
+    q->buf_fb = q->nfb > 0 ? windowcf_create(q->nfb) : NULL;
+    q->x2     = wdelayf_create(q->nff);
+    q->d2     = q->nfb > 0 ? wdelayf_create(q->nfb) : NULL;
+
+    // reset equalizer object
+    eqdfe_cccf_reset(q);
+
+    // return main object
+    return q;
+}
+
+// destroy equalizer object
+void eqdfe_cccf_destroy(eqdfe_cccf _q)
+{
+    free(_q->wf);
+    free(_q->wb);
+
+    windowcf_destroy(_q->buf_ff);
+    wdelayf_destroy(_q->x2);
+    if (_q->nfb > 0) {
+        windowcf_destroy(_q->buf_fb);
+        wdelayf_destroy(_q->d2);
+    }
+    free(_q);
+}
+
+// reset equalizer: feedforward delta response, cleared feedback taps
+void eqdfe_cccf_reset(eqdfe_cccf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->nff; i++)
+        _q->wf[i] = (i==0) ? 1.0f : 0.0f;
+    for (i=0; i<_q->nfb; i++)
+        _q->wb[i] = 0.0f;
+
+    windowcf_reset(_q->buf_ff);
+    wdelayf_reset(_q->x2);
+    if (_q->nfb > 0) {
+        windowcf_reset(_q->buf_fb);
+        wdelayf_reset(_q->d2);
+    }
+
+    // reset input count
+    _q->count = 0;
+    _q->buf_full = 0;
+
+    // reset squared magnitude sums
+    _q->x2_sum = 0;
+    _q->d2_sum = 0;
+}
+
+// print equalizer internals
+void eqdfe_cccf_print(eqdfe_cccf _q)
+{
+    printf("equalizer (DFE):\n");
+    printf("    feedforward:%u\n", _q->nff);
+    printf("    feedback:   %u\n", _q->nfb);
+    unsigned int i;
+    for (i=0; i<_q->nff; i++)
+        printf("  f(%3u) = %12.4e + j*%12.4e;\n", i+1, crealf(_q->wf[i]), cimagf(_q->wf[i]));
+    for (i=0; i<_q->nfb; i++)
+        printf("  b(%3u) = %12.4e + j*%12.4e;\n", i+1, crealf(_q->wb[i]), cimagf(_q->wb[i]));
+}
+
+// get learning rate of equalizer
+float eqdfe_cccf_get_bw(eqdfe_cccf _q)
+{
+    return _q->mu;
+}
+
+// set learning rate of equalizer
+//  _q      :   equalizer object
+//  _mu     :   LMS learning rate (should be near 0), _mu > 0
+void eqdfe_cccf_set_bw(eqdfe_cccf _q,
+                       float      _mu)
+{
+    if (_mu < 0.0f) {
+        fprintf(stderr,"error: eqdfe_cccf_set_bw(), learning rate cannot be less than zero\n");
+        exit(1);
+    }
+
+    _q->mu = _mu;
+}
+
+// push received sample into equalizer internal buffer
+//  _q      :   equalizer object
+//  _x      :   received sample
+void eqdfe_cccf_push(eqdfe_cccf    _q,
+                     float complex _x)
+{
+    // push value into buffer
+    windowcf_push(_q->buf_ff, _x);
+
+    // update sum{|x|^2}
+    float x2_n = crealf(_x * conjf(_x));
+    float x2_0;
+    wdelayf_push(_q->x2, x2_n);
+    wdelayf_read(_q->x2, &x2_0);
+    _q->x2_sum = _q->x2_sum + x2_n - x2_0;
+
+    // increment count
+    _q->count++;
+}
+
+// execute internal dot products over both sections
+//  _q      :   equalizer object
+//  _y      :   output sample
+void eqdfe_cccf_execute(eqdfe_cccf      _q,
+                        float complex * _y)
+{
+    float complex y = 0;    // temporary accumulator
+    float complex * r;      // read buffer
+    unsigned int i;
+
+    // feedforward section: conjugate dot product over received samples
+    windowcf_read(_q->buf_ff, &r);
+    for (i=0; i<_q->nff; i++)
+        y += conjf(_q->wf[i])*r[i];
+
+    // feedback section: conjugate dot product over past decisions
+    if (_q->nfb > 0) {
+        windowcf_read(_q->buf_fb, &r);
+        for (i=0; i<_q->nfb; i++)
+            y += conjf(_q->wb[i])*r[i];
+    }
+
+    // set output
+    *_y = y;
+}
+
+// step through one cycle of equalizer training: adapt both sections
+// jointly from the common error, then feed the decision back
+//  _q      :   equalizer object
+//  _d      :   desired output (decision)
+//  _d_hat  :   filtered output
+void eqdfe_cccf_step(eqdfe_cccf    _q,
+                     float complex _d,
+                     float complex _d_hat)
+{
+    unsigned int i;
+    float complex * r;      // read buffer
+
+    // only adapt once the feedforward buffer is full
+    int adapt = 1;
+    if (!_q->buf_full) {
+        if (_q->count < _q->nff)
+            adapt = 0;
+        else
+            _q->buf_full = 1;
+    }
+
+    if (adapt) {
+        // compute error (a priori), normalized by the combined energy
+        // of both filter inputs in a single joint adaptation pass
+        float complex alpha = conjf(_d - _d_hat);
+        float gamma = _q->mu / (_q->x2_sum + _q->d2_sum);
+
+        // update feedforward weights
+        windowcf_read(_q->buf_ff, &r);
+        for (i=0; i<_q->nff; i++)
+            _q->wf[i] += gamma*alpha*r[i];
+
+        // update feedback weights
+        if (_q->nfb > 0) {
+            windowcf_read(_q->buf_fb, &r);
+            for (i=0; i<_q->nfb; i++)
+                _q->wb[i] += gamma*alpha*r[i];
+        }
+    }
+
+    // push decision into feedback buffer
+    if (_q->nfb > 0) {
+        windowcf_push(_q->buf_fb, _d);
+
+        // update sum{|d|^2}
+        float d2_n = crealf(_d * conjf(_d));
+        float d2_0;
+        wdelayf_push(_q->d2, d2_n);
+        wdelayf_read(_q->d2, &d2_0);
+        _q->d2_sum = _q->d2_sum + d2_n - d2_0;
+    }
+}
+
+// step through one cycle of equalizer training (blind), slicing the
+// output to the unit circle as with eqlms
+//  _q      :   equalizer object
+//  _d_hat  :   filtered output
+void eqdfe_cccf_step_blind(eqdfe_cccf    _q,
+                           float complex _d_hat)
+{
+    // update equalizer using constant modulus method
+    float complex d = _d_hat / cabsf(_d_hat);
+    eqdfe_cccf_step(_q, d, _d_hat);
+}
+
+// retrieve internal filter coefficients
+//  _q      :   equalizer object
+//  _wf     :   feedforward weights [size: _nff x 1]
+//  _wb     :   feedback weights [size: _nfb x 1]
+void eqdfe_cccf_get_weights(eqdfe_cccf      _q,
+                            float complex * _wf,
+                            float complex * _wb)
+{
+    unsigned int i;
+    for (i=0; i<_q->nff; i++)
+        _wf[i] = conjf(_q->wf[_q->nff-i-1]);
+    for (i=0; i<_q->nfb; i++)
+        _wb[i] = conjf(_q->wb[_q->nfb-i-1]);
+}
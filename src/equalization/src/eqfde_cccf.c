@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Frequency-domain block LMS equalizer (overlap-save)
+//
+// Filtering and adaptation both operate on blocks of h_len samples
+// using transforms of size 2*h_len: the input block is filtered by
+// per-bin complex gains, and the tap gradient is computed in the
+// frequency domain with per-bin normalization (constrained FDAF).
+// For long equalizers this replaces the O(h_len) per-sample cost of
+// eqlms with O(log h_len).
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+struct eqfde_cccf_s {
+    unsigned int    h_len;      // filter length (time-domain taps)
+    unsigned int    nfft;       // transform size (2*h_len)
+    float           mu;         // LMS step size
+
+    // frequency-domain state
+    float complex * W;          // per-bin equalizer gains [nfft]
+    float complex * X;          // transform of current input window [nfft]
+
+    // transform buffers and plans
+    float complex * buf_time;   // time-domain scratch [nfft]
+    float complex * buf_freq;   // frequency-domain scratch [nfft]
+    fftplan         fft;        // forward transform (buf_time -> buf_freq)
+    fftplan         ifft;       // inverse transform (buf_freq -> buf_time)
+
+    // input history for overlap-save
+    float complex * x_hist;     // previous and current block [nfft]
+};
+
+// create frequency-domain equalizer object
+//  _h_len  :   equalizer length (number of time-domain taps), _h_len > 0
+eqfde_cccf eqfde_cccf_create(unsigned int _h_len)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: eqfde_cccf_create(), filter length must be greater than 0\n");
+        exit(1);
+    }
+
+    eqfde_cccf q = (eqfde_cccf) malloc(sizeof(struct eqfde_cccf_s));
+
+    // set filter order, other params
+    q->h_len = _h_len;
+    q->nfft  = 2*q->h_len;
+    q->mu    = 0.5f;
+
+    // allocate internal buffers
+    q->W        = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->X        = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->buf_time = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->buf_freq = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->x_hist   = (float complex*) malloc((q->nfft)*sizeof(float complex));
+
+    // create transform plans
+    q->fft  = fft_create_plan(q->nfft, q->buf_time, q->buf_freq, LIQUID_FFT_FORWARD,  0);
+    q->ifft = fft_create_plan(q->nfft, q->buf_freq, q->buf_time, LIQUID_FFT_BACKWARD, 0);
+
+    // reset equalizer object
+    eqfde_cccf_reset(q);
+
+    // return main object
+    return q;
+}
+
+// destroy equalizer object
+void eqfde_cccf_destroy(eqfde_cccf _q)
+{
+    fft_destroy_plan(_q->fft);
+    fft_destroy_plan(_q->ifft);
+
+    free(_q->W);
+    free(_q->X);
+    free(_q->buf_time);
+    free(_q->buf_freq);
+    free(_q->x_hist);
+    free(_q);
+}
+
+// reset equalizer: pass-through response, cleared input history
+void eqfde_cccf_reset(eqfde_cccf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++)
+        _q->W[i] = 1.0f;
+
+    memset(_q->X,      0x00, (_q->nfft)*sizeof(float complex));
+    memset(_q->x_hist, 0x00, (_q->nfft)*sizeof(float complex));
+}
+
+// print equalizer internals
+void eqfde_cccf_print(eqfde_cccf _q)
+{
+    printf("equalizer (frequency-domain block LMS):\n");
+    printf("    order:      %u\n", _q->h_len);
+    printf("    nfft:       %u\n", _q->nfft);
+    printf("    mu:         %12.8f\n", _q->mu);
+}
+
+// get block length (samples consumed/produced per block)
+unsigned int eqfde_cccf_get_block_len(eqfde_cccf _q)
+{
+    return _q->h_len;
+}
+
+// get learning rate of equalizer
+float eqfde_cccf_get_bw(eqfde_cccf _q)
+{
+    return _q->mu;
+}
+
+// set learning rate of equalizer
+//  _q      :   equalizer object
+//  _mu     :   LMS learning rate (should be near 0), _mu > 0
+void eqfde_cccf_set_bw(eqfde_cccf _q,
+                       float      _mu)
+{
+    if (_mu < 0.0f) {
+        fprintf(stderr,"error: eqfde_cccf_set_bw(), learning rate cannot be less than zero\n");
+        exit(1);
+    }
+
+    _q->mu = _mu;
+}
+
+// retrieve internal time-domain filter coefficients
+//  _q      :   equalizer object
+//  _w      :   output weights [size: _h_len x 1]
+void eqfde_cccf_get_weights(eqfde_cccf      _q,
+                            float complex * _w)
+{
+    // inverse transform of per-bin gains; taps occupy the first
+    // h_len samples by the gradient constraint
+    memmove(_q->buf_freq, _q->W, (_q->nfft)*sizeof(float complex));
+    fft_execute(_q->ifft);
+
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++)
+        _w[i] = _q->buf_time[i] / (float)(_q->nfft);
+}
+
+// filter a single block of h_len samples (overlap-save), leaving
+// per-bin gains unmodified; the transform of the input window is
+// retained internally for subsequent adaptation
+//  _q      :   equalizer object
+//  _x      :   input sample block [size: h_len x 1]
+//  _y      :   output sample block [size: h_len x 1]
+void eqfde_cccf_execute(eqfde_cccf      _q,
+                        float complex * _x,
+                        float complex * _y)
+{
+    unsigned int i;
+    unsigned int M = _q->h_len;
+
+    // shift input history and append new block
+    memmove(_q->x_hist, _q->x_hist + M, M*sizeof(float complex));
+    memmove(_q->x_hist + M, _x,         M*sizeof(float complex));
+
+    // transform input window
+    memmove(_q->buf_time, _q->x_hist, (_q->nfft)*sizeof(float complex));
+    fft_execute(_q->fft);
+    memmove(_q->X, _q->buf_freq, (_q->nfft)*sizeof(float complex));
+
+    // apply per-bin gains and inverse transform
+    for (i=0; i<_q->nfft; i++)
+        _q->buf_freq[i] = _q->W[i] * _q->X[i];
+    fft_execute(_q->ifft);
+
+    // retain last M samples (overlap-save discards the first M)
+    float g = 1.0f / (float)(_q->nfft);
+    for (i=0; i<M; i++)
+        _y[i] = _q->buf_time[M+i] * g;
+}
+
+// filter a block of samples without adaptation
+//  _q      :   equalizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   input array length (multiple of block length)
+//  _y      :   output sample array [size: _n x 1]
+void eqfde_cccf_execute_block(eqfde_cccf      _q,
+                              float complex * _x,
+                              unsigned int    _n,
+                              float complex * _y)
+{
+    // validate input
+    if (_n % _q->h_len) {
+        fprintf(stderr,"error: eqfde_cccf_execute_block(), input length must be a multiple of the block length\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    for (i=0; i<_n; i+=_q->h_len)
+        eqfde_cccf_execute(_q, _x+i, _y+i);
+}
+
+// step through one block of equalizer training: filter the block,
+// then update the per-bin gains from the error using normalized
+// frequency-domain gradient descent with the gradient constrained to
+// h_len causal taps
+//  _q      :   equalizer object
+//  _x      :   received sample block [size: h_len x 1]
+//  _d      :   desired output block [size: h_len x 1]
+//  _d_hat  :   output sample block [size: h_len x 1]
+void eqfde_cccf_step(eqfde_cccf      _q,
+                     float complex * _x,
+                     float complex * _d,
+                     float complex * _d_hat)
+{
+    unsigned int i;
+    unsigned int M = _q->h_len;
+
+    // filter block (also updates internal input transform)
+    eqfde_cccf_execute(_q, _x, _d_hat);
+
+    // transform error block, zero-padded to align with the output
+    // position in the overlap-save window
+    memset(_q->buf_time, 0x00, M*sizeof(float complex));
+    for (i=0; i<M; i++)
+        _q->buf_time[M+i] = _d[i] - _d_hat[i];
+    fft_execute(_q->fft);
+
+    // per-bin normalized gradient
+    for (i=0; i<_q->nfft; i++) {
+        float x2 = crealf( _q->X[i] * conjf(_q->X[i]) );
+        _q->buf_freq[i] = conjf(_q->X[i]) * _q->buf_freq[i] / (x2 + 1e-6f);
+    }
+
+    // constrain gradient to h_len causal taps: inverse transform,
+    // zero the tail, transform back
+    fft_execute(_q->ifft);
+    float g = 1.0f / (float)(_q->nfft);
+    for (i=0; i<M; i++)
+        _q->buf_time[i] *= g;
+    memset(_q->buf_time + M, 0x00, M*sizeof(float complex));
+    fft_execute(_q->fft);
+
+    // apply update
+    for (i=0; i<_q->nfft; i++)
+        _q->W[i] += _q->mu * _q->buf_freq[i];
+}
+
+// step through a group of blocks of equalizer training
+//  _q      :   equalizer object
+//  _x      :   received sample array [size: _n x 1]
+//  _d      :   desired output array [size: _n x 1]
+//  _n      :   input array length (multiple of block length)
+//  _d_hat  :   output sample array [size: _n x 1]
+void eqfde_cccf_step_block(eqfde_cccf      _q,
+                           float complex * _x,
+                           float complex * _d,
+                           unsigned int    _n,
+                           float complex * _d_hat)
+{
+    // validate input
+    if (_n % _q->h_len) {
+        fprintf(stderr,"error: eqfde_cccf_step_block(), input length must be a multiple of the block length\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    for (i=0; i<_n; i+=_q->h_len)
+        eqfde_cccf_step(_q, _x+i, _d+i, _d_hat+i);
+}
@@ -380,6 +380,61 @@ void EQLMS(_step)(EQLMS() _q,
     memmove(_q->w0, _q->w1, _q->h_len*sizeof(T));
 }
 
+// step through a block of training cycles (block LMS): compute the
+// filter output for each sample, accumulate the tap gradient across
+// the block, and apply a single update with the normalization (signal
+// energy estimate) computed once per block
+//  _q      :   equalizer object
+//  _x      :   received sample array [size: _n x 1]
+//  _d      :   desired output array [size: _n x 1]
+//  _n      :   input array length
+//  _d_hat  :   output sample array [size: _n x 1]
+void EQLMS(_step_block)(EQLMS()      _q,
+                        T *          _x,
+                        T *          _d,
+                        unsigned int _n,
+                        T *          _d_hat)
+{
+    unsigned int i;
+    unsigned int j;
+
+    // clear gradient accumulator
+    T g[_q->h_len];
+    for (i=0; i<_q->h_len; i++)
+        g[i] = 0;
+
+    unsigned int num_updates = 0;
+    for (j=0; j<_n; j++) {
+        // push sample and compute output with current weights
+        EQLMS(_push)(_q, _x[j]);
+        EQLMS(_execute)(_q, &_d_hat[j]);
+
+        // only accumulate gradient once buffer is full
+        if (!_q->buf_full) {
+            if (_q->count < _q->h_len)
+                continue;
+            else
+                _q->buf_full = 1;
+        }
+
+        // compute error (a priori) and accumulate gradient
+        T alpha = conj(_d[j] - _d_hat[j]);
+        T * r;      // read buffer
+        WINDOW(_read)(_q->buffer, &r);
+        for (i=0; i<_q->h_len; i++)
+            g[i] += alpha * r[i];
+        num_updates++;
+    }
+
+    // apply deferred update, normalizing by the energy estimate once
+    // per block rather than once per sample
+    if (num_updates == 0)
+        return;
+    float gamma = _q->mu / _q->x2_sum;
+    for (i=0; i<_q->h_len; i++)
+        _q->w0[i] += gamma * g[i];
+}
+
 // step through one cycle of equalizer training
 //  _q      :   equalizer object
 //  _d_hat  :   filtered output
@@ -404,6 +459,52 @@ void EQLMS(_get_weights)(EQLMS() _q, T * _w)
         _w[i] = conj(_q->w0[_q->h_len-i-1]);
 }
 
+// get size of serialized equalizer state [bytes]
+unsigned int EQLMS(_get_state_size)(EQLMS() _q)
+{
+    return _q->h_len*sizeof(T);
+}
+
+// save converged equalizer weights into buffer for later warm start;
+// the input sample buffer is not included as it refills within h_len
+// samples of operation
+//  _q       : equalizer object
+//  _buf     : output buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match EQLMS(_get_state_size)
+void EQLMS(_save_state)(EQLMS()         _q,
+                        unsigned char * _buf,
+                        unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != EQLMS(_get_state_size)(_q)) {
+        fprintf(stderr,"error: eqlms_%s_save_state(), invalid buffer length %u (expected %u)\n",
+                EXTENSION_FULL, _buf_len, EQLMS(_get_state_size)(_q));
+        exit(1);
+    }
+
+    memmove(_buf, _q->w0, _q->h_len*sizeof(T));
+}
+
+// restore equalizer weights previously saved with EQLMS(_save_state),
+// skipping cold-start convergence; the object must have the same
+// filter length as the one the state was saved from
+//  _q       : equalizer object
+//  _buf     : input buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match EQLMS(_get_state_size)
+void EQLMS(_restore_state)(EQLMS()         _q,
+                           unsigned char * _buf,
+                           unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != EQLMS(_get_state_size)(_q)) {
+        fprintf(stderr,"error: eqlms_%s_restore_state(), invalid buffer length %u (expected %u)\n",
+                EXTENSION_FULL, _buf_len, EQLMS(_get_state_size)(_q));
+        exit(1);
+    }
+
+    memmove(_q->w0, _buf, _q->h_len*sizeof(T));
+}
+
 // train equalizer object
 //  _q      :   equalizer object
 //  _w      :   initial weights / output weights
@@ -24,6 +24,7 @@
 // Recursive least-squares (RLS) equalizer
 //
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -50,8 +51,20 @@ struct EQRLS(_s) {
 
     unsigned int n;     // input counter
     WINDOW() buffer;    // input buffer
+
+    // dichotomous coordinate descent (DCD) engine
+    int          dcd;           // DCD engine selected?
+    T *          R;             // correlation matrix [pxp]
+    T *          beta;          // residual vector [px1]
+    T *          dw;            // weight increment [px1]
+    float        dcd_h;         // maximum step amplitude
+    unsigned int dcd_bits;      // number of step-halving levels
+    unsigned int dcd_updates;   // maximum coordinate updates per step
 };
 
+// step through one cycle of equalizer training (DCD engine)
+void EQRLS(_step_dcd)(EQRLS() _q, T _d, T _d_hat);
+
 
 // create recursive least-squares (RLS) equalizer object
 //  _h      :   initial coefficients [size: _p x 1], default if NULL
@@ -80,6 +93,12 @@ EQRLS() EQRLS(_create)(T *          _h,
 
     q->buffer = WINDOW(_create)(q->p);
 
+    // DCD engine disabled by default
+    q->dcd  = 0;
+    q->R    = NULL;
+    q->beta = NULL;
+    q->dw   = NULL;
+
     // copy coefficients (if not NULL)
     if (_h == NULL) {
         // initial coefficients with delta at first index
@@ -99,6 +118,37 @@ EQRLS() EQRLS(_create)(T *          _h,
 }
 
 
+// create RLS equalizer object with the dichotomous coordinate descent
+// (DCD) engine: the inverse-correlation recursion is replaced with a
+// correlation/residual recursion solved by power-of-two coordinate
+// updates, giving RLS-class convergence without the O(p^3) matrix
+// update per symbol
+//  _h      :   initial coefficients [size: _p x 1], default if NULL
+//  _p      :   equalizer length (number of taps)
+EQRLS() EQRLS(_create_dcd)(T *          _h,
+                           unsigned int _p)
+{
+    EQRLS() q = EQRLS(_create)(_h, _p);
+
+    // select DCD engine and allocate its state
+    q->dcd  = 1;
+    q->R    = (T*) malloc((q->p)*(q->p)*sizeof(T));
+    q->beta = (T*) malloc((q->p)*sizeof(T));
+    q->dw   = (T*) malloc((q->p)*sizeof(T));
+
+    // solver parameters: maximum step amplitude, number of
+    // step-halving levels, coordinate updates per input sample
+    q->dcd_h       = 1.0f;
+    q->dcd_bits    = 16;
+    q->dcd_updates = 8;
+
+    // reset again to initialize DCD state
+    EQRLS(_reset)(q);
+
+    // return object
+    return q;
+}
+
 // re-create recursive least-squares (RLS) equalizer object
 //  _q  : old equalizer object
 //  _h  : filter coefficients (NULL for {1,0,0...})
@@ -116,11 +166,14 @@ EQRLS() EQRLS(_recreate)(EQRLS()      _q,
         return _q;
     }
 
+    // retain engine selection
+    int dcd = _q->dcd;
+
     // completely destroy old equalizer object
     EQRLS(_destroy)(_q);
 
     // create new one and return
-    return EQRLS(_create)(_h,_p);
+    return dcd ? EQRLS(_create_dcd)(_h,_p) : EQRLS(_create)(_h,_p);
 }
 
 // destroy eqrls object
@@ -138,6 +191,10 @@ void EQRLS(_destroy)(EQRLS() _q)
     free(_q->gxl);
     free(_q->gxlP0);
 
+    free(_q->R);
+    free(_q->beta);
+    free(_q->dw);
+
     // destroy window buffer
     WINDOW(_destroy)(_q->buffer);
 
@@ -194,6 +251,16 @@ void EQRLS(_reset)(EQRLS() _q)
         }
     }
 
+    // initialize DCD engine state: regularized correlation matrix,
+    // cleared residual vector
+    if (_q->dcd) {
+        for (i=0; i<_q->p; i++) {
+            for (j=0; j<_q->p; j++)
+                _q->R[(_q->p)*i + j] = (i==j) ? _q->delta : 0;
+            _q->beta[i] = 0;
+        }
+    }
+
     // copy default coefficients
     memmove(_q->w0, _q->h0, (_q->p)*sizeof(T));
 
@@ -253,6 +320,12 @@ void EQRLS(_step)(EQRLS() _q,
                   T       _d,
                   T       _d_hat)
 {
+    // dispatch to DCD engine if selected
+    if (_q->dcd) {
+        EQRLS(_step_dcd)(_q, _d, _d_hat);
+        return;
+    }
+
     unsigned int i,r,c;
     unsigned int p=_q->p;
 
@@ -356,6 +429,95 @@ void EQRLS(_step)(EQRLS() _q,
 
 }
 
+// execute cycle of equalizer training (DCD engine): update the
+// correlation matrix and residual vector directly and approximately
+// solve R*dw = beta with power-of-two coordinate updates, leaving the
+// solution residual in beta for the next cycle
+//  _q      :   equalizer object
+//  _d      :   desired output
+//  _d_hat  :   filtered output
+void EQRLS(_step_dcd)(EQRLS() _q,
+                      T       _d,
+                      T       _d_hat)
+{
+    unsigned int i,k;
+    unsigned int p=_q->p;
+
+    // compute error (a priori)
+    T alpha = _d - _d_hat;
+
+    // read buffer
+    T * x;
+    WINDOW(_read)(_q->buffer, &x);
+
+    // update correlation matrix, R = lambda*[R] + [conj(x)]*[x.']
+    for (i=0; i<p; i++) {
+        for (k=0; k<p; k++) {
+            matrix_access(_q->R,p,p,i,k) =
+                _q->lambda * matrix_access(_q->R,p,p,i,k) + conj(x[i])*x[k];
+        }
+    }
+
+    // update residual vector, beta = lambda*[beta] + alpha*[conj(x)]
+    for (i=0; i<p; i++)
+        _q->beta[i] = _q->lambda * _q->beta[i] + alpha*conj(x[i]);
+
+    // clear weight increment
+    for (i=0; i<p; i++)
+        _q->dw[i] = 0;
+
+    // cyclic coordinate descent: adjust one weight component at a time
+    // by the current power-of-two step, halving the step once no
+    // component exceeds its threshold
+    float step = _q->dcd_h;
+    unsigned int num_bits    = 0;
+    unsigned int num_updates = 0;
+    while (num_bits < _q->dcd_bits && num_updates < _q->dcd_updates) {
+        int updated = 0;
+        for (k=0; k<p; k++) {
+            float Rkk = creal(matrix_access(_q->R,p,p,k,k));
+
+            // real component
+            float br = creal(_q->beta[k]);
+            if (fabsf(br) > 0.5f*step*Rkk) {
+                T ds = br > 0 ? step : -step;
+                _q->dw[k] += ds;
+                for (i=0; i<p; i++)
+                    _q->beta[i] -= ds * matrix_access(_q->R,p,p,i,k);
+                updated = 1;
+                if (++num_updates == _q->dcd_updates)
+                    break;
+            }
+
+#if T_COMPLEX
+            // imaginary component
+            float bi = cimag(_q->beta[k]);
+            if (fabsf(bi) > 0.5f*step*Rkk) {
+                T ds = (bi > 0 ? step : -step) * _Complex_I;
+                _q->dw[k] += ds;
+                for (i=0; i<p; i++)
+                    _q->beta[i] -= ds * matrix_access(_q->R,p,p,i,k);
+                updated = 1;
+                if (++num_updates == _q->dcd_updates)
+                    break;
+            }
+#endif
+        }
+        if (!updated) {
+            // no component updated at this step size; halve it
+            step *= 0.5f;
+            num_bits++;
+        }
+    }
+
+    // update weighting vector
+    for (i=0; i<p; i++)
+        _q->w1[i] = _q->w0[i] + _q->dw[i];
+
+    // copy old values
+    memmove(_q->w0, _q->w1, p*sizeof(T));
+}
+
 // retrieve internal filter coefficients
 //  _q      :   equalizer object
 //  _w      :   weights [size: _p x 1]
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: with no feedback taps the DFE matches the linear LMS
+//           equalizer exactly
+//
+void autotest_eqdfe_cccf_linear_equivalence()
+{
+    float        tol         = 1e-6f;   // error tolerance
+    unsigned int p           = 7;       // equalizer order
+    unsigned int num_samples = 80;      // number of samples to observe
+
+    // create linear LMS equalizer and feedback-free DFE
+    eqlms_cccf eq0 = eqlms_cccf_create(NULL, p);
+    eqdfe_cccf eq1 = eqdfe_cccf_create(p, 0);
+    eqlms_cccf_set_bw(eq0, 0.3f);
+    eqdfe_cccf_set_bw(eq1, 0.3f);
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(11);
+
+    unsigned int i;
+    float complex x, d, d_hat0, d_hat1;
+    for (i=0; i<num_samples; i++) {
+        // generate random sample and desired output
+        x = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+            ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        d = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+            ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+
+        // train both equalizers on the same data
+        eqlms_cccf_push   (eq0, x);
+        eqlms_cccf_execute(eq0, &d_hat0);
+        eqlms_cccf_step   (eq0, d, d_hat0);
+
+        eqdfe_cccf_push   (eq1, x);
+        eqdfe_cccf_execute(eq1, &d_hat1);
+        eqdfe_cccf_step   (eq1, d, d_hat1);
+
+        // outputs match exactly
+        CONTEND_DELTA( crealf(d_hat0), crealf(d_hat1), tol );
+        CONTEND_DELTA( cimagf(d_hat0), cimagf(d_hat1), tol );
+    }
+    msequence_destroy(ms);
+
+    // final weights match exactly
+    float complex w0[p];
+    float complex w1[p];
+    eqlms_cccf_get_weights(eq0, w0);
+    eqdfe_cccf_get_weights(eq1, w1, NULL);
+    for (i=0; i<p; i++) {
+        CONTEND_DELTA( crealf(w0[i]), crealf(w1[i]), tol );
+        CONTEND_DELTA( cimagf(w0[i]), cimagf(w1[i]), tol );
+    }
+
+    // clean up objects
+    eqlms_cccf_destroy(eq0);
+    eqdfe_cccf_destroy(eq1);
+}
+
+//
+// AUTOTEST: static channel filter, decision-directed training on QPSK
+//           symbols with feedback cancelling post-cursor interference
+//
+void autotest_eqdfe_cccf_static()
+{
+    // parameters
+    float           tol         =  2e-2f;   // error tolerance
+    unsigned int    nff         =  9;       // feedforward filter length
+    unsigned int    nfb         =  4;       // feedback filter length
+    unsigned int    delay       =  4;       // target equalizer delay (symbols)
+    float           mu          =  0.1f;    // equalizer bandwidth
+    unsigned int    num_symbols = 30000;    // number of symbols to observe
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(12);
+
+    // create equalizer
+    eqdfe_cccf eq = eqdfe_cccf_create(nff, nfb);
+    eqdfe_cccf_set_bw(eq, mu);
+
+    // create channel filter with significant post-cursor interference
+    float complex h[4] = {
+         1.00f +  0.00f*_Complex_I,
+         0.30f + -0.15f*_Complex_I,
+        -0.20f +  0.08f*_Complex_I,
+         0.10f +  0.05f*_Complex_I };
+    firfilt_cccf fchannel = firfilt_cccf_create(h,4);
+
+    // arrays
+    float complex sym_in [num_symbols]; // input symbols
+    float complex sym_out[num_symbols]; // equalized symbols
+
+    // run equalization, training on known symbols
+    unsigned int i;
+    float complex x, d;
+    for (i=0; i<num_symbols; i++) {
+        // generate input symbol and apply channel
+        sym_in[i]  = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 );
+        sym_in[i] += ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        firfilt_cccf_push   (fchannel, sym_in[i]);
+        firfilt_cccf_execute(fchannel, &x);
+
+        // desired output is input delayed to lie within the
+        // feedforward span
+        d = i < delay ? 0.0f : sym_in[i-delay];
+
+        // push received sample, filter, and adapt
+        eqdfe_cccf_push   (eq, x);
+        eqdfe_cccf_execute(eq, &sym_out[i]);
+        eqdfe_cccf_step   (eq, d, sym_out[i]);
+    }
+    msequence_destroy(ms);
+
+    // verify convergence over the last several symbols
+    unsigned int settling_delay = num_symbols - 200;
+    for (i=settling_delay; i<num_symbols; i++) {
+        float error = cabsf(sym_in[i-delay]-sym_out[i]);
+
+        if (liquid_autotest_verbose) {
+            printf("x[%4u] = {%12.8f,%12.8f}, y[%4u] = {%12.8f,%12.8f}, error=%12.8f %s\n",
+                    i-delay, crealf(sym_in[i-delay]), cimagf(sym_in[i-delay]),
+                    i,       crealf(sym_out[i]),      cimagf(sym_out[i]),
+                    error, error > tol ? "*" : "");
+        }
+
+        CONTEND_DELTA(error, 0.0f, tol);
+    }
+
+    // clean up objects
+    firfilt_cccf_destroy(fchannel);
+    eqdfe_cccf_destroy(eq);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: freshly-created equalizer passes samples through unmodified
+//
+void autotest_eqfde_cccf_passthrough()
+{
+    float        tol         = 1e-5f;   // error tolerance
+    unsigned int h_len       = 16;      // equalizer length
+    unsigned int num_samples = 128;     // number of samples to observe
+
+    // create equalizer (default pass-through response)
+    eqfde_cccf eq = eqfde_cccf_create(h_len);
+    CONTEND_EQUALITY( eqfde_cccf_get_block_len(eq), h_len );
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(11);
+
+    unsigned int i;
+    float complex x[num_samples];
+    float complex y[num_samples];
+    for (i=0; i<num_samples; i++) {
+        x[i]  = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 );
+        x[i] += ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+    }
+    msequence_destroy(ms);
+
+    // filter without adaptation
+    eqfde_cccf_execute_block(eq, x, num_samples, y);
+
+    // output matches input to within transform round-trip error
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y[i]), crealf(x[i]), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(x[i]), tol );
+    }
+
+    // initial weights are a delta at the first tap
+    float complex w[h_len];
+    eqfde_cccf_get_weights(eq, w);
+    CONTEND_DELTA( crealf(w[0]), 1.0f, tol );
+    CONTEND_DELTA( cimagf(w[0]), 0.0f, tol );
+    for (i=1; i<h_len; i++)
+        CONTEND_DELTA( cabsf(w[i]), 0.0f, tol );
+
+    // clean up objects
+    eqfde_cccf_destroy(eq);
+}
+
+//
+// AUTOTEST: static channel filter, block training on QPSK symbols
+//
+void autotest_eqfde_cccf_static()
+{
+    // parameters
+    float           tol         =  2e-2f;   // error tolerance
+    unsigned int    h_len       =  16;      // equalizer length (block length)
+    unsigned int    delay       =   4;      // target equalizer delay (symbols)
+    float           mu          =  0.20f;   // equalizer bandwidth
+    unsigned int    num_blocks  = 150;      // number of blocks to observe
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(12);
+
+    // create equalizer
+    eqfde_cccf eq = eqfde_cccf_create(h_len);
+    eqfde_cccf_set_bw(eq, mu);
+
+    // create channel filter (mild inter-symbol interference)
+    float complex h[4] = {
+         1.00f +  0.00f*_Complex_I,
+         0.08f + -0.05f*_Complex_I,
+        -0.06f +  0.02f*_Complex_I,
+         0.03f +  0.01f*_Complex_I };
+    firfilt_cccf fchannel = firfilt_cccf_create(h,4);
+
+    // arrays
+    unsigned int  num_symbols = h_len * num_blocks;
+    float complex sym_in [num_symbols];     // input symbols
+    float complex sym_rx [num_symbols];     // received (distorted) symbols
+    float complex sym_des[num_symbols];     // desired (delayed) symbols
+    float complex sym_out[num_symbols];     // equalized symbols
+
+    unsigned int i;
+    for (i=0; i<num_symbols; i++) {
+        // generate input symbol and apply channel
+        sym_in[i]  = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 );
+        sym_in[i] += ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        firfilt_cccf_push   (fchannel, sym_in[i]);
+        firfilt_cccf_execute(fchannel, &sym_rx[i]);
+
+        // desired output is input delayed to lie within the equalizer span
+        sym_des[i] = i < delay ? 0.0f : sym_in[i-delay];
+    }
+    msequence_destroy(ms);
+
+    // train equalizer one block at a time
+    eqfde_cccf_step_block(eq, sym_rx, sym_des, num_symbols, sym_out);
+
+    // verify convergence over the last several blocks
+    unsigned int settling_delay = num_symbols - 200;
+    for (i=settling_delay; i<num_symbols; i++) {
+        float error = cabsf(sym_des[i]-sym_out[i]);
+
+        if (liquid_autotest_verbose) {
+            printf("d[%4u] = {%12.8f,%12.8f}, y[%4u] = {%12.8f,%12.8f}, error=%12.8f %s\n",
+                    i, crealf(sym_des[i]), cimagf(sym_des[i]),
+                    i, crealf(sym_out[i]), cimagf(sym_out[i]),
+                    error, error > tol ? "*" : "");
+        }
+
+        CONTEND_DELTA(error, 0.0f, tol);
+    }
+
+    // clean up objects
+    firfilt_cccf_destroy(fchannel);
+    eqfde_cccf_destroy(eq);
+}
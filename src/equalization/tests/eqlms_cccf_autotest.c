@@ -23,6 +23,192 @@
 #include "autotest/autotest.h"
 #include "liquid.h"
 
+//
+// AUTOTEST: block update with unit block size matches per-sample training
+//
+void autotest_eqlms_cccf_step_block_unit()
+{
+    float        tol         = 1e-6f;   // error tolerance
+    unsigned int p           = 7;       // equalizer order
+    unsigned int num_samples = 80;      // number of samples to observe
+
+    // create identical equalizers: one trained per sample, one trained
+    // with the block method on single-sample blocks
+    eqlms_cccf eq0 = eqlms_cccf_create(NULL, p);
+    eqlms_cccf eq1 = eqlms_cccf_create(NULL, p);
+    eqlms_cccf_set_bw(eq0, 0.3f);
+    eqlms_cccf_set_bw(eq1, 0.3f);
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(11);
+
+    unsigned int i;
+    float complex x, d, d_hat0, d_hat1;
+    for (i=0; i<num_samples; i++) {
+        // generate random sample and desired output
+        x = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+            ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        d = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+            ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+
+        // train per sample
+        eqlms_cccf_push   (eq0, x);
+        eqlms_cccf_execute(eq0, &d_hat0);
+        eqlms_cccf_step   (eq0, d, d_hat0);
+
+        // train on single-sample block
+        eqlms_cccf_step_block(eq1, &x, &d, 1, &d_hat1);
+
+        // outputs match exactly
+        CONTEND_DELTA( crealf(d_hat0), crealf(d_hat1), tol );
+        CONTEND_DELTA( cimagf(d_hat0), cimagf(d_hat1), tol );
+    }
+    msequence_destroy(ms);
+
+    // final weights match exactly
+    float complex w0[p];
+    float complex w1[p];
+    eqlms_cccf_get_weights(eq0, w0);
+    eqlms_cccf_get_weights(eq1, w1);
+    for (i=0; i<p; i++) {
+        CONTEND_DELTA( crealf(w0[i]), crealf(w1[i]), tol );
+        CONTEND_DELTA( cimagf(w0[i]), cimagf(w1[i]), tol );
+    }
+
+    // clean up objects
+    eqlms_cccf_destroy(eq0);
+    eqlms_cccf_destroy(eq1);
+}
+
+//
+// AUTOTEST: saving and restoring converged equalizer weights
+//
+void autotest_eqlms_cccf_state()
+{
+    float        tol         = 1e-6f;   // error tolerance
+    unsigned int p           = 7;       // equalizer order
+    unsigned int num_samples = 80;      // number of samples to observe
+
+    // create equalizer and train on random data
+    eqlms_cccf eq0 = eqlms_cccf_create(NULL, p);
+    eqlms_cccf_set_bw(eq0, 0.3f);
+
+    msequence ms = msequence_create_default(11);
+    unsigned int i;
+    float complex x, d, d_hat;
+    for (i=0; i<num_samples; i++) {
+        x = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+            ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        d = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 ) +
+            ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        eqlms_cccf_push   (eq0, x);
+        eqlms_cccf_execute(eq0, &d_hat);
+        eqlms_cccf_step   (eq0, d, d_hat);
+    }
+    msequence_destroy(ms);
+
+    // save converged weights
+    unsigned int n = eqlms_cccf_get_state_size(eq0);
+    unsigned char state[n];
+    eqlms_cccf_save_state(eq0, state, n);
+
+    // restore into a fresh (cold) object of the same length
+    eqlms_cccf eq1 = eqlms_cccf_create(NULL, p);
+    eqlms_cccf_set_bw(eq1, 0.3f);
+    eqlms_cccf_restore_state(eq1, state, n);
+
+    // weights match exactly
+    float complex w0[p];
+    float complex w1[p];
+    eqlms_cccf_get_weights(eq0, w0);
+    eqlms_cccf_get_weights(eq1, w1);
+    for (i=0; i<p; i++) {
+        CONTEND_DELTA( crealf(w0[i]), crealf(w1[i]), tol );
+        CONTEND_DELTA( cimagf(w0[i]), cimagf(w1[i]), tol );
+    }
+
+    // clean up objects
+    eqlms_cccf_destroy(eq0);
+    eqlms_cccf_destroy(eq1);
+}
+
+//
+// AUTOTEST: static channel filter, block training on QPSK symbols
+//
+void autotest_eqlms_cccf_step_block()
+{
+    // parameters
+    float           tol         =  2e-2f;   // error tolerance
+    unsigned int    p           =  13;      // equalizer order
+    unsigned int    delay       =  6;       // target equalizer delay (symbols)
+    float           mu          =  0.05f;   // equalizer bandwidth
+    unsigned int    block_len   =  16;      // training block length
+    unsigned int    num_blocks  = 125;      // number of blocks to observe
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(12);
+
+    // create equalizer
+    eqlms_cccf eq = eqlms_cccf_create(NULL, p);
+    eqlms_cccf_set_bw(eq, mu);
+
+    // create channel filter (mild inter-symbol interference)
+    float complex h[4] = {
+         1.00f +  0.00f*_Complex_I,
+         0.08f + -0.05f*_Complex_I,
+        -0.06f +  0.02f*_Complex_I,
+         0.03f +  0.01f*_Complex_I };
+    firfilt_cccf fchannel = firfilt_cccf_create(h,4);
+
+    // arrays
+    unsigned int  num_symbols = block_len * num_blocks;
+    float complex sym_in [num_symbols];     // input symbols
+    float complex sym_rx [num_symbols];     // received (distorted) symbols
+    float complex sym_des[num_symbols];     // desired (delayed) symbols
+    float complex sym_out[num_symbols];     // equalized symbols
+
+    unsigned int i;
+    for (i=0; i<num_symbols; i++) {
+        // generate input symbol and apply channel
+        sym_in[i]  = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 );
+        sym_in[i] += ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        firfilt_cccf_push   (fchannel, sym_in[i]);
+        firfilt_cccf_execute(fchannel, &sym_rx[i]);
+
+        // desired output is input delayed to the equalizer center
+        sym_des[i] = i < delay ? 0.0f : sym_in[i-delay];
+    }
+    msequence_destroy(ms);
+
+    // train equalizer one block at a time
+    for (i=0; i<num_blocks; i++) {
+        eqlms_cccf_step_block(eq,
+            &sym_rx [i*block_len],
+            &sym_des[i*block_len],
+            block_len,
+            &sym_out[i*block_len]);
+    }
+
+    // verify convergence over the last several blocks
+    unsigned int settling_delay = num_symbols - 200;
+    for (i=settling_delay; i<num_symbols; i++) {
+        float error = cabsf(sym_des[i]-sym_out[i]);
+
+        if (liquid_autotest_verbose) {
+            printf("d[%4u] = {%12.8f,%12.8f}, y[%4u] = {%12.8f,%12.8f}, error=%12.8f %s\n",
+                    i, crealf(sym_des[i]), cimagf(sym_des[i]),
+                    i, crealf(sym_out[i]), cimagf(sym_out[i]),
+                    error, error > tol ? "*" : "");
+        }
+
+        CONTEND_DELTA(error, 0.0f, tol);
+    }
+
+    // clean up objects
+    firfilt_cccf_destroy(fchannel);
+    eqlms_cccf_destroy(eq);
+}
+
 // 
 // AUTOTEST: static channel filter, blind equalization on QPSK symbols
 //
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: dichotomous coordinate descent engine, static channel
+//           filter, training on known QPSK symbols
+//
+void autotest_eqrls_cccf_dcd()
+{
+    // parameters
+    float           tol         =  2e-2f;   // error tolerance
+    unsigned int    p           =  9;       // equalizer order
+    unsigned int    delay       =  4;       // target equalizer delay (symbols)
+    unsigned int    num_symbols = 800;      // number of symbols to observe
+
+    // create sequence generator for repeatability
+    msequence ms = msequence_create_default(12);
+
+    // create equalizer with the DCD engine
+    eqrls_cccf eq = eqrls_cccf_create_dcd(NULL, p);
+
+    // create channel filter (mild inter-symbol interference)
+    float complex h[4] = {
+         1.00f +  0.00f*_Complex_I,
+         0.08f + -0.05f*_Complex_I,
+        -0.06f +  0.02f*_Complex_I,
+         0.03f +  0.01f*_Complex_I };
+    firfilt_cccf fchannel = firfilt_cccf_create(h,4);
+
+    // arrays
+    float complex sym_in [num_symbols]; // input symbols
+    float complex sym_out[num_symbols]; // equalized symbols
+
+    // run equalization, training on known symbols
+    unsigned int i;
+    float complex x, d;
+    for (i=0; i<num_symbols; i++) {
+        // generate input symbol and apply channel
+        sym_in[i]  = ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 );
+        sym_in[i] += ( msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2 )*_Complex_I;
+        firfilt_cccf_push   (fchannel, sym_in[i]);
+        firfilt_cccf_execute(fchannel, &x);
+
+        // desired output is input delayed to lie within the
+        // equalizer span
+        d = i < delay ? 0.0f : sym_in[i-delay];
+
+        // push received sample, filter, and adapt
+        eqrls_cccf_push   (eq, x);
+        eqrls_cccf_execute(eq, &sym_out[i]);
+        eqrls_cccf_step   (eq, d, sym_out[i]);
+    }
+    msequence_destroy(ms);
+
+    // verify convergence over the last several symbols
+    unsigned int settling_delay = num_symbols - 200;
+    for (i=settling_delay; i<num_symbols; i++) {
+        float error = cabsf(sym_in[i-delay]-sym_out[i]);
+
+        if (liquid_autotest_verbose) {
+            printf("x[%4u] = {%12.8f,%12.8f}, y[%4u] = {%12.8f,%12.8f}, error=%12.8f %s\n",
+                    i-delay, crealf(sym_in[i-delay]), cimagf(sym_in[i-delay]),
+                    i,       crealf(sym_out[i]),      cimagf(sym_out[i]),
+                    error, error > tol ? "*" : "");
+        }
+
+        CONTEND_DELTA(error, 0.0f, tol);
+    }
+
+    // clean up objects
+    firfilt_cccf_destroy(fchannel);
+    eqrls_cccf_destroy(eq);
+}
@@ -27,9 +27,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <stdint.h>
+#include <arm_acle.h>
+#endif
+
 
 // object-independent methods
 
@@ -269,9 +275,41 @@ unsigned int crc8_generate_key(unsigned char *_msg,
 // CRC-16
 //
 
+// slice-by-8 look-up tables, generated once on first use; validation
+// may run concurrently (e.g. on synchronizer worker threads), so
+// generation runs under pthread_once
+static unsigned short crc16_gentab[8][256];
+static pthread_once_t crc16_gentab_once = PTHREAD_ONCE_INIT;
+
+// generate slice-by-8 look-up tables for 16-bit CRC
+void crc16_init_gentab(void)
+{
+    unsigned int i, j, mask;
+    unsigned int poly = liquid_reverse_uint16(CRC16_POLY);
+
+    // table 0: conventional byte-at-a-time look-up table
+    for (i=0; i<256; i++) {
+        unsigned int key16 = i;
+        for (j=0; j<8; j++) {
+            mask = -(key16 & 1);
+            key16 = (key16>>1) ^ (poly & mask);
+        }
+        crc16_gentab[0][i] = key16;
+    }
+
+    // table k: effect of byte i followed by k zero bytes
+    for (j=1; j<8; j++) {
+        for (i=0; i<256; i++) {
+            unsigned int key16 = crc16_gentab[j-1][i];
+            crc16_gentab[j][i] = (key16>>8) ^ crc16_gentab[0][key16 & 0xff];
+        }
+    }
+}
+
 // generate 16-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
+// slice-by-8 method, operates on eight bytes at a time using
+// pre-computed look-up tables
 // algorithm from: http://www.hackersdelight.org/crc.pdf
 //
 //  _msg    :   input data message [size: _n x 1]
@@ -279,16 +317,44 @@ unsigned int crc8_generate_key(unsigned char *_msg,
 unsigned int crc16_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key16=~0;
+    pthread_once(&crc16_gentab_once, crc16_init_gentab);
+
+    unsigned int i, j, mask, key16=~0;
     unsigned int poly = liquid_reverse_uint16(CRC16_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key16 ^= b;
+
+    // process the first two bytes one bit at a time: the shift
+    // register is initialized to all ones in a 32-bit word, so bits
+    // above the polynomial order feed into the state until sixteen
+    // shifts have drained them (preserves legacy key values)
+    for (i=0; i<2 && _n>0; i++) {
+        key16 ^= *_msg++;
+        _n--;
         for (j=0; j<8; j++) {
             mask = -(key16 & 1);
             key16 = (key16>>1) ^ (poly & mask);
         }
     }
+
+    // main loop: process eight input bytes per step, each indexing
+    // the table that accounts for its offset from the end of the block
+    while (_n >= 8) {
+        key16 ^= _msg[0] | (_msg[1] << 8);
+        key16 = crc16_gentab[7][ key16      & 0xff] ^
+                crc16_gentab[6][(key16>>8)  & 0xff] ^
+                crc16_gentab[5][_msg[2]] ^
+                crc16_gentab[4][_msg[3]] ^
+                crc16_gentab[3][_msg[4]] ^
+                crc16_gentab[2][_msg[5]] ^
+                crc16_gentab[1][_msg[6]] ^
+                crc16_gentab[0][_msg[7]];
+        _msg += 8;
+        _n   -= 8;
+    }
+
+    // clean up remaining bytes
+    for (i=0; i<_n; i++)
+        key16 = (key16>>8) ^ crc16_gentab[0][(key16 ^ _msg[i]) & 0xff];
+
     return (~key16) & 0xffff;
 }
 
@@ -325,9 +391,43 @@ unsigned int crc24_generate_key(unsigned char *_msg,
 // CRC-32
 //
 
+// slice-by-8 look-up tables, generated once on first use under
+// pthread_once (see crc16 note above)
+static unsigned int crc32_gentab[8][256];
+static pthread_once_t crc32_gentab_once = PTHREAD_ONCE_INIT;
+
+// generate slice-by-8 look-up tables for 32-bit CRC
+void crc32_init_gentab(void)
+{
+    unsigned int i, j, mask;
+    unsigned int poly = liquid_reverse_uint32(CRC32_POLY);
+
+    // table 0: conventional byte-at-a-time look-up table
+    for (i=0; i<256; i++) {
+        unsigned int key32 = i;
+        for (j=0; j<8; j++) {
+            mask = -(key32 & 1);
+            key32 = (key32>>1) ^ (poly & mask);
+        }
+        crc32_gentab[0][i] = key32;
+    }
+
+    // table k: effect of byte i followed by k zero bytes
+    for (j=1; j<8; j++) {
+        for (i=0; i<256; i++) {
+            unsigned int key32 = crc32_gentab[j-1][i];
+            crc32_gentab[j][i] = (key32>>8) ^ crc32_gentab[0][key32 & 0xff];
+        }
+    }
+}
+
 // generate 32-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
+// uses the ARMv8 CRC-32 instructions where available (the instruction
+// set implements this same reflected 0x04c11db7 polynomial; note that
+// the x86 sse4.2 crc32 instruction implements the Castagnoli
+// polynomial and cannot be used here), otherwise a slice-by-8 method
+// operating on eight bytes at a time using pre-computed look-up tables
 // algorithm from: http://www.hackersdelight.org/crc.pdf
 //
 //  _msg    :   input data message [size: _n x 1]
@@ -335,17 +435,51 @@ unsigned int crc24_generate_key(unsigned char *_msg,
 unsigned int crc32_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key32=~0;
-    unsigned int poly = liquid_reverse_uint32(CRC32_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key32 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key32 & 1);
-            key32 = (key32>>1) ^ (poly & mask);
-        }
+#if defined(__ARM_FEATURE_CRC32)
+    unsigned int i;
+    uint32_t key32 = ~0;
+
+    // process eight bytes per instruction
+    while (_n >= 8) {
+        uint64_t v;
+        memcpy(&v, _msg, 8);
+        key32 = __crc32d(key32, v);
+        _msg += 8;
+        _n   -= 8;
+    }
+
+    // clean up remaining bytes
+    for (i=0; i<_n; i++)
+        key32 = __crc32b(key32, _msg[i]);
+
+    return (~key32) & 0xffffffff;
+#else
+    pthread_once(&crc32_gentab_once, crc32_init_gentab);
+
+    unsigned int i, key32=~0;
+
+    // main loop: process eight input bytes per step, each indexing
+    // the table that accounts for its offset from the end of the block
+    while (_n >= 8) {
+        key32 ^= _msg[0] | (_msg[1] << 8) | (_msg[2] << 16) | ((unsigned int)_msg[3] << 24);
+        key32 = crc32_gentab[7][ key32       & 0xff] ^
+                crc32_gentab[6][(key32 >> 8) & 0xff] ^
+                crc32_gentab[5][(key32 >>16) & 0xff] ^
+                crc32_gentab[4][(key32 >>24) & 0xff] ^
+                crc32_gentab[3][_msg[4]] ^
+                crc32_gentab[2][_msg[5]] ^
+                crc32_gentab[1][_msg[6]] ^
+                crc32_gentab[0][_msg[7]];
+        _msg += 8;
+        _n   -= 8;
     }
+
+    // clean up remaining bytes
+    for (i=0; i<_n; i++)
+        key32 = (key32>>8) ^ crc32_gentab[0][(key32 ^ _msg[i]) & 0xff];
+
     return (~key32) & 0xffffffff;
+#endif
 }
 
 #if 0
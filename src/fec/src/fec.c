@@ -74,7 +74,9 @@ void liquid_print_fec_schemes()
     printf("          ");
     for (i=0; i<LIQUID_FEC_NUM_SCHEMES; i++) {
 #if !LIBFEC_ENABLED
-        if ( fec_scheme_is_convolutional(i) || fec_scheme_is_reedsolomon(i) )
+        // K=7 convolutional and Reed-Solomon codes use internal engines
+        // and are always available
+        if ( fec_scheme_is_convolutional(i) && !fec_scheme_is_conv_v27(i) )
             continue;
 #endif
         printf("%s", fec_scheme_str[i][0]);
@@ -136,6 +138,25 @@ int fec_scheme_is_convolutional(fec_scheme _scheme)
     return 0;
 }
 
+// is scheme in the K=7 convolutional family (internal Viterbi engine)?
+int fec_scheme_is_conv_v27(fec_scheme _scheme)
+{
+    switch (_scheme) {
+    case LIQUID_FEC_CONV_V27:
+    case LIQUID_FEC_CONV_V27P23:
+    case LIQUID_FEC_CONV_V27P34:
+    case LIQUID_FEC_CONV_V27P45:
+    case LIQUID_FEC_CONV_V27P56:
+    case LIQUID_FEC_CONV_V27P67:
+    case LIQUID_FEC_CONV_V27P78:
+        return 1;
+
+    default:;
+    }
+
+    return 0;
+}
+
 // is scheme punctured?
 int fec_scheme_is_punctured(fec_scheme _scheme)
 {
@@ -220,12 +241,8 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_SECDED3932:     return _msg_len + _msg_len/4 + ((_msg_len%4) ? 1 : 0);
     case LIQUID_FEC_SECDED7264:     return _msg_len + _msg_len/8 + ((_msg_len%8) ? 1 : 0);
 
-#if LIBFEC_ENABLED
-    // convolutional codes
+    // convolutional codes (K=7 family uses internal Viterbi engine)
     case LIQUID_FEC_CONV_V27:       return 2*_msg_len + 2;  // (K-1)/r=12, round up to 2 bytes
-    case LIQUID_FEC_CONV_V29:       return 2*_msg_len + 2;  // (K-1)/r=16, 2 bytes
-    case LIQUID_FEC_CONV_V39:       return 3*_msg_len + 3;  // (K-1)/r=24, 3 bytes
-    case LIQUID_FEC_CONV_V615:      return 6*_msg_len + 11; // (K-1)/r=84, round up to 11 bytes
     case LIQUID_FEC_CONV_V27P23:    return fec_conv_get_enc_msg_len(_msg_len,7,2);
     case LIQUID_FEC_CONV_V27P34:    return fec_conv_get_enc_msg_len(_msg_len,7,3);
     case LIQUID_FEC_CONV_V27P45:    return fec_conv_get_enc_msg_len(_msg_len,7,4);
@@ -233,6 +250,11 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_CONV_V27P67:    return fec_conv_get_enc_msg_len(_msg_len,7,6);
     case LIQUID_FEC_CONV_V27P78:    return fec_conv_get_enc_msg_len(_msg_len,7,7);
 
+#if LIBFEC_ENABLED
+    case LIQUID_FEC_CONV_V29:       return 2*_msg_len + 2;  // (K-1)/r=16, 2 bytes
+    case LIQUID_FEC_CONV_V39:       return 3*_msg_len + 3;  // (K-1)/r=24, 3 bytes
+    case LIQUID_FEC_CONV_V615:      return 6*_msg_len + 11; // (K-1)/r=84, round up to 11 bytes
+
     case LIQUID_FEC_CONV_V29P23:    return fec_conv_get_enc_msg_len(_msg_len,9,2);
     case LIQUID_FEC_CONV_V29P34:    return fec_conv_get_enc_msg_len(_msg_len,9,3);
     case LIQUID_FEC_CONV_V29P45:    return fec_conv_get_enc_msg_len(_msg_len,9,4);
@@ -240,21 +262,11 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_CONV_V29P67:    return fec_conv_get_enc_msg_len(_msg_len,9,6);
     case LIQUID_FEC_CONV_V29P78:    return fec_conv_get_enc_msg_len(_msg_len,9,7);
 
-    // Reed-Solomon codes
-    case LIQUID_FEC_RS_M8:          return fec_rs_get_enc_msg_len(_msg_len,32,255,223);
 #else
-    case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
     case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
     case LIQUID_FEC_CONV_V29P23:
     case LIQUID_FEC_CONV_V29P34:
     case LIQUID_FEC_CONV_V29P45:
@@ -263,11 +275,10 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_CONV_V29P78:
         fprintf(stderr, "error: fec_get_enc_msg_length(), convolutional codes unavailable (install libfec)\n");
         exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
 #endif
+
+    // Reed-Solomon codes
+    case LIQUID_FEC_RS_M8:          return fec_rs_get_enc_msg_len(_msg_len,32,255,223);
     default:
         printf("error: fec_get_enc_msg_length(), unknown/unsupported scheme: %d\n", _scheme);
         exit(-1);
@@ -414,18 +425,19 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_SECDED3932:     return 4./5.;   // ultimately 32/39 ~ 0.82051
     case LIQUID_FEC_SECDED7264:     return 8./9.;
 
-    // convolutional codes
-#if LIBFEC_ENABLED
+    // convolutional codes (K=7 family uses internal Viterbi engine)
     case LIQUID_FEC_CONV_V27:       return 1./2.;
-    case LIQUID_FEC_CONV_V29:       return 1./2.;
-    case LIQUID_FEC_CONV_V39:       return 1./3.;
-    case LIQUID_FEC_CONV_V615:      return 1./6.;
     case LIQUID_FEC_CONV_V27P23:    return 2./3.;
     case LIQUID_FEC_CONV_V27P34:    return 3./4.;
     case LIQUID_FEC_CONV_V27P45:    return 4./5.;
     case LIQUID_FEC_CONV_V27P56:    return 5./6.;
     case LIQUID_FEC_CONV_V27P67:    return 6./7.;
     case LIQUID_FEC_CONV_V27P78:    return 7./8.;
+
+#if LIBFEC_ENABLED
+    case LIQUID_FEC_CONV_V29:       return 1./2.;
+    case LIQUID_FEC_CONV_V39:       return 1./3.;
+    case LIQUID_FEC_CONV_V615:      return 1./6.;
     case LIQUID_FEC_CONV_V29P23:    return 2./3.;
     case LIQUID_FEC_CONV_V29P34:    return 3./4.;
     case LIQUID_FEC_CONV_V29P45:    return 4./5.;
@@ -433,21 +445,11 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_CONV_V29P67:    return 6./7.;
     case LIQUID_FEC_CONV_V29P78:    return 7./8.;
 
-    // Reed-Solomon codes
-    case LIQUID_FEC_RS_M8:          return 223./255.;
 #else
-    case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
     case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
     case LIQUID_FEC_CONV_V29P23:
     case LIQUID_FEC_CONV_V29P34:
     case LIQUID_FEC_CONV_V29P45:
@@ -456,12 +458,11 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_CONV_V29P78:
         fprintf(stderr,"error: fec_get_rate(), convolutional codes unavailable (install libfec)\n");
         exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_get_rate(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
 #endif
 
+    // Reed-Solomon codes
+    case LIQUID_FEC_RS_M8:          return 223./255.;
+
     default:
         printf("error: fec_get_rate(), unknown/unsupported scheme: %d\n", _scheme);
         exit(-1);
@@ -502,12 +503,8 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     case LIQUID_FEC_SECDED7264:
         return fec_secded7264_create(_opts);
 
-    // convolutional codes
-#if LIBFEC_ENABLED
+    // convolutional codes (K=7 family uses internal Viterbi engine)
     case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
         return fec_conv_create(_scheme);
 
     // punctured
@@ -517,7 +514,15 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     case LIQUID_FEC_CONV_V27P56:
     case LIQUID_FEC_CONV_V27P67:
     case LIQUID_FEC_CONV_V27P78:
+        return fec_conv_punctured_create(_scheme);
 
+#if LIBFEC_ENABLED
+    case LIQUID_FEC_CONV_V29:
+    case LIQUID_FEC_CONV_V39:
+    case LIQUID_FEC_CONV_V615:
+        return fec_conv_create(_scheme);
+
+    // punctured
     case LIQUID_FEC_CONV_V29P23:
     case LIQUID_FEC_CONV_V29P34:
     case LIQUID_FEC_CONV_V29P45:
@@ -526,22 +531,11 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     case LIQUID_FEC_CONV_V29P78:
         return fec_conv_punctured_create(_scheme);
 
-    // Reed-Solomon codes
-    case LIQUID_FEC_RS_M8:
-        return fec_rs_create(_scheme);
 #else
-    case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
     case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
     case LIQUID_FEC_CONV_V29P23:
     case LIQUID_FEC_CONV_V29P34:
     case LIQUID_FEC_CONV_V29P45:
@@ -550,11 +544,11 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     case LIQUID_FEC_CONV_V29P78:
         fprintf(stderr,"error: fec_create(), convolutional codes unavailable (install libfec)\n");
         exit(-1);
+#endif
 
+    // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_create(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+        return fec_rs_create(_scheme);
 
     default:
         printf("error: fec_create(), unknown/unsupported scheme: %d\n", _scheme);
@@ -625,12 +619,8 @@ void fec_destroy(fec _q)
         fec_secded7264_destroy(_q);
         return;
 
-    // convolutional codes
-#if LIBFEC_ENABLED
+    // convolutional codes (K=7 family uses internal Viterbi engine)
     case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
         fec_conv_destroy(_q);
         return;
 
@@ -641,7 +631,17 @@ void fec_destroy(fec _q)
     case LIQUID_FEC_CONV_V27P56:
     case LIQUID_FEC_CONV_V27P67:
     case LIQUID_FEC_CONV_V27P78:
+        fec_conv_punctured_destroy(_q);
+        return;
+
+#if LIBFEC_ENABLED
+    case LIQUID_FEC_CONV_V29:
+    case LIQUID_FEC_CONV_V39:
+    case LIQUID_FEC_CONV_V615:
+        fec_conv_destroy(_q);
+        return;
 
+    // punctured
     case LIQUID_FEC_CONV_V29P23:
     case LIQUID_FEC_CONV_V29P34:
     case LIQUID_FEC_CONV_V29P45:
@@ -651,23 +651,11 @@ void fec_destroy(fec _q)
         fec_conv_punctured_destroy(_q);
         return;
 
-    // Reed-Solomon codes
-    case LIQUID_FEC_RS_M8:
-        fec_rs_destroy(_q);
-        return;
 #else
-    case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
     case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
     case LIQUID_FEC_CONV_V29P23:
     case LIQUID_FEC_CONV_V29P34:
     case LIQUID_FEC_CONV_V29P45:
@@ -676,11 +664,12 @@ void fec_destroy(fec _q)
     case LIQUID_FEC_CONV_V29P78:
         fprintf(stderr,"error: fec_destroy(), convolutional codes unavailable (install libfec)\n");
         exit(-1);
+#endif
 
+    // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_destroy(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+        fec_rs_destroy(_q);
+        return;
 
     default:
         printf("error: fec_destroy(), unknown/unsupported scheme: %d\n", _q->scheme);
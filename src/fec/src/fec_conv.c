@@ -34,6 +34,7 @@
 
 #if LIBFEC_ENABLED
 #include "fec.h"
+#endif
 
 fec fec_conv_create(fec_scheme _fs)
 {
@@ -48,9 +49,17 @@ fec fec_conv_create(fec_scheme _fs)
 
     switch (q->scheme) {
     case LIQUID_FEC_CONV_V27:  fec_conv_init_v27(q);   break;
+#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V29:  fec_conv_init_v29(q);   break;
     case LIQUID_FEC_CONV_V39:  fec_conv_init_v39(q);   break;
     case LIQUID_FEC_CONV_V615: fec_conv_init_v615(q);  break;
+#else
+    case LIQUID_FEC_CONV_V29:
+    case LIQUID_FEC_CONV_V39:
+    case LIQUID_FEC_CONV_V615:
+        fprintf(stderr,"error: fec_conv_create(), scheme unavailable (install libfec)\n");
+        exit(1);
+#endif
     default:
         fprintf(stderr,"error: fec_conv_create(), invalid type\n");
         exit(1);
@@ -100,7 +109,7 @@ void fec_conv_encode(fec _q,
 
             // compute parity bits for each polynomial
             for (r=0; r<_q->R; r++) {
-                byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                 _msg_enc[n/8] = byte_out;
                 n++;
             }
@@ -114,7 +123,7 @@ void fec_conv_encode(fec _q,
 
         // compute parity bits for each polynomial
         for (r=0; r<_q->R; r++) {
-            byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+            byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
             _msg_enc[n/8] = byte_out;
             n++;
         }
@@ -239,13 +248,15 @@ void fec_conv_init_v27(fec _q)
     _q->R=2;
     _q->K=7;
     _q->poly = fec_conv27_poly;
-    _q->create_viterbi = create_viterbi27;
-    _q->init_viterbi = init_viterbi27;
-    _q->update_viterbi_blk = update_viterbi27_blk;
-    _q->chainback_viterbi = chainback_viterbi27;
-    _q->delete_viterbi = delete_viterbi27;
+    // use internal butterfly add-compare-select engine
+    _q->create_viterbi = fec_conv27_viterbi_create;
+    _q->init_viterbi = fec_conv27_viterbi_init;
+    _q->update_viterbi_blk = fec_conv27_viterbi_update_blk;
+    _q->chainback_viterbi = fec_conv27_viterbi_chainback;
+    _q->delete_viterbi = fec_conv27_viterbi_delete;
 }
 
+#if LIBFEC_ENABLED
 void fec_conv_init_v29(fec _q)
 {
     _q->R=2;
@@ -281,19 +292,5 @@ void fec_conv_init_v615(fec _q)
     _q->chainback_viterbi = chainback_viterbi615;
     _q->delete_viterbi = delete_viterbi615;
 }
-
-
-
-#else   // LIBFEC_ENABLED
-
-fec fec_conv_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_conv_destroy(fec _q)
-{
-}
-
 #endif  // LIBFEC_ENABLED
 
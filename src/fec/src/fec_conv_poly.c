@@ -48,7 +48,8 @@ int fec_conv615_poly[6] = {V615POLYA,
 
 #else
 
-int fec_conv27_poly[2]  = {0,0};
+// K=7 polynomials (CCSDS), used by the internal Viterbi engine
+int fec_conv27_poly[2]  = {0x6d,0x4f};
 int fec_conv29_poly[2]  = {0,0};
 int fec_conv39_poly[3]  = {0,0,0};
 int fec_conv615_poly[6] = {0,0,0,0,0,0};
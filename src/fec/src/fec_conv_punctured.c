@@ -34,6 +34,7 @@
 
 #if LIBFEC_ENABLED
 #include "fec.h"
+#endif
 
 fec fec_conv_punctured_create(fec_scheme _fs)
 {
@@ -54,12 +55,23 @@ fec fec_conv_punctured_create(fec_scheme _fs)
     case LIQUID_FEC_CONV_V27P67:   fec_conv_init_v27p67(q);    break;
     case LIQUID_FEC_CONV_V27P78:   fec_conv_init_v27p78(q);    break;
 
+#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V29P23:   fec_conv_init_v29p23(q);    break;
     case LIQUID_FEC_CONV_V29P34:   fec_conv_init_v29p34(q);    break;
     case LIQUID_FEC_CONV_V29P45:   fec_conv_init_v29p45(q);    break;
     case LIQUID_FEC_CONV_V29P56:   fec_conv_init_v29p56(q);    break;
     case LIQUID_FEC_CONV_V29P67:   fec_conv_init_v29p67(q);    break;
     case LIQUID_FEC_CONV_V29P78:   fec_conv_init_v29p78(q);    break;
+#else
+    case LIQUID_FEC_CONV_V29P23:
+    case LIQUID_FEC_CONV_V29P34:
+    case LIQUID_FEC_CONV_V29P45:
+    case LIQUID_FEC_CONV_V29P56:
+    case LIQUID_FEC_CONV_V29P67:
+    case LIQUID_FEC_CONV_V29P78:
+        fprintf(stderr,"error: fec_conv_punctured_create(), scheme unavailable (install libfec)\n");
+        exit(1);
+#endif
     default:
         fprintf(stderr,"error: fec_conv_punctured_create(), invalid type\n");
         exit(1);
@@ -112,7 +124,7 @@ void fec_conv_punctured_encode(fec _q,
             for (r=0; r<_q->R; r++) {
                 // enable output determined by puncturing matrix
                 if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                    byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                    byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                     _msg_enc[n/8] = byte_out;
                     n++;
                 } else {
@@ -134,7 +146,7 @@ void fec_conv_punctured_encode(fec _q,
         // compute parity bits for each polynomial
         for (r=0; r<_q->R; r++) {
             if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                 _msg_enc[n/8] = byte_out;
                 n++;
             }
@@ -186,7 +198,11 @@ void fec_conv_punctured_decode_hard(fec _q,
                 if (k==8) {
                     k = 0;
                     n++;
-                    byte_in = _msg_enc[n];
+                    // pre-load next byte only if one remains; the last
+                    // bit of the last byte would otherwise read past
+                    // the end of the encoded message
+                    if (n < _q->num_enc_bytes)
+                        byte_in = _msg_enc[n];
                 }
             } else {
                 // push erasure
@@ -372,6 +388,7 @@ void fec_conv_init_v27p78(fec _q)
 }
 
 
+#if LIBFEC_ENABLED
 void fec_conv_init_v29p23(fec _q)
 {
     // initialize R, K, polynomial, and viterbi methods
@@ -428,31 +445,4 @@ void fec_conv_init_v29p78(fec _q)
 }
 
 
-#else   // LIBFEC_ENABLED
-
-fec fec_conv_punctured_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_conv_punctured_destroy(fec _q)
-{
-}
-
-void fec_conv_punctured_encode(fec _q,
-                               unsigned int _dec_msg_len,
-                               unsigned char *_msg_dec,
-                               unsigned char *_msg_enc)
-{
-}
-
-//unsigned int
-void fec_conv_punctured_decode(fec _q,
-                               unsigned int _dec_msg_len,
-                               unsigned char *_msg_enc,
-                               unsigned char *_msg_dec)
-{
-}
-
 #endif  // LIBFEC_ENABLED
-
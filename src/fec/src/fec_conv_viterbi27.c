@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// internal Viterbi decoder for the K=7, rate-1/2 convolutional code
+// (CCSDS polynomials 0x6d, 0x4f). Path metrics are kept in flat
+// 16-bit arrays and the add-compare-select loop runs over butterfly
+// pairs with no data-dependent branches, so the compiler can
+// vectorize it; metrics are renormalized in batches rather than per
+// trellis step. The interface matches the libfec function pointers
+// used by fec_conv.c so the engine can be selected per scheme.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#define FEC_CONV27_NUM_STATES       (64)
+
+// renormalization batch interval [trellis steps]; path metrics grow by
+// at most 510 per step, so 64 steps stay well within 16-bit range
+#define FEC_CONV27_RENORM_INTERVAL  (64)
+
+// initial metric for states other than the starting state
+#define FEC_CONV27_METRIC_INIT      (2048)
+
+struct fec_conv27_viterbi_s {
+    uint16_t pm_0[FEC_CONV27_NUM_STATES];   // path metrics (current)
+    uint16_t pm_1[FEC_CONV27_NUM_STATES];   // path metrics (next)
+    uint64_t * decisions;                   // survivor decisions, one word per step
+    unsigned int num_steps;                 // decisions allocated (trellis steps)
+    unsigned int step;                      // current trellis step
+    unsigned char out2[FEC_CONV27_NUM_STATES]; // expected output bit pair per transition
+};
+
+// create viterbi decoder for K=7, rate-1/2 code
+//  _num_dec_bits   :   number of decoded data bits per frame
+void * fec_conv27_viterbi_create(int _num_dec_bits)
+{
+    struct fec_conv27_viterbi_s * q = (struct fec_conv27_viterbi_s *)
+        malloc(sizeof(struct fec_conv27_viterbi_s));
+
+    // trellis runs over data bits plus (K-1) tail bits
+    q->num_steps = _num_dec_bits + 6;
+    q->decisions = (uint64_t*) malloc(q->num_steps*sizeof(uint64_t));
+
+    // pre-compute expected output bit pair for each 7-bit transition
+    // word w = (state<<1)|bit with the high (oldest) bit clear; both
+    // polynomials have the high bit set, so transitions from the upper
+    // half of the trellis invert both outputs: out2[w ^ 0x40] = out2[w] ^ 3
+    unsigned int w;
+    for (w=0; w<FEC_CONV27_NUM_STATES; w++) {
+        q->out2[w] = (liquid_count_ones_mod2(w & fec_conv27_poly[0]) << 1) |
+                      liquid_count_ones_mod2(w & fec_conv27_poly[1]);
+    }
+
+    fec_conv27_viterbi_init(q, 0);
+    return (void*)q;
+}
+
+// destroy viterbi decoder object
+void fec_conv27_viterbi_delete(void * _vp)
+{
+    struct fec_conv27_viterbi_s * q = (struct fec_conv27_viterbi_s *)_vp;
+    free(q->decisions);
+    free(q);
+}
+
+// initialize path metrics for new frame
+//  _vp             :   viterbi decoder object
+//  _starting_state :   initial encoder state
+int fec_conv27_viterbi_init(void * _vp, int _starting_state)
+{
+    struct fec_conv27_viterbi_s * q = (struct fec_conv27_viterbi_s *)_vp;
+
+    unsigned int s;
+    for (s=0; s<FEC_CONV27_NUM_STATES; s++)
+        q->pm_0[s] = FEC_CONV27_METRIC_INIT;
+    q->pm_0[_starting_state & (FEC_CONV27_NUM_STATES-1)] = 0;
+
+    q->step = 0;
+    return 0;
+}
+
+// update decoder with block of symbols, running add-compare-select
+// over all 32 butterflies per trellis step
+//  _vp         :   viterbi decoder object
+//  _syms       :   soft input symbols, two per bit [0,255]
+//  _num_bits   :   number of trellis steps (data bits plus tail)
+int fec_conv27_viterbi_update_blk(void * _vp,
+                                  unsigned char * _syms,
+                                  int _num_bits)
+{
+    struct fec_conv27_viterbi_s * q = (struct fec_conv27_viterbi_s *)_vp;
+
+    int i;
+    unsigned int s;
+    for (i=0; i<_num_bits; i++) {
+        // branch metrics for the four expected output pairs
+        unsigned int sym_0 = _syms[2*i + 0];
+        unsigned int sym_1 = _syms[2*i + 1];
+        uint16_t mt[4];
+        mt[0] = sym_0         + sym_1;
+        mt[1] = sym_0         + (255 - sym_1);
+        mt[2] = (255 - sym_0) + sym_1;
+        mt[3] = (255 - sym_0) + (255 - sym_1);
+
+        // add-compare-select over butterflies: new state (s<<1)|b has
+        // predecessors s (lower half) and s+32 (upper half, with both
+        // expected output bits inverted)
+        uint64_t d = 0;
+        for (s=0; s<FEC_CONV27_NUM_STATES/2; s++) {
+            unsigned int b;
+            for (b=0; b<2; b++) {
+                unsigned int ns  = (s<<1) | b;
+                uint16_t m_0 = q->pm_0[s   ] + mt[q->out2[ns]    ];
+                uint16_t m_1 = q->pm_0[s+32] + mt[q->out2[ns] ^ 3];
+                uint64_t sel = (m_1 < m_0) ? 1 : 0;
+                q->pm_1[ns]  = sel ? m_1 : m_0;
+                d |= sel << ns;
+            }
+        }
+        q->decisions[q->step++] = d;
+
+        // swap metric buffers
+        memcpy(q->pm_0, q->pm_1, sizeof(q->pm_0));
+
+        // batch renormalization: subtract minimum metric periodically
+        if ((q->step % FEC_CONV27_RENORM_INTERVAL) == 0) {
+            uint16_t pm_min = q->pm_0[0];
+            for (s=1; s<FEC_CONV27_NUM_STATES; s++)
+                pm_min = q->pm_0[s] < pm_min ? q->pm_0[s] : pm_min;
+            for (s=0; s<FEC_CONV27_NUM_STATES; s++)
+                q->pm_0[s] -= pm_min;
+        }
+    }
+    return 0;
+}
+
+// trace back surviving path and write decoded data bits
+//  _vp         :   viterbi decoder object
+//  _data       :   output message [size: _num_bits/8 x 1]
+//  _num_bits   :   number of data bits to decode
+//  _end_state  :   terminal encoder state
+int fec_conv27_viterbi_chainback(void * _vp,
+                                 unsigned char * _data,
+                                 unsigned int _num_bits,
+                                 unsigned int _end_state)
+{
+    struct fec_conv27_viterbi_s * q = (struct fec_conv27_viterbi_s *)_vp;
+
+    memset(_data, 0x00, _num_bits/8);
+
+    unsigned int state = _end_state & (FEC_CONV27_NUM_STATES-1);
+    unsigned int k = q->step;
+    while (k > 0) {
+        k--;
+        unsigned int d   = (q->decisions[k] >> state) & 1;
+        unsigned int bit = state & 1;
+
+        // data bits precede the (K-1) tail bits, packed MSB first
+        if (k < _num_bits)
+            _data[k>>3] |= bit << (7 - (k & 7));
+
+        // step back to surviving predecessor
+        state = (state >> 1) | (d << 5);
+    }
+    return 0;
+}
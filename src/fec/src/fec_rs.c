@@ -33,9 +33,6 @@
 
 #define VERBOSE_FEC_RS    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
-
 fec fec_rs_create(fec_scheme _fs)
 {
     fec q = (fec) malloc(sizeof(struct fec_s));
@@ -74,7 +71,7 @@ void fec_rs_destroy(fec _q)
 {
     // delete internal Reed-Solomon decoder object
     if (_q->rs != NULL) {
-        free_rs_char(_q->rs);
+        fec_rs_gf256_destroy(_q->rs);
     }
 
     // delete internal memory arrays
@@ -117,7 +114,7 @@ void fec_rs_encode(fec _q,
         // necessary as these bits are going to be thrown away anyway
 
         // encode data, appending parity bits to end of sequence
-        encode_rs_char(_q->rs, _q->tblock, &_q->tblock[_q->dec_block_len]);
+        fec_rs_gf256_encode(_q->rs, _q->tblock, &_q->tblock[_q->dec_block_len]);
 
         // copy result to output
         memmove(&_msg_enc[n1], _q->tblock, _q->enc_block_len*sizeof(unsigned char));
@@ -167,11 +164,11 @@ void fec_rs_decode(fec _q,
         memmove(_q->tblock, &_msg_enc[n0], _q->enc_block_len*sizeof(unsigned char));
 
         // decode block
-        //derrors = 
-        decode_rs_char(_q->rs,
-                       _q->tblock,
-                       _q->derrlocs,
-                       _q->erasures);
+        //derrors =
+        fec_rs_gf256_decode(_q->rs,
+                            _q->tblock,
+                            _q->derrlocs,
+                            _q->erasures);
 
         // copy result
         memmove(&_msg_dec[n1], _q->tblock, block_size*sizeof(unsigned char));
@@ -262,15 +259,15 @@ void fec_rs_setlength(fec _q,
 
     // delete old decoder if necessary
     if (_q->rs != NULL)
-        free_rs_char(_q->rs);
+        fec_rs_gf256_destroy(_q->rs);
 
     // Reed-Solomon specific decoding
-    _q->rs = init_rs_char(_q->symsize,
-                          _q->genpoly,
-                          _q->fcs,
-                          _q->prim,
-                          _q->nroots,
-                          _q->pad);
+    _q->rs = fec_rs_gf256_create(_q->symsize,
+                                 _q->genpoly,
+                                 _q->fcs,
+                                 _q->prim,
+                                 _q->nroots,
+                                 _q->pad);
 }
 
 // 
@@ -286,31 +283,3 @@ void fec_rs_init_p8(fec _q)
     _q->nroots = 32;
 }
 
-#else   // LIBFEC_ENABLED
-
-fec fec_rs_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_rs_destroy(fec _q)
-{
-}
-
-void fec_rs_encode(fec _q,
-                   unsigned int _dec_msg_len,
-                   unsigned char *_msg_dec,
-                   unsigned char *_msg_enc)
-{
-}
-
-//unsigned int
-void fec_rs_decode(fec _q,
-                   unsigned int _dec_msg_len,
-                   unsigned char *_msg_enc,
-                   unsigned char *_msg_dec)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fec_rs_gf256.c
+//
+// internal Reed-Solomon codec over GF(2^8) with a libfec-compatible
+// interface.  Multiplication is carried out through log/anti-log
+// tables built once at creation; the syndrome loop runs a tight
+// table-driven Horner recursion per root and the decoder bails out
+// immediately when all syndromes are zero (the common error-free
+// case), so intact blocks cost little more than a single pass over
+// the data.  Error location uses the Berlekamp-Massey recursion with
+// Chien search and Forney's algorithm for the error magnitudes.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// special log-domain value representing zero
+#define FEC_RS_GF256_LOGZERO (255)
+
+struct fec_rs_gf256_s {
+    int nn;             // block length: 2^8 - 1
+    int nroots;         // number of parity symbols
+    int fcs;            // first consecutive root
+    int prim;           // primitive element for root generation
+    int iprim;          // multiplicative inverse of prim (mod nn)
+    int pad;            // implicit leading zero padding symbols
+
+    unsigned char alpha_to[256];    // anti-log table
+    unsigned char index_of[256];    // log table
+    unsigned char * genpoly;        // generator polynomial, log domain
+};
+
+// reduce exponent modulo nn = 255 (input strictly less than 2*nn)
+static inline int fec_rs_gf256_modnn(int _x)
+{
+    return _x >= 255 ? _x - 255 : _x;
+}
+
+// create internal Reed-Solomon codec object (interface compatible
+// with libfec's init_rs_char)
+//  _symsize    :   symbol size (must be 8 bits)
+//  _gfpoly     :   field-generator polynomial
+//  _fcs        :   first consecutive root
+//  _prim       :   primitive element to generate roots
+//  _nroots     :   number of parity symbols
+//  _pad        :   number of implicit leading zero padding symbols
+void * fec_rs_gf256_create(int _symsize,
+                           int _gfpoly,
+                           int _fcs,
+                           int _prim,
+                           int _nroots,
+                           int _pad)
+{
+    // validate input
+    if (_symsize != 8) {
+        fprintf(stderr,"error: fec_rs_gf256_create(), symbol size must be 8 bits\n");
+        exit(1);
+    } else if (_nroots <= 0 || _nroots >= 255) {
+        fprintf(stderr,"error: fec_rs_gf256_create(), number of roots out of range\n");
+        exit(1);
+    } else if (_pad < 0 || _pad >= 255 - _nroots) {
+        fprintf(stderr,"error: fec_rs_gf256_create(), invalid padding size\n");
+        exit(1);
+    }
+
+    struct fec_rs_gf256_s * q =
+        (struct fec_rs_gf256_s*) malloc(sizeof(struct fec_rs_gf256_s));
+
+    q->nn     = 255;
+    q->nroots = _nroots;
+    q->fcs    = _fcs;
+    q->prim   = _prim;
+    q->pad    = _pad;
+
+    // generate log/anti-log tables from the field polynomial
+    int i;
+    int sr = 1;
+    q->index_of[0] = FEC_RS_GF256_LOGZERO;
+    q->alpha_to[FEC_RS_GF256_LOGZERO] = 0;
+    for (i=0; i<q->nn; i++) {
+        q->index_of[sr] = i;
+        q->alpha_to[i]  = sr;
+        sr <<= 1;
+        if (sr & 0x100)
+            sr ^= _gfpoly;
+        sr &= q->nn;
+    }
+
+    // find iprim such that (iprim * prim) mod nn == 1
+    for (i=1; (i*_prim) % q->nn != 1; i++)
+        ;
+    q->iprim = i;
+
+    // compute generator polynomial
+    //   g(x) = prod( x - alpha^((fcs+i)*prim) ), i in [0, nroots)
+    // expanded in the normal domain, stored in the log domain
+    unsigned char gp[q->nroots+1];
+    int j;
+    int root;
+    gp[0] = 1;
+    for (i=0, root=_fcs*_prim; i<q->nroots; i++, root+=_prim) {
+        gp[i+1] = 1;
+
+        // multiply current polynomial by (x - alpha^root)
+        for (j=i; j>0; j--) {
+            if (gp[j] != 0)
+                gp[j] = gp[j-1] ^ q->alpha_to[fec_rs_gf256_modnn(q->index_of[gp[j]] + root)];
+            else
+                gp[j] = gp[j-1];
+        }
+        gp[0] = q->alpha_to[fec_rs_gf256_modnn(q->index_of[gp[0]] + root)];
+    }
+
+    q->genpoly = (unsigned char*) malloc((q->nroots+1)*sizeof(unsigned char));
+    for (i=0; i<=q->nroots; i++)
+        q->genpoly[i] = q->index_of[gp[i]];
+
+    return (void*)q;
+}
+
+// destroy internal Reed-Solomon codec object
+void fec_rs_gf256_destroy(void * _rs)
+{
+    struct fec_rs_gf256_s * q = (struct fec_rs_gf256_s*)_rs;
+    free(q->genpoly);
+    free(q);
+}
+
+// encode block, appending parity symbols (interface compatible with
+// libfec's encode_rs_char)
+//  _rs     :   internal codec object
+//  _data   :   data block [size: nn-nroots-pad x 1]
+//  _parity :   output parity symbols [size: nroots x 1]
+void fec_rs_gf256_encode(void *          _rs,
+                         unsigned char * _data,
+                         unsigned char * _parity)
+{
+    struct fec_rs_gf256_s * q = (struct fec_rs_gf256_s*)_rs;
+
+    int i;
+    int j;
+    memset(_parity, 0x00, q->nroots*sizeof(unsigned char));
+
+    // systematic encoding: linear feedback shift register division
+    // by the generator polynomial
+    for (i=0; i<q->nn - q->nroots - q->pad; i++) {
+        unsigned char feedback = q->index_of[_data[i] ^ _parity[0]];
+        if (feedback != FEC_RS_GF256_LOGZERO) {
+            for (j=1; j<q->nroots; j++)
+                _parity[j] ^= q->alpha_to[fec_rs_gf256_modnn(feedback + q->genpoly[q->nroots-j])];
+        }
+
+        // shift register
+        memmove(&_parity[0], &_parity[1], (q->nroots-1)*sizeof(unsigned char));
+        _parity[q->nroots-1] = (feedback != FEC_RS_GF256_LOGZERO) ?
+            q->alpha_to[fec_rs_gf256_modnn(feedback + q->genpoly[0])] : 0;
+    }
+}
+
+// decode block in place, returning the number of symbols corrected or
+// -1 if the block is uncorrectable (interface compatible with
+// libfec's decode_rs_char)
+//  _rs       :   internal codec object
+//  _data     :   received block, data and parity [size: nn-pad x 1]
+//  _eras_pos :   erasure positions in, error positions out (may be NULL)
+//  _no_eras  :   number of erasures in _eras_pos
+int fec_rs_gf256_decode(void *          _rs,
+                        unsigned char * _data,
+                        int *           _eras_pos,
+                        int             _no_eras)
+{
+    struct fec_rs_gf256_s * q = (struct fec_rs_gf256_s*)_rs;
+
+    int nn     = q->nn;
+    int nroots = q->nroots;
+    int pad    = q->pad;
+    int len    = nn - pad;      // received block length
+
+    int i;
+    int j;
+    int r;
+
+    // compute syndromes in the log domain: evaluate the received
+    // polynomial at each root of the generator polynomial using a
+    // Horner recursion (hot loop: one table multiply and one xor per
+    // input symbol per root)
+    unsigned char syn[nroots];
+    unsigned int syn_or = 0;
+    for (i=0; i<nroots; i++) {
+        int step = fec_rs_gf256_modnn((q->fcs + i) * q->prim % nn);
+        unsigned int s = _data[0];
+        for (j=1; j<len; j++) {
+            s = (s == 0) ? _data[j] :
+                _data[j] ^ q->alpha_to[fec_rs_gf256_modnn(q->index_of[s] + step)];
+        }
+        syn_or |= s;
+        syn[i] = q->index_of[s];
+    }
+
+    // early termination: no errors detected, nothing to correct
+    if (syn_or == 0)
+        return 0;
+
+    // initialize error-and-erasure locator polynomial (normal domain)
+    unsigned char lambda[nroots+1];
+    memset(lambda, 0x00, sizeof(lambda));
+    lambda[0] = 1;
+    if (_no_eras > 0) {
+        lambda[1] = q->alpha_to[q->prim * (nn - 1 - (_eras_pos[0] + pad)) % nn];
+        for (i=1; i<_no_eras; i++) {
+            int u = q->prim * (nn - 1 - (_eras_pos[i] + pad)) % nn;
+            for (j=i+1; j>0; j--) {
+                unsigned char tmp = q->index_of[lambda[j-1]];
+                if (tmp != FEC_RS_GF256_LOGZERO)
+                    lambda[j] ^= q->alpha_to[fec_rs_gf256_modnn(u + tmp)];
+            }
+        }
+    }
+
+    // Berlekamp-Massey recursion to find the error locator polynomial
+    unsigned char b[nroots+1];  // correction polynomial, log domain
+    unsigned char t[nroots+1];  // scratch polynomial, normal domain
+    for (i=0; i<=nroots; i++)
+        b[i] = q->index_of[lambda[i]];
+
+    int el = _no_eras;          // current register length
+    for (r=_no_eras+1; r<=nroots; r++) {
+        // compute discrepancy
+        unsigned char discr = 0;
+        for (i=0; i<r; i++) {
+            if (lambda[i] != 0 && syn[r-i-1] != FEC_RS_GF256_LOGZERO)
+                discr ^= q->alpha_to[fec_rs_gf256_modnn(q->index_of[lambda[i]] + syn[r-i-1])];
+        }
+
+        if (discr == 0) {
+            // b(x) <- x*b(x)
+            memmove(&b[1], &b[0], nroots*sizeof(unsigned char));
+            b[0] = FEC_RS_GF256_LOGZERO;
+            continue;
+        }
+
+        unsigned char discr_log = q->index_of[discr];
+
+        // t(x) = lambda(x) - discr * x * b(x)
+        t[0] = lambda[0];
+        for (i=0; i<nroots; i++) {
+            t[i+1] = (b[i] != FEC_RS_GF256_LOGZERO) ?
+                lambda[i+1] ^ q->alpha_to[fec_rs_gf256_modnn(discr_log + b[i])] :
+                lambda[i+1];
+        }
+
+        if (2*el <= r + _no_eras - 1) {
+            el = r + _no_eras - el;
+            // b(x) <- lambda(x) / discr
+            for (i=0; i<=nroots; i++) {
+                b[i] = (lambda[i] == 0) ? FEC_RS_GF256_LOGZERO :
+                    fec_rs_gf256_modnn(q->index_of[lambda[i]] - discr_log + nn);
+            }
+        } else {
+            // b(x) <- x*b(x)
+            memmove(&b[1], &b[0], nroots*sizeof(unsigned char));
+            b[0] = FEC_RS_GF256_LOGZERO;
+        }
+        memcpy(lambda, t, (nroots+1)*sizeof(unsigned char));
+    }
+
+    // convert lambda to the log domain and compute its degree
+    unsigned char lambda_log[nroots+1];
+    int deg_lambda = 0;
+    for (i=0; i<=nroots; i++) {
+        lambda_log[i] = q->index_of[lambda[i]];
+        if (lambda[i] != 0)
+            deg_lambda = i;
+    }
+
+    // Chien search: find roots of the error locator polynomial by
+    // evaluating it at successive field elements; reg[] holds each
+    // coefficient's running exponent so an evaluation costs one table
+    // look-up and one xor per coefficient
+    unsigned char reg[nroots+1];
+    int root[nroots];   // roots, exponent form
+    int loc[nroots];    // error locations
+    int count = 0;
+    memcpy(reg, lambda_log, (nroots+1)*sizeof(unsigned char));
+    int k = q->iprim - 1;
+    for (i=1; i<=nn; i++, k=fec_rs_gf256_modnn(k + q->iprim)) {
+        unsigned int v = 1;
+        for (j=deg_lambda; j>0; j--) {
+            if (reg[j] != FEC_RS_GF256_LOGZERO) {
+                reg[j] = fec_rs_gf256_modnn(reg[j] + j);
+                v ^= q->alpha_to[reg[j]];
+            }
+        }
+        if (v != 0)
+            continue;
+
+        // found a root and its corresponding error location
+        root[count] = i;
+        loc[count]  = k;
+        if (++count == deg_lambda)
+            break;
+    }
+
+    // uncorrectable: number of roots does not match polynomial degree
+    if (count != deg_lambda)
+        return -1;
+
+    // compute error evaluator polynomial
+    //   omega(x) = syn(x) * lambda(x) mod x^nroots
+    // in the log domain
+    int deg_omega = deg_lambda - 1;
+    unsigned char omega[nroots];
+    for (i=0; i<=deg_omega; i++) {
+        unsigned char tmp = 0;
+        for (j=i; j>=0; j--) {
+            if (syn[i-j] != FEC_RS_GF256_LOGZERO && lambda_log[j] != FEC_RS_GF256_LOGZERO)
+                tmp ^= q->alpha_to[fec_rs_gf256_modnn(syn[i-j] + lambda_log[j])];
+        }
+        omega[i] = q->index_of[tmp];
+    }
+
+    // Forney's algorithm: compute error magnitude at each location as
+    //   e = x^(1-fcs) * omega(x^-1) / lambda'(x^-1)
+    for (j=count-1; j>=0; j--) {
+        unsigned char num1 = 0;
+        for (i=deg_omega; i>=0; i--) {
+            if (omega[i] != FEC_RS_GF256_LOGZERO)
+                num1 ^= q->alpha_to[fec_rs_gf256_modnn(omega[i] + i*root[j] % nn)];
+        }
+        unsigned char num2 = q->alpha_to[fec_rs_gf256_modnn(root[j] * (q->fcs - 1) % nn + nn)];
+
+        // formal derivative of lambda contains only odd-power terms
+        unsigned char den = 0;
+        int imax = deg_lambda < nroots-1 ? deg_lambda : nroots-1;
+        for (i = imax & ~1; i>=0; i-=2) {
+            if (lambda_log[i+1] != FEC_RS_GF256_LOGZERO)
+                den ^= q->alpha_to[fec_rs_gf256_modnn(lambda_log[i+1] + i*root[j] % nn)];
+        }
+        if (den == 0)
+            return -1;
+
+        // apply error correction
+        if (num1 != 0 && loc[j] >= pad) {
+            _data[loc[j] - pad] ^=
+                q->alpha_to[fec_rs_gf256_modnn(q->index_of[num1] + q->index_of[num2] +
+                                               nn - q->index_of[den])];
+        }
+    }
+
+    // report error locations
+    if (_eras_pos != NULL) {
+        for (i=0; i<count; i++)
+            _eras_pos[i] = loc[i] - pad;
+    }
+
+    return count;
+}
+
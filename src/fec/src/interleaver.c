@@ -37,31 +37,36 @@
 // internal methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N);
-
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N);
-
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask);
-
-// permute one iteration (soft bit input) with mask
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask);
+// maximum interleaving depth (number of planned permutation tables)
+#define LIQUID_INTERLEAVER_MAX_DEPTH (4)
+
+// generate planned permutation table for one iteration
+void interleaver_plan_permutation(unsigned int * _p,
+                                  unsigned int   _n,
+                                  unsigned int   _M,
+                                  unsigned int   _N);
+
+// permute one iteration from planned table
+void interleaver_permute(unsigned char *      _x,
+                         const unsigned int * _p,
+                         unsigned int         _n2);
+
+// permute one iteration from planned table (soft bit input)
+void interleaver_permute_soft(unsigned char *      _x,
+                              const unsigned int * _p,
+                              unsigned int         _n2);
+
+// permute one iteration from planned table with mask
+void interleaver_permute_mask(unsigned char *      _x,
+                              const unsigned int * _p,
+                              unsigned int         _n2,
+                              unsigned char        _mask);
+
+// permute one iteration from planned table (soft bit input) with mask
+void interleaver_permute_mask_soft(unsigned char *      _x,
+                                   const unsigned int * _p,
+                                   unsigned int         _n2,
+                                   unsigned char        _mask);
 
 
 // structured interleaver object
@@ -73,6 +78,13 @@ struct interleaver_s {
 
     // interleaving depth (number of permutations)
     unsigned int depth;
+
+    // planned permutation tables, one per iteration; generating the
+    // swap indices is a serial recursion, so it is run once here
+    // rather than on every encode/decode invocation
+    unsigned int n2;        // number of swaps per iteration: n/2
+    unsigned int n2_cap;    // allocated swap-table capacity
+    unsigned int * p[LIQUID_INTERLEAVER_MAX_DEPTH];
 };
 
 // create interleaver of length _n input/output bytes
@@ -90,12 +102,67 @@ interleaver interleaver_create(unsigned int _n)
     q->N = q->n / q->M;
     while (q->n >= (q->M*q->N)) q->N++;  // ensures M*N >= n
 
+    // generate planned permutation tables (iteration i permutes the
+    // M x (N + 2^i - [i>0]) block arrangement)
+    unsigned int i;
+    q->n2 = q->n / 2;
+    q->n2_cap = q->n2;
+    unsigned int N_i[LIQUID_INTERLEAVER_MAX_DEPTH] = {q->N, q->N+2, q->N+4, q->N+8};
+    for (i=0; i<LIQUID_INTERLEAVER_MAX_DEPTH; i++) {
+        q->p[i] = (unsigned int*) malloc(q->n2*sizeof(unsigned int));
+        interleaver_plan_permutation(q->p[i], q->n, q->M, N_i[i]);
+    }
+
     return q;
 }
 
+// re-create interleaver for a new length, re-planning the permutation
+// tables in place and growing them only when the new length exceeds
+// their allocated capacity
+interleaver interleaver_recreate(interleaver  _q,
+                                 unsigned int _n)
+{
+    if (_q == NULL) {
+        // interleaver was never created
+        return interleaver_create(_n);
+    }
+
+    // no change; return input pointer
+    if (_q->n == _n)
+        return _q;
+
+    _q->n = _n;
+
+    // re-compute block dimensions
+    _q->M = 1 + (unsigned int) floorf(sqrtf(_q->n));
+    _q->N = _q->n / _q->M;
+    while (_q->n >= (_q->M*_q->N)) _q->N++;  // ensures M*N >= n
+
+    // grow permutation tables if necessary
+    unsigned int i;
+    _q->n2 = _q->n / 2;
+    if (_q->n2 > _q->n2_cap) {
+        _q->n2_cap = _q->n2;
+        for (i=0; i<LIQUID_INTERLEAVER_MAX_DEPTH; i++)
+            _q->p[i] = (unsigned int*) realloc(_q->p[i], _q->n2_cap*sizeof(unsigned int));
+    }
+
+    // re-generate planned permutation tables
+    unsigned int N_i[LIQUID_INTERLEAVER_MAX_DEPTH] = {_q->N, _q->N+2, _q->N+4, _q->N+8};
+    for (i=0; i<LIQUID_INTERLEAVER_MAX_DEPTH; i++)
+        interleaver_plan_permutation(_q->p[i], _q->n, _q->M, N_i[i]);
+
+    return _q;
+}
+
 // destroy interleaver object
 void interleaver_destroy(interleaver _q)
 {
+    // free planned permutation tables
+    unsigned int i;
+    for (i=0; i<LIQUID_INTERLEAVER_MAX_DEPTH; i++)
+        free(_q->p[i]);
+
     // free main object memory
     free(_q);
 }
@@ -127,10 +194,10 @@ void interleaver_encode(interleaver _q,
     // copy data to output
     memmove(_msg_enc, _msg_dec, _q->n);
 
-    if (_q->depth > 0) interleaver_permute(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    if (_q->depth > 0) interleaver_permute(_msg_enc, _q->p[0], _q->n2);
+    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, _q->p[1], _q->n2, 0x0f);
+    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, _q->p[2], _q->n2, 0x55);
+    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, _q->p[3], _q->n2, 0x33);
 }
 
 // execute forward interleaver (encoder) on soft bits
@@ -144,10 +211,10 @@ void interleaver_encode_soft(interleaver _q,
     // copy data to output
     memmove(_msg_enc, _msg_dec, 8*_q->n);
 
-    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, _q->p[0], _q->n2);
+    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, _q->p[1], _q->n2, 0x0f);
+    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, _q->p[2], _q->n2, 0x55);
+    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, _q->p[3], _q->n2, 0x33);
 }
 
 // execute reverse interleaver (decoder)
@@ -161,10 +228,10 @@ void interleaver_decode(interleaver _q,
     // copy data to output
     memmove(_msg_dec, _msg_enc, _q->n);
 
-    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute(_msg_dec, _q->n, _q->M, _q->N);
+    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, _q->p[3], _q->n2, 0x33);
+    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, _q->p[2], _q->n2, 0x55);
+    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, _q->p[1], _q->n2, 0x0f);
+    if (_q->depth > 0) interleaver_permute(_msg_dec, _q->p[0], _q->n2);
 }
 
 // execute reverse interleaver (decoder) on soft bits
@@ -178,28 +245,33 @@ void interleaver_decode_soft(interleaver _q,
     // copy data to output
     memmove(_msg_dec, _msg_enc, 8*_q->n);
 
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, _q->n, _q->M, _q->N);
+    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, _q->p[3], _q->n2, 0x33);
+    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, _q->p[2], _q->n2, 0x55);
+    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, _q->p[1], _q->n2, 0x0f);
+    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, _q->p[0], _q->n2);
 }
 
 // 
 // internal permutation methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N)
+// generate planned permutation table for one iteration; runs the
+// serial swap-index recursion once so the encode/decode hot paths
+// reduce to table-driven swaps
+//  _p  :   output table of swap indices [size: _n/2 x 1]
+//  _n  :   number of bytes
+//  _M  :   row dimension
+//  _N  :   col dimension
+void interleaver_plan_permutation(unsigned int * _p,
+                                  unsigned int   _n,
+                                  unsigned int   _M,
+                                  unsigned int   _N)
 {
     unsigned int i;
     unsigned int j;
     unsigned int m=0;
     unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp;
     for (i=0; i<n2; i++) {
         //j = m*N + n; // input
         do {
@@ -211,6 +283,21 @@ void interleaver_permute(unsigned char * _x,
             }
         } while (j>=n2);
 
+        _p[i] = j;
+    }
+}
+
+// permute one iteration from planned table
+void interleaver_permute(unsigned char *      _x,
+                         const unsigned int * _p,
+                         unsigned int         _n2)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned char tmp;
+    for (i=0; i<_n2; i++) {
+        j = _p[i];
+
         // swap indices
         tmp = _x[2*j+1];
         _x[2*j+1] = _x[2*i+0];
@@ -218,62 +305,37 @@ void interleaver_permute(unsigned char * _x,
     }
 }
 
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N)
+// permute one iteration from planned table (soft bit input)
+void interleaver_permute_soft(unsigned char *      _x,
+                              const unsigned int * _p,
+                              unsigned int         _n2)
 {
     unsigned int i;
     unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
     unsigned char tmp[8];
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-    
+    for (i=0; i<_n2; i++) {
+        j = _p[i];
+
         // swap soft bits at indices
         memmove( tmp,            &_x[8*(2*j+1)], 8);
         memmove( &_x[8*(2*j+1)], &_x[8*(2*i+0)], 8);
         memmove( &_x[8*(2*i+0)], tmp,            8);
     }
-    //printf("\n");
 }
 
 
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask)
+// permute one iteration from planned table with mask
+void interleaver_permute_mask(unsigned char *      _x,
+                              const unsigned int * _p,
+                              unsigned int         _n2,
+                              unsigned char        _mask)
 {
     unsigned int i;
     unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
     unsigned char tmp0;
     unsigned char tmp1;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
+    for (i=0; i<_n2; i++) {
+        j = _p[i];
 
         // swap indices, applying mask
         tmp0 = (_x[2*i+0] & (~_mask)) | (_x[2*j+1] & ( _mask));
@@ -283,30 +345,18 @@ void interleaver_permute_mask(unsigned char * _x,
     }
 }
 
-// permute one iteration (soft bit input)
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask)
+// permute one iteration from planned table (soft bit input) with mask
+void interleaver_permute_mask_soft(unsigned char *      _x,
+                                   const unsigned int * _p,
+                                   unsigned int         _n2,
+                                   unsigned char        _mask)
 {
     unsigned int i;
     unsigned int j;
     unsigned int k;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
     unsigned char tmp;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
+    for (i=0; i<_n2; i++) {
+        j = _p[i];
 
         // swap bits matching the mask
         for (k=0; k<8; k++) {
@@ -317,6 +367,5 @@ void interleaver_permute_mask_soft(unsigned char * _x,
             }
         }
     }
-    //printf("\n");
 }
 
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// minsum.c
+//
+// normalized min-sum decoder for LDPC codes with a layered (serial)
+// schedule and 16-bit fixed-point messages; considerably faster than
+// the flooding sum-product implementation in sumproduct.c as each
+// check node update requires only comparisons and additions (no
+// transcendental functions), the posterior is refreshed after every
+// layer (roughly halving the number of iterations needed), and
+// messages are stored only on the non-zero entries of the sparse
+// parity check matrix
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#define DEBUG_MINSUM 0
+
+// fixed-point log-likelihood representation: Q8.8
+#define MINSUM_FRACBITS (8)
+#define MINSUM_LLR_MAX  (32767)
+
+// saturate 32-bit accumulator to 16-bit message range
+static inline int16_t fec_minsum_sat(int32_t _v)
+{
+    if (_v >  MINSUM_LLR_MAX) return  MINSUM_LLR_MAX;
+    if (_v < -MINSUM_LLR_MAX) return -MINSUM_LLR_MAX;
+    return (int16_t)_v;
+}
+
+// run layered normalized min-sum decoder:
+// returns 1 if parity checks, 0 otherwise
+//  _m          :   rows
+//  _n          :   cols
+//  _H          :   sparse binary parity check matrix [size: _m x _n]
+//  _LLR        :   received signal (soft bits, LLR) [size: _n x 1]
+//  _c_hat      :   estimated transmitted signal [size: _n x 1]
+//  _max_steps  :   maximum number of iterations before bailing
+int fec_minsum(unsigned int    _m,
+               unsigned int    _n,
+               smatrixb        _H,
+               float *         _LLR,
+               unsigned char * _c_hat,
+               unsigned int    _max_steps)
+{
+    // validate input
+    if (_n == 0 || _m == 0) {
+        fprintf(stderr,"error: fec_minsum(), matrix dimensions cannot be zero\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int j;
+    unsigned int e;
+
+    // count non-zero entries of _H and build compressed row adjacency
+    // so each iteration touches only the edges of the Tanner graph
+    unsigned int num_edges = 0;
+    unsigned int row_ptr[_m+1];
+    for (j=0; j<_m; j++) {
+        row_ptr[j] = num_edges;
+        for (i=0; i<_n; i++) {
+            if (smatrixb_get(_H,j,i))
+                num_edges++;
+        }
+    }
+    row_ptr[_m] = num_edges;
+
+    unsigned int col_idx[num_edges];
+    e = 0;
+    for (j=0; j<_m; j++) {
+        for (i=0; i<_n; i++) {
+            if (smatrixb_get(_H,j,i))
+                col_idx[e++] = i;
+        }
+    }
+
+    // posterior log-likelihoods, quantized to Q8.8
+    int16_t L[_n];
+    for (i=0; i<_n; i++) {
+        float v = _LLR[i] * (float)(1<<MINSUM_FRACBITS);
+        if      (v >  MINSUM_LLR_MAX) L[i] =  MINSUM_LLR_MAX;
+        else if (v < -MINSUM_LLR_MAX) L[i] = -MINSUM_LLR_MAX;
+        else                          L[i] = (int16_t)v;
+    }
+
+    // check-to-variable messages, one per edge
+    int16_t R[num_edges];
+    for (e=0; e<num_edges; e++)
+        R[e] = 0;
+
+    unsigned int num_iterations = 0;
+    int parity_pass = 0;
+    while (num_iterations < _max_steps) {
+        // layered schedule: update one check node (row) at a time,
+        // folding its new messages back into the posterior immediately
+        for (j=0; j<_m; j++) {
+            unsigned int e0 = row_ptr[j];
+            unsigned int e1 = row_ptr[j+1];
+
+            // strip old messages and find the two smallest magnitudes
+            // together with the overall sign parity
+            int16_t      Lq[e1-e0];
+            unsigned int sp     = 0;            // sign parity of row
+            int32_t      min1   = MINSUM_LLR_MAX;
+            int32_t      min2   = MINSUM_LLR_MAX;
+            unsigned int argmin = 0;
+            for (e=e0; e<e1; e++) {
+                int16_t v = fec_minsum_sat((int32_t)L[col_idx[e]] - (int32_t)R[e]);
+                Lq[e-e0] = v;
+
+                sp ^= (v < 0);
+                int32_t mag = v < 0 ? -v : v;
+                if (mag < min1) {
+                    min2   = min1;
+                    min1   = mag;
+                    argmin = e;
+                } else if (mag < min2) {
+                    min2 = mag;
+                }
+            }
+
+            // compute normalized extrinsic messages and update posterior
+            for (e=e0; e<e1; e++) {
+                int16_t v   = Lq[e-e0];
+                int32_t mag = (e==argmin) ? min2 : min1;
+
+                // normalization factor alpha = 0.75 compensates the
+                // min-sum over-estimate of the extrinsic reliability
+                mag = (3*mag) >> 2;
+
+                // extrinsic sign: product of the signs of all other
+                // inputs to this check node
+                int16_t r = (sp ^ (v < 0)) ? (int16_t)-mag : (int16_t)mag;
+
+                R[e] = r;
+                L[col_idx[e]] = fec_minsum_sat((int32_t)v + (int32_t)r);
+            }
+        }
+        num_iterations++;
+
+        // compute hard-decoded value
+        for (i=0; i<_n; i++)
+            _c_hat[i] = L[i] < 0 ? 1 : 0;
+
+        // early termination: compute syndrome over row adjacency and
+        // stop as soon as all parity checks are satisfied
+        parity_pass = 1;
+        for (j=0; j<_m; j++) {
+            unsigned int p = 0;
+            for (e=row_ptr[j]; e<row_ptr[j+1]; e++)
+                p ^= _c_hat[col_idx[e]];
+            if (p) {
+                parity_pass = 0;
+                break;
+            }
+        }
+
+#if DEBUG_MINSUM
+        printf("fec_minsum(), iteration %u : parity %s\n",
+                num_iterations, parity_pass ? "pass" : "FAIL");
+#endif
+        if (parity_pass)
+            break;
+    }
+
+    return parity_pass;
+}
+
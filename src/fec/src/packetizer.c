@@ -30,7 +30,8 @@
 
 #include "liquid.internal.h"
 
-// reallocate memory for buffers
+// reallocate memory for buffers, retaining any existing allocation
+// that is already large enough
 void packetizer_realloc_buffers(packetizer _p, unsigned int _len);
 
 // computes the number of encoded bytes after packetizing
@@ -102,10 +103,11 @@ packetizer packetizer_create(unsigned int _n,
     p->check        = _crc;
     p->crc_length   = crc_get_length(p->check);
 
-    // allocate memory for buffers (scale by 8 for soft decoding)
-    p->buffer_len = p->packet_len;
-    p->buffer_0 = (unsigned char*) malloc(8*p->buffer_len);
-    p->buffer_1 = (unsigned char*) malloc(8*p->buffer_len);
+    // allocate memory for buffers (scaled by 8 for soft decoding)
+    p->buffer_len = 0;
+    p->buffer_0 = NULL;
+    p->buffer_1 = NULL;
+    packetizer_realloc_buffers(p, p->packet_len);
 
     // create plan
     p->plan_len = 2;
@@ -167,8 +169,41 @@ packetizer packetizer_recreate(packetizer _p,
         return _p;
     }
 
-    // something has changed; destroy old object and create new one
-    // TODO : rather than completely destroying object, only change values that are necessary
+    // schemes unchanged: only the message length has changed, so
+    // adjust the plan lengths in place, re-creating just the
+    // interleavers and growing the staging buffers as necessary
+    // (much cheaper than rebuilding the fec codecs)
+    if (_p->check       ==  _crc    &&
+        _p->plan[0].fs  ==  _fec0   &&
+        _p->plan[1].fs  ==  _fec1 )
+    {
+        _p->msg_len    = _n;
+        _p->packet_len = packetizer_compute_enc_msg_len(_n, _crc, _fec0, _fec1);
+
+        unsigned int i;
+        unsigned int n0 = _n + _p->crc_length;
+        for (i=0; i<_p->plan_len; i++) {
+            // update lengths
+            _p->plan[i].dec_msg_len = n0;
+            _p->plan[i].enc_msg_len = fec_get_enc_msg_length(_p->plan[i].fs,
+                                                             _p->plan[i].dec_msg_len);
+
+            // re-plan interleaver in place (tables depend upon length);
+            // its depth is retained so the FEC_NONE setting persists
+            _p->plan[i].q = interleaver_recreate(_p->plan[i].q,
+                                                 _p->plan[i].enc_msg_len);
+
+            // update length
+            n0 = _p->plan[i].enc_msg_len;
+        }
+
+        // grow staging buffers if necessary
+        packetizer_realloc_buffers(_p, _p->packet_len);
+
+        return _p;
+    }
+
+    // something else has changed; destroy old object and create new one
     packetizer_destroy(_p);
     return packetizer_create(_n,_crc,_fec0,_fec1);
 }
@@ -276,7 +311,8 @@ void packetizer_encode(packetizer            _p,
     // whiten input sequence
     scramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
 
-    // execute fec/interleaver plans
+    // execute fec/interleaver plans; the final interleaver writes
+    // directly to the caller's output to avoid a trailing copy
     for (i=0; i<_p->plan_len; i++) {
         // run the encoder: buffer[0] > buffer[1]
         fec_encode(_p->plan[i].f,
@@ -284,14 +320,11 @@ void packetizer_encode(packetizer            _p,
                    _p->buffer_0,
                    _p->buffer_1);
 
-        // run the interleaver: buffer[1] > buffer[0]
+        // run the interleaver: buffer[1] > buffer[0] (or output)
         interleaver_encode(_p->plan[i].q,
                            _p->buffer_1,
-                           _p->buffer_0);
+                           i==_p->plan_len-1 ? _pkt : _p->buffer_0);
     }
-
-    // copy result to output
-    memmove(_pkt, _p->buffer_0, _p->packet_len);
 }
 
 // Execute the packetizer to decode an input message, return validity
@@ -304,15 +337,13 @@ int packetizer_decode(packetizer            _p,
                       const unsigned char * _pkt,
                       unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, _p->packet_len);
-
-    // execute fec/interleaver plans
+    // execute fec/interleaver plans; the first de-interleaver reads
+    // directly from the caller's input to avoid a leading copy
     unsigned int i;
     for (i=_p->plan_len; i>0; i--) {
-        // run the de-interleaver: buffer[0] > buffer[1]
+        // run the de-interleaver: buffer[0] (or input) > buffer[1]
         interleaver_decode(_p->plan[i-1].q,
-                           _p->buffer_0,
+                           i==_p->plan_len ? (unsigned char*)_pkt : _p->buffer_0,
                            _p->buffer_1);
 
         // run the decoder: buffer[1] > buffer[0]
@@ -353,45 +384,54 @@ int packetizer_decode_soft(packetizer            _p,
                            const unsigned char * _pkt,
                            unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, 8*_p->packet_len);
-
-    // 
-    // decode outer level using soft decoding
-    //
-
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode_soft(_p->plan[1].q,
-                            _p->buffer_0,
-                            _p->buffer_1);
-
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode_soft(_p->plan[1].f,
-                    _p->plan[1].dec_msg_len,
-                    _p->buffer_1,
-                    _p->buffer_0);
-
-    // 
-    // decode inner level using hard decoding
-    //
-
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode(_p->plan[0].q,
-                       _p->buffer_0,
-                       _p->buffer_1);
-
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode(_p->plan[0].f,
-               _p->plan[0].dec_msg_len,
-               _p->buffer_1,
-               _p->buffer_0);
+    // execute fec/interleaver plans, retaining the soft-bit
+    // representation through outer stages that apply no error
+    // correction so the innermost decoder still sees soft input;
+    // once a level has been decoded the remaining (inner) stages
+    // run on hard bytes
+    unsigned int i;
+    int soft = 1;
+    for (i=_p->plan_len; i>0; i--) {
+        if (soft) {
+            // run the soft de-interleaver: buffer[0] (or input) > buffer[1]
+            // (the first stage reads directly from the caller's input)
+            interleaver_decode_soft(_p->plan[i-1].q,
+                                    i==_p->plan_len ? (unsigned char*)_pkt : _p->buffer_0,
+                                    _p->buffer_1);
+
+            if (_p->plan[i-1].fs == LIQUID_FEC_NONE && i > 1) {
+                // no error correction at this level: pass soft bits
+                // through to the next stage
+                memmove(_p->buffer_0, _p->buffer_1, 8*_p->plan[i-1].dec_msg_len);
+            } else {
+                // run the soft decoder: buffer[1] > buffer[0]
+                // (schemes without a soft decoder internally make
+                // hard decisions on the input bits)
+                fec_decode_soft(_p->plan[i-1].f,
+                                _p->plan[i-1].dec_msg_len,
+                                _p->buffer_1,
+                                _p->buffer_0);
+                soft = 0;
+            }
+        } else {
+            // run the de-interleaver: buffer[0] > buffer[1]
+            interleaver_decode(_p->plan[i-1].q,
+                               _p->buffer_0,
+                               _p->buffer_1);
+
+            // run the decoder: buffer[1] > buffer[0]
+            fec_decode(_p->plan[i-1].f,
+                       _p->plan[i-1].dec_msg_len,
+                       _p->buffer_1,
+                       _p->buffer_0);
+        }
+    }
 
     // remove sequence whitening
     unscramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
 
     // strip crc, validate message
     unsigned int key = 0;
-    unsigned int i;
     for (i=0; i<_p->crc_length; i++) {
         key <<= 8;
 
@@ -419,8 +459,14 @@ void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
 
 void packetizer_realloc_buffers(packetizer _p, unsigned int _len)
 {
+    // retain existing allocation if it is already large enough so
+    // that length changes within a previous maximum are free
+    if (_len <= _p->buffer_len)
+        return;
+
+    // allocate memory for buffers (scaled by 8 for soft decoding)
     _p->buffer_len = _len;
-    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, _p->buffer_len);
-    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, _p->buffer_len);
+    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, 8*_p->buffer_len);
+    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, 8*_p->buffer_len);
 }
 
@@ -32,25 +32,19 @@ void fec_test_soft_codec(fec_scheme _fs,
                          void * _opts)
 {
 #if !LIBFEC_ENABLED
-    if ( _fs == LIQUID_FEC_CONV_V27    ||
-         _fs == LIQUID_FEC_CONV_V29    ||
+    // K=7 convolutional codes use the internal Viterbi engine and are
+    // always available
+    if ( _fs == LIQUID_FEC_CONV_V29    ||
          _fs == LIQUID_FEC_CONV_V39    ||
          _fs == LIQUID_FEC_CONV_V615   ||
-         _fs == LIQUID_FEC_CONV_V27P23 ||
-         _fs == LIQUID_FEC_CONV_V27P34 ||
-         _fs == LIQUID_FEC_CONV_V27P45 ||
-         _fs == LIQUID_FEC_CONV_V27P56 ||
-         _fs == LIQUID_FEC_CONV_V27P67 ||
-         _fs == LIQUID_FEC_CONV_V27P78 ||
          _fs == LIQUID_FEC_CONV_V29P23 ||
          _fs == LIQUID_FEC_CONV_V29P34 ||
          _fs == LIQUID_FEC_CONV_V29P45 ||
          _fs == LIQUID_FEC_CONV_V29P56 ||
          _fs == LIQUID_FEC_CONV_V29P67 ||
-         _fs == LIQUID_FEC_CONV_V29P78 ||
-         _fs == LIQUID_FEC_RS_M8)
+         _fs == LIQUID_FEC_CONV_V29P78)
     {
-        AUTOTEST_WARN("convolutional, Reed-Solomon codes unavailable (install libfec)\n");
+        AUTOTEST_WARN("K=9, K=15 convolutional codes unavailable (install libfec)\n");
         return;
     }
 #endif
@@ -85,3 +85,43 @@ void autotest_interleaver_soft_16()     { interleaver_test_soft(16  ); }
 void autotest_interleaver_soft_64()     { interleaver_test_soft(64  ); }
 void autotest_interleaver_soft_256()    { interleaver_test_soft(256 ); }
 
+
+// 
+// AUTOTEST: in-place re-creation matches a freshly created object
+//
+void autotest_interleaver_recreate()
+{
+    unsigned int lens[4] = {64, 256, 16, 100};
+    unsigned int i, j;
+    unsigned char x[256];
+    unsigned char y0[256];
+    unsigned char y1[256];
+    unsigned char z[256];
+
+    // create interleaver object with initial length
+    interleaver q0 = interleaver_create(lens[0]);
+
+    for (j=0; j<4; j++) {
+        unsigned int n = lens[j];
+
+        // re-create object with new length (grows and shrinks)
+        q0 = interleaver_recreate(q0, n);
+
+        for (i=0; i<n; i++)
+            x[i] = rand() & 0xFF;
+
+        // permutation must match a freshly created object...
+        interleaver q1 = interleaver_create(n);
+        interleaver_encode(q0, x, y0);
+        interleaver_encode(q1, x, y1);
+        CONTEND_SAME_DATA(y0, y1, n);
+        interleaver_destroy(q1);
+
+        // ...and still invert properly
+        interleaver_decode(q0, y0, z);
+        CONTEND_SAME_DATA(x, z, n);
+    }
+
+    // destroy interleaver object
+    interleaver_destroy(q0);
+}
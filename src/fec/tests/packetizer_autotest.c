@@ -58,6 +58,53 @@ void packetizer_test_codec(unsigned int _n,
     packetizer_destroy(p);
 }
 
+// Help function to keep code base small; expands the encoded packet
+// into weakly-confident soft bits (with additive noise) and ensures
+// the soft decoder recovers the original message
+void packetizer_test_codec_soft(unsigned int _n,
+                                crc_scheme _crc,
+                                fec_scheme _fec0,
+                                fec_scheme _fec1)
+{
+    unsigned char msg_tx[_n];
+    unsigned char msg_rx[_n];
+    unsigned int pkt_len = packetizer_compute_enc_msg_len(_n,_crc,_fec0,_fec1);
+    unsigned char packet[pkt_len];
+    unsigned char packet_soft[8*pkt_len];
+
+    // create object
+    packetizer p = packetizer_create(_n,_crc,_fec0,_fec1);
+
+    if (liquid_autotest_verbose)
+        packetizer_print(p);
+
+    // initialize data
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        msg_tx[i] = i % 256;
+        msg_rx[i] = 0;
+    }
+
+    // encode packet
+    packetizer_encode(p, msg_tx, packet);
+
+    // expand to soft bits, reducing confidence with pseudo-random noise
+    for (i=0; i<8*pkt_len; i++) {
+        unsigned char bit   = (packet[i/8] >> (7-(i%8))) & 0x01;
+        unsigned char noise = (i*37) % 64;
+        packet_soft[i] = bit ? LIQUID_SOFTBIT_1 - noise : LIQUID_SOFTBIT_0 + noise;
+    }
+
+    // decode packet (soft bits)
+    int crc_pass = packetizer_decode_soft(p, packet_soft, msg_rx);
+
+    CONTEND_SAME_DATA(msg_tx, msg_rx, _n);
+    CONTEND_EQUALITY(crc_pass, 1);
+
+    // clean up objects
+    packetizer_destroy(p);
+}
+
 //
 // AUTOTESTS
 //
@@ -65,3 +112,48 @@ void autotest_packetizer_n16_0_0()  { packetizer_test_codec(16, LIQUID_CRC_32, L
 void autotest_packetizer_n16_0_1()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_REP3);       }
 void autotest_packetizer_n16_0_2()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING74);  }
 
+// ensure codec integrity is maintained through re-creation, both when
+// only the message length changes (plan updated in place) and when the
+// schemes change (object rebuilt)
+void autotest_packetizer_recreate()
+{
+    unsigned int n;
+    unsigned char msg_tx[64];
+    unsigned char msg_rx[64];
+    unsigned char packet[512];
+    unsigned int i;
+    for (i=0; i<64; i++)
+        msg_tx[i] = i % 256;
+
+    // create object
+    packetizer p = packetizer_create(16, LIQUID_CRC_32, LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE);
+
+    // re-create with a longer message, same schemes
+    p = packetizer_recreate(p, 64, LIQUID_CRC_32, LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE);
+    n = packetizer_get_enc_msg_len(p);
+    CONTEND_EQUALITY( n, packetizer_compute_enc_msg_len(64, LIQUID_CRC_32, LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE) );
+    packetizer_encode(p, msg_tx, packet);
+    CONTEND_EQUALITY( packetizer_decode(p, packet, msg_rx), 1 );
+    CONTEND_SAME_DATA( msg_tx, msg_rx, 64 );
+
+    // re-create with a shorter message, same schemes
+    p = packetizer_recreate(p, 16, LIQUID_CRC_32, LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE);
+    packetizer_encode(p, msg_tx, packet);
+    CONTEND_EQUALITY( packetizer_decode(p, packet, msg_rx), 1 );
+    CONTEND_SAME_DATA( msg_tx, msg_rx, 16 );
+
+    // re-create with different schemes
+    p = packetizer_recreate(p, 32, LIQUID_CRC_16, LIQUID_FEC_REP3, LIQUID_FEC_HAMMING128);
+    packetizer_encode(p, msg_tx, packet);
+    CONTEND_EQUALITY( packetizer_decode(p, packet, msg_rx), 1 );
+    CONTEND_SAME_DATA( msg_tx, msg_rx, 32 );
+
+    // clean up objects
+    packetizer_destroy(p);
+}
+
+void autotest_packetizer_soft_n16_0_0()  { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_NONE,       LIQUID_FEC_NONE);       }
+void autotest_packetizer_soft_n16_1_0()  { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_HAMMING128, LIQUID_FEC_NONE);       }
+void autotest_packetizer_soft_n16_2_0()  { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_CONV_V27,   LIQUID_FEC_NONE);       }
+void autotest_packetizer_soft_n16_1_1()  { packetizer_test_codec_soft(16, LIQUID_CRC_32, LIQUID_FEC_HAMMING74,  LIQUID_FEC_REP3);       }
+
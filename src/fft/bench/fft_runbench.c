@@ -26,8 +26,10 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #include <sys/resource.h>
 #include "liquid.h"
+#include "bench/liquid_benchmark.h"
 
 // Helper function to keep code base small
 void fft_runbench(struct rusage *     _start,
@@ -63,6 +65,11 @@ void fft_runbench(struct rusage *     _start,
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
 
+    // roofline workload annotation (per transform): input and output
+    // buffers traversed once; ~5 N log2(N) floating-point operations
+    liquid_benchmark_workload.bytes_per_trial = 2.0f * _nfft * sizeof(float complex);
+    liquid_benchmark_workload.flops_per_trial = 5.0f * _nfft * log2f((float)_nfft);
+
     fft_destroy_plan(q);
     free(x);
     free(y);
@@ -45,8 +45,18 @@ struct ASGRAM(_s) {
     unsigned int num_levels;    // number of levels
     float        div;           // dB per division
     float        ref;           // dB reference value
+
+    char *       line_prev;     // previously-rendered character line
+    int          line_valid;    // has a line been rendered yet?
 };
 
+// internal method to render the character line from the current
+// periodogram contents
+void ASGRAM(_render)(ASGRAM() _q,
+                     char *   _ascii,
+                     float *  _peakval,
+                     float *  _peakfreq);
+
 // create asgram object with size _nfft
 ASGRAM() ASGRAM(_create)(unsigned int _nfft)
 {
@@ -72,6 +82,10 @@ ASGRAM() ASGRAM(_create)(unsigned int _nfft)
     // create spectral periodogram object
     q->periodogram = SPGRAM(_create)(q->nfftp,LIQUID_WINDOW_HANN,q->nfft,q->nfft/2);
 
+    // allocate memory for previously-rendered line (differential rendering)
+    q->line_prev  = (char *) malloc((q->nfft)*sizeof(char));
+    q->line_valid = 0;
+
     // power spectral density levels
     q->num_levels = 10;
     ASGRAM(_set_display)(q," .,-+*&NM#");
@@ -89,6 +103,7 @@ void ASGRAM(_destroy)(ASGRAM() _q)
     // free PSD estimate array
     free(_q->X);
     free(_q->psd);
+    free(_q->line_prev);
 
     // free main object memory
     free(_q);
@@ -98,6 +113,7 @@ void ASGRAM(_destroy)(ASGRAM() _q)
 void ASGRAM(_reset)(ASGRAM() _q)
 {
     SPGRAM(_reset)(_q->periodogram);
+    _q->line_valid = 0;
 }
 
 // set scale and offset for spectrogram
@@ -179,6 +195,73 @@ void ASGRAM(_execute)(ASGRAM() _q,
         return;
     }
 
+    // render character line
+    ASGRAM(_render)(_q, _ascii, _peakval, _peakfreq);
+
+    // retain line for differential rendering
+    memmove(_q->line_prev, _ascii, _q->nfft);
+    _q->line_valid = 1;
+}
+
+// compute spectral periodogram output from current buffer contents,
+// reporting only cells which changed since the last render
+//  _q           : ascii spectrogram object
+//  _ascii       : output ASCII string [size: _nfft x 1]
+//  _changed     : output indices of changed cells [size: _nfft x 1]
+//  _num_changed : number of changed cells (returned value)
+//  _peakval     : value at peak (returned value)
+//  _peakfreq    : frequency at peak (returned value)
+// returns dirty flag: 1 if any cell changed, 0 otherwise
+int ASGRAM(_execute_diff)(ASGRAM()       _q,
+                          char *         _ascii,
+                          unsigned int * _changed,
+                          unsigned int * _num_changed,
+                          float *        _peakval,
+                          float *        _peakfreq)
+{
+    // no new data accumulated: previous line remains current
+    if (SPGRAM(_get_num_transforms)(_q->periodogram)==0) {
+        if (_q->line_valid)
+            memmove(_ascii, _q->line_prev, _q->nfft);
+        else
+            memset(_ascii,' ',_q->nfft);
+        *_num_changed = 0;
+        *_peakval = 0.0f;
+        *_peakfreq = 0.0f;
+        return 0;
+    }
+
+    // render character line
+    ASGRAM(_render)(_q, _ascii, _peakval, _peakfreq);
+
+    // compare against previously-rendered line; on the first render
+    // every cell is reported as changed
+    unsigned int i;
+    unsigned int num_changed = 0;
+    for (i=0; i<_q->nfft; i++) {
+        if (!_q->line_valid || _ascii[i] != _q->line_prev[i])
+            _changed[num_changed++] = i;
+    }
+    *_num_changed = num_changed;
+
+    // retain line for next comparison
+    memmove(_q->line_prev, _ascii, _q->nfft);
+    _q->line_valid = 1;
+
+    return num_changed > 0 ? 1 : 0;
+}
+
+// internal method to render the character line from the current
+// periodogram contents
+//  _q          :   ascii spectrogram object
+//  _ascii      :   output ASCII string [size: _nfft x 1]
+//  _peakval    :   value at peak (returned value)
+//  _peakfreq   :   frequency at peak (returned value)
+void ASGRAM(_render)(ASGRAM() _q,
+                     char *   _ascii,
+                     float *  _peakval,
+                     float *  _peakfreq)
+{
     // execute spectral periodogram
     SPGRAM(_get_psd)(_q->periodogram, _q->psd);
     SPGRAM(_reset)(_q->periodogram);
@@ -195,6 +278,7 @@ void ASGRAM(_execute)(ASGRAM() _q,
 
     // down-sample from nfft*p frequency bins to just nfft by retaining
     // one value (e.g. maximum or average) over range.
+    float gamma = 1.0f / ((float)(_q->p) * _q->div);
     for (i=0; i<_q->nfft; i++) {
 #if 0
         // find maximum within 'p' samples
@@ -203,20 +287,21 @@ void ASGRAM(_execute)(ASGRAM() _q,
             unsigned int index = (_q->p*i) + j;
             psd_val = (j==0 || _q->psd[index] > psd_val) ? _q->psd[index] : psd_val;
         }
+        psd_val *= (float)(_q->p);
 #else
-        // find average over 'p' samples
+        // find sum over 'p' samples (averaging deferred to quantization)
         float psd_val = 0.0f;
         for (j=0; j<_q->p; j++)
             psd_val += _q->psd[(_q->p*i) + j];
-        psd_val /= (float)(_q->p);
 #endif
 
-        // determine ascii level (which character to use)
-        _ascii[i] = _q->levelchar[0];
-        for (j=0; j<_q->num_levels; j++) {
-            if ( psd_val > _q->levels[j] )
-                _ascii[i] = _q->levelchar[j];
-        }
+        // determine ascii level directly: thresholds are uniformly
+        // spaced at ref + j*div, so the level index follows in closed
+        // form without scanning the threshold array
+        int level = (int) ceilf( (psd_val*gamma) - _q->ref/_q->div ) - 1;
+        if (level < 0)                          level = 0;
+        if (level >= (int)_q->num_levels)       level = _q->num_levels - 1;
+        _ascii[i] = _q->levelchar[level];
     }
 
     // append null character to end of string
@@ -26,8 +26,24 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
 #include "liquid.internal.h"
 
+// process-wide cache of radix-2 index/twiddle tables, shared between
+// all plans of the same size and direction and reference-counted so
+// repeated plan creation (e.g. many detector or filter objects of the
+// same length) pays the table set-up cost only once. Tables do not
+// depend on the plan flags, so those are not part of the key.
+struct FFT(_radix2_tables_s) {
+    unsigned int   nfft;        // transform size
+    int            direction;   // forward/reverse
+    unsigned int * index_rev;   // reversed indices
+    TC *           twiddle;     // packed per-stage twiddle factors
+    unsigned int   refcount;    // number of plans holding a reference
+    struct FFT(_radix2_tables_s) * next;
+};
+
 struct FFT(plan_s)
 {
     // common data
@@ -57,8 +73,8 @@ struct FFT(plan_s)
         // radix-2 transform data
         struct {
             unsigned int m;             // log2(nfft)
-            unsigned int * index_rev;   // reversed indices
-            TC * twiddle;               // twiddle factors
+            // shared, reference-counted index/twiddle tables
+            struct FFT(_radix2_tables_s) * tables;
         } radix2;
 
         // recursive mixed-radix transform data:
@@ -75,8 +91,24 @@ struct FFT(plan_s)
             TC * twiddle;       // twiddle factors
             FFT(plan) fft_P;    // sub-transform of size P
             FFT(plan) fft_Q;    // sub-transform of size Q
+
+            // opt-in threaded execution (LIQUID_FFT_FLAG_THREADED)
+            unsigned int num_threads;   // worker threads (0 = serial)
+            TC ** t0_th;                // per-worker small FFT input buffers
+            TC ** t1_th;                // per-worker small FFT output buffers
+            FFT(plan) * fft_P_th;       // per-worker sub-transforms of size P
+            FFT(plan) * fft_Q_th;       // per-worker sub-transforms of size Q
         } mixedradix;
 
+        // real-input transforms (r2c/c2r) computed with a half-size
+        // complex transform exploiting conjugate symmetry
+        struct {
+            TC * z;             // half-size time-domain buffer
+            TC * Z;             // half-size freq-domain buffer
+            TC * twiddle;       // recombination twiddle factors
+            FFT(plan) fft;      // half-size complex sub-transform
+        } real;
+
         // Rader's algorithm for computing FFTs of prime length
         struct {
             unsigned int * seq; // transformation sequence, size: nfft-1
@@ -87,6 +119,21 @@ struct FFT(plan_s)
             FFT(plan) ifft;     // sub-IFFT of size nfft-1
         } rader;
 
+        // input-pruned transform for sparse spectra: transform
+        // decomposition over nfft = M1*M2 with the nonzero inputs
+        // scattered (mod M2) into M1 sub-transforms of size M2
+        struct {
+            unsigned int num_nonzero;   // number of nonzero inputs
+            unsigned int * index;       // nonzero input indices, size: num_nonzero
+            unsigned int * residue;     // input indices mod M2, size: num_nonzero
+            unsigned int M1;            // output phase count
+            unsigned int M2;            // sub-transform size
+            TC * twiddle;               // scatter twiddle factors, size: num_nonzero x M1
+            TC * t0;                    // sub-transform input buffer
+            TC * t1;                    // sub-transform output buffer
+            FFT(plan) fft;              // sub-transform of size M2 (NULL if M2==1)
+        } pruned;
+
         // Rader's alternate algorithm for computing FFTs of prime length
         struct {
             unsigned int nfft_prime;
@@ -100,6 +147,90 @@ struct FFT(plan_s)
     } data;
 };
 
+// head of the process-wide radix-2 table cache; plans may be created
+// and destroyed from multiple threads, so the list and the per-entry
+// reference counts are guarded by a mutex
+static struct FFT(_radix2_tables_s) * FFT(_radix2_cache) = NULL;
+static pthread_mutex_t FFT(_radix2_cache_mutex) = PTHREAD_MUTEX_INITIALIZER;
+
+// acquire shared radix-2 tables for a given size and direction,
+// creating them on first request
+//  _nfft   :   transform size (power of two)
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+struct FFT(_radix2_tables_s) * FFT(_radix2_tables_acquire)(unsigned int _nfft,
+                                                           int          _dir)
+{
+    pthread_mutex_lock(&FFT(_radix2_cache_mutex));
+
+    // search cache for matching table set
+    struct FFT(_radix2_tables_s) * t = FFT(_radix2_cache);
+    while (t != NULL) {
+        if (t->nfft == _nfft && t->direction == _dir) {
+            t->refcount++;
+            pthread_mutex_unlock(&FFT(_radix2_cache_mutex));
+            return t;
+        }
+        t = t->next;
+    }
+
+    // not found; create new table set and insert at head of cache
+    t = (struct FFT(_radix2_tables_s) *) malloc(sizeof(struct FFT(_radix2_tables_s)));
+    t->nfft      = _nfft;
+    t->direction = _dir;
+    t->refcount  = 1;
+    t->next      = FFT(_radix2_cache);
+    FFT(_radix2_cache) = t;
+
+    // initialize reversed indices
+    unsigned int m = liquid_msb_index(_nfft) - 1;   // m = log2(nfft)
+    t->index_rev = (unsigned int *) malloc(_nfft*sizeof(unsigned int));
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        t->index_rev[i] = fft_reverse_index(i,m);
+
+    // initialize packed per-stage twiddle factors for the stages
+    // following the combined radix-4 input pass: for the stage with
+    // half-size n1 the n1 values exp(+/-j pi k / n1), k=0..n1-1, are
+    // stored contiguously
+    unsigned int ntw = _nfft > 4 ? _nfft - 4 : 1;
+    t->twiddle = (TC *) malloc(ntw * sizeof(TC));
+
+    T d = (_dir == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    unsigned int n1;
+    unsigned int k = 0;
+    for (n1=4; n1<_nfft; n1<<=1) {
+        for (i=0; i<n1; i++)
+            t->twiddle[k++] = cexpf(_Complex_I*d*M_PI*(T)i / (T)n1);
+    }
+
+    pthread_mutex_unlock(&FFT(_radix2_cache_mutex));
+    return t;
+}
+
+// release reference to shared radix-2 tables, freeing them when the
+// last reference is dropped
+void FFT(_radix2_tables_release)(struct FFT(_radix2_tables_s) * _t)
+{
+    pthread_mutex_lock(&FFT(_radix2_cache_mutex));
+    _t->refcount--;
+    if (_t->refcount > 0) {
+        pthread_mutex_unlock(&FFT(_radix2_cache_mutex));
+        return;
+    }
+
+    // unlink from cache
+    struct FFT(_radix2_tables_s) ** p = &FFT(_radix2_cache);
+    while (*p != _t)
+        p = &(*p)->next;
+    *p = _t->next;
+    pthread_mutex_unlock(&FFT(_radix2_cache_mutex));
+
+    // free table memory
+    free(_t->index_rev);
+    free(_t->twiddle);
+    free(_t);
+}
+
 // create FFT plan, regular complex one-dimensional transform
 //  _nfft   :   FFT size
 //  _x      :   input array [size: _nfft x 1]
@@ -160,12 +291,18 @@ void FFT(_destroy_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: FFT(_destroy_plan_mixed_radix)(_q); return;
         case LIQUID_FFT_METHOD_RADER:       FFT(_destroy_plan_rader)(_q);       return;
         case LIQUID_FFT_METHOD_RADER2:      FFT(_destroy_plan_rader2)(_q);      return;
+        case LIQUID_FFT_METHOD_PRUNED:      FFT(_destroy_plan_pruned)(_q);      return;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
             exit(1);
         }
         break;
+    // real-input transforms
+    case LIQUID_FFT_REAL_FORWARD:
+    case LIQUID_FFT_REAL_BACKWARD:
+        FFT(_destroy_plan_real)(_q);
+        break;
     // discrete cosine transforms
     case LIQUID_FFT_REDFT00:
     case LIQUID_FFT_REDFT10:
@@ -206,6 +343,7 @@ void FFT(_print_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: printf("Cooley-Tukey\n");       break;
         case LIQUID_FFT_METHOD_RADER:       printf("Rader (Type I)\n");     break;
         case LIQUID_FFT_METHOD_RADER2:      printf("Rader (Type II)\n");    break;
+        case LIQUID_FFT_METHOD_PRUNED:      printf("Pruned\n");             break;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -214,6 +352,11 @@ void FFT(_print_plan)(FFT(plan) _q)
         // print recursive plan
         FFT(_print_plan_recursive)(_q, 0);
         break;
+    // real-input transforms
+    case LIQUID_FFT_REAL_FORWARD:
+    case LIQUID_FFT_REAL_BACKWARD:
+        FFT(_print_plan_real)(_q);
+        break;
     // discrete cosine transforms
     case LIQUID_FFT_REDFT00:
     case LIQUID_FFT_REDFT10:
@@ -276,6 +419,15 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
         FFT(_print_plan_recursive)(_q->data.rader2.fft, _level+1);
         break;
 
+    case LIQUID_FFT_METHOD_PRUNED:
+        printf("pruned, num-nonzero=%u, M1=%u, M2=%u\n",
+                _q->data.pruned.num_nonzero,
+                _q->data.pruned.M1,
+                _q->data.pruned.M2);
+        if (_q->data.pruned.fft != NULL)
+            FFT(_print_plan_recursive)(_q->data.pruned.fft, _level+1);
+        break;
+
     case LIQUID_FFT_METHOD_UNKNOWN:     printf("(unknown)\n");      break;
     default:                            printf("(unknown)\n");      break;
     }
@@ -284,8 +436,60 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
 // execute fft
 void FFT(_execute)(FFT(plan) _q)
 {
+    LIQUID_PROFILE_BEGIN(FFT_EXECUTE);
+
     // invoke internal function pointer
     _q->execute(_q);
+
+    LIQUID_PROFILE_END(FFT_EXECUTE);
+}
+
+// execute fft on a batch of contiguous transforms (complex
+// one-dimensional plans only)
+//  _q          :   fft plan
+//  _batch      :   number of transforms
+//  _x          :   input array [size: _batch x _x_stride]
+//  _x_stride   :   input stride between transforms, _x_stride >= nfft
+//  _y          :   output array [size: _batch x _y_stride]
+//  _y_stride   :   output stride between transforms, _y_stride >= nfft
+void FFT(_execute_batch)(FFT(plan)    _q,
+                         unsigned int _batch,
+                         TC *         _x,
+                         unsigned int _x_stride,
+                         TC *         _y,
+                         unsigned int _y_stride)
+{
+    // route large batches of complex one-dimensional transforms
+    // through the registered external backend (if any); the backend
+    // may decline by returning non-zero
+    if (liquid_internal_backend.fft_execute_batch != NULL &&
+        (_q->type == LIQUID_FFT_FORWARD || _q->type == LIQUID_FFT_BACKWARD) &&
+        _q->nfft * _batch >= liquid_internal_backend.fft_threshold)
+    {
+        if (liquid_internal_backend.fft_execute_batch(
+                liquid_internal_backend.context,
+                _q->direction, _q->nfft, _batch,
+                (liquid_float_complex*)_x, _x_stride,
+                (liquid_float_complex*)_y, _y_stride) == 0)
+            return;
+    }
+
+    // save plan buffer pointers
+    TC * x0 = _q->x;
+    TC * y0 = _q->y;
+
+    // run each transform in turn; the plan's twiddle and index tables
+    // stay resident in cache across iterations
+    unsigned int i;
+    for (i=0; i<_batch; i++) {
+        _q->x = _x + i*_x_stride;
+        _q->y = _y + i*_y_stride;
+        _q->execute(_q);
+    }
+
+    // restore plan buffer pointers
+    _q->x = x0;
+    _q->y = y0;
 }
 
 // perform n-point FFT allocating plan internally
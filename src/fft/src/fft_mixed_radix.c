@@ -33,6 +33,17 @@
 
 #define FFT_DEBUG_MIXED_RADIX 0
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+
+// minimum transform size before the threaded flag engages; below this
+// the thread management overhead outweighs any gain
+#define FFT_MIXED_RADIX_THREADED_MIN (1<<13)
+
+// forward declaration of threaded execution method
+void FFT(_execute_mixed_radix_threaded)(FFT(plan) _q);
+#endif
+
 // create FFT plan for regular DFT
 //  _nfft   :   FFT size
 //  _x      :   input array [size: _nfft x 1]
@@ -104,6 +115,46 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
     for (i=0; i<q->nfft; i++)
         q->data.mixedradix.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
 
+    // opt-in threaded execution: clone sub-transforms and scratch buffers
+    // for each worker so both phases can be split across threads
+    q->data.mixedradix.num_threads = 0;
+    q->data.mixedradix.t0_th       = NULL;
+    q->data.mixedradix.t1_th       = NULL;
+    q->data.mixedradix.fft_P_th    = NULL;
+    q->data.mixedradix.fft_Q_th    = NULL;
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+    if ((q->flags & LIQUID_FFT_FLAG_THREADED) && q->nfft >= FFT_MIXED_RADIX_THREADED_MIN) {
+        // determine number of workers (clamped by loop counts)
+        unsigned int num_threads = (q->flags >> 12) & 0xf;
+        if (num_threads == 0) num_threads = 4;
+        if (num_threads > P)  num_threads = P;
+        if (num_threads > Q)  num_threads = Q;
+
+        if (num_threads > 1) {
+            q->data.mixedradix.num_threads = num_threads;
+            q->data.mixedradix.t0_th    = (TC **)      malloc(num_threads*sizeof(TC *));
+            q->data.mixedradix.t1_th    = (TC **)      malloc(num_threads*sizeof(TC *));
+            q->data.mixedradix.fft_P_th = (FFT(plan)*) malloc(num_threads*sizeof(FFT(plan)));
+            q->data.mixedradix.fft_Q_th = (FFT(plan)*) malloc(num_threads*sizeof(FFT(plan)));
+            for (i=0; i<num_threads; i++) {
+                q->data.mixedradix.t0_th[i] = (TC *) malloc(t_len * sizeof(TC));
+                q->data.mixedradix.t1_th[i] = (TC *) malloc(t_len * sizeof(TC));
+
+                // sub-plans are created without the threaded flag
+                q->data.mixedradix.fft_P_th[i] = FFT(_create_plan)(P,
+                                                                   q->data.mixedradix.t0_th[i],
+                                                                   q->data.mixedradix.t1_th[i],
+                                                                   q->direction, 0);
+                q->data.mixedradix.fft_Q_th[i] = FFT(_create_plan)(Q,
+                                                                   q->data.mixedradix.t0_th[i],
+                                                                   q->data.mixedradix.t1_th[i],
+                                                                   q->direction, 0);
+            }
+            q->execute = FFT(_execute_mixed_radix_threaded);
+        }
+    }
+#endif
+
     return q;
 }
 
@@ -114,6 +165,19 @@ void FFT(_destroy_plan_mixed_radix)(FFT(plan) _q)
     FFT(_destroy_plan)(_q->data.mixedradix.fft_P);
     FFT(_destroy_plan)(_q->data.mixedradix.fft_Q);
 
+    // free per-worker sub-plans, buffers (threaded execution only)
+    unsigned int i;
+    for (i=0; i<_q->data.mixedradix.num_threads; i++) {
+        FFT(_destroy_plan)(_q->data.mixedradix.fft_P_th[i]);
+        FFT(_destroy_plan)(_q->data.mixedradix.fft_Q_th[i]);
+        free(_q->data.mixedradix.t0_th[i]);
+        free(_q->data.mixedradix.t1_th[i]);
+    }
+    free(_q->data.mixedradix.t0_th);
+    free(_q->data.mixedradix.t1_th);
+    free(_q->data.mixedradix.fft_P_th);
+    free(_q->data.mixedradix.fft_Q_th);
+
     // free data specific to mixed-radix transforms
     free(_q->data.mixedradix.t0);
     free(_q->data.mixedradix.t1);
@@ -190,6 +254,102 @@ void FFT(_execute_mixed_radix)(FFT(plan) _q)
     }
 }
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+// worker context for threaded mixed-radix execution
+struct FFT(_mixed_radix_worker_s) {
+    FFT(plan)    q;         // parent mixed-radix plan
+    unsigned int worker;    // worker index
+    int          phase;     // 0: P-point DFTs, 1: Q-point DFTs
+};
+
+// threaded mixed-radix worker; each worker owns a static, contiguous
+// range of the outer loop so the output is deterministic regardless of
+// scheduling order
+static void * FFT(_execute_mixed_radix_worker)(void * _arg)
+{
+    struct FFT(_mixed_radix_worker_s) * ctx = (struct FFT(_mixed_radix_worker_s) *) _arg;
+    FFT(plan) _q = ctx->q;
+
+    // set internal constants, pointers
+    unsigned int P           = _q->data.mixedradix.P;
+    unsigned int Q           = _q->data.mixedradix.Q;
+    unsigned int num_threads = _q->data.mixedradix.num_threads;
+    TC * x       = _q->data.mixedradix.x;
+    TC * twiddle = _q->data.mixedradix.twiddle;
+
+    // worker-local scratch buffers and sub-plan
+    unsigned int w = ctx->worker;
+    TC * t0 = _q->data.mixedradix.t0_th[w];
+    TC * t1 = _q->data.mixedradix.t1_th[w];
+
+    unsigned int i;
+    unsigned int k;
+
+    if (ctx->phase == 0) {
+        // compute this worker's share of the 'Q' DFTs of size 'P'
+        unsigned int i0 = (Q *  w   ) / num_threads;
+        unsigned int i1 = (Q * (w+1)) / num_threads;
+        for (i=i0; i<i1; i++) {
+            // copy to temporary buffer
+            for (k=0; k<P; k++)
+                t0[k] = x[Q*k+i];
+
+            // run internal P-point DFT
+            FFT(_execute)(_q->data.mixedradix.fft_P_th[w]);
+
+            // copy back to input, applying twiddle factors
+            for (k=0; k<P; k++)
+                x[Q*k+i] = t1[k] * twiddle[i*k];
+        }
+    } else {
+        // compute this worker's share of the 'P' DFTs of size 'Q'
+        unsigned int i0 = (P *  w   ) / num_threads;
+        unsigned int i1 = (P * (w+1)) / num_threads;
+        for (i=i0; i<i1; i++) {
+            // copy to temporary buffer
+            for (k=0; k<Q; k++)
+                t0[k] = x[Q*i+k];
+
+            // run internal Q-point DFT
+            FFT(_execute)(_q->data.mixedradix.fft_Q_th[w]);
+
+            // copy and transpose
+            for (k=0; k<Q; k++)
+                _q->y[k*P+i] = t1[k];
+        }
+    }
+    return NULL;
+}
+
+// execute mixed-radix FFT, splitting each phase across worker threads;
+// the phases are joined in between as the second depends upon the first
+void FFT(_execute_mixed_radix_threaded)(FFT(plan) _q)
+{
+    unsigned int num_threads = _q->data.mixedradix.num_threads;
+    pthread_t threads[16];
+    struct FFT(_mixed_radix_worker_s) ctx[16];
+
+    // copy input to internal buffer
+    memmove(_q->data.mixedradix.x, _q->x, _q->nfft*sizeof(TC));
+
+    int phase;
+    unsigned int w;
+    for (phase=0; phase<2; phase++) {
+        // spawn workers 1..num_threads-1, running worker 0 inline
+        for (w=0; w<num_threads; w++) {
+            ctx[w].q      = _q;
+            ctx[w].worker = w;
+            ctx[w].phase  = phase;
+        }
+        for (w=1; w<num_threads; w++)
+            pthread_create(&threads[w], NULL, FFT(_execute_mixed_radix_worker), &ctx[w]);
+        FFT(_execute_mixed_radix_worker)(&ctx[0]);
+        for (w=1; w<num_threads; w++)
+            pthread_join(threads[w], NULL);
+    }
+}
+#endif
+
 // strategize as to best radix to use
 unsigned int FFT(_estimate_mixed_radix)(unsigned int _nfft)
 {
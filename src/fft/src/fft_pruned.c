@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_pruned.c : input-pruned transforms for sparse spectra
+//
+// Computes an n-point transform from a fixed set of K nonzero input
+// indices using transform decomposition: with n = M1*M2 the outputs
+// y[n1 + M1*n2] for a fixed n1 are the M2-point transform of the K
+// nonzero inputs scattered (mod M2) after twiddling by W_n^(k*n1), so
+// the plan runs M1 scatter passes of K terms each plus M1 sub-
+// transforms of size M2 ~ K. Cost scales with the number of occupied
+// inputs instead of n log n, which pays off for sparse allocations
+// such as narrowband-in-wideband OFDM symbol generation. Inputs
+// outside the declared index set are ignored.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create FFT plan for transform with a fixed sparse input set
+//  _nfft           :   FFT size
+//  _x              :   input array [size: _nfft x 1]
+//  _y              :   output array [size: _nfft x 1]
+//  _dir            :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _index          :   nonzero input indices [size: _num_nonzero x 1]
+//  _num_nonzero    :   number of nonzero inputs, 0 < _num_nonzero <= _nfft
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_pruned)(unsigned int   _nfft,
+                                   TC *           _x,
+                                   TC *           _y,
+                                   int            _dir,
+                                   unsigned int * _index,
+                                   unsigned int   _num_nonzero,
+                                   int            _flags)
+{
+    // validate input
+    if (_num_nonzero == 0 || _num_nonzero > _nfft) {
+        fprintf(stderr,"error: fft_create_plan_pruned(), number of nonzero inputs must be in [1,nfft]\n");
+        exit(1);
+    }
+    unsigned int i;
+    for (i=0; i<_num_nonzero; i++) {
+        if (_index[i] >= _nfft) {
+            fprintf(stderr,"error: fft_create_plan_pruned(), input index exceeds transform size\n");
+            exit(1);
+        }
+    }
+
+    // allocate plan and initialize
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = _x;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_PRUNED;
+    q->execute   = FFT(_execute_pruned);
+
+    // choose sub-transform size M2: smallest divisor-of-nfft power of
+    // two holding all scattered inputs (M2 >= num_nonzero where the
+    // factorization allows); an odd nfft degenerates to M2=1, a direct
+    // summation over the nonzero inputs
+    unsigned int M2 = 1;
+    while (M2 < _num_nonzero && (q->nfft % (2*M2)) == 0)
+        M2 <<= 1;
+    unsigned int M1 = q->nfft / M2;
+    q->data.pruned.M1 = M1;
+    q->data.pruned.M2 = M2;
+
+    // copy input index set and pre-compute residues (mod M2)
+    q->data.pruned.num_nonzero = _num_nonzero;
+    q->data.pruned.index   = (unsigned int *) malloc(_num_nonzero*sizeof(unsigned int));
+    q->data.pruned.residue = (unsigned int *) malloc(_num_nonzero*sizeof(unsigned int));
+    for (i=0; i<_num_nonzero; i++) {
+        q->data.pruned.index[i]   = _index[i];
+        q->data.pruned.residue[i] = _index[i] % M2;
+    }
+
+    // pre-compute scatter twiddle factors W_n^(k*n1) for each nonzero
+    // input k and each output phase n1
+    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0f : 1.0f;
+    q->data.pruned.twiddle = (TC *) malloc(_num_nonzero*M1*sizeof(TC));
+    unsigned int n1;
+    for (i=0; i<_num_nonzero; i++) {
+        for (n1=0; n1<M1; n1++) {
+            double phi = 2.0*M_PI*(double)_index[i]*(double)n1/(double)(q->nfft);
+            q->data.pruned.twiddle[i*M1+n1] = cexpf(_Complex_I*d*(T)fmod(phi, 2.0*M_PI));
+        }
+    }
+
+    // create M2-point sub-transform and scatter buffers
+    if (M2 > 1) {
+        q->data.pruned.t0  = (TC *) malloc(M2*sizeof(TC));
+        q->data.pruned.t1  = (TC *) malloc(M2*sizeof(TC));
+        q->data.pruned.fft = FFT(_create_plan)(M2, q->data.pruned.t0, q->data.pruned.t1,
+                                               q->direction, q->flags);
+    } else {
+        q->data.pruned.t0  = NULL;
+        q->data.pruned.t1  = NULL;
+        q->data.pruned.fft = NULL;
+    }
+
+    return q;
+}
+
+// destroy FFT plan
+void FFT(_destroy_plan_pruned)(FFT(plan) _q)
+{
+    // free internal tables and buffers
+    free(_q->data.pruned.index);
+    free(_q->data.pruned.residue);
+    free(_q->data.pruned.twiddle);
+    free(_q->data.pruned.t0);
+    free(_q->data.pruned.t1);
+    if (_q->data.pruned.fft != NULL)
+        FFT(_destroy_plan)(_q->data.pruned.fft);
+
+    // free main object memory
+    free(_q);
+}
+
+// execute pruned transform
+void FFT(_execute_pruned)(FFT(plan) _q)
+{
+    unsigned int K  = _q->data.pruned.num_nonzero;
+    unsigned int M1 = _q->data.pruned.M1;
+    unsigned int M2 = _q->data.pruned.M2;
+    unsigned int i;
+    unsigned int n1;
+    unsigned int n2;
+
+    for (n1=0; n1<M1; n1++) {
+        if (M2 > 1) {
+            // scatter twiddled nonzero inputs (mod M2)
+            memset(_q->data.pruned.t0, 0x00, M2*sizeof(TC));
+            for (i=0; i<K; i++) {
+                _q->data.pruned.t0[_q->data.pruned.residue[i]] +=
+                    _q->x[_q->data.pruned.index[i]] * _q->data.pruned.twiddle[i*M1+n1];
+            }
+
+            // sub-transform gives every M1-strided output at phase n1
+            FFT(_execute)(_q->data.pruned.fft);
+            for (n2=0; n2<M2; n2++)
+                _q->y[n1 + M1*n2] = _q->data.pruned.t1[n2];
+        } else {
+            // degenerate factorization: direct summation
+            TC sum = 0;
+            for (i=0; i<K; i++)
+                sum += _q->x[_q->data.pruned.index[i]] * _q->data.pruned.twiddle[i*M1+n1];
+            _q->y[n1] = sum;
+        }
+    }
+}
@@ -23,12 +23,25 @@
 //
 // fft_radix2.c : definitions for transforms of the form 2^m
 //
+// The first two stages are combined into a single twiddle-free radix-4
+// pass; the remaining stages run contiguous butterflies against packed
+// per-stage twiddle tables so both the scalar path and the optional
+// vectorized kernel stream through memory without strided twiddle
+// look-ups.
+//
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include "liquid.internal.h"
 
+#ifdef LIQUID_X86_TARGET_ATTR
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+// forward declaration of vectorized butterfly kernel
+void FFT(_execute_radix2_avx2)(FFT(plan) _q);
+#endif
+
 // create FFT plan for regular DFT
 //  _nfft   :   FFT size
 //  _x      :   input array [size: _nfft x 1]
@@ -53,21 +66,17 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
     q->method    = LIQUID_FFT_METHOD_RADIX2;
 
     q->execute   = FFT(_execute_radix2);
+#ifdef LIQUID_X86_TARGET_ATTR
+    // select vectorized butterfly kernel when available on this machine
+    int features = liquid_cpu_features();
+    if ((features & LIQUID_CPU_X86_AVX2) && (features & LIQUID_CPU_X86_FMA))
+        q->execute = FFT(_execute_radix2_avx2);
+#endif
 
-    // initialize twiddle factors, indices for radix-2 transforms
-    q->data.radix2.m = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
-    
-    q->data.radix2.index_rev = (unsigned int *) malloc((q->nfft)*sizeof(unsigned int));
-    unsigned int i;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.index_rev[i] = fft_reverse_index(i,q->data.radix2.m);
-
-    // initialize twiddle factors
-    q->data.radix2.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // acquire shared twiddle factors, indices for radix-2 transforms
+    // from the process-wide cache
+    q->data.radix2.m      = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
+    q->data.radix2.tables = FFT(_radix2_tables_acquire)(q->nfft, q->direction);
 
     return q;
 }
@@ -75,9 +84,8 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
 // destroy FFT plan
 void FFT(_destroy_plan_radix2)(FFT(plan) _q)
 {
-    // free data specific to radix-2 transforms
-    free(_q->data.radix2.index_rev);
-    free(_q->data.radix2.twiddle);
+    // release reference to shared radix-2 tables
+    FFT(_radix2_tables_release)(_q->data.radix2.tables);
 
     // free main object memory
     free(_q);
@@ -87,51 +95,133 @@ void FFT(_destroy_plan_radix2)(FFT(plan) _q)
 void FFT(_execute_radix2)(FFT(plan) _q)
 {
     // swap values
-    unsigned int i,j,k;
+    unsigned int i,j;
 
     // unroll loop
     unsigned int nfft4 = (_q->nfft>>2)<<2;  // floor(_nfft/4)
     for (i=0; i<nfft4; i+=4) {
-        _q->y[i  ] = _q->x[ _q->data.radix2.index_rev[i  ] ];
-        _q->y[i+1] = _q->x[ _q->data.radix2.index_rev[i+1] ];
-        _q->y[i+2] = _q->x[ _q->data.radix2.index_rev[i+2] ];
-        _q->y[i+3] = _q->x[ _q->data.radix2.index_rev[i+3] ];
+        _q->y[i  ] = _q->x[ _q->data.radix2.tables->index_rev[i  ] ];
+        _q->y[i+1] = _q->x[ _q->data.radix2.tables->index_rev[i+1] ];
+        _q->y[i+2] = _q->x[ _q->data.radix2.tables->index_rev[i+2] ];
+        _q->y[i+3] = _q->x[ _q->data.radix2.tables->index_rev[i+3] ];
     }
 
-#if 0
-    // clean up remaining
-    // NOTE : this only happens when _nfft=2 because we know (_nfft%4)==0 otherwise
-    for ( ; i<_q->nfft; i++)
-        _q->y[i] = _q->x[ _q->data.radix2.index_rev[i] ];
-#endif
-
-    TC yp;
-    TC *y=_q->y;
-    unsigned int n1 = 0;
-    unsigned int n2 = 1;
+    TC * y = _q->y;
+    unsigned int nfft = _q->nfft;
 
-    TC t;   // twiddle value
-    unsigned int stride = _q->nfft;
-    unsigned int twiddle_index;
-
-    for (i=0; i<_q->data.radix2.m; i++) {
-        n1 = n2;
-        n2 *= 2;
-        stride >>= 1;
+    // trivial case: single butterfly
+    if (nfft == 2) {
+        TC yp = _q->x[0];
+        y[0]  = yp + _q->x[1];
+        y[1]  = yp - _q->x[1];
+        return;
+    }
 
-        twiddle_index = 0;
-    
-        for (j=0; j<n1; j++) {
-            t = _q->data.radix2.twiddle[twiddle_index];
-            twiddle_index = (twiddle_index + stride) % _q->nfft;
+    // first two stages combined into a single twiddle-free radix-4 pass
+    int inv = _q->direction == LIQUID_FFT_BACKWARD;
+    for (i=0; i<nfft; i+=4) {
+        TC a = y[i+0] + y[i+1];
+        TC b = y[i+0] - y[i+1];
+        TC c = y[i+2] + y[i+3];
+        TC d = y[i+2] - y[i+3];
+        d = inv ? _Complex_I*d : -_Complex_I*d;
+        y[i+0] = a + c;
+        y[i+2] = a - c;
+        y[i+1] = b + d;
+        y[i+3] = b - d;
+    }
 
-            for (k=j; k<_q->nfft; k+=n2) {
+    // remaining stages: contiguous butterflies against the packed
+    // per-stage twiddle tables
+    unsigned int n1 = 4;
+    TC * tw = _q->data.radix2.tables->twiddle;
+    while (n1 < nfft) {
+        unsigned int n2 = n1 << 1;
+        unsigned int k0;
+        for (k0=0; k0<nfft; k0+=n2) {
+            for (j=0; j<n1; j++) {
                 // NOTE: most computation is with the multiplication in next line
-                yp      =  y[k+n1]*t;
-                y[k+n1] =  y[k] - yp;
-                y[k]    += yp;
+                TC yp       = y[k0+j+n1]*tw[j];
+                y[k0+j+n1]  = y[k0+j] - yp;
+                y[k0+j]    += yp;
             }
         }
+        tw += n1;
+        n1  = n2;
     }
 }
 
+#ifdef LIQUID_X86_TARGET_ATTR
+// AVX2/FMA butterfly kernel: identical stage structure to the scalar
+// path with four contiguous butterflies per iteration
+__attribute__((target("avx2,fma")))
+void FFT(_execute_radix2_avx2)(FFT(plan) _q)
+{
+    // swap values
+    unsigned int i,j;
+
+    // unroll loop
+    unsigned int nfft4 = (_q->nfft>>2)<<2;  // floor(_nfft/4)
+    for (i=0; i<nfft4; i+=4) {
+        _q->y[i  ] = _q->x[ _q->data.radix2.tables->index_rev[i  ] ];
+        _q->y[i+1] = _q->x[ _q->data.radix2.tables->index_rev[i+1] ];
+        _q->y[i+2] = _q->x[ _q->data.radix2.tables->index_rev[i+2] ];
+        _q->y[i+3] = _q->x[ _q->data.radix2.tables->index_rev[i+3] ];
+    }
+
+    TC * y = _q->y;
+    unsigned int nfft = _q->nfft;
+
+    // trivial case: single butterfly
+    if (nfft == 2) {
+        TC yp = _q->x[0];
+        y[0]  = yp + _q->x[1];
+        y[1]  = yp - _q->x[1];
+        return;
+    }
+
+    // first two stages combined into a single twiddle-free radix-4 pass
+    int inv = _q->direction == LIQUID_FFT_BACKWARD;
+    for (i=0; i<nfft; i+=4) {
+        TC a = y[i+0] + y[i+1];
+        TC b = y[i+0] - y[i+1];
+        TC c = y[i+2] + y[i+3];
+        TC d = y[i+2] - y[i+3];
+        d = inv ? _Complex_I*d : -_Complex_I*d;
+        y[i+0] = a + c;
+        y[i+2] = a - c;
+        y[i+1] = b + d;
+        y[i+3] = b - d;
+    }
+
+    // remaining stages: four butterflies per iteration; all indices
+    // below are in floats (interleaved real/imaginary components)
+    float * yf  = (float*) y;
+    float * twf = (float*) _q->data.radix2.tables->twiddle;
+    unsigned int n1 = 8;            // 2*n1 in complex samples
+    unsigned int n  = 2*nfft;
+    while (n1 < n) {
+        unsigned int n2 = n1 << 1;
+        unsigned int k0;
+        for (k0=0; k0<n; k0+=n2) {
+            for (j=0; j<n1; j+=8) {
+                __m256 a    = _mm256_loadu_ps(&yf[k0+j]);
+                __m256 b    = _mm256_loadu_ps(&yf[k0+j+n1]);
+                __m256 t    = _mm256_loadu_ps(&twf[j]);
+
+                // complex multiply: yp = b*t
+                __m256 t_re = _mm256_moveldup_ps(t);
+                __m256 t_im = _mm256_movehdup_ps(t);
+                __m256 b_sw = _mm256_permute_ps(b, _MM_SHUFFLE(2,3,0,1));
+                __m256 yp   = _mm256_fmaddsub_ps(b, t_re, _mm256_mul_ps(b_sw, t_im));
+
+                // butterfly
+                _mm256_storeu_ps(&yf[k0+j],    _mm256_add_ps(a, yp));
+                _mm256_storeu_ps(&yf[k0+j+n1], _mm256_sub_ps(a, yp));
+            }
+        }
+        twf += n1;
+        n1   = n2;
+    }
+}
+#endif
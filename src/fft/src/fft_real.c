@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_real.c : real-to-complex (r2c) and complex-to-real (c2r)
+//              one-dimensional transforms
+//
+// A real signal has a conjugate-symmetric spectrum, so an even-length
+// transform of size n can be computed with a single complex transform
+// of size n/2 followed by a recombination pass, roughly doubling
+// throughput and halving twiddle/buffer memory relative to a regular
+// complex transform. Odd lengths fall back to a full complex
+// transform internally.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create FFT plan for real-to-complex transform
+//  _nfft   :   FFT size
+//  _x      :   input array (real) [size: _nfft x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_r2c)(unsigned int _nfft,
+                                T *          _x,
+                                TC *         _y,
+                                int          _flags)
+{
+    // allocate plan and initialize
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->xr        = _x;
+    q->x         = NULL;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = LIQUID_FFT_REAL_FORWARD;
+    q->direction = LIQUID_FFT_FORWARD;
+    q->method    = LIQUID_FFT_METHOD_UNKNOWN;
+
+    if ((q->nfft % 2) == 0) {
+        // even length: pack real input into a half-size complex buffer
+        unsigned int m = q->nfft / 2;
+        q->execute = FFT(_execute_r2c);
+
+        // allocate internal buffers
+        q->data.real.z = (TC *) malloc(m*sizeof(TC));
+        q->data.real.Z = (TC *) malloc(m*sizeof(TC));
+
+        // initialize recombination twiddle factors: exp(-j 2 pi k / nfft)
+        q->data.real.twiddle = (TC *) malloc(m*sizeof(TC));
+        unsigned int i;
+        for (i=0; i<m; i++)
+            q->data.real.twiddle[i] = cexpf(-_Complex_I*2*M_PI*(T)i / (T)(q->nfft));
+
+        // create half-size complex sub-transform
+        q->data.real.fft = FFT(_create_plan)(m, q->data.real.z, q->data.real.Z,
+                                             LIQUID_FFT_FORWARD, q->flags);
+    } else {
+        // odd length: fall back to a full complex transform on a copy
+        // of the input
+        q->execute = FFT(_execute_r2c_odd);
+
+        q->data.real.z       = (TC *) malloc(q->nfft*sizeof(TC));
+        q->data.real.Z       = NULL;
+        q->data.real.twiddle = NULL;
+
+        q->data.real.fft = FFT(_create_plan)(q->nfft, q->data.real.z, q->y,
+                                             LIQUID_FFT_FORWARD, q->flags);
+    }
+
+    return q;
+}
+
+// create FFT plan for complex-to-real inverse transform
+//  _nfft   :   FFT size
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array (real) [size: _nfft x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_c2r)(unsigned int _nfft,
+                                TC *         _x,
+                                T *          _y,
+                                int          _flags)
+{
+    // allocate plan and initialize
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = _x;
+    q->y         = NULL;
+    q->yr        = _y;
+    q->flags     = _flags;
+    q->type      = LIQUID_FFT_REAL_BACKWARD;
+    q->direction = LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_UNKNOWN;
+
+    if ((q->nfft % 2) == 0) {
+        // even length: compute with half-size complex inverse transform
+        unsigned int m = q->nfft / 2;
+        q->execute = FFT(_execute_c2r);
+
+        // allocate internal buffers
+        q->data.real.z = (TC *) malloc(m*sizeof(TC));
+        q->data.real.Z = (TC *) malloc(m*sizeof(TC));
+
+        // initialize recombination twiddle factors: exp(+j 2 pi k / nfft)
+        q->data.real.twiddle = (TC *) malloc(m*sizeof(TC));
+        unsigned int i;
+        for (i=0; i<m; i++)
+            q->data.real.twiddle[i] = cexpf(+_Complex_I*2*M_PI*(T)i / (T)(q->nfft));
+
+        // create half-size complex sub-transform
+        q->data.real.fft = FFT(_create_plan)(m, q->data.real.Z, q->data.real.z,
+                                             LIQUID_FFT_BACKWARD, q->flags);
+    } else {
+        // odd length: fall back to a full complex transform, retaining
+        // the real component of the result
+        q->execute = FFT(_execute_c2r_odd);
+
+        q->data.real.z       = (TC *) malloc(q->nfft*sizeof(TC));
+        q->data.real.Z       = NULL;
+        q->data.real.twiddle = NULL;
+
+        q->data.real.fft = FFT(_create_plan)(q->nfft, q->x, q->data.real.z,
+                                             LIQUID_FFT_BACKWARD, q->flags);
+    }
+
+    return q;
+}
+
+// destroy FFT plan
+void FFT(_destroy_plan_real)(FFT(plan) _q)
+{
+    // free data specific to real-input transforms (buffers unused by
+    // the odd-length fallback are NULL)
+    free(_q->data.real.z);
+    free(_q->data.real.Z);
+    free(_q->data.real.twiddle);
+
+    // destroy sub-transform
+    FFT(_destroy_plan)(_q->data.real.fft);
+
+    // free main object memory
+    free(_q);
+}
+
+// print real-input (r2c/c2r) plan
+void FFT(_print_plan_real)(FFT(plan) _q)
+{
+    printf("fft plan [%s], n=%u, real\n",
+            _q->type == LIQUID_FFT_REAL_FORWARD ? "r2c" : "c2r",
+            _q->nfft);
+
+    // print sub-transform plan
+    FFT(_print_plan_recursive)(_q->data.real.fft, 1);
+}
+
+// execute real-to-complex transform (even length)
+void FFT(_execute_r2c)(FFT(plan) _q)
+{
+    unsigned int m = _q->nfft / 2;
+    unsigned int i;
+
+    // pack real input into half-size complex buffer:
+    //   z[k] = x[2k] + j x[2k+1]
+    // (interleaved memory layouts are identical)
+    memmove(_q->data.real.z, _q->xr, _q->nfft*sizeof(T));
+
+    // run half-size complex transform
+    FFT(_execute)(_q->data.real.fft);
+
+    // recombine, exploiting conjugate symmetry:
+    //   X[k] = Xe[k] + W^k Xo[k],   W = exp(-j 2 pi / nfft)
+    // where Xe, Xo are the transforms of the even/odd input samples
+    TC * Z = _q->data.real.Z;
+    _q->y[0] = crealf(Z[0]) + cimagf(Z[0]);
+    _q->y[m] = crealf(Z[0]) - cimagf(Z[0]);
+    for (i=1; i<m; i++) {
+        TC z0 =       Z[  i];
+        TC z1 = conjf(Z[m-i]);
+        TC Xe =               0.5f*(z0 + z1);
+        TC Xo = -_Complex_I * 0.5f*(z0 - z1);
+        _q->y[i] = Xe + _q->data.real.twiddle[i]*Xo;
+
+        // fill negative frequencies from conjugate symmetry
+        _q->y[_q->nfft-i] = conjf(_q->y[i]);
+    }
+}
+
+// execute complex-to-real inverse transform (even length)
+void FFT(_execute_c2r)(FFT(plan) _q)
+{
+    unsigned int m = _q->nfft / 2;
+    unsigned int i;
+
+    // split the (conjugate-symmetric) spectrum into the half-size
+    // transforms of the even/odd output samples and re-pack:
+    //   Xe[k] =        ( X[k] + conj(X[m-k]) ) / 2
+    //   Xo[k] = W^{-k} ( X[k] - conj(X[m-k]) ) / 2
+    //   Z[k]  = Xe[k] + j Xo[k]
+    TC * X = _q->x;
+    for (i=0; i<m; i++) {
+        TC x0 =       X[  i];
+        TC x1 = conjf(X[m-i]);
+        TC Xe = 0.5f*(x0 + x1);
+        TC Xo = 0.5f*(x0 - x1) * _q->data.real.twiddle[i];
+        _q->data.real.Z[i] = Xe + _Complex_I*Xo;
+    }
+
+    // run half-size complex inverse transform
+    FFT(_execute)(_q->data.real.fft);
+
+    // unpack interleaved real/imaginary components; as with the regular
+    // complex inverse transform the output is scaled by the size
+    for (i=0; i<m; i++) {
+        _q->yr[2*i+0] = 2.0f*crealf(_q->data.real.z[i]);
+        _q->yr[2*i+1] = 2.0f*cimagf(_q->data.real.z[i]);
+    }
+}
+
+// execute real-to-complex transform (odd-length fallback)
+void FFT(_execute_r2c_odd)(FFT(plan) _q)
+{
+    // copy real input to internal complex buffer
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++)
+        _q->data.real.z[i] = _q->xr[i];
+
+    // run full complex transform directly into the output array
+    FFT(_execute)(_q->data.real.fft);
+}
+
+// execute complex-to-real inverse transform (odd-length fallback)
+void FFT(_execute_c2r_odd)(FFT(plan) _q)
+{
+    // run full complex inverse transform on the input array
+    FFT(_execute)(_q->data.real.fft);
+
+    // retain real component of the result
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++)
+        _q->yr[i] = crealf(_q->data.real.z[i]);
+}
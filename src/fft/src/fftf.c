@@ -43,5 +43,7 @@
 #include "fft_mixed_radix.c"    // FFT definitions for mixed-radix transforms (Cooley-Tukey)
 #include "fft_rader.c"          // FFT definitions for transforms of prime length (Rader's algorithm)
 #include "fft_rader2.c"         // FFT definitions for transforms of prime length (Rader's alternate algorithm)
+#include "fft_pruned.c"         // FFT definitions for input-pruned transforms (sparse spectra)
 #include "fft_r2r_1d.c"         // real-to-real definitions (DCT/DST)
+#include "fft_real.c"           // real-input definitions (r2c/c2r)
 
@@ -26,13 +26,31 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include <complex.h>
 #include "liquid.internal.h"
 
+// process-wide cache of scaled window tables, interned across all
+// spgram instances with identical window type, length, and transform
+// size (the normalization depends on the FFT size) and
+// reference-counted so a bank of identical monitors keeps one table
+// resident instead of one copy per instance
+struct SPGRAM(_wtab_s) {
+    int          wtype;         // window type
+    unsigned int window_len;    // window length
+    unsigned int nfft;          // FFT length (normalization)
+    T *          w;             // scaled tapering window [size: window_len x 1]
+    T *          wdup;          // window duplicated across interleaved
+                                // real/imag components (complex input only)
+    unsigned int refcount;      // number of instances holding a reference
+    struct SPGRAM(_wtab_s) * next;
+};
+
 struct SPGRAM(_s) {
     // options
     unsigned int    nfft;           // FFT length
@@ -45,10 +63,23 @@ struct SPGRAM(_s) {
 
     WINDOW()        buffer;         // input buffer
     TC *            buf_time;       // pointer to input array (allocated)
+    T *             buf_real;       // real input array (r2c transform only)
     TC *            buf_freq;       // output fft (allocated)
     T  *            w;              // tapering window [size: window_len x 1]
+    T  *            wdup;           // window duplicated across interleaved
+                                    // real/imag components (complex input only)
+    struct SPGRAM(_wtab_s) * wtab;  // shared window tables (NULL: object owns w, wdup)
     FFT_PLAN        fft;            // FFT plan
 
+    // decimating sub-band mode (complex input only): frequency
+    // translation, anti-alias filtering, and decimation fused into
+    // the transform stage
+    unsigned int    decim;          // decimation factor (1: disabled)
+    TC *            hmix;           // mixed anti-alias filter taps [size: hmix_len x 1]
+    unsigned int    hmix_len;       // anti-alias filter length
+    TC *            vmix;           // combined taper/de-rotation weights [size: num_out x 1]
+    unsigned int    num_out;        // decimated samples per transform, num_out <= nfft
+
     // psd accumulation
     T *                 psd;                    // accumulated power spectral density estimate (linear)
     unsigned int        sample_timer;           // countdown to transform
@@ -56,6 +87,8 @@ struct SPGRAM(_s) {
     unsigned long long int num_samples_total;   // total number of samples since start
     unsigned long long int num_transforms;      // total number of transforms since reset
     unsigned long long int num_transforms_total;// total number of transforms since start
+    unsigned long long int epoch;               // accumulation epoch; increments whenever
+                                                // the accumulated spectrum changes
 
     // parameters for display purposes only
     float           frequency;      // center frequency [Hz]
@@ -70,6 +103,128 @@ struct SPGRAM(_s) {
 // from current buffer contents
 void SPGRAM(_step)(SPGRAM() _q);
 
+// initialize tapering window, writing _n coefficients to the
+// (pre-allocated) array; returns -1 on an unknown window type
+int SPGRAM(_init_window)(int          _wtype,
+                         unsigned int _n,
+                         T *          _w)
+{
+    unsigned int i;
+    float beta = 10.0f;
+    float zeta =  3.0f;
+    if (_wtype == LIQUID_WINDOW_KAISER) {
+        // compute entire window in a single block
+        liquid_kaiser_window(_n, beta, _w);
+        return 0;
+    }
+
+    for (i=0; i<_n; i++) {
+        switch (_wtype) {
+        case LIQUID_WINDOW_HAMMING:         _w[i] = liquid_hamming(i,_n);         break;
+        case LIQUID_WINDOW_HANN:            _w[i] = liquid_hann(i,_n);            break;
+        case LIQUID_WINDOW_BLACKMANHARRIS:  _w[i] = liquid_blackmanharris(i,_n);  break;
+        case LIQUID_WINDOW_BLACKMANHARRIS7: _w[i] = liquid_blackmanharris7(i,_n); break;
+        case LIQUID_WINDOW_FLATTOP:         _w[i] = liquid_flattop(i,_n);         break;
+        case LIQUID_WINDOW_TRIANGULAR:      _w[i] = liquid_triangular(i,_n,_n);   break;
+        case LIQUID_WINDOW_RCOSTAPER:       _w[i] = liquid_rcostaper_window(i,_n,_n/3); break;
+        case LIQUID_WINDOW_KBD:             _w[i] = liquid_kbd(i,_n,zeta); break;
+        default:
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// window table cache; objects may be created and destroyed from
+// multiple threads, so the list and reference counts are guarded by
+// a mutex
+static struct SPGRAM(_wtab_s) * SPGRAM(_wtab_cache) = NULL;
+static pthread_mutex_t SPGRAM(_wtab_cache_mutex) = PTHREAD_MUTEX_INITIALIZER;
+
+// acquire a reference to the shared, scaled window tables for the given
+// parameters, creating and caching them on first use; returns NULL on
+// an unknown window type
+struct SPGRAM(_wtab_s) * SPGRAM(_wtab_acquire)(int          _wtype,
+                                               unsigned int _window_len,
+                                               unsigned int _nfft)
+{
+    pthread_mutex_lock(&SPGRAM(_wtab_cache_mutex));
+
+    // search cache for matching table set
+    struct SPGRAM(_wtab_s) * t = SPGRAM(_wtab_cache);
+    while (t != NULL) {
+        if (t->wtype == _wtype && t->window_len == _window_len && t->nfft == _nfft) {
+            t->refcount++;
+            pthread_mutex_unlock(&SPGRAM(_wtab_cache_mutex));
+            return t;
+        }
+        t = t->next;
+    }
+
+    // not found; compute window coefficients
+    T * w = (T*) malloc(_window_len*sizeof(T));
+    if (SPGRAM(_init_window)(_wtype, _window_len, w)) {
+        free(w);
+        pthread_mutex_unlock(&SPGRAM(_wtab_cache_mutex));
+        return NULL;
+    }
+
+    // scale by window magnitude, FFT size
+    unsigned int i;
+    float g = 0.0f;
+    for (i=0; i<_window_len; i++)
+        g += w[i] * w[i];
+    g = M_SQRT2 / ( sqrtf(g / _window_len) * sqrtf((float)_nfft) );
+    for (i=0; i<_window_len; i++)
+        w[i] = g * w[i];
+
+    // create new table set and insert at head of cache
+    t = (struct SPGRAM(_wtab_s) *) malloc(sizeof(struct SPGRAM(_wtab_s)));
+    t->wtype      = _wtype;
+    t->window_len = _window_len;
+    t->nfft       = _nfft;
+    t->w          = w;
+    t->wdup       = NULL;
+#if TI_COMPLEX
+    // duplicate window across interleaved real/imaginary components so
+    // it can be applied with a single vectorized real multiply in _step()
+    t->wdup = (T*) malloc((2*_window_len)*sizeof(T));
+    for (i=0; i<_window_len; i++) {
+        t->wdup[2*i+0] = w[i];
+        t->wdup[2*i+1] = w[i];
+    }
+#endif
+    t->refcount = 1;
+    t->next     = SPGRAM(_wtab_cache);
+    SPGRAM(_wtab_cache) = t;
+    pthread_mutex_unlock(&SPGRAM(_wtab_cache_mutex));
+    return t;
+}
+
+// release a reference to a shared window table set, freeing the tables
+// once the last instance using them is destroyed
+void SPGRAM(_wtab_release)(struct SPGRAM(_wtab_s) * _t)
+{
+    pthread_mutex_lock(&SPGRAM(_wtab_cache_mutex));
+    _t->refcount--;
+    if (_t->refcount > 0) {
+        pthread_mutex_unlock(&SPGRAM(_wtab_cache_mutex));
+        return;
+    }
+
+    // unlink from cache
+    struct SPGRAM(_wtab_s) ** p = &SPGRAM(_wtab_cache);
+    while (*p != _t)
+        p = &(*p)->next;
+    *p = _t->next;
+    pthread_mutex_unlock(&SPGRAM(_wtab_cache_mutex));
+
+    // free tables
+    free(_t->w);
+    free(_t->wdup);
+    free(_t);
+}
+
 // create spgram object
 //  _nfft       : FFT size
 //  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
@@ -109,53 +264,47 @@ SPGRAM() SPGRAM(_create)(unsigned int _nfft,
     q->frequency  =  0;
     q->sample_rate= -1;
 
+    // decimating sub-band mode disabled
+    q->decim    = 1;
+    q->hmix     = NULL;
+    q->hmix_len = 0;
+    q->vmix     = NULL;
+    q->num_out  = 0;
+
     // set object for full accumulation
     SPGRAM(_set_alpha)(q, -1.0f);
 
     // create FFT arrays, object
-    q->buf_time = (TC*) malloc((q->nfft)*sizeof(TC));
     q->buf_freq = (TC*) malloc((q->nfft)*sizeof(TC));
     q->psd      = (T *) malloc((q->nfft)*sizeof(T ));
+#if TI_COMPLEX
+    q->buf_time = (TC*) malloc((q->nfft)*sizeof(TC));
+    q->buf_real = NULL;
     q->fft      = FFT_CREATE_PLAN(q->nfft, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, FFT_METHOD);
+#else
+    // real input: exploit conjugate symmetry with a real-to-complex transform
+    q->buf_time = NULL;
+    q->buf_real = (T *) malloc((q->nfft)*sizeof(T ));
+    q->fft      = FFT_CREATE_PLAN_R2C(q->nfft, q->buf_real, q->buf_freq, FFT_METHOD);
+#endif
 
     // create buffer
     q->buffer = WINDOW(_create)(q->window_len);
 
-    // create window
-    q->w = (T*) malloc((q->window_len)*sizeof(T));
-    unsigned int i;
-    unsigned int n = q->window_len;
-    float beta = 10.0f;
-    float zeta =  3.0f;
-    for (i=0; i<n; i++) {
-        switch (q->wtype) {
-        case LIQUID_WINDOW_HAMMING:         q->w[i] = liquid_hamming(i,n);         break;
-        case LIQUID_WINDOW_HANN:            q->w[i] = liquid_hann(i,n);            break;
-        case LIQUID_WINDOW_BLACKMANHARRIS:  q->w[i] = liquid_blackmanharris(i,n);  break;
-        case LIQUID_WINDOW_BLACKMANHARRIS7: q->w[i] = liquid_blackmanharris7(i,n); break;
-        case LIQUID_WINDOW_KAISER:          q->w[i] = liquid_kaiser(i,n,beta);     break;
-        case LIQUID_WINDOW_FLATTOP:         q->w[i] = liquid_flattop(i,n);         break;
-        case LIQUID_WINDOW_TRIANGULAR:      q->w[i] = liquid_triangular(i,n,n);    break;
-        case LIQUID_WINDOW_RCOSTAPER:       q->w[i] = liquid_rcostaper_window(i,n,n/3); break;
-        case LIQUID_WINDOW_KBD:             q->w[i] = liquid_kbd(i,n,zeta); break;
-        default:
-            fprintf(stderr,"error: spgram%s_create(), invalid window\n", EXTENSION);
-            SPGRAM(_destroy)(q);
-            return NULL;
-        }
+    // acquire shared window tables, scaled for this window and FFT size
+    q->wtab = SPGRAM(_wtab_acquire)(q->wtype, q->window_len, q->nfft);
+    if (q->wtab == NULL) {
+        fprintf(stderr,"error: spgram%s_create(), invalid window\n", EXTENSION);
+        q->w    = NULL;
+        q->wdup = NULL;
+        SPGRAM(_destroy)(q);
+        return NULL;
     }
+    q->w    = q->wtab->w;
+    q->wdup = q->wtab->wdup;
 
-    // scale by window magnitude, FFT size
-    float g = 0.0f;
-    for (i=0; i<q->window_len; i++)
-        g += q->w[i] * q->w[i];
-    g = M_SQRT2 / ( sqrtf(g / q->window_len) * sqrtf((float)(q->nfft)) );
-
-    // scale window and copy
-    for (i=0; i<q->window_len; i++)
-        q->w[i] = g * q->w[i];
-
-    // reset the spgram object
+    // initialize accumulation epoch and reset the spgram object
+    q->epoch = 0;
     SPGRAM(_reset)(q);
 
     // return new object
@@ -174,6 +323,141 @@ SPGRAM() SPGRAM(_create_default)(unsigned int _nfft)
     return SPGRAM(_create)(_nfft, LIQUID_WINDOW_KAISER, _nfft/2, _nfft/4);
 }
 
+#if TI_COMPLEX
+// create spgram object for monitoring a decimated sub-band, fusing
+// frequency translation, anti-alias filtering, and decimation into the
+// transform stage: the object buffers raw input samples and each FFT
+// input is computed at transform time as a strided anti-alias filter
+// dot product, de-rotated to the sub-band center and tapered, so many
+// monitors can share a single input pass instead of each running its
+// own decimator chain. The estimate is equivalent to mixing the input
+// down by _fc, decimating by _decim, and running a standard spgram,
+// and is normalized so mid-band levels line up with a full-band
+// estimate of the same input.
+//  _nfft       : FFT size (resolution within the sub-band)
+//  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
+//  _window_len : window length [decimated samples], _window_len <= _nfft
+//  _delay      : delay between transforms [input samples], _delay > 0
+//  _fc         : sub-band center frequency, -0.5 <= _fc <= 0.5
+//  _decim      : decimation factor, _decim > 0
+SPGRAM() SPGRAM(_create_decim)(unsigned int _nfft,
+                               int          _wtype,
+                               unsigned int _window_len,
+                               unsigned int _delay,
+                               float        _fc,
+                               unsigned int _decim)
+{
+    // validate input
+    if (_nfft < 2) {
+        fprintf(stderr,"error: spgram%s_create_decim(), fft size must be at least 2\n", EXTENSION);
+        return NULL;
+    } else if (_window_len > _nfft) {
+        fprintf(stderr,"error: spgram%s_create_decim(), window size cannot exceed fft size\n", EXTENSION);
+        return NULL;
+    } else if (_window_len == 0) {
+        fprintf(stderr,"error: spgram%s_create_decim(), window size must be greater than zero\n", EXTENSION);
+        return NULL;
+    } else if (_wtype == LIQUID_WINDOW_KBD && _window_len % 2) {
+        fprintf(stderr,"error: spgram%s_create_decim(), KBD window length must be even\n", EXTENSION);
+        return NULL;
+    } else if (_delay == 0) {
+        fprintf(stderr,"error: spgram%s_create_decim(), delay must be greater than 0\n", EXTENSION);
+        return NULL;
+    } else if (_fc < -0.5f || _fc > 0.5f) {
+        fprintf(stderr,"error: spgram%s_create_decim(), center frequency must be in [-0.5,0.5]\n", EXTENSION);
+        return NULL;
+    } else if (_decim == 0) {
+        fprintf(stderr,"error: spgram%s_create_decim(), decimation factor must be greater than zero\n", EXTENSION);
+        return NULL;
+    }
+
+    // allocate memory for main object
+    SPGRAM() q = (SPGRAM()) malloc(sizeof(struct SPGRAM(_s)));
+
+    // set input parameters
+    q->nfft       = _nfft;
+    q->wtype      = _wtype;
+    q->delay      = _delay;
+    q->frequency  =  0;
+    q->sample_rate= -1;
+    q->decim      = _decim;
+    q->num_out    = _window_len;
+
+    // design anti-alias prototype filter, scaled so a flat input
+    // density reads at the same level after decimation as it would on
+    // a full-band estimate (unit passband power gain)
+    unsigned int i;
+    q->hmix_len = 2*4*_decim + 1;
+    float * h = (float*) malloc(q->hmix_len*sizeof(float));
+    liquid_firdes_kaiser(q->hmix_len, 0.45f/(float)_decim, 60.0f, 0.0f, h);
+    float hsum = 0.0f;
+    for (i=0; i<q->hmix_len; i++)
+        hsum += h[i];
+    float hg = sqrtf((float)_decim) / hsum;
+
+    // mix filter taps down to the sub-band center so filtering and
+    // frequency translation fuse into a single complex dot product
+    q->hmix = (TC*) malloc(q->hmix_len*sizeof(TC));
+    for (i=0; i<q->hmix_len; i++) {
+        double phi = -2.0*M_PI*(double)_fc*(double)i;
+        q->hmix[i] = hg*h[i]*cexpf(_Complex_I*(float)fmod(phi, 2.0*M_PI));
+    }
+    free(h);
+
+    // buffer enough raw samples to produce num_out decimated outputs
+    q->window_len = (q->num_out-1)*_decim + q->hmix_len;
+
+    // set object for full accumulation
+    SPGRAM(_set_alpha)(q, -1.0f);
+
+    // create FFT arrays, object
+    q->buf_freq = (TC*) malloc((q->nfft)*sizeof(TC));
+    q->psd      = (T *) malloc((q->nfft)*sizeof(T ));
+    q->buf_time = (TC*) malloc((q->nfft)*sizeof(TC));
+    q->buf_real = NULL;
+    q->fft      = FFT_CREATE_PLAN(q->nfft, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, FFT_METHOD);
+
+    // create buffer
+    q->buffer = WINDOW(_create)(q->window_len);
+
+    // create window; the taper is folded into the per-output de-rotation
+    // weights below, so this object owns its tables rather than sharing
+    // them through the cache
+    q->w    = (T*) malloc((q->num_out)*sizeof(T));
+    q->wdup = NULL;
+    q->wtab = NULL;
+    q->vmix = NULL;
+    if (SPGRAM(_init_window)(q->wtype, q->num_out, q->w)) {
+        fprintf(stderr,"error: spgram%s_create_decim(), invalid window\n", EXTENSION);
+        SPGRAM(_destroy)(q);
+        return NULL;
+    }
+
+    // scale by window magnitude, FFT size
+    float g = 0.0f;
+    for (i=0; i<q->num_out; i++)
+        g += q->w[i] * q->w[i];
+    g = M_SQRT2 / ( sqrtf(g / q->num_out) * sqrtf((float)(q->nfft)) );
+
+    // combine scaled taper with the per-output de-rotation: the mixed
+    // filter leaves a residual rotation of _fc*_decim cycles per
+    // decimated sample on the sub-band center
+    q->vmix = (TC*) malloc((q->num_out)*sizeof(TC));
+    for (i=0; i<q->num_out; i++) {
+        double phi = -2.0*M_PI*(double)_fc*(double)_decim*(double)i;
+        q->w[i]   *= g;
+        q->vmix[i] = q->w[i]*cexpf(_Complex_I*(float)fmod(phi, 2.0*M_PI));
+    }
+
+    // initialize accumulation epoch and reset the spgram object
+    q->epoch = 0;
+    SPGRAM(_reset)(q);
+
+    // return new object
+    return q;
+}
+#endif
+
 // destroy spgram object
 void SPGRAM(_destroy)(SPGRAM() _q)
 {
@@ -182,8 +466,17 @@ void SPGRAM(_destroy)(SPGRAM() _q)
 
     // free allocated memory
     free(_q->buf_time);
+    free(_q->buf_real);
     free(_q->buf_freq);
-    free(_q->w);
+    if (_q->wtab != NULL) {
+        // window tables are shared; drop this instance's reference
+        SPGRAM(_wtab_release)(_q->wtab);
+    } else {
+        free(_q->w);
+        free(_q->wdup);
+    }
+    free(_q->hmix);
+    free(_q->vmix);
     free(_q->psd);
     WINDOW(_destroy)(_q->buffer);
     FFT_DESTROY_PLAN(_q->fft);
@@ -198,8 +491,13 @@ void SPGRAM(_clear)(SPGRAM() _q)
 {
     // clear FFT input
     unsigned int i;
-    for (i=0; i<_q->nfft; i++)
+    for (i=0; i<_q->nfft; i++) {
+#if TI_COMPLEX
         _q->buf_time[i] = 0.0f;
+#else
+        _q->buf_real[i] = 0.0f;
+#endif
+    }
 
     // reset counters
     _q->sample_timer   = _q->delay;
@@ -209,6 +507,9 @@ void SPGRAM(_clear)(SPGRAM() _q)
     // clear PSD accumulation
     for (i=0; i<_q->nfft; i++)
         _q->psd[i] = 0.0f;
+
+    // accumulated spectrum changed
+    _q->epoch++;
 }
 
 // reset the spgram object to its original state completely
@@ -324,6 +625,15 @@ float SPGRAM(_get_alpha)(SPGRAM() _q)
     return _q->alpha;
 }
 
+// get accumulation epoch; the epoch increments whenever the
+// accumulated spectrum changes (transform or reset), so pollers can
+// compare against a saved value and skip conversion entirely when the
+// spectrum is unchanged
+unsigned long long int SPGRAM(_get_epoch)(SPGRAM() _q)
+{
+    return _q->epoch;
+}
+
 // push a single sample into the spgram object
 //  _q      :   spgram object
 //  _x      :   input sample
@@ -356,15 +666,29 @@ void SPGRAM(_write)(SPGRAM()     _q,
                     TI *         _x,
                     unsigned int _n)
 {
-#if 0
-    // write a block of samples to the internal window
-    WINDOW(_write)(_q->buffer, _x, _n);
-#else
-    // TODO: be smarter about how to write and execute samples
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        SPGRAM(_push)(_q, _x[i]);
-#endif
+    // process buffer in segments delimited by the transform schedule,
+    // writing each segment to the internal window in one pass rather
+    // than pushing samples individually
+    unsigned int i=0;
+    while (i < _n) {
+        // number of samples to process before the next transform
+        unsigned int num = _q->sample_timer < (_n-i) ? _q->sample_timer : (_n-i);
+
+        // write segment of samples to the internal window
+        WINDOW(_write)(_q->buffer, &_x[i], num);
+
+        // update counters
+        _q->num_samples       += num;
+        _q->num_samples_total += num;
+        _q->sample_timer      -= num;
+        i += num;
+
+        if (_q->sample_timer == 0) {
+            // reset timer and step through computation
+            _q->sample_timer = _q->delay;
+            SPGRAM(_step)(_q);
+        }
+    }
 }
 
 
@@ -374,16 +698,46 @@ void SPGRAM(_step)(SPGRAM() _q)
 {
     unsigned int i;
 
-    // read buffer, copy to FFT input (applying window)
-    // TODO: use SIMD extensions to speed this up
+    // read buffer, copy to FFT input (applying window) in a single
+    // vectorized pass
     TI * rc;
     WINDOW(_read)(_q->buffer, &rc);
-    for (i=0; i<_q->window_len; i++)
-        _q->buf_time[i] = rc[i] * _q->w[i];
+#if TI_COMPLEX
+    if (_q->hmix != NULL) {
+        // decimating sub-band mode: each FFT input is a strided
+        // anti-alias filter dot product against the raw buffer (the
+        // mixer is folded into the taps), de-rotated to the sub-band
+        // center and tapered by the analysis window
+        unsigned int k;
+        unsigned int p;
+        for (k=0; k<_q->num_out; k++) {
+            TI * xk = rc + k*_q->decim;
+            TC   v  = 0;
+            for (p=0; p<_q->hmix_len; p++)
+                v += xk[p] * _q->hmix[p];
+            _q->buf_time[k] = v * _q->vmix[k];
+        }
+        for (k=_q->num_out; k<_q->nfft; k++)
+            _q->buf_time[k] = 0;
+    } else {
+        // multiply interleaved real/imaginary components by the
+        // duplicated window
+        liquid_vectorf_mul((T*)rc, _q->wdup, 2*_q->window_len, (T*)_q->buf_time);
+    }
+#else
+    liquid_vectorf_mul(rc, _q->w, _q->window_len, _q->buf_real);
+#endif
 
-    // execute fft on _q->buf_time and store result in _q->buf_freq
+    // execute fft on input buffer and store result in _q->buf_freq
     FFT_EXECUTE(_q->fft);
 
+#if !TI_COMPLEX
+    // complete negative frequencies from conjugate symmetry (an fftw
+    // r2c transform only populates the first nfft/2+1 bins)
+    for (i=1; i<(_q->nfft+1)/2; i++)
+        _q->buf_freq[_q->nfft-i] = conjf(_q->buf_freq[i]);
+#endif
+
     // accumulate output
     // TODO: vectorize this operation
     for (i=0; i<_q->nfft; i++) {
@@ -396,6 +750,7 @@ void SPGRAM(_step)(SPGRAM() _q)
 
     _q->num_transforms++;
     _q->num_transforms_total++;
+    _q->epoch++;
 }
 
 // compute spectral periodogram output (fft-shifted values
@@ -405,17 +760,149 @@ void SPGRAM(_step)(SPGRAM() _q)
 void SPGRAM(_get_psd)(SPGRAM() _q,
                       T *      _X)
 {
-    // compute magnitude in dB and run FFT shift
+    // compute magnitude in dB and run FFT shift; the per-bin
+    // conversion uses the fast logarithm approximation as display
+    // output does not need libm accuracy
     unsigned int i;
     unsigned int nfft_2 = _q->nfft / 2;
     T scale = _q->accumulate ? -10*log10f(_q->num_transforms) : 0.0f;
     // TODO: adjust scale if infinite integration
     for (i=0; i<_q->nfft; i++) {
         unsigned int k = (i + nfft_2) % _q->nfft;
-        _X[i] = 10*log10f(_q->psd[k]+1e-12f) + scale;
+        // 10*log10(x) = (10/ln(10)) * ln(x)
+        _X[i] = 4.342944819f*liquid_logf(_q->psd[k]+1e-12f) + scale;
     }
 }
 
+// compute spectral periodogram output only if the accumulated spectrum
+// has changed since the caller's saved epoch, avoiding the per-bin dB
+// conversion for unchanged spectra (e.g. display polling faster than
+// the transform rate)
+//  _q      :   spgram object
+//  _epoch  :   caller's saved epoch, updated on conversion (set to 0
+//              before the first call)
+//  _X      :   output spectrum [size: _nfft x 1]
+// returns 1 if _X was updated, 0 if the spectrum was unchanged
+int SPGRAM(_get_psd_delta)(SPGRAM()                 _q,
+                           unsigned long long int * _epoch,
+                           T *                      _X)
+{
+    // spectrum unchanged since caller's last conversion?
+    if (*_epoch == _q->epoch)
+        return 0;
+
+    // convert and save new epoch
+    SPGRAM(_get_psd)(_q, _X);
+    *_epoch = _q->epoch;
+    return 1;
+}
+
+// exported accumulation state layout:
+//   uint32_t nfft            transform size
+//   uint32_t wtype           window type
+//   uint32_t window_len      window length
+//   uint64_t num_samples     samples since reset
+//   uint64_t num_transforms  transforms since reset
+//   T        psd[nfft]       linear power accumulation buffer
+
+// get size of exported accumulation state [bytes]
+unsigned int SPGRAM(_get_accum_size)(SPGRAM() _q)
+{
+    return 3*sizeof(uint32_t) + 2*sizeof(uint64_t) + _q->nfft*sizeof(T);
+}
+
+// export raw linear accumulation state into compact binary buffer
+//  _q       : spgram object
+//  _buf     : output buffer, [size: _buf_len x 1]
+//  _buf_len : buffer length, at least SPGRAM(_get_accum_size)
+int SPGRAM(_export_accum)(SPGRAM()        _q,
+                          unsigned char * _buf,
+                          unsigned int    _buf_len)
+{
+    // validate input
+    if (!_q->accumulate) {
+        fprintf(stderr,"warning: spgram%s_export_accum(), object must be in accumulation mode\n", EXTENSION);
+        return -1;
+    } else if (_buf_len < SPGRAM(_get_accum_size)(_q)) {
+        fprintf(stderr,"warning: spgram%s_export_accum(), buffer length %u too small (expected %u)\n",
+                EXTENSION, _buf_len, SPGRAM(_get_accum_size)(_q));
+        return -1;
+    }
+
+    // write fixed-width header
+    uint32_t nfft           = _q->nfft;
+    uint32_t wtype          = _q->wtype;
+    uint32_t window_len     = _q->window_len;
+    uint64_t num_samples    = _q->num_samples;
+    uint64_t num_transforms = _q->num_transforms;
+    unsigned char * p = _buf;
+    memcpy(p, &nfft,           sizeof(uint32_t)); p += sizeof(uint32_t);
+    memcpy(p, &wtype,          sizeof(uint32_t)); p += sizeof(uint32_t);
+    memcpy(p, &window_len,     sizeof(uint32_t)); p += sizeof(uint32_t);
+    memcpy(p, &num_samples,    sizeof(uint64_t)); p += sizeof(uint64_t);
+    memcpy(p, &num_transforms, sizeof(uint64_t)); p += sizeof(uint64_t);
+
+    // write linear accumulation buffer
+    memcpy(p, _q->psd, _q->nfft*sizeof(T));
+    return 0;
+}
+
+// merge previously exported accumulation state into this object by
+// summing the linear accumulation buffers and sample/transform counts
+//  _q       : spgram object
+//  _buf     : input buffer, [size: _buf_len x 1]
+//  _buf_len : buffer length, must match SPGRAM(_get_accum_size)
+int SPGRAM(_import_merge)(SPGRAM()        _q,
+                          unsigned char * _buf,
+                          unsigned int    _buf_len)
+{
+    // validate input
+    if (!_q->accumulate) {
+        fprintf(stderr,"warning: spgram%s_import_merge(), object must be in accumulation mode\n", EXTENSION);
+        return -1;
+    } else if (_buf_len != SPGRAM(_get_accum_size)(_q)) {
+        fprintf(stderr,"warning: spgram%s_import_merge(), buffer length %u invalid (expected %u)\n",
+                EXTENSION, _buf_len, SPGRAM(_get_accum_size)(_q));
+        return -1;
+    }
+
+    // read fixed-width header
+    uint32_t nfft;
+    uint32_t wtype;
+    uint32_t window_len;
+    uint64_t num_samples;
+    uint64_t num_transforms;
+    unsigned char * p = _buf;
+    memcpy(&nfft,           p, sizeof(uint32_t)); p += sizeof(uint32_t);
+    memcpy(&wtype,          p, sizeof(uint32_t)); p += sizeof(uint32_t);
+    memcpy(&window_len,     p, sizeof(uint32_t)); p += sizeof(uint32_t);
+    memcpy(&num_samples,    p, sizeof(uint64_t)); p += sizeof(uint64_t);
+    memcpy(&num_transforms, p, sizeof(uint64_t)); p += sizeof(uint64_t);
+
+    // verify configuration matches so partial periodograms are
+    // commensurable
+    if (nfft       != _q->nfft       ||
+        wtype      != (uint32_t)_q->wtype ||
+        window_len != _q->window_len) {
+        fprintf(stderr,"warning: spgram%s_import_merge(), configuration mismatch\n", EXTENSION);
+        return -1;
+    }
+
+    // sum linear accumulation buffers and counters
+    unsigned int i;
+    const T * psd = (const T *)p;
+    for (i=0; i<_q->nfft; i++)
+        _q->psd[i] += psd[i];
+    _q->num_samples          += num_samples;
+    _q->num_samples_total    += num_samples;
+    _q->num_transforms       += num_transforms;
+    _q->num_transforms_total += num_transforms;
+
+    // accumulated spectrum changed
+    _q->epoch++;
+    return 0;
+}
+
 // export gnuplot file
 //  _q        : spgram object
 //  _filename : input buffer [size: _n x 1]
@@ -44,6 +44,15 @@ struct SPWATERFALL(_s) {
     unsigned int    index_time;     // time index for writing to buffer
     unsigned int    rollover;       // number of FFTs to take before writing to output
 
+    // multi-resolution pyramid (optional)
+    int             pyramid_enabled;// pyramid mode enabled?
+    unsigned int    pyramid_levels; // number of time-decimation levels
+    T *             pyramid_psd;    // level buffers [levels x time x nfft]
+    uint64_t *      pyramid_count;  // total rows written at each level [size: levels x 1]
+
+    // binary archive (optional)
+    FILE *          archive_fid;    // append-only archive file handle
+
     // parameters for display purposes only
     float           frequency;      // center frequency [Hz]
     float           sample_rate;    // sample rate [Hz]
@@ -62,6 +71,12 @@ void SPWATERFALL(_step)(SPWATERFALL() _q);
 // consolidate buffer by taking log-average of two separate spectral estimates in time
 void SPWATERFALL(_consolidate_buffer)(SPWATERFALL() _q);
 
+// cascade newly-written pyramid rows to coarser time-decimation levels
+void SPWATERFALL(_pyramid_update)(SPWATERFALL() _q);
+
+// quantize a spectral estimate and append it to the open archive as one tile
+void SPWATERFALL(_archive_append)(SPWATERFALL() _q, const T * _psd);
+
 // export files
 int SPWATERFALL(_export_bin)(SPWATERFALL() _q, const char * _base);
 int SPWATERFALL(_export_gnu)(SPWATERFALL() _q, const char * _base);
@@ -110,6 +125,15 @@ SPWATERFALL() SPWATERFALL(_create)(unsigned int _nfft,
     q->height       = 800;
     q->commands     = NULL;
 
+    // pyramid mode disabled by default
+    q->pyramid_enabled = 0;
+    q->pyramid_levels  = 0;
+    q->pyramid_psd     = NULL;
+    q->pyramid_count   = NULL;
+
+    // archive closed by default
+    q->archive_fid     = NULL;
+
     // create buffer to hold aggregated power spectral density
     // NOTE: the buffer is two-dimensional time/frequency grid that is two times
     //       'nfft' and 'time' to account for log-average consolidation each time
@@ -148,6 +172,12 @@ void SPWATERFALL(_destroy)(SPWATERFALL() _q)
     // free allocated memory
     free(_q->psd);
     free(_q->commands);
+    free(_q->pyramid_psd);
+    free(_q->pyramid_count);
+
+    // close archive (if open)
+    if (_q->archive_fid != NULL)
+        fclose(_q->archive_fid);
 
     // destroy internal spectral periodogram object
     SPGRAM(_destroy)(_q->periodogram);
@@ -163,6 +193,12 @@ void SPWATERFALL(_clear)(SPWATERFALL() _q)
     SPGRAM(_clear)(_q->periodogram);
     memset(_q->psd, 0x00, 2*_q->nfft*_q->time*sizeof(T));
     _q->index_time = 0;
+
+    // clear pyramid buffers (if allocated)
+    if (_q->pyramid_psd != NULL) {
+        memset(_q->pyramid_psd,   0x00, _q->pyramid_levels*_q->time*_q->nfft*sizeof(T));
+        memset(_q->pyramid_count, 0x00, _q->pyramid_levels*sizeof(uint64_t));
+    }
 }
 
 // reset the spwaterfall object to its original state completely
@@ -203,6 +239,88 @@ const float * SPWATERFALL(_get_psd)(SPWATERFALL() _q)
     return (const T *) _q->psd;
 }
 
+// Enable incremental multi-resolution pyramid mode. Each level
+// maintains the most recent 'time' spectral estimates at a power-of-two
+// time decimation; new estimates cascade to coarser levels by pairwise
+// log-average, giving constant amortized cost per estimate and bounded
+// (levels x time x nfft) memory for arbitrarily long runs.
+//  _q          : spwaterfall object
+//  _num_levels : number of time-decimation levels, _num_levels > 0
+int SPWATERFALL(_pyramid_enable)(SPWATERFALL() _q,
+                                 unsigned int  _num_levels)
+{
+    // validate input
+    if (_num_levels == 0) {
+        fprintf(stderr,"error: spwaterfall%s_pyramid_enable(), number of levels must be greater than zero\n", EXTENSION);
+        return -1;
+    } else if (_num_levels > 1 && _q->time < 2) {
+        fprintf(stderr,"error: spwaterfall%s_pyramid_enable(), time buffer must be at least 2 to cascade levels\n", EXTENSION);
+        return -1;
+    }
+
+    // (re)allocate level buffers and row counters
+    _q->pyramid_levels = _num_levels;
+    _q->pyramid_psd    = (T*)        realloc(_q->pyramid_psd,   _num_levels*_q->time*_q->nfft*sizeof(T));
+    _q->pyramid_count  = (uint64_t*) realloc(_q->pyramid_count, _num_levels*sizeof(uint64_t));
+    memset(_q->pyramid_psd,   0x00, _num_levels*_q->time*_q->nfft*sizeof(T));
+    memset(_q->pyramid_count, 0x00, _num_levels*sizeof(uint64_t));
+
+    // enable pyramid mode
+    _q->pyramid_enabled = 1;
+    return 0;
+}
+
+// Disable pyramid mode; accumulated level buffers are retained for
+// querying until the object is cleared or destroyed
+int SPWATERFALL(_pyramid_disable)(SPWATERFALL() _q)
+{
+    _q->pyramid_enabled = 0;
+    return 0;
+}
+
+// Get number of pyramid time-decimation levels
+unsigned int SPWATERFALL(_pyramid_get_num_levels)(SPWATERFALL() _q)
+{
+    return _q->pyramid_levels;
+}
+
+// Get number of valid rows at a particular pyramid level; each row at
+// level 'l' spans 2^l spectral estimates in time
+unsigned int SPWATERFALL(_pyramid_get_num_time)(SPWATERFALL() _q,
+                                                unsigned int  _level)
+{
+    if (_level >= _q->pyramid_levels)
+        return 0;
+    uint64_t count = _q->pyramid_count[_level];
+    return count < (uint64_t)_q->time ? (unsigned int)count : _q->time;
+}
+
+// Get power spectral density at a particular pyramid level, copying
+// valid rows in chronological order (oldest first)
+//  _q     : spwaterfall object
+//  _level : pyramid level, _level < num_levels
+//  _psd   : output buffer [size: num_time x nfft]
+int SPWATERFALL(_pyramid_get_psd)(SPWATERFALL() _q,
+                                  unsigned int  _level,
+                                  T *           _psd)
+{
+    // validate input
+    if (_level >= _q->pyramid_levels) {
+        fprintf(stderr,"error: spwaterfall%s_pyramid_get_psd(), level exceeds number of pyramid levels\n", EXTENSION);
+        return -1;
+    }
+
+    // unroll circular row buffer into output, oldest row first
+    T *          base = _q->pyramid_psd + _level*_q->time*_q->nfft;
+    unsigned int num  = SPWATERFALL(_pyramid_get_num_time)(_q, _level);
+    unsigned int i;
+    for (i=0; i<num; i++) {
+        unsigned int k = (unsigned int)((_q->pyramid_count[_level] - num + i) % _q->time);
+        memmove(_psd + i*_q->nfft, base + k*_q->nfft, _q->nfft*sizeof(T));
+    }
+    return 0;
+}
+
 // set center freuqncy
 int SPWATERFALL(_set_freq)(SPWATERFALL() _q,
                            float         _freq)
@@ -295,12 +413,238 @@ int SPWATERFALL(_export)(SPWATERFALL() _q,
     SPWATERFALL(_export_gnu)(_q, _base);
 }
 
+// binary archive format
+//
+// The archive is append-only and seekable: a 20-byte fixed header
+// followed by fixed-size tiles, one per spectral estimate, so review
+// tools can map the file and jump to any time slice without parsing.
+//
+//  header : magic 'LQSW' (4 bytes), version (uint32), nfft (uint32),
+//           reserved (uint64)
+//  tile   : sample index (uint64), psd min/max [dB] (2 x float),
+//           spectral estimate quantized to 8 bits (nfft x uint8)
+
+// read and validate archive header, returning transform size
+// (or zero on error)
+unsigned int SPWATERFALL(_archive_read_header)(FILE * _fid)
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t nfft;
+    uint64_t reserved;
+    if (fread(magic,    1, 4,                _fid) != 4 ||
+        fread(&version, sizeof(uint32_t), 1, _fid) != 1 ||
+        fread(&nfft,    sizeof(uint32_t), 1, _fid) != 1 ||
+        fread(&reserved,sizeof(uint64_t), 1, _fid) != 1)
+    {
+        return 0;
+    }
+    if (memcmp(magic, "LQSW", 4) != 0 || version != 1 || nfft < 2)
+        return 0;
+    return nfft;
+}
+
+// Open binary archive for appending, writing the fixed header if the
+// file is new; each subsequent spectral estimate is appended as one
+// quantized tile until the archive is stopped
+//  _q        : spwaterfall object
+//  _filename : archive filename
+int SPWATERFALL(_archive_start)(SPWATERFALL() _q,
+                                const char *  _filename)
+{
+    if (_q->archive_fid != NULL) {
+        fprintf(stderr,"error: spwaterfall%s_archive_start(), archive already open\n", EXTENSION);
+        return -1;
+    }
+
+    // open for appending, creating the file if it does not exist
+    FILE * fid = fopen(_filename,"a+b");
+    if (fid == NULL) {
+        fprintf(stderr,"error: spwaterfall%s_archive_start(), could not open '%s' for writing\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+
+    // write header on a new archive; otherwise validate it matches
+    fseek(fid, 0, SEEK_END);
+    if (ftell(fid) == 0) {
+        uint32_t version  = 1;
+        uint32_t nfft     = _q->nfft;
+        uint64_t reserved = 0;
+        fwrite("LQSW",    1, 4,                fid);
+        fwrite(&version,  sizeof(uint32_t), 1, fid);
+        fwrite(&nfft,     sizeof(uint32_t), 1, fid);
+        fwrite(&reserved, sizeof(uint64_t), 1, fid);
+    } else {
+        fseek(fid, 0, SEEK_SET);
+        if (SPWATERFALL(_archive_read_header)(fid) != _q->nfft) {
+            fprintf(stderr,"error: spwaterfall%s_archive_start(), '%s' is not a compatible archive\n",
+                    EXTENSION, _filename);
+            fclose(fid);
+            return -1;
+        }
+        fseek(fid, 0, SEEK_END);
+    }
+
+    _q->archive_fid = fid;
+    return 0;
+}
+
+// Stop archiving spectral estimates and close the archive file
+int SPWATERFALL(_archive_stop)(SPWATERFALL() _q)
+{
+    if (_q->archive_fid == NULL) {
+        fprintf(stderr,"error: spwaterfall%s_archive_stop(), no archive open\n", EXTENSION);
+        return -1;
+    }
+    fclose(_q->archive_fid);
+    _q->archive_fid = NULL;
+    return 0;
+}
+
+// quantize a spectral estimate and append it to the open archive as one tile
+//  _q   : spwaterfall object
+//  _psd : spectral estimate [size: nfft x 1]
+void SPWATERFALL(_archive_append)(SPWATERFALL() _q,
+                                  const T *     _psd)
+{
+    if (_q->archive_fid == NULL)
+        return;
+
+    // compute quantization range from this estimate
+    unsigned int i;
+    float psd_min = _psd[0];
+    float psd_max = _psd[0];
+    for (i=1; i<_q->nfft; i++) {
+        if (_psd[i] < psd_min) psd_min = _psd[i];
+        if (_psd[i] > psd_max) psd_max = _psd[i];
+    }
+
+    // quantize estimate to 8 bits
+    unsigned char tile[_q->nfft];
+    float scale = psd_max > psd_min ? 255.0f / (psd_max - psd_min) : 0.0f;
+    for (i=0; i<_q->nfft; i++) {
+        int v = (int) roundf( (_psd[i] - psd_min) * scale );
+        tile[i] = (unsigned char) (v < 0 ? 0 : (v > 255 ? 255 : v));
+    }
+
+    // append tile: index, range, quantized estimate
+    uint64_t sample_index = SPGRAM(_get_num_samples_total)(_q->periodogram);
+    fwrite(&sample_index, sizeof(uint64_t), 1,        _q->archive_fid);
+    fwrite(&psd_min,      sizeof(float),    1,        _q->archive_fid);
+    fwrite(&psd_max,      sizeof(float),    1,        _q->archive_fid);
+    fwrite(tile,          1,                _q->nfft, _q->archive_fid);
+}
+
+// Get transform size of an existing archive (or -1 on error)
+//  _filename : archive filename
+int SPWATERFALL(_archive_get_nfft)(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"rb");
+    if (fid == NULL) {
+        fprintf(stderr,"error: spwaterfall%s_archive_get_nfft(), could not open '%s' for reading\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+    unsigned int nfft = SPWATERFALL(_archive_read_header)(fid);
+    fclose(fid);
+    if (nfft == 0) {
+        fprintf(stderr,"error: spwaterfall%s_archive_get_nfft(), '%s' is not a valid archive\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+    return (int) nfft;
+}
+
+// Get number of tiles (spectral estimates) in an existing archive
+// (or -1 on error)
+//  _filename : archive filename
+int SPWATERFALL(_archive_get_num_tiles)(const char * _filename)
+{
+    int nfft = SPWATERFALL(_archive_get_nfft)(_filename);
+    if (nfft < 0)
+        return -1;
+
+    FILE * fid = fopen(_filename,"rb");
+    fseek(fid, 0, SEEK_END);
+    long int len = ftell(fid);
+    fclose(fid);
+
+    // tiles follow the 20-byte header; each is 16 bytes plus one byte
+    // per frequency bin
+    return (int) ((len - 20) / (16 + nfft));
+}
+
+// Read a single tile from an existing archive, de-quantizing the
+// spectral estimate into the output buffer
+//  _filename     : archive filename
+//  _index        : tile index, _index < num_tiles
+//  _psd          : output spectral estimate [size: nfft x 1]
+//  _sample_index : output sample index of estimate (ignored if NULL)
+int SPWATERFALL(_archive_read)(const char * _filename,
+                               unsigned int _index,
+                               T *          _psd,
+                               uint64_t *   _sample_index)
+{
+    int num_tiles = SPWATERFALL(_archive_get_num_tiles)(_filename);
+    if (num_tiles < 0) {
+        return -1;
+    } else if (_index >= (unsigned int) num_tiles) {
+        fprintf(stderr,"error: spwaterfall%s_archive_read(), tile index exceeds archive size\n", EXTENSION);
+        return -1;
+    }
+
+    // re-open and seek directly to requested tile
+    FILE * fid = fopen(_filename,"rb");
+    unsigned int nfft = SPWATERFALL(_archive_read_header)(fid);
+    fseek(fid, 20 + (long int)_index*(16 + nfft), SEEK_SET);
+
+    // read tile
+    uint64_t      sample_index;
+    float         psd_min;
+    float         psd_max;
+    unsigned char tile[nfft];
+    if (fread(&sample_index, sizeof(uint64_t), 1,    fid) != 1    ||
+        fread(&psd_min,      sizeof(float),    1,    fid) != 1    ||
+        fread(&psd_max,      sizeof(float),    1,    fid) != 1    ||
+        fread(tile,          1,                nfft, fid) != nfft)
+    {
+        fprintf(stderr,"error: spwaterfall%s_archive_read(), could not read tile %u\n", EXTENSION, _index);
+        fclose(fid);
+        return -1;
+    }
+    fclose(fid);
+
+    // de-quantize estimate
+    unsigned int i;
+    float step = (psd_max - psd_min) / 255.0f;
+    for (i=0; i<nfft; i++)
+        _psd[i] = psd_min + step*(float)tile[i];
+
+    if (_sample_index != NULL)
+        *_sample_index = sample_index;
+    return 0;
+}
+
 // compute spectral periodogram output from current buffer contents
 //  _q : spwaterfall object
 void SPWATERFALL(_step)(SPWATERFALL() _q)
 {
     // determine if we need to extract PSD estimate from periodogram
     if (SPGRAM(_get_num_transforms)(_q->periodogram) >= _q->rollover) {
+        // pyramid mode: write estimate directly into the finest level's
+        // circular row buffer and cascade; the rollover never doubles so
+        // each level retains a fixed, uniform time decimation
+        if (_q->pyramid_enabled) {
+            unsigned int k = (unsigned int)(_q->pyramid_count[0] % _q->time);
+            SPGRAM(_get_psd)(_q->periodogram, _q->pyramid_psd + k*_q->nfft);
+            SPGRAM(_clear)(_q->periodogram);
+            SPWATERFALL(_archive_append)(_q, _q->pyramid_psd + k*_q->nfft);
+            _q->pyramid_count[0]++;
+            SPWATERFALL(_pyramid_update)(_q);
+            return;
+        }
+
         //printf("index : %u\n", _q->index_time);
         // get PSD estimate from periodogram object, placing result in
         // proper location in internal buffer
@@ -309,6 +653,9 @@ void SPWATERFALL(_step)(SPWATERFALL() _q)
         // soft reset of internal state, counters
         SPGRAM(_clear)(_q->periodogram);
 
+        // append estimate to binary archive (if open)
+        SPWATERFALL(_archive_append)(_q, _q->psd + _q->nfft*_q->index_time);
+
         // increment buffer counter
         _q->index_time++;
 
@@ -345,6 +692,38 @@ void SPWATERFALL(_consolidate_buffer)(SPWATERFALL() _q)
     _q->rollover *= 2;
 }
 
+// cascade newly-written pyramid rows to coarser time-decimation levels;
+// each completed pair of rows at level 'l' produces one log-averaged row
+// at level 'l+1', so a new estimate triggers at most two row averages on
+// average (constant amortized cost)
+//  _q : spwaterfall object
+void SPWATERFALL(_pyramid_update)(SPWATERFALL() _q)
+{
+    unsigned int l;
+    for (l=0; l+1 < _q->pyramid_levels; l++) {
+        // stop cascading once the current level has an incomplete pair
+        if (_q->pyramid_count[l] == 0 || _q->pyramid_count[l] % 2)
+            break;
+
+        // locate the two most recent rows at this level and the
+        // destination row at the next
+        T * base = _q->pyramid_psd + l*_q->time*_q->nfft;
+        T * r0   = base + (unsigned int)((_q->pyramid_count[l]-2) % _q->time)*_q->nfft;
+        T * r1   = base + (unsigned int)((_q->pyramid_count[l]-1) % _q->time)*_q->nfft;
+        T * ro   = _q->pyramid_psd + (l+1)*_q->time*_q->nfft +
+                   (unsigned int)(_q->pyramid_count[l+1] % _q->time)*_q->nfft;
+
+        // convert to linear, compute average, convert back to log
+        unsigned int k;
+        for (k=0; k<_q->nfft; k++) {
+            T v0 = powf(10.0f, r0[k]*0.1f);
+            T v1 = powf(10.0f, r1[k]*0.1f);
+            ro[k] = 10.0f*log10f(0.5f*(v0+v1));
+        }
+        _q->pyramid_count[l+1]++;
+    }
+}
+
 // export gnuplot file
 //  _q        : spwaterfall object
 //  _filename : input buffer [size: _n x 1]
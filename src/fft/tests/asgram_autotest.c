@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// test ascii spectrogram (asgram) objects
+
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// validate differential rendering: full/diff consistency, dirty flag,
+// and incremental reconstruction from changed cells
+void autotest_asgramcf_execute_diff()
+{
+    unsigned int nfft        =  48; // transform size
+    unsigned int num_samples = 960; // samples per rendered frame
+    unsigned int i;
+
+    // create two objects processing identical input: one rendered with
+    // the full method, one with the differential method
+    asgramcf q0 = asgramcf_create(nfft);
+    asgramcf q1 = asgramcf_create(nfft);
+
+    char         ascii0 [nfft];     // full render
+    char         ascii1 [nfft];     // differential render
+    char         shadow [nfft];     // reconstruction from changed cells
+    unsigned int changed[nfft];     // indices of changed cells
+    unsigned int num_changed;
+    float        peakval, peakfreq;
+    int          dirty;
+
+    // first frame: render both ways; every cell is reported as changed
+    float complex buf[num_samples];
+    for (i=0; i<num_samples; i++)
+        buf[i] = ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+    asgramcf_write(q0, buf, num_samples);
+    asgramcf_write(q1, buf, num_samples);
+
+    asgramcf_execute(q0, ascii0, &peakval, &peakfreq);
+    dirty = asgramcf_execute_diff(q1, ascii1, changed, &num_changed, &peakval, &peakfreq);
+    CONTEND_EQUALITY( dirty,       1    );
+    CONTEND_EQUALITY( num_changed, nfft );
+    CONTEND_EQUALITY( memcmp(ascii0, ascii1, nfft), 0 );
+    memmove(shadow, ascii1, nfft);
+
+    // no new samples: line is clean and unchanged
+    dirty = asgramcf_execute_diff(q1, ascii1, changed, &num_changed, &peakval, &peakfreq);
+    CONTEND_EQUALITY( dirty,       0 );
+    CONTEND_EQUALITY( num_changed, 0 );
+    CONTEND_EQUALITY( memcmp(shadow, ascii1, nfft), 0 );
+
+    // second frame: applying only the changed cells to the previous
+    // line reconstructs the full render exactly
+    for (i=0; i<num_samples; i++)
+        buf[i] = ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+    asgramcf_write(q0, buf, num_samples);
+    asgramcf_write(q1, buf, num_samples);
+
+    asgramcf_execute(q0, ascii0, &peakval, &peakfreq);
+    dirty = asgramcf_execute_diff(q1, ascii1, changed, &num_changed, &peakval, &peakfreq);
+    CONTEND_EQUALITY( dirty, num_changed > 0 ? 1 : 0 );
+    CONTEND_EQUALITY( memcmp(ascii0, ascii1, nfft), 0 );
+    for (i=0; i<num_changed; i++)
+        shadow[changed[i]] = ascii1[changed[i]];
+    CONTEND_EQUALITY( memcmp(shadow, ascii1, nfft), 0 );
+
+    // destroy objects
+    asgramcf_destroy(q0);
+    asgramcf_destroy(q1);
+}
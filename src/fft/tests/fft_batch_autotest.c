@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test batched execution against individual transforms
+void fft_test_batch(unsigned int _nfft,
+                    unsigned int _batch)
+{
+    unsigned int i;
+    unsigned int k;
+    float tol = 1e-4f * _nfft;
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(_batch*_nfft*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(       _nfft*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_batch*_nfft*sizeof(float complex));
+
+    // initialize random complex input
+    for (i=0; i<_batch*_nfft; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // run batched transforms with a single plan
+    fftplan q = fft_create_plan(_nfft, x, y1, LIQUID_FFT_FORWARD, 0);
+    fft_execute_batch(q, _batch, x, _nfft, y1, _nfft);
+    fft_destroy_plan(q);
+
+    // validate each transform against individual execution
+    for (k=0; k<_batch; k++) {
+        fft_run(_nfft, &x[k*_nfft], y0, LIQUID_FFT_FORWARD, 0);
+        for (i=0; i<_nfft; i++) {
+            CONTEND_DELTA( crealf(y0[i]), crealf(y1[k*_nfft+i]), tol );
+            CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[k*_nfft+i]), tol );
+        }
+    }
+
+    // free memory
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_fft_batch_16()  { fft_test_batch( 16, 4); }
+void autotest_fft_batch_30()  { fft_test_batch( 30, 3); }
+void autotest_fft_batch_64()  { fft_test_batch( 64, 8); }
+void autotest_fft_batch_79()  { fft_test_batch( 79, 2); }
+void autotest_fft_batch_256() { fft_test_batch(256, 5); }
+
+// external backend hooks: count invocations, optionally declining so
+// the built-in implementation runs
+static unsigned int fft_batch_backend_count = 0;
+static int fft_batch_backend_decline(void * _context, int _direction,
+        unsigned int _nfft, unsigned int _batch,
+        liquid_float_complex * _x, unsigned int _x_stride,
+        liquid_float_complex * _y, unsigned int _y_stride)
+{
+    fft_batch_backend_count++;
+    return 1;
+}
+
+// verify backend registration, size threshold, and fall-back on decline
+void autotest_fft_batch_backend()
+{
+    unsigned int nfft  = 64;
+    unsigned int batch =  4;
+    unsigned int i;
+
+    float complex x [batch*nfft];
+    float complex y0[batch*nfft];
+    float complex y1[batch*nfft];
+    for (i=0; i<batch*nfft; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // reference: no backend registered
+    fftplan q = fft_create_plan(nfft, x, y0, LIQUID_FFT_FORWARD, 0);
+    fft_execute_batch(q, batch, x, nfft, y0, nfft);
+
+    // register declining backend with threshold below problem size;
+    // callback must be invoked, and output must match the built-in path
+    liquid_backend backend = {0};
+    backend.fft_execute_batch = fft_batch_backend_decline;
+    backend.fft_threshold     = nfft*batch;
+    liquid_backend_register(&backend);
+
+    fft_batch_backend_count = 0;
+    fft_execute_batch(q, batch, x, nfft, y1, nfft);
+    CONTEND_EQUALITY( fft_batch_backend_count, 1 );
+    CONTEND_SAME_DATA( y0, y1, batch*nfft*sizeof(float complex) );
+
+    // raise threshold above problem size; callback must not be invoked
+    backend.fft_threshold = nfft*batch + 1;
+    liquid_backend_register(&backend);
+    fft_batch_backend_count = 0;
+    fft_execute_batch(q, batch, x, nfft, y1, nfft);
+    CONTEND_EQUALITY( fft_batch_backend_count, 0 );
+
+    // unregister and confirm routing is disabled
+    liquid_backend_register(NULL);
+    fft_batch_backend_count = 0;
+    fft_execute_batch(q, batch, x, nfft, y1, nfft);
+    CONTEND_EQUALITY( fft_batch_backend_count, 0 );
+
+    fft_destroy_plan(q);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test input-pruned transform against a full reference transform of
+// the same sparse input
+void fft_test_pruned(unsigned int _nfft,
+                     unsigned int _num_nonzero,
+                     int          _dir)
+{
+    unsigned int i;
+    float tol = 1e-3f;
+
+    // choose distinct nonzero input indices, roughly evenly spread
+    unsigned int index[_num_nonzero];
+    for (i=0; i<_num_nonzero; i++)
+        index[i] = (i*_nfft) / _num_nonzero;
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_nfft*sizeof(float complex));
+
+    // sparse input: random values on the declared set, zero elsewhere
+    for (i=0; i<_nfft; i++)
+        x[i] = 0.0f;
+    for (i=0; i<_num_nonzero; i++)
+        x[index[i]] = randnf() + _Complex_I*randnf();
+
+    // compute dense reference
+    fft_run(_nfft, x, y0, _dir, 0);
+
+    // compute pruned transform
+    fftplan q = fft_create_plan_pruned(_nfft, x, y1, _dir, index, _num_nonzero, 0);
+    fft_execute(q);
+
+    // validate results
+    for (i=0; i<_nfft; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // values outside the declared index set are ignored
+    for (i=0; i<_nfft; i++) {
+        if (x[i] == 0.0f)
+            x[i] = randnf() + _Complex_I*randnf();
+    }
+    fft_execute(q);
+    for (i=0; i<_nfft; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    fft_destroy_plan(q);
+
+    // free memory
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+// power-of-two transforms, sparse and dense input sets
+void autotest_fft_pruned_64()      { fft_test_pruned(  64,  4, LIQUID_FFT_FORWARD);  }
+void autotest_fft_pruned_256()     { fft_test_pruned( 256, 16, LIQUID_FFT_BACKWARD); }
+void autotest_fft_pruned_1024()    { fft_test_pruned(1024, 52, LIQUID_FFT_BACKWARD); }
+void autotest_fft_pruned_full()    { fft_test_pruned( 128,128, LIQUID_FFT_FORWARD);  }
+
+// composite and odd sizes exercise partial and degenerate
+// factorizations of the sub-transform
+void autotest_fft_pruned_96()      { fft_test_pruned(  96, 20, LIQUID_FFT_FORWARD);  }
+void autotest_fft_pruned_63()      { fft_test_pruned(  63,  5, LIQUID_FFT_BACKWARD); }
+void autotest_fft_pruned_127()     { fft_test_pruned( 127,  7, LIQUID_FFT_FORWARD);  }
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test real-to-complex transform against regular complex transform
+void fft_test_r2c(unsigned int _nfft)
+{
+    unsigned int i;
+    float tol = 1e-4f * _nfft;
+
+    // allocate arrays
+    float *         x  = (float *)         malloc(_nfft*sizeof(float));
+    float complex * xc = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_nfft*sizeof(float complex));
+
+    // initialize random real input
+    for (i=0; i<_nfft; i++) {
+        x[i]  = randnf();
+        xc[i] = x[i];
+    }
+
+    // compute reference with regular complex transform
+    fft_run(_nfft, xc, y0, LIQUID_FFT_FORWARD, 0);
+
+    // compute real-to-complex transform
+    fftplan q = fft_create_plan_r2c(_nfft, x, y1, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+
+    // validate results
+    for (i=0; i<_nfft; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // free memory
+    free(x);
+    free(xc);
+    free(y0);
+    free(y1);
+}
+
+// test complex-to-real round trip: ifft(fft(x)) = nfft * x
+void fft_test_c2r(unsigned int _nfft)
+{
+    unsigned int i;
+    float tol = 1e-4f * _nfft;
+
+    // allocate arrays
+    float *         x = (float *)         malloc(_nfft*sizeof(float));
+    float complex * X = (float complex *) malloc(_nfft*sizeof(float complex));
+    float *         y = (float *)         malloc(_nfft*sizeof(float));
+
+    // initialize random real input
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf();
+
+    // compute forward transform
+    fftplan qf = fft_create_plan_r2c(_nfft, x, X, 0);
+    fft_execute(qf);
+    fft_destroy_plan(qf);
+
+    // compute inverse transform
+    fftplan qr = fft_create_plan_c2r(_nfft, X, y, 0);
+    fft_execute(qr);
+    fft_destroy_plan(qr);
+
+    // validate results (transform is unnormalized)
+    for (i=0; i<_nfft; i++)
+        CONTEND_DELTA( y[i], _nfft*x[i], tol );
+
+    // free memory
+    free(x);
+    free(X);
+    free(y);
+}
+
+// real-to-complex transforms
+void autotest_fft_r2c_2()   { fft_test_r2c(  2); }
+void autotest_fft_r2c_8()   { fft_test_r2c(  8); }
+void autotest_fft_r2c_17()  { fft_test_r2c( 17); }
+void autotest_fft_r2c_30()  { fft_test_r2c( 30); }
+void autotest_fft_r2c_64()  { fft_test_r2c( 64); }
+void autotest_fft_r2c_254() { fft_test_r2c(254); }
+
+// complex-to-real round trips
+void autotest_fft_c2r_2()   { fft_test_c2r(  2); }
+void autotest_fft_c2r_8()   { fft_test_c2r(  8); }
+void autotest_fft_c2r_17()  { fft_test_c2r( 17); }
+void autotest_fft_c2r_30()  { fft_test_c2r( 30); }
+void autotest_fft_c2r_64()  { fft_test_c2r( 64); }
+void autotest_fft_c2r_254() { fft_test_c2r(254); }
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test threaded execution flag against serial reference; the flag must
+// produce bit-for-bit deterministic results and is silently ignored for
+// small plans or builds without pthread support
+void fft_test_threaded(unsigned int _nfft)
+{
+    unsigned int i;
+    float tol = 1e-4f * _nfft;
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_nfft*sizeof(float complex));
+
+    // initialize random complex input
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // compute serial reference
+    fft_run(_nfft, x, y0, LIQUID_FFT_FORWARD, 0);
+
+    // compute transform with threaded flag set
+    fftplan q = fft_create_plan(_nfft, x, y1, LIQUID_FFT_FORWARD, LIQUID_FFT_FLAG_THREADED);
+    fft_execute(q);
+    fft_destroy_plan(q);
+
+    // validate results
+    for (i=0; i<_nfft; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // free memory
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_fft_threaded_9600()  { fft_test_threaded( 9600); }
+void autotest_fft_threaded_12000() { fft_test_threaded(12000); }
@@ -132,6 +132,122 @@ void testbench_spgramcf_signal(unsigned int _nfft, int _wtype, float _fc, float
     nco_crcf_destroy(mixer);
 }
 
+// decimating sub-band monitor: white noise reads at the same level as
+// a full-band estimate over the usable portion of the sub-band
+void autotest_spgramcf_decim_noise()
+{
+    unsigned int nfft        = 400;     // transform size (sub-band resolution)
+    unsigned int decim       = 4;       // decimation factor
+    float        fc          = 0.20f;   // sub-band center frequency
+    float        noise_floor = -80.0f;  // input noise floor [dB]
+    float        nstd        = powf(10.0f, noise_floor/20.0f);
+    float        tol         = 1.0f;    // error tolerance [dB]
+    unsigned int i;
+
+    // create decimating estimator centered on the sub-band
+    spgramcf q = spgramcf_create_decim(nfft, LIQUID_WINDOW_HAMMING,
+            nfft/2, decim*nfft/4, fc, decim);
+
+    unsigned int num_samples = 400*nfft*decim;
+    for (i=0; i<num_samples; i++)
+        spgramcf_push(q, nstd*( randnf() + _Complex_I*randnf() ) * M_SQRT1_2);
+
+    // compute power spectral density output
+    float psd[nfft];
+    spgramcf_get_psd(q, psd);
+
+    // verify level over the inner portion of the sub-band (the
+    // anti-alias filter transition bands roll off near the edges)
+    for (i=nfft/5; i<4*nfft/5; i++)
+        CONTEND_DELTA(psd[i], noise_floor, tol)
+
+    spgramcf_destroy(q);
+}
+
+// decimating sub-band monitor: a tone offset from the sub-band center
+// lands on the expected bin of the zoomed spectrum
+void autotest_spgramcf_decim_tone()
+{
+    unsigned int nfft  =  600;      // transform size (sub-band resolution)
+    unsigned int decim =    5;      // decimation factor
+    float        fc    = -0.15f;    // sub-band center frequency
+    float        nu    = 0.125f;    // tone offset within decimated band
+    float        nstd  = 1e-4f;     // noise standard deviation
+    unsigned int i;
+
+    // create decimating estimator centered on the sub-band
+    spgramcf q = spgramcf_create_decim(nfft, LIQUID_WINDOW_HAMMING,
+            nfft/2, decim*nfft/4, fc, decim);
+
+    // generate tone at raw frequency fc + nu/decim and push
+    unsigned int num_samples = 200*nfft*decim;
+    double f0   = (double)fc + (double)nu/(double)decim;
+    double dphi = 2.0*M_PI*f0;
+    double phi  = 0.0;
+    for (i=0; i<num_samples; i++) {
+        float complex v = cexpf(_Complex_I*(float)phi)
+                        + nstd*( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+        spgramcf_push(q, v);
+        phi = fmod(phi + dphi, 2.0*M_PI);
+    }
+
+    // compute power spectral density output
+    float psd[nfft];
+    spgramcf_get_psd(q, psd);
+
+    // locate peak and compare to expected bin
+    unsigned int i0 = ((unsigned int)roundf((nu+0.5f)*nfft)) % nfft;
+    unsigned int imax = 0;
+    for (i=0; i<nfft; i++)
+        imax = psd[i] > psd[imax] ? i : imax;
+    CONTEND_EQUALITY(imax, i0);
+
+    // peak stands well above the noise floor
+    CONTEND_GREATER_THAN( psd[i0], psd[(i0 + nfft/2) % nfft] + 30.0f );
+
+    spgramcf_destroy(q);
+}
+
+// window tables are shared across instances with identical parameters;
+// verify estimates match regardless of sharing and that tables survive
+// destruction of sibling instances in any order
+void autotest_spgramcf_shared_window()
+{
+    unsigned int nfft = 512;
+    unsigned int i;
+
+    // bank of identically-configured estimators sharing one window table
+    spgramcf q0 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, nfft/2, nfft/4);
+    spgramcf q1 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, nfft/2, nfft/4);
+    spgramcf q2 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, nfft/2, nfft/4);
+
+    // destroy one instance up front; the remaining instances must still
+    // hold valid tables
+    spgramcf_destroy(q0);
+
+    // push the same noise sequence through both remaining instances
+    unsigned int num_samples = 40*nfft;
+    for (i=0; i<num_samples; i++) {
+        float complex v = ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+        spgramcf_push(q1, v);
+        spgramcf_push(q2, v);
+    }
+
+    // estimates are identical
+    float psd_1[nfft];
+    float psd_2[nfft];
+    spgramcf_get_psd(q1, psd_1);
+    spgramcf_get_psd(q2, psd_2);
+    CONTEND_SAME_DATA(psd_1, psd_2, nfft*sizeof(float));
+
+    spgramcf_destroy(q1);
+    spgramcf_destroy(q2);
+
+    // re-creating after the last reference is dropped rebuilds the
+    // tables and still produces a properly-normalized estimate
+    testbench_spgramcf_noise(nfft, LIQUID_WINDOW_HAMMING, -80.0f);
+}
+
 void autotest_spgramcf_signal_00() { testbench_spgramcf_signal(800,LIQUID_WINDOW_HAMMING, 0.0f,30.0f); }
 void autotest_spgramcf_signal_01() { testbench_spgramcf_signal(800,LIQUID_WINDOW_HAMMING, 0.2f,10.0f); }
 void autotest_spgramcf_signal_02() { testbench_spgramcf_signal(800,LIQUID_WINDOW_HANN,    0.2f,10.0f); }
@@ -246,3 +362,178 @@ void autotest_spgramcf_standalone()
     free(buf);
 }
 
+
+// verify the block-write fast path produces the same accumulated
+// spectrum as pushing samples individually
+void autotest_spgramcf_write_equivalence()
+{
+    unsigned int i;
+    unsigned int nfft        =  400;
+    unsigned int num_samples = 2771;    // odd length to exercise segmentation
+    float        tol         = 1e-6f;
+
+    // create two identical spectral periodogram objects
+    spgramcf q0 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, 257, 101);
+    spgramcf q1 = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, 257, 101);
+
+    // generate noise buffer
+    float complex buf[num_samples];
+    for (i=0; i<num_samples; i++)
+        buf[i] = (randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    // push samples individually / write whole buffer
+    for (i=0; i<num_samples; i++)
+        spgramcf_push(q0, buf[i]);
+    spgramcf_write(q1, buf, num_samples);
+
+    // verify matching internal state
+    CONTEND_EQUALITY( spgramcf_get_num_samples   (q0), spgramcf_get_num_samples   (q1) );
+    CONTEND_EQUALITY( spgramcf_get_num_transforms(q0), spgramcf_get_num_transforms(q1) );
+
+    // verify matching spectral output
+    float psd_0[nfft];
+    float psd_1[nfft];
+    spgramcf_get_psd(q0, psd_0);
+    spgramcf_get_psd(q1, psd_1);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA( psd_0[i], psd_1[i], tol );
+
+    // destroy objects
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+}
+
+// test epoch counter and incremental PSD query: conversion runs only
+// when the accumulated spectrum has changed
+void autotest_spgramcf_psd_delta()
+{
+    unsigned int nfft  = 512;   // transform size
+    unsigned int delay = 128;   // samples between transforms
+    unsigned int i;
+
+    // create spectral periodogram
+    spgramcf q = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, nfft/2, delay);
+
+    // no accumulation yet: polling with the current epoch is a no-op
+    unsigned long long int epoch = spgramcf_get_epoch(q);
+    float psd[nfft];
+    CONTEND_EQUALITY( spgramcf_get_psd_delta(q, &epoch, psd), 0 );
+
+    // push exactly enough samples for a single transform
+    for (i=0; i<delay; i++)
+        spgramcf_push(q, 0.1f*(randnf() + _Complex_I*randnf()));
+
+    // spectrum changed: first poll converts, second skips
+    CONTEND_EQUALITY( spgramcf_get_psd_delta(q, &epoch, psd), 1 );
+    CONTEND_EQUALITY( epoch, spgramcf_get_epoch(q) );
+    CONTEND_EQUALITY( spgramcf_get_psd_delta(q, &epoch, psd), 0 );
+
+    // converted output matches the full query
+    float psd_full[nfft];
+    spgramcf_get_psd(q, psd_full);
+    CONTEND_SAME_DATA( psd, psd_full, nfft*sizeof(float) );
+
+    // pushing fewer samples than the transform delay leaves the
+    // spectrum (and epoch) unchanged
+    for (i=0; i<delay-1; i++)
+        spgramcf_push(q, 0.1f*(randnf() + _Complex_I*randnf()));
+    CONTEND_EQUALITY( spgramcf_get_psd_delta(q, &epoch, psd), 0 );
+
+    // reset changes the accumulated spectrum and bumps the epoch
+    spgramcf_reset(q);
+    CONTEND_EQUALITY( spgramcf_get_psd_delta(q, &epoch, psd), 1 );
+
+    spgramcf_destroy(q);
+}
+
+// distributed accumulation: merging exported partial accumulations is
+// exactly equivalent to processing all samples on a single instance
+void autotest_spgramcf_accum_merge()
+{
+    unsigned int nfft        = 400;     // transform size
+    unsigned int delay       = nfft/2;  // samples between transforms
+    unsigned int num_samples = 20*nfft; // samples per partial estimate
+    unsigned int i;
+
+    // create three periodograms in accumulation mode: two partials and
+    // one reference fed the combined stream; the window length matches
+    // the delay so transforms do not overlap and splitting the stream
+    // across instances is exactly equivalent
+    spgramcf q0  = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, delay, delay);
+    spgramcf q1  = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, delay, delay);
+    spgramcf ref = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, delay, delay);
+    spgramcf_set_alpha(q0,  -1.0f);
+    spgramcf_set_alpha(q1,  -1.0f);
+    spgramcf_set_alpha(ref, -1.0f);
+
+    // process two independent noise streams
+    for (i=0; i<num_samples; i++) {
+        float complex v = 0.1f*(randnf() + _Complex_I*randnf());
+        spgramcf_push(q0,  v);
+        spgramcf_push(ref, v);
+    }
+    for (i=0; i<num_samples; i++) {
+        float complex v = 0.1f*(randnf() + _Complex_I*randnf());
+        spgramcf_push(q1,  v);
+        spgramcf_push(ref, v);
+    }
+
+    // export partial state from q1 and merge into q0
+    unsigned int buf_len = spgramcf_get_accum_size(q1);
+    CONTEND_EQUALITY( buf_len, 28 + nfft*sizeof(float) );
+    unsigned char * buf = (unsigned char*) malloc(buf_len);
+    CONTEND_EQUALITY( spgramcf_export_accum(q1, buf, buf_len), 0 );
+    unsigned long long int epoch = spgramcf_get_epoch(q0);
+    CONTEND_EQUALITY( spgramcf_import_merge(q0, buf, buf_len), 0 );
+    CONTEND_LESS_THAN( epoch, spgramcf_get_epoch(q0) );
+
+    // merged counters match the reference
+    CONTEND_EQUALITY( spgramcf_get_num_samples(q0),    spgramcf_get_num_samples(ref)    );
+    CONTEND_EQUALITY( spgramcf_get_num_transforms(q0), spgramcf_get_num_transforms(ref) );
+
+    // merged spectrum matches the single-instance estimate; the partial
+    // sums accumulate in a different order so allow for rounding in the
+    // last bits
+    float psd_merged[nfft];
+    float psd_ref[nfft];
+    spgramcf_get_psd(q0,  psd_merged);
+    spgramcf_get_psd(ref, psd_ref);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA( psd_merged[i], psd_ref[i], 1e-3f );
+
+    free(buf);
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+    spgramcf_destroy(ref);
+}
+
+// invalid configurations for accumulation export/merge
+void autotest_spgramcf_accum_errors()
+{
+    fprintf(stderr,"warning: ignore potential warnings here; checking for invalid configurations\n");
+    unsigned int nfft = 200;
+    spgramcf q = spgramcf_create_default(nfft);
+    unsigned int buf_len = spgramcf_get_accum_size(q);
+    unsigned char * buf = (unsigned char*) malloc(buf_len);
+
+    // averaging mode: export and merge both fail
+    spgramcf_set_alpha(q, 0.1f);
+    CONTEND_EQUALITY( spgramcf_export_accum(q, buf, buf_len), -1 );
+    CONTEND_EQUALITY( spgramcf_import_merge(q, buf, buf_len), -1 );
+
+    // accumulation mode: buffer length is validated
+    spgramcf_set_alpha(q, -1.0f);
+    CONTEND_EQUALITY( spgramcf_export_accum(q, buf, buf_len-1), -1 );
+    CONTEND_EQUALITY( spgramcf_import_merge(q, buf, buf_len-1), -1 );
+    CONTEND_EQUALITY( spgramcf_export_accum(q, buf, buf_len  ),  0 );
+
+    // configuration mismatch is rejected on merge
+    spgramcf p = spgramcf_create(nfft, LIQUID_WINDOW_HANN, nfft/2, nfft/4);
+    spgramcf_set_alpha(p, -1.0f);
+    CONTEND_EQUALITY( spgramcf_get_accum_size(p), buf_len );
+    CONTEND_EQUALITY( spgramcf_import_merge(p, buf, buf_len), -1 );
+
+    free(buf);
+    spgramcf_destroy(q);
+    spgramcf_destroy(p);
+}
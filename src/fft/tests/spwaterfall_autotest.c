@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// test spectral periodogram waterfall (spwaterfall) objects
+
+#include <math.h>
+#include <stdio.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// validate incremental multi-resolution pyramid mode: level counts,
+// pairwise log-average cascade, and circular buffer unrolling
+void autotest_spwaterfallcf_pyramid()
+{
+    float        tol        = 1e-4f; // error tolerance [dB]
+    unsigned int nfft       =    64; // transform size
+    unsigned int delay      =    32; // samples between transforms
+    unsigned int time       =    32; // rows retained per pyramid level
+    unsigned int num_levels =     3; // pyramid levels
+    unsigned int num_rows   =    40; // level-0 rows to generate (exceeds
+                                     // 'time' to exercise ring wrapping)
+    unsigned int i;
+    unsigned int k;
+
+    // create object and enable pyramid mode
+    spwaterfallcf q = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, nfft, delay, time);
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_enable(q, num_levels), 0 );
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_num_levels(q), num_levels );
+
+    // push noise; one transform (hence one level-0 row) every 'delay' samples
+    for (i=0; i<num_rows*delay; i++)
+        spwaterfallcf_push(q, ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2);
+
+    // verify row counts: level 0 saturates at 'time'; coarser levels
+    // hold one row per completed pair at the level below
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_num_time(q, 0), time       );
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_num_time(q, 1), num_rows/2 );
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_num_time(q, 2), num_rows/4 );
+
+    // extract levels (rows in chronological order, oldest first)
+    float psd0[time*nfft];
+    float psd1[time*nfft];
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_psd(q, 0, psd0), 0 );
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_psd(q, 1, psd1), 0 );
+
+    // level 0 retains rows (num_rows-time)..(num_rows-1); verify each
+    // fully-retained pair log-averages to the corresponding level-1 row
+    unsigned int offset = num_rows - time; // oldest retained level-0 row
+    for (i=0; i<num_rows/2; i++) {
+        if (2*i < offset)
+            continue; // source pair no longer retained at level 0
+        for (k=0; k<nfft; k++) {
+            float v0 = powf(10.0f, psd0[(2*i  -offset)*nfft + k]*0.1f);
+            float v1 = powf(10.0f, psd0[(2*i+1-offset)*nfft + k]*0.1f);
+            CONTEND_DELTA( psd1[i*nfft + k], 10.0f*log10f(0.5f*(v0+v1)), tol );
+        }
+    }
+
+    // querying an invalid level fails
+    CONTEND_EQUALITY( spwaterfallcf_pyramid_get_num_time(q, num_levels), 0 );
+
+    // destroy object
+    spwaterfallcf_destroy(q);
+}
+
+// validate binary archive: tile count, seekable reads, and quantization
+// round trip against internal buffer contents
+void autotest_spwaterfallcf_archive()
+{
+    unsigned int nfft     =   64;   // transform size
+    unsigned int delay    =   32;   // samples between transforms
+    unsigned int time     =   32;   // time buffer
+    unsigned int num_rows =   16;   // spectral estimates to archive
+    const char * filename = "autotest_spwaterfallcf_archive.lqsw";
+    unsigned int i;
+    unsigned int k;
+
+    // start from a fresh archive file
+    remove(filename);
+
+    // create object, open archive, and push noise (one estimate appended
+    // every 'delay' samples; buffer never consolidates so internal rows
+    // match archived tiles one-to-one)
+    spwaterfallcf q = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, nfft, delay, time);
+    CONTEND_EQUALITY( spwaterfallcf_archive_start(q, filename), 0 );
+    for (i=0; i<num_rows*delay; i++)
+        spwaterfallcf_push(q, ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2);
+    CONTEND_EQUALITY( spwaterfallcf_archive_stop(q), 0 );
+
+    // validate archive dimensions
+    CONTEND_EQUALITY( spwaterfallcf_archive_get_nfft     (filename), nfft     );
+    CONTEND_EQUALITY( spwaterfallcf_archive_get_num_tiles(filename), num_rows );
+    CONTEND_EQUALITY( spwaterfallcf_get_num_time(q),                 num_rows );
+
+    // read back each tile and compare to the internal buffer row within
+    // the 8-bit quantization step for that tile's dynamic range
+    const float * psd = spwaterfallcf_get_psd(q);
+    float         tile[nfft];
+    uint64_t      sample_index;
+    uint64_t      sample_index_prev = 0;
+    for (i=0; i<num_rows; i++) {
+        CONTEND_EQUALITY( spwaterfallcf_archive_read(filename, i, tile, &sample_index), 0 );
+
+        // sample indices are strictly increasing
+        CONTEND_EXPRESSION( sample_index > sample_index_prev );
+        sample_index_prev = sample_index;
+
+        // compute row dynamic range for quantization tolerance
+        const float * row = psd + i*nfft;
+        float row_min = row[0];
+        float row_max = row[0];
+        for (k=1; k<nfft; k++) {
+            if (row[k] < row_min) row_min = row[k];
+            if (row[k] > row_max) row_max = row[k];
+        }
+        float tol = 0.5f*(row_max - row_min)/255.0f + 1e-3f;
+        for (k=0; k<nfft; k++)
+            CONTEND_DELTA( tile[k], row[k], tol );
+    }
+
+    // reading past the end fails
+    CONTEND_EQUALITY( spwaterfallcf_archive_read(filename, num_rows, tile, NULL), -1 );
+
+    // destroy object and remove archive file
+    spwaterfallcf_destroy(q);
+    remove(filename);
+}
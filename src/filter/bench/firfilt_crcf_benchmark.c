@@ -22,6 +22,7 @@
 
 #include <sys/resource.h>
 #include "liquid.h"
+#include "bench/liquid_benchmark.h"
 
 // Helper function to keep code base small
 void firfilt_crcf_bench(struct rusage *_start,
@@ -62,6 +63,13 @@ void firfilt_crcf_bench(struct rusage *_start,
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
 
+    // roofline workload annotation (per push/execute): traverse window
+    // and real coefficients, write one output; two real multiply-adds
+    // per coefficient
+    liquid_benchmark_workload.bytes_per_trial =
+        _n*sizeof(float complex) + _n*sizeof(float) + 2*sizeof(float complex);
+    liquid_benchmark_workload.flops_per_trial = 4.0f * _n;
+
     firfilt_crcf_destroy(f);
 }
 
@@ -38,6 +38,11 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// minimum number of lags for which the multi-lag engine computes all
+// outputs with transforms (Wiener-Khinchin) rather than one dot
+// product per lag
+#define LIQUID_AUTOCORR_FFT_THRESHOLD (32)
+
 struct AUTOCORR(_s) {
     unsigned int window_size;
     unsigned int delay;
@@ -48,6 +53,19 @@ struct AUTOCORR(_s) {
     float * we2;        // energy buffer
     float e2_sum;       // running sum of energy
     unsigned int ie2;   // read index
+
+    // multi-lag engine (NULL/zero for single-lag objects): all lags in
+    // [0,num_lags) are computed from the same buffer, with transforms
+    // when the lag count crosses the threshold above
+    unsigned int    num_lags;   // number of lags, 0 for single-lag object
+    unsigned int    nfft;       // transform size (FFT engine only)
+    float complex * buf_time_0; // transform input buffer
+    float complex * buf_freq_0; // spectrum of recent samples
+    float complex * buf_freq_1; // spectrum of full buffer
+    float complex * buf_time_1; // correlation output buffer
+    FFT_PLAN        fft_0;      // forward transform: buf_time_0 > buf_freq_0
+    FFT_PLAN        fft_1;      // forward transform: buf_time_0 > buf_freq_1
+    FFT_PLAN        ifft;       // inverse transform: buf_freq_1 > buf_time_1
 };
 
 // create auto-correlator object                            
@@ -70,6 +88,73 @@ AUTOCORR() AUTOCORR(_create)(unsigned int _window_size,
     // allocate array for squared energy buffer
     q->we2 = (float*) malloc( (q->window_size)*sizeof(float) );
 
+    // single-lag object: no multi-lag engine
+    q->num_lags   = 0;
+    q->buf_time_0 = NULL;
+    q->buf_freq_0 = NULL;
+    q->buf_freq_1 = NULL;
+    q->buf_time_1 = NULL;
+
+    // clear object
+    AUTOCORR(_reset)(q);
+
+    // return main object
+    return q;
+}
+
+// create multi-lag auto-correlator object computing all lags in
+// [0,_num_lags) from a single buffer; above a lag-count threshold the
+// outputs are computed together with transforms (Wiener-Khinchin)
+// rather than one dot product per lag
+//  _window_size    : size of the correlator window
+//  _num_lags       : number of lags to compute, _num_lags > 0
+AUTOCORR() AUTOCORR(_create_multi)(unsigned int _window_size,
+                                   unsigned int _num_lags)
+{
+    // validate input
+    if (_num_lags == 0) {
+        fprintf(stderr,"error: autocorr_%s_create_multi(), number of lags must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create main object
+    AUTOCORR() q = (AUTOCORR()) malloc(sizeof(struct AUTOCORR(_s)));
+
+    // set user-based parameters
+    q->window_size = _window_size;
+    q->delay       = 0;
+    q->num_lags    = _num_lags;
+
+    // create window objects; the largest lag reaches num_lags-1
+    // samples beyond the correlation window
+    unsigned int n = q->window_size + q->num_lags - 1;
+    q->w      = WINDOW(_create)(n);
+    q->wdelay = WINDOW(_create)(n);
+
+    // allocate array for squared energy buffer
+    q->we2 = (float*) malloc( (q->window_size)*sizeof(float) );
+
+    if (q->num_lags >= LIQUID_AUTOCORR_FFT_THRESHOLD) {
+        // create transform buffers and plans; size avoids circular
+        // wrap-around over all computed lags
+        q->nfft = 1;
+        while (q->nfft < n + q->window_size)
+            q->nfft <<= 1;
+        q->buf_time_0 = (float complex*) malloc((q->nfft)*sizeof(float complex));
+        q->buf_freq_0 = (float complex*) malloc((q->nfft)*sizeof(float complex));
+        q->buf_freq_1 = (float complex*) malloc((q->nfft)*sizeof(float complex));
+        q->buf_time_1 = (float complex*) malloc((q->nfft)*sizeof(float complex));
+        q->fft_0 = FFT_CREATE_PLAN(q->nfft, q->buf_time_0, q->buf_freq_0, FFT_DIR_FORWARD,  FFT_METHOD);
+        q->fft_1 = FFT_CREATE_PLAN(q->nfft, q->buf_time_0, q->buf_freq_1, FFT_DIR_FORWARD,  FFT_METHOD);
+        q->ifft  = FFT_CREATE_PLAN(q->nfft, q->buf_freq_1, q->buf_time_1, FFT_DIR_BACKWARD, FFT_METHOD);
+    } else {
+        q->nfft       = 0;
+        q->buf_time_0 = NULL;
+        q->buf_freq_0 = NULL;
+        q->buf_freq_1 = NULL;
+        q->buf_time_1 = NULL;
+    }
+
     // clear object
     AUTOCORR(_reset)(q);
 
@@ -87,6 +172,17 @@ void AUTOCORR(_destroy)(AUTOCORR() _q)
     // free array for squared energy buffer
     free(_q->we2);
 
+    // free multi-lag transform objects
+    if (_q->buf_time_0 != NULL) {
+        FFT_DESTROY_PLAN(_q->fft_0);
+        FFT_DESTROY_PLAN(_q->fft_1);
+        FFT_DESTROY_PLAN(_q->ifft);
+        free(_q->buf_time_0);
+        free(_q->buf_freq_0);
+        free(_q->buf_freq_1);
+        free(_q->buf_time_1);
+    }
+
     // free main object memory
     free(_q);
 }
@@ -109,7 +205,13 @@ void AUTOCORR(_reset)(AUTOCORR() _q)
 // print auto-correlator parameters to stdout
 void AUTOCORR(_print)(AUTOCORR() _q)
 {
-    printf("autocorr [%u window, %u delay]\n", _q->window_size, _q->delay);
+    if (_q->num_lags > 0) {
+        printf("autocorr [%u window, %u lags, %s engine]\n",
+            _q->window_size, _q->num_lags,
+            _q->buf_time_0 == NULL ? "dotprod" : "fft");
+    } else {
+        printf("autocorr [%u window, %u delay]\n", _q->window_size, _q->delay);
+    }
 }
 
 // push sample into auto-correlator object
@@ -156,6 +258,66 @@ void AUTOCORR(_execute)(AUTOCORR() _q, TO *_rxx)
     DOTPROD(_run4)(rw, rwdelay, _q->window_size, _rxx);
 }
 
+// compute auto-correlation output at all lags in [0,num_lags) of a
+// multi-lag object; above the lag-count threshold all outputs are
+// computed together with three transforms, otherwise with one dot
+// product per lag
+//  _q      :   multi-lag auto-correlation object
+//  _rxx    :   output array, [size: num_lags x 1]
+void AUTOCORR(_execute_multi)(AUTOCORR() _q,
+                              TO *       _rxx)
+{
+    // validate object type
+    if (_q->num_lags == 0) {
+        fprintf(stderr,"error: autocorr_%s_execute_multi(), object was not created with create_multi()\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int L = _q->num_lags;
+    unsigned int W = _q->window_size;
+    unsigned int n = W + L - 1;
+
+    // provide pointers for reading buffers (oldest sample first)
+    TI * rw;        // input buffer read pointer
+    TC * rwdelay;   // conjugated input buffer read pointer
+
+    WINDOW(_read)(_q->w,      &rw     );
+    WINDOW(_read)(_q->wdelay, &rwdelay);
+
+    if (_q->buf_time_0 == NULL) {
+        // direct engine: one dot product per lag; lag l correlates the
+        // most recent W samples against the buffer delayed by l
+        for (i=0; i<L; i++)
+            DOTPROD(_run4)(rw + L-1, rwdelay + L-1-i, W, &_rxx[i]);
+        return;
+    }
+
+    // transform engine (Wiener-Khinchin): cross-correlate the most
+    // recent W samples against the full buffer in the frequency domain
+
+    // transform most recent W samples, zero-padded
+    for (i=0; i<_q->nfft; i++)
+        _q->buf_time_0[i] = i < W ? rw[L-1+i] : 0.0f;
+    FFT_EXECUTE(_q->fft_0);
+
+    // transform full buffer, zero-padded
+    for (i=0; i<_q->nfft; i++)
+        _q->buf_time_0[i] = i < n ? rw[i] : 0.0f;
+    FFT_EXECUTE(_q->fft_1);
+
+    // cross-multiply (conjugate product) with inverse transform scaling
+    float g = 1.0f / (float)(_q->nfft);
+    for (i=0; i<_q->nfft; i++)
+        _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->buf_freq_1[i]) * g;
+
+    // inverse transform and extract lags (negative correlation indices
+    // wrap around the end of the transform)
+    FFT_EXECUTE(_q->ifft);
+    for (i=0; i<L; i++)
+        _rxx[i] = _q->buf_time_1[(_q->nfft + i - (L-1)) % _q->nfft];
+}
+
 // compute auto-correlation on block of samples; the input
 // and output arrays may have the same pointer
 //  _q      :   auto-correlation object
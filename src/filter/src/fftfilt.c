@@ -50,6 +50,12 @@ struct FFTFILT(_s) {
     float complex * H;          // FFT of filter coefficients [size: 2*n x 1]
     float complex * w;          // overlap array [size: n x 1]
 
+    // scratch for batched multi-block execution (grow-only, allocated
+    // on first use) [size: batch_cap*2*n x 1 each]
+    float complex * batch_time; // time-domain blocks, zero-padded
+    float complex * batch_freq; // frequency-domain blocks
+    unsigned int    batch_cap;  // scratch capacity [blocks]
+
     // FFT objects
 #ifdef LIQUID_FFTOVERRIDE
     fftplan fft;        // FFT object (forward)
@@ -97,6 +103,11 @@ FFTFILT() FFTFILT(_create)(TC *         _h,
     q->H        = (float complex *) malloc((2*q->n)* sizeof(float complex)); // FFT{ h }
     q->w        = (float complex *) malloc((  q->n)* sizeof(float complex)); // delay buffer
 
+    // batched scratch allocated on first multi-block call
+    q->batch_time = NULL;
+    q->batch_freq = NULL;
+    q->batch_cap  = 0;
+
     // create internal FFT objects
 #ifdef LIQUID_FFTOVERRIDE
     q->fft  = fft_create_plan(2*q->n, q->time_buf, q->freq_buf, LIQUID_FFT_FORWARD,  0);
@@ -137,6 +148,8 @@ void FFTFILT(_destroy)(FFTFILT() _q)
     free(_q->freq_buf);         // buffer (frequency domain)
     free(_q->H);                // frequency response of filter coefficients
     free(_q->w);                // output window buffer
+    free(_q->batch_time);       // batched scratch (time domain)
+    free(_q->batch_freq);       // batched scratch (frequency domain)
 
     // destroy FFT objects
 #ifdef LIQUID_FFTOVERRIDE
@@ -267,6 +280,92 @@ void FFTFILT(_execute)(FFTFILT() _q,
     memmove(_q->w, &_q->time_buf[_q->n], _q->n*sizeof(float complex));
 }
 
+// execute the filter on several contiguous blocks of input samples in a
+// single call; all blocks are transformed with a batched FFT against the
+// persistent filter spectrum before a sequential overlap-add pass, which
+// amortizes per-call overhead and produces output identical to calling
+// _execute() once per block
+//  _q          : filter object
+//  _x          : pointer to input data array  [size: _n*_num_blocks x 1]
+//  _num_blocks : number of blocks of _n samples to process
+//  _y          : pointer to output data array [size: _n*_num_blocks x 1]
+void FFTFILT(_execute_block)(FFTFILT()    _q,
+                             TI *         _x,
+                             unsigned int _num_blocks,
+                             TO *         _y)
+{
+    // single block: run directly on internal buffers
+    if (_num_blocks == 0) {
+        return;
+    } else if (_num_blocks == 1) {
+        FFTFILT(_execute)(_q, _x, _y);
+        return;
+    }
+
+    // grow scratch arrays to hold all padded blocks
+    if (_num_blocks > _q->batch_cap) {
+        _q->batch_cap  = _num_blocks;
+        _q->batch_time = (float complex *) realloc(_q->batch_time,
+                (_q->batch_cap)*2*(_q->n)*sizeof(float complex));
+        _q->batch_freq = (float complex *) realloc(_q->batch_freq,
+                (_q->batch_cap)*2*(_q->n)*sizeof(float complex));
+    }
+
+    // pack input blocks, zero-padding the second half of each
+    unsigned int b;
+    unsigned int i;
+    for (b=0; b<_num_blocks; b++) {
+        float complex * t = &_q->batch_time[b*2*_q->n];
+        for (i=0; i<_q->n; i++)
+            t[i] = _x[b*_q->n + i];
+        for (i=0; i<_q->n; i++)
+            t[_q->n + i] = 0;
+    }
+
+    // run batched forward transform
+#ifdef LIQUID_FFTOVERRIDE
+    fft_execute_batch(_q->fft, _num_blocks,
+            _q->batch_time, 2*_q->n, _q->batch_freq, 2*_q->n);
+#else
+    FFT_EXECUTE_BATCH(_q->fft, _num_blocks,
+            _q->batch_time, 2*_q->n, _q->batch_freq, 2*_q->n);
+#endif
+
+    // multiply all blocks by the persistent filter spectrum
+    for (b=0; b<_num_blocks; b++) {
+        float complex * f = &_q->batch_freq[b*2*_q->n];
+        for (i=0; i<2*_q->n; i++)
+            f[i] *= _q->H[i];
+    }
+
+    // run batched inverse transform
+#ifdef LIQUID_FFTOVERRIDE
+    fft_execute_batch(_q->ifft, _num_blocks,
+            _q->batch_freq, 2*_q->n, _q->batch_time, 2*_q->n);
+#else
+    FFT_EXECUTE_BATCH(_q->ifft, _num_blocks,
+            _q->batch_freq, 2*_q->n, _q->batch_time, 2*_q->n);
+#endif
+
+    // sequential overlap-add pass across blocks
+    for (b=0; b<_num_blocks; b++) {
+        float complex * t = &_q->batch_time[b*2*_q->n];
+
+        // copy output summed with overlap buffer and scaled
+#if TI_COMPLEX
+        for (i=0; i<_q->n; i++)
+            _y[b*_q->n + i] = (t[i] + _q->w[i]) * _q->scale;
+#else
+        // manual copy for type conversion
+        for (i=0; i<_q->n; i++)
+            _y[b*_q->n + i] = (T) crealf(t[i] + _q->w[i]) * _q->scale;
+#endif
+
+        // copy buffer
+        memmove(_q->w, &t[_q->n], _q->n*sizeof(float complex));
+    }
+}
+
 // return length of filter object's internal coefficients
 unsigned int FFTFILT(_get_length)(FFTFILT() _q)
 {
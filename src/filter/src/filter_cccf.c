@@ -46,14 +46,17 @@
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_cccf,name)
 // ordfilt
 #define RRESAMP(name)       LIQUID_CONCAT(rresamp_cccf,name)
+#define RRESAMPBANK(name)  LIQUID_CONCAT(rresampbank_cccf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_cccf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_cccf,name)
+#define SFIRFILT(name)      LIQUID_CONCAT(sfirfilt_cccf,name)
 //#define SYMSYNC(name)       LIQUID_CONCAT(symsync_cccf,name)
 
 #define T                   float complex   // general
 #define TO                  float complex   // output
 #define TC                  float complex   // coefficients
 #define TI                  float complex   // input
+#define TW                  double complex // wide internal state
 #define WINDOW(name)        LIQUID_CONCAT(windowcf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_cccf,name)
 #define POLY(name)          LIQUID_CONCAT(polyf,name)
@@ -82,7 +85,9 @@
 #include "msresamp.c"
 #include "msresamp2.c"
 #include "rresamp.c"
+#include "rresampbank.c"
 //#include "resamp.c"         // floating-point phase version
 #include "resamp.fixed.c" // fixed-point phase version
 #include "resamp2.c"
+#include "sfirfilt.c"
 //#include "symsync.c"
@@ -45,15 +45,19 @@
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_crcf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_crcf,name)
 // ordfilt
+#define QFIRFILT(name)      LIQUID_CONCAT(qfirfilt_crcf,name)
 #define RRESAMP(name)       LIQUID_CONCAT(rresamp_crcf,name)
+#define RRESAMPBANK(name)  LIQUID_CONCAT(rresampbank_crcf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_crcf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_crcf,name)
+#define SFIRFILT(name)      LIQUID_CONCAT(sfirfilt_crcf,name)
 #define SYMSYNC(name)       LIQUID_CONCAT(symsync_crcf,name)
 
 #define T                   float complex   // general
 #define TO                  float complex   // output
 #define TC                  float           // coefficients
 #define TI                  float complex   // input
+#define TW                  double complex // wide internal state
 #define WINDOW(name)        LIQUID_CONCAT(windowcf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_crcf,name)
 #define POLY(name)          LIQUID_CONCAT(polyf,name)
@@ -81,8 +85,11 @@
 #include "msresamp.c"
 #include "msresamp2.c"
 // ordfilt
+#include "qfirfilt.c"
 #include "rresamp.c"
+#include "rresampbank.c"
 //#include "resamp.c"         // floating-point phase version
 #include "resamp.fixed.c" // fixed-point phase version
 #include "resamp2.c"
+#include "sfirfilt.c"
 #include "symsync.c"
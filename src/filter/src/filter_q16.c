@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Fixed-point FIR filter and decimator on interleaved q15 (sc16) samples
+//
+// Complex samples are kept in the native radio front-end format
+// (interleaved int16_t i/q) and filtered against real Q.15 coefficients
+// entirely in integer arithmetic, deferring conversion to floating
+// point until after the front half of the receive chain.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+//
+// firfilt_crcq16
+//
+
+// filter structure
+struct firfilt_crcq16_s {
+    int16_t *       h;      // coefficients array (Q.15)
+    unsigned int    h_len;  // number of coefficients
+
+    int16_t *       w;      // sample buffer, interleaved i/q [2*h_len]
+    dotprod_crcq16  dp;     // vector dot product
+};
+
+// create fixed-point filter object
+//  _h      : filter coefficients in Q.15 [size: _n x 1]
+//  _n      : number of filter coefficients, _n > 0
+firfilt_crcq16 firfilt_crcq16_create(int16_t *    _h,
+                                     unsigned int _n)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: firfilt_crcq16_create(), filter length must be greater than zero\n");
+        exit(1);
+    }
+
+    firfilt_crcq16 q = (firfilt_crcq16) malloc(sizeof(struct firfilt_crcq16_s));
+    q->h_len = _n;
+
+    // load filter in reverse order
+    q->h = (int16_t*) malloc((q->h_len)*sizeof(int16_t));
+    unsigned int i;
+    for (i=0; i<q->h_len; i++)
+        q->h[i] = _h[_n-i-1];
+
+    // allocate sample buffer (interleaved i/q)
+    q->w = (int16_t*) malloc(2*(q->h_len)*sizeof(int16_t));
+
+    // create dot product object
+    q->dp = dotprod_crcq16_create(q->h, q->h_len);
+
+    // reset filter state (clear buffer)
+    firfilt_crcq16_reset(q);
+
+    return q;
+}
+
+// destroy filter object, freeing all internal memory
+void firfilt_crcq16_destroy(firfilt_crcq16 _q)
+{
+    dotprod_crcq16_destroy(_q->dp);
+    free(_q->h);
+    free(_q->w);
+    free(_q);
+}
+
+// reset filter object's internal buffer
+void firfilt_crcq16_reset(firfilt_crcq16 _q)
+{
+    memset(_q->w, 0x00, 2*(_q->h_len)*sizeof(int16_t));
+}
+
+// print filter object internals to standard output
+void firfilt_crcq16_print(firfilt_crcq16 _q)
+{
+    printf("firfilt_crcq16 [%u coefficients]\n", _q->h_len);
+    dotprod_crcq16_print(_q->dp);
+}
+
+// push one complex sample (interleaved i/q pair) into filter buffer
+//  _q      : filter object
+//  _x      : input sample, interleaved i/q [size: 2 x 1]
+void firfilt_crcq16_push(firfilt_crcq16 _q,
+                         int16_t *      _x)
+{
+    // shift buffer, appending new sample at the end (newest last, to
+    // match the reversed coefficient ordering)
+    memmove(_q->w, _q->w+2, 2*(_q->h_len-1)*sizeof(int16_t));
+    _q->w[2*_q->h_len-2] = _x[0];
+    _q->w[2*_q->h_len-1] = _x[1];
+}
+
+// compute output sample from internal buffer
+//  _q      : filter object
+//  _y      : output sample, interleaved i/q [size: 2 x 1]
+void firfilt_crcq16_execute(firfilt_crcq16 _q,
+                            int16_t *      _y)
+{
+    dotprod_crcq16_execute(_q->dp, _q->w, _y);
+}
+
+// execute filter on block of interleaved complex samples
+//  _q      : filter object
+//  _x      : input buffer, interleaved i/q [size: 2 _n x 1]
+//  _n      : number of complex samples
+//  _y      : output buffer, interleaved i/q [size: 2 _n x 1]
+void firfilt_crcq16_execute_block(firfilt_crcq16 _q,
+                                  int16_t *      _x,
+                                  unsigned int   _n,
+                                  int16_t *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // push sample into filter buffer
+        firfilt_crcq16_push(_q, &_x[2*i]);
+
+        // compute output sample
+        firfilt_crcq16_execute(_q, &_y[2*i]);
+    }
+}
+
+// get length of filter object (number of coefficients)
+unsigned int firfilt_crcq16_get_length(firfilt_crcq16 _q)
+{
+    return _q->h_len;
+}
+
+
+//
+// firdecim_crcq16
+//
+
+// decimator structure
+struct firdecim_crcq16_s {
+    int16_t *       h;      // coefficients array (Q.15)
+    unsigned int    h_len;  // number of coefficients
+    unsigned int    M;      // decimation factor
+
+    int16_t *       w;      // sample buffer, interleaved i/q [2*h_len]
+    dotprod_crcq16  dp;     // vector dot product
+};
+
+// create fixed-point decimator object
+//  _M      : decimation factor, _M > 0
+//  _h      : filter coefficients in Q.15 [size: _h_len x 1]
+//  _h_len  : number of filter coefficients, _h_len > 0
+firdecim_crcq16 firdecim_crcq16_create(unsigned int _M,
+                                       int16_t *    _h,
+                                       unsigned int _h_len)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: firdecim_crcq16_create(), filter length must be greater than zero\n");
+        exit(1);
+    } else if (_M == 0) {
+        fprintf(stderr,"error: firdecim_crcq16_create(), decimation factor must be greater than zero\n");
+        exit(1);
+    }
+
+    firdecim_crcq16 q = (firdecim_crcq16) malloc(sizeof(struct firdecim_crcq16_s));
+    q->h_len = _h_len;
+    q->M     = _M;
+
+    // load filter in reverse order
+    q->h = (int16_t*) malloc((q->h_len)*sizeof(int16_t));
+    unsigned int i;
+    for (i=0; i<q->h_len; i++)
+        q->h[i] = _h[_h_len-i-1];
+
+    // allocate sample buffer (interleaved i/q)
+    q->w = (int16_t*) malloc(2*(q->h_len)*sizeof(int16_t));
+
+    // create dot product object
+    q->dp = dotprod_crcq16_create(q->h, q->h_len);
+
+    // reset decimator state (clear buffer)
+    firdecim_crcq16_reset(q);
+
+    return q;
+}
+
+// destroy decimator object, freeing all internal memory
+void firdecim_crcq16_destroy(firdecim_crcq16 _q)
+{
+    dotprod_crcq16_destroy(_q->dp);
+    free(_q->h);
+    free(_q->w);
+    free(_q);
+}
+
+// reset decimator object's internal buffer
+void firdecim_crcq16_reset(firdecim_crcq16 _q)
+{
+    memset(_q->w, 0x00, 2*(_q->h_len)*sizeof(int16_t));
+}
+
+// print decimator object internals to standard output
+void firdecim_crcq16_print(firdecim_crcq16 _q)
+{
+    printf("firdecim_crcq16 [M=%u, %u coefficients]\n", _q->M, _q->h_len);
+    dotprod_crcq16_print(_q->dp);
+}
+
+// push one complex sample into decimator buffer (newest last, to match
+// the reversed coefficient ordering)
+static void firdecim_crcq16_push(firdecim_crcq16 _q,
+                                 int16_t *       _x)
+{
+    memmove(_q->w, _q->w+2, 2*(_q->h_len-1)*sizeof(int16_t));
+    _q->w[2*_q->h_len-2] = _x[0];
+    _q->w[2*_q->h_len-1] = _x[1];
+}
+
+// execute decimator on one block of _M complex input samples
+//  _q      : decimator object
+//  _x      : input buffer, interleaved i/q [size: 2 _M x 1]
+//  _y      : output sample, interleaved i/q [size: 2 x 1]
+void firdecim_crcq16_execute(firdecim_crcq16 _q,
+                             int16_t *       _x,
+                             int16_t *       _y)
+{
+    // push first sample and compute output
+    firdecim_crcq16_push(_q, &_x[0]);
+    dotprod_crcq16_execute(_q->dp, _q->w, _y);
+
+    // buffer remaining samples
+    unsigned int i;
+    for (i=1; i<_q->M; i++)
+        firdecim_crcq16_push(_q, &_x[2*i]);
+}
+
+// execute decimator on block of _n*_M complex input samples
+//  _q      : decimator object
+//  _x      : input buffer, interleaved i/q [size: 2 _n _M x 1]
+//  _n      : number of output samples
+//  _y      : output buffer, interleaved i/q [size: 2 _n x 1]
+void firdecim_crcq16_execute_block(firdecim_crcq16 _q,
+                                   int16_t *       _x,
+                                   unsigned int    _n,
+                                   int16_t *       _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        firdecim_crcq16_execute(_q, &_x[2*i*_q->M], &_y[2*i]);
+}
@@ -47,15 +47,19 @@
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_rrrf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_rrrf,name)
 #define ORDFILT(name)       LIQUID_CONCAT(ordfilt_rrrf,name)
+#define QFIRFILT(name)      LIQUID_CONCAT(qfirfilt_rrrf,name)
 #define RRESAMP(name)       LIQUID_CONCAT(rresamp_rrrf,name)
+#define RRESAMPBANK(name)  LIQUID_CONCAT(rresampbank_rrrf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_rrrf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_rrrf,name)
+#define SFIRFILT(name)      LIQUID_CONCAT(sfirfilt_rrrf,name)
 #define SYMSYNC(name)       LIQUID_CONCAT(symsync_rrrf,name)
 
 #define T                   float   // general
 #define TO                  float   // output
 #define TC                  float   // coefficients
 #define TI                  float   // input
+#define TW                  double // wide internal state
 #define WINDOW(name)        LIQUID_CONCAT(windowf,name)
 #define DOTPROD(name)       LIQUID_CONCAT(dotprod_rrrf,name)
 #define POLY(name)          LIQUID_CONCAT(polyf,name)
@@ -85,8 +89,11 @@
 #include "msresamp.c"
 #include "msresamp2.c"
 #include "ordfilt.c"
+#include "qfirfilt.c"
 #include "rresamp.c"
+#include "rresampbank.c"
 //#include "resamp.c"         // floating-point phase version
 #include "resamp.fixed.c" // fixed-point phase version
 #include "resamp2.c"
+#include "sfirfilt.c"
 #include "symsync.c"
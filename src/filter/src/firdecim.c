@@ -217,21 +217,21 @@ void FIRDECIM(_execute)(FIRDECIM() _q,
                         TO *       _y)
 {
     TI * r; // read pointer
-    unsigned int i;
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_push)(_q->w, _x[i]);
 
-        if (i==0) {
-            // read buffer (retrieve pointer to aligned memory array)
-            WINDOW(_read)(_q->w, &r);
+    // push first sample and compute output
+    WINDOW(_push)(_q->w, _x[0]);
 
-            // execute dot product
-            DOTPROD(_execute)(_q->dp, r, _y);
+    // read buffer (retrieve pointer to aligned memory array)
+    WINDOW(_read)(_q->w, &r);
 
-            // apply scaling factor
-            *_y *= _q->scale;
-        }
-    }
+    // execute dot product
+    DOTPROD(_execute)(_q->dp, r, _y);
+
+    // apply scaling factor
+    *_y *= _q->scale;
+
+    // write remaining input samples into buffer in one pass
+    WINDOW(_write)(_q->w, _x+1, _q->M-1);
 }
 
 // execute decimator on block of _n*_M input samples
@@ -35,6 +35,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
@@ -262,21 +263,17 @@ void liquid_firdes_kaiser(unsigned int _n,
     // choose kaiser beta parameter (approximate)
     float beta = kaiser_beta_As(_As);
 
-    float t, h1, h2; 
+    // compute window over the full block
+    float w[_n];
+    liquid_kaiser_window(_n, beta, w);
+
+    float t;
     unsigned int i;
     for (i=0; i<_n; i++) {
         t = (float)i - (float)(_n-1)/2 + _mu;
-     
-        // sinc prototype
-        h1 = sincf(2.0f*_fc*t);
-
-        // kaiser window
-        h2 = liquid_kaiser(i,_n,beta);
-
-        //printf("t = %f, h1 = %f, h2 = %f\n", t, h1, h2);
 
-        // composite
-        _h[i] = h1*h2;
+        // composite: sinc prototype scaled by kaiser window
+        _h[i] = sincf(2.0f*_fc*t) * w[i];
     }
 }
 
@@ -420,6 +417,90 @@ void liquid_firdes_prototype(liquid_firfilt_type _type,
     }
 }
 
+// internal cache of prototype filter designs, keyed on the design
+// parameters; entries are shared and immutable once created.  lookups
+// may run from multiple threads, so the entry array is guarded by a
+// mutex
+struct liquid_firdes_cache_entry_s {
+    liquid_firfilt_type type;   // filter type
+    unsigned int        k;      // samples/symbol
+    unsigned int        m;      // symbol delay
+    float               beta;   // excess bandwidth factor
+    float               dt;     // fractional sample delay
+    float *             h;      // coefficients [size: 2*k*m+1]
+};
+
+static struct liquid_firdes_cache_entry_s * liquid_firdes_cache = NULL;
+static unsigned int    liquid_firdes_cache_size  = 0;
+static pthread_mutex_t liquid_firdes_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Design (root-)Nyquist filter from prototype, returning a shared
+// immutable coefficient array from an in-process cache; the design is
+// only computed the first time a given parameter tuple is requested.
+// The returned array remains valid until liquid_firdes_cache_clear()
+// and must not be modified or freed by the caller.
+//  _type   : filter type (e.g. LIQUID_FIRFILT_RRC)
+//  _k      : samples/symbol,          _k > 1
+//  _m      : symbol delay,            _m > 0
+//  _beta   : excess bandwidth factor, _beta in [0,1)
+//  _dt     : fractional sample delay, _dt in [-1,1]
+const float * liquid_firdes_prototype_cached(liquid_firfilt_type _type,
+                                             unsigned int        _k,
+                                             unsigned int        _m,
+                                             float               _beta,
+                                             float               _dt)
+{
+    unsigned int i;
+
+    pthread_mutex_lock(&liquid_firdes_cache_mutex);
+
+    // search cache for matching design
+    for (i=0; i<liquid_firdes_cache_size; i++) {
+        struct liquid_firdes_cache_entry_s * e = &liquid_firdes_cache[i];
+        if (e->type == _type && e->k == _k && e->m == _m &&
+            e->beta == _beta && e->dt == _dt)
+        {
+            pthread_mutex_unlock(&liquid_firdes_cache_mutex);
+            return e->h;
+        }
+    }
+
+    // not found; run design into a new cache entry (any invalid
+    // parameters are caught by liquid_firdes_prototype)
+    unsigned int h_len = 2*_k*_m + 1;
+    float * h = (float*) malloc(h_len*sizeof(float));
+    liquid_firdes_prototype(_type, _k, _m, _beta, _dt, h);
+
+    // append entry to cache
+    liquid_firdes_cache = (struct liquid_firdes_cache_entry_s*)
+        realloc(liquid_firdes_cache,
+                (liquid_firdes_cache_size+1)*sizeof(struct liquid_firdes_cache_entry_s));
+    struct liquid_firdes_cache_entry_s * e = &liquid_firdes_cache[liquid_firdes_cache_size++];
+    e->type = _type;
+    e->k    = _k;
+    e->m    = _m;
+    e->beta = _beta;
+    e->dt   = _dt;
+    e->h    = h;
+
+    pthread_mutex_unlock(&liquid_firdes_cache_mutex);
+    return h;
+}
+
+// clear the internal prototype design cache, freeing all memory and
+// invalidating previously-returned coefficient arrays
+void liquid_firdes_cache_clear(void)
+{
+    unsigned int i;
+    pthread_mutex_lock(&liquid_firdes_cache_mutex);
+    for (i=0; i<liquid_firdes_cache_size; i++)
+        free(liquid_firdes_cache[i].h);
+    free(liquid_firdes_cache);
+    liquid_firdes_cache      = NULL;
+    liquid_firdes_cache_size = 0;
+    pthread_mutex_unlock(&liquid_firdes_cache_mutex);
+}
+
 
 // Design FIR doppler filter
 //  _n      : filter length
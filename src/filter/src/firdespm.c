@@ -78,6 +78,10 @@ void firdespm_compute_interp(firdespm _q);
 // output), desired response, and weights
 void firdespm_compute_error(firdespm _q);
 
+// compute error signal only in windows around the current
+// extremal frequencies (reusable mode)
+void firdespm_compute_error_window(firdespm _q);
+
 // search error curve for _r+1 extremal indices
 void firdespm_iext_search(firdespm _q);
 
@@ -113,6 +117,7 @@ struct firdespm_s {
     double * D;                 // desired response
     double * W;                 // weight
     double * E;                 // error
+    double * xg;                // Chebyshev abscissae, cos(2*pi*F[i])
 
     double * x;                 // Chebyshev points : cos(2*pi*f)
     double * alpha;             // Lagrange interpolating polynomial
@@ -121,6 +126,7 @@ struct firdespm_s {
 
     unsigned int * iext;        // indices of extrema
     unsigned int num_exchanges; // number of changes in extrema
+    int has_extrema;            // previous design extrema valid? (reusable mode)
 
     firdespm_callback callback; // user-defined callback function
     void *            userdata; // user-defined structure for callback function
@@ -303,6 +309,8 @@ firdespm firdespm_create(unsigned int            _h_len,
     q->D = (double*) malloc(q->grid_size*sizeof(double));
     q->W = (double*) malloc(q->grid_size*sizeof(double));
     q->E = (double*) malloc(q->grid_size*sizeof(double));
+    q->xg = (double*) malloc(q->grid_size*sizeof(double));
+    q->has_extrema = 0;
     q->callback = NULL;
     q->userdata = NULL;
     firdespm_init_grid(q);
@@ -394,6 +402,8 @@ firdespm firdespm_create_callback(unsigned int          _h_len,
     q->D = (double*) malloc(q->grid_size*sizeof(double));
     q->W = (double*) malloc(q->grid_size*sizeof(double));
     q->E = (double*) malloc(q->grid_size*sizeof(double));
+    q->xg = (double*) malloc(q->grid_size*sizeof(double));
+    q->has_extrema = 0;
     firdespm_init_grid(q);
     // TODO : fix grid, weights according to filter type
 
@@ -419,6 +429,7 @@ void firdespm_destroy(firdespm _q)
     free(_q->D);
     free(_q->W);
     free(_q->E);
+    free(_q->xg);
 
     // free band description elements
     free(_q->bands);
@@ -491,6 +502,64 @@ void firdespm_execute(firdespm _q, float * _h)
     printf("search complete in %u iterations\n", p);
 #endif
 
+    // retain extremal set for possible warm-started re-designs
+    _q->has_extrema = 1;
+
+    // compute filter taps
+    firdespm_compute_taps(_q, _h);
+}
+
+// execute filter design in reusable mode, storing result in _h. The
+// dense grid is refreshed (so a user-defined callback may produce an
+// updated response) and the Remez exchange is warm-started from the
+// previous extremal set, evaluating the error only in windows around
+// the current extrema. The solution is verified against a full-grid
+// evaluation before computing taps; if it fails, the regular search
+// is run instead.
+void firdespm_execute_reuse(firdespm _q,
+                            float *  _h)
+{
+    // no previous design to start from; run regular search
+    if (!_q->has_extrema) {
+        firdespm_execute(_q, _h);
+        return;
+    }
+
+    // refresh dense grid (desired response and weights may have
+    // changed through the user-defined callback)
+    firdespm_init_grid(_q);
+
+    // iterate over the Remez exchange algorithm from the previous
+    // extremal set with windowed error evaluation
+    unsigned int p;
+    unsigned int max_iterations = 40;
+    int converged = 0;
+    for (p=0; p<max_iterations; p++) {
+        // compute interpolator
+        firdespm_compute_interp(_q);
+
+        // compute error in windows around current extrema
+        firdespm_compute_error_window(_q);
+
+        // search for new extremal frequencies
+        firdespm_iext_search(_q);
+
+        // check exit criteria
+        if (firdespm_is_search_complete(_q)) {
+            converged = 1;
+            break;
+        }
+    }
+
+    // verify solution at full grid resolution
+    firdespm_compute_error(_q);
+    firdespm_iext_search(_q);
+    if (!converged || !firdespm_is_search_complete(_q)) {
+        // windowed search missed an extremum; fall back to full search
+        firdespm_execute(_q, _h);
+        return;
+    }
+
     // compute filter taps
     firdespm_compute_taps(_q, _h);
 }
@@ -590,6 +659,11 @@ void firdespm_init_grid(firdespm _q)
     }
     _q->grid_size = n;
 
+    // cache Chebyshev abscissae of grid points; these are invariant
+    // over the Remez iterations and across re-designs
+    for (i=0; i<_q->grid_size; i++)
+        _q->xg[i] = cos(2*M_PI*_q->F[i]);
+
     // take care of special symmetry conditions here
     if (_q->btype == LIQUID_FIRDESPM_BANDPASS) {
         if (_q->s == 0) {
@@ -668,18 +742,41 @@ void firdespm_compute_error(firdespm _q)
 {
     unsigned int i;
 
-    double xf;
     double H;
     for (i=0; i<_q->grid_size; i++) {
-        // compute actual response
-        xf = cos(2*M_PI*_q->F[i]);
-        H = poly_val_lagrange_barycentric(_q->x,_q->c,_q->alpha,xf,_q->r+1);
+        // compute actual response from cached Chebyshev abscissa
+        H = poly_val_lagrange_barycentric(_q->x,_q->c,_q->alpha,_q->xg[i],_q->r+1);
 
         // compute error
         _q->E[i] = _q->W[i] * (_q->D[i] - H);
     }
 }
 
+// compute error signal only in windows around the current extremal
+// frequencies; remaining grid points retain the error of the previous
+// iteration. This is a heuristic for nearly-converged designs and must
+// be verified with a full evaluation before computing taps.
+void firdespm_compute_error_window(firdespm _q)
+{
+    unsigned int i;
+    unsigned int w = 4*_q->grid_density;    // window semi-width [points]
+    unsigned int n = 0;                     // next grid index to evaluate
+
+    for (i=0; i<_q->r+1; i++) {
+        // compute window around extremal point, clipping to grid
+        // bounds and skipping points already evaluated
+        unsigned int i0 = _q->iext[i] > w ? _q->iext[i] - w : 0;
+        unsigned int i1 = _q->iext[i] + w + 1;
+        if (i1 > _q->grid_size) i1 = _q->grid_size;
+        if (i0 < n)             i0 = n;
+
+        for (n=i0; n<i1; n++) {
+            double H = poly_val_lagrange_barycentric(_q->x,_q->c,_q->alpha,_q->xg[n],_q->r+1);
+            _q->E[n] = _q->W[n] * (_q->D[n] - H);
+        }
+    }
+}
+
 // search error curve for r+1 extremal indices
 // TODO : return number of values which have changed (exit criteria)
 void firdespm_iext_search(firdespm _q)
@@ -37,10 +37,18 @@
 
 #define LIQUID_FIRFILT_USE_WINDOW   (0)
 
+// number of outputs computed per chunk in block execution
+#define LIQUID_FIRFILT_BLOCK_LEN    (256)
+
+// minimum filter length before create_auto() attaches the internal
+// frequency-domain (FFT-based) filter engine
+#define LIQUID_FIRFILT_AUTO_MIN     (128)
+
 // firfilt object structure
 struct FIRFILT(_s) {
     TC * h;             // filter coefficients array [size; h_len x 1]
     unsigned int h_len; // filter length
+    unsigned int * nref;// coefficient reference count (see clone_shared)
 
 #if LIQUID_FIRFILT_USE_WINDOW
     // use window object for internal buffer
@@ -54,8 +62,33 @@ struct FIRFILT(_s) {
 #endif
     DOTPROD() dp;           // dot product object
     TC scale;               // output scaling factor
+
+    // execute kernel, selected by filter length at create; lengths
+    // with a stamped compile-time specialization bypass the generic
+    // dot product (see FIRFILT(_select_kernel))
+    void (*execute)(FIRFILT() _q, TO * _y);
+
+    // frequency-domain engine (create_auto, long filters only)
+    FFTFILT() fdf;          // FFT-based filter engine
+    unsigned int fdf_n;     // engine input/output block size
+    TI * fdf_buf;           // engine scratch buffer [size: fdf_n x 1]
+
+    // deferred filter design (create_lazy methods only); parameters
+    // are stored here at create and the design runs at the first
+    // execute or an explicit prepare call
+    int          lazy_design;   // design pending?
+    int          lazy_type;     // prototype type (negative : kaiser)
+    unsigned int lazy_k;        // samples/symbol (rnyquist)
+    unsigned int lazy_m;        // filter delay (rnyquist)
+    float        lazy_fc;       // cut-off frequency (kaiser)
+    float        lazy_As;       // stop-band attenuation (kaiser)
+    float        lazy_beta;     // excess bandwidth factor (rnyquist)
+    float        lazy_mu;       // fractional sample offset
 };
 
+// select execute kernel based on filter length (internal method)
+void FIRFILT(_select_kernel)(FIRFILT() _q);
+
 // create firfilt object
 //  _h      :   coefficients (filter taps) [size: _n x 1]
 //  _n      :   filter length
@@ -92,15 +125,117 @@ FIRFILT() FIRFILT(_create)(TC * _h,
     // create dot product object
     q->dp = DOTPROD(_create)(q->h, q->h_len);
 
+    // coefficients are not (yet) shared with any clone
+    q->nref  = (unsigned int*) malloc(sizeof(unsigned int));
+    *q->nref = 1;
+
+    // set default scaling
+    q->scale = 1;
+
+    // no frequency-domain engine by default (see create_auto)
+    q->fdf     = NULL;
+    q->fdf_n   = 0;
+    q->fdf_buf = NULL;
+
+    // no deferred design (see create_lazy methods)
+    q->lazy_design = 0;
+
+    // select execute kernel for this filter length
+    FIRFILT(_select_kernel)(q);
+
+    // reset filter state (clear buffer)
+    FIRFILT(_reset)(q);
+
+    return q;
+}
+
+// create filter object skeleton with coefficient design deferred;
+// internal method used by the create_lazy methods
+//  _n      :   filter length
+FIRFILT() FIRFILT(_create_lazy)(unsigned int _n)
+{
+    // create filter object and initialize
+    FIRFILT() q = (FIRFILT()) malloc(sizeof(struct FIRFILT(_s)));
+    q->h_len = _n;
+    q->h     = NULL;
+
+#if LIQUID_FIRFILT_USE_WINDOW
+    // create window (internal buffer)
+    q->w = WINDOW(_create)(q->h_len);
+#else
+    // initialize array for buffering
+    q->w_len   = 1<<liquid_msb_index(q->h_len); // effectively 2^{floor(log2(len))+1}
+    q->w_mask  = q->w_len - 1;
+    q->w       = (TI *) malloc((q->w_len + q->h_len + 1)*sizeof(TI));
+    q->w_index = 0;
+#endif
+
+    // dot product object is created once the design has run
+    q->dp = NULL;
+
+    // coefficients are not (yet) shared with any clone
+    q->nref  = (unsigned int*) malloc(sizeof(unsigned int));
+    *q->nref = 1;
+
     // set default scaling
     q->scale = 1;
 
+    // no frequency-domain engine
+    q->fdf     = NULL;
+    q->fdf_n   = 0;
+    q->fdf_buf = NULL;
+
+    // design is pending (parameters set by caller)
+    q->lazy_design = 1;
+
+    // select execute kernel for this filter length
+    FIRFILT(_select_kernel)(q);
+
     // reset filter state (clear buffer)
     FIRFILT(_reset)(q);
 
     return q;
 }
 
+// determine whether the frequency-domain engine is preferred for a
+// filter of length _n: consult the process-wide tuning table when
+// populated (see liquid_tune) and otherwise fall back to the static
+// length threshold
+int FIRFILT(_engine_preferred)(unsigned int _n)
+{
+    int choice = liquid_tune_get(LIQUID_TUNE_FIRFILT, _n);
+    if (choice != -1)
+        return choice;
+    return _n >= LIQUID_FIRFILT_AUTO_MIN;
+}
+
+// create firfilt object with an automatically-selected internal
+// implementation; long filters attach a frequency-domain engine which
+// is used transparently by the block execute method
+//  _h      :   coefficients (filter taps) [size: _n x 1]
+//  _n      :   filter length
+FIRFILT() FIRFILT(_create_auto)(TC *         _h,
+                                unsigned int _n)
+{
+    // create regular (time-domain) object
+    FIRFILT() q = FIRFILT(_create)(_h, _n);
+
+    // attach frequency-domain engine for long filters
+    if (FIRFILT(_engine_preferred)(_n)) {
+        // engine block size: smallest power of two at least twice the
+        // filter order
+        unsigned int n = 1;
+        while (n < 2*(_n-1))
+            n <<= 1;
+
+        q->fdf_n   = n;
+        q->fdf     = FFTFILT(_create)(_h, _n, n);
+        q->fdf_buf = (TI *) malloc(n*sizeof(TI));
+    }
+
+    return q;
+}
+
 // create filter using Kaiser-Bessel windowed sinc method
 //  _n      : filter length, _n > 0
 //  _fc     : cutoff frequency, 0 < _fc < 0.5
@@ -127,10 +262,39 @@ FIRFILT() FIRFILT(_create_kaiser)(unsigned int _n,
     for (i=0; i<_n; i++)
         h[i] = (TC) hf[i];
 
-    // 
+    //
     return FIRFILT(_create)(h, _n);
 }
 
+// create filter using Kaiser-Bessel windowed sinc method with the
+// design itself deferred to the first execute or an explicit prepare
+// call; constructing a large bank returns immediately and the designs
+// may then run in parallel (e.g. one prepare call per worker thread)
+//  _n      : filter length, _n > 0
+//  _fc     : cutoff frequency, 0 < _fc < 0.5
+//  _As     : stop-band attenuation [dB], _As > 0
+//  _mu     : fractional sample offset, -0.5 < _mu < 0.5
+FIRFILT() FIRFILT(_create_lazy_kaiser)(unsigned int _n,
+                                       float        _fc,
+                                       float        _As,
+                                       float        _mu)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: firfilt_%s_create_lazy_kaiser(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create skeleton object and store design parameters
+    FIRFILT() q = FIRFILT(_create_lazy)(_n);
+    q->lazy_type = -1;
+    q->lazy_fc   = _fc;
+    q->lazy_As   = _As;
+    q->lazy_mu   = _mu;
+
+    return q;
+}
+
 // create from square-root Nyquist prototype
 //  _type   : filter type (e.g. LIQUID_FIRFILT_RRC)
 //  _k      : nominal samples/symbol, _k > 1
@@ -170,6 +334,73 @@ FIRFILT() FIRFILT(_create_rnyquist)(int          _type,
     return FIRFILT(_create)(hc, h_len);
 }
 
+// create from square-root Nyquist prototype with the design deferred
+// to the first execute or an explicit prepare call
+//  _type   : filter type (e.g. LIQUID_FIRFILT_RRC)
+//  _k      : nominal samples/symbol, _k > 1
+//  _m      : filter delay [symbols], _m > 0
+//  _beta   : rolloff factor, 0 < beta <= 1
+//  _mu     : fractional sample offset,-0.5 < _mu < 0.5
+FIRFILT() FIRFILT(_create_lazy_rnyquist)(int          _type,
+                                         unsigned int _k,
+                                         unsigned int _m,
+                                         float        _beta,
+                                         float        _mu)
+{
+    // validate input
+    if (_k < 2) {
+        fprintf(stderr,"error: firfilt_%s_create_lazy_rnyquist(), filter samples/symbol must be greater than 1\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: firfilt_%s_create_lazy_rnyquist(), filter delay must be greater than 0\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_beta < 0.0f || _beta > 1.0f) {
+        fprintf(stderr,"error: firfilt_%s_create_lazy_rnyquist(), filter excess bandwidth factor must be in [0,1]\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create skeleton object and store design parameters
+    FIRFILT() q = FIRFILT(_create_lazy)(2*_k*_m + 1);
+    q->lazy_type = _type;
+    q->lazy_k    = _k;
+    q->lazy_m    = _m;
+    q->lazy_beta = _beta;
+    q->lazy_mu   = _mu;
+
+    return q;
+}
+
+// run any deferred filter design; a no-op when the coefficients are
+// already available
+void FIRFILT(_prepare)(FIRFILT() _q)
+{
+    if (!_q->lazy_design)
+        return;
+
+    // run deferred design
+    float hf[_q->h_len];
+    if (_q->lazy_type < 0) {
+        // Kaiser-Bessel windowed sinc
+        liquid_firdes_kaiser(_q->h_len, _q->lazy_fc, _q->lazy_As, _q->lazy_mu, hf);
+    } else {
+        // square-root Nyquist prototype
+        liquid_firdes_prototype(_q->lazy_type, _q->lazy_k, _q->lazy_m,
+                                _q->lazy_beta, _q->lazy_mu, hf);
+    }
+
+    // load filter in reverse order
+    _q->h = (TC *) malloc((_q->h_len)*sizeof(TC));
+    unsigned int i;
+    for (i=_q->h_len; i>0; i--)
+        _q->h[i-1] = (TC) hf[_q->h_len-i];
+
+    // create dot product object
+    _q->dp = DOTPROD(_create)(_q->h, _q->h_len);
+
+    // design is no longer pending
+    _q->lazy_design = 0;
+}
+
 // Create object from Parks-McClellan algorithm prototype
 //  _h_len  : filter length, _h_len > 0
 //  _fc     : cutoff frequency, 0 < _fc < 0.5
@@ -309,6 +540,15 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
 {
     unsigned int i;
 
+    // validate input
+    if (*_q->nref > 1) {
+        fprintf(stderr,"error: firfilt_%s_recreate(), cannot re-create filter with shared coefficients\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // run any deferred design (original coefficient array must exist)
+    FIRFILT(_prepare)(_q);
+
     // reallocate memory array if filter length has changed
     if (_n != _q->h_len) {
         // reallocate memory
@@ -322,11 +562,15 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
         // free old array
         free(_q->w);
 
-        // initialize array for buffering
+        // initialize array for buffering; the new buffer must be
+        // cleared (as in _create) so the first outputs do not read
+        // uninitialized memory
         _q->w_len   = 1<<liquid_msb_index(_q->h_len);   // effectively 2^{floor(log2(len))+1}
         _q->w_mask  = _q->w_len - 1;
         _q->w       = (TI *) malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
         _q->w_index = 0;
+        for (i=0; i<_q->w_len; i++)
+            _q->w[i] = 0.0;
 #endif
     }
 
@@ -337,9 +581,76 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
     // re-create internal dot product object
     _q->dp = DOTPROD(_recreate)(_q->dp, _q->h, _q->h_len);
 
+    // re-create frequency-domain engine with new coefficients
+    if (_q->fdf != NULL) {
+        FFTFILT(_destroy)(_q->fdf);
+        free(_q->fdf_buf);
+        _q->fdf     = NULL;
+        _q->fdf_n   = 0;
+        _q->fdf_buf = NULL;
+
+        if (FIRFILT(_engine_preferred)(_n)) {
+            unsigned int n = 1;
+            while (n < 2*(_n-1))
+                n <<= 1;
+
+            _q->fdf_n   = n;
+            _q->fdf     = FFTFILT(_create)(_h, _n, n);
+            _q->fdf_buf = (TI *) malloc(n*sizeof(TI));
+        }
+    }
+
+    // re-select execute kernel for the new filter length
+    FIRFILT(_select_kernel)(_q);
+
     return _q;
 }
 
+// create clone of firfilt object sharing the original's (immutable)
+// coefficients; the clone has its own buffer state so it may run on an
+// independent sample stream, but the coefficient array and dot product
+// object are reference counted rather than duplicated, keeping the
+// per-instance memory footprint to just the buffer
+//  _q      :   original firfilt object
+FIRFILT() FIRFILT(_clone_shared)(FIRFILT() _q)
+{
+    // run any deferred design; clones share the designed coefficients
+    FIRFILT(_prepare)(_q);
+
+    // create filter object and copy all static parameters
+    FIRFILT() q = (FIRFILT()) malloc(sizeof(struct FIRFILT(_s)));
+    memmove(q, _q, sizeof(struct FIRFILT(_s)));
+
+    // coefficients and dot product object are shared; increment the
+    // common reference count
+    (*q->nref)++;
+
+#if LIQUID_FIRFILT_USE_WINDOW
+    // create window (internal buffer)
+    q->w = WINDOW(_create)(q->h_len);
+#else
+    // allocate independent buffer for the clone
+    q->w       = (TI *) malloc((q->w_len + q->h_len + 1)*sizeof(TI));
+    q->w_index = 0;
+#endif
+
+    // the frequency-domain engine holds overlap state and cannot be
+    // shared; re-create it from the coefficients when one is attached
+    if (_q->fdf != NULL) {
+        unsigned int i;
+        TC h[q->h_len];
+        for (i=0; i<q->h_len; i++)
+            h[i] = _q->h[q->h_len-i-1];
+        q->fdf     = FFTFILT(_create)(h, q->h_len, q->fdf_n);
+        q->fdf_buf = (TI *) malloc((q->fdf_n)*sizeof(TI));
+    }
+
+    // reset filter state (clear buffer)
+    FIRFILT(_reset)(q);
+
+    return q;
+}
+
 // destroy firfilt object
 void FIRFILT(_destroy)(FIRFILT() _q)
 {
@@ -348,8 +659,20 @@ void FIRFILT(_destroy)(FIRFILT() _q)
 #else
     free(_q->w);
 #endif
-    DOTPROD(_destroy)(_q->dp);
-    free(_q->h);
+    if (_q->fdf != NULL) {
+        FFTFILT(_destroy)(_q->fdf);
+        free(_q->fdf_buf);
+    }
+
+    // coefficients may be shared among clones (see clone_shared);
+    // free them only with the last reference
+    (*_q->nref)--;
+    if (*_q->nref == 0) {
+        if (_q->dp != NULL)
+            DOTPROD(_destroy)(_q->dp);
+        free(_q->h);
+        free(_q->nref);
+    }
     free(_q);
 }
 
@@ -369,6 +692,8 @@ void FIRFILT(_reset)(FIRFILT() _q)
 // print filter object internals (taps, buffer)
 void FIRFILT(_print)(FIRFILT() _q)
 {
+    FIRFILT(_prepare)(_q);
+
     printf("firfilt_%s:\n", EXTENSION_FULL);
     unsigned int i;
     unsigned int n = _q->h_len;
@@ -444,12 +769,12 @@ void FIRFILT(_write)(FIRFILT()    _q,
 #endif
 }
 
-// compute output sample (dot product between internal
-// filter coefficients and internal buffer)
+// generic execute kernel: dot product between internal filter
+// coefficients and internal buffer (internal method)
 //  _q      :   filter object
 //  _y      :   output sample pointer
-void FIRFILT(_execute)(FIRFILT() _q,
-                       TO *      _y)
+void FIRFILT(_execute_kernel_generic)(FIRFILT() _q,
+                                      TO *      _y)
 {
     // read buffer (retrieve pointer to aligned memory array)
 #if LIQUID_FIRFILT_USE_WINDOW
@@ -466,6 +791,127 @@ void FIRFILT(_execute)(FIRFILT() _q,
     *_y *= _q->scale;
 }
 
+#if !LIQUID_FIRFILT_USE_WINDOW
+// stamp out length-specialized execute kernels: the compile-time trip
+// count lets the compiler fully unroll the accumulation loop and
+// schedule multiply-accumulate chains, which beats the generic dot
+// product dispatch for short (per-sample matched) filters
+#define LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(N)                             \
+void FIRFILT(_execute_kernel_##N)(FIRFILT() _q,                             \
+                                  TO *      _y)                             \
+{                                                                           \
+    TI * r = _q->w + _q->w_index;                                           \
+    TO   y = 0;                                                             \
+    unsigned int i;                                                         \
+    for (i=0; i<N; i++)                                                     \
+        y += r[i] * _q->h[i];                                               \
+    *_y = y * _q->scale;                                                    \
+}
+
+// common matched-filter lengths (2*k*m+1 with k=2) and powers of two
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(13)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(16)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(17)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(21)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(25)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(29)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(32)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(33)
+LIQUID_FIRFILT_DEFINE_EXECUTE_KERNEL(64)
+
+// select execute kernel based on filter length (internal method)
+void FIRFILT(_select_kernel)(FIRFILT() _q)
+{
+    switch (_q->h_len) {
+    case 13: _q->execute = FIRFILT(_execute_kernel_13); break;
+    case 16: _q->execute = FIRFILT(_execute_kernel_16); break;
+    case 17: _q->execute = FIRFILT(_execute_kernel_17); break;
+    case 21: _q->execute = FIRFILT(_execute_kernel_21); break;
+    case 25: _q->execute = FIRFILT(_execute_kernel_25); break;
+    case 29: _q->execute = FIRFILT(_execute_kernel_29); break;
+    case 32: _q->execute = FIRFILT(_execute_kernel_32); break;
+    case 33: _q->execute = FIRFILT(_execute_kernel_33); break;
+    case 64: _q->execute = FIRFILT(_execute_kernel_64); break;
+    default: _q->execute = FIRFILT(_execute_kernel_generic);
+    }
+}
+#else
+// window-based buffer: no length-specialized kernels
+void FIRFILT(_select_kernel)(FIRFILT() _q)
+{
+    _q->execute = FIRFILT(_execute_kernel_generic);
+}
+#endif
+
+// compute output sample (dot product between internal
+// filter coefficients and internal buffer)
+//  _q      :   filter object
+//  _y      :   output sample pointer
+void FIRFILT(_execute)(FIRFILT() _q,
+                       TO *      _y)
+{
+    // run any deferred design
+    if (_q->lazy_design)
+        FIRFILT(_prepare)(_q);
+
+    // invoke internal kernel function pointer
+    _q->execute(_q, _y);
+}
+
+// execute frequency-domain engine on a block of input samples; the
+// engine carries no state between calls: one warm-up block seeds the
+// overlap buffer from the filter history so the single-sample interface
+// may be freely mixed with block execution
+//  _q      : filter object
+//  _x      : pointer to input array [size: _n x 1]
+//  _n      : number of input, output samples, _n >= fdf_n
+//  _y      : pointer to output array [size: _n x 1]
+void FIRFILT(_execute_block_fft)(FIRFILT()    _q,
+                                 TI *         _x,
+                                 unsigned int _n,
+                                 TO *         _y)
+{
+    unsigned int i;
+    unsigned int n = _q->fdf_n;     // engine block size
+    unsigned int m = _q->h_len - 1; // history carried between calls
+    TO buf_out[n];                  // discarded engine output
+
+    // warm up engine: run one block with the carried history aligned at
+    // the end so the overlap buffer holds its pending tail contributions
+    FFTFILT(_reset)(_q->fdf);
+    for (i=0; i<n-m; i++)
+        _q->fdf_buf[i] = 0;
+    for (i=0; i<m; i++)
+        _q->fdf_buf[n-m+i] = _q->w[_q->w_index + i + 1];
+    FFTFILT(_execute)(_q->fdf, _q->fdf_buf, buf_out);
+
+    // store new history back into circular buffer before any output is
+    // written (input and output buffers may be the same)
+    _q->w_index = 0;
+    memmove(_q->w, &_x[_n - _q->h_len], (_q->h_len)*sizeof(TI));
+
+    // process full blocks directly
+    while (_n >= n) {
+        FFTFILT(_execute)(_q->fdf, _x, _y);
+        for (i=0; i<n; i++)
+            _y[i] *= _q->scale;
+
+        _x += n;
+        _y += n;
+        _n -= n;
+    }
+
+    // process remaining samples with a final zero-padded block
+    if (_n > 0) {
+        memmove(_q->fdf_buf, _x, _n*sizeof(TI));
+        for (i=_n; i<n; i++)
+            _q->fdf_buf[i] = 0;
+        FFTFILT(_execute)(_q->fdf, _q->fdf_buf, buf_out);
+        for (i=0; i<_n; i++)
+            _y[i] = buf_out[i] * _q->scale;
+    }
+}
+
 // execute the filter on a block of input samples; the
 // input and output buffers may be the same
 //  _q      : filter object
@@ -477,6 +923,11 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,
                              unsigned int _n,
                              TO *         _y)
 {
+    // run any deferred design
+    if (_q->lazy_design)
+        FIRFILT(_prepare)(_q);
+
+#if LIQUID_FIRFILT_USE_WINDOW
     unsigned int i;
     for (i=0; i<_n; i++) {
         // push sample into filter
@@ -485,6 +936,56 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,
         // compute output sample
         FIRFILT(_execute)(_q, &_y[i]);
     }
+#else
+    // trivial case
+    if (_n == 0)
+        return;
+
+    // run frequency-domain engine when attached (create_auto) and the
+    // block is long enough to amortize its warm-up transform
+    if (_q->fdf != NULL && _n >= _q->fdf_n) {
+        FIRFILT(_execute_block_fft)(_q, _x, _n, _y);
+        return;
+    }
+
+    unsigned int i;
+    unsigned int m = _q->h_len - 1; // history carried between chunks
+
+    // process input in chunks on a linear scratch buffer: history
+    // followed by input samples, so each output is a dot product on
+    // contiguous memory and the circular buffer is only updated once
+    TI buf[m + LIQUID_FIRFILT_BLOCK_LEN];
+
+    // load history from circular buffer
+    for (i=0; i<m; i++)
+        buf[i] = _q->w[_q->w_index + i + 1];
+
+    while (_n > 0) {
+        unsigned int r = _n < LIQUID_FIRFILT_BLOCK_LEN ? _n : LIQUID_FIRFILT_BLOCK_LEN;
+
+        // copy input to scratch buffer (permits in-place operation)
+        memmove(buf + m, _x, r*sizeof(TI));
+
+        // compute r output samples
+        for (i=0; i<r; i++) {
+            DOTPROD(_execute)(_q->dp, buf+i, &_y[i]);
+            _y[i] *= _q->scale;
+        }
+
+        _x += r;
+        _y += r;
+        _n -= r;
+
+        if (_n > 0) {
+            // shift history to the front of the scratch buffer
+            memmove(buf, buf + r, m*sizeof(TI));
+        } else {
+            // done: store last h_len samples back into circular buffer
+            _q->w_index = 0;
+            memmove(_q->w, buf + r - 1, (_q->h_len)*sizeof(TI));
+        }
+    }
+#endif
 }
 
 // get filter length
@@ -501,6 +1002,9 @@ void FIRFILT(_freqresponse)(FIRFILT()       _q,
                             float           _fc,
                             float complex * _H)
 {
+    // run any deferred design
+    FIRFILT(_prepare)(_q);
+
     unsigned int i;
     float complex H = 0.0f;
 
@@ -522,6 +1026,9 @@ void FIRFILT(_freqresponse)(FIRFILT()       _q,
 float FIRFILT(_groupdelay)(FIRFILT() _q,
                            float     _fc)
 {
+    // run any deferred design
+    FIRFILT(_prepare)(_q);
+
     // copy coefficients to be in correct order
     float h[_q->h_len];
     unsigned int i;
@@ -532,3 +1039,99 @@ float FIRFILT(_groupdelay)(FIRFILT() _q,
     return fir_group_delay(h, n, _fc);
 }
 
+// compute complex frequency response at uniformly-spaced frequencies
+// with a single transform rather than one evaluation per point
+//  _q      :   filter object
+//  _nfft   :   number of frequency points, _nfft > 0
+//  _H      :   output frequency response, [size: _nfft x 1], where
+//              _H[i] corresponds to frequency i/_nfft (upper half
+//              wrapping to negative frequencies as with an FFT)
+void FIRFILT(_freqresponse_block)(FIRFILT()       _q,
+                                  unsigned int    _nfft,
+                                  float complex * _H)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: firfilt_%s_freqresponse_block(), transform size must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // run any deferred design
+    FIRFILT(_prepare)(_q);
+
+    // create transform; inverse direction matches the
+    // exp{+j 2 pi fc i} convention of FIRFILT(_freqresponse)()
+    float complex buf_time[_nfft];
+    FFT_PLAN fft = FFT_CREATE_PLAN(_nfft, buf_time, _H, FFT_DIR_BACKWARD, FFT_METHOD);
+
+    // fold coefficients modulo the transform size; frequency samples
+    // of the aliased sequence equal the true response exactly
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        buf_time[i] = 0.0f;
+    for (i=0; i<_q->h_len; i++)
+        buf_time[i % _nfft] += _q->h[i];
+
+    // execute and clean up
+    FFT_EXECUTE(fft);
+    FFT_DESTROY_PLAN(fft);
+
+    // apply scaling
+    for (i=0; i<_nfft; i++)
+        _H[i] *= _q->scale;
+}
+
+// compute group delay at uniformly-spaced frequencies with two
+// transforms rather than one evaluation per point
+//  _q      :   filter object
+//  _nfft   :   number of frequency points, _nfft > 0
+//  _d      :   output group delay [samples], [size: _nfft x 1], where
+//              _d[i] corresponds to frequency i/_nfft (upper half
+//              wrapping to negative frequencies as with an FFT)
+void FIRFILT(_groupdelay_block)(FIRFILT()    _q,
+                                unsigned int _nfft,
+                                float *      _d)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: firfilt_%s_groupdelay_block(), transform size must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // run any deferred design
+    FIRFILT(_prepare)(_q);
+
+    // create transforms of the folded coefficients and the folded
+    // index-weighted coefficients; the group delay at each frequency
+    // is the real part of their ratio
+    float complex buf_time[_nfft];
+    float complex H0[_nfft];
+    float complex H1[_nfft];
+    FFT_PLAN fft0 = FFT_CREATE_PLAN(_nfft, buf_time, H0, FFT_DIR_BACKWARD, FFT_METHOD);
+    FFT_PLAN fft1 = FFT_CREATE_PLAN(_nfft, buf_time, H1, FFT_DIR_BACKWARD, FFT_METHOD);
+
+    // coefficients in natural order (internal array is reversed), as
+    // in FIRFILT(_groupdelay)()
+    unsigned int i;
+    unsigned int n = _q->h_len;
+    for (i=0; i<_nfft; i++)
+        buf_time[i] = 0.0f;
+    for (i=0; i<n; i++)
+        buf_time[i % _nfft] += crealf(_q->h[n-i-1]);
+    FFT_EXECUTE(fft0);
+
+    for (i=0; i<_nfft; i++)
+        buf_time[i] = 0.0f;
+    for (i=0; i<n; i++)
+        buf_time[i % _nfft] += crealf(_q->h[n-i-1]) * (float)i;
+    FFT_EXECUTE(fft1);
+
+    FFT_DESTROY_PLAN(fft0);
+    FFT_DESTROY_PLAN(fft1);
+
+    // compute ratio, guarding against division by zero in deep nulls
+    float tol = 1e-5f;
+    for (i=0; i<_nfft; i++)
+        _d[i] = cabsf(H0[i]) < tol ? 0.0f : crealf(H1[i]/H0[i]);
+}
+
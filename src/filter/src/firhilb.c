@@ -63,6 +63,15 @@ struct FIRHILB(_s) {
 
     // regular real-to-complex/complex-to-real operation
     unsigned int toggle;
+
+    // contiguous scratch buffers for block decimation (grow-only)
+    T *          block_buf;     // filter- and delay-branch streams
+    unsigned int block_cap;     // output capacity of scratch buffers
+
+    // fused mix-down for residual IF-to-baseband offset, applied to
+    // the decimator output
+    float        mix_dphi;      // frequency offset [radians/output sample]
+    float        mix_theta;     // accumulated mixer phase
 };
 
 // create firhilb object
@@ -116,6 +125,13 @@ FIRHILB() FIRHILB(_create)(unsigned int _m,
     // create internal dot product object
     q->dpq = DOTPROD(_create)(q->hq, q->hq_len);
 
+    // initialize block scratch buffers (allocated on first block call)
+    q->block_buf = NULL;
+    q->block_cap = 0;
+
+    // clear fused mixer frequency
+    q->mix_dphi = 0.0f;
+
     // reset internal state and return object
     FIRHILB(_reset)(q);
     return q;
@@ -138,6 +154,9 @@ void FIRHILB(_destroy)(FIRHILB() _q)
     free(_q->hc);
     free(_q->hq);
 
+    // free block scratch buffers
+    free(_q->block_buf);
+
     // free main object memory
     free(_q);
 }
@@ -171,6 +190,21 @@ void FIRHILB(_reset)(FIRHILB() _q)
 
     // reset toggle flag
     _q->toggle = 0;
+
+    // reset fused mixer phase
+    _q->mix_theta = 0.0f;
+}
+
+// set residual frequency offset of fused mixer; the offset is applied
+// as a mix-down on the decimator output, shifting a signal centered
+// slightly off the quarter-sample-rate IF to baseband without a
+// separate oscillator pass
+//  _q      :   firhilb object
+//  _dphi   :   frequency offset [radians/output sample]
+void FIRHILB(_set_freq)(FIRHILB() _q,
+                        float     _dphi)
+{
+    _q->mix_dphi = _dphi;
 }
 
 // execute Hilbert transform (real to complex)
@@ -287,7 +321,18 @@ void FIRHILB(_decim_execute)(FIRHILB()   _q,
 
     // set return value
     T complex v = yi + _Complex_I * yq;
-    *_y = _q->toggle ? -v : v;
+    v = _q->toggle ? -v : v;
+
+    // apply fused mix-down for residual IF offset
+    if (_q->mix_dphi != 0.0f || _q->mix_theta != 0.0f) {
+        v *= cexpf(-_Complex_I*_q->mix_theta);
+
+        // update and constrain mixer phase
+        _q->mix_theta += _q->mix_dphi;
+        if      (_q->mix_theta >  2*M_PI) _q->mix_theta -= 2*M_PI;
+        else if (_q->mix_theta < -2*M_PI) _q->mix_theta += 2*M_PI;
+    }
+    *_y = v;
 
     // toggle flag
     _q->toggle = 1 - _q->toggle;
@@ -305,9 +350,65 @@ void FIRHILB(_decim_execute_block)(FIRHILB()    _q,
                                    T complex *  _y)
 {
     unsigned int i;
+    if (_n == 0)
+        return;
+
+    // grow scratch buffers holding the de-interleaved filter- and
+    // delay-branch streams contiguously: [history | block]; running the
+    // dot products over a flat stream avoids the per-sample window
+    // push/read overhead of the interleaved path
+    if (_q->block_cap < _n) {
+        _q->block_cap = _n;
+        _q->block_buf = (T*) realloc(_q->block_buf,
+                (_q->hq_len-1 + _q->m + 2*_n)*sizeof(T));
+    }
+    T * qbuf = _q->block_buf;                       // filter branch
+    T * dbuf = _q->block_buf + _q->hq_len-1 + _n;   // delay branch
 
-    for (i=0; i<_n; i++)
-        FIRHILB(_decim_execute)(_q, &_x[2*i], &_y[i]);
+    // copy branch histories from window buffers: the most recent
+    // hq_len-1 filter-branch samples and m delay-branch samples
+    T * r;
+    WINDOW(_read)(_q->w1, &r);
+    memmove(qbuf, &r[1], (_q->hq_len-1)*sizeof(T));
+    WINDOW(_read)(_q->w0, &r);
+    memmove(dbuf, &r[_q->m], (_q->m)*sizeof(T));
+
+    // de-interleave input block into branch streams
+    for (i=0; i<_n; i++) {
+        qbuf[_q->hq_len-1 + i] = _x[2*i  ];
+        dbuf[_q->m        + i] = _x[2*i+1];
+    }
+
+    // run filter over the contiguous stream; the polyphase split
+    // already skips the zero coefficients of the half-band design so
+    // only the 2*m non-zero taps are computed per output
+    for (i=0; i<_n; i++) {
+        T yq;
+        DOTPROD(_execute)(_q->dpq, &qbuf[i], &yq);
+        T complex v = dbuf[i] + _Complex_I * yq;
+        _y[i] = ((_q->toggle + i) & 1) ? -v : v;
+    }
+
+    // apply fused mix-down for residual IF-to-baseband offset using a
+    // phasor recurrence rather than a trigonometric call per sample
+    if (_q->mix_dphi != 0.0f || _q->mix_theta != 0.0f) {
+        T complex phasor = cexpf(-_Complex_I*_q->mix_theta);
+        T complex step   = cexpf(-_Complex_I*_q->mix_dphi);
+        for (i=0; i<_n; i++) {
+            _y[i] *= phasor;
+            phasor *= step;
+        }
+
+        // update and constrain mixer phase
+        _q->mix_theta = fmodf(_q->mix_theta + _n*_q->mix_dphi, 2*M_PI);
+    }
+
+    // write block samples back into window buffers for subsequent calls
+    WINDOW(_write)(_q->w1, &qbuf[_q->hq_len-1], _n);
+    WINDOW(_write)(_q->w0, &dbuf[_q->m       ], _n);
+
+    // update toggle flag for _n outputs
+    _q->toggle = (_q->toggle + _n) & 1;
 }
 
 // execute Hilbert transform interpolator (complex to real)
@@ -37,6 +37,8 @@ struct FIRPFB(_s) {
     WINDOW() w;                 // window buffer
     DOTPROD() * dp;             // array of vector dot product objects
     TC scale;                   // output scaling factor
+    unsigned int * nref;        // filter bank reference count (see clone_shared)
+    int w_shared;               // window buffer owned by another object?
 };
 
 // create firpfb from external coefficients
@@ -89,6 +91,13 @@ FIRPFB() FIRPFB(_create)(unsigned int _M,
     // create window buffer
     q->w = WINDOW(_create)(q->h_sub_len);
 
+    // filter bank is not (yet) shared with any clone
+    q->nref  = (unsigned int*) malloc(sizeof(unsigned int));
+    *q->nref = 1;
+
+    // window buffer is owned by this object
+    q->w_shared = 0;
+
     // set default scaling
     q->scale = 1;
 
@@ -250,6 +259,12 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,
                            TC *         _h,
                            unsigned int _h_len)
 {
+    // validate input
+    if (*_q->nref > 1) {
+        fprintf(stderr,"error: firpfb_%s_recreate(), cannot re-create filter bank with shared coefficients\n", EXTENSION_FULL);
+        exit(1);
+    }
+
     // check to see if filter length has changed
     if (_h_len != _q->h_len || _M != _q->num_filters) {
         // filter length has changed: recreate entire filter
@@ -272,14 +287,76 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,
     return _q;
 }
 
+// create clone of firpfb object sharing the original's (immutable)
+// filter bank; the clone has its own buffer state so it may run on an
+// independent sample stream, but the bank of dot product objects is
+// reference counted rather than duplicated, keeping the per-instance
+// memory footprint to just the buffer
+//  _q      :   original firpfb object
+FIRPFB() FIRPFB(_clone_shared)(FIRPFB() _q)
+{
+    // create object and copy all static parameters
+    FIRPFB() q = (FIRPFB()) malloc(sizeof(struct FIRPFB(_s)));
+    memmove(q, _q, sizeof(struct FIRPFB(_s)));
+
+    // dot product objects are shared; increment the common reference count
+    (*q->nref)++;
+
+    // create independent window buffer for the clone
+    q->w = WINDOW(_create)(q->h_sub_len);
+    q->w_shared = 0;
+
+    // reset object and return
+    FIRPFB(_reset)(q);
+    return q;
+}
+
+// create firpfb object with its own coefficients but running against
+// another bank's window buffer; samples pushed into either object are
+// seen by both, so a pair of banks (e.g. a matched filter and its
+// derivative) filters one stream in a single combined polyphase pass
+// without duplicating buffer state
+//  _base   : firpfb object owning the window buffer
+//  _h      : coefficients [size: _h_len x 1]
+//  _h_len  : filter length, must match that of _base
+FIRPFB() FIRPFB(_create_shared_window)(FIRPFB()     _base,
+                                       TC *         _h,
+                                       unsigned int _h_len)
+{
+    // validate input; the banks must have identical geometry as they
+    // index the same buffer
+    if (_h_len != _base->h_len) {
+        fprintf(stderr,"error: firpfb_%s_create_shared_window(), filter length (%u) must match base object (%u)\n",
+                EXTENSION_FULL, _h_len, _base->h_len);
+        exit(1);
+    }
+
+    // create object with its own coefficient bank
+    FIRPFB() q = FIRPFB(_create)(_base->num_filters, _h, _h_len);
+
+    // replace window buffer with the base object's
+    WINDOW(_destroy)(q->w);
+    q->w        = _base->w;
+    q->w_shared = 1;
+    return q;
+}
+
 // destroy firpfb object, freeing all internal memory
 void FIRPFB(_destroy)(FIRPFB() _q)
 {
-    unsigned int i;
-    for (i=0; i<_q->num_filters; i++)
-        DOTPROD(_destroy)(_q->dp[i]);
-    free(_q->dp);
-    WINDOW(_destroy)(_q->w);
+    // filter bank may be shared among clones (see clone_shared);
+    // free it only with the last reference
+    (*_q->nref)--;
+    if (*_q->nref == 0) {
+        unsigned int i;
+        for (i=0; i<_q->num_filters; i++)
+            DOTPROD(_destroy)(_q->dp[i]);
+        free(_q->dp);
+        free(_q->nref);
+    }
+    // window buffer may be owned by another object (see create_shared_window)
+    if (!_q->w_shared)
+        WINDOW(_destroy)(_q->w);
     free(_q);
 }
 
@@ -301,7 +378,9 @@ void FIRPFB(_print)(FIRPFB() _q)
 // clear/reset firpfb object internal state
 void FIRPFB(_reset)(FIRPFB() _q)
 {
-    WINDOW(_reset)(_q->w);
+    // shared window buffers are reset by their owning object
+    if (!_q->w_shared)
+        WINDOW(_reset)(_q->w);
 }
 
 // set output scaling for filter
@@ -325,6 +404,28 @@ void FIRPFB(_push)(FIRPFB() _q, TI _x)
     WINDOW(_push)(_q->w, _x);
 }
 
+// execute all filters in the bank on the internal buffer, reading the
+// buffer state only once; useful when every output of the bank is
+// needed for the same input state (e.g. interpolation)
+//  _q      : firpfb object
+//  _y      : output sample array [size: num_filters x 1]
+void FIRPFB(_execute_all)(FIRPFB() _q,
+                          TO *     _y)
+{
+    // read buffer
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+
+    // execute dot product for each filter in the bank
+    unsigned int i;
+    for (i=0; i<_q->num_filters; i++) {
+        DOTPROD(_execute)(_q->dp[i], r, &_y[i]);
+
+        // apply scaling factor
+        _y[i] *= _q->scale;
+    }
+}
+
 // execute the filter on internal buffer and coefficients
 //  _q      : firpfb object
 //  _i      : index of filter to use
@@ -351,6 +452,42 @@ void FIRPFB(_execute)(FIRPFB()     _q,
     *_y *= _q->scale;
 }
 
+// execute two filter banks at the same index in one fused pass over the
+// first object's internal buffer (e.g. matched and derivative matched
+// filters in timing recovery); only _q0's buffer is read
+//  _q0     : first firpfb object (provides the input buffer)
+//  _q1     : second firpfb object
+//  _i      : index of filter to use
+//  _y0     : pointer to first output sample
+//  _y1     : pointer to second output sample
+void FIRPFB(_execute_pair)(FIRPFB()     _q0,
+                           FIRPFB()     _q1,
+                           unsigned int _i,
+                           TO *         _y0,
+                           TO *         _y1)
+{
+    // validate input
+    if (_i >= _q0->num_filters || _i >= _q1->num_filters) {
+        fprintf(stderr,"error: firpfb_execute_pair(), filterbank index (%u) exceeds maximum (%u)\n",
+                _i, _q0->num_filters < _q1->num_filters ? _q0->num_filters : _q1->num_filters);
+        exit(1);
+    } else if (_q0->h_sub_len != _q1->h_sub_len) {
+        fprintf(stderr,"error: firpfb_execute_pair(), filterbank dimensions must match\n");
+        exit(1);
+    }
+
+    // read buffer (first object only)
+    TI *r;
+    WINDOW(_read)(_q0->w, &r);
+
+    // execute fused dot product pair against common input window
+    DOTPROD(_execute_pair)(_q0->dp[_i], _q1->dp[_i], r, _y0, _y1);
+
+    // apply scaling factors
+    *_y0 *= _q0->scale;
+    *_y1 *= _q1->scale;
+}
+
 // execute the filter on a block of input samples; the
 // input and output buffers may be the same
 //  _q      : firpfb object
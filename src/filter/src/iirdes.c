@@ -456,55 +456,74 @@ void iirdes_dzpk_lp2bp(liquid_float_complex * _zd,
     }
 }
 
-// IIR filter design template
+// iirdes object: cached analog prototype for incremental redesign
+//
+// The analog prototype (Butterworth/Chebyshev/elliptic/Bessel root
+// finding) depends only on the filter type, order, and ripple
+// specifications; the cut-off and center frequencies enter only through
+// the bilinear transform and the digital frequency transformations.
+// Caching the analog zeros/poles/gain lets the frequency mapping be
+// re-applied cheaply when only the band edges change, e.g. when
+// re-tuning a bank of notch filters.
+struct iirdes_s {
+    // design parameters
+    liquid_iirdes_filtertype ftype;     // filter type
+    liquid_iirdes_bandtype   btype;     // band type
+    liquid_iirdes_format     format;    // coefficients format
+    unsigned int             n;         // filter order
+    float                    Ap;        // pass-band ripple [dB]
+    float                    As;        // stop-band ripple [dB]
+
+    // cached analog prototype
+    unsigned int    nza;    // number of analog zeros
+    float complex * za;     // analog zeros,  [size: n x 1]
+    float complex * pa;     // analog poles,  [size: n x 1]
+    float complex   ka;     // analog gain
+    float complex   k0;     // nominal digital gain
+};
+
+// create iirdes object, computing and caching the analog prototype
 //  _ftype      :   filter type (e.g. LIQUID_IIRDES_BUTTER)
 //  _btype      :   band type (e.g. LIQUID_IIRDES_BANDPASS)
 //  _format     :   coefficients format (e.g. LIQUID_IIRDES_SOS)
 //  _n          :   filter order
-//  _fc         :   low-pass prototype cut-off frequency
-//  _f0         :   center frequency (band-pass, band-stop)
 //  _Ap         :   pass-band ripple in dB
 //  _As         :   stop-band ripple in dB
-//  _B          :   numerator
-//  _A          :   denominator
-void liquid_iirdes(liquid_iirdes_filtertype _ftype,
-                   liquid_iirdes_bandtype   _btype,
-                   liquid_iirdes_format     _format,
-                   unsigned int _n,
-                   float _fc,
-                   float _f0,
-                   float _Ap,
-                   float _As,
-                   float * _B,
-                   float * _A)
+iirdes iirdes_create(liquid_iirdes_filtertype _ftype,
+                     liquid_iirdes_bandtype   _btype,
+                     liquid_iirdes_format     _format,
+                     unsigned int             _n,
+                     float                    _Ap,
+                     float                    _As)
 {
     // validate input
-    if (_fc <= 0 || _fc >= 0.5) {
-        fprintf(stderr,"error: liquid_iirdes(), cutoff frequency out of range\n");
-        exit(1);
-    } else if (_f0 < 0 || _f0 > 0.5) {
-        fprintf(stderr,"error: liquid_iirdes(), center frequency out of range\n");
-        exit(1);
-    } else if (_Ap <= 0) {
-        fprintf(stderr,"error: liquid_iirdes(), pass-band ripple out of range\n");
+    if (_Ap <= 0) {
+        fprintf(stderr,"error: iirdes_create(), pass-band ripple out of range\n");
         exit(1);
     } else if (_As <= 0) {
-        fprintf(stderr,"error: liquid_iirdes(), stop-band ripple out of range\n");
+        fprintf(stderr,"error: iirdes_create(), stop-band ripple out of range\n");
         exit(1);
     } else if (_n == 0) {
-        fprintf(stderr,"error: liquid_iirdes(), filter order must be > 0\n");
+        fprintf(stderr,"error: iirdes_create(), filter order must be > 0\n");
         exit(1);
     }
 
-    // number of analaog poles/zeros
-    unsigned int npa = _n;
-    unsigned int nza;
-
-    // analog poles/zeros/gain
-    float complex pa[_n];
-    float complex za[_n];
-    float complex ka;
-    float complex k0 = 1.0f; // nominal digital gain
+    // create object and set design parameters
+    iirdes q  = (iirdes) malloc(sizeof(struct iirdes_s));
+    q->ftype  = _ftype;
+    q->btype  = _btype;
+    q->format = _format;
+    q->n      = _n;
+    q->Ap     = _Ap;
+    q->As     = _As;
+
+    // allocate memory for analog zeros, poles; the pole array holds
+    // one extra entry as the Bessel design computes the roots of the
+    // order-(n+1) polynomial, writing n+1 values before the first n
+    // are retained
+    q->za = (float complex*) malloc( q->n   *sizeof(float complex));
+    q->pa = (float complex*) malloc((q->n+1)*sizeof(float complex));
+    q->k0 = 1.0f;   // nominal digital gain
 
     // derived values
     unsigned int r = _n%2;      // odd/even filter order
@@ -517,149 +536,237 @@ void liquid_iirdes(liquid_iirdes_filtertype _ftype,
     switch (_ftype) {
     case LIQUID_IIRDES_BUTTER:
         // Butterworth filter design : no zeros, _n poles
-        nza = 0;
-        k0 = 1.0f;
-        butter_azpkf(_n,za,pa,&ka);
+        q->nza = 0;
+        q->k0 = 1.0f;
+        butter_azpkf(_n,q->za,q->pa,&q->ka);
         break;
     case LIQUID_IIRDES_CHEBY1:
         // Cheby-I filter design : no zeros, _n poles, pass-band ripple
-        nza = 0;
+        q->nza = 0;
         epsilon = sqrtf( powf(10.0f, _Ap / 10.0f) - 1.0f );
-        k0 = r ? 1.0f : 1.0f / sqrt(1.0f + epsilon*epsilon);
-        cheby1_azpkf(_n,epsilon,za,pa,&ka);
+        q->k0 = r ? 1.0f : 1.0f / sqrt(1.0f + epsilon*epsilon);
+        cheby1_azpkf(_n,epsilon,q->za,q->pa,&q->ka);
         break;
     case LIQUID_IIRDES_CHEBY2:
         // Cheby-II filter design : _n-r zeros, _n poles, stop-band ripple
-        nza = 2*L;
+        q->nza = 2*L;
         epsilon = powf(10.0f, -_As/20.0f);
-        k0 = 1.0f;
-        cheby2_azpkf(_n,epsilon,za,pa,&ka);
+        q->k0 = 1.0f;
+        cheby2_azpkf(_n,epsilon,q->za,q->pa,&q->ka);
         break;
     case LIQUID_IIRDES_ELLIP:
         // elliptic filter design : _n-r zeros, _n poles, pass/stop-band ripple
-        nza = 2*L;
+        q->nza = 2*L;
         Gp = powf(10.0f, -_Ap / 20.0f);     // pass-band gain
         Gs = powf(10.0f, -_As / 20.0f);     // stop-band gain
         ep = sqrtf(1.0f/(Gp*Gp) - 1.0f);    // pass-band epsilon
         es = sqrtf(1.0f/(Gs*Gs) - 1.0f);    // stop-band epsilon
-        k0 = r ? 1.0f : 1.0f / sqrt(1.0f + ep*ep);
-        ellip_azpkf(_n,ep,es,za,pa,&ka);
+        q->k0 = r ? 1.0f : 1.0f / sqrt(1.0f + ep*ep);
+        ellip_azpkf(_n,ep,es,q->za,q->pa,&q->ka);
         break;
     case LIQUID_IIRDES_BESSEL:
         // Bessel filter design : no zeros, _n poles
-        nza = 0;
-        k0 = 1.0f;
-        bessel_azpkf(_n,za,pa,&ka);
+        q->nza = 0;
+        q->k0 = 1.0f;
+        bessel_azpkf(_n,q->za,q->pa,&q->ka);
         break;
     default:
-        fprintf(stderr,"error: liquid_iirdes(), unknown filter type\n");
+        fprintf(stderr,"error: iirdes_create(), unknown filter type\n");
         exit(1);
     }
 
-#if LIQUID_IIRDES_DEBUG_PRINT
+    return q;
+}
+
+// destroy iirdes object, freeing all internal memory
+void iirdes_destroy(iirdes _q)
+{
+    // free analog prototype arrays
+    free(_q->za);
+    free(_q->pa);
+
+    // free main object memory
+    free(_q);
+}
+
+// print iirdes object internals
+void iirdes_print(iirdes _q)
+{
+    printf("iirdes: order=%u, Ap=%.3f dB, As=%.3f dB\n", _q->n, _q->Ap, _q->As);
     unsigned int i;
+    printf("  analog zeros (%u):\n", _q->nza);
+    for (i=0; i<_q->nza; i++)
+        printf("    za[%3u] = %12.8f + j*%12.8f\n", i, crealf(_q->za[i]), cimagf(_q->za[i]));
+    printf("  analog poles (%u):\n", _q->n);
+    for (i=0; i<_q->n; i++)
+        printf("    pa[%3u] = %12.8f + j*%12.8f\n", i, crealf(_q->pa[i]), cimagf(_q->pa[i]));
+}
 
-    printf("poles (analog):\n");
-    for (i=0; i<npa; i++)
-        printf("  pa[%3u] = %12.8f + j*%12.8f\n", i, crealf(pa[i]), cimagf(pa[i]));
-    printf("zeros (analog):\n");
-    for (i=0; i<nza; i++)
-        printf("  za[%3u] = %12.8f + j*%12.8f\n", i, crealf(za[i]), cimagf(za[i]));
-    printf("gain (analog):\n");
-    printf("  ka : %12.8f + j*%12.8f\n", crealf(ka), cimagf(ka));
-#endif
+// get number of output coefficients in each of B and A for a single
+// design (e.g. the stride between designs in iirdes_execute_batch)
+unsigned int iirdes_get_num_coefficients(iirdes _q)
+{
+    // effective digital filter order; band transformations double it
+    unsigned int n = _q->n;
+    if (_q->btype == LIQUID_IIRDES_BANDPASS ||
+        _q->btype == LIQUID_IIRDES_BANDSTOP)
+    {
+        n *= 2;
+    }
+
+    if (_q->format == LIQUID_IIRDES_TF)
+        return n + 1;
+
+    // second-order sections: 3 coefficients for each of L+r sections
+    unsigned int r = n%2;
+    unsigned int L = (n-r)/2;
+    return 3*(L+r);
+}
+
+// re-apply the frequency transformation to the cached analog prototype,
+// producing filter coefficients for new band edges without repeating
+// the analog root finding
+//  _q      :   iirdes object
+//  _fc     :   low-pass prototype cut-off frequency
+//  _f0     :   center frequency (band-pass, band-stop)
+//  _B      :   numerator,   [size: iirdes_get_num_coefficients(_q) x 1]
+//  _A      :   denominator, [size: iirdes_get_num_coefficients(_q) x 1]
+void iirdes_execute(iirdes  _q,
+                    float   _fc,
+                    float   _f0,
+                    float * _B,
+                    float * _A)
+{
+    // validate input
+    if (_fc <= 0 || _fc >= 0.5) {
+        fprintf(stderr,"error: iirdes_execute(), cutoff frequency out of range\n");
+        exit(1);
+    } else if (_f0 < 0 || _f0 > 0.5) {
+        fprintf(stderr,"error: iirdes_execute(), center frequency out of range\n");
+        exit(1);
+    }
+
+    unsigned int n = _q->n;
 
     // complex digital poles/zeros/gain
     // NOTE: allocated double the filter order to cover band-pass, band-stop cases
-    float complex zd[2*_n];
-    float complex pd[2*_n];
+    float complex zd[2*n];
+    float complex pd[2*n];
     float complex kd;
-    float m = iirdes_freqprewarp(_btype,_fc,_f0);
-    //printf("m : %12.8f\n", m);
-    bilinear_zpkf(za,    nza,
-                  pa,    npa,
-                  k0,    m,
+    float m = iirdes_freqprewarp(_q->btype,_fc,_f0);
+    bilinear_zpkf(_q->za, _q->nza,
+                  _q->pa, n,
+                  _q->k0, m,
                   zd, pd, &kd);
 
-#if LIQUID_IIRDES_DEBUG_PRINT
-    printf("zeros (digital, low-pass prototype):\n");
-    for (i=0; i<_n; i++)
-        printf("  zd[%3u] = %12.4e + j*%12.4e;\n", i, crealf(zd[i]), cimagf(zd[i]));
-    printf("poles (digital, low-pass prototype):\n");
-    for (i=0; i<_n; i++)
-        printf("  pd[%3u] = %12.4e + j*%12.4e;\n", i, crealf(pd[i]), cimagf(pd[i]));
-    printf("gain (digital):\n");
-    printf("  kd : %12.8f + j*%12.8f\n", crealf(kd), cimagf(kd));
-#endif
-
     // negate zeros, poles for high-pass and band-stop cases
-    if (_btype == LIQUID_IIRDES_HIGHPASS ||
-        _btype == LIQUID_IIRDES_BANDSTOP)
+    if (_q->btype == LIQUID_IIRDES_HIGHPASS ||
+        _q->btype == LIQUID_IIRDES_BANDSTOP)
     {
         // run transform, place resulting zeros, poles
         // back in same original arrays
-        iirdes_dzpk_lp2hp(zd, pd, _n, zd, pd);
+        iirdes_dzpk_lp2hp(zd, pd, n, zd, pd);
     }
 
     // transform zeros, poles in band-pass, band-stop cases
     // NOTE: this also doubles the filter order
-    if (_btype == LIQUID_IIRDES_BANDPASS ||
-        _btype == LIQUID_IIRDES_BANDSTOP)
+    if (_q->btype == LIQUID_IIRDES_BANDPASS ||
+        _q->btype == LIQUID_IIRDES_BANDSTOP)
     {
         // allocate memory for transformed zeros, poles
-        float complex zd1[2*_n];
-        float complex pd1[2*_n];
+        float complex zd1[2*n];
+        float complex pd1[2*n];
 
         // run zeros, poles low-pass -> band-pass trasform
         iirdes_dzpk_lp2bp(zd, pd,   // low-pass prototype zeros, poles
-                          _n,       // filter order
+                          n,        // filter order
                           _f0,      // center frequency
                           zd1,pd1); // transformed zeros, poles (length: 2*n)
 
         // copy transformed zeros, poles
-        memmove(zd, zd1, 2*_n*sizeof(float complex));
-        memmove(pd, pd1, 2*_n*sizeof(float complex));
+        memmove(zd, zd1, 2*n*sizeof(float complex));
+        memmove(pd, pd1, 2*n*sizeof(float complex));
 
-        // update paramters; filter order doubles which changes the
+        // update parameters; filter order doubles which changes the
         // number of second-order sections and forces there to never
         // be any remainder (r=0 always).
-        _n =  2*_n;     // _n is now even
-#if LIQUID_IIRDES_DEBUG_PRINT
-        r  = _n % 2;    //  r is now zero
-        L  = (_n-r)/2;  //  L is now the original value of _n
-#endif
+        n = 2*n;    // n is now even
     }
 
-    if (_format == LIQUID_IIRDES_TF) {
+    if (_q->format == LIQUID_IIRDES_TF) {
         // convert complex digital poles/zeros/gain into transfer
         // function : H(z) = B(z) / A(z)
-        // where length(B,A) = low/high-pass ? _n + 1 : 2*_n + 1
-        iirdes_dzpk2tff(zd,pd,_n,kd,_B,_A);
-
-#if LIQUID_IIRDES_DEBUG_PRINT
-        // print coefficients
-        for (i=0; i<=_n; i++) printf("b[%3u] = %12.8f;\n", i, _B[i]);
-        for (i=0; i<=_n; i++) printf("a[%3u] = %12.8f;\n", i, _A[i]);
-#endif
+        // where length(B,A) = low/high-pass ? n + 1 : 2*n + 1
+        iirdes_dzpk2tff(zd,pd,n,kd,_B,_A);
     } else {
         // convert complex digital poles/zeros/gain into second-
         // order sections form :
         // H(z) = prod { (b0 + b1*z^-1 + b2*z^-2) / (a0 + a1*z^-1 + a2*z^-2) }
         // where size(B,A) = low|high-pass  : [3]x[L+r]
         //                   band-pass|stop : [3]x[2*L]
-        iirdes_dzpk2sosf(zd,pd,_n,kd,_B,_A);
+        iirdes_dzpk2sosf(zd,pd,n,kd,_B,_A);
+    }
+}
 
-#if LIQUID_IIRDES_DEBUG_PRINT
-        // print coefficients
-        printf("B [%u x 3] :\n", L+r);
-        for (i=0; i<L+r; i++)
-            printf("  %12.8f %12.8f %12.8f\n", _B[3*i+0], _B[3*i+1], _B[3*i+2]);
-        printf("A [%u x 3] :\n", L+r);
-        for (i=0; i<L+r; i++)
-            printf("  %12.8f %12.8f %12.8f\n", _A[3*i+0], _A[3*i+1], _A[3*i+2]);
-#endif
+// generate coefficient sets for an array of band edges from a single
+// cached analog prototype, e.g. a bank of notch filters with different
+// center frequencies; design i is written with a stride of
+// iirdes_get_num_coefficients(_q) into each of _B and _A
+//  _q      :   iirdes object
+//  _fc     :   low-pass prototype cut-off frequencies,  [size: _num x 1]
+//  _f0     :   center frequencies (band-pass, -stop),   [size: _num x 1]
+//  _num    :   number of designs to generate
+//  _B      :   numerators,   [size: _num*iirdes_get_num_coefficients(_q) x 1]
+//  _A      :   denominators, [size: _num*iirdes_get_num_coefficients(_q) x 1]
+void iirdes_execute_batch(iirdes       _q,
+                          float *      _fc,
+                          float *      _f0,
+                          unsigned int _num,
+                          float *      _B,
+                          float *      _A)
+{
+    unsigned int stride = iirdes_get_num_coefficients(_q);
+    unsigned int i;
+    for (i=0; i<_num; i++)
+        iirdes_execute(_q, _fc[i], _f0[i], _B + i*stride, _A + i*stride);
+}
 
+// IIR filter design template
+//  _ftype      :   filter type (e.g. LIQUID_IIRDES_BUTTER)
+//  _btype      :   band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _format     :   coefficients format (e.g. LIQUID_IIRDES_SOS)
+//  _n          :   filter order
+//  _fc         :   low-pass prototype cut-off frequency
+//  _f0         :   center frequency (band-pass, band-stop)
+//  _Ap         :   pass-band ripple in dB
+//  _As         :   stop-band ripple in dB
+//  _B          :   numerator
+//  _A          :   denominator
+void liquid_iirdes(liquid_iirdes_filtertype _ftype,
+                   liquid_iirdes_bandtype   _btype,
+                   liquid_iirdes_format     _format,
+                   unsigned int _n,
+                   float _fc,
+                   float _f0,
+                   float _Ap,
+                   float _As,
+                   float * _B,
+                   float * _A)
+{
+    // validate input
+    if (_fc <= 0 || _fc >= 0.5) {
+        fprintf(stderr,"error: liquid_iirdes(), cutoff frequency out of range\n");
+        exit(1);
+    } else if (_f0 < 0 || _f0 > 0.5) {
+        fprintf(stderr,"error: liquid_iirdes(), center frequency out of range\n");
+        exit(1);
     }
+
+    // compute analog prototype, apply frequency transformation, and
+    // discard the cached design
+    iirdes q = iirdes_create(_ftype, _btype, _format, _n, _Ap, _As);
+    iirdes_execute(q, _fc, _f0, _B, _A);
+    iirdes_destroy(q);
 }
 
 // checks stability of iir filter
@@ -58,17 +58,33 @@ struct IIRFILT(_s) {
     // filter structure type
     enum {
         IIRFILT_TYPE_NORM=0,
-        IIRFILT_TYPE_SOS
+        IIRFILT_TYPE_SOS,
+        IIRFILT_TYPE_TRANS
     } type;
 
+    // transposed direct-form II engine with wide-precision state
+    TW * bt;            // zero-padded feed-forward coefficients [size: n]
+    TW * at;            // zero-padded feed-back coefficients [size: n]
+    TW * wt;            // transposed-form state registers [size: n]
+
 #if LIQUID_IIRFILT_USE_DOTPROD
     DOTPROD() dpb;      // numerator dot product
     DOTPROD() dpa;      // denominator dot product
 #endif
 
-    // second-order sections 
+    // second-order sections
     IIRFILTSOS() * qsos;    // second-order sections filters
     unsigned int nsos;      // number of second-order sections
+
+    // stage-major coefficients and state scratch arrays for the block
+    // cascade engine [size: nsos x 1 each]
+    TC * sos_b0;            // feed-forward coefficients across stages
+    TC * sos_b1;
+    TC * sos_b2;
+    TC * sos_a1;            // feed-back coefficients across stages
+    TC * sos_a2;
+    TO * sos_v1;            // direct-form II state across stages
+    TO * sos_v2;
 };
 
 // initialize internal objects/arrays
@@ -79,6 +95,16 @@ void IIRFILT(_init)(IIRFILT() _q)
     _q->v    = NULL;
     _q->qsos = NULL;
     _q->nsos = 0;
+    _q->sos_b0 = NULL;
+    _q->sos_b1 = NULL;
+    _q->sos_b2 = NULL;
+    _q->sos_a1 = NULL;
+    _q->sos_a2 = NULL;
+    _q->sos_v1 = NULL;
+    _q->sos_v2 = NULL;
+    _q->bt   = NULL;
+    _q->at   = NULL;
+    _q->wt   = NULL;
 #if LIQUID_IIRFILT_USE_DOTPROD
     _q->dpb  = NULL;
     _q->dpa  = NULL;
@@ -150,6 +176,39 @@ IIRFILT() IIRFILT(_create)(TC *         _b,
     return q;
 }
 
+// create iirfilt object using transposed direct-form II structure with
+// wide-precision state registers; the shorter error-feedback paths and
+// double-precision accumulation keep long-running filters numerically
+// stable without periodic re-creation
+//  _b      :   numerator, feed-forward coefficients [size: _nb x 1]
+//  _nb     :   length of numerator
+//  _a      :   denominator, feed-back coefficients [size: _na x 1]
+//  _na     :   length of denominator
+IIRFILT() IIRFILT(_create_trans)(TC *         _b,
+                                 unsigned int _nb,
+                                 TC *         _a,
+                                 unsigned int _na)
+{
+    // create object with regular structure (validates input and
+    // normalizes coefficients to _a[0])
+    IIRFILT() q = IIRFILT(_create)(_b, _nb, _a, _na);
+    q->type = IIRFILT_TYPE_TRANS;
+
+    // copy coefficients into zero-padded wide-precision arrays
+    q->bt = (TW *) malloc((q->n)*sizeof(TW));
+    q->at = (TW *) malloc((q->n)*sizeof(TW));
+    q->wt = (TW *) malloc((q->n)*sizeof(TW));
+    unsigned int i;
+    for (i=0; i<q->n; i++) {
+        q->bt[i] = i < q->nb ? q->b[i] : 0;
+        q->at[i] = i < q->na ? q->a[i] : 0;
+    }
+
+    // reset object and return
+    IIRFILT(_reset)(q);
+    return q;
+}
+
 // create iirfilt (infinite impulse response filter) object based
 // on second-order sections form
 //  _B      :   numerator, feed-forward coefficients [size: _nsos x 3]
@@ -196,6 +255,24 @@ IIRFILT() IIRFILT(_create_sos)(TC *         _B,
         q->qsos[i] = IIRFILTSOS(_create)(bt,at);
         //q->qsos[i] = IIRFILT(_create)(q->b+3*i,3,q->a+3*i,3);
     }
+
+    // copy coefficients into stage-major arrays (normalized to each
+    // section's a0) for the block cascade engine
+    q->sos_b0 = (TC *) malloc((q->nsos)*sizeof(TC));
+    q->sos_b1 = (TC *) malloc((q->nsos)*sizeof(TC));
+    q->sos_b2 = (TC *) malloc((q->nsos)*sizeof(TC));
+    q->sos_a1 = (TC *) malloc((q->nsos)*sizeof(TC));
+    q->sos_a2 = (TC *) malloc((q->nsos)*sizeof(TC));
+    q->sos_v1 = (TO *) malloc((q->nsos)*sizeof(TO));
+    q->sos_v2 = (TO *) malloc((q->nsos)*sizeof(TO));
+    for (i=0; i<q->nsos; i++) {
+        TC a0 = q->a[3*i+0];
+        q->sos_b0[i] = q->b[3*i+0] / a0;
+        q->sos_b1[i] = q->b[3*i+1] / a0;
+        q->sos_b2[i] = q->b[3*i+2] / a0;
+        q->sos_a1[i] = q->a[3*i+1] / a0;
+        q->sos_a2[i] = q->a[3*i+2] / a0;
+    }
     return q;
 }
 
@@ -449,8 +526,22 @@ void IIRFILT(_destroy)(IIRFILT() _q)
         for (i=0; i<_q->nsos; i++)
             IIRFILTSOS(_destroy)(_q->qsos[i]);
         free(_q->qsos);
+
+        // free stage-major arrays for block cascade engine
+        free(_q->sos_b0);
+        free(_q->sos_b1);
+        free(_q->sos_b2);
+        free(_q->sos_a1);
+        free(_q->sos_a2);
+        free(_q->sos_v1);
+        free(_q->sos_v2);
     }
 
+    // free transposed-form coefficient and state arrays
+    if (_q->bt != NULL) free(_q->bt);
+    if (_q->at != NULL) free(_q->at);
+    if (_q->wt != NULL) free(_q->wt);
+
     // free main object memory
     free(_q);
 }
@@ -458,7 +549,8 @@ void IIRFILT(_destroy)(IIRFILT() _q)
 // print iirfilt object internals
 void IIRFILT(_print)(IIRFILT() _q)
 {
-    printf("iir filter [%s]:\n", _q->type == IIRFILT_TYPE_NORM ? "normal" : "sos");
+    printf("iir filter [%s]:\n", _q->type == IIRFILT_TYPE_SOS  ? "sos" :
+                                 _q->type == IIRFILT_TYPE_TRANS? "trans" : "normal");
     unsigned int i;
 
     if (_q->type == IIRFILT_TYPE_SOS) {
@@ -500,6 +592,12 @@ void IIRFILT(_reset)(IIRFILT() _q)
         for (i=0; i<_q->n; i++)
             _q->v[i] = 0;
     }
+
+    // clear transposed-form state registers
+    if (_q->wt != NULL) {
+        for (i=0; i<_q->n; i++)
+            _q->wt[i] = 0;
+    }
 }
 
 // execute normal iir filter using traditional numerator/denominator
@@ -543,6 +641,29 @@ void IIRFILT(_execute_norm)(IIRFILT() _q,
 #endif
 }
 
+// execute iir filter using transposed direct-form II structure with
+// wide-precision state registers
+//  _q      :   iirfilt object
+//  _x      :   input sample
+//  _y      :   output sample
+void IIRFILT(_execute_trans)(IIRFILT() _q,
+                             TI        _x,
+                             TO *      _y)
+{
+    unsigned int i;
+
+    // compute output from input and first state register
+    TW x = _x;
+    TW y = _q->bt[0]*x + _q->wt[0];
+
+    // update state registers; the last register remains zero
+    for (i=1; i<_q->n; i++)
+        _q->wt[i-1] = _q->bt[i]*x + _q->wt[i] - _q->at[i]*y;
+
+    // set return value
+    *_y = (TO) y;
+}
+
 // execute iir filter using second-order sections form
 //  _q      :   iirfilt object
 //  _x      :   input sample
@@ -564,6 +685,71 @@ void IIRFILT(_execute_sos)(IIRFILT() _q,
     *_y = t1;
 }
 
+// execute iir filter on a block of samples using the second-order
+// sections cascade engine. Samples are pipelined along the cascade
+// diagonal: within each tick, stage s processes sample (t-s), so the
+// stage recurrences are independent of one another and the inner loop
+// runs across stages from the stage-major coefficient arrays. The
+// pipeline is drained at the end of the block so the resulting state
+// and output match sequential execution exactly.
+//  _q      : iirfilt object
+//  _x      : input sample array [size: _n x 1]
+//  _n      : number of input, output samples
+//  _y      : output sample array [size: _n x 1]
+void IIRFILT(_execute_block_sos)(IIRFILT()    _q,
+                                 TI *         _x,
+                                 unsigned int _n,
+                                 TO *         _y)
+{
+    unsigned int nsos = _q->nsos;
+    unsigned int s, t;
+    TO pipe[nsos];  // pipe[s]: input sample pending for stage s
+    TO out [nsos];  // out[s] : output of stage s for current tick
+
+    // load direct-form II state from each section
+    for (s=0; s<nsos; s++) {
+        TO v[2];
+        IIRFILTSOS(_get_state)(_q->qsos[s], v);
+        _q->sos_v1[s] = v[0];
+        _q->sos_v2[s] = v[1];
+    }
+
+    // run _n samples plus (nsos-1) ticks to drain the pipeline
+    for (t=0; t<_n + nsos - 1; t++) {
+        // feed next input sample into first stage
+        if (t < _n)
+            pipe[0] = _x[t];
+
+        // active stage range: stage s processes sample (t-s)
+        unsigned int s0 = t < _n     ? 0   : t - _n + 1;
+        unsigned int s1 = t+1 < nsos ? t+1 : nsos;
+
+        // compute all active stages; recurrences are independent
+        for (s=s0; s<s1; s++) {
+            TO v0 = pipe[s] - _q->sos_a1[s]*_q->sos_v1[s]
+                            - _q->sos_a2[s]*_q->sos_v2[s];
+            out[s] = _q->sos_b0[s]*v0 + _q->sos_b1[s]*_q->sos_v1[s]
+                                      + _q->sos_b2[s]*_q->sos_v2[s];
+            _q->sos_v2[s] = _q->sos_v1[s];
+            _q->sos_v1[s] = v0;
+        }
+
+        // feed each stage output to the next stage; emit the last
+        for (s=s0; s<s1; s++) {
+            if (s+1 == nsos)
+                _y[t - (nsos-1)] = out[s];
+            else
+                pipe[s+1] = out[s];
+        }
+    }
+
+    // store direct-form II state back to each section
+    for (s=0; s<nsos; s++) {
+        TO v[2] = { _q->sos_v1[s], _q->sos_v2[s] };
+        IIRFILTSOS(_set_state)(_q->qsos[s], v);
+    }
+}
+
 // execute iir filter, switching to type-specific function
 //  _q      :   iirfilt object
 //  _x      :   input sample
@@ -574,6 +760,8 @@ void IIRFILT(_execute)(IIRFILT() _q,
 {
     if (_q->type == IIRFILT_TYPE_NORM)
         IIRFILT(_execute_norm)(_q,_x,_y);
+    else if (_q->type == IIRFILT_TYPE_TRANS)
+        IIRFILT(_execute_trans)(_q,_x,_y);
     else
         IIRFILT(_execute_sos)(_q,_x,_y);
 }
@@ -589,6 +777,13 @@ void IIRFILT(_execute_block)(IIRFILT()    _q,
                              unsigned int _n,
                              TO *         _y)
 {
+    // run cascade engine when block is long enough to keep the
+    // pipeline filled
+    if (_q->type == IIRFILT_TYPE_SOS && _n >= _q->nsos) {
+        IIRFILT(_execute_block_sos)(_q, _x, _n, _y);
+        return;
+    }
+
     unsigned int i;
     for (i=0; i<_n; i++)
         // compute output sample
@@ -676,3 +871,171 @@ float IIRFILT(_groupdelay)(IIRFILT() _q,
     return groupdelay;
 }
 
+// compute complex frequency response at uniformly-spaced frequencies
+// in one pass rather than one evaluation per point
+//  _q      :   filter object
+//  _nfft   :   number of frequency points, _nfft > 0
+//  _H      :   output frequency response, [size: _nfft x 1], where
+//              _H[i] corresponds to frequency i/_nfft (upper half
+//              wrapping to negative frequencies as with an FFT)
+void IIRFILT(_freqresponse_block)(IIRFILT()       _q,
+                                  unsigned int    _nfft,
+                                  float complex * _H)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: iirfilt_%s_freqresponse_block(), transform size must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int k;
+
+    if (_q->type == IIRFILT_TYPE_NORM) {
+        // transform numerator and denominator separately and divide
+        // per bin; inverse direction matches the exp{+j 2 pi fc i}
+        // convention of IIRFILT(_freqresponse)()
+        float complex buf_time[_nfft];
+        float complex Ha[_nfft];
+        FFT_PLAN fft_b = FFT_CREATE_PLAN(_nfft, buf_time, _H, FFT_DIR_BACKWARD, FFT_METHOD);
+        FFT_PLAN fft_a = FFT_CREATE_PLAN(_nfft, buf_time, Ha, FFT_DIR_BACKWARD, FFT_METHOD);
+
+        // fold coefficients modulo the transform size; frequency
+        // samples of the aliased sequence equal the true response
+        for (i=0; i<_nfft; i++)
+            buf_time[i] = 0.0f;
+        for (i=0; i<_q->nb; i++)
+            buf_time[i % _nfft] += _q->b[i];
+        FFT_EXECUTE(fft_b);
+
+        for (i=0; i<_nfft; i++)
+            buf_time[i] = 0.0f;
+        for (i=0; i<_q->na; i++)
+            buf_time[i % _nfft] += _q->a[i];
+        FFT_EXECUTE(fft_a);
+
+        FFT_DESTROY_PLAN(fft_b);
+        FFT_DESTROY_PLAN(fft_a);
+
+        for (k=0; k<_nfft; k++)
+            _H[k] /= Ha[k];
+    } else {
+        // second-order sections: compute the complex exponent once per
+        // bin and share it across all sections
+        for (k=0; k<_nfft; k++) {
+            float complex z1 = cexpf(_Complex_I*2*M_PI*(float)k/(float)_nfft);
+            float complex z2 = z1*z1;
+
+            float complex H = 1.0f;
+            for (i=0; i<_q->nsos; i++) {
+                float complex Hb = _q->b[3*i+0] + _q->b[3*i+1]*z1 + _q->b[3*i+2]*z2;
+                float complex Ha = _q->a[3*i+0] + _q->a[3*i+1]*z1 + _q->a[3*i+2]*z2;
+                H *= Hb / Ha;
+            }
+            _H[k] = H;
+        }
+    }
+}
+
+// compute group delay at uniformly-spaced frequencies in one pass
+// rather than one evaluation per point
+//  _q      :   filter object
+//  _nfft   :   number of frequency points, _nfft > 0
+//  _d      :   output group delay [samples], [size: _nfft x 1], where
+//              _d[i] corresponds to frequency i/_nfft (upper half
+//              wrapping to negative frequencies as with an FFT)
+void IIRFILT(_groupdelay_block)(IIRFILT()    _q,
+                                unsigned int _nfft,
+                                float *      _d)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: iirfilt_%s_groupdelay_block(), transform size must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    float tol = 1e-5f;
+
+    // clear output accumulator
+    for (k=0; k<_nfft; k++)
+        _d[k] = 0.0f;
+
+    if (_q->type == IIRFILT_TYPE_NORM) {
+        // compute c = conv(b,fliplr(a)) once, as in iir_group_delay()
+        unsigned int nc = _q->na + _q->nb - 1;
+        float c[nc];
+        for (i=0; i<nc; i++)
+            c[i] = 0.0f;
+        for (i=0; i<_q->na; i++) {
+            for (j=0; j<_q->nb; j++)
+                c[i+j] += crealf(_q->a[_q->na-i-1]) * crealf(_q->b[j]);
+        }
+
+        // transform the folded sequence and its index-weighted
+        // counterpart; the group delay at each frequency is the real
+        // part of their ratio
+        float complex buf_time[_nfft];
+        float complex t0[_nfft];
+        float complex t1[_nfft];
+        FFT_PLAN fft0 = FFT_CREATE_PLAN(_nfft, buf_time, t0, FFT_DIR_BACKWARD, FFT_METHOD);
+        FFT_PLAN fft1 = FFT_CREATE_PLAN(_nfft, buf_time, t1, FFT_DIR_BACKWARD, FFT_METHOD);
+
+        for (i=0; i<_nfft; i++)
+            buf_time[i] = 0.0f;
+        for (i=0; i<nc; i++)
+            buf_time[i % _nfft] += c[i];
+        FFT_EXECUTE(fft0);
+
+        for (i=0; i<_nfft; i++)
+            buf_time[i] = 0.0f;
+        for (i=0; i<nc; i++)
+            buf_time[i % _nfft] += c[i] * (float)i;
+        FFT_EXECUTE(fft1);
+
+        FFT_DESTROY_PLAN(fft0);
+        FFT_DESTROY_PLAN(fft1);
+
+        for (k=0; k<_nfft; k++) {
+            _d[k] = cabsf(t0[k]) < tol ? 0.0f :
+                    crealf(t1[k]/t0[k]) - (float)(_q->na - 1);
+        }
+    } else {
+        // second-order sections: pre-compute each section's
+        // c = conv(b,fliplr(a)) (five taps) and accumulate the
+        // per-section delay with a shared exponent per bin
+        float c[5*_q->nsos];
+        for (i=0; i<_q->nsos; i++) {
+            for (j=0; j<5; j++)
+                c[5*i+j] = 0.0f;
+            unsigned int p, q;
+            for (p=0; p<3; p++) {
+                for (q=0; q<3; q++)
+                    c[5*i+p+q] += crealf(_q->a[3*i+2-p]) * crealf(_q->b[3*i+q]);
+            }
+        }
+
+        for (k=0; k<_nfft; k++) {
+            // compute powers of the complex exponent once per bin
+            float complex z = cexpf(_Complex_I*2*M_PI*(float)k/(float)_nfft);
+            float complex zp[5];
+            zp[0] = 1.0f;
+            for (j=1; j<5; j++)
+                zp[j] = zp[j-1]*z;
+
+            for (i=0; i<_q->nsos; i++) {
+                float complex t0 = 0.0f;
+                float complex t1 = 0.0f;
+                for (j=0; j<5; j++) {
+                    float complex c0 = c[5*i+j]*zp[j];
+                    t0 += c0*(float)j;
+                    t1 += c0;
+                }
+                _d[k] += cabsf(t1) < tol ? 0.0f : crealf(t0/t1) - 2.0f;
+            }
+        }
+    }
+}
+
@@ -234,6 +234,27 @@ void IIRFILTSOS(_execute_df2)(IIRFILTSOS() _q,
 #endif
 }
 
+// copy the two most recent direct-form II state values
+//  _q      : iirfiltsos object
+//  _v      : state output array [size: 2 x 1]
+void IIRFILTSOS(_get_state)(IIRFILTSOS() _q,
+                            TO *         _v)
+{
+    _v[0] = _q->v[0];
+    _v[1] = _q->v[1];
+}
+
+// restore direct-form II state values; the third buffer element is
+// left untouched as it is overwritten before use on the next execution
+//  _q      : iirfiltsos object
+//  _v      : state input array [size: 2 x 1]
+void IIRFILTSOS(_set_state)(IIRFILTSOS() _q,
+                            TO *         _v)
+{
+    _q->v[0] = _v[0];
+    _q->v[1] = _v[1];
+}
+
 // compute group delay in samples
 //  _q      :   filter object
 //  _fc     :   frequency
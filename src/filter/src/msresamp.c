@@ -51,6 +51,10 @@ void MSRESAMP(_decim_execute)(MSRESAMP()     _q,
                               TO *           _y,
                               unsigned int * _num_written);
 
+// plan decimation stages (number of half-band stages, integer
+// decimation factor, arbitrary resampling rate)
+void MSRESAMP(_plan_decim)(MSRESAMP() _q);
+
 
 struct MSRESAMP(_s) {
     // user-defined parameters
@@ -65,14 +69,25 @@ struct MSRESAMP(_s) {
     MSRESAMP2() halfband_resamp;        // multi-stage halfband resampler
     float rate_halfband;                // halfband rate
 
+    // integer decimation stage parameters (decimation only)
+    FIRDECIM() decim;                   // integer decimation object (NULL if unused)
+    unsigned int decim_factor;          // integer decimation factor (1 if unused)
+    unsigned int decim_m;               // integer decimation filter semi-length
+    T * decim_buffer;                   // integer decimation input buffer
+    unsigned int decim_index;           // integer decimation buffer write index
+
     // arbitrary resampler parameters
-    RESAMP() arbitrary_resamp;          // arbitrary resampling object
+    RESAMP() arbitrary_resamp;          // arbitrary resampling object (NULL if unused)
     float rate_arbitrary;               // clean-up resampling rate, in (0.5, 2.0)
 
     // internal buffers (ping-pong)
     unsigned int buffer_len;            // length of each buffer
     T * buffer;                         // buffer[0]
     unsigned int buffer_index;          // index of buffer
+
+    // sample-clock metadata: samples consumed/produced since reset
+    uint64_t num_input;                 // input samples consumed
+    uint64_t num_output;                // output samples produced
 };
 
 // create msresamp object
@@ -103,6 +118,8 @@ MSRESAMP() MSRESAMP(_create)(float _r,
     q->rate_arbitrary = q->rate;
     q->rate_halfband  = 1.0f;
     q->num_halfband_stages = 0;
+    q->decim_factor = 1;
+    q->decim_m      = 4;    // integer decimation filter semi-length (in symbols)
     switch(q->type) {
         case LIQUID_RESAMP_INTERP:
             while (q->rate_arbitrary > 2.0f) {
@@ -112,11 +129,7 @@ MSRESAMP() MSRESAMP(_create)(float _r,
             }
             break;
         case LIQUID_RESAMP_DECIM:
-            while (q->rate_arbitrary < 0.5f) {
-                q->num_halfband_stages++;
-                q->rate_halfband  *= 0.5f;
-                q->rate_arbitrary *= 2.0f;
-            }
+            MSRESAMP(_plan_decim)(q);
             break;
         default:;
     }
@@ -131,13 +144,27 @@ MSRESAMP() MSRESAMP(_create)(float _r,
                                             q->num_halfband_stages,
                                             0.4f, 0.0f, q->As);
 
-    // create arbitrary resampler object
+    // create integer decimation stage (decimation planner only); scale
+    // compensates the decimation filter's pass-band gain
+    q->decim        = NULL;
+    q->decim_buffer = NULL;
+    if (q->decim_factor > 1) {
+        q->decim = FIRDECIM(_create_kaiser)(q->decim_factor, q->decim_m, q->As);
+        FIRDECIM(_set_scale)(q->decim, 1.0f / (float)q->decim_factor);
+        q->decim_buffer = (T*) malloc( q->decim_factor*sizeof(T) );
+    }
+
+    // create arbitrary resampler object unless the composite rate is
+    // realized exactly by the preceding stages
     // TODO: compute appropriate parameters
-    q->arbitrary_resamp = RESAMP(_create)(q->rate_arbitrary,
-                                          7,
-                                          min(0.515f*q->rate_arbitrary,0.49f),
-                                          q->As,
-                                          64);
+    q->arbitrary_resamp = NULL;
+    if (q->rate_arbitrary != 1.0f) {
+        q->arbitrary_resamp = RESAMP(_create)(q->rate_arbitrary,
+                                              7,
+                                              min(0.515f*q->rate_arbitrary,0.49f),
+                                              q->As,
+                                              64);
+    }
 
     // reset object
     MSRESAMP(_reset)(q);
@@ -149,11 +176,18 @@ MSRESAMP() MSRESAMP(_create)(float _r,
 // destroy msresamp object, freeing all internally-allocated memory
 void MSRESAMP(_destroy)(MSRESAMP() _q)
 {
-    // free buffer
+    // free buffers
     free(_q->buffer);
+    if (_q->decim_buffer != NULL)
+        free(_q->decim_buffer);
+
+    // destroy integer decimation stage
+    if (_q->decim != NULL)
+        FIRDECIM(_destroy)(_q->decim);
 
     // destroy arbitrary resampler
-    RESAMP(_destroy)(_q->arbitrary_resamp);
+    if (_q->arbitrary_resamp != NULL)
+        RESAMP(_destroy)(_q->arbitrary_resamp);
 
     // destroy multi-stage half-band resampler object
     MSRESAMP2(_destroy)(_q->halfband_resamp);
@@ -198,8 +232,15 @@ void MSRESAMP(_print)(MSRESAMP() _q)
         stage++;
     }
 
+    // integer decimation stage
+    if (_q->decim_factor > 1) {
+        r /= (float)_q->decim_factor;
+        printf("    [%2u, r=%11.7f] : firdecim,  M=%u\n", stage, r, _q->decim_factor);
+        stage++;
+    }
+
     // arbitrary (decimator)
-    if (_q->type == LIQUID_RESAMP_DECIM) {
+    if (_q->type == LIQUID_RESAMP_DECIM && _q->arbitrary_resamp != NULL) {
         float rate = _q->rate_arbitrary;
         r *= rate;
         printf("    [%2u, r=%11.7f] : arbitrary, r=%12.8f\n", stage, r, rate);
@@ -213,12 +254,22 @@ void MSRESAMP(_reset)(MSRESAMP() _q)
     // reset multi-stage half-band resampler object
     MSRESAMP2(_reset)(_q->halfband_resamp);
 
+    // reset integer decimation stage
+    if (_q->decim != NULL)
+        FIRDECIM(_reset)(_q->decim);
+    _q->decim_index = 0;
+
     // reset arbitrary resampler
-    RESAMP(_reset)(_q->arbitrary_resamp);
+    if (_q->arbitrary_resamp != NULL)
+        RESAMP(_reset)(_q->arbitrary_resamp);
 
     // reset buffer write pointer
     _q->buffer_index = 0;
 
+    // reset sample counters
+    _q->num_input  = 0;
+    _q->num_output = 0;
+
     // TODO: clear internal buffers?
 }
 
@@ -226,7 +277,8 @@ void MSRESAMP(_reset)(MSRESAMP() _q)
 float MSRESAMP(_get_delay)(MSRESAMP() _q)
 {
     float delay_halfband = MSRESAMP2(_get_delay)(_q->halfband_resamp);
-    float delay_arbitrary = RESAMP(_get_delay)(_q->arbitrary_resamp);
+    float delay_arbitrary = _q->arbitrary_resamp == NULL ? 0.0f :
+                            RESAMP(_get_delay)(_q->arbitrary_resamp);
 
 #if 0
     printf("halfband    : rate=%12.8f, delay=%12.8f\n", (float)(1<<_q->num_halfband_stages), delay_halfband);
@@ -234,16 +286,20 @@ float MSRESAMP(_get_delay)(MSRESAMP() _q)
 #endif
 
     // compute delay based on interpolation or decimation type
-    if (_q->num_halfband_stages == 0) {
-        // no half-band stages; just arbitrary resampler delay
-        return delay_arbitrary;
-    } else if (_q->type == LIQUID_RESAMP_INTERP) {
+    if (_q->type == LIQUID_RESAMP_INTERP) {
         // interpolation
+        if (_q->num_halfband_stages == 0)
+            return delay_arbitrary;
         return delay_halfband / _q->rate_arbitrary + delay_arbitrary;
     } else {
-        // decimation
+        // decimation; scale each stage's group delay (measured in
+        // samples at that stage's input rate) to the composite input
         unsigned int M = 1 << _q->num_halfband_stages;
-        return delay_halfband + M*delay_arbitrary;
+        unsigned int D = _q->decim_factor;
+        float delay = delay_halfband + M*D*delay_arbitrary;
+        if (D > 1)
+            delay += M * D * _q->decim_m;
+        return delay;
     }
 
     return 0.0f;
@@ -255,6 +311,60 @@ float MSRESAMP(_get_rate)(MSRESAMP() _q)
     return _q->rate;
 }
 
+// get exact composite resampling rate realized by the stage cascade;
+// the half-band and integer stages are exact powers so only the
+// arbitrary stage's quantized phase step contributes
+double MSRESAMP(_get_rate_actual)(MSRESAMP() _q)
+{
+    double r_arb = _q->arbitrary_resamp == NULL ? 1.0 :
+                   RESAMP(_get_rate_actual)(_q->arbitrary_resamp);
+    return _q->type == LIQUID_RESAMP_INTERP ?
+        r_arb * (double)(1 << _q->num_halfband_stages) :
+        r_arb / (double)((1 << _q->num_halfband_stages) * _q->decim_factor);
+}
+
+// get number of input samples consumed since reset
+unsigned long long MSRESAMP(_get_num_input)(MSRESAMP() _q)
+{
+    return _q->num_input;
+}
+
+// get number of output samples produced since reset
+unsigned long long MSRESAMP(_get_num_output)(MSRESAMP() _q)
+{
+    return _q->num_output;
+}
+
+// get input-clock time of a given output sample, measured in
+// (fractional) input samples since reset and compensated for the
+// composite filter group delay; inverts the sample-index mapping so
+// output streams can carry drift-free timestamps
+//  _q      :   msresamp object
+//  _k      :   output sample index (counted from reset)
+double MSRESAMP(_get_output_time)(MSRESAMP()         _q,
+                                  unsigned long long _k)
+{
+    // composite group delay from _get_delay() is measured in input
+    // samples for both cascade types
+    return (double)_k / MSRESAMP(_get_rate_actual)(_q)
+         - (double) MSRESAMP(_get_delay)(_q);
+}
+
+// get stage plan selected by the internal cost model
+//  _q              :   msresamp object
+//  _num_halfband   :   number of half-band stages
+//  _decim_factor   :   integer decimation factor (1 if unused)
+//  _rate_arbitrary :   rate of arbitrary resampling stage (1 if unused)
+void MSRESAMP(_get_plan)(MSRESAMP()     _q,
+                         unsigned int * _num_halfband,
+                         unsigned int * _decim_factor,
+                         float *        _rate_arbitrary)
+{
+    if (_num_halfband   != NULL) *_num_halfband   = _q->num_halfband_stages;
+    if (_decim_factor   != NULL) *_decim_factor   = _q->decim_factor;
+    if (_rate_arbitrary != NULL) *_rate_arbitrary = _q->rate_arbitrary;
+}
+
 // execute multi-stage resampler
 //  _q      :   msresamp object
 //  _x      :   input sample array
@@ -275,12 +385,81 @@ void MSRESAMP(_execute)(MSRESAMP()     _q,
         break;
     default:;
     }
+
+    // update sample counters
+    _q->num_input  += _nx;
+    _q->num_output += *_ny;
 }
 
-// 
+//
 // internal methods
 //
 
+// plan decimation stages by minimizing the approximate multiply rate
+// (multiplications per input sample) over candidate cascades of the form
+//   [k half-band stages] -> [decimate by D] -> [arbitrary resampler]
+// where the arbitrary stage is bypassed when the residual rate is unity.
+// Cost assumptions:
+//  * a half-band stage at rate 2^-i computes one output from m+1
+//    non-zero coefficients (every other coefficient is zero)
+//  * an integer decimator by D computes one output from 2*D*m+1
+//    coefficients at rate 2^-k / D
+//  * the arbitrary stage evaluates two filterbank branches of 2*m+1
+//    coefficients per output (linear interpolation) at the composite
+//    output rate
+void MSRESAMP(_plan_decim)(MSRESAMP() _q)
+{
+    float R = 1.0f / _q->rate;  // composite decimation factor, R >= 1
+
+    unsigned int k;             // candidate number of half-band stages
+    unsigned int k_opt   = 0;   // optimal number of half-band stages
+    unsigned int D_opt   = 1;   // optimal integer decimation factor
+    float        cost_opt= 0.0f;// cost of optimal plan
+    int          init    = 0;   // optimal values initialized?
+
+    for (k=0; (float)(1<<k) <= R; k++) {
+        // largest integer decimation factor leaving a residual rate in
+        // [1,2); small bias guards against R rounding just below an
+        // integer multiple; limit factor to keep filter design reasonable
+        unsigned int D = (unsigned int)(R / (float)(1<<k) + 1e-5f);
+        if (D > 64)
+            continue;
+
+        // residual rate after half-band and integer stages
+        float r_resid = R / (float)((1<<k)*D);
+
+        // accumulate cost of half-band cascade
+        float cost = 0.0f;
+        unsigned int i;
+        for (i=1; i<=k; i++)
+            cost += (float)(_q->decim_m + 1) / (float)(1<<i);
+
+        // cost of integer decimation stage
+        if (D > 1)
+            cost += (float)(2*D*_q->decim_m + 1) / (float)((1<<k)*D);
+
+        // cost of arbitrary resampling stage (bypassed when residual
+        // rate is unity to within numerical precision)
+        if ( fabsf(r_resid - 1.0f) > 1e-5f )
+            cost += 2.0f*(float)(2*7 + 1) / R;
+
+        // retain plan if cost is reduced
+        if (!init || cost < cost_opt) {
+            k_opt    = k;
+            D_opt    = D;
+            cost_opt = cost;
+            init     = 1;
+        }
+    }
+
+    // save optimal plan
+    _q->num_halfband_stages = k_opt;
+    _q->rate_halfband       = 1.0f / (float)(1<<k_opt);
+    _q->decim_factor        = D_opt;
+    float r_resid = R / (float)((1<<k_opt)*D_opt);
+    _q->rate_arbitrary = fabsf(r_resid - 1.0f) > 1e-5f ? 1.0f/r_resid : 1.0f;
+}
+
 // execute multi-stage resampler as interpolator
 //  _q      :   msresamp object
 //  _x      :   input sample array
@@ -300,16 +479,20 @@ void MSRESAMP(_interp_execute)(MSRESAMP()     _q,
     // buffer
     for (i=0; i<_nx; i++) {
         // run arbitrary resampler
+        LIQUID_PROFILE_BEGIN(MSRESAMP_ARBITRARY);
         RESAMP(_execute)(_q->arbitrary_resamp, _x[i], _q->buffer, &nw);
+        LIQUID_PROFILE_END(MSRESAMP_ARBITRARY);
 
         // run multi-stage half-band resampler on each output sample
         unsigned int k;
+        LIQUID_PROFILE_BEGIN(MSRESAMP_HALFBAND);
         for (k=0; k<nw; k++) {
             MSRESAMP2(_execute)(_q->halfband_resamp, &_q->buffer[k], &_y[ny]);
 
             // increase output counter by halfband interpolation rate
             ny += 1 << _q->num_halfband_stages;
         }
+        LIQUID_PROFILE_END(MSRESAMP_HALFBAND);
     }
 
     // set return value for number of samples written
@@ -342,16 +525,34 @@ void MSRESAMP(_decim_execute)(MSRESAMP()     _q,
         // check if buffer has 'M' elements
         if (_q->buffer_index == M) {
             // run half-band decimation, producing a single output
+            LIQUID_PROFILE_BEGIN(MSRESAMP_HALFBAND);
             MSRESAMP2(_execute)(_q->halfband_resamp, _q->buffer, &halfband_output);
-
-            // run resulting sample through arbitrary resampler
-            RESAMP(_execute)(_q->arbitrary_resamp, halfband_output, &_y[ny], &nw);
-
-            // increment output counter
-            ny += nw;
+            LIQUID_PROFILE_END(MSRESAMP_HALFBAND);
 
             // reset buffer index
             _q->buffer_index = 0;
+
+            // run result through integer decimation stage (if present)
+            if (_q->decim_factor > 1) {
+                _q->decim_buffer[_q->decim_index++] = halfband_output;
+
+                // wait until decimator buffer is full
+                if (_q->decim_index < _q->decim_factor)
+                    continue;
+
+                FIRDECIM(_execute)(_q->decim, _q->decim_buffer, &halfband_output);
+                _q->decim_index = 0;
+            }
+
+            // run resulting sample through arbitrary resampler (if present)
+            if (_q->arbitrary_resamp != NULL) {
+                LIQUID_PROFILE_BEGIN(MSRESAMP_ARBITRARY);
+                RESAMP(_execute)(_q->arbitrary_resamp, halfband_output, &_y[ny], &nw);
+                LIQUID_PROFILE_END(MSRESAMP_ARBITRARY);
+                ny += nw;
+            } else {
+                _y[ny++] = halfband_output;
+            }
         }
     }
 
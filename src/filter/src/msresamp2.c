@@ -56,6 +56,11 @@ struct MSRESAMP2(_s) {
     T *             buffer1;    // buffer[1]
     unsigned int    buffer_index;  // index of buffer
     float           zeta;       // scaling factor
+
+    // streaming mode: persistent input accumulator allowing arbitrary
+    // call granularity when running as a decimator
+    T *             stream_buf;     // input accumulator [size: M x 1]
+    unsigned int    stream_count;   // number of samples accumulated
 };
 
 // execute multi-stage resampler as interpolator
@@ -128,6 +133,9 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
     q->buffer0 = (T*) malloc( q->M * sizeof(T) );
     q->buffer1 = (T*) malloc( q->M * sizeof(T) );
 
+    // allocate memory for streaming input accumulator
+    q->stream_buf = (T*) malloc( q->M * sizeof(T) );
+
     // allocate arrays for half-band resampler parameters
     q->fc_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
     q->f0_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
@@ -176,6 +184,7 @@ void MSRESAMP2(_destroy)(MSRESAMP2() _q)
     // free buffers
     free(_q->buffer0);
     free(_q->buffer1);
+    free(_q->stream_buf);
 
     // free half-band resampler design parameter arrays
     free(_q->fc_stage);
@@ -228,7 +237,10 @@ void MSRESAMP2(_reset)(MSRESAMP2() _q)
 
     // reset buffer write pointer
     _q->buffer_index = 0;
-    
+
+    // reset streaming input accumulator
+    _q->stream_count = 0;
+
     // NOTE: not necessary to clear internal buffers
 }
 
@@ -281,10 +293,25 @@ float MSRESAMP2(_get_delay)(MSRESAMP2() _q)
     return delay;
 }
 
-// execute multi-stage resampler as interpolator            
-//  _q      : msresamp object                               
-//  _x      : input sample                                  
-//  _y      : output sample array  [size:2^_num_stages x 1] 
+// get strict latency bound (number of output samples); integer upper
+// bound on the group delay, including the input accumulation of the
+// streaming interface when running as a decimator
+unsigned int MSRESAMP2(_get_latency)(MSRESAMP2() _q)
+{
+    unsigned int latency = (unsigned int) ceilf( MSRESAMP2(_get_delay)(_q) );
+
+    // streaming decimation accumulates up to M-1 input samples (strictly
+    // less than one output sample period) before the cascade runs
+    if (_q->type == LIQUID_RESAMP_DECIM)
+        latency++;
+
+    return latency;
+}
+
+// execute multi-stage resampler as interpolator
+//  _q      : msresamp object
+//  _x      : input sample
+//  _y      : output sample array  [size:2^_num_stages x 1]
 void MSRESAMP2(_execute)(MSRESAMP2() _q,
                          TI *        _x,
                          TO *        _y)
@@ -303,6 +330,52 @@ void MSRESAMP2(_execute)(MSRESAMP2() _q,
     }
 }
 
+// execute multi-stage resampler on a block of samples with arbitrary
+// call granularity; as a decimator, inputs are accumulated internally
+// and an output sample is produced whenever a full block of M=2^num_stages
+// samples is available, so callers need not align calls to the
+// decimation factor
+//  _q      : msresamp object
+//  _x      : input sample array [size: _nx x 1]
+//  _nx     : input sample array size
+//  _y      : output sample array [size: _nx*M x 1 (interpolator) or
+//            at most (_nx+M-1)/M x 1 (decimator)]
+// returns number of output samples written
+unsigned int MSRESAMP2(_execute_stream)(MSRESAMP2()  _q,
+                                        TI *         _x,
+                                        unsigned int _nx,
+                                        TO *         _y)
+{
+    unsigned int i;
+    unsigned int ny = 0;
+
+    if (_q->num_stages == 0) {
+        // pass through
+        for (i=0; i<_nx; i++)
+            _y[i] = _x[i];
+        return _nx;
+    } else if (_q->type == LIQUID_RESAMP_INTERP) {
+        // each input sample immediately produces M output samples
+        for (i=0; i<_nx; i++) {
+            MSRESAMP2(_interp_execute)(_q, _x[i], &_y[ny]);
+            ny += _q->M;
+        }
+    } else {
+        // accumulate inputs into persistent buffer, running the cascade
+        // each time a full block is available
+        for (i=0; i<_nx; i++) {
+            _q->stream_buf[_q->stream_count++] = _x[i];
+            if (_q->stream_count == _q->M) {
+                MSRESAMP2(_decim_execute)(_q, _q->stream_buf, &_y[ny]);
+                _q->stream_count = 0;
+                ny++;
+            }
+        }
+    }
+
+    return ny;
+}
+
 //
 // internal methods
 //
@@ -315,31 +388,46 @@ void MSRESAMP2(_interp_execute)(MSRESAMP2() _q,
                                 TI          _x,
                                 TO *        _y)
 {
-    // buffer pointers (initialize BOTH to _q->buffer0);
+    // buffer pointers
     T * b0 = _q->buffer0;   // input buffer pointer
-    T * b1 = _q->buffer1;   // output buffer pointer
+    T * b1;                 // output buffer pointer
 
     // set input sample in first buffer
     b0[0] = _x;
 
-    unsigned int s;         // half-band decimator stage counter
-    unsigned int k;         // number of inputs for this stage
-    for (s=0; s<_q->num_stages; s++) {
-        // compute number of inputs for this stage
-        k = 1 << s;
+    // run cascade, fusing adjacent half-band stages into a single
+    // quarter-band pass where possible; intermediate samples of a fused
+    // pair stay in a small local buffer rather than touching the full
+    // stage buffers
+    unsigned int s = 0;     // half-band interpolator stage counter
+    unsigned int toggle = 0;
+    while (s < _q->num_stages) {
+        unsigned int k  = 1 << s;                       // inputs for this pass
+        unsigned int ns = (s+2 <= _q->num_stages) ? 2 : 1; // stages in pass
 
-        // set final stage output as supplied output pointer
-        if (s == _q->num_stages-1)
-            b1 = _y;
+        // set final pass output as supplied output pointer
+        b1 = (s+ns == _q->num_stages) ? _y :
+            (toggle == 0 ? _q->buffer1 : _q->buffer0);
 
-        // run half-band stages as interpolators
         unsigned int i;
-        for (i=0; i<k; i++)
-            RESAMP2(_interp_execute)(_q->resamp2[s], b0[i], &b1[2*i]);
+        if (ns == 2) {
+            // fused pair: 1 input -> 4 outputs per iteration
+            T tmp[2];
+            for (i=0; i<k; i++) {
+                RESAMP2(_interp_execute)(_q->resamp2[s  ], b0[i],  tmp      );
+                RESAMP2(_interp_execute)(_q->resamp2[s+1], tmp[0], &b1[4*i  ]);
+                RESAMP2(_interp_execute)(_q->resamp2[s+1], tmp[1], &b1[4*i+2]);
+            }
+        } else {
+            // single remaining stage
+            for (i=0; i<k; i++)
+                RESAMP2(_interp_execute)(_q->resamp2[s], b0[i], &b1[2*i]);
+        }
 
-        // toggle output buffer pointers
-        b0 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
-        b1 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+        // advance stage counter and swap buffer pointers
+        s += ns;
+        b0 = b1;
+        toggle = 1 - toggle;
     }
 }
 
@@ -351,25 +439,41 @@ void MSRESAMP2(_decim_execute)(MSRESAMP2() _q,
                                TI *        _x,
                                TO *        _y)
 {
-    // buffer pointers (initialize BOTH to _q->buffer0);
+    // buffer pointers
     T * b0 = _x;            // input buffer pointer
     T * b1 = _q->buffer1;   // output buffer pointer
 
-    unsigned int s;         // half-band decimator stage counter
-    unsigned int k;         // number of outputs for this stage
-    for (s=0; s<_q->num_stages; s++) {
-        // compute number of outputs for this stage
-        k = 1 << (_q->num_stages - s - 1);
+    // run cascade, fusing adjacent half-band stages into a single
+    // quarter-band pass where possible; intermediate samples of a fused
+    // pair stay in a small local buffer rather than touching the full
+    // stage buffers
+    unsigned int s = 0;     // half-band decimator stage counter
+    unsigned int toggle = 0;
+    while (s < _q->num_stages) {
+        unsigned int g  = _q->num_stages - s - 1;   // reversed resampler index
+        unsigned int ns = (s+2 <= _q->num_stages) ? 2 : 1; // stages in pass
+        unsigned int k  = 1 << (_q->num_stages - s - ns);  // outputs for pass
 
-        // run half-band stages as decimators
         unsigned int i;
-        unsigned int g = _q->num_stages-s-1;    // reversed resampler index
-        for (i=0; i<k; i++)
-            RESAMP2(_decim_execute)(_q->resamp2[g], &b0[2*i], &b1[i]);
+        if (ns == 2) {
+            // fused pair: 4 inputs -> 1 output per iteration
+            T tmp[2];
+            for (i=0; i<k; i++) {
+                RESAMP2(_decim_execute)(_q->resamp2[g  ], &b0[4*i  ], &tmp[0]);
+                RESAMP2(_decim_execute)(_q->resamp2[g  ], &b0[4*i+2], &tmp[1]);
+                RESAMP2(_decim_execute)(_q->resamp2[g-1], tmp,        &b1[i] );
+            }
+        } else {
+            // single remaining stage
+            for (i=0; i<k; i++)
+                RESAMP2(_decim_execute)(_q->resamp2[g], &b0[2*i], &b1[i]);
+        }
 
-        // toggle output buffer pointers
-        b0 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
-        b1 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+        // advance stage counter and swap buffer pointers
+        s += ns;
+        b0 = b1;
+        b1 = toggle == 0 ? _q->buffer0 : _q->buffer1;
+        toggle = 1 - toggle;
     }
 
     // set single output sample and scale appropriately
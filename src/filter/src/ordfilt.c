@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 // defined:
 //  ORDFILT()       name-mangling macro
@@ -35,7 +36,7 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
-#define LIQUID_ORDFILT_USE_WINDOW 1
+#define LIQUID_ORDFILT_USE_WINDOW 0
 
 #if LIQUID_ORDFILT_USE_WINDOW
 int ordfilt_sort_compf(const void * _v1, const void * _v2)
@@ -54,11 +55,22 @@ struct ORDFILT(_s) {
     TI *            buf_sorted; // input buffer (sorted)
 #else
     // trickier to implement but faster
-    TI *            buf;        // input buffer
+    TI *            buf;        // input buffer (circular)
     uint16_t *      buf_index;  // buffer index of sorted values
+    unsigned int    buf_pos;    // write position in circular buffer
 #endif
 };
 
+#if !LIQUID_ORDFILT_USE_WINDOW
+// find rank of oldest sample in sorted index list (internal method)
+unsigned int ORDFILT(_find_rank)(ORDFILT() _q);
+
+// find insertion rank of new sample in sorted list (internal method)
+unsigned int ORDFILT(_find_insertion_rank)(ORDFILT()    _q,
+                                           TI           _x,
+                                           unsigned int _n);
+#endif
+
 // Create a order-statistic filter (ordfilt) object by specifying
 // the buffer size and appropriate sample index of order statistic.
 //  _n      : buffer size
@@ -73,6 +85,9 @@ ORDFILT() ORDFILT(_create)(unsigned int _n,
     } else if (_k >= _n) {
         fprintf(stderr,"error: ordfilt_%s_create(), filter index must be in [0,n-1]\n", EXTENSION_FULL);
         exit(1);
+    } else if (_n > 65535) {
+        fprintf(stderr,"error: ordfilt_%s_create(), filter length exceeds maximum\n", EXTENSION_FULL);
+        exit(1);
     }
 
     // create filter object and initialize
@@ -85,6 +100,9 @@ ORDFILT() ORDFILT(_create)(unsigned int _n,
     q->buf        = WINDOW(_create)(q->n);
     q->buf_sorted = (TI*) malloc(q->n * sizeof(TI));
 #else
+    // allocate circular buffer and sorted index list
+    q->buf       = (TI*)       malloc(q->n * sizeof(TI));
+    q->buf_index = (uint16_t*) malloc(q->n * sizeof(uint16_t));
 #endif
 
     // reset filter state (clear buffer)
@@ -106,6 +124,8 @@ void ORDFILT(_destroy)(ORDFILT() _q)
     WINDOW(_destroy)(_q->buf);
     free(_q->buf_sorted);
 #else
+    free(_q->buf);
+    free(_q->buf_index);
 #endif
     free(_q);
 }
@@ -116,6 +136,13 @@ void ORDFILT(_reset)(ORDFILT() _q)
 #if LIQUID_ORDFILT_USE_WINDOW
     WINDOW(_reset)(_q->buf);
 #else
+    // clear buffer; with all values equal the identity ordering is sorted
+    unsigned int i;
+    for (i=0; i<_q->n; i++) {
+        _q->buf[i]       = 0;
+        _q->buf_index[i] = (uint16_t)i;
+    }
+    _q->buf_pos = 0;
 #endif
 }
 
@@ -134,6 +161,31 @@ void ORDFILT(_push)(ORDFILT() _q,
 #if LIQUID_ORDFILT_USE_WINDOW
     WINDOW(_push)(_q->buf, _x);
 #else
+    // incremental update: remove the expired sample from the sorted
+    // index list and insert the new one, keeping the list sorted;
+    // binary searches dominate, so the update runs in O(log n) plus
+    // a short index shift
+    unsigned int j_old = ORDFILT(_find_rank)(_q);
+
+    // remove expired entry from sorted list
+    memmove(_q->buf_index + j_old,
+            _q->buf_index + j_old + 1,
+            (_q->n - j_old - 1)*sizeof(uint16_t));
+
+    // overwrite expired sample in circular buffer
+    _q->buf[_q->buf_pos] = _x;
+
+    // find insertion rank among remaining n-1 entries and insert
+    unsigned int j_new = ORDFILT(_find_insertion_rank)(_q, _x, _q->n-1);
+    memmove(_q->buf_index + j_new + 1,
+            _q->buf_index + j_new,
+            (_q->n - j_new - 1)*sizeof(uint16_t));
+    _q->buf_index[j_new] = (uint16_t)_q->buf_pos;
+
+    // advance write position
+    _q->buf_pos++;
+    if (_q->buf_pos == _q->n)
+        _q->buf_pos = 0;
 #endif
 }
 
@@ -148,6 +200,9 @@ void ORDFILT(_write)(ORDFILT()    _q,
 #if LIQUID_ORDFILT_USE_WINDOW
     WINDOW(_write)(_q->buf, _x, _n);
 #else
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        ORDFILT(_push)(_q, _x[i]);
 #endif
 }
 
@@ -172,6 +227,9 @@ void ORDFILT(_execute)(ORDFILT() _q,
     // save output
     *_y = _q->buf_sorted[_q->k];
 #else
+    // sorted index list is maintained incrementally; the order
+    // statistic (e.g. median) is a direct look-up
+    *_y = _q->buf[_q->buf_index[_q->k]];
 #endif
 }
 
@@ -196,3 +254,48 @@ void ORDFILT(_execute_block)(ORDFILT()    _q,
     }
 }
 
+#if !LIQUID_ORDFILT_USE_WINDOW
+// find rank of oldest sample in sorted index list; binary search for
+// its value, then scan forward among equal values to match the
+// buffer position (internal method)
+unsigned int ORDFILT(_find_rank)(ORDFILT() _q)
+{
+    TI v = _q->buf[_q->buf_pos];
+
+    // binary search for left-most rank holding a value not less than v
+    unsigned int lo = 0;
+    unsigned int hi = _q->n;
+    while (lo < hi) {
+        unsigned int mid = (lo + hi) / 2;
+        if (_q->buf[_q->buf_index[mid]] < v)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    // scan forward among equal values for matching buffer position
+    while (_q->buf_index[lo] != _q->buf_pos)
+        lo++;
+
+    return lo;
+}
+
+// find insertion rank of new sample among first _n entries of sorted
+// index list (internal method)
+unsigned int ORDFILT(_find_insertion_rank)(ORDFILT()    _q,
+                                           TI           _x,
+                                           unsigned int _n)
+{
+    unsigned int lo = 0;
+    unsigned int hi = _n;
+    while (lo < hi) {
+        unsigned int mid = (lo + hi) / 2;
+        if (_q->buf[_q->buf_index[mid]] < _x)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+#endif
+
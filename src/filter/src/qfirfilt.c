@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Quantized-coefficient finite impulse response filter: coefficients
+// are stored as 8- or 16-bit integers with a single per-filter scale
+// factor, cutting coefficient memory by a factor of four (or two)
+// relative to single-precision floats so large banks of narrowband
+// filters stay cache-resident
+//
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// defined:
+//  QFIRFILT()      name-mangling macro
+//  TO              output data type
+//  TC              coefficients data type
+//  TI              input data type
+//  WINDOW()        window macro
+//  PRINTVAL()      print macro(s)
+
+// qfirfilt object structure
+struct QFIRFILT(_s) {
+    int8_t *        h8;         // quantized coefficients, 8-bit mode
+    int16_t *       h16;        // quantized coefficients, 16-bit mode
+    unsigned int    h_len;      // filter length
+    unsigned int    nbits;      // coefficient word size (8 or 16)
+    TC              scale;      // coefficient scale factor (per filter)
+    float           qerror;     // relative r.m.s. quantization error
+    WINDOW()        w;          // internal sample buffer
+};
+
+// create quantized-coefficient filter from external coefficients
+//  _h      : filter coefficients, [size: _h_len x 1]
+//  _h_len  : filter length, _h_len > 0
+//  _nbits  : coefficient word size (8 or 16 bits)
+QFIRFILT() QFIRFILT(_create)(TC *         _h,
+                             unsigned int _h_len,
+                             unsigned int _nbits)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: qfirfilt_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_nbits != 8 && _nbits != 16) {
+        fprintf(stderr,"error: qfirfilt_%s_create(), coefficient word size must be 8 or 16 bits\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create filter object and initialize
+    QFIRFILT() q = (QFIRFILT()) malloc(sizeof(struct QFIRFILT(_s)));
+    q->h_len = _h_len;
+    q->nbits = _nbits;
+    q->h8    = NULL;
+    q->h16   = NULL;
+
+    // derive scale factor from largest coefficient magnitude so the
+    // full integer range is used
+    unsigned int i;
+    float h_max = 0.0f;
+    for (i=0; i<q->h_len; i++) {
+        if (fabsf(_h[i]) > h_max)
+            h_max = fabsf(_h[i]);
+    }
+    int v_max = (q->nbits == 8) ? INT8_MAX : INT16_MAX;
+    q->scale = (h_max > 0.0f) ? h_max / (float)v_max : 1.0f;
+
+    // quantize coefficients (rounding to nearest), accumulating the
+    // coefficient error energy for create-time reporting
+    float e2 = 0.0f;    // quantization error energy
+    float h2 = 0.0f;    // coefficient energy
+    if (q->nbits == 8)  q->h8  = (int8_t*)  malloc(q->h_len * sizeof(int8_t));
+    else                q->h16 = (int16_t*) malloc(q->h_len * sizeof(int16_t));
+    for (i=0; i<q->h_len; i++) {
+        int v = (int) roundf(_h[i] / q->scale);
+        if (v >  v_max) v =  v_max;
+        if (v < -v_max) v = -v_max;
+        if (q->nbits == 8)  q->h8[i]  = (int8_t)  v;
+        else                q->h16[i] = (int16_t) v;
+
+        float e = _h[i] - q->scale * (float)v;
+        e2 += e     * e;
+        h2 += _h[i] * _h[i];
+    }
+
+    // relative r.m.s. coefficient error; bounds the stopband
+    // degradation introduced by quantization
+    q->qerror = (h2 > 0.0f) ? sqrtf(e2 / h2) : 0.0f;
+
+    // create internal sample buffer
+    q->w = WINDOW(_create)(q->h_len);
+
+    // reset filter state (clear buffer)
+    QFIRFILT(_reset)(q);
+    return q;
+}
+
+// destroy qfirfilt object, freeing all internal memory
+void QFIRFILT(_destroy)(QFIRFILT() _q)
+{
+    WINDOW(_destroy)(_q->w);
+    free(_q->h8);
+    free(_q->h16);
+    free(_q);
+}
+
+// reset internal state of filter object
+void QFIRFILT(_reset)(QFIRFILT() _q)
+{
+    WINDOW(_reset)(_q->w);
+}
+
+// print filter object internals, including quantization error
+void QFIRFILT(_print)(QFIRFILT() _q)
+{
+    printf("qfirfilt_%s: [%u taps, %u-bit coefficients, error %.2f dB]\n",
+            EXTENSION_FULL, _q->h_len, _q->nbits,
+            20*log10f(_q->qerror + 1e-12f));
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++) {
+        int v = (_q->nbits == 8) ? (int)_q->h8[i] : (int)_q->h16[i];
+        printf("  h(%4u) = %6d (%12.8f)\n", i, v, _q->scale * (float)v);
+    }
+}
+
+// push sample into filter object's internal buffer
+//  _q      : filter object
+//  _x      : input sample
+void QFIRFILT(_push)(QFIRFILT() _q,
+                     TI         _x)
+{
+    WINDOW(_push)(_q->w, _x);
+}
+
+// write block of samples into filter object's internal buffer
+//  _x      : array of input samples, [size: _n x 1]
+//  _n      : number of input elements
+void QFIRFILT(_write)(QFIRFILT()   _q,
+                      TI *         _x,
+                      unsigned int _n)
+{
+    WINDOW(_write)(_q->w, _x, _n);
+}
+
+// compute output sample: accumulate against the integer coefficients
+// and apply the scale factor once to the result
+//  _q      : filter object
+//  _y      : output sample pointer
+void QFIRFILT(_execute)(QFIRFILT() _q,
+                        TO *       _y)
+{
+    // read buffer (retrieve pointer to aligned memory array)
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+
+    unsigned int i;
+    TO y = 0;
+    if (_q->nbits == 8) {
+        for (i=0; i<_q->h_len; i++)
+            y += (TC)_q->h8[i] * r[_q->h_len - 1 - i];
+    } else {
+        for (i=0; i<_q->h_len; i++)
+            y += (TC)_q->h16[i] * r[_q->h_len - 1 - i];
+    }
+
+    // set return value, applying scale factor
+    *_y = y * _q->scale;
+}
+
+// execute the filter on a block of input samples; the
+// input and output buffers may be the same
+//  _q      : filter object
+//  _x      : pointer to input array [size: _n x 1]
+//  _n      : number of input, output samples
+//  _y      : pointer to output array [size: _n x 1]
+void QFIRFILT(_execute_block)(QFIRFILT()   _q,
+                              TI *         _x,
+                              unsigned int _n,
+                              TO *         _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // push sample into filter
+        QFIRFILT(_push)(_q, _x[i]);
+
+        // compute output sample
+        QFIRFILT(_execute)(_q, &_y[i]);
+    }
+}
+
+// get length of filter object's impulse response
+unsigned int QFIRFILT(_get_length)(QFIRFILT() _q)
+{
+    return _q->h_len;
+}
+
+// get coefficient word size (8 or 16 bits)
+unsigned int QFIRFILT(_get_nbits)(QFIRFILT() _q)
+{
+    return _q->nbits;
+}
+
+// get coefficient scale factor applied to the quantized values
+TC QFIRFILT(_get_scale)(QFIRFILT() _q)
+{
+    return _q->scale;
+}
+
+// get relative r.m.s. coefficient quantization error computed at
+// create time (e.g. -20*log10(error) approximates the quantization
+// noise floor in the stopband)
+float QFIRFILT(_get_quantization_error)(QFIRFILT() _q)
+{
+    return _q->qerror;
+}
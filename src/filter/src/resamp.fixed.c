@@ -44,6 +44,19 @@ struct RESAMP(_s) {
     uint32_t        phase;  // sampling phase
     unsigned int    npfb;   // 256
     FIRPFB()        pfb;    // filter bank
+
+    // sample-clock metadata: samples consumed/produced since reset
+    uint64_t        num_input;  // input samples consumed
+    uint64_t        num_output; // output samples produced
+
+    // Farrow-structure engine: each filter tap is fit to a short
+    // polynomial in the timing phase, so one output is a fixed set
+    // of sub-filter dot products combined by Horner's rule with no
+    // per-sample branch selection
+    int             farrow_enabled; // Farrow engine enabled?
+    unsigned int    farrow_order;   // polynomial order
+    DOTPROD() *     fdp;            // sub-filters [size: farrow_order+1]
+    WINDOW()        fw;             // input window
 };
 
 // create arbitrary resampler
@@ -109,6 +122,11 @@ RESAMP() RESAMP(_create)(float        _rate,
         h[i] = hf[i]*gain;
     q->pfb = FIRPFB(_create)(q->npfb,h,n-1);
 
+    // Farrow-structure engine disabled by default
+    q->farrow_enabled = 0;
+    q->fdp            = NULL;
+    q->fw             = NULL;
+
     // reset object and return
     RESAMP(_reset)(q);
     return q;
@@ -138,9 +156,80 @@ RESAMP() RESAMP(_create_default)(float _rate)
     return RESAMP(_create)(_rate, m, fc, As, npfb);
 }
 
+// create arbitrary resampler object with a square-root Nyquist
+// prototype convolved into the polyphase bank, producing matched-filter
+// shaped samples at arbitrary output rate in a single pass (e.g. for
+// variable-rate transmit chains, replacing a resamp/firinterp cascade)
+//  _type   :   filter type (e.g. LIQUID_FIRFILT_RRC)
+//  _rate   :   resampling rate (output samples per input symbol)
+//  _m      :   prototype filter semi-length (symbols)
+//  _beta   :   prototype filter excess bandwidth factor, 0 < _beta <= 1
+//  _npfb   :   number of filters in polyphase filterbank (ignored;
+//              fixed internally like RESAMP(_create))
+RESAMP() RESAMP(_create_prototype)(int          _type,
+                                   float        _rate,
+                                   unsigned int _m,
+                                   float        _beta,
+                                   unsigned int _npfb)
+{
+    // validate input
+    if (_rate <= 0) {
+        fprintf(stderr,"error: resamp_%s_create_prototype(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: resamp_%s_create_prototype(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_beta <= 0.0f || _beta > 1.0f) {
+        fprintf(stderr,"error: resamp_%s_create_prototype(), filter excess bandwidth must be in (0,1]\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // allocate memory for resampler
+    RESAMP() q = (RESAMP()) malloc(sizeof(struct RESAMP(_s)));
+
+    // set rate using formal method (specifies output stride 'step')
+    RESAMP(_set_rate)(q, _rate);
+
+    // set properties; cutoff is that of the pulse shape relative to
+    // the input symbol rate
+    q->m    = _m;
+    q->fc   = 0.5f*(1.0f + _beta) > 0.49f ? 0.49f : 0.5f*(1.0f + _beta);
+    q->As   = 60.0f;
+    q->npfb = 256;      // number of filters in bank (fixed 8-bit value)
+
+    // design square-root Nyquist prototype at npfb samples per symbol;
+    // unlike the default kaiser design the coefficients are used as
+    // designed so the shaped output matches a firinterp object built
+    // from the same pulse
+    unsigned int n = 2*q->m*q->npfb+1;
+    float * hf = (float*) malloc(n*sizeof(float));
+    TC    * h  = (TC*)    malloc(n*sizeof(TC)   );
+    liquid_firdes_prototype(_type, q->npfb, q->m, _beta, 0, hf);
+
+    // copy to type-specific array
+    unsigned int i;
+    for (i=0; i<n; i++)
+        h[i] = hf[i];
+    q->pfb = FIRPFB(_create)(q->npfb,h,n-1);
+    free(hf);
+    free(h);
+
+    // Farrow-structure engine disabled by default
+    q->farrow_enabled = 0;
+    q->fdp            = NULL;
+    q->fw             = NULL;
+
+    // reset object and return
+    RESAMP(_reset)(q);
+    return q;
+}
+
 // free arbitrary resampler object
 void RESAMP(_destroy)(RESAMP() _q)
 {
+    // free Farrow engine objects
+    RESAMP(_disable_farrow)(_q);
+
     // free polyphase filterbank
     FIRPFB(_destroy)(_q->pfb);
 
@@ -161,8 +250,122 @@ void RESAMP(_reset)(RESAMP() _q)
     // clear filterbank
     FIRPFB(_reset)(_q->pfb);
 
+    // clear Farrow engine window
+    if (_q->farrow_enabled)
+        WINDOW(_reset)(_q->fw);
+
     // reset state
-    _q->phase = 0;
+    _q->phase      = 0;
+    _q->num_input  = 0;
+    _q->num_output = 0;
+}
+
+// get number of input samples consumed since reset
+unsigned long long RESAMP(_get_num_input)(RESAMP() _q)
+{
+    return _q->num_input;
+}
+
+// get number of output samples produced since reset
+unsigned long long RESAMP(_get_num_output)(RESAMP() _q)
+{
+    return _q->num_output;
+}
+
+// get exact resampling rate realized by the quantized phase step;
+// differs slightly from the requested rate and is the value to use
+// when mapping output indices back to input sample times
+double RESAMP(_get_rate_actual)(RESAMP() _q)
+{
+    return (double)(1<<24) / (double)(_q->step);
+}
+
+// get input-clock time of the next output sample to be produced,
+// measured in (fractional) input samples since reset and compensated
+// for the filter group delay; exact under rate adjustments, so
+// downstream consumers get drift-free timestamps
+double RESAMP(_get_next_output_time)(RESAMP() _q)
+{
+    return (double)(_q->num_input) - (double)(_q->m)
+         + (double)(_q->phase) / (double)(1<<24);
+}
+
+// enable Farrow-structure execution engine: fit each tap of the
+// polyphase prototype to a polynomial of order _order in the timing
+// phase; each output then evaluates order+1 fixed sub-filters combined
+// by Horner's rule with no branch selection, and the timing phase is
+// applied at full resolution rather than quantized to the bank index
+//  _q      :   resampling object
+//  _order  :   polynomial order (e.g. 3), 1 <= _order <= 8
+void RESAMP(_enable_farrow)(RESAMP()     _q,
+                            unsigned int _order)
+{
+    // validate input
+    if (_order < 1 || _order > 8) {
+        fprintf(stderr,"error: resamp_%s_enable_farrow(), polynomial order must be in [1,8]\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // discard any previous Farrow engine
+    RESAMP(_disable_farrow)(_q);
+    _q->farrow_order = _order;
+
+    // re-design prototype filter (as in create)
+    unsigned int n = 2*_q->m*_q->npfb+1;
+    float hf[n];
+    liquid_firdes_kaiser(n,_q->fc/((float)(_q->npfb)),_q->As,0.0f,hf);
+    unsigned int i;
+    float gain=0.0f;
+    for (i=0; i<n; i++)
+        gain += hf[i];
+    gain = (_q->npfb)/(gain);
+
+    // fit each tap position to a polynomial in the branch fraction
+    // tau = i/npfb and build one sub-filter per polynomial order,
+    // loading taps in reverse order (as with the polyphase bank)
+    unsigned int h_sub_len = 2*_q->m;
+    unsigned int j, t;
+    float xf[_q->npfb];
+    float yf[_q->npfb];
+    float p[_order+1];
+    TC c[(_order+1)*h_sub_len];
+    for (i=0; i<_q->npfb; i++)
+        xf[i] = (float)i / (float)(_q->npfb);
+    for (t=0; t<h_sub_len; t++) {
+        for (i=0; i<_q->npfb; i++)
+            yf[i] = hf[i + t*_q->npfb]*gain;
+        polyf_fit(xf, yf, _q->npfb, p, _order+1);
+        for (j=0; j<=_order; j++)
+            c[j*h_sub_len + h_sub_len-t-1] = p[j];
+    }
+
+    // create sub-filters and input window
+    _q->fdp = (DOTPROD()*) malloc((_order+1)*sizeof(DOTPROD()));
+    for (j=0; j<=_order; j++)
+        _q->fdp[j] = DOTPROD(_create)(&c[j*h_sub_len], h_sub_len);
+    _q->fw = WINDOW(_create)(h_sub_len);
+
+    // enable engine and reset object state
+    _q->farrow_enabled = 1;
+    RESAMP(_reset)(_q);
+}
+
+// disable Farrow-structure execution engine, reverting to polyphase
+// branch selection
+void RESAMP(_disable_farrow)(RESAMP() _q)
+{
+    if (!_q->farrow_enabled)
+        return;
+
+    unsigned int j;
+    for (j=0; j<=_q->farrow_order; j++)
+        DOTPROD(_destroy)(_q->fdp[j]);
+    free(_q->fdp);
+    WINDOW(_destroy)(_q->fw);
+    _q->fdp = NULL;
+    _q->fw  = NULL;
+    _q->farrow_enabled = 0;
+    RESAMP(_reset)(_q);
 }
 
 // get resampler filter delay (semi-length m)
@@ -251,6 +454,38 @@ void RESAMP(_execute)(RESAMP()       _q,
                       TO *           _y,
                       unsigned int * _num_written)
 {
+    // Farrow-structure engine: compute sub-filter outputs once per
+    // input sample and evaluate each output as a polynomial in the
+    // timing phase (branch-free)
+    if (_q->farrow_enabled) {
+        WINDOW(_push)(_q->fw, _x);
+        unsigned int n=0;
+        if (_q->phase <= 0x00ffffff) {
+            // compute fixed sub-filter outputs
+            TI * r;
+            WINDOW(_read)(_q->fw, &r);
+            TO d[_q->farrow_order+1];
+            unsigned int j;
+            for (j=0; j<=_q->farrow_order; j++)
+                DOTPROD(_execute)(_q->fdp[j], r, &d[j]);
+
+            // evaluate polynomial at full-resolution timing phase
+            while (_q->phase <= 0x00ffffff) {
+                float tau = (float)(_q->phase) * (1.0f/16777216.0f);
+                TO v = d[_q->farrow_order];
+                for (j=_q->farrow_order; j>0; j--)
+                    v = v*tau + d[j-1];
+                _y[n++] = v;
+                _q->phase += _q->step;
+            }
+        }
+        _q->phase -= (1<<24);
+        _q->num_input  += 1;
+        _q->num_output += n;
+        *_num_written = n;
+        return;
+    }
+
     // push input
     FIRPFB(_push)(_q->pfb, _x);
 
@@ -266,6 +501,10 @@ void RESAMP(_execute)(RESAMP()       _q,
     // decrement filter-bank index by output rate
     _q->phase -= (1<<24);
 
+    // update sample counters
+    _q->num_input  += 1;
+    _q->num_output += n;
+
     // error checking for now
     *_num_written = n;
 }
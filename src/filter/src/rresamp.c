@@ -38,6 +38,10 @@ struct RRESAMP(_s) {
 
     // polyphase filterbank properties/object
     FIRPFB()        pfb;    // filterbank object (interpolator), Q filters in bank
+
+    // schedule for block execution, pre-computed at create time
+    unsigned int *  sched_num;  // number of outputs after each input push [size: Q x 1]
+    unsigned int *  sched_index;// filterbank index for each output [size: P x 1]
 };
 
 // internal: execute rational-rate resampler on a primitive-length block of
@@ -80,6 +84,23 @@ RRESAMP() RRESAMP(_create)(unsigned int _P,
     // create poly-phase filter bank
     q->pfb = FIRPFB(_create)(q->P, _h, 2*q->P*q->m);
 
+    // pre-compute schedule for block execution, removing the per-output
+    // index arithmetic from the inner loop; mirrors the index recursion
+    // in rresamp_xxx_execute_primitive()
+    q->sched_num   = (unsigned int*) malloc(q->Q*sizeof(unsigned int));
+    q->sched_index = (unsigned int*) malloc(q->P*sizeof(unsigned int));
+    unsigned int index = 0;
+    unsigned int i, n=0;
+    for (i=0; i<q->Q; i++) {
+        q->sched_num[i] = 0;
+        while (index < q->P) {
+            q->sched_index[n++] = index;
+            q->sched_num[i]++;
+            index += q->Q;
+        }
+        index -= q->P;
+    }
+
     // reset object and return
     RRESAMP(_reset)(q);
     return q;
@@ -194,6 +215,10 @@ void RRESAMP(_destroy)(RRESAMP() _q)
     // free polyphase filterbank
     FIRPFB(_destroy)(_q->pfb);
 
+    // free schedule tables
+    free(_q->sched_num);
+    free(_q->sched_index);
+
     // free main object memory
     free(_q);
 }
@@ -293,6 +318,38 @@ void RRESAMP(_execute)(RRESAMP() _q,
     }
 }
 
+// Execute rational-rate resampler on a block of input samples;
+// equivalent to _n successive calls to execute() but running from the
+// schedule tables so the inner loop carries no index arithmetic
+//  _q  : resamp object
+//  _x  : input sample array, [size: _n*Q x 1]
+//  _n  : block size (number of execute() input blocks)
+//  _y  : output sample array [size: _n*P x 1]
+void RRESAMP(_execute_block)(RRESAMP()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int b;
+    for (b=0; b<_n*_q->block_len; b++) {
+        // run one primitive block from the pre-computed schedule
+        const unsigned int * index = _q->sched_index;
+        unsigned int i, k, n=0;
+        for (i=0; i<_q->Q; i++) {
+            // push input
+            FIRPFB(_push)(_q->pfb, _x[i]);
+
+            // produce scheduled outputs
+            for (k=0; k<_q->sched_num[i]; k++)
+                FIRPFB(_execute)(_q->pfb, *index++, &_y[n++]);
+        }
+
+        // update input/output pointers
+        _x += _q->Q;
+        _y += _q->P;
+    }
+}
+
 // internal
 void RRESAMP(_execute_primitive)(RRESAMP() _q,
                                  TI *      _x,
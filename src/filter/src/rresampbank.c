@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Rational-rate resampler bank: many parallel streams through one filter
+//
+// Running N independent rresamp objects over N streams with identical
+// filters scatters N separate filter states (and N coefficient copies)
+// across memory. This object shares a single coefficient table and keeps
+// the per-channel delay lines interleaved in structure-of-arrays layout,
+// w[tap][channel], so each filter tap is applied to all channels with one
+// pass over a contiguous row. Input and output blocks are likewise
+// channel-interleaved (sample-major).
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+struct RRESAMPBANK(_s) {
+    // filter design parameters
+    unsigned int    P;              // interpolation factor
+    unsigned int    Q;              // decimation factor
+    unsigned int    m;              // filter semi-length, h_len = 2*m + 1
+    unsigned int    block_len;      // number of blocks to run in execute()
+    unsigned int    num_channels;   // number of parallel channels
+
+    // shared polyphase coefficients, phase-major and reversed so that
+    // y = sum_t h[phase][t] * w[t] with w[0] the oldest sample
+    TC *            h;              // [size: P*h_sub_len x 1]
+    unsigned int    h_sub_len;      // sub-filter length, 2*m
+    TC              scale;          // output scaling factor
+
+    // channel state, structure-of-arrays: w[t*num_channels + ch]
+    TI *            w;              // [size: h_sub_len*num_channels x 1]
+
+    // schedule for block execution, pre-computed at create time
+    unsigned int *  sched_num;  // number of outputs after each input push [size: Q x 1]
+    unsigned int *  sched_index;// filterbank index for each output [size: P x 1]
+};
+
+// Create rational-rate resampler bank from external coefficients
+//  _P              : interpolation factor,                     P > 0
+//  _Q              : decimation factor,                        Q > 0
+//  _m              : filter semi-length (delay),               0 < _m
+//  _h              : filter coefficients, [size: 2*_P*_m x 1]
+//  _num_channels   : number of parallel channels,              _num_channels > 0
+RRESAMPBANK() RRESAMPBANK(_create)(unsigned int _P,
+                                   unsigned int _Q,
+                                   unsigned int _m,
+                                   TC *         _h,
+                                   unsigned int _num_channels)
+{
+    // validate input
+    if (_P == 0) {
+        fprintf(stderr,"error: rresampbank_%s_create(), interpolation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_Q == 0) {
+        fprintf(stderr,"error: rresampbank_%s_create(), decimation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: rresampbank_%s_create(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr,"error: rresampbank_%s_create(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // allocate memory for resampler bank
+    RRESAMPBANK() q = (RRESAMPBANK()) malloc(sizeof(struct RRESAMPBANK(_s)));
+
+    // set properties
+    q->P            = _P;
+    q->Q            = _Q;
+    q->m            = _m;
+    q->block_len    =  1;
+    q->num_channels = _num_channels;
+    q->scale        =  1;
+
+    // copy coefficients phase-major, loading each sub-filter in reverse
+    // order (same decomposition as firpfb)
+    q->h_sub_len = 2*q->m;
+    q->h = (TC*) malloc(q->P*q->h_sub_len*sizeof(TC));
+    unsigned int i, t;
+    for (i=0; i<q->P; i++) {
+        for (t=0; t<q->h_sub_len; t++)
+            q->h[i*q->h_sub_len + t] = _h[i + (q->h_sub_len-t-1)*q->P];
+    }
+
+    // allocate interleaved channel state
+    q->w = (TI*) malloc(q->h_sub_len*q->num_channels*sizeof(TI));
+
+    // pre-compute schedule for block execution (same index recursion as
+    // rresamp_xxx_execute_primitive)
+    q->sched_num   = (unsigned int*) malloc(q->Q*sizeof(unsigned int));
+    q->sched_index = (unsigned int*) malloc(q->P*sizeof(unsigned int));
+    unsigned int index = 0;
+    unsigned int n=0;
+    for (i=0; i<q->Q; i++) {
+        q->sched_num[i] = 0;
+        while (index < q->P) {
+            q->sched_index[n++] = index;
+            q->sched_num[i]++;
+            index += q->Q;
+        }
+        index -= q->P;
+    }
+
+    // reset object and return
+    RRESAMPBANK(_reset)(q);
+    return q;
+}
+
+// Create rational-rate resampler bank from filter prototype
+//  _P              : interpolation factor,                     P > 0
+//  _Q              : decimation factor,                        Q > 0
+//  _m              : filter semi-length (delay),               0 < _m
+//  _bw             : filter bandwidth relative to sample rate, 0 < _bw <= 0.5
+//  _As             : filter stop-band attenuation [dB],        0 < _As
+//  _num_channels   : number of parallel channels,              _num_channels > 0
+RRESAMPBANK() RRESAMPBANK(_create_kaiser)(unsigned int _P,
+                                          unsigned int _Q,
+                                          unsigned int _m,
+                                          float        _bw,
+                                          float        _As,
+                                          unsigned int _num_channels)
+{
+    // scale interpolation and decimation factors by their greatest common divisor
+    unsigned int gcd = liquid_gcd(_P, _Q);
+    _P /= gcd;
+    _Q /= gcd;
+
+    // design filter
+    unsigned int h_len = 2*_P*_m + 1;
+    float * hf = (float*) malloc(h_len*sizeof(float));
+    TC    * h  = (TC*)    malloc(h_len*sizeof(TC)   );
+    liquid_firdes_kaiser(h_len, _bw/(float)_P, _As, 0.0f, hf);
+
+    // convert to type-specific coefficients
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = (TC) hf[i];
+
+    // create object and set parameters
+    RRESAMPBANK() q = RRESAMPBANK(_create)(_P, _Q, _m, h, _num_channels);
+    RRESAMPBANK(_set_scale)(q, 2.0f*_bw*sqrtf((float)(q->Q)/(float)(q->P)));
+    q->block_len = gcd;
+
+    // free allocated memory and return object
+    free(hf);
+    free(h);
+    return q;
+}
+
+// create rational-rate resampler bank with a specified resampling rate
+// and default parameters
+//  m (filter semi-length) = 12
+//  As (filter stop-band attenuation) = 60 dB
+RRESAMPBANK() RRESAMPBANK(_create_default)(unsigned int _P,
+                                           unsigned int _Q,
+                                           unsigned int _num_channels)
+{
+    // validate input
+    if (_P == 0) {
+        fprintf(stderr,"error: rresampbank_%s_create(), interpolation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_Q == 0) {
+        fprintf(stderr,"error: rresampbank_%s_create(), decimation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // set default parameters
+    unsigned int m  = 12;
+    float        bw = 0.5f;
+    float        As = 60.0f;
+
+    // create and return resampler bank object
+    return RRESAMPBANK(_create_kaiser)(_P, _Q, m, bw, As, _num_channels);
+}
+
+// free resampler bank object
+void RRESAMPBANK(_destroy)(RRESAMPBANK() _q)
+{
+    // free coefficients and channel state
+    free(_q->h);
+    free(_q->w);
+
+    // free schedule tables
+    free(_q->sched_num);
+    free(_q->sched_index);
+
+    // free main object memory
+    free(_q);
+}
+
+// print resampler bank object
+void RRESAMPBANK(_print)(RRESAMPBANK() _q)
+{
+    printf("resampler bank [rate: %u/%u=%.6f, block length=%u], m=%u, channels=%u\n",
+            _q->P, _q->Q, (float)(_q->P) / (float)(_q->Q), _q->block_len,
+            _q->m, _q->num_channels);
+}
+
+// reset resampler bank object
+void RRESAMPBANK(_reset)(RRESAMPBANK() _q)
+{
+    // clear all channel state
+    memset(_q->w, 0, _q->h_sub_len*_q->num_channels*sizeof(TI));
+}
+
+// Set output scaling for filter
+//  _q      : resampler bank object
+//  _scale  : scaling factor to apply to each output sample
+void RRESAMPBANK(_set_scale)(RRESAMPBANK() _q,
+                             TC            _scale)
+{
+    _q->scale = _scale;
+}
+
+// Get output scaling for filter
+//  _q      : resampler bank object
+//  _scale  : scaling factor to apply to each output sample
+void RRESAMPBANK(_get_scale)(RRESAMPBANK() _q,
+                             TC *          _scale)
+{
+    *_scale = _q->scale;
+}
+
+// get resampler filter delay (semi-length m)
+unsigned int RRESAMPBANK(_get_delay)(RRESAMPBANK() _q)
+{
+    return _q->m;
+}
+
+// get block length
+unsigned int RRESAMPBANK(_get_block_len)(RRESAMPBANK() _q)
+{
+    return _q->block_len;
+}
+
+// Get rate of resampler, r = P/Q
+float RRESAMPBANK(_get_rate)(RRESAMPBANK() _q)
+{
+    return (float)(_q->P) / (float)(_q->Q);
+}
+
+// Get number of parallel channels
+unsigned int RRESAMPBANK(_get_num_channels)(RRESAMPBANK() _q)
+{
+    return _q->num_channels;
+}
+
+// Execute resampler bank on one interleaved block of input samples
+//  _q  : resampler bank object
+//  _x  : input sample array, [size: Q*num_channels x 1]
+//  _y  : output sample array [size: P*num_channels x 1]
+void RRESAMPBANK(_execute)(RRESAMPBANK() _q,
+                           TI *          _x,
+                           TO *          _y)
+{
+    RRESAMPBANK(_execute_block)(_q, _x, 1, _y);
+}
+
+// Execute resampler bank on a block of interleaved input samples;
+// equivalent to _n successive calls to execute()
+//  _q  : resampler bank object
+//  _x  : input sample array, [size: _n*Q*num_channels x 1]
+//  _n  : block size (number of execute() input blocks)
+//  _y  : output sample array [size: _n*P*num_channels x 1]
+void RRESAMPBANK(_execute_block)(RRESAMPBANK() _q,
+                                 TI *          _x,
+                                 unsigned int  _n,
+                                 TO *          _y)
+{
+    unsigned int nc = _q->num_channels;
+    unsigned int b;
+    for (b=0; b<_n*_q->block_len; b++) {
+        // run one primitive block from the pre-computed schedule
+        const unsigned int * index = _q->sched_index;
+        unsigned int i, k, t, ch, n=0;
+        for (i=0; i<_q->Q; i++) {
+            // push one input sample per channel: shift the interleaved
+            // window up one tap row and append the new row
+            memmove(_q->w, _q->w + nc, (_q->h_sub_len-1)*nc*sizeof(TI));
+            memcpy(_q->w + (_q->h_sub_len-1)*nc, _x + i*nc, nc*sizeof(TI));
+
+            // produce scheduled outputs, applying each tap across all
+            // channels in one contiguous pass
+            for (k=0; k<_q->sched_num[i]; k++) {
+                const TC * hp = _q->h + (*index++)*_q->h_sub_len;
+                TO *       yp = _y + (n++)*nc;
+                for (ch=0; ch<nc; ch++)
+                    yp[ch] = 0;
+                for (t=0; t<_q->h_sub_len; t++) {
+                    TC c = hp[t];
+                    const TI * wp = _q->w + t*nc;
+                    for (ch=0; ch<nc; ch++)
+                        yp[ch] += c * wp[ch];
+                }
+                for (ch=0; ch<nc; ch++)
+                    yp[ch] *= _q->scale;
+            }
+        }
+
+        // update input/output pointers
+        _x += _q->Q * nc;
+        _y += _q->P * nc;
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Sparse finite impulse response filter: long-span filters with only a
+// few non-zero taps (e.g. comb and echo-profile filters), computing
+// the output by gathering samples at the non-zero tap delays instead
+// of running a dense dot product over the full span
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// defined:
+//  SFIRFILT()      name-mangling macro
+//  TO              output data type
+//  TC              coefficients data type
+//  TI              input data type
+//  WINDOW()        window macro
+//  PRINTVAL()      print macro(s)
+
+// sfirfilt object structure
+struct SFIRFILT(_s) {
+    TC *            h;          // non-zero filter coefficients
+    unsigned int *  d;          // tap delays (in samples)
+    unsigned int    num_taps;   // number of non-zero taps
+    unsigned int    h_len;      // filter span (maximum delay plus one)
+    WINDOW()        w;          // internal sample buffer
+    TC              scale;      // output scaling factor
+};
+
+// create sparse filter from a list of delay/coefficient pairs
+//  _h          : filter coefficients, [size: _num_taps x 1]
+//  _delays     : tap delays (in samples), [size: _num_taps x 1]
+//  _num_taps   : number of non-zero taps, _num_taps > 0
+SFIRFILT() SFIRFILT(_create)(TC *           _h,
+                             unsigned int * _delays,
+                             unsigned int   _num_taps)
+{
+    // validate input
+    if (_num_taps == 0) {
+        fprintf(stderr,"error: sfirfilt_%s_create(), filter must have at least one tap\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create filter object and initialize
+    SFIRFILT() q = (SFIRFILT()) malloc(sizeof(struct SFIRFILT(_s)));
+    q->num_taps = _num_taps;
+    q->scale    = 1;
+
+    // copy coefficients and delays, computing filter span
+    q->h = (TC*)           malloc(q->num_taps * sizeof(TC));
+    q->d = (unsigned int*) malloc(q->num_taps * sizeof(unsigned int));
+    memmove(q->h, _h,      q->num_taps * sizeof(TC));
+    memmove(q->d, _delays, q->num_taps * sizeof(unsigned int));
+    unsigned int i;
+    q->h_len = 0;
+    for (i=0; i<q->num_taps; i++) {
+        if (q->d[i] + 1 > q->h_len)
+            q->h_len = q->d[i] + 1;
+    }
+
+    // create internal sample buffer spanning the full delay range
+    q->w = WINDOW(_create)(q->h_len);
+
+    // reset filter state (clear buffer)
+    SFIRFILT(_reset)(q);
+    return q;
+}
+
+// destroy sfirfilt object, freeing all internal memory
+void SFIRFILT(_destroy)(SFIRFILT() _q)
+{
+    WINDOW(_destroy)(_q->w);
+    free(_q->h);
+    free(_q->d);
+    free(_q);
+}
+
+// reset internal state of filter object
+void SFIRFILT(_reset)(SFIRFILT() _q)
+{
+    WINDOW(_reset)(_q->w);
+}
+
+// print filter object internals
+void SFIRFILT(_print)(SFIRFILT() _q)
+{
+    printf("sfirfilt_%s: [%u taps, span %u]\n",
+            EXTENSION_FULL, _q->num_taps, _q->h_len);
+    unsigned int i;
+    for (i=0; i<_q->num_taps; i++) {
+        printf("  h(%4u) = ", _q->d[i]);
+        PRINTVAL_TC(_q->h[i],%12.8f);
+        printf("\n");
+    }
+}
+
+// set output scaling for filter
+void SFIRFILT(_set_scale)(SFIRFILT() _q,
+                          TC         _scale)
+{
+    _q->scale = _scale;
+}
+
+// get output scaling for filter
+void SFIRFILT(_get_scale)(SFIRFILT() _q,
+                          TC *       _scale)
+{
+    *_scale = _q->scale;
+}
+
+// push sample into filter object's internal buffer
+//  _q      : filter object
+//  _x      : input sample
+void SFIRFILT(_push)(SFIRFILT() _q,
+                     TI         _x)
+{
+    WINDOW(_push)(_q->w, _x);
+}
+
+// write block of samples into filter object's internal buffer
+//  _q      : filter object
+//  _x      : array of input samples, [size: _n x 1]
+//  _n      : number of input elements
+void SFIRFILT(_write)(SFIRFILT()   _q,
+                      TI *         _x,
+                      unsigned int _n)
+{
+    WINDOW(_write)(_q->w, _x, _n);
+}
+
+// compute output sample by gathering buffer samples at the
+// non-zero tap delays
+//  _q      : filter object
+//  _y      : output sample pointer
+void SFIRFILT(_execute)(SFIRFILT() _q,
+                        TO *       _y)
+{
+    // read buffer (retrieve pointer to aligned memory array)
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+
+    // gather: sample at delay d is h_len-1-d entries from the end
+    unsigned int i;
+    TO y = 0;
+    for (i=0; i<_q->num_taps; i++)
+        y += _q->h[i] * r[_q->h_len - 1 - _q->d[i]];
+
+    // set return value, applying scaling factor
+    *_y = y * _q->scale;
+}
+
+// execute the filter on a block of input samples; the
+// input and output buffers may be the same
+//  _q      : filter object
+//  _x      : pointer to input array [size: _n x 1]
+//  _n      : number of input, output samples
+//  _y      : pointer to output array [size: _n x 1]
+void SFIRFILT(_execute_block)(SFIRFILT()   _q,
+                              TI *         _x,
+                              unsigned int _n,
+                              TO *         _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // push sample into filter
+        SFIRFILT(_push)(_q, _x[i]);
+
+        // compute output sample
+        SFIRFILT(_execute)(_q, &_y[i]);
+    }
+}
+
+// get length of filter object's impulse response span
+unsigned int SFIRFILT(_get_length)(SFIRFILT() _q)
+{
+    return _q->h_len;
+}
+
+// get number of non-zero taps in filter object
+unsigned int SFIRFILT(_get_num_taps)(SFIRFILT() _q)
+{
+    return _q->num_taps;
+}
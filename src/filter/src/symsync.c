@@ -38,6 +38,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
+
+// smoothing factor for timing-error tracking statistics
+#define SYMSYNC_STATS_ALPHA (0.02f)
 
 #define DEBUG_SYMSYNC           0
 #define DEBUG_SYMSYNC_PRINT     0
@@ -102,6 +106,16 @@ struct SYMSYNC(_s) {
     FIRPFB()      mf;           // matched filter
     FIRPFB()     dmf;           // derivative matched filter
 
+    // timing-tracking statistics, updated once per symbol and published
+    // through a sequence counter (odd while an update is in flight) so a
+    // monitoring thread can take a consistent snapshot without a mutex
+    atomic_uint       stats_seq;        // sequence counter
+    float             stats_err_mean;   // EWMA of timing error
+    float             stats_err_var;    // EWMA of timing error variance
+    float             stats_rate;       // resampling rate at last update
+    float             stats_tau;        // timing phase at last update
+    unsigned long int stats_num_symbols;// symbols through timing loop
+
 #if DEBUG_SYMSYNC
     windowf debug_rate;
     windowf debug_del;
@@ -172,14 +186,18 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
     for (i=0; i<_h_len; i++)
         dh[i] *= 0.06f / hdh_max;
 
+    // create matched filter bank; the derivative bank shares its window
+    // buffer so both filters run over one stream in a single combined
+    // polyphase pass
     q->mf  = FIRPFB(_create)(q->npfb, _h, _h_len);
-    q->dmf = FIRPFB(_create)(q->npfb, dh, _h_len);
+    q->dmf = FIRPFB(_create_shared_window)(q->mf, dh, _h_len);
 
     // reset state and initialize loop filter
     q->A[0] = 1.0f;     q->B[0] = 0.0f;
     q->A[1] = 0.0f;     q->B[1] = 0.0f;
     q->A[2] = 0.0f;     q->B[2] = 0.0f;
     q->pll = iirfiltsos_rrrf_create(q->B, q->A);
+    atomic_init(&q->stats_seq, 0);
     SYMSYNC(_reset)(q);
     SYMSYNC(_set_lf_bw)(q, 0.01f);
 
@@ -307,9 +325,10 @@ void SYMSYNC(_destroy)(SYMSYNC() _q)
     windowf_destroy(_q->debug_q_hat);
 #endif
 
-    // destroy filterbank objects
-    FIRPFB(_destroy)(_q->mf);
+    // destroy filterbank objects (derivative bank shares the matched
+    // filter's window buffer so it must be destroyed first)
     FIRPFB(_destroy)(_q->dmf);
+    FIRPFB(_destroy)(_q->mf);
 
     // destroy timing phase-locked loop filter
     iirfiltsos_rrrf_destroy(_q->pll);
@@ -342,6 +361,18 @@ void SYMSYNC(_reset)(SYMSYNC() _q)
     _q->q_hat         = 0.0f;   // filtered timing error
     _q->decim_counter = 0;      // decimated output counter
 
+    // clear tracking statistics under the sequence counter in case a
+    // monitoring thread reads concurrently
+    unsigned int seq = atomic_load_explicit(&_q->stats_seq, memory_order_relaxed);
+    atomic_store_explicit(&_q->stats_seq, seq+1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    _q->stats_err_mean    = 0.0f;
+    _q->stats_err_var     = 0.0f;
+    _q->stats_rate        = _q->rate;
+    _q->stats_tau         = 0.0f;
+    _q->stats_num_symbols = 0;
+    atomic_store_explicit(&_q->stats_seq, seq+2, memory_order_release);
+
     // reset timing phase-locked loop filter
     iirfiltsos_rrrf_reset(_q->pll);
 }
@@ -416,6 +447,85 @@ float SYMSYNC(_get_tau)(SYMSYNC() _q)
     return _q->tau_decim;
 }
 
+// get consistent snapshot of timing-tracking statistics; spins until a
+// read completes without racing the per-symbol update
+//  _q      : synchronizer object
+//  _stats  : output statistics snapshot
+void SYMSYNC(_get_stats)(SYMSYNC()              _q,
+                         liquid_symsync_stats * _stats)
+{
+    unsigned int s0;
+    unsigned int s1;
+    do {
+        s0 = atomic_load_explicit(&_q->stats_seq, memory_order_acquire);
+        _stats->timing_error_mean = _q->stats_err_mean;
+        _stats->timing_error_var  = _q->stats_err_var;
+        _stats->rate              = _q->stats_rate;
+        _stats->tau               = _q->stats_tau;
+        _stats->num_symbols       = _q->stats_num_symbols;
+        atomic_thread_fence(memory_order_acquire);
+        s1 = atomic_load_explicit(&_q->stats_seq, memory_order_relaxed);
+    } while ( (s0 & 1) || s0 != s1 );
+}
+
+// get size of serialized timing state [bytes]
+unsigned int SYMSYNC(_get_state_size)(SYMSYNC() _q)
+{
+    return 7*sizeof(float) + sizeof(int);
+}
+
+// save converged timing state (resampling rate, timing phase and
+// filtered error) into buffer for later warm start; the loop filter
+// memory is not captured and re-settles within a few symbols
+//  _q       : synchronizer object
+//  _buf     : output buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match SYMSYNC(_get_state_size)
+void SYMSYNC(_save_state)(SYMSYNC()       _q,
+                          unsigned char * _buf,
+                          unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != SYMSYNC(_get_state_size)(_q)) {
+        fprintf(stderr,"error: symsync_%s_save_state(), invalid buffer length %u (expected %u)\n",
+                EXTENSION_FULL, _buf_len, SYMSYNC(_get_state_size)(_q));
+        exit(1);
+    }
+
+    float v[7] = {_q->rate, _q->del, _q->tau, _q->tau_decim,
+                  _q->bf,   _q->q,   _q->q_hat};
+    memmove(_buf,                 v,      7*sizeof(float));
+    memmove(_buf+7*sizeof(float), &_q->b, sizeof(int));
+}
+
+// restore timing state previously saved with SYMSYNC(_save_state);
+// the object must have the same configuration (samples/symbol, filter
+// bank size) as the one the state was saved from
+//  _q       : synchronizer object
+//  _buf     : input buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match SYMSYNC(_get_state_size)
+void SYMSYNC(_restore_state)(SYMSYNC()       _q,
+                             unsigned char * _buf,
+                             unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != SYMSYNC(_get_state_size)(_q)) {
+        fprintf(stderr,"error: symsync_%s_restore_state(), invalid buffer length %u (expected %u)\n",
+                EXTENSION_FULL, _buf_len, SYMSYNC(_get_state_size)(_q));
+        exit(1);
+    }
+
+    float v[7];
+    memmove(v,      _buf,                 7*sizeof(float));
+    memmove(&_q->b, _buf+7*sizeof(float), sizeof(int));
+    _q->rate      = v[0];
+    _q->del       = v[1];
+    _q->tau       = v[2];
+    _q->tau_decim = v[3];
+    _q->bf        = v[4];
+    _q->q         = v[5];
+    _q->q_hat     = v[6];
+}
+
 // execute synchronizer on input data array
 //  _q      : synchronizer object
 //  _x      : input data array
@@ -437,6 +547,77 @@ void SYMSYNC(_execute)(SYMSYNC()      _q,
     *_ny = ny;
 }
 
+// execute synchronizer on a large block of input samples; equivalent to
+// the execute() method but optimized for streaming operation: when the
+// synchronizer is locked the rate is constant and the timing-error
+// update is hoisted out of the inner loop entirely
+//  _q      : synchronizer object
+//  _x      : input data array
+//  _nx     : number of input samples
+//  _y      : output data array
+//  _ny     : number of samples written to output buffer
+void SYMSYNC(_execute_stream)(SYMSYNC()      _q,
+                              TI *           _x,
+                              unsigned int   _nx,
+                              TO *           _y,
+                              unsigned int * _ny)
+{
+    // timing updates enabled: run regular per-sample step logic
+    if (!_q->is_locked) {
+        SYMSYNC(_execute)(_q, _x, _nx, _y, _ny);
+        return;
+    }
+
+    // synchronizer locked: rate and fractional delay step are constant,
+    // so interpolate with no loop-filter or decimation branches
+    TO mf;              // matched filter output
+    unsigned int i;
+    unsigned int ny=0;  // number of output samples written
+    for (i=0; i<_nx; i++) {
+        // push sample into MF filterbank
+        FIRPFB(_push)(_q->mf, _x[i]);
+
+        // continue loop until filterbank index rolls over
+        while (_q->b < _q->npfb) {
+            // compute filterbank output, scaled by samples/symbol
+            FIRPFB(_execute)(_q->mf, _q->b, &mf);
+            _y[ny++] = mf / (float)(_q->k);
+
+            // maintain decimation counter so that unlocking resumes at
+            // the correct timing-update phase
+            if (_q->decim_counter == _q->k_out)
+                _q->decim_counter = 0;
+            _q->decim_counter++;
+
+            // update states
+            _q->tau += _q->del;                     // instantaneous fractional offset
+            _q->bf  = _q->tau * (float)(_q->npfb);  // filterbank index (soft)
+            _q->b   = (int)roundf(_q->bf);          // filterbank index
+        }
+
+        // filterbank index rolled over; update states
+        _q->tau -= 1.0f;                // instantaneous fractional offset
+        _q->bf  -= (float)(_q->npfb);   // filterbank index (soft)
+        _q->b   -= _q->npfb;            // filterbank index
+    }
+
+    // set output number of samples written
+    *_ny = ny;
+}
+
+// get upper bound on the number of output samples written by a single
+// call to the execute methods with _nx input samples
+//  _q      : synchronizer object
+//  _nx     : number of input samples
+unsigned int SYMSYNC(_get_output_max)(SYMSYNC()    _q,
+                                      unsigned int _nx)
+{
+    // the nominal output count is _nx * k_out / k; the timing loop can
+    // transiently slow the effective rate, so size the bound for twice
+    // the nominal rate plus one sample for the phase roll-over
+    return (unsigned int) ceilf(2.0f * _nx * (float)_q->k_out / (float)_q->k) + 1;
+}
+
 //
 // internal methods
 //
@@ -451,9 +632,9 @@ void SYMSYNC(_step)(SYMSYNC()      _q,
                     TO *           _y,
                     unsigned int * _ny)
 {
-    // push sample into MF and dMF filterbanks
+    // push sample into MF filterbank; the dMF outputs are computed
+    // against the same input buffer by the fused execute-pair method
     FIRPFB(_push)(_q->mf,  _x);
-    FIRPFB(_push)(_q->dmf, _x);
 
     // matched and derivative matched-filter outputs
     TO  mf; // matched filter output
@@ -468,8 +649,13 @@ void SYMSYNC(_step)(SYMSYNC()      _q,
         printf("  [%2u] : tau : %12.8f, b : %4u (%12.8f)\n", n, _q->tau, _q->b, _q->bf);
 #endif
 
-        // compute filterbank output
-        FIRPFB(_execute)(_q->mf, _q->b, &mf);
+        // compute filterbank output; fuse with the derivative bank in a
+        // single pass over the input buffer when this output triggers a
+        // timing update
+        if (_q->decim_counter == _q->k_out && !_q->is_locked)
+            FIRPFB(_execute_pair)(_q->mf, _q->dmf, _q->b, &mf, &dmf);
+        else
+            FIRPFB(_execute)(_q->mf, _q->b, &mf);
 
         // scale output by samples/symbol
         _y[n] = mf / (float)(_q->k);
@@ -493,10 +679,7 @@ void SYMSYNC(_step)(SYMSYNC()      _q,
             if (_q->is_locked)
                 continue;
 
-            // compute dMF output
-            FIRPFB(_execute)(_q->dmf, _q->b, &dmf);
-
-            // update internal state
+            // update internal state (dMF output computed above)
             SYMSYNC(_advance_internal_loop)(_q, mf, dmf);
             _q->tau_decim = _q->tau;    // save return value
         }
@@ -547,6 +730,20 @@ void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
     _q->rate += _q->rate_adjustment * _q->q_hat;
     _q->del   = _q->rate + _q->q_hat;
 
+    //  4. update tracking statistics; the sequence counter is odd while
+    //     the fields are being written so SYMSYNC(_get_stats) can detect
+    //     and retry a torn read
+    unsigned int seq = atomic_load_explicit(&_q->stats_seq, memory_order_relaxed);
+    atomic_store_explicit(&_q->stats_seq, seq+1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    float d = _q->q - _q->stats_err_mean;
+    _q->stats_err_mean += SYMSYNC_STATS_ALPHA * d;
+    _q->stats_err_var  += SYMSYNC_STATS_ALPHA * (d*d - _q->stats_err_var);
+    _q->stats_rate      = _q->rate;
+    _q->stats_tau       = _q->tau_decim;
+    _q->stats_num_symbols++;
+    atomic_store_explicit(&_q->stats_seq, seq+2, memory_order_release);
+
 #if DEBUG_SYMSYNC_PRINT
     printf("q : %12.8f, rate : %12.8f, del : %12.8f, q_hat : %12.8f\n", _q->q, _q->rate, _q->del, _q->q_hat);
 #endif
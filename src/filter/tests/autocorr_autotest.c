@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// multi-lag auto-correlation matches a bank of single-lag objects run
+// with one fixed delay each
+void testbench_autocorr_cccf_multi(unsigned int _window_size,
+                                   unsigned int _num_lags)
+{
+    unsigned int num_samples = 4*(_window_size + _num_lags);
+    float        tol         = 1e-3f;
+    unsigned int i, l;
+
+    // create multi-lag object and reference bank of single-lag objects
+    autocorr_cccf q = autocorr_cccf_create_multi(_window_size, _num_lags);
+    autocorr_cccf q_ref[_num_lags];
+    for (l=0; l<_num_lags; l++)
+        q_ref[l] = autocorr_cccf_create(_window_size, l);
+
+    // push noise samples into all objects
+    for (i=0; i<num_samples; i++) {
+        float complex x = randnf() + _Complex_I*randnf();
+        autocorr_cccf_push(q, x);
+        for (l=0; l<_num_lags; l++)
+            autocorr_cccf_push(q_ref[l], x);
+    }
+
+    // compute all lags in one pass and compare to the reference bank
+    float complex rxx[_num_lags];
+    autocorr_cccf_execute_multi(q, rxx);
+    for (l=0; l<_num_lags; l++) {
+        float complex rxx_ref;
+        autocorr_cccf_execute(q_ref[l], &rxx_ref);
+        CONTEND_DELTA( crealf(rxx[l]), crealf(rxx_ref), tol );
+        CONTEND_DELTA( cimagf(rxx[l]), cimagf(rxx_ref), tol );
+    }
+
+    // destroy objects
+    autocorr_cccf_destroy(q);
+    for (l=0; l<_num_lags; l++)
+        autocorr_cccf_destroy(q_ref[l]);
+}
+
+// exercise both engines: dot products below the lag-count threshold,
+// transforms above
+void autotest_autocorr_cccf_multi_dotprod() { testbench_autocorr_cccf_multi(40,  8); }
+void autotest_autocorr_cccf_multi_fft()     { testbench_autocorr_cccf_multi(40, 64); }
+
+// real-valued input with the transform engine
+void autotest_autocorr_rrrf_multi_fft()
+{
+    unsigned int window_size = 64;
+    unsigned int num_lags    = 48;
+    unsigned int num_samples = 400;
+    float        tol         = 1e-3f;
+    unsigned int i, l;
+
+    autocorr_rrrf q = autocorr_rrrf_create_multi(window_size, num_lags);
+    autocorr_rrrf q_ref[num_lags];
+    for (l=0; l<num_lags; l++)
+        q_ref[l] = autocorr_rrrf_create(window_size, l);
+
+    for (i=0; i<num_samples; i++) {
+        float x = randnf();
+        autocorr_rrrf_push(q, x);
+        for (l=0; l<num_lags; l++)
+            autocorr_rrrf_push(q_ref[l], x);
+    }
+
+    float rxx[num_lags];
+    autocorr_rrrf_execute_multi(q, rxx);
+    for (l=0; l<num_lags; l++) {
+        float rxx_ref;
+        autocorr_rrrf_execute(q_ref[l], &rxx_ref);
+        CONTEND_DELTA( rxx[l], rxx_ref, tol );
+    }
+
+    autocorr_rrrf_destroy(q);
+    for (l=0; l<num_lags; l++)
+        autocorr_rrrf_destroy(q_ref[l]);
+}
@@ -117,3 +117,49 @@ void autotest_fftfilt_cccf_data_h23x256()
 }
 
 
+
+//
+// AUTOTEST: multi-block execution matches per-block execution exactly
+//
+void autotest_fftfilt_crcf_execute_block()
+{
+    unsigned int h_len      = 17;   // filter length
+    unsigned int n          = 64;   // block size
+    unsigned int num_blocks = 12;   // number of blocks to process
+    float        tol        = 1e-6f;
+
+    // generate random filter coefficients and input signal
+    float         h[h_len];
+    float complex x[n*num_blocks];
+    unsigned int  i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+    for (i=0; i<n*num_blocks; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // create two identical filter objects
+    fftfilt_crcf q0 = fftfilt_crcf_create(h, h_len, n);
+    fftfilt_crcf q1 = fftfilt_crcf_create(h, h_len, n);
+
+    // run reference one block at a time
+    float complex y0[n*num_blocks];
+    for (i=0; i<num_blocks; i++)
+        fftfilt_crcf_execute(q0, &x[i*n], &y0[i*n]);
+
+    // run multi-block execution in two calls to exercise the
+    // overlap hand-off between calls
+    float complex y1[n*num_blocks];
+    fftfilt_crcf_execute_block(q1, x, num_blocks/2, y1);
+    fftfilt_crcf_execute_block(q1, &x[(num_blocks/2)*n],
+            num_blocks - num_blocks/2, &y1[(num_blocks/2)*n]);
+
+    // verify results
+    for (i=0; i<n*num_blocks; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), tol);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), tol);
+    }
+
+    // destroy filter objects
+    fftfilt_crcf_destroy(q0);
+    fftfilt_crcf_destroy(q1);
+}
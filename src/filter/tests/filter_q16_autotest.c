@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: fixed-point filter on interleaved q15 samples against
+//           floating-point firfilt_crcf reference
+//
+void autotest_firfilt_crcq16()
+{
+    unsigned int h_len      = 21;   // filter length
+    unsigned int num_samples= 80;   // number of samples to run
+    float        tol        = 4.0f / 32768.0f;
+
+    // generate coefficients and input, quantizing both so the
+    // floating-point reference sees exactly the fixed-point values
+    float        hf[h_len];
+    int16_t      h [h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++) {
+        hf[i] = 0.1f * randnf();
+        h[i]  = (int16_t)roundf(hf[i] * 32768.0f);
+        hf[i] = (float)h[i] / 32768.0f;
+    }
+
+    float complex xf[num_samples];
+    int16_t       x [2*num_samples];
+    for (i=0; i<num_samples; i++) {
+        x[2*i  ] = (int16_t)roundf(0.1f * randnf() * 32768.0f);
+        x[2*i+1] = (int16_t)roundf(0.1f * randnf() * 32768.0f);
+        xf[i]    = ((float)x[2*i] + (float)x[2*i+1]*_Complex_I) / 32768.0f;
+    }
+
+    // create both filters with the same response
+    firfilt_crcq16 q0 = firfilt_crcq16_create(h, h_len);
+    firfilt_crcf   q1 = firfilt_crcf_create(hf, h_len);
+
+    CONTEND_EQUALITY(firfilt_crcq16_get_length(q0), h_len);
+
+    // run and compare
+    int16_t       y [2*num_samples];
+    float complex yf[num_samples];
+    firfilt_crcq16_execute_block(q0, x, num_samples, y);
+    firfilt_crcf_execute_block  (q1, xf, num_samples, yf);
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA((float)y[2*i  ] / 32768.0f, crealf(yf[i]), tol);
+        CONTEND_DELTA((float)y[2*i+1] / 32768.0f, cimagf(yf[i]), tol);
+    }
+
+    // destroy objects
+    firfilt_crcq16_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+//
+// AUTOTEST: fixed-point decimator on interleaved q15 samples against
+//           floating-point firdecim_crcf reference
+//
+void autotest_firdecim_crcq16()
+{
+    unsigned int M          = 4;    // decimation factor
+    unsigned int h_len      = 21;   // filter length
+    unsigned int num_samples= 20;   // number of output samples
+    float        tol        = 4.0f / 32768.0f;
+
+    // generate coefficients and input, quantizing both so the
+    // floating-point reference sees exactly the fixed-point values
+    float        hf[h_len];
+    int16_t      h [h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++) {
+        hf[i] = 0.1f * randnf();
+        h[i]  = (int16_t)roundf(hf[i] * 32768.0f);
+        hf[i] = (float)h[i] / 32768.0f;
+    }
+
+    float complex xf[M*num_samples];
+    int16_t       x [2*M*num_samples];
+    for (i=0; i<M*num_samples; i++) {
+        x[2*i  ] = (int16_t)roundf(0.1f * randnf() * 32768.0f);
+        x[2*i+1] = (int16_t)roundf(0.1f * randnf() * 32768.0f);
+        xf[i]    = ((float)x[2*i] + (float)x[2*i+1]*_Complex_I) / 32768.0f;
+    }
+
+    // create both decimators with the same response
+    firdecim_crcq16 q0 = firdecim_crcq16_create(M, h, h_len);
+    firdecim_crcf   q1 = firdecim_crcf_create(M, hf, h_len);
+
+    // run and compare
+    int16_t       y [2*num_samples];
+    float complex yf[num_samples];
+    firdecim_crcq16_execute_block(q0, x, num_samples, y);
+    firdecim_crcf_execute_block  (q1, xf, num_samples, yf);
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA((float)y[2*i  ] / 32768.0f, crealf(yf[i]), tol);
+        CONTEND_DELTA((float)y[2*i+1] / 32768.0f, cimagf(yf[i]), tol);
+    }
+
+    // destroy objects
+    firdecim_crcq16_destroy(q0);
+    firdecim_crcf_destroy(q1);
+}
@@ -90,6 +90,34 @@ void autotest_liquid_firdes_rrcos() {
 }
 
 
+void autotest_liquid_firdes_prototype_cached()
+{
+    // Initialize variables
+    unsigned int k=4, m=7;
+    float beta=0.25f;
+    unsigned int h_len = 2*k*m+1;
+
+    // design filter directly
+    float h[h_len];
+    liquid_firdes_prototype(LIQUID_FIRFILT_RRC,k,m,beta,0,h);
+
+    // request same design through cache; coefficients match exactly
+    // (same design path)
+    const float * h0 = liquid_firdes_prototype_cached(LIQUID_FIRFILT_RRC,k,m,beta,0);
+    CONTEND_SAME_DATA( h, h0, h_len*sizeof(float) );
+
+    // second request returns the same shared array without re-design
+    const float * h1 = liquid_firdes_prototype_cached(LIQUID_FIRFILT_RRC,k,m,beta,0);
+    CONTEND_EQUALITY( h0 == h1, 1 );
+
+    // different parameters map to a distinct entry
+    const float * h2 = liquid_firdes_prototype_cached(LIQUID_FIRFILT_RRC,k,m,0.35f,0);
+    CONTEND_EQUALITY( h0 == h2, 0 );
+
+    // clear cache, freeing shared arrays
+    liquid_firdes_cache_clear();
+}
+
 void autotest_liquid_firdes_rkaiser()
 {
     // Initialize variables
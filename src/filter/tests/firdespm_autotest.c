@@ -145,3 +145,35 @@ void autotest_firdespm_bandpass_n32()
         CONTEND_DELTA( h[i], h0[i], tol );
 }
 
+
+void autotest_firdespm_execute_reuse()
+{
+    // verify that a warm-started re-design on a reused object matches
+    // a fresh design of the same specification
+
+    // initialize variables
+    unsigned int n=57;
+    unsigned int num_bands=2;
+    float bands[4]  = {0.0f,0.15f,0.23f,0.50f};
+    float des[2]    = {1.0f,0.0f};
+    float weights[2]= {1.0f,1.0f};
+    liquid_firdespm_btype btype = LIQUID_FIRDESPM_BANDPASS;
+    float tol = 1e-5f;
+    unsigned int i;
+
+    // reference design (fresh object)
+    float h0[n];
+    firdespm_run(n,num_bands,bands,des,weights,NULL,btype,h0);
+
+    // design on reusable object: first regular execution, then a
+    // warm-started re-design of the same specification
+    float h1[n];
+    firdespm q = firdespm_create(n,num_bands,bands,des,weights,NULL,btype);
+    firdespm_execute(q,h1);
+    firdespm_execute_reuse(q,h1);
+    firdespm_destroy(q);
+
+    // ensure data are equal
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( h0[i], h1[i], tol );
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// test block-based execution against single-sample push/execute,
+// splitting the input across several calls to exercise history carry
+void firfilt_crcf_test_block(unsigned int _h_len,
+                             unsigned int _n)
+{
+    unsigned int i;
+    float tol = 0.001f;
+
+    // design prototype filter
+    firfilt_crcf q0 = firfilt_crcf_create_kaiser(_h_len, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf q1 = firfilt_crcf_create_kaiser(_h_len, 0.2f, 60.0f, 0.0f);
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(_n*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(_n*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_n*sizeof(float complex));
+
+    // initialize random input
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // compute reference with single-sample interface
+    for (i=0; i<_n; i++) {
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    // compute output with block interface, splitting input in two
+    unsigned int n0 = _n/3;
+    firfilt_crcf_execute_block(q1, x,      n0,     y1   );
+    firfilt_crcf_execute_block(q1, x+n0, _n-n0,    y1+n0);
+
+    // validate results
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // validate in-place operation
+    firfilt_crcf_reset(q1);
+    firfilt_crcf_execute_block(q1, x, _n, x);
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(x[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(x[i]), tol );
+    }
+
+    // destroy objects and free memory
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_firfilt_crcf_block_h13x40()   { firfilt_crcf_test_block( 13,   40); }
+void autotest_firfilt_crcf_block_h57x1200() { firfilt_crcf_test_block( 57, 1200); }
+void autotest_firfilt_crcf_block_h80x400()  { firfilt_crcf_test_block( 80,  400); }
+
+// test auto-selected (frequency-domain) implementation against the
+// regular time-domain filter, mixing single-sample and block interfaces
+void firfilt_crcf_test_auto(unsigned int _h_len,
+                            unsigned int _n)
+{
+    unsigned int i;
+    float tol = 0.001f;
+
+    // design filter coefficients
+    float h[_h_len];
+    liquid_firdes_kaiser(_h_len, 0.17f, 60.0f, 0.0f, h);
+
+    // create reference and auto-selected filter objects
+    firfilt_crcf q0 = firfilt_crcf_create     (h, _h_len);
+    firfilt_crcf q1 = firfilt_crcf_create_auto(h, _h_len);
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(_n*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(_n*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_n*sizeof(float complex));
+
+    // initialize random input
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // compute reference with single-sample interface
+    for (i=0; i<_n; i++) {
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    // compute output mixing single-sample and block interfaces
+    unsigned int n0 = 10; // leading samples pushed individually
+    for (i=0; i<n0; i++) {
+        firfilt_crcf_push(q1, x[i]);
+        firfilt_crcf_execute(q1, &y1[i]);
+    }
+    firfilt_crcf_execute_block(q1, x+n0, _n-n0, y1+n0);
+
+    // validate results
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects and free memory
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_firfilt_crcf_auto_h200x2400() { firfilt_crcf_test_auto(200, 2400); }
+void autotest_firfilt_crcf_auto_h400x3000() { firfilt_crcf_test_auto(400, 3000); }
+
+// test clone with shared coefficients against the original filter,
+// running the two objects on independent sample streams
+void autotest_firfilt_crcf_clone_shared()
+{
+    unsigned int i;
+    unsigned int h_len = 57;    // filter length
+    unsigned int n     = 400;   // number of samples
+    float tol = 0.001f;
+
+    // create original filter and clone sharing its coefficients
+    firfilt_crcf q0 = firfilt_crcf_create_kaiser(h_len, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf q1 = firfilt_crcf_clone_shared(q0);
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(n*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(n*sizeof(float complex));
+
+    // initialize random input
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // advance the original's buffer state; the clone must be unaffected
+    for (i=0; i<h_len; i++)
+        firfilt_crcf_push(q0, randnf() + randnf()*_Complex_I);
+
+    // run the clone on the input and compare against a fresh original
+    firfilt_crcf_reset(q0);
+    for (i=0; i<n; i++) {
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+    firfilt_crcf_execute_block(q1, x, n, y1);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy the original first; the clone retains the coefficients
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_reset(q1);
+    for (i=0; i<n; i++) {
+        firfilt_crcf_push(q1, x[i]);
+        firfilt_crcf_execute(q1, &y1[i]);
+    }
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy clone and free memory
+    firfilt_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+// lazily-created filters must match their eagerly-designed
+// counterparts once the deferred design has run
+void autotest_firfilt_crcf_lazy()
+{
+    unsigned int i;
+    unsigned int n = 200;
+    float tol = 1e-4f;
+
+    // eager and lazy Kaiser designs; also one prepared explicitly
+    firfilt_crcf q0 = firfilt_crcf_create_kaiser     (57, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf q1 = firfilt_crcf_create_lazy_kaiser(57, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf q2 = firfilt_crcf_create_lazy_kaiser(57, 0.2f, 60.0f, 0.0f);
+    firfilt_crcf_prepare(q2);
+
+    CONTEND_EQUALITY( firfilt_crcf_get_length(q1), 57 );
+
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // first execute triggers the deferred design on q1
+    float complex y0[n];
+    float complex y1[n];
+    float complex y2[n];
+    firfilt_crcf_execute_block(q0, x, n, y0);
+    firfilt_crcf_execute_block(q1, x, n, y1);
+    firfilt_crcf_execute_block(q2, x, n, y2);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+        CONTEND_DELTA( crealf(y0[i]), crealf(y2[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y2[i]), tol );
+    }
+
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+    firfilt_crcf_destroy(q2);
+
+    // square-root Nyquist prototype, single-sample interface
+    firfilt_crcf f0 = firfilt_crcf_create_rnyquist     (LIQUID_FIRFILT_RRC, 2, 7, 0.3f, 0.0f);
+    firfilt_crcf f1 = firfilt_crcf_create_lazy_rnyquist(LIQUID_FIRFILT_RRC, 2, 7, 0.3f, 0.0f);
+    CONTEND_EQUALITY( firfilt_crcf_get_length(f1), 2*2*7+1 );
+    for (i=0; i<n; i++) {
+        float complex v0, v1;
+        firfilt_crcf_push(f0, x[i]);
+        firfilt_crcf_push(f1, x[i]);
+        firfilt_crcf_execute(f0, &v0);
+        firfilt_crcf_execute(f1, &v1);
+        CONTEND_DELTA( crealf(v0), crealf(v1), tol );
+        CONTEND_DELTA( cimagf(v0), cimagf(v1), tol );
+    }
+    firfilt_crcf_destroy(f0);
+    firfilt_crcf_destroy(f1);
+
+    // a never-executed lazy filter is destroyed cleanly
+    firfilt_crcf q3 = firfilt_crcf_create_lazy_kaiser(21, 0.3f, 40.0f, 0.0f);
+    firfilt_crcf_destroy(q3);
+}
+
+// verify length-specialized execute kernels against the block path
+// (generic dot product) across specialized and generic lengths
+void autotest_firfilt_crcf_kernel_lengths()
+{
+    unsigned int lengths[8] = {4, 13, 16, 21, 25, 33, 40, 64};
+    unsigned int num_samples = 256;
+    float        tol         = 1e-4f;
+
+    unsigned int l;
+    unsigned int i;
+
+    for (l=0; l<8; l++) {
+        unsigned int h_len = lengths[l];
+
+        // generate random coefficients and input
+        float h[h_len];
+        for (i=0; i<h_len; i++)
+            h[i] = randnf();
+        float complex x[num_samples];
+        for (i=0; i<num_samples; i++)
+            x[i] = randnf() + randnf()*_Complex_I;
+
+        // create pair of identical filters
+        firfilt_crcf q0 = firfilt_crcf_create(h, h_len);
+        firfilt_crcf q1 = firfilt_crcf_create(h, h_len);
+
+        // run one filter per sample, the other on the whole block
+        float complex y0[num_samples];
+        float complex y1[num_samples];
+        for (i=0; i<num_samples; i++) {
+            firfilt_crcf_push(q0, x[i]);
+            firfilt_crcf_execute(q0, &y0[i]);
+        }
+        firfilt_crcf_execute_block(q1, x, num_samples, y1);
+
+        // verify results match
+        for (i=0; i<num_samples; i++) {
+            CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+            CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+        }
+
+        firfilt_crcf_destroy(q0);
+        firfilt_crcf_destroy(q1);
+    }
+}
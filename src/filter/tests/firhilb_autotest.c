@@ -115,3 +115,84 @@ void autotest_firhilbf_interp()
     firhilbf_destroy(ht);
 }
 
+
+void autotest_firhilbf_decim_block()
+{
+    unsigned int m           = 7;       // filter semi-length
+    unsigned int num_samples = 240;     // number of output samples
+
+    unsigned int i;
+
+    // create two identical transform objects
+    firhilbf q0 = firhilbf_create(m,60.0f);
+    firhilbf q1 = firhilbf_create(m,60.0f);
+
+    // generate pseudo-random input signal
+    float x[2*num_samples];
+    for (i=0; i<2*num_samples; i++)
+        x[i] = randnf();
+
+    // run first object one output sample at a time
+    float complex y0[num_samples];
+    for (i=0; i<num_samples; i++)
+        firhilbf_decim_execute(q0, &x[2*i], &y0[i]);
+
+    // run second object in blocks of varying (odd) sizes
+    float complex y1[num_samples];
+    unsigned int n = 0;
+    while (n < num_samples) {
+        unsigned int k = 1 + (n % 7);
+        if (k > num_samples - n)
+            k = num_samples - n;
+        firhilbf_decim_execute_block(q1, &x[2*n], k, &y1[n]);
+        n += k;
+    }
+
+    // verify block output matches sample-at-a-time output exactly
+    for (i=0; i<num_samples; i++) {
+        CONTEND_EQUALITY( crealf(y0[i]), crealf(y1[i]) );
+        CONTEND_EQUALITY( cimagf(y0[i]), cimagf(y1[i]) );
+    }
+
+    firhilbf_destroy(q0);
+    firhilbf_destroy(q1);
+}
+
+void autotest_firhilbf_decim_freq()
+{
+    unsigned int m           = 7;       // filter semi-length
+    unsigned int num_samples = 240;     // number of output samples
+    float        dphi        = 0.1f;    // residual IF offset [radians/sample]
+    float        tol         = 1e-4f;   // error tolerance
+
+    unsigned int i;
+
+    // create two identical transform objects with fused mixer enabled
+    firhilbf q0 = firhilbf_create(m,60.0f);
+    firhilbf q1 = firhilbf_create(m,60.0f);
+    firhilbf_set_freq(q0, dphi);
+    firhilbf_set_freq(q1, dphi);
+
+    // generate pseudo-random input signal
+    float x[2*num_samples];
+    for (i=0; i<2*num_samples; i++)
+        x[i] = randnf();
+
+    // run first object one output sample at a time and the second as a
+    // single block
+    float complex y0[num_samples];
+    float complex y1[num_samples];
+    for (i=0; i<num_samples; i++)
+        firhilbf_decim_execute(q0, &x[2*i], &y0[i]);
+    firhilbf_decim_execute_block(q1, x, num_samples, y1);
+
+    // verify the fused mixer tracks the same phase trajectory in both
+    // paths (block path uses a phasor recurrence)
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    firhilbf_destroy(q0);
+    firhilbf_destroy(q1);
+}
@@ -76,3 +76,148 @@ void autotest_firpfb_impulse_response()
     firpfb_rrrf_destroy(f);
 }
 
+
+// validate fused execute-pair method against separate execution of
+// matched and derivative matched filter banks
+void autotest_firpfb_execute_pair()
+{
+    unsigned int npfb = 32;     // number of filters in the bank
+    unsigned int k    =  2;     // samples/symbol
+    unsigned int m    =  4;     // filter semi-length
+    unsigned int num_samples = 80;
+    float        tol  = 1e-4f;
+
+    unsigned int i;
+    unsigned int b;
+
+    // create matched and derivative matched filter banks; reference
+    // copies are maintained independently
+    firpfb_crcf  mf0 = firpfb_crcf_create_rnyquist (LIQUID_FIRFILT_RRC, npfb, k, m, 0.3f);
+    firpfb_crcf dmf0 = firpfb_crcf_create_drnyquist(LIQUID_FIRFILT_RRC, npfb, k, m, 0.3f);
+    firpfb_crcf  mf1 = firpfb_crcf_create_rnyquist (LIQUID_FIRFILT_RRC, npfb, k, m, 0.3f);
+    firpfb_crcf dmf1 = firpfb_crcf_create_drnyquist(LIQUID_FIRFILT_RRC, npfb, k, m, 0.3f);
+
+    float complex y0, dy0;  // reference outputs
+    float complex y1, dy1;  // fused outputs
+
+    for (i=0; i<num_samples; i++) {
+        // push sample into all banks (fused pair reads mf1's buffer)
+        float complex x = randnf() + randnf()*_Complex_I;
+        firpfb_crcf_push( mf0, x);
+        firpfb_crcf_push(dmf0, x);
+        firpfb_crcf_push( mf1, x);
+
+        // sweep filter index with input sample
+        b = i % npfb;
+
+        // compute reference and fused outputs
+        firpfb_crcf_execute( mf0, b, &y0);
+        firpfb_crcf_execute(dmf0, b, &dy0);
+        firpfb_crcf_execute_pair(mf1, dmf1, b, &y1, &dy1);
+
+        // validate outputs
+        CONTEND_DELTA( crealf(y0),  crealf(y1),  tol );
+        CONTEND_DELTA( cimagf(y0),  cimagf(y1),  tol );
+        CONTEND_DELTA( crealf(dy0), crealf(dy1), tol );
+        CONTEND_DELTA( cimagf(dy0), cimagf(dy1), tol );
+    }
+
+    // destroy filter bank objects
+    firpfb_crcf_destroy( mf0);
+    firpfb_crcf_destroy(dmf0);
+    firpfb_crcf_destroy( mf1);
+    firpfb_crcf_destroy(dmf1);
+}
+
+void autotest_firpfb_clone_shared()
+{
+    unsigned int npfb = 32;     // number of filters in the bank
+    unsigned int k    =  2;     // samples/symbol
+    unsigned int m    =  4;     // filter semi-length
+    unsigned int num_samples = 80;
+    float        tol  = 1e-4f;
+
+    unsigned int i;
+    unsigned int b;
+
+    // create filter bank and clone sharing its coefficients
+    firpfb_crcf q0 = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, npfb, k, m, 0.3f);
+    firpfb_crcf q1 = firpfb_crcf_clone_shared(q0);
+
+    float complex y0, y1;
+
+    for (i=0; i<num_samples; i++) {
+        // push sample into both banks
+        float complex x = randnf() + randnf()*_Complex_I;
+        firpfb_crcf_push(q0, x);
+        firpfb_crcf_push(q1, x);
+
+        // sweep filter index with input sample
+        b = i % npfb;
+
+        // outputs must match exactly (identical coefficients and state)
+        firpfb_crcf_execute(q0, b, &y0);
+        firpfb_crcf_execute(q1, b, &y1);
+        CONTEND_DELTA( crealf(y0), crealf(y1), tol );
+        CONTEND_DELTA( cimagf(y0), cimagf(y1), tol );
+    }
+
+    // destroy the original first; the clone retains the filter bank
+    firpfb_crcf_destroy(q0);
+    firpfb_crcf_reset(q1);
+    for (i=0; i<num_samples; i++) {
+        firpfb_crcf_push(q1, randnf() + randnf()*_Complex_I);
+        firpfb_crcf_execute(q1, i % npfb, &y1);
+    }
+
+    // destroy clone
+    firpfb_crcf_destroy(q1);
+}
+
+// shared-window bank: a second bank created against the first one's
+// window buffer sees the same samples without a second push, and
+// matches an independent bank fed the same stream
+void autotest_firpfb_create_shared_window()
+{
+    unsigned int npfb  = 16;    // number of filters in the bank
+    unsigned int h_len = 16*9;  // total filter length
+    unsigned int num_samples = 80;
+    float        tol   = 1e-4f;
+
+    unsigned int i;
+
+    // generate two distinct coefficient sets
+    float complex h0[h_len];
+    float complex h1[h_len];
+    for (i=0; i<h_len; i++) {
+        h0[i] = randnf() + randnf()*_Complex_I;
+        h1[i] = randnf() + randnf()*_Complex_I;
+    }
+
+    // create base bank, a bank sharing its window, and an independent
+    // reference with the shared bank's coefficients
+    firpfb_cccf q0 = firpfb_cccf_create(npfb, h0, h_len);
+    firpfb_cccf q1 = firpfb_cccf_create_shared_window(q0, h1, h_len);
+    firpfb_cccf q2 = firpfb_cccf_create(npfb, h1, h_len);
+
+    float complex y1, y2;
+
+    for (i=0; i<num_samples; i++) {
+        // push sample into the base bank only (and the reference)
+        float complex x = randnf() + randnf()*_Complex_I;
+        firpfb_cccf_push(q0, x);
+        firpfb_cccf_push(q2, x);
+
+        // shared bank output must match the independent reference
+        unsigned int b = i % npfb;
+        firpfb_cccf_execute(q1, b, &y1);
+        firpfb_cccf_execute(q2, b, &y2);
+        CONTEND_DELTA( crealf(y1), crealf(y2), tol );
+        CONTEND_DELTA( cimagf(y1), cimagf(y2), tol );
+    }
+
+    // destroy objects (sharing bank before its base)
+    firpfb_cccf_destroy(q1);
+    firpfb_cccf_destroy(q0);
+    firpfb_cccf_destroy(q2);
+}
@@ -238,3 +238,83 @@ void autotest_iir_groupdelay_sos_n8()
     iirfilt_rrrf_destroy(filter);
 }
 
+
+// block frequency-response and group-delay evaluation matches the
+// per-point queries on a FIR filter object
+void autotest_firfilt_crcf_response_block()
+{
+    unsigned int h_len = 57;    // filter length
+    unsigned int nfft  = 64;    // number of frequency points
+    float        tol   = 1e-3f; // error tolerance
+    unsigned int i;
+
+    // create filter from prototype
+    float h[h_len];
+    liquid_firdes_kaiser(h_len, 0.20f, 60.0f, 0.0f, h);
+    firfilt_crcf q = firfilt_crcf_create(h, h_len);
+    firfilt_crcf_set_scale(q, 0.1f);
+
+    // evaluate response and delay over the whole grid in one pass
+    float complex H[nfft];
+    float         d[nfft];
+    firfilt_crcf_freqresponse_block(q, nfft, H);
+    firfilt_crcf_groupdelay_block  (q, nfft, d);
+
+    // compare against per-point evaluation
+    for (i=0; i<nfft; i++) {
+        // wrap upper half of the grid to negative frequencies
+        float fc = (float)i/(float)nfft - (i < nfft/2 ? 0.0f : 1.0f);
+
+        float complex H0;
+        firfilt_crcf_freqresponse(q, fc, &H0);
+        CONTEND_DELTA( crealf(H[i]), crealf(H0), tol );
+        CONTEND_DELTA( cimagf(H[i]), cimagf(H0), tol );
+
+        // compare delay only where the response is not in a deep
+        // stop-band null (the ratio is ill-conditioned there for the
+        // per-point evaluation as well)
+        if (cabsf(H0) > 0.01f)
+            CONTEND_DELTA( d[i], firfilt_crcf_groupdelay(q, fc), tol );
+    }
+
+    firfilt_crcf_destroy(q);
+}
+
+// block frequency-response and group-delay evaluation matches the
+// per-point queries on IIR filter objects (both transfer-function and
+// second-order-section forms)
+void autotest_iirfilt_crcf_response_block()
+{
+    unsigned int order = 5;     // filter order
+    unsigned int nfft  = 64;    // number of frequency points
+    float        tol   = 1e-3f; // error tolerance
+    unsigned int i, t;
+
+    for (t=0; t<2; t++) {
+        // create filter (regular transfer function, then second-order
+        // sections)
+        iirfilt_crcf q = iirfilt_crcf_create_prototype(
+            LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS,
+            t==0 ? LIQUID_IIRDES_TF : LIQUID_IIRDES_SOS,
+            order, 0.1f, 0.0f, 1.0f, 60.0f);
+
+        // evaluate response and delay over the whole grid in one pass
+        float complex H[nfft];
+        float         d[nfft];
+        iirfilt_crcf_freqresponse_block(q, nfft, H);
+        iirfilt_crcf_groupdelay_block  (q, nfft, d);
+
+        // compare against per-point evaluation
+        for (i=0; i<nfft; i++) {
+            float fc = (float)i/(float)nfft - (i < nfft/2 ? 0.0f : 1.0f);
+
+            float complex H0;
+            iirfilt_crcf_freqresponse(q, fc, &H0);
+            CONTEND_DELTA( crealf(H[i]), crealf(H0), tol );
+            CONTEND_DELTA( cimagf(H[i]), cimagf(H0), tol );
+            CONTEND_DELTA( d[i], iirfilt_crcf_groupdelay(q, fc), tol );
+        }
+
+        iirfilt_crcf_destroy(q);
+    }
+}
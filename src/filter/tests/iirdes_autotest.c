@@ -298,3 +298,98 @@ void autotest_iirdes_isstable_n2_no()
     CONTEND_EQUALITY( stable, 0 );
 }
 
+
+//
+// AUTOTEST : cached-prototype design object matches liquid_iirdes
+//
+// design the same filter through the one-shot interface and through a
+// design object re-used for several band edges; coefficients must match
+void testbench_iirdes_object(liquid_iirdes_filtertype _ftype,
+                             liquid_iirdes_bandtype   _btype,
+                             liquid_iirdes_format     _format,
+                             unsigned int             _n)
+{
+    float Ap  = 1.0f;
+    float As  = 60.0f;
+    float tol = 1e-6f;
+
+    // create design object once
+    iirdes q = iirdes_create(_ftype, _btype, _format, _n, Ap, As);
+    unsigned int num_coeff = iirdes_get_num_coefficients(q);
+
+    float B0[num_coeff], A0[num_coeff];     // one-shot design
+    float B1[num_coeff], A1[num_coeff];     // cached design
+
+    // sweep band edges, re-using the cached analog prototype
+    unsigned int trial, i;
+    for (trial=0; trial<4; trial++) {
+        float fc = 0.10f + 0.05f*trial;
+        float f0 = 0.15f + 0.06f*trial;
+
+        liquid_iirdes(_ftype, _btype, _format, _n, fc, f0, Ap, As, B0, A0);
+        iirdes_execute(q, fc, f0, B1, A1);
+
+        for (i=0; i<num_coeff; i++) {
+            CONTEND_DELTA( B1[i], B0[i], tol );
+            CONTEND_DELTA( A1[i], A0[i], tol );
+        }
+    }
+
+    iirdes_destroy(q);
+}
+
+void autotest_iirdes_object_butter_lowpass()   { testbench_iirdes_object(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS,  LIQUID_IIRDES_SOS, 5); }
+void autotest_iirdes_object_cheby1_highpass()  { testbench_iirdes_object(LIQUID_IIRDES_CHEBY1, LIQUID_IIRDES_HIGHPASS, LIQUID_IIRDES_TF,  4); }
+void autotest_iirdes_object_cheby2_bandpass()  { testbench_iirdes_object(LIQUID_IIRDES_CHEBY2, LIQUID_IIRDES_BANDPASS, LIQUID_IIRDES_SOS, 3); }
+void autotest_iirdes_object_ellip_bandstop()   { testbench_iirdes_object(LIQUID_IIRDES_ELLIP,  LIQUID_IIRDES_BANDSTOP, LIQUID_IIRDES_SOS, 4); }
+void autotest_iirdes_object_bessel_lowpass()   { testbench_iirdes_object(LIQUID_IIRDES_BESSEL, LIQUID_IIRDES_LOWPASS,  LIQUID_IIRDES_TF,  6); }
+
+//
+// AUTOTEST : batch design for an array of center frequencies
+//
+void autotest_iirdes_execute_batch()
+{
+    unsigned int num_designs = 8;
+    unsigned int order       = 3;
+    float        Ap          = 0.1f;
+    float        As          = 40.0f;
+    float        tol         = 1e-6f;
+
+    // notch-like bank: band-stop designs with sweeping center frequency
+    iirdes q = iirdes_create(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_BANDSTOP,
+                             LIQUID_IIRDES_SOS, order, Ap, As);
+    unsigned int stride = iirdes_get_num_coefficients(q);
+
+    // band-stop SOS with order 3: effective order 6, 3 sections
+    CONTEND_EQUALITY( stride, 9 );
+
+    float fc[num_designs], f0[num_designs];
+    unsigned int i, k;
+    for (k=0; k<num_designs; k++) {
+        fc[k] = 0.02f;
+        f0[k] = 0.05f + 0.04f*k;
+    }
+
+    // run batch design
+    float B[num_designs*stride], A[num_designs*stride];
+    iirdes_execute_batch(q, fc, f0, num_designs, B, A);
+
+    // each design matches the one-shot interface
+    float B0[stride], A0[stride];
+    for (k=0; k<num_designs; k++) {
+        liquid_iirdes(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_BANDSTOP,
+                      LIQUID_IIRDES_SOS, order, fc[k], f0[k], Ap, As, B0, A0);
+        for (i=0; i<stride; i++) {
+            CONTEND_DELTA( B[k*stride + i], B0[i], tol );
+            CONTEND_DELTA( A[k*stride + i], A0[i], tol );
+        }
+
+        // resulting filter is stable
+        // (convert SOS sections individually)
+        for (i=0; i<stride/3; i++) {
+            CONTEND_EQUALITY( iirdes_isstable(&B[k*stride+3*i], &A[k*stride+3*i], 3), 1 );
+        }
+    }
+
+    iirdes_destroy(q);
+}
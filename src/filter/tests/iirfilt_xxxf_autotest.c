@@ -24,6 +24,7 @@
 // iirfilt_xxxf_autotest.c : test floating-point filters
 //
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -108,3 +109,100 @@ void autotest_iirfilt_cccf_h7x64()
 }
 
 
+
+// 
+// AUTOTEST : compare block cascade engine against single-sample
+//            execution for second-order sections form
+//
+void testbench_iirfilt_crcf_block(unsigned int _order,
+                                  unsigned int _n)
+{
+    unsigned int i;
+    float tol = 1e-4f;
+
+    // create two identical elliptic filters in second-order sections form
+    iirfilt_crcf q0 = iirfilt_crcf_create_prototype(
+        LIQUID_IIRDES_ELLIP, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS,
+        _order, 0.1f, 0.0f, 1.0f, 60.0f);
+    iirfilt_crcf q1 = iirfilt_crcf_create_prototype(
+        LIQUID_IIRDES_ELLIP, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS,
+        _order, 0.1f, 0.0f, 1.0f, 60.0f);
+
+    // allocate arrays
+    float complex * x  = (float complex *) malloc(_n*sizeof(float complex));
+    float complex * y0 = (float complex *) malloc(_n*sizeof(float complex));
+    float complex * y1 = (float complex *) malloc(_n*sizeof(float complex));
+
+    // initialize random input
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // compute reference with single-sample interface
+    for (i=0; i<_n; i++)
+        iirfilt_crcf_execute(q0, x[i], &y0[i]);
+
+    // compute output with block interface, splitting input in two to
+    // exercise pipeline fill/drain across calls
+    unsigned int n0 = _n/3;
+    iirfilt_crcf_execute_block(q1, x,      n0,     y1   );
+    iirfilt_crcf_execute_block(q1, x+n0, _n-n0,    y1+n0);
+
+    // validate results
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // validate in-place operation
+    iirfilt_crcf_reset(q1);
+    iirfilt_crcf_execute_block(q1, x, _n, x);
+    for (i=0; i<_n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(x[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(x[i]), tol );
+    }
+
+    // destroy objects and free memory
+    iirfilt_crcf_destroy(q0);
+    iirfilt_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_iirfilt_crcf_block_sos5() { testbench_iirfilt_crcf_block(5, 800); }
+void autotest_iirfilt_crcf_block_sos8() { testbench_iirfilt_crcf_block(8, 800); }
+
+// 
+// AUTOTEST : compare transposed direct-form II structure against
+//            regular direct-form II execution
+//
+void autotest_iirfilt_rrrf_trans()
+{
+    unsigned int order = 5;     // filter order
+    unsigned int n = 400;       // number of samples
+    unsigned int i;
+    float tol = 1e-3f;
+
+    // design Butterworth filter in transfer-function form
+    float b[order+1];
+    float a[order+1];
+    liquid_iirdes(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_TF,
+                  order, 0.15f, 0.0f, 1.0f, 60.0f, b, a);
+
+    // create regular and transposed-form filter objects
+    iirfilt_rrrf q0 = iirfilt_rrrf_create      (b, order+1, a, order+1);
+    iirfilt_rrrf q1 = iirfilt_rrrf_create_trans(b, order+1, a, order+1);
+
+    // run random input through both filters and compare outputs
+    for (i=0; i<n; i++) {
+        float x = randnf();
+        float y0, y1;
+        iirfilt_rrrf_execute(q0, x, &y0);
+        iirfilt_rrrf_execute(q1, x, &y1);
+        CONTEND_DELTA( y0, y1, tol );
+    }
+
+    // destroy filter objects
+    iirfilt_rrrf_destroy(q0);
+    iirfilt_rrrf_destroy(q1);
+}
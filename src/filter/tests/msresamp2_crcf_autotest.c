@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : streaming decimator matches block-aligned execution
+//
+void autotest_msresamp2_crcf_stream_decim()
+{
+    unsigned int num_stages = 3;    // decimation factor: M=8
+    unsigned int num_blocks = 40;   // number of full input blocks
+    float        fc         = 0.4f; // cut-off frequency
+    float        As         = 60.0f;// stop-band attenuation [dB]
+
+    unsigned int i;
+    unsigned int M = 1 << num_stages;
+    unsigned int num_samples = M * num_blocks;
+
+    // create two identical decimators
+    msresamp2_crcf q0 = msresamp2_crcf_create(LIQUID_RESAMP_DECIM, num_stages, fc, 0.0f, As);
+    msresamp2_crcf q1 = msresamp2_crcf_create(LIQUID_RESAMP_DECIM, num_stages, fc, 0.0f, As);
+
+    // generate pseudo-random input signal
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // run first object with block-aligned calls
+    float complex y0[num_blocks];
+    for (i=0; i<num_blocks; i++)
+        msresamp2_crcf_execute(q0, &x[i*M], &y0[i]);
+
+    // run second object with the streaming interface using chunk sizes
+    // deliberately misaligned with the decimation factor
+    float complex y1[num_blocks];
+    unsigned int ny = 0;
+    unsigned int n  = 0;
+    while (n < num_samples) {
+        unsigned int nx = 3 + (n % 5);  // 3, 4, ..., 7 samples per call
+        if (nx > num_samples - n)
+            nx = num_samples - n;
+        ny += msresamp2_crcf_execute_stream(q1, &x[n], nx, &y1[ny]);
+        n += nx;
+    }
+
+    // verify streaming output matches block-aligned output exactly
+    CONTEND_EQUALITY( ny, num_blocks );
+    for (i=0; i<ny; i++) {
+        CONTEND_EQUALITY( crealf(y0[i]), crealf(y1[i]) );
+        CONTEND_EQUALITY( cimagf(y0[i]), cimagf(y1[i]) );
+    }
+
+    // strict latency is an integer upper bound on the group delay
+    CONTEND_GREATER_THAN( (float)msresamp2_crcf_get_latency(q0),
+                          msresamp2_crcf_get_delay(q0) );
+
+    msresamp2_crcf_destroy(q0);
+    msresamp2_crcf_destroy(q1);
+}
+
+//
+// AUTOTEST : streaming interpolator matches sample-at-a-time execution
+//
+void autotest_msresamp2_crcf_stream_interp()
+{
+    unsigned int num_stages = 2;    // interpolation factor: M=4
+    unsigned int num_samples= 120;  // number of input samples
+    float        fc         = 0.4f; // cut-off frequency
+    float        As         = 60.0f;// stop-band attenuation [dB]
+
+    unsigned int i;
+    unsigned int M = 1 << num_stages;
+
+    // create two identical interpolators
+    msresamp2_crcf q0 = msresamp2_crcf_create(LIQUID_RESAMP_INTERP, num_stages, fc, 0.0f, As);
+    msresamp2_crcf q1 = msresamp2_crcf_create(LIQUID_RESAMP_INTERP, num_stages, fc, 0.0f, As);
+
+    // generate pseudo-random input signal
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // run first object one input sample at a time
+    float complex y0[M*num_samples];
+    for (i=0; i<num_samples; i++)
+        msresamp2_crcf_execute(q0, &x[i], &y0[i*M]);
+
+    // run second object on the entire block at once
+    float complex y1[M*num_samples];
+    unsigned int ny = msresamp2_crcf_execute_stream(q1, x, num_samples, y1);
+
+    // verify streaming output matches sample-at-a-time output exactly
+    CONTEND_EQUALITY( ny, M*num_samples );
+    for (i=0; i<ny; i++) {
+        CONTEND_EQUALITY( crealf(y0[i]), crealf(y1[i]) );
+        CONTEND_EQUALITY( cimagf(y0[i]), cimagf(y1[i]) );
+    }
+
+    msresamp2_crcf_destroy(q0);
+    msresamp2_crcf_destroy(q1);
+}
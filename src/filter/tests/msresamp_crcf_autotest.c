@@ -165,3 +165,130 @@ void autotest_msresamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// 
+// AUTOTEST : verify decimation stage planner
+//
+// create resampler for an extreme decimation ratio and check that the
+// reported stage plan reproduces the composite rate, that the measured
+// output rate matches, and that pass-band gain is preserved through the
+// integer decimation stage
+void msresamp_crcf_test_plan(float _r)
+{
+    unsigned int i;
+
+    // create resampler and query stage plan
+    msresamp_crcf q = msresamp_crcf_create(_r, 60.0f);
+    unsigned int num_halfband  = 0;
+    unsigned int decim_factor  = 0;
+    float rate_arbitrary = 0.0f;
+    msresamp_crcf_get_plan(q, &num_halfband, &decim_factor, &rate_arbitrary);
+
+    // cascade of reported stages must reproduce the composite rate
+    float r_plan = rate_arbitrary / (float)((1<<num_halfband)*decim_factor);
+    CONTEND_DELTA( r_plan/_r, 1.0f, 1e-4f );
+
+    // run constant (DC) input through resampler
+    unsigned int nx = (unsigned int)(60.0f/_r);     // ~60 output samples
+    unsigned int y_len = (unsigned int) ceilf(1.1f*nx*_r) + 4;
+    float complex y[y_len];
+    unsigned int ny=0;
+    unsigned int nw;
+    for (i=0; i<nx; i++) {
+        float complex v = 1.0f;
+        msresamp_crcf_execute(q, &v, 1, &y[ny], &nw);
+        ny += nw;
+    }
+
+    // check measured resampling rate
+    CONTEND_DELTA( (float)ny / (float)nx, _r, 0.05f*_r );
+
+    // check steady-state output against unity DC gain, ignoring the
+    // transient at the start (filter delay)
+    unsigned int n0 = (unsigned int) ceilf(2.0f * _r * msresamp_crcf_get_delay(q)) + 1;
+    for (i=n0; i<ny; i++) {
+        CONTEND_DELTA( crealf(y[i]), 1.0f, 0.01f );
+        CONTEND_DELTA( cimagf(y[i]), 0.0f, 0.01f );
+    }
+
+    // destroy object
+    msresamp_crcf_destroy(q);
+}
+
+void autotest_msresamp_crcf_plan_2560()
+{
+    // 2560 = 2^9 * 5 : expect nine half-band stages, decimation by 5,
+    // and no residual arbitrary stage
+    msresamp_crcf_test_plan(1.0f/2560.0f);
+
+    msresamp_crcf q = msresamp_crcf_create(1.0f/2560.0f, 60.0f);
+    unsigned int num_halfband, decim_factor;
+    float rate_arbitrary;
+    msresamp_crcf_get_plan(q, &num_halfband, &decim_factor, &rate_arbitrary);
+    CONTEND_EQUALITY( num_halfband, 9 );
+    CONTEND_EQUALITY( decim_factor, 5 );
+    CONTEND_EQUALITY( rate_arbitrary, 1.0f );
+    msresamp_crcf_destroy(q);
+}
+
+void autotest_msresamp_crcf_plan_192() { msresamp_crcf_test_plan(1.0f/192.0f); }
+void autotest_msresamp_crcf_plan_441() { msresamp_crcf_test_plan(1.0f/441.0f); }
+
+//
+// AUTOTEST : output-time query maps an impulse back to its input index
+//            through the full stage cascade (both cascade types)
+//
+void autotest_msresamp_crcf_timestamp()
+{
+    float rates[4] = {0.1f, 0.37f, 2.7f, 8.0f}; // resampling rates to test
+    unsigned int num_input = 800;               // number of input samples
+    unsigned int n0 = 300;                      // input index of impulse
+    unsigned int t;
+
+    for (t=0; t<4; t++) {
+        // create resampler
+        float r = rates[t];
+        msresamp_crcf q = msresamp_crcf_create(r, 60.0f);
+
+        // generate impulse and run resampler in one block
+        unsigned int y_len = (unsigned int)ceilf(r*num_input) + 64;
+        float complex x[num_input];
+        float complex y[y_len];
+        unsigned int i;
+        for (i=0; i<num_input; i++)
+            x[i] = i==n0 ? 1.0f : 0.0f;
+        unsigned int ny;
+        msresamp_crcf_execute(q, x, num_input, y, &ny);
+
+        // locate output peak
+        unsigned int kpk = 0;
+        float peak = 0.0f;
+        for (i=0; i<ny; i++) {
+            if (cabsf(y[i]) > peak) {
+                peak = cabsf(y[i]);
+                kpk  = i;
+            }
+        }
+
+        if (liquid_autotest_verbose) {
+            printf("msresamp_crcf_timestamp: rate=%f, t(peak)=%f (expected %u)\n",
+                    r, msresamp_crcf_get_output_time(q, kpk), n0);
+        }
+
+        // sample counters match what was pushed/produced
+        CONTEND_EQUALITY( msresamp_crcf_get_num_input(q),  (unsigned long long)num_input );
+        CONTEND_EQUALITY( msresamp_crcf_get_num_output(q), (unsigned long long)ny );
+
+        // exact composite rate is close to the request
+        double rate = msresamp_crcf_get_rate_actual(q);
+        CONTEND_DELTA( (float)rate, r, r/65536.0f );
+
+        // peak maps back to the impulse's input index within half an
+        // output sample spacing (plus a small margin)
+        CONTEND_DELTA( (float)msresamp_crcf_get_output_time(q, kpk),
+                       (float)n0,
+                       0.6f/rate );
+
+        msresamp_crcf_destroy(q);
+    }
+}
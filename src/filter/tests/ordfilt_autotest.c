@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// sort comparator for brute-force reference
+static int ordfilt_autotest_sort(const void * _v1, const void * _v2)
+{
+    return *(float*)_v1 > *(float*)_v2 ? 1 : -1;
+}
+
+// run order-statistic filter on random data and compare each output
+// to a brute-force sort of the trailing window
+void ordfilt_autotest_harness(unsigned int _n,
+                              unsigned int _k)
+{
+    unsigned int num_samples = 400;
+    unsigned int i;
+
+    // create filter object
+    ordfilt_rrrf q = ordfilt_rrrf_create(_n, _k);
+
+    // trailing window (initialized to zero to match filter state)
+    float buf[_n];
+    float buf_sorted[_n];
+    memset(buf, 0, _n*sizeof(float));
+
+    for (i=0; i<num_samples; i++) {
+        // generate random sample, with occasional outliers to mimic
+        // impulsive noise
+        float x = randnf();
+        if ((rand() % 20)==0)
+            x += 20.0f;
+
+        // compute filter output
+        float y;
+        ordfilt_rrrf_push(q, x);
+        ordfilt_rrrf_execute(q, &y);
+
+        // compute reference: sort trailing window and index directly
+        memmove(buf, buf+1, (_n-1)*sizeof(float));
+        buf[_n-1] = x;
+        memmove(buf_sorted, buf, _n*sizeof(float));
+        qsort((void*)buf_sorted, _n, sizeof(float), &ordfilt_autotest_sort);
+
+        CONTEND_EQUALITY(y, buf_sorted[_k]);
+    }
+
+    // destroy filter object
+    ordfilt_rrrf_destroy(q);
+}
+
+void autotest_ordfilt_rrrf_n11_k5() { ordfilt_autotest_harness(11, 5); }
+void autotest_ordfilt_rrrf_n17_k0() { ordfilt_autotest_harness(17, 0); }
+void autotest_ordfilt_rrrf_n23_k22(){ ordfilt_autotest_harness(23,22); }
+
+// verify median-specialized constructor against brute force
+void autotest_ordfilt_rrrf_medfilt()
+{
+    unsigned int m = 4;
+    unsigned int num_samples = 200;
+    unsigned int n = 2*m+1;
+    unsigned int i;
+
+    ordfilt_rrrf q = ordfilt_rrrf_create_medfilt(m);
+
+    float buf[n];
+    float buf_sorted[n];
+    memset(buf, 0, n*sizeof(float));
+
+    for (i=0; i<num_samples; i++) {
+        float x = randnf();
+        float y;
+        ordfilt_rrrf_push(q, x);
+        ordfilt_rrrf_execute(q, &y);
+
+        memmove(buf, buf+1, (n-1)*sizeof(float));
+        buf[n-1] = x;
+        memmove(buf_sorted, buf, n*sizeof(float));
+        qsort((void*)buf_sorted, n, sizeof(float), &ordfilt_autotest_sort);
+
+        CONTEND_EQUALITY(y, buf_sorted[m]);
+    }
+
+    ordfilt_rrrf_destroy(q);
+}
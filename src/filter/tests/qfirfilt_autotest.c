@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare quantized filter to an equivalent dense firfilt running the
+// original coefficients; the output error is hard-bounded by the
+// aggregate coefficient residual times the peak input magnitude
+void testbench_qfirfilt_crcf(unsigned int _nbits,
+                             float        _tol)
+{
+    unsigned int h_len       = 57;      // filter length
+    unsigned int num_samples = 400;     // number of samples to run
+    unsigned int i;
+
+    // design prototype low-pass filter
+    float h[h_len];
+    liquid_firdes_kaiser(h_len, 0.1f, 60.0f, 0.0f, h);
+
+    // create filter objects
+    qfirfilt_crcf q0 = qfirfilt_crcf_create(h, h_len, _nbits);
+    firfilt_crcf  q1 = firfilt_crcf_create (h, h_len);
+    CONTEND_EQUALITY( qfirfilt_crcf_get_length(q0), h_len  );
+    CONTEND_EQUALITY( qfirfilt_crcf_get_nbits (q0), _nbits );
+
+    // quantization error is small but non-zero
+    float qerror = qfirfilt_crcf_get_quantization_error(q0);
+    CONTEND_GREATER_THAN( qerror, 0.0f );
+    CONTEND_LESS_THAN   ( qerror, _tol );
+    if (liquid_autotest_verbose) {
+        printf("qfirfilt_crcf, %2u-bit coefficients: error %.2f dB\n",
+                _nbits, 20*log10f(qerror));
+    }
+
+    // measure the aggregate coefficient residual sum |h_q[i] - h[i]|
+    // by running an impulse through a copy of the quantized filter
+    float eps_sum = 0.0f;
+    qfirfilt_crcf qi = qfirfilt_crcf_create(h, h_len, _nbits);
+    for (i=0; i<h_len; i++) {
+        float complex y;
+        qfirfilt_crcf_push   (qi, i==0 ? 1.0f : 0.0f);
+        qfirfilt_crcf_execute(qi, &y);
+        eps_sum += fabsf(crealf(y) - h[i]);
+    }
+    qfirfilt_crcf_destroy(qi);
+
+    // generate random input and find its peak component magnitude;
+    // each output component then differs from the dense reference by
+    // at most eps_sum * x_max regardless of the random sequence
+    float complex x[num_samples];
+    float x_max = 0.0f;
+    for (i=0; i<num_samples; i++) {
+        x[i] = randnf() + randnf()*_Complex_I;
+        if (fabsf(crealf(x[i])) > x_max) x_max = fabsf(crealf(x[i]));
+        if (fabsf(cimagf(x[i])) > x_max) x_max = fabsf(cimagf(x[i]));
+    }
+    float tol_out = eps_sum * x_max + 1e-5f;
+
+    // run samples through both filters and compare outputs
+    for (i=0; i<num_samples; i++) {
+        float complex y0, y1;
+
+        qfirfilt_crcf_push   (q0, x[i]);
+        qfirfilt_crcf_execute(q0, &y0);
+
+        firfilt_crcf_push   (q1, x[i]);
+        firfilt_crcf_execute(q1, &y1);
+
+        CONTEND_DELTA( crealf(y0), crealf(y1), tol_out );
+        CONTEND_DELTA( cimagf(y0), cimagf(y1), tol_out );
+    }
+
+    // destroy filter objects
+    qfirfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+void autotest_qfirfilt_crcf_int8()  { testbench_qfirfilt_crcf( 8, 0.01f   ); }
+void autotest_qfirfilt_crcf_int16() { testbench_qfirfilt_crcf(16, 0.0001f ); }
+
+// verify quantized coefficients reconstruct the original response
+// within half a quantization step, and that block execution matches
+// sample-by-sample operation
+void autotest_qfirfilt_rrrf_reconstruction()
+{
+    unsigned int h_len       = 41;
+    unsigned int num_samples = 200;
+    unsigned int i;
+
+    // design prototype filter
+    float h[h_len];
+    liquid_firdes_kaiser(h_len, 0.2f, 40.0f, 0.0f, h);
+
+    qfirfilt_rrrf q0 = qfirfilt_rrrf_create(h, h_len, 8);
+    qfirfilt_rrrf q1 = qfirfilt_rrrf_create(h, h_len, 8);
+
+    // the impulse response is the reconstructed coefficient set; each
+    // coefficient is within half a quantization step of the original
+    float scale = qfirfilt_rrrf_get_scale(q0);
+    for (i=0; i<h_len; i++) {
+        float y;
+        qfirfilt_rrrf_push(q0, i==0 ? 1.0f : 0.0f);
+        qfirfilt_rrrf_execute(q0, &y);
+        CONTEND_DELTA( y, h[i], 0.5f*scale + 1e-6f );
+    }
+
+    // block execution matches sample-by-sample operation exactly
+    float x[num_samples];
+    float y0[num_samples];
+    float y1[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf();
+    qfirfilt_rrrf_reset(q0);
+    for (i=0; i<num_samples; i++) {
+        qfirfilt_rrrf_push(q0, x[i]);
+        qfirfilt_rrrf_execute(q0, &y0[i]);
+    }
+    qfirfilt_rrrf_execute_block(q1, x, num_samples, y1);
+    for (i=0; i<num_samples; i++)
+        CONTEND_EQUALITY( y0[i], y1[i] );
+
+    qfirfilt_rrrf_destroy(q0);
+    qfirfilt_rrrf_destroy(q1);
+}
@@ -165,3 +165,170 @@ void autotest_resamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+//
+// AUTOTEST : Farrow-structure engine tracks polyphase engine output
+//
+void autotest_resamp_crcf_farrow()
+{
+    // options
+    float r = 0.91827364f;      // resampling rate (output/input)
+    unsigned int n = 400;       // number of input samples
+    float fx = 0.18365473f;     // complex input sinusoid frequency (0.2*r)
+    unsigned int i;
+
+    // create two resamplers: polyphase reference and Farrow engine
+    resamp_crcf q0 = resamp_crcf_create_default(r);
+    resamp_crcf q1 = resamp_crcf_create_default(r);
+    resamp_crcf_enable_farrow(q1, 3);
+
+    unsigned int m  = resamp_crcf_get_delay(q0);
+    unsigned int nx = n + m;
+    unsigned int y_len = (unsigned int) ceilf(1.1 * nx * r) + 4;
+    float complex x[nx];
+    float complex y0[y_len];
+    float complex y1[y_len];
+
+    // generate windowed complex sinusoid
+    for (i=0; i<nx; i++) {
+        float w = i < n ? liquid_kaiser(i, n, 10.0f) : 0.0f;
+        x[i] = cexpf(_Complex_I*2*M_PI*fx*i) * w;
+    }
+
+    // resample with both engines
+    unsigned int ny0, ny1;
+    resamp_crcf_execute_block(q0, x, nx, y0, &ny0);
+    resamp_crcf_execute_block(q1, x, nx, y1, &ny1);
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+
+    // same output sample count
+    CONTEND_EQUALITY(ny0, ny1);
+
+    // outputs agree to within the branch quantization of the
+    // polyphase reference plus the polynomial fit error
+    float rmse = 0.0f;
+    for (i=0; i<ny0; i++) {
+        float complex e = y1[i] - y0[i];
+        rmse += crealf( e*conjf(e) );
+    }
+    rmse = sqrtf( rmse / (float)ny0 );
+    if (liquid_autotest_verbose)
+        printf("resamp_crcf_farrow: ny=%u, rmse=%12.4e\n", ny0, rmse);
+    CONTEND_LESS_THAN( rmse, 0.02f );
+}
+
+//
+// AUTOTEST : sample-clock metadata tracks input/output sample indices
+//            through the resampler, including the filter group delay
+//
+void autotest_resamp_crcf_timestamp()
+{
+    float rates[3] = {0.7f, 1.0f, 2.5f};   // resampling rates to test
+    unsigned int num_input = 200;          // number of input samples
+    unsigned int n0 = 57;                  // input index of impulse
+    unsigned int t;
+
+    for (t=0; t<3; t++) {
+        // create resampler
+        resamp_crcf q = resamp_crcf_create_default(rates[t]);
+        double rate = resamp_crcf_get_rate_actual(q);
+
+        // push an impulse through the resampler, recording the time of
+        // each output sample from the metadata interface
+        unsigned int i, k, nw;
+        float complex y[8];
+        float  peak   = 0.0f;
+        double t_peak = 0.0;
+        unsigned int num_output = 0;
+        for (i=0; i<num_input; i++) {
+            // time of the first output this input may produce
+            double t_next = resamp_crcf_get_next_output_time(q);
+
+            // execute on single sample (impulse at index n0)
+            resamp_crcf_execute(q, i==n0 ? 1.0f : 0.0f, y, &nw);
+
+            // consecutive outputs are spaced by the inverse of the rate
+            for (k=0; k<nw; k++) {
+                if (cabsf(y[k]) > peak) {
+                    peak   = cabsf(y[k]);
+                    t_peak = t_next + (double)k / rate;
+                }
+            }
+            num_output += nw;
+        }
+
+        if (liquid_autotest_verbose) {
+            printf("resamp_crcf_timestamp: rate=%f, t_peak=%f (expected %u)\n",
+                    rates[t], t_peak, n0);
+        }
+
+        // sample counters match what was pushed/produced
+        CONTEND_EQUALITY( resamp_crcf_get_num_input(q),  (unsigned long long)num_input );
+        CONTEND_EQUALITY( resamp_crcf_get_num_output(q), (unsigned long long)num_output );
+
+        // quantized rate is within one part in 2^16 of the request
+        CONTEND_DELTA( (float)rate, rates[t], rates[t]/65536.0f );
+
+        // impulse peak maps back to its input index within one output
+        // sample spacing
+        CONTEND_DELTA( (float)t_peak, (float)n0, 1.0f/rate );
+
+        resamp_crcf_destroy(q);
+    }
+}
+
+void autotest_resamp_crcf_create_prototype()
+{
+    // options
+    float        rate = 4.0f;   // output samples per input symbol
+    unsigned int m    = 9;      // prototype filter semi-length
+    float        beta = 0.25f;  // excess bandwidth factor
+    unsigned int npfb = 256;    // number of filters in bank
+    float        tol  = 1e-6f;  // error tolerance
+
+    unsigned int i;
+
+    // create resampler with square-root Nyquist prototype convolved
+    // into the polyphase bank
+    resamp_crcf q = resamp_crcf_create_prototype(LIQUID_FIRFILT_RRC, rate, m, beta, npfb);
+
+    // design reference pulse directly (npfb samples per symbol)
+    unsigned int h_len = 2*m*npfb+1;
+    float hf[h_len];
+    liquid_firdes_prototype(LIQUID_FIRFILT_RRC, npfb, m, beta, 0, hf);
+
+    // feed unit impulse followed by zeros and collect output
+    unsigned int num_input  = 2*m+4;
+    unsigned int num_output = (unsigned int)(rate*num_input) + 8;
+    float complex y[num_output];
+    unsigned int ny = 0;
+    unsigned int nw;
+    for (i=0; i<num_input; i++) {
+        resamp_crcf_execute(q, i==0 ? 1.0f : 0.0f, &y[ny], &nw);
+        ny += nw;
+    }
+
+    // find peak of output and of reference pulse
+    unsigned int iy_max = 0;
+    for (i=0; i<ny; i++) {
+        if ( cabsf(y[i]) > cabsf(y[iy_max]) )
+            iy_max = i;
+    }
+    unsigned int ih_max = m*npfb;   // pulse is symmetric about center
+
+    // with an integer rate and npfb divisible by the rate, the output
+    // is the prototype pulse sampled at stride npfb/rate with no
+    // inter-filter interpolation error
+    unsigned int stride = npfb / (unsigned int)rate;
+    CONTEND_DELTA( crealf(y[iy_max]), hf[ih_max], tol );
+    CONTEND_EQUALITY( iy_max >= m*(unsigned int)rate, 1 );
+    for (i=1; i<m*(unsigned int)rate; i++) {
+        // compare samples on both sides of the peak
+        CONTEND_DELTA( crealf(y[iy_max+i]), hf[ih_max+i*stride], tol );
+        CONTEND_DELTA( crealf(y[iy_max-i]), hf[ih_max-i*stride], tol );
+        CONTEND_DELTA( cimagf(y[iy_max+i]), 0.0f, tol );
+    }
+
+    resamp_crcf_destroy(q);
+}
@@ -192,3 +192,53 @@ void autotest_rresamp_crcf_P6_Q5() { test_harness_rresamp_crcf( 6, 5, 15, 0.4f,
 void autotest_rresamp_crcf_P8_Q5() { test_harness_rresamp_crcf( 8, 5, 15, 0.4f, 60.0f); }
 void autotest_rresamp_crcf_P9_Q5() { test_harness_rresamp_crcf( 9, 5, 15, 0.4f, 60.0f); }
 
+
+// 
+// AUTOTEST : compare block execution (pre-computed schedule) against
+//            successive calls to the regular execute() method
+//
+void test_harness_rresamp_crcf_block(unsigned int _P,
+                                     unsigned int _Q)
+{
+    unsigned int i;
+    float tol = 1e-6f;
+    unsigned int n = 20;    // number of execute() blocks to run
+
+    // create two identical resamplers
+    rresamp_crcf q0 = rresamp_crcf_create_kaiser(_P, _Q, 12, 0.4f, 60.0f);
+    rresamp_crcf q1 = rresamp_crcf_create_kaiser(_P, _Q, 12, 0.4f, 60.0f);
+
+    // buffers
+    unsigned int nx = n * rresamp_crcf_get_Q(q0);
+    unsigned int ny = n * rresamp_crcf_get_P(q0);
+    float complex x [nx];
+    float complex y0[ny];
+    float complex y1[ny];
+
+    // generate pseudo-random input
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // compute reference with successive calls to execute()
+    unsigned int P = rresamp_crcf_get_P(q0);
+    unsigned int Q = rresamp_crcf_get_Q(q0);
+    for (i=0; i<n; i++)
+        rresamp_crcf_execute(q0, &x[i*Q], &y0[i*P]);
+
+    // compute output with single block call
+    rresamp_crcf_execute_block(q1, x, n, y1);
+
+    // validate results
+    for (i=0; i<ny; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects
+    rresamp_crcf_destroy(q0);
+    rresamp_crcf_destroy(q1);
+}
+
+void autotest_rresamp_crcf_block_P3_Q4() { test_harness_rresamp_crcf_block( 3,  4); }
+void autotest_rresamp_crcf_block_P8_Q5() { test_harness_rresamp_crcf_block( 8,  5); }
+void autotest_rresamp_crcf_block_P6_Q8() { test_harness_rresamp_crcf_block( 6,  8); }
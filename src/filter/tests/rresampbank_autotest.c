@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : resampler bank matches a set of independent rresamp objects
+//
+// Run the same per-channel input through the bank (channel-interleaved)
+// and through num_channels independent rresamp_rrrf objects with the same
+// design parameters; the outputs must agree to within rounding
+void test_harness_rresampbank_rrrf(unsigned int _P,
+                                   unsigned int _Q,
+                                   unsigned int _m,
+                                   unsigned int _num_channels)
+{
+    float        bw  = 0.5f;
+    float        As  = 60.0f;
+    float        tol = 1e-4f;
+    unsigned int n   = 20;      // number of execute() blocks
+
+    // create bank and reference resamplers
+    rresampbank_rrrf bank = rresampbank_rrrf_create_kaiser(_P, _Q, _m, bw, As, _num_channels);
+    rresamp_rrrf     ref[_num_channels];
+    unsigned int ch;
+    for (ch=0; ch<_num_channels; ch++)
+        ref[ch] = rresamp_rrrf_create_kaiser(_P, _Q, _m, bw, As);
+
+    CONTEND_EQUALITY( rresampbank_rrrf_get_num_channels(bank), _num_channels );
+    CONTEND_EQUALITY( rresampbank_rrrf_get_delay       (bank), rresamp_rrrf_get_delay(ref[0]) );
+    CONTEND_DELTA   ( rresampbank_rrrf_get_rate        (bank),
+                      rresamp_rrrf_get_rate(ref[0]), 1e-6f );
+
+    // buffer sizes per execute() call, in samples per channel
+    unsigned int nx = rresamp_rrrf_get_Q(ref[0]);
+    unsigned int ny = rresamp_rrrf_get_P(ref[0]);
+
+    float x [nx*_num_channels];     // interleaved input
+    float y [ny*_num_channels];     // interleaved bank output
+    float xc[nx];                   // single-channel input
+    float yc[ny];                   // single-channel reference output
+
+    unsigned int b, i;
+    for (b=0; b<n; b++) {
+        // generate distinct sinusoid per channel
+        for (ch=0; ch<_num_channels; ch++) {
+            float fc = 0.02f + 0.03f*ch / (float)_num_channels;
+            for (i=0; i<nx; i++)
+                x[i*_num_channels + ch] = cosf(2*M_PI*fc*(b*nx + i) + 0.1f*ch);
+        }
+
+        // run bank on interleaved block
+        rresampbank_rrrf_execute(bank, x, y);
+
+        // run each reference resampler on its de-interleaved stream
+        for (ch=0; ch<_num_channels; ch++) {
+            for (i=0; i<nx; i++)
+                xc[i] = x[i*_num_channels + ch];
+            rresamp_rrrf_execute(ref[ch], xc, yc);
+
+            for (i=0; i<ny; i++) {
+                CONTEND_DELTA( y[i*_num_channels + ch], yc[i], tol );
+            }
+        }
+    }
+
+    // destroy objects
+    rresampbank_rrrf_destroy(bank);
+    for (ch=0; ch<_num_channels; ch++)
+        rresamp_rrrf_destroy(ref[ch]);
+}
+
+// actual tests
+void autotest_rresampbank_rrrf_P1_Q6()  { test_harness_rresampbank_rrrf( 1, 6, 12,  4); } // decimator
+void autotest_rresampbank_rrrf_P6_Q1()  { test_harness_rresampbank_rrrf( 6, 1, 12,  7); } // 8 kHz -> 48 kHz
+void autotest_rresampbank_rrrf_P48_Q8() { test_harness_rresampbank_rrrf(48, 8,  9,  3); } // with common divisor
+void autotest_rresampbank_rrrf_P3_Q2()  { test_harness_rresampbank_rrrf( 3, 2, 12, 12); } // fractional
+
+//
+// AUTOTEST : complex resampler bank matches independent rresamp objects
+//
+void autotest_rresampbank_crcf()
+{
+    unsigned int P = 5, Q = 3, m = 12, num_channels = 5;
+    float        bw  = 0.5f;
+    float        As  = 60.0f;
+    float        tol = 1e-4f;
+    unsigned int n   = 20;
+
+    rresampbank_crcf bank = rresampbank_crcf_create_kaiser(P, Q, m, bw, As, num_channels);
+    rresamp_crcf     ref[num_channels];
+    unsigned int ch;
+    for (ch=0; ch<num_channels; ch++)
+        ref[ch] = rresamp_crcf_create_kaiser(P, Q, m, bw, As);
+
+    float complex x [Q*num_channels];
+    float complex y [P*num_channels];
+    float complex xc[Q];
+    float complex yc[P];
+
+    unsigned int b, i;
+    for (b=0; b<n; b++) {
+        for (ch=0; ch<num_channels; ch++) {
+            float fc = -0.1f + 0.05f*ch;
+            for (i=0; i<Q; i++)
+                x[i*num_channels + ch] = cexpf(_Complex_I*2*M_PI*fc*(b*Q + i));
+        }
+
+        rresampbank_crcf_execute(bank, x, y);
+
+        for (ch=0; ch<num_channels; ch++) {
+            for (i=0; i<Q; i++)
+                xc[i] = x[i*num_channels + ch];
+            rresamp_crcf_execute(ref[ch], xc, yc);
+
+            for (i=0; i<P; i++) {
+                CONTEND_DELTA( crealf(y[i*num_channels + ch]), crealf(yc[i]), tol );
+                CONTEND_DELTA( cimagf(y[i*num_channels + ch]), cimagf(yc[i]), tol );
+            }
+        }
+    }
+
+    rresampbank_crcf_destroy(bank);
+    for (ch=0; ch<num_channels; ch++)
+        rresamp_crcf_destroy(ref[ch]);
+}
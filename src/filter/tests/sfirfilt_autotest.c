@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare sparse filter to an equivalent dense firfilt with the
+// non-zero coefficients embedded in a long mostly-zero response
+void autotest_sfirfilt_crcf_vs_dense()
+{
+    unsigned int num_taps    =  12;     // number of non-zero taps
+    unsigned int span        = 240;     // filter span
+    unsigned int num_samples = 800;     // number of samples to run
+    float        tol         = 1e-4f;   // error tolerance
+
+    unsigned int i;
+
+    // generate sparse tap set: random coefficients at scattered
+    // delays, pinning the last tap to the full span
+    float        hs[num_taps];
+    unsigned int ds[num_taps];
+    for (i=0; i<num_taps; i++) {
+        hs[i] = randnf();
+        ds[i] = i==num_taps-1 ? span-1 : rand() % (span-1);
+    }
+
+    // embed into dense response
+    float hd[span];
+    memset(hd, 0, span*sizeof(float));
+    for (i=0; i<num_taps; i++)
+        hd[ds[i]] += hs[i];
+
+    // create filter objects
+    sfirfilt_crcf q0 = sfirfilt_crcf_create(hs, ds, num_taps);
+    firfilt_crcf  q1 = firfilt_crcf_create(hd, span);
+    CONTEND_EQUALITY( sfirfilt_crcf_get_length(q0),   span     );
+    CONTEND_EQUALITY( sfirfilt_crcf_get_num_taps(q0), num_taps );
+
+    // run random samples through both filters and compare outputs
+    for (i=0; i<num_samples; i++) {
+        float complex x = randnf() + randnf()*_Complex_I;
+        float complex y0, y1;
+
+        sfirfilt_crcf_push   (q0, x);
+        sfirfilt_crcf_execute(q0, &y0);
+
+        firfilt_crcf_push   (q1, x);
+        firfilt_crcf_execute(q1, &y1);
+
+        CONTEND_DELTA( crealf(y0), crealf(y1), tol );
+        CONTEND_DELTA( cimagf(y0), cimagf(y1), tol );
+    }
+
+    // destroy filter objects
+    sfirfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+// verify a two-tap comb filter: y(n) = x(n) + a x(n-D)
+void autotest_sfirfilt_rrrf_comb()
+{
+    unsigned int D = 37;        // comb delay
+    float        a = -0.7f;     // feed-forward coefficient
+    unsigned int num_samples = 200;
+
+    unsigned int i;
+
+    float        h[2] = {1.0f, a};
+    unsigned int d[2] = {0,    D};
+    sfirfilt_rrrf q = sfirfilt_rrrf_create(h, d, 2);
+
+    // run random samples, comparing to direct expression
+    float x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf();
+
+    for (i=0; i<num_samples; i++) {
+        float y;
+        sfirfilt_rrrf_push(q, x[i]);
+        sfirfilt_rrrf_execute(q, &y);
+
+        float y_exp = x[i] + (i >= D ? a*x[i-D] : 0.0f);
+        CONTEND_DELTA( y, y_exp, 1e-6f );
+    }
+
+    sfirfilt_rrrf_destroy(q);
+}
+
+// verify output scaling and block execution
+void autotest_sfirfilt_cccf_scale()
+{
+    unsigned int i;
+
+    float complex h[3] = {1.0f, 0.3f - 0.2f*_Complex_I, -0.1f*_Complex_I};
+    unsigned int  d[3] = {0, 11, 29};
+
+    sfirfilt_cccf q0 = sfirfilt_cccf_create(h, d, 3);
+    sfirfilt_cccf q1 = sfirfilt_cccf_create(h, d, 3);
+    sfirfilt_cccf_set_scale(q1, 0.5f*_Complex_I);
+
+    float complex scale;
+    sfirfilt_cccf_get_scale(q1, &scale);
+    CONTEND_EQUALITY( crealf(scale), 0.0f );
+    CONTEND_EQUALITY( cimagf(scale), 0.5f );
+
+    // run block through both filters and compare
+    float complex x [64];
+    float complex y0[64];
+    float complex y1[64];
+    for (i=0; i<64; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+    sfirfilt_cccf_execute_block(q0, x, 64, y0);
+    sfirfilt_cccf_execute_block(q1, x, 64, y1);
+
+    for (i=0; i<64; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(0.5f*_Complex_I*y0[i]), 1e-6f );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(0.5f*_Complex_I*y0[i]), 1e-6f );
+    }
+
+    sfirfilt_cccf_destroy(q0);
+    sfirfilt_cccf_destroy(q1);
+}
@@ -175,3 +175,180 @@ void autotest_symsync_crcf_scenario_1() { symsync_crcf_test(2, 7, 0.35, -0.25, 1
 void autotest_symsync_crcf_scenario_2() { symsync_crcf_test(2, 7, 0.35, -0.25, 1.0001f ); }
 void autotest_symsync_crcf_scenario_3() { symsync_crcf_test(2, 7, 0.35, -0.25, 0.9999f ); }
 
+
+// validate streaming execute method and output-count bound against the
+// regular execute method
+void autotest_symsync_crcf_state()
+{
+    unsigned int k           =   2;     // samples/symbol
+    unsigned int m           =   7;     // filter delay (symbols)
+    float        beta        = 0.35f;   // excess bandwidth factor
+    unsigned int num_symbols = 200;     // number of data symbols
+
+    unsigned int i;
+    unsigned int num_samples = k*num_symbols;
+
+    // create synchronizer and converge its timing loop on a delayed
+    // interpolated QPSK sequence
+    symsync_crcf q0 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, k, m, beta, 32);
+    symsync_crcf_set_lf_bw(q0, 0.02f);
+
+    float complex x[num_samples];
+    modem mod = modem_create(LIQUID_MODEM_QPSK);
+    firinterp_crcf interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC,k,m,beta,0.3f);
+    for (i=0; i<num_symbols; i++) {
+        unsigned int sym = modem_gen_rand_sym(mod);
+        float complex s;
+        modem_modulate(mod, sym, &s);
+        firinterp_crcf_execute(interp, s, &x[i*k]);
+    }
+    firinterp_crcf_destroy(interp);
+    modem_destroy(mod);
+
+    unsigned int ny_max = symsync_crcf_get_output_max(q0, num_samples);
+    float complex y[ny_max];
+    unsigned int ny;
+    symsync_crcf_execute(q0, x, num_samples, y, &ny);
+
+    // save converged timing state and restore into a fresh object
+    unsigned int n = symsync_crcf_get_state_size(q0);
+    unsigned char state[n];
+    symsync_crcf_save_state(q0, state, n);
+
+    symsync_crcf q1 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, k, m, beta, 32);
+    symsync_crcf_set_lf_bw(q1, 0.02f);
+    symsync_crcf_restore_state(q1, state, n);
+    CONTEND_EQUALITY( symsync_crcf_get_tau(q1), symsync_crcf_get_tau(q0) );
+
+    symsync_crcf_destroy(q0);
+    symsync_crcf_destroy(q1);
+}
+
+void autotest_symsync_crcf_execute_stream()
+{
+    unsigned int k           =   2;     // samples/symbol
+    unsigned int m           =   7;     // filter delay (symbols)
+    float        beta        = 0.35f;   // excess bandwidth factor
+    unsigned int num_symbols = 200;     // number of data symbols
+    float        tol         = 1e-5f;   // error tolerance
+
+    unsigned int i;
+    unsigned int num_samples = k*num_symbols;
+
+    // create two identical synchronizer objects
+    symsync_crcf q0 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, k, m, beta, 32);
+    symsync_crcf q1 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, k, m, beta, 32);
+
+    // generate interpolated random QPSK sequence
+    float complex x[num_samples];
+    modem mod = modem_create(LIQUID_MODEM_QPSK);
+    firinterp_crcf interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC,k,m,beta,0);
+    for (i=0; i<num_symbols; i++) {
+        unsigned int sym = modem_gen_rand_sym(mod);
+        float complex s;
+        modem_modulate(mod, sym, &s);
+        firinterp_crcf_execute(interp, s, &x[i*k]);
+    }
+    firinterp_crcf_destroy(interp);
+    modem_destroy(mod);
+
+    // allocate output buffers using the output-count bound
+    unsigned int ny_max = symsync_crcf_get_output_max(q0, num_samples);
+    float complex y0[ny_max];
+    float complex y1[ny_max];
+    unsigned int ny0;
+    unsigned int ny1;
+
+    // run both synchronizers unlocked on the first half...
+    symsync_crcf_execute       (q0, x, num_samples/2, y0, &ny0);
+    symsync_crcf_execute_stream(q1, x, num_samples/2, y1, &ny1);
+    CONTEND_EQUALITY( ny0, ny1 );
+    CONTEND_LESS_THAN( ny0, ny_max+1 );
+    for (i=0; i<ny0; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // ...then lock and run on the second half
+    symsync_crcf_lock(q0);
+    symsync_crcf_lock(q1);
+    symsync_crcf_execute       (q0, x+num_samples/2, num_samples/2, y0, &ny0);
+    symsync_crcf_execute_stream(q1, x+num_samples/2, num_samples/2, y1, &ny1);
+    CONTEND_EQUALITY( ny0, ny1 );
+    CONTEND_LESS_THAN( ny0, ny_max+1 );
+    for (i=0; i<ny0; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy synchronizer objects
+    symsync_crcf_destroy(q0);
+    symsync_crcf_destroy(q1);
+}
+
+void autotest_symsync_crcf_get_stats()
+{
+    unsigned int k           =   2;     // samples/symbol
+    unsigned int m           =   7;     // filter delay (symbols)
+    float        beta        = 0.35f;   // excess bandwidth factor
+    unsigned int num_symbols = 400;     // number of data symbols
+
+    unsigned int i;
+    unsigned int num_samples = k*num_symbols;
+
+    // create synchronizer and check statistics are cleared on creation
+    symsync_crcf q = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC, k, m, beta, 32);
+    symsync_crcf_set_lf_bw(q, 0.02f);
+
+    liquid_symsync_stats stats;
+    symsync_crcf_get_stats(q, &stats);
+    CONTEND_EQUALITY( stats.num_symbols, 0 );
+    CONTEND_EQUALITY( stats.timing_error_mean, 0.0f );
+    CONTEND_EQUALITY( stats.timing_error_var,  0.0f );
+
+    // generate interpolated random QPSK sequence (no timing offset)
+    float complex x[num_samples];
+    modem mod = modem_create(LIQUID_MODEM_QPSK);
+    firinterp_crcf interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC,k,m,beta,0);
+    for (i=0; i<num_symbols; i++) {
+        unsigned int sym = modem_gen_rand_sym(mod);
+        float complex s;
+        modem_modulate(mod, sym, &s);
+        firinterp_crcf_execute(interp, s, &x[i*k]);
+    }
+    firinterp_crcf_destroy(interp);
+    modem_destroy(mod);
+
+    // run synchronizer over the entire sequence
+    unsigned int ny_max = symsync_crcf_get_output_max(q, num_samples);
+    float complex y[ny_max];
+    unsigned int ny;
+    symsync_crcf_execute(q, x, num_samples, y, &ny);
+
+    // statistics should reflect a converged loop: one update per output
+    // symbol, small residual timing error and rate near nominal
+    symsync_crcf_get_stats(q, &stats);
+    if (liquid_autotest_verbose) {
+        printf("symsync stats: n=%lu, err mean=%12.4e, var=%12.4e, rate=%8.6f, tau=%8.6f\n",
+                stats.num_symbols, stats.timing_error_mean, stats.timing_error_var,
+                stats.rate, stats.tau);
+    }
+    // the snapshot reflects the last loop update and may trail the final
+    // output symbol by one
+    CONTEND_DELTA(     (float)stats.num_symbols, (float)ny, 1.0f );
+    CONTEND_DELTA(     stats.timing_error_mean, 0.0f, 0.05f );
+    // variance of the converged loop depends on the random symbol
+    // sequence; bound with margin over the worst value observed
+    // across seeds (~0.056)
+    CONTEND_LESS_THAN( stats.timing_error_var,  0.10f );
+    CONTEND_DELTA(     stats.rate, (float)k, 0.01f );
+    CONTEND_DELTA(     stats.tau, symsync_crcf_get_tau(q), 0.01f );
+
+    // reset clears the accumulated statistics
+    symsync_crcf_reset(q);
+    symsync_crcf_get_stats(q, &stats);
+    CONTEND_EQUALITY( stats.num_symbols, 0 );
+    CONTEND_EQUALITY( stats.timing_error_mean, 0.0f );
+
+    symsync_crcf_destroy(q);
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// chanbankcf : work-stealing channel-bank executor
+//
+// Schedules independent per-channel processing (e.g. demodulator
+// chains behind a firpfbch2 channelizer) across worker threads.
+// Pending sample batches are submitted per channel; execute() drains
+// all channels, distributing them over per-worker deques.  A worker
+// pops work from the front of its own deque and, when empty, steals
+// from the back of another worker's deque, so bursty channels spread
+// across idle cores automatically.  Each channel is claimed by exactly
+// one worker per call, preserving in-order, single-threaded execution
+// of any one channel's (stateful) chain.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
+
+// maximum number of worker threads
+#define LIQUID_CHANBANK_MAX_THREADS (16)
+
+// per-channel pending batch (growable)
+struct chanbankcf_channel_s {
+    float complex * data;       // pending samples
+    unsigned int    num;        // number of pending samples
+    unsigned int    cap;        // allocated capacity
+};
+
+struct chanbankcf_s {
+    unsigned int num_channels;              // number of channels in the bank
+    unsigned int num_threads;               // number of worker threads
+    chanbankcf_channel_proc proc;           // channel processing function
+    void *       context;                   // common processing context
+
+    struct chanbankcf_channel_s * channels; // pending batches [size: num_channels x 1]
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+    // per-worker deques of channel indices, rebuilt by each execute()
+    unsigned int *  deque_items[LIQUID_CHANBANK_MAX_THREADS];
+    unsigned int    deque_head [LIQUID_CHANBANK_MAX_THREADS];
+    unsigned int    deque_tail [LIQUID_CHANBANK_MAX_THREADS];
+    pthread_mutex_t deque_lock [LIQUID_CHANBANK_MAX_THREADS];
+#endif
+};
+
+// create channel-bank executor
+//  _num_channels   :   number of channels in the bank, _num_channels > 0
+//  _num_threads    :   number of worker threads, 0 < _num_threads <= 16
+//  _proc           :   channel processing function
+//  _context        :   common context passed to the processing function
+chanbankcf chanbankcf_create(unsigned int            _num_channels,
+                             unsigned int            _num_threads,
+                             chanbankcf_channel_proc _proc,
+                             void *                  _context)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: chanbankcf_create(), number of channels must be greater than zero\n");
+        exit(1);
+    } else if (_num_threads == 0 || _num_threads > LIQUID_CHANBANK_MAX_THREADS) {
+        fprintf(stderr,"error: chanbankcf_create(), number of threads must be in [1,%u]\n",
+                LIQUID_CHANBANK_MAX_THREADS);
+        exit(1);
+    } else if (_proc == NULL) {
+        fprintf(stderr,"error: chanbankcf_create(), processing function cannot be NULL\n");
+        exit(1);
+    }
+
+    // create object and initialize
+    chanbankcf q = (chanbankcf) malloc(sizeof(struct chanbankcf_s));
+    q->num_channels = _num_channels;
+    q->num_threads  = _num_threads;
+    q->proc         = _proc;
+    q->context      = _context;
+
+    // never run more workers than channels
+    if (q->num_threads > q->num_channels)
+        q->num_threads = q->num_channels;
+
+    // allocate per-channel pending batches
+    q->channels = (struct chanbankcf_channel_s*) malloc(
+            q->num_channels*sizeof(struct chanbankcf_channel_s));
+    unsigned int i;
+    for (i=0; i<q->num_channels; i++) {
+        q->channels[i].data = NULL;
+        q->channels[i].num  = 0;
+        q->channels[i].cap  = 0;
+    }
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+    // allocate per-worker deques (each can hold every channel)
+    for (i=0; i<q->num_threads; i++) {
+        q->deque_items[i] = (unsigned int*) malloc(q->num_channels*sizeof(unsigned int));
+        q->deque_head[i]  = 0;
+        q->deque_tail[i]  = 0;
+        pthread_mutex_init(&q->deque_lock[i], NULL);
+    }
+#endif
+
+    return q;
+}
+
+// destroy channel-bank executor; channel objects referenced by the
+// processing context are user-owned and remain
+void chanbankcf_destroy(chanbankcf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        free(_q->channels[i].data);
+    free(_q->channels);
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+    for (i=0; i<_q->num_threads; i++) {
+        free(_q->deque_items[i]);
+        pthread_mutex_destroy(&_q->deque_lock[i]);
+    }
+#endif
+
+    free(_q);
+}
+
+// print channel-bank executor internals
+void chanbankcf_print(chanbankcf _q)
+{
+    printf("chanbankcf: [%u channels, %u threads]\n",
+            _q->num_channels, _q->num_threads);
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        printf("  channel %3u: %u samples pending\n", i, _q->channels[i].num);
+}
+
+// reset executor, discarding all pending samples
+void chanbankcf_reset(chanbankcf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->channels[i].num = 0;
+}
+
+// get number of channels in the bank
+unsigned int chanbankcf_get_num_channels(chanbankcf _q)
+{
+    return _q->num_channels;
+}
+
+// get number of samples pending on a channel
+unsigned int chanbankcf_get_num_pending(chanbankcf   _q,
+                                        unsigned int _channel)
+{
+    // validate input
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: chanbankcf_get_num_pending(), channel index (%u) exceeds maximum (%u)\n",
+                _channel, _q->num_channels);
+        exit(1);
+    }
+
+    return _q->channels[_channel].num;
+}
+
+// append sample batch to a channel's pending queue
+//  _q          :   channel-bank executor
+//  _channel    :   channel index
+//  _x          :   sample array [size: _n x 1]
+//  _n          :   number of samples
+void chanbankcf_submit(chanbankcf      _q,
+                       unsigned int    _channel,
+                       float complex * _x,
+                       unsigned int    _n)
+{
+    // validate input
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: chanbankcf_submit(), channel index (%u) exceeds maximum (%u)\n",
+                _channel, _q->num_channels);
+        exit(1);
+    }
+
+    struct chanbankcf_channel_s * c = &_q->channels[_channel];
+
+    // grow pending buffer as needed (doubling)
+    if (c->num + _n > c->cap) {
+        unsigned int cap = c->cap == 0 ? 64 : c->cap;
+        while (cap < c->num + _n)
+            cap <<= 1;
+        c->data = (float complex*) realloc(c->data, cap*sizeof(float complex));
+        c->cap  = cap;
+    }
+
+    // append samples
+    memmove(c->data + c->num, _x, _n*sizeof(float complex));
+    c->num += _n;
+}
+
+// run a claimed channel's pending batch and clear it
+static void chanbankcf_run_channel(chanbankcf   _q,
+                                   unsigned int _channel)
+{
+    struct chanbankcf_channel_s * c = &_q->channels[_channel];
+    _q->proc(_q->context, _channel, c->data, c->num);
+    c->num = 0;
+}
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+
+// worker context for threaded execution
+struct chanbankcf_worker_s {
+    chanbankcf   q;         // executor object
+    unsigned int worker;    // worker index
+};
+
+// worker loop: drain own deque from the front, then steal channels
+// from the back of other workers' deques; exit when every deque has
+// been seen empty (all channels claimed)
+static void * chanbankcf_worker(void * _arg)
+{
+    struct chanbankcf_worker_s * ctx = (struct chanbankcf_worker_s *) _arg;
+    chanbankcf q   = ctx->q;
+    unsigned int w = ctx->worker;
+
+    while (1) {
+        unsigned int channel;
+        int claimed = 0;
+
+        // pop from the front of this worker's own deque
+        pthread_mutex_lock(&q->deque_lock[w]);
+        if (q->deque_head[w] < q->deque_tail[w]) {
+            channel = q->deque_items[w][q->deque_head[w]++];
+            claimed = 1;
+        }
+        pthread_mutex_unlock(&q->deque_lock[w]);
+
+        // steal from the back of another worker's deque
+        unsigned int v;
+        for (v=0; v<q->num_threads && !claimed; v++) {
+            if (v == w) continue;
+            pthread_mutex_lock(&q->deque_lock[v]);
+            if (q->deque_head[v] < q->deque_tail[v]) {
+                channel = q->deque_items[v][--q->deque_tail[v]];
+                claimed = 1;
+            }
+            pthread_mutex_unlock(&q->deque_lock[v]);
+        }
+
+        // no channel left anywhere: all work has been claimed
+        if (!claimed)
+            break;
+
+        chanbankcf_run_channel(q, channel);
+    }
+
+    return NULL;
+}
+
+#endif
+
+// drain all pending channel batches across the worker threads; blocks
+// until every channel has been processed
+void chanbankcf_execute(chanbankcf _q)
+{
+    unsigned int i;
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+    if (_q->num_threads > 1) {
+        // distribute channels with pending samples over the worker
+        // deques round-robin; stealing rebalances uneven batches
+        for (i=0; i<_q->num_threads; i++) {
+            _q->deque_head[i] = 0;
+            _q->deque_tail[i] = 0;
+        }
+        unsigned int w = 0;
+        for (i=0; i<_q->num_channels; i++) {
+            if (_q->channels[i].num == 0)
+                continue;
+            _q->deque_items[w][_q->deque_tail[w]++] = i;
+            w = (w+1) % _q->num_threads;
+        }
+
+        // spawn workers 1..num_threads-1, running worker 0 inline
+        pthread_t threads[LIQUID_CHANBANK_MAX_THREADS];
+        struct chanbankcf_worker_s ctx[LIQUID_CHANBANK_MAX_THREADS];
+        for (i=0; i<_q->num_threads; i++) {
+            ctx[i].q      = _q;
+            ctx[i].worker = i;
+        }
+        for (i=1; i<_q->num_threads; i++)
+            pthread_create(&threads[i], NULL, chanbankcf_worker, &ctx[i]);
+        chanbankcf_worker(&ctx[0]);
+        for (i=1; i<_q->num_threads; i++)
+            pthread_join(threads[i], NULL);
+
+        return;
+    }
+#endif
+
+    // serial fallback (single worker or no pthread support)
+    for (i=0; i<_q->num_channels; i++) {
+        if (_q->channels[i].num > 0)
+            chanbankcf_run_channel(_q, i);
+    }
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flowgraphcf : stream-graph execution engine
+//
+// Connects a chain of block-based processing nodes and executes them
+// with batched hand-off: each cache-sized chunk of samples is carried
+// through the entire chain before the next chunk is read, so the data
+// stays resident while the per-call overhead is amortized over the
+// chunk.  Nodes wrap existing liquid objects; the graph owns only the
+// scheduling and the intermediate buffers.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// internal node descriptor
+struct flowgraphcf_node_s {
+    flowgraphcf_node_proc proc;     // node processing function
+    void *                context;  // node object (user-owned)
+    float                 rate;     // maximum output/input sample ratio
+};
+
+struct flowgraphcf_s {
+    unsigned int block_len;             // scheduling chunk size [samples]
+
+    struct flowgraphcf_node_s * nodes;  // node descriptors [size: num_nodes x 1]
+    unsigned int num_nodes;             // number of nodes in the chain
+
+    cbuffercf buf_in;                   // input staging buffer
+    float complex * buf_0;              // chunk scratch buffer (ping)
+    float complex * buf_1;              // chunk scratch buffer (pong)
+    unsigned int chunk_out_max;         // output bound for one chunk
+};
+
+// re-compute per-chunk output bound and resize scratch buffers;
+// internal method invoked when a node is appended
+void flowgraphcf_update_buffers(flowgraphcf _q)
+{
+    // propagate chunk size bound through the chain, allowing a small
+    // burst margin per node (e.g. resamplers emitting an extra sample)
+    unsigned int i;
+    unsigned int n = _q->block_len;
+    for (i=0; i<_q->num_nodes; i++) {
+        float rate = _q->nodes[i].rate;
+        if (rate > 1.0f)
+            n = (unsigned int) ceilf(n*rate);
+        n += 4;
+    }
+    _q->chunk_out_max = n;
+
+    // scratch buffers hold a chunk at any point along the chain
+    _q->buf_0 = (float complex*) realloc(_q->buf_0, n*sizeof(float complex));
+    _q->buf_1 = (float complex*) realloc(_q->buf_1, n*sizeof(float complex));
+}
+
+// create flowgraph object
+//  _block_len  :   scheduling chunk size [samples]
+flowgraphcf flowgraphcf_create(unsigned int _block_len)
+{
+    // validate input
+    if (_block_len == 0) {
+        fprintf(stderr,"error: flowgraphcf_create(), block length must be greater than zero\n");
+        exit(1);
+    }
+
+    // create object and initialize
+    flowgraphcf q = (flowgraphcf) malloc(sizeof(struct flowgraphcf_s));
+    q->block_len = _block_len;
+    q->nodes     = NULL;
+    q->num_nodes = 0;
+
+    // create input staging buffer and scratch buffers
+    q->buf_in = cbuffercf_create(q->block_len);
+    q->buf_0  = NULL;
+    q->buf_1  = NULL;
+    flowgraphcf_update_buffers(q);
+
+    return q;
+}
+
+// destroy flowgraph object; node objects are user-owned and remain
+void flowgraphcf_destroy(flowgraphcf _q)
+{
+    cbuffercf_destroy(_q->buf_in);
+    free(_q->nodes);
+    free(_q->buf_0);
+    free(_q->buf_1);
+    free(_q);
+}
+
+// print flowgraph object internals
+void flowgraphcf_print(flowgraphcf _q)
+{
+    printf("flowgraphcf: [%u nodes, block length %u]\n",
+            _q->num_nodes, _q->block_len);
+    unsigned int i;
+    for (i=0; i<_q->num_nodes; i++)
+        printf("  node %3u: rate %8.4f\n", i, _q->nodes[i].rate);
+}
+
+// reset flowgraph scheduling state; node objects are not reset
+void flowgraphcf_reset(flowgraphcf _q)
+{
+    cbuffercf_reset(_q->buf_in);
+}
+
+// append processing node to the end of the chain
+//  _q          :   flowgraph object
+//  _proc       :   node processing function
+//  _context    :   node object passed to the processing function
+//  _rate       :   maximum output/input sample ratio, _rate > 0
+void flowgraphcf_add_node(flowgraphcf           _q,
+                          flowgraphcf_node_proc _proc,
+                          void *                _context,
+                          float                 _rate)
+{
+    // validate input
+    if (_proc == NULL) {
+        fprintf(stderr,"error: flowgraphcf_add_node(), processing function cannot be NULL\n");
+        exit(1);
+    } else if (_rate <= 0.0f) {
+        fprintf(stderr,"error: flowgraphcf_add_node(), rate must be greater than zero\n");
+        exit(1);
+    }
+
+    // extend node array and append descriptor
+    _q->nodes = (struct flowgraphcf_node_s*) realloc(_q->nodes,
+            (_q->num_nodes+1)*sizeof(struct flowgraphcf_node_s));
+    _q->nodes[_q->num_nodes].proc    = _proc;
+    _q->nodes[_q->num_nodes].context = _context;
+    _q->nodes[_q->num_nodes].rate    = _rate;
+    _q->num_nodes++;
+
+    // re-size internal buffers for the extended chain
+    flowgraphcf_update_buffers(_q);
+}
+
+// get number of nodes in the chain
+unsigned int flowgraphcf_get_num_nodes(flowgraphcf _q)
+{
+    return _q->num_nodes;
+}
+
+// get upper bound on the number of output samples generated by
+// executing the graph on _n input samples
+unsigned int flowgraphcf_get_output_max(flowgraphcf  _q,
+                                        unsigned int _n)
+{
+    // each chunk produces at most chunk_out_max output samples
+    unsigned int num_chunks = (_n + _q->block_len - 1) / _q->block_len;
+    return num_chunks * _q->chunk_out_max;
+}
+
+// execute the graph on a block of input samples, carrying each chunk
+// through the full chain before the next chunk is read
+//  _q      :   flowgraph object
+//  _x      :   input sample array [size: _nx x 1]
+//  _nx     :   number of input samples
+//  _y      :   output sample array [size: flowgraphcf_get_output_max(_q,_nx) x 1]
+//  _ny     :   number of output samples written
+void flowgraphcf_execute(flowgraphcf     _q,
+                         float complex * _x,
+                         unsigned int    _nx,
+                         float complex * _y,
+                         unsigned int *  _ny)
+{
+    unsigned int ny = 0;
+    while (_nx > 0 || cbuffercf_size(_q->buf_in) > 0) {
+        // top off staging buffer from the input array
+        unsigned int n = cbuffercf_space_available(_q->buf_in);
+        if (n > _nx) n = _nx;
+        if (n > 0) {
+            cbuffercf_write(_q->buf_in, _x, n);
+            _x  += n;
+            _nx -= n;
+        }
+
+        // read one chunk into the scratch buffer
+        unsigned int r;
+        float complex * p;
+        cbuffercf_read(_q->buf_in, _q->block_len, &p, &r);
+        memmove(_q->buf_0, p, r*sizeof(float complex));
+        cbuffercf_release(_q->buf_in, r);
+
+        // run the chunk through every node while it is cache-resident
+        unsigned int i;
+        for (i=0; i<_q->num_nodes; i++) {
+            r = _q->nodes[i].proc(_q->nodes[i].context, _q->buf_0, r, _q->buf_1);
+
+            // swap scratch buffers: output becomes next node's input
+            float complex * tmp = _q->buf_0;
+            _q->buf_0 = _q->buf_1;
+            _q->buf_1 = tmp;
+        }
+
+        // append chunk output to the output array
+        memmove(_y + ny, _q->buf_0, r*sizeof(float complex));
+        ny += r;
+    }
+
+    // set return value
+    *_ny = ny;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+#define CHANBANKCF_TEST_MAX_CHANNELS    (16)
+#define CHANBANKCF_TEST_MAX_SAMPLES     (4096)
+
+// collection context: each channel's callback appends the samples it
+// receives to that channel's private array (one worker per channel, so
+// no synchronization is required)
+struct chanbankcf_testbench_s {
+    float complex y[CHANBANKCF_TEST_MAX_CHANNELS][CHANBANKCF_TEST_MAX_SAMPLES];
+    unsigned int  ny[CHANBANKCF_TEST_MAX_CHANNELS];
+};
+
+static void chanbankcf_testbench_proc(void *          _context,
+                                      unsigned int    _channel,
+                                      float complex * _x,
+                                      unsigned int    _n)
+{
+    struct chanbankcf_testbench_s * tb = (struct chanbankcf_testbench_s *) _context;
+    memmove(tb->y[_channel] + tb->ny[_channel], _x, _n*sizeof(float complex));
+    tb->ny[_channel] += _n;
+}
+
+// submit uneven random batches on each channel and verify every
+// channel's callback receives exactly the submitted stream, in order,
+// when drained across multiple worker threads
+void autotest_chanbankcf_order()
+{
+    unsigned int num_channels = 12;
+    unsigned int num_threads  =  4;
+    unsigned int num_rounds   =  8;
+
+    unsigned int i, j, n;
+
+    struct chanbankcf_testbench_s * tb =
+        (struct chanbankcf_testbench_s*) calloc(1, sizeof(struct chanbankcf_testbench_s));
+    chanbankcf q = chanbankcf_create(num_channels, num_threads,
+                                     chanbankcf_testbench_proc, tb);
+    CONTEND_EQUALITY( chanbankcf_get_num_channels(q), num_channels );
+
+    // reference streams
+    float complex x[CHANBANKCF_TEST_MAX_CHANNELS][CHANBANKCF_TEST_MAX_SAMPLES];
+    unsigned int  nx[CHANBANKCF_TEST_MAX_CHANNELS];
+    for (i=0; i<num_channels; i++)
+        nx[i] = 0;
+
+    for (j=0; j<num_rounds; j++) {
+        // submit a batch of random length on each channel; channel
+        // index skews the load to exercise stealing
+        for (i=0; i<num_channels; i++) {
+            n = 16 + (rand() % (32*(i+1)));
+            float complex batch[n];
+            unsigned int k;
+            for (k=0; k<n; k++)
+                batch[k] = randnf() + randnf()*_Complex_I;
+
+            chanbankcf_submit(q, i, batch, n);
+            memmove(x[i] + nx[i], batch, n*sizeof(float complex));
+            nx[i] += n;
+        }
+
+        // drain the bank
+        chanbankcf_execute(q);
+        for (i=0; i<num_channels; i++)
+            CONTEND_EQUALITY( chanbankcf_get_num_pending(q, i), 0 );
+    }
+
+    // each channel's collected stream matches its submitted stream
+    for (i=0; i<num_channels; i++) {
+        CONTEND_EQUALITY( tb->ny[i], nx[i] );
+        CONTEND_SAME_DATA( tb->y[i], x[i], nx[i]*sizeof(float complex) );
+    }
+
+    chanbankcf_destroy(q);
+    free(tb);
+}
+
+// feed the bank from a firpfbch2 channelizer and verify the collected
+// per-channel streams match the channelizer output exactly
+void autotest_chanbankcf_firpfbch2()
+{
+    unsigned int M           =  8;  // number of channels
+    unsigned int m           =  4;  // prototype filter semi-length
+    unsigned int num_symbols = 64;  // channelizer input blocks
+
+    unsigned int i, j;
+
+    struct chanbankcf_testbench_s * tb =
+        (struct chanbankcf_testbench_s*) calloc(1, sizeof(struct chanbankcf_testbench_s));
+    chanbankcf q = chanbankcf_create(M, 2, chanbankcf_testbench_proc, tb);
+
+    // create channelizer and reference per-channel streams
+    firpfbch2_crcf ch = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, m, 60.0f);
+    float complex y_ref[CHANBANKCF_TEST_MAX_CHANNELS][CHANBANKCF_TEST_MAX_SAMPLES];
+
+    for (j=0; j<num_symbols; j++) {
+        // run channelizer on M/2 random input samples
+        float complex x[M/2];
+        float complex Y[M];
+        for (i=0; i<M/2; i++)
+            x[i] = randnf() + randnf()*_Complex_I;
+        firpfbch2_crcf_execute(ch, x, Y);
+
+        // submit each channel's output sample to the bank
+        for (i=0; i<M; i++) {
+            chanbankcf_submit(q, i, &Y[i], 1);
+            y_ref[i][j] = Y[i];
+        }
+
+        // drain periodically (batches of several symbols)
+        if ((j % 10) == 9)
+            chanbankcf_execute(q);
+    }
+    chanbankcf_execute(q);
+
+    // verify collected streams
+    for (i=0; i<M; i++) {
+        CONTEND_EQUALITY( tb->ny[i], num_symbols );
+        CONTEND_SAME_DATA( tb->y[i], y_ref[i], num_symbols*sizeof(float complex) );
+    }
+
+    firpfbch2_crcf_destroy(ch);
+    chanbankcf_destroy(q);
+    free(tb);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// node wrappers around existing liquid objects
+
+static unsigned int flowgraphcf_test_node_firfilt(void *          _context,
+                                                  float complex * _x,
+                                                  unsigned int    _n,
+                                                  float complex * _y)
+{
+    firfilt_crcf_execute_block((firfilt_crcf)_context, _x, _n, _y);
+    return _n;
+}
+
+static unsigned int flowgraphcf_test_node_mixdown(void *          _context,
+                                                  float complex * _x,
+                                                  unsigned int    _n,
+                                                  float complex * _y)
+{
+    nco_crcf_mix_block_down((nco_crcf)_context, _x, _y, _n);
+    return _n;
+}
+
+static unsigned int flowgraphcf_test_node_resamp(void *          _context,
+                                                 float complex * _x,
+                                                 unsigned int    _n,
+                                                 float complex * _y)
+{
+    unsigned int ny;
+    resamp_crcf_execute_block((resamp_crcf)_context, _x, _n, _y, &ny);
+    return ny;
+}
+
+// run a firfilt -> mixer -> resampler chain through the graph and
+// compare against invoking the same objects directly
+void autotest_flowgraphcf_chain()
+{
+    unsigned int block_len   =  64;     // scheduling chunk size
+    unsigned int num_samples = 400;     // number of input samples
+    float        rate        = 0.75f;   // resampling rate
+    float        tol         = 1e-4f;   // allows for vectorized dot product
+                                        // summation order differences
+
+    unsigned int i;
+
+    // create two identical sets of processing objects
+    firfilt_crcf filt0 = firfilt_crcf_create_kaiser(21, 0.3f, 60.0f, 0.0f);
+    firfilt_crcf filt1 = firfilt_crcf_create_kaiser(21, 0.3f, 60.0f, 0.0f);
+    nco_crcf     mix0  = nco_crcf_create(LIQUID_NCO);
+    nco_crcf     mix1  = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_frequency(mix0, 0.1f);
+    nco_crcf_set_frequency(mix1, 0.1f);
+    resamp_crcf  rs0   = resamp_crcf_create(rate, 7, 0.4f, 60.0f, 64);
+    resamp_crcf  rs1   = resamp_crcf_create(rate, 7, 0.4f, 60.0f, 64);
+
+    // build flowgraph on the first set
+    flowgraphcf fg = flowgraphcf_create(block_len);
+    flowgraphcf_add_node(fg, flowgraphcf_test_node_firfilt, filt0, 1.0f);
+    flowgraphcf_add_node(fg, flowgraphcf_test_node_mixdown, mix0,  1.0f);
+    flowgraphcf_add_node(fg, flowgraphcf_test_node_resamp,  rs0,   rate);
+    CONTEND_EQUALITY( flowgraphcf_get_num_nodes(fg), 3 );
+
+    // generate random input
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // execute graph
+    unsigned int ny_max = flowgraphcf_get_output_max(fg, num_samples);
+    float complex y0[ny_max];
+    unsigned int ny0;
+    flowgraphcf_execute(fg, x, num_samples, y0, &ny0);
+    CONTEND_LESS_THAN( ny0, ny_max+1 );
+
+    // compute reference by invoking the second set directly
+    float complex t0[num_samples];
+    float complex t1[num_samples];
+    float complex y1[ny_max];
+    unsigned int ny1;
+    firfilt_crcf_execute_block(filt1, x, num_samples, t0);
+    nco_crcf_mix_block_down(mix1, t0, t1, num_samples);
+    resamp_crcf_execute_block(rs1, t1, num_samples, y1, &ny1);
+
+    // validate results
+    CONTEND_EQUALITY( ny0, ny1 );
+    for (i=0; i<ny0; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects
+    flowgraphcf_destroy(fg);
+    firfilt_crcf_destroy(filt0);
+    firfilt_crcf_destroy(filt1);
+    nco_crcf_destroy(mix0);
+    nco_crcf_destroy(mix1);
+    resamp_crcf_destroy(rs0);
+    resamp_crcf_destroy(rs1);
+}
+
+// an empty graph passes samples through unmodified
+void autotest_flowgraphcf_passthrough()
+{
+    unsigned int block_len   = 16;
+    unsigned int num_samples = 53;  // deliberately not a chunk multiple
+
+    unsigned int i;
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    flowgraphcf fg = flowgraphcf_create(block_len);
+    CONTEND_EQUALITY( flowgraphcf_get_num_nodes(fg), 0 );
+
+    float complex y[flowgraphcf_get_output_max(fg, num_samples)];
+    unsigned int ny;
+    flowgraphcf_execute(fg, x, num_samples, y, &ny);
+
+    CONTEND_EQUALITY( ny, num_samples );
+    CONTEND_SAME_DATA( x, y, num_samples*sizeof(float complex) );
+
+    flowgraphcf_destroy(fg);
+}
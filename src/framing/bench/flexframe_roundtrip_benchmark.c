@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// end-to-end frame encode/decode (round-trip) benchmarks; each trial
+// assembles, generates, and synchronizes one complete frame, and the
+// payload throughput is reported in addition to the trial rate
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+static int flexframe_roundtrip_callback(unsigned char *  _header,
+                                        int              _header_valid,
+                                        unsigned char *  _payload,
+                                        unsigned int     _payload_len,
+                                        int              _payload_valid,
+                                        framesyncstats_s _stats,
+                                        void *           _userdata)
+{
+    unsigned int * num_payloads_valid = (unsigned int*) _userdata;
+    if (_payload_valid)
+        (*num_payloads_valid)++;
+    return 0;
+}
+
+// compute elapsed user+system time between rusage captures
+static double flexframe_roundtrip_extime(struct rusage * _start,
+                                         struct rusage * _finish)
+{
+    return _finish->ru_utime.tv_sec - _start->ru_utime.tv_sec
+        + 1e-6*(_finish->ru_utime.tv_usec - _start->ru_utime.tv_usec)
+        + _finish->ru_stime.tv_sec - _start->ru_stime.tv_sec
+        + 1e-6*(_finish->ru_stime.tv_usec - _start->ru_stime.tv_usec);
+}
+
+// Helper function to keep code base small
+void flexframe_roundtrip_bench(struct rusage *     _start,
+                               struct rusage *     _finish,
+                               unsigned long int * _num_iterations,
+                               unsigned int        _payload_len,
+                               modulation_scheme   _ms,
+                               fec_scheme          _fec0,
+                               fec_scheme          _fec1)
+{
+    *_num_iterations /= 300 + _payload_len;
+    if (*_num_iterations < 1)
+        *_num_iterations = 1;
+    unsigned long int i;
+
+    // create frame generator with specified properties
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = _fec0;
+    fgprops.fec1       = _fec1;
+    fgprops.mod_scheme = _ms;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create frame synchronizer
+    unsigned int num_payloads_valid = 0;
+    flexframesync fs = flexframesync_create(flexframe_roundtrip_callback,
+                                            (void*)&num_payloads_valid);
+
+    // initialize header, payload
+    unsigned char header[14];
+    unsigned char payload[_payload_len];
+    for (i=0; i<14; i++)
+        header[i] = i;
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    // determine frame length and allocate sample buffer
+    flexframegen_assemble(fg, header, payload, _payload_len);
+    unsigned int frame_len = flexframegen_getframelen(fg);
+    float complex frame[frame_len];
+    flexframegen_reset(fg);
+
+    //
+    // start trials: full assemble/generate/synchronize cycle
+    //
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        flexframegen_assemble(fg, header, payload, _payload_len);
+        int frame_complete = 0;
+        while (!frame_complete)
+            frame_complete = flexframegen_write_samples(fg, frame, frame_len);
+        flexframesync_execute(fs, frame, frame_len);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // report payload throughput
+    double extime = flexframe_roundtrip_extime(_start, _finish);
+    printf("  payloads valid: %6u / %6lu, payload throughput: %8.3f Mbps\n",
+            num_payloads_valid, *_num_iterations,
+            extime <= 0.0 ? 0.0 :
+            1e-6 * (double)(*_num_iterations) * (double)_payload_len * 8.0 / extime);
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+#define FLEXFRAME_ROUNDTRIP_BENCH_API(PAYLOAD_LEN,MS,FEC0,FEC1)     \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ flexframe_roundtrip_bench(_start, _finish, _num_iterations,       \
+                            PAYLOAD_LEN, MS, FEC0, FEC1); }
+
+// payload length sweep
+void benchmark_flexframe_roundtrip_p64_qpsk
+    FLEXFRAME_ROUNDTRIP_BENCH_API(  64, LIQUID_MODEM_QPSK,  LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+void benchmark_flexframe_roundtrip_p256_qpsk
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QPSK,  LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+void benchmark_flexframe_roundtrip_p1024_qpsk
+    FLEXFRAME_ROUNDTRIP_BENCH_API(1024, LIQUID_MODEM_QPSK,  LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+// modulation scheme sweep
+void benchmark_flexframe_roundtrip_p256_bpsk
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_BPSK,  LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+void benchmark_flexframe_roundtrip_p256_qam16
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QAM16, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+void benchmark_flexframe_roundtrip_p256_qam64
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QAM64, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+// FEC pair sweep
+void benchmark_flexframe_roundtrip_p256_qpsk_h128
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QPSK,  LIQUID_FEC_HAMMING128, LIQUID_FEC_NONE);
+void benchmark_flexframe_roundtrip_p256_qpsk_g2412
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QPSK,  LIQUID_FEC_GOLAY2412,  LIQUID_FEC_NONE);
+void benchmark_flexframe_roundtrip_p256_qpsk_h128_h74
+    FLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QPSK,  LIQUID_FEC_HAMMING128, LIQUID_FEC_HAMMING74);
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// end-to-end OFDM frame encode/decode (round-trip) benchmarks; each
+// trial assembles, generates, and synchronizes one complete frame, and
+// the payload throughput is reported in addition to the trial rate
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+static int ofdmflexframe_roundtrip_callback(unsigned char *  _header,
+                                            int              _header_valid,
+                                            unsigned char *  _payload,
+                                            unsigned int     _payload_len,
+                                            int              _payload_valid,
+                                            framesyncstats_s _stats,
+                                            void *           _userdata)
+{
+    unsigned int * num_payloads_valid = (unsigned int*) _userdata;
+    if (_payload_valid)
+        (*num_payloads_valid)++;
+    return 0;
+}
+
+// compute elapsed user+system time between rusage captures
+static double ofdmflexframe_roundtrip_extime(struct rusage * _start,
+                                             struct rusage * _finish)
+{
+    return _finish->ru_utime.tv_sec - _start->ru_utime.tv_sec
+        + 1e-6*(_finish->ru_utime.tv_usec - _start->ru_utime.tv_usec)
+        + _finish->ru_stime.tv_sec - _start->ru_stime.tv_sec
+        + 1e-6*(_finish->ru_stime.tv_usec - _start->ru_stime.tv_usec);
+}
+
+// Helper function to keep code base small
+void ofdmflexframe_roundtrip_bench(struct rusage *     _start,
+                                   struct rusage *     _finish,
+                                   unsigned long int * _num_iterations,
+                                   unsigned int        _payload_len,
+                                   modulation_scheme   _ms,
+                                   fec_scheme          _fec0)
+{
+    *_num_iterations /= 2000 + _payload_len;
+    if (*_num_iterations < 1)
+        *_num_iterations = 1;
+    unsigned long int i;
+
+    // OFDM parameters
+    unsigned int M         = 64;    // number of subcarriers
+    unsigned int cp_len    = 16;    // cyclic prefix length
+    unsigned int taper_len =  4;    // taper length
+    unsigned int buf_len   = M + cp_len;
+
+    // create frame generator with specified properties
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = _fec0;
+    fgprops.fec1       = LIQUID_FEC_NONE;
+    fgprops.mod_scheme = _ms;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, &fgprops);
+
+    // create frame synchronizer
+    unsigned int num_payloads_valid = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+                                                    ofdmflexframe_roundtrip_callback,
+                                                    (void*)&num_payloads_valid);
+
+    // initialize header, payload
+    unsigned char header[8];
+    unsigned char payload[_payload_len];
+    for (i=0; i<8; i++)
+        header[i] = i;
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    // sample buffer (one OFDM symbol at a time)
+    float complex buf[buf_len];
+
+    //
+    // start trials: full assemble/generate/synchronize cycle
+    //
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        ofdmflexframegen_assemble(fg, header, payload, _payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, buf_len);
+            ofdmflexframesync_execute(fs, buf, buf_len);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // report payload throughput
+    double extime = ofdmflexframe_roundtrip_extime(_start, _finish);
+    printf("  payloads valid: %6u / %6lu, payload throughput: %8.3f Mbps\n",
+            num_payloads_valid, *_num_iterations,
+            extime <= 0.0 ? 0.0 :
+            1e-6 * (double)(*_num_iterations) * (double)_payload_len * 8.0 / extime);
+
+    // destroy objects
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+#define OFDMFLEXFRAME_ROUNDTRIP_BENCH_API(PAYLOAD_LEN,MS,FEC0)      \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ ofdmflexframe_roundtrip_bench(_start, _finish, _num_iterations,   \
+                                PAYLOAD_LEN, MS, FEC0); }
+
+// payload length sweep
+void benchmark_ofdmflexframe_roundtrip_p64_qpsk
+    OFDMFLEXFRAME_ROUNDTRIP_BENCH_API(  64, LIQUID_MODEM_QPSK,  LIQUID_FEC_NONE);
+void benchmark_ofdmflexframe_roundtrip_p256_qpsk
+    OFDMFLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QPSK,  LIQUID_FEC_NONE);
+void benchmark_ofdmflexframe_roundtrip_p1024_qpsk
+    OFDMFLEXFRAME_ROUNDTRIP_BENCH_API(1024, LIQUID_MODEM_QPSK,  LIQUID_FEC_NONE);
+
+// modulation scheme / FEC sweep
+void benchmark_ofdmflexframe_roundtrip_p256_qam16
+    OFDMFLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QAM16, LIQUID_FEC_NONE);
+void benchmark_ofdmflexframe_roundtrip_p256_qpsk_g2412
+    OFDMFLEXFRAME_ROUNDTRIP_BENCH_API( 256, LIQUID_MODEM_QPSK,  LIQUID_FEC_GOLAY2412);
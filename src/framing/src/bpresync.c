@@ -45,6 +45,18 @@ struct BPRESYNC(_s) {
     float * rxy;        // output correlation [size: m x 1]
 
     float n_inv;        // 1/n (pre-computed for speed)
+
+    // two-stage (hierarchical) acquisition: a short prefix correlator
+    // runs at every offset and only when it passes threshold is the
+    // full-length, all-Doppler correlation computed
+    int       prefix_enabled;   // prefix pre-screening enabled?
+    unsigned int n_prefix;      // prefix correlator length
+    float     prefix_threshold; // pre-screening detection threshold
+    float     n_prefix_inv;     // 1/n_prefix (pre-computed for speed)
+    bsequence prefix_rx_i;      // received prefix pattern (in-phase)
+    bsequence prefix_rx_q;      // received prefix pattern (quadrature)
+    bsequence prefix_sync_i;    // prefix sync pattern (in-phase)
+    bsequence prefix_sync_q;    // prefix sync pattern (quadrature)
 };
 
 // correlate input sequence with particular sequence index
@@ -57,6 +69,9 @@ void BPRESYNC(_correlatex)(BPRESYNC()      _q,
                            float complex * _rxy0,
                            float complex * _rxy1);
 
+// evaluate short prefix correlator, returning output magnitude
+float BPRESYNC(_prefix_rxy)(BPRESYNC() _q);
+
 // create binary pre-demod synchronizer
 //  _v          :   baseband sequence
 //  _n          :   baseband sequence length
@@ -114,6 +129,13 @@ BPRESYNC() BPRESYNC(_create)(TC *         _v,
     // allocate memory for cross-correlation
     _q->rxy = (float*) malloc( _q->m*sizeof(float) );
 
+    // two-stage acquisition disabled by default
+    _q->prefix_enabled = 0;
+    _q->prefix_rx_i    = NULL;
+    _q->prefix_rx_q    = NULL;
+    _q->prefix_sync_i  = NULL;
+    _q->prefix_sync_q  = NULL;
+
     // reset object
     BPRESYNC(_reset)(_q);
 
@@ -142,6 +164,14 @@ void BPRESYNC(_destroy)(BPRESYNC() _q)
     // free internal cross-correlation array
     free(_q->rxy);
 
+    // free prefix correlator objects
+    if (_q->prefix_enabled) {
+        bsequence_destroy(_q->prefix_rx_i);
+        bsequence_destroy(_q->prefix_rx_q);
+        bsequence_destroy(_q->prefix_sync_i);
+        bsequence_destroy(_q->prefix_sync_q);
+    }
+
     // free main object memory
     free(_q);
 }
@@ -158,6 +188,79 @@ void BPRESYNC(_reset)(BPRESYNC() _q)
         bsequence_push(_q->rx_i, (i+0) % 2);
         bsequence_push(_q->rx_q, (i+1) % 2);
     }
+
+    // reset prefix receive buffers to same alternating pattern
+    if (_q->prefix_enabled) {
+        for (i=0; i<_q->n_prefix; i++) {
+            bsequence_push(_q->prefix_rx_i, (i+0) % 2);
+            bsequence_push(_q->prefix_rx_q, (i+1) % 2);
+        }
+    }
+}
+
+// enable two-stage (hierarchical) acquisition: a short correlator over
+// the last _prefix_len sequence symbols is evaluated first and the
+// full-length, all-Doppler correlation runs only when its output
+// magnitude meets _threshold; offsets failing the pre-screen return a
+// zero correlation without touching the full-length correlators
+//  _q          :   pre-demod synchronizer object
+//  _prefix_len :   prefix correlator length, 0 < _prefix_len <= n
+//  _threshold  :   pre-screening detection threshold (e.g. 0.5)
+void BPRESYNC(_enable_prefix)(BPRESYNC()   _q,
+                              unsigned int _prefix_len,
+                              float        _threshold)
+{
+    // validate input
+    if (_prefix_len == 0 || _prefix_len > _q->n) {
+        fprintf(stderr, "error: bpresync_%s_enable_prefix(), prefix length must be in (0,n]\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // discard any previous prefix correlator
+    BPRESYNC(_disable_prefix)(_q);
+
+    _q->n_prefix         = _prefix_len;
+    _q->n_prefix_inv     = 1.0f / (float)(_q->n_prefix);
+    _q->prefix_threshold = _threshold;
+
+    // create prefix receive buffers and seed from main buffer contents
+    // (bit index 0 is the most recently received sample)
+    _q->prefix_rx_i = bsequence_create(_q->n_prefix);
+    _q->prefix_rx_q = bsequence_create(_q->n_prefix);
+    unsigned int i;
+    for (i=0; i<_q->n_prefix; i++) {
+        bsequence_push(_q->prefix_rx_i, bsequence_index(_q->rx_i, _q->n_prefix-i-1));
+        bsequence_push(_q->prefix_rx_q, bsequence_index(_q->rx_q, _q->n_prefix-i-1));
+    }
+
+    // create prefix sync pattern from the tail of the zero-offset
+    // template (sequence index 0 carries no frequency offset)
+    _q->prefix_sync_i = bsequence_create(_q->n_prefix);
+    _q->prefix_sync_q = bsequence_create(_q->n_prefix);
+    for (i=0; i<_q->n_prefix; i++) {
+        bsequence_push(_q->prefix_sync_i, bsequence_index(_q->sync_i[0], _q->n_prefix-i-1));
+        bsequence_push(_q->prefix_sync_q, bsequence_index(_q->sync_q[0], _q->n_prefix-i-1));
+    }
+
+    _q->prefix_enabled = 1;
+}
+
+// disable two-stage acquisition, reverting to full correlation at
+// every offset
+void BPRESYNC(_disable_prefix)(BPRESYNC() _q)
+{
+    if (!_q->prefix_enabled)
+        return;
+
+    bsequence_destroy(_q->prefix_rx_i);
+    bsequence_destroy(_q->prefix_rx_q);
+    bsequence_destroy(_q->prefix_sync_i);
+    bsequence_destroy(_q->prefix_sync_q);
+    _q->prefix_rx_i    = NULL;
+    _q->prefix_rx_q    = NULL;
+    _q->prefix_sync_i  = NULL;
+    _q->prefix_sync_q  = NULL;
+    _q->prefix_enabled = 0;
 }
 
 /* push input sample into pre-demod synchronizer            */
@@ -169,6 +272,12 @@ void BPRESYNC(_push)(BPRESYNC() _q,
     // push symbol into buffers
     bsequence_push(_q->rx_i, REAL(_x)>0);
     bsequence_push(_q->rx_q, IMAG(_x)>0);
+
+    // push symbol into prefix buffers
+    if (_q->prefix_enabled) {
+        bsequence_push(_q->prefix_rx_i, REAL(_x)>0);
+        bsequence_push(_q->prefix_rx_q, IMAG(_x)>0);
+    }
 }
 
 /* correlate input sequence                                 */
@@ -185,6 +294,16 @@ void BPRESYNC(_execute)(BPRESYNC() _q,
     float complex rxy0;
     float complex rxy1;
     float dphi_hat = 0.0f;
+
+    // two-stage acquisition: evaluate short prefix correlator first
+    // and abort before the full-length, all-Doppler search when the
+    // output falls below threshold
+    if (_q->prefix_enabled && BPRESYNC(_prefix_rxy)(_q) < _q->prefix_threshold) {
+        *_rxy      = 0.0f;
+        *_dphi_hat = 0.0f;
+        return;
+    }
+
     for (i=0; i<_q->m; i++)  {
 
         BPRESYNC(_correlatex)(_q, i, &rxy0, &rxy1);
@@ -245,3 +364,29 @@ void BPRESYNC(_correlatex)(BPRESYNC()      _q,
     *_rxy1 = (rxy_i1 + rxy_q1 * _Complex_I) * _q->n_inv;
 }
 
+// evaluate short prefix correlator against the zero-offset template
+// tail, returning the larger of the non-conjugated and conjugated
+// output magnitudes; over the short window residual frequency offset
+// rotates the correlation peak far less than over the full sequence,
+// so a single frequency hypothesis suffices for pre-screening
+float BPRESYNC(_prefix_rxy)(BPRESYNC() _q)
+{
+    // compute prefix correlations
+    int rxy_ii = 2*bsequence_correlate(_q->prefix_sync_i, _q->prefix_rx_i) - (int)(_q->n_prefix);
+    int rxy_qq = 2*bsequence_correlate(_q->prefix_sync_q, _q->prefix_rx_q) - (int)(_q->n_prefix);
+    int rxy_iq = 2*bsequence_correlate(_q->prefix_sync_i, _q->prefix_rx_q) - (int)(_q->n_prefix);
+    int rxy_qi = 2*bsequence_correlate(_q->prefix_sync_q, _q->prefix_rx_i) - (int)(_q->n_prefix);
+
+    // non-conjugated
+    int rxy_i0 = rxy_ii - rxy_qq;
+    int rxy_q0 = rxy_iq + rxy_qi;
+    float rxy0 = cabsf(rxy_i0 + rxy_q0 * _Complex_I) * _q->n_prefix_inv;
+
+    // conjugated
+    int rxy_i1 = rxy_ii + rxy_qq;
+    int rxy_q1 = rxy_iq - rxy_qi;
+    float rxy1 = cabsf(rxy_i1 + rxy_q1 * _Complex_I) * _q->n_prefix_inv;
+
+    return rxy0 > rxy1 ? rxy0 : rxy1;
+}
+
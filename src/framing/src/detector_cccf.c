@@ -51,6 +51,10 @@ void detector_cccf_update_sumsq(detector_cccf _q,
 // compute all dot product outputs
 void detector_cccf_compute_dotprods(detector_cccf _q);
 
+// update dual-rate pre-search with new input sample
+void detector_cccf_update_presearch(detector_cccf _q,
+                                    float complex _x);
+
 // estimate carrier and timing offsets
 void detector_cccf_estimate_offsets(detector_cccf _q,
                                     float *       _tau_hat,
@@ -87,6 +91,23 @@ struct detector_cccf_s {
     float x2_sum;           // sum{ |x|^2 }
     float x2_hat;           // estimate of E{|x|^2}
 
+    // dual-rate pre-search: coarse correlation runs on a decimated
+    // input stream and full-rate correlators execute only around
+    // candidate peaks
+    int presearch_enabled;      // pre-search enabled?
+    unsigned int M;             // pre-search decimation factor
+    unsigned int nd;            // decimated sequence length, n/M
+    float nd_inv;               // 1/nd (pre-computed for speed)
+    float presearch_threshold;  // coarse detection threshold
+    firdecim_cccf decim;        // input stream decimator
+    windowcf dbuffer;           // decimated input buffer
+    dotprod_cccf * dpd;         // coarse correlators (pre-spun)
+    float complex * dblock;     // decimator input block [size: M x 1]
+    unsigned int dcount;        // decimator input block counter
+    wdelayf x2d;                // buffer of decimated |x|^2 values
+    float x2d_sum;              // sum{ |xd|^2 }
+    unsigned int armed_timer;   // full-rate correlation armed countdown
+
     // counters/states
     enum {
         DETECTOR_STATE_SEEK=0,  // seek sequence
@@ -167,6 +188,14 @@ detector_cccf detector_cccf_create(float complex * _s,
         q->dp[k] = dotprod_cccf_create(sconj, q->n);
     }
 
+    // dual-rate pre-search disabled by default
+    q->presearch_enabled = 0;
+    q->decim   = NULL;
+    q->dbuffer = NULL;
+    q->dpd     = NULL;
+    q->dblock  = NULL;
+    q->x2d     = NULL;
+
     // reset state
     detector_cccf_reset(q);
 
@@ -203,6 +232,9 @@ void detector_cccf_destroy(detector_cccf _q)
     // destroy |x|^2 buffer
     wdelayf_destroy(_q->x2);
 
+    // destroy pre-search objects
+    detector_cccf_disable_presearch(_q);
+
     // free internal buffers/arrays
     free(_q->s);
 
@@ -236,6 +268,115 @@ void detector_cccf_reset(detector_cccf _q)
     //memset(_q->rxy, 0x00, sizeof(_q->rxy));
     memset(_q->rxy0, 0x00, _q->m*sizeof(float));
     memset(_q->rxy1, 0x00, _q->m*sizeof(float));
+
+    // reset pre-search state
+    if (_q->presearch_enabled) {
+        firdecim_cccf_reset(_q->decim);
+        windowcf_reset(_q->dbuffer);
+        wdelayf_reset(_q->x2d);
+        _q->dcount      = 0;
+        _q->x2d_sum     = 0.0f;
+        _q->armed_timer = 0;
+    }
+}
+
+// enable dual-rate pre-search: the input stream is decimated by _M
+// (through firdecim) and correlated against the identically decimated
+// sequence; the full-rate correlator bank executes only around offsets
+// where the coarse output magnitude meets _threshold, which should sit
+// comfortably below the main detection threshold (e.g. 0.8 of it)
+//  _q          :   pre-demod detector
+//  _M          :   decimation factor (e.g. 4), _n must be divisible by _M
+//  _threshold  :   coarse detection threshold
+void detector_cccf_enable_presearch(detector_cccf _q,
+                                    unsigned int  _M,
+                                    float         _threshold)
+{
+    // validate input
+    if (_M < 2) {
+        fprintf(stderr,"error: detector_cccf_enable_presearch(), decimation factor must be at least 2\n");
+        exit(1);
+    } else if (_q->n % _M != 0 || _q->n / _M < 8) {
+        fprintf(stderr,"error: detector_cccf_enable_presearch(), sequence length must be a multiple of decimation factor (and at least 8 coarse samples)\n");
+        exit(1);
+    } else if (_threshold <= 0.0f) {
+        fprintf(stderr,"error: detector_cccf_enable_presearch(), threshold must be greater than zero\n");
+        exit(1);
+    }
+
+    // discard any previous pre-search objects
+    detector_cccf_disable_presearch(_q);
+
+    _q->M                   = _M;
+    _q->nd                  = _q->n / _M;
+    _q->nd_inv              = 1.0f / (float)(_q->nd);
+    _q->presearch_threshold = _threshold;
+
+    // create input stream decimator and decimated buffers
+    unsigned int m = 2;     // decimation filter semi-length
+    _q->decim   = firdecim_cccf_create_kaiser(_q->M, m, 60.0f);
+    _q->dbuffer = windowcf_create(_q->nd);
+    _q->x2d     = wdelayf_create(_q->nd);
+    _q->dblock  = (float complex*) malloc(_q->M*sizeof(float complex));
+
+    // run the sequence through an identical decimator so the filter
+    // delay matches on both paths and coarse/full peaks coincide
+    unsigned int i, j, k;
+    float complex sd[_q->nd];
+    firdecim_cccf decim_s = firdecim_cccf_create_kaiser(_q->M, m, 60.0f);
+    for (j=0; j<_q->nd; j++)
+        firdecim_cccf_execute(decim_s, &_q->s[j*_q->M], &sd[j]);
+    firdecim_cccf_destroy(decim_s);
+
+    // normalize decimated sequence to unit average energy so coarse
+    // outputs scale like the full-rate ones
+    float e2 = 0.0f;
+    for (j=0; j<_q->nd; j++)
+        e2 += crealf( sd[j]*conjf(sd[j]) );
+    float g = 1.0f / sqrtf(e2 * _q->nd_inv + FLT_EPSILON);
+    for (j=0; j<_q->nd; j++)
+        sd[j] *= g;
+
+    // create coarse correlators, pre-spun at the same frequency
+    // hypotheses as the full-rate bank (coarse sample j is input
+    // sample j*M, hence the M in the mixing exponent)
+    _q->dpd = (dotprod_cccf*) malloc((_q->m)*sizeof(dotprod_cccf));
+    float complex sdconj[_q->nd];
+    for (k=0; k<_q->m; k++) {
+        for (i=0; i<_q->nd; i++)
+            sdconj[i] = conjf(sd[i]) * cexpf(-_Complex_I*_q->dphi[k]*i*_q->M);
+        _q->dpd[k] = dotprod_cccf_create(sdconj, _q->nd);
+    }
+
+    // reset pre-search state
+    _q->presearch_enabled = 1;
+    _q->dcount            = 0;
+    _q->x2d_sum           = 0.0f;
+    _q->armed_timer       = 0;
+}
+
+// disable dual-rate pre-search, reverting to full-rate correlation at
+// every sample offset
+void detector_cccf_disable_presearch(detector_cccf _q)
+{
+    if (!_q->presearch_enabled)
+        return;
+
+    firdecim_cccf_destroy(_q->decim);
+    windowcf_destroy(_q->dbuffer);
+    wdelayf_destroy(_q->x2d);
+    free(_q->dblock);
+    unsigned int k;
+    for (k=0; k<_q->m; k++)
+        dotprod_cccf_destroy(_q->dpd[k]);
+    free(_q->dpd);
+
+    _q->decim   = NULL;
+    _q->dbuffer = NULL;
+    _q->x2d     = NULL;
+    _q->dblock  = NULL;
+    _q->dpd     = NULL;
+    _q->presearch_enabled = 0;
 }
 
 // Run sample through pre-demod detector's correlator.
@@ -257,6 +398,10 @@ int detector_cccf_correlate(detector_cccf _q,
     // update sum{|x|^2}
     detector_cccf_update_sumsq(_q, _x);
 
+    // update coarse (decimated) correlation
+    if (_q->presearch_enabled)
+        detector_cccf_update_presearch(_q, _x);
+
 #if DEBUG_DETECTOR
     windowcf_push(_q->debug_x, _x);
     windowf_push(_q->debug_x2, _q->x2_hat);
@@ -272,6 +417,19 @@ int detector_cccf_correlate(detector_cccf _q,
         return 0;
     }
 
+    // dual-rate pre-search: away from candidate peaks skip the
+    // full-rate correlator bank entirely
+    if (_q->presearch_enabled) {
+        if (_q->state == DETECTOR_STATE_SEEK && _q->armed_timer == 0) {
+#if DEBUG_DETECTOR
+            windowf_push(_q->debug_rxy, 0.0f);
+#endif
+            return 0;
+        }
+        if (_q->armed_timer)
+            _q->armed_timer--;
+    }
+
     // save previous correlator outputs
     memmove(_q->rxy0, _q->rxy1, _q->m*sizeof(float));
     memmove(_q->rxy1, _q->rxy,  _q->m*sizeof(float));
@@ -396,6 +554,60 @@ void detector_cccf_compute_dotprods(detector_cccf _q)
 #endif
 }
 
+// update dual-rate pre-search with new input sample: decimate input
+// stream, correlate against the decimated sequence at every frequency
+// hypothesis, and arm the full-rate correlator bank around offsets
+// where the coarse output meets threshold
+void detector_cccf_update_presearch(detector_cccf _q,
+                                    float complex _x)
+{
+    // collect decimator input block
+    _q->dblock[_q->dcount++] = _x;
+    if (_q->dcount < _q->M)
+        return;
+    _q->dcount = 0;
+
+    // compute decimator output and push into coarse buffer
+    float complex xd;
+    firdecim_cccf_execute(_q->decim, _q->dblock, &xd);
+    windowcf_push(_q->dbuffer, xd);
+
+    // update estimate of decimated signal magnitude
+    float x2_n = crealf(xd * conjf(xd));
+    float x2_0;
+    wdelayf_push(_q->x2d, x2_n);
+    wdelayf_read(_q->x2d, &x2_0);
+    _q->x2d_sum = _q->x2d_sum + x2_n - x2_0;
+    if (_q->x2d_sum < FLT_EPSILON)
+        _q->x2d_sum = FLT_EPSILON;
+
+    // compute coarse correlator outputs
+    float complex * rd;
+    windowcf_read(_q->dbuffer, &rd);
+    float g = _q->nd_inv / sqrtf(_q->x2d_sum * _q->nd_inv);
+    float rxy_max = 0.0f;
+    float complex rxy;
+    unsigned int k;
+    for (k=0; k<_q->m; k++) {
+        dotprod_cccf_execute(_q->dpd[k], rd, &rxy);
+        float rxy_abs = cabsf(rxy) * g;
+        if (rxy_abs > rxy_max)
+            rxy_max = rxy_abs;
+    }
+
+    // candidate peak: arm full-rate correlators long enough to refine
+    // it (coarse timing is quantized to M samples)
+    if (rxy_max > _q->presearch_threshold) {
+        if (_q->armed_timer == 0) {
+            // discard stale full-rate history from last armed window
+            memset(_q->rxy0, 0x00, _q->m*sizeof(float));
+            memset(_q->rxy1, 0x00, _q->m*sizeof(float));
+            memset(_q->rxy,  0x00, _q->m*sizeof(float));
+        }
+        _q->armed_timer = 4*_q->M;
+    }
+}
+
 // estimate carrier and timing offsets
 void detector_cccf_estimate_offsets(detector_cccf _q,
                                     float *       _tau_hat,
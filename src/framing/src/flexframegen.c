@@ -94,6 +94,7 @@ struct flexframegen_s {
     unsigned int    payload_dec_len;    // length of decoded
     qpacketmodem    payload_encoder;    // packet encoder/modulator
     unsigned int    payload_sym_len;    // length of encoded/modulated payload
+    unsigned int    payload_sym_cap;    // allocated size of payload_sym
     float complex * payload_sym;        // encoded payload symbols
 
     // counters/states
@@ -144,7 +145,8 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
     q->payload_encoder = qpacketmodem_create();
     q->payload_dec_len = 64;
     q->payload_sym_len = qpacketmodem_get_frame_len(q->payload_encoder);
-    q->payload_sym     = (float complex *) malloc( q->payload_sym_len*sizeof(float complex));
+    q->payload_sym_cap = q->payload_sym_len;
+    q->payload_sym     = (float complex *) malloc( q->payload_sym_cap*sizeof(float complex));
 
     // set payload properties
     flexframegen_setprops(q, _fgprops);
@@ -336,6 +338,28 @@ int flexframegen_set_header_props(flexframegen          _q,
     return 0;
 }
 
+// pre-allocate internal buffers for payloads up to _len_max bytes so
+// that subsequent calls to assemble() with payloads no longer than the
+// maximum are allocation-free
+void flexframegen_set_payload_len_max(flexframegen _q,
+                                      unsigned int _len_max)
+{
+    // if frame is already assembled, give warning
+    if (_q->frame_assembled) {
+        fprintf(stderr, "warning: flexframegen_set_payload_len_max(), frame is already assembled; must reset() first\n");
+        return;
+    }
+
+    // configure at the maximum length to grow all internal buffers to
+    // their maxima, then restore the current length (buffers never
+    // shrink)
+    unsigned int payload_dec_len = _q->payload_dec_len;
+    _q->payload_dec_len = _len_max;
+    flexframegen_reconfigure(_q);
+    _q->payload_dec_len = payload_dec_len;
+    flexframegen_reconfigure(_q);
+}
+
 // get frame length (number of samples)
 unsigned int flexframegen_getframelen(flexframegen _q)
 {
@@ -457,10 +481,15 @@ void flexframegen_reconfigure(flexframegen _q)
                            _q->props.fec1,
                            _q->props.mod_scheme);
 
-    // re-allocate memory for encoded message
+    // re-allocate memory for encoded message; the buffer grows but
+    // never shrinks so that assembling frames with varying payload
+    // lengths within a previous maximum is allocation-free
     _q->payload_sym_len = qpacketmodem_get_frame_len(_q->payload_encoder);
-    _q->payload_sym = (float complex*) realloc(_q->payload_sym,
-                                               _q->payload_sym_len*sizeof(float complex));
+    if (_q->payload_sym_len > _q->payload_sym_cap) {
+        _q->payload_sym_cap = _q->payload_sym_len;
+        _q->payload_sym = (float complex*) realloc(_q->payload_sym,
+                                                   _q->payload_sym_cap*sizeof(float complex));
+    }
 
     // ensure payload was reallocated appropriately
     if (_q->payload_sym == NULL) {
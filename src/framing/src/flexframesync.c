@@ -32,6 +32,7 @@
 #include <math.h>
 #include <complex.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
@@ -42,6 +43,11 @@
 
 #define FLEXFRAMESYNC_ENABLE_EQ     0
 
+// threaded operation: maximum number of payload decoding workers and
+// depth of the internal job queue
+#define FLEXFRAMESYNC_MAX_THREADS   (4)
+#define FLEXFRAMESYNC_NUM_JOBS      (8)
+
 // push samples through detection stage
 void flexframesync_execute_seekpn(flexframesync _q,
                                   float complex _x);
@@ -69,6 +75,53 @@ void flexframesync_execute_rxheader(flexframesync _q,
 void flexframesync_execute_rxpayload(flexframesync _q,
                                      float complex _x);
 
+// update energy gate with input sample, returning 1 if the sample
+// should be run through the frame detector
+int flexframesync_squelch_step(flexframesync _q,
+                               float complex _x);
+
+// worker pool methods for threaded payload decoding
+void   flexframesync_start_pool  (flexframesync _q, unsigned int _num_threads);
+void   flexframesync_stop_pool   (flexframesync _q);
+void * flexframesync_worker      (void * _arg);
+void   flexframesync_submit_job  (flexframesync _q);
+void   flexframesync_deliver_jobs(flexframesync _q, int _block);
+
+// payload decoding job for threaded operation; sample collection runs
+// on the ingest thread while the demodulation/decoding of each detected
+// frame's payload is handed to a worker, with callbacks invoked in
+// detection order from the ingest thread
+struct flexframesync_job_s {
+    enum {
+        FLEXFRAMESYNC_JOB_FREE=0,       // slot is available
+        FLEXFRAMESYNC_JOB_PENDING,      // queued, waiting for a worker
+        FLEXFRAMESYNC_JOB_RUNNING,      // worker is decoding payload
+        FLEXFRAMESYNC_JOB_DONE,         // decoded, waiting for delivery
+    }               state;              // job state
+
+    // frame configuration (from decoded header)
+    unsigned char * header_dec;         // decoded header (copy)
+    int             header_valid;       // header CRC flag
+    unsigned int    payload_dec_len;    // payload data (length)
+    int             check;              // payload validity check
+    int             fec0;               // payload FEC (inner)
+    int             fec1;               // payload FEC (outer)
+    int             mod_scheme;         // payload modulation scheme
+    int             payload_soft;       // payload performs soft demod
+
+    // payload symbols and decoder output
+    float complex * payload_sym;        // payload symbols (received)
+    unsigned int    payload_sym_len;    // payload symbols (length)
+    unsigned char * payload_dec;        // payload data (bytes)
+    int             payload_valid;      // payload CRC flag
+    framesyncstats_s stats;             // frame statistics snapshot
+
+    // allocated buffer lengths (grow-only)
+    unsigned int    buf_header_len;     // header_dec allocation
+    unsigned int    buf_sym_len;        // payload_sym allocation
+    unsigned int    buf_dec_len;        // payload_dec allocation
+};
+
 static flexframegenprops_s flexframesyncprops_header_default = {
    FLEXFRAME_H_CRC,
    FLEXFRAME_H_FEC0,
@@ -95,6 +148,14 @@ struct flexframesync_s {
     nco_crcf        mixer;              // carrier frequency recovery (coarse)
     nco_crcf        pll;                // carrier frequency recovery (fine)
 
+    // optional energy-gate squelch (detection pre-stage)
+    int             squelch_enabled;    // energy gate enabled?
+    int             squelch_open;       // gate currently open?
+    int             squelch_replay;     // replaying pre-trigger history?
+    agc_crcf        squelch_agc;        // signal level estimate and gate status
+    windowcf        squelch_history;    // pre-trigger sample history
+    unsigned int    squelch_history_len;// history buffer length
+
     // timing recovery objects, states
     firpfb_crcf     mf;                 // matched filter decimator
     unsigned int    npfb;               // number of filters in symsync
@@ -131,8 +192,26 @@ struct flexframesync_s {
     qpacketmodem    payload_decoder;    // payload demodulator/decoder
     unsigned char * payload_dec;        // payload data (bytes)
     unsigned int    payload_dec_len;    // payload data (length)
+    unsigned int    payload_sym_cap;    // payload_sym allocation (high watermark)
+    unsigned int    payload_dec_cap;    // payload_dec allocation (high watermark)
     int             payload_valid;      // payload CRC flag
-    
+
+    // optional zero-copy buffer exchange with the application
+    framesync_buffer_exchange_callback buffer_exchange; // exchange callback
+    void *          buffer_exchange_userdata;           // exchange context
+
+    // worker pool for threaded payload decoding
+    unsigned int    num_threads;        // number of workers (0: serial operation)
+    pthread_t       threads[FLEXFRAMESYNC_MAX_THREADS];
+    pthread_mutex_t job_mutex;          // job queue mutex
+    pthread_cond_t  job_submitted;      // signal: job queued (or pool shutting down)
+    pthread_cond_t  job_completed;      // signal: worker finished a job
+    int             pool_running;       // workers should keep running?
+    struct flexframesync_job_s jobs[FLEXFRAMESYNC_NUM_JOBS]; // job queue (ring)
+    unsigned int    job_head;           // oldest outstanding job (next delivery)
+    unsigned int    job_tail;           // next slot to fill
+    unsigned int    job_count;          // number of outstanding jobs
+
     // status variables
     unsigned int    preamble_counter;   // counter: num of p/n syms received
     unsigned int    symbol_counter;     // counter: num of symbols received
@@ -195,6 +274,17 @@ flexframesync flexframesync_create(framesync_callback _callback,
     q->mixer = nco_crcf_create(LIQUID_NCO);
     q->pll   = nco_crcf_create(LIQUID_NCO);
     nco_crcf_pll_set_bandwidth(q->pll, 1e-4f); // very low bandwidth
+
+    // energy-gate squelch (disabled by default); history buffer covers
+    // the full detector buffer so no preamble samples are lost when the
+    // gate opens
+    q->squelch_enabled     = 0;
+    q->squelch_open        = 0;
+    q->squelch_replay      = 0;
+    q->squelch_history_len = qdetector_cccf_get_buf_len(q->detector);
+    q->squelch_history     = windowcf_create(q->squelch_history_len);
+    q->squelch_agc         = agc_crcf_create();
+    agc_crcf_set_bandwidth(q->squelch_agc, 0.1f); // fast signal level estimate
     
     // header demodulator/decoder
     q->header_sym = NULL;
@@ -224,8 +314,22 @@ flexframesync flexframesync_create(framesync_callback _callback,
     // allocate memory for payload symbols and recovered data bytes
     q->payload_sym = (float complex*) malloc(q->payload_sym_len*sizeof(float complex));
     q->payload_dec = (unsigned char*) malloc(q->payload_dec_len*sizeof(unsigned char));
+    q->payload_sym_cap = q->payload_sym_len;
+    q->payload_dec_cap = q->payload_dec_len;
     q->payload_soft = 0;
 
+    // buffer exchange disabled by default (callback retains buffer ownership)
+    q->buffer_exchange          = NULL;
+    q->buffer_exchange_userdata = NULL;
+
+    // threaded payload decoding disabled by default
+    q->num_threads  = 0;
+    q->pool_running = 0;
+    q->job_head     = 0;
+    q->job_tail     = 0;
+    q->job_count    = 0;
+    memset(q->jobs, 0x00, sizeof(q->jobs));
+
     // reset global data counters
     flexframesync_reset_framedatastats(q);
 
@@ -245,6 +349,18 @@ flexframesync flexframesync_create(framesync_callback _callback,
 // destroy frame synchronizer object, freeing all internal memory
 void flexframesync_destroy(flexframesync _q)
 {
+    // shut down worker pool, delivering any outstanding frames
+    if (_q->num_threads > 0)
+        flexframesync_stop_pool(_q);
+
+    // free payload decoding job buffers
+    unsigned int i;
+    for (i=0; i<FLEXFRAMESYNC_NUM_JOBS; i++) {
+        free(_q->jobs[i].header_dec);
+        free(_q->jobs[i].payload_sym);
+        free(_q->jobs[i].payload_dec);
+    }
+
 #if DEBUG_FLEXFRAMESYNC
     // clean up debug objects (if created)
     if (_q->debug_objects_created)
@@ -266,6 +382,8 @@ void flexframesync_destroy(flexframesync _q)
     modem_destroy         (_q->payload_demod);    // payload demodulator (for PLL)
     qpacketmodem_destroy  (_q->payload_decoder);  // payload demodulator/decoder
     qdetector_cccf_destroy(_q->detector);         // frame detector
+    agc_crcf_destroy      (_q->squelch_agc);      // squelch signal level estimate
+    windowcf_destroy      (_q->squelch_history);  // squelch pre-trigger history
     firpfb_crcf_destroy   (_q->mf);               // matched filter
     nco_crcf_destroy      (_q->mixer);            // oscillator (coarse)
     nco_crcf_destroy      (_q->pll);              // oscillator (fine)
@@ -296,7 +414,10 @@ void flexframesync_reset(flexframesync _q)
 
     // reset symbol timing recovery state
     firpfb_crcf_reset(_q->mf);
-        
+
+    // drop any partially-demodulated payload data
+    qpacketmodem_reset(_q->payload_decoder);
+
     // reset state
     _q->state           = FLEXFRAMESYNC_STATE_DETECTFRAME;
     _q->preamble_counter= 0;
@@ -379,6 +500,40 @@ int flexframesync_set_header_props(flexframesync          _q,
     return 0;
 }
 
+// set carrier frequency offset search range of the internal detector;
+// the detection stage tests shifted template hypotheses against a
+// single transform of the input, so one synchronizer can acquire
+// frames over a wide offset range in place of multiple instances at
+// stepped NCO offsets
+//  _q          :   frame synchronizer object
+//  _dphi_max   :   maximum carrier offset [radians/sample], in [0,pi)
+void flexframesync_set_cfo_range(flexframesync _q,
+                                 float         _dphi_max)
+{
+    qdetector_cccf_set_range(_q->detector, _dphi_max);
+}
+
+// enable energy-gate squelch: skip frame detection (correlation) while
+// the input signal level is below the given threshold
+//  _q          :   frame synchronizer object
+//  _threshold  :   signal level threshold [dB]
+void flexframesync_squelch_enable(flexframesync _q,
+                                  float         _threshold)
+{
+    _q->squelch_enabled = 1;
+    _q->squelch_open    = 0;
+    agc_crcf_squelch_enable(_q->squelch_agc);
+    agc_crcf_squelch_set_threshold(_q->squelch_agc, _threshold);
+    windowcf_reset(_q->squelch_history);
+}
+
+// disable energy-gate squelch
+void flexframesync_squelch_disable(flexframesync _q)
+{
+    _q->squelch_enabled = 0;
+    agc_crcf_squelch_disable(_q->squelch_agc);
+}
+
 // execute frame synchronizer
 //  _q  :   frame synchronizer object
 //  _x  :   input sample array [size: _n x 1]
@@ -391,32 +546,56 @@ void flexframesync_execute(flexframesync   _q,
     for (i=0; i<_n; i++) {
 #if DEBUG_FLEXFRAMESYNC
         // write samples to debug buffer
-        // NOTE: the debug_qdetector_flush prevents samples from being written twice
-        if (_q->debug_enabled && !_q->debug_qdetector_flush)
+        // NOTE: the debug_qdetector_flush and squelch_replay flags
+        //       prevent samples from being written twice
+        if (_q->debug_enabled && !_q->debug_qdetector_flush && !_q->squelch_replay)
             windowcf_push(_q->debug_x, _x[i]);
 #endif
+        // optional energy gate: skip frame detection entirely on dead air
+        if (_q->squelch_enabled && !_q->squelch_replay &&
+            _q->state == FLEXFRAMESYNC_STATE_DETECTFRAME)
+        {
+            if (!flexframesync_squelch_step(_q, _x[i]))
+                continue;
+        }
         switch (_q->state) {
-        case FLEXFRAMESYNC_STATE_DETECTFRAME:
+        case FLEXFRAMESYNC_STATE_DETECTFRAME: {
             // detect frame (look for p/n sequence)
+            LIQUID_PROFILE_BEGIN(FLEXFRAMESYNC_SEEKPN);
             flexframesync_execute_seekpn(_q, _x[i]);
+            LIQUID_PROFILE_END(FLEXFRAMESYNC_SEEKPN);
             break;
-        case FLEXFRAMESYNC_STATE_RXPREAMBLE:
+        }
+        case FLEXFRAMESYNC_STATE_RXPREAMBLE: {
             // receive p/n sequence symbols
+            LIQUID_PROFILE_BEGIN(FLEXFRAMESYNC_RXPREAMBLE);
             flexframesync_execute_rxpreamble(_q, _x[i]);
+            LIQUID_PROFILE_END(FLEXFRAMESYNC_RXPREAMBLE);
             break;
-        case FLEXFRAMESYNC_STATE_RXHEADER:
+        }
+        case FLEXFRAMESYNC_STATE_RXHEADER: {
             // receive header symbols
+            LIQUID_PROFILE_BEGIN(FLEXFRAMESYNC_RXHEADER);
             flexframesync_execute_rxheader(_q, _x[i]);
+            LIQUID_PROFILE_END(FLEXFRAMESYNC_RXHEADER);
             break;
-        case FLEXFRAMESYNC_STATE_RXPAYLOAD:
+        }
+        case FLEXFRAMESYNC_STATE_RXPAYLOAD: {
             // receive payload symbols
+            LIQUID_PROFILE_BEGIN(FLEXFRAMESYNC_RXPAYLOAD);
             flexframesync_execute_rxpayload(_q, _x[i]);
+            LIQUID_PROFILE_END(FLEXFRAMESYNC_RXPAYLOAD);
             break;
+        }
         default:
             fprintf(stderr,"error: flexframesync_exeucte(), unknown/unsupported state\n");
             exit(1);
         }
     }
+
+    // threaded operation: deliver completed frames in detection order
+    if (_q->num_threads > 0)
+        flexframesync_deliver_jobs(_q, 0);
 }
 
 // 
@@ -479,6 +658,48 @@ void flexframesync_execute_seekpn(flexframesync _q,
 #endif
 }
 
+// step receiver mixer, matched filter, decimator
+//  _q      :   frame synchronizer
+//  _x      :   input sample
+//  _y      :   output symbol
+// update energy gate with input sample, returning 1 if the sample
+// should be run through the frame detector
+//  _q      :   frame synchronizer object
+//  _x      :   input sample
+int flexframesync_squelch_step(flexframesync _q,
+                               float complex _x)
+{
+    // update signal level estimate and squelch status
+    float complex v;
+    agc_crcf_execute(_q->squelch_agc, _x, &v);
+    int status = agc_crcf_squelch_get_status(_q->squelch_agc);
+
+    if (_q->squelch_open) {
+        // close the gate once the signal has been low for the timeout
+        if (status == LIQUID_AGC_SQUELCH_TIMEOUT)
+            _q->squelch_open = 0;
+        else
+            return 1;
+    }
+
+    if (status == LIQUID_AGC_SQUELCH_RISE) {
+        // gate opens: replay pre-trigger history through the detector so
+        // no preamble samples are lost, then process current sample
+        _q->squelch_open   = 1;
+        _q->squelch_replay = 1;
+        float complex * r;
+        windowcf_read(_q->squelch_history, &r);
+        flexframesync_execute(_q, r, _q->squelch_history_len);
+        _q->squelch_replay = 0;
+        windowcf_reset(_q->squelch_history);
+        return 1;
+    }
+
+    // gate closed: record sample in pre-trigger history only
+    windowcf_push(_q->squelch_history, _x);
+    return 0;
+}
+
 // step receiver mixer, matched filter, decimator
 //  _q      :   frame synchronizer
 //  _x      :   input sample
@@ -593,6 +814,11 @@ void flexframesync_execute_rxheader(flexframesync _q,
                 return;
             }
 
+            // threaded operation: deliver outstanding frames first so
+            // the callback below is invoked in detection order
+            if (_q->num_threads > 0)
+                flexframesync_deliver_jobs(_q, 1);
+
             // update statistics
             _q->framedatastats.num_frames_detected++;
 
@@ -709,9 +935,16 @@ void flexframesync_decode_header(flexframesync _q)
     // set length appropriately
     _q->payload_sym_len = qpacketmodem_get_frame_len(_q->payload_decoder);
 
-    // re-allocate buffers accordingly
-    _q->payload_sym = (float complex*) realloc(_q->payload_sym, (_q->payload_sym_len)*sizeof(float complex));
-    _q->payload_dec = (unsigned char*) realloc(_q->payload_dec, (_q->payload_dec_len)*sizeof(unsigned char));
+    // re-allocate buffers as needed, retaining the high-watermark
+    // allocation so frames of similar size do not realloc every time
+    if (_q->payload_sym_len > _q->payload_sym_cap) {
+        _q->payload_sym     = (float complex*) realloc(_q->payload_sym, (_q->payload_sym_len)*sizeof(float complex));
+        _q->payload_sym_cap = _q->payload_sym_len;
+    }
+    if (_q->payload_dec_len > _q->payload_dec_cap) {
+        _q->payload_dec     = (unsigned char*) realloc(_q->payload_dec, (_q->payload_dec_len)*sizeof(unsigned char));
+        _q->payload_dec_cap = _q->payload_dec_len;
+    }
 
     if (_q->payload_sym == NULL || _q->payload_dec == NULL) {
         fprintf(stderr,"error: flexframesync_decode_header(), could not re-allocate payload arrays\n");
@@ -766,19 +999,38 @@ void flexframesync_execute_rxpayload(flexframesync _q,
         // save payload symbols (modem input/output)
         _q->payload_sym[_q->symbol_counter] = mf_out;
 
+        // serial operation: demodulate incrementally into the decoder so
+        // only the final FEC decode remains at frame end, smoothing the
+        // per-sample load (threaded operation hands the full symbol
+        // buffer to a worker instead)
+        if (_q->num_threads == 0) {
+            if (_q->payload_soft)
+                qpacketmodem_decode_soft_sym(_q->payload_decoder, mf_out);
+            else
+                qpacketmodem_decode_sym(_q->payload_decoder, mf_out);
+        }
+
         // increment counter
         _q->symbol_counter++;
 
         if (_q->symbol_counter == _q->payload_sym_len) {
-            // decode payload
+            // threaded operation: hand payload off to the worker pool;
+            // statistics are updated and the callback invoked (in
+            // detection order) when the frame is delivered
+            if (_q->num_threads > 0) {
+                flexframesync_submit_job(_q);
+                flexframesync_reset(_q);
+                return;
+            }
+
+            // decode payload; symbols were demodulated as they arrived
+            // so only the packet decoder runs here
             if (_q->payload_soft) {
-                _q->payload_valid = qpacketmodem_decode_soft(_q->payload_decoder,
-                                                             _q->payload_sym,
-                                                             _q->payload_dec);
+                _q->payload_valid = qpacketmodem_decode_soft_payload(_q->payload_decoder,
+                                                                     _q->payload_dec);
             } else {
-                _q->payload_valid = qpacketmodem_decode(_q->payload_decoder,
-                                                        _q->payload_sym,
-                                                        _q->payload_dec);
+                _q->payload_valid = qpacketmodem_decode_payload(_q->payload_decoder,
+                                                                _q->payload_dec);
             }
 
             // update statistics
@@ -812,6 +1064,19 @@ void flexframesync_execute_rxpayload(flexframesync _q,
                              _q->userdata);
             }
 
+            // zero-copy hand-off: the application keeps the filled
+            // payload buffer and provides a replacement
+            if (_q->buffer_exchange != NULL) {
+                _q->payload_dec = _q->buffer_exchange(_q->payload_dec,
+                                                      _q->payload_dec_len,
+                                                      _q->buffer_exchange_userdata);
+                if (_q->payload_dec == NULL) {
+                    fprintf(stderr,"error: flexframesync, buffer exchange returned NULL\n");
+                    exit(1);
+                }
+                _q->payload_dec_cap = _q->payload_dec_len;
+            }
+
             // reset frame synchronizer
             flexframesync_reset(_q);
             return;
@@ -831,6 +1096,265 @@ framedatastats_s flexframesync_get_framedatastats(flexframesync _q)
     return _q->framedatastats;
 }
 
+// set number of internal payload decoding threads (0: serial operation);
+// any outstanding frames are delivered before the worker count changes
+void flexframesync_set_threads(flexframesync _q,
+                               unsigned int  _num_threads)
+{
+    // cap number of workers
+    if (_num_threads > FLEXFRAMESYNC_MAX_THREADS)
+        _num_threads = FLEXFRAMESYNC_MAX_THREADS;
+
+    // return if number of workers has not changed
+    if (_num_threads == _q->num_threads)
+        return;
+
+    // stop existing worker pool, delivering outstanding frames
+    if (_q->num_threads > 0)
+        flexframesync_stop_pool(_q);
+
+    // start new worker pool
+    if (_num_threads > 0)
+        flexframesync_start_pool(_q, _num_threads);
+}
+
+// set optional buffer-exchange callback for zero-copy payload delivery;
+// after the frame callback returns, ownership of the filled payload
+// buffer transfers to the application, which must return a fresh
+// buffer (allocated with malloc(), at least _payload_len bytes) for the
+// synchronizer to fill next
+void flexframesync_set_buffer_exchange(flexframesync                      _q,
+                                       framesync_buffer_exchange_callback _exchange,
+                                       void *                             _userdata)
+{
+    _q->buffer_exchange          = _exchange;
+    _q->buffer_exchange_userdata = _userdata;
+}
+
+// start worker pool for threaded payload decoding
+void flexframesync_start_pool(flexframesync _q,
+                              unsigned int  _num_threads)
+{
+    pthread_mutex_init(&_q->job_mutex,     NULL);
+    pthread_cond_init (&_q->job_submitted, NULL);
+    pthread_cond_init (&_q->job_completed, NULL);
+    _q->pool_running = 1;
+    _q->num_threads  = _num_threads;
+
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++)
+        pthread_create(&_q->threads[i], NULL, flexframesync_worker, (void*)_q);
+}
+
+// stop worker pool, delivering any outstanding frames first
+void flexframesync_stop_pool(flexframesync _q)
+{
+    // deliver outstanding frames before shutting workers down
+    flexframesync_deliver_jobs(_q, 1);
+
+    // clear running flag and wake all workers
+    pthread_mutex_lock(&_q->job_mutex);
+    _q->pool_running = 0;
+    pthread_cond_broadcast(&_q->job_submitted);
+    pthread_mutex_unlock(&_q->job_mutex);
+
+    // wait for workers to exit
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++)
+        pthread_join(_q->threads[i], NULL);
+    _q->num_threads = 0;
+
+    pthread_mutex_destroy(&_q->job_mutex);
+    pthread_cond_destroy (&_q->job_submitted);
+    pthread_cond_destroy (&_q->job_completed);
+}
+
+// payload decoding worker; each worker owns its own qpacketmodem object
+// and pulls the oldest pending job from the queue
+void * flexframesync_worker(void * _arg)
+{
+    flexframesync _q = (flexframesync) _arg;
+    qpacketmodem decoder = qpacketmodem_create();
+
+    pthread_mutex_lock(&_q->job_mutex);
+    while (1) {
+        // find oldest pending job in the queue
+        struct flexframesync_job_s * job = NULL;
+        unsigned int i;
+        for (i=0; i<_q->job_count; i++) {
+            struct flexframesync_job_s * j =
+                &_q->jobs[(_q->job_head + i) % FLEXFRAMESYNC_NUM_JOBS];
+            if (j->state == FLEXFRAMESYNC_JOB_PENDING) {
+                job = j;
+                break;
+            }
+        }
+
+        // no work available: wait for a submission (or exit on shutdown)
+        if (job == NULL) {
+            if (!_q->pool_running)
+                break;
+            pthread_cond_wait(&_q->job_submitted, &_q->job_mutex);
+            continue;
+        }
+
+        // claim job and decode payload outside the lock
+        job->state = FLEXFRAMESYNC_JOB_RUNNING;
+        pthread_mutex_unlock(&_q->job_mutex);
+
+        qpacketmodem_configure(decoder,
+                               job->payload_dec_len,
+                               job->check,
+                               job->fec0,
+                               job->fec1,
+                               job->mod_scheme);
+        if (job->payload_soft) {
+            job->payload_valid = qpacketmodem_decode_soft(decoder,
+                                                          job->payload_sym,
+                                                          job->payload_dec);
+        } else {
+            job->payload_valid = qpacketmodem_decode(decoder,
+                                                     job->payload_sym,
+                                                     job->payload_dec);
+        }
+
+        // mark job complete and notify the ingest thread
+        pthread_mutex_lock(&_q->job_mutex);
+        job->state = FLEXFRAMESYNC_JOB_DONE;
+        pthread_cond_signal(&_q->job_completed);
+    }
+    pthread_mutex_unlock(&_q->job_mutex);
+
+    qpacketmodem_destroy(decoder);
+    return NULL;
+}
+
+// copy frame state into the next job slot and wake a worker; called from
+// the ingest thread once all payload symbols have been collected
+void flexframesync_submit_job(flexframesync _q)
+{
+    // make room in the queue, delivering completed frames; if the queue
+    // is still full (workers lagging) block until it has drained
+    flexframesync_deliver_jobs(_q, 0);
+    if (_q->job_count == FLEXFRAMESYNC_NUM_JOBS)
+        flexframesync_deliver_jobs(_q, 1);
+
+    // claim next slot; workers ignore it until it is marked pending
+    struct flexframesync_job_s * job = &_q->jobs[_q->job_tail];
+
+    // grow internal buffers as needed
+    if (_q->header_dec_len > job->buf_header_len) {
+        job->header_dec = (unsigned char*) realloc(job->header_dec, _q->header_dec_len*sizeof(unsigned char));
+        job->buf_header_len = _q->header_dec_len;
+    }
+    if (_q->payload_sym_len > job->buf_sym_len) {
+        job->payload_sym = (float complex*) realloc(job->payload_sym, _q->payload_sym_len*sizeof(float complex));
+        job->buf_sym_len = _q->payload_sym_len;
+    }
+    if (_q->payload_dec_len > job->buf_dec_len) {
+        job->payload_dec = (unsigned char*) realloc(job->payload_dec, _q->payload_dec_len*sizeof(unsigned char));
+        job->buf_dec_len = _q->payload_dec_len;
+    }
+    if (job->header_dec == NULL || job->payload_sym == NULL || job->payload_dec == NULL) {
+        fprintf(stderr,"error: flexframesync_submit_job(), could not re-allocate job arrays\n");
+        exit(1);
+    }
+
+    // copy frame configuration and received payload symbols
+    memmove(job->header_dec,  _q->header_dec,  _q->header_dec_len *sizeof(unsigned char));
+    memmove(job->payload_sym, _q->payload_sym, _q->payload_sym_len*sizeof(float complex));
+    job->header_valid    = _q->header_valid;
+    job->payload_sym_len = _q->payload_sym_len;
+    job->payload_dec_len = _q->payload_dec_len;
+    job->payload_soft    = _q->payload_soft;
+    job->check           = qpacketmodem_get_crc      (_q->payload_decoder);
+    job->fec0            = qpacketmodem_get_fec0     (_q->payload_decoder);
+    job->fec1            = qpacketmodem_get_fec1     (_q->payload_decoder);
+    job->mod_scheme      = qpacketmodem_get_modscheme(_q->payload_decoder);
+
+    // snapshot frame statistics before the synchronizer is reset
+    job->stats            = _q->framesyncstats;
+    job->stats.evm        = 10*log10f(_q->framesyncstats.evm / (float)_q->payload_sym_len);
+    job->stats.rssi       = 20*log10f(_q->gamma_hat);
+    job->stats.cfo        = nco_crcf_get_frequency(_q->mixer);
+    job->stats.mod_scheme = job->mod_scheme;
+    job->stats.mod_bps    = modulation_types[job->mod_scheme].bps;
+    job->stats.check      = job->check;
+    job->stats.fec0       = job->fec0;
+    job->stats.fec1       = job->fec1;
+
+    // mark job as pending and wake a worker
+    pthread_mutex_lock(&_q->job_mutex);
+    job->state   = FLEXFRAMESYNC_JOB_PENDING;
+    _q->job_tail = (_q->job_tail + 1) % FLEXFRAMESYNC_NUM_JOBS;
+    _q->job_count++;
+    pthread_cond_signal(&_q->job_submitted);
+    pthread_mutex_unlock(&_q->job_mutex);
+}
+
+// update statistics and invoke callbacks for completed jobs at the head
+// of the queue, preserving detection order
+//  _q      :   frame synchronizer object
+//  _block  :   wait until all outstanding jobs have been delivered?
+void flexframesync_deliver_jobs(flexframesync _q,
+                                int           _block)
+{
+    pthread_mutex_lock(&_q->job_mutex);
+    while (_q->job_count > 0) {
+        struct flexframesync_job_s * job = &_q->jobs[_q->job_head];
+
+        // oldest job still in flight: wait for a worker or stop early
+        if (job->state != FLEXFRAMESYNC_JOB_DONE) {
+            if (!_block)
+                break;
+            pthread_cond_wait(&_q->job_completed, &_q->job_mutex);
+            continue;
+        }
+
+        // release lock while delivering; workers never touch completed jobs
+        pthread_mutex_unlock(&_q->job_mutex);
+
+        // update statistics
+        _q->framedatastats.num_frames_detected++;
+        _q->framedatastats.num_headers_valid++;
+        _q->framedatastats.num_payloads_valid += job->payload_valid;
+        _q->framedatastats.num_bytes_received += job->payload_dec_len;
+
+        // invoke callback
+        if (_q->callback != NULL) {
+            job->stats.framesyms     = job->payload_sym;
+            job->stats.num_framesyms = job->payload_sym_len;
+            _q->callback(job->header_dec,
+                         job->header_valid,
+                         job->payload_dec,
+                         job->payload_dec_len,
+                         job->payload_valid,
+                         job->stats,
+                         _q->userdata);
+        }
+
+        // zero-copy hand-off: the application keeps the filled payload
+        // buffer and provides a replacement for this job slot
+        if (_q->buffer_exchange != NULL) {
+            job->payload_dec = _q->buffer_exchange(job->payload_dec,
+                                                   job->payload_dec_len,
+                                                   _q->buffer_exchange_userdata);
+            if (job->payload_dec == NULL) {
+                fprintf(stderr,"error: flexframesync, buffer exchange returned NULL\n");
+                exit(1);
+            }
+            job->buf_dec_len = job->payload_dec_len;
+        }
+
+        // free slot and advance queue head
+        pthread_mutex_lock(&_q->job_mutex);
+        job->state   = FLEXFRAMESYNC_JOB_FREE;
+        _q->job_head = (_q->job_head + 1) % FLEXFRAMESYNC_NUM_JOBS;
+        _q->job_count--;
+    }
+    pthread_mutex_unlock(&_q->job_mutex);
+}
+
 // enable debugging
 void flexframesync_debug_enable(flexframesync _q)
 {
@@ -31,6 +31,7 @@
 #include <string.h>
 #include <math.h>
 #include <complex.h>
+#include <stdatomic.h>
 
 #include "liquid.internal.h"
 
@@ -65,3 +66,208 @@ void framedatastats_print(framedatastats_s * _stats)
     printf("  bytes received    : %lu\n", _stats->num_bytes_received);
 }
 
+//
+// framedatastats_acc : lock-free multi-threaded accumulator
+//
+
+// per-thread counter slot; each updating thread touches only its own
+// slot with relaxed atomic increments, so slots never contend and no
+// mutex is needed on the frame path. The slot is padded to a cache
+// line to keep threads from false-sharing neighbors' counters.
+struct framedatastats_slot_s {
+    atomic_uint  num_frames_detected;
+    atomic_uint  num_headers_valid;
+    atomic_uint  num_payloads_valid;
+    atomic_ulong num_bytes_received;
+    atomic_ulong latency_hist[LIQUID_FRAMEDATASTATS_HIST];
+    char         pad[64];
+};
+
+struct framedatastats_acc_s {
+    unsigned int num_threads;                   // number of counter slots
+    struct framedatastats_slot_s * slots;       // per-thread counters [size: num_threads x 1]
+};
+
+// create accumulator with a counter slot for each of _num_threads threads
+framedatastats_acc framedatastats_acc_create(unsigned int _num_threads)
+{
+    // validate input
+    if (_num_threads == 0) {
+        fprintf(stderr,"error: framedatastats_acc_create(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+
+    framedatastats_acc q = (framedatastats_acc) malloc(sizeof(struct framedatastats_acc_s));
+    q->num_threads = _num_threads;
+    q->slots = (struct framedatastats_slot_s *)
+        malloc(q->num_threads*sizeof(struct framedatastats_slot_s));
+
+    framedatastats_acc_reset(q);
+    return q;
+}
+
+// destroy accumulator object
+void framedatastats_acc_destroy(framedatastats_acc _q)
+{
+    free(_q->slots);
+    free(_q);
+}
+
+// reset all per-thread counters and the latency histogram
+void framedatastats_acc_reset(framedatastats_acc _q)
+{
+    unsigned int i;
+    unsigned int b;
+    for (i=0; i<_q->num_threads; i++) {
+        struct framedatastats_slot_s * s = &_q->slots[i];
+        atomic_store(&s->num_frames_detected, 0);
+        atomic_store(&s->num_headers_valid,   0);
+        atomic_store(&s->num_payloads_valid,  0);
+        atomic_store(&s->num_bytes_received,  0);
+        for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++)
+            atomic_store(&s->latency_hist[b], 0);
+    }
+}
+
+// map latency [seconds] to histogram bucket: bucket i spans
+// [2^i, 2^(i+1)) microseconds, clamped at either end
+static unsigned int framedatastats_acc_bucket(float _latency)
+{
+    float us = _latency * 1e6f;
+    if (us < 2.0f)
+        return 0;
+    unsigned int b = (unsigned int) log2f(us);
+    return b >= LIQUID_FRAMEDATASTATS_HIST ? LIQUID_FRAMEDATASTATS_HIST-1 : b;
+}
+
+// lower edge of latency histogram bucket [seconds]
+float framedatastats_acc_histogram_edge(unsigned int _bucket)
+{
+    // validate input
+    if (_bucket >= LIQUID_FRAMEDATASTATS_HIST) {
+        fprintf(stderr,"error: framedatastats_acc_histogram_edge(), bucket exceeds histogram size\n");
+        exit(1);
+    }
+
+    return ldexpf(1e-6f, _bucket);
+}
+
+// record a received frame from a particular thread (lock-free)
+void framedatastats_acc_update(framedatastats_acc _q,
+                               unsigned int       _thread,
+                               int                _header_valid,
+                               int                _payload_valid,
+                               unsigned int       _num_bytes,
+                               float              _latency)
+{
+    // validate input
+    if (_thread >= _q->num_threads) {
+        fprintf(stderr,"error: framedatastats_acc_update(), thread index exceeds number of slots\n");
+        exit(1);
+    }
+
+    // relaxed increments: only this thread writes this slot; queries
+    // merge with acquire loads
+    struct framedatastats_slot_s * s = &_q->slots[_thread];
+    atomic_fetch_add_explicit(&s->num_frames_detected, 1, memory_order_relaxed);
+    if (_header_valid)
+        atomic_fetch_add_explicit(&s->num_headers_valid, 1, memory_order_relaxed);
+    if (_payload_valid) {
+        atomic_fetch_add_explicit(&s->num_payloads_valid, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&s->num_bytes_received, _num_bytes, memory_order_relaxed);
+    }
+    if (_latency >= 0.0f) {
+        unsigned int b = framedatastats_acc_bucket(_latency);
+        atomic_fetch_add_explicit(&s->latency_hist[b], 1, memory_order_relaxed);
+    }
+}
+
+// merge counters across all threads into an aggregate view
+framedatastats_s framedatastats_acc_get(framedatastats_acc _q)
+{
+    framedatastats_s stats;
+    framedatastats_reset(&stats);
+
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++) {
+        struct framedatastats_slot_s * s = &_q->slots[i];
+        stats.num_frames_detected += atomic_load_explicit(&s->num_frames_detected, memory_order_acquire);
+        stats.num_headers_valid   += atomic_load_explicit(&s->num_headers_valid,   memory_order_acquire);
+        stats.num_payloads_valid  += atomic_load_explicit(&s->num_payloads_valid,  memory_order_acquire);
+        stats.num_bytes_received  += atomic_load_explicit(&s->num_bytes_received,  memory_order_acquire);
+    }
+    return stats;
+}
+
+// merge latency histogram counts across all threads
+void framedatastats_acc_get_histogram(framedatastats_acc  _q,
+                                      unsigned long int * _counts)
+{
+    unsigned int i;
+    unsigned int b;
+    for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++)
+        _counts[b] = 0;
+    for (i=0; i<_q->num_threads; i++) {
+        struct framedatastats_slot_s * s = &_q->slots[i];
+        for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++)
+            _counts[b] += atomic_load_explicit(&s->latency_hist[b], memory_order_acquire);
+    }
+}
+
+// estimate latency percentile from histogram
+float framedatastats_acc_get_latency(framedatastats_acc _q,
+                                     float              _percentile)
+{
+    // validate input
+    if (_percentile < 0.0f || _percentile > 1.0f) {
+        fprintf(stderr,"error: framedatastats_acc_get_latency(), percentile must be in [0,1]\n");
+        exit(1);
+    }
+
+    unsigned long int counts[LIQUID_FRAMEDATASTATS_HIST];
+    framedatastats_acc_get_histogram(_q, counts);
+
+    unsigned long int total = 0;
+    unsigned int b;
+    for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++)
+        total += counts[b];
+    if (total == 0)
+        return 0.0f;
+
+    // first bucket where the cumulative count reaches the requested
+    // quantile; report its upper edge
+    unsigned long int target = (unsigned long int) ceilf(_percentile * (float)total);
+    unsigned long int cumulative = 0;
+    for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++) {
+        cumulative += counts[b];
+        if (cumulative >= target)
+            break;
+    }
+    b = b >= LIQUID_FRAMEDATASTATS_HIST ? LIQUID_FRAMEDATASTATS_HIST-1 : b;
+    return ldexpf(1e-6f, b+1);
+}
+
+// print merged statistics and latency percentiles
+void framedatastats_acc_print(framedatastats_acc _q)
+{
+    framedatastats_s stats = framedatastats_acc_get(_q);
+    printf("framedatastats_acc [%u thread%s]:\n",
+            _q->num_threads, _q->num_threads == 1 ? "" : "s");
+    framedatastats_print(&stats);
+
+    unsigned long int counts[LIQUID_FRAMEDATASTATS_HIST];
+    framedatastats_acc_get_histogram(_q, counts);
+    unsigned long int total = 0;
+    unsigned int b;
+    for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++)
+        total += counts[b];
+    if (total == 0) {
+        printf("  latency           : no samples recorded\n");
+        return;
+    }
+
+    printf("  latency (50%%)     : %12.3e s\n", framedatastats_acc_get_latency(_q, 0.50f));
+    printf("  latency (90%%)     : %12.3e s\n", framedatastats_acc_get_latency(_q, 0.90f));
+    printf("  latency (99%%)     : %12.3e s\n", framedatastats_acc_get_latency(_q, 0.99f));
+}
+
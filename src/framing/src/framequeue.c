@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// framequeue : asynchronous frame callback queue
+//
+// Decouples frame synchronization from application processing:
+// installing framequeue_callback() as a synchronizer's callback
+// deposits (header, payload, stats) records into a bounded lock-free
+// queue instead of running application code inside _execute(), so a
+// slow handler no longer stalls sample processing.  The application
+// drains the queue from another thread with its own callback.  The
+// queue supports multiple producers (several synchronizers feeding one
+// queue) and a single consumer; records are deep copies, so queued
+// frames remain valid after the synchronizer moves on
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "liquid.internal.h"
+
+// queued frame record; slot sequence numbers implement a bounded
+// multi-producer queue: a slot is free for position p when seq == p,
+// and holds a readable record when seq == p+1
+struct framequeue_slot_s {
+    atomic_ulong     seq;           // slot sequence number
+    unsigned char *  header;        // copied header, [size: header_len x 1]
+    int              header_valid;  // is header valid?
+    unsigned char *  payload;       // copied payload, [size: payload_len x 1]
+    unsigned int     payload_len;   // payload length (bytes)
+    int              payload_valid; // is payload valid?
+    framesyncstats_s stats;         // frame statistics (framesyms copied)
+};
+
+struct framequeue_s {
+    unsigned int capacity;          // maximum number of queued records
+    unsigned int header_len;        // header length (bytes)
+    int          policy;            // backpressure policy
+
+    struct framequeue_slot_s * slots;   // ring of records
+
+    atomic_ulong      tail;         // producer position
+    atomic_ulong      head;         // consumer position (single consumer)
+    atomic_ulong      num_dropped;  // frames dropped on overflow
+};
+
+// create frame callback queue
+//  _capacity   : maximum number of queued frames, _capacity > 0
+//  _header_len : header length of the feeding synchronizer(s) (bytes)
+//  _policy     : backpressure policy when the queue is full
+//                (e.g. LIQUID_FRAMEQUEUE_DROP)
+framequeue framequeue_create(unsigned int _capacity,
+                             unsigned int _header_len,
+                             int          _policy)
+{
+    // validate input
+    if (_capacity == 0) {
+        fprintf(stderr,"error: framequeue_create(), capacity must be greater than zero\n");
+        exit(1);
+    } else if (_policy != LIQUID_FRAMEQUEUE_DROP &&
+               _policy != LIQUID_FRAMEQUEUE_BLOCK) {
+        fprintf(stderr,"error: framequeue_create(), invalid backpressure policy\n");
+        exit(1);
+    }
+
+    // create object and initialize
+    framequeue q = (framequeue) malloc(sizeof(struct framequeue_s));
+    q->capacity   = _capacity;
+    q->header_len = _header_len;
+    q->policy     = _policy;
+
+    // allocate slot ring; slot i is initially free for position i
+    q->slots = (struct framequeue_slot_s*) malloc(
+            q->capacity*sizeof(struct framequeue_slot_s));
+    unsigned int i;
+    for (i=0; i<q->capacity; i++) {
+        atomic_init(&q->slots[i].seq, i);
+        q->slots[i].header  = NULL;
+        q->slots[i].payload = NULL;
+    }
+
+    atomic_init(&q->tail,        0);
+    atomic_init(&q->head,        0);
+    atomic_init(&q->num_dropped, 0);
+    return q;
+}
+
+// free a consumed slot's record buffers
+static void framequeue_slot_free(struct framequeue_slot_s * _s)
+{
+    free(_s->header);
+    free(_s->payload);
+    free(_s->stats.framesyms);
+    _s->header  = NULL;
+    _s->payload = NULL;
+}
+
+// destroy frame callback queue, freeing any records still pending
+void framequeue_destroy(framequeue _q)
+{
+    framequeue_reset(_q);
+    free(_q->slots);
+    free(_q);
+}
+
+// discard all pending records without invoking a callback; consumer
+// context only (must not run concurrently with another drain)
+void framequeue_reset(framequeue _q)
+{
+    unsigned long pos = atomic_load_explicit(&_q->head, memory_order_relaxed);
+    while (1) {
+        struct framequeue_slot_s * s = &_q->slots[pos % _q->capacity];
+        unsigned long seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if ((long)(seq - (pos+1)) < 0)
+            break;
+        framequeue_slot_free(s);
+        atomic_store_explicit(&s->seq, pos + _q->capacity, memory_order_release);
+        pos++;
+    }
+    atomic_store_explicit(&_q->head, pos, memory_order_relaxed);
+}
+
+// print frame callback queue internals
+void framequeue_print(framequeue _q)
+{
+    printf("framequeue: [capacity %u, pending %u, dropped %lu, policy %s]\n",
+            _q->capacity,
+            framequeue_get_size(_q),
+            (unsigned long) atomic_load_explicit(&_q->num_dropped, memory_order_relaxed),
+            _q->policy == LIQUID_FRAMEQUEUE_DROP ? "drop" : "block");
+}
+
+// producer-side callback: install as a frame synchronizer's callback
+// with the framequeue object as the userdata pointer; copies the frame
+// record into the queue and returns immediately
+int framequeue_callback(unsigned char *  _header,
+                        int              _header_valid,
+                        unsigned char *  _payload,
+                        unsigned int     _payload_len,
+                        int              _payload_valid,
+                        framesyncstats_s _stats,
+                        void *           _userdata)
+{
+    framequeue q = (framequeue) _userdata;
+
+    // claim a slot position; a slot is free when its sequence number
+    // matches the claimed position
+    unsigned long pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    struct framequeue_slot_s * s;
+    while (1) {
+        s = &q->slots[pos % q->capacity];
+        unsigned long seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+        long dif = (long)(seq - pos);
+        if (dif == 0) {
+            // slot free: try to claim position (failure reloads pos)
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos+1,
+                        memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (dif < 0) {
+            // queue full: apply backpressure policy
+            if (q->policy == LIQUID_FRAMEQUEUE_DROP) {
+                atomic_fetch_add_explicit(&q->num_dropped, 1, memory_order_relaxed);
+                return 0;
+            }
+            // block: wait for the consumer to release a slot
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        } else {
+            // another producer claimed this position; reload
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+
+    // deep-copy the record; buffers passed to the callback are only
+    // valid for the duration of the call
+    s->header = NULL;
+    if (_header != NULL && q->header_len > 0) {
+        s->header = (unsigned char*) malloc(q->header_len);
+        memmove(s->header, _header, q->header_len);
+    }
+    s->header_valid = _header_valid;
+
+    s->payload = NULL;
+    if (_payload != NULL && _payload_len > 0) {
+        s->payload = (unsigned char*) malloc(_payload_len);
+        memmove(s->payload, _payload, _payload_len);
+    }
+    s->payload_len   = _payload_len;
+    s->payload_valid = _payload_valid;
+
+    s->stats = _stats;
+    s->stats.framesyms = NULL;
+    if (_stats.framesyms != NULL && _stats.num_framesyms > 0) {
+        s->stats.framesyms = (liquid_float_complex*) malloc(
+                _stats.num_framesyms*sizeof(liquid_float_complex));
+        memmove(s->stats.framesyms, _stats.framesyms,
+                _stats.num_framesyms*sizeof(liquid_float_complex));
+    }
+
+    // publish the record
+    atomic_store_explicit(&s->seq, pos+1, memory_order_release);
+    return 0;
+}
+
+// pop a single pending record, invoking the application callback;
+// returns 1 if a record was consumed, 0 if the queue was empty;
+// single consumer only
+//  _q        : frame callback queue
+//  _callback : application frame callback
+//  _userdata : application userdata pointer
+int framequeue_pop(framequeue         _q,
+                   framesync_callback _callback,
+                   void *             _userdata)
+{
+    unsigned long pos = atomic_load_explicit(&_q->head, memory_order_relaxed);
+    struct framequeue_slot_s * s = &_q->slots[pos % _q->capacity];
+    unsigned long seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+    if ((long)(seq - (pos+1)) < 0)
+        return 0;
+
+    // invoke application callback with the copied record
+    _callback(s->header,  s->header_valid,
+              s->payload, s->payload_len, s->payload_valid,
+              s->stats, _userdata);
+
+    // release the slot for position pos + capacity
+    framequeue_slot_free(s);
+    atomic_store_explicit(&s->seq, pos + _q->capacity, memory_order_release);
+    atomic_store_explicit(&_q->head, pos+1, memory_order_relaxed);
+    return 1;
+}
+
+// drain all pending records, invoking the application callback on
+// each; returns the number of records consumed; single consumer only
+//  _q        : frame callback queue
+//  _callback : application frame callback
+//  _userdata : application userdata pointer
+unsigned int framequeue_drain(framequeue         _q,
+                              framesync_callback _callback,
+                              void *             _userdata)
+{
+    unsigned int n = 0;
+    while (framequeue_pop(_q, _callback, _userdata))
+        n++;
+    return n;
+}
+
+// get number of records currently pending (approximate while
+// producers are active)
+unsigned int framequeue_get_size(framequeue _q)
+{
+    unsigned long head = atomic_load_explicit(&_q->head, memory_order_relaxed);
+    unsigned long tail = atomic_load_explicit(&_q->tail, memory_order_relaxed);
+    return (unsigned int)(tail - head);
+}
+
+// get maximum number of queued records
+unsigned int framequeue_get_capacity(framequeue _q)
+{
+    return _q->capacity;
+}
+
+// get number of frames dropped on overflow (drop policy only)
+unsigned long int framequeue_get_num_dropped(framequeue _q)
+{
+    return (unsigned long int) atomic_load_explicit(&_q->num_dropped, memory_order_relaxed);
+}
@@ -40,6 +40,13 @@
 
 // execute stages
 void fskframesync_execute_detectframe(fskframesync _q, float complex _x);
+
+// update energy gate with input sample, returning 1 if the sample
+// should be run through the frame detector
+int fskframesync_squelch_step(fskframesync _q, float complex _x);
+
+// decode payload, invoke callback and reset synchronizer
+void fskframesync_decode_payload(fskframesync _q);
 void fskframesync_execute_rxheader(   fskframesync _q, float complex _x);
 void fskframesync_execute_rxpayload(  fskframesync _q, float complex _x);
 
@@ -118,6 +125,13 @@ struct fskframesync_s {
     }               state;
     int             frame_assembled;    // frame assembled flag
     int             frame_detected;     // frame detected flag
+    // optional energy-gate squelch (detection pre-stage)
+    int             squelch_enabled;    // energy gate enabled?
+    int             squelch_open;       // gate currently open?
+    int             squelch_replay;     // replaying pre-trigger history?
+    agc_crcf        squelch_agc;        // signal level estimate and gate status
+    windowcf        squelch_history;    // pre-trigger sample history
+    unsigned int    squelch_history_len; // history buffer length
     unsigned int    sample_counter;     // output sample counter
     unsigned int    symbol_counter;     // output symbol counter
     unsigned int    timer;              // sample timer
@@ -179,6 +193,16 @@ fskframesync fskframesync_create(framesync_callback _callback,
     // create buffer for detection
     q->buf_LLR2 = windowf_create(2*preamble_sym_len);
 
+    // energy-gate squelch (disabled by default); history buffer covers
+    // the full over-sampled preamble so the correlator misses nothing
+    q->squelch_enabled     = 0;
+    q->squelch_open        = 0;
+    q->squelch_replay      = 0;
+    q->squelch_history_len = q->k*(2*preamble_sym_len + 2);
+    q->squelch_history     = windowcf_create(q->squelch_history_len);
+    q->squelch_agc         = agc_crcf_create();
+    agc_crcf_set_bandwidth(q->squelch_agc, 0.1f); // fast signal level estimate
+
     // header objects/arrays
 #if 0
     q->header_dec_len   = 10;
@@ -280,6 +304,10 @@ void fskframesync_destroy(fskframesync _q)
     firfilt_rrrf_destroy(_q->detector);
     windowf_destroy(_q->buf_LLR2);
 
+    // destroy squelch objects
+    agc_crcf_destroy(_q->squelch_agc);
+    windowcf_destroy(_q->squelch_history);
+
     // destroy/free header objects/arrays
 #if 0
     free(_q->header_dec);
@@ -348,6 +376,28 @@ void fskframesync_reset(fskframesync _q)
     _q->pfb_index        = 0;
 }
 
+// enable energy-gate squelch: skip frame detection (correlation and
+// per-symbol demodulation) while the input signal level is below the
+// given threshold
+//  _q          :   frame synchronizer object
+//  _threshold  :   signal level threshold [dB]
+void fskframesync_squelch_enable(fskframesync _q,
+                                 float        _threshold)
+{
+    _q->squelch_enabled = 1;
+    _q->squelch_open    = 0;
+    agc_crcf_squelch_enable(_q->squelch_agc);
+    agc_crcf_squelch_set_threshold(_q->squelch_agc, _threshold);
+    windowcf_reset(_q->squelch_history);
+}
+
+// disable energy-gate squelch
+void fskframesync_squelch_disable(fskframesync _q)
+{
+    _q->squelch_enabled = 0;
+    agc_crcf_squelch_disable(_q->squelch_agc);
+}
+
 // execute frame synchronizer
 //  _q      :   frame synchronizer object
 //  _x      :   input sample
@@ -360,6 +410,14 @@ void fskframesync_execute(fskframesync  _q,
         windowcf_push(_q->debug_x, _x);
 #endif
 
+    // optional energy gate: skip frame detection entirely on dead air
+    if (_q->squelch_enabled && !_q->squelch_replay &&
+        _q->state == STATE_DETECTFRAME)
+    {
+        if (!fskframesync_squelch_step(_q, _x))
+            return;
+    }
+
     switch (_q->state) {
     case STATE_DETECTFRAME:
         // look for p/n sequence
@@ -386,9 +444,89 @@ void fskframesync_execute_block(fskframesync    _q,
                                 float complex * _x,
                                 unsigned int    _n)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++)
+    unsigned int i=0;
+    while (i<_n) {
+        // payload phase with timing locked at a symbol boundary: hand
+        // whole symbols to the batched demodulator engine directly,
+        // avoiding the per-sample buffer and state machine
+        if (_q->state == STATE_RXPAYLOAD && _q->timer == _q->k &&
+            _n - i >= _q->k)
+        {
+#if DEBUG_FSKFRAMESYNC
+            if (_q->debug_enabled) {
+                // per-sample path retains debug sample capture
+                fskframesync_execute(_q, _x[i]);
+                i++;
+                continue;
+            }
+#endif
+            // number of whole symbols available, limited to the frame
+            unsigned int num_sym = (_n - i) / _q->k;
+            if (num_sym > _q->payload_sym_len - _q->symbol_counter)
+                num_sym = _q->payload_sym_len - _q->symbol_counter;
+
+            // demodulate in chunks, converting to symbol buffer type
+            while (num_sym > 0) {
+                unsigned int syms[64];
+                unsigned int n0 = num_sym < 64 ? num_sym : 64;
+                unsigned int j;
+                fskdem_demodulate_block(_q->dem, _x+i, n0, syms, NULL);
+                for (j=0; j<n0; j++)
+                    _q->payload_sym[_q->symbol_counter+j] = (unsigned char)syms[j];
+                _q->symbol_counter += n0;
+                num_sym            -= n0;
+                i                  += n0*_q->k;
+            }
+
+            // decode payload if complete (resets synchronizer)
+            if (_q->symbol_counter == _q->payload_sym_len)
+                fskframesync_decode_payload(_q);
+            continue;
+        }
+
         fskframesync_execute(_q, _x[i]);
+        i++;
+    }
+}
+
+// update energy gate with input sample, returning 1 if the sample
+// should be run through the frame detector
+//  _q      :   frame synchronizer object
+//  _x      :   input sample
+int fskframesync_squelch_step(fskframesync  _q,
+                              float complex _x)
+{
+    // update signal level estimate and squelch status
+    float complex v;
+    agc_crcf_execute(_q->squelch_agc, _x, &v);
+    int status = agc_crcf_squelch_get_status(_q->squelch_agc);
+
+    if (_q->squelch_open) {
+        // close the gate once the signal has been low for the timeout
+        if (status == LIQUID_AGC_SQUELCH_TIMEOUT)
+            _q->squelch_open = 0;
+        else
+            return 1;
+    }
+
+    if (status == LIQUID_AGC_SQUELCH_RISE) {
+        // gate opens: replay pre-trigger history through the detector so
+        // no preamble samples are lost, then process current sample
+        _q->squelch_open   = 1;
+        _q->squelch_replay = 1;
+        float complex * r;
+        windowcf_read(_q->squelch_history, &r);
+        unsigned int i;
+        for (i=0; i<_q->squelch_history_len; i++)
+            fskframesync_execute(_q, r[i]);
+        _q->squelch_replay = 0;
+        windowcf_reset(_q->squelch_history);
+        return 1;
+    }
+
+    // gate closed: record sample in pre-trigger history only
+    windowcf_push(_q->squelch_history, _x);
+    return 0;
 }
 
 // 
@@ -613,47 +751,53 @@ void fskframesync_execute_rxpayload(fskframesync  _q,
 
     // decode payload if appropriate
     if (_q->symbol_counter == _q->payload_sym_len) {
+        fskframesync_decode_payload(_q);
+        return;
+    }
+}
+
+// decode payload, invoke callback and reset synchronizer
+void fskframesync_decode_payload(fskframesync _q)
+{
 #if 1
-        printf("rx payload symbols (%u)\n", _q->payload_sym_len);
-        unsigned int i;
-        for (i=0; i<_q->payload_sym_len; i++)
-            printf("%1x%s", _q->payload_sym[i], ((i+1)%64)==0 ? "\n" : "");
-        printf("\n");
+    printf("rx payload symbols (%u)\n", _q->payload_sym_len);
+    unsigned int i;
+    for (i=0; i<_q->payload_sym_len; i++)
+        printf("%1x%s", _q->payload_sym[i], ((i+1)%64)==0 ? "\n" : "");
+    printf("\n");
 #endif
-        // decode payload
-        int payload_valid = qpacketmodem_decode_syms(_q->payload_decoder,
-                                                     _q->payload_sym,
-                                                     _q->payload_dec);
-        printf("payload: %s\n", payload_valid ? "valid" : "INVALID");
-        
-        // invoke callback
-        if (_q->callback != NULL) {
-            // set framestats internals
-            _q->framestats.evm           = 0.0f; //20*log10f(sqrtf(_q->framestats.evm / 600));
-            _q->framestats.rssi          = 0.0f; //20*log10f(_q->gamma_hat);
-            _q->framestats.cfo           = 0.0f; //nco_crcf_get_frequency(_q->mixer);
-            _q->framestats.framesyms     = NULL;
-            _q->framestats.num_framesyms = 0;
-            _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
-            _q->framestats.mod_bps       = 0;
-            _q->framestats.check         = _q->payload_crc;
-            _q->framestats.fec0          = _q->payload_fec0;
-            _q->framestats.fec1          = _q->payload_fec1;
-
-            // invoke callback method
-            _q->callback(_q->header_dec,        // decoded header
-                         1,                     // header valid
-                         _q->payload_dec,       // payload
-                         _q->payload_dec_len,   // payload length
-                         payload_valid,         // payload valid,
-                         _q->framestats,
-                         _q->userdata);
-        }
-
-        // reset frame synchronizer
-        fskframesync_reset(_q);
-        return;
+    // decode payload
+    int payload_valid = qpacketmodem_decode_syms(_q->payload_decoder,
+                                                 _q->payload_sym,
+                                                 _q->payload_dec);
+    printf("payload: %s\n", payload_valid ? "valid" : "INVALID");
+
+    // invoke callback
+    if (_q->callback != NULL) {
+        // set framestats internals
+        _q->framestats.evm           = 0.0f; //20*log10f(sqrtf(_q->framestats.evm / 600));
+        _q->framestats.rssi          = 0.0f; //20*log10f(_q->gamma_hat);
+        _q->framestats.cfo           = 0.0f; //nco_crcf_get_frequency(_q->mixer);
+        _q->framestats.framesyms     = NULL;
+        _q->framestats.num_framesyms = 0;
+        _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+        _q->framestats.mod_bps       = 0;
+        _q->framestats.check         = _q->payload_crc;
+        _q->framestats.fec0          = _q->payload_fec0;
+        _q->framestats.fec1          = _q->payload_fec1;
+
+        // invoke callback method
+        _q->callback(_q->header_dec,        // decoded header
+                     1,                     // header valid
+                     _q->payload_dec,       // payload
+                     _q->payload_dec_len,   // payload length
+                     payload_valid,         // payload valid,
+                     _q->framestats,
+                     _q->userdata);
     }
+
+    // reset frame synchronizer
+    fskframesync_reset(_q);
 }
 
 // decode header and re-configure payload decoder
@@ -45,6 +45,11 @@
 void gmskframesync_execute_sample(gmskframesync _q,
                                   float complex _x);
 
+// update energy gate with post-filtered sample, returning 1 if the
+// sample should be run through the frame detector
+int gmskframesync_squelch_step(gmskframesync _q,
+                               float complex _x);
+
 // push buffered p/n sequence through synchronizer
 void gmskframesync_pushpn(gmskframesync _q);
 
@@ -68,6 +73,13 @@ void gmskframesync_execute_detectframe(gmskframesync _q, float complex _x);
 void gmskframesync_execute_rxpreamble( gmskframesync _q, float complex _x);
 void gmskframesync_execute_rxheader(   gmskframesync _q, float complex _x);
 void gmskframesync_execute_rxpayload(  gmskframesync _q, float complex _x);
+void gmskframesync_execute_rxpayload_demod(gmskframesync _q, float complex _y);
+
+// process payload phase on a block of input samples with vectorized
+// derotation; returns the number of samples consumed
+unsigned int gmskframesync_execute_rxpayload_block(gmskframesync   _q,
+                                                   float complex * _x,
+                                                   unsigned int    _n);
 
 // decode header
 void gmskframesync_decode_header(gmskframesync _q);
@@ -105,6 +117,14 @@ struct gmskframesync_s {
     float gamma_hat;                // channel gain estimate
     windowcf buffer;                // pre-demod buffered samples, size: k*(pn_len+m)
     nco_crcf nco_coarse;            // coarse carrier frequency recovery
+
+    // optional energy-gate squelch (detection pre-stage)
+    int squelch_enabled;            // energy gate enabled?
+    int squelch_open;               // gate currently open?
+    int squelch_replay;             // replaying pre-trigger history?
+    agc_crcf squelch_agc;           // signal level estimate and gate status
+    windowcf squelch_history;       // pre-trigger sample history
+    unsigned int squelch_history_len; // history buffer length
     
     // preamble
     unsigned int preamble_len;      // number of symbols in preamble
@@ -208,6 +228,16 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
     q->frame_detector = detector_cccf_create(preamble_samples, q->preamble_len*q->k, threshold, dphi_max);
     q->buffer = windowcf_create(q->k*(q->preamble_len+q->m));
 
+    // energy-gate squelch (disabled by default); history buffer covers
+    // the full preamble so no samples are lost when the gate opens
+    q->squelch_enabled     = 0;
+    q->squelch_open        = 0;
+    q->squelch_replay      = 0;
+    q->squelch_history_len = 2*q->k*(q->preamble_len + q->m);
+    q->squelch_history     = windowcf_create(q->squelch_history_len);
+    q->squelch_agc         = agc_crcf_create();
+    agc_crcf_set_bandwidth(q->squelch_agc, 0.1f); // fast signal level estimate
+
     // create symbol timing recovery filters
     q->npfb = 32;   // number of filters in the bank
     q->mf   = firpfb_rrrf_create_rnyquist( LIQUID_FIRFILT_GMSKRX,q->npfb,q->k,q->m,q->BT);
@@ -280,6 +310,10 @@ void gmskframesync_destroy(gmskframesync _q)
     windowcf_destroy(_q->buffer);
     free(_q->preamble_pn);
     free(_q->preamble_rx);
+
+    // squelch
+    agc_crcf_destroy(_q->squelch_agc);
+    windowcf_destroy(_q->squelch_history);
     
     // header
     packetizer_destroy(_q->p_header);
@@ -360,6 +394,69 @@ int gmskframesync_is_frame_open(gmskframesync _q)
     return (_q->state == STATE_DETECTFRAME) ? 0 : 1;
 }
 
+// enable energy-gate squelch: skip frame detection (correlation) while
+// the input signal level is below the given threshold
+//  _q          :   frame synchronizer object
+//  _threshold  :   signal level threshold [dB]
+void gmskframesync_squelch_enable(gmskframesync _q,
+                                  float         _threshold)
+{
+    _q->squelch_enabled = 1;
+    _q->squelch_open    = 0;
+    agc_crcf_squelch_enable(_q->squelch_agc);
+    agc_crcf_squelch_set_threshold(_q->squelch_agc, _threshold);
+    windowcf_reset(_q->squelch_history);
+}
+
+// disable energy-gate squelch
+void gmskframesync_squelch_disable(gmskframesync _q)
+{
+    _q->squelch_enabled = 0;
+    agc_crcf_squelch_disable(_q->squelch_agc);
+}
+
+// update energy gate with post-filtered sample, returning 1 if the
+// sample should be run through the frame detector
+//  _q      :   frame synchronizer object
+//  _x      :   input sample
+int gmskframesync_squelch_step(gmskframesync _q,
+                               float complex _x)
+{
+    // update signal level estimate and squelch status
+    float complex v;
+    agc_crcf_execute(_q->squelch_agc, _x, &v);
+    int status = agc_crcf_squelch_get_status(_q->squelch_agc);
+
+    if (_q->squelch_open) {
+        // close the gate once the signal has been low for the timeout
+        if (status == LIQUID_AGC_SQUELCH_TIMEOUT)
+            _q->squelch_open = 0;
+        else
+            return 1;
+    }
+
+    if (status == LIQUID_AGC_SQUELCH_RISE) {
+        // gate opens: replay pre-trigger history through the detector so
+        // no preamble samples are lost, then process current sample
+        // NOTE: history holds post-filtered samples, so replay bypasses
+        //       the pre-demodulation filter
+        _q->squelch_open   = 1;
+        _q->squelch_replay = 1;
+        float complex * r;
+        windowcf_read(_q->squelch_history, &r);
+        unsigned int i;
+        for (i=0; i<_q->squelch_history_len; i++)
+            gmskframesync_execute_sample(_q, r[i]);
+        _q->squelch_replay = 0;
+        windowcf_reset(_q->squelch_history);
+        return 1;
+    }
+
+    // gate closed: record sample in pre-trigger history only
+    windowcf_push(_q->squelch_history, _x);
+    return 0;
+}
+
 void gmskframesync_execute_sample(gmskframesync _q,
                                   float complex _x)
 {
@@ -395,8 +492,16 @@ void gmskframesync_execute(gmskframesync   _q,
                            unsigned int    _n)
 {
     // push through synchronizer
-    unsigned int i;
-    for (i=0; i<_n; i++) {
+    unsigned int i=0;
+    while (i<_n) {
+        // payload phase: the state machine only needs per-symbol
+        // granularity once timing is locked, so process samples in
+        // blocks with vectorized derotation
+        if (_q->state == STATE_RXPAYLOAD) {
+            i += gmskframesync_execute_rxpayload_block(_q, _x+i, _n-i);
+            continue;
+        }
+
         float complex xf;   // input sample
 #if GMSKFRAMESYNC_PREFILTER
         iirfilt_crcf_execute(_q->prefilter, _x[i], &xf);
@@ -409,8 +514,16 @@ void gmskframesync_execute(gmskframesync   _q,
             windowcf_push(_q->debug_x, xf);
 #endif
 
-        gmskframesync_execute_sample(_q, xf);
+        // optional energy gate: skip frame detection entirely on dead air
+        if (_q->squelch_enabled && !_q->squelch_replay &&
+            _q->state == STATE_DETECTFRAME)
+        {
+            if (!gmskframesync_squelch_step(_q, xf))
+                continue;
+        }
 
+        gmskframesync_execute_sample(_q, xf);
+        i++;
     }
 }
 
@@ -426,9 +539,10 @@ int gmskframesync_update_symsync(gmskframesync _q,
                                  float         _x,
                                  float *       _y)
 {
-    // push sample into filterbanks
-    firpfb_rrrf_push(_q->mf,  _x);
-    firpfb_rrrf_push(_q->dmf, _x);
+    // push sample into matched filter bank; the derivative bank outputs
+    // are computed against the same buffer with the fused execute-pair
+    // method
+    firpfb_rrrf_push(_q->mf, _x);
 
     //
     float mf_out  = 0.0f;    // matched-filter output
@@ -451,8 +565,7 @@ int gmskframesync_update_symsync(gmskframesync _q,
         // reset timer
         _q->pfb_timer = 2;  // k samples/symbol
 
-        firpfb_rrrf_execute(_q->mf,  _q->pfb_index, &mf_out);
-        firpfb_rrrf_execute(_q->dmf, _q->pfb_index, &dmf_out);
+        firpfb_rrrf_execute_pair(_q->mf, _q->dmf, _q->pfb_index, &mf_out, &dmf_out);
 
         // update filtered timing error
         // lo  bandwidth parameters: {0.92, 1.20}, about 100 symbols settling time
@@ -532,9 +645,8 @@ void gmskframesync_pushpn(gmskframesync _q)
         // update instantanenous frequency estimate
         gmskframesync_update_fi(_q, y);
 
-        // push initial samples into filterbanks
-        firpfb_rrrf_push(_q->mf,  _q->fi_hat);
-        firpfb_rrrf_push(_q->dmf, _q->fi_hat);
+        // push initial samples into matched filter bank
+        firpfb_rrrf_push(_q->mf, _q->fi_hat);
     }
 
     // set state (still need a few more samples before entire p/n
@@ -706,8 +818,58 @@ void gmskframesync_execute_rxpayload(gmskframesync _q,
     nco_crcf_mix_down(_q->nco_coarse, _x, &y);
     nco_crcf_step(_q->nco_coarse);
 
+    // demodulate
+    gmskframesync_execute_rxpayload_demod(_q, y);
+}
+
+// process payload phase on a block of input samples: prefilter and
+// derotate the entire block up front, then run the per-symbol demod
+// logic over the result; returns the number of samples consumed (the
+// block is abandoned early if the frame completes within it)
+unsigned int gmskframesync_execute_rxpayload_block(gmskframesync   _q,
+                                                   float complex * _x,
+                                                   unsigned int    _n)
+{
+    // internal block size
+    unsigned int num = _n < 64 ? _n : 64;
+    float complex buf[64];
+    unsigned int j;
+
+#if GMSKFRAMESYNC_PREFILTER
+    // apply pre-demodulation filter to entire block
+    iirfilt_crcf_execute_block(_q->prefilter, _x, num, buf);
+#else
+    memmove(buf, _x, num*sizeof(float complex));
+#endif
+
+#if DEBUG_GMSKFRAMESYNC
+    if (_q->debug_enabled) {
+        for (j=0; j<num; j++)
+            windowcf_push(_q->debug_x, buf[j]);
+    }
+#endif
+
+    // derotate entire block by coarse carrier estimate (in place)
+    nco_crcf_mix_block_down(_q->nco_coarse, buf, buf, num);
+
+    // run block through per-symbol demodulator
+    for (j=0; j<num; j++) {
+        gmskframesync_execute_rxpayload_demod(_q, buf[j]);
+
+        // stop if the frame completed within the block; remaining
+        // samples are re-processed through the detection path
+        if (_q->state != STATE_RXPAYLOAD)
+            return j+1;
+    }
+    return num;
+}
+
+// demodulate single mixed-down payload sample
+void gmskframesync_execute_rxpayload_demod(gmskframesync _q,
+                                           float complex _y)
+{
     // update instantanenous frequency estimate
-    gmskframesync_update_fi(_q, y);
+    gmskframesync_update_fi(_q, _y);
 
     // update symbol synchronizer
     float mf_out = 0.0f;
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 
 // internal structure
 struct MSOURCE(_s)
@@ -51,6 +52,26 @@ struct MSOURCE(_s)
 
     // global counters
     unsigned long long num_samples; // total number of samples generated
+
+    // threaded generation
+    int             threaded;       // threaded generation enabled?
+    unsigned int    num_threads;    // number of worker threads
+    pthread_t *     threads;        // worker thread handles
+    void *          thread_args;    // worker thread arguments
+    float complex * buf_partial;    // per-worker buffers [size: num_threads x M]
+    pthread_mutex_t mutex;          // pool synchronization mutex
+    pthread_cond_t  cond_start;     // work-available condition
+    pthread_cond_t  cond_done;      // work-complete condition
+    unsigned int    sequence;       // generation sequence number
+    unsigned int    num_done;       // workers finished this round
+    int             quit;           // pool shutdown flag
+};
+
+// worker thread argument
+struct MSOURCE(_worker_s)
+{
+    struct MSOURCE(_s) * q;         // parent object
+    unsigned int         index;     // worker index
 };
 
 //
@@ -89,6 +110,13 @@ MSOURCE() MSOURCE(_create)(unsigned int _M,
     q->read_index = q->M/2; // indicate buffer is empty
     q->num_blocks = 0;
 
+    // threaded generation disabled by default
+    q->threaded    = 0;
+    q->num_threads = 0;
+    q->threads     = NULL;
+    q->thread_args = NULL;
+    q->buf_partial = NULL;
+
     // reset and return main object
     MSOURCE(_reset)(q);
     return q;
@@ -103,6 +131,9 @@ MSOURCE() MSOURCE(_create_default)(void)
 // destroy msource object, freeing all internal memory
 void MSOURCE(_destroy)(MSOURCE() _q)
 {
+    // shut down worker pool
+    MSOURCE(_set_num_threads)(_q, 0);
+
     // destroy internal objects
     unsigned int i;
     for (i=0; i<_q->num_sources; i++)
@@ -461,16 +492,123 @@ QSOURCE() MSOURCE(_get_source)(MSOURCE() _q,
     return NULL;
 }
 
+// worker thread loop: render assigned sources into the worker's
+// private accumulation buffer each time a round is signalled
+static void * MSOURCE(_worker)(void * _arg)
+{
+    struct MSOURCE(_worker_s) * w = (struct MSOURCE(_worker_s)*) _arg;
+    struct MSOURCE(_s) *        q = w->q;
+    unsigned int                t = w->index;
+    unsigned int sequence = 0;
+
+    pthread_mutex_lock(&q->mutex);
+    while (1) {
+        // wait for next round (or shutdown)
+        while (!q->quit && q->sequence == sequence)
+            pthread_cond_wait(&q->cond_start, &q->mutex);
+        if (q->quit)
+            break;
+        sequence = q->sequence;
+        pthread_mutex_unlock(&q->mutex);
+
+        // render sources t, t+T, t+2T, ... into private buffer
+        float complex * buf = q->buf_partial + t*q->M;
+        memset(buf, 0, q->M*sizeof(float complex));
+        unsigned int i;
+        for (i=t; i<q->num_sources; i+=q->num_threads)
+            QSOURCE(_generate_into)(q->sources[i], buf);
+
+        // signal completion
+        pthread_mutex_lock(&q->mutex);
+        q->num_done++;
+        if (q->num_done == q->num_threads)
+            pthread_cond_signal(&q->cond_done);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+
+// set number of worker threads for source generation (0: serial)
+//  _q          : msource object
+//  _num_threads: number of workers, 0 to disable threaded generation
+void MSOURCE(_set_num_threads)(MSOURCE()    _q,
+                               unsigned int _num_threads)
+{
+    unsigned int i;
+
+    // shut down existing pool
+    if (_q->threaded) {
+        pthread_mutex_lock(&_q->mutex);
+        _q->quit = 1;
+        pthread_cond_broadcast(&_q->cond_start);
+        pthread_mutex_unlock(&_q->mutex);
+        for (i=0; i<_q->num_threads; i++)
+            pthread_join(_q->threads[i], NULL);
+        pthread_mutex_destroy(&_q->mutex);
+        pthread_cond_destroy (&_q->cond_start);
+        pthread_cond_destroy (&_q->cond_done);
+        free(_q->threads);
+        free(_q->thread_args);
+        free(_q->buf_partial);
+        _q->threads     = NULL;
+        _q->thread_args = NULL;
+        _q->buf_partial = NULL;
+        _q->threaded    = 0;
+        _q->num_threads = 0;
+    }
+
+    if (_num_threads == 0)
+        return;
+
+    // create pool
+    _q->num_threads = _num_threads;
+    _q->threads     = (pthread_t*) malloc(_num_threads*sizeof(pthread_t));
+    _q->buf_partial = (float complex*) malloc(_num_threads*_q->M*sizeof(float complex));
+    struct MSOURCE(_worker_s) * args =
+        (struct MSOURCE(_worker_s)*) malloc(_num_threads*sizeof(struct MSOURCE(_worker_s)));
+    _q->thread_args = (void*) args;
+    _q->sequence = 0;
+    _q->num_done = 0;
+    _q->quit     = 0;
+    pthread_mutex_init(&_q->mutex,      NULL);
+    pthread_cond_init (&_q->cond_start, NULL);
+    pthread_cond_init (&_q->cond_done,  NULL);
+    for (i=0; i<_num_threads; i++) {
+        args[i].q     = _q;
+        args[i].index = i;
+        pthread_create(&_q->threads[i], NULL, MSOURCE(_worker), &args[i]);
+    }
+    _q->threaded = 1;
+}
+
 // generate samples internally
 void MSOURCE(_generate)(MSOURCE() _q)
 {
-    // clear buffer
-    memset(_q->buf_freq, 0, _q->M*sizeof(float complex));
-
-    // add sources into main frequency buffer
     unsigned int i;
-    for (i=0; i<_q->num_sources; i++)
-        QSOURCE(_generate_into)(_q->sources[i], _q->buf_freq);
+
+    if (_q->threaded) {
+        // signal workers to render this round
+        pthread_mutex_lock(&_q->mutex);
+        _q->num_done = 0;
+        _q->sequence++;
+        pthread_cond_broadcast(&_q->cond_start);
+        while (_q->num_done < _q->num_threads)
+            pthread_cond_wait(&_q->cond_done, &_q->mutex);
+        pthread_mutex_unlock(&_q->mutex);
+
+        // reduce private buffers in fixed worker order so the result
+        // is deterministic for a given thread count
+        memset(_q->buf_freq, 0, _q->M*sizeof(float complex));
+        for (i=0; i<_q->num_threads; i++)
+            liquid_vectorcf_add(_q->buf_freq, _q->buf_partial + i*_q->M, _q->M, _q->buf_freq);
+    } else {
+        // clear buffer
+        memset(_q->buf_freq, 0, _q->M*sizeof(float complex));
+
+        // add sources into main frequency buffer
+        for (i=0; i<_q->num_sources; i++)
+            QSOURCE(_generate_into)(_q->sources[i], _q->buf_freq);
+    }
 
     // run synthesis channelizer
     firpfbch2_crcf_execute(_q->ch, _q->buf_freq, _q->buf_time);
@@ -31,6 +31,7 @@
 #include <string.h>
 #include <math.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
@@ -39,6 +40,11 @@
 // reconfigure internal buffers, objects, etc.
 void ofdmflexframegen_reconfigure(ofdmflexframegen _q);
 
+// pipelined assembly (internal)
+void * ofdmflexframegen_pipeline_worker(void * _arg);       // encoder thread
+void   ofdmflexframegen_encode_staged  (ofdmflexframegen _q); // encode staged frame
+void   ofdmflexframegen_pipeline_load  (ofdmflexframegen _q); // load encoded frame
+
 // encode header
 void ofdmflexframegen_encode_header(ofdmflexframegen _q);
 
@@ -119,6 +125,7 @@ struct ofdmflexframegen_s {
     modem mod_payload;                  // payload modulator
     unsigned char * payload_enc;        // payload data (encoded bytes)
     unsigned char * payload_mod;        // payload data (modulated symbols)
+    unsigned int payload_enc_buf_len;   // allocated size of payload_enc
     unsigned int payload_enc_len;       // length of encoded payload
     unsigned int payload_mod_len;       // number of modulated symbols in payload
 
@@ -141,6 +148,28 @@ struct ofdmflexframegen_s {
     // properties
     ofdmflexframegenprops_s props;
     ofdmflexframegenprops_s header_props;
+
+    // pipelined assembly: optional background thread runs header/payload
+    // encoding while the caller drains ready symbols from write()
+    int             pipeline_enabled;       // pipeline mode enabled?
+    int             pipeline_init;          // pipeline objects created?
+    int             pipeline_running;       // encoder thread active?
+    int             pipeline_pending;       // staged frame awaiting encode?
+    int             pipeline_done;          // encoded frame awaiting load?
+    pthread_t       pipeline_thread;        // background encoder thread
+    pthread_mutex_t pipeline_mutex;         // protects pipeline state
+    pthread_cond_t  pipeline_submit;        // signal: frame staged
+    pthread_cond_t  pipeline_ready;         // signal: staging slot free
+    unsigned char * staged_header;          // staged header (user bytes)
+    unsigned char * staged_payload;         // staged payload (uncoded)
+    unsigned int    staged_payload_len;     // staged payload length
+    unsigned int    staged_buf_len;         // staged payload allocation
+    unsigned char * header_mod_back;        // header symbols (back buffer)
+    unsigned char * payload_mod_back;       // payload symbols (back buffer)
+    unsigned int    payload_mod_back_len;   // number of back-buffer symbols
+    unsigned int    payload_mod_back_buf_len; // back-buffer allocation
+    unsigned int    payload_mod_buf_len;    // front-buffer allocation
+    unsigned int    num_symbols_payload_back; // payload OFDM symbols (back)
 };
 
 // create OFDM flexible framing generator object
@@ -207,14 +236,26 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
                                      LIQUID_FEC_NONE,
                                      LIQUID_FEC_NONE);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
+    q->payload_enc_buf_len = q->payload_enc_len;
+    q->payload_enc = (unsigned char*) malloc(q->payload_enc_buf_len*sizeof(unsigned char));
 
     q->payload_mod_len = 1;
-    q->payload_mod = (unsigned char*) malloc(q->payload_mod_len*sizeof(unsigned char));
+    q->payload_mod_buf_len = q->payload_mod_len;
+    q->payload_mod = (unsigned char*) malloc(q->payload_mod_buf_len*sizeof(unsigned char));
 
     // create payload modem (initially QPSK, overridden by properties)
     q->mod_payload = modem_create(LIQUID_MODEM_QPSK);
 
+    // pipelined assembly disabled by default
+    q->pipeline_enabled = 0;
+    q->pipeline_init    = 0;
+    q->staged_header    = NULL;
+    q->staged_payload   = NULL;
+    q->staged_buf_len   = 0;
+    q->header_mod_back  = NULL;
+    q->payload_mod_back = NULL;
+    q->payload_mod_back_buf_len = 0;
+
     // initialize properties
     ofdmflexframegen_setprops(q, _fgprops);
 
@@ -227,6 +268,18 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
 
 void ofdmflexframegen_destroy(ofdmflexframegen _q)
 {
+    // shut down pipeline and destroy its objects
+    if (_q->pipeline_init) {
+        ofdmflexframegen_pipeline_disable(_q);
+        pthread_mutex_destroy(&_q->pipeline_mutex);
+        pthread_cond_destroy (&_q->pipeline_submit);
+        pthread_cond_destroy (&_q->pipeline_ready);
+        free(_q->staged_header);
+        free(_q->staged_payload);
+        free(_q->header_mod_back);
+        free(_q->payload_mod_back);
+    }
+
     // destroy internal objects
     ofdmframegen_destroy(_q->fg);       // OFDM frame generator
     packetizer_destroy(_q->p_header);   // header packetizer
@@ -402,6 +455,22 @@ void ofdmflexframegen_set_header_props(ofdmflexframegen _q,
     ofdmflexframegen_set_header_len(_q, _q->header_user_len);
 }
 
+// pre-allocate internal buffers for payloads up to _len_max bytes so
+// that subsequent calls to assemble() with payloads no longer than the
+// maximum are allocation-free
+void ofdmflexframegen_set_payload_len_max(ofdmflexframegen _q,
+                                          unsigned int     _len_max)
+{
+    // configure at the maximum length to grow all internal buffers to
+    // their maxima, then restore the current length (buffers never
+    // shrink)
+    unsigned int payload_dec_len = _q->payload_dec_len;
+    _q->payload_dec_len = _len_max;
+    ofdmflexframegen_reconfigure(_q);
+    _q->payload_dec_len = payload_dec_len;
+    ofdmflexframegen_reconfigure(_q);
+}
+
 // get length of frame (symbols)
 //  _q              :   OFDM frame generator object
 unsigned int ofdmflexframegen_getframelen(ofdmflexframegen _q)
@@ -426,6 +495,39 @@ void ofdmflexframegen_assemble(ofdmflexframegen      _q,
                                const unsigned char * _payload,
                                unsigned int          _payload_len)
 {
+    // pipeline mode: stage the frame for the background encoder thread
+    // and return immediately; write() loads the encoded frame at the
+    // next symbol boundary
+    if (_q->pipeline_enabled) {
+        pthread_mutex_lock(&_q->pipeline_mutex);
+
+        // wait for the staging slot and back buffers to be free
+        while (_q->pipeline_pending || _q->pipeline_done)
+            pthread_cond_wait(&_q->pipeline_ready, &_q->pipeline_mutex);
+
+        // copy user-defined header data into staging buffer
+        if (_header == NULL)
+            memset(_q->staged_header, 0x00, _q->header_user_len*sizeof(unsigned char));
+        else
+            memmove(_q->staged_header, _header, _q->header_user_len*sizeof(unsigned char));
+
+        // copy payload into staging buffer (grow as needed)
+        if (_payload_len > _q->staged_buf_len) {
+            _q->staged_payload = (unsigned char*) realloc(_q->staged_payload,
+                                                          _payload_len*sizeof(unsigned char));
+            _q->staged_buf_len = _payload_len;
+        }
+        memmove(_q->staged_payload, _payload, _payload_len*sizeof(unsigned char));
+        _q->staged_payload_len = _payload_len;
+
+        // mark frame staged and wake the encoder thread
+        _q->frame_complete   = 0;
+        _q->pipeline_pending = 1;
+        pthread_cond_signal(&_q->pipeline_submit);
+        pthread_mutex_unlock(&_q->pipeline_mutex);
+        return;
+    }
+
     // reset state
     ofdmflexframegen_reset(_q);
 
@@ -482,6 +584,10 @@ int ofdmflexframegen_write(ofdmflexframegen _q,
     unsigned int i;
     for (i=0; i<_buf_len; i++) {
         if (_q->buf_index >= _q->frame_len) {
+            // pipeline mode: load the next encoded frame when idle
+            if (_q->pipeline_init && !_q->frame_assembled)
+                ofdmflexframegen_pipeline_load(_q);
+
             ofdmflexframegen_gen_symbol(_q);
             _q->buf_index = 0;
         }
@@ -492,6 +598,58 @@ int ofdmflexframegen_write(ofdmflexframegen _q,
     return _q->frame_complete;
 }
 
+// enable pipelined frame assembly with a background encoder thread
+void ofdmflexframegen_pipeline_enable(ofdmflexframegen _q)
+{
+    if (_q->pipeline_enabled)
+        return;
+
+    // create synchronization objects on first use
+    if (!_q->pipeline_init) {
+        pthread_mutex_init(&_q->pipeline_mutex,  NULL);
+        pthread_cond_init (&_q->pipeline_submit, NULL);
+        pthread_cond_init (&_q->pipeline_ready,  NULL);
+        _q->pipeline_init = 1;
+    }
+
+    // (re-)allocate staging/back buffers to match current configuration
+    _q->staged_header   = (unsigned char*) realloc(_q->staged_header,
+                                                   _q->header_user_len*sizeof(unsigned char));
+    _q->header_mod_back = (unsigned char*) realloc(_q->header_mod_back,
+                                                   _q->header_sym_len*sizeof(unsigned char));
+
+    // reset pipeline state
+    _q->pipeline_pending = 0;
+    _q->pipeline_done    = 0;
+    _q->pipeline_running = 1;
+    _q->pipeline_enabled = 1;
+
+    // emit silence until the first pipelined frame is ready
+    if (!_q->frame_assembled)
+        _q->state = OFDMFLEXFRAMEGEN_STATE_ZEROS;
+
+    // start background encoder thread
+    pthread_create(&_q->pipeline_thread, NULL, ofdmflexframegen_pipeline_worker, (void*)_q);
+}
+
+// disable pipelined frame assembly, blocking until any staged frame has
+// been encoded; an encoded frame not yet transmitted remains queued and
+// is still loaded by write()
+void ofdmflexframegen_pipeline_disable(ofdmflexframegen _q)
+{
+    if (!_q->pipeline_enabled)
+        return;
+
+    // stop encoder thread; it encodes any staged frame before exiting
+    pthread_mutex_lock(&_q->pipeline_mutex);
+    _q->pipeline_running = 0;
+    pthread_cond_broadcast(&_q->pipeline_submit);
+    pthread_mutex_unlock(&_q->pipeline_mutex);
+    pthread_join(_q->pipeline_thread, NULL);
+
+    _q->pipeline_enabled = 0;
+}
+
 
 //
 // internal
@@ -507,10 +665,15 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
                                         _q->props.fec0,
                                         _q->props.fec1);
 
-    // re-allocate memory for encoded message
+    // re-allocate memory for encoded message; buffers grow but never
+    // shrink so that assembling frames with varying payload lengths
+    // within a previous maximum is allocation-free
     _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
-    _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
-                                               _q->payload_enc_len*sizeof(unsigned char));
+    if (_q->payload_enc_len > _q->payload_enc_buf_len) {
+        _q->payload_enc_buf_len = _q->payload_enc_len;
+        _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
+                                                   _q->payload_enc_buf_len*sizeof(unsigned char));
+    }
 #if DEBUG_OFDMFLEXFRAMEGEN
     //printf(">>>> payload : %u (%u encoded)\n", _q->props.payload_len, _q->payload_enc_len);
 #endif
@@ -523,14 +686,135 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
     unsigned int bps = modulation_types[_q->props.mod_scheme].bps;
     div_t d = div(8*_q->payload_enc_len, bps);
     _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
-    _q->payload_mod = (unsigned char*)realloc(_q->payload_mod,
-                                              _q->payload_mod_len*sizeof(unsigned char));
+    if (_q->payload_mod_len > _q->payload_mod_buf_len) {
+        _q->payload_mod_buf_len = _q->payload_mod_len;
+        _q->payload_mod = (unsigned char*)realloc(_q->payload_mod,
+                                                  _q->payload_mod_buf_len*sizeof(unsigned char));
+    }
 
     // re-compute number of payload OFDM symbols
     d = div(_q->payload_mod_len, _q->M_data);
     _q->num_symbols_payload = d.quot + (d.rem ? 1 : 0);
 }
 
+// background encoder thread: encode staged frames into the back buffers
+void * ofdmflexframegen_pipeline_worker(void * _arg)
+{
+    ofdmflexframegen _q = (ofdmflexframegen) _arg;
+
+    pthread_mutex_lock(&_q->pipeline_mutex);
+    while (1) {
+        // wait for a staged frame (or shutdown)
+        while (_q->pipeline_running && !_q->pipeline_pending)
+            pthread_cond_wait(&_q->pipeline_submit, &_q->pipeline_mutex);
+
+        if (!_q->pipeline_pending)
+            break;
+        pthread_mutex_unlock(&_q->pipeline_mutex);
+
+        // encode staged frame outside the lock; the caller cannot
+        // re-stage until the pending flag clears
+        ofdmflexframegen_encode_staged(_q);
+
+        pthread_mutex_lock(&_q->pipeline_mutex);
+        _q->pipeline_pending = 0;
+        _q->pipeline_done    = 1;
+    }
+    pthread_mutex_unlock(&_q->pipeline_mutex);
+    return NULL;
+}
+
+// encode staged frame into back buffers (encoder thread)
+void ofdmflexframegen_encode_staged(ofdmflexframegen _q)
+{
+    // re-create payload packetizer if the staged length differs
+    if (_q->staged_payload_len != _q->payload_dec_len) {
+        _q->payload_dec_len = _q->staged_payload_len;
+        _q->p_payload = packetizer_recreate(_q->p_payload,
+                                            _q->payload_dec_len,
+                                            _q->props.check,
+                                            _q->props.fec0,
+                                            _q->props.fec1);
+        _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
+        if (_q->payload_enc_len > _q->payload_enc_buf_len) {
+            _q->payload_enc_buf_len = _q->payload_enc_len;
+            _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
+                                                       _q->payload_enc_buf_len*sizeof(unsigned char));
+        }
+    }
+
+    // encode full header from staged user data
+    memmove(_q->header, _q->staged_header, _q->header_user_len*sizeof(unsigned char));
+    ofdmflexframegen_encode_header(_q);
+
+    // repack encoded header bytes into back buffer of modem symbols
+    unsigned int bps = modulation_types[_q->header_props.mod_scheme].bps;
+    unsigned int num_written;
+    liquid_repack_bytes(_q->header_enc,      8,   _q->header_enc_len,
+                        _q->header_mod_back, bps, _q->header_sym_len,
+                        &num_written);
+
+    // encode payload
+    packetizer_encode(_q->p_payload, _q->staged_payload, _q->payload_enc);
+
+    // compute number of modulated payload symbols; grow back buffer
+    bps = modulation_types[_q->props.mod_scheme].bps;
+    div_t d = div(8*_q->payload_enc_len, bps);
+    _q->payload_mod_back_len = d.quot + (d.rem ? 1 : 0);
+    if (_q->payload_mod_back_len > _q->payload_mod_back_buf_len) {
+        _q->payload_mod_back = (unsigned char*) realloc(_q->payload_mod_back,
+                                                        _q->payload_mod_back_len*sizeof(unsigned char));
+        _q->payload_mod_back_buf_len = _q->payload_mod_back_len;
+    }
+
+    // repack 8-bit payload bytes into 'bps'-bit payload symbols
+    memset(_q->payload_mod_back, 0x00, _q->payload_mod_back_len);
+    liquid_repack_bytes(_q->payload_enc,      8,   _q->payload_enc_len,
+                        _q->payload_mod_back, bps, _q->payload_mod_back_len,
+                        &num_written);
+
+    // re-compute number of payload OFDM symbols
+    d = div(_q->payload_mod_back_len, _q->M_data);
+    _q->num_symbols_payload_back = d.quot + (d.rem ? 1 : 0);
+}
+
+// load the next pipelined frame for transmission, if one is ready
+void ofdmflexframegen_pipeline_load(ofdmflexframegen _q)
+{
+    pthread_mutex_lock(&_q->pipeline_mutex);
+    if (!_q->pipeline_done) {
+        pthread_mutex_unlock(&_q->pipeline_mutex);
+        return;
+    }
+
+    // copy encoded header/payload symbols into the front buffers
+    memmove(_q->header_mod, _q->header_mod_back,
+            _q->header_sym_len*sizeof(unsigned char));
+    if (_q->payload_mod_back_len > _q->payload_mod_buf_len) {
+        _q->payload_mod = (unsigned char*) realloc(_q->payload_mod,
+                                                   _q->payload_mod_back_len*sizeof(unsigned char));
+        _q->payload_mod_buf_len = _q->payload_mod_back_len;
+    }
+    memmove(_q->payload_mod, _q->payload_mod_back,
+            _q->payload_mod_back_len*sizeof(unsigned char));
+    _q->payload_mod_len     = _q->payload_mod_back_len;
+    _q->num_symbols_payload = _q->num_symbols_payload_back;
+
+    // release the back buffers to the encoder thread
+    _q->pipeline_done = 0;
+    pthread_cond_signal(&_q->pipeline_ready);
+    pthread_mutex_unlock(&_q->pipeline_mutex);
+
+    // reset per-frame transmit state
+    _q->symbol_number        = 0;
+    _q->state                = OFDMFLEXFRAMEGEN_STATE_S0a;
+    _q->frame_assembled      = 1;
+    _q->frame_complete       = 0;
+    _q->header_symbol_index  = 0;
+    _q->payload_symbol_index = 0;
+    ofdmframegen_reset(_q->fg);
+}
+
 // encode header
 void ofdmflexframegen_encode_header(ofdmflexframegen _q)
 {
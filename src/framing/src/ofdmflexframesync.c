@@ -31,6 +31,7 @@
 #include <string.h>
 #include <math.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
@@ -59,6 +60,55 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q);
 void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                                 float complex * _X);
 
+// threaded operation: maximum number of payload decoding workers and
+// depth of the internal job queue
+#define OFDMFLEXFRAMESYNC_MAX_THREADS   (4)
+#define OFDMFLEXFRAMESYNC_NUM_JOBS      (8)
+
+// worker pool methods for threaded payload decoding
+void   ofdmflexframesync_start_pool  (ofdmflexframesync _q, unsigned int _num_threads);
+void   ofdmflexframesync_stop_pool   (ofdmflexframesync _q);
+void * ofdmflexframesync_worker      (void * _arg);
+void   ofdmflexframesync_submit_job  (ofdmflexframesync _q);
+void   ofdmflexframesync_deliver_jobs(ofdmflexframesync _q, int _block);
+
+// payload decoding job for threaded operation; subcarrier demodulation
+// runs on the ingest thread while the FEC decode of each completed
+// frame's bit/LLR buffer is handed to a worker, with callbacks invoked
+// in detection order from the ingest thread
+struct ofdmflexframesync_job_s {
+    enum {
+        OFDMFLEXFRAMESYNC_JOB_FREE=0,   // slot is available
+        OFDMFLEXFRAMESYNC_JOB_PENDING,  // queued, waiting for a worker
+        OFDMFLEXFRAMESYNC_JOB_RUNNING,  // worker is decoding payload
+        OFDMFLEXFRAMESYNC_JOB_DONE,     // decoded, waiting for delivery
+    }               state;              // job state
+
+    // frame configuration (from decoded header)
+    unsigned char * header;             // decoded header (copy)
+    int             header_valid;       // header CRC flag
+    unsigned int    payload_len;        // payload data (length)
+    int             check;              // payload validity check
+    int             fec0;               // payload FEC (inner)
+    int             fec1;               // payload FEC (outer)
+    int             payload_soft;       // payload is soft (LLR) bits
+
+    // demodulated payload bits/LLRs and decoder output
+    unsigned char * payload_enc;        // payload bit/LLR buffer (demodulated)
+    unsigned int    payload_enc_len;    // payload bit/LLR buffer (length)
+    float complex * payload_syms;       // payload symbols (received)
+    unsigned int    payload_mod_len;    // payload symbols (length)
+    unsigned char * payload_dec;        // payload data (bytes)
+    int             payload_valid;      // payload CRC flag
+    framesyncstats_s stats;             // frame statistics snapshot
+
+    // allocated buffer lengths (grow-only)
+    unsigned int    buf_header_len;     // header allocation
+    unsigned int    buf_enc_len;        // payload_enc allocation
+    unsigned int    buf_sym_len;        // payload_syms allocation
+    unsigned int    buf_dec_len;        // payload_dec allocation
+};
+
 static ofdmflexframegenprops_s ofdmflexframesyncprops_header_default = {
     OFDMFLEXFRAME_H_CRC,
     OFDMFLEXFRAME_H_FEC0,
@@ -123,6 +173,18 @@ struct ofdmflexframesync_s {
     // internal synchronizer objects
     ofdmframesync fs;                   // internal OFDM frame synchronizer
 
+    // worker pool for threaded payload decoding
+    unsigned int    num_threads;        // number of workers (0: serial operation)
+    pthread_t       threads[OFDMFLEXFRAMESYNC_MAX_THREADS];
+    pthread_mutex_t job_mutex;          // job queue mutex
+    pthread_cond_t  job_submitted;      // signal: job queued (or pool shutting down)
+    pthread_cond_t  job_completed;      // signal: worker finished a job
+    int             pool_running;       // workers should keep running?
+    struct ofdmflexframesync_job_s jobs[OFDMFLEXFRAMESYNC_NUM_JOBS]; // job queue (ring)
+    unsigned int    job_head;           // oldest outstanding job (next delivery)
+    unsigned int    job_tail;           // next slot to fill
+    unsigned int    job_count;          // number of outstanding jobs
+
     // counters/states
     unsigned int symbol_counter;        // received symbol number
     enum {
@@ -213,6 +275,14 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     q->payload_syms = (float complex *) malloc(q->payload_len*sizeof(float complex));
     q->payload_mod_len = 0;
 
+    // threaded payload decoding disabled by default
+    q->num_threads  = 0;
+    q->pool_running = 0;
+    q->job_head     = 0;
+    q->job_tail     = 0;
+    q->job_count    = 0;
+    memset(q->jobs, 0x00, sizeof(q->jobs));
+
     // reset state
     ofdmflexframesync_reset_framedatastats(q);
     ofdmflexframesync_reset(q);
@@ -223,6 +293,19 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
 void ofdmflexframesync_destroy(ofdmflexframesync _q)
 {
+    // shut down worker pool, delivering any outstanding frames
+    if (_q->num_threads > 0)
+        ofdmflexframesync_stop_pool(_q);
+
+    // free payload decoding job buffers
+    unsigned int i;
+    for (i=0; i<OFDMFLEXFRAMESYNC_NUM_JOBS; i++) {
+        free(_q->jobs[i].header);
+        free(_q->jobs[i].payload_enc);
+        free(_q->jobs[i].payload_syms);
+        free(_q->jobs[i].payload_dec);
+    }
+
     // destroy internal objects
     ofdmframesync_destroy(_q->fs);
     packetizer_destroy(_q->p_header);
@@ -359,6 +442,10 @@ void ofdmflexframesync_execute(ofdmflexframesync _q,
 {
     // push samples through ofdmframesync object
     ofdmframesync_execute(_q->fs, _x, _n);
+
+    // threaded operation: deliver completed frames in detection order
+    if (_q->num_threads > 0)
+        ofdmflexframesync_deliver_jobs(_q, 0);
 }
 
 // 
@@ -734,6 +821,25 @@ void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
             _q->payload_symbol_index++;
 
             if (_q->payload_symbol_index == _q->payload_mod_len) {
+                // set framesyncstats internals
+                _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
+                _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
+                _q->framesyncstats.mod_scheme    = _q->ms_payload;
+                _q->framesyncstats.mod_bps       = _q->bps_payload;
+                _q->framesyncstats.check         = _q->check;
+                _q->framesyncstats.fec0          = _q->fec0;
+                _q->framesyncstats.fec1          = _q->fec1;
+
+                // threaded operation: hand the demodulated bit/LLR
+                // buffer off to the worker pool; statistics are updated
+                // and the callback invoked (in detection order) when
+                // the frame is delivered
+                if (_q->num_threads > 0) {
+                    ofdmflexframesync_submit_job(_q);
+                    ofdmflexframesync_reset(_q);
+                    break;
+                }
+
                 // payload extracted
                 if (_q->payload_soft) {
                     _q->payload_valid = packetizer_decode_soft(_q->p_payload, _q->payload_enc, _q->payload_dec);
@@ -748,16 +854,9 @@ void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                 _q->framedatastats.num_payloads_valid += _q->payload_valid;
                 _q->framedatastats.num_bytes_received += _q->payload_len;
 
-                // set framesyncstats internals
-                _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
-                _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
+                // set frame symbols (callback-scoped pointers)
                 _q->framesyncstats.framesyms     = _q->payload_syms;
                 _q->framesyncstats.num_framesyms = _q->payload_mod_len;
-                _q->framesyncstats.mod_scheme    = _q->ms_payload;
-                _q->framesyncstats.mod_bps       = _q->bps_payload;
-                _q->framesyncstats.check         = _q->check;
-                _q->framesyncstats.fec0          = _q->fec0;
-                _q->framesyncstats.fec1          = _q->fec1;
 
                 // ignore callback if set to NULL
                 if (_q->callback == NULL) {
@@ -785,3 +884,222 @@ void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
 
 
 
+
+// set number of internal payload decoding threads (0: serial operation);
+// any outstanding frames are delivered before the worker count changes
+void ofdmflexframesync_set_threads(ofdmflexframesync _q,
+                                   unsigned int      _num_threads)
+{
+    // cap number of workers
+    if (_num_threads > OFDMFLEXFRAMESYNC_MAX_THREADS)
+        _num_threads = OFDMFLEXFRAMESYNC_MAX_THREADS;
+
+    // return if number of workers has not changed
+    if (_num_threads == _q->num_threads)
+        return;
+
+    // stop existing worker pool, delivering outstanding frames
+    if (_q->num_threads > 0)
+        ofdmflexframesync_stop_pool(_q);
+
+    // start new worker pool
+    if (_num_threads > 0)
+        ofdmflexframesync_start_pool(_q, _num_threads);
+}
+
+// start worker pool for threaded payload decoding
+void ofdmflexframesync_start_pool(ofdmflexframesync _q,
+                                  unsigned int      _num_threads)
+{
+    pthread_mutex_init(&_q->job_mutex,     NULL);
+    pthread_cond_init (&_q->job_submitted, NULL);
+    pthread_cond_init (&_q->job_completed, NULL);
+    _q->pool_running = 1;
+    _q->num_threads  = _num_threads;
+
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++)
+        pthread_create(&_q->threads[i], NULL, ofdmflexframesync_worker, (void*)_q);
+}
+
+// stop worker pool, delivering any outstanding frames first
+void ofdmflexframesync_stop_pool(ofdmflexframesync _q)
+{
+    // deliver outstanding frames before shutting workers down
+    ofdmflexframesync_deliver_jobs(_q, 1);
+
+    // clear running flag and wake all workers
+    pthread_mutex_lock(&_q->job_mutex);
+    _q->pool_running = 0;
+    pthread_cond_broadcast(&_q->job_submitted);
+    pthread_mutex_unlock(&_q->job_mutex);
+
+    // wait for workers to exit
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++)
+        pthread_join(_q->threads[i], NULL);
+    _q->num_threads = 0;
+
+    pthread_mutex_destroy(&_q->job_mutex);
+    pthread_cond_destroy (&_q->job_submitted);
+    pthread_cond_destroy (&_q->job_completed);
+}
+
+// payload decoding worker; each worker owns its own packetizer object
+// and pulls the oldest pending job from the queue
+void * ofdmflexframesync_worker(void * _arg)
+{
+    ofdmflexframesync _q = (ofdmflexframesync) _arg;
+    packetizer p = packetizer_create(1, LIQUID_CRC_NONE, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+    pthread_mutex_lock(&_q->job_mutex);
+    while (1) {
+        // find oldest pending job in the queue
+        struct ofdmflexframesync_job_s * job = NULL;
+        unsigned int i;
+        for (i=0; i<_q->job_count; i++) {
+            struct ofdmflexframesync_job_s * j =
+                &_q->jobs[(_q->job_head + i) % OFDMFLEXFRAMESYNC_NUM_JOBS];
+            if (j->state == OFDMFLEXFRAMESYNC_JOB_PENDING) {
+                job = j;
+                break;
+            }
+        }
+
+        // no work available: wait for a submission (or exit on shutdown)
+        if (job == NULL) {
+            if (!_q->pool_running)
+                break;
+            pthread_cond_wait(&_q->job_submitted, &_q->job_mutex);
+            continue;
+        }
+
+        // claim job and decode payload outside the lock
+        job->state = OFDMFLEXFRAMESYNC_JOB_RUNNING;
+        pthread_mutex_unlock(&_q->job_mutex);
+
+        p = packetizer_recreate(p, job->payload_len, job->check, job->fec0, job->fec1);
+        if (job->payload_soft) {
+            job->payload_valid = packetizer_decode_soft(p, job->payload_enc, job->payload_dec);
+        } else {
+            job->payload_valid = packetizer_decode(p, job->payload_enc, job->payload_dec);
+        }
+
+        // mark job complete and notify the ingest thread
+        pthread_mutex_lock(&_q->job_mutex);
+        job->state = OFDMFLEXFRAMESYNC_JOB_DONE;
+        pthread_cond_signal(&_q->job_completed);
+    }
+    pthread_mutex_unlock(&_q->job_mutex);
+
+    packetizer_destroy(p);
+    return NULL;
+}
+
+// copy frame state into the next job slot and wake a worker; called from
+// the ingest thread once the demodulated bit/LLR buffer is complete
+void ofdmflexframesync_submit_job(ofdmflexframesync _q)
+{
+    // make room in the queue, delivering completed frames; if the queue
+    // is still full (workers lagging) block until it has drained
+    ofdmflexframesync_deliver_jobs(_q, 0);
+    if (_q->job_count == OFDMFLEXFRAMESYNC_NUM_JOBS)
+        ofdmflexframesync_deliver_jobs(_q, 1);
+
+    // claim next slot; workers ignore it until it is marked pending
+    struct ofdmflexframesync_job_s * job = &_q->jobs[_q->job_tail];
+
+    // grow internal buffers as needed
+    if (_q->header_dec_len > job->buf_header_len) {
+        job->header = (unsigned char*) realloc(job->header, _q->header_dec_len*sizeof(unsigned char));
+        job->buf_header_len = _q->header_dec_len;
+    }
+    if (_q->payload_enc_len > job->buf_enc_len) {
+        job->payload_enc = (unsigned char*) realloc(job->payload_enc, _q->payload_enc_len*sizeof(unsigned char));
+        job->buf_enc_len = _q->payload_enc_len;
+    }
+    if (_q->payload_mod_len > job->buf_sym_len) {
+        job->payload_syms = (float complex*) realloc(job->payload_syms, _q->payload_mod_len*sizeof(float complex));
+        job->buf_sym_len = _q->payload_mod_len;
+    }
+    if (_q->payload_len > job->buf_dec_len) {
+        job->payload_dec = (unsigned char*) realloc(job->payload_dec, _q->payload_len*sizeof(unsigned char));
+        job->buf_dec_len = _q->payload_len;
+    }
+    if (job->header == NULL || job->payload_enc == NULL ||
+        job->payload_syms == NULL || job->payload_dec == NULL)
+    {
+        fprintf(stderr,"error: ofdmflexframesync_submit_job(), could not re-allocate job arrays\n");
+        exit(1);
+    }
+
+    // copy frame configuration and demodulated payload bits/LLRs
+    memmove(job->header,       _q->header,       _q->header_dec_len *sizeof(unsigned char));
+    memmove(job->payload_enc,  _q->payload_enc,  _q->payload_enc_len*sizeof(unsigned char));
+    memmove(job->payload_syms, _q->payload_syms, _q->payload_mod_len*sizeof(float complex));
+    job->header_valid    = _q->header_valid;
+    job->payload_len     = _q->payload_len;
+    job->payload_enc_len = _q->payload_enc_len;
+    job->payload_mod_len = _q->payload_mod_len;
+    job->payload_soft    = _q->payload_soft;
+    job->check           = _q->check;
+    job->fec0            = _q->fec0;
+    job->fec1            = _q->fec1;
+    job->stats           = _q->framesyncstats;
+
+    // mark job as pending and wake a worker
+    pthread_mutex_lock(&_q->job_mutex);
+    job->state   = OFDMFLEXFRAMESYNC_JOB_PENDING;
+    _q->job_tail = (_q->job_tail + 1) % OFDMFLEXFRAMESYNC_NUM_JOBS;
+    _q->job_count++;
+    pthread_cond_signal(&_q->job_submitted);
+    pthread_mutex_unlock(&_q->job_mutex);
+}
+
+// update statistics and invoke callbacks for completed jobs at the head
+// of the queue, preserving detection order
+//  _q      :   frame synchronizer object
+//  _block  :   wait until all outstanding jobs have been delivered?
+void ofdmflexframesync_deliver_jobs(ofdmflexframesync _q,
+                                    int               _block)
+{
+    pthread_mutex_lock(&_q->job_mutex);
+    while (_q->job_count > 0) {
+        struct ofdmflexframesync_job_s * job = &_q->jobs[_q->job_head];
+
+        // oldest job still in flight: wait for a worker or stop early
+        if (job->state != OFDMFLEXFRAMESYNC_JOB_DONE) {
+            if (!_block)
+                break;
+            pthread_cond_wait(&_q->job_completed, &_q->job_mutex);
+            continue;
+        }
+
+        // release lock while delivering; workers never touch completed jobs
+        pthread_mutex_unlock(&_q->job_mutex);
+
+        // update statistics
+        _q->framedatastats.num_payloads_valid += job->payload_valid;
+        _q->framedatastats.num_bytes_received += job->payload_len;
+
+        // invoke callback
+        if (_q->callback != NULL) {
+            job->stats.framesyms     = job->payload_syms;
+            job->stats.num_framesyms = job->payload_mod_len;
+            _q->callback(job->header,
+                         job->header_valid,
+                         job->payload_dec,
+                         job->payload_len,
+                         job->payload_valid,
+                         job->stats,
+                         _q->userdata);
+        }
+
+        // free slot and advance queue head
+        pthread_mutex_lock(&_q->job_mutex);
+        job->state   = OFDMFLEXFRAMESYNC_JOB_FREE;
+        _q->job_head = (_q->job_head + 1) % OFDMFLEXFRAMESYNC_NUM_JOBS;
+        _q->job_count--;
+    }
+    pthread_mutex_unlock(&_q->job_mutex);
+}
@@ -36,6 +36,9 @@
 #define DEBUG_QDETECTOR_PRINT        0
 #define DEBUG_QDETECTOR_FILENAME     "qdetector_cccf_debug.m"
 
+// maximum number of detection templates
+#define QDETECTOR_CCCF_MAX_TEMPLATES (8)
+
 // seek signal (initial detection)
 void qdetector_cccf_execute_seek(qdetector_cccf _q,
                                  float complex  _x);
@@ -51,6 +54,17 @@ struct qdetector_cccf_s {
     float complex * S;              // template (freq), [size: nfft x 1]
     float           s2_sum;         // sum{ s^2 }
 
+    // detection templates; all templates share the same transform size
+    // and are correlated against a single forward transform of the
+    // input; 's', 'S', 's2_sum', and 's_len' above alias the active
+    // template (most recent detection, used for alignment)
+    unsigned int    num_templates;  // number of detection templates
+    unsigned int    tpl_index;      // template index of most recent detection
+    float complex * tpl_s  [QDETECTOR_CCCF_MAX_TEMPLATES];  // templates (time)
+    float complex * tpl_S  [QDETECTOR_CCCF_MAX_TEMPLATES];  // templates (freq)
+    float           tpl_s2 [QDETECTOR_CCCF_MAX_TEMPLATES];  // sum{ s^2 }
+    unsigned int    tpl_len[QDETECTOR_CCCF_MAX_TEMPLATES];  // time lengths
+
     float complex * buf_time_0;     // time-domain buffer (FFT)
     float complex * buf_freq_0;     // frequence-domain buffer (FFT)
     float complex * buf_freq_1;     // frequence-domain buffer (IFFT)
@@ -97,10 +111,13 @@ qdetector_cccf qdetector_cccf_create(float complex * _s,
     qdetector_cccf q = (qdetector_cccf) malloc(sizeof(struct qdetector_cccf_s));
     q->s_len = _s_len;
 
-    // allocate memory and copy sequence
-    q->s = (float complex*) malloc(q->s_len * sizeof(float complex));
-    memmove(q->s, _s, q->s_len*sizeof(float complex));
-    q->s2_sum = liquid_sumsqcf(q->s, q->s_len); // compute sum{ s^2 }
+    // allocate memory and copy sequence (first template)
+    q->num_templates = 1;
+    q->tpl_index     = 0;
+    q->tpl_len[0]    = q->s_len;
+    q->tpl_s[0]      = (float complex*) malloc(q->s_len * sizeof(float complex));
+    memmove(q->tpl_s[0], _s, q->s_len*sizeof(float complex));
+    q->tpl_s2[0] = liquid_sumsqcf(q->tpl_s[0], q->s_len); // compute sum{ s^2 }
 
     // prepare transforms
     q->nfft       = 1 << liquid_nextpow2( (unsigned int)( 2 * q->s_len ) ); // NOTE: must be even
@@ -113,11 +130,16 @@ qdetector_cccf qdetector_cccf_create(float complex * _s,
     q->ifft = fft_create_plan(q->nfft, q->buf_freq_1, q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
 
     // create frequency-domain template by taking nfft-point transform on 's', storing in 'S'
-    q->S = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->tpl_S[0] = (float complex*) malloc(q->nfft * sizeof(float complex));
     memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
-    memmove(q->buf_time_0, q->s, q->s_len*sizeof(float complex));
+    memmove(q->buf_time_0, q->tpl_s[0], q->s_len*sizeof(float complex));
     fft_execute(q->fft);
-    memmove(q->S, q->buf_freq_0, q->nfft*sizeof(float complex));
+    memmove(q->tpl_S[0], q->buf_freq_0, q->nfft*sizeof(float complex));
+
+    // set active template
+    q->s      = q->tpl_s[0];
+    q->S      = q->tpl_S[0];
+    q->s2_sum = q->tpl_s2[0];
 
     // reset state variables
     q->counter        = q->nfft/2;
@@ -289,11 +311,85 @@ qdetector_cccf qdetector_cccf_create_cpfsk(unsigned char * _sequence,
     return q;
 }
 
+// copy detector object, re-using the pre-computed template spectrum of
+// the original; this avoids the cost of re-generating and transforming
+// the template when many detectors share the same preamble (e.g.
+// stamping out a new detector after a channel re-tune)
+qdetector_cccf qdetector_cccf_copy(qdetector_cccf _q_orig)
+{
+    // validate input
+    if (_q_orig == NULL) {
+        fprintf(stderr,"error: qdetector_cccf_copy(), object cannot be NULL\n");
+        exit(1);
+    }
+
+    // allocate memory for main object and copy template properties
+    qdetector_cccf q = (qdetector_cccf) malloc(sizeof(struct qdetector_cccf_s));
+    q->nfft = _q_orig->nfft;
+
+    // copy time- and frequency-domain templates directly rather than
+    // re-computing the transforms
+    q->num_templates = _q_orig->num_templates;
+    q->tpl_index     = 0;
+    unsigned int t;
+    for (t=0; t<q->num_templates; t++) {
+        q->tpl_len[t] = _q_orig->tpl_len[t];
+        q->tpl_s2 [t] = _q_orig->tpl_s2 [t];
+        q->tpl_s  [t] = (float complex*) malloc(q->tpl_len[t] * sizeof(float complex));
+        q->tpl_S  [t] = (float complex*) malloc(q->nfft       * sizeof(float complex));
+        memmove(q->tpl_s[t], _q_orig->tpl_s[t], q->tpl_len[t]*sizeof(float complex));
+        memmove(q->tpl_S[t], _q_orig->tpl_S[t], q->nfft      *sizeof(float complex));
+    }
+
+    // set active template
+    q->s      = q->tpl_s[0];
+    q->S      = q->tpl_S[0];
+    q->s_len  = q->tpl_len[0];
+    q->s2_sum = q->tpl_s2[0];
+
+    // allocate internal buffers and prepare transforms
+    q->buf_time_0 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_0 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_1 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_time_1 = (float complex*) malloc(q->nfft * sizeof(float complex));
+
+    q->fft  = fft_create_plan(q->nfft, q->buf_time_0, q->buf_freq_0, LIQUID_FFT_FORWARD,  0);
+    q->ifft = fft_create_plan(q->nfft, q->buf_freq_1, q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
+
+    // reset state variables
+    q->counter        = q->nfft/2;
+    q->num_transforms = 0;
+    q->x2_sum_0       = 0.0f;
+    q->x2_sum_1       = 0.0f;
+    q->state          = QDETECTOR_STATE_SEEK;
+    q->frame_detected = 0;
+    memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
+
+    // reset estimates
+    q->rxy       = 0.0f;
+    q->tau_hat   = 0.0f;
+    q->gamma_hat = 0.0f;
+    q->dphi_hat  = 0.0f;
+    q->phi_hat   = 0.0f;
+
+    // copy detection threshold and carrier offset search range
+    q->threshold = _q_orig->threshold;
+    q->range     = _q_orig->range;
+
+    // return object
+    return q;
+}
+
 void qdetector_cccf_destroy(qdetector_cccf _q)
 {
+    // free detection templates
+    unsigned int t;
+    for (t=0; t<_q->num_templates; t++) {
+        free(_q->tpl_s[t]);
+        free(_q->tpl_S[t]);
+    }
+
     // free allocated arrays
-    free(_q->s         );
-    free(_q->S         );
     free(_q->buf_time_0);
     free(_q->buf_freq_0);
     free(_q->buf_freq_1);
@@ -310,6 +406,7 @@ void qdetector_cccf_destroy(qdetector_cccf _q)
 void qdetector_cccf_print(qdetector_cccf _q)
 {
     printf("qdetector_cccf:\n");
+    printf("  number of templates   :   %-u\n",   _q->num_templates);
     printf("  template length (time):   %-u\n",   _q->s_len);
     printf("  FFT size              :   %-u\n",   _q->nfft);
     printf("  search range (bins)   :   %-d\n",   _q->range);
@@ -321,6 +418,132 @@ void qdetector_cccf_reset(qdetector_cccf _q)
 {
 }
 
+// set new template and reset detector state; internal buffers and
+// transform plans are re-used when the transform size is unchanged,
+// making this considerably cheaper than re-creating the detector
+//  _q      :   detector object
+//  _s      :   new sample sequence
+//  _s_len  :   length of sample sequence
+void qdetector_cccf_reset_template(qdetector_cccf  _q,
+                                   float complex * _s,
+                                   unsigned int    _s_len)
+{
+    // validate input
+    if (_s_len == 0) {
+        fprintf(stderr,"error: qdetector_cccf_reset_template(), sequence length cannot be zero\n");
+        exit(1);
+    }
+
+    // drop all but the first template
+    unsigned int t;
+    for (t=1; t<_q->num_templates; t++) {
+        free(_q->tpl_s[t]);
+        free(_q->tpl_S[t]);
+    }
+    _q->num_templates = 1;
+    _q->tpl_index     = 0;
+
+    // copy new time-domain sequence
+    if (_s_len != _q->tpl_len[0]) {
+        _q->tpl_s[0]   = (float complex*) realloc(_q->tpl_s[0], _s_len*sizeof(float complex));
+        _q->tpl_len[0] = _s_len;
+    }
+    memmove(_q->tpl_s[0], _s, _s_len*sizeof(float complex));
+    _q->tpl_s2[0] = liquid_sumsqcf(_q->tpl_s[0], _s_len); // compute sum{ s^2 }
+    _q->s_len  = _q->tpl_len[0];
+    _q->s2_sum = _q->tpl_s2[0];
+
+    // re-create internal buffers and transform plans only if the
+    // transform size changed
+    unsigned int nfft = 1 << liquid_nextpow2( (unsigned int)( 2 * _q->s_len ) );
+    if (nfft != _q->nfft) {
+        // scale carrier offset search range to maintain angular range
+        _q->range = (int)( (float)_q->range * (float)nfft / (float)_q->nfft );
+
+        _q->nfft       = nfft;
+        _q->tpl_S[0]   = (float complex*) realloc(_q->tpl_S[0],   _q->nfft*sizeof(float complex));
+        _q->buf_time_0 = (float complex*) realloc(_q->buf_time_0, _q->nfft*sizeof(float complex));
+        _q->buf_freq_0 = (float complex*) realloc(_q->buf_freq_0, _q->nfft*sizeof(float complex));
+        _q->buf_freq_1 = (float complex*) realloc(_q->buf_freq_1, _q->nfft*sizeof(float complex));
+        _q->buf_time_1 = (float complex*) realloc(_q->buf_time_1, _q->nfft*sizeof(float complex));
+
+        fft_destroy_plan(_q->fft);
+        fft_destroy_plan(_q->ifft);
+        _q->fft  = fft_create_plan(_q->nfft, _q->buf_time_0, _q->buf_freq_0, LIQUID_FFT_FORWARD,  0);
+        _q->ifft = fft_create_plan(_q->nfft, _q->buf_freq_1, _q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
+    }
+
+    // re-compute frequency-domain template and set active template
+    memset(_q->buf_time_0, 0x00, _q->nfft*sizeof(float complex));
+    memmove(_q->buf_time_0, _q->tpl_s[0], _q->s_len*sizeof(float complex));
+    fft_execute(_q->fft);
+    memmove(_q->tpl_S[0], _q->buf_freq_0, _q->nfft*sizeof(float complex));
+    _q->s = _q->tpl_s[0];
+    _q->S = _q->tpl_S[0];
+
+    // reset state variables
+    _q->counter        = _q->nfft/2;
+    _q->num_transforms = 0;
+    _q->x2_sum_0       = 0.0f;
+    _q->x2_sum_1       = 0.0f;
+    _q->state          = QDETECTOR_STATE_SEEK;
+    _q->frame_detected = 0;
+    memset(_q->buf_time_0, 0x00, _q->nfft*sizeof(float complex));
+
+    // reset estimates
+    _q->rxy       = 0.0f;
+    _q->tau_hat   = 0.0f;
+    _q->gamma_hat = 0.0f;
+    _q->dphi_hat  = 0.0f;
+    _q->phi_hat   = 0.0f;
+}
+
+// add detection template, searching all templates simultaneously with a
+// single forward transform of the input per block; the new template must
+// yield the same transform size as the existing one(s); resets detector
+// state
+//  _q      :   detector object
+//  _s      :   additional sample sequence
+//  _s_len  :   length of sample sequence
+void qdetector_cccf_add_template(qdetector_cccf  _q,
+                                 float complex * _s,
+                                 unsigned int    _s_len)
+{
+    // validate input
+    if (_s_len == 0) {
+        fprintf(stderr,"error: qdetector_cccf_add_template(), sequence length cannot be zero\n");
+        exit(1);
+    } else if ( (1 << liquid_nextpow2((unsigned int)(2*_s_len))) != _q->nfft ) {
+        fprintf(stderr,"error: qdetector_cccf_add_template(), template transform size does not match\n");
+        exit(1);
+    } else if (_q->num_templates == QDETECTOR_CCCF_MAX_TEMPLATES) {
+        fprintf(stderr,"error: qdetector_cccf_add_template(), maximum number of templates (%u) exceeded\n",
+                QDETECTOR_CCCF_MAX_TEMPLATES);
+        exit(1);
+    }
+
+    // copy sequence and compute frequency-domain template
+    unsigned int t = _q->num_templates;
+    _q->tpl_len[t] = _s_len;
+    _q->tpl_s[t]   = (float complex*) malloc(_s_len   * sizeof(float complex));
+    _q->tpl_S[t]   = (float complex*) malloc(_q->nfft * sizeof(float complex));
+    memmove(_q->tpl_s[t], _s, _s_len*sizeof(float complex));
+    _q->tpl_s2[t] = liquid_sumsqcf(_q->tpl_s[t], _s_len); // compute sum{ s^2 }
+    memset(_q->buf_time_0, 0x00, _q->nfft*sizeof(float complex));
+    memmove(_q->buf_time_0, _q->tpl_s[t], _s_len*sizeof(float complex));
+    fft_execute(_q->fft);
+    memmove(_q->tpl_S[t], _q->buf_freq_0, _q->nfft*sizeof(float complex));
+    _q->num_templates++;
+
+    // reset state variables
+    _q->counter        = _q->nfft/2;
+    _q->x2_sum_0       = 0.0f;
+    _q->x2_sum_1       = 0.0f;
+    _q->state          = QDETECTOR_STATE_SEEK;
+    _q->frame_detected = 0;
+    memset(_q->buf_time_0, 0x00, _q->nfft*sizeof(float complex));
+}
+
 void * qdetector_cccf_execute(qdetector_cccf _q,
                               float complex  _x)
 {
@@ -362,11 +585,14 @@ void qdetector_cccf_set_threshold(qdetector_cccf _q,
     _q->threshold = _threshold;
 }
 
-// set carrier offset search range
+// set carrier offset search range; each hypothesis shifts the template
+// spectrum by one transform bin against the single forward transform of
+// the input, so wide ranges add correlation work but no extra forward
+// transforms; limited to half the sampling bandwidth
 void qdetector_cccf_set_range(qdetector_cccf _q,
                               float          _dphi_max)
 {
-    if (_dphi_max < 0.0f || _dphi_max > 0.5f) {
+    if (_dphi_max < 0.0f || _dphi_max >= M_PI) {
         fprintf(stderr,"warning: carrier offset search range (%12.4e) out of range; ignoring\n", _dphi_max);
         return;
     }
@@ -383,6 +609,12 @@ unsigned int qdetector_cccf_get_seq_len(qdetector_cccf _q)
     return _q->s_len;
 }
 
+// index of template which generated the most recent detection
+unsigned int qdetector_cccf_get_template_index(qdetector_cccf _q)
+{
+    return _q->tpl_index;
+}
+
 // pointer to sequence
 const void * qdetector_cccf_get_sequence(qdetector_cccf _q)
 {
@@ -450,11 +682,12 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
     fft_execute(_q->fft);
 
     // compute scaling factor (TODO: use median rather than mean signal level)
+    // NOTE: template-dependent factor sqrt{s_len} is applied per template below
     float g0;
     if (_q->x2_sum_0 == 0.f) {
-        g0 = sqrtf(_q->x2_sum_1) * sqrtf((float)(_q->s_len) / (float)(_q->nfft / 2));
+        g0 = sqrtf(_q->x2_sum_1) / sqrtf((float)(_q->nfft / 2));
     } else {
-        g0 = sqrtf(_q->x2_sum_0 + _q->x2_sum_1) * sqrtf((float)(_q->s_len) / (float)(_q->nfft));
+        g0 = sqrtf(_q->x2_sum_0 + _q->x2_sum_1) / sqrtf((float)(_q->nfft));
     }
     if (g0 < 1e-10) {
         memmove(_q->buf_time_0,
@@ -466,58 +699,67 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
         _q->x2_sum_1 = 0.0f;
         return;
     }
-    float g = 1.0f / ((float)(_q->nfft) * g0 * sqrtf(_q->s2_sum));
-    
-    // sweep over carrier frequency offset range
-    int offset;
+
+    // correlate input spectrum against each template, re-using the
+    // single forward transform of the input for all of them
+    unsigned int t;
     unsigned int i;
     float        rxy_peak   = 0.0f;
     unsigned int rxy_index  = 0;
     int          rxy_offset = 0;
-    // NOTE: this offset may be coarse as a fine carrier estimate is computed later
-    for (offset=-_q->range; offset<=_q->range; offset++) {
+    unsigned int rxy_tpl    = 0;
+    for (t=0; t<_q->num_templates; t++) {
+        // template-dependent scaling factor
+        float g = 1.0f / ((float)(_q->nfft) * g0 * sqrtf((float)(_q->tpl_len[t]) * _q->tpl_s2[t]));
+
+        // sweep over carrier frequency offset range
+        int offset;
+        // NOTE: this offset may be coarse as a fine carrier estimate is computed later
+        for (offset=-_q->range; offset<=_q->range; offset++) {
+
+            // cross-multiply, aligning appropriately
+            for (i=0; i<_q->nfft; i++) {
+                // shifted index
+                unsigned int j = (i + _q->nfft - offset) % _q->nfft;
+
+                _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->tpl_S[t][j]);
+            }
 
-        // cross-multiply, aligning appropriately
-        for (i=0; i<_q->nfft; i++) {
-            // shifted index
-            unsigned int j = (i + _q->nfft - offset) % _q->nfft;
+            // run inverse transform
+            fft_execute(_q->ifft);
 
-            _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->S[j]);
-        }
-
-        // run inverse transform
-        fft_execute(_q->ifft);
-        
-        // scale output appropriately
-        liquid_vectorcf_mulscalar(_q->buf_time_1, _q->nfft, g, _q->buf_time_1);
+            // scale output appropriately
+            liquid_vectorcf_mulscalar(_q->buf_time_1, _q->nfft, g, _q->buf_time_1);
 
 #if DEBUG_QDETECTOR
-        // debug output
-        char filename[64];
-        sprintf(filename,"qdetector_out_%u_%d.m", _q->num_transforms, offset+2);
-        FILE * fid = fopen(filename, "w");
-        fprintf(fid,"clear all; close all;\n");
-        fprintf(fid,"nfft = %u;\n", _q->nfft);
-        for (i=0; i<_q->nfft; i++)
-            fprintf(fid,"rxy(%6u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(_q->buf_time_1[i]), cimagf(_q->buf_time_1[i]));
-        fprintf(fid,"figure;\n");
-        fprintf(fid,"t=[0:(nfft-1)];\n");
-        fprintf(fid,"plot(t,abs(rxy));\n");
-        fprintf(fid,"grid on;\n");
-        fprintf(fid,"axis([0 %u 0 1.5]);\n", _q->nfft);
-        fprintf(fid,"[v i] = max(abs(rxy));\n");
-        fprintf(fid,"title(sprintf('peak of %%12.8f at index %%u', v, i));\n");
-        fclose(fid);
-        printf("debug: %s\n", filename);
+            // debug output
+            char filename[64];
+            sprintf(filename,"qdetector_out_%u_%d.m", _q->num_transforms, offset+2);
+            FILE * fid = fopen(filename, "w");
+            fprintf(fid,"clear all; close all;\n");
+            fprintf(fid,"nfft = %u;\n", _q->nfft);
+            for (i=0; i<_q->nfft; i++)
+                fprintf(fid,"rxy(%6u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(_q->buf_time_1[i]), cimagf(_q->buf_time_1[i]));
+            fprintf(fid,"figure;\n");
+            fprintf(fid,"t=[0:(nfft-1)];\n");
+            fprintf(fid,"plot(t,abs(rxy));\n");
+            fprintf(fid,"grid on;\n");
+            fprintf(fid,"axis([0 %u 0 1.5]);\n", _q->nfft);
+            fprintf(fid,"[v i] = max(abs(rxy));\n");
+            fprintf(fid,"title(sprintf('peak of %%12.8f at index %%u', v, i));\n");
+            fclose(fid);
+            printf("debug: %s\n", filename);
 #endif
-        // search for peak
-        // TODO: only search over range [-nfft/2, nfft/2)
-        for (i=0; i<_q->nfft; i++) {
-            float rxy_abs = cabsf(_q->buf_time_1[i]);
-            if (rxy_abs > rxy_peak) {
-                rxy_peak   = rxy_abs;
-                rxy_index  = i;
-                rxy_offset = offset;
+            // search for peak
+            // TODO: only search over range [-nfft/2, nfft/2)
+            for (i=0; i<_q->nfft; i++) {
+                float rxy_abs = cabsf(_q->buf_time_1[i]);
+                if (rxy_abs > rxy_peak) {
+                    rxy_peak   = rxy_abs;
+                    rxy_index  = i;
+                    rxy_offset = offset;
+                    rxy_tpl    = t;
+                }
             }
         }
     }
@@ -525,10 +767,17 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
     // increment number of transforms (debugging)
     _q->num_transforms++;
 
-    if (rxy_peak > _q->threshold && rxy_index < _q->nfft - _q->s_len) {
+    if (rxy_peak > _q->threshold && rxy_index < _q->nfft - _q->tpl_len[rxy_tpl]) {
 #if DEBUG_QDETECTOR_PRINT
-        printf("*** frame detected! rxy = %12.8f, time index=%u, freq. offset=%d\n", rxy_peak, rxy_index, rxy_offset);
+        printf("*** frame detected! rxy = %12.8f, time index=%u, freq. offset=%d, template=%u\n", rxy_peak, rxy_index, rxy_offset, rxy_tpl);
 #endif
+        // set active template for alignment stage
+        _q->tpl_index = rxy_tpl;
+        _q->s         = _q->tpl_s  [rxy_tpl];
+        _q->S         = _q->tpl_S  [rxy_tpl];
+        _q->s_len     = _q->tpl_len[rxy_tpl];
+        _q->s2_sum    = _q->tpl_s2 [rxy_tpl];
+
         // update state, reset counter, copy buffer appropriately
         _q->state = QDETECTOR_STATE_ALIGN;
         _q->offset = rxy_offset;
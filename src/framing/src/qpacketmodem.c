@@ -35,6 +35,10 @@
 
 #include "liquid.internal.h"
 
+// batch size for block soft demodulation (bounds stack scratch space
+// while keeping the table-driven demodulator running on long runs)
+#define QPACKETMODEM_BLOCK_LEN (256)
+
 struct qpacketmodem_s {
     // properties
     modem           mod_payload;        // payload modulator/demodulator
@@ -43,6 +47,8 @@ struct qpacketmodem_s {
     unsigned int    payload_dec_len;    // number of decoded payload bytes
     unsigned char * payload_enc;        // payload data (encoded bytes)
     unsigned char * payload_mod;        // payload symbols (modulator output, demod input)
+    unsigned int    payload_enc_buf_len;// allocated size of payload_enc
+    unsigned int    payload_mod_buf_len;// allocated size of payload_mod
     unsigned int    payload_enc_len;    // number of encoded payload bytes
     unsigned int    payload_bit_len;    // number of bits in encoded payload
     unsigned int    payload_mod_len;    // number of symbols in encoded payload
@@ -77,11 +83,13 @@ qpacketmodem qpacketmodem_create()
     q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
 
     // soft demodulator uses one byte to represent each soft bit
-    q->payload_enc = (unsigned char*) malloc(q->bits_per_symbol*q->payload_mod_len*sizeof(unsigned char));
+    q->payload_enc_buf_len = q->bits_per_symbol*q->payload_mod_len;
+    q->payload_enc = (unsigned char*) malloc(q->payload_enc_buf_len*sizeof(unsigned char));
 
     // set symbol length appropriately
     q->payload_mod_len = q->payload_enc_len * q->bits_per_symbol;   // for QPSK
-    q->payload_mod = (unsigned char*) malloc(q->payload_mod_len*sizeof(unsigned char));
+    q->payload_mod_buf_len = q->payload_mod_len;
+    q->payload_mod = (unsigned char*) malloc(q->payload_mod_buf_len*sizeof(unsigned char));
 
     q->n = 0;
 
@@ -107,6 +115,7 @@ void qpacketmodem_destroy(qpacketmodem _q)
 void qpacketmodem_reset(qpacketmodem _q)
 {
     modem_reset(_q->mod_payload);
+    _q->n = 0;  // drop any partially-received payload data
 }
 
 // print object internals
@@ -149,13 +158,21 @@ int qpacketmodem_configure(qpacketmodem _q,
     div_t d = div(_q->payload_bit_len, _q->bits_per_symbol);
     _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
 
-    // encoded payload array (leave room for soft-decision decoding)
-    _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
-            _q->bits_per_symbol*_q->payload_mod_len*sizeof(unsigned char));
+    // encoded payload array (leave room for soft-decision decoding);
+    // buffers grow but never shrink so that repeated length changes
+    // within a previous maximum are allocation-free
+    if (_q->bits_per_symbol*_q->payload_mod_len > _q->payload_enc_buf_len) {
+        _q->payload_enc_buf_len = _q->bits_per_symbol*_q->payload_mod_len;
+        _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
+                _q->payload_enc_buf_len*sizeof(unsigned char));
+    }
 
     // reallocate memory for modem symbols
-    _q->payload_mod = (unsigned char*) realloc(_q->payload_mod,
-                                               _q->payload_mod_len*sizeof(unsigned char));
+    if (_q->payload_mod_len > _q->payload_mod_buf_len) {
+        _q->payload_mod_buf_len = _q->payload_mod_len;
+        _q->payload_mod = (unsigned char*) realloc(_q->payload_mod,
+                                                   _q->payload_mod_buf_len*sizeof(unsigned char));
+    }
 
     _q->n = 0;
 
@@ -315,18 +332,21 @@ int qpacketmodem_decode_soft(qpacketmodem    _q,
                              float complex * _frame,
                              unsigned char * _payload)
 {
-    unsigned int i;
-
-    // demodulate and pack bytes into decoder input buffer
-    unsigned int sym;
-    //memset(_q->payload_enc, 0x00, _q->payload_enc_len*sizeof(unsigned char));
+    // batch soft demodulation straight into the decoder input buffer;
+    // the soft de-interleaver and FEC decoders consume the LLR bytes
+    // in place with no further per-bit marshalling
+    unsigned int syms[QPACKETMODEM_BLOCK_LEN];
+    unsigned int i = 0;
     unsigned int n = 0;
-    for (i=0; i<_q->payload_mod_len; i++) {
-        // demodulate symbol
-        modem_demodulate_soft(_q->mod_payload, _frame[i], &sym, _q->payload_enc+n);
-        n += _q->bits_per_symbol;
+    while (i < _q->payload_mod_len) {
+        unsigned int num = _q->payload_mod_len - i;
+        if (num > QPACKETMODEM_BLOCK_LEN)
+            num = QPACKETMODEM_BLOCK_LEN;
+        modem_demodulate_soft_block(_q->mod_payload, _frame+i, num, syms,
+                                    _q->payload_enc + n);
+        i += num;
+        n += num * _q->bits_per_symbol;
     }
-    //printf("received %u bits (expected %u)\n", n, _q->payload_mod_len * _q->bits_per_symbol);
     assert( n == _q->payload_mod_len * _q->bits_per_symbol);
 
     // decode payload, returning flag if decoded payload is valid
@@ -352,3 +372,33 @@ int qpacketmodem_decode_soft_payload(qpacketmodem    _q,
     _q->n = 0;
     return packetizer_decode_soft(_q->p, _q->payload_enc, _payload);
 }
+
+// decode symbol from modulated frame samples (hard decision),
+// returning flag if all symbols received
+//  _q          :   qpacketmodem object
+//  _symbol     :   encoded/modulated symbol
+int qpacketmodem_decode_sym(qpacketmodem  _q,
+                            float complex _symbol)
+{
+    unsigned int sym;
+    modem_demodulate(_q->mod_payload, _symbol, &sym);
+    liquid_pack_array(_q->payload_enc,
+                      _q->payload_enc_len,
+                      _q->n,
+                      _q->bits_per_symbol,
+                      sym);
+    _q->n += _q->bits_per_symbol;
+    return _q->n == _q->payload_mod_len * _q->bits_per_symbol;
+}
+
+// decode payload from symbols previously pushed through
+// qpacketmodem_decode_sym(), returning flag if CRC passed
+//  _q          :   qpacketmodem object
+//  _payload    :   recovered decoded payload bytes
+int qpacketmodem_decode_payload(qpacketmodem    _q,
+                                unsigned char * _payload)
+{
+    assert( _q->n == _q->payload_mod_len * _q->bits_per_symbol);
+    _q->n = 0;
+    return packetizer_decode(_q->p, _q->payload_enc, _payload);
+}
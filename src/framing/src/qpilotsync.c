@@ -38,6 +38,9 @@
 
 #define DEBUG_QPILOTSYNC 0
 
+// forward declaration of internal methods
+void qpilotsync_generate_pilots(qpilotsync _q);
+
 struct qpilotsync_s {
     // properties
     unsigned int    payload_len;    // number of samples in payload
@@ -69,7 +72,6 @@ qpilotsync qpilotsync_create(unsigned int _payload_len,
         fprintf(stderr,"error: qpilotsync_create(), pilot spacing must be at least 2 symbols\n");
         exit(1);
     }
-    unsigned int i;
 
     // allocate memory for main object
     qpilotsync q = (qpilotsync) malloc(sizeof(struct qpilotsync_s));
@@ -83,23 +85,9 @@ qpilotsync qpilotsync_create(unsigned int _payload_len,
     q->frame_len  = q->payload_len + q->num_pilots;
 
 
-    // allocate memory for pilots
+    // allocate memory for pilots and generate sequence
     q->pilots = (float complex*) malloc(q->num_pilots*sizeof(float complex));
-
-    // find appropriate sequence size
-    unsigned int m = liquid_nextpow2(q->num_pilots);
-
-    // generate pilot sequence
-    msequence seq = msequence_create_default(m);
-    for (i=0; i<q->num_pilots; i++) {
-        // generate symbol
-        unsigned int s = msequence_generate_symbol(seq, 2);
-
-        // save modulated symbol
-        float theta = (2 * M_PI * (float)s / 4.0f) + M_PI / 4.0f;
-        q->pilots[i] = cexpf(_Complex_I*theta);
-    }
-    msequence_destroy(seq);
+    qpilotsync_generate_pilots(q);
 
     // compute fft size and create transform objects
     q->nfft = 1 << liquid_nextpow2(q->num_pilots + (q->num_pilots>>1));
@@ -117,14 +105,63 @@ qpilotsync qpilotsync_recreate(qpilotsync   _q,
                                unsigned int _payload_len,
                                unsigned int _pilot_spacing)
 {
-    // TODO: only re-generate objects as necessary
+    // create object if it does not already exist
+    if (_q == NULL)
+        return qpilotsync_create(_payload_len, _pilot_spacing);
+
+    // same configuration: re-use object as is (pilot sequence and
+    // transform plan are fully determined by these two properties)
+    if (_q->payload_len == _payload_len && _q->pilot_spacing == _pilot_spacing) {
+        qpilotsync_reset(_q);
+        return _q;
+    }
 
-    // destroy object
-    if (_q != NULL)
-        qpilotsync_destroy(_q);
+    // set new properties and recompute derived values
+    unsigned int num_pilots_old = _q->num_pilots;
+    unsigned int nfft_old       = _q->nfft;
+    _q->payload_len   = _payload_len;
+    _q->pilot_spacing = _pilot_spacing;
+    _q->num_pilots    = qpilot_num_pilots(_q->payload_len, _q->pilot_spacing);
+    _q->frame_len     = _q->payload_len + _q->num_pilots;
+
+    // re-generate pilot sequence
+    if (_q->num_pilots != num_pilots_old)
+        _q->pilots = (float complex*) realloc(_q->pilots, _q->num_pilots*sizeof(float complex));
+    qpilotsync_generate_pilots(_q);
+
+    // re-create transform only when its size actually changes
+    _q->nfft = 1 << liquid_nextpow2(_q->num_pilots + (_q->num_pilots>>1));
+    if (_q->nfft != nfft_old) {
+        fft_destroy_plan(_q->fft);
+        _q->buf_time = (float complex*) realloc(_q->buf_time, _q->nfft*sizeof(float complex));
+        _q->buf_freq = (float complex*) realloc(_q->buf_freq, _q->nfft*sizeof(float complex));
+        _q->fft      = fft_create_plan(_q->nfft, _q->buf_time, _q->buf_freq, LIQUID_FFT_FORWARD, 0);
+    }
 
-    // create new object
-    return qpilotsync_create(_payload_len, _pilot_spacing);
+    // reset object and return
+    qpilotsync_reset(_q);
+    return _q;
+}
+
+// generate modulated pilot sequence from default m-sequence
+void qpilotsync_generate_pilots(qpilotsync _q)
+{
+    unsigned int i;
+
+    // find appropriate sequence size
+    unsigned int m = liquid_nextpow2(_q->num_pilots);
+
+    // generate pilot sequence
+    msequence seq = msequence_create_default(m);
+    for (i=0; i<_q->num_pilots; i++) {
+        // generate symbol
+        unsigned int s = msequence_generate_symbol(seq, 2);
+
+        // save modulated symbol
+        float theta = (2 * M_PI * (float)s / 4.0f) + M_PI / 4.0f;
+        _q->pilots[i] = cexpf(_Complex_I*theta);
+    }
+    msequence_destroy(seq);
 }
 
 void qpilotsync_destroy(qpilotsync _q)
@@ -197,19 +234,23 @@ void qpilotsync_execute(qpilotsync      _q,
     }
 
     // compute frequency offset by computing transform and finding peak
+    // (search on squared magnitude to avoid a square root per bin)
     fft_execute(_q->fft);
     unsigned int i0 = 0;
-    float        y0 = 0;
+    float        y2 = 0;
     for (i=0; i<_q->nfft; i++) {
 #if DEBUG_QPILOTSYNC
         printf("X(%3u) = %12.8f + 1i*%12.8f; %% %12.8f\n",
                 i+1, crealf(_q->buf_freq[i]), cimagf(_q->buf_freq[i]), cabsf(_q->buf_freq[i]));
 #endif
-        if (i==0 || cabsf(_q->buf_freq[i]) > y0) {
+        float complex v = _q->buf_freq[i];
+        float         m = crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
+        if (i==0 || m > y2) {
             i0 = i;
-            y0 = cabsf(_q->buf_freq[i]);
+            y2 = m;
         }
     }
+    float y0 = sqrtf(y2);
 
     // interpolate and recover frequency
     unsigned int ineg = (i0 + _q->nfft - 1) % _q->nfft;
@@ -248,9 +289,18 @@ void qpilotsync_execute(qpilotsync      _q,
     // METHOD 2: compute metric by de-rotating pilots and measuring resulting phase
     // NOTE: this is possibly more accurate than the above method but might also
     //       be more computationally complex
+    // de-rotate with a recursively-updated phasor (one complex multiply
+    // per pilot instead of a complex exponential), renormalizing
+    // periodically to bound accumulated round-off
     float complex metric = 0;
-    for (i=0; i<_q->num_pilots; i++)
-        metric += _q->buf_time[i] * cexpf(-_Complex_I*_q->dphi_hat*i*(float)(_q->pilot_spacing));
+    float complex rot    = 1.0f;
+    float complex step   = cexpf(-_Complex_I*_q->dphi_hat*(float)(_q->pilot_spacing));
+    for (i=0; i<_q->num_pilots; i++) {
+        metric += _q->buf_time[i] * rot;
+        rot    *= step;
+        if ( ((i+1) & 0x3f)==0 )
+            rot /= cabsf(rot);
+    }
     //printf("metric : %12.8f <%12.8f>\n", cabsf(metric), cargf(metric));
     _q->phi_hat = cargf(metric);
     _q->g_hat   = cabsf(metric) / (float)(_q->num_pilots);
@@ -259,10 +309,16 @@ void qpilotsync_execute(qpilotsync      _q,
     // frequency correction
     float g = 1.0f / _q->g_hat;
 
-    // recover frame symbols
+    // recover frame symbols, de-rotating with a recursively-updated
+    // phasor as above
     _q->evm_hat = 0.0f;
+    rot  = cexpf(-_Complex_I*_q->phi_hat);
+    step = cexpf(-_Complex_I*_q->dphi_hat);
     for (i=0; i<_q->frame_len; i++) {
-        float complex v = g * _frame[i] * cexpf(-_Complex_I*(_q->dphi_hat*i + _q->phi_hat));
+        float complex v = g * _frame[i] * rot;
+        rot *= step;
+        if ( ((i+1) & 0x3f)==0 )
+            rot /= cabsf(rot);
         if ( (i % _q->pilot_spacing)==0 ) {
             // pilot symbol
             float complex e = _q->pilots[p] - v;
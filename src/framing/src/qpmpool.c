@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// qpmpool.c
+//
+// configuration-keyed pool of packet encoder/decoder objects
+//
+// Burst-mode links that change payload mod/FEC parameters per burst
+// otherwise pay a full qpacketmodem create/configure/destroy cycle
+// (and the modem and packetizer creates inside it) for every burst.
+// The pool retains configured objects after release and hands an idle
+// object back on the next acquire with the same configuration, so the
+// steady state is a table lookup and a reset.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// pool entry: one retained object and the configuration it carries
+struct qpmpool_entry_s {
+    qpacketmodem q;             // retained packet encoder/decoder
+    unsigned int payload_len;   // length of payload message [bytes]
+    crc_scheme   check;         // data validity check
+    fec_scheme   fec0;          // inner FEC scheme
+    fec_scheme   fec1;          // outer FEC scheme
+    int          ms;            // modulation scheme
+    int          in_use;        // object currently checked out?
+};
+
+struct qpmpool_s {
+    struct qpmpool_entry_s * entries;       // pooled objects
+    unsigned int             num_entries;   // number of objects held
+    unsigned int             max_entries;   // entries allocation size
+};
+
+// create packet encoder/decoder pool
+qpmpool qpmpool_create()
+{
+    qpmpool q = (qpmpool) malloc(sizeof(struct qpmpool_s));
+    q->num_entries = 0;
+    q->max_entries = 8;
+    q->entries = (struct qpmpool_entry_s*)
+        malloc(q->max_entries*sizeof(struct qpmpool_entry_s));
+    return q;
+}
+
+// destroy pool and all pooled objects, including any still checked out
+void qpmpool_destroy(qpmpool _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_entries; i++)
+        qpacketmodem_destroy(_q->entries[i].q);
+    free(_q->entries);
+    free(_q);
+}
+
+// print pool contents
+void qpmpool_print(qpmpool _q)
+{
+    printf("qpmpool: %u objects\n", _q->num_entries);
+    unsigned int i;
+    for (i=0; i<_q->num_entries; i++) {
+        struct qpmpool_entry_s * e = &_q->entries[i];
+        printf("  %3u : payload %u bytes, %s, %s/%s, %s%s\n",
+            i,
+            e->payload_len,
+            crc_scheme_str[e->check][0],
+            fec_scheme_str[e->fec0][0],
+            fec_scheme_str[e->fec1][0],
+            modulation_types[e->ms].name,
+            e->in_use ? " (in use)" : "");
+    }
+}
+
+// acquire configured packet encoder/decoder from pool
+qpacketmodem qpmpool_acquire(qpmpool      _q,
+                             unsigned int _payload_len,
+                             crc_scheme   _check,
+                             fec_scheme   _fec0,
+                             fec_scheme   _fec1,
+                             int          _ms)
+{
+    // re-use an idle object with a matching configuration
+    unsigned int i;
+    for (i=0; i<_q->num_entries; i++) {
+        struct qpmpool_entry_s * e = &_q->entries[i];
+        if (!e->in_use                       &&
+            e->payload_len == _payload_len   &&
+            e->check       == _check         &&
+            e->fec0        == _fec0          &&
+            e->fec1        == _fec1          &&
+            e->ms          == _ms)
+        {
+            e->in_use = 1;
+            qpacketmodem_reset(e->q);
+            return e->q;
+        }
+    }
+
+    // no match: create and configure a new object for the pool
+    qpacketmodem p = qpacketmodem_create();
+    if (qpacketmodem_configure(p, _payload_len, _check, _fec0, _fec1, _ms)) {
+        qpacketmodem_destroy(p);
+        return NULL;
+    }
+
+    // extend entries table as needed
+    if (_q->num_entries == _q->max_entries) {
+        _q->max_entries *= 2;
+        _q->entries = (struct qpmpool_entry_s*)
+            realloc(_q->entries, _q->max_entries*sizeof(struct qpmpool_entry_s));
+    }
+
+    struct qpmpool_entry_s * e = &_q->entries[_q->num_entries++];
+    e->q           = p;
+    e->payload_len = _payload_len;
+    e->check       = _check;
+    e->fec0        = _fec0;
+    e->fec1        = _fec1;
+    e->ms          = _ms;
+    e->in_use      = 1;
+    return p;
+}
+
+// return packet encoder/decoder to pool for re-use
+int qpmpool_release(qpmpool _q, qpacketmodem _p)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_entries; i++) {
+        if (_q->entries[i].q == _p) {
+            if (!_q->entries[i].in_use) {
+                fprintf(stderr,"warning: qpmpool_release(), object already released\n");
+                return -1;
+            }
+            _q->entries[i].in_use = 0;
+            return 0;
+        }
+    }
+    fprintf(stderr,"error: qpmpool_release(), object does not belong to pool\n");
+    return -1;
+}
+
+// get total number of objects held by pool (idle and checked out)
+unsigned int qpmpool_get_num_objects(qpmpool _q)
+{
+    return _q->num_entries;
+}
@@ -55,6 +55,7 @@ struct QSOURCE(_s)
     firpfbch2_crcf  ch;         // analysis channelizer
     int             enabled;    // signal enabled?
     uint64_t        num_samples;// total number of output samples generated
+    liquid_rng      rng;        // per-source random number generator
 
     // signal type
     enum {
@@ -148,6 +149,10 @@ QSOURCE() QSOURCE(_create)(unsigned int _M,
     // channelizer gain correction
     q->gain_ch = sqrtf((float)(q->P)/(float)(q->M));
 
+    // per-source random number generator; re-seeded when the source
+    // is assigned its identifier
+    q->rng = liquid_rng_create(0);
+
     // reset and return main object
     QSOURCE(_reset)(q);
     return q;
@@ -187,6 +192,7 @@ void QSOURCE(_destroy)(QSOURCE() _q)
     firpfbch2_crcf_destroy(_q->ch);
     resamp_crcf_destroy   (_q->resamp);
     NCO(_destroy)         (_q->mixer);
+    liquid_rng_destroy    (_q->rng);
 
     // free main object memory
     free(_q);
@@ -303,6 +309,10 @@ void QSOURCE(_set_id)(QSOURCE() _q,
                       int       _id)
 {
     _q->id = _id;
+
+    // seed internal generator from identifier so each source has an
+    // independent, reproducible stream
+    liquid_rng_seed(_q->rng, (unsigned long)(_id + 1));
 }
 
 // get internal object identifier
@@ -384,7 +394,7 @@ void QSOURCE(_generate)(QSOURCE() _q,
         }
         break;
     case QSOURCE_NOISE:
-        sample = (randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+        sample = (randnf_rng(_q->rng) + _Complex_I*randnf_rng(_q->rng)) * M_SQRT1_2;
         break;
     case QSOURCE_MODEM:
         SYMSTREAM(_write_samples)(_q->source.linmod.symstream, &sample, 1);
@@ -393,7 +403,7 @@ void QSOURCE(_generate)(QSOURCE() _q,
     case QSOURCE_FSK:
         // fill buffer when necessary
         if (_q->source.fsk.index==0)
-            fskmod_modulate(_q->source.fsk.mod, rand() & _q->source.fsk.mask, _q->source.fsk.buf);
+            fskmod_modulate(_q->source.fsk.mod, liquid_rng_uint32(_q->rng) & _q->source.fsk.mask, _q->source.fsk.buf);
 
         // compensate for k samples/symbol
         sample = _q->source.fsk.buf[ _q->source.fsk.index++ ]; // *  M_SQRT1_2;
@@ -402,7 +412,7 @@ void QSOURCE(_generate)(QSOURCE() _q,
     case QSOURCE_GMSK:
         // fill buffer when necessary
         if (_q->source.gmsk.index==0)
-            gmskmod_modulate(_q->source.gmsk.mod, rand() & 1, _q->source.gmsk.buf);
+            gmskmod_modulate(_q->source.gmsk.mod, liquid_rng_uint32(_q->rng) & 1, _q->source.gmsk.buf);
 
         // compensate for 2 samples/symbol
         sample = _q->source.gmsk.buf[ _q->source.gmsk.index++ ] *  M_SQRT1_2;
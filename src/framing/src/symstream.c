@@ -41,6 +41,9 @@ struct SYMSTREAM(_s) {
     FIRINTERP()     interp;         // interpolator
     TO *            buf;            // output buffer
     unsigned int    buf_index;      // output buffer sample index
+    TO *            pattern;        // pre-rendered periodic waveform (NULL if unset)
+    unsigned int    pattern_len;    // pattern length [samples]
+    unsigned int    pattern_index;  // pattern read index
 };
 
 // create symstream object using default parameters
@@ -100,6 +103,10 @@ SYMSTREAM() SYMSTREAM(_create_linear)(int          _ftype,
     // sample buffer
     q->buf = (TO*) malloc(q->k*sizeof(TO));
 
+    // no pattern cache by default
+    q->pattern     = NULL;
+    q->pattern_len = 0;
+
     // reset and return main object
     SYMSTREAM(_reset)(q);
     return q;
@@ -113,6 +120,7 @@ void SYMSTREAM(_destroy)(SYMSTREAM() _q)
     FIRINTERP(_destroy)(_q->interp);
 
     free(_q->buf);
+    free(_q->pattern);
 
     // free main object
     free(_q);
@@ -130,7 +138,8 @@ void SYMSTREAM(_reset)(SYMSTREAM() _q)
     // reset objects and counter
     MODEM(_reset)(_q->mod);
     FIRINTERP(_reset)(_q->interp);
-    _q->buf_index = 0;
+    _q->buf_index     = 0;
+    _q->pattern_index = 0;
 }
 
 // Set internal linear modulation scheme, leaving the filter parameters
@@ -160,6 +169,71 @@ float SYMSTREAM(_get_gain)(SYMSTREAM() _q)
     return _q->gain;
 }
 
+// Set repeating symbol pattern, pre-rendering one period of the
+// interpolated waveform; subsequent calls to write_samples() serve the
+// cached waveform by copy instead of running the modulation/filter chain
+//  _q       : symstream object
+//  _syms    : symbol indices defining one period [size: _num_syms x 1]
+//  _num_syms: pattern length [symbols]
+void SYMSTREAM(_set_pattern)(SYMSTREAM()    _q,
+                             unsigned int * _syms,
+                             unsigned int   _num_syms)
+{
+    // validate input
+    if (_num_syms == 0) {
+        fprintf(stderr,"error: symstream%s_set_pattern(), pattern length must be greater than zero\n", EXTENSION);
+        exit(1);
+    }
+    unsigned int M = 1 << MODEM(_get_bps)(_q->mod);
+    unsigned int i;
+    for (i=0; i<_num_syms; i++) {
+        if (_syms[i] >= M) {
+            fprintf(stderr,"error: symstream%s_set_pattern(), symbol exceeds constellation size\n", EXTENSION);
+            exit(1);
+        }
+    }
+
+    // (re-)allocate cache for one period of the interpolated waveform
+    _q->pattern_len = _num_syms * _q->k;
+    _q->pattern     = (TO*) realloc(_q->pattern, _q->pattern_len*sizeof(TO));
+
+    // render with scratch objects so the live generator state is untouched;
+    // cycle the pattern through the interpolator until the filter memory
+    // (2 _m symbols) holds only pattern symbols, then capture one period of
+    // the steady-state (exactly periodic) waveform
+    MODEM()     mod    = MODEM(_create)(MODEM(_get_scheme)(_q->mod));
+    FIRINTERP() interp = FIRINTERP(_create_prototype)(_q->filter_type, _q->k, _q->m, _q->beta, 0);
+    unsigned int num_reps = (2*_q->m + _num_syms - 1) / _num_syms;
+    unsigned int r;
+    TO v;
+    for (r=0; r<num_reps; r++) {
+        for (i=0; i<_num_syms; i++) {
+            MODEM(_modulate)(mod, _syms[i], &v);
+            v *= _q->gain;
+            FIRINTERP(_execute)(interp, v, _q->buf);
+        }
+    }
+    for (i=0; i<_num_syms; i++) {
+        MODEM(_modulate)(mod, _syms[i], &v);
+        v *= _q->gain;
+        FIRINTERP(_execute)(interp, v, _q->pattern + i*_q->k);
+    }
+    MODEM    (_destroy)(mod);
+    FIRINTERP(_destroy)(interp);
+
+    // restart pattern from the beginning
+    _q->pattern_index = 0;
+}
+
+// Clear repeating symbol pattern, reverting to random symbol generation
+void SYMSTREAM(_clear_pattern)(SYMSTREAM() _q)
+{
+    free(_q->pattern);
+    _q->pattern       = NULL;
+    _q->pattern_len   = 0;
+    _q->pattern_index = 0;
+}
+
 // fill buffer with samples
 void SYMSTREAM(_fill_buffer)(SYMSTREAM() _q)
 {
@@ -186,6 +260,21 @@ void SYMSTREAM(_write_samples)(SYMSTREAM()  _q,
                                unsigned int _buf_len)
 {
     unsigned int i;
+
+    // serve cached pattern by copy with circular stitching
+    if (_q->pattern_len > 0) {
+        unsigned int n = 0;
+        while (n < _buf_len) {
+            unsigned int num = _q->pattern_len - _q->pattern_index;
+            if (num > _buf_len - n)
+                num = _buf_len - n;
+            memmove(_buf + n, _q->pattern + _q->pattern_index, num*sizeof(TO));
+            _q->pattern_index = (_q->pattern_index + num) % _q->pattern_len;
+            n += num;
+        }
+        return;
+    }
+
     for (i=0; i<_buf_len; i++) {
         // check to see if buffer needs samples
         if (_q->buf_index==0)
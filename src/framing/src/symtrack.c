@@ -34,10 +34,20 @@
 #define DEBUG_SYMTRACK_FILENAME  "symtrack_internal_debug.m"
 #define DEBUG_BUFFER_LEN        (1024)
 
+// number of input samples processed per chunk in block execution
+#define LIQUID_SYMTRACK_BLOCK_LEN   (256)
+
 //
 // forward declaration of internal methods
 //
 
+// run single symbol synchronizer output sample through the tracking
+// loop (mixer, equalizer, demodulator, phase-locked loop), writing at
+// most one recovered symbol to the output
+unsigned int SYMTRACK(_process_sync_output)(SYMTRACK() _q,
+                                            TO         _v,
+                                            TO *       _y);
+
 // internal structure
 struct SYMTRACK(_s) {
     // parameters
@@ -255,44 +265,8 @@ void SYMTRACK(_execute)(SYMTRACK()     _q,
     SYMSYNC(_execute)(_q->symsync, &v, 1, _q->symsync_buf, &nw);
 
     // process each output sample
-    for (i=0; i<nw; i++) {
-        // update phase-locked loop
-        NCO(_step)(_q->nco);
-        nco_crcf_mix_down(_q->nco, _q->symsync_buf[i], &v);
-
-        // equalizer/decimator
-        EQLMS(_push)(_q->eq, v);
-
-        // decimate result, noting that symsync outputs at exactly 2 samples/symbol
-        _q->symsync_index++;
-        if ( !(_q->symsync_index % 2) )
-            continue;
-
-        // increment number of symbols received
-        _q->num_syms_rx++;
-
-        // compute equalizer output
-        TO d_hat;
-        EQLMS(_execute)(_q->eq, &d_hat);
-
-        // demodulate result, apply phase correction
-        unsigned int sym_out;
-        MODEM(_demodulate)(_q->demod, d_hat, &sym_out);
-        float phase_error = MODEM(_get_demodulator_phase_error)(_q->demod);
-
-        // update equalizer independent of the signal: estimate error
-        // assuming constant modulus signal
-        // TODO: use decision-directed feedback when modulation scheme is known
-        // TODO: check lock conditions of previous object to determine when to run equalizer
-        if (_q->num_syms_rx > 200)
-            EQLMS(_step)(_q->eq, d_hat/cabsf(d_hat), d_hat);
-
-        // update pll
-        NCO(_pll_step)(_q->nco, phase_error);
-
-        // save result to output
-        _y[num_outputs++] = d_hat;
-    }
+    for (i=0; i<nw; i++)
+        num_outputs += SYMTRACK(_process_sync_output)(_q, _q->symsync_buf[i], &_y[num_outputs]);
 
 #if DEBUG_SYMTRACK
     printf("symsync wrote %u samples, %u outputs\n", nw, num_outputs);
@@ -314,19 +288,95 @@ void SYMTRACK(_execute_block)(SYMTRACK()     _q,
                               TO *           _y,
                               unsigned int * _ny)
 {
-    //
     unsigned int i;
     unsigned int num_written = 0;
 
-    //
-    for (i=0; i<_nx; i++) {
+    // scratch buffers for fused stage execution; the symbol
+    // synchronizer output buffer is bounded by the resampler's
+    // worst-case output count for a full chunk
+    TI buf_agc [LIQUID_SYMTRACK_BLOCK_LEN];
+    TO buf_sync[SYMSYNC(_get_output_max)(_q->symsync, LIQUID_SYMTRACK_BLOCK_LEN)];
+
+    // process input in cache-resident chunks, running each stage over
+    // the entire chunk before moving to the next stage; this amortizes
+    // the per-sample bookkeeping of the per-stage objects
+    unsigned int n = 0;
+    while (n < _nx) {
+        // chunk length
+        unsigned int r = _nx - n;
+        if (r > LIQUID_SYMTRACK_BLOCK_LEN)
+            r = LIQUID_SYMTRACK_BLOCK_LEN;
+
+        // run chunk through automatic gain control
+        AGC(_execute_block)(_q->agc, _x + n, r, buf_agc);
+
+        // symbol synchronizer (output rate: 2 samples per symbol)
         unsigned int nw = 0;
-        SYMTRACK(_execute)(_q, _x[i], &_y[num_written], &nw);
+        SYMSYNC(_execute)(_q->symsync, buf_agc, r, buf_sync, &nw);
+
+        // run each output sample through the tracking loop; this stage
+        // carries feedback (equalizer, pll) and remains sample-by-sample
+        for (i=0; i<nw; i++)
+            num_written += SYMTRACK(_process_sync_output)(_q, buf_sync[i], &_y[num_written]);
 
-        num_written += nw;
+        n += r;
     }
 
     //
     *_ny = num_written;
 }
 
+//
+// internal methods
+//
+
+// run single symbol synchronizer output sample through the tracking
+// loop (mixer, equalizer, demodulator, phase-locked loop)
+//  _q      : synchronizer object
+//  _v      : symbol synchronizer output sample
+//  _y      : output symbol array
+// returns the number of symbols written to the output (0 or 1)
+unsigned int SYMTRACK(_process_sync_output)(SYMTRACK() _q,
+                                            TO         _v,
+                                            TO *       _y)
+{
+    // update phase-locked loop
+    TO v;
+    NCO(_step)(_q->nco);
+    nco_crcf_mix_down(_q->nco, _v, &v);
+
+    // equalizer/decimator
+    EQLMS(_push)(_q->eq, v);
+
+    // decimate result, noting that symsync outputs at exactly 2 samples/symbol
+    _q->symsync_index++;
+    if ( !(_q->symsync_index % 2) )
+        return 0;
+
+    // increment number of symbols received
+    _q->num_syms_rx++;
+
+    // compute equalizer output
+    TO d_hat;
+    EQLMS(_execute)(_q->eq, &d_hat);
+
+    // demodulate result, apply phase correction
+    unsigned int sym_out;
+    MODEM(_demodulate)(_q->demod, d_hat, &sym_out);
+    float phase_error = MODEM(_get_demodulator_phase_error)(_q->demod);
+
+    // update equalizer independent of the signal: estimate error
+    // assuming constant modulus signal
+    // TODO: use decision-directed feedback when modulation scheme is known
+    // TODO: check lock conditions of previous object to determine when to run equalizer
+    if (_q->num_syms_rx > 200)
+        EQLMS(_step)(_q->eq, d_hat/cabsf(d_hat), d_hat);
+
+    // update pll
+    NCO(_pll_step)(_q->nco, phase_error);
+
+    // save result to output
+    _y[0] = d_hat;
+    return 1;
+}
+
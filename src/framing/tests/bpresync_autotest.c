@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : two-stage (prefix pre-screened) acquisition detects the
+//            sequence with the same correlation output as full search
+//
+void autotest_bpresync_cccf_prefix()
+{
+    unsigned int n = 256;       // sequence length
+    unsigned int m = 5;         // number of correlators
+    unsigned int i;
+
+    // generate pseudo-random +/-1 sequence
+    float complex v[n];
+    msequence ms = msequence_create_default(10);
+    for (i=0; i<n; i++) {
+        v[i] = (msequence_advance(ms) ? 1.0f : -1.0f) +
+               (msequence_advance(ms) ? 1.0f : -1.0f)*_Complex_I;
+    }
+    msequence_destroy(ms);
+
+    // create two synchronizers: full search and prefix pre-screened
+    bpresync_cccf q0 = bpresync_cccf_create(v, n, 0.016f, m);
+    bpresync_cccf q1 = bpresync_cccf_create(v, n, 0.016f, m);
+    bpresync_cccf_enable_prefix(q1, 64, 0.5f);
+
+    float complex rxy0, rxy1;
+    float dphi_hat0, dphi_hat1;
+
+    // push noise; pre-screened output must remain below threshold
+    for (i=0; i<n; i++) {
+        float complex x = randnf()*0.1f + randnf()*0.1f*_Complex_I;
+        bpresync_cccf_push(q0, x);
+        bpresync_cccf_push(q1, x);
+        bpresync_cccf_execute(q1, &rxy1, &dphi_hat1);
+        CONTEND_LESS_THAN( cabsf(rxy1), 0.5f );
+    }
+
+    // push the sequence itself and compare full vs. pre-screened output
+    for (i=0; i<n; i++) {
+        bpresync_cccf_push(q0, v[i]);
+        bpresync_cccf_push(q1, v[i]);
+    }
+    bpresync_cccf_execute(q0, &rxy0, &dphi_hat0);
+    bpresync_cccf_execute(q1, &rxy1, &dphi_hat1);
+
+    // aligned noise-free sequence: strong detection in both cases with
+    // identical full-stage output
+    CONTEND_GREATER_THAN( cabsf(rxy0), 0.9f );
+    CONTEND_EQUALITY( crealf(rxy0), crealf(rxy1) );
+    CONTEND_EQUALITY( cimagf(rxy0), cimagf(rxy1) );
+    CONTEND_EQUALITY( dphi_hat0, dphi_hat1 );
+
+    bpresync_cccf_destroy(q0);
+    bpresync_cccf_destroy(q1);
+}
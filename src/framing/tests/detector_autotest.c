@@ -172,3 +172,75 @@ void detector_cccf_runtest(unsigned int _n,
 }
 
 
+
+//
+// AUTOTEST : dual-rate pre-search matches full-rate detection on a
+//            heavily over-sampled sequence
+//
+void autotest_detector_cccf_presearch()
+{
+    unsigned int k = 8;             // samples per chip (over-sampled)
+    unsigned int num_chips = 64;    // number of chips in sequence
+    unsigned int n = k*num_chips;   // sequence length (samples)
+    unsigned int n0 = 100;          // leading noise-only samples
+    float threshold = 0.3f;         // detection threshold
+    float dphi = 0.01f;             // carrier frequency offset
+    float nstd = powf(10.0f, -80.0f/20.0f);
+    float gamma = powf(10.0f, -50.0f/20.0f);
+    unsigned int i;
+
+    // generate over-sampled synchronization pattern
+    float complex s[n];
+    msequence ms = msequence_create_default(6);
+    for (i=0; i<n; i++) {
+        if ( (i%k)==0 )
+            s[i] = msequence_advance(ms) ? 1.0f : -1.0f;
+        else
+            s[i] = s[i-1];
+    }
+    msequence_destroy(ms);
+
+    // generate received signal: noise, then sequence with offsets
+    unsigned int num_samples = n0 + n + 40;
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++) {
+        x[i]  = (i >= n0 && i < n0+n) ? gamma*s[i-n0] : 0.0f;
+        x[i] *= cexpf(_Complex_I*dphi*i);
+        x[i] += nstd*( randnf() + _Complex_I*randnf() )*M_SQRT1_2;
+    }
+
+    // create two detectors: full-rate reference and pre-searched
+    detector_cccf sync0 = detector_cccf_create(s, n, threshold, 0.02f);
+    detector_cccf sync1 = detector_cccf_create(s, n, threshold, 0.02f);
+    detector_cccf_enable_presearch(sync1, 4, 0.8f*threshold);
+
+    float tau_hat0=0, dphi_hat0=0, gamma_hat0=0, delay_hat0=0;
+    float tau_hat1=0, dphi_hat1=0, gamma_hat1=0, delay_hat1=0;
+    int detected0=0, detected1=0;
+    for (i=0; i<num_samples; i++) {
+        if (detector_cccf_correlate(sync0, x[i], &tau_hat0, &dphi_hat0, &gamma_hat0)) {
+            detected0 = 1;
+            delay_hat0 = (float)i + tau_hat0;
+        }
+        if (detector_cccf_correlate(sync1, x[i], &tau_hat1, &dphi_hat1, &gamma_hat1)) {
+            detected1 = 1;
+            delay_hat1 = (float)i + tau_hat1;
+        }
+    }
+    detector_cccf_destroy(sync0);
+    detector_cccf_destroy(sync1);
+
+    if (liquid_autotest_verbose) {
+        printf("detector presearch autotest:\n");
+        printf("    full-rate  : detected? %s, delay=%12.6f, dphi=%12.6f\n",
+                detected0 ? "yes" : "no", delay_hat0, dphi_hat0);
+        printf("    pre-search : detected? %s, delay=%12.6f, dphi=%12.6f\n",
+                detected1 ? "yes" : "no", delay_hat1, dphi_hat1);
+    }
+
+    // ensure signal was detected in both cases with matching estimates
+    CONTEND_EXPRESSION( detected0 );
+    CONTEND_EXPRESSION( detected1 );
+    CONTEND_DELTA( delay_hat1, delay_hat0, 1.0f  );
+    CONTEND_DELTA( dphi_hat1,  dphi_hat0,  0.005f );
+}
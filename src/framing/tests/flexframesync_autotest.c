@@ -89,3 +89,382 @@ void autotest_flexframesync()
     flexframesync_destroy(fs);
 }
 
+//
+// AUTOTEST : test recovery of frame with the energy-gate squelch
+//            enabled, preceded and followed by dead air
+//
+void autotest_flexframesync_squelch()
+{
+    unsigned int i;
+
+    unsigned int _payload_len = 400;
+    int _ms    = LIQUID_MODEM_QPSK;
+    int _fec0  = LIQUID_FEC_NONE;
+    int _fec1  = LIQUID_FEC_NONE;
+    int _check = LIQUID_CRC_32;
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = _ms;
+    fgprops.check       = _check;
+    fgprops.fec0        = _fec0;
+    fgprops.fec1        = _fec1;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object, gating detection on signal energy
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    flexframesync_squelch_enable(fs, -25.0f);
+
+    // initialize header and payload
+    unsigned char header[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    // assemble the frame
+    flexframegen_assemble(fg, header, payload, _payload_len);
+
+    // push dead air (noise well below threshold) through synchronizer
+    float complex buf[2];
+    unsigned int num_silence = 4000;
+    for (i=0; i<num_silence/2; i++) {
+        buf[0] = 0.001f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        buf[1] = 0.001f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        flexframesync_execute(fs, buf, 2);
+    }
+
+    // generate the frame
+    int frame_complete = 0;
+    while (!frame_complete) {
+        // write samples to buffer
+        frame_complete = flexframegen_write_samples(fg, buf, 2);
+
+        // run through frame synchronizer
+        flexframesync_execute(fs, buf, 2);
+    }
+
+    // trailing dead air to flush synchronizer
+    for (i=0; i<num_silence/2; i++) {
+        buf[0] = 0.001f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        buf[1] = 0.001f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        flexframesync_execute(fs, buf, 2);
+    }
+
+    // get frame data statistics
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (liquid_autotest_verbose)
+        flexframesync_print(fs);
+
+    // check to see that frame was recovered
+    CONTEND_EQUALITY( stats.num_frames_detected, 1 );
+    CONTEND_EQUALITY( stats.num_headers_valid,   1 );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  1 );
+    CONTEND_EQUALITY( stats.num_bytes_received,  _payload_len );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+// callback for threaded test; first payload byte carries the frame
+// index, ensuring frames are delivered in the order they were detected
+static int flexframesync_autotest_threaded_callback(
+        unsigned char *  _header,
+        int              _header_valid,
+        unsigned char *  _payload,
+        unsigned int     _payload_len,
+        int              _payload_valid,
+        framesyncstats_s _stats,
+        void *           _userdata)
+{
+    unsigned int * num_frames_received = (unsigned int*) _userdata;
+    CONTEND_EQUALITY( _header_valid,  1 );
+    CONTEND_EQUALITY( _payload_valid, 1 );
+    if (_payload_valid)
+        CONTEND_EQUALITY( _payload[0], *num_frames_received );
+    *num_frames_received += 1;
+    return 0;
+}
+
+//
+// AUTOTEST : test recovery of multiple frames with payload decoding
+//            handed to an internal worker pool
+//
+void autotest_flexframesync_threaded()
+{
+    unsigned int i;
+    unsigned int j;
+
+    unsigned int _payload_len = 400;
+    unsigned int _num_frames  = 5;
+    int _ms    = LIQUID_MODEM_QPSK;
+    int _fec0  = LIQUID_FEC_NONE;
+    int _fec1  = LIQUID_FEC_NONE;
+    int _check = LIQUID_CRC_32;
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = _ms;
+    fgprops.check       = _check;
+    fgprops.fec0        = _fec0;
+    fgprops.fec1        = _fec1;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object with two payload decoding threads
+    unsigned int num_frames_received = 0;
+    flexframesync fs = flexframesync_create(flexframesync_autotest_threaded_callback,
+                                            (void*)&num_frames_received);
+    flexframesync_set_threads(fs, 2);
+
+    // initialize header and payload
+    unsigned char header[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    for (j=0; j<_num_frames; j++) {
+        // tag payload with frame index and assemble the frame
+        payload[0] = j;
+        flexframegen_assemble(fg, header, payload, _payload_len);
+
+        // generate the frame
+        int frame_complete = 0;
+        float complex buf[2];
+        while (!frame_complete) {
+            // write samples to buffer
+            frame_complete = flexframegen_write_samples(fg, buf, 2);
+
+            // run through frame synchronizer
+            flexframesync_execute(fs, buf, 2);
+        }
+    }
+
+    // drain worker pool, delivering any outstanding frames
+    flexframesync_set_threads(fs, 0);
+
+    // get frame data statistics
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (liquid_autotest_verbose)
+        flexframesync_print(fs);
+
+    // check to see that all frames were recovered and delivered in order
+    CONTEND_EQUALITY( num_frames_received,       _num_frames );
+    CONTEND_EQUALITY( stats.num_frames_detected, _num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   _num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  _num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,  _num_frames*_payload_len );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+
+//
+// AUTOTEST : test recovery of frame with a large carrier frequency
+//            offset using the widened detector search range
+//
+void autotest_flexframesync_cfo()
+{
+    unsigned int i;
+
+    unsigned int _payload_len = 400;
+    float        _dphi        = 0.6f;   // carrier offset [radians/sample]
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_NONE;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object, widening the carrier offset search
+    // range of the detection stage to cover the applied offset
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    flexframesync_set_cfo_range(fs, 0.7f);
+
+    // initialize header and payload
+    unsigned char header[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    // assemble the frame
+    flexframegen_assemble(fg, header, payload, _payload_len);
+
+    // generate the frame, applying the carrier offset
+    int frame_complete = 0;
+    unsigned int n = 0;
+    float complex buf[2];
+    while (!frame_complete) {
+        // write samples to buffer and mix up to the offset
+        frame_complete = flexframegen_write_samples(fg, buf, 2);
+        for (i=0; i<2; i++)
+            buf[i] *= cexpf(_Complex_I*_dphi*(float)(n++));
+
+        // run through frame synchronizer
+        flexframesync_execute(fs, buf, 2);
+    }
+
+    // get frame data statistics
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (liquid_autotest_verbose)
+        flexframesync_print(fs);
+
+    // check to see that frame was recovered
+    CONTEND_EQUALITY( stats.num_frames_detected, 1 );
+    CONTEND_EQUALITY( stats.num_headers_valid,   1 );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  1 );
+    CONTEND_EQUALITY( stats.num_bytes_received,  _payload_len );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+// buffer-exchange test context: retained buffers from delivered frames
+struct flexframesync_autotest_exchange_s {
+    unsigned char * buffers[8];         // buffers taken from the synchronizer
+    unsigned int    buffer_len;         // length of each filled buffer
+    unsigned int    num_exchanged;      // number of exchanges performed
+};
+
+// buffer-exchange callback: keep the filled buffer and hand back a
+// freshly allocated one
+static unsigned char * flexframesync_autotest_exchange(
+        unsigned char * _payload,
+        unsigned int    _payload_len,
+        void *          _userdata)
+{
+    struct flexframesync_autotest_exchange_s * ctx =
+        (struct flexframesync_autotest_exchange_s*) _userdata;
+    ctx->buffers[ctx->num_exchanged] = _payload;
+    ctx->buffer_len                  = _payload_len;
+    ctx->num_exchanged++;
+    return (unsigned char*) malloc(_payload_len*sizeof(unsigned char));
+}
+
+//
+// AUTOTEST : test zero-copy payload delivery with the buffer-exchange
+//            callback; retained buffers stay valid across frames
+//
+void autotest_flexframesync_buffer_exchange()
+{
+    unsigned int i;
+    unsigned int j;
+
+    unsigned int _payload_len = 200;
+    unsigned int _num_frames  = 3;
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_NONE;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object with buffer exchange enabled
+    struct flexframesync_autotest_exchange_s ctx = {.num_exchanged=0};
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    flexframesync_set_buffer_exchange(fs, flexframesync_autotest_exchange, (void*)&ctx);
+
+    // initialize header and payload
+    unsigned char header[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    for (j=0; j<_num_frames; j++) {
+        // tag payload with frame index and assemble the frame
+        payload[0] = j;
+        flexframegen_assemble(fg, header, payload, _payload_len);
+
+        // generate the frame
+        int frame_complete = 0;
+        float complex buf[2];
+        while (!frame_complete) {
+            // write samples to buffer
+            frame_complete = flexframegen_write_samples(fg, buf, 2);
+
+            // run through frame synchronizer
+            flexframesync_execute(fs, buf, 2);
+        }
+    }
+
+    // check that each frame produced an exchange and that the retained
+    // buffers still hold the decoded payloads after later frames ran
+    CONTEND_EQUALITY( ctx.num_exchanged, _num_frames );
+    CONTEND_EQUALITY( ctx.buffer_len,    _payload_len );
+    for (j=0; j<ctx.num_exchanged; j++) {
+        CONTEND_EQUALITY( ctx.buffers[j][0], j );
+        CONTEND_SAME_DATA( &ctx.buffers[j][1], &payload[1], _payload_len-1 );
+        free(ctx.buffers[j]);
+    }
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+//
+// AUTOTEST : recover a burst of frames with varying payload lengths
+//            from a single generator pre-allocated to the maximum
+//
+void autotest_flexframesync_varying_len()
+{
+    unsigned int payload_lens[4] = {400, 40, 200, 120};
+    unsigned int num_frames = 4;
+    unsigned int i, f;
+
+    // create flexframegen object, pre-allocating for the longest payload
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_HAMMING74;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+    flexframegen_set_payload_len_max(fg, 400);
+
+    // create flexframesync object
+    flexframesync fs = flexframesync_create(NULL,NULL);
+
+    unsigned char header[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    unsigned char payload[400];
+    unsigned int num_bytes = 0;
+    float complex buf[2];
+
+    for (f=0; f<num_frames; f++) {
+        // initialize payload and assemble frame
+        for (i=0; i<payload_lens[f]; i++)
+            payload[i] = rand() & 0xff;
+        flexframegen_assemble(fg, header, payload, payload_lens[f]);
+        num_bytes += payload_lens[f];
+
+        // generate the frame and run through synchronizer
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 2);
+            flexframesync_execute(fs, buf, 2);
+        }
+    }
+
+    // check to see that all frames were recovered
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (liquid_autotest_verbose)
+        flexframesync_print(fs);
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,  num_bytes );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
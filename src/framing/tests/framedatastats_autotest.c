@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// per-thread slots merge into correct aggregate counters, histogram,
+// and percentiles
+void autotest_framedatastats_acc()
+{
+    framedatastats_acc q = framedatastats_acc_create(3);
+
+    // empty accumulator
+    framedatastats_s stats = framedatastats_acc_get(q);
+    CONTEND_EQUALITY( stats.num_frames_detected, 0 );
+    CONTEND_EQUALITY( framedatastats_acc_get_latency(q, 0.5f), 0.0f );
+
+    // slot 0: two good frames at ~10 us, slot 1: one header-only frame
+    // at ~100 us, slot 2: one missed frame (no latency sample)
+    framedatastats_acc_update(q, 0, 1, 1, 64, 10e-6f);
+    framedatastats_acc_update(q, 0, 1, 1, 64, 10e-6f);
+    framedatastats_acc_update(q, 1, 1, 0,  0, 100e-6f);
+    framedatastats_acc_update(q, 2, 0, 0,  0, -1.0f);
+
+    // merged counters
+    stats = framedatastats_acc_get(q);
+    CONTEND_EQUALITY( stats.num_frames_detected, 4   );
+    CONTEND_EQUALITY( stats.num_headers_valid,   3   );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  2   );
+    CONTEND_EQUALITY( stats.num_bytes_received,  128 );
+
+    // merged histogram: 10 us lands in [8,16) us, 100 us in [64,128) us
+    unsigned long int counts[LIQUID_FRAMEDATASTATS_HIST];
+    framedatastats_acc_get_histogram(q, counts);
+    unsigned long int total = 0;
+    unsigned int b;
+    for (b=0; b<LIQUID_FRAMEDATASTATS_HIST; b++)
+        total += counts[b];
+    CONTEND_EQUALITY( total,     3 );
+    CONTEND_EQUALITY( counts[3], 2 );
+    CONTEND_EQUALITY( counts[6], 1 );
+
+    // bucket edges are a log scale starting at 1 microsecond
+    CONTEND_DELTA( framedatastats_acc_histogram_edge(0), 1e-6f, 1e-9f );
+    CONTEND_DELTA( framedatastats_acc_histogram_edge(3), 8e-6f, 1e-9f );
+
+    // percentiles report the containing bucket's upper edge
+    CONTEND_DELTA( framedatastats_acc_get_latency(q, 0.50f),  16e-6f, 1e-9f );
+    CONTEND_DELTA( framedatastats_acc_get_latency(q, 0.99f), 128e-6f, 1e-9f );
+
+    if (liquid_autotest_verbose)
+        framedatastats_acc_print(q);
+
+    // reset clears every slot
+    framedatastats_acc_reset(q);
+    stats = framedatastats_acc_get(q);
+    CONTEND_EQUALITY( stats.num_frames_detected, 0 );
+    CONTEND_EQUALITY( framedatastats_acc_get_latency(q, 0.5f), 0.0f );
+
+    framedatastats_acc_destroy(q);
+}
+
+// worker context for concurrent update test
+struct framedatastats_acc_worker_s {
+    framedatastats_acc q;           // shared accumulator
+    unsigned int       thread;      // this worker's slot index
+    unsigned int       num_updates; // updates to apply
+};
+
+static void * framedatastats_acc_worker(void * _context)
+{
+    struct framedatastats_acc_worker_s * w =
+        (struct framedatastats_acc_worker_s *) _context;
+    unsigned int i;
+    for (i=0; i<w->num_updates; i++)
+        framedatastats_acc_update(w->q, w->thread, 1, i % 2, 10, 20e-6f);
+    return NULL;
+}
+
+// concurrent updates from several threads merge without losing counts
+void autotest_framedatastats_acc_threaded()
+{
+    unsigned int num_threads = 4;
+    unsigned int num_updates = 20000;
+    framedatastats_acc q = framedatastats_acc_create(num_threads);
+
+    // spawn workers, each hammering its own slot
+    pthread_t threads[num_threads];
+    struct framedatastats_acc_worker_s workers[num_threads];
+    unsigned int i;
+    for (i=0; i<num_threads; i++) {
+        workers[i].q           = q;
+        workers[i].thread      = i;
+        workers[i].num_updates = num_updates;
+        pthread_create(&threads[i], NULL, framedatastats_acc_worker, &workers[i]);
+    }
+    for (i=0; i<num_threads; i++)
+        pthread_join(threads[i], NULL);
+
+    // every update is accounted for
+    framedatastats_s stats = framedatastats_acc_get(q);
+    CONTEND_EQUALITY( stats.num_frames_detected, num_threads * num_updates        );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_threads * num_updates        );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_threads * num_updates / 2    );
+    CONTEND_EQUALITY( stats.num_bytes_received,  num_threads * num_updates / 2*10 );
+
+    // all latency samples landed in the [16,32) us bucket
+    unsigned long int counts[LIQUID_FRAMEDATASTATS_HIST];
+    framedatastats_acc_get_histogram(q, counts);
+    CONTEND_EQUALITY( counts[4], num_threads * num_updates );
+
+    framedatastats_acc_destroy(q);
+}
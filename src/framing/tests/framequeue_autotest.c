@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// consumer context: verify drained records arrive in order with the
+// expected contents
+struct framequeue_autotest_ctx {
+    unsigned int num_received;  // number of records drained
+    unsigned int payload_len;   // expected payload length
+};
+
+static int framequeue_autotest_consumer(unsigned char *  _header,
+                                        int              _header_valid,
+                                        unsigned char *  _payload,
+                                        unsigned int     _payload_len,
+                                        int              _payload_valid,
+                                        framesyncstats_s _stats,
+                                        void *           _userdata)
+{
+    struct framequeue_autotest_ctx * ctx =
+        (struct framequeue_autotest_ctx*) _userdata;
+
+    // records carry their production index in the header and payload
+    unsigned int n = ctx->num_received;
+    CONTEND_EQUALITY( _header[0],     n & 0xff );
+    CONTEND_EQUALITY( _header_valid,  1        );
+    CONTEND_EQUALITY( _payload_len,   ctx->payload_len );
+    CONTEND_EQUALITY( _payload_valid, (int)(n % 2) );
+    unsigned int i;
+    for (i=0; i<_payload_len; i++)
+        CONTEND_EQUALITY( _payload[i], (n+i) & 0xff );
+
+    // statistics (including copied frame symbols) follow the record
+    CONTEND_DELTA( _stats.rssi, -(float)n, 1e-6f );
+    CONTEND_EQUALITY( _stats.num_framesyms, 4 );
+    CONTEND_DELTA( crealf(_stats.framesyms[0]), (float)n, 1e-6f );
+
+    ctx->num_received++;
+    return 0;
+}
+
+// push records through the queue, exercising wrap-around with more
+// records than the queue capacity
+void autotest_framequeue_flow()
+{
+    unsigned int capacity    =  8;
+    unsigned int header_len  =  8;
+    unsigned int payload_len = 64;
+    unsigned int num_frames  = 20;
+    unsigned int i, n;
+
+    framequeue q = framequeue_create(capacity, header_len, LIQUID_FRAMEQUEUE_DROP);
+    CONTEND_EQUALITY( framequeue_get_capacity(q), capacity );
+    CONTEND_EQUALITY( framequeue_get_size(q),     0        );
+
+    struct framequeue_autotest_ctx ctx = {0, payload_len};
+    unsigned char header [header_len];
+    unsigned char payload[payload_len];
+    float complex framesyms[4];
+    framesyncstats_s stats;
+
+    // alternate producing a few records and draining them so the ring
+    // wraps several times
+    for (n=0; n<num_frames; n++) {
+        unsigned int m = n;
+        unsigned int batch = 1 + (n % 3);
+        for (i=0; i<batch && n<num_frames; i++, n++) {
+            header[0] = n & 0xff;
+            unsigned int j;
+            for (j=0; j<payload_len; j++)
+                payload[j] = (n+j) & 0xff;
+            framesyncstats_init_default(&stats);
+            stats.rssi          = -(float)n;
+            stats.framesyms     = framesyms;
+            stats.num_framesyms = 4;
+            framesyms[0]        = (float)n;
+            framequeue_callback(header, 1, payload, payload_len, n % 2,
+                                stats, (void*)q);
+        }
+        CONTEND_EQUALITY( framequeue_get_size(q), n-m );
+        CONTEND_EQUALITY( framequeue_drain(q, framequeue_autotest_consumer,
+                                           (void*)&ctx), n-m );
+        n--;    // outer loop increment
+    }
+
+    // all records received in order, none dropped
+    CONTEND_EQUALITY( ctx.num_received, num_frames );
+    CONTEND_EQUALITY( framequeue_get_num_dropped(q), 0 );
+    CONTEND_EQUALITY( framequeue_get_size(q), 0 );
+
+    framequeue_destroy(q);
+}
+
+// overflow with the drop policy: excess frames are discarded and
+// counted, queued frames are unaffected
+void autotest_framequeue_overflow()
+{
+    unsigned int capacity    = 4;
+    unsigned int header_len  = 8;
+    unsigned int payload_len = 16;
+    unsigned int num_frames  = 11;
+    unsigned int i, n;
+
+    framequeue q = framequeue_create(capacity, header_len, LIQUID_FRAMEQUEUE_DROP);
+
+    struct framequeue_autotest_ctx ctx = {0, payload_len};
+    unsigned char header [header_len];
+    unsigned char payload[payload_len];
+    float complex framesyms[4];
+    framesyncstats_s stats;
+
+    // produce more records than the queue can hold
+    for (n=0; n<num_frames; n++) {
+        header[0] = n & 0xff;
+        for (i=0; i<payload_len; i++)
+            payload[i] = (n+i) & 0xff;
+        framesyncstats_init_default(&stats);
+        stats.rssi          = -(float)n;
+        stats.framesyms     = framesyms;
+        stats.num_framesyms = 4;
+        framesyms[0]        = (float)n;
+        framequeue_callback(header, 1, payload, payload_len, n % 2,
+                            stats, (void*)q);
+    }
+
+    // the first 'capacity' records are queued, the rest dropped
+    CONTEND_EQUALITY( framequeue_get_size(q),        capacity );
+    CONTEND_EQUALITY( framequeue_get_num_dropped(q), num_frames - capacity );
+
+    // drain and verify the surviving records
+    CONTEND_EQUALITY( framequeue_drain(q, framequeue_autotest_consumer,
+                                       (void*)&ctx), capacity );
+    CONTEND_EQUALITY( ctx.num_received, capacity );
+
+    // reset discards pending records without invoking a callback
+    framequeue_callback(header, 1, payload, payload_len, 0, stats, (void*)q);
+    CONTEND_EQUALITY( framequeue_get_size(q), 1 );
+    framequeue_reset(q);
+    CONTEND_EQUALITY( framequeue_get_size(q), 0 );
+
+    framequeue_destroy(q);
+}
+
+// queued-callback mode on a real synchronizer: frame recovery runs
+// with framequeue_callback installed, and the application receives
+// the frame on a later drain
+static int framequeue_autotest_fs64_callback(unsigned char *  _header,
+                                             int              _header_valid,
+                                             unsigned char *  _payload,
+                                             unsigned int     _payload_len,
+                                             int              _payload_valid,
+                                             framesyncstats_s _stats,
+                                             void *           _userdata)
+{
+    unsigned char * ref = (unsigned char*) _userdata;
+    CONTEND_EQUALITY( _header_valid,  1  );
+    CONTEND_EQUALITY( _payload_valid, 1  );
+    CONTEND_EQUALITY( _payload_len,   64 );
+    CONTEND_SAME_DATA( _header,  ref,    8  );
+    CONTEND_SAME_DATA( _payload, ref+8,  64 );
+    return 0;
+}
+
+void autotest_framequeue_framesync64()
+{
+    unsigned int i;
+
+    // frame data: header and payload packed for reference
+    unsigned char ref[8+64];
+    for (i=0; i<8+64; i++)
+        ref[i] = rand() & 0xff;
+
+    // create frame generator and synchronizer depositing into queue
+    framegen64 fg = framegen64_create();
+    framequeue  q = framequeue_create(16, 8, LIQUID_FRAMEQUEUE_DROP);
+    framesync64 fs = framesync64_create(framequeue_callback, (void*)q);
+
+    // generate the frame with some noise
+    unsigned int frame_len = LIQUID_FRAME64_LEN;
+    float complex frame[frame_len];
+    framegen64_execute(fg, ref, ref+8, frame);
+    for (i=0; i<frame_len; i++)
+        frame[i] += 0.01f*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    // run synchronizer; the frame is queued, not delivered
+    framesync64_execute(fs, frame, frame_len);
+    CONTEND_EQUALITY( framequeue_get_size(q), 1 );
+
+    // drain from the application side
+    CONTEND_EQUALITY( framequeue_drain(q, framequeue_autotest_fs64_callback,
+                                       (void*)ref), 1 );
+
+    framegen64_destroy(fg);
+    framesync64_destroy(fs);
+    framequeue_destroy(q);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// populate a source generator with a deterministic scenario; the noise
+// source draws from a per-source generator seeded by its id, so two
+// objects built this way produce identical streams
+static void msourcecf_autotest_add_sources(msourcecf _q)
+{
+    msourcecf_add_tone (_q, -0.30f, 0.01f, -10.0f);
+    msourcecf_add_chirp(_q,  0.17f, 0.10f, -20.0f, 1000, 0, 0);
+    msourcecf_add_noise(_q,  0.00f, 0.20f, -30.0f);
+}
+
+//
+// AUTOTEST: threaded generation matches serial generation
+//
+void autotest_msourcecf_threaded()
+{
+    float        tol = 1e-5f;   // error tolerance
+    unsigned int n   = 4096;    // number of samples
+
+    // create serial and threaded generators with identical scenarios
+    msourcecf q0 = msourcecf_create(64, 4, 60);
+    msourcecf q1 = msourcecf_create(64, 4, 60);
+    msourcecf_autotest_add_sources(q0);
+    msourcecf_autotest_add_sources(q1);
+    msourcecf_set_num_threads(q1, 2);
+
+    // generate samples with both objects
+    float complex y0[n];
+    float complex y1[n];
+    msourcecf_write_samples(q0, y0, n);
+    msourcecf_write_samples(q1, y1, n);
+
+    // streams match to within reduction-order rounding
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // output is not degenerate
+    float energy = 0.0f;
+    for (i=0; i<n; i++)
+        energy += crealf( y0[i]*conjf(y0[i]) );
+    CONTEND_GREATER_THAN( energy, 0.0f );
+
+    msourcecf_destroy(q0);
+    msourcecf_destroy(q1);
+}
@@ -90,3 +90,147 @@ void autotest_ofdmflexframe_07() { testbench_ofdmflexframe(1200, 40, 20,    1, L
 void autotest_ofdmflexframe_08() { testbench_ofdmflexframe(1200,  0,  0,  800, LIQUID_MODEM_QPSK); }
 void autotest_ofdmflexframe_09() { testbench_ofdmflexframe(1200, 40, 20, 8217, LIQUID_MODEM_QPSK); }
 
+
+// AUTOTEST : test recovery of multiple frames with payload encoding
+//            pipelined on a background thread
+void autotest_ofdmflexframe_pipeline()
+{
+    unsigned int j;
+    unsigned int M           =   64;
+    unsigned int cp_len      =    8;
+    unsigned int taper_len   =    4;
+    unsigned int payload_len =  800;
+    unsigned int num_frames  =    3;
+
+    // create frame generator/synchronizer
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check        = LIQUID_CRC_32;
+    fgprops.fec0         = LIQUID_FEC_NONE;
+    fgprops.fec1         = LIQUID_FEC_NONE;
+    fgprops.mod_scheme   = LIQUID_MODEM_QPSK;
+    ofdmflexframegen  fg = ofdmflexframegen_create( M, cp_len, taper_len, NULL, &fgprops);
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL, NULL, NULL);
+
+    // enable pipelined assembly on background encoder thread
+    ofdmflexframegen_pipeline_enable(fg);
+
+    // initialize header and payload
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    memset(payload, 0x00, payload_len);
+
+    unsigned int  buf_len = 1024;
+    float complex buf[buf_len];
+    for (j=0; j<num_frames; j++) {
+        // stage the frame; encoding runs on the background thread
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        // generate the frame; leading samples may be zeros while the
+        // pipeline encodes
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, buf_len);
+            ofdmflexframesync_execute(fs, buf, buf_len);
+        }
+    }
+
+    // disable pipeline
+    ofdmflexframegen_pipeline_disable(fg);
+
+    // verify frame data statistics
+    framedatastats_s stats = ofdmflexframesync_get_framedatastats(fs);
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,  num_frames*payload_len );
+
+    // destroy objects
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+// callback for threaded sync test; first payload byte carries the frame
+// index, ensuring frames are delivered in the order they were detected
+static int ofdmflexframe_autotest_threaded_sync_callback(
+        unsigned char *  _header,
+        int              _header_valid,
+        unsigned char *  _payload,
+        unsigned int     _payload_len,
+        int              _payload_valid,
+        framesyncstats_s _stats,
+        void *           _userdata)
+{
+    unsigned int * num_frames_received = (unsigned int*) _userdata;
+    CONTEND_EQUALITY( _header_valid,  1 );
+    CONTEND_EQUALITY( _payload_valid, 1 );
+    if (_payload_valid)
+        CONTEND_EQUALITY( _payload[0], *num_frames_received );
+    *num_frames_received += 1;
+    return 0;
+}
+
+// AUTOTEST : test recovery of multiple frames with payload decoding
+//            handed to an internal worker pool
+void autotest_ofdmflexframe_threaded_sync()
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int M           = 64;
+    unsigned int cp_len      = 8;
+    unsigned int taper_len   = 4;
+    unsigned int payload_len = 800;
+    unsigned int num_frames  = 5;
+
+    // create frame generator
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check        = LIQUID_CRC_32;
+    fgprops.fec0         = LIQUID_FEC_NONE;
+    fgprops.fec1         = LIQUID_FEC_GOLAY2412;
+    fgprops.mod_scheme   = LIQUID_MODEM_QPSK;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, &fgprops);
+
+    // create frame synchronizer with two payload decoding threads
+    unsigned int num_frames_received = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+            ofdmflexframe_autotest_threaded_sync_callback,
+            (void*)&num_frames_received);
+    ofdmflexframesync_set_threads(fs, 2);
+
+    // initialize header and payload
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    for (j=0; j<num_frames; j++) {
+        // tag payload with frame index and assemble the frame
+        payload[0] = j;
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        // generate the frame
+        unsigned int  buf_len = 1024;
+        float complex buf[buf_len];
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, buf_len);
+            ofdmflexframesync_execute(fs, buf, buf_len);
+        }
+    }
+
+    // drain worker pool, delivering any outstanding frames
+    ofdmflexframesync_set_threads(fs, 0);
+
+    // verify all frames were recovered and delivered in order
+    framedatastats_s stats = ofdmflexframesync_get_framedatastats(fs);
+    CONTEND_EQUALITY( num_frames_received,       num_frames );
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,  num_frames*payload_len );
+
+    // destroy objects
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
@@ -58,6 +58,109 @@ void autotest_qdetector_cccf_gmsk_n671()    { qdetector_cccf_runtest_gmsk  ( 671
 void autotest_qdetector_cccf_gmsk_n1024()   { qdetector_cccf_runtest_gmsk  (1024); }
 void autotest_qdetector_cccf_gmsk_n1341()   { qdetector_cccf_runtest_gmsk  (1341); }
 
+//
+// AUTOTEST : swap template in place and copy object, re-using the
+//            pre-computed template spectrum; both the re-targeted
+//            original and the copy should detect the new sequence
+//
+void autotest_qdetector_cccf_template_reuse()
+{
+    unsigned int seq_len = 240;     // sequence length (samples)
+    unsigned int i;
+
+    // generate two random QPSK sample sequences
+    float complex seq_0[seq_len];
+    float complex seq_1[seq_len];
+    for (i=0; i<seq_len; i++) {
+        seq_0[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                   (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+        seq_1[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                   (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+    }
+
+    // create detector with first sequence, then swap in second template
+    qdetector_cccf q = qdetector_cccf_create(seq_0, seq_len);
+    qdetector_cccf_reset_template(q, seq_1, seq_len);
+    CONTEND_EQUALITY( qdetector_cccf_get_seq_len(q), seq_len );
+
+    // copy object, inheriting the second template
+    qdetector_cccf q_copy = qdetector_cccf_copy(q);
+    CONTEND_EQUALITY( qdetector_cccf_get_buf_len(q_copy), qdetector_cccf_get_buf_len(q) );
+
+    // assemble test signal: silence, second sequence, silence
+    unsigned int buf_len     = qdetector_cccf_get_buf_len(q);
+    unsigned int num_samples = 2*buf_len + seq_len;
+    float complex y[num_samples];
+    for (i=0; i<num_samples; i++) {
+        y[i]  = (i >= buf_len && i < buf_len + seq_len) ? seq_1[i-buf_len] : 0.0f;
+        y[i] += 0.01f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+    }
+
+    // both detectors should find the new sequence
+    int detected_orig = 0;
+    int detected_copy = 0;
+    for (i=0; i<num_samples; i++) {
+        if (qdetector_cccf_execute(q,      y[i]) != NULL) detected_orig = 1;
+        if (qdetector_cccf_execute(q_copy, y[i]) != NULL) detected_copy = 1;
+    }
+    CONTEND_EQUALITY( detected_orig, 1 );
+    CONTEND_EQUALITY( detected_copy, 1 );
+
+    // destroy objects
+    qdetector_cccf_destroy(q);
+    qdetector_cccf_destroy(q_copy);
+}
+
+//
+// AUTOTEST : search for multiple templates simultaneously with a single
+//            detector object, checking that the matching template index
+//            is reported for each detection
+//
+void autotest_qdetector_cccf_multi_template()
+{
+    unsigned int seq_len       = 240;   // sequence length (samples)
+    unsigned int num_templates =   4;   // number of detection templates
+    unsigned int i;
+    unsigned int t;
+
+    // generate random QPSK sample sequences
+    float complex seq[num_templates][seq_len];
+    for (t=0; t<num_templates; t++) {
+        for (i=0; i<seq_len; i++) {
+            seq[t][i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                        (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+        }
+    }
+
+    // create detector with first sequence and add remaining templates
+    qdetector_cccf q = qdetector_cccf_create(seq[0], seq_len);
+    for (t=1; t<num_templates; t++)
+        qdetector_cccf_add_template(q, seq[t], seq_len);
+    if (liquid_autotest_verbose)
+        qdetector_cccf_print(q);
+
+    unsigned int buf_len = qdetector_cccf_get_buf_len(q);
+
+    // send each sequence in turn, surrounded by silence, and check that
+    // the appropriate template index is reported
+    for (t=0; t<num_templates; t++) {
+        unsigned int num_samples = 2*buf_len + seq_len;
+        int detected = 0;
+        for (i=0; i<num_samples; i++) {
+            float complex y = (i >= buf_len && i < buf_len + seq_len) ? seq[t][i-buf_len] : 0.0f;
+            y += 0.01f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+
+            if (qdetector_cccf_execute(q, y) != NULL)
+                detected = 1;
+        }
+        CONTEND_EQUALITY( detected, 1 );
+        CONTEND_EQUALITY( qdetector_cccf_get_template_index(q), t );
+    }
+
+    // destroy object
+    qdetector_cccf_destroy(q);
+}
+
 // autotest helper function
 //  _sequence_len   :   sequence length
 void qdetector_cccf_runtest_linear(unsigned int _sequence_len)
@@ -306,3 +409,77 @@ void qdetector_cccf_runtest_gmsk(unsigned int _sequence_len)
 }
 
 
+
+//
+// AUTOTEST : detect sequence with a large carrier frequency offset by
+//            widening the multi-hypothesis search range; a second
+//            detector left at its default range should miss the frame
+//
+void autotest_qdetector_cccf_cfo_search()
+{
+    unsigned int k     =    2;      // samples per symbol
+    unsigned int m     =    7;      // filter delay [symbols]
+    float        beta  = 0.3f;      // excess bandwidth factor
+    int          ftype = LIQUID_FIRFILT_ARKAISER; // filter type
+    unsigned int sequence_len = 240;// sequence length (symbols)
+    float        dphi  = 0.60f;     // carrier frequency offset [radians/sample]
+    unsigned int i;
+
+    // generate synchronization sequence (QPSK symbols)
+    float complex sequence[sequence_len];
+    for (i=0; i<sequence_len; i++) {
+        sequence[i] = (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 +
+                      (rand() % 2 ? 1.0f : -1.0f) * M_SQRT1_2 * _Complex_I;
+    }
+
+    // generate transmitted signal: sequence surrounded by random symbols
+    unsigned int num_symbols = 8*sequence_len + 2*m;
+    unsigned int num_samples = k * num_symbols;
+    float complex y[num_samples];
+    firinterp_crcf interp = firinterp_crcf_create_prototype(ftype, k, m, beta, 0);
+    unsigned int n = 0;
+    for (i=0; i<num_symbols; i++) {
+        float complex sym = i < sequence_len ? sequence[i] : sequence[rand()%sequence_len];
+        firinterp_crcf_execute(interp, sym, &y[n]);
+        n += k;
+    }
+    firinterp_crcf_destroy(interp);
+
+    // apply carrier offset
+    for (i=0; i<num_samples; i++)
+        y[i] *= cexpf(_Complex_I*dphi*i);
+
+    // create two detectors: wide carrier offset search and default
+    qdetector_cccf q0 = qdetector_cccf_create_linear(sequence, sequence_len, ftype, k, m, beta);
+    qdetector_cccf q1 = qdetector_cccf_create_linear(sequence, sequence_len, ftype, k, m, beta);
+    qdetector_cccf_set_range(q0, 0.7f);
+
+    // try to detect frame with both detectors
+    int   frame_detected_0 = 0;
+    int   frame_detected_1 = 0;
+    float dphi_hat = 0.0f;
+    for (i=0; i<num_samples; i++) {
+        if (!frame_detected_0 && qdetector_cccf_execute(q0,y[i]) != NULL) {
+            frame_detected_0 = 1;
+            dphi_hat = qdetector_cccf_get_dphi(q0);
+        }
+        if (!frame_detected_1 && qdetector_cccf_execute(q1,y[i]) != NULL)
+            frame_detected_1 = 1;
+    }
+
+    if (liquid_autotest_verbose) {
+        printf("qdetector_cccf_cfo_search: wide:%s, default:%s, dphi-hat=%8.5f (actual %8.5f)\n",
+                frame_detected_0 ? "detected" : "missed",
+                frame_detected_1 ? "detected" : "missed",
+                dphi_hat, dphi);
+    }
+
+    // wide-range detector finds the frame and estimates the offset;
+    // default range (0.3 radians/sample) cannot reach it
+    CONTEND_EQUALITY( frame_detected_0, 1 );
+    CONTEND_EQUALITY( frame_detected_1, 0 );
+    CONTEND_DELTA( dphi_hat, dphi, 0.01f );
+
+    qdetector_cccf_destroy(q0);
+    qdetector_cccf_destroy(q1);
+}
@@ -182,3 +182,46 @@ void autotest_qpilotsync_300_24() { qpilotsync_test(LIQUID_MODEM_QPSK, 300, 24,
 void autotest_qpilotsync_400_28() { qpilotsync_test(LIQUID_MODEM_QPSK, 400, 28, 0.07f, 1.2f, 0.7f, 40.0f); }
 void autotest_qpilotsync_500_32() { qpilotsync_test(LIQUID_MODEM_QPSK, 500, 32, 0.07f, 1.2f, 0.7f, 40.0f); }
 
+
+//
+// AUTOTEST : recreate with new frame lengths keeps the synchronizer
+//            equivalent to a freshly-created object
+//
+void autotest_qpilotsync_recreate()
+{
+    unsigned int i;
+    unsigned int payload_lens[4] = {100, 400, 100, 250};
+    unsigned int pilot_spacing   = 16;
+
+    qpilotsync q0 = NULL;
+    for (i=0; i<4; i++) {
+        // recreate object (in place where lengths permit) and compare
+        // its configuration to a fresh object
+        q0 = qpilotsync_recreate(q0, payload_lens[i], pilot_spacing);
+        qpilotsync q1 = qpilotsync_create(payload_lens[i], pilot_spacing);
+
+        CONTEND_EQUALITY( qpilotsync_get_frame_len(q0),
+                          qpilotsync_get_frame_len(q1) );
+
+        // process an impaired frame through each and compare recovery
+        unsigned int frame_len = qpilotsync_get_frame_len(q0);
+        float complex frame_rx  [frame_len];
+        float complex payload_0 [payload_lens[i]];
+        float complex payload_1 [payload_lens[i]];
+        unsigned int  j;
+        for (j=0; j<frame_len; j++)
+            frame_rx[j] = cexpf(_Complex_I*(0.02f*j + 0.5f)) * (randnf() + _Complex_I*randnf())*M_SQRT1_2;
+        qpilotsync_execute(q0, frame_rx, payload_0);
+        qpilotsync_execute(q1, frame_rx, payload_1);
+        CONTEND_DELTA( qpilotsync_get_dphi(q0), qpilotsync_get_dphi(q1), 1e-6f );
+        CONTEND_DELTA( qpilotsync_get_phi (q0), qpilotsync_get_phi (q1), 1e-6f );
+        CONTEND_DELTA( qpilotsync_get_gain(q0), qpilotsync_get_gain(q1), 1e-6f );
+        for (j=0; j<payload_lens[i]; j++) {
+            CONTEND_DELTA( crealf(payload_0[j]), crealf(payload_1[j]), 1e-6f );
+            CONTEND_DELTA( cimagf(payload_0[j]), cimagf(payload_1[j]), 1e-6f );
+        }
+
+        qpilotsync_destroy(q1);
+    }
+    qpilotsync_destroy(q0);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : acquire/release re-uses objects keyed on configuration
+//
+void autotest_qpmpool_reuse()
+{
+    qpmpool pool = qpmpool_create();
+
+    // acquire two distinct configurations
+    qpacketmodem q0 = qpmpool_acquire(pool, 64, LIQUID_CRC_32,
+        LIQUID_FEC_GOLAY2412, LIQUID_FEC_NONE, LIQUID_MODEM_QPSK);
+    qpacketmodem q1 = qpmpool_acquire(pool, 200, LIQUID_CRC_16,
+        LIQUID_FEC_NONE, LIQUID_FEC_NONE, LIQUID_MODEM_QAM16);
+    CONTEND_EXPRESSION(q0 != NULL);
+    CONTEND_EXPRESSION(q1 != NULL);
+    CONTEND_EQUALITY(qpmpool_get_num_objects(pool), 2);
+
+    // same configuration while q0 is checked out: new object
+    qpacketmodem q2 = qpmpool_acquire(pool, 64, LIQUID_CRC_32,
+        LIQUID_FEC_GOLAY2412, LIQUID_FEC_NONE, LIQUID_MODEM_QPSK);
+    CONTEND_EXPRESSION(q2 != q0);
+    CONTEND_EQUALITY(qpmpool_get_num_objects(pool), 3);
+
+    // release and re-acquire: same object comes back, pool does not grow
+    CONTEND_EQUALITY(qpmpool_release(pool, q0), 0);
+    qpacketmodem q3 = qpmpool_acquire(pool, 64, LIQUID_CRC_32,
+        LIQUID_FEC_GOLAY2412, LIQUID_FEC_NONE, LIQUID_MODEM_QPSK);
+    CONTEND_EXPRESSION(q3 == q0);
+    CONTEND_EQUALITY(qpmpool_get_num_objects(pool), 3);
+
+    if (liquid_autotest_verbose)
+        qpmpool_print(pool);
+
+    qpmpool_destroy(pool);
+}
+
+//
+// AUTOTEST : pooled object encodes/decodes like a fresh one
+//
+void autotest_qpmpool_recovery()
+{
+    unsigned int payload_len = 100;
+    unsigned int i, trial;
+
+    qpmpool pool = qpmpool_create();
+    for (trial=0; trial<4; trial++) {
+        qpacketmodem q = qpmpool_acquire(pool, payload_len, LIQUID_CRC_32,
+            LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE, LIQUID_MODEM_QPSK);
+        CONTEND_EXPRESSION(q != NULL);
+
+        unsigned int frame_len = qpacketmodem_get_frame_len(q);
+        unsigned char payload_tx[payload_len];
+        unsigned char payload_rx[payload_len];
+        liquid_float_complex frame[frame_len];
+        for (i=0; i<payload_len; i++)
+            payload_tx[i] = rand() & 0xff;
+
+        qpacketmodem_encode(q, payload_tx, frame);
+        int crc_pass = qpacketmodem_decode(q, frame, payload_rx);
+
+        CONTEND_EQUALITY(crc_pass, 1);
+        CONTEND_SAME_DATA(payload_tx, payload_rx, payload_len);
+
+        qpmpool_release(pool, q);
+    }
+
+    // every trial re-used the single pooled object
+    CONTEND_EQUALITY(qpmpool_get_num_objects(pool), 1);
+    qpmpool_destroy(pool);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: cached pattern matches direct rendering of the steady-state
+//           waveform and stitches phase-continuously across periods
+//
+void autotest_symstreamcf_pattern()
+{
+    float        tol = 1e-6f;   // error tolerance
+    unsigned int k   = 4;       // samples/symbol
+    unsigned int m   = 7;       // filter delay
+    float        beta= 0.3f;    // excess bandwidth
+    unsigned int P   = 16;      // pattern length [symbols]
+    unsigned int i;
+
+    // deterministic QPSK symbol pattern
+    unsigned int syms[P];
+    for (i=0; i<P; i++)
+        syms[i] = (i*i + 3*i + 1) % 4;
+
+    // create generator with cached pattern
+    symstreamcf gen = symstreamcf_create_linear(LIQUID_FIRFILT_RRC,k,m,beta,LIQUID_MODEM_QPSK);
+    symstreamcf_set_pattern(gen, syms, P);
+
+    // generate several periods with uneven block sizes
+    unsigned int num_samples = 4*P*k;
+    float complex y[num_samples];
+    symstreamcf_write_samples(gen, y,                 13);
+    symstreamcf_write_samples(gen, y+13,              P*k);
+    symstreamcf_write_samples(gen, y+13+P*k, num_samples-13-P*k);
+
+    // render reference directly: run the pattern through an identical
+    // modulation/interpolation chain past the filter transient, then
+    // capture the steady-state waveform
+    modem        mod    = modem_create(LIQUID_MODEM_QPSK);
+    firinterp_crcf interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC,k,m,beta,0);
+    float complex buf[k];
+    float complex ref[P*k];
+    float complex v;
+    unsigned int  r;
+    for (r=0; r<2; r++) {
+        for (i=0; i<P; i++) {
+            modem_modulate(mod, syms[i], &v);
+            firinterp_crcf_execute(interp, v, buf);
+        }
+    }
+    for (i=0; i<P; i++) {
+        modem_modulate(mod, syms[i], &v);
+        firinterp_crcf_execute(interp, v, ref + i*k);
+    }
+    modem_destroy(mod);
+    firinterp_crcf_destroy(interp);
+
+    // compare all generated samples against cyclic reference
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y[i]), crealf(ref[i % (P*k)]), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(ref[i % (P*k)]), tol );
+    }
+
+    // clearing the pattern reverts to the regular generator path
+    symstreamcf_clear_pattern(gen);
+    symstreamcf_write_samples(gen, y, num_samples);
+    float energy = 0.0f;
+    for (i=0; i<num_samples; i++)
+        energy += crealf( y[i]*conjf(y[i]) );
+    CONTEND_GREATER_THAN( energy, 0.0f );
+
+    symstreamcf_destroy(gen);
+}
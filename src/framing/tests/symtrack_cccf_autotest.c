@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// verify the fused block execution path produces the same symbol
+// stream as running the synchronizer one sample at a time
+void autotest_symtrack_cccf_execute_block()
+{
+    unsigned int k           =    2;    // samples per symbol
+    unsigned int m           =    7;    // filter delay
+    float        beta        = 0.3f;    // filter excess bandwidth
+    unsigned int num_symbols =  800;    // number of symbols to generate
+
+    unsigned int i;
+
+    // create pair of identical synchronizers
+    symtrack_cccf q0 = symtrack_cccf_create(LIQUID_FIRFILT_ARKAISER,
+            k, m, beta, LIQUID_MODEM_QPSK);
+    symtrack_cccf q1 = symtrack_cccf_create(LIQUID_FIRFILT_ARKAISER,
+            k, m, beta, LIQUID_MODEM_QPSK);
+
+    // generate shaped QPSK input signal
+    unsigned int num_samples = k*num_symbols;
+    float complex x[num_samples];
+    symstreamcf gen = symstreamcf_create_linear(LIQUID_FIRFILT_ARKAISER,
+            k, m, beta, LIQUID_MODEM_QPSK);
+    symstreamcf_write_samples(gen, x, num_samples);
+    symstreamcf_destroy(gen);
+
+    // run first object one sample at a time
+    float complex y0[num_symbols + 64];
+    unsigned int  ny0 = 0;
+    for (i=0; i<num_samples; i++) {
+        unsigned int nw = 0;
+        symtrack_cccf_execute(q0, x[i], y0+ny0, &nw);
+        ny0 += nw;
+    }
+
+    // run second object on entire block, split unevenly to exercise
+    // the internal chunking
+    float complex y1[num_symbols + 64];
+    unsigned int  ny1 = 0;
+    unsigned int  nw  = 0;
+    symtrack_cccf_execute_block(q1, x,     300,             y1,     &nw); ny1 += nw;
+    symtrack_cccf_execute_block(q1, x+300, num_samples-300, y1+ny1, &nw); ny1 += nw;
+
+    // verify matching output symbol streams; the block path uses the
+    // agc's sub-block gain approximation, so allow a small tolerance
+    CONTEND_EQUALITY(ny0, ny1);
+    float tol = 0.05f;
+    for (i=0; i<ny0; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects
+    symtrack_cccf_destroy(q0);
+    symtrack_cccf_destroy(q1);
+}
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iqreadercf : streaming sample reader for IQ recordings
+//
+// Samples are delivered as 32-bit float complex regardless of the
+// on-disk format; integer formats are converted (and scaled) on load.
+// The file is memory-mapped where the platform supports it; otherwise
+// a prefetch thread keeps one buffer ahead of the consumer so disk
+// reads and conversion overlap with processing.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef _POSIX_MAPPED_FILES
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define LIQUID_IQREADER_THREADED 1
+#else
+#define LIQUID_IQREADER_THREADED 0
+#endif
+
+// number of samples per prefetch buffer (stream path)
+#define LIQUID_IQREADER_BUF_LEN (16384)
+
+// scaling factor applied to 16-bit integer samples on load
+#define LIQUID_IQFILE_SC16_SCALE (1.0f/32768.0f)
+
+// internal: bytes per raw sample for a given format
+unsigned int liquid_iqfile_sample_size(int _format)
+{
+    switch (_format) {
+    case LIQUID_IQFILE_CF32: return 2*sizeof(float);
+    case LIQUID_IQFILE_SC16: return 2*sizeof(int16_t);
+    default:
+        fprintf(stderr,"error: liquid_iqfile_sample_size(), invalid format\n");
+        exit(1);
+    }
+    return 0;
+}
+
+// internal: convert a block of raw samples to 32-bit float complex
+//  _format : on-disk sample format
+//  _raw    : raw input array [size: _n samples]
+//  _n      : number of samples
+//  _buf    : output array [size: _n x 1]
+void liquid_iqfile_convert_to_cf32(int             _format,
+                                   unsigned char * _raw,
+                                   unsigned long int _n,
+                                   float complex * _buf)
+{
+    unsigned long int i;
+    switch (_format) {
+    case LIQUID_IQFILE_CF32:
+        memmove(_buf, _raw, _n*sizeof(float complex));
+        break;
+    case LIQUID_IQFILE_SC16: {
+        // simple independent scaling loop; compilers vectorize this
+        const int16_t * v = (const int16_t*)_raw;
+        for (i=0; i<_n; i++)
+            _buf[i] = (v[2*i+0] + _Complex_I*v[2*i+1]) * LIQUID_IQFILE_SC16_SCALE;
+        break;
+    }
+    default:;
+    }
+}
+
+struct iqreadercf_s {
+    char *            filename;     // input file name
+    int               format;       // on-disk sample format
+    unsigned int      sample_size;  // bytes per raw sample
+    unsigned long int num_samples;  // total samples in file
+    unsigned long int index;        // consumer read position (samples)
+
+    // memory-mapped path
+    int               use_mmap;     // file successfully mapped?
+    unsigned char *   map;          // mapped file contents
+    size_t            map_len;      // mapped length (bytes)
+
+    // streamed path
+    FILE *            fid;          // input file stream
+    float complex *   buf[2];       // converted double buffers
+    unsigned long int buf_len[2];   // valid samples per buffer
+    unsigned long int buf_index;    // consumer position in active buffer
+    unsigned int      buf_active;   // buffer being consumed
+    unsigned char *   raw;          // raw read scratch
+
+#if LIQUID_IQREADER_THREADED
+    // prefetch thread state
+    pthread_t         thread;       // prefetch worker
+    pthread_mutex_t   mutex;        //
+    pthread_cond_t    cond;         //
+    int               next_ready;   // inactive buffer filled?
+    int               eof;          // worker reached end of file
+    int               done;         // object shutting down
+#endif
+};
+
+// internal: fill a buffer with converted samples from the file stream
+//  returns the number of samples read
+unsigned long int iqreadercf_fill(iqreadercf _q, unsigned int _which)
+{
+    unsigned long int n = fread(_q->raw, _q->sample_size,
+            LIQUID_IQREADER_BUF_LEN, _q->fid);
+    liquid_iqfile_convert_to_cf32(_q->format, _q->raw, n, _q->buf[_which]);
+    _q->buf_len[_which] = n;
+    return n;
+}
+
+#if LIQUID_IQREADER_THREADED
+// prefetch worker: keep the inactive buffer filled one step ahead of
+// the consumer
+void * iqreadercf_prefetch(void * _arg)
+{
+    iqreadercf q = (iqreadercf) _arg;
+
+    pthread_mutex_lock(&q->mutex);
+    while (!q->done) {
+        if (q->next_ready || q->eof) {
+            // nothing to do until the consumer swaps buffers
+            pthread_cond_wait(&q->cond, &q->mutex);
+            continue;
+        }
+
+        // fill inactive buffer outside the lock (fread + conversion)
+        unsigned int which = 1 - q->buf_active;
+        pthread_mutex_unlock(&q->mutex);
+        unsigned long int n = iqreadercf_fill(q, which);
+        pthread_mutex_lock(&q->mutex);
+
+        if (n < LIQUID_IQREADER_BUF_LEN)
+            q->eof = 1;
+        q->next_ready = 1;
+        pthread_cond_signal(&q->cond);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
+
+// create sample stream reader
+//  _filename   : input file name
+//  _format     : on-disk sample format (e.g. LIQUID_IQFILE_SC16)
+iqreadercf iqreadercf_create(const char * _filename,
+                             int          _format)
+{
+    // validate input
+    if (_filename == NULL) {
+        fprintf(stderr,"error: iqreadercf_create(), invalid file name\n");
+        exit(1);
+    }
+
+    iqreadercf q = (iqreadercf) malloc(sizeof(struct iqreadercf_s));
+    q->filename = (char*) malloc(strlen(_filename)+1);
+    strcpy(q->filename, _filename);
+    q->format      = _format;
+    q->sample_size = liquid_iqfile_sample_size(_format);
+    q->index       = 0;
+
+    // open file and determine length
+    q->fid = fopen(q->filename,"rb");
+    if (q->fid == NULL) {
+        fprintf(stderr,"error: iqreadercf_create(), could not open '%s' for reading\n", q->filename);
+        exit(1);
+    }
+    fseek(q->fid, 0, SEEK_END);
+    long int file_size = ftell(q->fid);
+    fseek(q->fid, 0, SEEK_SET);
+    q->num_samples = (unsigned long int)file_size / q->sample_size;
+
+    // try to map the file; fall back to buffered streaming
+    q->use_mmap = 0;
+    q->map      = NULL;
+    q->map_len  = 0;
+#ifdef _POSIX_MAPPED_FILES
+    if (file_size > 0 && getenv("LIQUID_IQREADER_NOMMAP")==NULL) {
+        void * p = mmap(NULL, (size_t)file_size, PROT_READ, MAP_PRIVATE,
+                fileno(q->fid), 0);
+        if (p != MAP_FAILED) {
+            q->use_mmap = 1;
+            q->map      = (unsigned char*) p;
+            q->map_len  = (size_t)file_size;
+#ifdef POSIX_MADV_SEQUENTIAL
+            posix_madvise(p, q->map_len, POSIX_MADV_SEQUENTIAL);
+#endif
+        }
+    }
+#endif
+
+    // allocate stream buffers (only used without the mapping)
+    q->buf[0] = NULL;
+    q->buf[1] = NULL;
+    q->raw    = NULL;
+    if (!q->use_mmap) {
+        q->buf[0] = (float complex*) malloc(LIQUID_IQREADER_BUF_LEN*sizeof(float complex));
+        q->buf[1] = (float complex*) malloc(LIQUID_IQREADER_BUF_LEN*sizeof(float complex));
+        q->raw    = (unsigned char*) malloc(LIQUID_IQREADER_BUF_LEN*q->sample_size);
+    }
+    q->buf_len[0] = 0;
+    q->buf_len[1] = 0;
+    q->buf_index  = 0;
+    q->buf_active = 0;
+
+#if LIQUID_IQREADER_THREADED
+    q->next_ready = 0;
+    q->eof        = 0;
+    q->done       = 0;
+    if (!q->use_mmap) {
+        pthread_mutex_init(&q->mutex, NULL);
+        pthread_cond_init (&q->cond,  NULL);
+
+        // seed active buffer synchronously, then start prefetching
+        q->buf_len[0] = iqreadercf_fill(q, 0);
+        if (q->buf_len[0] < LIQUID_IQREADER_BUF_LEN)
+            q->eof = 1;
+        pthread_create(&q->thread, NULL, iqreadercf_prefetch, (void*)q);
+    }
+#else
+    if (!q->use_mmap)
+        q->buf_len[0] = iqreadercf_fill(q, 0);
+#endif
+
+    return q;
+}
+
+// destroy reader object, closing file and freeing internal memory
+void iqreadercf_destroy(iqreadercf _q)
+{
+#if LIQUID_IQREADER_THREADED
+    if (!_q->use_mmap) {
+        pthread_mutex_lock(&_q->mutex);
+        _q->done = 1;
+        pthread_cond_signal(&_q->cond);
+        pthread_mutex_unlock(&_q->mutex);
+        pthread_join(_q->thread, NULL);
+        pthread_mutex_destroy(&_q->mutex);
+        pthread_cond_destroy (&_q->cond);
+    }
+#endif
+#ifdef _POSIX_MAPPED_FILES
+    if (_q->use_mmap)
+        munmap((void*)_q->map, _q->map_len);
+#endif
+    fclose(_q->fid);
+    free(_q->buf[0]);
+    free(_q->buf[1]);
+    free(_q->raw);
+    free(_q->filename);
+    free(_q);
+}
+
+// print reader object internals
+void iqreadercf_print(iqreadercf _q)
+{
+    printf("iqreadercf: '%s', %lu samples (%s, %s)\n",
+            _q->filename, _q->num_samples,
+            _q->format == LIQUID_IQFILE_SC16 ? "sc16" : "cf32",
+            _q->use_mmap ? "mapped" : "streamed");
+}
+
+// get total number of samples in file
+unsigned long int iqreadercf_get_num_samples(iqreadercf _q)
+{
+    return _q->num_samples;
+}
+
+// internal: advance the streamed path to the next filled buffer
+//  returns 0 when no further samples are available
+int iqreadercf_next_buffer(iqreadercf _q)
+{
+#if LIQUID_IQREADER_THREADED
+    pthread_mutex_lock(&_q->mutex);
+    while (!_q->next_ready && !_q->eof)
+        pthread_cond_wait(&_q->cond, &_q->mutex);
+    if (!_q->next_ready) {
+        // end of file with no pending buffer
+        pthread_mutex_unlock(&_q->mutex);
+        return 0;
+    }
+    _q->buf_active = 1 - _q->buf_active;
+    _q->buf_index  = 0;
+    _q->next_ready = 0;
+    pthread_cond_signal(&_q->cond);
+    int valid = _q->buf_len[_q->buf_active] > 0;
+    pthread_mutex_unlock(&_q->mutex);
+    return valid;
+#else
+    _q->buf_index = 0;
+    return iqreadercf_fill(_q, _q->buf_active) > 0;
+#endif
+}
+
+// read block of samples, converting to 32-bit float complex
+//  _q              : reader object
+//  _buf            : output array [size: _num_samples x 1]
+//  _num_samples    : maximum number of samples to read
+// returns the number of samples written to the output
+unsigned long int iqreadercf_read(iqreadercf        _q,
+                                  float complex *   _buf,
+                                  unsigned long int _num_samples)
+{
+    // memory-mapped path: convert directly from the mapping
+    if (_q->use_mmap) {
+        unsigned long int n = _q->num_samples - _q->index;
+        if (n > _num_samples)
+            n = _num_samples;
+        liquid_iqfile_convert_to_cf32(_q->format,
+                _q->map + _q->index*_q->sample_size, n, _buf);
+        _q->index += n;
+        return n;
+    }
+
+    // streamed path: drain double buffers
+    unsigned long int num_read = 0;
+    while (num_read < _num_samples) {
+        if (_q->buf_index == _q->buf_len[_q->buf_active]) {
+            if (!iqreadercf_next_buffer(_q))
+                break;
+        }
+        unsigned long int n = _q->buf_len[_q->buf_active] - _q->buf_index;
+        if (n > _num_samples - num_read)
+            n = _num_samples - num_read;
+        memmove(_buf + num_read,
+                _q->buf[_q->buf_active] + _q->buf_index,
+                n*sizeof(float complex));
+        _q->buf_index += n;
+        num_read      += n;
+    }
+    _q->index += num_read;
+    return num_read;
+}
+
+// rewind reader to the beginning of the file
+void iqreadercf_reset(iqreadercf _q)
+{
+    _q->index = 0;
+    if (_q->use_mmap)
+        return;
+
+#if LIQUID_IQREADER_THREADED
+    // quiesce prefetch thread before rewinding the stream
+    pthread_mutex_lock(&_q->mutex);
+    while (!_q->next_ready && !_q->eof)
+        pthread_cond_wait(&_q->cond, &_q->mutex);
+    fseek(_q->fid, 0, SEEK_SET);
+    _q->buf_len[0] = iqreadercf_fill(_q, 0);
+    _q->buf_len[1] = 0;
+    _q->buf_active = 0;
+    _q->buf_index  = 0;
+    _q->eof        = _q->buf_len[0] < LIQUID_IQREADER_BUF_LEN;
+    _q->next_ready = 0;
+    pthread_cond_signal(&_q->cond);
+    pthread_mutex_unlock(&_q->mutex);
+#else
+    fseek(_q->fid, 0, SEEK_SET);
+    _q->buf_len[_q->buf_active] = iqreadercf_fill(_q, _q->buf_active);
+    _q->buf_index = 0;
+#endif
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iqrecordercf : compliance recorder with SigMF-style metadata
+//
+// Unlike iqwritercf, samples are converted straight from the caller's
+// buffer (e.g. a cbuffercf read region) to the on-disk format with no
+// intermediate copy; native-format recordings are written directly.
+// On destroy a '<filename>.meta' sidecar is emitted with SigMF-style
+// JSON metadata (format, sample rate, center frequency, start time).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "liquid.internal.h"
+
+// number of samples per conversion chunk
+#define LIQUID_IQRECORDER_BUF_LEN (16384)
+
+struct iqrecordercf_s {
+    char *            filename;         // output file name
+    int               format;           // on-disk sample format
+    unsigned int      sample_size;      // bytes per raw sample
+    unsigned long int num_samples;      // total samples written
+    FILE *            fid;              // output file stream
+    unsigned char *   raw;              // raw conversion scratch
+
+    // recording metadata
+    float             sample_rate;      // sample rate [Hz]
+    float             center_frequency; // center frequency [Hz]
+    char              datetime[64];     // recording start time (ISO 8601)
+};
+
+// create compliance recorder
+//  _filename   : output file name
+//  _format     : on-disk sample format (e.g. LIQUID_IQFILE_SC16)
+iqrecordercf iqrecordercf_create(const char * _filename,
+                                 int          _format)
+{
+    // validate input
+    if (_filename == NULL) {
+        fprintf(stderr,"error: iqrecordercf_create(), invalid file name\n");
+        exit(1);
+    }
+
+    iqrecordercf q = (iqrecordercf) malloc(sizeof(struct iqrecordercf_s));
+    q->filename = (char*) malloc(strlen(_filename)+1);
+    strcpy(q->filename, _filename);
+    q->format      = _format;
+    q->sample_size = liquid_iqfile_sample_size(_format);
+    q->num_samples = 0;
+
+    q->fid = fopen(q->filename,"wb");
+    if (q->fid == NULL) {
+        fprintf(stderr,"error: iqrecordercf_create(), could not open '%s' for writing\n", q->filename);
+        exit(1);
+    }
+
+    // conversion scratch (integer formats only)
+    q->raw = (unsigned char*) malloc(LIQUID_IQRECORDER_BUF_LEN*q->sample_size);
+
+    // default metadata; capture start time
+    q->sample_rate      = 0.0f;
+    q->center_frequency = 0.0f;
+    time_t now = time(NULL);
+    strftime(q->datetime, sizeof(q->datetime),
+            "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    return q;
+}
+
+// internal: emit SigMF-style JSON metadata sidecar
+void iqrecordercf_write_metadata(iqrecordercf _q)
+{
+    char filename_meta[strlen(_q->filename)+6];
+    sprintf(filename_meta,"%s.meta", _q->filename);
+    FILE * fid = fopen(filename_meta,"w");
+    if (fid == NULL) {
+        fprintf(stderr,"error: iqrecordercf_destroy(), could not open '%s' for writing\n", filename_meta);
+        exit(1);
+    }
+
+    fprintf(fid,"{\n");
+    fprintf(fid,"    \"global\": {\n");
+    fprintf(fid,"        \"core:datatype\": \"%s\",\n",
+            _q->format == LIQUID_IQFILE_SC16 ? "ci16_le" : "cf32_le");
+    fprintf(fid,"        \"core:sample_rate\": %.1f,\n", _q->sample_rate);
+    fprintf(fid,"        \"core:recorder\": \"liquid-dsp\"\n");
+    fprintf(fid,"    },\n");
+    fprintf(fid,"    \"captures\": [\n");
+    fprintf(fid,"        {\n");
+    fprintf(fid,"            \"core:sample_start\": 0,\n");
+    fprintf(fid,"            \"core:frequency\": %.1f,\n", _q->center_frequency);
+    fprintf(fid,"            \"core:datetime\": \"%s\",\n", _q->datetime);
+    fprintf(fid,"            \"core:length\": %lu\n", _q->num_samples);
+    fprintf(fid,"        }\n");
+    fprintf(fid,"    ]\n");
+    fprintf(fid,"}\n");
+    fclose(fid);
+}
+
+// destroy recorder object, closing the file and emitting metadata
+void iqrecordercf_destroy(iqrecordercf _q)
+{
+    fclose(_q->fid);
+    iqrecordercf_write_metadata(_q);
+
+    free(_q->raw);
+    free(_q->filename);
+    free(_q);
+}
+
+// print recorder object internals
+void iqrecordercf_print(iqrecordercf _q)
+{
+    printf("iqrecordercf: '%s', %lu samples (%s), rate %.1f Hz, fc %.1f Hz\n",
+            _q->filename, _q->num_samples,
+            _q->format == LIQUID_IQFILE_SC16 ? "sc16" : "cf32",
+            _q->sample_rate, _q->center_frequency);
+}
+
+// set recording sample rate for metadata [Hz]
+void iqrecordercf_set_sample_rate(iqrecordercf _q,
+                                  float        _sample_rate)
+{
+    _q->sample_rate = _sample_rate;
+}
+
+// set recording center frequency for metadata [Hz]
+void iqrecordercf_set_center_frequency(iqrecordercf _q,
+                                       float        _center_frequency)
+{
+    _q->center_frequency = _center_frequency;
+}
+
+// get total number of samples recorded
+unsigned long int iqrecordercf_get_num_samples(iqrecordercf _q)
+{
+    return _q->num_samples;
+}
+
+// record block of samples straight from the caller's buffer
+//  _q              : recorder object
+//  _buf            : input array [size: _num_samples x 1]
+//  _num_samples    : number of samples to record
+void iqrecordercf_write(iqrecordercf      _q,
+                        float complex *   _buf,
+                        unsigned long int _num_samples)
+{
+    if (_q->format == LIQUID_IQFILE_CF32) {
+        // native format: write directly without copying
+        fwrite(_buf, _q->sample_size, _num_samples, _q->fid);
+    } else {
+        // convert in chunks from the caller's buffer into the scratch
+        unsigned long int num_written = 0;
+        while (num_written < _num_samples) {
+            unsigned long int n = _num_samples - num_written;
+            if (n > LIQUID_IQRECORDER_BUF_LEN)
+                n = LIQUID_IQRECORDER_BUF_LEN;
+            liquid_iqfile_convert_from_cf32(_q->format,
+                    _buf + num_written, n, _q->raw);
+            fwrite(_q->raw, _q->sample_size, n, _q->fid);
+            num_written += n;
+        }
+    }
+    _q->num_samples += _num_samples;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iqwritercf : streaming sample writer for IQ recordings
+//
+// Samples are accepted as 32-bit float complex and converted to the
+// requested on-disk format. Writes are double-buffered: a flush
+// thread drains one buffer to disk while the caller fills the other,
+// so conversion and disk writes overlap with processing.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#include <pthread.h>
+#define LIQUID_IQWRITER_THREADED 1
+#else
+#define LIQUID_IQWRITER_THREADED 0
+#endif
+
+// number of samples per write buffer
+#define LIQUID_IQWRITER_BUF_LEN (16384)
+
+// internal: convert a block of 32-bit float complex samples to the
+// raw on-disk format
+//  _format : on-disk sample format
+//  _buf    : input array [size: _n x 1]
+//  _n      : number of samples
+//  _raw    : raw output array [size: _n samples]
+void liquid_iqfile_convert_from_cf32(int               _format,
+                                     float complex *   _buf,
+                                     unsigned long int _n,
+                                     unsigned char *   _raw)
+{
+    unsigned long int i;
+    switch (_format) {
+    case LIQUID_IQFILE_CF32:
+        memmove(_raw, _buf, _n*sizeof(float complex));
+        break;
+    case LIQUID_IQFILE_SC16: {
+        // scale to full range and saturate
+        int16_t * v = (int16_t*)_raw;
+        for (i=0; i<_n; i++) {
+            float vi = crealf(_buf[i]) * 32768.0f;
+            float vq = cimagf(_buf[i]) * 32768.0f;
+            vi = vi >  32767.0f ?  32767.0f : vi;
+            vi = vi < -32768.0f ? -32768.0f : vi;
+            vq = vq >  32767.0f ?  32767.0f : vq;
+            vq = vq < -32768.0f ? -32768.0f : vq;
+            v[2*i+0] = (int16_t)vi;
+            v[2*i+1] = (int16_t)vq;
+        }
+        break;
+    }
+    default:;
+    }
+}
+
+struct iqwritercf_s {
+    char *            filename;     // output file name
+    int               format;       // on-disk sample format
+    unsigned int      sample_size;  // bytes per raw sample
+    unsigned long int num_samples;  // total samples written
+    FILE *            fid;          // output file stream
+
+    // double buffers: caller fills the active buffer, flush thread
+    // converts and writes the other
+    float complex *   buf[2];       // sample buffers
+    unsigned long int buf_len[2];   // pending samples per buffer
+    unsigned int      buf_active;   // buffer being filled
+    unsigned char *   raw;          // raw conversion scratch (flush side)
+
+#if LIQUID_IQWRITER_THREADED
+    pthread_t         thread;       // flush worker
+    pthread_mutex_t   mutex;        //
+    pthread_cond_t    cond;         //
+    int               flush_pending;// inactive buffer awaiting flush?
+    int               done;         // object shutting down
+#endif
+};
+
+// internal: convert and write a buffer to disk
+void iqwritercf_drain(iqwritercf _q, unsigned int _which)
+{
+    liquid_iqfile_convert_from_cf32(_q->format,
+            _q->buf[_which], _q->buf_len[_which], _q->raw);
+    fwrite(_q->raw, _q->sample_size, _q->buf_len[_which], _q->fid);
+    _q->buf_len[_which] = 0;
+}
+
+#if LIQUID_IQWRITER_THREADED
+// flush worker: write out the inactive buffer whenever one is pending
+void * iqwritercf_flush(void * _arg)
+{
+    iqwritercf q = (iqwritercf) _arg;
+
+    pthread_mutex_lock(&q->mutex);
+    while (1) {
+        if (!q->flush_pending) {
+            if (q->done)
+                break;
+            pthread_cond_wait(&q->cond, &q->mutex);
+            continue;
+        }
+
+        // convert and write outside the lock
+        unsigned int which = 1 - q->buf_active;
+        pthread_mutex_unlock(&q->mutex);
+        iqwritercf_drain(q, which);
+        pthread_mutex_lock(&q->mutex);
+
+        q->flush_pending = 0;
+        pthread_cond_signal(&q->cond);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
+
+// create sample stream writer
+//  _filename   : output file name
+//  _format     : on-disk sample format (e.g. LIQUID_IQFILE_SC16)
+iqwritercf iqwritercf_create(const char * _filename,
+                             int          _format)
+{
+    // validate input
+    if (_filename == NULL) {
+        fprintf(stderr,"error: iqwritercf_create(), invalid file name\n");
+        exit(1);
+    }
+
+    iqwritercf q = (iqwritercf) malloc(sizeof(struct iqwritercf_s));
+    q->filename = (char*) malloc(strlen(_filename)+1);
+    strcpy(q->filename, _filename);
+    q->format      = _format;
+    q->sample_size = liquid_iqfile_sample_size(_format);
+    q->num_samples = 0;
+
+    q->fid = fopen(q->filename,"wb");
+    if (q->fid == NULL) {
+        fprintf(stderr,"error: iqwritercf_create(), could not open '%s' for writing\n", q->filename);
+        exit(1);
+    }
+
+    // allocate double buffers and conversion scratch
+    q->buf[0] = (float complex*) malloc(LIQUID_IQWRITER_BUF_LEN*sizeof(float complex));
+    q->buf[1] = (float complex*) malloc(LIQUID_IQWRITER_BUF_LEN*sizeof(float complex));
+    q->raw    = (unsigned char*) malloc(LIQUID_IQWRITER_BUF_LEN*q->sample_size);
+    q->buf_len[0] = 0;
+    q->buf_len[1] = 0;
+    q->buf_active = 0;
+
+#if LIQUID_IQWRITER_THREADED
+    q->flush_pending = 0;
+    q->done          = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init (&q->cond,  NULL);
+    pthread_create(&q->thread, NULL, iqwritercf_flush, (void*)q);
+#endif
+
+    return q;
+}
+
+// destroy writer object, flushing pending samples and closing the file
+void iqwritercf_destroy(iqwritercf _q)
+{
+#if LIQUID_IQWRITER_THREADED
+    // wait for any outstanding flush, then shut the worker down
+    pthread_mutex_lock(&_q->mutex);
+    while (_q->flush_pending)
+        pthread_cond_wait(&_q->cond, &_q->mutex);
+    _q->done = 1;
+    pthread_cond_signal(&_q->cond);
+    pthread_mutex_unlock(&_q->mutex);
+    pthread_join(_q->thread, NULL);
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy (&_q->cond);
+#endif
+
+    // write out remaining samples in the active buffer
+    iqwritercf_drain(_q, _q->buf_active);
+
+    fclose(_q->fid);
+    free(_q->buf[0]);
+    free(_q->buf[1]);
+    free(_q->raw);
+    free(_q->filename);
+    free(_q);
+}
+
+// print writer object internals
+void iqwritercf_print(iqwritercf _q)
+{
+    printf("iqwritercf: '%s', %lu samples (%s)\n",
+            _q->filename, _q->num_samples,
+            _q->format == LIQUID_IQFILE_SC16 ? "sc16" : "cf32");
+}
+
+// get total number of samples written
+unsigned long int iqwritercf_get_num_samples(iqwritercf _q)
+{
+    return _q->num_samples;
+}
+
+// write block of samples, converting to the on-disk format
+//  _q              : writer object
+//  _buf            : input array [size: _num_samples x 1]
+//  _num_samples    : number of samples to write
+void iqwritercf_write(iqwritercf        _q,
+                      float complex *   _buf,
+                      unsigned long int _num_samples)
+{
+    unsigned long int num_written = 0;
+    while (num_written < _num_samples) {
+        // fill active buffer
+        unsigned long int n = LIQUID_IQWRITER_BUF_LEN - _q->buf_len[_q->buf_active];
+        if (n > _num_samples - num_written)
+            n = _num_samples - num_written;
+        memmove(_q->buf[_q->buf_active] + _q->buf_len[_q->buf_active],
+                _buf + num_written,
+                n*sizeof(float complex));
+        _q->buf_len[_q->buf_active] += n;
+        num_written                 += n;
+
+        // hand full buffer to the flush worker and switch
+        if (_q->buf_len[_q->buf_active] == LIQUID_IQWRITER_BUF_LEN) {
+#if LIQUID_IQWRITER_THREADED
+            pthread_mutex_lock(&_q->mutex);
+            while (_q->flush_pending)
+                pthread_cond_wait(&_q->cond, &_q->mutex);
+            _q->buf_active    = 1 - _q->buf_active;
+            _q->flush_pending = 1;
+            pthread_cond_signal(&_q->cond);
+            pthread_mutex_unlock(&_q->mutex);
+#else
+            iqwritercf_drain(_q, _q->buf_active);
+#endif
+        }
+    }
+    _q->num_samples += _num_samples;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// write a random stream to file and read it back in uneven chunks,
+// spanning several internal buffer lengths
+void iqfile_test_roundtrip(int _format, float _tol)
+{
+    unsigned long int num_samples = 40000;  // total samples
+    const char filename[] = "autotest_iqfile.dat";
+
+    unsigned long int i;
+
+    // generate reference stream, bounded to avoid integer saturation
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    for (i=0; i<num_samples; i++)
+        x[i] = (randf()-0.5f) + (randf()-0.5f)*_Complex_I;
+
+    // write to file in uneven chunks
+    iqwritercf w = iqwritercf_create(filename, _format);
+    unsigned long int n = 0;
+    while (n < num_samples) {
+        unsigned long int r = 1 + (rand() % 7777);
+        if (r > num_samples - n)
+            r = num_samples - n;
+        iqwritercf_write(w, x+n, r);
+        n += r;
+    }
+    CONTEND_EQUALITY( iqwritercf_get_num_samples(w), num_samples );
+    iqwritercf_destroy(w);
+
+    // read back and compare
+    iqreadercf q = iqreadercf_create(filename, _format);
+    CONTEND_EQUALITY( iqreadercf_get_num_samples(q), num_samples );
+
+    float complex * y = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned long int num_read = 0;
+    while (num_read < num_samples) {
+        unsigned long int r = iqreadercf_read(q, y+num_read, 1 + (rand() % 5000));
+        if (r == 0)
+            break;
+        num_read += r;
+    }
+    CONTEND_EQUALITY( num_read, num_samples );
+
+    // further reads return no samples
+    float complex v;
+    CONTEND_EQUALITY( iqreadercf_read(q, &v, 1), 0 );
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(x[i]), crealf(y[i]), _tol );
+        CONTEND_DELTA( cimagf(x[i]), cimagf(y[i]), _tol );
+    }
+
+    // rewind and verify the first samples once more
+    iqreadercf_reset(q);
+    num_read = iqreadercf_read(q, y, 100);
+    CONTEND_EQUALITY( num_read, 100 );
+    for (i=0; i<100; i++) {
+        CONTEND_DELTA( crealf(x[i]), crealf(y[i]), _tol );
+        CONTEND_DELTA( cimagf(x[i]), cimagf(y[i]), _tol );
+    }
+
+    iqreadercf_destroy(q);
+    free(x);
+    free(y);
+    remove(filename);
+}
+
+// native float samples round-trip exactly
+void autotest_iqfile_cf32() { iqfile_test_roundtrip(LIQUID_IQFILE_CF32, 0.0f); }
+
+// 16-bit integer samples round-trip within quantization error
+void autotest_iqfile_sc16() { iqfile_test_roundtrip(LIQUID_IQFILE_SC16, 1.0f/32768.0f); }
+
+// internal: scan a text file for a substring
+int iqfile_test_meta_contains(const char * _filename, const char * _key)
+{
+    FILE * fid = fopen(_filename,"r");
+    if (fid == NULL)
+        return 0;
+    int found = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fid) != NULL) {
+        if (strstr(line, _key) != NULL) {
+            found = 1;
+            break;
+        }
+    }
+    fclose(fid);
+    return found;
+}
+
+// record a stream with metadata and verify data and sidecar contents
+void autotest_iqrecordercf()
+{
+    unsigned long int num_samples = 20000;
+    const char filename[] = "autotest_iqrecorder.dat";
+    float tol = 1.0f/32768.0f;
+
+    unsigned long int i;
+
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    for (i=0; i<num_samples; i++)
+        x[i] = (randf()-0.5f) + (randf()-0.5f)*_Complex_I;
+
+    // record in uneven chunks straight from the source buffer
+    iqrecordercf rec = iqrecordercf_create(filename, LIQUID_IQFILE_SC16);
+    iqrecordercf_set_sample_rate     (rec, 2.4e6f);
+    iqrecordercf_set_center_frequency(rec, 100.1e6f);
+    unsigned long int n = 0;
+    while (n < num_samples) {
+        unsigned long int r = 1 + (rand() % 7777);
+        if (r > num_samples - n)
+            r = num_samples - n;
+        iqrecordercf_write(rec, x+n, r);
+        n += r;
+    }
+    CONTEND_EQUALITY( iqrecordercf_get_num_samples(rec), num_samples );
+    iqrecordercf_destroy(rec);
+
+    // read back the recording
+    iqreadercf q = iqreadercf_create(filename, LIQUID_IQFILE_SC16);
+    CONTEND_EQUALITY( iqreadercf_get_num_samples(q), num_samples );
+    float complex * y = (float complex*) malloc(num_samples*sizeof(float complex));
+    CONTEND_EQUALITY( iqreadercf_read(q, y, num_samples), num_samples );
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(x[i]), crealf(y[i]), tol );
+        CONTEND_DELTA( cimagf(x[i]), cimagf(y[i]), tol );
+    }
+    iqreadercf_destroy(q);
+
+    // verify metadata sidecar contents
+    const char filename_meta[] = "autotest_iqrecorder.dat.meta";
+    CONTEND_EXPRESSION( iqfile_test_meta_contains(filename_meta, "\"core:datatype\": \"ci16_le\"") );
+    CONTEND_EXPRESSION( iqfile_test_meta_contains(filename_meta, "\"core:sample_rate\": 2400000.0") );
+    CONTEND_EXPRESSION( iqfile_test_meta_contains(filename_meta, "\"core:frequency\": 100100000.0") );
+    CONTEND_EXPRESSION( iqfile_test_meta_contains(filename_meta, "\"core:datetime\"") );
+    CONTEND_EXPRESSION( iqfile_test_meta_contains(filename_meta, "\"core:length\": 20000") );
+
+    free(x);
+    free(y);
+    remove(filename);
+    remove(filename_meta);
+}
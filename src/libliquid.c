@@ -21,10 +21,12 @@
  */
 
 //
-// Run-time library version numbers
+// Run-time library version numbers and global library state
 //
 
-#include "liquid.h"
+#include <string.h>
+
+#include "liquid.internal.h"
 
 const char liquid_version[] = LIQUID_VERSION;
 
@@ -38,3 +40,17 @@ int liquid_libversion_number(void)
     return LIQUID_VERSION_NUMBER;
 }
 
+// registered external compute backend; all callbacks NULL by default
+// so batched kernels run their built-in implementations
+liquid_backend liquid_internal_backend = {0};
+
+// register external compute backend, copying the interface structure;
+// pass NULL to restore built-in implementations
+void liquid_backend_register(liquid_backend * _backend)
+{
+    if (_backend == NULL)
+        memset(&liquid_internal_backend, 0, sizeof(liquid_backend));
+    else
+        memmove(&liquid_internal_backend, _backend, sizeof(liquid_backend));
+}
+
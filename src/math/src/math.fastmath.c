@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Fast approximations to transcendental math functions
+//
+// Polynomial approximations to expf/logf with roughly 1e-7 relative
+// error, intended for per-sample processing loops (e.g. gain tracking)
+// where libm accuracy is not needed. The exponent manipulation assumes
+// IEEE 754 single-precision storage. Set LIQUID_FASTMATH to zero to
+// fall back to libm.
+//
+
+#include <math.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+// set to zero to fall back to libm transcendentals
+#define LIQUID_FASTMATH (1)
+
+// e^x : fast approximation to expf
+float liquid_expf(float _x)
+{
+#if !LIQUID_FASTMATH
+    return expf(_x);
+#else
+    // clamp input to range producing finite, normal results
+    if (_x >  87.0f) _x =  87.0f;
+    if (_x < -87.0f) _x = -87.0f;
+
+    // range reduction: x = k*ln(2) + r with |r| <= ln(2)/2,
+    // splitting ln(2) into two parts to retain precision
+    int   k = (int) lroundf(_x * 1.44269504f);
+    float r = (_x - (float)k*0.693359375f) + (float)k*2.12194440e-4f;
+
+    // degree-6 polynomial on the reduced range
+    float p = 1.0f + r*(1.0f + r*(0.5f + r*(0.166666667f +
+              r*(0.0416666667f + r*(0.00833333333f + r*0.00138888889f)))));
+
+    // scale by 2^k through direct exponent manipulation
+    union { float f; uint32_t i; } s;
+    s.i = (uint32_t)(k + 127) << 23;
+    return p * s.f;
+#endif
+}
+
+// ln(x) : fast approximation to logf
+float liquid_logf(float _x)
+{
+#if !LIQUID_FASTMATH
+    return logf(_x);
+#else
+    // delegate edge cases to libm (non-positive, subnormal,
+    // infinite, or not-a-number input)
+    if ( !(_x >= 1.17549435e-38f) || isinf(_x) )
+        return logf(_x);
+
+    // decompose x = m*2^e with m on [sqrt(1/2), sqrt(2))
+    union { float f; uint32_t i; } u = { .f = _x };
+    int e = (int)(u.i >> 23) - 127;
+    u.i = (u.i & 0x007fffff) | 0x3f800000;
+    float m = u.f;
+    if (m > 1.41421356f) {
+        m *= 0.5f;
+        e++;
+    }
+
+    // inverse hyperbolic tangent series:
+    //   ln(m) = 2*(s + s^3/3 + s^5/5 + s^7/7 + s^9/9), s = (m-1)/(m+1)
+    float s  = (m - 1.0f)/(m + 1.0f);
+    float s2 = s*s;
+    float p  = 2.0f*s*(1.0f + s2*(0.333333333f +
+               s2*(0.2f + s2*(0.142857143f + s2*0.111111111f))));
+
+    // recombine with exponent contribution
+    return (float)e*0.693147181f + p;
+#endif
+}
+
+// b^x : fast approximation to powf for positive base
+float liquid_powf(float _b,
+                  float _x)
+{
+#if !LIQUID_FASTMATH
+    return powf(_b, _x);
+#else
+    // delegate non-positive base to libm
+    if (_b <= 0.0f)
+        return powf(_b, _x);
+
+    return liquid_expf( _x*liquid_logf(_b) );
+#endif
+}
@@ -69,13 +69,4 @@ float liquid_tanf(float _x)
     return s/c;
 }
 
-float liquid_expf(float _x)
-{
-    return expf(_x);
-}
-
-float liquid_logf(float _x)
-{
-    return logf(_x);
-}
 
@@ -43,6 +43,35 @@ T POLY(_val)(T * _p, unsigned int _k, T _x)
     return y;
 }
 
+// evaluate polynomial at a block of values; the accumulation is run
+// across all points for each coefficient so the inner loop operates on
+// contiguous arrays (auto-vectorizable), producing results identical
+// to POLY(_val) at each point
+void POLY(_vals)(T *          _p,
+                 unsigned int _k,
+                 T *          _x,
+                 unsigned int _n,
+                 T *          _y)
+{
+    unsigned int i;
+    unsigned int j;
+
+    // running powers of each evaluation point
+    T xk[_n];
+    for (i=0; i<_n; i++) {
+        _y[i] = 0.0f;
+        xk[i] = 1;
+    }
+
+    for (j=0; j<_k; j++) {
+        T c = _p[j];
+        for (i=0; i<_n; i++) {
+            _y[i] += c*xk[i];
+            xk[i] *= _x[i];
+        }
+    }
+}
+
 void POLY(_fit)(T * _x,
                 T * _y,
                 unsigned int _n,
@@ -161,6 +161,88 @@ void POLY(_findroots_durandkerner)(T *          _p,
         _roots[i] = r1[i];
 }
 
+// refine complex roots of the polynomial with Durand-Kerner sweeps
+// seeded from previous estimates; each sweep updates all estimates,
+// and roots whose correction has fallen below tolerance are masked
+// out of subsequent sweeps. Intended for incremental redesigns where
+// the coefficients change slightly between calls; falls back to a
+// fresh search if the seeds fail to converge. Output roots retain the
+// ordering of the input seeds (they are not re-sorted) so callers can
+// track individual roots across redesigns.
+//  _p      :   polynomial array, ascending powers [size: _k x 1]
+//  _k      :   polynomials length (poly order = _k - 1)
+//  _roots  :   previous root estimates (input), refined roots (output)
+//              [size: _k-1 x 1]
+void POLY(_findroots_warmstart)(T *          _p,
+                                unsigned int _k,
+                                TC *         _roots)
+{
+    if (_k < 2) {
+        fprintf(stderr,"%s_findroots_warmstart(), order must be greater than 0\n", POLY_NAME);
+        exit(1);
+    } else if (_p[_k-1] == 0) {
+        fprintf(stderr,"%s_findroots_warmstart(), leading coefficient must be non-zero\n", POLY_NAME);
+        exit(1);
+    }
+
+    float        tol                = 1e-8f; // per-root convergence tolerance
+    unsigned int max_num_iterations =    20; // maximum sweep count
+
+    unsigned int num_roots = _k-1;
+    unsigned int i, j, n;
+
+    // copy seeds and mark all roots active
+    TC  r[num_roots];
+    int active[num_roots];
+    memmove(r, _roots, num_roots*sizeof(TC));
+    for (j=0; j<num_roots; j++)
+        active[j] = 1;
+
+    unsigned int num_active = num_roots;
+    for (i=0; i<max_num_iterations && num_active > 0; i++) {
+        for (j=0; j<num_roots; j++) {
+            // skip roots that have already settled
+            if (!active[j])
+                continue;
+
+            // evaluate polynomial at current estimate (Horner's rule),
+            // normalizing by the leading coefficient
+            TC f = 0;
+            for (n=_k; n>0; n--)
+                f = f*r[j] + _p[n-1];
+            f /= _p[_k-1];
+
+            // Weierstrass correction: product of distances to all
+            // other root estimates
+            TC fp = 1;
+            for (n=0; n<num_roots; n++) {
+                if (n==j) continue;
+                fp *= r[j] - r[n];
+            }
+            TC step = f / fp;
+            r[j] -= step;
+
+            // mask this root once its correction is negligible
+            // (relative to its magnitude)
+            float d = crealf(step*conjf(step));
+            float m = 1.0f + crealf(r[j]*conjf(r[j]));
+            if (d < tol*tol*m) {
+                active[j] = 0;
+                num_active--;
+            }
+        }
+    }
+
+    // seeds did not converge (e.g. stale estimates or duplicate
+    // seeds); fall back to a full search
+    if (num_active > 0) {
+        POLY(_findroots)(_p,_k,_roots);
+        return;
+    }
+
+    memmove(_roots, r, num_roots*sizeof(TC));
+}
+
 // finds the complex roots of the polynomial using Bairstow's method
 //  _p      :   polynomial array, ascending powers [size: _k x 1]
 //  _k      :   polynomials length (poly order = _k - 1)
@@ -235,6 +235,62 @@ float liquid_kaiser(unsigned int _i,
     return a / b;
 }
 
+// modified Bessel function of the first kind (order zero) evaluated
+// with a direct term recurrence; converges quickly over the argument
+// range of window taper parameters and avoids the per-term log/exp of
+// liquid_besseli0f
+static float liquid_kaiser_besseli0(float _z)
+{
+    float z2_4 = 0.25f*_z*_z;   // z^2 / 4
+    float t = 1.0f;             // current term
+    float y = 1.0f;             // accumulated sum
+    unsigned int k;
+    for (k=1; k<64; k++) {
+        // I_0(z) = sum_k (z^2/4)^k / (k!)^2
+        t *= z2_4 / (float)(k*k);
+        y += t;
+        if (t < 1e-8f*y)
+            break;
+    }
+    return y;
+}
+
+// Kaiser window computed over the full block [Kaiser:1980]; the
+// normalizing Bessel term is evaluated once and the second half of the
+// window is filled by symmetry, so generating long windows is much
+// faster than calling liquid_kaiser() per tap
+//  _wlen   :   full window length
+//  _beta   :   window taper parameter
+//  _w      :   output window buffer, [size: _wlen x 1]
+void liquid_kaiser_window(unsigned int _wlen,
+                          float        _beta,
+                          float *      _w)
+{
+    // validate input
+    if (_wlen == 0) {
+        fprintf(stderr,"error: liquid_kaiser_window(), window length must be greater than zero\n");
+        exit(1);
+    } else if (_beta < 0) {
+        fprintf(stderr,"error: liquid_kaiser_window(), beta must be greater than or equal to zero\n");
+        exit(1);
+    } else if (_wlen == 1) {
+        _w[0] = 1.0f;
+        return;
+    }
+
+    // compute normalizing denominator once for the entire window
+    float b_inv = 1.0f / liquid_kaiser_besseli0(_beta);
+
+    // compute first half; even symmetry fills the rest
+    unsigned int i;
+    for (i=0; i<(_wlen+1)/2; i++) {
+        float t = (float)i - (float)(_wlen-1)/2;
+        float r = 2.0f*t/(float)(_wlen-1);
+        _w[i] = liquid_kaiser_besseli0(_beta*sqrtf(1-r*r)) * b_inv;
+        _w[_wlen-i-1] = _w[i];
+    }
+}
+
 // Hamming window [Nuttall:1981]
 float liquid_hamming(unsigned int _i,
                      unsigned int _wlen)
@@ -20,11 +20,56 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
+
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
+//
+// AUTOTEST: fast approximation to expf
+//
+void autotest_liquid_expf()
+{
+    float tol = 1e-5f;  // relative error tolerance
+    float x;
+    for (x=-20.0f; x<20.0f; x+=0.0193f) {
+        float e0 = expf(x);
+        float e1 = liquid_expf(x);
+        CONTEND_DELTA( e1/e0, 1.0f, tol );
+    }
+}
 
-// 
+//
+// AUTOTEST: fast approximation to logf
+//
+void autotest_liquid_logf()
+{
+    float tol = 1e-5f;  // error tolerance
+    float x;
+    for (x=1e-6f; x<1e6f; x*=1.193f) {
+        float l0 = logf(x);
+        float l1 = liquid_logf(x);
+        CONTEND_DELTA( l1, l0, tol*(1.0f + fabsf(l0)) );
+    }
+}
+
+//
+// AUTOTEST: fast approximation to powf
+//
+void autotest_liquid_powf()
+{
+    float tol = 1e-4f;  // relative error tolerance
+    float b, x;
+    for (b=0.1f; b<10.0f; b+=0.0719f) {
+        for (x=-2.0f; x<2.0f; x+=0.193f) {
+            float p0 = powf(b, x);
+            float p1 = liquid_powf(b, x);
+            CONTEND_DELTA( p1/p0, 1.0f, tol );
+        }
+    }
+}
+
+//
 // AUTOTEST: Q function
 //
 void autotest_Q()
@@ -80,3 +125,26 @@ void autotest_nextpow2()
     CONTEND_EQUALITY(liquid_nextpow2(888),  10);
 }
 
+
+// 
+// AUTOTEST : block Kaiser window generation matches per-tap evaluation
+//
+void autotest_kaiser_window()
+{
+    unsigned int wlen[3] = {21, 64, 257};   // window lengths
+    float        beta[3] = {0.0f, 3.0f, 10.0f}; // taper parameters
+    float        tol     = 1e-4f;           // error tolerance
+    unsigned int i, j, k;
+
+    for (j=0; j<3; j++) {
+        for (k=0; k<3; k++) {
+            // compute window over the full block
+            float w[wlen[j]];
+            liquid_kaiser_window(wlen[j], beta[k], w);
+
+            // compare against per-tap evaluation
+            for (i=0; i<wlen[j]; i++)
+                CONTEND_DELTA( w[i], liquid_kaiser(i, wlen[j], beta[k]), tol );
+        }
+    }
+}
@@ -25,7 +25,31 @@
 #include "autotest/autotest.h"
 #include "liquid.h"
 
-// 
+//
+// AUTOTEST: poly_vals block evaluation matches poly_val at each point
+//
+void autotest_polyf_vals()
+{
+    unsigned int k=5;   // polynomial length (order 4)
+    unsigned int n=37;  // number of evaluation points
+    unsigned int i;
+
+    // polynomial coefficients and evaluation points
+    float p[5] = {0.7f, -1.2f, 0.3f, 0.05f, -0.6f};
+    float x[n];
+    for (i=0; i<n; i++)
+        x[i] = 2.4f*randnf();
+
+    // evaluate as a block
+    float y[n];
+    polyf_vals(p, k, x, n, y);
+
+    // compare against scalar evaluation
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( y[i], polyf_val(p, k, x[i]) );
+}
+
+//
 // AUTOTEST: poly_fit 3rd order polynomial, critically sampled
 //
 void autotest_polyf_fit_q3n3()
@@ -70,6 +70,34 @@ void autotest_polyf_findroots_real()
     polyf_findroots_testbench(p, r, 5, 1e-6f);
 }
 
+void autotest_polyf_findroots_warmstart()
+{
+    float tol = 1e-5f;
+    unsigned int i;
+
+    // polynomial with known roots
+    float         p[6] = {6,11,-33,-33,11,6};
+    float complex r[5] = {-3, -1, -1./3., 0.5, 2.};
+
+    // seed with perturbed roots, emulating a slight redesign
+    float complex roots[5];
+    for (i=0; i<5; i++)
+        roots[i] = r[i] + 0.01f*(1 + _Complex_I)*cosf(1.7f*i);
+
+    // refine; ordering of the seeds is retained
+    polyf_findroots_warmstart(p, 6, roots);
+    for (i=0; i<5; i++)
+        CONTEND_DELTA( roots[i], r[i], tol );
+
+    // degenerate seeds (all equal) cannot converge and must fall back
+    // to a full search, returning sorted roots
+    for (i=0; i<5; i++)
+        roots[i] = 0.0f;
+    polyf_findroots_warmstart(p, 6, roots);
+    for (i=0; i<5; i++)
+        CONTEND_DELTA( roots[i], r[i], tol );
+}
+
 void autotest_polyf_findroots_complex()
 {
 
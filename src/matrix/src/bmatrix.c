@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// bmatrix : packed binary matrix over GF(2)
+//
+// Rows are stored 64 bits per word so row operations (XOR, elimination,
+// matrix-vector products) run word-wide rather than bit-per-byte as in
+// the expanded smatrixb representation.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+// number of bits per storage word
+#define BMATRIX_BITS_PER_WORD (64)
+
+// internal structure
+struct bmatrix_s {
+    unsigned int M;         // number of rows
+    unsigned int N;         // number of columns
+    unsigned int num_words; // number of words per row, (N+63)/64
+    uint64_t *   v;         // packed rows, [size: M x num_words]
+};
+
+// internal: pointer to packed row _m
+static inline uint64_t * bmatrix_row(bmatrix      _q,
+                                     unsigned int _m)
+{
+    return &_q->v[_m * _q->num_words];
+}
+
+// create _M x _N packed binary matrix, initialized with zeros
+bmatrix bmatrix_create(unsigned int _M,
+                       unsigned int _N)
+{
+    // validate input
+    if (_M == 0 || _N == 0) {
+        fprintf(stderr,"error: bmatrix_create(), dimensions must be greater than zero\n");
+        exit(1);
+    }
+
+    // create object and allocate memory
+    bmatrix q = (bmatrix) malloc(sizeof(struct bmatrix_s));
+    q->M = _M;
+    q->N = _N;
+    q->num_words = (_N + BMATRIX_BITS_PER_WORD - 1) / BMATRIX_BITS_PER_WORD;
+    q->v = (uint64_t*) malloc(q->M * q->num_words * sizeof(uint64_t));
+
+    // clear and return object
+    bmatrix_clear(q);
+    return q;
+}
+
+// create _m x _n packed binary matrix, initialized on expanded
+// (bit-per-byte) array
+//  _x  : input matrix, [size: _m x _n]
+//  _m  : number of rows in input matrix
+//  _n  : number of columns in input matrix
+bmatrix bmatrix_create_array(unsigned char * _x,
+                             unsigned int    _m,
+                             unsigned int    _n)
+{
+    bmatrix q = bmatrix_create(_m, _n);
+
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<_m; i++) {
+        for (j=0; j<_n; j++) {
+            if (_x[i*_n + j])
+                bmatrix_set(q, i, j, 1);
+        }
+    }
+    return q;
+}
+
+// create packed binary matrix from sparse binary matrix
+bmatrix bmatrix_create_smatrixb(smatrixb _A)
+{
+    // get dimensions of sparse matrix
+    unsigned int m;
+    unsigned int n;
+    smatrixb_size(_A, &m, &n);
+
+    // create object and copy non-zero entries
+    bmatrix q = bmatrix_create(m, n);
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<m; i++) {
+        for (j=0; j<n; j++) {
+            if (smatrixb_isset(_A, i, j))
+                bmatrix_set(q, i, j, 1);
+        }
+    }
+    return q;
+}
+
+// destroy packed binary matrix, freeing all internal memory
+void bmatrix_destroy(bmatrix _q)
+{
+    free(_q->v);
+    free(_q);
+}
+
+// print packed binary matrix to stdout
+void bmatrix_print(bmatrix _q)
+{
+    printf("bmatrix [%u x %u] :\n", _q->M, _q->N);
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<_q->M; i++) {
+        printf("  ");
+        for (j=0; j<_q->N; j++)
+            printf("%c", bmatrix_get(_q,i,j) ? '1' : '.');
+        printf("\n");
+    }
+}
+
+// zero all elements, retaining allocated memory
+void bmatrix_clear(bmatrix _q)
+{
+    memset(_q->v, 0x00, _q->M * _q->num_words * sizeof(uint64_t));
+}
+
+// get size of packed binary matrix (number of rows and columns)
+//  _q  : packed binary matrix object
+//  _m  : number of rows in matrix
+//  _n  : number of columns in matrix
+void bmatrix_size(bmatrix        _q,
+                  unsigned int * _m,
+                  unsigned int * _n)
+{
+    *_m = _q->M;
+    *_n = _q->N;
+}
+
+// set the value in matrix at specified row and column
+//  _q  : packed binary matrix object
+//  _m  : row index of value to set
+//  _n  : column index of value to set
+//  _v  : value to set in matrix (0 or 1)
+void bmatrix_set(bmatrix      _q,
+                 unsigned int _m,
+                 unsigned int _n,
+                 int          _v)
+{
+    // validate input
+    if (_m >= _q->M || _n >= _q->N) {
+        fprintf(stderr,"error: bmatrix_set(), index (%u,%u) exceeds matrix dimension (%u,%u)\n",
+                _m, _n, _q->M, _q->N);
+        exit(1);
+    }
+
+    uint64_t mask = (uint64_t)1 << (_n % BMATRIX_BITS_PER_WORD);
+    if (_v)
+        bmatrix_row(_q,_m)[_n / BMATRIX_BITS_PER_WORD] |=  mask;
+    else
+        bmatrix_row(_q,_m)[_n / BMATRIX_BITS_PER_WORD] &= ~mask;
+}
+
+// get the value from matrix at specified row and column
+//  _q  : packed binary matrix object
+//  _m  : row index of value to get
+//  _n  : column index of value to get
+int bmatrix_get(bmatrix      _q,
+                unsigned int _m,
+                unsigned int _n)
+{
+    // validate input
+    if (_m >= _q->M || _n >= _q->N) {
+        fprintf(stderr,"error: bmatrix_get(), index (%u,%u) exceeds matrix dimension (%u,%u)\n",
+                _m, _n, _q->M, _q->N);
+        exit(1);
+    }
+
+    uint64_t mask = (uint64_t)1 << (_n % BMATRIX_BITS_PER_WORD);
+    return (bmatrix_row(_q,_m)[_n / BMATRIX_BITS_PER_WORD] & mask) ? 1 : 0;
+}
+
+// initialize to identity matrix; set all diagonal elements to 1, all
+// others to 0 (works with both square and non-square matrices)
+void bmatrix_eye(bmatrix _q)
+{
+    bmatrix_clear(_q);
+    unsigned int i;
+    unsigned int imax = _q->M < _q->N ? _q->M : _q->N;
+    for (i=0; i<imax; i++)
+        bmatrix_set(_q, i, i, 1);
+}
+
+// add (XOR) row _src into row _dst, one word at a time
+//  _q      : packed binary matrix object
+//  _dst    : index of row to update
+//  _src    : index of row to add
+void bmatrix_row_xor(bmatrix      _q,
+                     unsigned int _dst,
+                     unsigned int _src)
+{
+    // validate input
+    if (_dst >= _q->M || _src >= _q->M) {
+        fprintf(stderr,"error: bmatrix_row_xor(), row index exceeds matrix dimension\n");
+        exit(1);
+    }
+
+    uint64_t * rd = bmatrix_row(_q,_dst);
+    uint64_t * rs = bmatrix_row(_q,_src);
+    unsigned int k;
+    for (k=0; k<_q->num_words; k++)
+        rd[k] ^= rs[k];
+}
+
+// swap two rows
+//  _q  : packed binary matrix object
+//  _r0 : index of first row
+//  _r1 : index of second row
+void bmatrix_row_swap(bmatrix      _q,
+                      unsigned int _r0,
+                      unsigned int _r1)
+{
+    // validate input
+    if (_r0 >= _q->M || _r1 >= _q->M) {
+        fprintf(stderr,"error: bmatrix_row_swap(), row index exceeds matrix dimension\n");
+        exit(1);
+    }
+
+    if (_r0 == _r1)
+        return;
+
+    uint64_t * ra = bmatrix_row(_q,_r0);
+    uint64_t * rb = bmatrix_row(_q,_r1);
+    unsigned int k;
+    for (k=0; k<_q->num_words; k++) {
+        uint64_t tmp = ra[k];
+        ra[k] = rb[k];
+        rb[k] = tmp;
+    }
+}
+
+// Gauss-Jordan elimination over GF(2) with word-wide row operations,
+// reducing the matrix to reduced row-echelon form in place; returns
+// the rank of the matrix
+unsigned int bmatrix_gjelim(bmatrix _q)
+{
+    unsigned int rank = 0;  // number of pivots found so far
+    unsigned int i;
+    unsigned int j;
+
+    for (j=0; j<_q->N && rank<_q->M; j++) {
+        // find pivot row for this column at or below current rank
+        unsigned int word = j / BMATRIX_BITS_PER_WORD;
+        uint64_t     mask = (uint64_t)1 << (j % BMATRIX_BITS_PER_WORD);
+        unsigned int p    = rank;
+        while (p < _q->M && !(bmatrix_row(_q,p)[word] & mask))
+            p++;
+        if (p == _q->M)
+            continue;   // column has no pivot
+
+        // move pivot row into place
+        bmatrix_row_swap(_q, rank, p);
+
+        // clear column in all other rows with word-wide updates
+        for (i=0; i<_q->M; i++) {
+            if (i != rank && (bmatrix_row(_q,i)[word] & mask))
+                bmatrix_row_xor(_q, i, rank);
+        }
+        rank++;
+    }
+
+    return rank;
+}
+
+// multiply packed binary matrix by expanded binary vector over GF(2),
+// \( \vec{y} = \vec{A} \vec{x} \); each output bit is the parity of a
+// word-wide masked population count rather than a bit-per-byte loop
+//  _q  : packed binary matrix object
+//  _x  : input vector, [size: _N x 1]
+//  _y  : output vector, [size: _M x 1]
+void bmatrix_vmul(bmatrix         _q,
+                  unsigned char * _x,
+                  unsigned char * _y)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+
+    // pack input vector
+    uint64_t x[_q->num_words];
+    memset(x, 0x00, _q->num_words*sizeof(uint64_t));
+    for (j=0; j<_q->N; j++) {
+        if (_x[j])
+            x[j / BMATRIX_BITS_PER_WORD] |= (uint64_t)1 << (j % BMATRIX_BITS_PER_WORD);
+    }
+
+    // compute each output bit as parity of row/vector overlap
+    for (i=0; i<_q->M; i++) {
+        uint64_t * r = bmatrix_row(_q,i);
+        uint64_t p = 0;
+        for (k=0; k<_q->num_words; k++)
+            p ^= r[k] & x[k];
+
+        // reduce word parity to a single bit
+        p ^= p >> 32;
+        p ^= p >> 16;
+        p ^= p >>  8;
+        p ^= p >>  4;
+        p ^= p >>  2;
+        p ^= p >>  1;
+        _y[i] = (unsigned char)(p & 1);
+    }
+}
+
+// copy packed binary matrix into sparse binary matrix of the same
+// dimensions, clearing the destination first
+//  _q  : packed binary matrix object (input)
+//  _A  : sparse binary matrix object (output)
+void bmatrix_to_smatrixb(bmatrix  _q,
+                         smatrixb _A)
+{
+    // validate dimensions
+    unsigned int m;
+    unsigned int n;
+    smatrixb_size(_A, &m, &n);
+    if (m != _q->M || n != _q->N) {
+        fprintf(stderr,"error: bmatrix_to_smatrixb(), dimension mismatch ([%u x %u] vs [%u x %u])\n",
+                _q->M, _q->N, m, n);
+        exit(1);
+    }
+
+    // clear sparse matrix and copy non-zero entries
+    smatrixb_clear(_A);
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<_q->M; i++) {
+        for (j=0; j<_q->N; j++) {
+            if (bmatrix_get(_q,i,j))
+                smatrixb_set(_A, i, j, 1);
+        }
+    }
+}
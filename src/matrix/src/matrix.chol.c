@@ -38,6 +38,16 @@ void MATRIX(_chol)(T *          _A,
                    unsigned int _n,
                    T *          _L)
 {
+    // dispatch to unrolled kernels for the small dimensions that
+    // dominate per-subcarrier MIMO processing
+    if (_n == 2) {
+        MATRIX(_chol2x2)(_A, _L);
+        return;
+    } else if (_n == 4) {
+        MATRIX(_chol4x4)(_A, _L);
+        return;
+    }
+
     // reset L
     unsigned int i;
     for (i=0; i<_n*_n; i++)
@@ -47,10 +57,11 @@ void MATRIX(_chol)(T *          _A,
     unsigned int k;
     T  A_jj;
     T  L_jj;
-    T  L_ik;
+    T  L_jj_inv;
     T  L_jk;
     TP t0;
     T  t1;
+    T  Lj_conj[_n];     // conjugated pivot row
     for (j=0; j<_n; j++) {
         // assert that A_jj is real, positive
         A_jj = matrix_access(_A,_n,_n,j,j);
@@ -65,13 +76,16 @@ void MATRIX(_chol)(T *          _A,
         }
 #endif
 
-        // compute L_jj and store it in output matrix
+        // conjugate pivot row once so the trailing update below is a
+        // plain multiply-accumulate over contiguous arrays
         t0 = 0.0;
         for (k=0; k<j; k++) {
             L_jk = matrix_access(_L,_n,_n,j,k);
 #if T_COMPLEX
-            t0 += creal( L_jk * conj(L_jk) );
+            Lj_conj[k] = conj(L_jk);
+            t0 += creal( L_jk * Lj_conj[k] );
 #else
+            Lj_conj[k] = L_jk;
             t0 += L_jk * L_jk;
 #endif
         }
@@ -83,20 +97,109 @@ void MATRIX(_chol)(T *          _A,
         L_jj = sqrt( A_jj - t0 );
         matrix_access(_L,_n,_n,j,j) = L_jj;
 
+        // store inverse of L_jj to reduce number of divisions
+        L_jj_inv = 1.0 / L_jj;
+
         for (i=j+1; i<_n; i++) {
             t1 = matrix_access(_A,_n,_n,i,j);
-            for (k=0; k<j; k++) {
-                L_ik = matrix_access(_L,_n,_n,i,k);
-                L_jk = matrix_access(_L,_n,_n,j,k);
+            for (k=0; k<j; k++)
+                t1 -= matrix_access(_L,_n,_n,i,k) * Lj_conj[k];
+            matrix_access(_L,_n,_n,i,j) = t1 * L_jj_inv;
+        }
+    }
+}
+
+
+// type-specific conjugation helper for the unrolled kernels
 #if T_COMPLEX
-                t1 -= L_ik * conj(L_jk);
+#  define CHOL_CONJ(X) conj(X)
 #else
-                t1 -= L_ik * L_jk;
+#  define CHOL_CONJ(X) (X)
 #endif
-            }
-            // TODO : store inverse of L_jj to reduce number of divisions
-            matrix_access(_L,_n,_n,i,j) = t1 / L_jj;
-        }
+
+// real part of |x|^2 accumulation term
+#define CHOL_ABS2(X) ( creal((X)*CHOL_CONJ(X)) )
+
+// unrolled 2x2 Cholesky decomposition, A = L * L^H
+void MATRIX(_chol2x2)(T * _A,
+                      T * _L)
+{
+    // reset L
+    unsigned int i;
+    for (i=0; i<4; i++)
+        _L[i] = 0.0;
+
+    double d0 = creal(_A[0]);
+    if (d0 < 0.0) {
+        fprintf(stderr,"warning: matrix_chol2x2(), matrix is not positive definite (real{A[0,0]} = %12.4e < 0)\n", d0);
+        return;
+    }
+    T L00 = sqrt(d0);
+    T L10 = _A[2] / L00;
+
+    double d1 = creal(_A[3]) - CHOL_ABS2(L10);
+    if (d1 < 0.0) {
+        fprintf(stderr,"warning: matrix_chol2x2(), matrix is not positive definite (real{A[1,1]} = %12.4e < %12.4e)\n", creal(_A[3]), CHOL_ABS2(L10));
+        return;
     }
+
+    _L[0] = L00;    _L[1] = 0.0;
+    _L[2] = L10;    _L[3] = sqrt(d1);
+}
+
+// unrolled 4x4 Cholesky decomposition, A = L * L^H
+void MATRIX(_chol4x4)(T * _A,
+                      T * _L)
+{
+    // reset L
+    unsigned int i;
+    for (i=0; i<16; i++)
+        _L[i] = 0.0;
+
+    // column 0
+    double d0 = creal(_A[0]);
+    if (d0 < 0.0) {
+        fprintf(stderr,"warning: matrix_chol4x4(), matrix is not positive definite (real{A[0,0]} = %12.4e < 0)\n", d0);
+        return;
+    }
+    T L00 = sqrt(d0);
+    T g   = 1.0 / L00;
+    T L10 = _A[ 4] * g;
+    T L20 = _A[ 8] * g;
+    T L30 = _A[12] * g;
+
+    // column 1
+    double d1 = creal(_A[5]) - CHOL_ABS2(L10);
+    if (d1 < 0.0) {
+        fprintf(stderr,"warning: matrix_chol4x4(), matrix is not positive definite (real{A[1,1]} = %12.4e < %12.4e)\n", creal(_A[5]), CHOL_ABS2(L10));
+        return;
+    }
+    T L11 = sqrt(d1);
+    g = 1.0 / L11;
+    T L21 = (_A[ 9] - L20*CHOL_CONJ(L10)) * g;
+    T L31 = (_A[13] - L30*CHOL_CONJ(L10)) * g;
+
+    // column 2
+    double d2 = creal(_A[10]) - CHOL_ABS2(L20) - CHOL_ABS2(L21);
+    if (d2 < 0.0) {
+        fprintf(stderr,"warning: matrix_chol4x4(), matrix is not positive definite (real{A[2,2]} = %12.4e < %12.4e)\n", creal(_A[10]), CHOL_ABS2(L20)+CHOL_ABS2(L21));
+        return;
+    }
+    T L22 = sqrt(d2);
+    T L32 = (_A[14] - L30*CHOL_CONJ(L20) - L31*CHOL_CONJ(L21)) / L22;
+
+    // column 3
+    double d3 = creal(_A[15]) - CHOL_ABS2(L30) - CHOL_ABS2(L31) - CHOL_ABS2(L32);
+    if (d3 < 0.0) {
+        fprintf(stderr,"warning: matrix_chol4x4(), matrix is not positive definite (real{A[3,3]} = %12.4e < %12.4e)\n", creal(_A[15]), CHOL_ABS2(L30)+CHOL_ABS2(L31)+CHOL_ABS2(L32));
+        return;
+    }
+
+    _L[ 0] = L00;   _L[ 1] = 0.0;   _L[ 2] = 0.0;   _L[ 3] = 0.0;
+    _L[ 4] = L10;   _L[ 5] = L11;   _L[ 6] = 0.0;   _L[ 7] = 0.0;
+    _L[ 8] = L20;   _L[ 9] = L21;   _L[10] = L22;   _L[11] = 0.0;
+    _L[12] = L30;   _L[13] = L31;   _L[14] = L32;   _L[15] = sqrt(d3);
 }
 
+#undef CHOL_CONJ
+#undef CHOL_ABS2
@@ -34,6 +34,17 @@ void MATRIX(_inv)(T * _X, unsigned int _XR, unsigned int _XC)
         exit(1);
     }
 
+    // dispatch to closed-form kernels for the small dimensions that
+    // dominate per-subcarrier MIMO processing, avoiding the full
+    // Gauss-Jordan elimination with pivoting
+    if (_XR == 2) {
+        MATRIX(_inv2x2)(_X);
+        return;
+    } else if (_XR == 4) {
+        MATRIX(_inv4x4)(_X);
+        return;
+    }
+
     // X:
     //  x11 x12 ... x1n
     //  x21 x22 ... x2n
@@ -133,7 +144,9 @@ void MATRIX(_pivot)(T * _X, unsigned int _XR, unsigned int _XC, unsigned int _r,
     unsigned int r,c;
 
     // pivot using back-substitution
-    T g;    // multiplier
+    T g;                        // multiplier
+    T v_inv = 1 / v;            // single division for entire pivot
+    T * xp = &_X[_r*_XC];       // pivot row
     for (r=0; r<_XR; r++) {
 
         // skip over pivot row
@@ -141,13 +154,12 @@ void MATRIX(_pivot)(T * _X, unsigned int _XR, unsigned int _XC, unsigned int _r,
             continue;
 
         // compute multiplier
-        g = matrix_access(_X,_XR,_XC,r,_c) / v;
+        g = matrix_access(_X,_XR,_XC,r,_c) * v_inv;
 
-        // back-substitution
-        for (c=0; c<_XC; c++) {
-            matrix_access(_X,_XR,_XC,r,c) = g*matrix_access(_X,_XR,_XC,_r,c) -
-                                              matrix_access(_X,_XR,_XC, r,c);
-        }
+        // back-substitution along contiguous rows
+        T * x = &_X[r*_XC];
+        for (c=0; c<_XC; c++)
+            x[c] = g*xp[c] - x[c];
     }
 }
 
@@ -164,3 +176,69 @@ void MATRIX(_swaprows)(T * _X, unsigned int _XR, unsigned int _XC, unsigned int
         matrix_access(_X,_XR,_XC,_r2,c) = v_tmp;
     }
 }
+
+// closed-form 2x2 matrix inverse (in place)
+void MATRIX(_inv2x2)(T * _X)
+{
+    T det = _X[0]*_X[3] - _X[1]*_X[2];
+    if (det == 0)
+        fprintf(stderr,"warning: matrix_inv2x2(), matrix singular to machine precision\n");
+
+    T det_inv = 1.0 / det;
+    T a =  _X[3] * det_inv;
+    T b = -_X[1] * det_inv;
+    T c = -_X[2] * det_inv;
+    T d =  _X[0] * det_inv;
+
+    _X[0] = a;  _X[1] = b;
+    _X[2] = c;  _X[3] = d;
+}
+
+// closed-form 4x4 matrix inverse (in place) from the adjugate, computed
+// with 2x2 sub-determinants of the upper and lower halves
+void MATRIX(_inv4x4)(T * _X)
+{
+    // 2x2 sub-determinants of rows (0,1) and rows (2,3)
+    T s0 = _X[ 0]*_X[ 5] - _X[ 4]*_X[ 1];
+    T s1 = _X[ 0]*_X[ 6] - _X[ 4]*_X[ 2];
+    T s2 = _X[ 0]*_X[ 7] - _X[ 4]*_X[ 3];
+    T s3 = _X[ 1]*_X[ 6] - _X[ 5]*_X[ 2];
+    T s4 = _X[ 1]*_X[ 7] - _X[ 5]*_X[ 3];
+    T s5 = _X[ 2]*_X[ 7] - _X[ 6]*_X[ 3];
+
+    T c5 = _X[10]*_X[15] - _X[14]*_X[11];
+    T c4 = _X[ 9]*_X[15] - _X[13]*_X[11];
+    T c3 = _X[ 9]*_X[14] - _X[13]*_X[10];
+    T c2 = _X[ 8]*_X[15] - _X[12]*_X[11];
+    T c1 = _X[ 8]*_X[14] - _X[12]*_X[10];
+    T c0 = _X[ 8]*_X[13] - _X[12]*_X[ 9];
+
+    T det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    if (det == 0)
+        fprintf(stderr,"warning: matrix_inv4x4(), matrix singular to machine precision\n");
+    T det_inv = 1.0 / det;
+
+    // adjugate, scaled by inverse determinant
+    T y[16];
+    y[ 0] = ( _X[ 5]*c5 - _X[ 6]*c4 + _X[ 7]*c3) * det_inv;
+    y[ 1] = (-_X[ 1]*c5 + _X[ 2]*c4 - _X[ 3]*c3) * det_inv;
+    y[ 2] = ( _X[13]*s5 - _X[14]*s4 + _X[15]*s3) * det_inv;
+    y[ 3] = (-_X[ 9]*s5 + _X[10]*s4 - _X[11]*s3) * det_inv;
+
+    y[ 4] = (-_X[ 4]*c5 + _X[ 6]*c2 - _X[ 7]*c1) * det_inv;
+    y[ 5] = ( _X[ 0]*c5 - _X[ 2]*c2 + _X[ 3]*c1) * det_inv;
+    y[ 6] = (-_X[12]*s5 + _X[14]*s2 - _X[15]*s1) * det_inv;
+    y[ 7] = ( _X[ 8]*s5 - _X[10]*s2 + _X[11]*s1) * det_inv;
+
+    y[ 8] = ( _X[ 4]*c4 - _X[ 5]*c2 + _X[ 7]*c0) * det_inv;
+    y[ 9] = (-_X[ 0]*c4 + _X[ 1]*c2 - _X[ 3]*c0) * det_inv;
+    y[10] = ( _X[12]*s4 - _X[13]*s2 + _X[15]*s0) * det_inv;
+    y[11] = (-_X[ 8]*s4 + _X[ 9]*s2 - _X[11]*s0) * det_inv;
+
+    y[12] = (-_X[ 4]*c3 + _X[ 5]*c1 - _X[ 6]*c0) * det_inv;
+    y[13] = ( _X[ 0]*c3 - _X[ 1]*c1 + _X[ 2]*c0) * det_inv;
+    y[14] = (-_X[12]*s3 + _X[13]*s1 - _X[14]*s0) * det_inv;
+    y[15] = ( _X[ 8]*s3 - _X[ 9]*s1 + _X[10]*s0) * det_inv;
+
+    memmove(_X, y, 16*sizeof(T));
+}
@@ -97,6 +97,38 @@ void MATRIX(_pdiv)(T * _X,
 }
 
 
+// fully-unrolled multiply kernel for a tiny fixed size; the constant
+// trip counts let the compiler hold the output row in registers and
+// vectorize the contiguous row updates
+#define LIQUID_MATRIX_MUL_TINY(FN,N)                    \
+static void FN(T * _x, T * _y, T * _z)                  \
+{                                                       \
+    unsigned int r, c, i;                               \
+    for (r=0; r<N; r++) {                               \
+        T zr[N];                                        \
+        for (c=0; c<N; c++)                             \
+            zr[c] = 0.0f;                               \
+        for (i=0; i<N; i++) {                           \
+            T x_ri = _x[r*N+i];                         \
+            for (c=0; c<N; c++)                         \
+                zr[c] += x_ri * _y[i*N+c];              \
+        }                                               \
+        for (c=0; c<N; c++)                             \
+            _z[r*N+c] = zr[c];                          \
+    }                                                   \
+}
+
+LIQUID_MATRIX_MUL_TINY(MATRIX(_mul_2x2), 2)
+LIQUID_MATRIX_MUL_TINY(MATRIX(_mul_4x4), 4)
+LIQUID_MATRIX_MUL_TINY(MATRIX(_mul_8x8), 8)
+
+#undef LIQUID_MATRIX_MUL_TINY
+
+// column block size for the general multiply kernel; a block of the
+// output row and the corresponding slices of y stay cache-resident
+// across the accumulation over i
+#define LIQUID_MATRIX_MUL_BLOCK (32)
+
 // multiply two matrices together
 void MATRIX(_mul)(T * _X, unsigned int _XR, unsigned int _XC,
                   T * _Y, unsigned int _YR, unsigned int _YC,
@@ -108,21 +140,35 @@ void MATRIX(_mul)(T * _X, unsigned int _XR, unsigned int _XC,
         exit(1);
     }
 
-    unsigned int r, c, i;
-    for (r=0; r<_ZR; r++) {
-        for (c=0; c<_ZC; c++) {
-            // z(i,j) = dotprod( x(i,:), y(:,j) )
-            T sum=0.0f;
+    // dispatch on tiny square sizes common to MIMO processing
+    if (_ZR == _ZC && _XC == _ZR) {
+        switch (_ZR) {
+        case 2: MATRIX(_mul_2x2)(_X,_Y,_Z); return;
+        case 4: MATRIX(_mul_4x4)(_X,_Y,_Z); return;
+        case 8: MATRIX(_mul_8x8)(_X,_Y,_Z); return;
+        default:;
+        }
+    }
+
+    // general case: accumulate along rows of z so that the inner loop
+    // reads y and updates z contiguously, blocking over columns to
+    // keep the working set cache-resident
+    unsigned int r, c, i, cb;
+    for (cb=0; cb<_ZC; cb+=LIQUID_MATRIX_MUL_BLOCK) {
+        unsigned int c1 = cb + LIQUID_MATRIX_MUL_BLOCK;
+        if (c1 > _ZC) c1 = _ZC;
+
+        for (r=0; r<_ZR; r++) {
+            for (c=cb; c<c1; c++)
+                matrix_access(_Z,_ZR,_ZC,r,c) = 0.0f;
+
             for (i=0; i<_XC; i++) {
-                sum += matrix_access(_X,_XR,_XC,r,i) *
-                       matrix_access(_Y,_YR,_YC,i,c);
+                T x_ri = matrix_access(_X,_XR,_XC,r,i);
+                for (c=cb; c<c1; c++) {
+                    matrix_access(_Z,_ZR,_ZC,r,c) += x_ri *
+                        matrix_access(_Y,_YR,_YC,i,c);
+                }
             }
-            matrix_access(_Z,_ZR,_ZC,r,c) = sum;
-#ifdef DEBUG
-            printf("z(%u,%u) = ", r, c);
-            MATRIX_PRINT_ELEMENT(_Z,_ZR,_ZC,r,c);
-            printf("\n");
-#endif
         }
     }
 }
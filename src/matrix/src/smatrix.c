@@ -61,6 +61,14 @@ struct SMATRIX(_s) {
     unsigned int * num_nlist;       // weight of each row, n
     unsigned int max_num_mlist;     // maximum of num_mlist
     unsigned int max_num_nlist;     // maximum of num_nlist
+
+    // compiled (CSR) representation: contiguous copies of the per-row
+    // index/value lists for fast streaming products; rebuilt on demand
+    // by SMATRIX(_compile) and invalidated by any structural change
+    unsigned int * csr_ptr;         // row start offsets [size: M+1]
+    unsigned short int * csr_index; // column indices [size: nnz]
+    T * csr_vals;                   // values [size: nnz]
+    int csr_valid;                  // compiled arrays up to date?
 };
 
 // create _M x _N matrix, initialized with zeros
@@ -101,6 +109,12 @@ SMATRIX() SMATRIX(_create)(unsigned int _M,
     q->max_num_mlist = 0;
     q->max_num_nlist = 0;
 
+    // initialize compiled representation (empty)
+    q->csr_ptr   = NULL;
+    q->csr_index = NULL;
+    q->csr_vals  = NULL;
+    q->csr_valid = 0;
+
     // return main object
     return q;
 }
@@ -149,6 +163,11 @@ void SMATRIX(_destroy)(SMATRIX() _q)
     free(_q->mvals);
     free(_q->nvals);
 
+    // free compiled representation
+    free(_q->csr_ptr);
+    free(_q->csr_index);
+    free(_q->csr_vals);
+
     // free main object memory
     free(_q);
 }
@@ -248,7 +267,10 @@ void SMATRIX(_clear)(SMATRIX() _q)
 {
     unsigned int i;
     unsigned int j;
-    
+
+    // invalidate compiled representation
+    _q->csr_valid = 0;
+
     // clear row entries
     for (i=0; i<_q->M; i++) {
         for (j=0; j<_q->num_mlist[i]; j++) {
@@ -274,6 +296,9 @@ void SMATRIX(_reset)(SMATRIX() _q)
 
     _q->max_num_mlist = 0;
     _q->max_num_nlist = 0;
+
+    // invalidate compiled representation
+    _q->csr_valid = 0;
 }
 
 // determine if element is set
@@ -350,6 +375,9 @@ void SMATRIX(_insert)(SMATRIX()    _q,
     // update maximum
     if (_q->num_mlist[_m] > _q->max_num_mlist) _q->max_num_mlist = _q->num_mlist[_m];
     if (_q->num_nlist[_n] > _q->max_num_nlist) _q->max_num_nlist = _q->num_nlist[_n];
+
+    // invalidate compiled representation
+    _q->csr_valid = 0;
 }
 
 // delete element at index
@@ -402,6 +430,9 @@ void SMATRIX(_delete)(SMATRIX()    _q,
 
     if (_q->max_num_nlist == _q->num_nlist[_n]+1)
         SMATRIX(_reset_max_nlist)(_q);
+
+    // invalidate compiled representation
+    _q->csr_valid = 0;
 }
 
 // set element value at index
@@ -435,6 +466,9 @@ void SMATRIX(_set)(SMATRIX()    _q,
         if (_q->nlist[_n][i] == _m)
             _q->nvals[_n][i] = _v;
     }
+
+    // invalidate compiled representation
+    _q->csr_valid = 0;
 }
 
 
@@ -543,6 +577,40 @@ void SMATRIX(_mul)(SMATRIX() _a,
     }
 }
 
+// compile contiguous (CSR) representation of non-zero entries,
+// enabling the fast path in SMATRIX(_vmul); invalidated internally
+// whenever the matrix is modified
+void SMATRIX(_compile)(SMATRIX() _q)
+{
+    unsigned int i;
+    unsigned int j;
+
+    // count total number of non-zero entries
+    unsigned int nnz = 0;
+    for (i=0; i<_q->M; i++)
+        nnz += _q->num_mlist[i];
+
+    // (re)allocate contiguous arrays
+    _q->csr_ptr   = (unsigned int *)       realloc(_q->csr_ptr,   (_q->M+1)*sizeof(unsigned int));
+    _q->csr_index = (unsigned short int *) realloc(_q->csr_index, nnz*sizeof(unsigned short int));
+    _q->csr_vals  = (T *)                  realloc(_q->csr_vals,  nnz*sizeof(T));
+
+    // copy per-row lists into contiguous arrays
+    unsigned int n = 0;
+    for (i=0; i<_q->M; i++) {
+        _q->csr_ptr[i] = n;
+        for (j=0; j<_q->num_mlist[i]; j++) {
+            _q->csr_index[n] = _q->mlist[i][j];
+            _q->csr_vals[n]  = _q->mvals[i][j];
+            n++;
+        }
+    }
+    _q->csr_ptr[_q->M] = n;
+
+    // mark compiled representation as current
+    _q->csr_valid = 1;
+}
+
 // multiply by vector
 //  _q  :   sparse matrix
 //  _x  :   input vector [size: _N x 1]
@@ -553,7 +621,22 @@ void SMATRIX(_vmul)(SMATRIX() _q,
 {
     unsigned int i;
     unsigned int j;
-    
+
+    // fast path: stream over compiled contiguous arrays
+    if (_q->csr_valid) {
+        for (i=0; i<_q->M; i++) {
+            T p = 0;
+            for (j=_q->csr_ptr[i]; j<_q->csr_ptr[i+1]; j++)
+                p += _q->csr_vals[j] * _x[ _q->csr_index[j] ];
+#if SMATRIX_BOOL
+            _y[i] = p % 2;
+#else
+            _y[i] = p;
+#endif
+        }
+        return;
+    }
+
     // initialize to zero
     for (i=0; i<_q->M; i++)
         _y[i] = 0;
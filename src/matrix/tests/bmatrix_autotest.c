@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+//
+// AUTOTESTS: packed binary matrix functionality
+//
+
+// test basic set/get access and identity initialization
+void autotest_bmatrix_access()
+{
+    // use a column count straddling a word boundary
+    unsigned int M =  12;
+    unsigned int N = 100;
+    unsigned int i;
+    unsigned int j;
+
+    bmatrix q = bmatrix_create(M,N);
+
+    // matrix starts cleared
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            CONTEND_EQUALITY( bmatrix_get(q,i,j), 0 );
+        }
+    }
+
+    // set, verify, clear, verify a high-column entry
+    bmatrix_set(q, 3, 97, 1);
+    CONTEND_EQUALITY( bmatrix_get(q,3,97), 1 );
+    CONTEND_EQUALITY( bmatrix_get(q,3,96), 0 );
+    bmatrix_set(q, 3, 97, 0);
+    CONTEND_EQUALITY( bmatrix_get(q,3,97), 0 );
+
+    // identity
+    bmatrix_eye(q);
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            CONTEND_EQUALITY( bmatrix_get(q,i,j), i==j ? 1 : 0 );
+        }
+    }
+
+    bmatrix_destroy(q);
+}
+
+// test matrix/vector multiplication against expanded reference
+void autotest_bmatrix_vmul()
+{
+    unsigned int M = 24;
+    unsigned int N = 75;
+    unsigned int i;
+    unsigned int j;
+
+    // generate random expanded matrix and input vector
+    unsigned char A[M*N];
+    unsigned char x[N];
+    for (i=0; i<M*N; i++) A[i] = rand() % 2;
+    for (j=0; j<N;   j++) x[j] = rand() % 2;
+
+    // create packed matrix from expanded array
+    bmatrix q = bmatrix_create_array(A, M, N);
+
+    // compute reference product bit-per-byte
+    unsigned char y_ref[M];
+    for (i=0; i<M; i++) {
+        unsigned char p = 0;
+        for (j=0; j<N; j++)
+            p ^= A[i*N + j] & x[j];
+        y_ref[i] = p;
+    }
+
+    // compute packed product and compare
+    unsigned char y[M];
+    bmatrix_vmul(q, x, y);
+    CONTEND_SAME_DATA( y, y_ref, M*sizeof(unsigned char) );
+
+    bmatrix_destroy(q);
+}
+
+// test round-trip conversion with sparse binary matrix
+void autotest_bmatrix_smatrixb()
+{
+    unsigned int M = 16;
+    unsigned int N = 70;
+    unsigned int i;
+    unsigned int j;
+
+    // create sparse matrix with random entries
+    smatrixb A = smatrixb_create(M,N);
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            if ((rand() % 4) == 0)
+                smatrixb_set(A, i, j, 1);
+        }
+    }
+
+    // convert to packed form and back into a second sparse matrix
+    bmatrix  q = bmatrix_create_smatrixb(A);
+    smatrixb B = smatrixb_create(M,N);
+    bmatrix_to_smatrixb(q, B);
+
+    // verify all three representations agree
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            CONTEND_EQUALITY( bmatrix_get(q,i,j), smatrixb_isset(A,i,j) );
+            CONTEND_EQUALITY( smatrixb_get(B,i,j), smatrixb_get(A,i,j) );
+        }
+    }
+
+    bmatrix_destroy(q);
+    smatrixb_destroy(A);
+    smatrixb_destroy(B);
+}
+
+// test Gauss-Jordan elimination over GF(2)
+void autotest_bmatrix_gjelim()
+{
+    unsigned int M = 20;
+    unsigned int N = 90;
+    unsigned int i;
+    unsigned int j;
+
+    // identity has full rank and is unchanged by elimination
+    bmatrix q = bmatrix_create(M,M);
+    bmatrix_eye(q);
+    CONTEND_EQUALITY( bmatrix_gjelim(q), M );
+    for (i=0; i<M; i++) {
+        for (j=0; j<M; j++) {
+            CONTEND_EQUALITY( bmatrix_get(q,i,j), i==j ? 1 : 0 );
+        }
+    }
+    bmatrix_destroy(q);
+
+    // random wide matrix with a duplicated row: rank at most M-1, and
+    // the result is in reduced row-echelon form
+    q = bmatrix_create(M,N);
+    for (i=0; i<M-1; i++) {
+        for (j=0; j<N; j++)
+            bmatrix_set(q, i, j, rand() % 2);
+    }
+    for (j=0; j<N; j++)
+        bmatrix_set(q, M-1, j, bmatrix_get(q, 0, j));
+
+    unsigned int rank = bmatrix_gjelim(q);
+    CONTEND_LESS_THAN( rank, M );
+
+    // each pivot column contains exactly one non-zero entry
+    unsigned int r;
+    for (r=0; r<rank; r++) {
+        // find leading one of row r
+        for (j=0; j<N; j++) {
+            if (bmatrix_get(q,r,j))
+                break;
+        }
+        CONTEND_LESS_THAN( j, N );
+        unsigned int count = 0;
+        for (i=0; i<M; i++)
+            count += bmatrix_get(q,i,j);
+        CONTEND_EQUALITY( count, 1 );
+    }
+
+    // rows below the rank are all zero
+    for (i=rank; i<M; i++) {
+        for (j=0; j<N; j++) {
+            CONTEND_EQUALITY( bmatrix_get(q,i,j), 0 );
+        }
+    }
+    bmatrix_destroy(q);
+}
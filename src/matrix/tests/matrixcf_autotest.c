@@ -405,3 +405,60 @@ void autotest_matrixcf_transmul()
 
 
 
+
+// small-dimension matrix inversion kernels: verify x * inv(x) = I
+void testbench_matrixcf_inv_small(unsigned int _n)
+{
+    float tol = 1e-4f;
+    unsigned int i, j;
+
+    // generate well-conditioned random matrix (diagonally dominant)
+    float complex x[_n*_n];
+    float complex y[_n*_n];
+    float complex z[_n*_n];
+    for (i=0; i<_n*_n; i++)
+        x[i] = randnf()*0.2f + _Complex_I*randnf()*0.2f;
+    for (i=0; i<_n; i++)
+        matrix_access(x,_n,_n,i,i) += 2.0f;
+
+    // invert and multiply back
+    memmove(y, x, _n*_n*sizeof(float complex));
+    matrixcf_inv(y, _n, _n);
+    matrixcf_mul(x,_n,_n, y,_n,_n, z,_n,_n);
+
+    // verify z is the identity matrix
+    for (i=0; i<_n; i++) {
+        for (j=0; j<_n; j++) {
+            CONTEND_DELTA( crealf(matrix_access(z,_n,_n,i,j)), i==j ? 1.0f : 0.0f, tol );
+            CONTEND_DELTA( cimagf(matrix_access(z,_n,_n,i,j)), 0.0f,              tol );
+        }
+    }
+}
+
+void autotest_matrixcf_inv_2x2() { testbench_matrixcf_inv_small(2); }
+void autotest_matrixcf_inv_4x4() { testbench_matrixcf_inv_small(4); }
+
+// 2x2 Cholesky kernel: decompose A = G * G^H and verify L = G
+void autotest_matrixcf_chol_2x2()
+{
+    float tol = 1e-4f;
+
+    // lower-triangular generator with real positive diagonal
+    float complex G[4] = {
+        1.3f,               0.0f,
+        0.6f - 0.4f*_Complex_I, 0.8f};
+
+    // A = G * G^H (computed by hand)
+    float complex A[4] = {
+        1.69f,                  0.78f + 0.52f*_Complex_I,
+        0.78f - 0.52f*_Complex_I,   1.16f};
+    float complex L[4];
+
+    // decompose and compare
+    unsigned int i;
+    matrixcf_chol(A, 2, L);
+    for (i=0; i<4; i++) {
+        CONTEND_DELTA( crealf(L[i]), crealf(G[i]), tol );
+        CONTEND_DELTA( cimagf(L[i]), cimagf(G[i]), tol );
+    }
+}
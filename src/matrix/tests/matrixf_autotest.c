@@ -316,6 +316,43 @@ void autotest_matrixf_mul()
         CONTEND_DELTA( matrixf_data_mul_z[i], z[i], tol );
 }
 
+// test tiny fixed-size multiplication kernels (2x2, 4x4, 8x8)
+void autotest_matrixf_mul_tiny()
+{
+    float tol = 1e-4f;
+
+    unsigned int sizes[3] = {2, 4, 8};
+    unsigned int s;
+    for (s=0; s<3; s++) {
+        unsigned int n = sizes[s];
+        unsigned int r, c, i;
+
+        // random input matrices
+        float x[n*n];
+        float y[n*n];
+        for (i=0; i<n*n; i++) {
+            x[i] = randnf();
+            y[i] = randnf();
+        }
+
+        // multiply (exercises fixed-size kernel)
+        float z[n*n];
+        matrixf_mul(x, n, n,
+                    y, n, n,
+                    z, n, n);
+
+        // compare against direct computation
+        for (r=0; r<n; r++) {
+            for (c=0; c<n; c++) {
+                float sum = 0.0f;
+                for (i=0; i<n; i++)
+                    sum += matrix_access(x,n,n,r,i) * matrix_access(y,n,n,i,c);
+                CONTEND_DELTA( matrix_access(z,n,n,r,c), sum, tol );
+            }
+        }
+    }
+}
+
 // Q/R decomp (Gram-Schmidt)
 void autotest_matrixf_qrdecomp()
 {
@@ -420,3 +457,57 @@ void autotest_matrixf_transmul()
 
 
 
+
+// small-dimension matrix inversion kernels: verify x * inv(x) = I
+void testbench_matrixf_inv_small(unsigned int _n)
+{
+    float tol = 1e-4f;
+    unsigned int i, j;
+
+    // generate well-conditioned random matrix (diagonally dominant)
+    float x[_n*_n];
+    float y[_n*_n];
+    float z[_n*_n];
+    for (i=0; i<_n*_n; i++)
+        x[i] = randnf()*0.2f;
+    for (i=0; i<_n; i++)
+        matrix_access(x,_n,_n,i,i) += 2.0f;
+
+    // invert and multiply back
+    memmove(y, x, _n*_n*sizeof(float));
+    matrixf_inv(y, _n, _n);
+    matrixf_mul(x,_n,_n, y,_n,_n, z,_n,_n);
+
+    // verify z is the identity matrix
+    for (i=0; i<_n; i++) {
+        for (j=0; j<_n; j++) {
+            CONTEND_DELTA( matrix_access(z,_n,_n,i,j), i==j ? 1.0f : 0.0f, tol );
+        }
+    }
+}
+
+void autotest_matrixf_inv_2x2() { testbench_matrixf_inv_small(2); }
+void autotest_matrixf_inv_4x4() { testbench_matrixf_inv_small(4); }
+
+// 2x2 Cholesky kernel: decompose A = G * G^T and verify L = G
+void autotest_matrixf_chol_2x2()
+{
+    float tol = 1e-4f;
+
+    // lower-triangular generator with positive diagonal
+    float G[4] = {
+        1.3f, 0.0f,
+        0.6f, 0.8f};
+    float A[4];
+    float L[4];
+
+    // A = G * G^T
+    unsigned int i;
+    matrixf_mul_hermitian(G, 2, 2, A);
+
+    // decompose and compare
+    matrixf_chol(A, 2, L);
+    for (i=0; i<4; i++) {
+        CONTEND_DELTA( L[i], G[i], tol );
+    }
+}
@@ -29,6 +29,38 @@
 // AUTOTESTS: basic sparse matrix functionality
 //
 
+// test sparse binary matrix/vector multiplication with compiled
+// representation
+void autotest_smatrixb_vmul_compiled()
+{
+    unsigned int M = 24;
+    unsigned int N = 40;
+    unsigned int i;
+
+    // create sparse matrix and set random entries
+    smatrixb A = smatrixb_create(M, N);
+    for (i=0; i<80; i++)
+        smatrixb_set(A, rand()%M, rand()%N, 1);
+
+    // initialize random input vector
+    unsigned char x[N];
+    for (i=0; i<N; i++)
+        x[i] = rand() & 1;
+
+    // compute output with list-based representation
+    unsigned char y0[M];
+    smatrixb_vmul(A, x, y0);
+
+    // compile and re-compute with contiguous representation
+    smatrixb_compile(A);
+    unsigned char y1[M];
+    smatrixb_vmul(A, x, y1);
+    for (i=0; i<M; i++)
+        CONTEND_EQUALITY( y0[i], y1[i] );
+
+    smatrixb_destroy(A);
+}
+
 // test sparse binary matrix methods
 void autotest_smatrixb_vmul()
 {
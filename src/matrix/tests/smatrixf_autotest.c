@@ -65,6 +65,49 @@ void autotest_smatrixf_vmul()
 
     smatrixf_destroy(A);
 }
+
+// test sparse matrix/vector multiplication with compiled representation
+void autotest_smatrixf_vmul_compiled()
+{
+    float tol = 1e-6f;
+
+    unsigned int M = 40;
+    unsigned int N = 64;
+    unsigned int i;
+
+    // create sparse matrix and set random values
+    smatrixf A = smatrixf_create(M, N);
+    for (i=0; i<120; i++)
+        smatrixf_set(A, rand()%M, rand()%N, randnf());
+
+    // initialize random input vector
+    float x[N];
+    for (i=0; i<N; i++)
+        x[i] = randnf();
+
+    // compute output with list-based representation
+    float y0[M];
+    smatrixf_vmul(A, x, y0);
+
+    // compile and re-compute with contiguous representation
+    smatrixf_compile(A);
+    float y1[M];
+    smatrixf_vmul(A, x, y1);
+    for (i=0; i<M; i++)
+        CONTEND_DELTA( y0[i], y1[i], tol );
+
+    // modifying the matrix invalidates the compiled arrays; results
+    // must track the change
+    smatrixf_set(A, 0, 0, 7.0f);
+    smatrixf_vmul(A, x, y0);
+    smatrixf_compile(A);
+    smatrixf_vmul(A, x, y1);
+    for (i=0; i<M; i++)
+        CONTEND_DELTA( y0[i], y1[i], tol );
+
+    smatrixf_destroy(A);
+}
+
 // test sparse floating-point matrix multiplication
 void autotest_smatrixf_mul()
 {
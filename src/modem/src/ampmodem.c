@@ -245,6 +245,27 @@ void ampmodem_demodulate_block(ampmodem        _q,
                                float *         _x)
 {
     unsigned int i;
+
+    // envelope detection: compute signal magnitudes with the
+    // vectorized kernel instead of calling cabsf() per sample; the
+    // DC-blocking filter still runs sample by sample
+    if (_q->demod == ampmodem_demod_dsb_peak_detect) {
+        float v[256];
+        while (_n > 0) {
+            unsigned int k = _n < 256 ? _n : 256;
+            liquid_vectorcf_abs(_y, k, v);
+            for (i=0; i<k; i++) {
+                firfilt_rrrf_push   (_q->dcblock, v[i]);
+                firfilt_rrrf_execute(_q->dcblock, &_x[i]);
+                _x[i] /= _q->mod_index;
+            }
+            _y += k;
+            _x += k;
+            _n -= k;
+        }
+        return;
+    }
+
     for (i=0; i<_n; i++) {
         // invoke internal type-specific method
         //ampmodem_demodulate(_q, _y[i], &_x[i]);
@@ -37,6 +37,11 @@ struct FREQDEM(_s) {
     T     ref;  // 1/(2*pi*kf)
 
     TC r_prime; // previous received sample
+
+    // optional processing modes
+    int          small_angle;   // arcsin-free small-angle discriminator
+    iirfilt_rrrf deemph;        // de-emphasis filter (NULL: disabled)
+    float        deemph_tau;    // de-emphasis time constant [samples]
 };
 
 // create freqdem object
@@ -58,6 +63,11 @@ FREQDEM() FREQDEM(_create)(float _kf)
     // compute derived values
     q->ref = 1.0f / (2*M_PI*q->kf);
 
+    // default modes: exact discriminator, no de-emphasis
+    q->small_angle = 0;
+    q->deemph      = NULL;
+    q->deemph_tau  = 0.0f;
+
     // reset modem object
     FREQDEM(_reset)(q);
 
@@ -68,6 +78,9 @@ FREQDEM() FREQDEM(_create)(float _kf)
 // destroy modem object
 void FREQDEM(_destroy)(FREQDEM() _q)
 {
+    if (_q->deemph != NULL)
+        iirfilt_rrrf_destroy(_q->deemph);
+
     // free main object memory
     free(_q);
 }
@@ -77,6 +90,10 @@ void FREQDEM(_print)(FREQDEM() _q)
 {
     printf("freqdem:\n");
     printf("    mod. factor :   %8.4f\n", _q->kf);
+    if (_q->small_angle)
+        printf("    small-angle :   enabled\n");
+    if (_q->deemph != NULL)
+        printf("    de-emphasis :   %8.4f samples\n", _q->deemph_tau);
 }
 
 // reset modem object
@@ -84,6 +101,52 @@ void FREQDEM(_reset)(FREQDEM() _q)
 {
     // clear complex phase term
     _q->r_prime = 0;
+
+    // reset de-emphasis filter state
+    if (_q->deemph != NULL)
+        iirfilt_rrrf_reset(_q->deemph);
+}
+
+// enable/disable arcsin-free small-angle discriminator, approximating
+// the phase difference as sin(dphi) ~ dphi; roughly twice as fast as
+// the exact discriminator and appropriate for high-SNR links where
+// per-sample phase increments stay well within [-pi/2, pi/2]
+//  _q      :   frequency demodulator object
+//  _enable :   enable approximation?
+void FREQDEM(_set_small_angle)(FREQDEM() _q,
+                               int       _enable)
+{
+    _q->small_angle = _enable != 0;
+}
+
+// set de-emphasis time constant, folding a single-pole low-pass
+// de-emphasis filter (discrete equivalent of 1/(1 + s*tau)) into the
+// demodulator output path
+//  _q      :   frequency demodulator object
+//  _tau    :   time constant [samples], _tau >= 0 (0: disable)
+void FREQDEM(_set_deemphasis)(FREQDEM() _q,
+                              float     _tau)
+{
+    // validate input
+    if (_tau < 0.0f) {
+        fprintf(stderr,"error: freqdem_set_deemphasis(), time constant must be non-negative\n");
+        exit(1);
+    }
+
+    // destroy old filter
+    if (_q->deemph != NULL) {
+        iirfilt_rrrf_destroy(_q->deemph);
+        _q->deemph = NULL;
+    }
+    _q->deemph_tau = _tau;
+    if (_tau == 0.0f)
+        return;
+
+    // design single-pole filter with matched time constant, unity DC gain
+    float p = expf(-1.0f/_tau);
+    float b[1] = {1.0f - p};
+    float a[2] = {1.0f, -p};
+    _q->deemph = iirfilt_rrrf_create(b, 1, a, 2);
 }
 
 // demodulate sample
@@ -95,7 +158,18 @@ void FREQDEM(_demodulate)(FREQDEM() _q,
                           T *       _m)
 {
     // compute phase difference and normalize by modulation index
-    *_m = cargf( conjf(_q->r_prime)*_r ) * _q->ref;
+    TC z = conjf(_q->r_prime)*_r;
+    if (_q->small_angle) {
+        // arcsin-free approximation: dphi ~ sin(dphi) = Im{z}/|z|
+        T v = cabsf(z);
+        *_m = (v > 0.0f ? cimagf(z)/v : 0.0f) * _q->ref;
+    } else {
+        *_m = cargf(z) * _q->ref;
+    }
+
+    // apply de-emphasis filter
+    if (_q->deemph != NULL)
+        iirfilt_rrrf_execute(_q->deemph, *_m, _m);
 
     // save previous input sample
     _q->r_prime = _r;
@@ -111,9 +185,41 @@ void FREQDEM(_demodulate_block)(FREQDEM()    _q,
                                 unsigned int _n,
                                 T *          _m)
 {
-    // TODO: implement more efficient method
+    // process in chunks: form the one-sample-lag conjugate products,
+    // then convert phase differences with the vectorized kernels rather
+    // than calling cargf() once per sample
+    TC buf[256];
+    T  mag[256];
     unsigned int i;
-    for (i=0; i<_n; i++)
-        FREQDEM(_demodulate)(_q, _r[i], &_m[i]);
+    while (_n > 0) {
+        unsigned int k = _n < 256 ? _n : 256;
+
+        // phase difference products, first against the previous sample
+        buf[0] = conjf(_q->r_prime)*_r[0];
+        for (i=1; i<k; i++)
+            buf[i] = conjf(_r[i-1])*_r[i];
+        _q->r_prime = _r[k-1];
+
+        if (_q->small_angle) {
+            // arcsin-free approximation: dphi ~ sin(dphi) = Im{z}/|z|
+            liquid_vectorcf_abs(buf, k, mag);
+            for (i=0; i<k; i++)
+                _m[i] = mag[i] > 0.0f ? cimagf(buf[i])/mag[i] : 0.0f;
+        } else {
+            // extract exact phase
+            liquid_vectorcf_carg(buf, k, _m);
+        }
+
+        // normalize by modulation index
+        liquid_vectorf_mulscalar(_m, k, _q->ref, _m);
+
+        // apply de-emphasis filter
+        if (_q->deemph != NULL)
+            iirfilt_rrrf_execute_block(_q->deemph, _m, k, _m);
+
+        _r += k;
+        _m += k;
+        _n -= k;
+    }
 }
 
@@ -53,6 +53,11 @@ struct fskdem_s {
     FFT_PLAN        fft;        // FFT object
     unsigned int *  demod_map;  // demodulation map
 
+    // Goertzel resonator bank engine
+    int             goertzel;   // use Goertzel engine?
+    float *         gcoef;      // resonator coefficients [size: M x 1]
+    float complex * gexp;       // finalizer phasors [size: M x 1]
+
     // state variables
     unsigned int    s_demod;    // demodulated symbol (used for frequency error)
 };
@@ -145,6 +150,11 @@ fskdem fskdem_create(unsigned int _m,
     q->buf_freq = (float complex*) malloc(q->K * sizeof(float complex));
     q->fft = FFT_CREATE_PLAN(q->K, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, 0);
 
+    // default to FFT-based demodulation engine
+    q->goertzel = 0;
+    q->gcoef    = NULL;
+    q->gexp     = NULL;
+
     // reset modem object
     fskdem_reset(q);
 
@@ -152,6 +162,54 @@ fskdem fskdem_create(unsigned int _m,
     return q;
 }
 
+// create fskdem object using a bank of Goertzel resonators rather
+// than a full FFT; only the M candidate tone bins are evaluated so
+// the per-symbol cost is O(M*k) independent of the transform size,
+// a significant savings when the constellation is small relative to
+// the transform
+//  _m          :   bits per symbol, _m > 0
+//  _k          :   samples/symbol, _k >= 2^_m
+//  _bandwidth  :   total signal bandwidth, (0,0.5)
+fskdem fskdem_create_goertzel(unsigned int _m,
+                              unsigned int _k,
+                              float        _bandwidth)
+{
+    // create base object (validates input, builds demodulation map)
+    fskdem q = fskdem_create(_m, _k, _bandwidth);
+
+    // enable Goertzel engine
+    q->goertzel = 1;
+
+    // precompute resonator coefficient and finalizer phasor for the
+    // bin frequency of each candidate tone
+    q->gcoef = (float*)         malloc(q->M * sizeof(float));
+    q->gexp  = (float complex*) malloc(q->M * sizeof(float complex));
+    unsigned int s;
+    for (s=0; s<q->M; s++) {
+        float omega = 2.0f*M_PI*(float)(q->demod_map[s]) / (float)(q->K);
+        q->gcoef[s] = 2.0f*cosf(omega);
+        q->gexp[s]  = cexpf(-_Complex_I*omega);
+    }
+
+    // return main object
+    return q;
+}
+
+// create fskdem object with the demodulation engine selected from the
+// process-wide tuning table (see liquid_tune); without a recorded
+// measurement the FFT engine is used
+//  _m          :   bits per symbol, _m > 0
+//  _k          :   samples/symbol, _k >= 2^_m
+//  _bandwidth  :   total signal bandwidth, (0,0.5)
+fskdem fskdem_create_auto(unsigned int _m,
+                          unsigned int _k,
+                          float        _bandwidth)
+{
+    int choice = liquid_tune_get(LIQUID_TUNE_FSKDEM, (_m<<16)|_k);
+    return choice == 1 ? fskdem_create_goertzel(_m, _k, _bandwidth) :
+                         fskdem_create         (_m, _k, _bandwidth);
+}
+
 // destroy fskdem object
 void fskdem_destroy(fskdem _q)
 {
@@ -161,6 +219,10 @@ void fskdem_destroy(fskdem _q)
     free(_q->buf_freq);
     FFT_DESTROY_PLAN(_q->fft);
 
+    // free Goertzel engine arrays
+    if (_q->gcoef != NULL) free(_q->gcoef);
+    if (_q->gexp  != NULL) free(_q->gexp);
+
     // free main object memory
     free(_q);
 }
@@ -188,6 +250,61 @@ void fskdem_reset(fskdem _q)
     _q->s_demod = 0;
 }
 
+// evaluate a single transform bin of the internal time buffer with
+// the Goertzel recursion
+//  _q      :   fskdem object
+//  _coef   :   resonator coefficient, 2*cos(2*pi*b/K)
+//  _gexp   :   finalizer phasor, exp(-j*2*pi*b/K)
+float complex fskdem_run_goertzel(fskdem        _q,
+                                  float         _coef,
+                                  float complex _gexp)
+{
+    float complex v0;
+    float complex v1 = 0;
+    float complex v2 = 0;
+    unsigned int n;
+    for (n=0; n<_q->k; n++) {
+        v0 = _q->buf_time[n] + _coef*v1 - v2;
+        v2 = v1;
+        v1 = v0;
+    }
+    return v1 - _gexp*v2;
+}
+
+// demodulate symbol in internal time buffer using the Goertzel
+// resonator bank, optionally saving candidate tone energies
+//  _q      :   fskdem object
+//  _e      :   output tone energies (ignored if NULL) [size: M x 1]
+unsigned int fskdem_demodulate_goertzel(fskdem  _q,
+                                        float * _e)
+{
+    float vmax = 0;
+    unsigned int s;
+    for (s=0; s<_q->M; s++) {
+        // evaluate resonator at tone bin, saving transform value for
+        // subsequent energy queries
+        float complex v = fskdem_run_goertzel(_q, _q->gcoef[s], _q->gexp[s]);
+        _q->buf_freq[_q->demod_map[s]] = v;
+
+        // compute raw (squared magnitude) energy
+        float energy = crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
+
+        // save tone energy for soft processing
+        if (_e != NULL)
+            _e[s] = energy;
+
+        if (s==0 || energy > vmax) {
+            // save optimal output symbol
+            _q->s_demod = s;
+
+            // save peak bin energy
+            vmax = energy;
+        }
+    }
+
+    return _q->s_demod;
+}
+
 // demodulate symbol, assuming perfect symbol timing
 //  _q      :   fskdem object
 //  _y      :   input sample array [size: _k x 1]
@@ -197,6 +314,10 @@ unsigned int fskdem_demodulate(fskdem          _q,
     // copy input to internal time buffer
     memmove(_q->buf_time, _y, _q->k*sizeof(float complex));
 
+    // evaluate only candidate tone bins with resonator bank
+    if (_q->goertzel)
+        return fskdem_demodulate_goertzel(_q, NULL);
+
     // compute transform, storing result in 'buf_freq'
     FFT_EXECUTE(_q->fft);
 
@@ -220,9 +341,84 @@ unsigned int fskdem_demodulate(fskdem          _q,
     return _q->s_demod;
 }
 
+// demodulate block of symbols, assuming perfect symbol timing
+//  _q      :   fskdem object
+//  _y      :   input sample array [size: _n*_k x 1]
+//  _n      :   number of symbols
+//  _s      :   output symbol array [size: _n x 1]
+//  _e      :   output tone energies (ignored if NULL) [size: _n*M x 1]
+void fskdem_demodulate_block(fskdem          _q,
+                             float complex * _y,
+                             unsigned int    _n,
+                             unsigned int *  _s,
+                             float *         _e)
+{
+    unsigned int i;
+    unsigned int s;
+
+    for (i=0; i<_n; i++) {
+        // copy input to internal time buffer; samples beyond the
+        // symbol length remain zero (transform zero-padding)
+        memmove(_q->buf_time, &_y[i*_q->k], _q->k*sizeof(float complex));
+
+        // evaluate only candidate tone bins with resonator bank
+        if (_q->goertzel) {
+            _s[i] = fskdem_demodulate_goertzel(_q, _e==NULL ? NULL : &_e[i*_q->M]);
+            continue;
+        }
+
+        // compute transform, storing result in 'buf_freq'
+        FFT_EXECUTE(_q->fft);
+
+        // find maximum by looking at particular bins; compare raw
+        // (squared magnitude) energies, skipping the square root of
+        // the per-symbol search
+        float vmax = 0;
+        for (s=0; s<_q->M; s++) {
+            float complex v = _q->buf_freq[_q->demod_map[s]];
+            float energy = crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
+
+            // save tone energy for soft processing
+            if (_e != NULL)
+                _e[i*_q->M + s] = energy;
+
+            if (s==0 || energy > vmax) {
+                // save optimal output symbol
+                _q->s_demod = s;
+
+                // save peak FFT bin energy
+                vmax = energy;
+            }
+        }
+
+        // save best result
+        _s[i] = _q->s_demod;
+    }
+}
+
 // get demodulator frequency error
 float fskdem_get_frequency_error(fskdem _q)
 {
+    // Goertzel engine: evaluate bins adjacent to the peak tone bin
+    // directly from the retained time buffer
+    if (_q->goertzel) {
+        unsigned int index = _q->demod_map[_q->s_demod];
+        float vm = 0;   // previous
+        float v0 = 0;   // peak
+        float vp = 0;   // post
+        unsigned int b;
+        for (b=0; b<3; b++) {
+            unsigned int bin = (index + _q->K + b - 1) % _q->K;
+            float omega = 2.0f*M_PI*(float)bin / (float)(_q->K);
+            float complex v = fskdem_run_goertzel(_q, 2.0f*cosf(omega),
+                                                  cexpf(-_Complex_I*omega));
+            if      (b==0) vm = cabsf(v);
+            else if (b==1) v0 = cabsf(v);
+            else           vp = cabsf(v);
+        }
+        return (vp - vm) / v0;
+    }
+
     // get index of peak bin
     //unsigned int index = _q->buf_freq[ _q->s_demod ];
 
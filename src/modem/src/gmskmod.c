@@ -43,6 +43,17 @@ struct gmskmod_s {
 
     float theta;            // phase state
     float k_inv;            // 1/k
+
+    // trajectory table: the filter spans 2m+1 symbols, so the set of
+    // filtered-phase trajectories over one symbol is enumerable; each
+    // entry holds the unit-magnitude waveform segment of one symbol
+    // history, reducing modulation to a table copy and one rotation
+    unsigned int    hist_len;    // history length (filter span, symbols)
+    unsigned int    num_traj;    // number of trajectories, 2^hist_len
+    unsigned int    sym_hist;    // symbol history register
+    unsigned int    warmup;      // symbols until history register is primed
+    float complex * traj;        // waveform segments [size: num_traj x k]
+    float *         traj_dtheta; // phase increment per segment
 };
 
 // create gmskmod object
@@ -84,6 +95,45 @@ gmskmod gmskmod_create(unsigned int _k,
     // create interpolator object
     q->interp_tx = firinterp_rrrf_create_prototype(LIQUID_FIRFILT_GMSKTX, q->k, q->m, q->BT, 0);
 
+    // build trajectory table, keeping the direct interpolator path for
+    // configurations where the table would be unreasonably large
+    q->hist_len = 2*q->m + 1;
+    q->num_traj = 1 << q->hist_len;
+    if (q->hist_len <= 16 && q->num_traj*q->k <= 65536) {
+        q->traj        = (float complex*) malloc(q->num_traj*q->k*sizeof(float complex));
+        q->traj_dtheta = (float*)         malloc(q->num_traj*sizeof(float));
+
+        // scratch interpolator for generating trajectories
+        firinterp_rrrf interp = firinterp_rrrf_create_prototype(LIQUID_FIRFILT_GMSKTX, q->k, q->m, q->BT, 0);
+
+        unsigned int h;
+        unsigned int i;
+        int j;
+        float phi[q->k];
+        for (h=0; h<q->num_traj; h++) {
+            // push symbol history, oldest first (bit 0 is the newest
+            // symbol); the filter retains exactly hist_len symbols so
+            // the final segment depends on this history alone
+            firinterp_rrrf_reset(interp);
+            for (j=q->hist_len-1; j>=0; j--) {
+                float x = ((h >> j) & 1) ? q->k_inv : -q->k_inv;
+                firinterp_rrrf_execute(interp, x, phi);
+            }
+
+            // integrate phase over segment
+            float dtheta = 0.0f;
+            for (i=0; i<q->k; i++) {
+                dtheta += phi[i];
+                q->traj[h*q->k + i] = liquid_cexpjf(dtheta);
+            }
+            q->traj_dtheta[h] = dtheta;
+        }
+        firinterp_rrrf_destroy(interp);
+    } else {
+        q->traj        = NULL;
+        q->traj_dtheta = NULL;
+    }
+
     // reset modem state
     gmskmod_reset(q);
 
@@ -96,6 +146,10 @@ void gmskmod_destroy(gmskmod _q)
     // destroy interpolator
     firinterp_rrrf_destroy(_q->interp_tx);
 
+    // free trajectory table
+    if (_q->traj        != NULL) free(_q->traj);
+    if (_q->traj_dtheta != NULL) free(_q->traj_dtheta);
+
     // free transmit filter array
     free(_q->h);
 
@@ -119,12 +173,39 @@ void gmskmod_reset(gmskmod _q)
 
     // clear interpolator buffer
     firinterp_rrrf_reset(_q->interp_tx);
+
+    // reset symbol history; the interpolator's zero initial state is
+    // not representable as a symbol history, so the first hist_len-1
+    // symbols run through the interpolator while the register fills
+    _q->sym_hist = 0;
+    _q->warmup   = _q->hist_len - 1;
 }
 
 void gmskmod_modulate(gmskmod _q,
                       unsigned int _s,
                       float complex * _y)
 {
+    unsigned int i;
+
+    // update symbol history register
+    _q->sym_hist = ((_q->sym_hist << 1) | (_s & 1)) & (_q->num_traj-1);
+
+    // table mode: copy waveform segment, rotated by the phase state
+    if (_q->traj != NULL && _q->warmup == 0) {
+        float complex * seg = &_q->traj[_q->sym_hist * _q->k];
+        float complex rot = liquid_cexpjf(_q->theta);
+        for (i=0; i<_q->k; i++)
+            _y[i] = rot * seg[i];
+
+        // advance phase state, ensuring phase in [-pi, pi]
+        _q->theta += _q->traj_dtheta[_q->sym_hist];
+        while (_q->theta >  M_PI) _q->theta -= 2*M_PI;
+        while (_q->theta < -M_PI) _q->theta += 2*M_PI;
+        return;
+    }
+    if (_q->warmup > 0)
+        _q->warmup--;
+
     // generate sample from symbol
     float x = _s==0 ? -_q->k_inv : _q->k_inv;
 
@@ -133,7 +214,6 @@ void gmskmod_modulate(gmskmod _q,
     firinterp_rrrf_execute(_q->interp_tx, x, phi);
 
     // integrate phase state
-    unsigned int i;
     for (i=0; i<_q->k; i++) {
         // integrate phase state
         _q->theta += phi[i];
@@ -61,9 +61,8 @@ MODEM() MODEM(_create_apsk)(unsigned int _bits_per_symbol)
     for (i=0; i<q->data.apsk.num_levels-1; i++)
         q->data.apsk.r_slicer[i] = apskdef->r_slicer[i];
 
-    // copy symbol map
-    q->data.apsk.map = (unsigned char *) malloc(q->M*sizeof(unsigned char));
-    memmove(q->data.apsk.map, apskdef->map, q->M*sizeof(unsigned char));
+    // reference shared constant symbol mapping (not copied; never freed)
+    q->data.apsk.map = apskdef->map;
 
     // set modulation/demodulation function pointers
     q->modulate_func = &MODEM(_modulate_apsk);
@@ -81,9 +80,8 @@ MODEM() MODEM(_create_apsk)(unsigned int _bits_per_symbol)
     default:;
     }
 
-    // initialize symbol map
-    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
-    MODEM(_init_map)(q);
+    // initialize symbol map (shared across instances of this scheme)
+    MODEM(_init_map_shared)(q);
     q->modulate_using_map = 1;
 
     // reset modem and return
@@ -27,11 +27,24 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
 #define DEBUG_DEMODULATE_SOFT 0
 
+// shared table cache for fixed modulation schemes: symbol maps and
+// soft-demodulation neighbor tables depend only on the scheme, so
+// each is built once when the first instance of a scheme is created
+// and referenced (never copied) by every subsequent instance; the
+// tables are immutable once built and retained for the life of the
+// process.  modems may be created concurrently (e.g. by synchronizer
+// worker threads), so the mutex serializes table construction and a
+// table is published to the cache only once it is complete
+static TC *            MODEM(_symbol_map_cache)[LIQUID_MODEM_NUM_SCHEMES];
+static unsigned char * MODEM(_demodsoft_cache) [LIQUID_MODEM_NUM_SCHEMES];
+static pthread_mutex_t MODEM(_cache_mutex) = PTHREAD_MUTEX_INITIALIZER;
+
 // modem structure used for both modulation and demodulation 
 //
 // The modem structure implements a variety of common modulation schemes,
@@ -60,6 +73,7 @@ struct MODEM(_s)
     // modulation
     TC * symbol_map;     // complete symbol map
     int modulate_using_map;         // modulate using map (look-up table) flag
+    int symbol_map_shared;          // map references shared static table (do not free)
 
     // demodulation
     TC r;                // received state vector
@@ -101,7 +115,7 @@ struct MODEM(_s)
             T r[8];                     // radii of levels
             T r_slicer[8];              // slicer radii of levels
             T phi[8];                   // phase offset of levels
-            unsigned char * map;        // symbol mapping (allocated)
+            unsigned char * map;        // symbol mapping (shared constant table)
         } apsk;
 
         // 'square' 32-QAM
@@ -130,6 +144,20 @@ struct MODEM(_s)
     // neighbors array
     unsigned char * demod_soft_neighbors;   // array of nearest neighbors
     unsigned int demod_soft_p;              // number of neighbors in array
+    int demod_soft_shared;                  // neighbors reference shared static table
+
+    // batch soft demodulation: planar (split real/imaginary)
+    // constellation table and per-bit symbol subsets enabling a
+    // vectorized distance computation over all constellation points
+    T *             demod_soft_tab_i;   // real components [size: M x 1]
+    T *             demod_soft_tab_q;   // imag components [size: M x 1]
+    unsigned char * demod_soft_subsets; // per-bit subsets [size: m x M]
+
+    // quantized per-axis LLR look-up table for square QAM; the LLR of
+    // square QAM is separable in the in-phase/quadrature axes so soft
+    // demodulation reduces to two table look-ups per symbol
+    unsigned char * demod_soft_qam_tab;     // [size: 256 x m_i]
+    T               demod_soft_qam_range;   // quantizer full-scale
 };
 
 // create digital modem of a specific scheme and bits/symbol
@@ -233,21 +261,28 @@ MODEM() MODEM(_recreate)(MODEM() _q,
 // destroy a modem object
 void MODEM(_destroy)(MODEM() _q)
 {
-    // free symbol map
-    if (_q->symbol_map != NULL)
+    // free symbol map (unless referencing a shared static table)
+    if (_q->symbol_map != NULL && !_q->symbol_map_shared)
         free(_q->symbol_map);
 
     // free soft-demodulation neighbors table
-    if (_q->demod_soft_neighbors != NULL)
+    if (_q->demod_soft_neighbors != NULL && !_q->demod_soft_shared)
         free(_q->demod_soft_neighbors);
 
+    // free batch soft-demodulation tables
+    if (_q->demod_soft_tab_i   != NULL) free(_q->demod_soft_tab_i);
+    if (_q->demod_soft_tab_q   != NULL) free(_q->demod_soft_tab_q);
+    if (_q->demod_soft_subsets != NULL) free(_q->demod_soft_subsets);
+
+    // free separable QAM soft-demodulation table
+    if (_q->demod_soft_qam_tab != NULL) free(_q->demod_soft_qam_tab);
+
     // free memory in specific data types
+    // (APSK symbol mapping references the shared constant table)
     if (_q->scheme == LIQUID_MODEM_SQAM32) {
         free(_q->data.sqam32.map);
     } else if (_q->scheme == LIQUID_MODEM_SQAM128) {
         free(_q->data.sqam128.map);
-    } else if (liquid_modem_is_apsk(_q->scheme)) {
-        free(_q->data.apsk.map);
     }
 
     // free main object memory
@@ -287,6 +322,7 @@ void MODEM(_init)(MODEM() _q,
     // initialize common elements
     _q->symbol_map = NULL;    // symbol map (LIQUID_MODEM_ARB only)
     _q->modulate_using_map=0; // modulate using map flag
+    _q->symbol_map_shared=0;  // map owned by this object by default
 
     // common data
     _q->m = _bits_per_symbol; // bits/symbol
@@ -299,6 +335,15 @@ void MODEM(_init)(MODEM() _q,
     // soft demodulation
     _q->demod_soft_neighbors = NULL;
     _q->demod_soft_p = 0;
+    _q->demod_soft_shared = 0;
+
+    // batch soft demodulation (tables built on first use)
+    _q->demod_soft_tab_i   = NULL;
+    _q->demod_soft_tab_q   = NULL;
+    _q->demod_soft_subsets = NULL;
+
+    // separable QAM soft demodulation (square QAM only)
+    _q->demod_soft_qam_tab = NULL;
 }
 
 // initialize symbol map for fast modulation
@@ -321,6 +366,26 @@ void MODEM(_init_map)(MODEM() _q)
         _q->modulate_func(_q, i, &_q->symbol_map[i]);
 }
 
+// initialize symbol map for fast modulation, referencing the shared
+// static table for the object's (fixed) modulation scheme; the table
+// is built by the first instance of the scheme
+void MODEM(_init_map_shared)(MODEM() _q)
+{
+    pthread_mutex_lock(&MODEM(_cache_mutex));
+    if (MODEM(_symbol_map_cache)[_q->scheme] == NULL) {
+        // first instance of this scheme: build the table completely
+        // before publishing it to the cache
+        TC * map = (TC*) malloc(_q->M*sizeof(TC));
+        _q->symbol_map = map;
+        MODEM(_init_map)(_q);
+        MODEM(_symbol_map_cache)[_q->scheme] = map;
+    }
+
+    _q->symbol_map        = MODEM(_symbol_map_cache)[_q->scheme];
+    _q->symbol_map_shared = 1;
+    pthread_mutex_unlock(&MODEM(_cache_mutex));
+}
+
 // Generate random symbol
 unsigned int MODEM(_gen_rand_sym)(MODEM() _q)
 {
@@ -362,6 +427,37 @@ void MODEM(_modulate)(MODEM() _q,
     }
 }
 
+// modulate a block of symbols
+//  _q  : modem object
+//  _s  : input symbol array [size: _n x 1]
+//  _n  : number of input symbols
+//  _y  : output sample array [size: _n x 1]
+void MODEM(_modulate_block)(MODEM()        _q,
+                            unsigned int * _s,
+                            unsigned int   _n,
+                            TC *           _y)
+{
+    unsigned int i;
+
+    if (_q->modulate_using_map) {
+        // table-driven schemes reduce to a single gather loop over
+        // the precomputed constellation map
+        for (i=0; i<_n; i++) {
+            // validate input
+            if (_s[i] >= _q->M) {
+                fprintf(stderr,"error: modem_modulate_block(), input symbol exceeds constellation size\n");
+                exit(1);
+            }
+            _y[i] = _q->symbol_map[_s[i]];
+        }
+        return;
+    }
+
+    // modulate one symbol at a time (e.g. stateful schemes)
+    for (i=0; i<_n; i++)
+        MODEM(_modulate)(_q, _s[i], &_y[i]);
+}
+
 // modulate using symbol map (look-up table)
 void MODEM(_modulate_map)(MODEM() _q,
                           unsigned int _symbol_in,
@@ -402,6 +498,12 @@ void MODEM(_demodulate_soft)(MODEM() _q,
     default:;
     }
 
+    // square QAM: two look-ups on quantized per-axis LLR table
+    if (_q->demod_soft_qam_tab != NULL) {
+        MODEM(_demodulate_soft_qam_table)(_q, _x, _s, _soft_bits);
+        return;
+    }
+
     // check if...
     if (_q->demod_soft_neighbors != NULL && _q->demod_soft_p != 0) {
         // demodulate using approximate log-likelihood method with
@@ -515,6 +617,128 @@ void MODEM(_demodulate_soft_table)(MODEM() _q,
 }
 
 
+// build planar constellation table and per-bit symbol subsets for
+// batch soft demodulation
+void MODEM(_demodulate_soft_block_init)(MODEM() _q)
+{
+    unsigned int s;
+    unsigned int k;
+
+    // allocate internal arrays
+    _q->demod_soft_tab_i   = (T*) malloc(_q->M*sizeof(T));
+    _q->demod_soft_tab_q   = (T*) malloc(_q->M*sizeof(T));
+    _q->demod_soft_subsets = (unsigned char*) malloc(_q->m*_q->M*sizeof(unsigned char));
+
+    // build planar constellation table (split real/imaginary
+    // components so distances can be computed on contiguous arrays)
+    TC x;
+    for (s=0; s<_q->M; s++) {
+        if (_q->modulate_using_map)
+            x = _q->symbol_map[s];
+        else
+            _q->modulate_func(_q, s, &x);
+        _q->demod_soft_tab_i[s] = crealf(x);
+        _q->demod_soft_tab_q[s] = cimagf(x);
+    }
+
+    // build per-bit symbol subsets: for bit k the first M/2 entries
+    // are the symbols with bit k cleared, the last M/2 the symbols
+    // with bit k set
+    for (k=0; k<_q->m; k++) {
+        unsigned int n0 = 0;
+        unsigned int n1 = 0;
+        for (s=0; s<_q->M; s++) {
+            unsigned int bit = (s >> (_q->m-k-1)) & 0x01;
+            if (bit) _q->demod_soft_subsets[k*_q->M + _q->M/2 + n1++] = s;
+            else     _q->demod_soft_subsets[k*_q->M +            n0++] = s;
+        }
+    }
+}
+
+// batch soft demodulation over a block of samples, computing the
+// log-likelihood ratio of each bit from the exact minimum distance
+// over each per-bit constellation subset
+//  _q          :   demodulator object
+//  _x          :   input sample array [size: _n x 1]
+//  _n          :   number of input samples
+//  _s          :   hard demodulator output array [size: _n x 1]
+//  _soft_bits  :   soft bit output array [size: _n*bps x 1]
+void MODEM(_demodulate_soft_block)(MODEM()         _q,
+                                   TC *            _x,
+                                   unsigned int    _n,
+                                   unsigned int *  _s,
+                                   unsigned char * _soft_bits)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+
+    // specialized and stateful schemes fall back to the per-symbol
+    // soft demodulator
+    if (_q->scheme == LIQUID_MODEM_BPSK ||
+        _q->scheme == LIQUID_MODEM_QPSK ||
+        liquid_modem_is_dpsk(_q->scheme))
+    {
+        for (i=0; i<_n; i++)
+            MODEM(_demodulate_soft)(_q, _x[i], &_s[i], &_soft_bits[i*_q->m]);
+        return;
+    }
+
+    // lazily build planar constellation table and per-bit subsets
+    if (_q->demod_soft_tab_i == NULL)
+        MODEM(_demodulate_soft_block_init)(_q);
+
+    unsigned int M   = _q->M;
+    unsigned int bps = _q->m;
+
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    T gamma = 1.2f*_q->M;
+
+    // squared distance to each constellation point
+    T d[M];
+
+    for (i=0; i<_n; i++) {
+        T vi = crealf(_x[i]);
+        T vq = cimagf(_x[i]);
+
+        // compute squared Euclidean distance to every constellation
+        // point; the planar table keeps the inner loop vectorizable
+        for (j=0; j<M; j++) {
+            T ei = vi - _q->demod_soft_tab_i[j];
+            T eq = vq - _q->demod_soft_tab_q[j];
+            d[j] = ei*ei + eq*eq;
+        }
+
+        // hard decision: index of minimum distance
+        unsigned int s_hat = 0;
+        for (j=1; j<M; j++) {
+            if (d[j] < d[s_hat])
+                s_hat = j;
+        }
+        _s[i] = s_hat;
+
+        // find minimum distance over each per-bit subset and make
+        // soft bit assignments
+        for (k=0; k<bps; k++) {
+            unsigned char * subset = &_q->demod_soft_subsets[k*M];
+            T dmin_0 = d[subset[0  ]];
+            T dmin_1 = d[subset[M/2]];
+            for (j=1; j<M/2; j++) {
+                if (d[subset[    j]] < dmin_0) dmin_0 = d[subset[    j]];
+                if (d[subset[M/2+j]] < dmin_1) dmin_1 = d[subset[M/2+j]];
+            }
+
+            int soft_bit = ((dmin_0 - dmin_1)*gamma)*16 + 127;
+            if (soft_bit > 255) soft_bit = 255;
+            if (soft_bit <   0) soft_bit = 0;
+            _soft_bits[i*bps+k] = (unsigned char)soft_bit;
+        }
+
+        // update demodulator state with received/estimated samples
+        _q->r     = _x[i];
+        _q->x_hat = _q->demod_soft_tab_i[s_hat] + _Complex_I*_q->demod_soft_tab_q[s_hat];
+    }
+}
 
 // get demodulator's estimated transmit sample
 void MODEM(_get_demodulator_sample)(MODEM() _q,
@@ -535,6 +759,52 @@ T MODEM(_get_demodulator_evm)(MODEM() _q)
     return cabsf(_q->x_hat - _q->r);
 }
 
+// estimate error vector magnitude and signal-to-noise ratio over a
+// block of received samples in a single pass: each sample is
+// hard-demodulated and the error vector to the decided constellation
+// point folded into Welford-style running means, which stay
+// numerically stable over arbitrarily long frames
+//  _q      :   modem object
+//  _x      :   received sample array [size: _n x 1]
+//  _n      :   number of samples, _n > 0
+//  _evm    :   output rms error vector magnitude (linear), ignored if NULL
+//  _snr    :   output estimated signal-to-noise ratio [dB], ignored if NULL
+void MODEM(_estimate_evm_snr)(MODEM()      _q,
+                              TC *         _x,
+                              unsigned int _n,
+                              T *          _evm,
+                              T *          _snr)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: modem_estimate_evm_snr(), block size must be greater than zero\n");
+        exit(1);
+    }
+
+    // accumulate running means of error and decided-signal power
+    T mean_err = 0.0f;
+    T mean_sig = 0.0f;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // hard-demodulate, updating internal received/estimated samples
+        unsigned int sym;
+        _q->demodulate_func(_q, _x[i], &sym);
+
+        // error vector to decided constellation point
+        TC e  = _q->r - _q->x_hat;
+        T  e2 = crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+        T  s2 = crealf(_q->x_hat)*crealf(_q->x_hat) + cimagf(_q->x_hat)*cimagf(_q->x_hat);
+
+        mean_err += (e2 - mean_err) / (T)(i+1);
+        mean_sig += (s2 - mean_sig) / (T)(i+1);
+    }
+
+    if (_evm != NULL)
+        *_evm = sqrtf(mean_err);
+    if (_snr != NULL)
+        *_snr = 10.0f*log10f(mean_sig / mean_err);
+}
+
 // Demodulate a linear symbol constellation using dynamic threshold calculation
 //  _v      :   input value
 //  _m      :   bits per symbol
@@ -611,7 +881,25 @@ void MODEM(_demodsoft_gentab)(MODEM()      _q,
         fprintf(stderr,"error: modem_demodsoft_gentab(), requesting too many neighbors\n");
         exit(1);
     }
-    
+
+    // fixed schemes reference one shared table per scheme, built by
+    // the first instance (the neighbor search is O(M^2 p) and need
+    // not be repeated for every create); hold the cache mutex across
+    // the build so a concurrent create of the same scheme waits for
+    // the completed table rather than observing a partial one
+    int cacheable = _q->scheme != LIQUID_MODEM_UNKNOWN &&
+                    _q->scheme != LIQUID_MODEM_ARB;
+    if (cacheable) {
+        pthread_mutex_lock(&MODEM(_cache_mutex));
+        if (MODEM(_demodsoft_cache)[_q->scheme] != NULL) {
+            _q->demod_soft_p         = _p;
+            _q->demod_soft_neighbors = MODEM(_demodsoft_cache)[_q->scheme];
+            _q->demod_soft_shared    = 1;
+            pthread_mutex_unlock(&MODEM(_cache_mutex));
+            return;
+        }
+    }
+
     // allocate internal memory
     _q->demod_soft_p = _p;
     _q->demod_soft_neighbors = (unsigned char*)malloc(_q->M*_p*sizeof(unsigned char));
@@ -706,6 +994,13 @@ void MODEM(_demodsoft_gentab)(MODEM()      _q,
         }
     }
 #endif
+
+    // retain the table for subsequent instances of this scheme
+    if (cacheable) {
+        MODEM(_demodsoft_cache)[_q->scheme] = _q->demod_soft_neighbors;
+        _q->demod_soft_shared = 1;
+        pthread_mutex_unlock(&MODEM(_cache_mutex));
+    }
 }
 
 
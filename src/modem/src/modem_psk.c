@@ -61,9 +61,8 @@ MODEM() MODEM(_create_psk)(unsigned int _bits_per_symbol)
     q->modulate_func = &MODEM(_modulate_psk);
     q->demodulate_func = &MODEM(_demodulate_psk);
 
-    // initialize symbol map
-    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
-    MODEM(_init_map)(q);
+    // initialize symbol map (shared across instances of this scheme)
+    MODEM(_init_map_shared)(q);
     q->modulate_using_map = 1;
 
     // initialize soft-demodulation look-up table
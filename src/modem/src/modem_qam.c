@@ -85,15 +85,19 @@ MODEM() MODEM(_create_qam)(unsigned int _bits_per_symbol)
     q->modulate_func = &MODEM(_modulate_qam);
     q->demodulate_func = &MODEM(_demodulate_qam);
 
-    // initialize symbol map
-    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
-    MODEM(_init_map)(q);
+    // initialize symbol map (shared across instances of this scheme)
+    MODEM(_init_map_shared)(q);
     q->modulate_using_map = 1;
 
     // initialize soft-demodulation look-up table
     if      (q->m == 3) MODEM(_demodsoft_gentab)(q, 3);
     else if (q->m >= 4) MODEM(_demodsoft_gentab)(q, 4);
 
+    // initialize separable approximate-LLR table (square QAM only,
+    // e.g. qam16/qam64/qam256)
+    if (q->m >= 4 && (q->m % 2)==0)
+        MODEM(_demodsoft_qam_gentab)(q);
+
     // reset and return
     MODEM(_reset)(q);
     return q;
@@ -143,3 +147,87 @@ void MODEM(_demodulate_qam)(MODEM()      _q,
     _q->r = _x;
 }
 
+// generate quantized per-axis LLR look-up table for square QAM soft
+// demodulation; the max-log LLR of each bit of square QAM depends only
+// on one axis of the received sample (the minimum distance term of the
+// other axis is common to both bit hypotheses and cancels), so each
+// bit's soft value can be tabulated against the quantized in-phase or
+// quadrature component alone
+void MODEM(_demodsoft_qam_gentab)(MODEM() _q)
+{
+    unsigned int m_i = _q->data.qam.m_i;
+    unsigned int M_i = _q->data.qam.M_i;
+    T alpha          = _q->data.qam.alpha;
+
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    T gamma = 1.2f*_q->M;
+
+    // quantizer full-scale: one half-step beyond the outermost level
+    _q->demod_soft_qam_range = M_i * alpha;
+
+    // allocate table: 256 quantized input values by m_i bits
+    _q->demod_soft_qam_tab = (unsigned char*) malloc(256*m_i*sizeof(unsigned char));
+
+    unsigned int b;
+    unsigned int j;
+    unsigned int k;
+    for (b=0; b<256; b++) {
+        // quantization bin center on axis
+        T v = ((b + 0.5f)/128.0f - 1.0f) * _q->demod_soft_qam_range;
+
+        for (j=0; j<m_i; j++) {
+            // find minimum distance over levels with bit j clear/set
+            T dmin_0 = 8.0f;
+            T dmin_1 = 8.0f;
+            for (k=0; k<M_i; k++) {
+                // level position and squared distance
+                T e = v - (2*(int)k - (int)M_i + 1)*alpha;
+                T d = e*e;
+
+                // strip bit (level index is gray decoded)
+                unsigned int bit = (gray_encode(k) >> (m_i-j-1)) & 0x01;
+                if ( bit ) {
+                    if (d < dmin_1) dmin_1 = d;
+                } else {
+                    if (d < dmin_0) dmin_0 = d;
+                }
+            }
+
+            // make soft bit assignment
+            int soft_bit = ((dmin_0 - dmin_1)*gamma)*16 + 127;
+            if (soft_bit > 255) soft_bit = 255;
+            if (soft_bit <   0) soft_bit = 0;
+            _q->demod_soft_qam_tab[b*m_i + j] = (unsigned char)soft_bit;
+        }
+    }
+}
+
+// soft demodulate square QAM using quantized per-axis LLR table:
+// one look-up for the in-phase bits, one for the quadrature bits
+//  _q          :   demodulator object
+//  _x          :   received sample
+//  _s          :   hard demodulator output
+//  _soft_bits  :   soft bit ouput (approximate log-likelihood ratio)
+void MODEM(_demodulate_soft_qam_table)(MODEM()         _q,
+                                       TC              _x,
+                                       unsigned int *  _s,
+                                       unsigned char * _soft_bits)
+{
+    // run hard demodulation (also stores internal sample estimates)
+    MODEM(_demodulate_qam)(_q, _x, _s);
+
+    unsigned int m_i = _q->data.qam.m_i;
+    unsigned int m_q = _q->data.qam.m_q;
+
+    // quantize in-phase and quadrature components, clipping to range
+    T range = _q->demod_soft_qam_range;
+    int b_i = (int)((crealf(_x)/range + 1.0f)*128.0f);
+    int b_q = (int)((cimagf(_x)/range + 1.0f)*128.0f);
+    if (b_i < 0) b_i = 0; else if (b_i > 255) b_i = 255;
+    if (b_q < 0) b_q = 0; else if (b_q > 255) b_q = 255;
+
+    // copy per-axis soft bits (in-phase bits lead)
+    memmove(_soft_bits,       &_q->demod_soft_qam_tab[b_i*m_i], m_i);
+    memmove(_soft_bits + m_i, &_q->demod_soft_qam_tab[b_q*m_i], m_q);
+}
+
@@ -69,3 +69,103 @@ void autotest_freqmodem_kf_0_02() { freqmodem_test(0.02f); }
 void autotest_freqmodem_kf_0_04() { freqmodem_test(0.04f); }
 void autotest_freqmodem_kf_0_08() { freqmodem_test(0.08f); }
 
+
+// small-angle discriminator: for modest modulation indices the
+// arcsin-free approximation recovers the message nearly as well as the
+// exact discriminator, and block/sample paths agree
+void autotest_freqdem_small_angle()
+{
+    unsigned int num_samples = 1024;
+    float        kf          = 0.04f;
+    float        tol         = 5e-2f;
+    unsigned int i;
+
+    freqmod mod   = freqmod_create(kf);
+    freqdem dem   = freqdem_create(kf);
+    freqdem dem_s = freqdem_create(kf);
+    freqdem_set_small_angle(dem, 1);
+    freqdem_set_small_angle(dem_s, 1);
+
+    float         m[num_samples];
+    float complex r[num_samples];
+    float         y[num_samples];
+    float         y_s[num_samples];
+
+    // generate message signal (sum of sines) and modulate
+    for (i=0; i<num_samples; i++) {
+        m[i] = 0.3f*cosf(2*M_PI*0.013f*i + 0.0f) +
+               0.2f*cosf(2*M_PI*0.021f*i + 0.4f) +
+               0.4f*cosf(2*M_PI*0.037f*i + 1.7f);
+    }
+    freqmod_modulate_block(mod, m, num_samples, r);
+
+    // demodulate: block path, and one sample at a time
+    freqdem_demodulate_block(dem, r, num_samples, y);
+    for (i=0; i<num_samples; i++)
+        freqdem_demodulate(dem_s, r[i], &y_s[i]);
+
+    // message recovered, block and sample paths agree closely
+    for (i=1; i<num_samples; i++) {
+        CONTEND_DELTA( y[i], m[i],   tol   );
+        CONTEND_DELTA( y[i], y_s[i], 1e-3f );
+    }
+
+    freqmod_destroy(mod);
+    freqdem_destroy(dem);
+    freqdem_destroy(dem_s);
+}
+
+// de-emphasis fold-in matches running the exact demodulator followed
+// by an equivalent external single-pole filter
+void autotest_freqdem_deemphasis()
+{
+    unsigned int num_samples = 1024;
+    float        kf          = 0.08f;
+    float        tau         = 12.0f;   // time constant [samples]
+    float        tol         = 1e-5f;
+    unsigned int i;
+
+    freqmod mod     = freqmod_create(kf);
+    freqdem dem     = freqdem_create(kf);
+    freqdem dem_ref = freqdem_create(kf);
+    freqdem_set_deemphasis(dem, tau);
+
+    // equivalent external de-emphasis filter
+    float p = expf(-1.0f/tau);
+    float b[1] = {1.0f - p};
+    float a[2] = {1.0f, -p};
+    iirfilt_rrrf deemph = iirfilt_rrrf_create(b, 1, a, 2);
+
+    float         m[num_samples];
+    float complex r[num_samples];
+    float         y[num_samples];
+    float         y_ref[num_samples];
+
+    for (i=0; i<num_samples; i++)
+        m[i] = 0.4f*cosf(2*M_PI*0.017f*i) + 0.3f*sinf(2*M_PI*0.041f*i);
+    freqmod_modulate_block(mod, m, num_samples, r);
+
+    // demodulate with folded-in de-emphasis
+    freqdem_demodulate_block(dem, r, num_samples, y);
+
+    // reference: plain demodulation, then external filter
+    freqdem_demodulate_block(dem_ref, r, num_samples, y_ref);
+    iirfilt_rrrf_execute_block(deemph, y_ref, num_samples, y_ref);
+
+    for (i=0; i<num_samples; i++)
+        CONTEND_DELTA( y[i], y_ref[i], tol );
+
+    // disabling de-emphasis restores plain demodulation
+    freqdem_set_deemphasis(dem, 0.0f);
+    freqdem_reset(dem);
+    freqdem_reset(dem_ref);
+    freqdem_demodulate_block(dem,     r, num_samples, y    );
+    freqdem_demodulate_block(dem_ref, r, num_samples, y_ref);
+    for (i=0; i<num_samples; i++)
+        CONTEND_DELTA( y[i], y_ref[i], tol );
+
+    freqmod_destroy(mod);
+    freqdem_destroy(dem);
+    freqdem_destroy(dem_ref);
+    iirfilt_rrrf_destroy(deemph);
+}
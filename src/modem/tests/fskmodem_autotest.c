@@ -83,3 +83,102 @@ void autotest_fskmodem_misc_M256()  { fskmodem_test_mod_demod( 8,  500, 0.372145
 void autotest_fskmodem_misc_M512()  { fskmodem_test_mod_demod( 9, 1000, 0.3721451); }
 void autotest_fskmodem_misc_M1024() { fskmodem_test_mod_demod(10, 2000, 0.3721451); }
 
+
+// Help function to keep code base small: demodulate a block of
+// modulated symbols at once and verify results against the
+// per-symbol demodulator
+void fskmodem_test_demodulate_block(unsigned int _m,
+                                    unsigned int _k,
+                                    float        _bandwidth)
+{
+    if (liquid_autotest_verbose)
+        printf("fskmodem_test_demodulate_block(m=%u, k=%u, bandwidth=%g)\n", _m, _k, _bandwidth);
+
+    // create modulator/demodulator pair
+    fskmod mod   = fskmod_create(_m,_k,_bandwidth);
+    fskdem dem_0 = fskdem_create(_m,_k,_bandwidth);
+    fskdem dem_1 = fskdem_create(_m,_k,_bandwidth);
+
+    unsigned int M = 1 << _m;   // constellation size
+    float complex buf[M*_k];    // transmit buffer
+    unsigned int sym_0[M];      // per-symbol demodulator output
+    unsigned int sym_1[M];      // block demodulator output
+    float e[M*M];               // tone energies
+
+    // modulate every symbol in the constellation
+    unsigned int i;
+    for (i=0; i<M; i++)
+        fskmod_modulate(mod, i, &buf[i*_k]);
+
+    // demodulate one symbol at a time
+    for (i=0; i<M; i++)
+        sym_0[i] = fskdem_demodulate(dem_0, &buf[i*_k]);
+
+    // demodulate block, saving tone energies
+    fskdem_demodulate_block(dem_1, buf, M, sym_1, e);
+
+    for (i=0; i<M; i++) {
+        // check hard decisions against per-symbol demodulator
+        CONTEND_EQUALITY(sym_0[i], sym_1[i]);
+
+        // demodulated tone must also have the largest energy
+        unsigned int s;
+        for (s=0; s<M; s++) {
+            if (s != sym_1[i])
+                CONTEND_LESS_THAN(e[i*M+s], e[i*M+sym_1[i]]);
+        }
+    }
+
+    // clean it up
+    fskmod_destroy(mod);
+    fskdem_destroy(dem_0);
+    fskdem_destroy(dem_1);
+}
+
+// AUTOTESTS: block demodulation
+void autotest_fskmodem_block_M2()  { fskmodem_test_demodulate_block(1,  4, 0.25f    ); }
+void autotest_fskmodem_block_M8()  { fskmodem_test_demodulate_block(3, 16, 0.25f    ); }
+void autotest_fskmodem_block_M16() { fskmodem_test_demodulate_block(4, 30, 0.3721451); }
+
+// Help function to keep code base small: verify the Goertzel resonator
+// bank engine against the FFT-based demodulator
+void fskmodem_test_goertzel(unsigned int _m,
+                            unsigned int _k,
+                            float        _bandwidth)
+{
+    if (liquid_autotest_verbose)
+        printf("fskmodem_test_goertzel(m=%u, k=%u, bandwidth=%g)\n", _m, _k, _bandwidth);
+
+    // create modulator/demodulator pair
+    fskmod mod     = fskmod_create(_m,_k,_bandwidth);
+    fskdem dem_fft = fskdem_create(_m,_k,_bandwidth);
+    fskdem dem_gtz = fskdem_create_goertzel(_m,_k,_bandwidth);
+
+    unsigned int M = 1 << _m;   // constellation size
+    float complex buf[_k];      // transmit buffer
+
+    // modulate, demodulate with both engines, compare
+    unsigned int i;
+    for (i=0; i<M; i++) {
+        // modulate
+        fskmod_modulate(mod, i, buf);
+
+        // demodulate with each engine
+        unsigned int sym_fft = fskdem_demodulate(dem_fft, buf);
+        unsigned int sym_gtz = fskdem_demodulate(dem_gtz, buf);
+
+        // both engines evaluate the same transform bins
+        CONTEND_EQUALITY(sym_fft, i);
+        CONTEND_EQUALITY(sym_gtz, i);
+    }
+
+    // clean it up
+    fskmod_destroy(mod);
+    fskdem_destroy(dem_fft);
+    fskdem_destroy(dem_gtz);
+}
+
+// AUTOTESTS: Goertzel resonator bank engine
+void autotest_fskmodem_goertzel_M2()  { fskmodem_test_goertzel(1,  4, 0.25f    ); }
+void autotest_fskmodem_goertzel_M4()  { fskmodem_test_goertzel(2, 40, 0.2f     ); }
+void autotest_fskmodem_goertzel_M16() { fskmodem_test_goertzel(4, 30, 0.3721451); }
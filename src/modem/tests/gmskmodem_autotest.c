@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// GMSK modem autotest
+//
+
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// Help function to keep code base small: verify the trajectory-table
+// modulator against direct per-sample phase integration through the
+// transmit interpolator
+void gmskmodem_test_modulate(unsigned int _k,
+                             unsigned int _m,
+                             float        _BT)
+{
+    if (liquid_autotest_verbose)
+        printf("gmskmodem_test_modulate(k=%u, m=%u, BT=%g)\n", _k, _m, _BT);
+
+    // create modulator
+    gmskmod mod = gmskmod_create(_k, _m, _BT);
+
+    // create reference interpolator (same prototype as modulator)
+    firinterp_rrrf interp = firinterp_rrrf_create_prototype(LIQUID_FIRFILT_GMSKTX, _k, _m, _BT, 0);
+
+    unsigned int num_symbols = 200;
+    float        k_inv       = 1.0f / (float)_k;
+    float        theta       = 0.0f;
+    float        phi[_k];
+    float complex buf[_k];
+
+    unsigned int i;
+    unsigned int n;
+    for (n=0; n<num_symbols; n++) {
+        // generate random symbol and modulate
+        unsigned int s = rand() & 1;
+        gmskmod_modulate(mod, s, buf);
+
+        // reference: interpolate and integrate phase directly
+        firinterp_rrrf_execute(interp, s==0 ? -k_inv : k_inv, phi);
+        for (i=0; i<_k; i++) {
+            theta += phi[i];
+            if (theta >  M_PI) theta -= 2*M_PI;
+            if (theta < -M_PI) theta += 2*M_PI;
+
+            // compare output samples
+            CONTEND_DELTA(crealf(buf[i]), cosf(theta), 1e-3f);
+            CONTEND_DELTA(cimagf(buf[i]), sinf(theta), 1e-3f);
+        }
+    }
+
+    // clean it up
+    gmskmod_destroy(mod);
+    firinterp_rrrf_destroy(interp);
+}
+
+// AUTOTESTS: trajectory-table modulation
+void autotest_gmskmodem_modulate_k2_m3()  { gmskmodem_test_modulate(2, 3, 0.30f); }
+void autotest_gmskmodem_modulate_k4_m3()  { gmskmodem_test_modulate(4, 3, 0.30f); }
+void autotest_gmskmodem_modulate_k8_m4()  { gmskmodem_test_modulate(8, 4, 0.25f); }
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -116,3 +117,127 @@ void autotest_mod_demod_arb128opt() { modem_test_mod_demod(LIQUID_MODEM_ARB128OP
 void autotest_mod_demod_arb256opt() { modem_test_mod_demod(LIQUID_MODEM_ARB256OPT); }
 void autotest_mod_demod_arb64vt()   { modem_test_mod_demod(LIQUID_MODEM_ARB64VT);   }
 
+
+// Help function to keep code base small: verify block modulation
+// matches modulating one symbol at a time
+void modem_test_modulate_block(modulation_scheme _ms)
+{
+    // generate modulators
+    modem mod_0 = modem_create(_ms);
+    modem mod_1 = modem_create(_ms);
+
+    // run the test
+    unsigned int i, M = 1 << modem_get_bps(mod_0);
+    unsigned int s[M];
+    float complex x_0[M];
+    float complex x_1[M];
+
+    for (i=0; i<M; i++)
+        s[i] = i;
+
+    // modulate one symbol at a time
+    for (i=0; i<M; i++)
+        modem_modulate(mod_0, s[i], &x_0[i]);
+
+    // modulate block
+    modem_modulate_block(mod_1, s, M, x_1);
+
+    // verify samples are identical
+    CONTEND_SAME_DATA(x_0, x_1, M*sizeof(float complex));
+
+    // clean it up
+    modem_destroy(mod_0);
+    modem_destroy(mod_1);
+}
+
+// AUTOTESTS: block modulation
+void autotest_modulate_block_psk8()    { modem_test_modulate_block(LIQUID_MODEM_PSK8);    }
+void autotest_modulate_block_dpsk4()   { modem_test_modulate_block(LIQUID_MODEM_DPSK4);   }
+void autotest_modulate_block_qam16()   { modem_test_modulate_block(LIQUID_MODEM_QAM16);   }
+void autotest_modulate_block_qam256()  { modem_test_modulate_block(LIQUID_MODEM_QAM256);  }
+void autotest_modulate_block_apsk32()  { modem_test_modulate_block(LIQUID_MODEM_APSK32);  }
+void autotest_modulate_block_sqam128() { modem_test_modulate_block(LIQUID_MODEM_SQAM128); }
+void autotest_modulate_block_arb64vt() { modem_test_modulate_block(LIQUID_MODEM_ARB64VT); }
+
+// Help function: fixed schemes share static tables across instances;
+// verify destroying one instance leaves others fully functional
+// (modulation, hard and soft demodulation)
+void modem_test_shared_tables(modulation_scheme _ms)
+{
+    modem mod_0 = modem_create(_ms);
+    modem mod_1 = modem_create(_ms);
+
+    // destroy the first instance; shared tables must remain valid
+    modem_destroy(mod_0);
+
+    modem demod = modem_create(_ms);
+    unsigned int i, s, M = 1 << modem_get_bps(demod);
+    unsigned char soft_bits[modem_get_bps(demod)];
+    float complex x;
+    for (i=0; i<M; i++) {
+        modem_modulate(mod_1, i, &x);
+        modem_demodulate(demod, x, &s);
+        CONTEND_EQUALITY(s, i);
+        modem_demodulate_soft(demod, x, &s, soft_bits);
+        CONTEND_EQUALITY(s, i);
+    }
+
+    modem_destroy(mod_1);
+    modem_destroy(demod);
+}
+
+// AUTOTESTS: shared static tables
+void autotest_shared_tables_psk8()   { modem_test_shared_tables(LIQUID_MODEM_PSK8);   }
+void autotest_shared_tables_qam64()  { modem_test_shared_tables(LIQUID_MODEM_QAM64);  }
+void autotest_shared_tables_apsk16() { modem_test_shared_tables(LIQUID_MODEM_APSK16); }
+
+// batch EVM/SNR estimation over a noisy frame matches the injected
+// channel conditions and a symbol-at-a-time reference pass
+void modem_test_estimate_evm_snr(modulation_scheme _ms,
+                                 float             _snr_db)
+{
+    unsigned int num_symbols = 40000;
+    float        nstd        = powf(10.0f, -_snr_db/20.0f);
+    unsigned int i;
+
+    modem mod   = modem_create(_ms);
+    modem demod = modem_create(_ms);
+    modem ref   = modem_create(_ms);
+    unsigned int M = 1 << modem_get_bps(mod);
+
+    // generate random symbols through an additive noise channel
+    float complex * x = (float complex *) malloc(num_symbols*sizeof(float complex));
+    for (i=0; i<num_symbols; i++) {
+        modem_modulate(mod, rand() % M, &x[i]);
+        x[i] += nstd*( randnf() + _Complex_I*randnf() )*M_SQRT1_2;
+    }
+
+    // batch estimate
+    float evm, snr;
+    modem_estimate_evm_snr(demod, x, num_symbols, &evm, &snr);
+
+    // reference: demodulate one symbol at a time just for the metric
+    float e2 = 0.0f;
+    unsigned int s;
+    for (i=0; i<num_symbols; i++) {
+        modem_demodulate(ref, x[i], &s);
+        float e = modem_get_demodulator_evm(ref);
+        e2 += e*e;
+    }
+    e2 = sqrtf(e2 / (float)num_symbols);
+
+    // batch result matches the reference pass and the channel
+    CONTEND_DELTA( evm, e2,      1e-4f      );
+    CONTEND_DELTA( evm, nstd,    0.05f*nstd );
+    CONTEND_DELTA( snr, _snr_db, 1.0f       );
+
+    free(x);
+    modem_destroy(mod);
+    modem_destroy(demod);
+    modem_destroy(ref);
+}
+
+// AUTOTESTS: batch EVM/SNR estimation
+void autotest_estimate_evm_snr_qpsk()   { modem_test_estimate_evm_snr(LIQUID_MODEM_QPSK,   20.0f); }
+void autotest_estimate_evm_snr_qam16()  { modem_test_estimate_evm_snr(LIQUID_MODEM_QAM16,  20.0f); }
+void autotest_estimate_evm_snr_apsk32() { modem_test_estimate_evm_snr(LIQUID_MODEM_APSK32, 25.0f); }
@@ -128,3 +128,113 @@ void autotest_demodsoft_arb128opt() { modem_test_demodsoft(LIQUID_MODEM_ARB128OP
 void autotest_demodsoft_arb256opt() { modem_test_demodsoft(LIQUID_MODEM_ARB256OPT); }
 void autotest_demodsoft_arb64vt()   { modem_test_demodsoft(LIQUID_MODEM_ARB64VT);   }
 
+// Help function to keep code base small: demodulate an entire block
+// of modulated symbols at once and verify both the hard decisions and
+// the recovered soft bits
+void modem_test_demodsoft_block(modulation_scheme _ms)
+{
+    // generate mod/demod
+    modem mod   = modem_create(_ms);
+    modem demod = modem_create(_ms);
+
+    // 
+    unsigned int bps = modem_get_bps(demod);
+
+    // run the test
+    unsigned int i, M=1<<bps;
+    unsigned int sym_soft;
+    float complex x[M];
+    unsigned int s[M];
+    unsigned char soft_bits[M*bps];
+
+    // modulate every symbol in the constellation
+    for (i=0; i<M; i++)
+        modem_modulate(mod, i, &x[i]);
+
+    // demodulate block using soft-decision
+    modem_demodulate_soft_block(demod, x, M, s, soft_bits);
+
+    for (i=0; i<M; i++) {
+        // check hard-decision output
+        CONTEND_EQUALITY(s[i], i);
+
+        // check soft bits
+        liquid_pack_soft_bits(&soft_bits[i*bps], bps, &sym_soft);
+        CONTEND_EQUALITY(sym_soft, i);
+    }
+
+    // clean it up
+    modem_destroy(mod);
+    modem_destroy(demod);
+}
+
+// AUTOTESTS: batch soft demodulation
+void autotest_demodsoft_block_psk8()    { modem_test_demodsoft_block(LIQUID_MODEM_PSK8);    }
+void autotest_demodsoft_block_ask4()    { modem_test_demodsoft_block(LIQUID_MODEM_ASK4);    }
+void autotest_demodsoft_block_qam16()   { modem_test_demodsoft_block(LIQUID_MODEM_QAM16);   }
+void autotest_demodsoft_block_qam64()   { modem_test_demodsoft_block(LIQUID_MODEM_QAM64);   }
+void autotest_demodsoft_block_qam256()  { modem_test_demodsoft_block(LIQUID_MODEM_QAM256);  }
+void autotest_demodsoft_block_apsk32()  { modem_test_demodsoft_block(LIQUID_MODEM_APSK32);  }
+void autotest_demodsoft_block_bpsk()    { modem_test_demodsoft_block(LIQUID_MODEM_BPSK);    }
+void autotest_demodsoft_block_qpsk()    { modem_test_demodsoft_block(LIQUID_MODEM_QPSK);    }
+void autotest_demodsoft_block_sqam32()  { modem_test_demodsoft_block(LIQUID_MODEM_SQAM32);  }
+void autotest_demodsoft_block_arb64vt() { modem_test_demodsoft_block(LIQUID_MODEM_ARB64VT); }
+
+// verify quantized separable LLR table for square QAM against an
+// exhaustive max-log computation over the full constellation
+void autotest_demodsoft_qam_table()
+{
+    modulation_scheme ms = LIQUID_MODEM_QAM16;
+    modem mod   = modem_create(ms);
+    modem demod = modem_create(ms);
+
+    unsigned int bps = modem_get_bps(demod);
+    unsigned int i, j, k, M = 1 << bps;
+
+    // constellation points
+    float complex c[M];
+    for (i=0; i<M; i++)
+        modem_modulate(mod, i, &c[i]);
+
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    float gamma = 1.2f*M;
+
+    // test noisy samples around each constellation point
+    unsigned int num_trials = 20;
+    for (i=0; i<M; i++) {
+        for (j=0; j<num_trials; j++) {
+            float complex x = c[i] +
+                0.05f*(randnf() + _Complex_I*randnf());
+
+            // demodulate using soft-decision
+            unsigned int s;
+            unsigned char soft_bits[bps];
+            modem_demodulate_soft(demod, x, &s, soft_bits);
+
+            // compute reference: exhaustive max-log over constellation
+            for (k=0; k<bps; k++) {
+                float dmin_0 = 8.0f;
+                float dmin_1 = 8.0f;
+                unsigned int sym;
+                for (sym=0; sym<M; sym++) {
+                    float complex e = x - c[sym];
+                    float d = crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+                    if ((sym >> (bps-k-1)) & 0x01) {
+                        if (d < dmin_1) dmin_1 = d;
+                    } else {
+                        if (d < dmin_0) dmin_0 = d;
+                    }
+                }
+                int soft_ref = ((dmin_0 - dmin_1)*gamma)*16 + 127;
+                if (soft_ref > 255) soft_ref = 255;
+                if (soft_ref <   0) soft_ref = 0;
+
+                // allow small quantization error from the table
+                CONTEND_DELTA((float)soft_bits[k], (float)soft_ref, 16.0f);
+            }
+        }
+    }
+
+    modem_destroy(mod);
+    modem_destroy(demod);
+}
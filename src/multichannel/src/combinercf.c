@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// combinercf.c
+//
+// coherent multi-channel combiner: weighted sum of aligned input
+// streams with complex per-channel weights (beamforming/diversity
+// combining) and an optional LMS-style adaptive weight update
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+struct combinercf_s {
+    unsigned int    num_channels;   // number of input channels
+    float complex * w;              // channel weights [size: num_channels x 1]
+    float           mu;             // LMS learning rate
+};
+
+// create combiner object
+//  _num_channels   :   number of input channels
+combinercf combinercf_create(unsigned int _num_channels)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: combinercf_create(), number of channels must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate memory for main object
+    combinercf q = (combinercf) malloc(sizeof(struct combinercf_s));
+    q->num_channels = _num_channels;
+
+    // allocate memory for weights
+    q->w = (float complex*) malloc(q->num_channels*sizeof(float complex));
+
+    // set default learning rate
+    q->mu = 0.5f;
+
+    // reset and return main object
+    combinercf_reset(q);
+    return q;
+}
+
+// destroy combiner object, freeing all internal memory
+void combinercf_destroy(combinercf _q)
+{
+    free(_q->w);
+    free(_q);
+}
+
+// print combiner object internals
+void combinercf_print(combinercf _q)
+{
+    printf("combinercf: [%u channels]\n", _q->num_channels);
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        printf("  w[%3u] = %12.8f + j*%12.8f\n",
+                i, crealf(_q->w[i]), cimagf(_q->w[i]));
+    }
+}
+
+// reset combiner object, setting all weights to unity
+void combinercf_reset(combinercf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->w[i] = 1.0f;
+}
+
+// get number of input channels
+unsigned int combinercf_get_num_channels(combinercf _q)
+{
+    return _q->num_channels;
+}
+
+// set all channel weights
+//  _q  :   combiner object
+//  _w  :   weight vector [size: num_channels x 1]
+void combinercf_set_weights(combinercf      _q,
+                            float complex * _w)
+{
+    memmove(_q->w, _w, _q->num_channels*sizeof(float complex));
+}
+
+// set single channel weight
+//  _q          :   combiner object
+//  _channel    :   channel index
+//  _w          :   weight
+void combinercf_set_weight(combinercf    _q,
+                           unsigned int  _channel,
+                           float complex _w)
+{
+    // validate input
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: combinercf_set_weight(), channel index (%u) exceeds maximum (%u)\n",
+                _channel, _q->num_channels-1);
+        exit(1);
+    }
+
+    _q->w[_channel] = _w;
+}
+
+// get single channel weight
+float complex combinercf_get_weight(combinercf   _q,
+                                    unsigned int _channel)
+{
+    // validate input
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: combinercf_get_weight(), channel index (%u) exceeds maximum (%u)\n",
+                _channel, _q->num_channels-1);
+        exit(1);
+    }
+
+    return _q->w[_channel];
+}
+
+// set LMS learning rate
+void combinercf_set_bw(combinercf _q,
+                       float      _mu)
+{
+    // validate input
+    if (_mu < 0.0f) {
+        fprintf(stderr,"error: combinercf_set_bw(), learning rate must be positive\n");
+        exit(1);
+    }
+
+    _q->mu = _mu;
+}
+
+// get LMS learning rate
+float combinercf_get_bw(combinercf _q)
+{
+    return _q->mu;
+}
+
+// combine aligned channel blocks into weighted sum
+//  _q  :   combiner object
+//  _x  :   array of channel input pointers [size: num_channels x 1], each [size: _n x 1]
+//  _n  :   block size
+//  _y  :   combined output [size: _n x 1]
+void combinercf_execute(combinercf       _q,
+                        float complex ** _x,
+                        unsigned int     _n,
+                        float complex *  _y)
+{
+    unsigned int i;
+    unsigned int k;
+
+    // accumulate one channel at a time; each pass is a sequential
+    // scaled accumulation the compiler can vectorize, keeping the
+    // kernel memory-bandwidth bound
+    float complex w0 = _q->w[0];
+    float complex * x0 = _x[0];
+    for (k=0; k<_n; k++)
+        _y[k] = w0 * x0[k];
+
+    for (i=1; i<_q->num_channels; i++) {
+        float complex w  = _q->w[i];
+        float complex * x = _x[i];
+        for (k=0; k<_n; k++)
+            _y[k] += w * x[k];
+    }
+}
+
+// combine a single snapshot (one sample per channel)
+//  _q  :   combiner object
+//  _x  :   channel input samples [size: num_channels x 1]
+//  _y  :   combined output sample
+void combinercf_execute_snapshot(combinercf      _q,
+                                 float complex * _x,
+                                 float complex * _y)
+{
+    float complex y = 0;
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        y += _q->w[i] * _x[i];
+    *_y = y;
+}
+
+// adjust weights with one normalized LMS step toward a known reference
+// (training symbol or decision), computing the combined output first
+//  _q      :   combiner object
+//  _x      :   channel input samples [size: num_channels x 1]
+//  _d      :   desired (reference) output sample
+//  _d_hat  :   combined output sample (a priori)
+void combinercf_step(combinercf      _q,
+                     float complex * _x,
+                     float complex   _d,
+                     float complex * _d_hat)
+{
+    unsigned int i;
+
+    // compute combined output and input energy
+    float complex y  = 0;
+    float         x2 = 0;
+    for (i=0; i<_q->num_channels; i++) {
+        y  += _q->w[i] * _x[i];
+        x2 += crealf( _x[i]*conjf(_x[i]) );
+    }
+    *_d_hat = y;
+
+    // avoid division by zero on an empty snapshot
+    if (x2 < 1e-12f)
+        return;
+
+    // compute error (a priori) and update weighting vector
+    // w[n+1] = w[n] + mu*(d-d_hat)*conj(x[n])/(x[n]' * conj(x[n]))
+    float complex alpha = _d - y;
+    float         g     = _q->mu / x2;
+    for (i=0; i<_q->num_channels; i++)
+        _q->w[i] += g * alpha * conjf(_x[i]);
+}
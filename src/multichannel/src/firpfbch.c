@@ -52,6 +52,11 @@ struct FIRPFBCH(_s) {
     FFT_PLAN fft;               // fft|ifft object
     TO * x;                     // fft|ifft transform input array
     TO * X;                     // fft|ifft transform output array
+
+    // synthesizer occupancy tracking and pruned transform
+    TO * rot;                   // pruned IDFT phasor table [size: num_channels x 1]
+    unsigned int idle_steps;    // consecutive all-idle synthesis steps
+    unsigned int prune_thresh;  // max active channels for pruned transform
 };
 
 // 
@@ -134,6 +139,15 @@ FIRPFBCH() FIRPFBCH(_create)(int          _type,
     else
         q->fft = FFT_CREATE_PLAN(q->num_channels, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
+    // pre-compute phasor table for pruned synthesis transform and set
+    // active-channel threshold near the FFT/pruned-DFT break-even point
+    q->rot = (TO*) malloc((q->num_channels)*sizeof(TO));
+    for (i=0; i<q->num_channels; i++)
+        q->rot[i] = liquid_cexpjf(2.0f*M_PI*(float)i/(float)q->num_channels);
+    q->prune_thresh = 0;
+    while ((1U << q->prune_thresh) < q->num_channels)
+        q->prune_thresh++;
+
     // reset filterbank object
     FIRPFBCH(_reset)(q);
 
@@ -275,6 +289,7 @@ void FIRPFBCH(_destroy)(FIRPFBCH() _q)
     free(_q->h);
     free(_q->x);
     free(_q->X);
+    free(_q->rot);
 
     // free main object memory
     free(_q);
@@ -290,6 +305,9 @@ void FIRPFBCH(_reset)(FIRPFBCH() _q)
         _q->X[i] = 0;
     }
     _q->filter_index = _q->num_channels-1;
+
+    // filter state is empty: bank starts fully idle
+    _q->idle_steps = _q->p;
 }
 
 // print firpfbch object
@@ -317,11 +335,50 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,
 {
     unsigned int i;
 
-    // copy channelized symbols to transform input
-    memmove(_q->X, _x, _q->num_channels*sizeof(TI));
+    // count channels occupied this step
+    unsigned int num_active = 0;
+    for (i=0; i<_q->num_channels; i++) {
+        if (_x[i] != 0.0f)
+            num_active++;
+    }
 
-    // execute inverse DFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->fft);
+    if (num_active == 0) {
+        // all channels idle: once the filter state has drained, the
+        // output is identically zero and all filter work can be skipped
+        if (_q->idle_steps >= _q->p) {
+            for (i=0; i<_q->num_channels; i++)
+                _y[i] = 0;
+            return;
+        }
+        _q->idle_steps++;
+
+        // transform of all-zero input is zero; keep running the filter
+        // bank below until the buffered state drains
+        for (i=0; i<_q->num_channels; i++)
+            _q->x[i] = 0;
+    } else if (num_active < _q->prune_thresh) {
+        // sparsely-occupied input: run pruned inverse DFT over the
+        // active channels only, cost O(K M) versus O(M log M)
+        _q->idle_steps = 0;
+        unsigned int k;
+        for (i=0; i<_q->num_channels; i++)
+            _q->x[i] = 0;
+        for (k=0; k<_q->num_channels; k++) {
+            if (_x[k] == 0.0f)
+                continue;
+            for (i=0; i<_q->num_channels; i++)
+                _q->x[i] += _x[k] * _q->rot[(k*i) % _q->num_channels];
+        }
+    } else {
+        // densely-occupied input: run full inverse transform
+        _q->idle_steps = 0;
+
+        // copy channelized symbols to transform input
+        memmove(_q->X, _x, _q->num_channels*sizeof(TI));
+
+        // execute inverse DFT, store result in buffer 'x'
+        FFT_EXECUTE(_q->fft);
+    }
 
     // push samples into filter bank and execute
     T * r;      // read pointer
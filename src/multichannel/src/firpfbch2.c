@@ -50,11 +50,19 @@ struct FIRPFBCH2(_s) {
     TO * X;             // IFFT input array  [size: M x 1]
     TO * x;             // IFFT output array [size: M x 1]
 
+    // blocked execution scratch buffers (grow-only)
+    TO * X_block;               // batched IFFT input  [size: block_len x M]
+    TO * x_block;               // batched IFFT output [size: block_len x M]
+    unsigned int block_len;     // allocated number of steps
+
     // common data structures shared between analysis and
     // synthesis algorithms
     WINDOW() * w0;      // window buffer object array
     WINDOW() * w1;      // window buffer object array (synthesizer only)
     int flag;           // flag indicating filter/buffer alignment
+
+    // sample-clock metadata: M/2-sample frames processed since reset
+    uint64_t num_frames;
 };
 
 // create firpfbch2 object
@@ -114,6 +122,11 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
     q->x = (T*) malloc((q->M)*sizeof(T));   // IFFT output
     q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
+    // blocked execution scratch buffers allocated on first use
+    q->X_block   = NULL;
+    q->x_block   = NULL;
+    q->block_len = 0;
+
     // create buffer objects
     q->w0 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
     q->w1 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
@@ -196,7 +209,9 @@ void FIRPFBCH2(_destroy)(FIRPFBCH2() _q)
     FFT_DESTROY_PLAN(_q->ifft);
     free(_q->X);
     free(_q->x);
-    
+    free(_q->X_block);
+    free(_q->x_block);
+
     // free window objects (buffers)
     for (i=0; i<_q->M; i++) {
         WINDOW(_destroy)(_q->w0[i]);
@@ -222,6 +237,43 @@ void FIRPFBCH2(_reset)(FIRPFBCH2() _q)
 
     // reset filter/buffer alignment flag
     _q->flag = 0;
+
+    // reset frame counter
+    _q->num_frames = 0;
+}
+
+// get number of channels
+unsigned int FIRPFBCH2(_get_M)(FIRPFBCH2() _q)
+{
+    return _q->M;
+}
+
+// get channelizer type (e.g. LIQUID_ANALYZER)
+int FIRPFBCH2(_get_type)(FIRPFBCH2() _q)
+{
+    return _q->type;
+}
+
+// get number of M/2-sample frames processed since reset
+unsigned long long FIRPFBCH2(_get_num_frames)(FIRPFBCH2() _q)
+{
+    return _q->num_frames;
+}
+
+// get high-rate-side sample time of a given frame, measured in
+// (fractional) samples since reset and compensated for the prototype
+// filter group delay; for the analyzer this is the input sample to
+// which the frame's channel outputs correspond, for the synthesizer
+// the output sample to which the frame's channel inputs correspond
+//  _q      :   channelizer object
+//  _frame  :   frame index (counted from reset)
+double FIRPFBCH2(_get_frame_time)(FIRPFBCH2()        _q,
+                                  unsigned long long _frame)
+{
+    // each frame advances the high-rate side by M/2 samples; the
+    // prototype filter introduces a delay of M*m samples
+    return (double)(_frame + 1) * (double)(_q->M2) - 1.0
+         - (double)(_q->M * _q->m);
 }
 
 // print firpfbch2 object internals
@@ -277,8 +329,67 @@ void FIRPFBCH2(_execute_analyzer)(FIRPFBCH2() _q,
     for (i=0; i<_q->M; i++)
         _y[i] = _q->x[i] / (float)(_q->M);
 
-    // update flag
+    // update flag and frame counter
     _q->flag = 1 - _q->flag;
+    _q->num_frames++;
+}
+
+// execute analysis filterbank channelizer over multiple steps, writing
+// each channel's output into its own contiguous stream (no interleaved
+// intermediate buffer)
+//  _x      :   channelizer input,  [size: _n*M/2 x 1]
+//  _y      :   array of M channel output buffers, each [size: _n x 1]
+//  _n      :   number of M/2-sample input steps
+void FIRPFBCH2(_execute_planar)(FIRPFBCH2()  _q,
+                                TI *         _x,
+                                TO **        _y,
+                                unsigned int _n)
+{
+    // validate type
+    if (_q->type != LIQUID_ANALYZER) {
+        fprintf(stderr,"error: firpfbch2_%s_execute_planar(), invalid type (analyzer only)\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int n;
+    float g = 1.0f / (float)(_q->M);
+    for (n=0; n<_n; n++) {
+        // load buffers in blocks of num_channels/2 starting
+        // in the middle of the filter bank and moving in the
+        // negative direction
+        unsigned int base_index = _q->flag ? _q->M : _q->M2;
+        for (i=0; i<_q->M2; i++) {
+            // push sample into buffer at filter index
+            WINDOW(_push)(_q->w0[base_index-i-1], _x[n*_q->M2 + i]);
+        }
+
+        // execute filter outputs
+        unsigned int offset = _q->flag ? _q->M2 : 0;
+        TI * r;      // buffer read pointer
+        for (i=0; i<_q->M; i++) {
+            // compute buffer index
+            unsigned int buffer_index  = (offset+i)%(_q->M);
+
+            // read buffer at index
+            WINDOW(_read)(_q->w0[buffer_index], &r);
+
+            // run dot product storing result in IFFT input buffer
+            DOTPROD(_execute)(_q->dp[i], r, &_q->X[buffer_index]);
+        }
+
+        // execute IFFT, store result in buffer 'x'
+        FFT_EXECUTE(_q->ifft);
+
+        // scatter scaled transform output directly into the
+        // per-channel streams
+        for (i=0; i<_q->M; i++)
+            _y[i][n] = _q->x[i] * g;
+
+        // update flag and frame counter
+        _q->flag = 1 - _q->flag;
+        _q->num_frames++;
+    }
 }
 
 // execute filterbank channelizer (synthesizer)
@@ -332,6 +443,111 @@ void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2() _q,
         _y[i] = y0 + y1;
     }
     _q->flag = 1 - _q->flag;
+    _q->num_frames++;
+}
+
+// execute filterbank channelizer over a block of steps in a single
+// call, batching the inverse transforms so the plan's internal tables
+// stay resident in cache across steps
+// LIQUID_ANALYZER:     input: _n*M/2, output: _n*M
+// LIQUID_SYNTHESIZER:  input: _n*M,   output: _n*M/2
+//  _x      :   channelizer input
+//  _n      :   number of steps
+//  _y      :   channelizer output
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int i;
+    unsigned int n;
+
+    // grow internal scratch transform buffers as needed
+    if (_n > _q->block_len) {
+        _q->X_block = (TO*) realloc(_q->X_block, (_n * _q->M)*sizeof(TO));
+        _q->x_block = (TO*) realloc(_q->x_block, (_n * _q->M)*sizeof(TO));
+        _q->block_len = _n;
+    }
+
+    if (_q->type == LIQUID_SYNTHESIZER) {
+        // batch the inverse transforms up front...
+        FFT_EXECUTE_BATCH(_q->ifft, _n, _x, _q->M, _q->x_block, _q->M);
+
+        // ...then run the output filter stages one step at a time
+        float g = (float)(_q->M2) / (float)(_q->M);
+        for (n=0; n<_n; n++) {
+            TO * xb = &_q->x_block[n*_q->M];
+
+            // push scaled samples into appropriate buffer
+            WINDOW() * buffer = (_q->flag == 0 ? _q->w1 : _q->w0);
+            for (i=0; i<_q->M; i++)
+                WINDOW(_push)(buffer[i], xb[i]*g);
+
+            // compute filter outputs
+            TO * r0, * r1;  // buffer read pointers
+            TO   y0,   y1;  // dotprod outputs
+            for (i=0; i<_q->M2; i++) {
+                // buffer index
+                unsigned int b = (_q->flag == 0) ? i : i+_q->M2;
+
+                // read buffer with index offset
+                WINDOW(_read)(_q->w0[b], &r0);
+                WINDOW(_read)(_q->w1[b], &r1);
+
+                // swap buffer outputs on alternating runs
+                TO * p0 = _q->flag ? r0 : r1;
+                TO * p1 = _q->flag ? r1 : r0;
+
+                // run dot products
+                DOTPROD(_execute)(_q->dp[i],        p0, &y0);
+                DOTPROD(_execute)(_q->dp[i+_q->M2], p1, &y1);
+
+                // save output
+                _y[n*_q->M2 + i] = y0 + y1;
+            }
+            _q->flag = 1 - _q->flag;
+            _q->num_frames++;
+        }
+        return;
+    }
+
+    // analyzer: run window/dotprod stages for all steps, filling the
+    // batched transform input
+    for (n=0; n<_n; n++) {
+        // load buffers in blocks of num_channels/2 starting
+        // in the middle of the filter bank and moving in the
+        // negative direction
+        unsigned int base_index = _q->flag ? _q->M : _q->M2;
+        for (i=0; i<_q->M2; i++) {
+            // push sample into buffer at filter index
+            WINDOW(_push)(_q->w0[base_index-i-1], _x[n*_q->M2 + i]);
+        }
+
+        // execute filter outputs
+        unsigned int offset = _q->flag ? _q->M2 : 0;
+        TI * r;      // buffer read pointer
+        for (i=0; i<_q->M; i++) {
+            // compute buffer index
+            unsigned int buffer_index  = (offset+i)%(_q->M);
+
+            // read buffer at index
+            WINDOW(_read)(_q->w0[buffer_index], &r);
+
+            // run dot product storing result in batched IFFT input
+            DOTPROD(_execute)(_q->dp[i], r, &_q->X_block[n*_q->M + buffer_index]);
+        }
+
+        // update flag and frame counter
+        _q->flag = 1 - _q->flag;
+        _q->num_frames++;
+    }
+
+    // run batched inverse transforms
+    FFT_EXECUTE_BATCH(_q->ifft, _n, _q->X_block, _q->M, _q->x_block, _q->M);
+
+    // scale result by 1/num_channels (C transform)
+    for (i=0; i<_n*_q->M; i++)
+        _y[i] = _q->x_block[i] / (float)(_q->M);
 }
 
 // execute filterbank channelizer
@@ -344,12 +560,18 @@ void FIRPFBCH2(_execute)(FIRPFBCH2() _q,
                          TO *        _y)
 {
     switch (_q->type) {
-    case LIQUID_ANALYZER:
+    case LIQUID_ANALYZER: {
+        LIQUID_PROFILE_BEGIN(FIRPFBCH2_ANALYZER);
         FIRPFBCH2(_execute_analyzer)(_q, _x, _y);
+        LIQUID_PROFILE_END(FIRPFBCH2_ANALYZER);
         return;
-    case LIQUID_SYNTHESIZER:
+    }
+    case LIQUID_SYNTHESIZER: {
+        LIQUID_PROFILE_BEGIN(FIRPFBCH2_SYNTHESIZER);
         FIRPFBCH2(_execute_synthesizer)(_q, _x, _y);
+        LIQUID_PROFILE_END(FIRPFBCH2_SYNTHESIZER);
         return;
+    }
     default:
         fprintf(stderr,"error: firpfbch2_%s_execute(), invalid type\n", EXTENSION_FULL);
         exit(1);
@@ -135,6 +135,23 @@ ofdmframegen ofdmframegen_create(unsigned int    _M,
     // allocate memory for transform objects
     q->X = (float complex*) malloc((q->M)*sizeof(float complex));
     q->x = (float complex*) malloc((q->M)*sizeof(float complex));
+#if FFT_HAVE_PLAN_PRUNED
+    if ( 4*(q->M_pilot + q->M_data) <= q->M ) {
+        // sparse allocation (narrowband-in-wideband): prune the inverse
+        // transform to the occupied subcarriers so symbol generation
+        // cost scales with the number of enabled carriers rather than
+        // the transform size
+        unsigned int * occupied = (unsigned int*) malloc((q->M_pilot + q->M_data)*sizeof(unsigned int));
+        unsigned int num_occupied = 0;
+        for (i=0; i<q->M; i++) {
+            if (q->p[i] != OFDMFRAME_SCTYPE_NULL)
+                occupied[num_occupied++] = i;
+        }
+        q->ifft = FFT_CREATE_PLAN_PRUNED(q->M, q->X, q->x, FFT_DIR_BACKWARD,
+                                         occupied, num_occupied, FFT_METHOD);
+        free(occupied);
+    } else
+#endif
     q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
     // allocate memory for PLCP arrays
@@ -280,7 +297,12 @@ void ofdmframegen_writesymbol(ofdmframegen    _q,
                               float complex * _x,
                               float complex * _y)
 {
-    // move frequency data to internal buffer
+    // move frequency data to internal buffer, applying gain to all
+    // subcarriers with a vectorized scalar multiply
+    liquid_vectorcf_mulscalar(_x, _q->M, _q->g_data, _q->X);
+
+    // overwrite null and pilot subcarriers, advancing the pilot
+    // sequence in fftshifted subcarrier order
     unsigned int i;
     unsigned int k;
     int sctype;
@@ -295,12 +317,7 @@ void ofdmframegen_writesymbol(ofdmframegen    _q,
         } else if (sctype==OFDMFRAME_SCTYPE_PILOT) {
             // pilot subcarrier
             _q->X[k] = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f) * _q->g_data;
-        } else {
-            // data subcarrier
-            _q->X[k] = _x[k] * _q->g_data;
         }
-
-        //printf("X[%3u] = %12.8f + j*%12.8f;\n",i+1,crealf(_q->X[i]),cimagf(_q->X[i]));
     }
 
     // execute transform
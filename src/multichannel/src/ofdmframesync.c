@@ -78,7 +78,13 @@ struct ofdmframesync_s {
     float complex * G1;     // complex subcarrier gain estimate, S1
     float complex * G;      // complex subcarrier gain estimate
     float complex * B;      // subcarrier phase rotation due to backoff
-    float complex * R;      // 
+    float complex * R;      //
+
+    // pre-computed subcarrier tables, shared across received symbols
+    unsigned int * pilot_ind;   // pilot subcarrier indices (fftshift order)
+    float * sc_fx;              // subcarrier frequency index, [-M/2, M/2)
+    float * sc_theta;           // scratch: per-subcarrier phase correction
+    float complex * sc_rot;     // scratch: per-subcarrier phase rotation
 
     // receiver state
     enum {
@@ -105,6 +111,7 @@ struct ofdmframesync_s {
     unsigned int timer;         // input sample timer
     unsigned int num_symbols;   // symbol counter
     unsigned int backoff;       // sample timing backoff
+    int primed;                 // acquisition primed with external timing?
     float complex s_hat_0;      // first S0 symbol metrics estimate
     float complex s_hat_1;      // second S0 symbol metrics estimate
 
@@ -227,6 +234,23 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     for (i=0; i<q->M; i++)
         q->B[i] = liquid_cexpjf(i*phi);
 
+    // pre-compute subcarrier tables so each received symbol shares the
+    // same loop set-up (indices, frequency values)
+    q->pilot_ind = (unsigned int*)   malloc((q->M_pilot)*sizeof(unsigned int));
+    q->sc_fx     = (float*)          malloc((q->M)*sizeof(float));
+    q->sc_theta  = (float*)          malloc((q->M)*sizeof(float));
+    q->sc_rot    = (float complex*)  malloc((q->M)*sizeof(float complex));
+    unsigned int n=0;
+    for (i=0; i<q->M; i++) {
+        // subcarrier frequency index
+        q->sc_fx[i] = (i > q->M2) ? (float)i - (float)(q->M) : (float)i;
+
+        // gather pilot indices starting at mid-point (effective fftshift)
+        unsigned int k = (i + q->M2) % q->M;
+        if (q->p[k] == OFDMFRAME_SCTYPE_PILOT)
+            q->pilot_ind[n++] = k;
+    }
+
     // set callback data
     q->callback = _callback;
     q->userdata = _userdata;
@@ -306,6 +330,12 @@ void ofdmframesync_destroy(ofdmframesync _q)
     free(_q->B);
     free(_q->R);
 
+    // free pre-computed subcarrier tables
+    free(_q->pilot_ind);
+    free(_q->sc_fx);
+    free(_q->sc_theta);
+    free(_q->sc_rot);
+
     // destroy synchronizer objects
     nco_crcf_destroy(_q->nco_rx);           // numerically-controlled oscillator
     msequence_destroy(_q->ms_pilot);
@@ -348,6 +378,7 @@ void ofdmframesync_reset(ofdmframesync _q)
     _q->plcp_sync_thresh   = (_q->M > 44) ? 0.30f : 0.30f + 0.01f*(44 - _q->M);
 
     // reset state
+    _q->primed = 0;
     _q->state = OFDMFRAMESYNC_STATE_SEEKPLCP;
 }
 
@@ -421,6 +452,36 @@ void ofdmframesync_set_cfo(ofdmframesync _q, float _cfo)
     nco_crcf_set_frequency(_q->nco_rx, _cfo);
 }
 
+// prime acquisition with externally-supplied burst timing (e.g. from
+// a TDMA schedule), skipping the autocorrelation-based plateau search
+// and S0 processing and starting directly in fine synchronization on
+// the S1 sequence; if the S1 sequence is not found near the hinted
+// position the synchronizer falls back to full acquisition
+//  _q           : synchronizer object
+//  _timing_hint : number of samples before the start of the frame
+//                 (first S0 cyclic-prefix sample), accurate to within
+//                 a few samples
+//  _cfo_hint    : carrier frequency offset estimate (f/Fs)
+void ofdmframesync_prime(ofdmframesync _q,
+                         unsigned int  _timing_hint,
+                         float         _cfo_hint)
+{
+    // clear any in-progress acquisition
+    ofdmframesync_reset(_q);
+
+    // apply carrier frequency offset hint (normally estimated from
+    // the repeated S0 sequence)
+    nco_crcf_set_frequency(_q->nco_rx, _cfo_hint);
+
+    // set timer to expire when the S1 symbol (less timing backoff) is
+    // aligned in the input buffer: the frame starts with two S0
+    // symbols of M + cp_len samples each, followed by the S1 cyclic
+    // prefix
+    _q->timer = _timing_hint + 2*(_q->M + _q->cp_len) + _q->cp_len + _q->M - _q->backoff;
+    _q->primed = 1;
+    _q->state = OFDMFRAMESYNC_STATE_PLCPLONG;
+}
+
 //
 // internal methods
 //
@@ -644,6 +705,17 @@ void ofdmframesync_execute_S1(ofdmframesync _q)
     float complex * rc;
     windowcf_read(_q->input_buffer, &rc);
 
+    // primed acquisition skipped the plateau search: estimate the
+    // nominal gain from the buffered S1 symbol instead
+    if (_q->primed) {
+        unsigned int k;
+        float g = 0.0f;
+        for (k=_q->cp_len; k<_q->M + _q->cp_len; k++)
+            g += crealf(rc[k])*crealf(rc[k]) + cimagf(rc[k])*cimagf(rc[k]);
+        _q->g0 = (float)(_q->M) / g;
+        _q->primed = 0;
+    }
+
     // estimate S1 gain
     // TODO : add backoff in gain estimation
     ofdmframesync_estimate_gain_S1(_q, &rc[_q->cp_len], _q->G);
@@ -973,14 +1045,19 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
     polyf_fit(x_freq, y_abs, N, p_abs, _order+1);
     polyf_fit(x_freq, y_arg, N, p_arg, _order+1);
 
-    // compute subcarrier gain
+    // compute subcarrier gain, evaluating polynomials at all
+    // subcarrier frequencies as a block
+    float freq[_q->M];
+    float A[_q->M];
+    float theta[_q->M];
     for (i=0; i<_q->M; i++) {
-        float freq = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-        freq = freq / (float)(_q->M);
-        float A     = polyf_val(p_abs, _order+1, freq);
-        float theta = polyf_val(p_arg, _order+1, freq);
-        _q->G[i] = (_q->p[i] == OFDMFRAME_SCTYPE_NULL) ? 0.0f : A * liquid_cexpjf(theta);
+        freq[i] = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
+        freq[i] = freq[i] / (float)(_q->M);
     }
+    polyf_vals(p_abs, _order+1, freq, _q->M, A);
+    polyf_vals(p_arg, _order+1, freq, _q->M, theta);
+    for (i=0; i<_q->M; i++)
+        _q->G[i] = (_q->p[i] == OFDMFRAME_SCTYPE_NULL) ? 0.0f : A[i] * liquid_cexpjf(theta[i]);
 
 #if 0
     for (i=0; i<N; i++)
@@ -999,49 +1076,32 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 void ofdmframesync_rxsymbol(ofdmframesync _q)
 {
-    // apply gain
+    // apply equalizer gain to all subcarriers at once
     unsigned int i;
-    for (i=0; i<_q->M; i++)
-        _q->X[i] *= _q->R[i];
+    liquid_vectorcf_mul(_q->X, _q->R, _q->M, _q->X);
 
     // polynomial curve-fit
     float x_phase[_q->M_pilot];
     float y_phase[_q->M_pilot];
     float p_phase[2];
 
-    unsigned int n=0;
     unsigned int k;
     float complex pilot = 1.0f;
-    for (i=0; i<_q->M; i++) {
+    for (i=0; i<_q->M_pilot; i++) {
 
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M2) % _q->M;
+        // pilot indices gathered in fftshift order at create()
+        k = _q->pilot_ind[i];
 
-        if (_q->p[k]==OFDMFRAME_SCTYPE_PILOT) {
-            if (n == _q->M_pilot) {
-                fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-                return;
-            }
-            pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
+        pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
 #if 0
-            printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
-                    k,
-                    crealf(_q->X[k]), cimagf(_q->X[k]),
-                    crealf(pilot),    cimagf(pilot));
+        printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
+                k,
+                crealf(_q->X[k]), cimagf(_q->X[k]),
+                crealf(pilot),    cimagf(pilot));
 #endif
-            // store resulting...
-            x_phase[n] = (k > _q->M2) ? (float)k - (float)(_q->M) : (float)k;
-            y_phase[n] = cargf(_q->X[k]*conjf(pilot));
-
-            // update counter
-            n++;
-
-        }
-    }
-
-    if (n != _q->M_pilot) {
-        fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-        return;
+        // store resulting...
+        x_phase[i] = _q->sc_fx[k];
+        y_phase[i] = cargf(_q->X[k]*conjf(pilot));
     }
 
     // try to unwrap phase
@@ -1075,17 +1135,18 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 #endif
 
-    // compensate for phase offset
-    // TODO : find more computationally efficient way to do this
+    // compensate for phase offset: evaluate the polynomial at each
+    // subcarrier frequency and apply the complex rotation as a single
+    // vector operation
+    for (i=0; i<_q->M; i++)
+        _q->sc_theta[i] = -(p_phase[0] + p_phase[1]*_q->sc_fx[i]);
+    liquid_vectorcf_cexpj(_q->sc_theta, _q->M, _q->sc_rot);
+    liquid_vectorcf_mul(_q->X, _q->sc_rot, _q->M, _q->X);
+
+    // clear null subcarriers
     for (i=0; i<_q->M; i++) {
-        // only apply to data/pilot subcarriers
-        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL) {
+        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL)
             _q->X[i] = 0.0f;
-        } else {
-            float fx    = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-            float theta = polyf_val(p_phase, 2, fx);
-            _q->X[i] *= liquid_cexpjf(-theta);
-        }
     }
 
     // adjust NCO frequency based on differential phase
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// block combining matches an explicit weighted sum
+void autotest_combinercf_static()
+{
+    unsigned int num_channels = 8;
+    unsigned int n            = 96;
+    float        tol          = 1e-5f;
+    unsigned int i;
+    unsigned int k;
+
+    // create combiner and set random weights
+    combinercf q = combinercf_create(num_channels);
+    CONTEND_EQUALITY( combinercf_get_num_channels(q), num_channels );
+    float complex w[num_channels];
+    for (i=0; i<num_channels; i++) {
+        w[i] = randnf() + _Complex_I*randnf();
+        combinercf_set_weight(q, i, w[i]);
+        CONTEND_DELTA( crealf(combinercf_get_weight(q,i)), crealf(w[i]), tol );
+        CONTEND_DELTA( cimagf(combinercf_get_weight(q,i)), cimagf(w[i]), tol );
+    }
+
+    // generate aligned channel blocks
+    float complex   buf[num_channels][n];
+    float complex * x  [num_channels];
+    for (i=0; i<num_channels; i++) {
+        x[i] = buf[i];
+        for (k=0; k<n; k++)
+            buf[i][k] = randnf() + _Complex_I*randnf();
+    }
+
+    // combine and compare to explicit sum
+    float complex y[n];
+    combinercf_execute(q, x, n, y);
+    for (k=0; k<n; k++) {
+        float complex y_ref = 0;
+        for (i=0; i<num_channels; i++)
+            y_ref += w[i]*buf[i][k];
+        CONTEND_DELTA( crealf(y[k]), crealf(y_ref), tol );
+        CONTEND_DELTA( cimagf(y[k]), cimagf(y_ref), tol );
+    }
+
+    // snapshot path matches block path
+    float complex x0[num_channels];
+    for (i=0; i<num_channels; i++)
+        x0[i] = buf[i][0];
+    float complex y0;
+    combinercf_execute_snapshot(q, x0, &y0);
+    CONTEND_DELTA( crealf(y0), crealf(y[0]), tol );
+    CONTEND_DELTA( cimagf(y0), cimagf(y[0]), tol );
+
+    combinercf_destroy(q);
+}
+
+// adaptive combining converges onto a steering vector: each channel
+// receives the same QPSK sequence with a fixed phase/gain offset and
+// the LMS update drives the combined output toward the reference
+void autotest_combinercf_adapt()
+{
+    unsigned int num_channels = 4;
+    unsigned int num_symbols  = 800;
+    float        nstd         = 0.01f;
+    unsigned int i;
+    unsigned int k;
+
+    // per-channel gain and phase (steering vector to invert)
+    float complex steer[4] = {
+         0.8f*cexpf(_Complex_I*0.3f),
+         1.1f*cexpf(_Complex_I*2.1f),
+         0.6f*cexpf(_Complex_I*-1.7f),
+         0.9f*cexpf(_Complex_I*0.9f)};
+
+    combinercf q = combinercf_create(num_channels);
+    combinercf_set_bw(q, 0.2f);
+    modem mod = modem_create(LIQUID_MODEM_QPSK);
+
+    float rmse = 0.0f;
+    for (k=0; k<num_symbols; k++) {
+        // modulate reference symbol and generate channel snapshot
+        float complex d;
+        modem_modulate(mod, modem_gen_rand_sym(mod), &d);
+        float complex x[num_channels];
+        for (i=0; i<num_channels; i++)
+            x[i] = d*steer[i] + nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+
+        // run combiner update with known reference
+        float complex d_hat;
+        combinercf_step(q, x, d, &d_hat);
+
+        // accumulate error over the last quarter of the run
+        if (k >= 3*num_symbols/4) {
+            float complex e = d - d_hat;
+            rmse += crealf( e*conjf(e) );
+        }
+    }
+    rmse = sqrtf( rmse / (float)(num_symbols/4) );
+    if (liquid_autotest_verbose) {
+        combinercf_print(q);
+        printf("  rmse : %12.8f\n", rmse);
+    }
+
+    // verify convergence
+    CONTEND_LESS_THAN( rmse, 0.05f );
+
+    combinercf_destroy(q);
+    modem_destroy(mod);
+}
@@ -97,3 +97,174 @@ void autotest_firpfbch2_crcf_n16()   { firpfbch2_crcf_runtest(  16, 5, 60.0f); }
 void autotest_firpfbch2_crcf_n32()   { firpfbch2_crcf_runtest(  32, 5, 60.0f); }
 void autotest_firpfbch2_crcf_n64()   { firpfbch2_crcf_runtest(  64, 5, 60.0f); }
 
+
+// AUTOTEST : verify planar (per-channel stream) analysis output matches
+//            the interleaved per-step output
+void autotest_firpfbch2_crcf_planar()
+{
+    float tol = 1e-6f;
+    unsigned int M = 16;    // number of channels
+    unsigned int m =  5;    // filter semi-length
+    unsigned int i;
+    unsigned int j;
+
+    // derived values
+    unsigned int num_steps   = 40;
+    unsigned int num_samples = num_steps * M/2;
+
+    // allocate arrays
+    float complex x[num_samples];
+    float complex Y[M];
+
+    // generate pseudo-random sequence
+    unsigned int s = 1;         // seed
+    unsigned int p = 524287;    // large prime number
+    unsigned int g =   1031;    // another large prime number
+    for (i=0; i<num_samples; i++) {
+        s = (s * p) % g;
+        x[i] = (float)s / (float)g - 0.5f;
+    }
+
+    // create two identical analysis filterbank objects
+    firpfbch2_crcf q0 = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, m, 60.0f);
+    firpfbch2_crcf q1 = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, m, 60.0f);
+
+    // allocate per-channel stream buffers
+    float complex   y_planar[M][num_steps];
+    float complex * y[M];
+    for (i=0; i<M; i++)
+        y[i] = y_planar[i];
+
+    // run planar channelizer over all steps in a single call
+    firpfbch2_crcf_execute_planar(q0, x, y, num_steps);
+
+    // run reference channelizer one step at a time and compare
+    for (j=0; j<num_steps; j++) {
+        firpfbch2_crcf_execute(q1, &x[j*M/2], Y);
+
+        for (i=0; i<M; i++) {
+            CONTEND_DELTA( crealf(y[i][j]), crealf(Y[i]), tol );
+            CONTEND_DELTA( cimagf(y[i][j]), cimagf(Y[i]), tol );
+        }
+    }
+
+    // destroy filterbank objects
+    firpfbch2_crcf_destroy(q0);
+    firpfbch2_crcf_destroy(q1);
+}
+
+// AUTOTEST : verify blocked multi-step execution matches the per-step
+//            output for both analysis and synthesis types
+void autotest_firpfbch2_crcf_block()
+{
+    float tol = 1e-6f;
+    unsigned int M = 16;    // number of channels
+    unsigned int m =  5;    // filter semi-length
+    unsigned int i;
+    unsigned int j;
+
+    // derived values
+    unsigned int num_steps = 40;
+
+    // generate pseudo-random sequence (analyzer input)
+    unsigned int num_samples = num_steps * M/2;
+    float complex x[num_samples];
+    unsigned int s = 1;         // seed
+    unsigned int p = 524287;    // large prime number
+    unsigned int g =   1031;    // another large prime number
+    for (i=0; i<num_samples; i++) {
+        s = (s * p) % g;
+        x[i] = (float)s / (float)g - 0.5f;
+    }
+
+    // create two identical analysis filterbank objects
+    firpfbch2_crcf qa0 = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, m, 60.0f);
+    firpfbch2_crcf qa1 = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, m, 60.0f);
+
+    // run blocked analyzer in a single call; reference one step at a time
+    float complex Y_block[num_steps*M];
+    float complex Y      [num_steps*M];
+    firpfbch2_crcf_execute_block(qa0, x, num_steps, Y_block);
+    for (j=0; j<num_steps; j++)
+        firpfbch2_crcf_execute(qa1, &x[j*M/2], &Y[j*M]);
+
+    for (i=0; i<num_steps*M; i++) {
+        CONTEND_DELTA( crealf(Y_block[i]), crealf(Y[i]), tol );
+        CONTEND_DELTA( cimagf(Y_block[i]), cimagf(Y[i]), tol );
+    }
+
+    // create two identical synthesis filterbank objects and run the
+    // analyzer output back through them
+    firpfbch2_crcf qs0 = firpfbch2_crcf_create_kaiser(LIQUID_SYNTHESIZER, M, m, 60.0f);
+    firpfbch2_crcf qs1 = firpfbch2_crcf_create_kaiser(LIQUID_SYNTHESIZER, M, m, 60.0f);
+
+    float complex y_block[num_samples];
+    float complex y      [num_samples];
+    firpfbch2_crcf_execute_block(qs0, Y, num_steps, y_block);
+    for (j=0; j<num_steps; j++)
+        firpfbch2_crcf_execute(qs1, &Y[j*M], &y[j*M/2]);
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y_block[i]), crealf(y[i]), tol );
+        CONTEND_DELTA( cimagf(y_block[i]), cimagf(y[i]), tol );
+    }
+
+    // destroy filterbank objects
+    firpfbch2_crcf_destroy(qa0);
+    firpfbch2_crcf_destroy(qa1);
+    firpfbch2_crcf_destroy(qs0);
+    firpfbch2_crcf_destroy(qs1);
+}
+
+//
+// AUTOTEST : frame-time query maps an impulse back to its input sample
+//            index through the analysis filterbank
+//
+void autotest_firpfbch2_crcf_frame_time()
+{
+    unsigned int M = 16;    // number of channels
+    unsigned int m =  4;    // filter semi-length
+    unsigned int num_frames = 64;
+    unsigned int n0 = 200;  // input sample index of impulse
+    unsigned int i, j;
+
+    // create analysis channelizer
+    firpfbch2_crcf q = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, M, m, 60.0f);
+
+    // push an impulse through the channelizer, locating the frame with
+    // the greatest total output energy
+    float complex x[M/2];
+    float complex Y[M];
+    unsigned int frame_peak = 0;
+    float        energy_peak = 0.0f;
+    for (j=0; j<num_frames; j++) {
+        for (i=0; i<M/2; i++)
+            x[i] = (j*M/2 + i)==n0 ? 1.0f : 0.0f;
+        firpfbch2_crcf_execute(q, x, Y);
+
+        float energy = 0.0f;
+        for (i=0; i<M; i++)
+            energy += crealf( Y[i]*conjf(Y[i]) );
+        if (energy > energy_peak) {
+            energy_peak = energy;
+            frame_peak  = j;
+        }
+    }
+
+    if (liquid_autotest_verbose) {
+        printf("firpfbch2_crcf_frame_time: t(peak frame)=%f (expected %u)\n",
+                firpfbch2_crcf_get_frame_time(q, frame_peak), n0);
+    }
+
+    // frame counter matches the number of frames processed
+    CONTEND_EQUALITY( firpfbch2_crcf_get_num_frames(q), (unsigned long long)num_frames );
+
+    // peak frame maps back to the impulse's input index within half a
+    // frame spacing (plus one sample)
+    CONTEND_DELTA( (float)firpfbch2_crcf_get_frame_time(q, frame_peak),
+                   (float)n0,
+                   (float)(M/2)/2.0f + 1.0f );
+
+    // destroy channelizer object
+    firpfbch2_crcf_destroy(q);
+}
@@ -143,3 +143,118 @@ void autotest_firpfbch_crcf_synthesis()
     }
 }
 
+
+//
+// AUTOTEST: validate synthesis correctness with sparsely-occupied
+//           channels (pruned transform) and idle periods (drained
+//           filter state)
+//
+void autotest_firpfbch_crcf_synthesis_sparse()
+{
+    // options
+    float tol = 5e-4f;              // error tolerance (reference
+                                    // up-converter accumulates more
+                                    // rounding error over 16 channels)
+    unsigned int num_channels=16;   // number of channels
+    unsigned int p=5;               // filter length (symbols)
+    unsigned int num_symbols=40;    // number of symbols
+
+    // derived values
+    unsigned int num_samples = num_channels * num_symbols;
+
+    unsigned int i;
+    unsigned int j;
+
+    // generate filter from pseudo-random m-sequence values
+    unsigned int h_len = p*num_channels;
+    float h[h_len];
+    msequence ms = msequence_create_default(6);
+    for (i=0; i<h_len; i++)
+        h[i] = (float)msequence_generate_symbol(ms, 2) - 1.5f; // (-1.5, -0.5, 0.5, 1.5)
+    msequence_destroy(ms);
+
+    // create filter object
+    firfilt_crcf f = firfilt_crcf_create(h, h_len);
+
+    // create filterbank channelizer object
+    firpfbch_crcf q = firpfbch_crcf_create(LIQUID_SYNTHESIZER, num_channels, p, h);
+
+    float complex Y[num_symbols][num_channels];     // channelized input
+    float complex y0[num_samples];                  // time-domain output
+    float complex y1[num_samples];                  // time-domain output
+
+    // generate input sequence: two occupied channels, an all-idle gap,
+    // a densely-occupied block, then sparse again
+    ms = msequence_create_default(7);
+    for (i=0; i<num_symbols; i++) {
+        for (j=0; j<num_channels; j++) {
+            int occupied;
+            if (i < 10)         occupied = (j==1 || j==11);  // sparse
+            else if (i < 20)    occupied = 0;                // idle
+            else if (i < 30)    occupied = 1;                // dense
+            else                occupied = (j==1 || j==11);  // sparse
+
+            float complex v =
+                0.1f * M_SQRT1_2 * ((float)msequence_generate_symbol(ms,2) - 1.5f) +
+                0.1f * M_SQRT1_2 * ((float)msequence_generate_symbol(ms,2) - 1.5f)*_Complex_I;
+            Y[i][j] = occupied ? v : 0.0f;
+        }
+    }
+    msequence_destroy(ms);
+
+    // 
+    // run synthesis filter bank
+    //
+
+    for (i=0; i<num_symbols; i++)
+        firpfbch_crcf_synthesizer_execute(q, &Y[i][0], &y0[i*num_channels]);
+
+    // 
+    // run traditional up-converter (inefficient)
+    //
+
+    // clear output array
+    for (i=0; i<num_samples; i++)
+        y1[i] = 0.0f;
+
+    unsigned int n;
+    float dphi; // carrier frequency
+    float complex y_hat;
+    for (i=0; i<num_channels; i++) {
+        // reset filter
+        firfilt_crcf_reset(f);
+
+        // set center frequency
+        dphi = 2.0f * M_PI * (float)i / (float)num_channels;
+
+        // reset input symbol counter
+        n=0;
+
+        for (j=0; j<num_samples; j++) {
+
+            // interpolate sequence
+            if ( (j%num_channels)==0 ) {
+                assert(n<num_symbols);
+                firfilt_crcf_push(f, Y[n][i]);
+                n++;
+            } else {
+                firfilt_crcf_push(f, 0);
+            }
+            firfilt_crcf_execute(f, &y_hat);
+
+            // accumulate up-converted sample
+            y1[j] += y_hat * cexpf(_Complex_I*j*dphi);
+        }
+        assert(n==num_symbols);
+    }
+
+    // compare results
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects
+    firfilt_crcf_destroy(f);
+    firpfbch_crcf_destroy(q);
+}
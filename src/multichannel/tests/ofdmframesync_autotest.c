@@ -143,3 +143,170 @@ void autotest_ofdmframesync_acquire_n128()  { ofdmframesync_acquire_test(128, 16
 void autotest_ofdmframesync_acquire_n256()  { ofdmframesync_acquire_test(256, 32, 0); }
 void autotest_ofdmframesync_acquire_n512()  { ofdmframesync_acquire_test(512, 64, 0); }
 
+
+// sparse narrowband-in-wideband allocation: only a small band of
+// subcarriers is occupied, so the generator's inverse transform is
+// pruned to the enabled carriers; verify the frame still synchronizes
+// and data subcarriers are recovered exactly as with a dense allocation
+void autotest_ofdmframesync_sparse()
+{
+    unsigned int M         = 256;   // number of subcarriers
+    unsigned int cp_len    = 32;    // cyclic prefix length
+    unsigned int taper_len = 0;     // taper length
+    float        tol       = 1e-2f; // error tolerance
+
+    // occupy roughly 14% of the band around DC
+    unsigned char p[M];
+    ofdmframe_init_sctype_range(M, -0.07f, 0.07f, p);
+
+    // derived values
+    unsigned int num_samples = (3 + 1)*(M + cp_len);
+
+    // create synthesizer/analyzer objects
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, taper_len, p);
+
+    float complex X[M];         // original data sequence
+    float complex X_test[M];    // recovered data sequence
+    ofdmframesync fs = ofdmframesync_create(M,cp_len,taper_len,p,ofdmframesync_autotest_callback,(void*)X_test);
+
+    unsigned int i;
+    float complex y[num_samples];   // frame samples
+
+    // assemble full frame
+    unsigned int n=0;
+    ofdmframegen_write_S0a(fg, &y[n]);  n += M + cp_len;
+    ofdmframegen_write_S0b(fg, &y[n]);  n += M + cp_len;
+    ofdmframegen_write_S1( fg, &y[n]);  n += M + cp_len;
+
+    // generate data symbol (random)
+    for (i=0; i<M; i++) {
+        X[i]      = cexpf(_Complex_I*2*M_PI*randf());
+        X_test[i] = 0.0f;
+    }
+    ofdmframegen_writesymbol(fg, X, &y[n]);
+    n += M + cp_len;
+    assert(n == num_samples);
+
+    // run receiver
+    ofdmframesync_execute(fs,y,num_samples);
+
+    // check output on occupied data subcarriers
+    for (i=0; i<M; i++) {
+        if (p[i] == OFDMFRAME_SCTYPE_DATA) {
+            float e = crealf( (X[i] - X_test[i])*conjf(X[i] - X_test[i]) );
+            CONTEND_DELTA( fabsf(e), 0.0f, tol );
+        }
+    }
+
+    // destroy objects
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+}
+
+// primed acquisition: burst timing and carrier offset are supplied
+// externally (e.g. from a TDMA schedule), so the synchronizer starts
+// directly in fine synchronization on the S1 sequence
+//  _timing_error   :   samples of error in the supplied timing hint
+void ofdmframesync_prime_test(int _timing_error)
+{
+    // options
+    unsigned int M         = 64;        // number of subcarriers
+    unsigned int cp_len    =  8;        // cyclic prefix length
+    unsigned int taper_len =  0;        // taper length
+    unsigned int delay     = 40;        // samples before burst start
+    float        tol       = 1e-2f;     // error tolerance
+
+    //
+    float dphi = 0.5f / (float)M;       // carrier frequency offset
+
+    // subcarrier allocation (initialize to default)
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    // derived values; trailing guard covers the receiver's symbol
+    // timer when the hint is late
+    unsigned int guard       = 2*cp_len;
+    unsigned int num_samples = delay + (3 + 1)*(M + cp_len) + guard;
+
+    // create synthesizer/analyzer objects
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, taper_len, p);
+
+    float complex X[M];         // original data sequence
+    float complex X_test[M];    // recovered data sequence
+    ofdmframesync fs = ofdmframesync_create(M,cp_len,taper_len,p,ofdmframesync_autotest_callback,(void*)X_test);
+
+    unsigned int i;
+    float complex y[num_samples];   // frame samples
+
+    // assemble frame preceded by a quiet scheduling gap
+    unsigned int n;
+    for (n=0; n<delay; n++)
+        y[n] = 0.0f;
+    ofdmframegen_write_S0a(fg, &y[n]);  n += M + cp_len;
+    ofdmframegen_write_S0b(fg, &y[n]);  n += M + cp_len;
+    ofdmframegen_write_S1( fg, &y[n]);  n += M + cp_len;
+    for (i=0; i<M; i++) {
+        X[i]      = cexpf(_Complex_I*2*M_PI*randf());
+        X_test[i] = 0.0f;
+    }
+    ofdmframegen_writesymbol(fg, X, &y[n]);
+    n += M + cp_len;
+    assert(n + guard == num_samples);
+    for ( ; n<num_samples; n++)
+        y[n] = 0.0f;
+
+    // add carrier offset
+    for (i=0; i<num_samples; i++)
+        y[i] *= cexpf(_Complex_I*dphi*i);
+
+    // prime receiver with (slightly wrong) burst timing and run
+    ofdmframesync_prime(fs, (unsigned int)((int)delay + _timing_error), dphi);
+    ofdmframesync_execute(fs,y,num_samples);
+
+    // check output
+    for (i=0; i<M; i++) {
+        if (p[i] == OFDMFRAME_SCTYPE_DATA) {
+            float e = crealf( (X[i] - X_test[i])*conjf(X[i] - X_test[i]) );
+            CONTEND_DELTA( fabsf(e), 0.0f, tol );
+        }
+    }
+
+    // destroy objects
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+}
+
+void autotest_ofdmframesync_prime()       { ofdmframesync_prime_test( 0); }
+void autotest_ofdmframesync_prime_early() { ofdmframesync_prime_test(-2); }
+void autotest_ofdmframesync_prime_late()  { ofdmframesync_prime_test( 2); }
+
+// a badly wrong hint must not lock onto a false S1 position: the
+// synchronizer either falls back to full acquisition or stays idle,
+// but never delivers a corrupted symbol
+void autotest_ofdmframesync_prime_fallback()
+{
+    unsigned int M      = 64;
+    unsigned int cp_len =  8;
+    unsigned int i;
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    float complex X_test[M];
+    for (i=0; i<M; i++)
+        X_test[i] = 0.0f;
+    ofdmframesync fs = ofdmframesync_create(M,cp_len,0,p,ofdmframesync_autotest_callback,(void*)X_test);
+
+    // prime with a hint pointing into pure noise
+    ofdmframesync_prime(fs, 100, 0.0f);
+    float complex y[4000];
+    for (i=0; i<4000; i++)
+        y[i] = 0.01f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+    ofdmframesync_execute(fs, y, 4000);
+
+    // no callback was invoked
+    for (i=0; i<M; i++)
+        CONTEND_EQUALITY( crealf(X_test[i]), 0.0f );
+
+    ofdmframesync_destroy(fs);
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Multi-tone synthesizer: bank of phase accumulators in structure-of-
+// arrays layout, emitting the summed waveform in a single pass per block
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// renormalization interval [samples]
+#define MSYNTH_RENORM_INTERVAL  (256)
+
+struct MSYNTH(_s) {
+    unsigned int num_tones;     // number of tones
+
+    // per-tone state, structure-of-arrays layout
+    T * amp;                    // amplitude
+    T * d_theta;                // frequency [radians/sample]
+    T * pr;                     // phasor, real component
+    T * pi;                     // phasor, imaginary component
+    T * rr;                     // rotator, real component
+    T * ri;                     // rotator, imaginary component
+
+    unsigned int r;             // samples since last renormalization
+};
+
+// create multi-tone synthesizer object
+//  _num_tones  :   number of tones
+MSYNTH() MSYNTH(_create)(unsigned int _num_tones)
+{
+    // validate input
+    if (_num_tones == 0) {
+        fprintf(stderr,"error: msynth_create(), number of tones must be greater than zero\n");
+        exit(1);
+    }
+
+    MSYNTH() q = (MSYNTH()) malloc(sizeof(struct MSYNTH(_s)));
+    q->num_tones = _num_tones;
+
+    // allocate per-tone arrays
+    q->amp     = (T*) malloc(q->num_tones*sizeof(T));
+    q->d_theta = (T*) malloc(q->num_tones*sizeof(T));
+    q->pr      = (T*) malloc(q->num_tones*sizeof(T));
+    q->pi      = (T*) malloc(q->num_tones*sizeof(T));
+    q->rr      = (T*) malloc(q->num_tones*sizeof(T));
+    q->ri      = (T*) malloc(q->num_tones*sizeof(T));
+
+    // set default amplitude and frequency
+    unsigned int i;
+    for (i=0; i<q->num_tones; i++) {
+        q->amp[i]     = 1.0f;
+        q->d_theta[i] = 0.0f;
+        q->rr[i]      = 1.0f;
+        q->ri[i]      = 0.0f;
+    }
+
+    // reset object and return
+    MSYNTH(_reset)(q);
+    return q;
+}
+
+// destroy msynth object
+void MSYNTH(_destroy)(MSYNTH() _q)
+{
+    if (!_q) {
+        return;
+    }
+
+    free(_q->amp);
+    free(_q->d_theta);
+    free(_q->pr);
+    free(_q->pi);
+    free(_q->rr);
+    free(_q->ri);
+    free(_q);
+}
+
+// print msynth object internals to stdout
+void MSYNTH(_print)(MSYNTH() _q)
+{
+    printf("msynth [%u tones]\n", _q->num_tones);
+    unsigned int i;
+    for (i=0; i<_q->num_tones; i++) {
+        printf("  %4u : amp=%12.8f, freq=%12.8f rad/sample\n",
+                i, _q->amp[i], _q->d_theta[i]);
+    }
+}
+
+// reset all tone phases, retaining amplitudes and frequencies
+void MSYNTH(_reset)(MSYNTH() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_tones; i++) {
+        _q->pr[i] = 1.0f;
+        _q->pi[i] = 0.0f;
+    }
+    _q->r = 0;
+}
+
+// get number of tones
+unsigned int MSYNTH(_get_num_tones)(MSYNTH() _q)
+{
+    return _q->num_tones;
+}
+
+// validate tone index
+void MSYNTH(_validate_index)(MSYNTH() _q,
+                             unsigned int _index,
+                             const char * _method)
+{
+    if (_index >= _q->num_tones) {
+        fprintf(stderr,"error: msynth_%s(), tone index (%u) exceeds number of tones (%u)\n",
+                _method, _index, _q->num_tones);
+        exit(1);
+    }
+}
+
+// set amplitude of single tone
+void MSYNTH(_set_amplitude)(MSYNTH() _q,
+                            unsigned int _index,
+                            T _amp)
+{
+    MSYNTH(_validate_index)(_q, _index, "set_amplitude");
+    _q->amp[_index] = _amp;
+}
+
+// get amplitude of single tone
+T MSYNTH(_get_amplitude)(MSYNTH() _q,
+                         unsigned int _index)
+{
+    MSYNTH(_validate_index)(_q, _index, "get_amplitude");
+    return _q->amp[_index];
+}
+
+// set frequency of single tone [radians/sample], preserving its phase
+void MSYNTH(_set_frequency)(MSYNTH() _q,
+                            unsigned int _index,
+                            T _dtheta)
+{
+    MSYNTH(_validate_index)(_q, _index, "set_frequency");
+    _q->d_theta[_index] = _dtheta;
+    _q->rr[_index]      = cosf(_dtheta);
+    _q->ri[_index]      = sinf(_dtheta);
+}
+
+// get frequency of single tone [radians/sample]
+T MSYNTH(_get_frequency)(MSYNTH() _q,
+                         unsigned int _index)
+{
+    MSYNTH(_validate_index)(_q, _index, "get_frequency");
+    return _q->d_theta[_index];
+}
+
+// set phase of single tone [radians]
+void MSYNTH(_set_phase)(MSYNTH() _q,
+                        unsigned int _index,
+                        T _phi)
+{
+    MSYNTH(_validate_index)(_q, _index, "set_phase");
+    _q->pr[_index] = cosf(_phi);
+    _q->pi[_index] = sinf(_phi);
+}
+
+// get phase of single tone [radians]
+T MSYNTH(_get_phase)(MSYNTH() _q,
+                     unsigned int _index)
+{
+    MSYNTH(_validate_index)(_q, _index, "get_phase");
+    return atan2f(_q->pi[_index], _q->pr[_index]);
+}
+
+// write block of samples: sum of all tones, advancing each phase
+// accumulator by complex rotation; the inner loop runs across tones in
+// structure-of-arrays layout so it vectorizes, giving a single pass
+// over the output buffer regardless of the number of tones
+//  _q      :   msynth object
+//  _buf    :   output buffer [size: _num_samples x 1]
+//  _num_samples :  number of samples to write
+void MSYNTH(_write_samples)(MSYNTH() _q,
+                            TC * _buf,
+                            unsigned int _num_samples)
+{
+    unsigned int i;
+    unsigned int t;
+    unsigned int n = _q->num_tones;
+    for (i=0; i<_num_samples; i++) {
+        // accumulate tones and advance phasors
+        T sr = 0.0f;
+        T si = 0.0f;
+        for (t=0; t<n; t++) {
+            sr += _q->amp[t] * _q->pr[t];
+            si += _q->amp[t] * _q->pi[t];
+
+            // rotate phasor by one sample
+            T v0 = _q->pr[t]*_q->rr[t] - _q->pi[t]*_q->ri[t];
+            T v1 = _q->pr[t]*_q->ri[t] + _q->pi[t]*_q->rr[t];
+            _q->pr[t] = v0;
+            _q->pi[t] = v1;
+        }
+        _buf[i] = sr + _Complex_I*si;
+
+        // renormalize phasors periodically with first-order correction
+        _q->r++;
+        if (_q->r == MSYNTH_RENORM_INTERVAL) {
+            for (t=0; t<n; t++) {
+                T g = 1.5f - 0.5f*(_q->pr[t]*_q->pr[t] + _q->pi[t]*_q->pi[t]);
+                _q->pr[t] *= g;
+                _q->pi[t] *= g;
+            }
+            _q->r = 0;
+        }
+    }
+}
@@ -28,7 +28,9 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
+#include <pthread.h>
 
 #define NCO_PLL_BANDWIDTH_DEFAULT   (0.1)
 #define NCO_PLL_GAIN_DEFAULT        (1000)
@@ -52,6 +54,38 @@ uint32_t NCO(_constrain)(float _theta);
 // compute index for sine look-up table
 unsigned int NCO(_index)(NCO() _q);
 
+// shared read-only quarter-wave sine table, [0,pi/2] inclusive,
+// built on the first LIQUID_NCO_INTERP object created; objects may
+// be created concurrently, so initialization runs under pthread_once
+#define NCO_QTAB_SIZE   (256)
+static T              NCO(_qtab)[NCO_QTAB_SIZE+1];
+static pthread_once_t NCO(_qtab_once) = PTHREAD_ONCE_INIT;
+
+// one-time quarter-wave table initialization
+static void NCO(_qtab_init)(void)
+{
+    unsigned int i;
+    for (i=0; i<=NCO_QTAB_SIZE; i++)
+        NCO(_qtab)[i] = SIN(0.5f*M_PI*(float)(i)/(float)NCO_QTAB_SIZE);
+}
+
+// evaluate sine at 32-bit phase with quarter-wave table interpolation
+T NCO(_sin_interp)(uint32_t _theta);
+
+// rotate block of samples by internal phase/frequency with complex rotator
+void NCO(_mix_block_rotate)(NCO()        _q,
+                            TC *         _x,
+                            TC *         _y,
+                            unsigned int _n,
+                            int          _dir);
+
+// rotate block of interleaved q15 samples with integer complex rotator
+void NCO(_mix_block_rotate_q15)(NCO()        _q,
+                                int16_t *    _x,
+                                int16_t *    _y,
+                                unsigned int _n,
+                                int          _dir);
+
 // create nco/vco object
 NCO() NCO(_create)(liquid_ncotype _type)
 {
@@ -63,6 +97,10 @@ NCO() NCO(_create)(liquid_ncotype _type)
     for (i=0; i<1024; i++)
         q->sintab[i] = SIN(2.0f*M_PI*(float)(i)/1024.0f);
 
+    // initialize shared quarter-wave table (once)
+    if (q->type == LIQUID_NCO_INTERP)
+        pthread_once(&NCO(_qtab_once), NCO(_qtab_init));
+
     // set default pll bandwidth
     NCO(_pll_set_bandwidth)(q, NCO_PLL_BANDWIDTH_DEFAULT);
 
@@ -152,15 +190,66 @@ T NCO(_get_frequency)(NCO() _q)
     return d_theta > M_PI ? d_theta - 2*M_PI : d_theta;
 }
 
+// get size of serialized oscillator state [bytes]
+unsigned int NCO(_get_state_size)(NCO() _q)
+{
+    return 2*sizeof(uint32_t);
+}
+
+// save oscillator state (fixed-point phase and frequency) into buffer
+// for later warm start, preserving full 32-bit precision
+//  _q       : nco object
+//  _buf     : output buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match NCO(_get_state_size)
+void NCO(_save_state)(NCO()           _q,
+                      unsigned char * _buf,
+                      unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != NCO(_get_state_size)(_q)) {
+        fprintf(stderr,"error: nco_save_state(), invalid buffer length %u (expected %u)\n",
+                _buf_len, NCO(_get_state_size)(_q));
+        exit(1);
+    }
+
+    memmove(_buf,                    &_q->theta,   sizeof(uint32_t));
+    memmove(_buf + sizeof(uint32_t), &_q->d_theta, sizeof(uint32_t));
+}
+
+// restore oscillator state previously saved with NCO(_save_state)
+//  _q       : nco object
+//  _buf     : input buffer [size: _buf_len x 1]
+//  _buf_len : buffer length, must match NCO(_get_state_size)
+void NCO(_restore_state)(NCO()           _q,
+                         unsigned char * _buf,
+                         unsigned int    _buf_len)
+{
+    // validate input
+    if (_buf_len != NCO(_get_state_size)(_q)) {
+        fprintf(stderr,"error: nco_restore_state(), invalid buffer length %u (expected %u)\n",
+                _buf_len, NCO(_get_state_size)(_q));
+        exit(1);
+    }
+
+    memmove(&_q->theta,   _buf,                    sizeof(uint32_t));
+    memmove(&_q->d_theta, _buf + sizeof(uint32_t), sizeof(uint32_t));
+}
+
 // compute sine, cosine internally
 T NCO(_sin)(NCO() _q)
 {
+    if (_q->type == LIQUID_NCO_INTERP)
+        return NCO(_sin_interp)(_q->theta);
+
     unsigned int index = NCO(_index)(_q);
     return _q->sintab[index];
 }
 
 T NCO(_cos)(NCO() _q)
 {
+    if (_q->type == LIQUID_NCO_INTERP)
+        return NCO(_sin_interp)(_q->theta + (1LU<<30));
+
     // add pi/2 phase shift
     unsigned int index = (NCO(_index)(_q) + 256) & 0x3ff;
     return _q->sintab[index];
@@ -171,6 +260,12 @@ void NCO(_sincos)(NCO() _q,
                   T *   _s,
                   T *   _c)
 {
+    if (_q->type == LIQUID_NCO_INTERP) {
+        *_s = NCO(_sin_interp)(_q->theta);
+        *_c = NCO(_sin_interp)(_q->theta + (1LU<<30));
+        return;
+    }
+
     // add pi/2 phase shift
     unsigned int index = NCO(_index)(_q);
 
@@ -273,29 +368,10 @@ void NCO(_mix_block_up)(NCO() _q,
                         TC *_y,
                         unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(theta) + _Complex_I*sin(theta)]
-        _y[i] = _x[i] * liquid_cexpjf(theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample up
-        NCO(_mix_up)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
-    }
-#endif
+    // mix with rotator, then advance internal phase by _n steps
+    // (fixed-point multiplication wraps phase appropriately)
+    NCO(_mix_block_rotate)(_q, _x, _y, _n, 0);
+    _q->theta += _n * _q->d_theta;
 }
 
 // Rotate input vector array down by NCO angle:
@@ -310,29 +386,309 @@ void NCO(_mix_block_down)(NCO() _q,
                           TC *_y,
                           unsigned int _n)
 {
+    // mix with conjugate rotator, then advance internal phase by _n steps
+    // (fixed-point multiplication wraps phase appropriately)
+    NCO(_mix_block_rotate)(_q, _x, _y, _n, 1);
+    _q->theta += _n * _q->d_theta;
+}
+
+// Rotate input vector array by internal NCO phase and frequency,
+// advancing the phase with a pre-computed complex increment (rotator)
+// rather than a table look-up per sample. Four phase-staggered rotator
+// lanes break the sample-to-sample dependency so the multiply loop
+// vectorizes, and the lanes are periodically renormalized to keep the
+// accumulated phasor on the unit circle.
+//  _q      :   nco object
+//  _x      :   input array [size: _n x 1]
+//  _y      :   output sample [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _dir    :   mixing direction (0:up, 1:down)
+void NCO(_mix_block_rotate)(NCO()        _q,
+                            TC *         _x,
+                            TC *         _y,
+                            unsigned int _n,
+                            int          _dir)
+{
+    // compute initial phasor and per-sample phase increment
+    T theta   = NCO(_get_phase)(_q);
+    T d_theta = NCO(_get_frequency)(_q);
+    if (_dir) {
+        theta   = -theta;
+        d_theta = -d_theta;
+    }
+    TC rot = COS(d_theta) + _Complex_I*SIN(d_theta);
+
+    // initialize four phase-staggered rotator lanes
+    TC p[4];
+    p[0] = COS(theta) + _Complex_I*SIN(theta);
+    p[1] = p[0]*rot;
+    p[2] = p[1]*rot;
+    p[3] = p[2]*rot;
+    TC rot4 = rot*rot*rot*rot;
+
     unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(-theta) + _Complex_I*sin(-theta)]
-        _y[i] = _x[i] * liquid_cexpjf(-theta);
-        
-        theta += d_theta;
+    unsigned int n4 = _n - (_n % 4);
+    unsigned int r  = 0;    // samples since last renormalization
+    for (i=0; i<n4; i+=4) {
+        // rotate four samples and advance each lane by four steps
+        _y[i  ] = _x[i  ] * p[0];   p[0] *= rot4;
+        _y[i+1] = _x[i+1] * p[1];   p[1] *= rot4;
+        _y[i+2] = _x[i+2] * p[2];   p[2] *= rot4;
+        _y[i+3] = _x[i+3] * p[3];   p[3] *= rot4;
+
+        // renormalize lanes periodically with first-order correction
+        r += 4;
+        if (r == 256) {
+            unsigned int j;
+            for (j=0; j<4; j++) {
+                T g = 1.5f - 0.5f*( crealf(p[j])*crealf(p[j]) +
+                                    cimagf(p[j])*cimagf(p[j]) );
+                p[j] *= g;
+            }
+            r = 0;
+        }
     }
 
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample down
-        NCO(_mix_down)(_q, _x[i], &_y[i]);
+    // rotate remaining samples (at most three)
+    for (; i<_n; i++)
+        _y[i] = _x[i] * p[i-n4];
+}
+
+// fixed-point (q15) mixing
+
+// samples per integer-rotator segment: the q15 rotator recursion is
+// re-seeded from the exact 32-bit phase every segment, bounding the
+// accumulated phase error from the quantized rotation angle to about
+// 64/32768 radians -- comparable to the 1024-entry look-up table used
+// by the floating-point LIQUID_NCO path
+#define NCO_Q15_SEGMENT (64)
+
+// saturate 32-bit intermediate to q15 range; rotating a full-scale
+// sample can push a component up to sqrt(2) beyond full scale
+static int16_t NCO(_sat_q15)(int32_t _v)
+{
+    return _v > 32767 ? 32767 : (_v < -32768 ? -32768 : (int16_t)_v);
+}
 
-        // step NCO phase
-        NCO(_step)(_q);
+// Rotate block of interleaved q15 (sc16) samples by internal NCO phase
+// and frequency entirely in integer arithmetic: the unit phasor and
+// per-sample rotator are held as q15 complex values and advanced with
+// 16x16-bit multiplies, so front ends can mix raw ADC samples without
+// converting to floating point first (and integer SIMD processes twice
+// as many samples per vector)
+//  _q      :   nco object
+//  _x      :   input array, interleaved I/Q [size: 2 _n x 1]
+//  _y      :   output array, interleaved I/Q [size: 2 _n x 1]
+//  _n      :   number of input, output samples
+//  _dir    :   mixing direction (0:up, 1:down)
+void NCO(_mix_block_rotate_q15)(NCO()        _q,
+                                int16_t *    _x,
+                                int16_t *    _y,
+                                unsigned int _n,
+                                int          _dir)
+{
+    uint32_t theta = _q->theta;
+    unsigned int i = 0;
+    while (i < _n) {
+        unsigned int m = _n - i;
+        if (m > NCO_Q15_SEGMENT)
+            m = NCO_Q15_SEGMENT;
+
+        // seed q15 phasor and rotator from the exact fixed-point phase
+        float phi  = 2.0f*M_PI*(float)theta       / (float)(1LLU<<32);
+        float dphi = 2.0f*M_PI*(float)_q->d_theta / (float)(1LLU<<32);
+        if (_dir) {
+            phi  = -phi;
+            dphi = -dphi;
+        }
+        int32_t pi = (int32_t)roundf(32767.0f*cosf(phi));
+        int32_t pq = (int32_t)roundf(32767.0f*sinf(phi));
+        int32_t ri = (int32_t)roundf(32767.0f*cosf(dphi));
+        int32_t rq = (int32_t)roundf(32767.0f*sinf(dphi));
+
+        unsigned int k;
+        for (k=0; k<m; k++) {
+            // rotate sample: y = x * p, rounding at q30 -> q15
+            int32_t xi = _x[2*(i+k)  ];
+            int32_t xq = _x[2*(i+k)+1];
+            _y[2*(i+k)  ] = NCO(_sat_q15)((xi*pi - xq*pq + (1<<14)) >> 15);
+            _y[2*(i+k)+1] = NCO(_sat_q15)((xi*pq + xq*pi + (1<<14)) >> 15);
+
+            // advance phasor: p = p * r
+            int32_t t = (pi*ri - pq*rq + (1<<14)) >> 15;
+            pq        = (pi*rq + pq*ri + (1<<14)) >> 15;
+            pi        = t;
+        }
+
+        theta += m*_q->d_theta;
+        i     += m;
+    }
+}
+
+// Rotate interleaved q15 (sc16) sample vector up by NCO angle and
+// advance the internal phase, as NCO(_mix_block_up) but with int16
+// complex input/output and an integer rotator
+//  _q      :   nco object
+//  _x      :   input array, interleaved I/Q [size: 2 _n x 1]
+//  _y      :   output array, interleaved I/Q [size: 2 _n x 1]
+//  _n      :   number of input, output samples
+void NCO(_mix_block_up_q15)(NCO()        _q,
+                            int16_t *    _x,
+                            int16_t *    _y,
+                            unsigned int _n)
+{
+    NCO(_mix_block_rotate_q15)(_q, _x, _y, _n, 0);
+    _q->theta += _n * _q->d_theta;
+}
+
+// Rotate interleaved q15 (sc16) sample vector down by NCO angle and
+// advance the internal phase, as NCO(_mix_block_down) but with int16
+// complex input/output and an integer rotator
+//  _q      :   nco object
+//  _x      :   input array, interleaved I/Q [size: 2 _n x 1]
+//  _y      :   output array, interleaved I/Q [size: 2 _n x 1]
+//  _n      :   number of input, output samples
+void NCO(_mix_block_down_q15)(NCO()        _q,
+                              int16_t *    _x,
+                              int16_t *    _y,
+                              unsigned int _n)
+{
+    NCO(_mix_block_rotate_q15)(_q, _x, _y, _n, 1);
+    _q->theta += _n * _q->d_theta;
+}
+
+// chirp generation
+
+// samples per analytically-seeded chirp segment: within a segment the
+// quadratic phase is evaluated with a second-order phasor recursion,
+// and each segment is re-seeded from the exact fixed-point phase state
+// so floating-point rounding cannot accumulate across long sweeps
+#define NCO_CHIRP_SEGMENT (256)
+
+// Generate a block of a phase-continuous linear-FM chirp, sweeping the
+// frequency by _df radians/sample each sample:
+//      y[k] = exp{j theta[k]},  theta[k+1] = theta[k] + d_theta[k],
+//                               d_theta[k+1] = d_theta[k] + _df
+// The internal phase and frequency are advanced (in fixed point, so the
+// result is identical to stepping sample by sample) and subsequent
+// calls or mixing operations continue the sweep without discontinuity.
+// Four phase-staggered phasor lanes carry the quadratic-phase recursion
+// so the multiply loop vectorizes as in NCO(_mix_block_rotate).
+//  _q      :   nco object
+//  _df     :   frequency increment per sample [radians/sample^2]
+//  _n      :   number of output samples
+//  _y      :   output array [size: _n x 1]
+void NCO(_generate_chirp)(NCO()        _q,
+                          T            _df,
+                          unsigned int _n,
+                          TC *         _y)
+{
+    // per-sample frequency increment (chirp rate) in fixed point
+    uint32_t dd = NCO(_constrain)(_df);
+
+    unsigned int i = 0;
+    while (i < _n) {
+        unsigned int m = _n - i;
+        if (m > NCO_CHIRP_SEGMENT)
+            m = NCO_CHIRP_SEGMENT;
+
+        // segment start phase, frequency, and chirp rate [radians]
+        T theta = 2.0f*M_PI*(float)_q->theta   / (float)(1LLU<<32);
+        T d     = 2.0f*M_PI*(float)_q->d_theta / (float)(1LLU<<32);
+        T df    = 2.0f*M_PI*(float)dd          / (float)(1LLU<<32);
+
+        // seed four phase-staggered lanes with the exact quadratic
+        // phase at offsets 0..3, lane rotators with the four-sample
+        // phase increment at each offset, and the common second
+        // difference: advancing lane j by four samples multiplies its
+        // phasor by exp{j (4 d + (4k+6) df)} which itself advances by
+        // exp{j 16 df} every iteration
+        TC p[4];
+        TC r[4];
+        unsigned int j;
+        for (j=0; j<4; j++) {
+            T pj = theta + j*d + df*(j*(j-1))/2;
+            T rj = 4*d + (4*j+6)*df;
+            p[j] = COS(pj) + _Complex_I*SIN(pj);
+            r[j] = COS(rj) + _Complex_I*SIN(rj);
+        }
+        TC c16 = COS(16*df) + _Complex_I*SIN(16*df);
+
+        unsigned int k;
+        unsigned int m4 = m - (m % 4);
+        for (k=0; k<m4; k+=4) {
+            // write four samples and advance each lane by four steps
+            _y[i+k  ] = p[0];   p[0] *= r[0];   r[0] *= c16;
+            _y[i+k+1] = p[1];   p[1] *= r[1];   r[1] *= c16;
+            _y[i+k+2] = p[2];   p[2] *= r[2];   r[2] *= c16;
+            _y[i+k+3] = p[3];   p[3] *= r[3];   r[3] *= c16;
+        }
+
+        // write remaining samples (at most three)
+        for (; k<m; k++)
+            _y[i+k] = p[k-m4];
+
+        // advance fixed-point phase state by m samples in closed form
+        // (unsigned multiplication wraps phase appropriately)
+        _q->theta   += m*_q->d_theta + dd*((m*(m-1))/2);
+        _q->d_theta += m*dd;
+        i += m;
+    }
+}
+
+// Generate a linear frequency sweep from the current frequency to a
+// target frequency over a block of samples; the internal frequency
+// lands exactly on the target so a subsequent segment (or plain
+// mixing) continues from there. A zero-length block steps to the
+// target frequency immediately without rendering any samples, and a
+// target equal to the current frequency renders a constant tone.
+//  _q      :   nco object
+//  _f1     :   target frequency [radians/sample]
+//  _n      :   number of output samples
+//  _y      :   output array [size: _n x 1]
+void NCO(_generate_sweep)(NCO()        _q,
+                          T            _f1,
+                          unsigned int _n,
+                          TC *         _y)
+{
+    if (_n > 0) {
+        T f0 = NCO(_get_frequency)(_q);
+        NCO(_generate_chirp)(_q, (_f1 - f0)/(float)_n, _n, _y);
+    }
+
+    // land exactly on the target frequency, absorbing the fixed-point
+    // rounding of the per-sample increment
+    NCO(_set_frequency)(_q, _f1);
+}
+
+// Generate a piecewise-linear frequency trajectory: for each segment,
+// sweep linearly from the current frequency to the segment's target
+// frequency over the segment's duration, concatenating the rendered
+// samples. Repeating the previous target holds a constant tone, and a
+// zero-duration segment jumps to its target instantaneously.
+//  _q              :   nco object
+//  _f              :   segment target frequencies [size: _num_segments x 1]
+//  _n              :   segment durations [size: _num_segments x 1]
+//  _num_segments   :   number of trajectory segments
+//  _y              :   output array [size: sum(_n) x 1]
+void NCO(_generate_trajectory)(NCO()          _q,
+                               T *            _f,
+                               unsigned int * _n,
+                               unsigned int   _num_segments,
+                               TC *           _y)
+{
+    // validate input
+    if (_num_segments == 0) {
+        fprintf(stderr,"error: nco_generate_trajectory(), number of segments must be greater than zero\n");
+        exit(1);
+    }
+
+    unsigned int i;
+    unsigned int n = 0;
+    for (i=0; i<_num_segments; i++) {
+        NCO(_generate_sweep)(_q, _f[i], _n[i], _y + n);
+        n += _n[i];
     }
-#endif
 }
 
 //
@@ -362,3 +718,25 @@ unsigned int NCO(_index)(NCO() _q)
     return ((_q->theta + (1<<21)) >> 22) & 0x3ff; // round appropriately
 }
 
+// evaluate sine at 32-bit phase with quarter-wave table interpolation:
+// exploit sin(pi-x) = sin(x) and sin(-x) = -sin(x) to fold the phase
+// into the first quadrant, then interpolate linearly between entries
+T NCO(_sin_interp)(uint32_t _theta)
+{
+    // extract quadrant and phase within quadrant
+    unsigned int quadrant = _theta >> 30;
+    uint32_t t = _theta << 2;
+
+    // mirror phase in second and fourth quadrants
+    if (quadrant & 1)
+        t = ~t;
+
+    // interpolate between adjacent table entries
+    unsigned int index = t >> 24;
+    T mu = (T)(t & 0x00ffffff) / (T)0x01000000;
+    T v  = NCO(_qtab)[index] + mu*(NCO(_qtab)[index+1] - NCO(_qtab)[index]);
+
+    // negate in third and fourth quadrants
+    return (quadrant & 2) ? -v : v;
+}
+
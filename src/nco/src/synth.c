@@ -48,6 +48,15 @@ struct SYNTH(_s) {
     TC current;
     TC next_half;
 
+    // conjugated chip and half-chip tables with their magnitudes,
+    // for block despreading via dot products
+    TC * tab_conj;      // conj(tab[i])
+    TC * tab_prev_conj; // conj((tab[i-1]+tab[i])/2)
+    TC * tab_next_conj; // conj((tab[i]+tab[i+1])/2)
+    T *  tab_mag;       // |tab[i]|
+    T *  tab_prev_mag;  // |(tab[i-1]+tab[i])/2|
+    T *  tab_next_mag;  // |(tab[i]+tab[i+1])/2|
+
     // phase-locked loop
     T alpha;
     T beta;
@@ -61,6 +70,26 @@ SYNTH() SYNTH(_create)(const TC * _table, unsigned int _length)
     q->tab    = (TC *)malloc(q->length * sizeof(TC));
     memcpy(q->tab, _table, q->length * sizeof(TC));
 
+    // pre-compute conjugated chip/half-chip tables and magnitudes for
+    // block despreading
+    q->tab_conj      = (TC *)malloc(q->length * sizeof(TC));
+    q->tab_prev_conj = (TC *)malloc(q->length * sizeof(TC));
+    q->tab_next_conj = (TC *)malloc(q->length * sizeof(TC));
+    q->tab_mag       = (T *) malloc(q->length * sizeof(T));
+    q->tab_prev_mag  = (T *) malloc(q->length * sizeof(T));
+    q->tab_next_mag  = (T *) malloc(q->length * sizeof(T));
+    unsigned int i;
+    for (i=0; i<q->length; i++) {
+        TC prev = q->tab[(i + q->length - 1) % q->length];
+        TC next = q->tab[(i + 1) % q->length];
+        q->tab_conj[i]      = conjf(q->tab[i]);
+        q->tab_prev_conj[i] = conjf((prev + q->tab[i]) / 2);
+        q->tab_next_conj[i] = conjf((q->tab[i] + next) / 2);
+        q->tab_mag[i]       = cabsf(q->tab_conj[i]);
+        q->tab_prev_mag[i]  = cabsf(q->tab_prev_conj[i]);
+        q->tab_next_mag[i]  = cabsf(q->tab_next_conj[i]);
+    }
+
     // set default pll bandwidth
     SYNTH(_pll_set_bandwidth)(q, SYNTH_PLL_BANDWIDTH_DEFAULT);
 
@@ -79,6 +108,12 @@ void SYNTH(_destroy)(SYNTH() _q)
     }
 
     free(_q->tab);
+    free(_q->tab_conj);
+    free(_q->tab_prev_conj);
+    free(_q->tab_next_conj);
+    free(_q->tab_mag);
+    free(_q->tab_prev_mag);
+    free(_q->tab_next_mag);
     free(_q);
 }
 
@@ -236,11 +271,51 @@ void SYNTH(_spread)(SYNTH() _q, TC _x, TC * _y)
     }
 }
 
+// internal: 1 if the frequency advances the table exactly one entry
+// per step, enabling the block despread path
+static int SYNTH(_unity_stride)(SYNTH() _q)
+{
+    return _q->d_theta == (T)((2.f * M_PI) / (float)_q->length);
+}
+
+// internal: advance state through one full table cycle following a
+// block despread
+static void SYNTH(_step_cycle)(SYNTH() _q)
+{
+    _q->theta += (T)_q->length * _q->d_theta;
+    SYNTH(_constrain_phase)(_q);
+    SYNTH(_compute_synth)(_q);
+}
+
 void SYNTH(_despread)(SYNTH() _q, TC * _x, TC * _y)
 {
+    unsigned int i;
+
+    // block path: each step advances the table one entry, so the
+    // despread is a dot product against a rotation of the conjugated
+    // table, computed in two contiguous segments
+    if (SYNTH(_unity_stride)(_q)) {
+        unsigned int L  = _q->length;
+        unsigned int i0 = _q->index;
+        unsigned int n0 = L - i0;
+
+        TC d0, d1;
+        DOTPROD(_run4)(_q->tab_conj+i0, _x,    n0, &d0);
+        DOTPROD(_run4)(_q->tab_conj,    _x+n0, i0, &d1);
+
+        T sum = 0;
+        for (i=0; i<n0; i++)
+            sum += cabsf(_x[i]) * _q->tab_mag[i0+i];
+        for (i=n0; i<L; i++)
+            sum += cabsf(_x[i]) * _q->tab_mag[i-n0];
+
+        *_y = (d0 + d1) / sum;
+        SYNTH(_step_cycle)(_q);
+        return;
+    }
+
     TC despread = 0;
     T  sum      = 0;
-    unsigned int i;
     for (i = 0; i < _q->length; i++) {
         TC temp;
         SYNTH(_mix_down)(_q, _x[i], &temp);
@@ -255,6 +330,42 @@ void SYNTH(_despread)(SYNTH() _q, TC * _x, TC * _y)
 
 void SYNTH(_despread_triple)(SYNTH() _q, TC * _x, TC * _early, TC * _punctual, TC * _late)
 {
+    unsigned int i;
+
+    // block path: despread all three branches with dot products
+    // against rotations of the conjugated chip/half-chip tables
+    if (SYNTH(_unity_stride)(_q)) {
+        unsigned int L  = _q->length;
+        unsigned int i0 = _q->index;
+        unsigned int n0 = L - i0;
+
+        TC de0, de1, dp0, dp1, dl0, dl1;
+        DOTPROD(_run4)(_q->tab_prev_conj+i0, _x,    n0, &de0);
+        DOTPROD(_run4)(_q->tab_prev_conj,    _x+n0, i0, &de1);
+        DOTPROD(_run4)(_q->tab_conj+i0,      _x,    n0, &dp0);
+        DOTPROD(_run4)(_q->tab_conj,         _x+n0, i0, &dp1);
+        DOTPROD(_run4)(_q->tab_next_conj+i0, _x,    n0, &dl0);
+        DOTPROD(_run4)(_q->tab_next_conj,    _x+n0, i0, &dl1);
+
+        // compute chip amplitudes once and accumulate branch sums
+        T se = 0;
+        T sp = 0;
+        T sl = 0;
+        for (i=0; i<L; i++) {
+            unsigned int k = i < n0 ? i0+i : i-n0;
+            T a = cabsf(_x[i]);
+            se += a * _q->tab_prev_mag[k];
+            sp += a * _q->tab_mag[k];
+            sl += a * _q->tab_next_mag[k];
+        }
+
+        *_early    = (de0 + de1) / se;
+        *_punctual = (dp0 + dp1) / sp;
+        *_late     = (dl0 + dl1) / sl;
+        SYNTH(_step_cycle)(_q);
+        return;
+    }
+
     TC despread_early    = 0;
     TC despread_punctual = 0;
     TC despread_late     = 0;
@@ -262,8 +373,6 @@ void SYNTH(_despread_triple)(SYNTH() _q, TC * _x, TC * _early, TC * _punctual, T
     T sum_early    = 0;
     T sum_punctual = 0;
     T sum_late     = 0;
-
-    unsigned int i;
     for (i = 0; i < _q->length; i++) {
         despread_early += _x[i] * conjf(_q->prev_half);
         despread_punctual += _x[i] * conjf(_q->current);
@@ -27,6 +27,7 @@
 #include "liquid.internal.h"
 
 #define SYNTH(name)   LIQUID_CONCAT(synth_crcf,name)
+#define DOTPROD(name) LIQUID_CONCAT(dotprod_cccf,name)
 #define T           float
 #define TC          liquid_float_complex
 
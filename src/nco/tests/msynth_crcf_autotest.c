@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare multi-tone synthesis against direct sum of complex exponentials
+void autotest_msynth_crcf_tones()
+{
+    // options
+    unsigned int num_tones = 16;
+    unsigned int buf_len   = 4096;
+    float        tol       = 1e-3f;
+
+    // create object and configure tones
+    msynth_crcf ms = msynth_crcf_create(num_tones);
+    CONTEND_EQUALITY( msynth_crcf_get_num_tones(ms), num_tones );
+
+    float amp  [num_tones];
+    float freq [num_tones];
+    float phase[num_tones];
+    unsigned int t;
+    for (t=0; t<num_tones; t++) {
+        amp  [t] = 0.2f + randf();
+        freq [t] = 2*M_PI*(randf() - 0.5f);
+        phase[t] = 2*M_PI*(randf() - 0.5f);
+        msynth_crcf_set_amplitude(ms, t, amp  [t]);
+        msynth_crcf_set_frequency(ms, t, freq [t]);
+        msynth_crcf_set_phase    (ms, t, phase[t]);
+
+        CONTEND_DELTA( msynth_crcf_get_amplitude(ms,t), amp  [t], tol );
+        CONTEND_DELTA( msynth_crcf_get_frequency(ms,t), freq [t], tol );
+        CONTEND_DELTA( msynth_crcf_get_phase    (ms,t), phase[t], tol );
+    }
+
+    // generate block of samples
+    float complex buf[buf_len];
+    msynth_crcf_write_samples(ms, buf, buf_len);
+
+    // compare result to direct synthesis (phase computed in double and
+    // wrapped before truncation to single precision)
+    unsigned int i;
+    for (i=0; i<buf_len; i++) {
+        float complex v = 0;
+        for (t=0; t<num_tones; t++) {
+            double theta = fmod(phase[t] + (double)i*freq[t], 2*M_PI);
+            v += amp[t] * cexpf(_Complex_I*(float)theta);
+        }
+
+        CONTEND_DELTA( crealf(buf[i]), crealf(v), tol );
+        CONTEND_DELTA( cimagf(buf[i]), cimagf(v), tol );
+    }
+
+    // destroy object
+    msynth_crcf_destroy(ms);
+}
+
+// reset clears tone phases but retains amplitudes and frequencies
+void autotest_msynth_crcf_reset()
+{
+    unsigned int buf_len = 64;
+    float        tol     = 1e-5f;
+
+    msynth_crcf ms = msynth_crcf_create(3);
+    msynth_crcf_set_frequency(ms, 0,  0.1f);
+    msynth_crcf_set_frequency(ms, 1, -0.3f);
+    msynth_crcf_set_frequency(ms, 2,  0.7f);
+    msynth_crcf_set_amplitude(ms, 1,  0.5f);
+
+    // generate block, reset, and re-generate
+    float complex buf_0[buf_len];
+    float complex buf_1[buf_len];
+    msynth_crcf_write_samples(ms, buf_0, buf_len);
+    msynth_crcf_reset(ms);
+    msynth_crcf_write_samples(ms, buf_1, buf_len);
+
+    // outputs should be identical
+    unsigned int i;
+    for (i=0; i<buf_len; i++) {
+        CONTEND_DELTA( crealf(buf_0[i]), crealf(buf_1[i]), tol );
+        CONTEND_DELTA( cimagf(buf_0[i]), cimagf(buf_1[i]), tol );
+    }
+
+    msynth_crcf_destroy(ms);
+}
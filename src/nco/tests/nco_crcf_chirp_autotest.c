@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// block chirp generation matches stepping the oscillator sample by
+// sample while adjusting the frequency, and leaves the internal phase
+// and frequency in the same state as the per-sample reference
+void autotest_nco_crcf_chirp()
+{
+    unsigned int n   = 2000;    // number of samples
+    float        f0  = 0.1f;    // start frequency
+    float        df  = 2e-4f;   // chirp rate [radians/sample^2]
+    float        phi = 0.3f;    // start phase
+    float        tol = 1e-3f;   // error tolerance
+    unsigned int k;
+
+    // initialize chirp generator and per-sample reference identically
+    nco_crcf q   = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf ref = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf_set_frequency(q,   f0);
+    nco_crcf_set_frequency(ref, f0);
+    nco_crcf_set_phase(q,   phi);
+    nco_crcf_set_phase(ref, phi);
+
+    // render chirp as a single block
+    float complex * y = (float complex*) malloc(n*sizeof(float complex));
+    nco_crcf_generate_chirp(q, df, n, y);
+
+    // compare to stepping the reference one sample at a time
+    for (k=0; k<n; k++) {
+        float complex v;
+        nco_crcf_cexpf(ref, &v);
+        CONTEND_DELTA( crealf(y[k]), crealf(v), tol );
+        CONTEND_DELTA( cimagf(y[k]), cimagf(v), tol );
+
+        nco_crcf_step(ref);
+        nco_crcf_adjust_frequency(ref, df);
+    }
+
+    // internal state matches the per-sample reference
+    CONTEND_DELTA( nco_crcf_get_phase(q),     nco_crcf_get_phase(ref),     1e-6f );
+    CONTEND_DELTA( nco_crcf_get_frequency(q), nco_crcf_get_frequency(ref), 1e-6f );
+
+    nco_crcf_destroy(q);
+    nco_crcf_destroy(ref);
+    free(y);
+}
+
+// splitting a sweep across two blocks of odd sizes produces the same
+// waveform as rendering it in one call (phase continuity at the seam)
+void autotest_nco_crcf_chirp_continuity()
+{
+    unsigned int n   =  1500;   // total number of samples
+    unsigned int n0  =   777;   // first block size
+    float        f0  = -0.3f;   // start frequency
+    float        df  = 1.2e-4f; // chirp rate [radians/sample^2]
+    float        tol = 1e-3f;   // error tolerance
+    unsigned int k;
+
+    nco_crcf q0 = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf q1 = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf_set_frequency(q0, f0);
+    nco_crcf_set_frequency(q1, f0);
+
+    // render as one block and as two blocks
+    float complex * y0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(n*sizeof(float complex));
+    nco_crcf_generate_chirp(q0, df, n,    y0);
+    nco_crcf_generate_chirp(q1, df, n0,   y1);
+    nco_crcf_generate_chirp(q1, df, n-n0, y1 + n0);
+
+    for (k=0; k<n; k++) {
+        CONTEND_DELTA( crealf(y1[k]), crealf(y0[k]), tol );
+        CONTEND_DELTA( cimagf(y1[k]), cimagf(y0[k]), tol );
+    }
+
+    nco_crcf_destroy(q0);
+    nco_crcf_destroy(q1);
+    free(y0);
+    free(y1);
+}
+
+// piecewise-linear trajectory: sweep up, hold, sweep down; verify the
+// measured instantaneous frequency within each segment and that the
+// oscillator lands exactly on the final target
+void autotest_nco_crcf_sweep_trajectory()
+{
+    float        f[3] = { 0.4f,  0.4f, -0.5f};  // segment target frequencies
+    unsigned int n[3] = {  400,   300,   600};  // segment durations
+    float        f0   = -0.2f;                  // start frequency
+    float        tol  = 0.01f;                  // frequency measurement tolerance
+
+    nco_crcf q = nco_crcf_create(LIQUID_NCO_INTERP);
+    nco_crcf_set_frequency(q, f0);
+
+    unsigned int num_samples = n[0] + n[1] + n[2];
+    float complex * y = (float complex*) malloc(num_samples*sizeof(float complex));
+    nco_crcf_generate_trajectory(q, f, n, 3, y);
+
+    // instantaneous frequency at sample k is arg{y[k+1] conj(y[k])}
+    // mid-way through the first sweep: f0 + 199*(0.4-(-0.2))/400
+    CONTEND_DELTA( cargf(y[ 200]*conjf(y[ 199])),  0.0985f, tol );
+    // inside the hold segment
+    CONTEND_DELTA( cargf(y[ 550]*conjf(y[ 549])),  0.4f,    tol );
+    // mid-way through the final sweep: 0.4 + 299*(-0.5-0.4)/600
+    CONTEND_DELTA( cargf(y[1000]*conjf(y[ 999])), -0.0485f, tol );
+
+    // frequency lands exactly on the final target
+    CONTEND_DELTA( nco_crcf_get_frequency(q), f[2], 1e-6f );
+
+    nco_crcf_destroy(q);
+    free(y);
+}
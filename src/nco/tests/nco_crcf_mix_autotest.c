@@ -30,7 +30,7 @@ void autotest_nco_crcf_mix_block_up()
     // options
     unsigned int buf_len = 4096;
     float        phase   = 0.7123f;
-    float        freq    = 0; //0.1324f;
+    float        freq    = 0.1324f;
     float        tol     = 1e-2f;
 
     // create object
@@ -49,9 +49,9 @@ void autotest_nco_crcf_mix_block_up()
     nco_crcf_mix_block_up(nco, buf_0, buf_1, buf_len);
 
     // compare result to expected
-    float phi = phase;
+    double phi = phase;
     for (i=0; i<buf_len; i++) {
-        float complex v = buf_0[i] * cexpf(_Complex_I*phi);
+        float complex v = buf_0[i] * cexpf(_Complex_I*(float)phi);
         CONTEND_DELTA( crealf(buf_1[i]), crealf(v), tol);
         CONTEND_DELTA( cimagf(buf_1[i]), cimagf(v), tol);
         phi += freq;
@@ -61,3 +61,99 @@ void autotest_nco_crcf_mix_block_up()
     nco_crcf_destroy(nco);
 }
 
+void autotest_nco_crcf_mix_block_down()
+{
+    // options
+    unsigned int buf_len = 4096;
+    float        phase   = 0.7123f;
+    float        freq    = 0.1324f;
+    float        tol     = 1e-2f;
+
+    // create object
+    nco_crcf nco = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_phase    (nco, phase);
+    nco_crcf_set_frequency(nco, freq);
+
+    // generate signal
+    float complex buf_0[buf_len];
+    float complex buf_1[buf_len];
+    unsigned int i;
+    for (i=0; i<buf_len; i++)
+        buf_0[i] = cexpf(_Complex_I*2*M_PI*randf());
+
+    // mix signal
+    nco_crcf_mix_block_down(nco, buf_0, buf_1, buf_len);
+
+    // compare result to expected
+    double phi = phase;
+    for (i=0; i<buf_len; i++) {
+        float complex v = buf_0[i] * cexpf(-_Complex_I*(float)phi);
+        CONTEND_DELTA( crealf(buf_1[i]), crealf(v), tol);
+        CONTEND_DELTA( cimagf(buf_1[i]), cimagf(v), tol);
+        phi += freq;
+    }
+
+    // internal phase advances by one step per sample
+    float theta = fmodf(phase + buf_len*freq, 2*M_PI);
+    if (theta < 0) theta += 2*M_PI;
+    CONTEND_DELTA( nco_crcf_get_phase(nco), theta, tol );
+
+    // destroy object
+    nco_crcf_destroy(nco);
+}
+
+// mix interleaved int16 I/Q samples with the integer rotator and
+// compare to the expected rotation at q15 scale
+void testbench_nco_crcf_mix_block_q15(int _dir)
+{
+    // options
+    unsigned int buf_len = 4096;
+    float        phase   = 0.7123f;
+    float        freq    = 0.1324f;
+    float        tol     = 1e-2f;
+
+    // create object
+    nco_crcf nco = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_phase    (nco, phase);
+    nco_crcf_set_frequency(nco, freq);
+
+    // generate signal at 70% of full scale (rotation can push a
+    // full-scale component beyond the q15 range)
+    int16_t buf_0[2*buf_len];
+    int16_t buf_1[2*buf_len];
+    unsigned int i;
+    for (i=0; i<buf_len; i++) {
+        float complex v = 0.7f*cexpf(_Complex_I*2*M_PI*randf());
+        buf_0[2*i  ] = (int16_t)roundf(32767.0f*crealf(v));
+        buf_0[2*i+1] = (int16_t)roundf(32767.0f*cimagf(v));
+    }
+
+    // mix signal
+    if (_dir)
+        nco_crcf_mix_block_down_q15(nco, buf_0, buf_1, buf_len);
+    else
+        nco_crcf_mix_block_up_q15  (nco, buf_0, buf_1, buf_len);
+
+    // compare result to expected, at unit scale
+    double phi = _dir ? -phase : phase;
+    double dphi = _dir ? -freq : freq;
+    for (i=0; i<buf_len; i++) {
+        float complex x = (buf_0[2*i] + _Complex_I*buf_0[2*i+1]) / 32767.0f;
+        float complex v = x * cexpf(_Complex_I*(float)phi);
+        CONTEND_DELTA( buf_1[2*i  ]/32767.0f, crealf(v), tol );
+        CONTEND_DELTA( buf_1[2*i+1]/32767.0f, cimagf(v), tol );
+        phi += dphi;
+    }
+
+    // internal phase advances by one step per sample
+    float theta = fmodf(phase + buf_len*freq, 2*M_PI);
+    if (theta < 0) theta += 2*M_PI;
+    CONTEND_DELTA( nco_crcf_get_phase(nco), theta, tol );
+
+    // destroy object
+    nco_crcf_destroy(nco);
+}
+
+void autotest_nco_crcf_mix_block_up_q15()   { testbench_nco_crcf_mix_block_q15(0); }
+void autotest_nco_crcf_mix_block_down_q15() { testbench_nco_crcf_mix_block_q15(1); }
+
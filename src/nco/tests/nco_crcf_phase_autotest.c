@@ -89,6 +89,56 @@ void autotest_nco_crcf_phase()
     nco_crcf_phase_test( 6.283185307f,  1.000000000f, -0.000000000f, LIQUID_NCO, tol);
 }
 
+// test saving and restoring oscillator state
+void autotest_nco_crcf_state()
+{
+    unsigned int i;
+
+    // run oscillator to an arbitrary phase/frequency state
+    nco_crcf q0 = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_frequency(q0, 0.1234f);
+    nco_crcf_set_phase    (q0, 0.7890f);
+    for (i=0; i<100; i++)
+        nco_crcf_step(q0);
+
+    // save state
+    unsigned int n = nco_crcf_get_state_size(q0);
+    unsigned char state[n];
+    nco_crcf_save_state(q0, state, n);
+
+    // restore into a fresh object; phase and frequency match exactly
+    // (state is fixed point)
+    nco_crcf q1 = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_restore_state(q1, state, n);
+    CONTEND_EQUALITY( nco_crcf_get_phase(q1),     nco_crcf_get_phase(q0)     );
+    CONTEND_EQUALITY( nco_crcf_get_frequency(q1), nco_crcf_get_frequency(q0) );
+
+    // both objects generate identical outputs from here
+    for (i=0; i<100; i++) {
+        nco_crcf_step(q0);
+        nco_crcf_step(q1);
+        CONTEND_EQUALITY( nco_crcf_sin(q0), nco_crcf_sin(q1) );
+        CONTEND_EQUALITY( nco_crcf_cos(q0), nco_crcf_cos(q1) );
+    }
+
+    nco_crcf_destroy(q0);
+    nco_crcf_destroy(q1);
+}
+
+// test quarter-wave interpolated nco phase (much tighter tolerance)
+void autotest_nco_crcf_phase_interp()
+{
+    float tol = 1e-4f;
+
+    // sweep phase over entire unit circle, all four quadrants
+    unsigned int i;
+    unsigned int n = 240;
+    for (i=0; i<n; i++) {
+        float theta = -2*M_PI + 4*M_PI*(float)i/(float)n;
+        nco_crcf_phase_test(theta, cosf(theta), sinf(theta), LIQUID_NCO_INTERP, tol);
+    }
+}
+
 //
 // test floating point precision nco
 //
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// generate pseudo-random complex spreading table (unit-magnitude chips)
+static void synth_crcf_autotest_init_pn(float complex * _pn,
+                                        unsigned int    _n)
+{
+    msequence ms = msequence_create_default(7);
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _pn[i]  = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2);
+        _pn[i] += (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+    }
+    msequence_destroy(ms);
+}
+
+//
+// AUTOTEST: block despreading matches the per-chip reference
+//
+void autotest_synth_crcf_despread()
+{
+    float        tol = 1e-4f;   // error tolerance
+    unsigned int n   = 64;      // spreading factor
+    float        g   = 0.7f;    // channel gain
+    float        dphi= 0.2f;    // symbol phase offset
+
+    // generate spreading sequence and synthesizer
+    float complex pn[n];
+    synth_crcf_autotest_init_pn(pn, n);
+    synth_crcf q = synth_crcf_create(pn, n);
+
+    // generate received chips: scaled, phase-rotated sequence
+    unsigned int i;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = g*cexpf(_Complex_I*dphi)*pn[i];
+
+    // despread; result is the normalized symbol
+    float complex y;
+    synth_crcf_despread(q, x, &y);
+
+    CONTEND_DELTA( crealf(y), cosf(dphi), tol );
+    CONTEND_DELTA( cimagf(y), sinf(dphi), tol );
+
+    synth_crcf_destroy(q);
+}
+
+//
+// AUTOTEST: triple (early/punctual/late) despreading matches the
+// per-chip reference computed with the synthesizer getters
+//
+void autotest_synth_crcf_despread_triple()
+{
+    float        tol = 1e-4f;   // error tolerance
+    unsigned int n   = 64;      // spreading factor
+
+    // generate spreading sequence and two identical synthesizers
+    float complex pn[n];
+    synth_crcf_autotest_init_pn(pn, n);
+    synth_crcf q0 = synth_crcf_create(pn, n);
+    synth_crcf q1 = synth_crcf_create(pn, n);
+
+    // generate received chips: sequence plus deterministic offsets
+    unsigned int i;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = pn[i] + 0.2f*cexpf(_Complex_I*1.013f*i);
+
+    // compute reference with the per-chip getters on the clone
+    float complex de = 0, dp = 0, dl = 0;
+    float         se = 0, sp = 0, sl = 0;
+    for (i=0; i<n; i++) {
+        de += x[i] * conjf( synth_crcf_get_half_previous(q1) );
+        dp += x[i] * conjf( synth_crcf_get_current(q1)       );
+        dl += x[i] * conjf( synth_crcf_get_half_next(q1)     );
+        se += cabsf(x[i]) * cabsf( synth_crcf_get_half_previous(q1) );
+        sp += cabsf(x[i]) * cabsf( synth_crcf_get_current(q1)       );
+        sl += cabsf(x[i]) * cabsf( synth_crcf_get_half_next(q1)     );
+        synth_crcf_step(q1);
+    }
+    de /= se;
+    dp /= sp;
+    dl /= sl;
+
+    // run object under test
+    float complex early, punctual, late;
+    synth_crcf_despread_triple(q0, x, &early, &punctual, &late);
+
+    CONTEND_DELTA( crealf(early),    crealf(de), tol );
+    CONTEND_DELTA( cimagf(early),    cimagf(de), tol );
+    CONTEND_DELTA( crealf(punctual), crealf(dp), tol );
+    CONTEND_DELTA( cimagf(punctual), cimagf(dp), tol );
+    CONTEND_DELTA( crealf(late),     crealf(dl), tol );
+    CONTEND_DELTA( cimagf(late),     cimagf(dl), tol );
+
+    // both objects end at the same table position
+    CONTEND_DELTA( synth_crcf_get_phase(q0), synth_crcf_get_phase(q1), 1e-4f );
+
+    synth_crcf_destroy(q0);
+    synth_crcf_destroy(q1);
+}
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "liquid.internal.h"
 
@@ -86,6 +87,7 @@ gasearch gasearch_create_advanced(gasearch_utility _utility,
     ga->mutation_rate   = _mutation_rate;
     ga->get_utility     = _utility;
     ga->minimize        = ( _minmax==LIQUID_OPTIM_MINIMIZE ) ? 1 : 0;
+    ga->num_threads     = 1;
 
     ga->bits_per_chromosome = _parent->num_bits;
 
@@ -213,6 +215,15 @@ void gasearch_set_mutation_rate(gasearch _g,
     _g->mutation_rate = _mutation_rate;
 }
 
+// set number of threads for parallel fitness evaluation; the caller
+// asserts that the utility callback is thread-safe. A value of 0 or 1
+// evaluates the population serially (default).
+void gasearch_set_num_threads(gasearch _g,
+                              unsigned int _num_threads)
+{
+    _g->num_threads = _num_threads < 1 ? 1 : _num_threads;
+}
+
 // Execute the search
 //  _g              :   ga search object
 //  _max_iterations :   maximum number of iterations to run before bailing
@@ -283,10 +294,48 @@ void gasearch_getopt(gasearch _g,
     *_utility_opt = _g->utility_opt;
 }
 
+// worker context for parallel population evaluation
+struct gasearch_eval_s {
+    gasearch     g;             // search object
+    unsigned int thread_id;     // worker index
+    unsigned int num_threads;   // total number of workers
+};
+
+// worker: evaluate strided subset of population
+static void * gasearch_eval_worker(void * _arg)
+{
+    struct gasearch_eval_s * w = (struct gasearch_eval_s*) _arg;
+    gasearch g = w->g;
+    unsigned int i;
+    for (i=w->thread_id; i<g->population_size; i+=w->num_threads)
+        g->utility[i] = g->get_utility(g->userdata, g->population[i]);
+    return NULL;
+}
+
 // evaluate fitness of entire population
 void gasearch_evaluate(gasearch _g)
 {
     unsigned int i;
+
+    // evaluate concurrently when enabled; each worker writes disjoint
+    // utility entries so no synchronization is needed beyond the join
+    unsigned int num_threads = _g->num_threads;
+    if (num_threads > _g->population_size)
+        num_threads = _g->population_size;
+    if (num_threads > 1) {
+        pthread_t threads[num_threads];
+        struct gasearch_eval_s ctx[num_threads];
+        for (i=0; i<num_threads; i++) {
+            ctx[i].g           = _g;
+            ctx[i].thread_id   = i;
+            ctx[i].num_threads = num_threads;
+            pthread_create(&threads[i], NULL, gasearch_eval_worker, (void*)&ctx[i]);
+        }
+        for (i=0; i<num_threads; i++)
+            pthread_join(threads[i], NULL);
+        return;
+    }
+
     for (i=0; i<_g->population_size; i++)
         _g->utility[i] = _g->get_utility(_g->userdata, _g->population[i]);
 }
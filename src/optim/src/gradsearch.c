@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 #include "liquid.internal.h"
 
 #define DEBUG_GRADSEARCH 0
@@ -44,6 +45,7 @@ struct gradsearch_s {
     utility_function utility;   // utility function pointer
     void * userdata;            // object to optimize (user data)
     int direction;              // search direction (minimize/maximimze utility)
+    unsigned int num_threads;   // number of threads for gradient probes
 };
 
 // create a gradient search object
@@ -76,6 +78,7 @@ gradsearch gradsearch_create(void *           _userdata,
     q->p = (float*) malloc(q->num_parameters*sizeof(float));
     q->pnorm = 0.0f;
     q->u = 0.0f;
+    q->num_threads = 1;
 
     return q;
 }
@@ -108,6 +111,15 @@ void gradsearch_print(gradsearch _q)
     printf("}\n");
 }
 
+// set number of threads for parallel gradient probes; the caller
+// asserts that the utility callback is thread-safe. A value of 0 or 1
+// evaluates the probes serially (default).
+void gradsearch_set_num_threads(gradsearch _q,
+                                unsigned int _num_threads)
+{
+    _q->num_threads = _num_threads < 1 ? 1 : _num_threads;
+}
+
 float gradsearch_step(gradsearch _q)
 {
     unsigned int i;
@@ -116,7 +128,10 @@ float gradsearch_step(gradsearch _q)
     unsigned int n=20;
     for (i=0; i<n; i++) {
         // compute gradient
-        gradsearch_gradient(_q->utility, _q->userdata, _q->v, _q->num_parameters, _q->delta, _q->p);
+        if (_q->num_threads > 1)
+            gradsearch_gradient_mt(_q->utility, _q->userdata, _q->v, _q->num_parameters, _q->delta, _q->p, _q->num_threads);
+        else
+            gradsearch_gradient(_q->utility, _q->userdata, _q->v, _q->num_parameters, _q->delta, _q->p);
 
         // normalize gradient vector
         _q->pnorm = gradsearch_norm(_q->p, _q->num_parameters);
@@ -237,6 +252,80 @@ void gradsearch_gradient(utility_function _utility,
     }
 }
 
+// worker context for parallel gradient probes
+struct gradsearch_gradient_job_s {
+    utility_function utility;       // user-defined function
+    void *           userdata;      // user-defined data object
+    float *          x;             // operating point
+    unsigned int     n;             // dimensionality of search
+    float            delta;         // gradient step size
+    float            u0;            // utility at operating point
+    float *          gradient;      // resulting gradient
+    unsigned int     thread_id;     // worker index
+    unsigned int     num_threads;   // total number of workers
+};
+
+// worker: probe strided subset of dimensions
+static void * gradsearch_gradient_worker(void * _arg)
+{
+    struct gradsearch_gradient_job_s * job = (struct gradsearch_gradient_job_s*) _arg;
+    float x_prime[job->n];
+    float u_prime;
+    unsigned int i;
+    for (i=job->thread_id; i<job->n; i+=job->num_threads) {
+        // copy operating point and increment along dimension 'i'
+        memmove(x_prime, job->x, job->n*sizeof(float));
+        x_prime[i] += job->delta;
+
+        // evaluate new utility and compute gradient estimate
+        u_prime = job->utility(job->userdata, x_prime, job->n);
+        job->gradient[i] = (u_prime - job->u0) / job->delta;
+    }
+    return NULL;
+}
+
+// compute the gradient of a function at a particular point, evaluating
+// the dimension probes concurrently; the utility must be thread-safe
+//  _utility     :   user-defined function
+//  _userdata    :   user-defined data object
+//  _x           :   operating point, [size: _n x 1]
+//  _n           :   dimensionality of search
+//  _delta       :   step value for which to compute gradient
+//  _gradient    :   resulting gradient
+//  _num_threads :   number of worker threads
+void gradsearch_gradient_mt(utility_function _utility,
+                            void  *          _userdata,
+                            float *          _x,
+                            unsigned int     _n,
+                            float            _delta,
+                            float *          _gradient,
+                            unsigned int     _num_threads)
+{
+    // evaluate function at current operating point
+    float u0 = _utility(_userdata, _x, _n);
+
+    // each worker probes a disjoint strided subset of dimensions
+    if (_num_threads > _n)
+        _num_threads = _n;
+    pthread_t threads[_num_threads];
+    struct gradsearch_gradient_job_s jobs[_num_threads];
+    unsigned int i;
+    for (i=0; i<_num_threads; i++) {
+        jobs[i].utility     = _utility;
+        jobs[i].userdata    = _userdata;
+        jobs[i].x           = _x;
+        jobs[i].n           = _n;
+        jobs[i].delta       = _delta;
+        jobs[i].u0          = u0;
+        jobs[i].gradient    = _gradient;
+        jobs[i].thread_id   = i;
+        jobs[i].num_threads = _num_threads;
+        pthread_create(&threads[i], NULL, gradsearch_gradient_worker, (void*)&jobs[i]);
+    }
+    for (i=0; i<_num_threads; i++)
+        pthread_join(threads[i], NULL);
+}
+
 // execute line search; loosely solve:
 //
 //    min|max phi(alpha) := f(_x - alpha*_p)
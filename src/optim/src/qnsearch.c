@@ -56,6 +56,18 @@ qnsearch qnsearch_create(void * _userdata,
     q->gradient0= (float*) calloc( q->num_parameters, sizeof(float) );
     q->v_prime  = (float*) calloc( q->num_parameters, sizeof(float) );
     q->dv       = (float*) calloc( q->num_parameters, sizeof(float) );
+
+    // L-BFGS engine disabled by default
+    q->lbfgs_m     = 0;
+    q->lbfgs_k     = 0;
+    q->lbfgs_head  = 0;
+    q->lbfgs_valid = 0;
+    q->lbfgs_s     = NULL;
+    q->lbfgs_y     = NULL;
+    q->lbfgs_rho   = NULL;
+    q->lbfgs_alpha = NULL;
+    q->v0          = NULL;
+
     q->utility = q->get_utility(q->userdata, q->v, q->num_parameters);
 
     qnsearch_reset(q);
@@ -73,6 +85,13 @@ void qnsearch_destroy(qnsearch _q)
     free(_q->gradient0);
     free(_q->v_prime);
     free(_q->dv);
+
+    free(_q->lbfgs_s);
+    free(_q->lbfgs_y);
+    free(_q->lbfgs_rho);
+    free(_q->lbfgs_alpha);
+    free(_q->v0);
+
     free(_q);
 }
 
@@ -91,15 +110,56 @@ void qnsearch_reset(qnsearch _q)
 
     // set B to identity matrix
     unsigned int i,j,n=0;
-    for (i=0; i<_q->num_parameters; i++) {
-        for (j=0; j<_q->num_parameters; j++) {
-            _q->B[n++] = (i==j) ? 1.0f : 0.0f;
+    if (_q->B != NULL) {
+        for (i=0; i<_q->num_parameters; i++) {
+            for (j=0; j<_q->num_parameters; j++) {
+                _q->B[n++] = (i==j) ? 1.0f : 0.0f;
+            }
         }
     }
 
+    // clear L-BFGS correction-pair history
+    _q->lbfgs_k     = 0;
+    _q->lbfgs_head  = 0;
+    _q->lbfgs_valid = 0;
+
     _q->utility = _q->get_utility(_q->userdata, _q->v, _q->num_parameters);
 }
 
+void qnsearch_set_lbfgs(qnsearch _q,
+                        unsigned int _m)
+{
+    if (_m == _q->lbfgs_m)
+        return;
+
+    // release state from previously selected engine
+    free(_q->lbfgs_s);     _q->lbfgs_s     = NULL;
+    free(_q->lbfgs_y);     _q->lbfgs_y     = NULL;
+    free(_q->lbfgs_rho);   _q->lbfgs_rho   = NULL;
+    free(_q->lbfgs_alpha); _q->lbfgs_alpha = NULL;
+    free(_q->v0);          _q->v0          = NULL;
+
+    unsigned int n = _q->num_parameters;
+    _q->lbfgs_m = _m;
+    if (_m > 0) {
+        // memory-bounded engine: the dense [n x n] arrays are not used
+        free(_q->B);    _q->B = NULL;
+        free(_q->H);    _q->H = NULL;
+
+        _q->lbfgs_s     = (float*) calloc( _m*n, sizeof(float) );
+        _q->lbfgs_y     = (float*) calloc( _m*n, sizeof(float) );
+        _q->lbfgs_rho   = (float*) calloc( _m,   sizeof(float) );
+        _q->lbfgs_alpha = (float*) calloc( _m,   sizeof(float) );
+        _q->v0          = (float*) calloc( n,    sizeof(float) );
+    } else if (_q->B == NULL) {
+        // restore dense Hessian engine arrays
+        _q->B = (float*) calloc( n*n, sizeof(float) );
+        _q->H = (float*) calloc( n*n, sizeof(float) );
+    }
+
+    qnsearch_reset(_q);
+}
+
 void qnsearch_step(qnsearch _q)
 {
     unsigned int i;
@@ -111,7 +171,24 @@ void qnsearch_step(qnsearch _q)
 
     // TODO : perform line search to find optimal gamma
 
-    // compute search direction
+    // compute search direction and step size
+    float stepsize = _q->gamma_hat;
+    if (_q->lbfgs_m > 0) {
+        // memory-bounded engine: fold the most recent parameter step and
+        // gradient change into the correction-pair history, then apply
+        // the two-loop recursion; O(m*n) operations, no [n x n] storage
+        if (_q->lbfgs_valid)
+            qnsearch_update_history_lbfgs(_q);
+        qnsearch_compute_direction_lbfgs(_q);
+
+        // the direction approximates the full Newton step, so search
+        // backwards from unity rather than using the nominal gamma
+        stepsize = qnsearch_linesearch_lbfgs(_q);
+
+        // store current point for the next correction pair
+        memmove(_q->v0, _q->v, n*sizeof(float));
+        _q->lbfgs_valid = 1;
+    } else {
 #if 0
     matrixf_mul(_q->B,        n, n,
                 _q->gradient, n, 1,
@@ -125,10 +202,11 @@ void qnsearch_step(qnsearch _q)
                 _q->gradient, n, 1,
                 _q->p, n, 1);
 #endif
+    }
 
     // compute step vector
     for (i=0; i<_q->num_parameters; i++)
-        _q->dv[i] = -_q->gamma_hat * _q->p[i];
+        _q->dv[i] = -stepsize * _q->p[i];
 
     // apply change
     for (i=0; i<_q->num_parameters; i++) {
@@ -272,3 +350,109 @@ void qnsearch_compute_Hessian(qnsearch _q)
 }
 
 
+// append correction pair {s = v - v0, y = gradient - gradient0} to the
+// circular history, discarding pairs which do not satisfy the curvature
+// condition y^T s > 0 (keeps the implicit inverse Hessian positive
+// definite)
+void qnsearch_update_history_lbfgs(qnsearch _q)
+{
+    unsigned int i;
+    unsigned int n = _q->num_parameters;
+    unsigned int k = _q->lbfgs_head;
+    float * s = _q->lbfgs_s + k*n;
+    float * y = _q->lbfgs_y + k*n;
+
+    float ys = 0.0f;
+    for (i=0; i<n; i++) {
+        s[i] = _q->v[i] - _q->v0[i];
+        y[i] = _q->gradient[i] - _q->gradient0[i];
+        ys += y[i] * s[i];
+    }
+
+    if (ys < 1e-12f)
+        return;
+
+    _q->lbfgs_rho[k] = 1.0f / ys;
+    _q->lbfgs_head = (k + 1) % _q->lbfgs_m;
+    if (_q->lbfgs_k < _q->lbfgs_m)
+        _q->lbfgs_k++;
+}
+
+// compute search direction p = H*gradient from the bounded history of
+// correction pairs using the two-loop recursion, where H is the implicit
+// inverse Hessian approximation
+void qnsearch_compute_direction_lbfgs(qnsearch _q)
+{
+    unsigned int i, j, k;
+    unsigned int n = _q->num_parameters;
+    unsigned int m = _q->lbfgs_m;
+
+    // initialize direction with current gradient
+    memmove(_q->p, _q->gradient, n*sizeof(float));
+
+    // no history yet: fall back to steepest descent
+    if (_q->lbfgs_k == 0)
+        return;
+
+    // first loop: newest pair to oldest
+    for (j=0; j<_q->lbfgs_k; j++) {
+        k = (_q->lbfgs_head + m - 1 - j) % m;
+        float * s = _q->lbfgs_s + k*n;
+        float * y = _q->lbfgs_y + k*n;
+
+        float alpha = 0.0f;
+        for (i=0; i<n; i++)
+            alpha += s[i] * _q->p[i];
+        alpha *= _q->lbfgs_rho[k];
+        _q->lbfgs_alpha[k] = alpha;
+
+        for (i=0; i<n; i++)
+            _q->p[i] -= alpha * y[i];
+    }
+
+    // scale by initial inverse Hessian estimate (s.y)/(y.y) from the
+    // most recent pair
+    k = (_q->lbfgs_head + m - 1) % m;
+    float * y = _q->lbfgs_y + k*n;
+    float yy = 0.0f;
+    for (i=0; i<n; i++)
+        yy += y[i] * y[i];
+    if (yy > 0.0f) {
+        float g = 1.0f / (_q->lbfgs_rho[k] * yy);
+        for (i=0; i<n; i++)
+            _q->p[i] *= g;
+    }
+
+    // second loop: oldest pair to newest
+    for (j=0; j<_q->lbfgs_k; j++) {
+        k = (_q->lbfgs_head + m - _q->lbfgs_k + j) % m;
+        float * s = _q->lbfgs_s + k*n;
+        float * yk = _q->lbfgs_y + k*n;
+
+        float beta = 0.0f;
+        for (i=0; i<n; i++)
+            beta += yk[i] * _q->p[i];
+        beta *= _q->lbfgs_rho[k];
+
+        for (i=0; i<n; i++)
+            _q->p[i] += (_q->lbfgs_alpha[k] - beta) * s[i];
+    }
+}
+
+// backtracking line search along the current direction p, halving the
+// step until the utility decreases (or the trial budget is exhausted)
+float qnsearch_linesearch_lbfgs(qnsearch _q)
+{
+    unsigned int i, t;
+    unsigned int n = _q->num_parameters;
+    float alpha = 1.0f;
+    for (t=0; t<24; t++) {
+        for (i=0; i<n; i++)
+            _q->v_prime[i] = _q->v[i] - alpha * _q->p[i];
+        float u = _q->get_utility(_q->userdata, _q->v_prime, n);
+        if (u < _q->utility)
+            break;
+        alpha *= 0.5f;
+    }
+    return alpha;
+}
@@ -158,3 +158,206 @@ void autotest_gradsearch_maxutility()
     CONTEND_DELTA( utility_max_autotest(NULL, v_opt, num_parameters), 1.0f, tol );
 }
 
+
+//
+// AUTOTEST: parallel gradient probes produce the same trajectory as the
+// serial path (rosenbrock utility is pure and thread-safe)
+//
+void autotest_gradsearch_threaded()
+{
+    float        tol            = 1e-6f;
+    unsigned int num_parameters = 8;
+    unsigned int num_iterations = 200;
+
+    // initialize serial and threaded searches at the same point
+    float v0[num_parameters];
+    float v1[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++) {
+        v0[i] = 0.1f*i;
+        v1[i] = 0.1f*i;
+    }
+
+    gradsearch gs0 = gradsearch_create(NULL, v0, num_parameters,
+                                       liquid_rosenbrock, LIQUID_OPTIM_MINIMIZE);
+    gradsearch gs1 = gradsearch_create(NULL, v1, num_parameters,
+                                       liquid_rosenbrock, LIQUID_OPTIM_MINIMIZE);
+    gradsearch_set_num_threads(gs1, 4);
+
+    // run searches and compare utilities along the way
+    unsigned int n;
+    for (n=0; n<num_iterations; n++) {
+        float u0 = gradsearch_step(gs0);
+        float u1 = gradsearch_step(gs1);
+        CONTEND_DELTA( u1, u0, tol );
+    }
+
+    // trajectories must be identical
+    for (i=0; i<num_parameters; i++) {
+        CONTEND_DELTA( v1[i], v0[i], tol );
+    }
+
+    gradsearch_destroy(gs0);
+    gradsearch_destroy(gs1);
+}
+
+// thread-safe fitness function: peak where every trait is 0.5
+static float gasearch_autotest_peak(void * _userdata, chromosome _c)
+{
+    unsigned int i;
+    float u = 1.0f;
+    for (i=0; i<chromosome_get_num_traits(_c); i++) {
+        float v = chromosome_valuef(_c, i);
+        u *= expf( -(v-0.5f)*(v-0.5f)*20.0f );
+    }
+    return u;
+}
+
+//
+// AUTOTEST: parallel fitness evaluation matches the serial path; worker
+// scheduling does not affect the result because each chromosome's
+// utility is written to its own slot and the random sequence is
+// consumed only by the (serial) crossover and mutation stages
+//
+void autotest_gasearch_threaded()
+{
+    float        tol             = 1e-6f;
+    unsigned int num_parameters  = 4;
+    unsigned int bits_per_param  = 12;
+    unsigned int num_generations = 40;
+
+    chromosome parent = chromosome_create_basic(num_parameters, bits_per_param);
+    chromosome c0     = chromosome_create_basic(num_parameters, bits_per_param);
+    chromosome c1     = chromosome_create_basic(num_parameters, bits_per_param);
+    float u0, u1;
+    unsigned int i;
+
+    // serial search
+    srand(12345);
+    gasearch ga0 = gasearch_create(gasearch_autotest_peak, NULL, parent,
+                                   LIQUID_OPTIM_MAXIMIZE);
+    gasearch_run(ga0, num_generations, 2.0f);
+    gasearch_getopt(ga0, c0, &u0);
+
+    // threaded search with the same seed
+    srand(12345);
+    gasearch ga1 = gasearch_create(gasearch_autotest_peak, NULL, parent,
+                                   LIQUID_OPTIM_MAXIMIZE);
+    gasearch_set_num_threads(ga1, 4);
+    gasearch_run(ga1, num_generations, 2.0f);
+    gasearch_getopt(ga1, c1, &u1);
+
+    // results must match exactly, and the search must have made progress
+    CONTEND_DELTA( u1, u0, tol );
+    for (i=0; i<num_parameters; i++) {
+        CONTEND_DELTA( chromosome_valuef(c1,i), chromosome_valuef(c0,i), tol );
+    }
+    CONTEND_GREATER_THAN( u1, 0.5f );
+
+    chromosome_destroy(parent);
+    chromosome_destroy(c0);
+    chromosome_destroy(c1);
+    gasearch_destroy(ga0);
+    gasearch_destroy(ga1);
+}
+
+// smooth convex bowl with poorly conditioned axes; minimum at [1 1 1 ...]
+static float qnsearch_autotest_quadratic(void *       _userdata,
+                                         float *      _v,
+                                         unsigned int _n)
+{
+    unsigned int i;
+    float u = 0.0f;
+    for (i=0; i<_n; i++)
+        u += (1.0f + 0.5f*i) * (_v[i]-1.0f) * (_v[i]-1.0f);
+    return u;
+}
+
+//
+// AUTOTEST: memory-bounded L-BFGS engine minimizes a high-dimensional
+// quadratic without ever forming the dense [n x n] Hessian
+//
+void autotest_qnsearch_lbfgs()
+{
+    float        tol            = 1e-2f;
+    unsigned int num_parameters = 20;
+    unsigned int num_iterations = 8000;
+
+    // initialize vector for optimization
+    float v_opt[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++)
+        v_opt[i] = 0.0f;
+
+    qnsearch q = qnsearch_create(NULL, v_opt, num_parameters,
+                                 qnsearch_autotest_quadratic,
+                                 LIQUID_OPTIM_MINIMIZE);
+    qnsearch_set_lbfgs(q, 8);
+
+    // execute search one iteration at a time
+    unsigned int d=1;
+    for (i=0; i<num_iterations; i++) {
+        qnsearch_step(q);
+
+        // periodically print updates
+        if (liquid_autotest_verbose) {
+            if (((i+1)%d)==0 || i==0 || i == num_iterations-1) {
+                printf("%5u: ", i+1);
+                qnsearch_print(q);
+
+                if ((i+1)==10*d) d*=10;
+            }
+        }
+    }
+
+    qnsearch_destroy(q);
+
+    // test results, optimum at [1, 1, 1, ... 1];
+    for (i=0; i<num_parameters; i++)
+        CONTEND_DELTA(v_opt[i], 1.0f, tol);
+
+    // test value of utility (should be nearly 0)
+    CONTEND_DELTA( qnsearch_autotest_quadratic(NULL, v_opt, num_parameters), 0.0f, tol );
+}
+
+//
+// AUTOTEST: L-BFGS engine reaches the same optimum as the dense Hessian
+// engine on a small problem
+//
+void autotest_qnsearch_lbfgs_dense()
+{
+    float        tol            = 2e-2f;
+    unsigned int num_parameters = 4;
+    unsigned int num_iterations = 4000;
+
+    // initialize dense and L-BFGS searches at the same point
+    float v0[num_parameters];
+    float v1[num_parameters];
+    unsigned int i;
+    for (i=0; i<num_parameters; i++) {
+        v0[i] = 0.0f;
+        v1[i] = 0.0f;
+    }
+
+    qnsearch q0 = qnsearch_create(NULL, v0, num_parameters,
+                                  qnsearch_autotest_quadratic,
+                                  LIQUID_OPTIM_MINIMIZE);
+    qnsearch q1 = qnsearch_create(NULL, v1, num_parameters,
+                                  qnsearch_autotest_quadratic,
+                                  LIQUID_OPTIM_MINIMIZE);
+    qnsearch_set_lbfgs(q1, 4);
+
+    for (i=0; i<num_iterations; i++) {
+        qnsearch_step(q0);
+        qnsearch_step(q1);
+    }
+
+    qnsearch_destroy(q0);
+    qnsearch_destroy(q1);
+
+    // both engines must land on the same optimum
+    for (i=0; i<num_parameters; i++) {
+        CONTEND_DELTA( v0[i], 1.0f, tol );
+        CONTEND_DELTA( v1[i], 1.0f, tol );
+    }
+}
@@ -23,14 +23,26 @@
 //
 // structured quantizer
 //
+// Companding (where requested) is applied per in-phase/quadrature
+// axis. The expansion side is table-driven: all 2^n reconstruction
+// levels are pre-computed at create so the DAC path is a single
+// look-up per axis regardless of compander type. Complex samples
+// pack the in-phase bits above the quadrature bits in the output
+// word.
+//
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
+
+// mu-law compression factor
+#define QUANTIZER_MULAW_MU      (255.0f)
 
 struct QUANTIZER(_s) {
     int ctype;          // compander type
-    unsigned int n;     // number of bits
-                        // table?
+    unsigned int n;     // number of bits per axis
+    float mu;           // mu-law compression factor
+    float * dac_table;  // expansion table [size: 2^n x 1]
 };
 
 // create quantizer object
@@ -45,6 +57,12 @@ QUANTIZER() QUANTIZER(_create)(liquid_compander_type _ctype,
     if (_num_bits == 0) {
         fprintf(stderr,"error: quantizer_create(), must have at least one bit/sample\n");
         exit(1);
+    } else if (_num_bits > 16) {
+        fprintf(stderr,"error: quantizer_create(), maximum 16 bits/sample exceeded\n");
+        exit(1);
+    } else if (_ctype == LIQUID_COMPANDER_ALAW) {
+        fprintf(stderr,"error: quantizer_create(), A-law compander not yet supported\n");
+        exit(1);
     }
 
     // create quantizer object
@@ -53,6 +71,18 @@ QUANTIZER() QUANTIZER(_create)(liquid_compander_type _ctype,
     // initialize values
     q->ctype = _ctype;
     q->n     = _num_bits;
+    q->mu    = QUANTIZER_MULAW_MU;
+
+    // pre-compute expansion table over all 2^n codes
+    unsigned int i;
+    unsigned int M = 1<<q->n;
+    q->dac_table = (float*) malloc(M*sizeof(float));
+    for (i=0; i<M; i++) {
+        float v = quantize_dac(i, q->n);
+        if (q->ctype == LIQUID_COMPANDER_MULAW)
+            v = expand_mulaw(v, q->mu);
+        q->dac_table[i] = v;
+    }
 
     // return object
     return q;
@@ -60,6 +90,9 @@ QUANTIZER() QUANTIZER(_create)(liquid_compander_type _ctype,
 
 void QUANTIZER(_destroy)(QUANTIZER() _q)
 {
+    // free expansion table
+    free(_q->dac_table);
+
     // free main object memory
     free(_q);
 }
@@ -84,19 +117,86 @@ void QUANTIZER(_execute_adc)(QUANTIZER() _q,
                              unsigned int * _sample)
 {
 #if T_COMPLEX
+    // quantize in-phase and quadrature axes independently and pack
+    float vi = crealf(_x);
+    float vq = cimagf(_x);
+    if (_q->ctype == LIQUID_COMPANDER_MULAW) {
+        vi = compress_mulaw(vi, _q->mu);
+        vq = compress_mulaw(vq, _q->mu);
+    }
+    *_sample = (quantize_adc(vi, _q->n) << _q->n) | quantize_adc(vq, _q->n);
 #else
+    float v = _x;
+    if (_q->ctype == LIQUID_COMPANDER_MULAW)
+        v = compress_mulaw(v, _q->mu);
+    *_sample = quantize_adc(v, _q->n);
 #endif
-    *_sample = 0;
 }
 
 void QUANTIZER(_execute_dac)(QUANTIZER() _q,
                              unsigned int _sample,
                              T * _x)
 {
+    unsigned int M = (1<<_q->n) - 1;
 #if T_COMPLEX
+    // unpack and expand each axis with a table look-up
+    *_x = _q->dac_table[(_sample >> _q->n) & M] +
+          _q->dac_table[ _sample           & M]*_Complex_I;
 #else
+    *_x = _q->dac_table[_sample & M];
 #endif
-    *_x = 0.0;
 }
 
+// execute quantizer as analog-to-digital converter on a block of
+// samples
+//  _q          : quantizer object
+//  _x          : input array [size: _num_samples x 1]
+//  _num_samples: number of samples
+//  _s          : output sample array [size: _num_samples x 1]
+void QUANTIZER(_execute_adc_block)(QUANTIZER()    _q,
+                                   T *            _x,
+                                   unsigned int   _num_samples,
+                                   unsigned int * _s)
+{
+    unsigned int i;
+    if (_q->ctype != LIQUID_COMPANDER_MULAW) {
+        // linear case: quantize directly with the hoisted-scale loop
+#if T_COMPLEX
+        for (i=0; i<_num_samples; i++)
+            *_s++ = (quantize_adc(crealf(_x[i]), _q->n) << _q->n) |
+                     quantize_adc(cimagf(_x[i]), _q->n);
+#else
+        quantize_adc_block(_x, _num_samples, _q->n, _s);
+#endif
+        return;
+    }
+
+    // companding case
+    for (i=0; i<_num_samples; i++)
+        QUANTIZER(_execute_adc)(_q, _x[i], _s++);
+}
 
+// execute quantizer as digital-to-analog converter on a block of
+// samples; expansion is a table look-up per axis for all compander
+// types
+//  _q          : quantizer object
+//  _s          : input sample array [size: _num_samples x 1]
+//  _num_samples: number of samples
+//  _x          : output array [size: _num_samples x 1]
+void QUANTIZER(_execute_dac_block)(QUANTIZER()    _q,
+                                   unsigned int * _s,
+                                   unsigned int   _num_samples,
+                                   T *            _x)
+{
+    unsigned int i;
+    unsigned int n = _q->n;
+    unsigned int M = (1<<n) - 1;
+    float * table = _q->dac_table;
+#if T_COMPLEX
+    for (i=0; i<_num_samples; i++)
+        _x[i] = table[(_s[i] >> n) & M] + table[_s[i] & M]*_Complex_I;
+#else
+    for (i=0; i<_num_samples; i++)
+        _x[i] = table[_s[i] & M];
+#endif
+}
@@ -84,3 +84,75 @@ float quantize_dac(unsigned int _s, unsigned int _num_bits)
     return (_s & N) ? -r : r;
 }
 
+// quantize block of samples, hoisting validation and scaling out of
+// the loop; the branch-free body auto-vectorizes
+//  _x          : input array [size: _num_samples x 1]
+//  _num_samples: number of samples
+//  _num_bits   : number of bits per sample
+//  _s          : output sample array [size: _num_samples x 1]
+void quantize_adc_block(float *        _x,
+                        unsigned int   _num_samples,
+                        unsigned int   _num_bits,
+                        unsigned int * _s)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if (_num_bits > QUANTIZER_MAX_BITS) {
+        printf("error: quantize_adc_block(), maximum bits exceeded\n");
+        exit(1);
+    }
+#endif
+
+    unsigned int i;
+    if (_num_bits == 0) {
+        for (i=0; i<_num_samples; i++)
+            _s[i] = 0;
+        return;
+    }
+
+    unsigned int n = _num_bits-1;   //
+    unsigned int N = 1<<n;          // 2^n
+    float        g = (float)N;      // scaling factor
+
+    for (i=0; i<_num_samples; i++) {
+        // scale, clip, and set MSB on negative input (branch-free)
+        unsigned int r = (unsigned int) floorf(fabsf(_x[i])*g);
+        r = r >= N ? N-1 : r;
+        _s[i] = r | (_x[i] < 0 ? N : 0);
+    }
+}
+
+// de-quantize block of samples, hoisting validation and scaling out
+// of the loop
+//  _s          : input sample array [size: _num_samples x 1]
+//  _num_samples: number of samples
+//  _num_bits   : number of bits per sample
+//  _x          : output array [size: _num_samples x 1]
+void quantize_dac_block(unsigned int * _s,
+                        unsigned int   _num_samples,
+                        unsigned int   _num_bits,
+                        float *        _x)
+{
+#ifdef LIQUID_VALIDATE_INPUT
+    if (_num_bits > QUANTIZER_MAX_BITS) {
+        printf("error: quantize_dac_block(), maximum bits exceeded\n");
+        exit(1);
+    }
+#endif
+
+    unsigned int i;
+    if (_num_bits == 0) {
+        for (i=0; i<_num_samples; i++)
+            _x[i] = 0.0f;
+        return;
+    }
+
+    unsigned int n = _num_bits-1;   //
+    unsigned int N = 1<<n;          // 2^n
+    float        g = 1.0f / (float)N;
+
+    for (i=0; i<_num_samples; i++) {
+        float r = ((float)(_s[i] & (N-1))+0.5f) * g;
+        _x[i] = (_s[i] & N) ? -r : r;
+    }
+}
+
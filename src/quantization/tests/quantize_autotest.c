@@ -53,3 +53,103 @@ void autotest_quantize_float_n8() {
     }
 }
 
+// block conversion matches the one-sample-per-call path exactly
+void autotest_quantize_block_n12()
+{
+    unsigned int num_samples=837;
+    unsigned int num_bits=12;
+
+    float        x    [num_samples];
+    unsigned int q    [num_samples];
+    float        x_hat[num_samples];
+
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = 2.0f*randf() - 1.0f;
+
+    quantize_adc_block(x, num_samples, num_bits, q);
+    quantize_dac_block(q, num_samples, num_bits, x_hat);
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_EQUALITY( q[i],     quantize_adc(x[i], num_bits) );
+        CONTEND_EQUALITY( x_hat[i], quantize_dac(q[i], num_bits) );
+    }
+}
+
+// structured quantizer, mu-law companding: round trip is accurate and
+// the block path matches the one-sample-per-call path exactly
+void autotest_quantizerf_mulaw_n12()
+{
+    unsigned int num_samples=571;
+    unsigned int num_bits=12;
+    float tol = 2e-3f;
+
+    quantizerf q = quantizerf_create(LIQUID_COMPANDER_MULAW, 1.0f, num_bits);
+
+    float        x    [num_samples];
+    unsigned int s    [num_samples];
+    float        x_hat[num_samples];
+
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = 2.0f*randf() - 1.0f;
+
+    quantizerf_execute_adc_block(q, x, num_samples, s);
+    quantizerf_execute_dac_block(q, s, num_samples, x_hat);
+
+    for (i=0; i<num_samples; i++) {
+        unsigned int s0;
+        float x0;
+        quantizerf_execute_adc(q, x[i], &s0);
+        quantizerf_execute_dac(q, s0, &x0);
+        CONTEND_EQUALITY( s[i],     s0 );
+        CONTEND_EQUALITY( x_hat[i], x0 );
+
+        // ensure original value is recovered within tolerance
+        CONTEND_DELTA( x[i], x_hat[i], tol );
+    }
+
+    quantizerf_destroy(q);
+}
+
+// structured quantizer, complex samples: in-phase and quadrature axes
+// pack into a single word and round trip independently
+void autotest_quantizercf_linear_n8()
+{
+    unsigned int num_samples=571;
+    unsigned int num_bits=8;
+    float tol = 1.0f / (float)(1<<num_bits);
+
+    quantizercf q = quantizercf_create(LIQUID_COMPANDER_LINEAR, 1.0f, num_bits);
+
+    float complex x    [num_samples];
+    unsigned int  s    [num_samples];
+    float complex x_hat[num_samples];
+
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = (2.0f*randf()-1.0f) + (2.0f*randf()-1.0f)*_Complex_I;
+
+    quantizercf_execute_adc_block(q, x, num_samples, s);
+    quantizercf_execute_dac_block(q, s, num_samples, x_hat);
+
+    for (i=0; i<num_samples; i++) {
+        // ensure only 2*num_bits written to value s
+        CONTEND_EQUALITY( s[i]>>(2*num_bits), 0 );
+
+        unsigned int s0;
+        float complex x0;
+        quantizercf_execute_adc(q, x[i], &s0);
+        quantizercf_execute_dac(q, s0, &x0);
+        CONTEND_EQUALITY( s[i], s0 );
+        CONTEND_EQUALITY( crealf(x_hat[i]), crealf(x0) );
+        CONTEND_EQUALITY( cimagf(x_hat[i]), cimagf(x0) );
+
+        // ensure original value is recovered within tolerance
+        CONTEND_DELTA( crealf(x[i]), crealf(x_hat[i]), tol );
+        CONTEND_DELTA( cimagf(x[i]), cimagf(x_hat[i]), tol );
+    }
+
+    quantizercf_destroy(q);
+}
+
@@ -35,6 +35,13 @@ float randf() {
     return randf_inline();
 }
 
+// uniform random number generator using explicit generator object
+float randf_rng(liquid_rng _rng)
+{
+    // use 24 high-order bits for a uniform sample on [0,1)
+    return (float)(liquid_rng_uint32(_rng) >> 8) * 0x1.0p-24f;
+}
+
 // uniform random number probability distribution function
 float randf_pdf(float _x)
 {
@@ -65,6 +72,21 @@ float randuf(float _a, float _b)
     return _a + (_b - _a)*randf_inline();
 }
 
+// uniform random number generator with arbitrary bounds using explicit
+// generator object
+float randuf_rng(liquid_rng _rng,
+                 float      _a,
+                 float      _b)
+{
+    // check bounds
+    if (_a >= _b) {
+        fprintf(stderr,"error: %s:%u, randuf_rng() has invalid range\n", __FILE__, __LINE__);
+        return 0;
+    }
+
+    return _a + (_b - _a)*randf_rng(_rng);
+}
+
 // uniform random number probability distribution function
 float randuf_pdf(float _x,
                  float _a,
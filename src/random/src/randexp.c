@@ -49,6 +49,26 @@ float randexpf(float _lambda)
     return -logf( u ) / _lambda;
 }
 
+// Exponential random number generator using explicit generator object
+float randexpf_rng(liquid_rng _rng,
+                   float      _lambda)
+{
+    // validate input
+    if (_lambda <= 0) {
+        fprintf(stderr,"error: randexpf_rng(), lambda must be greater than zero\n");
+        return 0.0f;
+    }
+
+    // compute a non-zero uniform random variable in (0,1]
+    float u;
+    do {
+        u = randf_rng(_rng);
+    } while (u==0.0f);
+
+    // perform variable transformation
+    return -logf( u ) / _lambda;
+}
+
 // Exponential random number probability distribution function
 float randexpf_pdf(float _x,
                    float _lambda)
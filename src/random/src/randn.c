@@ -27,6 +27,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "liquid.internal.h"
 
@@ -81,6 +82,112 @@ void cawgn(float complex *_x, float _nstd)
     *_x += icrandnf()*_nstd*0.707106781186547f;
 }
 
+// Gauss random number generator using explicit generator object
+float randnf_rng(liquid_rng _rng)
+{
+    // generate two uniform random numbers
+    float u1, u2;
+
+    // ensure u1 does not equal zero
+    do {
+        u1 = randf_rng(_rng);
+    } while (u1 == 0.0f);
+
+    u2 = randf_rng(_rng);
+
+    return sqrtf(-2*logf(u1)) * sinf(2*M_PI*u2);
+}
+
+// complex Gauss random number generator using explicit generator object
+void crandnf_rng(liquid_rng      _rng,
+                 float complex * _y)
+{
+    // generate two uniform random numbers
+    float u1, u2;
+
+    // ensure u1 does not equal zero
+    do {
+        u1 = randf_rng(_rng);
+    } while (u1 == 0.0f);
+
+    u2 = randf_rng(_rng);
+
+    *_y = sqrtf(-2*logf(u1)) * cexpf(_Complex_I*2*M_PI*u2);
+}
+
+//
+// block generation
+//
+// Batch methods use a counter-based uniform generator (an integer hash
+// of an incrementing counter), so the stream is reproducible from a
+// seed and each output pair is independent of the previous one, and
+// Box-Muller with both the sine and cosine branches retained so no
+// output is discarded.
+//
+
+// counter-based generator state
+static uint64_t randnf_block_count = 0;
+static uint64_t randnf_block_key   = 0;
+
+// integer hash (finalizer), mapping counter to 64 uniform bits
+static uint64_t randnf_block_hash(uint64_t _x)
+{
+    _x += 0x9e3779b97f4a7c15ULL;
+    _x = (_x ^ (_x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    _x = (_x ^ (_x >> 27)) * 0x94d049bb133111ebULL;
+    return _x ^ (_x >> 31);
+}
+
+// seed block generator, resetting internal counter
+void randnf_block_seed(unsigned long _seed)
+{
+    randnf_block_key   = randnf_block_hash( (uint64_t)_seed );
+    randnf_block_count = 0;
+}
+
+// generate block of Gauss random numbers, N(0,1)
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of samples to generate
+void randnf_block(float *      _y,
+                  unsigned int _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i+=2) {
+        // derive two uniform random numbers from hashed counter;
+        // u1 on (0,1] so the logarithm is always defined
+        uint64_t v  = randnf_block_hash(randnf_block_key + randnf_block_count++);
+        float    u1 = (float)((v >> 40)       + 1) * 0x1.0p-24f;
+        float    u2 = (float)( v & 0xffffff )      * 0x1.0p-24f;
+
+        // Box-Muller transform, retaining both outputs
+        float r     = sqrtf(-2.0f*liquid_logf(u1));
+        float theta = 2.0f*M_PI*u2;
+        _y[i] = r*cosf(theta);
+        if (i+1 < _n)
+            _y[i+1] = r*sinf(theta);
+    }
+}
+
+// generate block of complex Gauss random numbers with unit variance
+// per component
+//  _y      :   output array [size: _n x 1]
+//  _n      :   number of samples to generate
+void crandnf_block(float complex * _y,
+                   unsigned int    _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // derive two uniform random numbers from hashed counter
+        uint64_t v  = randnf_block_hash(randnf_block_key + randnf_block_count++);
+        float    u1 = (float)((v >> 40)       + 1) * 0x1.0p-24f;
+        float    u2 = (float)( v & 0xffffff )      * 0x1.0p-24f;
+
+        // Box-Muller transform, one complex sample per uniform pair
+        float r = sqrtf(-2.0f*liquid_logf(u1));
+        _y[i] = r*cexpf(_Complex_I*2.0f*M_PI*u2);
+    }
+}
+
 // Gauss random number probability distribution function
 float randnf_pdf(float _x,
                  float _eta,
@@ -42,6 +42,20 @@ float randricekf(float _K, float _omega)
     return cabsf(y);
 }
 
+// Rice-K random number generator using explicit generator object
+float randricekf_rng(liquid_rng _rng,
+                     float      _K,
+                     float      _omega)
+{
+    float complex x, y;
+    float s = sqrtf((_omega*_K)/(_K+1));
+    float sig = sqrtf(0.5f*_omega/(_K+1));
+    crandnf_rng(_rng, &x);
+    y = _Complex_I*( crealf(x)*sig + s ) +
+                   ( cimagf(x)*sig     );
+    return cabsf(y);
+}
+
 
 // Rice-K random number probability distribution function
 //  f(x) = (x/sigma^2) exp{ -(x^2+s^2)/(2sigma^2) } I0( x s / sigma^2 )
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Uniform random number generator object with per-instance state
+// (xoshiro128++ core), enabling independent streams, e.g. one per
+// worker thread, without contending on the libc rand() global state
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+struct liquid_rng_s {
+    uint32_t s[4];      // generator state
+};
+
+// 32-bit rotate left
+static inline uint32_t liquid_rng_rotl(uint32_t _x,
+                                       int      _k)
+{
+    return (_x << _k) | (_x >> (32-_k));
+}
+
+// integer hash (finalizer) used to expand the seed into state words
+static uint64_t liquid_rng_hash(uint64_t _x)
+{
+    _x += 0x9e3779b97f4a7c15ULL;
+    _x = (_x ^ (_x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    _x = (_x ^ (_x >> 27)) * 0x94d049bb133111ebULL;
+    return _x ^ (_x >> 31);
+}
+
+// create generator object, seeding internal state
+liquid_rng liquid_rng_create(unsigned long _seed)
+{
+    liquid_rng q = (liquid_rng) malloc(sizeof(struct liquid_rng_s));
+
+    // seed internal state
+    liquid_rng_seed(q, _seed);
+
+    return q;
+}
+
+// destroy generator object
+void liquid_rng_destroy(liquid_rng _q)
+{
+    free(_q);
+}
+
+// re-seed generator, resetting internal state
+void liquid_rng_seed(liquid_rng    _q,
+                     unsigned long _seed)
+{
+    // expand seed into four well-distributed state words; the hash
+    // output is never all zeros for distinct inputs so the generator
+    // cannot start in the degenerate all-zero state
+    uint64_t v0 = liquid_rng_hash( (uint64_t)_seed );
+    uint64_t v1 = liquid_rng_hash( v0 );
+
+    _q->s[0] = (uint32_t)(v0      );
+    _q->s[1] = (uint32_t)(v0 >> 32);
+    _q->s[2] = (uint32_t)(v1      );
+    _q->s[3] = (uint32_t)(v1 >> 32);
+}
+
+// advance generator, returning 32 uniform random bits
+unsigned int liquid_rng_uint32(liquid_rng _q)
+{
+    uint32_t r = liquid_rng_rotl(_q->s[0] + _q->s[3], 7) + _q->s[0];
+
+    uint32_t t = _q->s[1] << 9;
+    _q->s[2] ^= _q->s[0];
+    _q->s[3] ^= _q->s[1];
+    _q->s[1] ^= _q->s[2];
+    _q->s[0] ^= _q->s[3];
+    _q->s[2] ^= t;
+    _q->s[3]  = liquid_rng_rotl(_q->s[3], 11);
+
+    return (unsigned int)r;
+}
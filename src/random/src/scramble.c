@@ -21,35 +21,47 @@
  */
 
 //
-// Finite impulse response filter design
+// data scrambler/descrambler with periodic static masks
 //
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
 
+// periodic mask expanded to a 64-bit word (two 4-byte periods); built
+// byte-wise through memcpy so the layout is independent of endianness
+static const unsigned char liquid_scramble_mask8[8] = {
+    LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,
+    LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3,
+    LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,
+    LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3};
+
 void scramble_data(unsigned char * _x,
                    unsigned int _n)
 {
-    // t = 4*(floor(_n/4))
-    unsigned int t = (_n>>2)<<2;
+    // t = 8*(floor(_n/8))
+    unsigned int t = (_n>>3)<<3;
 
-    // apply static masks
+    // apply static mask one 64-bit word at a time (unaligned-safe:
+    // the compiler lowers these fixed-size memcpy calls to plain
+    // word loads/stores)
+    uint64_t mask;
+    memcpy(&mask, liquid_scramble_mask8, sizeof(mask));
     unsigned int i;
-    for (i=0; i<t; i+=4) {
-        _x[i  ] ^= LIQUID_SCRAMBLE_MASK0;
-        _x[i+1] ^= LIQUID_SCRAMBLE_MASK1;
-        _x[i+2] ^= LIQUID_SCRAMBLE_MASK2;
-        _x[i+3] ^= LIQUID_SCRAMBLE_MASK3;
+    for (i=0; i<t; i+=8) {
+        uint64_t w;
+        memcpy(&w, &_x[i], sizeof(w));
+        w ^= mask;
+        memcpy(&_x[i], &w, sizeof(w));
     }
 
     // clean up remainder of elements
-    if ( (i+0) < _n ) _x[i+0] ^= LIQUID_SCRAMBLE_MASK0;
-    if ( (i+1) < _n ) _x[i+1] ^= LIQUID_SCRAMBLE_MASK1;
-    if ( (i+2) < _n ) _x[i+2] ^= LIQUID_SCRAMBLE_MASK2;
-    if ( (i+3) < _n ) _x[i+3] ^= LIQUID_SCRAMBLE_MASK3;
+    for (; i<_n; i++)
+        _x[i] ^= liquid_scramble_mask8[i & 0x7];
 }
 
 void unscramble_data(unsigned char * _x,
@@ -65,36 +77,28 @@ void unscramble_data(unsigned char * _x,
 void unscramble_data_soft(unsigned char * _x,
                           unsigned int _n)
 {
-    // bit mask
-    unsigned char mask = 0x00;
+    // flipping a soft bit is 255-x = x^0xff, so the scrambler bits
+    // expand to a periodic 32-byte XOR pattern (one byte per soft bit,
+    // 0xff where the mask bit is set) applied one 64-bit word per
+    // input byte
+    static const unsigned char masks[4] = {
+        LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,
+        LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3};
+    uint64_t flip[4];
+    unsigned int i, j;
+    for (i=0; i<4; i++) {
+        unsigned char pattern[8];
+        for (j=0; j<8; j++)
+            pattern[j] = (masks[i] >> (8-j-1)) & 0x01 ? 0xff : 0x00;
+        memcpy(&flip[i], pattern, sizeof(uint64_t));
+    }
 
-    // apply static masks
-    unsigned int i;
+    // apply expanded masks
     for (i=0; i<_n; i++) {
-        switch ( i % 4 ) {
-        case 0: mask = LIQUID_SCRAMBLE_MASK0; break;
-        case 1: mask = LIQUID_SCRAMBLE_MASK1; break;
-        case 2: mask = LIQUID_SCRAMBLE_MASK2; break;
-        case 3: mask = LIQUID_SCRAMBLE_MASK3; break;
-        default:;
-        }
-
-#if 0
-        unsigned int j;
-        for (j=0; j<8; j++) {
-            if ( (mask >> (8-j-1)) & 0x01 )
-                _x[8*i+j] = 255 - _x[8*i+j];
-        }
-#else
-        if ( mask & 0x80 ) _x[8*i+0] = 255 - _x[8*i+0];
-        if ( mask & 0x40 ) _x[8*i+1] = 255 - _x[8*i+1];
-        if ( mask & 0x20 ) _x[8*i+2] = 255 - _x[8*i+2];
-        if ( mask & 0x10 ) _x[8*i+3] = 255 - _x[8*i+3];
-        if ( mask & 0x08 ) _x[8*i+4] = 255 - _x[8*i+4];
-        if ( mask & 0x04 ) _x[8*i+5] = 255 - _x[8*i+5];
-        if ( mask & 0x02 ) _x[8*i+6] = 255 - _x[8*i+6];
-        if ( mask & 0x01 ) _x[8*i+7] = 255 - _x[8*i+7];
-#endif
+        uint64_t w;
+        memcpy(&w, &_x[8*i], sizeof(w));
+        w ^= flip[i & 0x3];
+        memcpy(&_x[8*i], &w, sizeof(w));
     }
 }
 
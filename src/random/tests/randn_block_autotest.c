@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: block Gauss generator statistics (deterministic seed)
+//
+void autotest_randnf_block()
+{
+    unsigned int n = 100000;
+    float        tol = 0.02f;
+
+    // seed generator for reproducible statistics
+    randnf_block_seed(1234);
+
+    // generate block of samples
+    float y[n];
+    randnf_block(y, n);
+
+    // compute first and second moments
+    unsigned int i;
+    float m1 = 0.0f;
+    float m2 = 0.0f;
+    for (i=0; i<n; i++) {
+        m1 += y[i];
+        m2 += y[i]*y[i];
+    }
+    m1 /= (float) n;
+    m2 = m2/(float)n - m1*m1;
+
+    if (liquid_autotest_verbose)
+        printf("randnf_block: mean = %12.8f, variance = %12.8f\n", m1, m2);
+
+    CONTEND_DELTA( m1, 0.0f, tol );
+    CONTEND_DELTA( m2, 1.0f, tol );
+}
+
+//
+// AUTOTEST: complex block Gauss generator statistics
+//
+void autotest_crandnf_block()
+{
+    unsigned int n = 100000;
+    float        tol = 0.02f;
+
+    // seed generator for reproducible statistics
+    randnf_block_seed(5678);
+
+    // generate block of samples
+    float complex y[n];
+    crandnf_block(y, n);
+
+    // compute moments of real and imaginary components
+    unsigned int i;
+    float m1_i = 0.0f, m1_q = 0.0f;
+    float m2   = 0.0f;
+    for (i=0; i<n; i++) {
+        m1_i += crealf(y[i]);
+        m1_q += cimagf(y[i]);
+        m2   += crealf( y[i]*conjf(y[i]) );
+    }
+    m1_i /= (float) n;
+    m1_q /= (float) n;
+    m2   /= (float) n;
+
+    if (liquid_autotest_verbose)
+        printf("crandnf_block: mean = {%12.8f,%12.8f}, energy = %12.8f\n", m1_i, m1_q, m2);
+
+    CONTEND_DELTA( m1_i, 0.0f, tol );
+    CONTEND_DELTA( m1_q, 0.0f, tol );
+
+    // each component has unit variance
+    CONTEND_DELTA( m2, 2.0f, 2.0f*tol );
+}
+
+//
+// AUTOTEST: stream is reproducible from the seed
+//
+void autotest_randnf_block_reproducibility()
+{
+    unsigned int n = 256;
+
+    float y0[n];
+    float y1[n];
+
+    // generate two blocks from the same seed, the second in two parts
+    randnf_block_seed(37);
+    randnf_block(y0, n);
+
+    randnf_block_seed(37);
+    randnf_block(y1,      n/2);
+    randnf_block(y1+n/2,  n/2);
+
+    // streams match exactly
+    unsigned int i;
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( y0[i], y1[i] );
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: two generators with the same seed produce identical streams
+//
+void autotest_liquid_rng_reproducibility()
+{
+    unsigned int n = 256;
+
+    liquid_rng rng0 = liquid_rng_create(1234);
+    liquid_rng rng1 = liquid_rng_create(1234);
+
+    // streams match exactly
+    unsigned int i;
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( liquid_rng_uint32(rng0), liquid_rng_uint32(rng1) );
+
+    // re-seeding resets the streams
+    liquid_rng_seed(rng0, 1234);
+    liquid_rng_seed(rng1, 1234);
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( randf_rng(rng0), randf_rng(rng1) );
+
+    liquid_rng_destroy(rng0);
+    liquid_rng_destroy(rng1);
+}
+
+//
+// AUTOTEST: generators with different seeds produce independent streams
+//
+void autotest_liquid_rng_independence()
+{
+    unsigned int n = 256;
+
+    liquid_rng rng0 = liquid_rng_create(1);
+    liquid_rng rng1 = liquid_rng_create(2);
+
+    // count collisions between the two streams
+    unsigned int i;
+    unsigned int num_equal = 0;
+    for (i=0; i<n; i++) {
+        if ( liquid_rng_uint32(rng0) == liquid_rng_uint32(rng1) )
+            num_equal++;
+    }
+
+    // streams should (almost surely) never collide
+    CONTEND_LESS_THAN( num_equal, 4 );
+
+    liquid_rng_destroy(rng0);
+    liquid_rng_destroy(rng1);
+}
+
+//
+// AUTOTEST: uniform generator statistics
+//
+void autotest_randf_rng()
+{
+    unsigned int n = 100000;
+    float        tol = 0.01f;
+
+    liquid_rng rng = liquid_rng_create(1234);
+
+    // compute first and second moments
+    unsigned int i;
+    float m1 = 0.0f;
+    float m2 = 0.0f;
+    for (i=0; i<n; i++) {
+        float x = randf_rng(rng);
+        m1 += x;
+        m2 += x*x;
+    }
+    m1 /= (float) n;
+    m2 = m2/(float)n - m1*m1;
+
+    if (liquid_autotest_verbose)
+        printf("randf_rng: mean = %12.8f, variance = %12.8f\n", m1, m2);
+
+    CONTEND_DELTA( m1, 0.5f,      tol );
+    CONTEND_DELTA( m2, 1.0f/12.0f, tol );
+
+    liquid_rng_destroy(rng);
+}
+
+//
+// AUTOTEST: Gauss generator statistics
+//
+void autotest_randnf_rng()
+{
+    unsigned int n = 100000;
+    float        tol = 0.02f;
+
+    liquid_rng rng = liquid_rng_create(5678);
+
+    // compute first and second moments
+    unsigned int i;
+    float m1 = 0.0f;
+    float m2 = 0.0f;
+    for (i=0; i<n; i++) {
+        float x = randnf_rng(rng);
+        m1 += x;
+        m2 += x*x;
+    }
+    m1 /= (float) n;
+    m2 = m2/(float)n - m1*m1;
+
+    if (liquid_autotest_verbose)
+        printf("randnf_rng: mean = %12.8f, variance = %12.8f\n", m1, m2);
+
+    CONTEND_DELTA( m1, 0.0f, tol );
+    CONTEND_DELTA( m2, 1.0f, tol );
+
+    liquid_rng_destroy(rng);
+}
@@ -185,19 +185,50 @@ signed int bsequence_correlate(bsequence _bs1,
         exit(-1);
     }
     
-    unsigned int chunk;
+    // count differing bits with a word-wide XOR and population count;
+    // padding bits in the most-significant block are zero in both
+    // sequences and never differ
+    unsigned int num_diff = 0;
+    for (i=0; i<_bs1->s_len; i++)
+        num_diff += liquid_popcount_uint32( _bs1->s[i] ^ _bs2->s[i] );
 
-    for (i=0; i<_bs1->s_len; i++) {
-        //
-        chunk = _bs1->s[i] ^ _bs2->s[i];
-        chunk = ~chunk;
+    // number of matching bits
+    rxy = (signed int)_bs1->num_bits - (signed int)num_diff;
+    return rxy;
+}
 
-        rxy += liquid_count_ones(chunk);
+// Sliding cross-correlation: push each input bit into the receive
+// window and record the correlation against the reference after each
+// push, e.g. searching for code alignment during acquisition
+//  _bs1    :   fixed reference sequence
+//  _bs2    :   sliding receive window (same length as _bs1)
+//  _v      :   input bit array [size: _n x 1]
+//  _n      :   number of input bits
+//  _rxy    :   output correlation array [size: _n x 1]
+void bsequence_correlate_sliding(bsequence       _bs1,
+                                 bsequence       _bs2,
+                                 unsigned char * _v,
+                                 unsigned int    _n,
+                                 signed int *    _rxy)
+{
+    if ( _bs1->s_len != _bs2->s_len ) {
+        fprintf(stderr,"error: bsequence_correlate_sliding(), binary sequences must be the same length!\n");
+        exit(-1);
     }
 
-    // compensate for most-significant block and return
-    rxy -= 8*sizeof(unsigned int) - _bs1->num_bits_msb;
-    return rxy;
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<_n; i++) {
+        // push input bit into receive window
+        bsequence_push(_bs2, _v[i]);
+
+        // count differing bits over the packed storage
+        unsigned int num_diff = 0;
+        for (j=0; j<_bs1->s_len; j++)
+            num_diff += liquid_popcount_uint32( _bs1->s[j] ^ _bs2->s[j] );
+
+        _rxy[i] = (signed int)_bs1->num_bits - (signed int)num_diff;
+    }
 }
 
 // compute the binary addition of two bit sequences
@@ -93,6 +93,7 @@ msequence msequence_create(unsigned int _m,
     ms->n = (1<<_m)-1;  // sequence length, (2^m)-1
     ms->v = ms->a;      // shift register
     ms->b = 0;          // return bit
+    ms->am_len = 0;     // m-step leap table computed lazily
 
     return ms;
 }
@@ -192,6 +193,134 @@ unsigned int msequence_generate_symbol(msequence _ms,
     return s;
 }
 
+//
+// word-at-a-time generation
+//
+// The shift register update is linear over GF(2), so advancing the
+// state k steps is a binary matrix-vector product. Matrices are stored
+// as one row mask per state bit: new bit j is the binary dot product
+// of the old state and row j.
+//
+
+// initialize single-step state-transition matrix
+//  _ms     :   m-sequence object
+//  _A      :   output matrix [size: _ms->m x 1]
+static void msequence_init_matrix(msequence      _ms,
+                                  unsigned int * _A)
+{
+    // bit 0 is the feedback (generator polynomial) and bit j simply
+    // shifts up from bit j-1
+    unsigned int j;
+    _A[0] = _ms->g;
+    for (j=1; j<_ms->m; j++)
+        _A[j] = 1 << (j-1);
+}
+
+// multiply state-transition matrices over GF(2), C = A*B
+static void msequence_matrix_mul(unsigned int * _A,
+                                 unsigned int * _B,
+                                 unsigned int * _C,
+                                 unsigned int   _m)
+{
+    unsigned int j;
+    unsigned int k;
+    for (j=0; j<_m; j++) {
+        unsigned int r = 0;
+        for (k=0; k<_m; k++) {
+            if ((_A[j] >> k) & 1)
+                r ^= _B[k];
+        }
+        _C[j] = r;
+    }
+}
+
+// apply state-transition matrix to shift register state
+static unsigned int msequence_matrix_apply(unsigned int * _M,
+                                           unsigned int   _m,
+                                           unsigned int   _v)
+{
+    unsigned int j;
+    unsigned int v = 0;
+    for (j=0; j<_m; j++)
+        v |= liquid_bdotprod(_v, _M[j]) << j;
+    return v;
+}
+
+// generate block of bits, one bit per output element
+//  _ms     :   m-sequence object
+//  _v      :   output bit array [size: _n x 1]
+//  _n      :   number of bits to generate
+void msequence_generate_block(msequence       _ms,
+                              unsigned char * _v,
+                              unsigned int    _n)
+{
+    // lazily compute the m-step leap table A^m; after m steps the
+    // original register contents have shifted out entirely and the
+    // register holds exactly the last m output bits
+    if (_ms->am_len != _ms->m) {
+        unsigned int A[_ms->m];
+        unsigned int T[_ms->m];
+        unsigned int j;
+        msequence_init_matrix(_ms, A);
+        for (j=0; j<_ms->m; j++)
+            _ms->am[j] = 1 << j;    // identity
+        for (j=0; j<_ms->m; j++) {
+            msequence_matrix_mul(_ms->am, A, T, _ms->m);
+            memmove(_ms->am, T, _ms->m*sizeof(unsigned int));
+        }
+        _ms->am_len = _ms->m;
+    }
+
+    // advance m steps at a time, reading the m new output bits
+    // directly off the register (most significant bit first)
+    unsigned int i = 0;
+    unsigned int j;
+    while (i + _ms->m <= _n) {
+        _ms->v = msequence_matrix_apply(_ms->am, _ms->m, _ms->v);
+        for (j=0; j<_ms->m; j++)
+            _v[i+j] = (_ms->v >> (_ms->m-j-1)) & 1;
+        _ms->b = _ms->v & 1;
+        i += _ms->m;
+    }
+
+    // generate remaining bits one at a time
+    while (i < _n)
+        _v[i++] = msequence_advance(_ms);
+}
+
+// advance the internal state _n steps without generating output,
+// e.g. to split one code sequence across parallel generators
+//  _ms     :   m-sequence object
+//  _n      :   number of steps to advance
+void msequence_leap(msequence    _ms,
+                    unsigned int _n)
+{
+    // reduce by sequence period
+    _n %= _ms->n;
+
+    // compute A^n by binary exponentiation
+    unsigned int A[_ms->m];
+    unsigned int P[_ms->m];
+    unsigned int T[_ms->m];
+    unsigned int j;
+    msequence_init_matrix(_ms, A);
+    for (j=0; j<_ms->m; j++)
+        P[j] = 1 << j;  // identity
+    while (_n > 0) {
+        if (_n & 1) {
+            msequence_matrix_mul(P, A, T, _ms->m);
+            memmove(P, T, _ms->m*sizeof(unsigned int));
+        }
+        msequence_matrix_mul(A, A, T, _ms->m);
+        memmove(A, T, _ms->m*sizeof(unsigned int));
+        _n >>= 1;
+    }
+
+    // apply to shift register state
+    _ms->v = msequence_matrix_apply(P, _ms->m, _ms->v);
+    _ms->b = _ms->v & 1;
+}
+
 // reset msequence shift register to original state, typically '1'
 void msequence_reset(msequence _ms)
 {
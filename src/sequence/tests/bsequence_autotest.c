@@ -202,3 +202,46 @@ void autotest_bsequence_accumulate()
 }
 
 
+
+//
+// test sliding cross-correlation against per-lag correlation
+//
+void autotest_bsequence_correlate_sliding()
+{
+    // initialize reference on m-sequence (n = 63)
+    msequence ms = msequence_create_default(6);
+    unsigned int n = msequence_get_length(ms);
+    bsequence ref = bsequence_create(n);
+    bsequence_init_msequence(ref, ms);
+
+    // generate input stream: random lead-in followed by the sequence
+    unsigned int num_bits = 2*n;
+    unsigned char v[num_bits];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        v[i] = (i*i + 3*i + 1) % 2;
+    msequence_reset(ms);
+    for (i=0; i<n; i++)
+        v[n+i] = msequence_advance(ms);
+
+    // run sliding cross-correlation
+    bsequence rx = bsequence_create(n);
+    signed int rxy[num_bits];
+    bsequence_correlate_sliding(ref, rx, v, num_bits, rxy);
+
+    // compare to per-lag push/correlate reference
+    bsequence rx0 = bsequence_create(n);
+    for (i=0; i<num_bits; i++) {
+        bsequence_push(rx0, v[i]);
+        CONTEND_EQUALITY( rxy[i], bsequence_correlate(ref, rx0) );
+    }
+
+    // peak at alignment is the full sequence length
+    CONTEND_EQUALITY( rxy[num_bits-1], n );
+
+    // clean up memory
+    bsequence_destroy(ref);
+    bsequence_destroy(rx);
+    bsequence_destroy(rx0);
+    msequence_destroy(ms);
+}
@@ -92,3 +92,64 @@ void autotest_msequence_m10()   {   msequence_test_autocorrelation(10); }   // n
 void autotest_msequence_m11()   {   msequence_test_autocorrelation(11); }   // n = 2047
 void autotest_msequence_m12()   {   msequence_test_autocorrelation(12); }   // n = 4095
 
+
+// helper function to test block generation against bit-at-a-time advance
+void msequence_test_generate_block(unsigned int _m)
+{
+    // create two identical m-sequence objects
+    msequence ms0 = msequence_create_default(_m);
+    msequence ms1 = msequence_create_default(_m);
+
+    // generate more than one full period, with an uneven tail
+    unsigned int n = 2*msequence_get_length(ms0) + 7;
+    unsigned char v[n];
+    msequence_generate_block(ms0, v, n);
+
+    // block output matches bit-at-a-time advance
+    unsigned int i;
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( v[i], msequence_advance(ms1) );
+
+    // internal states match as well
+    CONTEND_EQUALITY( msequence_get_state(ms0), msequence_get_state(ms1) );
+
+    // clean up memory
+    msequence_destroy(ms0);
+    msequence_destroy(ms1);
+}
+
+void autotest_msequence_generate_block_m5()  { msequence_test_generate_block(5);  }
+void autotest_msequence_generate_block_m9()  { msequence_test_generate_block(9);  }
+void autotest_msequence_generate_block_m12() { msequence_test_generate_block(12); }
+
+// test leap-ahead against bit-at-a-time advance
+void autotest_msequence_leap()
+{
+    unsigned int leap = 379;
+
+    // create two identical m-sequence objects
+    msequence ms0 = msequence_create_default(10);
+    msequence ms1 = msequence_create_default(10);
+
+    // advance one object bit at a time, leap the other
+    unsigned int i;
+    for (i=0; i<leap; i++)
+        msequence_advance(ms0);
+    msequence_leap(ms1, leap);
+
+    // internal states match
+    CONTEND_EQUALITY( msequence_get_state(ms0), msequence_get_state(ms1) );
+
+    // subsequent output matches
+    for (i=0; i<64; i++)
+        CONTEND_EQUALITY( msequence_advance(ms0), msequence_advance(ms1) );
+
+    // leaping a full period returns to the same state
+    unsigned int v = msequence_get_state(ms1);
+    msequence_leap(ms1, msequence_get_length(ms1));
+    CONTEND_EQUALITY( msequence_get_state(ms1), v );
+
+    // clean up memory
+    msequence_destroy(ms0);
+    msequence_destroy(ms1);
+}
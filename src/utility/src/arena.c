@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// arena (region) allocator for object graphs and per-frame scratch
+//
+// Allocations are served by bumping a pointer within large contiguous
+// blocks, giving cache-friendly layout for groups of related objects and
+// O(1) release of everything at once via liquid_arena_clear().
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// all allocations are aligned to this boundary [bytes]
+#define LIQUID_ARENA_ALIGN (16UL)
+
+// optional user-installed backing allocator (default: malloc/free)
+static void * (*liquid_malloc_fn)(unsigned long int) = NULL;
+static void   (*liquid_free_fn)  (void *)            = NULL;
+
+// set backing allocator used for all subsequent arena block requests;
+// pass NULL for either argument to restore the default malloc/free
+void liquid_set_allocator(void * (*_malloc)(unsigned long int),
+                          void   (*_free)  (void *))
+{
+    liquid_malloc_fn = _malloc;
+    liquid_free_fn   = _free;
+}
+
+// internal block allocation through installed allocator
+static void * liquid_arena_block_alloc(unsigned long int _size)
+{
+    return liquid_malloc_fn == NULL ? malloc(_size) : liquid_malloc_fn(_size);
+}
+
+// internal block release through installed allocator
+static void liquid_arena_block_free(void * _p)
+{
+    if (liquid_free_fn == NULL)
+        free(_p);
+    else
+        liquid_free_fn(_p);
+}
+
+// arena block: header followed by raw storage
+struct liquid_arena_block_s {
+    struct liquid_arena_block_s * next;     // next (older) block in chain
+    unsigned char *               data;     // raw storage
+    unsigned long int             capacity; // storage size [bytes]
+    unsigned long int             index;    // bytes consumed
+};
+
+// internal structure
+struct liquid_arena_s {
+    struct liquid_arena_block_s * head;         // current block
+    unsigned long int             block_size;   // default block size [bytes]
+    unsigned long int             num_allocated;// total bytes served
+};
+
+// create new arena block with given capacity
+static struct liquid_arena_block_s * liquid_arena_create_block(unsigned long int _capacity)
+{
+    struct liquid_arena_block_s * b =
+        (struct liquid_arena_block_s *) liquid_arena_block_alloc(
+            sizeof(struct liquid_arena_block_s) + _capacity + LIQUID_ARENA_ALIGN);
+    if (b == NULL) {
+        fprintf(stderr,"error: liquid_arena, could not allocate block of %lu bytes\n", _capacity);
+        exit(1);
+    }
+    // align storage pointer past the header
+    unsigned long int addr = (unsigned long int) (b + 1);
+    addr = (addr + LIQUID_ARENA_ALIGN - 1) & ~(LIQUID_ARENA_ALIGN - 1);
+    b->next     = NULL;
+    b->data     = (unsigned char *) addr;
+    b->capacity = _capacity;
+    b->index    = 0;
+    return b;
+}
+
+// create arena allocator object
+//  _capacity : size of initial region [bytes]
+liquid_arena liquid_arena_create(unsigned long int _capacity)
+{
+    // validate input
+    if (_capacity == 0) {
+        fprintf(stderr,"error: liquid_arena_create(), capacity must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate memory for main object
+    liquid_arena q = (liquid_arena) malloc( sizeof(struct liquid_arena_s) );
+
+    q->block_size    = _capacity;
+    q->head          = liquid_arena_create_block(_capacity);
+    q->num_allocated = 0;
+    return q;
+}
+
+// destroy arena object, freeing all internal memory
+void liquid_arena_destroy(liquid_arena _q)
+{
+    struct liquid_arena_block_s * b = _q->head;
+    while (b != NULL) {
+        struct liquid_arena_block_s * next = b->next;
+        liquid_arena_block_free(b);
+        b = next;
+    }
+    free(_q);
+}
+
+// print arena object internals
+void liquid_arena_print(liquid_arena _q)
+{
+    printf("liquid_arena: block size %lu bytes, %lu bytes allocated\n",
+            _q->block_size, _q->num_allocated);
+    struct liquid_arena_block_s * b = _q->head;
+    while (b != NULL) {
+        printf("  block : %12lu / %12lu bytes\n", b->index, b->capacity);
+        b = b->next;
+    }
+}
+
+// allocate memory from arena; storage is valid until the arena is
+// cleared or destroyed and must not be passed to free()
+//  _q    : arena object
+//  _size : allocation size [bytes]
+void * liquid_arena_alloc(liquid_arena      _q,
+                          unsigned long int _size)
+{
+    // validate input
+    if (_size == 0) {
+        fprintf(stderr,"error: liquid_arena_alloc(), size must be greater than zero\n");
+        exit(1);
+    }
+
+    // round request up to alignment boundary
+    unsigned long int size = (_size + LIQUID_ARENA_ALIGN - 1) & ~(LIQUID_ARENA_ALIGN - 1);
+
+    // chain a new block when the current one cannot satisfy the request
+    if (_q->head->index + size > _q->head->capacity) {
+        unsigned long int capacity = size > _q->block_size ? size : _q->block_size;
+        struct liquid_arena_block_s * b = liquid_arena_create_block(capacity);
+        b->next  = _q->head;
+        _q->head = b;
+    }
+
+    // serve allocation by bumping block index
+    void * p = _q->head->data + _q->head->index;
+    _q->head->index   += size;
+    _q->num_allocated += size;
+    return p;
+}
+
+// release all allocations in O(1), retaining the largest region for reuse
+void liquid_arena_clear(liquid_arena _q)
+{
+    // keep the largest block (typically the most recently chained one)
+    // and release the rest
+    struct liquid_arena_block_s * keep = _q->head;
+    struct liquid_arena_block_s * b    = _q->head->next;
+    while (b != NULL) {
+        struct liquid_arena_block_s * next = b->next;
+        if (b->capacity > keep->capacity) {
+            liquid_arena_block_free(keep);
+            keep = b;
+        } else {
+            liquid_arena_block_free(b);
+        }
+        b = next;
+    }
+    keep->next       = NULL;
+    keep->index      = 0;
+    _q->head         = keep;
+    _q->num_allocated= 0;
+}
+
+// get total number of bytes currently allocated from arena
+unsigned long int liquid_arena_get_size(liquid_arena _q)
+{
+    return _q->num_allocated;
+}
@@ -33,7 +33,9 @@
 
 // count the number of ones in an integer
 unsigned int liquid_count_ones(unsigned int _x) {
-#if SIZEOF_INT == 2
+#if defined(__GNUC__)
+    return liquid_popcount_uint32(_x);
+#elif SIZEOF_INT == 2
     return liquid_count_ones_uint16(_x);
 #elif SIZEOF_INT == 4
     return liquid_count_ones_uint32(_x);
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// half-precision (IEEE 754 binary16) sample storage
+//
+// Values are carried as uint16_t and widened to single precision at the
+// processing boundary, halving the memory traffic of sample transport
+// in exchange for ~11 bits of mantissa -- ample headroom at monitoring
+// SNRs.  The conversions below are portable bit manipulation; compilers
+// targeting F16C or ARMv8.2 replace the pattern with the hardware
+// instructions at full optimization.
+//
+
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// convert half-precision value to single precision
+float liquid_fp16tof(uint16_t _h)
+{
+    uint32_t sign = ((uint32_t)(_h & 0x8000)) << 16;
+    uint32_t exp  = (_h >> 10) & 0x1f;
+    uint32_t mant =  _h        & 0x3ff;
+    uint32_t bits;
+    float f;
+
+    if (exp == 0) {
+        // zero or subnormal: reconstruct by scaled integer multiply
+        f = (float)mant * 0x1.0p-24f;
+        return (sign == 0) ? f : -f;
+    } else if (exp == 0x1f) {
+        // infinity or not-a-number
+        bits = sign | 0x7f800000 | (mant << 13);
+    } else {
+        // normal: re-bias exponent 15 -> 127
+        bits = sign | ((exp - 15 + 127) << 23) | (mant << 13);
+    }
+    memcpy(&f, &bits, sizeof(float));
+    return f;
+}
+
+// convert single-precision value to half precision (round to nearest
+// even, saturating to infinity)
+uint16_t liquid_ftofp16(float _f)
+{
+    uint32_t bits;
+    memcpy(&bits, &_f, sizeof(float));
+    uint16_t sign =  (bits >> 16) & 0x8000;
+    int      exp  = ((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mant =   bits        & 0x7fffff;
+
+    if (((bits >> 23) & 0xff) == 0xff) {
+        // infinity or not-a-number
+        return sign | 0x7c00 | (mant ? 0x200 : 0);
+    } else if (exp >= 0x1f) {
+        // overflow: saturate to infinity
+        return sign | 0x7c00;
+    } else if (exp <= 0) {
+        // subnormal half (or zero); values below the smallest
+        // subnormal flush to zero
+        if (exp < -10)
+            return sign;
+        mant |= 0x800000;
+        unsigned int shift = 14 - exp;
+        uint16_t h    = mant >> shift;
+        uint32_t rem  = mant & ((1U << shift) - 1);
+        uint32_t mid  = 1U << (shift - 1);
+        if (rem > mid || (rem == mid && (h & 1)))
+            h++;
+        return sign | h;
+    }
+
+    // normal: truncate mantissa to 10 bits with round to nearest even;
+    // a rounding carry propagates cleanly into the exponent field
+    uint16_t h   = (exp << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        h++;
+    return sign | h;
+}
+
+// convert block of half-precision values to single precision
+//  _h : input array [size: _n x 1]
+//  _n : array length
+//  _f : output array [size: _n x 1]
+void liquid_fp16tof_block(uint16_t *   _h,
+                          unsigned int _n,
+                          float *      _f)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _f[i] = liquid_fp16tof(_h[i]);
+}
+
+// convert block of single-precision values to half precision
+//  _f : input array [size: _n x 1]
+//  _n : array length
+//  _h : output array [size: _n x 1]
+void liquid_ftofp16_block(float *      _f,
+                          unsigned int _n,
+                          uint16_t *   _h)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _h[i] = liquid_ftofp16(_f[i]);
+}
+
+// internal chunk size for widening wrappers [complex samples]
+#define LIQUID_FP16_CHUNK (64)
+
+// execute filter on block of half-precision input samples, widening
+// internally
+//  _q : filter object
+//  _x : input buffer, interleaved half-precision i/q [size: 2 _n x 1]
+//  _y : output buffer [size: _n x 1]
+//  _n : number of complex samples
+void firfilt_crcf_execute_block_fp16(firfilt_crcf           _q,
+                                     uint16_t *             _x,
+                                     unsigned int           _n,
+                                     liquid_float_complex * _y)
+{
+    float complex buf[LIQUID_FP16_CHUNK];
+    unsigned int n = 0;
+    while (n < _n) {
+        unsigned int m = _n - n;
+        if (m > LIQUID_FP16_CHUNK)
+            m = LIQUID_FP16_CHUNK;
+        liquid_fp16tof_block(_x + 2*n, 2*m, (float*)buf);
+        firfilt_crcf_execute_block(_q, buf, m, _y + n);
+        n += m;
+    }
+}
+
+// execute channelizer on half-precision input, widening internally
+//  _q : channelizer object
+//  _x : input buffer, interleaved half-precision i/q
+//       [size: M x 1 (analyzer) or 2M x 1 (synthesizer) values]
+//  _y : channelizer output
+void firpfbch2_crcf_execute_fp16(firpfbch2_crcf         _q,
+                                 uint16_t *             _x,
+                                 liquid_float_complex * _y)
+{
+    unsigned int M = firpfbch2_crcf_get_M(_q);
+    unsigned int num_input = firpfbch2_crcf_get_type(_q) == LIQUID_ANALYZER ? M/2 : M;
+    float complex buf[num_input];
+    liquid_fp16tof_block(_x, 2*num_input, (float*)buf);
+    firpfbch2_crcf_execute(_q, buf, _y);
+}
+
+// write block of half-precision samples to spectral periodogram,
+// widening internally
+//  _q : spgram object
+//  _x : input buffer, interleaved half-precision i/q [size: 2 _n x 1]
+//  _n : input buffer length [complex samples]
+void spgramcf_write_fp16(spgramcf     _q,
+                         uint16_t *   _x,
+                         unsigned int _n)
+{
+    float complex buf[LIQUID_FP16_CHUNK];
+    unsigned int n = 0;
+    while (n < _n) {
+        unsigned int m = _n - n;
+        if (m > LIQUID_FP16_CHUNK)
+            m = LIQUID_FP16_CHUNK;
+        liquid_fp16tof_block(_x + 2*n, 2*m, (float*)buf);
+        spgramcf_write(_q, buf, m);
+        n += m;
+    }
+}
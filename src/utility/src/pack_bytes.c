@@ -200,21 +200,26 @@ void liquid_pack_bytes(unsigned char * _sym_in,
     unsigned int i;
     unsigned int N = 0;         // number of bytes written to output
     unsigned char byte = 0;
-    
-    for (i=0; i<_sym_in_len; i++) {
-        byte |= _sym_in[i] & 0x01;
-        
-        if ( (i+1)%8 == 0 ) {
-            _sym_out[N++] = byte;
-            byte = 0;
-        } else {
-            byte <<= 1;
-        }
+
+    // pack eight input symbols per output byte, branch-free
+    for (i=0; i+8<=_sym_in_len; i+=8) {
+        _sym_out[N++] = ((_sym_in[i  ] & 0x01) << 7) |
+                        ((_sym_in[i+1] & 0x01) << 6) |
+                        ((_sym_in[i+2] & 0x01) << 5) |
+                        ((_sym_in[i+3] & 0x01) << 4) |
+                        ((_sym_in[i+4] & 0x01) << 3) |
+                        ((_sym_in[i+5] & 0x01) << 2) |
+                        ((_sym_in[i+6] & 0x01) << 1) |
+                        ( _sym_in[i+7] & 0x01);
+    }
+
+    // pack remaining symbols, right-aligned in the final byte
+    if (i < _sym_in_len) {
+        for (; i<_sym_in_len; i++)
+            byte = (byte << 1) | (_sym_in[i] & 0x01);
+        _sym_out[N++] = byte;
     }
 
-    if ( i%8 != 0 )
-        _sym_out[N++] = byte >> 1;
-    
     *_num_written = N;
 }
 
@@ -289,52 +294,74 @@ void liquid_repack_bytes(unsigned char * _sym_in,
     }
     
     unsigned int i;
-    unsigned char s_in = 0;     // input symbol
-    unsigned char s_out = 0;    // output symbol
-
-    // there is probably a more efficient way to do this, but...
-    unsigned int total_bits = _sym_in_len*_sym_in_bps;
-    unsigned int i_in = 0;  // input index counter
-    unsigned int i_out = 0; // output index counter
-    unsigned int k=0;       // input symbol enable
-    unsigned int n=0;       // output symbol enable
-    unsigned int v;         // bit mask
-
-    for (i=0; i<total_bits; i++) {
-        // shift output symbol by one bit
-        s_out <<= 1;
-
-        // pop input if necessary
-        if ( k == 0 ) {
-            //printf("\n\n_sym_in[%d] = %d", i_in, _sym_in[i_in]);
-            s_in = _sym_in[i_in++];
-        }
+    unsigned int j;
+    unsigned char mask_in  = (1 << _sym_in_bps ) - 1;
+    unsigned char mask_out = (1 << _sym_out_bps) - 1;
+
+    // fast path: symbol sizes match; copy (masking any stray high bits)
+    if (_sym_in_bps == _sym_out_bps) {
+        for (i=0; i<_sym_in_len; i++)
+            _sym_out[i] = _sym_in[i] & mask_in;
+        *_num_written = _sym_in_len;
+        return;
+    }
 
-        // compute shift amount and append input bit at index
-        // to output symbol
-        v = _sym_in_bps - k - 1;
-        s_out |= (s_in >> v) & 0x01;
-        //printf("\n    b = %d, v = %d, s_in = %d, sym_out = %d", (sym_in >> v) & 0x01, v, s_in, sym_out );
-
-        // push output if available    
-        if ( n == _sym_out_bps-1 ) {
-            //printf("\n  _sym_out[%d] = %d", i_out, sym_out);
-            _sym_out[i_out++] = s_out;
-            s_out = 0;
+    // fast path: each input symbol splits evenly into output symbols
+    // (e.g. common 8-bit bytes to 1-, 2-, or 4-bit modem symbols)
+    if ( (_sym_in_bps % _sym_out_bps) == 0 ) {
+        unsigned int m = _sym_in_bps / _sym_out_bps; // outputs per input
+        unsigned int n = 0;
+        for (i=0; i<_sym_in_len; i++) {
+            unsigned char s = _sym_in[i];
+            for (j=0; j<m; j++)
+                _sym_out[n++] = (s >> (_sym_in_bps - (j+1)*_sym_out_bps)) & mask_out;
         }
+        *_num_written = n;
+        return;
+    }
 
-        // update input/output symbol pop/push flags
-        k = (k+1) % _sym_in_bps;
-        n = (n+1) % _sym_out_bps;
+    // fast path: input symbols combine evenly into output symbols and
+    // the input length divides cleanly (no partial tail symbol)
+    if ( (_sym_out_bps % _sym_in_bps) == 0 &&
+         (_sym_in_len % (_sym_out_bps/_sym_in_bps)) == 0 )
+    {
+        unsigned int m = _sym_out_bps / _sym_in_bps; // inputs per output
+        unsigned int n = 0;
+        for (i=0; i<_sym_in_len; i+=m) {
+            unsigned char s = 0;
+            for (j=0; j<m; j++)
+                s = (s << _sym_in_bps) | (_sym_in[i+j] & mask_in);
+            _sym_out[n++] = s;
+        }
+        *_num_written = n;
+        return;
     }
 
-    // if uneven, push zeros into remaining output symbol
-    if (i_out != req__sym_out_len) {
-        for (i=n; i<_sym_out_bps; i++)
-            s_out <<= 1;
-        _sym_out[i_out++] = s_out;
+    // general case: run symbols through a word-level bit accumulator,
+    // one shift/mask per symbol rather than one per bit
+    unsigned int acc      = 0;  // bit accumulator
+    unsigned int num_bits = 0;  // number of bits in accumulator
+    unsigned int i_in  = 0;     // input index counter
+    unsigned int i_out = 0;     // output index counter
+
+    while (i_out < req__sym_out_len) {
+        // fill accumulator until an output symbol is available
+        while (num_bits < _sym_out_bps && i_in < _sym_in_len) {
+            acc = (acc << _sym_in_bps) | (_sym_in[i_in++] & mask_in);
+            num_bits += _sym_in_bps;
+        }
+
+        if (num_bits >= _sym_out_bps) {
+            // pop output symbol off the top of the accumulator
+            num_bits -= _sym_out_bps;
+            _sym_out[i_out++] = (acc >> num_bits) & mask_out;
+        } else {
+            // input exhausted: pad remaining bits with zeros
+            _sym_out[i_out++] = (acc << (_sym_out_bps-num_bits)) & mask_out;
+            num_bits = 0;
+        }
     }
-    
+
     *_num_written = i_out;
 }
 
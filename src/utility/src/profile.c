@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// cycle-count instrumentation for hot execute paths
+//
+// Region timers are placed at stage boundaries inside selected execute
+// functions (see LIQUID_PROFILE_BEGIN/END in liquid.internal.h); the
+// hooks compile to nothing unless the library is built with
+// ./configure --enable-profile.
+//
+
+#include <stdio.h>
+#include <time.h>
+
+#include "liquid.internal.h"
+
+// timer names, ordered to match identifiers in liquid.internal.h
+static const char * liquid_profile_timer_names[LIQUID_PROFILE_NUM_TIMERS] = {
+    "fft_execute",
+    "firpfbch2_execute (analyzer)",
+    "firpfbch2_execute (synthesizer)",
+    "msresamp_execute (arbitrary)",
+    "msresamp_execute (halfband)",
+    "flexframesync_execute (seekpn)",
+    "flexframesync_execute (rxpreamble)",
+    "flexframesync_execute (rxheader)",
+    "flexframesync_execute (rxpayload)",
+};
+
+// accumulated counters
+static unsigned long long int liquid_profile_num_calls[LIQUID_PROFILE_NUM_TIMERS] = {0};
+static unsigned long long int liquid_profile_num_cycles[LIQUID_PROFILE_NUM_TIMERS] = {0};
+
+// read time-stamp counter
+unsigned long long int liquid_profile_tic(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    unsigned int lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((unsigned long long int)hi << 32) | lo;
+#else
+    // fall back to monotonic clock [ns] on targets without a
+    // user-accessible cycle counter
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long int)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+// accumulate elapsed cycles into timer
+//  _timer : timer identifier (e.g. LIQUID_PROFILE_TIMER_FFT_EXECUTE)
+//  _tic   : counter value captured at region entry
+void liquid_profile_toc(int                    _timer,
+                        unsigned long long int _tic)
+{
+    liquid_profile_num_calls [_timer] += 1;
+    liquid_profile_num_cycles[_timer] += liquid_profile_tic() - _tic;
+}
+
+// reset all profile counters
+void liquid_profile_reset(void)
+{
+    int i;
+    for (i=0; i<LIQUID_PROFILE_NUM_TIMERS; i++) {
+        liquid_profile_num_calls [i] = 0;
+        liquid_profile_num_cycles[i] = 0;
+    }
+}
+
+// print accumulated profile counters to stdout
+void liquid_profile_report(void)
+{
+#if !defined LIQUID_PROFILE
+    printf("liquid_profile_report(): instrumentation not compiled in; rebuild with ./configure --enable-profile\n");
+#endif
+    printf("%-36s %12s %16s %12s\n", "region", "calls", "cycles", "cycles/call");
+    int i;
+    for (i=0; i<LIQUID_PROFILE_NUM_TIMERS; i++) {
+        unsigned long long int n = liquid_profile_num_calls[i];
+        printf("%-36s %12llu %16llu %12.1f\n",
+                liquid_profile_timer_names[i],
+                n,
+                liquid_profile_num_cycles[i],
+                n==0 ? 0.0f : (double)liquid_profile_num_cycles[i] / (double)n);
+    }
+}
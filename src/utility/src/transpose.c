@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// transpose.c
+//
+// cache-oblivious blocked out-of-place matrix transpose (corner turn),
+// e.g. between a channelizer's per-step channel vectors and per-channel
+// sample runs; the recursion splits the larger dimension until a tile
+// fits comfortably in cache, and the base tile is a simple double loop
+// the compiler can vectorize
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+// stop splitting once both dimensions are at or below this tile size
+#define LIQUID_TRANSPOSE_TILE (16)
+
+// stamp out the recursive kernel and strided/contiguous front ends for
+// a given element type T with name suffix EXT
+#define LIQUID_TRANSPOSE_DEFINE(EXT,T)                                      \
+                                                                            \
+/* transpose sub-block: _y[c][r] = _x[r][c] over _r x _c elements,      */  \
+/* with row strides _xs (input) and _ys (output)                        */  \
+static void liquid_transpose_##EXT##_recurse(const T *    _x,               \
+                                             unsigned int _r,               \
+                                             unsigned int _c,               \
+                                             unsigned int _xs,              \
+                                             T *          _y,               \
+                                             unsigned int _ys)              \
+{                                                                           \
+    if (_r > LIQUID_TRANSPOSE_TILE || _c > LIQUID_TRANSPOSE_TILE) {         \
+        /* split the larger dimension and recurse on each half */           \
+        if (_r >= _c) {                                                     \
+            unsigned int r0 = _r/2;                                         \
+            liquid_transpose_##EXT##_recurse(_x, r0,    _c, _xs,            \
+                                             _y,            _ys);           \
+            liquid_transpose_##EXT##_recurse(_x + (unsigned long int)r0*_xs,\
+                                             _r-r0, _c, _xs,                \
+                                             _y + r0,       _ys);           \
+        } else {                                                            \
+            unsigned int c0 = _c/2;                                         \
+            liquid_transpose_##EXT##_recurse(_x,        _r, c0,    _xs,     \
+                                             _y,            _ys);           \
+            liquid_transpose_##EXT##_recurse(_x + c0,   _r, _c-c0, _xs,     \
+                                             _y + (unsigned long int)c0*_ys,\
+                                             _ys);                          \
+        }                                                                   \
+        return;                                                             \
+    }                                                                       \
+                                                                            \
+    /* base tile: direct double loop */                                     \
+    unsigned int i;                                                         \
+    unsigned int j;                                                         \
+    for (i=0; i<_r; i++) {                                                  \
+        for (j=0; j<_c; j++)                                                \
+            _y[j*_ys + i] = _x[i*_xs + j];                                  \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+/* strided transpose front end with input validation */                     \
+void liquid_transpose_##EXT##_strided(const T *    _x,                      \
+                                      unsigned int _r,                      \
+                                      unsigned int _c,                      \
+                                      unsigned int _xs,                     \
+                                      T *          _y,                      \
+                                      unsigned int _ys)                     \
+{                                                                           \
+    /* validate input */                                                    \
+    if (_r == 0 || _c == 0) {                                               \
+        fprintf(stderr,"error: liquid_transpose_" #EXT "_strided(), dimensions must be greater than zero\n"); \
+        exit(1);                                                            \
+    } else if (_xs < _c || _ys < _r) {                                      \
+        fprintf(stderr,"error: liquid_transpose_" #EXT "_strided(), strides cannot be smaller than row lengths\n"); \
+        exit(1);                                                            \
+    }                                                                       \
+                                                                            \
+    liquid_transpose_##EXT##_recurse(_x, _r, _c, _xs, _y, _ys);             \
+}                                                                           \
+                                                                            \
+/* contiguous transpose front end */                                        \
+void liquid_transpose_##EXT(const T *    _x,                                \
+                            unsigned int _r,                                \
+                            unsigned int _c,                                \
+                            T *          _y)                                \
+{                                                                           \
+    liquid_transpose_##EXT##_strided(_x, _r, _c, _c, _y, _r);               \
+}
+
+// define kernels for real and complex floating-point samples
+LIQUID_TRANSPOSE_DEFINE(f,  float)
+LIQUID_TRANSPOSE_DEFINE(cf, float complex)
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// tune.c
+//
+// microbenchmark-driven engine selection: liquid_tune() times candidate
+// kernels on the running machine and records the winners in a
+// process-wide table which create functions with an engine choice
+// (e.g. firfilt_xxxt_create_auto, fskdem_create_auto) consult. The
+// table can be exported after a tuning pass and imported at start-up
+// so production boots skip the benchmarks entirely.
+//
+// The table is not protected by a lock; tune or import before spawning
+// worker threads.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+struct liquid_tune_entry_s {
+    int          op;        // operation identifier (liquid_tune_op)
+    unsigned int size;      // problem size the entry was measured at
+    int          choice;    // selected engine
+};
+
+// process-wide tuning table
+static struct liquid_tune_entry_s * liquid_tune_table       = NULL;
+static unsigned int                 liquid_tune_num_entries = 0;
+static unsigned int                 liquid_tune_capacity    = 0;
+
+// record engine choice for an operation at a particular size,
+// replacing any previous entry for the same operation and size
+int liquid_tune_set(int          _op,
+                    unsigned int _size,
+                    int          _choice)
+{
+    // validate input
+    if (_op < 0 || _op >= LIQUID_TUNE_NUM_OPS) {
+        fprintf(stderr,"error: liquid_tune_set(), invalid operation (%d)\n", _op);
+        return -1;
+    }
+
+    // replace existing entry
+    unsigned int i;
+    for (i=0; i<liquid_tune_num_entries; i++) {
+        if (liquid_tune_table[i].op == _op && liquid_tune_table[i].size == _size) {
+            liquid_tune_table[i].choice = _choice;
+            return 0;
+        }
+    }
+
+    // append, growing table as needed
+    if (liquid_tune_num_entries == liquid_tune_capacity) {
+        liquid_tune_capacity = liquid_tune_capacity == 0 ? 16 : 2*liquid_tune_capacity;
+        liquid_tune_table = (struct liquid_tune_entry_s*) realloc(liquid_tune_table,
+                liquid_tune_capacity*sizeof(struct liquid_tune_entry_s));
+    }
+    liquid_tune_table[liquid_tune_num_entries].op     = _op;
+    liquid_tune_table[liquid_tune_num_entries].size   = _size;
+    liquid_tune_table[liquid_tune_num_entries].choice = _choice;
+    liquid_tune_num_entries++;
+    return 0;
+}
+
+// look up engine choice for an operation, matching the entry measured
+// at the nearest size (log scale); returns -1 when the table holds no
+// entry for the operation so callers fall back to a static default
+int liquid_tune_get(int          _op,
+                    unsigned int _size)
+{
+    int    choice   = -1;
+    double dist_min = 0.0;
+    unsigned int i;
+    for (i=0; i<liquid_tune_num_entries; i++) {
+        if (liquid_tune_table[i].op != _op)
+            continue;
+        double dist = fabs( log( (double)_size / (double)liquid_tune_table[i].size ) );
+        if (choice == -1 || dist < dist_min) {
+            choice   = liquid_tune_table[i].choice;
+            dist_min = dist;
+        }
+    }
+    return choice;
+}
+
+// discard all recorded choices
+void liquid_tune_clear(void)
+{
+    free(liquid_tune_table);
+    liquid_tune_table       = NULL;
+    liquid_tune_num_entries = 0;
+    liquid_tune_capacity    = 0;
+}
+
+// print tuning table
+void liquid_tune_print(void)
+{
+    printf("liquid tune table [%u entries]:\n", liquid_tune_num_entries);
+    unsigned int i;
+    for (i=0; i<liquid_tune_num_entries; i++) {
+        printf("  op %2d, size %8u : %d\n",
+                liquid_tune_table[i].op,
+                liquid_tune_table[i].size,
+                liquid_tune_table[i].choice);
+    }
+}
+
+// export tuning table to file so production boots can import it and
+// skip the tuning pass
+int liquid_tune_export(const char * _filename)
+{
+    FILE * fid = fopen(_filename, "w");
+    if (fid == NULL) {
+        fprintf(stderr,"error: liquid_tune_export(), could not open '%s' for writing\n", _filename);
+        return -1;
+    }
+    unsigned int i;
+    for (i=0; i<liquid_tune_num_entries; i++) {
+        fprintf(fid,"%d %u %d\n",
+                liquid_tune_table[i].op,
+                liquid_tune_table[i].size,
+                liquid_tune_table[i].choice);
+    }
+    fclose(fid);
+    return 0;
+}
+
+// import tuning table from file, merging entries into the table
+int liquid_tune_import(const char * _filename)
+{
+    FILE * fid = fopen(_filename, "r");
+    if (fid == NULL) {
+        fprintf(stderr,"error: liquid_tune_import(), could not open '%s' for reading\n", _filename);
+        return -1;
+    }
+    int          op;
+    unsigned int size;
+    int          choice;
+    while (fscanf(fid,"%d %u %d", &op, &size, &choice) == 3)
+        liquid_tune_set(op, size, choice);
+    fclose(fid);
+    return 0;
+}
+
+//
+// microbenchmarks
+//
+
+// time one firfilt engine processing a sample stream
+//  _n  : filter length
+//  _fd : frequency-domain engine?
+// returns elapsed ticks per sample
+static double liquid_tune_bench_firfilt(unsigned int _n,
+                                        int          _fd)
+{
+    unsigned int block = 2048;  // samples per repetition
+    unsigned int reps  = 8;     // timed repetitions
+    unsigned int i;
+
+    // random coefficients and input buffer
+    float * h = (float*) malloc(_n*sizeof(float));
+    for (i=0; i<_n; i++)
+        h[i] = randnf();
+    float complex * buf = (float complex*) malloc(block*sizeof(float complex));
+    for (i=0; i<block; i++)
+        buf[i] = randnf() + _Complex_I*randnf();
+
+    unsigned long long int tic;
+    unsigned long long int toc;
+    unsigned long long int num_samples = 0;
+    if (_fd) {
+        // frequency-domain engine with the block size the firfilt
+        // auto implementation would choose
+        unsigned int n2 = 1;
+        while (n2 < 2*(_n-1))
+            n2 <<= 1;
+        fftfilt_crcf f = fftfilt_crcf_create(h, _n, n2);
+        unsigned int num_blocks = (reps*block)/n2 + 1;
+        fftfilt_crcf_execute(f, buf, buf);  // warm up
+        tic = liquid_profile_tic();
+        for (i=0; i<num_blocks; i++)
+            fftfilt_crcf_execute(f, buf, buf);
+        toc = liquid_profile_tic();
+        num_samples = (unsigned long long int)num_blocks*n2;
+        fftfilt_crcf_destroy(f);
+    } else {
+        firfilt_crcf f = firfilt_crcf_create(h, _n);
+        firfilt_crcf_execute_block(f, buf, block, buf);  // warm up
+        tic = liquid_profile_tic();
+        for (i=0; i<reps; i++)
+            firfilt_crcf_execute_block(f, buf, block, buf);
+        toc = liquid_profile_tic();
+        num_samples = (unsigned long long int)reps*block;
+        firfilt_crcf_destroy(f);
+    }
+
+    free(h);
+    free(buf);
+    return (double)(toc - tic) / (double)num_samples;
+}
+
+// time one fskdem engine demodulating symbols
+//  _m        : bits per symbol
+//  _k        : samples per symbol
+//  _goertzel : Goertzel engine?
+// returns elapsed ticks per symbol
+static double liquid_tune_bench_fskdem(unsigned int _m,
+                                       unsigned int _k,
+                                       int          _goertzel)
+{
+    unsigned int reps = 2000;
+    unsigned int i;
+
+    fskdem q = _goertzel ? fskdem_create_goertzel(_m, _k, 0.45f) :
+                           fskdem_create         (_m, _k, 0.45f);
+
+    float complex * buf = (float complex*) malloc(_k*sizeof(float complex));
+    for (i=0; i<_k; i++)
+        buf[i] = randnf() + _Complex_I*randnf();
+
+    fskdem_demodulate(q, buf);  // warm up
+    unsigned long long int tic = liquid_profile_tic();
+    for (i=0; i<reps; i++)
+        fskdem_demodulate(q, buf);
+    unsigned long long int toc = liquid_profile_tic();
+
+    fskdem_destroy(q);
+    free(buf);
+    return (double)(toc - tic) / (double)reps;
+}
+
+// time candidate kernels on the running machine and record the winners
+// in the process-wide table; create functions with an engine choice
+// consult it through liquid_tune_get()
+int liquid_tune(void)
+{
+    unsigned int i;
+
+    // firfilt: time- vs frequency-domain block execute crossover
+    unsigned int firfilt_sizes[7] = {16, 32, 64, 128, 256, 512, 1024};
+    for (i=0; i<7; i++) {
+        unsigned int n = firfilt_sizes[i];
+        double td = liquid_tune_bench_firfilt(n, 0);
+        double fd = liquid_tune_bench_firfilt(n, 1);
+        liquid_tune_set(LIQUID_TUNE_FIRFILT, n, fd < td ? 1 : 0);
+    }
+
+    // fskdem: FFT vs Goertzel tone-bank engine across constellation
+    // sizes and oversampling rates
+    unsigned int fskdem_params[5][2] = {{1,4}, {2,8}, {3,16}, {4,32}, {4,64}};
+    for (i=0; i<5; i++) {
+        unsigned int m = fskdem_params[i][0];
+        unsigned int k = fskdem_params[i][1];
+        double t_fft = liquid_tune_bench_fskdem(m, k, 0);
+        double t_gtz = liquid_tune_bench_fskdem(m, k, 1);
+        liquid_tune_set(LIQUID_TUNE_FSKDEM, (m<<16)|k, t_gtz < t_fft ? 1 : 0);
+    }
+
+    return 0;
+}
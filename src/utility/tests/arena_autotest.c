@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: basic allocation, alignment, and O(1) clear
+//
+void autotest_liquid_arena()
+{
+    unsigned int i;
+    unsigned int j;
+
+    // create arena with a small initial region to exercise block chaining
+    liquid_arena arena = liquid_arena_create(256);
+
+    // allocations are non-overlapping, aligned, and writable
+    unsigned int  num_allocs = 40;
+    unsigned char * p[num_allocs];
+    for (i=0; i<num_allocs; i++) {
+        unsigned long int size = 17*i + 5;
+        p[i] = (unsigned char*) liquid_arena_alloc(arena, size);
+        CONTEND_EQUALITY( ((unsigned long int)p[i]) % 16, 0 );
+        memset(p[i], i, size);
+    }
+
+    // contents survive subsequent allocations (regions do not overlap)
+    for (i=0; i<num_allocs; i++) {
+        unsigned long int size = 17*i + 5;
+        unsigned int num_errors = 0;
+        for (j=0; j<size; j++)
+            num_errors += p[i][j] == (unsigned char)i ? 0 : 1;
+        CONTEND_EQUALITY( num_errors, 0 );
+    }
+    CONTEND_GREATER_THAN( liquid_arena_get_size(arena), 0 );
+
+    // clear releases everything at once and allocation resumes
+    liquid_arena_clear(arena);
+    CONTEND_EQUALITY( liquid_arena_get_size(arena), 0 );
+    unsigned char * r = (unsigned char*) liquid_arena_alloc(arena, 64);
+    memset(r, 0, 64);
+
+    // over-sized request (larger than block size) is still served
+    unsigned char * big = (unsigned char*) liquid_arena_alloc(arena, 10000);
+    memset(big, 0xa5, 10000);
+    CONTEND_EQUALITY( big[9999], 0xa5 );
+
+    liquid_arena_destroy(arena);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: half-precision conversion, exact and rounded values
+//
+void autotest_fp16_convert()
+{
+    unsigned int i;
+
+    // values exactly representable in binary16 convert without error
+    float v_exact[] = {0.0f, 1.0f, -1.0f, 0.5f, -2.25f, 1024.0f, 0.09375f};
+    for (i=0; i<sizeof(v_exact)/sizeof(float); i++)
+        CONTEND_EQUALITY( liquid_fp16tof(liquid_ftofp16(v_exact[i])), v_exact[i] );
+
+    // round trip of random values incurs at most half-ulp relative
+    // error (2^-11)
+    for (i=0; i<1000; i++) {
+        float v = randnf();
+        float r = liquid_fp16tof(liquid_ftofp16(v));
+        CONTEND_DELTA( r, v, fabsf(v)*0x1.0p-11f + 1e-7f );
+    }
+
+    // overflow saturates to infinity
+    CONTEND_EQUALITY( isinf(liquid_fp16tof(liquid_ftofp16( 1e6f))),  1 );
+    CONTEND_LESS_THAN( liquid_fp16tof(liquid_ftofp16(-1e6f)), 0.0f );
+}
+
+//
+// AUTOTEST: half-precision filter input matches single-precision path
+//
+void autotest_fp16_firfilt()
+{
+    float        tol = 2e-3f;   // error tolerance (fp16 quantization)
+    unsigned int n   = 200;     // number of samples
+    unsigned int i;
+
+    // design prototype filter
+    firfilt_crcf q0 = firfilt_crcf_create_kaiser(21, 0.3f, 60.0f, 0.0f);
+    firfilt_crcf q1 = firfilt_crcf_create_kaiser(21, 0.3f, 60.0f, 0.0f);
+
+    // generate random input and its half-precision image
+    float complex x[n];
+    uint16_t      x16[2*n];
+    for (i=0; i<n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    liquid_ftofp16_block((float*)x, 2*n, x16);
+
+    // run both paths
+    float complex y0[n];
+    float complex y1[n];
+    firfilt_crcf_execute_block     (q0, x,      n, y0);
+    firfilt_crcf_execute_block_fp16(q1, x16,    n, y1);
+
+    // compare
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+//
+// AUTOTEST: half-precision periodogram input matches single precision
+//
+void autotest_fp16_spgram()
+{
+    float        tol  = 0.1f;   // error tolerance [dB]
+    unsigned int nfft = 64;     // transform size
+    unsigned int n    = 4096;   // number of samples
+    unsigned int i;
+
+    spgramcf q0 = spgramcf_create_default(nfft);
+    spgramcf q1 = spgramcf_create_default(nfft);
+
+    // complex sinusoid in noise, and its half-precision image
+    float complex x[n];
+    uint16_t      x16[2*n];
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*2*M_PI*0.2f*i) + 0.1f*(randnf() + _Complex_I*randnf());
+    liquid_ftofp16_block((float*)x, 2*n, x16);
+
+    spgramcf_write     (q0, x,   n);
+    spgramcf_write_fp16(q1, x16, n);
+
+    float psd_0[nfft];
+    float psd_1[nfft];
+    spgramcf_get_psd(q0, psd_0);
+    spgramcf_get_psd(q1, psd_1);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA( psd_0[i], psd_1[i], tol );
+
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+}
@@ -291,5 +291,39 @@ void autotest_repack_bytes_04_uneven() {
     CONTEND_SAME_DATA( output, output_test, 5 );
 }
 
+// round trip random data through every symbol-size combination,
+// exercising both the even-split fast paths and the general case
+void autotest_repack_bytes_05_roundtrip() {
+    unsigned int bps_in;
+    unsigned int bps_out;
+    unsigned int len;
+    unsigned int i;
+
+    for (bps_in=1; bps_in<=8; bps_in++) {
+    for (bps_out=1; bps_out<=8; bps_out++) {
+    // even and uneven input lengths
+    for (len=61; len<=64; len+=3) {
+        unsigned char src[64];
+        unsigned char mid[512];
+        unsigned char dst[512];
+        unsigned int num_mid;
+        unsigned int num_dst;
+
+        for (i=0; i<len; i++)
+            src[i] = rand() & ((1<<bps_in)-1);
+
+        liquid_repack_bytes(src, bps_in,  len,     mid, bps_out, 512, &num_mid);
+        liquid_repack_bytes(mid, bps_out, num_mid, dst, bps_in,  512, &num_dst);
+
+        // original symbols are recovered; padding yields zero symbols
+        CONTEND_EXPRESSION( num_dst >= len );
+        CONTEND_SAME_DATA( src, dst, len );
+        for (i=len; i<num_dst; i++)
+            CONTEND_EQUALITY( dst[i], 0 );
+    }
+    }
+    }
+}
+
 
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// blocked transpose matches the naive element-by-element corner turn
+void testbench_transpose_cf(unsigned int _r,
+                            unsigned int _c)
+{
+    unsigned int i;
+    unsigned int j;
+
+    // initialize input with distinct values
+    float complex * x = (float complex*) malloc(_r*_c*sizeof(float complex));
+    float complex * y = (float complex*) malloc(_r*_c*sizeof(float complex));
+    for (i=0; i<_r*_c; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // transpose and compare to direct indexing
+    liquid_transpose_cf(x, _r, _c, y);
+    for (i=0; i<_r; i++) {
+        for (j=0; j<_c; j++)
+            CONTEND_EQUALITY( y[j*_r + i], x[i*_c + j] );
+    }
+
+    free(x);
+    free(y);
+}
+
+// exercise square, rectangular, degenerate, and non-tile-aligned sizes
+void autotest_transpose_cf_64_64() { testbench_transpose_cf(64, 64); }
+void autotest_transpose_cf_16_80() { testbench_transpose_cf(16, 80); }
+void autotest_transpose_cf_13_37() { testbench_transpose_cf(13, 37); }
+void autotest_transpose_cf_1_100() { testbench_transpose_cf( 1,100); }
+
+// strided variant operating on matrices embedded in larger buffers
+void autotest_transpose_f_strided()
+{
+    unsigned int r  = 24;   // input rows
+    unsigned int c  = 40;   // input columns
+    unsigned int xs = 50;   // input row stride
+    unsigned int ys = 30;   // output row stride
+    unsigned int i;
+    unsigned int j;
+
+    // initialize padded buffers, tagging the padding
+    float * x = (float*) malloc(r *xs*sizeof(float));
+    float * y = (float*) malloc(c *ys*sizeof(float));
+    for (i=0; i<r*xs; i++) x[i] = (float)i;
+    for (i=0; i<c*ys; i++) y[i] = -1.0f;
+
+    // transpose the embedded r x c sub-matrix
+    liquid_transpose_f_strided(x, r, c, xs, y, ys);
+
+    // verify transposed elements and untouched padding
+    for (i=0; i<c; i++) {
+        for (j=0; j<ys; j++) {
+            if (j < r) {
+                CONTEND_EQUALITY( y[i*ys + j], x[j*xs + i] );
+            } else {
+                CONTEND_EQUALITY( y[i*ys + j], -1.0f );
+            }
+        }
+    }
+
+    free(x);
+    free(y);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// tuning table: exact and nearest-size lookup, replacement, clearing
+void autotest_tune_table()
+{
+    liquid_tune_clear();
+
+    // empty table falls back to -1
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT, 64), -1 );
+
+    liquid_tune_set(LIQUID_TUNE_FIRFILT,  32, 0);
+    liquid_tune_set(LIQUID_TUNE_FIRFILT, 256, 1);
+
+    // exact matches
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT,  32), 0 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT, 256), 1 );
+
+    // nearest size on a log scale, extrapolating past the measured range
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT,   48), 0 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT,  200), 1 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT, 4096), 1 );
+
+    // operations are independent
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FSKDEM, 32), -1 );
+
+    // setting an existing entry replaces it
+    liquid_tune_set(LIQUID_TUNE_FIRFILT, 32, 1);
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT, 32), 1 );
+
+    // invalid operation rejected
+    CONTEND_EQUALITY( liquid_tune_set(LIQUID_TUNE_NUM_OPS, 32, 0), -1 );
+
+    liquid_tune_clear();
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT, 32), -1 );
+}
+
+// exported table imports back identically
+void autotest_tune_export_import()
+{
+    const char filename[] = "autotest_tune.tab";
+
+    liquid_tune_clear();
+    liquid_tune_set(LIQUID_TUNE_FIRFILT,          64, 0);
+    liquid_tune_set(LIQUID_TUNE_FIRFILT,         512, 1);
+    liquid_tune_set(LIQUID_TUNE_FSKDEM,  (2<<16) | 8, 1);
+    CONTEND_EQUALITY( liquid_tune_export(filename), 0 );
+
+    // re-import into an empty table
+    liquid_tune_clear();
+    CONTEND_EQUALITY( liquid_tune_import(filename), 0 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT,         64), 0 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT,        512), 1 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FSKDEM, (2<<16) | 8), 1 );
+
+    // importing a missing file fails cleanly
+    CONTEND_EQUALITY( liquid_tune_import("autotest_tune_missing.tab"), -1 );
+
+    liquid_tune_clear();
+    remove(filename);
+}
+
+// full tuning pass records a choice for every operation
+void autotest_tune()
+{
+    liquid_tune_clear();
+    liquid_tune();
+    if (liquid_autotest_verbose)
+        liquid_tune_print();
+
+    // every operation has at least one measured entry
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT,           128) != -1, 1 );
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FSKDEM,  (4<<16) |  32) != -1, 1 );
+
+    // very long filters always favor the frequency-domain engine
+    CONTEND_EQUALITY( liquid_tune_get(LIQUID_TUNE_FIRFILT, 1024), 1 );
+
+    // restore default (untuned) behavior for the remaining tests
+    liquid_tune_clear();
+}
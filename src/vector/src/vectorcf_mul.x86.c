@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorcf_mul.x86.c : complex vector multiplication (x86, run-time dispatch)
+//
+// Each 128-bit register holds two interleaved complex values; the
+// complex product is formed with duplicated real/imaginary parts and
+// an add/subtract instruction (SSE3).
+//
+
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+// SSE3 kernel: two complex values per register
+__attribute__((target("sse3")))
+static void liquid_vectorcf_mul_sse3(float complex * _x,
+                                     float complex * _y,
+                                     unsigned int    _n,
+                                     float complex * _z)
+{
+    // t = 2*(floor(_n/2))
+    unsigned int t = (_n >> 1) << 1;
+
+    // compute in groups of 2
+    unsigned int i;
+    for (i=0; i<t; i+=2) {
+        __m128 x  = _mm_loadu_ps((float*)&_x[i]);
+        __m128 y  = _mm_loadu_ps((float*)&_y[i]);
+
+        // duplicate real and imaginary parts of y
+        __m128 yl = _mm_moveldup_ps(y);
+        __m128 yh = _mm_movehdup_ps(y);
+
+        // swap real/imaginary parts of x
+        __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2,3,0,1));
+
+        // z = x*re{y} -/+ swap(x)*im{y}
+        __m128 z  = _mm_addsub_ps(_mm_mul_ps(x,  yl),
+                                  _mm_mul_ps(xs, yh));
+        _mm_storeu_ps((float*)&_z[i], z);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// basic complex vector multiplication, run-time dispatch
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_SSE3) {
+        liquid_vectorcf_mul_sse3(_x, _y, _n, _z);
+        return;
+    }
+
+    // portable version
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// SSE3 kernel: two complex values per register
+__attribute__((target("sse3")))
+static void liquid_vectorcf_mulscalar_sse3(float complex * _x,
+                                           unsigned int    _n,
+                                           float complex   _v,
+                                           float complex * _y)
+{
+    // broadcast real and imaginary parts of scalar
+    __m128 vl = _mm_set1_ps(crealf(_v));
+    __m128 vh = _mm_set1_ps(cimagf(_v));
+
+    // t = 2*(floor(_n/2))
+    unsigned int t = (_n >> 1) << 1;
+
+    // compute in groups of 2
+    unsigned int i;
+    for (i=0; i<t; i+=2) {
+        __m128 x  = _mm_loadu_ps((float*)&_x[i]);
+
+        // swap real/imaginary parts of x
+        __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2,3,0,1));
+
+        // y = x*re{v} -/+ swap(x)*im{v}
+        __m128 y  = _mm_addsub_ps(_mm_mul_ps(x,  vl),
+                                  _mm_mul_ps(xs, vh));
+        _mm_storeu_ps((float*)&_y[i], y);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// basic complex vector scalar multiplication, run-time dispatch
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mulscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _v,
+                               float complex * _y)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_SSE3) {
+        liquid_vectorcf_mulscalar_sse3(_x, _n, _v, _y);
+        return;
+    }
+
+    // portable version
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorcf_trig.x86.c : complex vector trigonometry (x86, run-time dispatch)
+//
+// The phase rotation kernel computes sine and cosine of four angles at
+// once: the angle is reduced to [-pi/4, pi/4] by quadrant (with the
+// quadrant multiple of pi/2 removed in three parts to retain
+// precision), both polynomials are evaluated in parallel, and the
+// quadrant selects between them and sets the signs. The inverse
+// kernels (phase and magnitude) use a polynomial atan2 approximation
+// and a Newton-refined reciprocal square-root estimate respectively.
+//
+
+#include <math.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+// SSE2 kernel: sine/cosine of four angles per iteration
+__attribute__((target("sse2")))
+static void liquid_vectorcf_cexpj_sse2(float *         _theta,
+                                       unsigned int    _n,
+                                       float complex * _x)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 x = _mm_loadu_ps(&_theta[i]);
+
+        // quadrant index: k = round( theta * 2/pi )
+        __m128i k  = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.636619772f)));
+        __m128  kf = _mm_cvtepi32_ps(k);
+
+        // reduced angle: r = theta - k*pi/2 (three-part split of pi/2)
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, _mm_set1_ps(1.5703125f)));
+        r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(4.83751297e-4f)));
+        r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(7.54978995e-8f)));
+        __m128 r2 = _mm_mul_ps(r, r);
+
+        // sin(r) = r + r^3*(s2 + r^2*(s1 + r^2*s0))
+        __m128 ps = _mm_set1_ps(-1.9515296e-4f);
+        ps = _mm_add_ps(_mm_mul_ps(ps, r2), _mm_set1_ps( 8.3321609e-3f));
+        ps = _mm_add_ps(_mm_mul_ps(ps, r2), _mm_set1_ps(-1.6666655e-1f));
+        __m128 sinr = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, r2), r), r);
+
+        // cos(r) = 1 - r^2/2 + r^4*(c2 + r^2*(c1 + r^2*c0))
+        __m128 pc = _mm_set1_ps( 2.4433157e-5f);
+        pc = _mm_add_ps(_mm_mul_ps(pc, r2), _mm_set1_ps(-1.3887316e-3f));
+        pc = _mm_add_ps(_mm_mul_ps(pc, r2), _mm_set1_ps( 4.1666646e-2f));
+        __m128 cosr = _mm_mul_ps(_mm_mul_ps(pc, r2), r2);
+        cosr = _mm_sub_ps(cosr, _mm_mul_ps(r2, _mm_set1_ps(0.5f)));
+        cosr = _mm_add_ps(cosr, _mm_set1_ps(1.0f));
+
+        // odd quadrants swap sine and cosine
+        __m128i one  = _mm_set1_epi32(1);
+        __m128i two  = _mm_set1_epi32(2);
+        __m128  swap = _mm_castsi128_ps(
+            _mm_cmpeq_epi32(_mm_and_si128(k, one), one));
+
+        // sign bits: sin negated in quadrants 2,3; cos in quadrants 1,2
+        __m128 ssin = _mm_castsi128_ps(
+            _mm_slli_epi32(_mm_and_si128(k, two), 30));
+        __m128 scos = _mm_castsi128_ps(
+            _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, one), two), 30));
+
+        // select and apply signs
+        __m128 sinv = _mm_or_ps(_mm_and_ps   (swap, cosr),
+                                _mm_andnot_ps(swap, sinr));
+        __m128 cosv = _mm_or_ps(_mm_and_ps   (swap, sinr),
+                                _mm_andnot_ps(swap, cosr));
+        sinv = _mm_xor_ps(sinv, ssin);
+        cosv = _mm_xor_ps(cosv, scos);
+
+        // interleave into complex output: x = cos + j*sin
+        _mm_storeu_ps((float*)&_x[i  ], _mm_unpacklo_ps(cosv, sinv));
+        _mm_storeu_ps((float*)&_x[i+2], _mm_unpackhi_ps(cosv, sinv));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = cexpf(_Complex_I*_theta[i]);
+}
+
+// compute complex phase rotation: x[i] = exp{ j theta[i] }
+//  _theta  :   input primitive array [size: _n x 1]
+//  _n      :   array length
+//  _x      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_cexpj(float *         _theta,
+                           unsigned int    _n,
+                           float complex * _x)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_SSE2) {
+        liquid_vectorcf_cexpj_sse2(_theta, _n, _x);
+        return;
+    }
+
+    // portable version
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _x[i] = cexpf(_Complex_I*_theta[i]);
+}
+
+// SSE2 kernel: phase of four complex samples per iteration using a
+// polynomial atan2 approximation: the ratio min(|re|,|im|)/max(|re|,|im|)
+// lies in [0,1] where a degree-9 odd polynomial approximates arctan to
+// within ~1e-4 radians, and octant masks fold the result back to the
+// full circle
+__attribute__((target("sse2")))
+static void liquid_vectorcf_carg_sse2(float complex * _x,
+                                      unsigned int    _n,
+                                      float *         _theta)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    __m128 sign_mask = _mm_set1_ps(-0.0f);
+    __m128 pi        = _mm_set1_ps(3.14159265f);
+    __m128 pi_2      = _mm_set1_ps(1.57079633f);
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // deinterleave real/imaginary components
+        __m128 v0 = _mm_loadu_ps((float*)&_x[i  ]);
+        __m128 v1 = _mm_loadu_ps((float*)&_x[i+2]);
+        __m128 re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+        __m128 im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+
+        // ratio of smaller to larger magnitude, in [0,1]; clamp the
+        // denominator away from zero so the origin maps to phase 0
+        __m128 are = _mm_andnot_ps(sign_mask, re);
+        __m128 aim = _mm_andnot_ps(sign_mask, im);
+        __m128 mn  = _mm_min_ps(are, aim);
+        __m128 mx  = _mm_max_ps(are, aim);
+        __m128 r   = _mm_div_ps(mn, _mm_max_ps(mx, _mm_set1_ps(1e-38f)));
+        __m128 z   = _mm_mul_ps(r, r);
+
+        // a = atan(r) ~ r*(c0 + z*(c1 + z*(c2 + z*(c3 + z*c4))))
+        __m128 p = _mm_set1_ps( 2.08351e-2f);
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-8.51330e-2f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps( 1.80141e-1f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-3.30299e-1f));
+        p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps( 9.99866e-1f));
+        __m128 a = _mm_mul_ps(p, r);
+
+        // fold octants: |im|>|re| reflects about pi/4, re<0 reflects
+        // about pi/2, and the sign of im selects the half-plane
+        __m128 swap = _mm_cmpgt_ps(aim, are);
+        a = _mm_or_ps(_mm_and_ps   (swap, _mm_sub_ps(pi_2, a)),
+                      _mm_andnot_ps(swap, a));
+        __m128 xneg = _mm_cmplt_ps(re, _mm_setzero_ps());
+        a = _mm_or_ps(_mm_and_ps   (xneg, _mm_sub_ps(pi, a)),
+                      _mm_andnot_ps(xneg, a));
+        a = _mm_xor_ps(a, _mm_and_ps(im, sign_mask));
+
+        _mm_storeu_ps(&_theta[i], a);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _theta[i] = cargf(_x[i]);
+}
+
+// compute phase of each element: theta[i] = arg{ x[i] }
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _theta  :   output primitive array [size: _n x 1]
+void liquid_vectorcf_carg(float complex * _x,
+                          unsigned int    _n,
+                          float *         _theta)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_SSE2) {
+        liquid_vectorcf_carg_sse2(_x, _n, _theta);
+        return;
+    }
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _theta[i] = cargf(_x[i]);
+}
+
+// SSE2 kernel: magnitude of four complex samples per iteration using
+// the reciprocal square-root estimate refined with one Newton step,
+// accurate to within a few ulp of single precision
+__attribute__((target("sse2")))
+static void liquid_vectorcf_abs_sse2(float complex * _x,
+                                     unsigned int    _n,
+                                     float *         _y)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // deinterleave real/imaginary components
+        __m128 v0 = _mm_loadu_ps((float*)&_x[i  ]);
+        __m128 v1 = _mm_loadu_ps((float*)&_x[i+2]);
+        __m128 re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+        __m128 im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+
+        // squared magnitude
+        __m128 z = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+
+        // reciprocal square-root estimate with one Newton refinement:
+        // s <- s*(1.5 - 0.5*z*s^2), then |x| = z/sqrt(z)
+        __m128 s = _mm_rsqrt_ps(z);
+        s = _mm_mul_ps(s, _mm_sub_ps(_mm_set1_ps(1.5f),
+                _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), z), _mm_mul_ps(s, s))));
+        __m128 m = _mm_mul_ps(z, s);
+
+        // zero inputs: rsqrt returns infinity, so force the output to zero
+        __m128 nz = _mm_cmpgt_ps(z, _mm_setzero_ps());
+        _mm_storeu_ps(&_y[i], _mm_and_ps(m, nz));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = cabsf(_x[i]);
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output primitive array pointer [size: _n x 1]
+void liquid_vectorcf_abs(float complex * _x,
+                         unsigned int    _n,
+                         float *         _y)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_SSE2) {
+        liquid_vectorcf_abs_sse2(_x, _n, _y);
+        return;
+    }
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = cabsf(_x[i]);
+}
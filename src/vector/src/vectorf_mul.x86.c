@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorf_mul.x86.c : vector multiplication (x86, run-time dispatch)
+//
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // x86 intrinsics (per-function target attributes)
+
+// SSE2 kernel (x86-64 baseline)
+__attribute__((target("sse2")))
+static void liquid_vectorf_mul_sse2(float *      _x,
+                                    float *      _y,
+                                    unsigned int _n,
+                                    float *      _z)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 x = _mm_loadu_ps(&_x[i]);
+        __m128 y = _mm_loadu_ps(&_y[i]);
+        _mm_storeu_ps(&_z[i], _mm_mul_ps(x, y));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// AVX-512 kernel with masked tail handling
+__attribute__((target("avx512f")))
+static void liquid_vectorf_mul_avx512f(float *      _x,
+                                       float *      _y,
+                                       unsigned int _n,
+                                       float *      _z)
+{
+    // t = 16*(floor(_n/16))
+    unsigned int t = (_n >> 4) << 4;
+
+    // compute in groups of 16
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        __m512 x = _mm512_loadu_ps(&_x[i]);
+        __m512 y = _mm512_loadu_ps(&_y[i]);
+        _mm512_storeu_ps(&_z[i], _mm512_mul_ps(x, y));
+    }
+
+    // handle remaining samples with a masked load/store
+    if (i < _n) {
+        __mmask16 mask = (__mmask16)((1U << (_n - i)) - 1);
+        __m512 x = _mm512_maskz_loadu_ps(mask, &_x[i]);
+        __m512 y = _mm512_maskz_loadu_ps(mask, &_y[i]);
+        _mm512_mask_storeu_ps(&_z[i], mask, _mm512_mul_ps(x, y));
+    }
+}
+
+// basic vector multiplication, run-time dispatch
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorf_mul(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_AVX512F)
+        liquid_vectorf_mul_avx512f(_x, _y, _n, _z);
+    else
+        liquid_vectorf_mul_sse2(_x, _y, _n, _z);
+}
+
+// SSE2 kernel (x86-64 baseline)
+__attribute__((target("sse2")))
+static void liquid_vectorf_mulscalar_sse2(float *      _x,
+                                          unsigned int _n,
+                                          float        _v,
+                                          float *      _y)
+{
+    __m128 v = _mm_set1_ps(_v);
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+
+    // compute in groups of 4
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 x = _mm_loadu_ps(&_x[i]);
+        _mm_storeu_ps(&_y[i], _mm_mul_ps(x, v));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// AVX-512 kernel with masked tail handling
+__attribute__((target("avx512f")))
+static void liquid_vectorf_mulscalar_avx512f(float *      _x,
+                                             unsigned int _n,
+                                             float        _v,
+                                             float *      _y)
+{
+    __m512 v = _mm512_set1_ps(_v);
+
+    // t = 16*(floor(_n/16))
+    unsigned int t = (_n >> 4) << 4;
+
+    // compute in groups of 16
+    unsigned int i;
+    for (i=0; i<t; i+=16) {
+        __m512 x = _mm512_loadu_ps(&_x[i]);
+        _mm512_storeu_ps(&_y[i], _mm512_mul_ps(x, v));
+    }
+
+    // handle remaining samples with a masked load/store
+    if (i < _n) {
+        __mmask16 mask = (__mmask16)((1U << (_n - i)) - 1);
+        __m512 x = _mm512_maskz_loadu_ps(mask, &_x[i]);
+        _mm512_mask_storeu_ps(&_y[i], mask, _mm512_mul_ps(x, v));
+    }
+}
+
+// basic vector scalar multiplication, run-time dispatch
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorf_mulscalar(float *      _x,
+                              unsigned int _n,
+                              float        _v,
+                              float *      _y)
+{
+    if (liquid_cpu_features() & LIQUID_CPU_X86_AVX512F)
+        liquid_vectorf_mulscalar_avx512f(_x, _n, _v, _y);
+    else
+        liquid_vectorf_mulscalar_sse2(_x, _n, _v, _y);
+}
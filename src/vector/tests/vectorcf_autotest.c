@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2007 - 2019 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST: element-wise complex vector multiplication
+//
+void autotest_vectorcf_mul()
+{
+    float        tol = 1e-6f;   // error tolerance
+    unsigned int n   = 35;      // odd length to exercise cleanup path
+
+    float complex x[n];
+    float complex y[n];
+    float complex z[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = cosf(0.719f*i) + _Complex_I*sinf(1.372f*i);
+        y[i] = cosf(1.137f*i) - _Complex_I*sinf(0.433f*i);
+    }
+
+    // compute element-wise product
+    liquid_vectorcf_mul(x, y, n, z);
+
+    // compare to scalar reference
+    for (i=0; i<n; i++) {
+        float complex z0 = x[i] * y[i];
+        CONTEND_DELTA( crealf(z[i]), crealf(z0), tol );
+        CONTEND_DELTA( cimagf(z[i]), cimagf(z0), tol );
+    }
+}
+
+//
+// AUTOTEST: complex vector scalar multiplication
+//
+void autotest_vectorcf_mulscalar()
+{
+    float         tol = 1e-6f;  // error tolerance
+    unsigned int  n   = 35;     // odd length to exercise cleanup path
+    float complex v   = 0.7f - 0.2f*_Complex_I;
+
+    float complex x[n];
+    float complex y[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = cosf(0.719f*i) + _Complex_I*sinf(1.372f*i);
+
+    // compute scalar product
+    liquid_vectorcf_mulscalar(x, n, v, y);
+
+    // compare to scalar reference
+    for (i=0; i<n; i++) {
+        float complex y0 = x[i] * v;
+        CONTEND_DELTA( crealf(y[i]), crealf(y0), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(y0), tol );
+    }
+}
+
+//
+// AUTOTEST: complex phase rotation
+//
+void autotest_vectorcf_cexpj()
+{
+    float        tol = 1e-5f;   // error tolerance
+    unsigned int n   = 79;      // odd length to exercise cleanup path
+
+    float         theta[n];
+    float complex x[n];
+
+    // sweep phase over several cycles, including negative angles
+    unsigned int i;
+    for (i=0; i<n; i++)
+        theta[i] = -20.0f + 0.517f*i;
+
+    // compute phase rotation
+    liquid_vectorcf_cexpj(theta, n, x);
+
+    // compare to scalar reference
+    for (i=0; i<n; i++) {
+        float complex x0 = cexpf(_Complex_I*theta[i]);
+        CONTEND_DELTA( crealf(x[i]), crealf(x0), tol );
+        CONTEND_DELTA( cimagf(x[i]), cimagf(x0), tol );
+
+        // result lies on the unit circle
+        CONTEND_DELTA( cabsf(x[i]), 1.0f, tol );
+    }
+}
+
+//
+// AUTOTEST: vectorized phase extraction (polynomial atan2)
+//
+void autotest_vectorcf_carg()
+{
+    float        tol = 1e-3f;   // error tolerance [radians]
+    unsigned int n   = 79;      // odd length to exercise cleanup path
+
+    float complex x[n];
+    float theta[n];
+
+    // samples in all octants at varying magnitudes, plus axis and
+    // origin special cases
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        float r = 0.01f + 10.0f*randf();
+        x[i] = r*cexpf(_Complex_I*2*M_PI*randf());
+    }
+    x[0] =  1.0f;
+    x[1] = -1.0f;
+    x[2] =  _Complex_I;
+    x[3] = -_Complex_I;
+    x[4] =  0.0f;
+
+    // compute phase of each element
+    liquid_vectorcf_carg(x, n, theta);
+
+    // compare to scalar reference
+    for (i=0; i<n; i++) {
+        // wrap phase difference to account for the +/- pi boundary
+        float e = theta[i] - cargf(x[i]);
+        while (e >  M_PI) e -= 2*M_PI;
+        while (e < -M_PI) e += 2*M_PI;
+        CONTEND_DELTA( e, 0.0f, tol );
+    }
+}
+
+//
+// AUTOTEST: vectorized magnitude (Newton-refined reciprocal square root)
+//
+void autotest_vectorcf_abs()
+{
+    unsigned int n = 79;        // odd length to exercise cleanup path
+
+    float complex x[n];
+    float y[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        float r = 0.001f + 100.0f*randf();
+        x[i] = r*cexpf(_Complex_I*2*M_PI*randf());
+    }
+    x[0] = 0.0f;    // origin maps exactly to zero
+
+    // compute magnitude of each element
+    liquid_vectorcf_abs(x, n, y);
+
+    // compare to scalar reference (relative tolerance)
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( y[i], cabsf(x[i]), 1e-5f*(1.0f + cabsf(x[i])) );
+}